@@ -63,21 +63,35 @@ public:
 
     /// Compute optimal solution and return value of objective function
     /// If the input feature map is empty, a warning is issued and -1 is returned.
+    /// The independent subproblems (bins) are prepared in parallel, largest first; the LP solver itself runs one bin at a time.
     /// @return value of objective function
     /// and @p pairs will have all realized edges set to "active"
-    double compute(const FeatureMap fm, PairsType& pairs, Size verbose_level) const;
+    double compute(const FeatureMap& fm, PairsType& pairs, Size verbose_level) const;
+
+    /// Bins with more edges than @p max_edges are solved by a greedy heuristic instead of the ILP (0 = always use the ILP, default)
+    void setGreedyThreshold(Size max_edges);
+
+    /// Bins with more edges than this are solved by a greedy heuristic (0 = disabled)
+    Size getGreedyThreshold() const;
 
 private:
 
     /// slicing the problem into subproblems
-    double computeSlice_(const FeatureMap fm,
+    double computeSlice_(const FeatureMap& fm,
                          PairsType& pairs,
                          const PairsIndex margin_left,
                          const PairsIndex margin_right,
                          const Size verbose_level) const;
 
     /// slicing the problem into subproblems
-    double computeSliceOld_(const FeatureMap fm,
+    /// greedy alternative to computeSlice_: accept edges by decreasing score, as long as they agree with the charge variants chosen so far
+    double computeSliceGreedy_(const FeatureMap& fm,
+                               PairsType& pairs,
+                               const PairsIndex margin_left,
+                               const PairsIndex margin_right) const;
+
+    /// slicing the problem into subproblems
+    double computeSliceOld_(const FeatureMap& fm,
                             PairsType& pairs,
                             const PairsIndex margin_left,
                             const PairsIndex margin_right,
@@ -91,6 +105,9 @@ private:
     // add another charge annotation variant for a feature
     void updateFeatureVariant_(FeatureType_& f_set, const String& rota_l, const Size& v) const;
 
+    /// bins with more edges than this are solved greedily (0 = never)
+    Size greedy_threshold_;
+
 
 
   }; // !class
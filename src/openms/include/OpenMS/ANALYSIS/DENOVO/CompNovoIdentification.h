@@ -75,7 +75,7 @@ public:
     /** @name Accessors
      */
     //@{
-    /// performs an ProteinIdentification run on a PeakMap
+    /// performs an ProteinIdentification run on a PeakMap (the CID/ETD spectrum pairs are processed in parallel)
     void getIdentifications(std::vector<PeptideIdentification> & ids, const PeakMap & exp) override;
 
     /// performs an ProteinIdentification run on a PeakSpectrum
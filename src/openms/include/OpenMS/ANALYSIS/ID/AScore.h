@@ -87,8 +87,9 @@ namespace OpenMS
         @param number_of_phospho_sites which directs the method to search for this number of phosphorylated sites.
 
         @note the original sequence is saved in the PeptideHits as MetaValue Search_engine_sequence.
+        @note Can be called by several threads at once, as long as @p real_spectrum is sorted by m/z or not shared between them.
     */
-    PeptideHit compute(const PeptideHit& hit, PeakSpectrum& real_spectrum);
+    PeptideHit compute(const PeptideHit& hit, PeakSpectrum& real_spectrum) const;
 
   protected:
     int compareMZ_(double mz1, double mz2) const;
@@ -158,6 +159,12 @@ namespace OpenMS
     /// Computes number of matched ions between windows and the given spectrum. All spectra have to be sorted by position!
     Size numberOfMatchedIons_(const PeakSpectrum& th, const PeakSpectrum& windows, Size depth) const;
 
+    /// Reduces each window to its @p depth most intense peaks and sorts the result by position (see numberOfMatchedIons_())
+    std::vector<PeakSpectrum> reduceWindows_(const std::vector<PeakSpectrum>& windows, Size depth) const;
+
+    /// Computes number of matched ions between a window reduced to the peak depth (sorted by position) and the given spectrum
+    Size countMatchedIons_(const PeakSpectrum& th, const PeakSpectrum& window_reduced) const;
+
     /// Computes the peptide score according to Beausoleil et al. page 1291
     double peptideScore_(const std::vector<double>& scores) const;
 
@@ -179,14 +186,19 @@ namespace OpenMS
     /// Create variant of the peptide with all phosphorylations removed
     AASequence removePhosphositesFromSequence_(const String& sequence) const;
     
-    /// Create theoretical spectra with all combinations with the number of phosphorylation events
+    /**
+        @brief Create theoretical spectra with all combinations with the number of phosphorylation events
+
+        The b- and y-ion ladder of @p seq_without_phospho is generated once; the ions of each permutation are
+        derived from it by adding the phospho masses of the sites they contain.
+    */
     std::vector<PeakSpectrum> createTheoreticalSpectra_(const std::vector<std::vector<Size>>& permutations, const AASequence& seq_without_phospho) const;
     
     /// Pick top 10 intensity peaks for each 100 Da windows
     std::vector<PeakSpectrum> peakPickingPerWindowsInSpectrum_(PeakSpectrum& real_spectrum) const;
     
     /// Create 10 scores for each theoretical spectrum (permutation), according to Beausoleil et al. Figure 3 b
-    std::vector<std::vector<double>> calculatePermutationPeptideScores_(std::vector<PeakSpectrum>& th_spectra, const std::vector<PeakSpectrum>& windows_top10) const;
+    std::vector<std::vector<double>> calculatePermutationPeptideScores_(std::vector<PeakSpectrum>& th_spectra, const std::vector<PeakSpectrum>& windows_top10, double base_match_probability) const;
     
     /// Rank weighted permutation scores ascending
     std::multimap<double, Size> rankWeightedPermutationPeptideScores_(const std::vector<std::vector<double>>& peptide_site_scores) const;
@@ -200,7 +212,6 @@ namespace OpenMS
     Size max_peptide_length_; ///< Limit for peptide lengths that can be analyzed
     Size max_permutations_; ///< Limit for number of sequence permutations that can be handled
     double unambiguous_score_; ///< Score for unambiguous assignments (all sites phosphorylated)
-    double base_match_probability_; ///< Probability of a match at a peak depth of 1
 
   };
 
@@ -272,6 +272,23 @@ public:
 
        */
     void queryByMZ(const double& observed_mz, const Int& observed_charge, const String& ion_mode, std::vector<AccurateMassSearchResult>& results, const EmpiricalFormula& observed_adduct = EmpiricalFormula()) const;
+
+    /**
+      @brief search for many observed masses at once
+
+      Gives the same results as calling queryByMZ() (without observed adduct) for each pair of @p observed_mzs and @p observed_charges,
+      but the queries are processed in order of increasing m/z. Thus, the tolerance windows move monotonically through the (sorted) database
+      and are found by a single merge-style scan per adduct instead of a binary search for every query.
+
+      @param observed_mzs The observed m/z values (in any order)
+      @param observed_charges The observed charges (same length as @p observed_mzs; 0 for unknown)
+      @param ion_mode Either 'positive' or 'negative'
+      @param results One list of hits per query, in input order
+
+      @throw Exception::InvalidSize if @p observed_mzs and @p observed_charges differ in length
+    */
+    void queryByMZs(const std::vector<double>& observed_mzs, const std::vector<Int>& observed_charges, const String& ion_mode, std::vector<std::vector<AccurateMassSearchResult> >& results) const;
+
     void queryByFeature(const Feature& feature, const Size& feature_index, const String& ion_mode, std::vector<AccurateMassSearchResult>& results) const;
     void queryByConsensusFeature(const ConsensusFeature& cfeat, const Size& cf_index, const Size& number_of_maps, const String& ion_mode, std::vector<AccurateMassSearchResult>& results) const;
 
@@ -342,6 +359,19 @@ private:
     void parseAdductsFile_(const String& filename, std::vector<AdductInfo>& result);
     void searchMass_(double neutral_query_mass, double diff_mass, std::pair<Size, Size>& hit_indices) const;
 
+    /// adducts for @p ion_mode ('positive' or 'negative')
+    /// @throw InvalidParameter for any other ion mode
+    const std::vector<AdductInfo>& getAdducts_(const String& ion_mode) const;
+
+    /// absolute tolerance of the neutral mass for an observation at @p observed_mz with @p adduct
+    double getMassTolerance_(double observed_mz, const AdductInfo& adduct) const;
+
+    /// append all database hits in [hit_indices.first, hit_indices.second) which are compatible with @p adduct to @p results
+    void appendHits_(double observed_mz, double neutral_mass, const AdductInfo& adduct, const std::pair<Size, Size>& hit_indices, std::vector<AccurateMassSearchResult>& results) const;
+
+    /// append a 'not-found' indicator to @p results
+    void appendUnidentified_(double observed_mz, Int observed_charge, std::vector<AccurateMassSearchResult>& results) const;
+
     /// add search results to a Consensus/Feature
     void annotate_(const std::vector<AccurateMassSearchResult>&, BaseFeature&) const;
 
@@ -366,6 +396,7 @@ private:
       String formula;
     };
     std::vector<MappingEntry_> mass_mappings_;
+    std::vector<double> masses_; ///< masses of mass_mappings_ (same order) in a contiguous array for fast range queries
 
     struct CompareEntryAndMass_ // defined here to allow for inlining by compiler
     {
@@ -84,16 +84,16 @@ namespace OpenMS
 
     /**
      * @brief Performs simple inference on one protein run.
-     * @param acc_to_protein_hitP_and_count Maps Accessions to a pair of ProteinHit pointers
-     *  and number of peptidoforms encountered @Todo could use member as hash to save strings
-     * @param best_pep Maps (un)modified peptide sequence to a map from charge (0 when unconsidered) to the
-     *  best PeptideHit pointer
+     *
+     * The best PSM per peptide (and charge) is determined in parallel over chunks of spectra.
+     * Scores and peptide counts are aggregated in arrays indexed by protein (accessions are mapped
+     * to indices once), in the order of the first occurrence of each peptide.
+     *
      * @param prot_run The current run to process
      * @param pep_ids Peptides for the current run to process
+     * @param min_peptides_per_protein Proteins with fewer peptides are removed
      */
     void processRun_(
-      std::unordered_map<std::string, std::pair<ProteinHit*, Size>>& acc_to_protein_hitP_and_count,
-      std::unordered_map<std::string, std::map<Int, PeptideHit*>>& best_pep,
       ProteinIdentification& prot_run,
       std::vector<PeptideIdentification>& pep_ids,
       Size min_peptides_per_protein) const;
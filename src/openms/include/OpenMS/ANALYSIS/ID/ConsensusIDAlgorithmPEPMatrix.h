@@ -171,8 +171,22 @@ namespace OpenMS
     /// Similarity scoring method
     SeqAnScore scoring_method_;
 
-    /// Alignment data structure
-    ::seqan::Align<SeqAnSequence, ::seqan::ArrayGaps> alignment_;
+    /// Gap penalty (same for gap opening and extension)
+    int penalty_;
+
+    /// Best substitution score of each amino acid (by SeqAn ordinal value), used to verify banded alignments
+    std::vector<int> best_scores_;
+
+    /**
+       @brief Score of the global (Needleman-Wunsch) alignment of @p seq1 and @p seq2
+
+       The alignment is first computed in a narrow band around the diagonal, which suffices for (near-)identical sequences.
+       If the banded score cannot be guaranteed to be optimal (bound on the score of any alignment leaving the band), the full alignment is computed.
+    */
+    int alignmentScore_(const SeqAnSequence& seq1, const SeqAnSequence& seq2) const;
+
+    /// Alignment score of @p seq1 and @p seq2 restricted to diagonals within @p band of the start and end diagonals
+    int bandedAlignmentScore_(const SeqAnSequence& seq1, const SeqAnSequence& seq2, Size band) const;
 
     /// Not implemented
     ConsensusIDAlgorithmPEPMatrix(const ConsensusIDAlgorithmPEPMatrix&);
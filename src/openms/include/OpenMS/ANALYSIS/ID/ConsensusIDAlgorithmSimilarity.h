@@ -61,18 +61,25 @@ namespace OpenMS
     /// Mapping: pair of peptide sequences -> sequence similarity
     typedef std::map<std::pair<AASequence, AASequence>, double> SimilarityCache;
 
-    /// Cache for already computed sequence similarities
+    /// Cache for already computed sequence similarities (access via lookupSimilarity_()/cacheSimilarity_() while processing)
     SimilarityCache similarities_;
 
     /**
        @brief Sequence similarity calculation (to be implemented by subclasses).
 
-       Implementations should use/update the cache of previously computed similarities.
+       Implementations should use/update the cache of previously computed similarities via lookupSimilarity_() and cacheSimilarity_().
+       This function is called in parallel for different pairs of sequences, so it must not modify other members.
 
        @return Similarity between two sequences in the range [0, 1]
     */
     virtual double getSimilarity_(AASequence seq1, AASequence seq2) = 0;
 
+    /// Looks up the similarity of @p seq_pair in the cache (thread-safe); returns false if it is not cached
+    bool lookupSimilarity_(const std::pair<AASequence, AASequence>& seq_pair, double& similarity) const;
+
+    /// Adds the similarity of @p seq_pair to the cache (thread-safe)
+    void cacheSimilarity_(const std::pair<AASequence, AASequence>& seq_pair, double similarity);
+
   private:
     /// Not implemented
     ConsensusIDAlgorithmSimilarity(const ConsensusIDAlgorithmSimilarity&);
@@ -99,18 +99,5 @@ namespace OpenMS
     bool checkOldRunConsistency_(const std::vector<ProteinIdentification>& protRuns, const String& experiment_type) const;
     /// Same as above but with specific reference run
     bool checkOldRunConsistency_(const std::vector<ProteinIdentification>& protRuns, const ProteinIdentification& ref, const String& experiment_type) const;
-
-
-    static size_t accessionHash_(const ProteinHit& p)
-    {
-      return std::hash<String>()(p.getAccession());
-    }
-    static bool accessionEqual_(const ProteinHit& p1, const ProteinHit& p2)
-    {
-      return p1.getAccession() == p2.getAccession();
-    }
-    using hash_type = std::size_t (*)(const ProteinHit&);
-    using equal_type = bool (*)(const ProteinHit&, const ProteinHit&);
-
   };
 } // namespace OpenMS
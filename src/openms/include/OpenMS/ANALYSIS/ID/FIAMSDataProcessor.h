@@ -41,6 +41,8 @@
 
 namespace OpenMS
 {
+  class AccurateMassSearchEngine;
+
   /**
     @brief Data processing for FIA-MS data
     
@@ -94,6 +96,21 @@ public:
     */
     bool run(const MSExperiment& experiment, const float n_seconds, OpenMS::MzTab& output, const bool load_cached_spectrum = true);
 
+    /**
+      @brief Same as above, but uses an already initialized accurate mass search engine
+
+      The engine is only read from, so one instance (see configureAccurateMassSearch()) can be
+      shared by several processors running concurrently, e.g. by FIAMSScheduler.
+
+      @param experiment  Input MSExperiment
+      @param n_seconds Input number of seconds
+      @param output   [out] Output of the accurate mass search results
+      @param ams Initialized accurate mass search engine
+      @param load_cached_spectrum Load the cached picked spectrum if exists
+      @return a boolean indicating if the picked spectrum was loaded from the cached file
+    */
+    bool run(const MSExperiment& experiment, const float n_seconds, OpenMS::MzTab& output, const AccurateMassSearchEngine& ams, const bool load_cached_spectrum = true);
+
     /**
       @brief Cut the time axis of the experiment from 0 to @n_seconds
 
@@ -153,6 +170,16 @@ public:
     */
     void runAccurateMassSearch(FeatureMap& input, OpenMS::MzTab& output);
 
+    /**
+      @brief Set the parameters of the accurate mass search engine from the parameters of this processor and initialize it
+
+      Loads the database and adduct files. Engines configured from processors with the same
+      "resolution", "db:*" and "*_adducts" parameters are interchangeable.
+
+      @param ams  [out] The engine to configure
+    */
+    void configureAccurateMassSearch(AccurateMassSearchEngine& ams) const;
+
     /**
       @brief Get mass-to-charge ratios to base the summing the spectra along the time axis upon
     */
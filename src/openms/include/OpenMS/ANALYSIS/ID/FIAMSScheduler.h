@@ -35,6 +35,7 @@
 #pragma once
 
 #include <OpenMS/FORMAT/CsvFile.h>
+#include <OpenMS/DATASTRUCTURES/Param.h>
 #include <map>
 
 namespace OpenMS
@@ -54,6 +55,10 @@ class MzMLFile;
     - *positive_adducts* - file containing the list of potential positive adducts for the accurate mass search
     - *negative_adducts* - file containing the list of potential negative adducts for the accurate mass search
     - *time* - ";"-separated numbers of seconds to process, f.e. "30;60;90;180"
+
+    The samples are processed in parallel. The database and adduct files are loaded only once
+    per distinct combination of resolution, databases and adduct lists and shared (read-only)
+    by all samples using them.
 */
 class OPENMS_DLLAPI FIAMSScheduler 
   {
@@ -78,8 +83,10 @@ public:
 
     /**
       @brief Run the FIA-MS data analysis for the batch defined in the @filename_
+
+      @param max_concurrent_samples Maximum number of samples processed at the same time (0: use as many threads as OpenMP provides)
     */
-    void run();
+    void run(Size max_concurrent_samples = 0);
 
     /**
       @brief Get the batch
@@ -97,6 +104,11 @@ private:
     */
     void loadSamples_();
 
+    /**
+      @brief Parameters of the FIAMSDataProcessor for the sample with index @p i
+    */
+    Param getProcessorParameters_(Size i) const;
+
     String filename_;
     String base_dir_;
     bool load_cached_;
@@ -49,6 +49,7 @@ namespace OpenMS
 {
 
   struct ScoreToTgtDecLabelPairs;
+  struct ScoreToFDRTable;
 
   /**
     @brief Calculates false discovery rates (FDR) from identifications
@@ -185,18 +186,9 @@ private:
     /// calculates the FDR, given two vectors of scores
     void calculateFDRs_(std::map<double, double>& score_to_fdr, std::vector<double>& target_scores, std::vector<double>& decoy_scores, bool q_value, bool higher_score_better) const;
 
-    /// Helper function for applyToQueryMatches()
-    void handleQueryMatch_(
-        IdentificationData::QueryMatchRef match_ref,
-        IdentificationData::ScoreTypeRef score_ref,
-        std::vector<double>& target_scores,
-        std::vector<double>& decoy_scores,
-        std::map<IdentificationData::IdentifiedMoleculeRef, bool>& molecule_to_decoy,
-        std::map<IdentificationData::QueryMatchRef, double>& match_to_score) const;
-
-    /// calculates an estimated FDR (based on P(E)Ps) given a vector of score value pairs and fills a map for lookup
+    /// calculates an estimated FDR (based on P(E)Ps) given a vector of score value pairs and fills a table for lookup
     /// in scores_to_FDR
-    void calculateEstimatedQVal_(std::map<double, double> &scores_to_FDR,
+    void calculateEstimatedQVal_(ScoreToFDRTable &scores_to_FDR,
                                  ScoreToTgtDecLabelPairs &scores_labels,
                                  bool higher_score_better) const;
 
@@ -204,8 +196,10 @@ private:
     /// Just goes through the sorted scores and counts the number of decoys and targets and annotates the FDR for
     /// this score as it goes. Q-values are optionally annotated by calculating the cumulative minimum in reversed
     /// order afterwards. Since I never understood our other algorithm, I can not explain the difference.
+    /// The scores are sorted in parallel (OpenMP) and the cumulative decoy counts are computed with a parallel
+    /// prefix scan over the flat array, so this also scales to tens of millions of PSMs.
     /// @note Formula used depends on Param "conservative": false -> (D+1)/T, true (e.g. used in Fido) -> (D+1)/(T+D)
-    void calculateFDRBasic_(std::map<double,double>& scores_to_FDR, ScoreToTgtDecLabelPairs& scores_labels, bool qvalue, bool higher_score_better) const;
+    void calculateFDRBasic_(ScoreToFDRTable& scores_to_FDR, ScoreToTgtDecLabelPairs& scores_labels, bool qvalue, bool higher_score_better) const;
 
     /// calculates the error area around the x=x line between two consecutive values of expected and actual
     /// i.e. it assumes exp2 > exp1
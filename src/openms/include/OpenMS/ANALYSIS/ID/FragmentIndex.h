@@ -0,0 +1,174 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <OpenMS/CHEMISTRY/AASequence.h>
+#include <OpenMS/CHEMISTRY/TheoreticalSpectrumGenerator.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+#include <OpenMS/KERNEL/StandardTypes.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+
+  /**
+    @brief An index of the fragment ions of a set of candidate peptides
+
+    All candidate peptides are sorted by precursor mass and the m/z values of
+    their singly charged b- and y-ions are stored in buckets of fixed m/z
+    width. Within a bucket, fragments are ordered by peptide (i.e. by
+    precursor mass), so a query only needs to look at the fragments of
+    peptides inside the precursor mass window.
+
+    query() counts, for every candidate in a precursor mass window, how many
+    peaks of an experimental spectrum match one of its fragments. This allows
+    a search engine to restrict expensive scoring to candidates that share a
+    minimum number of fragments with the spectrum instead of scoring every
+    candidate in the precursor window.
+
+    The index can be stored to and loaded from a binary file. A key (e.g. a
+    checksum of the database and the digestion settings) is stored along with
+    the index so that an outdated index file can be detected.
+
+    Usage: add all candidates with addPeptide(), then call build() once
+    before querying.
+  */
+  class OPENMS_DLLAPI FragmentIndex
+  {
+  public:
+
+    /// A candidate peptide
+    struct Peptide
+    {
+      String unmodified_sequence; ///< the unmodified peptide sequence
+      Size mod_index; ///< index of this variant among the modified variants of the unmodified sequence
+      String sequence; ///< the (modified) peptide sequence
+      double mass; ///< monoisotopic mass
+    };
+
+    /**
+      @brief Constructor
+
+      @param bucket_width Width of the fragment m/z buckets (in Th)
+    */
+    explicit FragmentIndex(double bucket_width = 0.05);
+
+    /// Adds a candidate peptide
+    void addPeptide(const String& unmodified_sequence, Size mod_index, const AASequence& peptide);
+
+    /// Sorts the candidates by mass and fills the fragment buckets (needs to be called before query())
+    void build();
+
+    /// Removes all candidates and fragments
+    void clear();
+
+    /// Number of candidate peptides
+    Size size() const;
+
+    /// Total number of fragments in the index
+    Size getNrFragments() const;
+
+    /// Access to a candidate (ordered by mass after build())
+    const Peptide& getPeptide(Size index) const;
+
+    /**
+      @brief Counts the fragments of all candidates in a precursor mass window matching a peak of @p spectrum
+
+      @param spectrum The experimental spectrum (singly charged fragment m/z)
+      @param min_mass Lower bound of the precursor mass window
+      @param max_mass Upper bound of the precursor mass window
+      @param fragment_tolerance Fragment mass tolerance (on either side of a peak)
+      @param fragment_tolerance_ppm Unit of @p fragment_tolerance is ppm if true, Th otherwise
+      @param min_matched_peaks Minimum number of matching fragments for a candidate to be reported
+      @param candidates Output: pairs of candidate index and number of matching fragments, sorted by candidate index
+
+      @throw Exception::Precondition if build() was not called
+    */
+    void query(const MSSpectrum& spectrum,
+               double min_mass,
+               double max_mass,
+               double fragment_tolerance,
+               bool fragment_tolerance_ppm,
+               Size min_matched_peaks,
+               std::vector<std::pair<Size, Size> >& candidates) const;
+
+    /**
+      @brief Stores the index in a binary file
+
+      @throw Exception::UnableToCreateFile if the file cannot be written
+      @throw Exception::Precondition if build() was not called
+    */
+    void store(const String& filename, const String& key) const;
+
+    /**
+      @brief Loads an index stored with store()
+
+      @return false if the file does not exist or was built with a different @p key (the index is left empty)
+
+      @throw Exception::ParseError if the file is not a valid index file
+    */
+    bool load(const String& filename, const String& key);
+
+  protected:
+
+    /// Index of the bucket containing m/z @p mz
+    Size bucket_(double mz) const;
+
+    /// A single fragment ion in a bucket
+    struct Fragment_
+    {
+      UInt32 peptide; ///< index of the peptide in peptides_
+      float mz; ///< fragment m/z
+    };
+
+    double bucket_width_;
+    bool built_;
+    TheoreticalSpectrumGenerator spectrum_generator_;
+    /// reused buffer for the fragment m/z values of a peptide
+    std::vector<double> mz_buffer_;
+
+    std::vector<Peptide> peptides_;
+    /// fragment m/z values of each peptide (only used before build())
+    std::vector<std::vector<float> > peptide_fragments_;
+
+    /// start of each bucket in fragments_ (size: number of buckets + 1)
+    std::vector<Size> bucket_offsets_;
+    std::vector<Fragment_> fragments_;
+  };
+
+} // namespace OpenMS
+
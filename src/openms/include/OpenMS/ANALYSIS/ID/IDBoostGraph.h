@@ -507,6 +507,10 @@ namespace OpenMS
     void annotateIndistProteins_(const Graph& fg, bool addSingletons);
     void calculateAndAnnotateIndistProteins_(const Graph& fg, bool addSingletons);
 
+    /// indices of the connected components sorted by decreasing number of edges. Usually there is one
+    /// huge component and thousands of tiny ones, so starting the big ones first balances the threads.
+    std::vector<Size> getCCsBySizeDescending_() const;
+
     /// Initialize and store the graph
     /// IMPORTANT: Once the graph is built, editing members like (protein/peptide)_hits_ will invalidate it!
     /// @param protein ProteinIdentification object storing IDs and groups
@@ -265,7 +265,10 @@ protected:
     void getIDDetails_(const PeptideIdentification& id, double& rt_pep, DoubleList& mz_values, IntList& charges, bool use_avg_mass = false) const;
 
     /// increase a bounding box by the given RT and m/z tolerances
-    void increaseBoundingBox_(DBoundingBox<2>& box);
+    void increaseBoundingBox_(DBoundingBox<2>& box) const;
+
+    /// bounding box containing all positions of IDs that isMatch_() can accept for an element at @p rt, @p mz
+    DBoundingBox<2> getMatchBox_(const double rt, const double mz) const;
 
     /// try to determine the type of m/z value reported for features, return
     /// whether average peptide masses should be used for matching
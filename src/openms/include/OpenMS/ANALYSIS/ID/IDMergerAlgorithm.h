@@ -40,7 +40,7 @@
 #include <OpenMS/KERNEL/ConsensusMap.h>
 #include <OpenMS/METADATA/ExperimentalDesign.h>
 
-#include <unordered_set>
+#include <unordered_map>
 
 namespace OpenMS
 {
@@ -122,7 +122,7 @@ namespace OpenMS
     /// mapping in
     void updateAndMovePepIDs_(
         std::vector<PeptideIdentification>&& pepIDs,
-        const std::map<String, Size>& runID_to_runIdx,
+        const std::unordered_map<String, Size>& runID_to_runIdx,
         const std::vector<StringList>& originFiles,
         bool annotate_origin
     );
@@ -139,21 +139,17 @@ namespace OpenMS
     /// the resulting new Peptide IDs
     std::vector<PeptideIdentification> pep_result_;
 
-    static size_t accessionHash_(const ProteinHit& p){
-      return std::hash<String>()(p.getAccession());
-    }
-    static bool accessionEqual_(const ProteinHit& p1, const ProteinHit& p2){
-      return p1.getAccession() == p2.getAccession();
-    }
-    using hash_type = std::size_t (*)(const ProteinHit&);
-    using equal_type = bool (*)(const ProteinHit&, const ProteinHit&);
-    std::unordered_set<ProteinHit, hash_type, equal_type> collected_protein_hits_;
+    /// the collected (unique) protein hits in the order of their first occurrence
+    std::vector<ProteinHit> collected_protein_hits_;
+
+    /// position of each accession in collected_protein_hits_
+    std::unordered_map<InternedString, Size> collected_protein_idx_;
 
     /// is the resulting protein ID already filled?
     bool filled_ = false;
 
     /// to keep track of the mzML origins of spectra
-    std::map<String, Size> file_origin_to_idx_;
+    std::unordered_map<String, Size> file_origin_to_idx_;
 
     /// the new identifier string
     String id_;
@@ -42,6 +42,7 @@
 
 #include <boost/unordered_map.hpp>
 
+#include <algorithm>
 #include <vector>
 #include <unordered_set>
 
@@ -57,6 +58,22 @@ namespace OpenMS
     using Base::Base;
   };
 
+  /// Maps original scores to FDRs or q-values. Pairs are sorted by score (ascending, scores are unique)
+  /// and looked up like in a std::map, but stored in one contiguous array.
+  struct ScoreToFDRTable // Not a typedef to allow forward declaration.
+      : public std::vector<std::pair<double, double>>
+  {
+    typedef std::vector<std::pair<double, double>> Base;
+    using Base::Base;
+
+    /// Returns the first entry whose score is not less than @p score (like std::map::lower_bound)
+    const_iterator lower_bound(double score) const
+    {
+      return std::lower_bound(begin(), end(), score,
+        [](const value_type& entry, double s) { return entry.first < s; });
+    }
+  };
+
   /**
    * @brief A class for extracting and reinserting IDScores from Peptide/ProteinIdentifications and from ConsensusMaps
    */
@@ -328,7 +345,7 @@ namespace OpenMS
     /**
      * \defgroup setScoresFunctions Sets FDRs/qVals
      * @brief  Sets FDRs/qVals from a scores_to_FDR map in the ID data structures
-     * @param  scores_to_FDR Maps original score to calculated FDR or q-Value
+     * @param  scores_to_FDR Maps original score to calculated FDR or q-Value (sorted by score)
      * @param  score_type FDR or q-Value
      * @param  higher_better should usually be false @todo remove?
      *
@@ -337,7 +354,7 @@ namespace OpenMS
      */
 
     template<typename IDType, class ...Args>
-    static void setScores_(const std::map<double, double> &scores_to_FDR,
+    static void setScores_(const ScoreToFDRTable &scores_to_FDR,
                     std::vector<IDType> &ids,
                     const std::string &score_type,
                     bool higher_better,
@@ -360,7 +377,7 @@ namespace OpenMS
     }
 
     template<typename IDType>
-    static void setScores_(const std::map<double, double> &scores_to_FDR, IDType &id, const std::string &score_type,
+    static void setScores_(const ScoreToFDRTable &scores_to_FDR, IDType &id, const std::string &score_type,
                     bool higher_better, bool keep_decoy)
     {
       String old_score_type = setScoreType_(id, score_type, higher_better);
@@ -376,7 +393,7 @@ namespace OpenMS
     }
 
     template<typename IDType>
-    static void setScores_(const std::map<double, double> &scores_to_FDR, IDType &id,
+    static void setScores_(const ScoreToFDRTable &scores_to_FDR, IDType &id,
                     const String &old_score_type)
     {
       std::vector<typename IDType::HitType> &hits = id.getHits();
@@ -387,7 +404,7 @@ namespace OpenMS
     }
 
     template<typename IDType, class ...Args>
-    static void setScoresAndRemoveDecoys_(const std::map<double, double> &scores_to_FDR, IDType &id,
+    static void setScoresAndRemoveDecoys_(const ScoreToFDRTable &scores_to_FDR, IDType &id,
                                    const String &old_score_type, Args ... args)
     {
       std::vector<typename IDType::HitType> &hits = id.getHits();
@@ -401,21 +418,21 @@ namespace OpenMS
     }
 
     template<typename HitType>
-    static void setScore_(const std::map<double, double> &scores_to_FDR, HitType &hit, const std::string &old_score_type)
+    static void setScore_(const ScoreToFDRTable &scores_to_FDR, HitType &hit, const std::string &old_score_type)
     {
       hit.setMetaValue(old_score_type, hit.getScore());
       hit.setScore(scores_to_FDR.lower_bound(hit.getScore())->second);
     }
 
     template<typename IDType>
-    static void setScores_(const std::map<double, double> &scores_to_FDR, IDType &id, const std::string &score_type,
+    static void setScores_(const ScoreToFDRTable &scores_to_FDR, IDType &id, const std::string &score_type,
                     bool higher_better)
     {
       String old_score_type = setScoreType_(id, score_type, higher_better);
       setScores_(scores_to_FDR, id, old_score_type);
     }
 
-    static void setScores_(const std::map<double, double> &scores_to_FDR,
+    static void setScores_(const ScoreToFDRTable &scores_to_FDR,
                     PeptideIdentification &id,
                     const std::string &score_type,
                     bool higher_better,
@@ -433,7 +450,7 @@ namespace OpenMS
       }
     }
 
-    static void setScores_(const std::map<double, double> &scores_to_FDR,
+    static void setScores_(const ScoreToFDRTable &scores_to_FDR,
                     PeptideIdentification &id,
                     const std::string &score_type,
                     bool higher_better,
@@ -448,7 +465,7 @@ namespace OpenMS
     }
 
     template<typename IDType>
-    static void setScores_(const std::map<double, double> &scores_to_FDR, IDType &id, const std::string &score_type,
+    static void setScores_(const ScoreToFDRTable &scores_to_FDR, IDType &id, const std::string &score_type,
                     bool higher_better, bool keep_decoy, const String &identifier)
     {
       if (id.getIdentifier() == identifier)
@@ -457,7 +474,7 @@ namespace OpenMS
       }
     }
 
-    static void setScores_(const std::map<double, double> &scores_to_FDR,
+    static void setScores_(const ScoreToFDRTable &scores_to_FDR,
                     PeptideIdentification &id,
                     const std::string &score_type,
                     bool higher_better,
@@ -471,7 +488,7 @@ namespace OpenMS
     }
 
     template<typename IDType>
-    static void setScores_(const std::map<double, double> &scores_to_FDR, IDType &id, const std::string &score_type,
+    static void setScores_(const ScoreToFDRTable &scores_to_FDR, IDType &id, const std::string &score_type,
                     bool higher_better, const String &identifier)
     {
       if (id.getIdentifier() == identifier)
@@ -482,7 +499,7 @@ namespace OpenMS
 
     //TODO could also get a keep_decoy flag when we define what a "decoy group" is -> keep all always for now
     static void setScores_(
-        const std::map<double, double> &scores_to_FDR,
+        const ScoreToFDRTable &scores_to_FDR,
         std::vector<ProteinIdentification::ProteinGroup> &grps,
         const std::string &score_type,
         bool higher_better);
@@ -498,7 +515,7 @@ namespace OpenMS
      * @param new_hits where to move if target (i.e. target or target+decoy)
      */
     template<typename HitType>
-    static void setScoreAndMoveIfTarget_(const std::map<double, double> &scores_to_FDR,
+    static void setScoreAndMoveIfTarget_(const ScoreToFDRTable &scores_to_FDR,
                                   HitType &hit,
                                   const std::string &old_score_type,
                                   std::vector<HitType> &new_hits)
@@ -520,7 +537,7 @@ namespace OpenMS
     * @param new_hits where to move if target (i.e. target or target+decoy)
     * @param charge If only peptides with charge X are currently considered
     */
-    static void setScoreAndMoveIfTarget_(const std::map<double, double> &scores_to_FDR,
+    static void setScoreAndMoveIfTarget_(const ScoreToFDRTable &scores_to_FDR,
                                   PeptideHit &hit,
                                   const std::string &old_score_type,
                                   std::vector<PeptideHit> &new_hits,
@@ -554,7 +571,7 @@ namespace OpenMS
      */
     // GCC-OPT 4.8 -- the following functions can be replaced by a
     // single one with a variadic template, see #4273 and https://gcc.gnu.org/bugzilla/show_bug.cgi?id=41933
-    static void setPeptideScoresForMap_(const std::map<double, double> &scores_to_FDR,
+    static void setPeptideScoresForMap_(const ScoreToFDRTable &scores_to_FDR,
                                  ConsensusMap &cmap,
                                  bool include_unassigned_peptides,
                                  const std::string &score_type,
@@ -568,7 +585,7 @@ namespace OpenMS
               higher_better, keep_decoy); };
       cmap.applyFunctionOnPeptideIDs(f, include_unassigned_peptides);
     }
-    static void setPeptideScoresForMap_(const std::map<double, double> &scores_to_FDR,
+    static void setPeptideScoresForMap_(const ScoreToFDRTable &scores_to_FDR,
                                         ConsensusMap &cmap,
                                         bool include_unassigned_peptides,
                                         const std::string &score_type,
@@ -583,7 +600,7 @@ namespace OpenMS
                        higher_better, keep_decoy, charge); };
       cmap.applyFunctionOnPeptideIDs(f, include_unassigned_peptides);
     }
-    static void setPeptideScoresForMap_(const std::map<double, double> &scores_to_FDR,
+    static void setPeptideScoresForMap_(const ScoreToFDRTable &scores_to_FDR,
                                         ConsensusMap &cmap,
                                         bool include_unassigned_peptides,
                                         const std::string &score_type,
@@ -598,7 +615,7 @@ namespace OpenMS
                        higher_better, keep_decoy, run_identifier); };
       cmap.applyFunctionOnPeptideIDs(f, include_unassigned_peptides);
     }
-    static void setPeptideScoresForMap_(const std::map<double, double> &scores_to_FDR,
+    static void setPeptideScoresForMap_(const ScoreToFDRTable &scores_to_FDR,
                                         ConsensusMap &cmap,
                                         bool include_unassigned_peptides,
                                         const std::string &score_type,
@@ -0,0 +1,186 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <OpenMS/DATASTRUCTURES/ListUtils.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+#include <OpenMS/FORMAT/FASTAFile.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <vector>
+
+namespace boost
+{
+  namespace interprocess
+  {
+    class mapped_region;
+  }
+}
+
+namespace OpenMS
+{
+
+  /**
+    @brief A persistent, memory-mapped cache of the (modified) peptides of a digested protein database
+
+    Digesting a large database and expanding all modified variants of every
+    peptide takes considerable time and is repeated by every search against
+    the same database. This class stores the result in a binary file: one
+    fixed-size record per modified candidate peptide, sorted by monoisotopic
+    mass, followed by the unmodified and modified sequences. The file is
+    memory-mapped on load, so candidates can be streamed from disk (e.g. by
+    iterating over a precursor mass range) without keeping all of them in
+    memory.
+
+    The cache is content-addressed: the file name is derived from a key
+    (see getKey()) which combines the SHA-1 checksum of the FASTA file with
+    all digestion and modification settings. Different settings or a changed
+    database thus never share a cache file.
+
+    Peptides containing ambiguous amino acids (B, X, Z) are skipped.
+
+    Usage:
+    @code
+    PeptideDigestCache cache;
+    String key = PeptideDigestCache::getKey(fasta_file, settings);
+    String filename = PeptideDigestCache::getFilename(cache_directory, key);
+    if (!cache.load(filename, key))
+    {
+      PeptideDigestCache::build(proteins, settings, key, filename);
+      cache.load(filename, key);
+    }
+    for (Size i = cache.lowerBound(min_mass); i < cache.size() && cache.getMass(i) <= max_mass; ++i) { ... }
+    @endcode
+  */
+  class OPENMS_DLLAPI PeptideDigestCache
+  {
+  public:
+
+    /// Settings that determine the set of candidate peptides
+    struct OPENMS_DLLAPI Settings
+    {
+      String enzyme = "Trypsin";
+      Size missed_cleavages = 1;
+      Size min_length = 7;
+      Size max_length = 40; ///< maximum peptide length (0 = disabled)
+      double min_mass = 0.0;
+      double max_mass = 0.0; ///< maximum monoisotopic mass of a candidate (0 = disabled)
+      StringList fixed_modifications;
+      StringList variable_modifications;
+      Size max_variable_mods_per_peptide = 2;
+      String database_tag; ///< identifier for modifications of the protein database not reflected by the FASTA file (e.g. generated decoys)
+
+      /// String representation of all settings (part of the key)
+      String toString() const;
+    };
+
+    /// A candidate peptide (sequences point into the memory-mapped file)
+    struct Peptide
+    {
+      double mass; ///< monoisotopic mass
+      Size mod_index; ///< index of this variant among the modified variants generated by ModifiedPeptideGenerator
+      StringView unmodified_sequence;
+      StringView sequence; ///< modified sequence (as created by AASequence::toString())
+    };
+
+    /// Default constructor (empty cache)
+    PeptideDigestCache();
+
+    /// Destructor
+    ~PeptideDigestCache();
+
+    /// Returns the key for @p fasta_file digested with @p settings
+    static String getKey(const String& fasta_file, const Settings& settings);
+
+    /// Returns the file name of the cache for @p key in @p directory
+    static String getFilename(const String& directory, const String& key);
+
+    /**
+      @brief Digests @p proteins and stores all candidates in @p filename
+
+      The file is written under a temporary name and renamed afterwards, so
+      concurrent runs never see a partially written cache.
+
+      @throw Exception::UnableToCreateFile if the file cannot be written
+    */
+    static void build(const std::vector<FASTAFile::FASTAEntry>& proteins, const Settings& settings, const String& key, const String& filename);
+
+    /**
+      @brief Memory-maps a cache file written by build()
+
+      @return false if the file does not exist or was built for a different @p key (the cache is left empty)
+
+      @throw Exception::ParseError if the file is not a valid cache file
+    */
+    bool load(const String& filename, const String& key);
+
+    /// Unmaps the cache file
+    void clear();
+
+    /// Number of candidates
+    Size size() const;
+
+    /// Mass of candidate @p index
+    double getMass(Size index) const;
+
+    /// Candidate @p index (ordered by mass)
+    Peptide getPeptide(Size index) const;
+
+    /// Index of the first candidate with a mass not smaller than @p mass
+    Size lowerBound(double mass) const;
+
+  protected:
+
+    /// On-disk record of a candidate
+    struct Entry_
+    {
+      double mass;
+      UInt64 unmodified_offset;
+      UInt64 modified_offset;
+      UInt32 unmodified_length;
+      UInt32 modified_length;
+      UInt64 mod_index;
+    };
+
+    boost::shared_ptr<boost::interprocess::mapped_region> mapped_file_;
+    const Entry_* entries_;
+    Size size_;
+    const char* sequences_;
+  };
+
+} // namespace OpenMS
+
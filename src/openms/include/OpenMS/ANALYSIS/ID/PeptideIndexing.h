@@ -36,6 +36,7 @@
 
 
 #include <OpenMS/ANALYSIS/ID/AhoCorasickAmbiguous.h>
+#include <OpenMS/ANALYSIS/ID/ProteinSuffixArray.h>
 #include <OpenMS/CHEMISTRY/ProteaseDigestion.h>
 #include <OpenMS/CHEMISTRY/ProteaseDB.h>
 #include <OpenMS/CONCEPT/LogStream.h>
@@ -153,8 +154,9 @@ public:
     /**
     @brief Re-index peptide identifications honoring enzyme cutting rules, ambiguous amino acids and target/decoy hits.
     
-    Template parameter 'T' can be either TFI_File or TFI_Vector. If the data is already available, use TFI_Vector and pass the vector.
-    If the data is still in a FASTA file and its not needed afterwards for additional processing, use TFI_File and pass the filename.
+    Template parameter 'T' can be either TFI_File, TFI_MMap or TFI_Vector. If the data is already available, use TFI_Vector and pass the vector.
+    If the data is still in a FASTA file, use TFI_MMap (or TFI_File, if the file cannot be memory-mapped) and pass the filename.
+    TFI_MMap reads the protein sequences and descriptions of the resulting protein hits directly from the mapped file, while TFI_File needs to seek and re-parse them.
 
     PeptideIndexer refreshes target/decoy information and mapping of peptides to proteins.
     The target/decoy information is crucial for the @ref TOPP_FalseDiscoveryRate tool. (For FDR calculations, "target+decoy" peptide hits count as target hits.)
@@ -305,6 +307,15 @@ public:
 
       bool invalid_protein_sequence = false; // check for proteins with modifications, i.e. '[' or '(', and throw an exception
 
+      if (search_backend_ == "suffix_array")
+      {
+        ExitCodes ret = searchSuffixArray_(proteins, pep_ids, enzyme, xtandem_fix_parameters, func, acc_to_prot, protein_is_decoy, protein_accessions, invalid_protein_sequence);
+        if (ret != EXECUTION_OK)
+        {
+          return ret;
+        }
+      }
+      else
       { // new scope - forget data after search
       
         /*
@@ -865,6 +876,234 @@ public:
       }
     }
 
+    /// key of the persistent suffix array index for a FASTA file (includes the sequence normalization)
+    String suffixArrayKey_(const FASTAContainer<TFI_File>& proteins) const
+    {
+      return ProteinSuffixArray::getKey(proteins.getFileName(), String("IL_equivalent=") + (IL_equivalent_ ? "true" : "false"));
+    }
+
+    /// key of the persistent suffix array index for a memory-mapped FASTA file (includes the sequence normalization)
+    String suffixArrayKey_(const FASTAContainer<TFI_MMap>& proteins) const
+    {
+      return ProteinSuffixArray::getKey(proteins.getFileName(), String("IL_equivalent=") + (IL_equivalent_ ? "true" : "false"));
+    }
+
+    /// in-memory databases are never indexed persistently (empty key)
+    String suffixArrayKey_(const FASTAContainer<TFI_Vector>&) const
+    {
+      return "";
+    }
+
+    /**
+      @brief Searches all peptides with a suffix array of the database instead of the Aho-Corasick trie
+
+      The index is loaded from @p index_file_ (if given and built from the same database with the same settings),
+      otherwise it is built from @p proteins and stored in @p index_file_.
+      Fills the same structures as the Aho-Corasick search in run().
+    */
+    template<typename T>
+    ExitCodes searchSuffixArray_(FASTAContainer<T>& proteins, const std::vector<PeptideIdentification>& pep_ids, const ProteaseDigestion& enzyme, bool xtandem_fix_parameters,
+                                 FoundProteinFunctor& func, Map<String, Size>& acc_to_prot, std::vector<bool>& protein_is_decoy,
+                                 std::vector<std::string>& protein_accessions, bool& invalid_protein_sequence)
+    {
+      /*
+      Peptides (in the same order as for Aho-Corasick, since results are iterated in the same way)
+      */
+      bool has_illegal_AAs(false);
+      Size nr_peptides(0);
+      std::map<String, std::vector<Size> > seq_to_peps; // identical sequences are searched only once
+      for (const PeptideIdentification& pep_id : pep_ids)
+      {
+        for (const PeptideHit& hit : pep_id.getHits())
+        {
+          String seq = hit.getSequence().toUnmodifiedString().remove('*');
+          if (seqan::isAmbiguous(seqan::AAString(seq.c_str())))
+          {
+            OPENMS_LOG_ERROR << "Peptide sequence '" << hit.getSequence() << "' contains one or more ambiguous amino acids (B|J|Z|X).\n";
+            has_illegal_AAs = true;
+          }
+          if (IL_equivalent_) // convert L to I;
+          {
+            seq.substitute('L', 'I');
+          }
+          seq_to_peps[seq].push_back(nr_peptides++);
+        }
+      }
+      if (has_illegal_AAs)
+      {
+        OPENMS_LOG_ERROR << "One or more peptides contained illegal amino acids. This is not allowed!"
+                  << "\nPlease either remove the peptide or replace it with one of the unambiguous ones (while allowing for ambiguous AA's to match the protein)." << std::endl;;
+      }
+      if (nr_peptides == 0)
+      {
+        OPENMS_LOG_WARN << "Warning: Peptide identifications have no hits inside! Output will be empty as well." << std::endl;
+        return PEPTIDE_IDS_EMPTY;
+      }
+
+      /*
+      Suffix array (load or build)
+      */
+      const size_t PROTEIN_CACHE_SIZE = 4e5;
+      StopWatch s;
+      s.start();
+      ProteinSuffixArray index;
+      const String key = suffixArrayKey_(proteins);
+      bool loaded(false);
+      if (!index_file_.empty())
+      {
+        if (key.empty())
+        {
+          OPENMS_LOG_WARN << "Warning: The database is not a FASTA file. Ignoring 'index_file'." << std::endl;
+        }
+        else
+        {
+          loaded = index.load(index_file_, key);
+          OPENMS_LOG_INFO << (loaded ? "Loaded" : "No matching") << " suffix array index '" << index_file_ << "'." << std::endl;
+        }
+      }
+
+      // stream the database to build the index (or to make sequences/descriptions available for annotation later)
+      if (!loaded || write_protein_sequence_ || write_protein_description_)
+      {
+        Size count_j_proteins(0);
+        this->startProgress(0, 1, loaded ? "Reading database" : "Building suffix array");
+        while (proteins.activateCache())
+        {
+          proteins.cacheChunk(PROTEIN_CACHE_SIZE);
+          if (loaded)
+          {
+            continue;
+          }
+          for (Size i = 0; i < proteins.chunkSize(); ++i)
+          {
+            String prot = proteins.chunkAt(i).sequence;
+            prot.remove('*');
+            if (prot.has('[') || prot.has('('))
+            {
+              invalid_protein_sequence = true;
+            }
+            if (IL_equivalent_)
+            {
+              prot.substitute('L', 'I');
+              prot.substitute('J', 'I');
+            }
+            else if (prot.has('J'))
+            {
+              ++count_j_proteins;
+            }
+            index.addProtein(proteins.chunkAt(i).identifier, prot);
+          }
+        }
+        if (!loaded)
+        {
+          index.build();
+          if (!index_file_.empty() && !key.empty())
+          {
+            index.store(index_file_, key);
+          }
+        }
+        this->endProgress();
+        if (count_j_proteins)
+        {
+          OPENMS_LOG_WARN << "PeptideIndexer found " << count_j_proteins << " protein sequences in your database containing the amino acid 'J'."
+            << "To match 'J' in a protein, an ambiguous amino acid placeholder for I/L will be used.\n"
+            << "This costs runtime and eats into the 'aaa_max' limit, leaving less opportunity for B/Z/X matches.\n"
+            << "If you want 'J' to be treated as unambiguous, enable '-IL_equivalent'!" << std::endl;
+        }
+      }
+      s.stop();
+      OPENMS_LOG_INFO << "Suffix array of " << index.size() << " proteins ready (" << int(s.getClockTime()) << "s)" << std::endl;
+      s.reset();
+
+      /*
+      Search
+      */
+      OPENMS_LOG_INFO << "Mapping " << nr_peptides << " peptides (" << seq_to_peps.size() << " distinct) with up to " << aaa_max_ << " ambiguous amino acid(s) and " << mm_max_ << " mismatch(es)!" << std::endl;
+      s.start();
+      std::vector<const std::pair<const String, std::vector<Size> >*> queries;
+      queries.reserve(seq_to_peps.size());
+      for (const auto& q : seq_to_peps)
+      {
+        queries.push_back(&q);
+      }
+      std::vector<bool> protein_found(index.size(), false);
+      this->startProgress(0, queries.size(), "Suffix array search");
+      std::atomic<int> progress_peps(0);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+      {
+        FoundProteinFunctor func_threads(enzyme, xtandem_fix_parameters);
+        std::vector<ProteinSuffixArray::Hit> hits;
+        std::vector<Size> found_thread;
+        String prot;
+        Size prot_idx = std::numeric_limits<Size>::max();
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 100) nowait
+#endif
+        for (SignedSize i = 0; i < (SignedSize)queries.size(); ++i)
+        {
+          ++progress_peps; // atomic
+          if (omp_get_thread_num() == 0)
+          {
+            this->setProgress(progress_peps);
+          }
+          const String& seq = queries[i]->first;
+          hits.clear();
+          index.findAll(seq, aaa_max_, mm_max_, hits);
+          std::sort(hits.begin(), hits.end(), [](const ProteinSuffixArray::Hit& a, const ProteinSuffixArray::Hit& b)
+          {
+            return a.protein_index != b.protein_index ? a.protein_index < b.protein_index : a.position < b.position;
+          });
+          for (const ProteinSuffixArray::Hit& hit : hits)
+          {
+            if (hit.protein_index != prot_idx)
+            {
+              prot_idx = hit.protein_index;
+              prot = index.getSequence(prot_idx).getString();
+              found_thread.push_back(prot_idx);
+            }
+            for (Size pep_idx : queries[i]->second)
+            {
+              func_threads.addHit(pep_idx, prot_idx, seq.size(), prot, (Int)hit.position);
+            }
+          }
+        }
+#ifdef _OPENMP
+#pragma omp critical(PeptideIndexer_joinSA)
+#endif
+        {
+          func.merge(func_threads);
+          for (Size p : found_thread)
+          {
+            protein_found[p] = true;
+          }
+        }
+      } // OMP end parallel
+      this->endProgress();
+
+      // accessions and decoy flags of the found proteins
+      protein_accessions.resize(index.size());
+      protein_is_decoy.resize(index.size());
+      for (Size p = 0; p < index.size(); ++p)
+      {
+        if (!protein_found[p])
+        {
+          continue;
+        }
+        const String acc = index.getAccession(p);
+        protein_is_decoy[p] = (prefix_ ? acc.hasPrefix(decoy_string_) : acc.hasSuffix(decoy_string_));
+        protein_accessions[p] = acc;
+        acc_to_prot[acc] = p;
+      }
+      s.stop();
+
+      OPENMS_LOG_INFO << "\nSuffix array search done (" << int(s.getClockTime()) << "s):\n  found " << func.filter_passed << " hits for " << func.pep_to_prot.size() << " of " << nr_peptides << " peptides.\n";
+      OPENMS_LOG_INFO << "Peptide hits passing enzyme filter: " << func.filter_passed << "\n"
+               << "     ... rejected by enzyme filter: " << func.filter_rejected << std::endl;
+      return EXECUTION_OK;
+    }
+
     void updateMembers_() override;
 
     String decoy_string_;
@@ -881,6 +1120,9 @@ public:
 
     Int aaa_max_;
     Int mm_max_;
+
+    String search_backend_;
+    String index_file_;
  };
 }
 
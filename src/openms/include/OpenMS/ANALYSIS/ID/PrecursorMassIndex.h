@@ -0,0 +1,244 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/CONCEPT/Types.h>
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace OpenMS
+{
+
+  /**
+    @brief A sorted, flat index of precursor masses
+
+    Maps precursor masses (e.g. of MS2 spectra, optionally corrected for isotope
+    misassignments) to a value (e.g. the scan index or additional precursor
+    information). It replaces a std::multimap<double, ValueType>: masses and
+    values are stored in two contiguous vectors, a range query returns the
+    positions [first, last) of all entries inside a mass window.
+
+    Entries with the same mass keep the order in which they were added (as in a
+    std::multimap). To support isotope-error offsets, add one entry per
+    corrected mass of a precursor (with the offset as part of the value).
+
+    Usage: add() all entries, then call build() once before querying.
+
+    Searches usually query candidates in ascending mass order. A Cursor remembers
+    the position of the last query and finds the next range by galloping forward
+    from there instead of doing a binary search over the whole index. Each thread
+    should use its own Cursor.
+  */
+  template <typename ValueType>
+  class PrecursorMassIndex
+  {
+  public:
+
+    /// Positions [first, last) of the entries in a mass window
+    typedef std::pair<Size, Size> Range;
+
+    /// Remembers the last query position, see class documentation
+    class Cursor
+    {
+    public:
+      explicit Cursor(const PrecursorMassIndex& index) :
+        index_(index),
+        pos_(0)
+      {
+      }
+
+      /// Same as PrecursorMassIndex::getRange(), but faster if queries are ascending
+      Range getRange(double min_mass, double max_mass)
+      {
+        index_.checkBuilt_();
+        const std::vector<double>& masses = index_.masses_;
+        if (pos_ > 0 && masses[pos_ - 1] >= min_mass)
+        { // query moved backwards: start over
+          pos_ = 0;
+        }
+        pos_ = gallop_(masses, pos_, min_mass, false);
+        const Size last = gallop_(masses, pos_, max_mass, true);
+        return Range(pos_, last);
+      }
+
+    private:
+      /// first position >= @p start with a mass not less than (or greater than, if @p upper) @p mass
+      static Size gallop_(const std::vector<double>& masses, Size start, double mass, bool upper)
+      {
+        const Size n = masses.size();
+        Size step = 1;
+        Size end = start;
+        while (end < n && (upper ? masses[end] <= mass : masses[end] < mass))
+        {
+          start = end + 1;
+          end += step;
+          step *= 2;
+        }
+        end = std::min(end, n);
+        std::vector<double>::const_iterator it = upper ?
+          std::upper_bound(masses.begin() + start, masses.begin() + end, mass) :
+          std::lower_bound(masses.begin() + start, masses.begin() + end, mass);
+        return it - masses.begin();
+      }
+
+      const PrecursorMassIndex& index_;
+      Size pos_;
+    };
+
+    /// Adds an entry (invalidates a previous build())
+    void add(double mass, const ValueType& value)
+    {
+      masses_.push_back(mass);
+      values_.push_back(value);
+      built_ = false;
+    }
+
+    /// Sorts the entries by mass
+    void build()
+    {
+      std::vector<Size> order(masses_.size());
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(), order.end(), [this](Size a, Size b) { return masses_[a] < masses_[b]; });
+
+      std::vector<double> masses;
+      std::vector<ValueType> values;
+      masses.reserve(order.size());
+      values.reserve(order.size());
+      for (Size i : order)
+      {
+        masses.push_back(masses_[i]);
+        values.push_back(values_[i]);
+      }
+      masses_.swap(masses);
+      values_.swap(values);
+      built_ = true;
+    }
+
+    /// Removes all entries
+    void clear()
+    {
+      masses_.clear();
+      values_.clear();
+      built_ = true;
+    }
+
+    /// Number of entries
+    Size size() const
+    {
+      return masses_.size();
+    }
+
+    /// Returns if the index has no entries
+    bool empty() const
+    {
+      return masses_.empty();
+    }
+
+    /// Mass of the entry at position @p pos (ordered by mass)
+    double getMass(Size pos) const
+    {
+      return masses_[pos];
+    }
+
+    /// Value of the entry at position @p pos (ordered by mass)
+    const ValueType& getValue(Size pos) const
+    {
+      return values_[pos];
+    }
+
+    /**
+      @brief Returns the positions of all entries with @p min_mass <= mass <= @p max_mass
+
+      @throw Exception::Precondition if build() was not called after the last add()
+    */
+    Range getRange(double min_mass, double max_mass) const
+    {
+      checkBuilt_();
+      const Size first = std::lower_bound(masses_.begin(), masses_.end(), min_mass) - masses_.begin();
+      const Size last = std::upper_bound(masses_.begin() + first, masses_.end(), max_mass) - masses_.begin();
+      return Range(first, std::max(first, last));
+    }
+
+    /// Returns if there is an entry with @p min_mass <= mass <= @p max_mass
+    bool hasMassInRange(double min_mass, double max_mass) const
+    {
+      const Range r = getRange(min_mass, max_mass);
+      return r.first != r.second;
+    }
+
+    /**
+      @brief Range queries for several mass windows
+
+      The windows do not need to be sorted, but queries are fastest if @p min_masses is ascending.
+
+      @param min_masses Lower bounds of the mass windows
+      @param max_masses Upper bounds of the mass windows (same size as @p min_masses)
+      @param ranges Output: one range per window
+    */
+    void getRanges(const std::vector<double>& min_masses, const std::vector<double>& max_masses, std::vector<Range>& ranges) const
+    {
+      if (min_masses.size() != max_masses.size())
+      {
+        throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, max_masses.size());
+      }
+      ranges.resize(min_masses.size());
+      Cursor cursor(*this);
+      for (Size i = 0; i < min_masses.size(); ++i)
+      {
+        ranges[i] = cursor.getRange(min_masses[i], max_masses[i]);
+      }
+    }
+
+  protected:
+
+    void checkBuilt_() const
+    {
+      if (!built_)
+      {
+        throw Exception::Precondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "PrecursorMassIndex::build() needs to be called before querying");
+      }
+    }
+
+    std::vector<double> masses_; ///< sorted precursor masses
+    std::vector<ValueType> values_; ///< value of each mass
+    bool built_ = true;
+  };
+}
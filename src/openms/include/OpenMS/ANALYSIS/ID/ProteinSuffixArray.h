@@ -0,0 +1,216 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <vector>
+
+namespace boost
+{
+  namespace interprocess
+  {
+    class mapped_region;
+  }
+}
+
+namespace OpenMS
+{
+
+  /**
+    @brief A persistent suffix array over a protein database, for looking up many peptides at once
+
+    All protein sequences are concatenated (separated by '\\0') and the
+    suffix array over this text is built once. Looking up a peptide is a
+    binary search per residue, independent of the size of the database, so
+    the expensive part (building the index) can be stored and shared by all
+    subsequent searches against the same database (see store() and load();
+    loaded indices are memory-mapped). After construction, all lookups are
+    const and can be done concurrently by multiple threads.
+
+    Ambiguous amino acids in the proteins (B, J, Z, X) and mismatches are
+    supported by backtracking over the suffix array intervals, with the same
+    semantics as AhoCorasickAmbiguous: an ambiguous amino acid in the protein
+    which covers the peptide residue costs one of @p aaa_max, any other
+    residue costs one of @p mm_max.
+
+    Sequences are stored as given, i.e. normalization (e.g. I/L) has to be
+    done by the caller, for proteins and peptides alike.
+
+    Usage:
+    @code
+    ProteinSuffixArray index;
+    String key = ProteinSuffixArray::getKey(fasta_file, "IL_equivalent=false");
+    if (!index.load(index_file, key))
+    {
+      for (...) index.addProtein(accession, sequence);
+      index.build();
+      index.store(index_file, key);
+    }
+    std::vector<ProteinSuffixArray::Hit> hits;
+    index.findAll("PEPTIDE", 2, 0, hits);
+    @endcode
+  */
+  class OPENMS_DLLAPI ProteinSuffixArray
+  {
+  public:
+
+    /// An occurrence of a peptide
+    struct Hit
+    {
+      Size protein_index; ///< index of the protein (in order of addProtein())
+      Size position; ///< 0-based start position of the peptide in the protein
+    };
+
+    /// Default constructor (empty index)
+    ProteinSuffixArray();
+
+    /// Destructor
+    ~ProteinSuffixArray();
+
+    /// Returns the key for @p fasta_file with additional @p settings (e.g. how sequences were normalized)
+    static String getKey(const String& fasta_file, const String& settings);
+
+    /**
+      @brief Adds a protein (before build())
+
+      @throw Exception::IllegalArgument if the index was already built or loaded
+    */
+    void addProtein(const String& accession, const String& sequence);
+
+    /// Builds the suffix array over all added proteins (in parallel if OpenMP is available)
+    void build();
+
+    /**
+      @brief Stores the index in @p filename (must be built)
+
+      The file is written under a temporary name and renamed afterwards, so
+      concurrent runs never see a partially written index.
+
+      @throw Exception::UnableToCreateFile if the file cannot be written
+    */
+    void store(const String& filename, const String& key) const;
+
+    /**
+      @brief Memory-maps an index file written by store()
+
+      @return false if the file does not exist or was built for a different @p key (the index is left empty)
+
+      @throw Exception::ParseError if the file is not a valid index file
+    */
+    bool load(const String& filename, const String& key);
+
+    /// Removes all proteins and unmaps a loaded index
+    void clear();
+
+    /// Number of proteins
+    Size size() const;
+
+    /// Accession of protein @p index
+    String getAccession(Size index) const;
+
+    /// Sequence of protein @p index
+    StringView getSequence(Size index) const;
+
+    /**
+      @brief Appends all occurrences of @p peptide to @p hits (in no particular order)
+
+      @param peptide Peptide sequence (must not contain ambiguous amino acids)
+      @param aaa_max Maximal number of ambiguous amino acids in the protein matched to a peptide residue
+      @param mm_max Maximal number of mismatches
+      @param hits Occurrences are appended here
+
+      Thread-safe (const) once the index was built or loaded.
+    */
+    void findAll(const String& peptide, Size aaa_max, Size mm_max, std::vector<Hit>& hits) const;
+
+    /**
+      @brief Finds the proteins that contain at least @p min_tags of the sequence @p tags (e.g. from Tagger)
+
+      This allows to prefilter the database for open or large searches: each
+      tag is looked up exactly (no ambiguous amino acids or mismatches), so a
+      query only depends on the number of tags and their occurrences, not on
+      the size of the database. Duplicate tags count once.
+
+      @param tags Sequence tags (normalized like the proteins)
+      @param min_tags Minimal number of different tags a protein has to contain (at least 1)
+      @param proteins Indices of the matching proteins (sorted, replaces the content)
+
+      Thread-safe (const) once the index was built or loaded.
+    */
+    void findProteins(const std::vector<std::string>& tags, Size min_tags, std::vector<Size>& proteins) const;
+
+  protected:
+
+    /// Narrows the suffix array interval [lo, hi) (which shares a prefix of length @p depth) to the suffixes with @p c at @p depth
+    void narrow_(Size lo, Size hi, Size depth, char c, Size& lo_out, Size& hi_out) const;
+
+    /// Recursive part of findAll()
+    void findAll_(const String& peptide, Size depth, Size lo, Size hi, Size aaa_left, Size mm_left, std::vector<Hit>& hits) const;
+
+    /// Character at @p depth of the suffix at suffix array position @p index ('\\0' beyond the text)
+    inline char charAt_(Size index, Size depth) const
+    {
+      const Size pos = suffix_array_[index] + depth;
+      return pos < text_size_ ? text_[pos] : '\0';
+    }
+
+    /// Sets the views below to the owned data
+    void updateViews_();
+
+    // views on either the owned data or the memory-mapped file
+    const char* text_;
+    Size text_size_;
+    const UInt64* suffix_array_;
+    const UInt64* protein_starts_; ///< nr. of proteins + 1 offsets into text_
+    const UInt64* accession_starts_; ///< nr. of proteins + 1 offsets into accessions_
+    const char* accessions_;
+    Size nr_proteins_;
+    bool built_;
+
+    // owned data (while adding proteins or after build())
+    std::string own_text_;
+    std::vector<UInt64> own_suffix_array_;
+    std::vector<UInt64> own_protein_starts_;
+    std::vector<UInt64> own_accession_starts_;
+    std::string own_accessions_;
+
+    boost::shared_ptr<boost::interprocess::mapped_region> mapped_file_;
+  };
+
+} // namespace OpenMS
@@ -35,7 +35,9 @@
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 #include <OpenMS/DATASTRUCTURES/DefaultParamHandler.h>
 
+#include <OpenMS/ANALYSIS/ID/FragmentIndex.h>
 #include <OpenMS/ANALYSIS/RNPXL/ModifiedPeptideGenerator.h>
+#include <OpenMS/FORMAT/FASTAFile.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 
 #include <vector>
@@ -65,6 +67,23 @@ class OPENMS_DLLAPI SimpleSearchEngineAlgorithm :
       const String& in_db, 
       std::vector<ProteinIdentification>& prot_ids,
       std::vector<PeptideIdentification>& pep_ids) const;
+
+    /**
+      @brief merge the results of sharded searches (see the 'shard' parameters) into the result of a single search
+
+      For every spectrum, the hits of all shards are combined, ranked and reduced to the top hits.
+      As every shard reports its own top hits, this yields the same hits and ranks as an unsharded search.
+      The merged hits are indexed against the whole database @p in_db.
+      The settings of this object need to match those used for the searches.
+
+      @param shard_protein_ids the protein identifications of every shard (one run per shard)
+      @param shard_peptide_ids the peptide identifications of every shard
+    */
+    ExitCodes mergeShards(const std::vector<std::vector<ProteinIdentification> >& shard_protein_ids,
+      const std::vector<std::vector<PeptideIdentification> >& shard_peptide_ids,
+      const String& in_db,
+      std::vector<ProteinIdentification>& prot_ids,
+      std::vector<PeptideIdentification>& pep_ids) const;
   protected:
     void updateMembers_() override;
 
@@ -85,9 +104,26 @@ class OPENMS_DLLAPI SimpleSearchEngineAlgorithm :
       }
     };
 
+    /// @brief the range [first, second) of the @p shard_index of @p shard_count consecutive shards of @p size elements
+    static std::pair<Size, Size> getShardRange_(Size size, Size shard_index, Size shard_count);
+
+    /// @brief append reversed decoys of all proteins to @p fasta_db and shuffle it
+    void appendDecoys_(std::vector<FASTAFile::FASTAEntry>& fasta_db) const;
+
+    /// @brief annotate @p peptide_ids with their proteins in @p fasta_db
+    ExitCodes indexPeptides_(std::vector<FASTAFile::FASTAEntry>& fasta_db,
+      std::vector<ProteinIdentification>& protein_ids,
+      std::vector<PeptideIdentification>& peptide_ids) const;
+
     /// @brief filter, deisotope, decharge spectra
     static void preprocessSpectra_(PeakMap& exp, double fragment_mass_tolerance, bool fragment_mass_tolerance_unit_ppm);
 
+    /// @brief digest @p fasta_db and add all (modified) candidate peptides to @p fragment_index
+    void buildFragmentIndex_(const std::vector<FASTAFile::FASTAEntry>& fasta_db,
+      const ModifiedPeptideGenerator::MapToResidueType& fixed_modifications,
+      const ModifiedPeptideGenerator::MapToResidueType& variable_modifications,
+      FragmentIndex& fragment_index) const;
+
     /// @brief filter and annotate search results
     /// most of the parameters are used to properly add meta data to the id objects
     void postProcessHits_(const PeakMap& exp, 
@@ -141,6 +177,17 @@ class OPENMS_DLLAPI SimpleSearchEngineAlgorithm :
     String peptide_motif_;
 
     Size report_top_hits_;
+
+    bool fragment_index_enabled_;
+    String fragment_index_file_;
+    Size fragment_index_min_matched_peaks_;
+
+    String digest_cache_directory_;
+
+    Size shard_database_count_;
+    Size shard_database_index_;
+    Size shard_spectrum_count_;
+    Size shard_spectrum_index_;
 };
 
 } // namespace
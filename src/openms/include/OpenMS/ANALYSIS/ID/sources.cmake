@@ -21,6 +21,7 @@ ConsensusMapMergerAlgorithm.h
 FalseDiscoveryRate.h
 FIAMSDataProcessor.h
 FIAMSScheduler.h
+FragmentIndex.h
 HiddenMarkovModel.h
 IDBoostGraph.h
 IDDecoyProbability.h
@@ -33,8 +34,11 @@ IDScoreSwitcherAlgorithm.h
 MessagePasserFactory.h
 MetaboliteSpectralMatching.h
 PeptideProteinResolution.h
+PrecursorMassIndex.h
 PrecursorPurity.h
+ProteinSuffixArray.h
 ProtonDistributionModel.h
+PeptideDigestCache.h
 PeptideIndexing.h
 PercolatorFeatureSetHelper.h
 SimpleSearchEngineAlgorithm.h
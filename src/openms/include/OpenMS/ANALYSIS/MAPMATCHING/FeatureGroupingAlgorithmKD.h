@@ -38,6 +38,9 @@
 #include <OpenMS/ANALYSIS/QUANTITATION/KDTreeFeatureMaps.h>
 #include <OpenMS/ANALYSIS/MAPMATCHING/FeatureDistance.h>
 #include <OpenMS/CONCEPT/ProgressLogger.h>
+#include <OpenMS/DATASTRUCTURES/ListUtils.h>
+
+#include <functional>
 
 namespace OpenMS
 {
@@ -171,6 +174,12 @@ private:
       The algorithm takes a number of feature or consensus maps and searches
       for corresponding (consensus) features across different maps.
 
+      For cohorts too large to hold all input maps in memory, groupFromFiles()
+      links feature maps stored as ColumnarFeatureFile. The maps are then
+      streamed from disk in m/z slabs (the partitions defined by
+      @p nr_partitions), so only the features of one slab are in memory at a
+      time.
+
       @htmlinclude OpenMS_FeatureGroupingAlgorithmKD.parameters
 
       @ingroup FeatureGrouping
@@ -203,6 +212,45 @@ public:
     void group(const std::vector<ConsensusMap>& maps,
                        ConsensusMap& out) override;
 
+    /**
+        @brief Applies the algorithm to feature maps stored on disk
+
+        @p files are ColumnarFeatureFile files holding feature maps whose
+        features are sorted by m/z (see FeatureMap::sortByMZ()). The maps are
+        processed one m/z partition at a time, i.e. the features of at most one
+        partition are kept in memory (use a larger value of @p nr_partitions to
+        reduce memory usage). Only the consensus features are added to @p out;
+        column headers, protein and unassigned peptide identifications have to
+        be set by the caller. ColumnarFeatureFile does not store peptide
+        identifications, so the caller also has to add the identifications
+        assigned to the input features (annotated with "map_index").
+
+        @exception IllegalArgument is thrown if less than two files are given,
+        if a file contains a consensus map or if its features are not sorted by m/z.
+    */
+    void groupFromFiles(const StringList& files, ConsensusMap& out);
+
+    /**
+        @brief Adds the features of new maps to an existing linking result
+
+        Instead of linking all maps again, the features of @p maps are matched
+        against the centroids of the consensus features in @p consensus (using
+        the linking tolerances and charge/adduct settings). Every consensus
+        feature receives at most one feature per new map; closest pairs (by
+        feature distance) are assigned first. Matched consensus features are
+        updated in place, the remaining new features are linked among each
+        other and added as new consensus features. The work is therefore
+        proportional to the new data (plus a kd-tree on the centroids).
+
+        The new maps get the map indices following the largest one in the
+        column headers of @p consensus. Their column headers, protein and
+        unassigned peptide identifications are added to @p consensus.
+
+        @note No RT warping is done ("warp:" parameters are ignored), i.e. the
+        new maps should already be aligned to the consensus map.
+    */
+    void addToConsensus(const std::vector<FeatureMap>& maps, ConsensusMap& consensus);
+
     /// Creates a new instance of this class (for Factory)
     static FeatureGroupingAlgorithm* create()
     {
@@ -231,6 +279,19 @@ private:
     template <typename MapType>
     void group_(const std::vector<MapType>& input_maps, ConsensusMap& out);
 
+    /// Sets up tolerances and the distance functor from the parameters
+    void setUpParameters_(double max_intensity);
+
+    /**
+        @brief Computes the m/z partition boundaries
+
+        @p next_mz delivers the @p nr_points m/z values of all input features in
+        ascending order (and returns false once they are exhausted). Partition
+        boundaries are only placed in m/z gaps larger than the tolerances, so no
+        cluster can reach across a boundary.
+    */
+    std::vector<double> computePartitionBoundaries_(Size nr_points, const std::function<bool(double&)>& next_mz) const;
+
     /// Run the actual clustering algorithm
     void runClustering_(const KDTreeFeatureMaps& kd_data, ConsensusMap& out);
 
@@ -240,6 +301,9 @@ private:
     /// Compute the current best cluster with center index @p i (mutates @p proxy and @p cf_indices)
     ClusterProxyKD computeBestClusterForCenter_(Size i, std::vector<Size>& cf_indices, const std::vector<Int>& assigned, const KDTreeFeatureMaps& kd_data) const;
 
+    /// Check whether feature @p other may be grouped with @p center, according to the charge and adduct merging settings
+    bool isCompatible_(const BaseFeature& center, const BaseFeature& other, const String& merge_charge, const String& merge_adduct) const;
+
     /// Construct consensus feature and add to out map
     void addConsensusFeature_(const std::vector<Size>& indices, const KDTreeFeatureMaps& kd_data, ConsensusMap& out) const;
 
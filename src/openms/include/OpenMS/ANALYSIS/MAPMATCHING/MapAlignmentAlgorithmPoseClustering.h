@@ -57,6 +57,10 @@ namespace OpenMS
     computation, smaller values might lead to no or unstable trafos. Set to -1
     to use all features (might take very long for large maps).
 
+    The reference is only read during alignment, and align() keeps all other
+    state local to the call, so several maps can be aligned to the same
+    reference concurrently (e.g. from an OpenMP loop).
+
     For further details see:
     @n Eva Lange et al.
     @n A Geometric Approach for the Alignment of Liquid Chromatography-Mass Spectrometry Data
@@ -78,9 +82,12 @@ public:
     /// Destructor
     ~MapAlignmentAlgorithmPoseClustering() override;
 
-    void align(const FeatureMap& map, TransformationDescription& trafo);
-    void align(const PeakMap& map, TransformationDescription& trafo);
-    void align(const ConsensusMap& map, TransformationDescription& trafo);
+    /// Aligns @p map to the reference (thread-safe, see class documentation)
+    void align(const FeatureMap& map, TransformationDescription& trafo) const;
+    /// Aligns @p map to the reference (thread-safe, see class documentation)
+    void align(const PeakMap& map, TransformationDescription& trafo) const;
+    /// Aligns @p map to the reference (thread-safe, see class documentation)
+    void align(const ConsensusMap& map, TransformationDescription& trafo) const;
 
     /// Sets the reference for the alignment
     template <typename MapType>
@@ -94,8 +101,13 @@ protected:
 
     void updateMembers_() override;
 
+    /// Aligns the (converted) map @p map_scene to the reference; @p map_scene is modified
+    void alignScene_(ConsensusMap& map_scene, TransformationDescription& trafo) const;
+
+    /// Superimposer holding the parameters (align() runs a copy of it)
     PoseClusteringAffineSuperimposer superimposer_;
 
+    /// Pair finder holding the parameters (align() runs a copy of it)
     StablePairFinder pairfinder_;
 
     ConsensusMap reference_;
@@ -37,6 +37,7 @@
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 #include <OpenMS/DATASTRUCTURES/DefaultParamHandler.h>
 #include <OpenMS/DATASTRUCTURES/BinaryTreeNode.h>
+#include <OpenMS/DATASTRUCTURES/DistanceMatrix.h>
 #include <OpenMS/APPLICATIONS/MapAlignerBase.h>
 #include <OpenMS/ANALYSIS/MAPMATCHING/MapAlignmentAlgorithmIdentification.h>
 
@@ -88,9 +89,28 @@ public:
     */
     static void buildTree(std::vector<FeatureMap>& feature_maps, std::vector<BinaryTreeNode>& tree, std::vector<std::vector<double>>& maps_ranges);
 
+    /**
+     * @brief Same as above, but reuses (and returns) the pairwise distances between the maps.
+     *
+     * The distances of the first @p dist_matrix.dimensionsize() maps are taken from @p dist_matrix, only the rows of the
+     * remaining maps are computed (in parallel). This way, adding a few maps to a large, already clustered cohort only
+     * requires the distances of the new maps. On return, @p dist_matrix holds the distances of all maps (1 - similarity).
+     * If @p dist_matrix is larger than the number of maps, it is recomputed completely.
+     *
+     * @param feature_maps Vector of input maps (FeatureMap) whose distance is to be calculated.
+     * @param tree Vector of BinaryTreeNodes that will be computed
+     * @param maps_ranges Vector to store all sorted RTs of extracted identifications for each map in @p feature_maps; needed to determine the 10/90 percentiles
+     * @param dist_matrix Distances of the maps that were already computed for the first maps in @p feature_maps (input/output)
+    */
+    static void buildTree(std::vector<FeatureMap>& feature_maps, std::vector<BinaryTreeNode>& tree, std::vector<std::vector<double>>& maps_ranges,
+                          DistanceMatrix<float>& dist_matrix);
+
     /**
      * @brief Align feature maps tree guided using align() of @ref OpenMS::MapAlignmentAlgorithmIdentification and use TreeNode with larger 10/90 percentile range as reference.
      *
+     * Tree nodes that merge disjoint clusters whose own subtrees are already aligned are independent of each other and
+     * are aligned in parallel.
+     *
      * @param tree Vector of BinaryTreeNodes that contains order for alignment.
      * @param feature_maps_transformed Vector with input maps for transformation process. Because the transformed maps are stored within this vector it's not const.
      * @param maps_ranges Vector that contains all sorted RTs of extracted identifications for each map; needed to determine the 10/90 percentiles.
@@ -46,7 +46,6 @@
 
 #include <list>
 #include <vector>
-#include <unordered_set>
 #include <utility> // for pair<>
 
 namespace OpenMS
@@ -92,7 +91,11 @@ namespace OpenMS
    This algorithm includes a number of optimizations to reduce run-time:
    @li two-dimensional hashing of features,
    @li a look-up table for feature distances,
-   @li a variant of QT clustering that requires only one round of clustering.
+   @li a variant of QT clustering that requires only one round of clustering,
+   @li partitioning of the m/z axis at gaps larger than the m/z tolerance
+       (@p nr_partitions); no cluster can span two partitions, so the
+       partitions are clustered independently and in parallel (if OpenMP is
+       enabled). The result is the same as for sequential processing.
 
    @see FeatureGroupingAlgorithmQT
 
@@ -111,9 +114,8 @@ namespace OpenMS
               std::pair<OpenMS::GridFeature*, OpenMS::GridFeature*>,
               double> PairDistances;
 
-    /// Map to store which grid features are next to which clusters (saves the clusters ids)
-    typedef OpenMSBoost::unordered_map<
-              const OpenMS::GridFeature*, std::unordered_set<Size> > ElementMapping;
+    /// Stores which grid features are next to which clusters (saves the cluster ids, indexed by the position of the grid feature, see elementIndex_())
+    typedef std::vector<std::vector<Size> > ElementMapping;
 
     /// Heap to efficiently find the best clusters
     typedef boost::heap::fibonacci_heap<QTCluster> Heap;
@@ -133,14 +135,20 @@ namespace OpenMS
     /// Maximum m/z difference
     double max_diff_mz_;
 
-    /// Maximum m/z difference
+    /// Number of m/z partitions
     int nr_partitions_;
 
     /// Feature distance functor
     FeatureDistance feature_distance_;
 
-    /// Set of features already used
-    std::unordered_set<const OpenMS::GridFeature*> already_used_;
+    /// Flags for features already used (indexed like the element mapping)
+    std::vector<bool> already_used_;
+
+    /// Position of the first grid feature of each input map (in the element mapping)
+    std::vector<Size> map_offsets_;
+
+    /// Returns the position of a grid feature in the element mapping and in already_used_
+    Size elementIndex_(const OpenMS::GridFeature* feature) const;
 
     /**
        @brief Calculates the distance between two grid features.
@@ -101,6 +101,15 @@ namespace OpenMS
 
     /// Evaluates the model at the given value
     virtual double evaluate(double value) const;
+
+    /**
+      @brief Evaluates the model at each of the given values (in place)
+
+      Gives the same results as calling evaluate(double) on every element.
+      Derived models may override this to exploit sorted input (e.g. the scan
+      times of a map), which avoids a separate lookup for every single value.
+    */
+    virtual void evaluateBatch(std::vector<double>& values) const;
     
     /**
     @brief Weight the data by the given weight function
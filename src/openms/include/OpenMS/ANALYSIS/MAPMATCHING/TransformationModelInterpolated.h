@@ -94,6 +94,17 @@ public:
      */
     double evaluate(double value) const override;
 
+    /**
+     * @brief Evaluate the interpolation model at each of the given values (in place)
+     *
+     * If @p values is sorted, the values below and above the data range are
+     * located once and the remaining values are interpolated in a single
+     * sweep over the data points. Unsorted input is evaluated value by value.
+     *
+     * @param values The positions where the model should be evaluated; replaced by the results.
+     */
+    void evaluateBatch(std::vector<double>& values) const override;
+
     /// Gets the default parameters
     static void getDefaultParameters(Param& params);
 
@@ -125,6 +136,22 @@ public:
        */
       virtual double eval(const double& x) const = 0;
 
+      /**
+       * @brief Evaluate the underlying interpolation at a sorted range of positions (in place).
+       *
+       * All positions must lie within the data range. The default implementation calls eval() for each position.
+       *
+       * @param first Begin of the (sorted) range of positions.
+       * @param last End of the range.
+       */
+      virtual void evalSorted(std::vector<double>::iterator first, std::vector<double>::iterator last) const
+      {
+        for (; first != last; ++first)
+        {
+          *first = eval(*first);
+        }
+      }
+
       /**
        * @brief d'tor.
        */
@@ -72,6 +72,9 @@ public:
     /// Evaluates the model at the given value
     double evaluate(double value) const override;
 
+    /// Evaluates the model at each of the given values (in place)
+    void evaluateBatch(std::vector<double>& values) const override;
+
     using TransformationModel::getParameters;
 
     /// Gets the "real" parameters
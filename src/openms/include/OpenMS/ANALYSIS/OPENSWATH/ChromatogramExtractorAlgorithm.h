@@ -180,6 +180,29 @@ public:
                               const double im_extraction_window,
                               const bool ppm);
 
+    /**
+     * @brief Extract the integrated intensity of many m/z windows from a single spectrum at once.
+     *
+     * Sums up all intensities with left[k] < m/z < right[k] for every window
+     * k (tophat filter). Since both the spectrum and the windows are sorted,
+     * the window bounds are found in a single merge over the spectrum,
+     * skipping ahead exponentially over regions without windows.
+     *
+     * @param mz_array The m/z values of the spectrum (sorted ascending)
+     * @param int_array The intensity values of the spectrum
+     * @param left Lower (exclusive) bounds of the windows, sorted ascending
+     * @param right Upper (exclusive) bounds of the windows, sorted ascending
+     * @param integrated_intensities Resulting intensities, one per window (will be overwritten)
+     *
+     * @note The result is undefined if the spectrum or the windows are not sorted.
+     *
+    */
+    static void extract_values_tophat(const std::vector<double>& mz_array,
+                                      const std::vector<double>& int_array,
+                                      const std::vector<double>& left,
+                                      const std::vector<double>& right,
+                                      std::vector<double>& integrated_intensities);
+
 private:
 
     int getFilterNr_(const String& filter);
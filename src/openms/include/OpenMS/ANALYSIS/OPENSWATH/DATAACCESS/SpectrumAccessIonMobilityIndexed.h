@@ -0,0 +1,177 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessOpenMSInMemory.h>
+
+#include <OpenMS/OPENSWATHALGO/DATAACCESS/DataStructures.h>
+
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+   * @brief An in-memory implementation of the OpenSWATH Spectrum Access interface with an ion mobility index
+   *
+   * For ion mobility data (e.g. diaPASEF), each spectrum is a frame that
+   * contains the peaks of all ion mobility scans sorted by m/z. Selecting the
+   * peaks of a small (m/z, ion mobility) region from such a frame requires a
+   * scan over all ion mobility values in the m/z window.
+   *
+   * In addition to keeping all data in memory (see
+   * SpectrumAccessOpenMSInMemory), this class creates a FrameIndex for each
+   * spectrum that has an ion mobility array. The FrameIndex groups the peaks
+   * into equally sized ion mobility buckets, each sorted by m/z, such that a
+   * query only looks at the buckets that overlap with the requested ion
+   * mobility range and can use binary search on m/z within each bucket. The
+   * spectra themselves are returned unchanged (sorted by m/z).
+   *
+   * ChromatogramExtractorAlgorithm automatically uses the index when
+   * extracting with an ion mobility window from this type of spectrum access.
+   *
+  */
+  class OPENMS_DLLAPI SpectrumAccessIonMobilityIndexed :
+    public SpectrumAccessOpenMSInMemory
+  {
+public:
+
+    /**
+     * @brief Peaks of a single frame, bucketed by ion mobility and sorted by m/z within each bucket
+     */
+    class OPENMS_DLLAPI FrameIndex
+    {
+public:
+      /**
+       * @brief Creates the index for a single frame
+       *
+       * @param frame Spectrum sorted by m/z which needs to have an ion mobility array
+       * @param nr_buckets Number of ion mobility buckets spanning the ion mobility range of the frame
+       *
+       * @throw Exception::IllegalArgument if no ion mobility array is present
+       */
+      FrameIndex(const OpenSwath::Spectrum& frame, Size nr_buckets);
+
+      /**
+       * @brief Sum of intensities of all peaks with left < m/z < right and left_im < ion mobility < right_im
+       */
+      double integrate(double left, double right, double left_im, double right_im) const;
+
+      /**
+       * @brief Calls @p f(mz, im, intensity) for all peaks in the buckets overlapping [left_im, right_im] with left <= m/z <= right
+       *
+       * The peaks of each bucket are visited in m/z order. Peaks in the
+       * border buckets may lie outside of the ion mobility range, @p f is
+       * expected to apply the exact ion mobility (and m/z) criteria.
+       */
+      template <typename FunctorType>
+      void forEachPeak(double left, double right, double left_im, double right_im, FunctorType f) const
+      {
+        if (mz_.empty() || right_im < im_min_ || right < left) return;
+        Size first_bucket = bucketIndex_(left_im), last_bucket = bucketIndex_(right_im);
+        for (Size b = first_bucket; b <= last_bucket; ++b)
+        {
+          auto bucket_begin = mz_.begin() + bucket_start_[b];
+          auto bucket_end = mz_.begin() + bucket_start_[b + 1];
+          for (auto it = std::lower_bound(bucket_begin, bucket_end, left); it != bucket_end && *it <= right; ++it)
+          {
+            Size k = std::distance(mz_.begin(), it);
+            f(*it, im_[k], intensity_[k]);
+          }
+        }
+      }
+
+      /// Number of ion mobility buckets
+      Size getNrBuckets() const
+      {
+        return bucket_start_.size() - 1;
+      }
+
+      /// Number of peaks in the frame
+      Size size() const
+      {
+        return mz_.size();
+      }
+
+protected:
+
+      /// Bucket containing ion mobility @p im (clamped to the valid buckets)
+      Size bucketIndex_(double im) const;
+
+      double im_min_;
+      double bucket_width_;
+      /// first peak of each bucket (plus the end of the last bucket)
+      std::vector<Size> bucket_start_;
+      std::vector<double> mz_;
+      std::vector<double> im_;
+      std::vector<double> intensity_;
+    };
+
+    typedef boost::shared_ptr<const FrameIndex> FrameIndexPtr;
+
+    /**
+     * @brief Constructor
+     *
+     * @param origin Spectra to be copied into memory
+     * @param nr_buckets Number of ion mobility buckets per frame
+     *
+     */
+    explicit SpectrumAccessIonMobilityIndexed(OpenSwath::ISpectrumAccess & origin, Size nr_buckets = 128);
+
+    /// Destructor
+    ~SpectrumAccessIonMobilityIndexed() override;
+
+    /// Copy constructor (shares the data and the indices)
+    SpectrumAccessIonMobilityIndexed(const SpectrumAccessIonMobilityIndexed & rhs);
+
+    /// Light clone operator (actual data will not get copied)
+    boost::shared_ptr<OpenSwath::ISpectrumAccess> lightClone() const override;
+
+    /**
+     * @brief Returns the ion mobility index of spectrum @p id
+     *
+     * @return The index or a null pointer if the spectrum has no ion mobility data
+     */
+    FrameIndexPtr getFrameIndex(int id) const;
+
+private:
+
+    std::vector<FrameIndexPtr> frame_indices_;
+
+  };
+
+} //end namespace OpenMS
+
@@ -55,10 +55,14 @@ namespace OpenMS
     (ISpectrumAccess) using the CachedmzML class which is able to read and
     write a cached mzML file.
 
-    @note This implementation is @a not thread-safe since it keeps internally a
-    single file access pointer which it moves when accessing a specific
-    data item. The caller is responsible to ensure that access is performed
-    atomically.
+    The cached file is memory-mapped if possible (see CachedmzML), in that
+    case data items are read directly from memory and light clones share the
+    mapping instead of opening their own file handle.
+
+    @note This implementation is @a not thread-safe if the file could not be
+    memory-mapped, since it then keeps internally a single file access
+    pointer which it moves when accessing a specific data item. The caller
+    is responsible to ensure that access is performed atomically.
 
   */
   class OPENMS_DLLAPI SpectrumAccessOpenMSCached :
@@ -81,6 +85,26 @@ public:
     */
     explicit SpectrumAccessOpenMSCached(const String& filename);
 
+    /**
+      @brief Constructor, maps a cached file whose meta data and index are already known
+
+      This avoids parsing the meta data file @p filename and scanning the
+      cached file, e.g. directly after the cached file was written by
+      MSDataCachedConsumer (which records the index while writing).
+
+      @param filename The filename of the .mzML file (it is assumed a second
+      file .mzML.cached exists, the .mzML file itself is not read).
+      @param meta_data Meta data of all spectra and chromatograms in the cached file
+      @param spectra_index Positions of the spectra in the cached file
+      @param chrom_index Positions of the chromatograms in the cached file
+
+      @throws Exception::FileNotFound is thrown if the cached file is not found
+      @throws Exception::IllegalArgument is thrown if the index does not match the meta data
+    */
+    SpectrumAccessOpenMSCached(const String& filename, MSExperimentType meta_data,
+                               const std::vector<std::streampos>& spectra_index,
+                               const std::vector<std::streampos>& chrom_index);
+
     /**
       @brief Destructor
     */
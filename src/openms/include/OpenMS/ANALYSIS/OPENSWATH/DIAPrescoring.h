@@ -77,6 +77,28 @@ public:
 
     void updateMembers_() override;
 
+    /**
+      @brief The part of the scoring of a transition group that does not depend on the spectrum.
+
+      Computed once per transition group by computeTheoreticalSpectrum() and
+      reused for every spectrum that is scored against the group.
+    */
+    struct TheoreticalSpectrum
+    {
+      /// m/z of the isotope (and pre-isotope) peaks, sorted
+      std::vector<double> masses;
+      /// square root of the intensities, normalized by their sum (manhattan score)
+      std::vector<double> manhattan_intensities;
+      /// square root of the intensities, normalized by their norm (dotprod score)
+      std::vector<double> dotprod_intensities;
+      /// manhattan score of a spectrum without signal in any of the windows
+      double empty_manhattan = 0.0;
+    };
+
+    /// Simulate the theoretical spectrum of a transition group from its library intensities
+    void computeTheoreticalSpectrum(const std::vector<OpenSwath::LightTransition>& lt,
+                                    TheoreticalSpectrum& theo) const;
+
     /**
       @brief Score a spectrum given a transition group.
 
@@ -87,15 +109,36 @@ public:
     void score(OpenSwath::SpectrumPtr spec,
                const std::vector<OpenSwath::LightTransition>& lt,
                double& dotprod,
-               double& manhattan);
+               double& manhattan) const;
+
+    /// Score a spectrum given the (precomputed) theoretical spectrum of a transition group
+    void score(OpenSwath::SpectrumPtr spec,
+               const TheoreticalSpectrum& theo,
+               double& dotprod,
+               double& manhattan) const;
 
     /**
       @brief Compute manhattan and dotprod score for all spectra which can be accessed by
       the SpectrumAccessPtr for all transitions groups in the LightTargetedExperiment.
+
+      The theoretical spectra are computed once per transition group and the
+      spectra are scored in parallel. Transition groups without any peak in the
+      m/z range of a spectrum are not integrated, they get the scores of an
+      empty spectrum.
     */
     void operator()(OpenSwath::SpectrumAccessPtr swath_ptr,
                     OpenSwath::LightTargetedExperiment& transition_exp_used,
                     OpenSwath::IDataFrameWriter* ivw);
+
+private:
+
+    /// score() using the buffers @p int_exp and @p mz_exp (reused between calls)
+    void score_(const OpenSwath::SpectrumPtr& spec,
+                const TheoreticalSpectrum& theo,
+                std::vector<double>& int_exp,
+                std::vector<double>& mz_exp,
+                double& dotprod,
+                double& manhattan) const;
   };
 
 
@@ -214,6 +214,22 @@ protected:
                                                       const FragmentSeqMap& ions,
                                                       const double mz_threshold);
 
+    /**
+      @brief Same as getMatchingPeptidoforms_(), but uses a binary search on @p ions, which have to be sorted by m/z (see sortIonMap_())
+
+      @param fragment_ion the queried fragment ion
+      @param ions a vector of pairs of fragment ion m/z and peptide sequences which could interfere with fragment_ion, sorted by m/z
+      @param mz_threshold the threshold within which to search for interferences
+
+      @return a vector of strings containing all peptidoforms with which fragment_ion overlaps
+    */
+    std::vector<std::string> getMatchingPeptidoformsSorted_(const double fragment_ion,
+                                                            const FragmentSeqMap& ions,
+                                                            const double mz_threshold);
+
+    /// Sorts all fragment ion lists of @p ion_map by m/z (as required by getMatchingPeptidoformsSorted_())
+    void sortIonMap_(IonMapT& ion_map);
+
     /**
       @brief Get swath index (precursor isolation window ordinal) for a particular precursor
 
@@ -309,6 +325,7 @@ protected:
       
       Then store the ion series for each of these theoretical fragment ions in
       the provided maps TargetSequenceMap, TargetIonMap, TargetPeptideMap.
+      The fragment ion lists of TargetIonMap are sorted by m/z. Peptides are processed in parallel.
 
       @details Used internally by the IPF algorithm, see MRMAssay::uisTransitions()
 
@@ -345,7 +362,7 @@ protected:
       For each decoy peptide sequence, compute all alternative peptidoforms
       using all modification-carrying residue permutations (n choose k
       possibilities) that are physicochemically possible according to
-      ModificationsDB.
+      ModificationsDB. The fragment ion lists of DecoyIonMap are sorted by m/z.
 
       @details Used internally by the IPF algorithm, see MRMAssay::uisTransitions()
 
@@ -117,6 +117,14 @@ public:
 
       Bruderer et al. Mol Cell Proteomics. 2017. 10.1074/mcp.RA117.000314.
 
+      Decoys whose sequence (including modifications) equals the sequence of
+      any target peptide are removed (except for the "shift" method).
+
+      Peptides are processed in parallel. All random choices (peptide
+      selection, shuffling, K/R switching) are derived from @p seed and the
+      index of the target peptide, so the result for a given seed does not
+      depend on the number of threads (-1: seed based on the current time).
+
     */
     void generateDecoys(const OpenMS::TargetedExperiment& exp,
                         OpenMS::TargetedExperiment& dec,
@@ -133,7 +141,8 @@ public:
                         const std::vector<size_t>& fragment_charges,
                         const bool enable_specific_losses,
                         const bool enable_unspecific_losses,
-                        const int round_decPow = -4) const;
+                        const int round_decPow = -4,
+                        const int seed = -1) const;
 
     typedef std::vector<OpenMS::TargetedExperiment::Protein> ProteinVectorType;
     typedef std::vector<OpenMS::TargetedExperiment::Peptide> PeptideVectorType;
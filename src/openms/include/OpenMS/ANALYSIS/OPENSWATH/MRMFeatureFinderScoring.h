@@ -147,6 +147,10 @@ public:
      *                  data is available.
      * @param transition_group_map Output mapping of transition groups
      *
+     * The transition groups are picked and scored in parallel (using one
+     * picker, set of scoring objects and clone of the spectrum access per
+     * thread); the features are reported in the order of @p transition_group_map.
+     *
     */
     void pickExperiment(OpenSwath::SpectrumAccessPtr input,
                         FeatureMap& output,
@@ -209,6 +213,18 @@ public:
       ms1_map_ = ms1_map;
     }
 
+    /** @brief Set caches for added-up spectra (see OpenSwathScoring::setSpectrumAdditionCaches)
+     *
+     * @param ms2_cache Cache for the SWATH map (may be null)
+     * @param ms1_cache Cache for the MS1 map (may be null)
+     *
+    */
+    void setSpectrumAdditionCaches(SpectrumAdditionCachePtr ms2_cache, SpectrumAdditionCachePtr ms1_cache)
+    {
+      ms2_spectrum_cache_ = ms2_cache;
+      ms1_spectrum_cache_ = ms1_cache;
+    }
+
     /** @brief Map the chromatograms to the transitions.
      *
      * Map an input chromatogram experiment (mzML) and transition list (TraML)
@@ -315,6 +331,10 @@ private:
     // data
     OpenSwath::SpectrumAccessPtr ms1_map_;
 
+    /// shared caches of added-up spectra (optional)
+    SpectrumAdditionCachePtr ms2_spectrum_cache_;
+    SpectrumAdditionCachePtr ms1_spectrum_cache_;
+
   };
 }
 
@@ -51,6 +51,7 @@
 #include <OpenMS/OPENSWATHALGO/ALGO/Scoring.h>
 #include <OpenMS/OPENSWATHALGO/ALGO/StatsHelpers.h>
 
+#include <algorithm>
 #include <numeric>
 
 //#define DEBUG_TRANSITIONGROUPPICKER
@@ -161,6 +162,7 @@ public:
       // and terminate.
       int chr_idx, peak_idx, cnt = 0;
       std::vector<MRMFeature> features;
+      TransitionTotals_ totals; // the same for all features of the group
       while (true)
       {
         chr_idx = -1; peak_idx = -1;
@@ -181,7 +183,7 @@ public:
         }
 
         // Compute a feature from the individual chromatograms and add non-zero features
-        MRMFeature mrm_feature = createMRMFeature(transition_group, picked_chroms, smoothed_chroms, chr_idx, peak_idx);
+        MRMFeature mrm_feature = createMRMFeature_(transition_group, picked_chroms, smoothed_chroms, chr_idx, peak_idx, totals);
         double total_xic = 0;
         double intensity = mrm_feature.getIntensity();
         if (intensity > 0)
@@ -224,6 +226,297 @@ public:
                                 const std::vector<SpectrumT>& smoothed_chroms,
                                 const int chr_idx,
                                 const int peak_idx)
+    {
+      TransitionTotals_ totals;
+      return createMRMFeature_(transition_group, picked_chroms, smoothed_chroms, chr_idx, peak_idx, totals);
+    }
+
+    /** 
+     
+      @brief Apex-based peak picking
+
+      Pick the peak with the closest apex to the consensus apex for each
+      chromatogram.  Use the closest peak for the current peak. 
+      
+      Note that we will only set the closest peak per chromatogram to zero, so
+      if there are two peaks for some transitions, we will have to get to them
+      later.  If there is no peak, then we transfer transition boundaries from
+      "master" peak.
+    */
+    template <typename SpectrumT>
+    void pickApex(std::vector<SpectrumT>& picked_chroms,
+                  const double best_left, const double best_right, const double peak_apex,
+                  double &min_left, double &max_right, 
+                  std::vector< double > & left_edges, std::vector< double > & right_edges)
+    {
+      for (Size k = 0; k < picked_chroms.size(); k++)
+      {
+        double peak_apex_dist_min = std::numeric_limits<double>::max();
+        int min_dist = -1;
+        for (Size i = 0; i < picked_chroms[k].size(); i++)
+        {
+          PeakIntegrator::PeakArea pa_tmp = pi_.integratePeak(  // get the peak apex
+              picked_chroms[k],
+              picked_chroms[k].getFloatDataArrays()[PeakPickerMRM::IDX_LEFTBORDER][i], 
+              picked_chroms[k].getFloatDataArrays()[PeakPickerMRM::IDX_RIGHTBORDER][i]); 
+          if (pa_tmp.apex_pos > 0.0 && std::fabs(pa_tmp.apex_pos - peak_apex) < peak_apex_dist_min)
+          { // update best candidate
+            peak_apex_dist_min = std::fabs(pa_tmp.apex_pos - peak_apex);
+            min_dist = (int)i;
+          }
+        }
+
+        // Select master peak boundaries, or in the case we found at least one peak, the local peak boundaries 
+        double l = best_left;
+        double r = best_right;
+        if (min_dist >= 0)
+        {
+          l = picked_chroms[k].getFloatDataArrays()[PeakPickerMRM::IDX_LEFTBORDER][min_dist];
+          r = picked_chroms[k].getFloatDataArrays()[PeakPickerMRM::IDX_RIGHTBORDER][min_dist];
+          picked_chroms[k][min_dist].setIntensity(0.0); // only remove one peak per transition
+        }
+
+        left_edges.push_back(l);
+        right_edges.push_back(r);
+        // ensure we remember the overall maxima / minima
+        if (l < min_left) {min_left = l;}
+        if (r > max_right) {max_right = r;}
+      }
+    }
+
+    template <typename SpectrumT, typename TransitionT>
+    void pickFragmentChromatograms(const MRMTransitionGroup<SpectrumT, TransitionT>& transition_group,
+                                    const std::vector<SpectrumT>& picked_chroms,
+                                    MRMFeature& mrmFeature,
+                                    const std::vector<SpectrumT>& smoothed_chroms,
+                                    const double best_left, const double best_right,
+                                    const bool use_consensus_,
+                                    double & total_intensity,
+                                    double & total_xic,
+                                    double & total_mi,
+                                    double & total_peak_apices,
+                                    const SpectrumT & master_peak_container,
+                                    const std::vector< double > & left_edges,
+                                    const std::vector< double > & right_edges,
+                                    const int chr_idx,
+                                    const int peak_idx)
+    {
+      TransitionTotals_ totals = computeTransitionTotals_(transition_group);
+      pickFragmentChromatograms_(transition_group, picked_chroms, mrmFeature, smoothed_chroms,
+                                 best_left, best_right, use_consensus_,
+                                 total_intensity, total_xic, total_mi, total_peak_apices,
+                                 master_peak_container, left_edges, right_edges,
+                                 chr_idx, peak_idx, totals);
+    }
+
+    template <typename SpectrumT, typename TransitionT>
+    void pickPrecursorChromatograms(const MRMTransitionGroup<SpectrumT, TransitionT>& transition_group,
+                                    const std::vector<SpectrumT>& picked_chroms,
+                                    MRMFeature& mrmFeature,
+                                    const std::vector<SpectrumT>& smoothed_chroms,
+                                    const double best_left, const double best_right,
+                                    const bool use_consensus_,
+                                    double & total_intensity,
+                                    const SpectrumT & master_peak_container,
+                                    const std::vector< double > & left_edges,
+                                    const std::vector< double > & right_edges,
+                                    const int chr_idx,
+                                    const int peak_idx)
+    {
+      for (Size k = 0; k < transition_group.getPrecursorChromatograms().size(); k++)
+      {
+        const SpectrumT& chromatogram = transition_group.getPrecursorChromatograms()[k];
+
+        // Identify precursor index
+        // note: this is only valid if all transitions are detecting transitions
+        Size prec_idx = transition_group.getChromatograms().size() + k;
+
+        double local_left = best_left;
+        double local_right = best_right;
+        if (!use_consensus_ && right_edges.size() > prec_idx && left_edges.size() > prec_idx)
+        {
+          local_left = left_edges[prec_idx];
+          local_right = right_edges[prec_idx];
+        }
+
+        SpectrumT used_chromatogram;
+        // resample the current chromatogram
+        if (peak_integration_ == "original")
+        {
+          used_chromatogram = resampleChromatogram_(chromatogram, master_peak_container, local_left, local_right);
+          // const SpectrumT& used_chromatogram = chromatogram; // instead of resampling
+        }
+        else if (peak_integration_ == "smoothed" && smoothed_chroms.size() <= prec_idx)
+        {
+          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+            "Tried to calculate peak area and height without any smoothed chromatograms for precursors");
+        }
+        else if (peak_integration_ == "smoothed")
+        {
+          used_chromatogram = resampleChromatogram_(smoothed_chroms[prec_idx], master_peak_container, local_left, local_right);
+        }
+        else
+        {
+          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+            String("Peak integration chromatogram ") + peak_integration_ + " is not a valid method for MRMTransitionGroupPicker");
+        }
+
+        Feature f;
+        double quality = 0;
+        f.setQuality(0, quality);
+        f.setOverallQuality(quality);
+
+        PeakIntegrator::PeakArea pa = pi_.integratePeak(used_chromatogram, local_left, local_right);
+        double peak_integral = pa.area;
+        double peak_apex_int = pa.height;
+
+        if (background_subtraction_ != "none")
+        {
+          double background{0};
+          double avg_noise_level{0};
+          if ((peak_integration_ == "smoothed") && smoothed_chroms.size() <= prec_idx)
+          {
+            throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+              "Tried to calculate background estimation without any smoothed chromatograms");
+          }
+          else if (background_subtraction_ == "original")
+          {
+            const double intensity_left = chromatogram.PosBegin(local_left)->getIntensity();
+            const double intensity_right = (chromatogram.PosEnd(local_right) - 1)->getIntensity();
+            const UInt n_points = std::distance(chromatogram.PosBegin(local_left), chromatogram.PosEnd(local_right));
+            avg_noise_level = (intensity_right + intensity_left) / 2;
+            background = avg_noise_level * n_points;
+          }
+          else if (background_subtraction_ == "exact")
+          {
+            PeakIntegrator::PeakBackground pb = pi_.estimateBackground(used_chromatogram, local_left, local_right, pa.apex_pos);
+            background = pb.area;
+            avg_noise_level = pb.height;
+          }
+          peak_integral -= background;
+          peak_apex_int -= avg_noise_level;
+          if (peak_integral < 0) {peak_integral = 0;}
+          if (peak_apex_int < 0) {peak_apex_int = 0;}
+
+          f.setMetaValue("area_background_level", background);
+          f.setMetaValue("noise_background_level", avg_noise_level);
+        }
+
+        f.setMZ(chromatogram.getPrecursor().getMZ());
+        if (k == 0) {mrmFeature.setMZ(chromatogram.getPrecursor().getMZ());} // only use m/z if first (monoisotopic) isotope
+
+        if (chromatogram.metaValueExists("precursor_mz")) // legacy code (ensures that old tests still work)
+        {
+          f.setMZ(chromatogram.getMetaValue("precursor_mz"));
+          if (k == 0) {mrmFeature.setMZ(chromatogram.getMetaValue("precursor_mz"));} // only use m/z if first (monoisotopic) isotope
+        }
+
+        f.setRT(picked_chroms[chr_idx][peak_idx].getMZ());
+        f.setIntensity(peak_integral);
+        ConvexHull2D hull;
+        hull.setHullPoints(pa.hull_points);
+        f.getConvexHulls().push_back(hull);
+        f.setMetaValue("native_id", chromatogram.getNativeID());
+        f.setMetaValue("peak_apex_int", peak_apex_int);
+
+        if (use_precursors_ && transition_group.getTransitions().empty())
+        {
+          total_intensity += peak_integral;
+        }
+
+        mrmFeature.addPrecursorFeature(f, chromatogram.getNativeID());
+      }
+    }
+
+    // maybe private, but we have tests
+
+    /**
+      @brief Remove overlapping features.
+
+      Remove features that are within the current seed (between best_left and
+      best_right) or overlap with it. An overlapping feature is defined as a
+      feature that has either of its borders within the border of the current
+      peak
+
+      Directly adjacent features are allowed, e.g. they can share one
+      border.
+    */
+    template <typename SpectrumT>
+    void remove_overlapping_features(std::vector<SpectrumT>& picked_chroms, double best_left, double best_right)
+    {
+      // delete all seeds that lie within the current seed
+      for (Size k = 0; k < picked_chroms.size(); k++)
+      {
+        for (Size i = 0; i < picked_chroms[k].size(); i++)
+        {
+          if (picked_chroms[k][i].getMZ() >= best_left && picked_chroms[k][i].getMZ() <= best_right)
+          {
+            picked_chroms[k][i].setIntensity(0.0);
+          }
+        }
+      }
+
+      // delete all seeds that overlap within the current seed
+      for (Size k = 0; k < picked_chroms.size(); k++)
+      {
+        for (Size i = 0; i < picked_chroms[k].size(); i++)
+        {
+          if (picked_chroms[k][i].getIntensity() <= 0.0) {continue; }
+
+          double left = picked_chroms[k].getFloatDataArrays()[PeakPickerMRM::IDX_LEFTBORDER][i];
+          double right = picked_chroms[k].getFloatDataArrays()[PeakPickerMRM::IDX_RIGHTBORDER][i];
+          if ((left > best_left && left < best_right)
+             || (right > best_left && right < best_right))
+          {
+            picked_chroms[k][i].setIntensity(0.0);
+          }
+        }
+      }
+    }
+
+    /// Find largest peak in a vector of chromatograms
+    void findLargestPeak(const std::vector<MSChromatogram >& picked_chroms, int& chr_idx, int& peak_idx);
+
+    /**
+      @brief Given a vector of chromatograms, find the indices of the chromatogram
+      containing the widest peak and of the position of highest intensity.
+
+      @param[in] picked_chroms The vector of chromatograms
+      @param[out] chrom_idx The index of the chromatogram containing the widest peak
+      @param[out] point_idx The index of the point with highest intensity
+    */
+    void findWidestPeakIndices(const std::vector<MSChromatogram>& picked_chroms, Int& chrom_idx, Int& point_idx) const;
+
+protected:
+
+    /**
+      @brief Feature-independent sums over the fragment chromatograms of a transition group
+
+      These only depend on the (complete) chromatograms, so they are computed
+      once per transition group and not for every picked feature (see
+      computeTransitionTotals_()).
+    */
+    struct TransitionTotals_
+    {
+      bool computed = false;
+      std::vector<double> xic; ///< total XIC of each transition
+      std::vector<double> mi; ///< total mutual information of each transition (if compute_total_mi_)
+      double group_xic = 0; ///< total XIC of the detecting transitions
+      double group_mi = 0; ///< total mutual information of the detecting transitions (if compute_total_mi_)
+    };
+
+    /**
+      @brief Create feature from a vector of chromatograms and a specified peak
+
+      Same as createMRMFeature(), @p totals are computed when first needed and reused for further calls.
+    */
+    template <typename SpectrumT, typename TransitionT>
+    MRMFeature createMRMFeature_(const MRMTransitionGroup<SpectrumT, TransitionT>& transition_group,
+                                 std::vector<SpectrumT>& picked_chroms,
+                                 const std::vector<SpectrumT>& smoothed_chroms,
+                                 const int chr_idx,
+                                 const int peak_idx,
+                                 TransitionTotals_& totals)
     {
       OPENMS_PRECONDITION(transition_group.isInternallyConsistent(), "Consistent state required")
       OPENMS_PRECONDITION(transition_group.chromatogramIdsMatch(), "Chromatogram native IDs need to match keys in transition group")
@@ -301,11 +594,15 @@ public:
       // have a different number of picked chromatograms than total transitions
       // as not all are detecting transitions).
       double total_intensity = 0; double total_peak_apices = 0; double total_xic = 0; double total_mi = 0;
-      pickFragmentChromatograms(transition_group, picked_chroms, mrmFeature, smoothed_chroms,
-                                best_left, best_right, use_consensus_,
-                                total_intensity, total_xic, total_mi, total_peak_apices,
-                                master_peak_container, left_edges, right_edges,
-                                chr_idx, peak_idx);
+      if (!totals.computed)
+      {
+        totals = computeTransitionTotals_(transition_group);
+      }
+      pickFragmentChromatograms_(transition_group, picked_chroms, mrmFeature, smoothed_chroms,
+                                 best_left, best_right, use_consensus_,
+                                 total_intensity, total_xic, total_mi, total_peak_apices,
+                                 master_peak_container, left_edges, right_edges,
+                                 chr_idx, peak_idx, totals);
 
       // Also pick the precursor chromatogram(s); note total_xic is not
       // extracted here, only for fragment traces
@@ -331,76 +628,87 @@ public:
       return mrmFeature;
     }
 
-    /** 
-     
-      @brief Apex-based peak picking
-
-      Pick the peak with the closest apex to the consensus apex for each
-      chromatogram.  Use the closest peak for the current peak. 
-      
-      Note that we will only set the closest peak per chromatogram to zero, so
-      if there are two peaks for some transitions, we will have to get to them
-      later.  If there is no peak, then we transfer transition boundaries from
-      "master" peak.
-    */
-    template <typename SpectrumT>
-    void pickApex(std::vector<SpectrumT>& picked_chroms,
-                  const double best_left, const double best_right, const double peak_apex,
-                  double &min_left, double &max_right, 
-                  std::vector< double > & left_edges, std::vector< double > & right_edges)
+    /// Computes the TransitionTotals_ of the fragment transitions of @p transition_group
+    template <typename SpectrumT, typename TransitionT>
+    TransitionTotals_ computeTransitionTotals_(const MRMTransitionGroup<SpectrumT, TransitionT>& transition_group)
     {
-      for (Size k = 0; k < picked_chroms.size(); k++)
+      const std::vector<TransitionT>& transitions = transition_group.getTransitions();
+      TransitionTotals_ totals;
+      totals.computed = true;
+      totals.xic.resize(transitions.size(), 0.0);
+
+      // intensities of each transition, extracted only once for all pairs of transitions
+      std::vector<std::vector<double> > intensities(compute_total_mi_ ? transitions.size() : 0);
+      for (Size k = 0; k < transitions.size(); k++)
       {
-        double peak_apex_dist_min = std::numeric_limits<double>::max();
-        int min_dist = -1;
-        for (Size i = 0; i < picked_chroms[k].size(); i++)
+        const SpectrumT& chromatogram = selectChromHelper_(transition_group, transitions[k].getNativeID());
+        const bool detecting = transitions[k].isDetectingTransition();
+        for (typename SpectrumT::const_iterator it = chromatogram.begin(); it != chromatogram.end(); it++)
         {
-          PeakIntegrator::PeakArea pa_tmp = pi_.integratePeak(  // get the peak apex
-              picked_chroms[k],
-              picked_chroms[k].getFloatDataArrays()[PeakPickerMRM::IDX_LEFTBORDER][i], 
-              picked_chroms[k].getFloatDataArrays()[PeakPickerMRM::IDX_RIGHTBORDER][i]); 
-          if (pa_tmp.apex_pos > 0.0 && std::fabs(pa_tmp.apex_pos - peak_apex) < peak_apex_dist_min)
-          { // update best candidate
-            peak_apex_dist_min = std::fabs(pa_tmp.apex_pos - peak_apex);
-            min_dist = (int)i;
+          if (detecting)
+          {
+            totals.group_xic += it->getIntensity();
+          }
+          totals.xic[k] += it->getIntensity();
+        }
+        if (compute_total_mi_)
+        {
+          intensities[k].reserve(chromatogram.size());
+          for (typename SpectrumT::const_iterator it = chromatogram.begin(); it != chromatogram.end(); it++)
+          {
+            intensities[k].push_back(it->getIntensity());
           }
         }
+      }
+
+      if (compute_total_mi_)
+      {
+        totals.mi.resize(transitions.size(), 0.0);
+        for (Size k = 0; k < transitions.size(); k++)
+        {
+          // compute baseline mutual information
+          int transition_total_mi_norm = 0;
+          for (Size m = 0; m < transitions.size(); m++)
+          {
+            if (transitions[m].isDetectingTransition())
+            {
+              totals.mi[k] += OpenSwath::Scoring::rankedMutualInformation(intensities[m], intensities[k]);
+              transition_total_mi_norm++;
+            }
+          }
+          if (transition_total_mi_norm > 0) { totals.mi[k] /= transition_total_mi_norm; }
 
-        // Select master peak boundaries, or in the case we found at least one peak, the local peak boundaries 
-        double l = best_left;
-        double r = best_right;
-        if (min_dist >= 0)
-        {
-          l = picked_chroms[k].getFloatDataArrays()[PeakPickerMRM::IDX_LEFTBORDER][min_dist];
-          r = picked_chroms[k].getFloatDataArrays()[PeakPickerMRM::IDX_RIGHTBORDER][min_dist];
-          picked_chroms[k][min_dist].setIntensity(0.0); // only remove one peak per transition
+          if (transitions[k].isDetectingTransition())
+          {
+            // sum up all transition-level total MI and divide by the number of detection transitions to have peak group level total MI
+            totals.group_mi += totals.mi[k] / transition_total_mi_norm;
+          }
         }
-
-        left_edges.push_back(l);
-        right_edges.push_back(r);
-        // ensure we remember the overall maxima / minima
-        if (l < min_left) {min_left = l;}
-        if (r > max_right) {max_right = r;}
       }
+      return totals;
     }
 
+    /// Same as pickFragmentChromatograms() with precomputed @p totals
     template <typename SpectrumT, typename TransitionT>
-    void pickFragmentChromatograms(const MRMTransitionGroup<SpectrumT, TransitionT>& transition_group,
-                                    const std::vector<SpectrumT>& picked_chroms,
-                                    MRMFeature& mrmFeature,
-                                    const std::vector<SpectrumT>& smoothed_chroms,
-                                    const double best_left, const double best_right,
-                                    const bool use_consensus_,
-                                    double & total_intensity,
-                                    double & total_xic,
-                                    double & total_mi,
-                                    double & total_peak_apices,
-                                    const SpectrumT & master_peak_container,
-                                    const std::vector< double > & left_edges,
-                                    const std::vector< double > & right_edges,
-                                    const int chr_idx,
-                                    const int peak_idx)
+    void pickFragmentChromatograms_(const MRMTransitionGroup<SpectrumT, TransitionT>& transition_group,
+                                     const std::vector<SpectrumT>& picked_chroms,
+                                     MRMFeature& mrmFeature,
+                                     const std::vector<SpectrumT>& smoothed_chroms,
+                                     const double best_left, const double best_right,
+                                     const bool use_consensus_,
+                                     double & total_intensity,
+                                     double & total_xic,
+                                     double & total_mi,
+                                     double & total_peak_apices,
+                                     const SpectrumT & master_peak_container,
+                                     const std::vector< double > & left_edges,
+                                     const std::vector< double > & right_edges,
+                                     const int chr_idx,
+                                     const int peak_idx,
+                                     const TransitionTotals_& totals)
     {
+      total_xic += totals.group_xic;
+      total_mi += totals.group_mi;
       for (Size k = 0; k < transition_group.getTransitions().size(); k++)
       {
 
@@ -421,56 +729,10 @@ public:
         }
 
         const SpectrumT& chromatogram = selectChromHelper_(transition_group, transition_group.getTransitions()[k].getNativeID()); 
-        if (transition_group.getTransitions()[k].isDetectingTransition())
-        {
-          for (typename SpectrumT::const_iterator it = chromatogram.begin(); it != chromatogram.end(); it++)
-          {
-            total_xic += it->getIntensity();
-          }
-        }
-
-        // Compute total intensity on transition-level
-        double transition_total_xic = 0; 
-
-        for (typename SpectrumT::const_iterator it = chromatogram.begin(); it != chromatogram.end(); it++)
-        {
-          transition_total_xic += it->getIntensity();
-        }
-
-        // Compute total mutual information on transition-level.
-        double transition_total_mi = 0;
-        if (compute_total_mi_)
-        {
-          std::vector<double> chrom_vect_id, chrom_vect_det;
-          for (typename SpectrumT::const_iterator it = chromatogram.begin(); it != chromatogram.end(); it++)
-          {
-            chrom_vect_id.push_back(it->getIntensity());
-          }
 
-          // compute baseline mutual information
-          int transition_total_mi_norm = 0;
-          for (Size m = 0; m < transition_group.getTransitions().size(); m++)
-          {
-            if (transition_group.getTransitions()[m].isDetectingTransition())
-            {
-              const SpectrumT& chromatogram_det = selectChromHelper_(transition_group, transition_group.getTransitions()[m].getNativeID());
-              chrom_vect_det.clear();
-              for (typename SpectrumT::const_iterator it = chromatogram_det.begin(); it != chromatogram_det.end(); it++)
-              {
-                chrom_vect_det.push_back(it->getIntensity());
-              }
-              transition_total_mi += OpenSwath::Scoring::rankedMutualInformation(chrom_vect_det, chrom_vect_id);
-              transition_total_mi_norm++;
-            }
-          }
-          if (transition_total_mi_norm > 0) { transition_total_mi /= transition_total_mi_norm; }
-
-          if (transition_group.getTransitions()[k].isDetectingTransition())
-          {
-            // sum up all transition-level total MI and divide by the number of detection transitions to have peak group level total MI
-            total_mi += transition_total_mi / transition_total_mi_norm;
-          }
-        }
+        // total intensity and mutual information on transition-level
+        const double transition_total_xic = totals.xic[k];
+        const double transition_total_mi = compute_total_mi_ ? totals.mi[k] : 0.0;
 
         SpectrumT used_chromatogram;
         // resample the current chromatogram
@@ -585,185 +847,6 @@ public:
       }
     }
 
-    template <typename SpectrumT, typename TransitionT>
-    void pickPrecursorChromatograms(const MRMTransitionGroup<SpectrumT, TransitionT>& transition_group,
-                                    const std::vector<SpectrumT>& picked_chroms,
-                                    MRMFeature& mrmFeature,
-                                    const std::vector<SpectrumT>& smoothed_chroms,
-                                    const double best_left, const double best_right,
-                                    const bool use_consensus_,
-                                    double & total_intensity,
-                                    const SpectrumT & master_peak_container,
-                                    const std::vector< double > & left_edges,
-                                    const std::vector< double > & right_edges,
-                                    const int chr_idx,
-                                    const int peak_idx)
-    {
-      for (Size k = 0; k < transition_group.getPrecursorChromatograms().size(); k++)
-      {
-        const SpectrumT& chromatogram = transition_group.getPrecursorChromatograms()[k];
-
-        // Identify precursor index
-        // note: this is only valid if all transitions are detecting transitions
-        Size prec_idx = transition_group.getChromatograms().size() + k;
-
-        double local_left = best_left;
-        double local_right = best_right;
-        if (!use_consensus_ && right_edges.size() > prec_idx && left_edges.size() > prec_idx)
-        {
-          local_left = left_edges[prec_idx];
-          local_right = right_edges[prec_idx];
-        }
-
-        SpectrumT used_chromatogram;
-        // resample the current chromatogram
-        if (peak_integration_ == "original")
-        {
-          used_chromatogram = resampleChromatogram_(chromatogram, master_peak_container, local_left, local_right);
-          // const SpectrumT& used_chromatogram = chromatogram; // instead of resampling
-        }
-        else if (peak_integration_ == "smoothed" && smoothed_chroms.size() <= prec_idx)
-        {
-          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-            "Tried to calculate peak area and height without any smoothed chromatograms for precursors");
-        }
-        else if (peak_integration_ == "smoothed")
-        {
-          used_chromatogram = resampleChromatogram_(smoothed_chroms[prec_idx], master_peak_container, local_left, local_right);
-        }
-        else
-        {
-          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-            String("Peak integration chromatogram ") + peak_integration_ + " is not a valid method for MRMTransitionGroupPicker");
-        }
-
-        Feature f;
-        double quality = 0;
-        f.setQuality(0, quality);
-        f.setOverallQuality(quality);
-
-        PeakIntegrator::PeakArea pa = pi_.integratePeak(used_chromatogram, local_left, local_right);
-        double peak_integral = pa.area;
-        double peak_apex_int = pa.height;
-
-        if (background_subtraction_ != "none")
-        {
-          double background{0};
-          double avg_noise_level{0};
-          if ((peak_integration_ == "smoothed") && smoothed_chroms.size() <= prec_idx)
-          {
-            throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-              "Tried to calculate background estimation without any smoothed chromatograms");
-          }
-          else if (background_subtraction_ == "original")
-          {
-            const double intensity_left = chromatogram.PosBegin(local_left)->getIntensity();
-            const double intensity_right = (chromatogram.PosEnd(local_right) - 1)->getIntensity();
-            const UInt n_points = std::distance(chromatogram.PosBegin(local_left), chromatogram.PosEnd(local_right));
-            avg_noise_level = (intensity_right + intensity_left) / 2;
-            background = avg_noise_level * n_points;
-          }
-          else if (background_subtraction_ == "exact")
-          {
-            PeakIntegrator::PeakBackground pb = pi_.estimateBackground(used_chromatogram, local_left, local_right, pa.apex_pos);
-            background = pb.area;
-            avg_noise_level = pb.height;
-          }
-          peak_integral -= background;
-          peak_apex_int -= avg_noise_level;
-          if (peak_integral < 0) {peak_integral = 0;}
-          if (peak_apex_int < 0) {peak_apex_int = 0;}
-
-          f.setMetaValue("area_background_level", background);
-          f.setMetaValue("noise_background_level", avg_noise_level);
-        }
-
-        f.setMZ(chromatogram.getPrecursor().getMZ());
-        if (k == 0) {mrmFeature.setMZ(chromatogram.getPrecursor().getMZ());} // only use m/z if first (monoisotopic) isotope
-
-        if (chromatogram.metaValueExists("precursor_mz")) // legacy code (ensures that old tests still work)
-        {
-          f.setMZ(chromatogram.getMetaValue("precursor_mz"));
-          if (k == 0) {mrmFeature.setMZ(chromatogram.getMetaValue("precursor_mz"));} // only use m/z if first (monoisotopic) isotope
-        }
-
-        f.setRT(picked_chroms[chr_idx][peak_idx].getMZ());
-        f.setIntensity(peak_integral);
-        ConvexHull2D hull;
-        hull.setHullPoints(pa.hull_points);
-        f.getConvexHulls().push_back(hull);
-        f.setMetaValue("native_id", chromatogram.getNativeID());
-        f.setMetaValue("peak_apex_int", peak_apex_int);
-
-        if (use_precursors_ && transition_group.getTransitions().empty())
-        {
-          total_intensity += peak_integral;
-        }
-
-        mrmFeature.addPrecursorFeature(f, chromatogram.getNativeID());
-      }
-    }
-
-    // maybe private, but we have tests
-
-    /**
-      @brief Remove overlapping features.
-
-      Remove features that are within the current seed (between best_left and
-      best_right) or overlap with it. An overlapping feature is defined as a
-      feature that has either of its borders within the border of the current
-      peak
-
-      Directly adjacent features are allowed, e.g. they can share one
-      border.
-    */
-    template <typename SpectrumT>
-    void remove_overlapping_features(std::vector<SpectrumT>& picked_chroms, double best_left, double best_right)
-    {
-      // delete all seeds that lie within the current seed
-      for (Size k = 0; k < picked_chroms.size(); k++)
-      {
-        for (Size i = 0; i < picked_chroms[k].size(); i++)
-        {
-          if (picked_chroms[k][i].getMZ() >= best_left && picked_chroms[k][i].getMZ() <= best_right)
-          {
-            picked_chroms[k][i].setIntensity(0.0);
-          }
-        }
-      }
-
-      // delete all seeds that overlap within the current seed
-      for (Size k = 0; k < picked_chroms.size(); k++)
-      {
-        for (Size i = 0; i < picked_chroms[k].size(); i++)
-        {
-          if (picked_chroms[k][i].getIntensity() <= 0.0) {continue; }
-
-          double left = picked_chroms[k].getFloatDataArrays()[PeakPickerMRM::IDX_LEFTBORDER][i];
-          double right = picked_chroms[k].getFloatDataArrays()[PeakPickerMRM::IDX_RIGHTBORDER][i];
-          if ((left > best_left && left < best_right)
-             || (right > best_left && right < best_right))
-          {
-            picked_chroms[k][i].setIntensity(0.0);
-          }
-        }
-      }
-    }
-
-    /// Find largest peak in a vector of chromatograms
-    void findLargestPeak(const std::vector<MSChromatogram >& picked_chroms, int& chr_idx, int& peak_idx);
-
-    /**
-      @brief Given a vector of chromatograms, find the indices of the chromatogram
-      containing the widest peak and of the position of highest intensity.
-
-      @param[in] picked_chroms The vector of chromatograms
-      @param[out] chrom_idx The index of the chromatogram containing the widest peak
-      @param[out] point_idx The index of the point with highest intensity
-    */
-    void findWidestPeakIndices(const std::vector<MSChromatogram>& picked_chroms, Int& chrom_idx, Int& point_idx) const;
-
-protected:
 
     /// Synchronize members with param class
     void updateMembers_() override;
@@ -1116,12 +1199,53 @@ protected:
       if (end != chromatogram.end()) {end++;}
 
       SpectrumT resampled_peak_container = master_peak_container; // copy the master container, which contains the RT values
+
+      // The chromatograms of a transition group are usually sampled at the
+      // same RT values as the reference chromatogram (e.g. when extracted from
+      // the same spectra). Then resampling yields the input intensities and
+      // they are copied directly.
+      if (copyOnSharedRaster_(begin, end, resampled_peak_container))
+      {
+        return resampled_peak_container;
+      }
+
       LinearResamplerAlign lresampler;
       lresampler.raster(begin, end, resampled_peak_container.begin(), resampled_peak_container.end());
 
       return resampled_peak_container;
     }
 
+    /**
+      @brief Copy intensities onto a raster that contains all RT values of the input
+
+      @param begin Start of the input data
+      @param end End of the input data
+      @param resampled_peak_container Raster (with zero intensities) to copy the intensities to
+
+      @return Whether the RT values of [begin, end) are (strictly increasing and) identical to
+      consecutive RT values of @p resampled_peak_container. If false, @p resampled_peak_container is unchanged.
+    */
+    template <typename SpectrumT>
+    bool copyOnSharedRaster_(typename SpectrumT::const_iterator begin, typename SpectrumT::const_iterator end,
+                             SpectrumT& resampled_peak_container)
+    {
+      if (begin == end) {return false;}
+      typename SpectrumT::iterator out = std::lower_bound(resampled_peak_container.begin(), resampled_peak_container.end(), begin->getMZ(),
+          [](const typename SpectrumT::PeakType& p, double rt) { return p.getMZ() < rt; });
+      if (std::distance(out, resampled_peak_container.end()) < std::distance(begin, end)) {return false;}
+
+      typename SpectrumT::iterator raster_it = out;
+      for (typename SpectrumT::const_iterator it = begin; it != end; ++it, ++raster_it)
+      {
+        if (raster_it->getMZ() != it->getMZ() || (it != begin && !((it - 1)->getMZ() < it->getMZ()))) {return false;}
+      }
+      for (typename SpectrumT::const_iterator it = begin; it != end; ++it, ++out)
+      {
+        out->setIntensity(it->getIntensity());
+      }
+      return true;
+    }
+
     //@}
 
     // Members
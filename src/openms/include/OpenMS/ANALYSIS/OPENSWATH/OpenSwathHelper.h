@@ -125,6 +125,28 @@ public:
                                        double min_upper_edge_dist,
                                        double lower, double upper);
 
+    /**
+      @brief Select the precursors (compounds) of one shard of the library and write them into a new LightTargetedExperiment
+
+      Partitions the compounds of @p targeted_exp into @p shard_count shards of similar size, so that
+      independent OpenSwathWorkflow runs (e.g. on different nodes) can each process one shard. Compounds are
+      assigned to shards by decreasing number of transitions, each to the shard with the fewest transitions
+      so far. The partition only depends on the library, so all runs agree on it.
+
+      The selected compounds and their transitions keep their order in @p targeted_exp; only the proteins
+      referenced by the selected compounds are kept.
+
+      @param[in] targeted_exp Transition list for selection
+      @param[out] shard Compounds, transitions and proteins of the shard
+      @param[in] shard_index Index of the shard (0-based)
+      @param[in] shard_count Number of shards
+
+      @throw Exception::IllegalArgument if @p shard_index is not smaller than @p shard_count
+    */
+    static void selectShard(const OpenSwath::LightTargetedExperiment& targeted_exp,
+                            OpenSwath::LightTargetedExperiment& shard,
+                            Size shard_index, Size shard_count);
+
     /**
       @brief Get the lower / upper offset for this SWATH map and do some sanity checks
 
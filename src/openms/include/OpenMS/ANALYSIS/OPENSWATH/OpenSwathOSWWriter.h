@@ -42,6 +42,7 @@
 #include <OpenMS/KERNEL/FeatureMap.h>
 
 #include <fstream>
+#include <memory>
 
 namespace OpenMS
 {
@@ -122,6 +123,10 @@ namespace OpenMS
     bool sonar_;
     bool enable_uis_scoring_;
 
+    /// background writer (see startAsyncWriting)
+    struct AsyncWriter_;
+    std::shared_ptr<AsyncWriter_> async_;
+
   public:
 
     OpenSwathOSWWriter(const String& output_filename,
@@ -138,6 +143,9 @@ namespace OpenMS
       enable_uis_scoring_(uis_scores)
       {}
 
+    /// Destructor (waits for pending asynchronous writes, see finishAsyncWriting)
+    ~OpenSwathOSWWriter();
+
     bool isActive() const;
 
     /**
@@ -202,9 +210,40 @@ namespace OpenMS
      *
      * @note Only call inside an OpenMP critical section
      *
+     * If asynchronous writing was started, the statements are only queued and
+     * written by the background thread (the call blocks only while the queue
+     * is full).
+     *
+     * @throw Exception::IllegalArgument if writing failed (for asynchronous writing: if a previous batch failed)
      */
     void writeLines(const std::vector<String>& to_osw_output);
 
+    /**
+     * @brief Write all following batches from a dedicated background thread
+     *
+     * Calls to writeLines will then return immediately and scoring threads do
+     * not wait for SQLite I/O. The background thread keeps a single connection
+     * open (in WAL journal mode while writing) and writes all batches that are
+     * pending in one transaction.
+     *
+     * Call after writeHeader and finish with finishAsyncWriting. Does nothing
+     * if the writer is not active or asynchronous writing was already started.
+     *
+     * @param max_queued_batches Maximal number of batches waiting to be written
+     *
+     */
+    void startAsyncWriting(Size max_queued_batches = 64);
+
+    /**
+     * @brief Write all pending batches and stop the background thread
+     *
+     * After this call the output file is complete. Does nothing if
+     * asynchronous writing was not started.
+     *
+     * @throw Exception::IllegalArgument if writing of a batch failed
+     */
+    void finishAsyncWriting();
+
   };
 
 }
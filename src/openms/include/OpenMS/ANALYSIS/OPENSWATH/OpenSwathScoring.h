@@ -44,6 +44,7 @@
 // scoring
 #include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathScores.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DIAScoring.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/SpectrumAdditionCache.h>
 
 #include <vector>
 #include <boost/shared_ptr.hpp>
@@ -67,6 +68,8 @@ namespace OpenMS
     std::string spectra_addition_method_;
     double im_drift_extra_pcnt_;
     OpenSwath_Scores_Usage su_;
+    SpectrumAdditionCachePtr ms2_spectrum_cache_;
+    SpectrumAdditionCachePtr ms1_spectrum_cache_;
 
   public:
 
@@ -94,6 +97,19 @@ namespace OpenMS
                     const OpenSwath_Scores_Usage & su,
                     const std::string& spectrum_addition_method);
 
+    /** @brief Share added-up spectra with other scoring objects
+     *
+     * If set, the spectra added up around the apex of a peak group are stored
+     * in (and taken from) the given caches instead of being recomputed for
+     * every peak group. The MS2 cache is used for single SWATH maps, the MS1
+     * cache for the MS1 map. Caches must only be shared between scoring
+     * objects that work on the same maps with the same settings.
+     *
+     * @param ms2_cache Cache for the SWATH map (may be null)
+     * @param ms1_cache Cache for the MS1 map (may be null)
+    */
+    void setSpectrumAdditionCaches(SpectrumAdditionCachePtr ms2_cache, SpectrumAdditionCachePtr ms1_cache);
+
     /** @brief Score a single peakgroup in a chromatogram using only chromatographic properties.
      *
      * This function only uses the chromatographic properties (coelution,
@@ -302,6 +318,7 @@ namespace OpenMS
      * @param[in] nr_spectra_to_add How many spectra to add up
      * @param drift_lower Drift time lower extraction boundary
      * @param drift_upper Drift time upper extraction boundary
+     * @param cache Optional cache of added-up spectra for @p swath_map
      *
      * @return Added up spectrum
     */
@@ -309,7 +326,8 @@ namespace OpenMS
                                             double RT,
                                             int nr_spectra_to_add,
                                             const double drift_lower,
-                                            const double drift_upper);
+                                            const double drift_upper,
+                                            SpectrumAdditionCache* cache = nullptr);
 
   };
 }
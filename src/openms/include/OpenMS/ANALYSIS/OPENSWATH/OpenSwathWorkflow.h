@@ -105,7 +105,7 @@ protected:
 
     /** @brief Default constructor
      *
-     *  Will not use any ms1 traces and use all threads in the outer loop.
+     *  Will not use any ms1 traces and work on any number of SWATH windows concurrently.
      *
      **/
     OpenSwathWorkflowBase() :
@@ -119,13 +119,8 @@ protected:
     /** @brief Constructor
      *
      *  @param use_ms1_traces Whether to use MS1 data
-     *  @param threads_outer_loop How many threads should be used for the outer
-     *  loop (-1 will use all threads in the outer loop)
-     *
-     *  @note The total number of threads should be divisible by this number
-     *  (e.g. use 8 in outer loop if you have 24 threads in total and 3 will be
-     *  used for the inner loop).
-     *
+     *  @param threads_outer_loop How many SWATH windows should be worked on
+     *  concurrently (-1 will not impose a limit, see threads_outer_loop_)
      *
      **/
     OpenSwathWorkflowBase(bool use_ms1_traces, bool use_ms1_ion_mobility, bool prm, int threads_outer_loop) :
@@ -203,13 +198,14 @@ protected:
     /// Whether data is acquired in targeted DIA (e.g. PRM mode) with potentially overlapping windows
     bool prm_;
 
-    /** @brief How many threads should be used for the outer loop
+    /** @brief How many SWATH windows should be worked on concurrently
      *
-     *  @note A value of -1 will use all threads in the outer loop
+     *  All threads work on batches of compounds from any of these windows.
+     *  Limiting the number of windows bounds the amount of memory used when
+     *  windows are loaded into memory.
      *
-     *  @note The total number of threads should be divisible by this number
-     *  (e.g. use 8 in outer loop if you have 24 threads in total and 3 will be
-     *  used for the inner loop).
+     *  @note A value of -1 will not impose a limit (or limit to the number of
+     *  threads if windows are loaded into memory)
      *
      **/
     int threads_outer_loop_;
@@ -503,6 +499,8 @@ protected:
      * @param tsv_writer TSV writer for storing output (on the fly)
      * @param osw_writer OSW Writer object to store identified features in SQLite format
      * @param ms1only If true, will only score on MS1 level and ignore MS2 level
+     * @param ms2_spectrum_cache Cache of added-up spectra of the SWATH map, shared by all batches of the window (optional)
+     * @param ms1_spectrum_cache Cache of added-up spectra of the MS1 map, shared by all windows (optional)
      *
     */
     void scoreAllChromatograms_(
@@ -517,7 +515,9 @@ protected:
         OpenSwathTSVWriter & tsv_writer,
         OpenSwathOSWWriter & osw_writer,
         int nr_ms1_isotopes = 0,
-        bool ms1only = false) const;
+        bool ms1only = false,
+        SpectrumAdditionCachePtr ms2_spectrum_cache = SpectrumAdditionCachePtr(),
+        SpectrumAdditionCachePtr ms1_spectrum_cache = SpectrumAdditionCachePtr()) const;
 
     /** @brief Select which compounds to analyze in the next batch (and copy to output)
      *
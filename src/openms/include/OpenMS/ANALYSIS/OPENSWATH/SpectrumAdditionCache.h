@@ -0,0 +1,127 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/OPENSWATHALGO/DATAACCESS/DataStructures.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <list>
+#include <map>
+#include <mutex>
+
+namespace OpenMS
+{
+  /**
+    @brief Thread-safe LRU cache of added-up (and sorted) DIA spectra
+
+    OpenSwathScoring sums up the spectra around the apex of every peak group.
+    Peak groups of different peptides in the same SWATH window often share the
+    same closest spectrum, so the same added-up spectrum is computed over and
+    over again. This cache stores the result by the index of the closest
+    spectrum, the number of added spectra and the drift time window, and can
+    be shared by all scoring threads that work on the same map.
+
+    The least recently used entries are evicted once the total size of the
+    stored peak data exceeds the memory limit. Cached spectra are shared, so
+    callers must not modify them.
+
+    @note A cache must only be used for a single map and a single set of
+    spectrum addition settings.
+  */
+  class OPENMS_DLLAPI SpectrumAdditionCache
+  {
+public:
+
+    /// Cache key
+    struct Key
+    {
+      int closest_idx; ///< index of the spectrum closest to the requested RT
+      int nr_spectra_to_add; ///< number of spectra added up
+      double drift_lower; ///< lower drift time bound (0 if not filtered)
+      double drift_upper; ///< upper drift time bound (0 if not filtered)
+
+      bool operator<(const Key& rhs) const;
+    };
+
+    /// Constructor with memory limit in bytes for the stored peak data
+    explicit SpectrumAdditionCache(Size max_bytes = 64 * 1024 * 1024);
+
+    /// Returns the cached spectrum for @p key (and marks it as recently used) or a null pointer
+    OpenSwath::SpectrumPtr get(const Key& key);
+
+    /// Inserts @p spectrum under @p key (replacing an existing entry) and evicts old entries if needed
+    void insert(const Key& key, const OpenSwath::SpectrumPtr& spectrum);
+
+    /// Number of cached spectra
+    Size size() const;
+
+    /// Bytes of peak data currently held
+    Size getMemoryUsage() const;
+
+    /// Memory limit in bytes
+    Size getMaxBytes() const;
+
+    /// Removes all entries
+    void clear();
+
+protected:
+
+    typedef std::list<std::pair<Key, OpenSwath::SpectrumPtr> > EntryList;
+
+    /// Size of the data arrays of @p spectrum in bytes
+    static Size spectrumBytes_(const OpenSwath::SpectrumPtr& spectrum);
+
+    /// Evicts least recently used entries until the memory limit is met (the mutex has to be held)
+    void evict_();
+
+    /// entries, most recently used first
+    EntryList entries_;
+
+    /// key to position in entries_
+    std::map<Key, EntryList::iterator> index_;
+
+    /// bytes of peak data currently held
+    Size bytes_;
+
+    /// memory limit
+    Size max_bytes_;
+
+    mutable std::mutex mutex_;
+  };
+
+  typedef boost::shared_ptr<SpectrumAdditionCache> SpectrumAdditionCachePtr;
+}
@@ -42,6 +42,10 @@
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/KERNEL/FeatureMap.h>
 
+#include <algorithm>
+#include <cmath>
+#include <exception>
+
 namespace OpenMS
 {
   /**
@@ -95,6 +99,37 @@ public:
         double min_score
       ) const = 0;
 
+      /**
+        @brief Batch version of generateScores(): scores each of @p specs against the library, in parallel
+
+        The default implementation calls generateScores() for every spectrum concurrently,
+        so implementations must not modify shared state in generateScores().
+      */
+      virtual void generateScores(
+        const std::vector<MSSpectrum>& specs,
+        std::vector<std::vector<std::pair<Size,double>>>& scores,
+        double min_score
+      ) const
+      {
+        scores.clear();
+        scores.resize(specs.size());
+        std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 8)
+        for (SignedSize i = 0; i < (SignedSize)specs.size(); ++i)
+        {
+          try
+          {
+            generateScores(specs[i], scores[i], min_score);
+          }
+          catch (...)
+          {
+#pragma omp critical (TargetedSpectraExtractor_Comparator_error)
+            if (!error) error = std::current_exception();
+          }
+        }
+        if (error) std::rethrow_exception(error);
+      }
+
       virtual void init(
         const std::vector<MSSpectrum>& library,
         const std::map<String,DataValue>& options
@@ -109,10 +144,25 @@ public:
       std::vector<MSSpectrum> library_;
     };
 
+    /**
+      @brief Scores spectra against a library by the contrast angle of their binned representations
+
+      The library is binned once in init(). Alongside, the norms of the binned library spectra and an index of the
+      library spectra sorted by precursor m/z are kept, so a query only bins itself and computes one dot product per
+      candidate.
+
+      Options for init():
+      - bin_size, peak_spread, bin_offset: see BinnedSpectrum
+      - precursor_mz_tolerance: if > 0 (in Da), queries with a precursor are only scored against library spectra whose
+        precursor m/z is within the tolerance (and against library spectra without precursor). Default: 0 (score all)
+    */
     class BinnedSpectrumComparator : public Comparator
     {
     public:
       ~BinnedSpectrumComparator() override = default;
+
+      using Comparator::generateScores;
+
       void generateScores (
         const MSSpectrum& spec,
         std::vector<std::pair<Size,double>>& scores,
@@ -121,13 +171,39 @@ public:
       {
         scores.clear();
         const BinnedSpectrum in_bs(spec, bin_size_, false, peak_spread_, bin_offset_);
-        for (Size i = 0; i < bs_library_.size(); ++i)
+        const double in_norm = std::sqrt(in_bs.getBins().dot(in_bs.getBins()));
+        auto score = [&](Size i)
         {
-          const double cmp_score = cmp_bs_(in_bs, bs_library_[i]);
+          // contrast angle (see BinnedSpectralContrastAngle), with the library norm precomputed
+          const double cmp_score = in_bs.getBins().dot(bs_library_[i].getBins()) / (in_norm * bs_norms_[i]);
           if (cmp_score >= min_score)
           {
             scores.emplace_back(i, cmp_score);
           }
+        };
+
+        if (precursor_mz_tolerance_ <= 0.0 || spec.getPrecursors().empty())
+        {
+          for (Size i = 0; i < bs_library_.size(); ++i)
+          {
+            score(i);
+          }
+          return;
+        }
+
+        // candidates: library spectra within the precursor window and those without precursor (in library order)
+        const double mz = spec.getPrecursors().front().getMZ();
+        auto first = std::lower_bound(precursor_index_.begin(), precursor_index_.end(), std::make_pair(mz - precursor_mz_tolerance_, Size(0)));
+        auto last = std::upper_bound(first, precursor_index_.end(), std::make_pair(mz + precursor_mz_tolerance_, bs_library_.size()));
+        std::vector<Size> candidates(no_precursor_);
+        for (; first != last; ++first)
+        {
+          candidates.push_back(first->second);
+        }
+        std::sort(candidates.begin(), candidates.end());
+        for (Size i : candidates)
+        {
+          score(i);
         }
       }
 
@@ -145,20 +221,45 @@ public:
         {
           bin_offset_ = options.at("bin_offset");
         }
+        if (options.count("precursor_mz_tolerance"))
+        {
+          precursor_mz_tolerance_ = options.at("precursor_mz_tolerance");
+        }
         library_ = library;
+
         bs_library_.clear();
+        bs_library_.reserve(library_.size());
         for (const MSSpectrum& s : library_)
         {
           bs_library_.emplace_back(s, bin_size_, false, peak_spread_, bin_offset_);
         }
+        bs_norms_.resize(bs_library_.size());
+        precursor_index_.clear();
+        no_precursor_.clear();
+        for (Size i = 0; i < bs_library_.size(); ++i)
+        {
+          bs_norms_[i] = std::sqrt(bs_library_[i].getBins().dot(bs_library_[i].getBins()));
+          if (library_[i].getPrecursors().empty())
+          {
+            no_precursor_.push_back(i);
+          }
+          else
+          {
+            precursor_index_.emplace_back(library_[i].getPrecursors().front().getMZ(), i);
+          }
+        }
+        std::sort(precursor_index_.begin(), precursor_index_.end());
         OPENMS_LOG_INFO << "The library contains " << bs_library_.size() << " spectra." << std::endl;
       }
     private:
-      BinnedSpectralContrastAngle cmp_bs_;
       std::vector<BinnedSpectrum> bs_library_;
+      std::vector<double> bs_norms_; ///< norms of the binned library spectra
+      std::vector<std::pair<double, Size>> precursor_index_; ///< (precursor m/z, library index), sorted
+      std::vector<Size> no_precursor_; ///< library spectra without precursor
       double bin_size_ = 1.0;
       UInt peak_spread_ = 0;
       double bin_offset_ = 0.4;
+      double precursor_mz_tolerance_ = 0.0;
     };
 
     void getDefaultParameters(Param& params) const;
@@ -360,6 +461,21 @@ public:
       std::vector<Match>& matches
     );
 
+    /**
+      @brief Batch version of matchSpectrum(): searches the spectral library for the top scoring candidates of each input spectrum
+
+      The spectra are scored in parallel (see Comparator::generateScores()).
+
+      @param[in] input_spectra The input spectra for which matches are desired
+      @param[in] cmp The comparator object containing the library and the logic for matching
+      @param[out] matches For each input spectrum, a vector of `Match`es, containing the matched spectra and their scores
+    */
+    void matchSpectra(
+      const std::vector<MSSpectrum>& input_spectra,
+      const Comparator& cmp,
+      std::vector<std::vector<Match>>& matches
+    ) const;
+
     /**
       @brief Compares a list of spectra against a spectral library and updates
       the related features.
@@ -419,6 +535,14 @@ protected:
     /// Overridden function from DefaultParamHandler to keep members up to date, when a parameter is changed
     void updateMembers_() override;
 
+    /// The (at most) @p n best scoring library entries of @p scores as `Match`es, by decreasing score (ties: library order)
+    static void topMatches_(
+      std::vector<std::pair<Size,double>>& scores,
+      const Comparator& cmp,
+      Size n,
+      std::vector<Match>& matches
+    );
+
 private:
     /**
       Unit to use for mz_tolerance_ and fwhm_threshold_: true for Da, false for ppm.
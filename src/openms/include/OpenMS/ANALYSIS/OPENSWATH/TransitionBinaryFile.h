@@ -0,0 +1,123 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <OpenMS/ANALYSIS/OPENSWATH/TransitionTSVFile.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+
+  /**
+      @brief This class supports reading and writing of binary transition libraries (.trbin)
+
+      Parsing TraML (and, to a lesser extent, TSV and PQP) assay libraries is slow for
+      large libraries. This format stores the same information as TransitionTSVFile and
+      TransitionPQPFile in native binary form, so loading it needs no text parsing:
+
+      - every field is stored as a flat array with one element per transition (or compound / protein),
+      - all strings are interned into one string pool and referenced by index, so repeated values
+        (peptide sequences, protein accessions, group labels, ...) are stored only once,
+      - list valued fields (e.g. protein references, modifications) are stored as one array of
+        values with an array of offsets per row.
+
+      A file contains two sections: the transitions in the row layout of TransitionTSVFile (used
+      to restore a TargetedExperiment), and the LightTargetedExperiment computed from it (as
+      OpenSwathDataAccessHelper::convertTargetedExp() would). Loading a LightTargetedExperiment,
+      e.g. in OpenSwathWorkflow, only reads the second section from the memory-mapped file and
+      does not create a TargetedExperiment at all.
+
+      As for TSV and PQP, only the information representable in TransitionTSVFile rows is kept
+      (in particular, arbitrary CV terms of a TraML file are not stored).
+
+      All data is written in the byte order of the machine creating the file.
+  */
+  class OPENMS_DLLAPI TransitionBinaryFile :
+    public TransitionTSVFile
+  {
+public:
+
+    //@{
+    /// Constructor
+    TransitionBinaryFile();
+
+    /// Destructor
+    ~TransitionBinaryFile() override;
+    //@}
+
+    /** @brief Write out a targeted experiment (TraML structure) into a binary transition library
+     *
+     * @param filename The output file
+     * @param targeted_exp The targeted experiment
+     *
+     * @exception Exception::IllegalArgument is thrown if @p targeted_exp contains invalid references
+     * @exception Exception::UnableToCreateFile is thrown if the file cannot be written
+    */
+    void convertTargetedExperimentToBinary(const char* filename, OpenMS::TargetedExperiment& targeted_exp);
+
+    /** @brief Read in a binary transition library and construct a targeted experiment (TraML structure)
+     *
+     * @param filename The input file
+     * @param targeted_exp The output targeted experiment
+     *
+     * @exception Exception::FileNotFound is thrown if the file does not exist
+     * @exception Exception::ParseError is thrown if the file is not a valid binary transition library
+    */
+    void convertBinaryToTargetedExperiment(const char* filename, OpenMS::TargetedExperiment& targeted_exp);
+
+    /** @brief Read in a binary transition library and construct a targeted experiment (Light transition structure)
+     *
+     * The light structure is read directly from the file (no TSV rows or TargetedExperiment are created).
+     *
+     * @param filename The input file
+     * @param targeted_exp The output targeted experiment (its content is replaced)
+     *
+     * @exception Exception::FileNotFound is thrown if the file does not exist
+     * @exception Exception::ParseError is thrown if the file is not a valid binary transition library
+    */
+    void convertBinaryToTargetedExperiment(const char* filename, OpenSwath::LightTargetedExperiment& targeted_exp);
+
+private:
+    /// write (Writer_) or read (Reader_) the TSV rows section
+    template <typename Archive>
+    static void serializeRows_(Archive& ar, std::vector<TSVTransition>& rows);
+
+    /// write (Writer_) or read (Reader_) the light section
+    template <typename Archive>
+    static void serializeLight_(Archive& ar, OpenSwath::LightTargetedExperiment& exp);
+  };
+}
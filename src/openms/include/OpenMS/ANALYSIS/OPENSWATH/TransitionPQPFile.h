@@ -39,6 +39,7 @@
 #include <boost/range/algorithm.hpp>
 #include <boost/range/algorithm_ext/erase.hpp>
 #include <iostream>
+#include <limits>
 
 namespace OpenMS
 {
@@ -274,6 +275,28 @@ public:
     */
     void convertPQPToTargetedExperiment(const char* filename, OpenSwath::LightTargetedExperiment& targeted_exp, bool legacy_traml_id = false);
 
+    /** @brief Read in a PQP file and directly construct a targeted experiment (Light transition structure)
+     *
+     * In contrast to convertPQPToTargetedExperiment, no intermediate
+     * TSVTransition rows are created: precursors and transitions are read in
+     * two separate queries and converted directly into the light structure,
+     * which is considerably faster and needs much less memory for large
+     * libraries. Optionally, only precursors within a given m/z range (e.g.
+     * the current SWATH window) and their transitions are loaded.
+     *
+     * @param filename The input file
+     * @param targeted_exp The output targeted experiment (transitions, compounds and proteins are appended)
+     * @param legacy_traml_id Should legacy TraML IDs be used (boolean)?
+     * @param precursor_mz_lower Lower bound of the precursor m/z range to load
+     * @param precursor_mz_upper Upper bound of the precursor m/z range to load
+     *
+    */
+    void convertPQPToLightTargetedExperiment(const char* filename,
+                                             OpenSwath::LightTargetedExperiment& targeted_exp,
+                                             bool legacy_traml_id = false,
+                                             double precursor_mz_lower = 0.0,
+                                             double precursor_mz_upper = std::numeric_limits<double>::max());
+
   };
 }
 
@@ -228,13 +228,13 @@ protected:
     /// Synchronize members with param class
     void updateMembers_() override;
 
-private:
-
     // Members
     String retentionTimeInterpretation_;
     bool override_group_label_check_;
     bool force_invalid_mods_;
 
+private:
+
     // Typedefs
     typedef std::vector<OpenMS::TargetedExperiment::Protein> ProteinVectorType;
     typedef std::vector<OpenMS::TargetedExperiment::Peptide> PeptideVectorType;
@@ -35,9 +35,11 @@ set(sources_list_h
   SwathWindowLoader.h
   SwathQC.h
   SpectrumAddition.h
+  SpectrumAdditionCache.h
   TargetedSpectraExtractor.h
   TransitionTSVFile.h
   TransitionPQPFile.h
+  TransitionBinaryFile.h
 )
 
 ### add path to the filenames
@@ -275,11 +275,26 @@ protected:
       const std::vector<AbsoluteQuantitationStandards::featureConcentration> & component_concentrations,
       const std::vector<size_t>& component_concentrations_indices);
   
+    /**
+      @brief Optimizes the calibration curve of a single component (see optimizeCalibrationCurves()).
+
+      @param[in,out] component_aqm The quantitation method of the component, updated with the optimized curve
+      @param[in,out] component_concentrations The standards of the component; outliers are removed in place
+
+      @exception Exception::UnableToFit is thrown if fitting cannot be performed
+    */
+    void optimizeCalibrationCurve_(
+      AbsoluteQuantitationMethod& component_aqm,
+      std::vector<AbsoluteQuantitationStandards::featureConcentration>& component_concentrations);
+
     /**
       @brief This function computes a candidate outlier point by iteratively
        leaving one point out to find the one which results in the maximum R^2
        of a first order linear regression of the remaining ones.
 
+      The R^2 only depends on the (weighted) calibration points, thus the points
+      are extracted once and no calibration curve is refitted.
+
       @param component_concentrations list of structures with features and concentrations
       @param feature_name name of the feature to calculate the absolute concentration.
       @param transformation_model model used to fit the calibration points
@@ -287,7 +302,7 @@ protected:
 
       @return The position of the candidate outlier point in component_concentrations.
 
-      @exception Exception::UnableToFit is thrown if fitting cannot be performed
+      @exception None
     */
     int jackknifeOutlierCandidate_(
       const std::vector<AbsoluteQuantitationStandards::featureConcentration>& component_concentrations,
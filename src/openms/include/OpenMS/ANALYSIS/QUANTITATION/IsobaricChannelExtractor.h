@@ -183,13 +183,18 @@ private:
     bool hasLowIntensityReporter_(const ConsensusFeature& cf) const;
 
     /**
-      @brief Computes the purity of the precursor given an iterator pointing to the MS/MS spectrum and one to the precursor spectrum.
+      @brief Computes the purity of the precursor given an iterator pointing to the MS/MS spectrum and the surrounding MS1 scans.
 
       @param ms2_spec Iterator pointing to the MS2 spectrum.
-      @param precursor Iterator pointing to the precursor spectrum of ms2_spec.
+      @param precursor_scan Iterator pointing to the precursor (survey) spectrum of ms2_spec.
+      @param follow_up_scan Iterator pointing to the MS1 scan following ms2_spec or to the end of the experiment if there is none.
+      @param exp_end End iterator of the experiment containing the scans.
       @return Fraction of the total intensity in the isolation window of the precursor spectrum that was assigned to the precursor.
     */
-    double computePrecursorPurity_(const PeakMap::ConstIterator& ms2_spec, const PuritySate_& pState) const;
+    double computePrecursorPurity_(const PeakMap::ConstIterator& ms2_spec,
+                                   const PeakMap::ConstIterator& precursor_scan,
+                                   const PeakMap::ConstIterator& follow_up_scan,
+                                   const PeakMap::ConstIterator& exp_end) const;
 
     /**
       @brief Computes the purity of the precursor given an iterator pointing to the MS/MS spectrum and a reference to the potential precursor spectrum.
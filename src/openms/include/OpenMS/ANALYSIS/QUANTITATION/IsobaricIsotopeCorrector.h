@@ -37,6 +37,8 @@
 #include <OpenMS/DATASTRUCTURES/Matrix.h>
 #include <Eigen/Core>
 
+#include <map>
+
 namespace OpenMS
 {
   class IsobaricQuantitationMethod;
@@ -65,13 +67,17 @@ public:
                                                                   const IsobaricQuantitationMethod* quant_method);
 
 private:
+    /**
+     @brief Maps the column (map) indices of the given map to the channel ids of the quantitation method.
+     */
+    static std::map<Size, Int> getChannelIds_(const ConsensusMap& cm);
+
     /**
      @brief Fills the input vector for the Eigen/NNLS step given the ConsensusFeature.
      */
     static void fillInputVector_(Eigen::VectorXd& b,
-                                 Matrix<double>& m_b,
                                  const ConsensusFeature& cf,
-                                 const ConsensusMap& cm);
+                                 const std::map<Size, Int>& channel_ids);
 
     /**
      @brief
@@ -94,7 +100,8 @@ private:
     static float updateOutpuMap_(const ConsensusMap& consensus_map_in,
                                  ConsensusMap& consensus_map_out,
                                  Size current_cf,
-                                 const Matrix<double>& m_x);
+                                 const Matrix<double>& m_x,
+                                 const std::map<Size, Int>& channel_ids);
   };
 } // namespace
 
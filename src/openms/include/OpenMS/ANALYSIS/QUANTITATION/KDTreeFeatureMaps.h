@@ -39,8 +39,7 @@
 #include <OpenMS/KERNEL/Feature.h>
 #include <OpenMS/DATASTRUCTURES/DefaultParamHandler.h>
 #include <OpenMS/ANALYSIS/MAPMATCHING/TransformationModelLowess.h>
-#include <OpenMS/DATASTRUCTURES/KDTree.h>
-#include <OpenMS/ANALYSIS/QUANTITATION/KDTreeFeatureNode.h>
+#include <OpenMS/DATASTRUCTURES/StaticKDTree.h>
 
 namespace OpenMS
 {
@@ -51,8 +50,8 @@ class OPENMS_DLLAPI KDTreeFeatureMaps : public DefaultParamHandler
 
 public:
 
-  /// 2D tree on features
-  typedef KDTree::KDTree<2,KDTreeFeatureNode> FeatureKDTree;
+  /// 2D tree on features (RT, m/z)
+  typedef StaticKDTree<2> FeatureKDTree;
 
   /// Default constructor
   KDTreeFeatureMaps() :
@@ -93,7 +92,7 @@ public:
     optimizeTree();
   }
 
-  /// Add feature
+  /// Add feature (it is found by queries right away, but only becomes part of the tree with the next optimizeTree())
   void addFeature(Size mt_map_index, const BaseFeature* feature);
 
   /// Return pointer to feature i
@@ -117,7 +116,7 @@ public:
   /// Number of features stored
   Size size() const;
 
-  /// Number of points in the tree
+  /// Number of points that can be found by queries (i.e. all features)
   Size treeSize() const;
 
   /// Number of maps
@@ -126,7 +125,7 @@ public:
   /// Clear all data
   void clear();
 
-  /// Optimize the kD tree
+  /// (Re-)build the kD tree on all features
   void optimizeTree();
 
   /// Fill @p result with indices of all features compatible (wrt. RT, m/z, map index) to the feature with @p index
@@ -135,7 +134,7 @@ public:
   /// Fill @p result with indices of all features within the specified boundaries
   void queryRegion(double rt_low, double rt_high, double mz_low, double mz_high, std::vector<Size>& result_indices, Size ignored_map_index = std::numeric_limits<Size>::max()) const;
 
-  /// Apply RT transformations
+  /// Apply RT transformations (and rebuild the kD tree on the new retention times)
   void applyTransformations(const std::vector<TransformationModelLowess*>& trafos);
 
 protected:
@@ -154,7 +153,7 @@ protected:
   /// Number of maps
   Size num_maps_;
 
-  /// 2D tree on features from all input maps.
+  /// 2D tree on features from all input maps. Features added after the last optimizeTree() (index >= kd_tree_.size()) are not in it yet.
   FeatureKDTree kd_tree_;
 
 };
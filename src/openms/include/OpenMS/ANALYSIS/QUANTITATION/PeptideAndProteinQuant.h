@@ -41,6 +41,8 @@
 #include <OpenMS/METADATA/ProteinIdentification.h>
 #include <OpenMS/METADATA/ExperimentalDesign.h>
 
+#include <unordered_map>
+
 namespace OpenMS
 {
   /**
@@ -218,6 +220,32 @@ private:
     /// Protein quantification data
     ProteinQuant prot_quant_;
 
+    /// Hash of a peptide sequence; only uses what AASequence::operator< compares, so sequences that are the same key of PeptideQuant get the same hash
+    struct SequenceHash_
+    {
+      Size operator()(const AASequence* seq) const;
+    };
+
+    /// Peptide sequences that are the same key of PeptideQuant (i.e. equivalent according to AASequence::operator<)
+    struct SequenceEqual_
+    {
+      bool operator()(const AASequence* a, const AASequence* b) const
+      {
+        return !(*a < *b) && !(*b < *a);
+      }
+    };
+
+    /**
+         @brief Interned peptides while reading quantitative data: sequence (key in @p pep_quant_) -> its data
+
+         Look-ups in @p pep_quant_ need many (expensive) AASequence comparisons; this index hashes each sequence once instead.
+         Entries point into @p pep_quant_, so an index must not outlive changes to it.
+    */
+    typedef std::unordered_map<const AASequence*, PeptideData*, SequenceHash_, SequenceEqual_> PeptideIndex_;
+
+    /// Returns the data of @p seq in @p pep_quant_ (inserted if necessary), using and updating @p index
+    PeptideData& getPeptideData_(const AASequence& seq, PeptideIndex_& index);
+
 
     /**
          @brief Get the "canonical" annotation (a single peptide hit) of a feature/consensus feature from the associated list of peptide identifications.
@@ -238,7 +266,8 @@ private:
     void quantifyFeature_(const FeatureHandle& feature, 
       size_t fraction, 
       size_t sample, 
-      const PeptideHit& hit);
+      const PeptideHit& hit,
+      PeptideIndex_& index);
 
     /**
      *   @brief Determine fraction and charge state of a peptide with the highest
@@ -349,7 +378,7 @@ private:
 
          The peptide hits in @p peptides are sorted by score in the process.
     */
-    void countPeptides_(std::vector<PeptideIdentification>& peptides, const Size& n_fractions);
+    void countPeptides_(std::vector<PeptideIdentification>& peptides, const Size& n_fractions, PeptideIndex_& index);
 
     /// Clear all data when parameters are set
     void updateMembers_() override;
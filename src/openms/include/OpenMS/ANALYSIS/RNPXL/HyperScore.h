@@ -63,6 +63,17 @@ struct OPENMS_DLLAPI HyperScore
 
   static double compute(double fragment_mass_tolerance, bool fragment_mass_tolerance_unit_ppm, const PeakSpectrum& exp_spectrum, const PeakSpectrum& theo_spectrum);
 
+  /** @brief compute the (ln transformed) X!Tandem HyperScore for a theoretical spectrum given as sorted m/z values and ion types
+   *  (as generated by TheoreticalSpectrumGenerator::getIonSeries()). All theoretical peaks have unit intensity.
+   *  The result equals compute() for a theoretical spectrum with the same peaks.
+   * @param fragment_mass_tolerance mass tolerance applied left and right of the theoretical spectrum peak position
+   * @param fragment_mass_tolerance_unit_ppm Unit of the mass tolerance is: Thomson if false, ppm if true
+   * @param exp_spectrum measured spectrum
+   * @param theo_mz sorted m/z values of the theoretical spectrum
+   * @param theo_ion_types ion type ('b', 'y', ...) of each theoretical peak
+   */
+  static double compute(double fragment_mass_tolerance, bool fragment_mass_tolerance_unit_ppm, const PeakSpectrum& exp_spectrum, const std::vector<double>& theo_mz, const std::vector<char>& theo_ion_types);
+
   private:
     /// helper to compute the log factorial
     static double logfactorial_(const int x, int base = 2);
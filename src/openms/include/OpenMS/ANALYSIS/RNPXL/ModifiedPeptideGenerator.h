@@ -82,7 +82,89 @@ namespace OpenMS
      std::vector<AASequence>& all_modified_peptides, 
      bool keep_original=true);
 
+    /// Placement of a single variable modification; @p site is the residue index or N_TERM_SITE / C_TERM_SITE for terminal modifications
+    struct ModificationPlacement
+    {
+      int site;
+      const ResidueModification* mod;
+    };
+
+    /// Site index of modifications placed at the peptide N-terminus (not at the N-terminal residue)
+    static const int N_TERM_SITE = -1;
+    /// Site index of modifications placed at the peptide C-terminus (not at the C-terminal residue)
+    static const int C_TERM_SITE = -2;
+
+    /**
+      @brief Enumerates the variable modified variants of a peptide one by one, without materializing them
+
+      Yields the same variants in the same order as applyVariableModifications() with @p max_variable_mods_per_peptide > 1
+      (for a value of 1, all single placements are enumerated in the same combinatorial manner).
+      Each variant is described by its modification placements and the mass difference to the unmodified peptide,
+      which is updated incrementally, so variants can be pruned by (precursor) mass before an AASequence is built.
+
+      @code
+      ModifiedPeptideGenerator::VariantEnumerator variants(var_mods, peptide, 3);
+      while (variants.next(min_delta, max_delta))
+      {
+        AASequence candidate = variants.getPeptide();
+        ...
+      }
+      @endcode
+
+      @note @p var_mods and @p peptide are referenced, not copied, and must outlive the enumerator.
+    */
+    class OPENMS_DLLAPI VariantEnumerator
+    {
+    public:
+      VariantEnumerator(const MapToResidueType& var_mods, const AASequence& peptide, Size max_variable_mods_per_peptide, bool keep_unmodified = true);
+
+      /// advances to the next variant; returns false if all variants were enumerated
+      bool next();
+
+      /// advances to the next variant whose mass difference (see getMassDelta()) is within [@p min_delta, @p max_delta]
+      bool next(double min_delta, double max_delta);
+
+      /// placements of the current variant, ordered by site (empty for the unmodified peptide)
+      const std::vector<ModificationPlacement>& getPlacements() const;
+
+      /// monoisotopic mass difference of the current variant to the unmodified peptide
+      double getMassDelta() const;
+
+      /// builds the current variant
+      AASequence getPeptide() const;
+
+    private:
+      /// sets up the first placement of the current subset of sites
+      void initPlacements_();
+
+      /// selects the first subset of @p n_mods_ sites
+      void initSubset_();
+
+      const MapToResidueType& var_mods_;
+      const AASequence& peptide_;
+      bool keep_unmodified_;
+      /// compatible sites and their modifications (ordered by site)
+      std::vector<std::pair<int, std::vector<const ResidueModification*> > > sites_;
+      Size max_placements_;
+      /// number of modifications of the current variant
+      Size n_mods_;
+      /// which sites are modified in the current variant
+      std::vector<bool> subset_mask_;
+      /// indices into sites_ of the modified sites
+      std::vector<Size> subset_;
+      /// chosen modification of each modified site
+      std::vector<Size> choice_;
+      std::vector<ModificationPlacement> placements_;
+      double mass_delta_;
+      bool started_;
+    };
+
   protected:
+    /// Determines which variable modifications can be placed at which site (see N_TERM_SITE and C_TERM_SITE)
+    static std::map<int, std::vector<const ResidueModification*> > getCompatibleSites_(
+      const MapToResidueType& var_mods,
+      const AASequence& peptide);
+
     // Lookup datastructure to allow lock-free generation of modified peptides
     static MapToResidueType createResidueModificationToResidueMap_(const std::vector<const ResidueModification*>& mods);
 
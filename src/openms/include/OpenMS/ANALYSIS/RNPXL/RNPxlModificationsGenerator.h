@@ -64,8 +64,37 @@ namespace OpenMS
                                                                      String sequence_restriction,
                                                                      bool cysteine_adduct,
                                                                      Int max_length = 4);
+
+      /// Key that identifies the result of initModificationMassesRNA() for the given parameters (see storeModificationMasses())
+      static String getModificationMassesKey(const StringList& target_nucleotides,
+                                             const StringList& nt_groups,
+                                             const std::set<char>& can_xl,
+                                             const StringList& mappings,
+                                             const StringList& modifications,
+                                             const String& sequence_restriction,
+                                             bool cysteine_adduct,
+                                             Int max_length);
+
+      /**
+        @brief Stores modification masses along with a @p key (see getModificationMassesKey()) in a text file
+
+        Generating long nucleotide adducts can take a long time. Repeated searches with the same settings can load the stored result instead.
+
+        @throw Exception::UnableToCreateFile if the file cannot be written
+      */
+      static void storeModificationMasses(const String& filename, const String& key, const RNPxlModificationMassesResult& result);
+
+      /**
+        @brief Loads modification masses stored with storeModificationMasses()
+
+        @return false if the file does not exist or was stored with a different @p key (@p result is left unchanged)
+        @throw Exception::ParseError if the file is not a valid modification masses file
+      */
+      static bool loadModificationMasses(const String& filename, const String& key, RNPxlModificationMassesResult& result);
+
     private:
-      static bool notInSeq(String res_seq, String query);
+      /// sorted k-mers (nucleotides of each k-mer sorted) of all @p sequences for each k in @p lengths
+      static std::map<Size, std::set<String> > getSortedKMers_(const StringList& sequences, const std::set<Size>& lengths);
       static void generateTargetSequences(const String& res_seq, Size param_pos, const std::map<char, std::vector<char> >& map_source2target, StringList& target_sequences);
     };
 }
@@ -98,6 +98,10 @@ namespace OpenMS
           Assumes the list of peptides and the list of spectrum precursor masses are sorted by mass in ascending order,
           and the list of mono-link masses is sorted in descending order.
 
+          Only pairs within the tolerance window of a precursor mass are generated: for each block of alpha peptides
+          the matching beta peptides are found by moving a window over the sorted peptide list (in parallel over blocks).
+          The result is ordered by precursor, then loop-links, mono-links and cross-links, independent of the number of threads.
+
        * @param peptides The peptides with precomputed masses from the digestDatabase function
        * @param cross_link_mass_light Mass of the cross-linker, only the light one if a labeled linker is used
        * @param cross_link_mass_mono_link A list of possible masses for the cross-link, if it is attached to a peptide on one side
@@ -0,0 +1,109 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Eugen Netz $
+// $Authors: Eugen Netz $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <OpenMS/CHEMISTRY/SimpleTSGXLMS.h>
+#include <OpenMS/ANALYSIS/XLMS/OPXLDataStructs.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <mutex>
+#include <unordered_map>
+
+namespace OpenMS
+{
+  /**
+    @brief Thread-safe pool of theoretical spectra for cross-linked peptides
+
+    In an XL-MS search the same peptides are part of the candidates of many
+    spectra. Their fragment spectra, as generated by SimpleTSGXLMS, only
+    depend on the peptide, the link position(s) and the charge range, but not
+    on the experimental spectrum. This pool generates each of those spectra
+    once and hands out shared, immutable copies afterwards, to all threads.
+
+    Linear ion spectra are pooled by (peptide, link positions, charge). Cross-link
+    ion spectra of peptide pairs are pooled by (alpha, beta, link positions, fragmented
+    peptide, charge range). Cross-link ions of mono-links and loop-links depend on
+    the experimental precursor mass and are not pooled.
+
+    The results are identical to calling the generator directly. Once @p
+    max_entries spectra are stored, further spectra are generated but not
+    added to the pool.
+
+    @ingroup Analysis_ID
+  */
+  class OPENMS_DLLAPI OPXLTheoreticalSpectrumPool
+  {
+public:
+
+    /// A theoretical spectrum as generated by SimpleTSGXLMS
+    typedef std::vector< SimpleTSGXLMS::SimplePeak > SimpleSpectrum;
+
+    /// Shared, immutable theoretical spectrum
+    typedef boost::shared_ptr<const SimpleSpectrum> SimpleSpectrumPtr;
+
+    /// Constructor, the parameters of @p generator are fixed at this point
+    explicit OPXLTheoreticalSpectrumPool(const SimpleTSGXLMS& generator, Size max_entries = 100000);
+
+    /// Same as SimpleTSGXLMS::getLinearIonSpectrum() on an empty spectrum
+    SimpleSpectrumPtr getLinearIonSpectrum(const AASequence& peptide, Size link_pos, int charge = 1, Size link_pos_2 = 0);
+
+    /// Same as SimpleTSGXLMS::getXLinkIonSpectrum() for a pair of peptides on an empty spectrum
+    SimpleSpectrumPtr getXLinkIonSpectrum(const OPXLDataStructs::ProteinProteinCrossLink& crosslink, bool frag_alpha, int mincharge, int maxcharge);
+
+    /// Number of pooled spectra
+    Size size() const;
+
+    /// Removes all pooled spectra
+    void clear();
+
+protected:
+
+    /// Returns the pooled spectrum for @p key (null if it is not pooled)
+    SimpleSpectrumPtr find_(const String& key) const;
+
+    /// Pools @p spectrum (if there is space left)
+    void insert_(const String& key, const SimpleSpectrumPtr& spectrum);
+
+    SimpleTSGXLMS generator_;
+
+    std::unordered_map<String, SimpleSpectrumPtr> pool_;
+
+    Size max_entries_;
+
+    mutable std::mutex mutex_;
+  };
+}
@@ -49,6 +49,7 @@
 #include <OpenMS/ANALYSIS/OPENSWATH/SwathWindowLoader.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/TransitionTSVFile.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/TransitionPQPFile.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/TransitionBinaryFile.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathTSVWriter.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathOSWWriter.h>
 
@@ -300,7 +301,7 @@ protected:
   }
 
   /**
-   * @brief Loads transition list from TraML / TSV or PQP
+   * @brief Loads transition list from TraML / TSV / PQP or binary transition library
    *
    * @param tr_type Input file type
    * @param tr_file Input file name
@@ -325,7 +326,13 @@ protected:
     else if (tr_type == FileTypes::PQP)
     {
       progresslogger.startProgress(0, 1, "Load PQP file");
-      TransitionPQPFile().convertPQPToTargetedExperiment(tr_file.c_str(), transition_exp);
+      TransitionPQPFile().convertPQPToLightTargetedExperiment(tr_file.c_str(), transition_exp);
+      progresslogger.endProgress();
+    }
+    else if (tr_type == FileTypes::TRBIN)
+    {
+      progresslogger.startProgress(0, 1, "Load binary transition library");
+      TransitionBinaryFile().convertBinaryToTargetedExperiment(tr_file.c_str(), transition_exp);
       progresslogger.endProgress();
     }
     else if (tr_type == FileTypes::TSV)
@@ -338,7 +345,7 @@ protected:
     }
     else
     {
-      OPENMS_LOG_ERROR << "Provide valid TraML, TSV or PQP transition file." << std::endl;
+      OPENMS_LOG_ERROR << "Provide valid TraML, TSV, PQP or binary transition file." << std::endl;
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Need to provide valid input file.");
     }
     return transition_exp;
@@ -43,6 +43,8 @@
 
 #include <OpenMS/METADATA/DataProcessing.h>
 
+#include <OpenMS/SYSTEM/ResourceTracker.h>
+
 #include <OpenMS/KERNEL/StandardTypes.h>
 
 #include <fstream>
@@ -53,6 +55,8 @@ namespace OpenMS
 {
   class FeatureMap;
   class ConsensusMap;
+  class PeptideIdentification;
+  class ProteinIdentification;
   struct ParameterInformation;
 
   /**
@@ -185,7 +189,7 @@ public:
     /**
       @brief Sets the maximal number of usable threads
 
-      @param num_threads The number of threads that should be usable.
+      @param num_threads The number of threads that should be usable (limited to the available cores, see ParallelExecution::setNumberOfThreads()).
 
       @note This method only works if %OpenMS is compiled with %OpenMP support.
     */
@@ -231,6 +235,9 @@ private:
     /// Log file stream.  Use the writeLog_() and writeDebug_() methods to access it.
     mutable std::ofstream log_;
 
+    /// Resource usage of main_() (see addResourceCheckpoint_() and option 'resource_report')
+    ResourceTracker resource_tracker_;
+
     /**
       @brief Ensures that at least some default logging destination is
       opened for writing in append mode.
@@ -819,10 +826,49 @@ protected:
     void writeDebug_(const String& text, const Param& param, UInt min_level) const;
     //@}
 
+    /**
+      @brief Marks the end of a processing stage named @p name for the resource report
+
+      Wall time, CPU time and memory since the previous checkpoint (or the start of main_())
+      are reported as a stage of the tool (see option 'resource_report' and debug output).
+      Typical stages are 'loading', the actual algorithm and 'writing'.
+    */
+    void addResourceCheckpoint_(const String& name);
+
     ///@name External processes (TODO consider creating another AdapterBase class)
     //@{
     /// Runs an external process via ExternalProcess and reports its status in the logs
     ExitCodes runExternalProcess_(const QString& executable, const QStringList& arguments, const QString& workdir = "") const;
+
+    /**
+      @brief Runs the same external program once for every entry of @p arguments, at most @p max_concurrent at a time
+
+      All processes are started and monitored from the calling thread, so no extra synchronization is needed.
+      After the first failure no further processes are started (the running ones are waited for).
+      Use @p max_concurrent = 0 to start all processes at once.
+    */
+    ExitCodes runExternalProcesses_(const QString& executable, const std::vector<QStringList>& arguments, const QString& workdir = "", Size max_concurrent = 0) const;
+
+    /**
+      @brief Splits the spectra of @p exp into (at most) @p chunks consecutive ranges and stores them as indexed mzML files named @p file_prefix_\<i\>.mzML
+
+      The chunks contain about the same number of MSn spectra; if there are MS1 spectra, chunks start at an MS1 spectrum
+      so precursor scans stay with their fragment spectra. Native IDs and RTs are kept, i.e. search results on the chunks
+      refer to the spectra of @p exp. Chromatograms are not written.
+
+      @return The names of the files written (empty ranges are skipped)
+    */
+    StringList writeSpectrumChunks_(const PeakMap& exp, Size chunks, const String& file_prefix) const;
+
+    /**
+      @brief Appends the results of a search on one chunk (see writeSpectrumChunks_()) to the results gathered so far
+
+      The first run of @p chunk_proteins becomes the run of the merged results (if @p proteins is still empty).
+      Protein hits of later chunks are added if their accession is new and identifications are re-assigned to the merged run.
+      @p chunk_proteins and @p chunk_peptides are empty afterwards.
+    */
+    static void mergeChunkIdentifications_(std::vector<ProteinIdentification>& proteins, std::vector<PeptideIdentification>& peptides,
+                                           std::vector<ProteinIdentification>& chunk_proteins, std::vector<PeptideIdentification>& chunk_peptides);
     //@}
 
     /**
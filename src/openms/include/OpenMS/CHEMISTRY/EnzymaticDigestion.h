@@ -38,6 +38,7 @@
 #include <OpenMS/CHEMISTRY/DigestionEnzyme.h>
 
 #include <boost/regex.hpp>
+#include <bitset>
 #include <string>
 #include <vector>
 
@@ -212,6 +213,36 @@ protected:
     */
     Size countMissedCleavages_(const std::vector<int>& cleavage_positions, Size seq_start, Size seq_end) const;
 
+    /**
+      @brief One alternative of a simple cleavage regex, checked without the regex engine
+
+      The site in front of residue i matches if residue i-1 is in @p before, residue i is in @p after and not in
+      @p not_after (each only if the corresponding look-around is present).
+      E.g. '(?<=[KR])(?!P)' has before = {K,R} and not_after = {P}.
+    */
+    struct SiteRule_
+    {
+      bool has_before = false;
+      bool has_after = false;
+      bool has_not_after = false;
+      std::bitset<256> before;
+      std::bitset<256> after;
+      std::bitset<256> not_after;
+    };
+
+    /**
+      @brief Translates an enzyme regex into site rules
+
+      Supports alternatives ('|') of (optionally grouped) single-residue look-arounds: '(?<=X)', '(?=X)' and '(?!X)',
+      where X is a residue or a bracket expression of residues, e.g. '(?<=[KR])(?!P)' or '((?<=D))|((?=D))'.
+
+      @return false if @p regex uses anything else (tokenize_() then falls back to the regex)
+    */
+    static bool parseSiteRules_(const String& regex, std::vector<SiteRule_>& rules);
+
+    /// Sets @p enzyme_ and compiles its regex (and site rules, if possible)
+    void compileEnzyme_(const DigestionEnzyme* enzyme);
+
     /// Number of missed cleavages
     Size missed_cleavages_;
 
@@ -219,6 +250,8 @@ protected:
     const DigestionEnzyme* enzyme_;
     /// Regex for tokenizing (huge speedup by making this a member instead of stack object in tokenize_())
     boost::regex re_;
+    /// Site rules equivalent to @p re_ (empty if the regex is too complex, see parseSiteRules_())
+    std::vector<SiteRule_> site_rules_;
 
     /// specificity of enzyme
     Specificity specificity_;
@@ -0,0 +1,151 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsotopeDistribution.h>
+#include <OpenMS/CHEMISTRY/EmpiricalFormula.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <map>
+#include <mutex>
+
+namespace OpenMS
+{
+  /**
+    @ingroup Chemistry
+
+    @brief Thread-safe cache of coarse isotope distributions
+
+    Many algorithms compute the same coarse isotope distributions over and
+    over again, either for the same sum formulas or for averagine formulas of
+    similar masses (which are often identical after rounding the element
+    counts). This cache stores the results of CoarseIsotopePatternGenerator
+    by sum formula, maximal isotope and rounding of masses, so results are
+    exactly the same as computing them directly. The cache returned by
+    getInstance() is shared by all algorithms.
+
+    For uses where an approximation is sufficient,
+    estimateFromPeptideWeightInterpolated() interpolates between the averagine
+    distributions at the borders of fixed mass buckets, so only one
+    distribution per bucket border needs to be computed.
+
+    Cached distributions can be stored to disk and loaded again, e.g. to
+    precompute averagine distributions once.
+
+    Once @p max_entries distributions are stored, further results are
+    computed but not added to the cache.
+  */
+  class OPENMS_DLLAPI CoarseIsotopePatternCache
+  {
+public:
+
+    /// Constructor
+    explicit CoarseIsotopePatternCache(Size max_entries = 100000);
+
+    /// Returns the cache shared by all algorithms
+    static CoarseIsotopePatternCache* getInstance();
+
+    /// Same as formula.getIsotopeDistribution(CoarseIsotopePatternGenerator(max_isotope, round_masses))
+    IsotopeDistribution getIsotopeDistribution(const EmpiricalFormula& formula, Size max_isotope, bool round_masses = false);
+
+    /// Same as above for a sum formula string (which is only parsed if the distribution is not cached)
+    IsotopeDistribution getIsotopeDistribution(const String& formula, Size max_isotope, bool round_masses = false);
+
+    /// Same as CoarseIsotopePatternGenerator(max_isotope).estimateFromPeptideWeight(@p average_weight)
+    IsotopeDistribution estimateFromPeptideWeight(double average_weight, Size max_isotope);
+
+    /**
+      @brief Approximate averagine distribution for @p average_weight
+
+      Masses and intensities are interpolated linearly between the averagine
+      distributions at the two closest multiples of @p bucket_width.
+
+      @exception Exception::InvalidValue is thrown if @p bucket_width is not positive
+    */
+    IsotopeDistribution estimateFromPeptideWeightInterpolated(double average_weight, Size max_isotope, double bucket_width = 10.0);
+
+    /// Computes (and caches) the averagine distributions of all bucket borders up to @p max_weight
+    void precomputeAveragine(double max_weight, Size max_isotope, double bucket_width = 10.0);
+
+    /**
+      @brief Stores all cached distributions in a text file
+
+      @exception Exception::UnableToCreateFile is thrown if the file cannot be created
+    */
+    void store(const String& filename) const;
+
+    /**
+      @brief Adds the distributions stored by store() to the cache
+
+      @exception Exception::FileNotFound is thrown if the file does not exist
+      @exception Exception::ParseError is thrown if the file cannot be parsed
+    */
+    void load(const String& filename);
+
+    /// Number of cached distributions
+    Size size() const;
+
+    /// Removes all cached distributions
+    void clear();
+
+protected:
+
+    /// Cache key
+    struct Key
+    {
+      String formula;
+      Size max_isotope;
+      bool round_masses;
+
+      bool operator<(const Key& rhs) const;
+    };
+
+    /// Returns the cached distribution for @p key, or computes it from @p formula and caches it
+    IsotopeDistribution get_(const Key& key, const EmpiricalFormula& formula);
+
+    /// Returns true and sets @p result if @p key is cached
+    bool find_(const Key& key, IsotopeDistribution& result) const;
+
+    /// Caches @p result (if there is space left)
+    void insert_(const Key& key, const IsotopeDistribution& result);
+
+    std::map<Key, IsotopeDistribution> cache_;
+
+    Size max_entries_;
+
+    mutable std::mutex mutex_;
+  };
+}
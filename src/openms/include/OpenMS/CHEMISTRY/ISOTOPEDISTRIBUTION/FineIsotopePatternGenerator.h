@@ -36,6 +36,8 @@
 
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsotopePatternGenerator.h>
 
+#include <vector>
+
 namespace OpenMS
 {
 
@@ -151,6 +153,20 @@ namespace OpenMS
       **/
     IsotopeDistribution run(const EmpiricalFormula&) const;
 
+    /**
+      * @brief Creates isotope distributions for a batch of empirical sum formulas
+      *
+      * Returns the same distributions as calling run() on each formula, but
+      * the isotope tables of the elements are extracted only once for the
+      * whole batch and shared between all formulas. The formulas are
+      * processed in parallel (if OpenMP is enabled), which makes this the
+      * method of choice when scoring many candidate formulas at once.
+      *
+      * @param formulas The empirical formulas
+      * @return One isotope distribution (sorted by m/z) per input formula, in input order
+      **/
+    std::vector<IsotopeDistribution> runBatch(const std::vector<EmpiricalFormula>& formulas) const;
+
     /// Set probability stop condition (lower values generate fewer results)
     void setThreshold(double stop_condition)
     {
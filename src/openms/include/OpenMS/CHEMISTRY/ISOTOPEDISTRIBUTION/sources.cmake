@@ -4,6 +4,7 @@ set(directory include/OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION)
 
 ### list all header files of the directory here
 set(sources_list_h
+  CoarseIsotopePatternCache.h
   CoarseIsotopePatternGenerator.h
   FineIsotopePatternGenerator.h
   IsoSpecWrapper.h
@@ -35,20 +35,79 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <vector>
 #include <utility>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include <boost/shared_ptr.hpp>
 
 #include <OpenMS/CHEMISTRY/MASSDECOMPOSITION/IMS/Weights.h>
 #include <OpenMS/CHEMISTRY/MASSDECOMPOSITION/IMS/MassDecomposer.h>
 
+#include <OpenMS/CONCEPT/Exception.h>
 #include <OpenMS/MATH/MISC/MathFunctions.h>
 
+namespace boost
+{
+  namespace interprocess
+  {
+    class mapped_region;
+  }
+}
+
 namespace OpenMS
 {
 
   namespace ims
   {
 
+    namespace Internal
+    {
+      /**
+        Read-only memory mapping of a table file of IntegerMassDecomposer (see
+        IntegerMassDecomposer::storeTable()), and replacement of such files such
+        that a mapped file is never truncated or seen half written.
+      */
+      class OPENMS_DLLAPI MappedERTFile
+      {
+public:
+        /// Maps @p filename. Returns false if the file does not exist or cannot be mapped.
+        bool map(const std::string & filename);
+
+        /// Start of the mapped file (nullptr if nothing is mapped)
+        const char * data() const
+        {
+          return data_;
+        }
+
+        /// Size of the mapped file
+        std::size_t size() const
+        {
+          return size_;
+        }
+
+        /// Name of a unique temporary file in the directory of @p filename
+        static std::string temporaryName(const std::string & filename);
+
+        /**
+          Renames @p tmp_filename to @p filename, replacing an existing file.
+
+          @throw Exception::UnableToCreateFile if renaming fails (@p tmp_filename is removed then)
+        */
+        static void replace(const std::string & tmp_filename, const std::string & filename);
+
+private:
+        boost::shared_ptr<boost::interprocess::mapped_region> region_;
+        const char * data_ = nullptr;
+        std::size_t size_ = 0;
+      };
+    }
+
     /**
       @brief Implements @c MassDecomposer interface using algorithm and data
       structures described in paper "Efficient Mass Decomposition"
@@ -93,13 +152,55 @@ public:
       */
       explicit IntegerMassDecomposer(const Weights & alphabet);
 
+      /**
+        Constructor with weights and a table file.
+
+        Loads the extended residue table from @p table_file if the file holds
+        the table of the same @p alphabet (see loadTable()). Otherwise, the
+        table is computed and written to @p table_file (see storeTable()),
+        such that later instances can skip the computation.
+
+        @param alphabet Weights over which masses to be decomposed.
+        @param table_file File to load the table from or store it to.
+
+        @throw Exception::UnableToCreateFile if the table needs to be stored but @p table_file cannot be written
+      */
+      IntegerMassDecomposer(const Weights & alphabet, const std::string & table_file);
+
+      /**
+        Stores the extended residue table (and the data derived from it) in
+        a binary file.
+
+        After a versioned header, the file holds the integer weights of the alphabet,
+        which identify the table (they encode both alphabet masses and precision).
+        All tables are stored as contiguous, 8 byte aligned arrays in native byte order,
+        i.e. the file is only meant to be read on the same platform. The file is written
+        under a temporary name and then renamed, so instances that have mapped an
+        older version of it are not affected.
+
+        @throw Exception::UnableToCreateFile if @p filename cannot be written
+      */
+      void storeTable(const std::string & filename) const;
+
+      /**
+        Maps the extended residue table of a file written by storeTable() into memory.
+
+        The table is not read or copied: queries access the mapped file directly and the
+        operating system pages it in on demand (and shares it between processes). The
+        mapping is kept as long as this decomposer (or a copy of it) exists.
+
+        @return false (and the decomposer is left unchanged) if the file does not exist, is damaged
+        or holds the table of a different alphabet, otherwise true.
+      */
+      bool loadTable(const std::string & filename);
+
       /**
         Returns true if decomposition over the @c mass exists, otherwise - false.
 
         @param mass Mass to be decomposed.
         @return true if decomposition over a given mass exists, otherwise - false.
       */
-      bool exist(value_type mass) override;
+      bool exist(value_type mass) const override;
 
       /**
         Gets one possible decomposition for @c mass.
@@ -107,7 +208,7 @@ public:
         @param mass Mass to be decomposed.
         @return One possible decomposition for a given mass.
       */
-      decomposition_type getDecomposition(value_type mass) override;
+      decomposition_type getDecomposition(value_type mass) const override;
 
       /**
         Gets all possible decompositions for @c mass.
@@ -115,7 +216,7 @@ public:
         @param mass Mass to be decomposed.
         @return All possible decompositions for a given mass.
       */
-      decompositions_type getAllDecompositions(value_type mass) override;
+      decompositions_type getAllDecompositions(value_type mass) const override;
 
       /**
         Gets number of all possible decompositions for a given @c mass.
@@ -125,7 +226,7 @@ public:
         @param mass Mass to be decomposed
         @return number of decompositions for a given mass.
       */
-      decomposition_value_type getNumberOfDecompositions(value_type mass) override;
+      decomposition_value_type getNumberOfDecompositions(value_type mass) const override;
 
 private:
 
@@ -144,6 +245,25 @@ private:
       */
       typedef std::vector<residues_table_row_type> residues_table_type;
 
+      /**
+        Extended residue table and witness vector in contiguous arrays, either
+        computed (and owned) or in a mapped table file. Immutable once set up,
+        so copies of the decomposer share it.
+      */
+      struct Table_
+      {
+        Internal::MappedERTFile file; ///< mapped table file (if loaded)
+        residues_table_row_type ertable_storage; ///< computed table (empty if mapped)
+        residues_table_row_type witness_index_storage; ///< computed witness indices (empty if mapped)
+        std::vector<decomposition_value_type> witness_count_storage; ///< computed witness counts (empty if mapped)
+
+        const value_type * ertable = nullptr; ///< @p columns columns of @p rows entries each
+        const value_type * witness_indices = nullptr; ///< @p rows entries
+        const decomposition_value_type * witness_counts = nullptr; ///< @p rows entries
+        size_type columns = 0;
+        size_type rows = 0;
+      };
+
       /**
         Weights over which the mass is to be decomposed.
       */
@@ -152,9 +272,10 @@ private:
       /**
         Table with the residues of the smallest decomposable numbers over
         every modulo of the smallest alphabet mass are stored.
-        Corresponds to the Extended Residue Table in the paper.
+        Corresponds to the Extended Residue Table in the paper
+        (and the witness vector w, see below).
       */
-      residues_table_type ertable_;
+      std::shared_ptr<const Table_> table_;
 
       /**
         List of the least common multiples. Corresponds to the lcm data structure
@@ -174,12 +295,6 @@ private:
       */
       value_type infty_;
 
-      /**
-        List of the witnesses that is used to find one mass decomposition.
-        Corresponds to the witness vector w in the paper.
-      */
-      witness_vector_type witness_vector_;
-
       /**
         Fills the extended residues table.
       */
@@ -187,6 +302,19 @@ private:
                                      residues_table_row_type & _mass_in_lcms, const value_type _infty,
                                      witness_vector_type & _witness_vector, residues_table_type & _ertable);
 
+      /**
+        Computes the extended residues table (and the data derived from it) for the alphabet.
+      */
+      void computeTable_();
+
+      /**
+        Entry @p row of column @p column of the extended residues table.
+      */
+      value_type ertValue_(size_type column, size_type row) const
+      {
+        return table_->ertable[column * table_->rows + row];
+      }
+
       /**
         Collects decompositions for @c mass by recursion.
 
@@ -196,7 +324,7 @@ private:
         @param decompositionsStore Container where decompositions are collected.
       */
       void collectDecompositionsRecursively_(value_type mass, size_type alphabetMassIndex,
-                                             decomposition_type decomposition, decompositions_type & decompositionsStore);
+                                             decomposition_type decomposition, decompositions_type & decompositionsStore) const;
     };
 
 
@@ -205,14 +333,211 @@ private:
       const Weights & alphabet) :
       alphabet_(alphabet)
     {
+      computeTable_();
+    }
 
-      lcms_.resize(alphabet.size());
-      mass_in_lcms_.resize(alphabet.size());
+    template <typename ValueType, typename DecompositionValueType>
+    IntegerMassDecomposer<ValueType, DecompositionValueType>::IntegerMassDecomposer(
+      const Weights & alphabet, const std::string & table_file) :
+      alphabet_(alphabet)
+    {
+      if (loadTable(table_file))
+      {
+        return;
+      }
+      computeTable_();
+      storeTable(table_file);
+    }
+
+    template <typename ValueType, typename DecompositionValueType>
+    void IntegerMassDecomposer<ValueType, DecompositionValueType>::computeTable_()
+    {
+      lcms_.resize(alphabet_.size());
+      mass_in_lcms_.resize(alphabet_.size());
+
+      infty_ = alphabet_.getWeight(0) * alphabet_.getWeight(alphabet_.size() - 1);
+
+      witness_vector_type witness_vector;
+      residues_table_type ertable;
+      fillExtendedResidueTable_(alphabet_, lcms_, mass_in_lcms_, infty_, witness_vector, ertable);
+
+      // moves the columns into one contiguous array (releasing each column once it is copied)
+      std::shared_ptr<Table_> table(new Table_());
+      table->columns = ertable.size();
+      table->rows = ertable.empty() ? 0 : ertable[0].size();
+      table->ertable_storage.reserve(table->columns * table->rows);
+      for (residues_table_row_type & column : ertable)
+      {
+        table->ertable_storage.insert(table->ertable_storage.end(), column.begin(), column.end());
+        residues_table_row_type().swap(column);
+      }
+      table->witness_index_storage.resize(witness_vector.size());
+      table->witness_count_storage.resize(witness_vector.size());
+      for (size_type i = 0; i < witness_vector.size(); ++i)
+      {
+        table->witness_index_storage[i] = witness_vector[i].first;
+        table->witness_count_storage[i] = witness_vector[i].second;
+      }
+      table->ertable = table->ertable_storage.data();
+      table->witness_indices = table->witness_index_storage.data();
+      table->witness_counts = table->witness_count_storage.data();
+      table_ = table;
+    }
+
+    namespace Internal
+    {
+      /// identifies files written by IntegerMassDecomposer::storeTable()
+      static const char ERT_FILE_MAGIC[8] = {'O', 'M', 'S', 'E', 'R', 'T', '\0', '\0'};
+
+      /// version of the file layout, increase on every change
+      static const unsigned long long ERT_FILE_VERSION = 2;
+
+      /// header of the table files; all arrays that follow start at multiples of 8 bytes
+      struct ERTFileHeader
+      {
+        char magic[8];
+        unsigned long long version;
+        unsigned long long value_size; ///< sizeof(value_type)
+        unsigned long long decomposition_value_size; ///< sizeof(decomposition_value_type)
+        unsigned long long alphabet_size;
+        unsigned long long columns; ///< columns of the extended residue table
+        unsigned long long rows; ///< rows of the extended residue table (and size of the witness vector)
+        unsigned long long infty;
+      };
+
+      /// @p size rounded up to a multiple of 8
+      inline std::size_t alignedERTSize(std::size_t size)
+      {
+        return (size + 7) / 8 * 8;
+      }
+
+      /// writes @p n elements of @p data, padded to a multiple of 8 bytes
+      template <typename T>
+      void writeERTArray(std::ostream & os, const T * data, std::size_t n)
+      {
+        const std::size_t bytes = n * sizeof(T);
+        if (bytes > 0)
+        {
+          os.write(reinterpret_cast<const char *>(data), bytes);
+        }
+        const char padding[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        os.write(padding, alignedERTSize(bytes) - bytes);
+      }
+    }
+
+    template <typename ValueType, typename DecompositionValueType>
+    void IntegerMassDecomposer<ValueType, DecompositionValueType>::storeTable(const std::string & filename) const
+    {
+      Internal::ERTFileHeader header;
+      std::memcpy(header.magic, Internal::ERT_FILE_MAGIC, sizeof(header.magic));
+      header.version = Internal::ERT_FILE_VERSION;
+      header.value_size = sizeof(value_type);
+      header.decomposition_value_size = sizeof(decomposition_value_type);
+      header.alphabet_size = alphabet_.size();
+      header.columns = table_->columns;
+      header.rows = table_->rows;
+      header.infty = infty_;
+
+      std::vector<unsigned long long> weights(alphabet_.size());
+      for (Weights::size_type i = 0; i < alphabet_.size(); ++i)
+      {
+        weights[i] = alphabet_.getWeight(i);
+      }
 
-      infty_ = alphabet.getWeight(0) * alphabet.getWeight(alphabet.size() - 1);
+      const std::string tmp_filename = Internal::MappedERTFile::temporaryName(filename);
+      {
+        std::ofstream os(tmp_filename.c_str(), std::ios::binary | std::ios::trunc);
+        if (!os)
+        {
+          throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+        }
+        os.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        Internal::writeERTArray(os, weights.data(), weights.size());
+        Internal::writeERTArray(os, lcms_.data(), lcms_.size());
+        Internal::writeERTArray(os, mass_in_lcms_.data(), mass_in_lcms_.size());
+        Internal::writeERTArray(os, table_->witness_indices, table_->rows);
+        Internal::writeERTArray(os, table_->witness_counts, table_->rows);
+        Internal::writeERTArray(os, table_->ertable, table_->columns * table_->rows);
+        if (!os)
+        {
+          os.close();
+          std::remove(tmp_filename.c_str());
+          throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+        }
+      }
+      Internal::MappedERTFile::replace(tmp_filename, filename);
+    }
 
-      fillExtendedResidueTable_(alphabet, lcms_, mass_in_lcms_, infty_, witness_vector_, ertable_);
+    template <typename ValueType, typename DecompositionValueType>
+    bool IntegerMassDecomposer<ValueType, DecompositionValueType>::loadTable(const std::string & filename)
+    {
+      static_assert(alignof(value_type) <= 8 && alignof(decomposition_value_type) <= 8, "table arrays are 8 byte aligned");
+
+      std::shared_ptr<Table_> table(new Table_());
+      if (!table->file.map(filename) || table->file.size() < sizeof(Internal::ERTFileHeader))
+      {
+        return false;
+      }
+      const char * data = table->file.data();
+      Internal::ERTFileHeader header;
+      std::memcpy(&header, data, sizeof(header));
+      if (std::memcmp(header.magic, Internal::ERT_FILE_MAGIC, sizeof(header.magic)) != 0 ||
+          header.version != Internal::ERT_FILE_VERSION ||
+          header.value_size != sizeof(value_type) ||
+          header.decomposition_value_size != sizeof(decomposition_value_type) ||
+          header.alphabet_size != alphabet_.size())
+      {
+        return false;
+      }
+
+      // the table dimensions follow from the alphabet (see fillExtendedResidueTable_()),
+      // so a damaged header cannot make the bounds below overflow
+      const bool has_table = alphabet_.size() >= 2;
+      if (header.columns != (has_table ? alphabet_.size() : 0) ||
+          header.rows != (has_table ? alphabet_.getWeight(0) : 0))
+      {
+        return false;
+      }
+
+      const std::size_t n = alphabet_.size();
+      const std::size_t rows = header.rows;
+      const std::size_t weights_offset = sizeof(header);
+      const std::size_t lcms_offset = weights_offset + Internal::alignedERTSize(n * sizeof(unsigned long long));
+      const std::size_t mass_in_lcms_offset = lcms_offset + Internal::alignedERTSize(n * sizeof(value_type));
+      const std::size_t witness_indices_offset = mass_in_lcms_offset + Internal::alignedERTSize(n * sizeof(value_type));
+      const std::size_t witness_counts_offset = witness_indices_offset + Internal::alignedERTSize(rows * sizeof(value_type));
+      const std::size_t ertable_offset = witness_counts_offset + Internal::alignedERTSize(rows * sizeof(decomposition_value_type));
+      const std::size_t file_size = ertable_offset + Internal::alignedERTSize(header.columns * rows * sizeof(value_type));
+      if (table->file.size() != file_size)
+      {
+        return false;
+      }
+
+      // the table must belong to the same (integer) alphabet
+      for (Weights::size_type i = 0; i < n; ++i)
+      {
+        unsigned long long weight;
+        std::memcpy(&weight, data + weights_offset + i * sizeof(weight), sizeof(weight));
+        if (weight != alphabet_.getWeight(i))
+        {
+          return false;
+        }
+      }
 
+      table->columns = header.columns;
+      table->rows = rows;
+      table->ertable = reinterpret_cast<const value_type *>(data + ertable_offset);
+      table->witness_indices = reinterpret_cast<const value_type *>(data + witness_indices_offset);
+      table->witness_counts = reinterpret_cast<const decomposition_value_type *>(data + witness_counts_offset);
+
+      // lcms are tiny (one entry per alphabet mass), they are copied
+      const value_type * lcms = reinterpret_cast<const value_type *>(data + lcms_offset);
+      const value_type * mass_in_lcms = reinterpret_cast<const value_type *>(data + mass_in_lcms_offset);
+      lcms_.assign(lcms, lcms + n);
+      mass_in_lcms_.assign(mass_in_lcms, mass_in_lcms + n);
+      infty_ = static_cast<value_type>(header.infty);
+      table_ = table;
+      return true;
     }
 
     template <typename ValueType, typename DecompositionValueType>
@@ -415,16 +740,16 @@ private:
 
     template <typename ValueType, typename DecompositionValueType>
     bool IntegerMassDecomposer<ValueType, DecompositionValueType>::
-    exist(value_type mass)
+    exist(value_type mass) const
     {
 
-      value_type residue = ertable_.back().at(mass % alphabet_.getWeight(0));
+      value_type residue = ertValue_(table_->columns - 1, mass % alphabet_.getWeight(0));
       return residue != infty_ && mass >= residue;
     }
 
     template <typename ValueType, typename DecompositionValueType>
     typename IntegerMassDecomposer<ValueType, DecompositionValueType>::decomposition_type
-    IntegerMassDecomposer<ValueType, DecompositionValueType>::getDecomposition(value_type mass)
+    IntegerMassDecomposer<ValueType, DecompositionValueType>::getDecomposition(value_type mass) const
     {
 
       decomposition_type decomposition;
@@ -438,15 +763,15 @@ private:
 
       // initial mass residue: in FIND-ONE algorithm in paper corresponds variable "r"
       value_type r = mass % alphabet_.getWeight(0);
-      value_type m = ertable_.back().at(r);
+      value_type m = ertValue_(table_->columns - 1, r);
 
       decomposition.at(0) = static_cast<decomposition_value_type>
                             ((mass - m) / alphabet_.getWeight(0));
 
       while (m != 0)
       {
-        size_type i = witness_vector_.at(r).first;
-        decomposition_value_type j = witness_vector_.at(r).second;
+        size_type i = static_cast<size_type>(table_->witness_indices[r]);
+        decomposition_value_type j = table_->witness_counts[r];
         decomposition.at(i) += j;
         if (m < j * alphabet_.getWeight(i))
         {
@@ -460,7 +785,7 @@ private:
 
     template <typename ValueType, typename DecompositionValueType>
     typename IntegerMassDecomposer<ValueType, DecompositionValueType>::decompositions_type
-    IntegerMassDecomposer<ValueType, DecompositionValueType>::getAllDecompositions(value_type mass)
+    IntegerMassDecomposer<ValueType, DecompositionValueType>::getAllDecompositions(value_type mass) const
     {
       decompositions_type decompositionsStore;
       decomposition_type decomposition(alphabet_.size());
@@ -471,7 +796,7 @@ private:
     template <typename ValueType, typename DecompositionValueType>
     void IntegerMassDecomposer<ValueType, DecompositionValueType>::
     collectDecompositionsRecursively_(value_type mass, size_type alphabetMassIndex,
-                                      decomposition_type decomposition, decompositions_type & decompositionsStore)
+                                      decomposition_type decomposition, decompositions_type & decompositionsStore) const
     {
       if (alphabetMassIndex == 0)
       {
@@ -505,7 +830,7 @@ private:
         }
 
         // r: current residue class. will stay the same in the following loop
-        value_type r = ertable_[alphabetMassIndex - 1][mass_mod_alphabet0];
+        value_type r = ertValue_(alphabetMassIndex - 1, mass_mod_alphabet0);
 
         // TODO: if infty was std::numeric_limits<...>... the following 'if' would not be necessary
         if (r != infty_)
@@ -548,7 +873,7 @@ private:
     */
     template <typename ValueType, typename DecompositionValueType>
     typename IntegerMassDecomposer<ValueType, DecompositionValueType>::decomposition_value_type IntegerMassDecomposer<ValueType,
-                                                                                                                      DecompositionValueType>::getNumberOfDecompositions(value_type mass)
+                                                                                                                      DecompositionValueType>::getNumberOfDecompositions(value_type mass) const
     {
       return static_cast<typename IntegerMassDecomposer<ValueType, DecompositionValueType>::decomposition_value_type>(getAllDecompositions(mass).size());
     }
@@ -38,6 +38,7 @@
 #include <utility>
 #include <map>
 #include <memory>
+#include <string>
 
 #include <OpenMS/CHEMISTRY/MASSDECOMPOSITION/IMS/IntegerMassDecomposer.h>
 
@@ -62,6 +63,9 @@ namespace OpenMS
       them using @c IntegerMassDecomposer, does some checks (i.e. on false
       positives appeared due to rounding) and collects decompositions together.
 
+      All queries are const, i.e. one decomposer can be queried from multiple
+      threads concurrently.
+
       @author Anton Pervukhin <Anton.Pervukhin@CeBiTec.Uni-Bielefeld.DE>
     */
     class OPENMS_DLLAPI RealMassDecomposer
@@ -89,6 +93,15 @@ public:
       */
       explicit RealMassDecomposer(const Weights & weights);
 
+      /**
+        Constructor with weights and a file to persist the table of the
+        integer decomposer in (see IntegerMassDecomposer::storeTable()).
+
+        @param weights Weights over which values/masses to be decomposed.
+        @param table_file The table is loaded from this file if it was computed for the same weights before, otherwise it is computed and stored there.
+      */
+      RealMassDecomposer(const Weights & weights, const std::string & table_file);
+
       /**
         Gets all decompositions for a @c mass with an @c error allowed.
 
@@ -96,9 +109,9 @@ public:
         @param error Error allowed between given and result decomposition.
         @return All possible decompositions for a given mass and error.
       */
-      decompositions_type getDecompositions(double mass, double error);
+      decompositions_type getDecompositions(double mass, double error) const;
 
-      decompositions_type getDecompositions(double mass, double error, const constraints_type & constraints);
+      decompositions_type getDecompositions(double mass, double error, const constraints_type & constraints) const;
 
       /**
        Gets a number of all decompositions for a @c mass with an @c error
@@ -109,7 +122,7 @@ public:
        @param error Error allowed between given and result decomposition.
        @return Number of all decompositions for a given mass and error.
       */
-      number_of_decompositions_type getNumberOfDecompositions(double mass, double error);
+      number_of_decompositions_type getNumberOfDecompositions(double mass, double error) const;
 
 private:
       /// Weights over which values/masses to be decomposed.
@@ -59,6 +59,13 @@ namespace OpenMS
 
     A mass decomposition algorithm decomposes a mass or a mass difference into
     possible amino acids and frequencies of them, which add up to the given mass.
+
+    The table of the decomposer depends on the alphabet (residues and modifications) and
+    the precision only. It is computed whenever the parameters change, which can take a
+    while for fine precisions. If the parameter 'decomp_table_cache' names a directory,
+    the tables are stored there (one file per alphabet and precision) and loaded on the
+    next use of the same configuration.
+
     This class is a wrapper for the algorithm published in
 
     @htmlinclude OpenMS_MassDecompositionAlgorithm.parameters
@@ -85,8 +92,8 @@ public:
       @name Operators
     */
     //@{
-    /// returns the possible decompositions given the weight
-    void getDecompositions(std::vector<MassDecomposition> & decomps, double weight);
+    /// returns the possible decompositions given the weight (thread safe, i.e. can be called concurrently)
+    void getDecompositions(std::vector<MassDecomposition> & decomps, double weight) const;
     //@}
 
 protected:
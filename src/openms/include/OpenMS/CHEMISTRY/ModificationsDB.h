@@ -38,6 +38,7 @@
 #include <OpenMS/DATASTRUCTURES/String.h>
 #include <OpenMS/CHEMISTRY/ResidueModification.h>
 
+#include <atomic>
 #include <set>
 #include <unordered_map>
 
@@ -70,6 +71,13 @@ namespace OpenMS
       databases. This can be done by providing a path through
       initializeModificationsDB(), however it is important that this is done
       *before* the first call to getInstance().
+
+      Name lookups (getModification(), searchModifications(), has() etc.) do
+      not lock: the name index built from the modification files is never
+      changed after construction and can be read concurrently. Modifications
+      registered later through addModification() are kept in a separate,
+      locked index; a bit filter over their names ensures that only lookups
+      of such names have to take the lock.
   */
   class OPENMS_DLLAPI ModificationsDB
   {
@@ -201,9 +209,29 @@ protected:
     /// Stores the modifications
     std::vector<ResidueModification*> mods_;
 
-    /// Stores the mappings of (unique) names to the modifications
+    /// Stores the mappings of (unique) names to the modifications (not changed after construction)
     std::unordered_map<String, std::set<const ResidueModification*> > modification_names_;
 
+    /// Stores the mappings of names to the modifications registered through addModification() (guarded by a lock)
+    std::unordered_map<String, std::set<const ResidueModification*> > added_modification_names_;
+
+    /// Number of 64 bit words of the filter over the names in added_modification_names_
+    static const Size ADDED_NAMES_FILTER_WORDS = 1024;
+
+    /// Bit filter over the name hashes in added_modification_names_ (bits are set before the lock is released and never cleared)
+    std::atomic<UInt64> added_names_filter_[ADDED_NAMES_FILTER_WORDS];
+
+    /**
+       @brief Returns the modifications which have the given name as synonym, or nullptr if there are none
+
+       The lock is only taken if @p mod_name may have been registered through
+       addModification(); in that case the result is assembled in @p buffer.
+    */
+    const std::set<const ResidueModification*>* findModifications_(const String& mod_name, std::set<const ResidueModification*>& buffer) const;
+
+    /// Registers @p mod under @p name in the index of added modifications (must be called with the lock held)
+    void addModificationName_(const String& name, const ResidueModification* mod);
+
     /** @brief Helper function to check if a residue matches the origin for a modification
      *
      * Special cases are handled as follows:
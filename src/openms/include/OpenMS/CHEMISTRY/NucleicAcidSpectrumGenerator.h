@@ -55,6 +55,30 @@ namespace OpenMS
   {
     public:
 
+    /**
+       @brief Uncharged fragment ladder of an oligonucleotide (see getLadder())
+
+       Besides the uncharged fragment peaks, this records where every peak comes from.
+       The ladders of modification variants of the oligo can then be derived by shifting masses instead of rebuilding them.
+    */
+    struct FragmentLadder
+    {
+      /// Origin of a peak in the ladder
+      enum class Source
+      {
+        PREFIX, ///< a/b/c/d ion covering positions [0, index]
+        SUFFIX, ///< w/x/y/z ion covering the last (index + 1) positions
+        A_MINUS_B, ///< a-B ion, base at position index lost
+        PRECURSOR ///< unfragmented oligo
+      };
+
+      MSSpectrum uncharged; ///< uncharged fragment spectrum (with ion names if "add_metainfo" is set)
+      std::vector<std::pair<Source, Size>> sources; ///< origin of every peak in @p uncharged
+      std::vector<const Ribonucleotide*> ribos; ///< ribonucleotides of the oligo
+      const RibonucleotideChainEnd* five_prime = nullptr; ///< 5' modification of the oligo
+      const RibonucleotideChainEnd* three_prime = nullptr; ///< 3' modification of the oligo
+    };
+
     /** @name Constructors and Destructors
     */
     //@{
@@ -93,6 +117,23 @@ namespace OpenMS
     */
     void getMultipleSpectra(std::map<Int, MSSpectrum>& spectra, const NASequence& oligo, const std::set<Int>& charges, Int base_charge = 1) const;
 
+    /**
+       @brief Computes the uncharged fragment ladder of an oligonucleotide, for use with getMultipleSpectra()
+
+       Build the ladder once for an oligo and use it for all of its modification variants.
+       The ladder depends on the parameters; build a new one after changing them.
+    */
+    FragmentLadder getLadder(const NASequence& oligo) const;
+
+    /**
+       @brief Generates spectra in multiple charge states for a modification variant of the oligonucleotide of @p ladder
+
+       Gives the same result as the other overload (up to rounding), but the fragment masses are derived from @p ladder by
+       adding the mass differences of (modified) ribonucleotides and chain ends, instead of building the fragment ladder again.
+       If @p oligo does not fit the ladder (e.g. different length), the ladder is built from scratch.
+    */
+    void getMultipleSpectra(std::map<Int, MSSpectrum>& spectra, const FragmentLadder& ladder, const NASequence& oligo, const std::set<Int>& charges, Int base_charge = 1) const;
+
     /// overwrite
     void updateMembers_() override;
     //@}
@@ -105,8 +146,14 @@ namespace OpenMS
     /// Special version of addFragmentPeaks_() for a-B ions
     void addAMinusBPeaks_(MSSpectrum& spectrum, const std::vector<double>& fragment_masses, const NASequence& oligo, Size start = 0) const;
 
-    /// Generates a spectrum containing peaks for uncharged fragment masses
-    MSSpectrum getUnchargedSpectrum_(const NASequence& oligo) const;
+    /// Generates a spectrum containing peaks for uncharged fragment masses (optionally recording the origin of every peak in @p sources)
+    MSSpectrum getUnchargedSpectrum_(const NASequence& oligo, std::vector<std::pair<FragmentLadder::Source, Size>>* sources = nullptr) const;
+
+    /// Uncharged spectrum of @p oligo, derived from @p ladder if possible (see getMultipleSpectra())
+    MSSpectrum deriveUnchargedSpectrum_(const FragmentLadder& ladder, const NASequence& oligo) const;
+
+    /// Fills @p spectra with the charged versions of @p uncharged_spectrum (see getMultipleSpectra())
+    void addChargedSpectra_(std::map<Int, MSSpectrum>& spectra, const MSSpectrum& uncharged_spectrum, const std::set<Int>& charges, Int base_charge) const;
 
     /// Adds a charged version of an uncharged spectrum to another spectrum
     void addChargedSpectrum_(MSSpectrum& spectrum, const MSSpectrum& uncharged_spectrum, Int charge, bool add_precursor) const;
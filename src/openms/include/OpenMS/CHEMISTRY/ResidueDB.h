@@ -38,7 +38,9 @@
 #include <boost/unordered_map.hpp>
 #include <OpenMS/DATASTRUCTURES/String.h>
 
+#include <atomic>
 #include <set>
+#include <vector>
 
 namespace OpenMS
 {
@@ -56,6 +58,16 @@ namespace OpenMS
       By default no modified residues are stored in an instance. However, if one
       queries the instance with getModifiedResidue, a new modified residue is
       added.
+
+      The unmodified residues and their names are not changed after
+      construction, so getResidue() and hasResidue() do not lock. Modified
+      residues are looked up in an immutable index, which getModifiedResidue()
+      reads without locking. New modified residues (or new names for them) are
+      first added to a small, locked index of recent entries. Once that is as
+      large as the immutable index, both are merged into a new immutable index.
+      The indices thus grow geometrically, and the superseded ones (which
+      concurrent readers may still use) take at most as much memory as the
+      current one.
   */
   class OPENMS_DLLAPI ResidueDB
   {
@@ -201,6 +213,25 @@ protected:
 
     void addResidue_(Residue* residue);
 
+    /// lookup structure for modified residues, see getModifiedResidue()
+    struct ModifiedResidueIndex_
+    {
+      /// residue name -> modification name (as passed to getModifiedResidue()) -> modified residue
+      boost::unordered_map<String, boost::unordered_map<String, const Residue*> > by_name;
+
+      /// all modified residues
+      std::set<const Residue*> residues;
+
+      /// number of entries in by_name
+      Size size = 0;
+
+      /// returns the residue registered for @p residue_name and @p modification, or nullptr
+      const Residue* find(const String& residue_name, const String& modification) const;
+    };
+
+    /// adds @p residue to the recent modified residues, merges them into a new immutable index if needed (must be called with the lock held)
+    void publishModifiedResidue_(const String& residue_name, const String& modification, const Residue* residue);
+
     boost::unordered_map<String, Residue*> residue_names_;
 
     // fast lookup table for residues
@@ -216,6 +247,15 @@ protected:
 
     std::set<const Residue*> const_modified_residues_;
 
+    /// current immutable index of the modified residues, read without locking
+    std::atomic<const ModifiedResidueIndex_*> modified_residue_index_;
+
+    /// all immutable indices published so far (concurrent readers may still use older ones, so they are deleted with the residues)
+    std::vector<const ModifiedResidueIndex_*> modified_residue_indices_;
+
+    /// modified residues registered since the last immutable index was published (guarded by the lock)
+    ModifiedResidueIndex_ recent_modified_residues_;
+
     Map<String, std::set<const Residue*> > residues_by_set_;
 
     std::set<String> residue_sets_;
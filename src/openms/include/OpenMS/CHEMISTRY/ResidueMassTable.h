@@ -0,0 +1,138 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  class ResidueModification;
+
+  /** @ingroup Chemistry
+
+      @brief Flat table of residue masses for computing peptide masses without creating AASequence objects
+
+      The table holds the internal monoisotopic mass of every residue in
+      ResidueDB, indexed by its one letter code, as well as the masses of the
+      peptide termini. Fixed modifications are folded into these masses
+      exactly as ModifiedPeptideGenerator::applyFixedModifications() applies
+      them, so that getMonoWeight() of a sequence equals
+      AASequence::getMonoWeight() of the corresponding fixed-modified peptide.
+
+      This allows enumerating the peptides of a digest and filtering them by
+      precursor mass before any AASequence is built. As the mass of a
+      sequence is the sum of its residue masses plus the mass of the termini,
+      masses of peptides that are extended at their C-terminal end can be
+      computed incrementally:
+
+      @code
+      double residue_sum = 0;
+      for (Size i = 0; i < sequence.size(); ++i)
+      {
+        residue_sum += table.getResidueMass(sequence[i]);
+        double mass = residue_sum + table.getTerminalMass(sequence[0], sequence[i]); // mass of sequence[0..i]
+      }
+      @endcode
+
+      Residues that are unknown to ResidueDB or have no defined mass (X) have
+      a mass of NaN, which propagates to all peptide masses that contain them.
+  */
+  class OPENMS_DLLAPI ResidueMassTable
+  {
+public:
+    /// Creates a table of the unmodified residues
+    ResidueMassTable();
+
+    /**
+      @brief Creates a table with the given fixed modifications applied
+
+      Modifications are applied in the given order, as in
+      ModifiedPeptideGenerator::applyFixedModifications() when iterating over
+      ModifiedPeptideGenerator::MapToResidueType::val.
+    */
+    explicit ResidueMassTable(const std::vector<const ResidueModification*>& fixed_modifications);
+
+    /// Returns the internal monoisotopic mass of the residue with the given one letter code (NaN if unknown)
+    inline double getResidueMass(char one_letter_code) const
+    {
+      return residue_masses_[static_cast<unsigned char>(one_letter_code)];
+    }
+
+    /// Returns the mass of the termini (water and fixed terminal modifications) of a peptide with the given first and last residue
+    inline double getTerminalMass(char first_residue, char last_residue) const
+    {
+      return n_terminal_masses_[static_cast<unsigned char>(first_residue)] + c_terminal_masses_[static_cast<unsigned char>(last_residue)];
+    }
+
+    /**
+      @brief Returns the uncharged monoisotopic mass of @p sequence
+
+      @throw Exception::InvalidValue if @p sequence is empty or contains a residue without mass
+    */
+    double getMonoWeight(const StringView& sequence) const;
+
+    /**
+      @brief Computes the masses of all prefixes of @p sequence, i.e. @p masses[i] is the mass of the first i + 1 residues
+
+      @p masses is resized to the length of @p sequence, so its memory is
+      reused across calls. Prefixes that contain a residue without mass are NaN.
+    */
+    void getPrefixMonoWeights(const StringView& sequence, std::vector<double>& masses) const;
+
+    /**
+      @brief Returns bounds of the mass shift that at most @p max_mods of the given variable modifications can add to a peptide
+
+      The bounds are conservative: all modifications are assumed to be
+      applicable and to be combinable with each other. Terminal modifications
+      may replace a fixed terminal modification of this table.
+    */
+    void getVariableModificationShiftRange(const std::vector<const ResidueModification*>& variable_modifications,
+                                           Size max_mods,
+                                           double& min_shift,
+                                           double& max_shift) const;
+
+protected:
+    /// internal residue masses by one letter code
+    double residue_masses_[256];
+
+    /// water plus the fixed N-terminal modification by first residue
+    double n_terminal_masses_[256];
+
+    /// fixed C-terminal modification by last residue
+    double c_terminal_masses_[256];
+  };
+}
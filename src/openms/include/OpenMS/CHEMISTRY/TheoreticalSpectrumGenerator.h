@@ -92,6 +92,31 @@ namespace OpenMS
     /// Generates a spectrum for a peptide sequence, with the ion types that are set in the tool parameters
     virtual void getSpectrum(PeakSpectrum& spec, const AASequence& peptide, Int min_charge, Int max_charge) const;
 
+    /**
+      @brief Fast path for scoring: computes the m/z values of the prefix and suffix ion series only
+
+      The ion types (a, b, c, x, y, z) and add_first_prefix_ion are taken from the parameters. Isotopes, losses, precursor and
+      immonium ions, intensities and meta data are not generated, regardless of the parameters.
+      The series are computed from running residue masses and merged while they are generated, so @p mz is sorted without
+      an additional sort. The result equals the m/z values of getSpectrum() with these settings (including the order of equal m/z values).
+
+      @p mz (and @p ion_types) are cleared first. Their memory is reused, so passing the same vectors to repeated calls avoids any
+      heap allocation once they have grown to the largest peptide.
+
+      @param mz Output: sorted m/z values
+      @param ion_types Output: ion type ('a', 'b', 'c', 'x', 'y' or 'z') of each m/z value
+      @param peptide The peptide
+      @param min_charge Minimal fragment charge
+      @param max_charge Maximal fragment charge
+
+      @throw Exception::InvalidSize if c- or x-ions are requested for a peptide with less than two residues
+      @throw Exception::InvalidParameter if more than 32 ion series (ion types times charges) are requested
+    */
+    void getIonSeries(std::vector<double>& mz, std::vector<char>& ion_types, const AASequence& peptide, Int min_charge, Int max_charge) const;
+
+    /// Fast path for scoring: computes the sorted m/z values of the prefix and suffix ion series only (see above)
+    void getIonSeries(std::vector<double>& mz, const AASequence& peptide, Int min_charge, Int max_charge) const;
+
     /// overwrite
     void updateMembers_() override;
     //@}
@@ -110,6 +135,9 @@ namespace OpenMS
     /// helper to add an isotope cluster to a spectrum, also adds charges and ion names to the DataArrays, if the add_metainfo parameter is set to true
     void addIsotopeCluster_(PeakSpectrum& spectrum, const AASequence& ion, DataArrays::StringDataArray& ion_names, DataArrays::IntegerDataArray& charges, const Residue::ResidueType res_type, Int charge, double intensity) const;
 
+    /// implementation of getIonSeries() (@p ion_types may be null)
+    void getIonSeries_(std::vector<double>& mz, std::vector<char>* ion_types, const AASequence& peptide, Int min_charge, Int max_charge) const;
+
     /// helper for mapping residue type to letter
     static char residueTypeToIonLetter_(const Residue::ResidueType res_type);
 
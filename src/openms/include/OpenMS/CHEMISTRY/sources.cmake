@@ -26,6 +26,7 @@ ProteaseDB.h
 ProteaseDigestion.h
 Residue.h
 ResidueDB.h
+ResidueMassTable.h
 ResidueModification.h
 RNaseDB.h
 RNaseDigestion.h
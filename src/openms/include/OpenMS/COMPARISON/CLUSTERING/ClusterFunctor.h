@@ -42,6 +42,7 @@
 
 namespace OpenMS
 {
+  class ProgressLogger;
 
   /**
       @brief Base class for cluster functors
@@ -99,6 +100,23 @@ public:
     /// registers all derived products
     static void registerChildren();
 
+protected:
+    /// Lance-Williams update: distance of the merged cluster (i,j) to a cluster k, given d(i,k), d(j,k) and the sizes of i and j
+    typedef float (*LinkageUpdate)(float d_ik, float d_jk, Size size_i, Size size_j);
+
+    /**
+        @brief nearest-neighbour-chain clustering for reducible linkages (e.g. average and complete linkage)
+
+        Follows chains of nearest neighbours and merges reciprocal nearest neighbours, which needs O(n^2) time
+        instead of the O(n^3) of repeatedly searching the closest pair of clusters.
+        The merges are reported in order of increasing distance, so @p cluster_tree is the same as with the
+        closest-pair search (up to ties), including the dummy nodes after @p threshold is reached.
+        @p original_distance is used as work space.
+
+        @throw ClusterFunctor::InsufficientInput thrown if input is <2
+    */
+    static void nearestNeighborChain_(DistanceMatrix<float> & original_distance, std::vector<BinaryTreeNode> & cluster_tree, const float threshold, LinkageUpdate update, const ProgressLogger & progress);
+
   };
 
 }
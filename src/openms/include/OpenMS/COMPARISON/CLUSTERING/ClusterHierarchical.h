@@ -49,6 +49,7 @@
 #include <OpenMS/COMPARISON/SPECTRA/BinnedSpectrumCompareFunctor.h>
 #include <OpenMS/CONCEPT/Exception.h>
 
+#include <exception>
 #include <vector>
 
 namespace OpenMS
@@ -100,6 +101,7 @@ public:
 
         The similarity functor must provide the similarity calculation with the ()-operator and
         yield normalized values in range of [0,1] for the type of < Data >.
+        The distance matrix is computed in parallel; every thread works with its own copy of @p comparator.
 
         @param data vector of objects to be clustered
         @param comparator similarity functor fitting for types in data
@@ -120,14 +122,30 @@ public:
         // create distance matrix for data using comparator
         original_distance.clear();
         original_distance.resize(data.size(), 1);
-        for (Size i = 0; i < data.size(); i++)
+        std::exception_ptr error;
+#pragma omp parallel
         {
-          for (Size j = 0; j < i; j++)
+          // comparators may cache intermediate results, each thread uses its own copy
+          const SimilarityComparator local_comparator(comparator);
+#pragma omp for schedule(dynamic, 1)
+          for (SignedSize i = 0; i < (SignedSize)data.size(); i++)
           {
-            // distance value is 1-similarity value, since similarity is in range of [0,1]
-            original_distance.setValueQuick(i, j, 1 - comparator(data[i], data[j]));
+            try
+            {
+              for (Size j = 0; j < (Size)i; j++)
+              {
+                // distance value is 1-similarity value, since similarity is in range of [0,1]
+                original_distance.setValueQuick(i, j, 1 - local_comparator(data[i], data[j]));
+              }
+            }
+            catch (...)
+            {
+#pragma omp critical (ClusterHierarchical_error)
+              if (!error) error = std::current_exception();
+            }
           }
         }
+        if (error) std::rethrow_exception(error);
       }
 
       // create clustering with ClusterMethod, DistanceMatrix and Data
@@ -137,7 +155,7 @@ public:
     /**
         @brief clustering function for binned PeakSpectrum
 
-        A version of the clustering function for PeakSpectra employing binned similarity methods. From the given PeakSpectrum BinnedSpectrum are generated, so the similarity functor @see BinnedSpectrumCompareFunctor can be applied.
+        A version of the clustering function for PeakSpectra employing binned similarity methods. From the given PeakSpectrum BinnedSpectrum are generated, so the similarity functor @see BinnedSpectrumCompareFunctor can be applied. Binning and the distance matrix are computed in parallel.
 
         @param data vector of @ref PeakSpectrum s to be clustered
         @param comparator a BinnedSpectrumCompareFunctor
@@ -160,28 +178,41 @@ public:
       std::vector<BinaryTreeNode> & cluster_tree, 
       DistanceMatrix<float> & original_distance)
     {
-      std::vector<BinnedSpectrum> binned_data;
-      binned_data.reserve(data.size());
+      std::vector<BinnedSpectrum> binned_data(data.size());
 
       //transform each PeakSpectrum to a corresponding BinnedSpectrum with given settings of size and spread
-      for (Size i = 0; i < data.size(); i++)
+#pragma omp parallel for
+      for (SignedSize i = 0; i < (SignedSize)data.size(); i++)
       {
         //double sz(2), UInt sp(1);
-        binned_data.push_back(BinnedSpectrum(data[i], sz, false, sp, offset));
+        binned_data[i] = BinnedSpectrum(data[i], sz, false, sp, offset);
       }
 
       //create distancematrix for data with comparator
       original_distance.clear();
       original_distance.resize(data.size(), 1);
 
-      for (Size i = 0; i < binned_data.size(); i++)
+      // rows get longer with i, so they are handed out one by one; the binned comparators do not keep state
+      std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 1)
+      for (SignedSize i = 0; i < (SignedSize)binned_data.size(); i++)
       {
-        for (Size j = 0; j < i; j++)
+        try
         {
-          //distance value is 1-similarity value, since similarity is in range of [0,1]
-          original_distance.setValue(i, j, 1 - comparator(binned_data[i], binned_data[j]));
+          for (Size j = 0; j < (Size)i; j++)
+          {
+            //distance value is 1-similarity value, since similarity is in range of [0,1]
+            original_distance.setValueQuick(i, j, 1 - comparator(binned_data[i], binned_data[j]));
+          }
+        }
+        catch (...)
+        {
+#pragma omp critical (ClusterHierarchical_error)
+          if (!error) error = std::current_exception();
         }
       }
+      if (error) std::rethrow_exception(error);
+      original_distance.updateMinElement();
 
       // create Clustering with ClusterMethod, DistanceMatrix and Data
       clusterer(original_distance, cluster_tree, threshold_);
@@ -0,0 +1,293 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Lars Nilse $
+// $Authors: Lars Nilse $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/DATASTRUCTURES/DPosition.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Cache-friendly container for (2-dimensional coordinate, value) pairs.
+
+    Like HashGrid, the coordinate plane is divided into cells of size @p cell_dimension
+    and each pair is assigned to the cell containing its coordinate. Instead of node-based
+    hash maps, all elements are kept in one contiguous array sorted by cell. The position of
+    a cell in that array is looked up in a flat open-addressing table.
+
+    The grid is filled in two steps: insert() collects elements and build() makes them
+    available for queries. Queries (find(), forEachNeighbor(), iteration) only see the
+    elements present at the last call to build(). Elements of a cell are kept in insertion
+    order.
+
+    Use it instead of HashGrid when the grid is filled once and queried many times
+    (e.g. neighbour searches for clustering).
+
+    @tparam Payload Type stored with each coordinate (e.g. a pointer to a feature)
+  */
+  template <typename Payload>
+  class FlatHashGrid
+  {
+public:
+    /// Coordinate for stored pairs
+    typedef DPosition<2, double> ClusterCenter;
+
+    /// Index of a cell
+    typedef DPosition<2, Int64> CellIndex;
+
+    typedef std::pair<ClusterCenter, Payload> value_type;
+    typedef const value_type* const_iterator;
+
+    /// Contiguous range of the elements of one cell
+    class CellRange
+    {
+public:
+      CellRange() :
+        begin_(nullptr), end_(nullptr)
+      {}
+
+      CellRange(const_iterator begin, const_iterator end) :
+        begin_(begin), end_(end)
+      {}
+
+      const_iterator begin() const { return begin_; }
+      const_iterator end() const { return end_; }
+      Size size() const { return end_ - begin_; }
+      bool empty() const { return begin_ == end_; }
+
+private:
+      const_iterator begin_;
+      const_iterator end_;
+    };
+
+    explicit FlatHashGrid(const ClusterCenter& cell_dimension) :
+      cell_dimension_(cell_dimension)
+    {}
+
+    /**
+      @brief Adds a (2-dimensional coordinate, value) pair.
+
+      The element is available for queries after the next call to build().
+
+      @exception Exception::OutOfRange if the cell index of the coordinate does not fit into Int64
+    */
+    void insert(const value_type& v)
+    {
+      cellIndexAt(v.first); // reject unrepresentable coordinates right away
+      pending_.push_back(v);
+    }
+
+    /// Sorts all inserted elements into their cells and rebuilds the cell table
+    void build()
+    {
+      std::vector<value_type> all;
+      all.reserve(elements_.size() + pending_.size());
+      all.insert(all.end(), elements_.begin(), elements_.end());
+      all.insert(all.end(), pending_.begin(), pending_.end());
+      pending_.clear();
+
+      // sort the elements by cell (stable, to keep the insertion order within a cell):
+      std::vector<std::pair<CellIndex, Size> > order;
+      order.reserve(all.size());
+      for (Size i = 0; i < all.size(); ++i)
+      {
+        order.push_back(std::make_pair(cellIndexAt(all[i].first), i));
+      }
+      std::stable_sort(order.begin(), order.end(),
+                       [](const std::pair<CellIndex, Size>& a, const std::pair<CellIndex, Size>& b)
+                       { return a.first < b.first; });
+
+      elements_.clear();
+      elements_.reserve(all.size());
+      cells_.clear();
+      for (Size i = 0; i < order.size(); ++i)
+      {
+        if (cells_.empty() || !(cells_.back().index == order[i].first))
+        {
+          cells_.push_back(Cell_(order[i].first, i));
+        }
+        elements_.push_back(all[order[i].second]);
+        ++cells_.back().end;
+      }
+
+      // open-addressing table with a load factor of at most 0.5:
+      Size table_size = 2;
+      while (table_size < 2 * cells_.size()) table_size *= 2;
+      table_.assign(table_size, empty_slot_());
+      for (Size c = 0; c < cells_.size(); ++c)
+      {
+        Size slot = slot_(cells_[c].index);
+        while (table_[slot] != empty_slot_()) slot = (slot + 1) & (table_.size() - 1);
+        table_[slot] = c;
+      }
+    }
+
+    /// Removes all elements
+    void clear()
+    {
+      elements_.clear();
+      pending_.clear();
+      cells_.clear();
+      table_.clear();
+    }
+
+    /// Number of elements available for queries (i.e. inserted before the last build())
+    Size size() const { return elements_.size(); }
+
+    /// Returns true if no elements are available for queries
+    bool empty() const { return elements_.empty(); }
+
+    /// Iterator to the first element (elements are ordered by cell)
+    const_iterator begin() const { return elements_.empty() ? nullptr : &elements_.front(); }
+
+    /// Iterator past the last element
+    const_iterator end() const { return begin() + elements_.size(); }
+
+    /// Number of non-empty cells
+    Size cellCount() const { return cells_.size(); }
+
+    /// Index of the @p cell-th non-empty cell (cells are sorted lexicographically by index)
+    const CellIndex& getCellIndex(Size cell) const { return cells_[cell].index; }
+
+    /// Elements of the @p cell-th non-empty cell
+    CellRange getCell(Size cell) const { return range_(cells_[cell]); }
+
+    /// Elements of the cell at @p index (empty range if the cell is empty)
+    CellRange find(const CellIndex& index) const
+    {
+      if (table_.empty()) return CellRange();
+      for (Size slot = slot_(index); table_[slot] != empty_slot_(); slot = (slot + 1) & (table_.size() - 1))
+      {
+        const Cell_& cell = cells_[table_[slot]];
+        if (cell.index == index) return range_(cell);
+      }
+      return CellRange();
+    }
+
+    /**
+      @brief Calls @p f for every element in the cell at @p index and its eight neighbouring cells.
+
+      @p f is called with a <tt>const value_type&</tt>. No memory is allocated.
+    */
+    template <typename Function>
+    void forEachNeighbor(const CellIndex& index, Function f) const
+    {
+      for (Int64 i = index[0] - 1; i <= index[0] + 1; ++i)
+      {
+        for (Int64 j = index[1] - 1; j <= index[1] + 1; ++j)
+        {
+          const CellRange cell = find(CellIndex(i, j));
+          for (const_iterator it = cell.begin(); it != cell.end(); ++it)
+          {
+            f(*it);
+          }
+        }
+      }
+    }
+
+    /**
+      @brief Index of the cell containing @p center.
+
+      @exception Exception::OutOfRange if the index does not fit into Int64
+    */
+    CellIndex cellIndexAt(const ClusterCenter& center) const
+    {
+      CellIndex ret;
+      for (Size d = 0; d < 2; ++d)
+      {
+        double t = std::floor(center[d] / cell_dimension_[d]);
+        if (t < std::numeric_limits<Int64>::min() || t > std::numeric_limits<Int64>::max()) throw Exception::OutOfRange(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
+        ret[d] = static_cast<Int64>(t);
+      }
+      return ret;
+    }
+
+    /// Dimension of the cells
+    const ClusterCenter& getCellDimension() const { return cell_dimension_; }
+
+private:
+    /// A non-empty cell: its index and its range [begin, end) in elements_
+    struct Cell_
+    {
+      Cell_(const CellIndex& i, Size b) :
+        index(i), begin(b), end(b)
+      {}
+
+      CellIndex index;
+      Size begin;
+      Size end;
+    };
+
+    static Size empty_slot_() { return std::numeric_limits<Size>::max(); }
+
+    CellRange range_(const Cell_& cell) const
+    {
+      return CellRange(&elements_[0] + cell.begin, &elements_[0] + cell.end);
+    }
+
+    /// Home slot of @p index in table_ (the coordinates are mixed, so that neighbouring and mirrored cells do not collide)
+    Size slot_(const CellIndex& index) const
+    {
+      UInt64 h = static_cast<UInt64>(index[0]) * 0x9E3779B97F4A7C15ULL;
+      h ^= static_cast<UInt64>(index[1]) + 0x7F4A7C159E3779B9ULL + (h << 6) + (h >> 2);
+      h ^= h >> 33;
+      h *= 0xFF51AFD7ED558CCDULL;
+      h ^= h >> 33;
+      return static_cast<Size>(h) & (table_.size() - 1);
+    }
+
+    ClusterCenter cell_dimension_;
+
+    /// Elements sorted by cell (as of the last build())
+    std::vector<value_type> elements_;
+
+    /// Elements inserted since the last build()
+    std::vector<value_type> pending_;
+
+    /// Non-empty cells, sorted by index
+    std::vector<Cell_> cells_;
+
+    /// Open-addressing table of positions in cells_
+    std::vector<Size> table_;
+  };
+
+} // namespace OpenMS
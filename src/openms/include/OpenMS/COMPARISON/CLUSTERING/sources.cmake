@@ -10,6 +10,7 @@ ClusterHierarchical.h
 ClusteringGrid.h
 CompleteLinkage.h
 EuclideanSimilarity.h
+FlatHashGrid.h
 GridBasedCluster.h
 GridBasedClustering.h
 HashGrid.h
@@ -39,6 +39,7 @@
 #include <OpenMS/COMPARISON/SPECTRA/BinnedSpectrum.h>
 
 #include <cmath>
+#include <vector>
 
 namespace OpenMS
 {
@@ -78,6 +79,19 @@ public:
     /// function call operator, calculates self similarity
     virtual double operator()(const BinnedSpectrum& spec) const = 0;
 
+    /**
+      @brief Calculates the similarity of one query against many targets
+
+      Equivalent to calling operator()(query, targets[i]) for every target, but
+      derived functors compute per-query terms only once. Use this for one-vs-many
+      and all-vs-all comparisons.
+
+      @param query Query spectrum
+      @param targets Target spectra (all with the same binning as @p query)
+      @param scores Output: one score per target (resized to targets.size())
+    */
+    virtual void compareBatch(const BinnedSpectrum& query, const std::vector<BinnedSpectrum>& targets, std::vector<double>& scores) const;
+
     /// registers all derived products
     static void registerChildren();
 
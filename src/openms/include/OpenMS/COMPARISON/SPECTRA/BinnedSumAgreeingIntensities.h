@@ -89,6 +89,9 @@ public:
     /// function call operator, calculates self similarity
     double operator()(const BinnedSpectrum& spec) const override;
 
+    /// scores @p query against all @p targets (see BinnedSpectrumCompareFunctor::compareBatch())
+    void compareBatch(const BinnedSpectrum& query, const std::vector<BinnedSpectrum>& targets, std::vector<double>& scores) const override;
+
     ///
     static BinnedSpectrumCompareFunctor* create() { return new BinnedSumAgreeingIntensities(); }
 
@@ -0,0 +1,134 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/KERNEL/StandardTypes.h>
+#include <OpenMS/CONCEPT/Types.h>
+
+#include <utility>
+#include <vector>
+
+namespace OpenMS
+{
+
+/**
+  @brief Peak matching kernels on contiguous, sorted m/z arrays
+
+  The PSM scores (e.g. HyperScore, MorpheusScore, XQuestScores) all match the
+  peaks of a reference spectrum (usually the theoretical one) against a target
+  spectrum (usually the experimental one). The kernels here do that with a single
+  forward pass over plain m/z arrays. The tolerance window of each reference peak
+  is computed once by getToleranceWindows(), so no ppm conversion is needed during
+  matching.
+
+  All m/z arrays need to be sorted in ascending order.
+
+  @ingroup SpectraComparison
+*/
+struct OPENMS_DLLAPI PeakMatcher
+{
+  /// appends the m/z values of @p spectrum to @p mz
+  static void getMZs(const PeakSpectrum& spectrum, std::vector<double>& mz);
+
+  /// appends the intensities of @p spectrum to @p intensities
+  static void getIntensities(const PeakSpectrum& spectrum, std::vector<double>& intensities);
+
+  /**
+    @brief Computes the tolerance window [@p lower, @p upper] around each value of @p mz
+
+    @param mz sorted m/z values
+    @param tolerance tolerance applied left and right of each value
+    @param tolerance_unit_ppm Unit of the tolerance is: Thomson if false, ppm if true
+    @param lower lower bounds of the windows (output)
+    @param upper upper bounds of the windows (output)
+  */
+  static void getToleranceWindows(const std::vector<double>& mz, double tolerance, bool tolerance_unit_ppm, std::vector<double>& lower, std::vector<double>& upper);
+
+  /**
+    @brief Finds the closest target peak in the window of each reference peak
+
+    Same matching as MatchedIterator: if two target peaks have the same distance,
+    the one with the smaller m/z is preferred. A target peak can be matched by several
+    reference peaks.
+
+    @param ref_mz reference m/z values
+    @param lower lower window bounds of @p ref_mz (see getToleranceWindows())
+    @param upper upper window bounds of @p ref_mz (see getToleranceWindows())
+    @param tgt_mz target m/z values
+    @param matches pairs of (reference index, target index), appended in order of the reference peaks
+    @return the number of appended pairs
+  */
+  static Size matchClosest(const std::vector<double>& ref_mz, const std::vector<double>& lower, const std::vector<double>& upper,
+                           const std::vector<double>& tgt_mz, std::vector<std::pair<Size, Size> >& matches);
+
+  /**
+    @brief Counts the reference peaks with at least one target peak in their window
+
+    @param lower lower window bounds of the reference peaks
+    @param upper upper window bounds of the reference peaks
+    @param tgt_mz target m/z values
+  */
+  static Size countMatchedReference(const std::vector<double>& lower, const std::vector<double>& upper, const std::vector<double>& tgt_mz);
+
+  /**
+    @brief Sums up the intensities of the target peaks in the window of at least one reference peak
+
+    Every target peak is counted once. Its mass error is the distance to the first
+    reference peak whose window contains it.
+
+    @param ref_mz reference m/z values
+    @param lower lower window bounds of @p ref_mz
+    @param upper upper window bounds of @p ref_mz
+    @param tgt_mz target m/z values
+    @param tgt_intensities target intensities
+    @param matched number of matched target peaks (output)
+    @param sum_error sum of the absolute mass errors of the matched target peaks in Da (output)
+    @return the summed intensity of the matched target peaks
+  */
+  static double sumMatchedTarget(const std::vector<double>& ref_mz, const std::vector<double>& lower, const std::vector<double>& upper,
+                                 const std::vector<double>& tgt_mz, const std::vector<double>& tgt_intensities, Size& matched, double& sum_error);
+
+  /**
+    @brief Counts the bins occupied by both spectra
+
+    A peak at m/z @em x occupies the bin ceil(x / @p bin_size). This does the same as
+    comparing two binned spectra, but without allocating the bin tables.
+  */
+  static Size countSharedBins(const std::vector<double>& mz1, const std::vector<double>& mz2, double bin_size);
+};
+
+}
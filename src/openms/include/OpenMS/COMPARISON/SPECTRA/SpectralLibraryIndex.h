@@ -0,0 +1,109 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/COMPARISON/SPECTRA/BinnedSpectrum.h>
+#include <OpenMS/KERNEL/MSSpectrum.h>
+
+#include <utility>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+      @brief Index of library spectra by precursor m/z, optionally with pre-binned spectra
+
+      The index stores the first precursor m/z of every library spectrum
+      (spectra without precursor are not indexed) together with the position
+      of the spectrum in the library. Lookups of all library spectra within a
+      precursor m/z window are binary searches. Spectra with equal precursor
+      m/z are returned in library order.
+
+      If requested, the library spectra are binned and normalized once during
+      construction, as done by SpectraSTSimilarityScore::transform(), so that
+      SpectraST scores only need to bin the query spectrum.
+
+      The index does not copy the library spectra: positions refer to the
+      container passed to the constructor.
+
+      @ingroup SpectraComparison
+  */
+  class OPENMS_DLLAPI SpectralLibraryIndex
+  {
+public:
+    /// precursor m/z and library position of an indexed spectrum
+    typedef std::pair<double, Size> Entry;
+    typedef std::vector<Entry>::const_iterator ConstIterator;
+
+    /// default constructor (empty index)
+    SpectralLibraryIndex();
+
+    /**
+        @brief builds the index of @p library
+
+        @param library the library spectra
+        @param bin_spectra also precompute binned and normalized spectra (SpectraST representation)
+    */
+    explicit SpectralLibraryIndex(const std::vector<MSSpectrum>& library, bool bin_spectra = false);
+
+    /// number of indexed spectra
+    Size size() const;
+
+    /// true if no spectrum is indexed
+    bool empty() const;
+
+    /// all indexed spectra with a precursor m/z in the closed interval [@p mz_low, @p mz_high], sorted by precursor m/z
+    std::pair<ConstIterator, ConstIterator> findByPrecursorMZ(double mz_low, double mz_high) const;
+
+    /// whether binned spectra were precomputed
+    bool hasBinnedSpectra() const;
+
+    /**
+        @brief the binned and normalized spectrum of the library spectrum at @p position
+
+        @exception Exception::Precondition if no binned spectra were precomputed
+        @exception Exception::IndexOverflow if @p position is not a valid library position
+    */
+    const BinnedSpectrum& getBinnedSpectrum(Size position) const;
+
+protected:
+    /// entries sorted by precursor m/z (and library position)
+    std::vector<Entry> entries_;
+
+    /// binned spectra by library position (empty if not requested)
+    std::vector<BinnedSpectrum> binned_spectra_;
+  };
+
+}
@@ -9,8 +9,10 @@ BinnedSpectrum.h
 BinnedSpectrumCompareFunctor.h
 BinnedSumAgreeingIntensities.h
 PeakAlignment.h
+PeakMatcher.h
 PeakSpectrumCompareFunctor.h
 SpectraSTSimilarityScore.h
+SpectralLibraryIndex.h
 SpectrumAlignment.h
 SpectrumAlignmentScore.h
 SpectrumCheapDPCorr.h
@@ -37,6 +37,7 @@
 #include <OpenMS/CONCEPT/Macros.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
 
+#include <atomic>
 #include <sstream>
 #include <iostream>
 #include <list>
@@ -307,6 +308,12 @@ protected:
       OpenMP critical pragma), however there may be a small performance penalty
       to this.
 
+      @note The macros only evaluate (and format) their message if the log stream
+      has an associated stream (see hasStreams()), so e.g. OPENMS_LOG_DEBUG statements
+      are cheap unless debug output was requested. If OPENMS_LOG_DISABLE_DEBUG is defined
+      at compile time, OPENMS_LOG_DEBUG statements are removed entirely.
+      Messages of statements in hot loops can be limited using OPENMS_LOG_WARN_LIMITED.
+
     */
     class OPENMS_DLLAPI LogStream :
       public std::ostream
@@ -428,6 +435,13 @@ public:
       ///
       void flush();
       //@}
+
+      /**
+        Returns whether any stream is associated with this LogStream, i.e. whether
+        messages written to it are output at all. This is a cheap check, which the
+        log macros use to skip the formatting of messages nobody receives.
+      */
+      bool hasStreams() const;
 private:
 
       typedef std::list<LogStreamBuf::StreamStruct>::iterator StreamIterator;
@@ -444,32 +458,67 @@ private:
 
     }; //LogStream
 
+    /**
+      @brief Returns true for the first @p limit calls with the same @p counter (thread safe, without locking)
+
+      Used by OPENMS_LOG_WARN_LIMITED to limit the number of messages of a single log statement.
+    */
+    inline bool withinLimit(std::atomic<Size>& counter, Size limit)
+    {
+      return counter.fetch_add(1, std::memory_order_relaxed) < limit;
+    }
+
   } // namespace Logger
 
+  /// Internal: only evaluates the following statement if @p stream has associated streams (a loop instead of an if avoids dangling-else issues at call sites)
+#define OPENMS_LOG_IF_BOUND_(stream) \
+  for (bool openms_log_bound_ = (stream).hasStreams(); openms_log_bound_; openms_log_bound_ = false)
+
+  /// Internal: only evaluates the following statement the first @p limit times this statement is executed
+#define OPENMS_LOG_IF_WITHIN_LIMIT_(limit) \
+  for (bool openms_log_within_limit_ = OpenMS::Logger::withinLimit([]() -> std::atomic<OpenMS::Size>& { static std::atomic<OpenMS::Size> count(0); return count; }(), limit); \
+       openms_log_within_limit_; openms_log_within_limit_ = false)
+
   /// Macro to be used if fatal error are reported (processing stops)
 #define OPENMS_LOG_FATAL_ERROR \
+  OPENMS_LOG_IF_BOUND_(OpenMS_Log_fatal) \
   OPENMS_THREAD_CRITICAL(LOGSTREAM) \
   OpenMS_Log_fatal << __FILE__ << "(" << __LINE__ << "): "
 
   /// Macro to be used if non-fatal error are reported (processing continues)
 #define OPENMS_LOG_ERROR \
+  OPENMS_LOG_IF_BOUND_(OpenMS_Log_error) \
   OPENMS_THREAD_CRITICAL(LOGSTREAM) \
   OpenMS_Log_error
 
   /// Macro if a warning, a piece of information which should be read by the user, should be logged
 #define OPENMS_LOG_WARN \
+  OPENMS_LOG_IF_BOUND_(OpenMS_Log_warn) \
   OPENMS_THREAD_CRITICAL(LOGSTREAM) \
   OpenMS_Log_warn
 
+  /// Macro like OPENMS_LOG_WARN, but the statement only logs (at most) the first @p limit times it is executed (e.g. for warnings in loops)
+#define OPENMS_LOG_WARN_LIMITED(limit) \
+  OPENMS_LOG_IF_WITHIN_LIMIT_(limit) \
+  OPENMS_LOG_WARN
+
   /// Macro if a information, e.g. a status should be reported
 #define OPENMS_LOG_INFO \
+  OPENMS_LOG_IF_BOUND_(OpenMS_Log_info) \
   OPENMS_THREAD_CRITICAL(LOGSTREAM) \
   OpenMS_Log_info
 
   /// Macro for general debugging information
+#ifdef OPENMS_LOG_DISABLE_DEBUG
+#define OPENMS_LOG_DEBUG \
+  for (bool openms_log_disabled_ = false; openms_log_disabled_; openms_log_disabled_ = false) \
+  OpenMS_Log_debug << __FILE__ << "(" << __LINE__ << "): "
+#else
 #define OPENMS_LOG_DEBUG \
+  OPENMS_LOG_IF_BOUND_(OpenMS_Log_debug) \
   OPENMS_THREAD_CRITICAL(LOGSTREAM) \
   OpenMS_Log_debug << __FILE__ << "(" << __LINE__ << "): "
+#endif
 
   OPENMS_DLLAPI extern Logger::LogStream OpenMS_Log_fatal; ///< Global static instance of a LogStream to capture messages classified as fatal errors. By default it is bound to @b cerr.
   OPENMS_DLLAPI extern Logger::LogStream OpenMS_Log_error; ///< Global static instance of a LogStream to capture messages classified as errors. By default it is bound to @b cerr.
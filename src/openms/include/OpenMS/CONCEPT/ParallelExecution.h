@@ -0,0 +1,262 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/config.h>
+#include <OpenMS/CONCEPT/Types.h>
+
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+namespace OpenMS
+{
+  /**
+    @brief Central entry point for the multi-threaded execution of loops, independent tasks and ordered pipelines.
+
+    All parallel work of the library runs on the single (OpenMP) thread pool, whose size is configured
+    once by setNumberOfThreads() (e.g. by TOPPBase from the '-threads' parameter). The number of threads
+    is never larger than the number of CPUs the process may use (see getAvailableCores()), so cgroup CPU
+    quotas of containers and batch systems are honoured.
+
+    Parallel regions are not nested: calling forEach(), runTasks() or pipeline() from within a parallel
+    region (e.g. a parallelized algorithm used inside a parallel loop over SWATH windows or samples)
+    executes the work serially on the calling thread. Thus the thread pool is never oversubscribed.
+
+    Exceptions thrown by the work items are caught; once all items are processed, the first one
+    is rethrown on the calling thread.
+
+    @code
+    ParallelExecution::forEach(0, (SignedSize)spectra.size(), [&](SignedSize i)
+    {
+      process(spectra[i]);
+    }, ParallelExecution::Schedule::DYNAMIC);
+    @endcode
+
+    @ingroup Concept
+  */
+  class OPENMS_DLLAPI ParallelExecution
+  {
+public:
+    /// Distribution of loop iterations over the threads
+    enum class Schedule
+    {
+      STATIC,  ///< equally sized blocks of iterations per thread (for iterations of similar cost)
+      DYNAMIC  ///< threads fetch chunks of iterations on demand (for iterations of varying cost)
+    };
+
+    /// Placement of the threads of the pool on the CPU cores (see setThreadAffinity())
+    enum class ThreadAffinity
+    {
+      NONE,   ///< threads may run on all available cores (the default)
+      CLOSE,  ///< thread i is pinned to the i-th available core (threads share as few sockets as possible)
+      SPREAD  ///< threads are pinned to cores distributed evenly over all available cores (and thus over all sockets)
+    };
+
+    /**
+      @brief Sets the number of threads used for parallel execution
+
+      @p num_threads is limited to the number of available cores. Values < 1 use all available cores.
+      Nested parallel regions are disabled.
+    */
+    static void setNumberOfThreads(int num_threads);
+
+    /// Returns the number of threads used by parallel regions started from the current thread (1 within a parallel region)
+    static int getNumberOfThreads();
+
+    /**
+      @brief Returns the number of CPU cores the process may use
+
+      Considers the number of hardware threads, the CPU affinity mask of the process and (on Linux)
+      the CPU quota of its cgroup (v1 and v2).
+    */
+    static int getAvailableCores();
+
+    /**
+      @brief Pins the threads of the pool to CPU cores
+
+      Pinning keeps a thread on the NUMA node where it first touched its data (e.g. the spectra it decoded
+      while loading), which avoids remote memory accesses in later parallel loops with the same (static)
+      distribution of work. Call it after setNumberOfThreads(). Only the threads of the OpenMP runtime
+      are pinned, which keeps its pool of threads for later parallel regions of the same size. The
+      environment variables OMP_PROC_BIND and OMP_PLACES are not overridden if they are set.
+
+      @note Only supported on Linux; a no-op elsewhere.
+    */
+    static void setThreadAffinity(ThreadAffinity affinity);
+
+    /// Are we currently executing inside an active parallel region?
+    static bool inParallelRegion();
+
+    /**
+      @brief Calls @p f(i) for all i in [@p begin, @p end) in parallel
+
+      @param chunk_size number of consecutive iterations fetched at once (Schedule::DYNAMIC only)
+    */
+    template <typename Function>
+    static void forEach(SignedSize begin, SignedSize end, const Function& f, Schedule schedule = Schedule::STATIC, int chunk_size = 1)
+    {
+      std::exception_ptr error;
+      const bool parallel = end - begin > 1 && !inParallelRegion();
+      if (schedule == Schedule::DYNAMIC)
+      {
+#pragma omp parallel for schedule(dynamic, chunk_size) if (parallel)
+        for (SignedSize i = begin; i < end; ++i)
+        {
+          try
+          {
+            f(i);
+          }
+          catch (...)
+          {
+#pragma omp critical (ParallelExecution_error)
+            if (!error) error = std::current_exception();
+          }
+        }
+      }
+      else
+      {
+#pragma omp parallel for schedule(static) if (parallel)
+        for (SignedSize i = begin; i < end; ++i)
+        {
+          try
+          {
+            f(i);
+          }
+          catch (...)
+          {
+#pragma omp critical (ParallelExecution_error)
+            if (!error) error = std::current_exception();
+          }
+        }
+      }
+      if (error) std::rethrow_exception(error);
+    }
+
+    /**
+      @brief Like forEach(), but every thread first creates its own state by calling @p init() and passes it to @p f(state, i)
+
+      Use this for workers with caches or other mutable members that must not be shared between threads.
+    */
+    template <typename Init, typename Function>
+    static void forEachWithState(SignedSize begin, SignedSize end, const Init& init, const Function& f, Schedule schedule = Schedule::STATIC, int chunk_size = 1)
+    {
+      typedef decltype(init()) State;
+      std::exception_ptr error;
+      const bool parallel = end - begin > 1 && !inParallelRegion();
+#pragma omp parallel if (parallel)
+      {
+        // all threads need to reach the loop, even if creating their state failed
+        std::unique_ptr<State> state;
+        try
+        {
+          state.reset(new State(init()));
+        }
+        catch (...)
+        {
+#pragma omp critical (ParallelExecution_error)
+          if (!error) error = std::current_exception();
+        }
+        if (schedule == Schedule::DYNAMIC)
+        {
+#pragma omp for schedule(dynamic, chunk_size)
+          for (SignedSize i = begin; i < end; ++i)
+          {
+            if (!state) continue;
+            try
+            {
+              f(*state, i);
+            }
+            catch (...)
+            {
+#pragma omp critical (ParallelExecution_error)
+              if (!error) error = std::current_exception();
+            }
+          }
+        }
+        else
+        {
+#pragma omp for schedule(static)
+          for (SignedSize i = begin; i < end; ++i)
+          {
+            if (!state) continue;
+            try
+            {
+              f(*state, i);
+            }
+            catch (...)
+            {
+#pragma omp critical (ParallelExecution_error)
+              if (!error) error = std::current_exception();
+            }
+          }
+        }
+      }
+      if (error) std::rethrow_exception(error);
+    }
+
+    /// Runs independent @p tasks in parallel (each task is executed by one thread)
+    static void runTasks(const std::vector<std::function<void()> >& tasks);
+
+    /**
+      @brief Calls @p compute(i) in parallel and @p consume(i) serially in increasing order of i, for all i in [@p begin, @p end)
+
+      The iterations are processed in blocks of @p block_size: @p compute is run for all iterations of a block in
+      parallel, then @p consume is called for them in order. Use this to parallelize the expensive part of a loop
+      whose results need to be collected (or written) in a fixed order, while bounding the number of intermediate
+      results held in memory to @p block_size.
+    */
+    template <typename Compute, typename Consume>
+    static void pipeline(SignedSize begin, SignedSize end, SignedSize block_size, const Compute& compute, const Consume& consume, Schedule schedule = Schedule::DYNAMIC)
+    {
+      if (block_size < 1) block_size = 1;
+      for (SignedSize block_begin = begin; block_begin < end; block_begin += block_size)
+      {
+        const SignedSize block_end = std::min(end, block_begin + block_size);
+        forEach(block_begin, block_end, compute, schedule);
+        for (SignedSize i = block_begin; i < block_end; ++i)
+        {
+          consume(i);
+        }
+      }
+    }
+  };
+
+} // namespace OpenMS
@@ -37,6 +37,7 @@
 #include <OpenMS/config.h>
 #include <OpenMS/CONCEPT/Types.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
+#include <OpenMS/DATASTRUCTURES/NumericCodec.h>
 #include <iostream>
 
 namespace OpenMS
@@ -101,10 +102,10 @@ private:
   template <typename FloatingPointType>
   inline std::ostream & operator<<(std::ostream & os, const PrecisionWrapper<FloatingPointType> & rhs)
   {
-    // manual conversion to String is much faster than ostreams internal conversion
-    // (this calls the correct overload for extra precision)
-    String s(rhs.ref_, true);
-    os << s;
+    // manual conversion is much faster than ostreams internal conversion
+    // (this calls the correct overload for extra precision); the text is the same as String(rhs.ref_, true)
+    char buffer[NumericCodec::MAX_LENGTH];
+    os.write(buffer, NumericCodec::write(rhs.ref_, buffer, true));
     return os;
   }
 } // namespace OpenMS
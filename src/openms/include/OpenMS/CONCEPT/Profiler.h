@@ -0,0 +1,170 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/config.h>
+#include <OpenMS/CONCEPT/Types.h>
+
+#include <atomic>
+#include <iosfwd>
+
+namespace OpenMS
+{
+  class String;
+  class StopWatch;
+
+  /**
+    @brief Lightweight, thread-safe collection of timings, counters and histograms of hot code regions.
+
+    Code regions are annotated with OPENMS_PROFILE_SCOPE (or a Profiler::ScopedTimer), event counts
+    with Profiler::addCounter and value distributions with Profiler::addSample.
+    Collection is disabled by default. In that case every annotation costs a single atomic load,
+    so the annotations can stay compiled in. TOPP tools enable it with the @em -profile option.
+
+    Every thread records into its own buffer, guarded by a lock that is only contended while the data is read.
+    The collected data can be written as a Chrome trace (JSON, see chrome://tracing or https://ui.perfetto.dev)
+    using storeChromeTrace() or summarized as a table using printSummary().
+
+    @note Names of scopes, counters and histograms are stored as pointers, i.e. they need to point to
+    storage that outlives the profile (string literals). Use intern() for names that are built at runtime.
+
+    @ingroup Concept
+  */
+  class OPENMS_DLLAPI Profiler
+  {
+public:
+    /**
+      @brief Measures the (wall clock) time between its construction and destruction.
+
+      The time is recorded as trace event and added to the timing statistics of its name.
+    */
+    class OPENMS_DLLAPI ScopedTimer
+    {
+public:
+      /// start measuring (if profiling is enabled); @p name needs to outlive the profile
+      explicit ScopedTimer(const char* name) :
+        name_(name),
+        start_(Profiler::isEnabled() ? Profiler::now() : -1)
+      {
+      }
+
+      /// stop measuring and record the elapsed time
+      ~ScopedTimer()
+      {
+        if (start_ >= 0) Profiler::addEvent(name_, start_, Profiler::now());
+      }
+
+      ScopedTimer(const ScopedTimer&) = delete;
+      ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+      const char* name_;
+      Int64 start_;
+    };
+
+    /// Enables or disables collection (already collected data is kept)
+    static void setEnabled(bool enabled);
+
+    /// Returns true if data is currently collected
+    static bool isEnabled()
+    {
+      return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /// Discards all collected data of all threads
+    static void clear();
+
+    /// Current time in nanoseconds since the profiler was first used
+    static Int64 now();
+
+    /// Records a completed region from @p start to @p end (as returned by now())
+    static void addEvent(const char* name, Int64 start, Int64 end);
+
+    /// Adds the (wall clock) time measured by @p sw to the timing statistics of @p name (no trace event is recorded)
+    static void addStopWatch(const char* name, const StopWatch& sw);
+
+    /// Increases the counter @p name by @p value
+    static void addCounter(const char* name, Int64 value = 1)
+    {
+      if (isEnabled()) addCounter_(name, value);
+    }
+
+    /// Adds @p value to the (per-thread) histogram @p name
+    static void addSample(const char* name, double value)
+    {
+      if (isEnabled()) addSample_(name, value);
+    }
+
+    /// Returns a pointer to a copy of @p name that stays valid for the lifetime of the program
+    static const char* intern(const String& name);
+
+    /// Returns the total of counter @p name summed over all threads
+    static Int64 getCounter(const String& name);
+
+    /// Returns how often the region @p name was recorded (summed over all threads)
+    static Size getTimerCount(const String& name);
+
+    /**
+      @brief Writes all recorded events, counters and histograms as Chrome trace (JSON) to @p filename
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    static void storeChromeTrace(const String& filename);
+
+    /// Prints a table of all timers, counters and histograms to @p os
+    static void printSummary(std::ostream& os);
+
+    /// Maximum number of trace events kept per thread; the timing statistics keep counting beyond that
+    static const Size MAX_EVENTS_PER_THREAD = 1000000;
+
+private:
+    static void addCounter_(const char* name, Int64 value);
+    static void addSample_(const char* name, double value);
+
+    static std::atomic<bool> enabled_;
+  };
+
+} // namespace OpenMS
+
+/// helper macros to create a unique variable name
+#define OPENMS_PROFILE_CONCAT_IMPL_(a, b) a ## b
+#define OPENMS_PROFILE_CONCAT_(a, b) OPENMS_PROFILE_CONCAT_IMPL_(a, b)
+
+/**
+  @brief Measures the time spent in the enclosing scope under the name @p name (a string literal).
+
+  @ingroup Concept
+*/
+#define OPENMS_PROFILE_SCOPE(name) OpenMS::Profiler::ScopedTimer OPENMS_PROFILE_CONCAT_(openms_profile_scope_, __LINE__)(name)
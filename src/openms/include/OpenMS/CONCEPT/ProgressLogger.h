@@ -37,6 +37,8 @@
 #include <OpenMS/CONCEPT/Types.h>
 
 #include <map>
+#include <utility>
+#include <vector>
 
 namespace OpenMS
 {
@@ -49,6 +51,9 @@ namespace OpenMS
 
     Use startProgress, setProgress and endProgress for the actual logging.
 
+    If the Profiler is enabled, every startProgress/endProgress pair is additionally recorded as
+    profiling region named by the progress label (independent of the log type).
+
     @note All methods are const, so it can be used through a const reference or in const methods as well!
   */
   class OPENMS_DLLAPI ProgressLogger
@@ -123,13 +128,15 @@ public:
 protected:
     mutable LogType type_;
     mutable time_t last_invoke_;
-    static int recursion_depth_;
 
     /// Return the name of the factory product used for this log type
     static String logTypeToFactoryName_(LogType type);
 
     mutable ProgressLoggerImpl* current_logger_;
 
+    /// label and start time of the currently open progress regions (only used if the Profiler is enabled)
+    mutable std::vector<std::pair<const char*, Int64> > profile_regions_;
+
   };
 
 } // namespace OpenMS
@@ -41,6 +41,8 @@
 #include <boost/random/variate_generator.hpp>
 #include <boost/random/uniform_int.hpp>
 
+#include <atomic>
+
 
 namespace OpenMS
 {
@@ -52,8 +54,15 @@ namespace OpenMS
 
     The unique ids are 64-bit random unsigned random integers.
     The class is implemented as a singleton.
+
     The random generator is implemented using boost::random.
 
+    Each thread takes the ids from a small block of random numbers which is refilled from the shared
+    generator when it is used up, so getUniqueId() only synchronizes once per block. In a single thread,
+    the ids are exactly the sequence of the generator, i.e. a fixed seed reproduces the same ids.
+    With several threads, all ids are still drawn from that sequence (and are thus distinct), but which
+    of them are used depends on the scheduling.
+
     @ingroup Concept
   */
   class OPENMS_DLLAPI UniqueIdGenerator
@@ -64,7 +73,7 @@ public:
     /// Returns a new unique id
     static UInt64 getUniqueId();
 
-    /// Initializes random generator using the given value.
+    /// Initializes random generator using the given value. Must not be called concurrently with getUniqueId().
     static void setSeed(const UInt64);
 
     /// Get the seed
@@ -75,13 +84,15 @@ protected:
     ~UniqueIdGenerator();
 
 private:
-    static UInt64 seed_;
-    static UniqueIdGenerator* instance_;
-    static boost::mt19937_64* rng_;
-    static boost::uniform_int<UInt64>* dist_;
+    UInt64 seed_; ///< the seed
+    boost::mt19937_64 rng_; ///< the random generator
+    boost::uniform_int<UInt64> dist_; ///< distribution over all 64-bit values
+    std::atomic<UInt64> generation_; ///< incremented by setSeed(), invalidates the blocks of all threads
 
     static UniqueIdGenerator& getInstance_();
-    void init_();
+
+    /// Writes the next @p count ids of the random sequence to @p ids and returns the current generation
+    UInt64 drawIds_(UInt64* ids, Size count);
     UniqueIdGenerator(const UniqueIdGenerator& );//protect from c++ auto-generation
   };
 
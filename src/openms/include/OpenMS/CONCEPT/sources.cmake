@@ -16,7 +16,9 @@ LogConfigHandler.h
 LogStream.h
 Macros.h
 MacrosTest.h
+ParallelExecution.h
 PrecisionWrapper.h
+Profiler.h
 ProgressLogger.h
 RAIICleanup.h
 SingletonRegistry.h
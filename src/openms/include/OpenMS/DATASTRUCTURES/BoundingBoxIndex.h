@@ -0,0 +1,134 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/DATASTRUCTURES/DBoundingBox.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Spatial index for point-in-box queries on a set of 2D bounding boxes
+
+    Answers "which boxes enclose this position?" without testing every box,
+    e.g. to find the features (bounding boxes in RT x m/z) a peptide
+    identification can be mapped to.
+
+    The first dimension (usually RT) is partitioned into bins of equal width;
+    each box is listed in every bin it overlaps. Within a bin, the boxes are
+    sorted by their lower bound in the second dimension (usually m/z), so a
+    query only visits boxes whose lower bound lies within one maximal box
+    height below the position.
+
+    The index is immutable after build() and query() is const, so queries can
+    be run in parallel.
+
+    @ingroup Datastructures
+  */
+  class OPENMS_DLLAPI BoundingBoxIndex
+  {
+public:
+    /// Box type
+    typedef DBoundingBox<2> BoxType;
+    /// Position type
+    typedef BoxType::PositionType PositionType;
+
+    /// Default constructor (empty index)
+    BoundingBoxIndex();
+
+    /// Constructor building the index (see build())
+    explicit BoundingBoxIndex(const std::vector<BoxType>& boxes, double bin_width = 0.0);
+
+    /**
+      @brief Builds the index for @p boxes (replaces a previous index)
+
+      Empty boxes are never reported by query().
+
+      @param boxes The boxes (referred to by their index in this vector)
+      @param bin_width Width of the bins in the first dimension. If not positive,
+             the median width of the boxes is used.
+    */
+    void build(const std::vector<BoxType>& boxes, double bin_width = 0.0);
+
+    /// Removes all boxes
+    void clear();
+
+    /// Returns the number of boxes (including empty ones)
+    Size size() const;
+
+    /// Returns if the index contains no boxes
+    bool empty() const;
+
+    /// Returns the box with index @p index
+    const BoxType& getBox(Size index) const;
+
+    /**
+      @brief Collects the indices of all boxes enclosing @p position
+
+      Same result as testing BoxType::encloses() for every box.
+
+      @param position The query position
+      @param result Indices of the enclosing boxes in ascending order (cleared first)
+    */
+    void query(const PositionType& position, std::vector<Size>& result) const;
+
+protected:
+    /// A box in a bin
+    struct Entry_
+    {
+      double min_y;
+      double max_y;
+      Size index;
+    };
+
+    /// All boxes
+    std::vector<BoxType> boxes_;
+    /// Lower bound of the first bin
+    double min_x_;
+    /// Upper bound of all boxes in the first dimension
+    double max_x_;
+    /// Width of the bins
+    double bin_width_;
+    /// First entry of each bin (number of bins + 1 entries)
+    std::vector<Size> bin_begin_;
+    /// Maximal box height in the second dimension per bin
+    std::vector<double> bin_max_height_;
+    /// Boxes per bin, sorted by lower bound in the second dimension
+    std::vector<Entry_> entries_;
+  };
+
+} // namespace OpenMS
+
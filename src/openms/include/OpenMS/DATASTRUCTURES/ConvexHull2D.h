@@ -106,7 +106,7 @@ public:
     /// accessor for the outer(!) points (no checking is performed if this is actually a convex hull)
     void setHullPoints(const PointArrayType& points);
 
-    /// returns the bounding box of the feature hull points
+    /// returns the bounding box of the feature hull points (kept up to date when points are added, no recomputation)
     DBoundingBox<2> getBoundingBox() const;
 
     /// adds a point to the hull if it is not already contained. Returns if the point was added.
@@ -153,6 +153,19 @@ public:
           **/
     bool encloses(const PointType& point) const;
 
+    /**
+      @brief tests for each of the @p points if it lies in the feature hull (see encloses(const PointType&) const)
+
+      Faster than querying the points one by one, since the scans of the hull are copied into flat sorted arrays
+      only once for all points.
+
+      @param points The points to test
+      @param result Is set to one entry per point, true if the point lies in the hull
+
+      @throws Exception::NotImplemented if only hull points (outer_points_), but no internal structure (map_points_) is given
+    **/
+    void encloses(const PointArrayType& points, std::vector<bool>& result) const;
+
 protected:
     /// internal structure maintaining the hull and enabling queries to encloses()
     HullPointType map_points_;
@@ -160,6 +173,9 @@ protected:
     /// just the list of points of the outer hull (derived from map_points_ or given by user)
     mutable PointArrayType outer_points_;
 
+    /// bounding box of map_points_ (or of outer_points_ if given by the user)
+    DBoundingBox<2> bounding_box_;
+
   };
 } // namespace OPENMS
 
@@ -40,7 +40,10 @@
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
 #include <OpenMS/DATASTRUCTURES/StringUtils.h>
 #include <OpenMS/FORMAT/FASTAFile.h>
+#include <OpenMS/FORMAT/FASTAIndex.h>
 
+#include <algorithm>
+#include <atomic>
 #include <functional>
 #include <fstream>
 #include <map>
@@ -55,6 +58,7 @@ namespace OpenMS
 
   struct TFI_File; ///< template parameter for file-based FASTA access
   struct TFI_Vector; ///< template parameter for vector-based FASTA access
+  struct TFI_MMap; ///< template parameter for memory-mapped, indexed FASTA access
 
   /**
   @brief This class allows for a chunk-wise single linear read over a (large) FASTA file, 
@@ -63,7 +67,7 @@ namespace OpenMS
   
   Internally uses FASTAFile class to read single sequences.
 
-  FASTAContainer supports two template specializations FASTAContainer<TFI_File> and FASTAContainer<TFI_Vector>.
+  FASTAContainer supports three template specializations FASTAContainer<TFI_File>, FASTAContainer<TFI_Vector> and FASTAContainer<TFI_MMap>.
   
   FASTAContainer<TFI_File> will make FASTA entries available chunk-wise from start to end by loading it from a FASTA file.
   This avoids having to load the full file into memory. While loading, the container will
@@ -73,6 +77,9 @@ namespace OpenMS
   FASTAContainer<TFI_Vector> simply takes an existing vector of FASTAEntries and provides the same interface
   (with a potentially huge speed benefit over FASTAContainer<TFI_File> since it does not need disk access, but at the cost of memory).
 
+  FASTAContainer<TFI_MMap> memory-maps the FASTA file and indexes all entries upfront (see FASTAIndex), so any entry can be
+  read quickly at any time, the total number of entries is known, and several passes over the data do not require re-parsing.
+
   If an algorithm searches through a FASTA file linearly, you can use FASTAContainer<TFI_File> to pre-load a small chunk
   and start working, while loading the next chunk in a background thread and swap it in when the active chunk 
   was processed.
@@ -98,6 +105,7 @@ public:
   /// C'tor with FASTA filename
   FASTAContainer(const String& FASTA_file)
     : f_(),
+    filename_(FASTA_file),
     offsets_(),
     data_fg_(),
     data_bg_(),
@@ -106,6 +114,12 @@ public:
     f_.readStart(FASTA_file);
   }
 
+  /// name of the underlying FASTA file
+  const String& getFileName() const
+  {
+    return filename_;
+  }
+
   /// how many entries were read and got swapped out already
   size_t getChunkOffset() const
   {
@@ -227,12 +241,181 @@ public:
 
 private:
   FASTAFile f_; ///< FASTA file connection
+  String filename_; ///< name of the FASTA file
   std::vector<std::streampos> offsets_; ///< internal byte offsets into FASTA file for random access reading of previous entries.
   std::vector<FASTAFile::FASTAEntry> data_fg_; ///< active (foreground) data
   std::vector<FASTAFile::FASTAEntry> data_bg_; ///< prefetched (background) data; will become the next active data
   size_t chunk_offset_; ///< number of entries before the current chunk
 };
 
+/**
+  @brief FASTAContainer<TFI_MMap> provides the chunked interface of FASTAContainer<TFI_File> on a memory-mapped FASTA file
+  with a faidx-style index (see FASTAIndex).
+
+  All entries are indexed on construction (or the index is read from an up-to-date '.fai' file next to the FASTA file),
+  thus size() is the total number of entries right away, and readAt() and getSequence() are fast for any entry, independent
+  of the active chunk.
+
+  Besides the single-threaded cacheChunk()/activateCache() cycle, several threads can iterate over the entries concurrently
+  by claiming ranges with nextChunk() and reading them with readAt().
+*/
+template<>
+class FASTAContainer<TFI_MMap>
+{
+public:
+  FASTAContainer() = delete;
+
+  /// C'tor with FASTA filename (see FASTAIndex::open())
+  FASTAContainer(const String& FASTA_file)
+    : index_(FASTA_file),
+    data_fg_(),
+    data_bg_(),
+    chunk_offset_(0),
+    read_pos_(0),
+    next_chunk_(0)
+  {
+  }
+
+  /// name of the underlying FASTA file
+  const String& getFileName() const
+  {
+    return index_.getFileName();
+  }
+
+  /// the index of the underlying FASTA file
+  const FASTAIndex& getIndex() const
+  {
+    return index_;
+  }
+
+  /// how many entries were swapped out already
+  size_t getChunkOffset() const
+  {
+    return chunk_offset_;
+  }
+
+  /** @brief Swaps in the background cache of entries, read previously via @p cacheChunk()
+
+      @return true if cache contains data; false if empty
+      @note Should be invoked by a single thread, followed by a barrier to sync access of subsequent calls to chunkAt()
+  */
+  bool activateCache()
+  {
+    chunk_offset_ += data_fg_.size();
+    data_fg_.swap(data_bg_);
+    data_bg_.clear();
+    return !data_fg_.empty();
+  }
+
+  /** @brief Prefetch a new cache in the background, with up to @p suggested_size entries (or fewer upon reaching the end)
+
+     Call @p activateCache() afterwards to make the data available via @p chunkAt().
+     @return true if new data is available; false if background data is empty
+  */
+  bool cacheChunk(int suggested_size)
+  {
+    data_bg_.clear();
+    const size_t end = std::min(index_.size(), read_pos_ + (size_t)std::max(suggested_size, 0));
+    data_bg_.resize(end - read_pos_);
+    for (size_t i = read_pos_; i < end; ++i)
+    {
+      index_.readEntry(i, data_bg_[i - read_pos_]);
+    }
+    read_pos_ = end;
+    return !data_bg_.empty();
+  }
+
+  /// number of entries in active cache
+  size_t chunkSize() const
+  {
+    return data_fg_.size();
+  }
+
+  /** @brief Retrieve a FASTA entry at cache position @p pos (fast)
+
+      Requires prior call to activateCache().
+      Index @p pos must be smaller than chunkSize().
+
+      @note: can be used by multiple threads at a time (until activateCache() is called)
+  */
+  const FASTAFile::FASTAEntry& chunkAt(size_t pos) const
+  {
+    return data_fg_[pos];
+  }
+
+  /** @brief Retrieve a FASTA entry at global position @p pos (fast, read from the mapped file)
+
+    @param protein Return value
+    @param pos Absolute entry number in FASTA file
+    @return true
+    @throw Exception::IndexOverflow if @p pos is not smaller than size()
+    @note: can be used by multiple threads at a time
+  */
+  bool readAt(FASTAFile::FASTAEntry& protein, size_t pos) const
+  {
+    if (pos >= index_.size())
+    {
+      throw Exception::IndexOverflow(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, pos, index_.size());
+    }
+    return index_.readEntry(pos, protein);
+  }
+
+  /** @brief Retrieve the sequence of the entry with identifier @p identifier (the record is found in constant time)
+
+    @return false if there is no such entry
+    @note: can be used by multiple threads at a time
+  */
+  bool getSequence(const String& identifier, String& sequence) const
+  {
+    return index_.getSequence(identifier, sequence);
+  }
+
+  /** @brief Claims the next range of (up to) @p chunk_size entries for processing by the calling thread
+
+    Each entry is handed out exactly once (until reset() is called), so several threads can loop over
+    the whole file concurrently, reading the claimed entries [@p begin, @p end) with readAt().
+    Independent of the cacheChunk()/activateCache() cycle.
+
+    @return false if all entries were claimed already
+  */
+  bool nextChunk(size_t chunk_size, size_t& begin, size_t& end)
+  {
+    begin = std::min(next_chunk_.fetch_add(chunk_size), index_.size());
+    end = std::min(begin + chunk_size, index_.size());
+    return begin < end;
+  }
+
+  /// is the FASTA file empty?
+  bool empty() const
+  {
+    return index_.empty();
+  }
+
+  /// resets reading of the FASTA file, enables fresh reading of the FASTA from the beginning
+  void reset()
+  {
+    data_fg_.clear();
+    data_bg_.clear();
+    chunk_offset_ = 0;
+    read_pos_ = 0;
+    next_chunk_ = 0;
+  }
+
+  /// number of entries in the FASTA file
+  size_t size() const
+  {
+    return index_.size();
+  }
+
+private:
+  FASTAIndex index_; ///< mapped and indexed FASTA file
+  std::vector<FASTAFile::FASTAEntry> data_fg_; ///< active (foreground) data
+  std::vector<FASTAFile::FASTAEntry> data_bg_; ///< prefetched (background) data; will become the next active data
+  size_t chunk_offset_; ///< number of entries before the current chunk
+  size_t read_pos_; ///< number of entries read by cacheChunk() so far
+  std::atomic<size_t> next_chunk_; ///< first entry not claimed by nextChunk() yet
+};
+
 /**
 @brief 
 FASTAContainer<TFI_Vector> simply takes an existing vector of FASTAEntries and provides the same interface
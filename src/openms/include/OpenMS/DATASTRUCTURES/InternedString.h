@@ -0,0 +1,138 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <functional>
+
+namespace OpenMS
+{
+  /**
+    @brief An immutable string stored once in a global pool ("interned")
+
+    Identifiers like protein accessions are repeated very often (e.g. in the peptide evidences of
+    the PSMs of a protein). An InternedString only stores a pointer to the single copy of its value in
+    the pool. Thus copies are cheap, equality and hashing are O(1) (pointer comparison), and the
+    memory of the value is shared. Ordering compares the values.
+
+    Values are never removed from the pool, so only use it for values that repeat (accessions,
+    file names, ...), not for unique ones. Interning is thread-safe; accessing the value does not lock.
+
+    @ingroup Datastructure
+  */
+  class OPENMS_DLLAPI InternedString
+  {
+  public:
+    /// Default constructor (the empty string)
+    InternedString();
+
+    /// Interns @p s
+    explicit InternedString(const String& s);
+
+    /// Copy constructor
+    InternedString(const InternedString&) = default;
+
+    /// Assignment operator
+    InternedString& operator=(const InternedString&) = default;
+
+    /// Assigns (and interns) @p s
+    InternedString& operator=(const String& s);
+
+    /// Returns the value
+    const String& get() const
+    {
+      return *value_;
+    }
+
+    /// Conversion to the value
+    operator const String&() const
+    {
+      return *value_;
+    }
+
+    /// Is this the empty string?
+    bool empty() const
+    {
+      return value_->empty();
+    }
+
+    /// Equality (O(1): equal values are the same entry of the pool)
+    bool operator==(const InternedString& rhs) const
+    {
+      return value_ == rhs.value_;
+    }
+
+    /// Inequality (O(1))
+    bool operator!=(const InternedString& rhs) const
+    {
+      return value_ != rhs.value_;
+    }
+
+    /// Lexicographical order of the values
+    bool operator<(const InternedString& rhs) const
+    {
+      return value_ != rhs.value_ && *value_ < *rhs.value_;
+    }
+
+    /// Hash of the entry in the pool (O(1), not the hash of the value)
+    std::size_t hash() const
+    {
+      return std::hash<const String*>()(value_);
+    }
+
+    /// Number of distinct values in the pool
+    static Size poolSize();
+
+  private:
+    /// Returns the entry of @p s in the pool (inserts it if needed)
+    static const String* intern_(const String& s);
+
+    const String* value_; ///< entry in the pool (never null)
+  };
+
+} // namespace OpenMS
+
+namespace std
+{
+  /// hash for InternedString (O(1))
+  template <> struct hash<OpenMS::InternedString>
+  {
+    std::size_t operator()(const OpenMS::InternedString& s) const
+    {
+      return s.hash();
+    }
+  };
+} // namespace std
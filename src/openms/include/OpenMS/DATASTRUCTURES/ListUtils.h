@@ -211,10 +211,11 @@ public:
       String ret = String(*it);
       // we have handled the first element
       ++it;
-      // add the rest
+      // add the rest (appending piecewise avoids a temporary per element)
       for (; it != container.end(); ++it)
       {
-        ret += (glue + String(*it));
+        ret += glue;
+        ret += String(*it);
       }
 
       return ret;
@@ -96,6 +96,8 @@ public:
     using Base::find;
     using Base::empty;
     using Base::count;
+    using Base::lower_bound;
+    using Base::upper_bound;
 
     using typename Base::iterator;
     using typename Base::const_iterator;
@@ -0,0 +1,138 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg, Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+
+#include <limits>
+#include <type_traits>
+
+namespace OpenMS
+{
+  /**
+    @brief Locale-independent conversion between numbers and character buffers
+
+    In contrast to the String conversions (String(double), String::toDouble()), no String objects are
+    involved: numbers are parsed directly from a character range and written into a buffer provided by
+    the caller. This is meant for the file handlers, which convert millions of numbers and would otherwise
+    allocate a temporary String for each of them.
+
+    The results are identical to the String conversions, i.e. the codec can be used as a drop-in replacement:
+    floating point numbers use the same boost::spirit grammars and precision policies as StringUtils,
+    integers use the boost::spirit qi/karma integer parsers and generators.
+
+    @ingroup Datastructures
+  */
+  class OPENMS_DLLAPI NumericCodec
+  {
+public:
+    /// Buffer size that is sufficient for every number written by write()
+    static const Size MAX_LENGTH = 64;
+
+    /**
+      @name Parsing
+
+      The character range [@p begin, @p end) is parsed into @p value. As for String::toDouble(), leading and
+      trailing whitespace is skipped and everything else must belong to the number ('nan' and 'inf' are accepted).
+
+      @return true on success; @p value is not changed on failure
+    */
+    //@{
+    static bool parse(const char* begin, const char* end, double& value);
+
+    static bool parse(const char* begin, const char* end, float& value);
+
+    template <typename IntegerT>
+    static typename std::enable_if<std::is_integral<IntegerT>::value, bool>::type
+    parse(const char* begin, const char* end, IntegerT& value)
+    {
+      typename Wide_<IntegerT>::Type result;
+      if (!parseInteger_(begin, end, result)) return false;
+      if (result < std::numeric_limits<IntegerT>::min() || result > std::numeric_limits<IntegerT>::max()) return false;
+      value = static_cast<IntegerT>(result);
+      return true;
+    }
+    //@}
+
+    /**
+      @name Formatting
+
+      @p value is written to @p buffer (which must hold at least MAX_LENGTH characters) without a terminating
+      null character. The text is identical to String(value, full_precision).
+
+      @return The number of characters written
+    */
+    //@{
+    static Size write(double value, char* buffer, bool full_precision = true);
+
+    static Size write(float value, char* buffer, bool full_precision = true);
+
+    static Size write(long double value, char* buffer, bool full_precision = true);
+
+    template <typename IntegerT>
+    static typename std::enable_if<std::is_integral<IntegerT>::value, Size>::type
+    write(IntegerT value, char* buffer)
+    {
+      return writeInteger_(static_cast<typename Wide_<IntegerT>::Type>(value), buffer);
+    }
+    //@}
+
+private:
+    /// 64 bit integer type with the signedness of @p IntegerT
+    template <typename IntegerT>
+    struct Wide_
+    {
+      typedef typename std::conditional<std::is_signed<IntegerT>::value, Int64, UInt64>::type Type;
+    };
+
+    /// @name Integer conversions of the widest types (implemented with boost::spirit, see StringUtils)
+    //@{
+    static bool parseInteger_(const char* begin, const char* end, Int64& value);
+
+    static bool parseInteger_(const char* begin, const char* end, UInt64& value);
+
+    static Size writeInteger_(Int64 value, char* buffer);
+
+    static Size writeInteger_(UInt64 value, char* buffer);
+    //@}
+
+    /// Advances @p begin over whitespace (as boost::spirit::ascii::space)
+    static void skipSpace_(const char*& begin, const char* end)
+    {
+      while (begin != end && (*begin == ' ' || (*begin >= '\t' && *begin <= '\r'))) ++begin;
+    }
+  };
+
+} // namespace OpenMS
@@ -39,8 +39,11 @@
 #include <OpenMS/DATASTRUCTURES/String.h>
 #include <OpenMS/OpenMSConfig.h>
 
+#include <atomic>
 #include <iosfwd>
+#include <memory>
 #include <set>
+#include <unordered_map>
 
 namespace OpenMS
 {
@@ -254,20 +257,20 @@ protected:
     /// Default constructor
     Param();
 
-    /// Copy constructor
-    Param(const Param&) = default;
+    /// Copy constructor (cheap: the parameter tree is shared until one of the copies is modified)
+    Param(const Param&);
 
-    /// Move constructor
-    Param(Param&&) = default;
+    /// Move constructor (leaves @p rhs empty)
+    Param(Param&&);
 
     /// Destructor
     ~Param();
 
-    /// Assignment operator
-    Param& operator=(const Param&) = default;
+    /// Assignment operator (cheap: the parameter tree is shared until one of the copies is modified)
+    Param& operator=(const Param&);
 
     /// Move assignment operator
-    Param& operator=(Param&&) & = default;
+    Param& operator=(Param&&) &;
 
     /// Equality operator
     bool operator==(const Param& rhs) const;
@@ -642,18 +645,43 @@ protected:
 
 protected:
 
+    /// Hashed lookup of entries by their full name (e.g. 'algorithm:common:param')
+    typedef std::unordered_map<String, ParamEntry*> EntryIndex;
+
+    /**
+      @brief Returns a parameter entry (using the hashed index if available).
+
+      @exception Exception::ElementNotFound is thrown for unset parameters
+    */
+    const ParamEntry& getEntry_(const String& key) const;
+
     /**
-      @brief Returns a mutable reference to a parameter entry.
+      @brief Returns a mutable reference to a parameter entry (un-shares the tree first).
 
       @exception Exception::ElementNotFound is thrown for unset parameters
     */
-    ParamEntry& getEntry_(const String& key) const;
+    ParamEntry& getEntry_(const String& key);
+
+    /// Returns the entry @p key or nullptr (builds the hashed index on repeated lookups)
+    ParamEntry* findEntry_(const String& key) const;
+
+    /// Adds all entries below @p node to @p index
+    static void indexEntries_(ParamNode& node, const String& prefix, EntryIndex& index);
+
+    /// Must be called before root_ is modified: copies the tree if it is shared with other Param objects and invalidates the index
+    void detach_();
 
     /// Constructor from a node which is used as root node
     Param(const Param::ParamNode& node);
 
-    /// Invisible root node that stores all the data
-    mutable Param::ParamNode root_;
+    /// Invisible root node that stores all the data (shared between copies, copied on the first modification)
+    std::shared_ptr<Param::ParamNode> root_;
+
+    /// Hashed index of the entries of root_ (built lazily by read-only lookups, dropped by detach_())
+    mutable std::shared_ptr<const EntryIndex> index_;
+
+    /// Number of read-only lookups since the last modification
+    mutable std::atomic<UInt> lookups_;
   };
 
   /// Output of Param to a stream.
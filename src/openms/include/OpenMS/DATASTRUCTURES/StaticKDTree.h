@@ -0,0 +1,268 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Johannes Veit $
+// $Authors: Johannes Veit $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+
+namespace OpenMS
+{
+
+  /**
+    @brief A static k-d tree on points of @p D dimensions for fast box and radius queries
+
+    The tree is built once from an array of points (see build()) and can only be queried
+    afterwards. It is stored implicitly in two arrays (no node objects, no pointers):
+    the points are reordered such that each range [begin, end) of the array is a subtree,
+    whose root is the median element at begin + (end - begin) / 2 (in the split dimension,
+    which cycles with the depth); the left and right subtrees are the ranges before and after it.
+    Ranges of at most LEAF_SIZE points are leaves and are scanned linearly.
+
+    Construction takes O(n log n) and the independent subtrees of each level are
+    partitioned in parallel. Queries are const and can be issued from several threads
+    concurrently; queryBoxes() and queryRadii() answer a batch of queries in parallel.
+
+    Query results are the indices of the points in the array given to build(), in no particular order.
+
+    @ingroup Datastructures
+  */
+  template <UInt D>
+  class StaticKDTree
+  {
+public:
+
+    /// Coordinates of a point
+    typedef std::array<double, D> PointType;
+
+    /// Maximal number of points in a leaf
+    static const Size LEAF_SIZE = 8;
+
+    /// Default constructor (empty tree)
+    StaticKDTree() = default;
+
+    /// Constructor building the tree on @p points
+    explicit StaticKDTree(const std::vector<PointType>& points)
+    {
+      build(points);
+    }
+
+    /// (Re-)builds the tree on @p points; point i is reported as index i by the queries
+    void build(const std::vector<PointType>& points)
+    {
+      const Size n = points.size();
+      // partition the points themselves (not indices into them) for memory locality
+      std::vector<std::pair<PointType, Size> > entries(n);
+      for (Size i = 0; i < n; ++i)
+      {
+        entries[i] = std::make_pair(points[i], i);
+      }
+
+      // partition level by level; subtrees of the same level are independent
+      std::vector<Range_> level(1, Range_{0, n, 0});
+      while (!level.empty())
+      {
+        std::vector<Range_> children(2 * level.size());
+#pragma omp parallel for schedule(dynamic, 1) if (level.size() > 1)
+        for (SignedSize i = 0; i < (SignedSize)level.size(); ++i)
+        {
+          const Range_ r = level[i];
+          if (r.end - r.begin <= LEAF_SIZE) continue; // leaf (children stay empty)
+          const Size mid = r.begin + (r.end - r.begin) / 2;
+          const UInt dim = r.dim;
+          std::nth_element(entries.begin() + r.begin, entries.begin() + mid, entries.begin() + r.end,
+                           [dim](const std::pair<PointType, Size>& a, const std::pair<PointType, Size>& b) { return a.first[dim] < b.first[dim]; });
+          const UInt next_dim = (dim + 1) % D;
+          children[2 * i] = Range_{r.begin, mid, next_dim};
+          children[2 * i + 1] = Range_{mid + 1, r.end, next_dim};
+        }
+        level.clear();
+        for (const Range_& r : children)
+        {
+          if (r.end > r.begin) level.push_back(r);
+        }
+      }
+
+      points_.resize(n);
+      indices_.resize(n);
+      for (Size i = 0; i < n; ++i)
+      {
+        points_[i] = entries[i].first;
+        indices_[i] = entries[i].second;
+      }
+    }
+
+    /// Number of points in the tree
+    Size size() const
+    {
+      return points_.size();
+    }
+
+    /// Returns whether the tree is empty
+    bool empty() const
+    {
+      return points_.empty();
+    }
+
+    /// Removes all points
+    void clear()
+    {
+      points_.clear();
+      indices_.clear();
+    }
+
+    /// Appends the indices of all points with @p low[d] <= p[d] <= @p high[d] (for all dimensions d) to @p result
+    void queryBox(const PointType& low, const PointType& high, std::vector<Size>& result) const
+    {
+      if (points_.empty()) return;
+      Range_ stack[MAX_STACK_];
+      Size top = 0;
+      stack[top++] = Range_{0, points_.size(), 0};
+      while (top > 0)
+      {
+        const Range_ r = stack[--top];
+        if (r.end - r.begin <= LEAF_SIZE)
+        {
+          for (Size i = r.begin; i < r.end; ++i)
+          {
+            if (inBox_(points_[i], low, high)) result.push_back(indices_[i]);
+          }
+          continue;
+        }
+        const Size mid = r.begin + (r.end - r.begin) / 2;
+        const PointType& p = points_[mid];
+        if (inBox_(p, low, high)) result.push_back(indices_[mid]);
+        const UInt next_dim = (r.dim + 1) % D;
+        // left subtree: coordinates <= p[dim], right subtree: coordinates >= p[dim]
+        if (low[r.dim] <= p[r.dim]) stack[top++] = Range_{r.begin, mid, next_dim};
+        if (high[r.dim] >= p[r.dim] && mid + 1 < r.end) stack[top++] = Range_{mid + 1, r.end, next_dim};
+      }
+    }
+
+    /// Appends the indices of all points with a Euclidean distance of at most @p radius to @p center to @p result
+    void queryRadius(const PointType& center, double radius, std::vector<Size>& result) const
+    {
+      if (points_.empty()) return;
+      const double radius_sq = radius * radius;
+      Range_ stack[MAX_STACK_];
+      Size top = 0;
+      stack[top++] = Range_{0, points_.size(), 0};
+      while (top > 0)
+      {
+        const Range_ r = stack[--top];
+        if (r.end - r.begin <= LEAF_SIZE)
+        {
+          for (Size i = r.begin; i < r.end; ++i)
+          {
+            if (squaredDistance_(points_[i], center) <= radius_sq) result.push_back(indices_[i]);
+          }
+          continue;
+        }
+        const Size mid = r.begin + (r.end - r.begin) / 2;
+        const PointType& p = points_[mid];
+        if (squaredDistance_(p, center) <= radius_sq) result.push_back(indices_[mid]);
+        const UInt next_dim = (r.dim + 1) % D;
+        if (center[r.dim] - radius <= p[r.dim]) stack[top++] = Range_{r.begin, mid, next_dim};
+        if (center[r.dim] + radius >= p[r.dim] && mid + 1 < r.end) stack[top++] = Range_{mid + 1, r.end, next_dim};
+      }
+    }
+
+    /// Batch version of queryBox(): @p results[i] holds the indices of the points in the box @p lows[i], @p highs[i] (queries run in parallel)
+    void queryBoxes(const std::vector<PointType>& lows, const std::vector<PointType>& highs, std::vector<std::vector<Size> >& results) const
+    {
+      results.clear();
+      results.resize(std::min(lows.size(), highs.size()));
+#pragma omp parallel for schedule(dynamic, 64)
+      for (SignedSize i = 0; i < (SignedSize)results.size(); ++i)
+      {
+        queryBox(lows[i], highs[i], results[i]);
+      }
+    }
+
+    /// Batch version of queryRadius(): @p results[i] holds the indices of the points within @p radius around @p centers[i] (queries run in parallel)
+    void queryRadii(const std::vector<PointType>& centers, double radius, std::vector<std::vector<Size> >& results) const
+    {
+      results.clear();
+      results.resize(centers.size());
+#pragma omp parallel for schedule(dynamic, 64)
+      for (SignedSize i = 0; i < (SignedSize)results.size(); ++i)
+      {
+        queryRadius(centers[i], radius, results[i]);
+      }
+    }
+
+protected:
+
+    /// A subtree, i.e. a range of the point array, and its split dimension
+    struct Range_
+    {
+      Size begin;
+      Size end;
+      UInt dim;
+    };
+
+    /// Upper bound of the number of pending subtrees during a query (one per level, plus the root)
+    static const Size MAX_STACK_ = 8 * sizeof(Size) + 1;
+
+    static bool inBox_(const PointType& p, const PointType& low, const PointType& high)
+    {
+      for (UInt d = 0; d < D; ++d)
+      {
+        if (p[d] < low[d] || p[d] > high[d]) return false;
+      }
+      return true;
+    }
+
+    static double squaredDistance_(const PointType& p, const PointType& q)
+    {
+      double dist = 0.0;
+      for (UInt d = 0; d < D; ++d)
+      {
+        dist += (p[d] - q[d]) * (p[d] - q[d]);
+      }
+      return dist;
+    }
+
+    /// Points in tree order
+    std::vector<PointType> points_;
+
+    /// Index (in the input of build()) of each point in points_
+    std::vector<Size> indices_;
+  };
+
+} // namespace OpenMS
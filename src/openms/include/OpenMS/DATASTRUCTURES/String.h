@@ -500,6 +500,11 @@ public:
     {
     }
 
+    // create view on a character range (e.g. in a memory-mapped file)
+    StringView(const char* begin, Size size) : begin_(begin), size_(size)
+    {
+    }
+
     // construct from other view
     StringView(const StringView& s) : begin_(s.begin_), size_(s.size_) 
     {
@@ -554,6 +559,12 @@ public:
       return String(begin_, begin_ + size_);
     }
 
+    /// access to a character of the view (no bounds check)
+    inline const char& operator[](Size i) const
+    {
+      return begin_[i];
+    }
+
     private:
       const char* begin_;
       Size size_;
@@ -568,7 +579,7 @@ namespace std
   {
     std::size_t operator()( OpenMS::String const& s) const
     {
-      return std::hash<string>()(static_cast<string>(s));
+      return std::hash<string>()(static_cast<const string&>(s));
     }
   };
 } // namespace std
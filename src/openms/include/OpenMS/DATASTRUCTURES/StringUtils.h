@@ -870,6 +870,13 @@ public:
       return boost::spirit::qi::parse(begin, end, parse_double_, target);
     }
 
+    /// Reads a float from an iterator position (see extractDouble()).
+    template <typename IteratorT>
+    static bool extractFloat(IteratorT& begin, const IteratorT& end, float& target)
+    {
+      return boost::spirit::qi::parse(begin, end, parse_float_, target);
+    }
+
 
     static String& toUpper(String & this_s)
     {
@@ -5,6 +5,7 @@ set(directory include/OpenMS/DATASTRUCTURES)
 set(sources_list_h
 Adduct.h
 BinaryTreeNode.h
+BoundingBoxIndex.h
 CalibrationData.h
 ChargePair.h
 Compomer.h
@@ -25,6 +26,7 @@ DefaultParamHandler.h
 DistanceMatrix.h
 FASTAContainer.h
 GridFeature.h
+InternedString.h
 IsotopeCluster.h
 KDTree.h
 ListUtils.h
@@ -34,9 +36,12 @@ Map.h
 MassExplainer.h
 MatchedIterator.h
 Matrix.h
+NumericCodec.h
 Param.h
 QTCluster.h
+RadixSort.h
 SeqanIncludeWrapper.h
+StaticKDTree.h
 String.h
 StringUtils.h
 StringListUtils.h
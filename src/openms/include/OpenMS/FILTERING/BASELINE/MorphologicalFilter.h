@@ -34,6 +34,7 @@
 
 #pragma once
 
+#include <OpenMS/CONCEPT/ParallelExecution.h>
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 #include <OpenMS/DATASTRUCTURES/DefaultParamHandler.h>
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
@@ -43,6 +44,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <limits>
 
 namespace OpenMS
 {
@@ -199,10 +201,6 @@ public:
     template <typename InputIterator, typename OutputIterator>
     void filterRange(InputIterator input_begin, InputIterator input_end, OutputIterator output_begin)
     {
-      // the buffer is static only to avoid reallocation
-      static std::vector<typename InputIterator::value_type> buffer;
-      const UInt size = input_end - input_begin;
-
       //determine the struct size in data points if not already set
       if (struct_size_in_datapoints_ == 0)
       {
@@ -210,60 +208,7 @@ public:
       }
 
       //apply the filtering
-      String method = param_.getValue("method");
-      if (method == "identity")
-      {
-        std::copy(input_begin, input_end, output_begin);
-      }
-      else if (method == "erosion")
-      {
-        applyErosion_(struct_size_in_datapoints_, input_begin, input_end, output_begin);
-      }
-      else if (method == "dilation")
-      {
-        applyDilation_(struct_size_in_datapoints_, input_begin, input_end, output_begin);
-      }
-      else if (method == "opening")
-      {
-        if (buffer.size() < size) buffer.resize(size);
-        applyErosion_(struct_size_in_datapoints_, input_begin, input_end, buffer.begin());
-        applyDilation_(struct_size_in_datapoints_, buffer.begin(), buffer.begin() + size, output_begin);
-      }
-      else if (method == "closing")
-      {
-        if (buffer.size() < size) buffer.resize(size);
-        applyDilation_(struct_size_in_datapoints_, input_begin, input_end, buffer.begin());
-        applyErosion_(struct_size_in_datapoints_, buffer.begin(), buffer.begin() + size, output_begin);
-      }
-      else if (method == "gradient")
-      {
-        if (buffer.size() < size) buffer.resize(size);
-        applyErosion_(struct_size_in_datapoints_, input_begin, input_end, buffer.begin());
-        applyDilation_(struct_size_in_datapoints_, input_begin, input_end, output_begin);
-        for (UInt i = 0; i < size; ++i) output_begin[i] -= buffer[i];
-      }
-      else if (method == "tophat")
-      {
-        if (buffer.size() < size) buffer.resize(size);
-        applyErosion_(struct_size_in_datapoints_, input_begin, input_end, buffer.begin());
-        applyDilation_(struct_size_in_datapoints_, buffer.begin(), buffer.begin() + size, output_begin);
-        for (UInt i = 0; i < size; ++i) output_begin[i] = input_begin[i] - output_begin[i];
-      }
-      else if (method == "bothat")
-      {
-        if (buffer.size() < size) buffer.resize(size);
-        applyDilation_(struct_size_in_datapoints_, input_begin, input_end, buffer.begin());
-        applyErosion_(struct_size_in_datapoints_, buffer.begin(), buffer.begin() + size, output_begin);
-        for (UInt i = 0; i < size; ++i) output_begin[i] = input_begin[i] - output_begin[i];
-      }
-      else if (method == "erosion_simple")
-      {
-        applyErosionSimple_(struct_size_in_datapoints_, input_begin, input_end, output_begin);
-      }
-      else if (method == "dilation_simple")
-      {
-        applyDilationSimple_(struct_size_in_datapoints_, input_begin, input_end, output_begin);
-      }
+      filterRange_(struct_size_in_datapoints_, param_.getValue("method"), input_begin, input_end, output_begin);
 
       struct_size_in_datapoints_ = 0;
     }
@@ -291,25 +236,29 @@ public:
       if (spectrum.size() <= 1) { return; }
 
       //Determine structuring element size in datapoints (depending on the unit)
+      //(kept local, so that different spectra can be filtered concurrently)
+      UInt struc_size;
       if ((String)(param_.getValue("struc_elem_unit")) == "Thomson")
       {
         const double struc_elem_length = (double)param_.getValue("struc_elem_length");
-        const double mz_diff = spectrum.back().getMZ() - spectrum.begin()->getMZ();        
-        struct_size_in_datapoints_ = (UInt)(ceil(struc_elem_length*(double)(spectrum.size() - 1)/mz_diff));
+        const double mz_diff = spectrum.back().getMZ() - spectrum.begin()->getMZ();
+        struc_size = (UInt)(ceil(struc_elem_length*(double)(spectrum.size() - 1)/mz_diff));
       }
       else
       {
-        struct_size_in_datapoints_ = (UInt)(double)param_.getValue("struc_elem_length");
+        struc_size = (UInt)(double)param_.getValue("struc_elem_length");
       }
       //make it odd (needed for the algorithm)
-      if (!Math::isOdd(struct_size_in_datapoints_)) ++struct_size_in_datapoints_;
+      if (!Math::isOdd(struc_size)) ++struc_size;
 
-      //apply the filtering and overwrite the input data
+      //apply the filtering on a contiguous copy of the intensities and overwrite the input data
+      std::vector<Peak1D::IntensityType> input(spectrum.size());
+      for (Size i = 0; i < spectrum.size(); ++i)
+      {
+        input[i] = spectrum[i].getIntensity();
+      }
       std::vector<Peak1D::IntensityType> output(spectrum.size());
-      filterRange(Internal::intensityIteratorWrapper(spectrum.begin()),
-                  Internal::intensityIteratorWrapper(spectrum.end()),
-                  output.begin()
-                  );
+      filterRange_(struc_size, param_.getValue("method"), input.begin(), input.end(), output.begin());
 
       //overwrite output with data
       for (Size i = 0; i < spectrum.size(); ++i)
@@ -323,15 +272,19 @@ public:
 
         The size of the structuring element is computed for each spectrum individually, if it is given in 'Thomson'.
         See the filtering method for MSSpectrum for details.
+
+        The spectra are filtered in parallel.
     */
     void filterExperiment(PeakMap & exp)
     {
       startProgress(0, exp.size(), "filtering baseline");
-      for (UInt i = 0; i < exp.size(); ++i)
+      Size progress = 0;
+      ParallelExecution::forEach(0, (SignedSize)exp.size(), [&](SignedSize i)
       {
         filter(exp[i]);
-        setProgress(i);
-      }
+#pragma omp critical (MorphologicalFilter_progress)
+        setProgress(++progress);
+      }, ParallelExecution::Schedule::DYNAMIC);
       endProgress();
     }
 
@@ -340,104 +293,82 @@ protected:
     ///Member for struct size in data points
     UInt struct_size_in_datapoints_;
 
-    /** @brief Applies erosion.  This implementation uses van Herk's method.
-    Only 3 min/max comparisons are required per data point, independent of
-    struc_size.
+    /** @brief Applies the filtering @p method with a structuring element of @p struc_size data points.
+
+    Does not touch any members, so it can be called concurrently.
     */
     template <typename InputIterator, typename OutputIterator>
-    void applyErosion_(Int struc_size, InputIterator input, InputIterator input_end, OutputIterator output)
+    void filterRange_(UInt struc_size, const String& method, InputIterator input_begin, InputIterator input_end, OutputIterator output_begin) const
     {
-      typedef typename InputIterator::value_type ValueType;
-      const Int size = input_end - input;
-      const Int struc_size_half = struc_size / 2;           // yes, integer division
-
-      static std::vector<ValueType> buffer;
-      if (Int(buffer.size()) < struc_size) buffer.resize(struc_size);
-
-      Int anchor;           // anchoring position of the current block
-      Int i;                // index relative to anchor, used for 'for' loops
-      Int ii = 0;           // input index
-      Int oi = 0;           // output index
-      ValueType current;           // current value
+      // the buffer is static only to avoid reallocation (one per thread)
+      static thread_local std::vector<typename InputIterator::value_type> buffer;
+      const UInt size = input_end - input_begin;
 
-      // we just can't get the case distinctions right in these cases, resorting to simple method.
-      if (size <= struc_size || size <= 5)
+      if (method == "identity")
       {
-        applyErosionSimple_(struc_size, input, input_end, output);
-        return;
+        std::copy(input_begin, input_end, output_begin);
       }
+      else if (method == "erosion")
       {
-        // lower margin area
-        current = input[0];
-        for (++ii; ii < struc_size_half; ++ii) if (current > input[ii]) current = input[ii];
-        for (; ii < std::min(Int(struc_size), size); ++ii, ++oi)
-        {
-          if (current > input[ii]) current = input[ii];
-          output[oi] = current;
-        }
+        applyErosion_(struc_size, input_begin, input_end, output_begin);
       }
+      else if (method == "dilation")
       {
-        // middle (main) area
-        for (anchor = struc_size;
-             anchor <= size - struc_size;
-             anchor += struc_size
-             )
-        {
-          ii = anchor;
-          current = input[ii];
-          buffer[0] = current;
-          for (i = 1; i < struc_size; ++i, ++ii)
-          {
-            if (current > input[ii]) current = input[ii];
-            buffer[i] = current;
-          }
-          ii = anchor - 1;
-          oi = ii + struc_size_half;
-          current = input[ii];
-          for (i = 1; i < struc_size; ++i, --ii, --oi)
-          {
-            if (current > input[ii]) current = input[ii];
-            output[oi] = std::min(buffer[struc_size - i], current);
-          }
-          if (current > input[ii]) current = input[ii];
-          output[oi] = current;
-        }
+        applyDilation_(struc_size, input_begin, input_end, output_begin);
       }
+      else if (method == "opening")
       {
-        // higher margin area
-        ii = size - 1;
-        oi = ii;
-        current = input[ii];
-        for (--ii; ii >= size - struc_size_half; --ii) if (current > input[ii]) current = input[ii];
-        for (; ii >= std::max(size - Int(struc_size), 0); --ii, --oi)
-        {
-          if (current > input[ii]) current = input[ii];
-          output[oi] = current;
-        }
-        anchor = size - struc_size;
-        ii = anchor;
-        current = input[ii];
-        buffer[0] = current;
-        for (i = 1; i < struc_size; ++i, ++ii)
-        {
-          if (current > input[ii]) current = input[ii];
-          buffer[i] = current;
-        }
-        ii = anchor - 1;
-        oi = ii + struc_size_half;
-        current = input[ii];
-        for (i = 1; (ii >= 0) && (i < struc_size); ++i, --ii, --oi)
-        {
-          if (current > input[ii]) current = input[ii];
-          output[oi] = std::min(buffer[struc_size - i], current);
-        }
-        if (ii >= 0)
-        {
-          if (current > input[ii]) current = input[ii];
-          output[oi] = current;
-        }
+        if (buffer.size() < size) buffer.resize(size);
+        applyErosion_(struc_size, input_begin, input_end, buffer.begin());
+        applyDilation_(struc_size, buffer.begin(), buffer.begin() + size, output_begin);
       }
-      return;
+      else if (method == "closing")
+      {
+        if (buffer.size() < size) buffer.resize(size);
+        applyDilation_(struc_size, input_begin, input_end, buffer.begin());
+        applyErosion_(struc_size, buffer.begin(), buffer.begin() + size, output_begin);
+      }
+      else if (method == "gradient")
+      {
+        if (buffer.size() < size) buffer.resize(size);
+        applyErosion_(struc_size, input_begin, input_end, buffer.begin());
+        applyDilation_(struc_size, input_begin, input_end, output_begin);
+        for (UInt i = 0; i < size; ++i) output_begin[i] -= buffer[i];
+      }
+      else if (method == "tophat")
+      {
+        if (buffer.size() < size) buffer.resize(size);
+        applyErosion_(struc_size, input_begin, input_end, buffer.begin());
+        applyDilation_(struc_size, buffer.begin(), buffer.begin() + size, output_begin);
+        for (UInt i = 0; i < size; ++i) output_begin[i] = input_begin[i] - output_begin[i];
+      }
+      else if (method == "bothat")
+      {
+        if (buffer.size() < size) buffer.resize(size);
+        applyDilation_(struc_size, input_begin, input_end, buffer.begin());
+        applyErosion_(struc_size, buffer.begin(), buffer.begin() + size, output_begin);
+        for (UInt i = 0; i < size; ++i) output_begin[i] = input_begin[i] - output_begin[i];
+      }
+      else if (method == "erosion_simple")
+      {
+        applyErosionSimple_(struc_size, input_begin, input_end, output_begin);
+      }
+      else if (method == "dilation_simple")
+      {
+        applyDilationSimple_(struc_size, input_begin, input_end, output_begin);
+      }
+    }
+
+    /** @brief Applies erosion.  This implementation uses van Herk's method.
+    Only 3 min/max comparisons are required per data point, independent of
+    struc_size.
+    */
+    template <typename InputIterator, typename OutputIterator>
+    void applyErosion_(Int struc_size, InputIterator input, InputIterator input_end, OutputIterator output) const
+    {
+      typedef typename InputIterator::value_type ValueType;
+      const ValueType identity = std::numeric_limits<ValueType>::has_infinity ? std::numeric_limits<ValueType>::infinity() : std::numeric_limits<ValueType>::max();
+      applyVanHerk_(struc_size, input, input_end, output, identity, [](ValueType a, ValueType b) { return b < a ? b : a; });
     }
 
     /** @brief Applies dilation.  This implementation uses van Herk's method.
@@ -445,104 +376,61 @@ protected:
     struc_size.
     */
     template <typename InputIterator, typename OutputIterator>
-    void applyDilation_(Int struc_size, InputIterator input, InputIterator input_end, OutputIterator output)
+    void applyDilation_(Int struc_size, InputIterator input, InputIterator input_end, OutputIterator output) const
     {
       typedef typename InputIterator::value_type ValueType;
+      const ValueType identity = std::numeric_limits<ValueType>::has_infinity ? -std::numeric_limits<ValueType>::infinity() : std::numeric_limits<ValueType>::lowest();
+      applyVanHerk_(struc_size, input, input_end, output, identity, [](ValueType a, ValueType b) { return a < b ? b : a; });
+    }
+
+    /** @brief van Herk/Gil-Werman sliding window minimum or maximum (depending on @p op).
+
+    The input is copied into a contiguous buffer, padded with @p identity (the
+    neutral element of @p op) by half a structuring element on both sides, so
+    that the margins need no special treatment.  The buffer is divided into
+    blocks of the window width, for which the running values from the left of
+    each block (prefix) and from the right of each block (suffix) are computed.
+    Every window covers the suffix of one block and the prefix of the next one,
+    so the result is the combination of two values, which is computed in a
+    single branch-free pass over contiguous memory (vectorized by the compiler).
+    */
+    template <typename InputIterator, typename OutputIterator, typename ValueType, typename Op>
+    void applyVanHerk_(Int struc_size, InputIterator input, InputIterator input_end, OutputIterator output, const ValueType identity, const Op& op) const
+    {
+      // the buffers are static only to avoid reallocation (one per thread)
+      static thread_local std::vector<ValueType> padded, prefix, suffix;
+
       const Int size = input_end - input;
+      if (size <= 0) return;
       const Int struc_size_half = struc_size / 2;           // yes, integer division
+      const Int width = 2 * struc_size_half + 1;           // window width, as in the simple method
+      const Int padded_size = (size + 2 * struc_size_half + width - 1) / width * width; // full blocks only
 
-      static std::vector<ValueType> buffer;
-      if (Int(buffer.size()) < struc_size) buffer.resize(struc_size);
-
-      Int anchor;           // anchoring position of the current block
-      Int i;                // index relative to anchor, used for 'for' loops
-      Int ii = 0;           // input index
-      Int oi = 0;           // output index
-      ValueType current;           // current value
+      padded.assign(padded_size, identity);
+      std::copy(input, input_end, padded.begin() + struc_size_half);
+      prefix.resize(padded_size);
+      suffix.resize(padded_size);
 
-      // we just can't get the case distinctions right in these cases, resorting to simple method.
-      if (size <= struc_size || size <= 5)
-      {
-        applyDilationSimple_(struc_size, input, input_end, output);
-        return;
-      }
-      {
-        // lower margin area
-        current = input[0];
-        for (++ii; ii < struc_size_half; ++ii) if (current < input[ii]) current = input[ii];
-        for (; ii < std::min(Int(struc_size), size); ++ii, ++oi)
-        {
-          if (current < input[ii]) current = input[ii];
-          output[oi] = current;
-        }
-      }
+      const ValueType* p = padded.data();
+      ValueType* g = prefix.data();
+      ValueType* h = suffix.data();
+      for (Int block = 0; block < padded_size; block += width)
       {
-        // middle (main) area
-        for (anchor = struc_size;
-             anchor <= size - struc_size;
-             anchor += struc_size
-             )
-        {
-          ii = anchor;
-          current = input[ii];
-          buffer[0] = current;
-          for (i = 1; i < struc_size; ++i, ++ii)
-          {
-            if (current < input[ii]) current = input[ii];
-            buffer[i] = current;
-          }
-          ii = anchor - 1;
-          oi = ii + struc_size_half;
-          current = input[ii];
-          for (i = 1; i < struc_size; ++i, --ii, --oi)
-          {
-            if (current < input[ii]) current = input[ii];
-            output[oi] = std::max(buffer[struc_size - i], current);
-          }
-          if (current < input[ii]) current = input[ii];
-          output[oi] = current;
-        }
+        const Int last = block + width - 1;
+        g[block] = p[block];
+        for (Int i = block + 1; i <= last; ++i) g[i] = op(g[i - 1], p[i]);
+        h[last] = p[last];
+        for (Int i = last - 1; i >= block; --i) h[i] = op(h[i + 1], p[i]);
       }
-      {
-        // higher margin area
-        ii = size - 1;
-        oi = ii;
-        current = input[ii];
-        for (--ii; ii >= size - struc_size_half; --ii) if (current < input[ii]) current = input[ii];
-        for (; ii >= std::max(size - Int(struc_size), 0); --ii, --oi)
-        {
-          if (current < input[ii]) current = input[ii];
-          output[oi] = current;
-        }
-        anchor = size - struc_size;
-        ii = anchor;
-        current = input[ii];
-        buffer[0] = current;
-        for (i = 1; i < struc_size; ++i, ++ii)
-        {
-          if (current < input[ii]) current = input[ii];
-          buffer[i] = current;
-        }
-        ii = anchor - 1;
-        oi = ii + struc_size_half;
-        current = input[ii];
-        for (i = 1; (ii >= 0) && (i < struc_size); ++i, --ii, --oi)
-        {
-          if (current < input[ii]) current = input[ii];
-          output[oi] = std::max(buffer[struc_size - i], current);
-        }
-        if (ii >= 0)
-        {
-          if (current < input[ii]) current = input[ii];
-          output[oi] = current;
-        }
-      }
-      return;
+
+      // window of output i is [i, i + width - 1] in padded coordinates
+      const ValueType* g_end = g + width - 1;
+      for (Int i = 0; i < size; ++i) output[i] = op(h[i], g_end[i]);
     }
 
     /// Applies erosion.  Simple implementation, possibly faster if struc_size is very small, and used in some special cases.
     template <typename InputIterator, typename OutputIterator>
-    void applyErosionSimple_(Int struc_size, InputIterator input_begin, InputIterator input_end, OutputIterator output_begin)
+    void applyErosionSimple_(Int struc_size, InputIterator input_begin, InputIterator input_end, OutputIterator output_begin) const
     {
       typedef typename InputIterator::value_type ValueType;
       const int size = input_end - input_begin;
@@ -560,7 +448,7 @@ protected:
 
     /// Applies dilation.  Simple implementation, possibly faster if struc_size is very small, and used in some special cases.
     template <typename InputIterator, typename OutputIterator>
-    void applyDilationSimple_(Int struc_size, InputIterator input_begin, InputIterator input_end, OutputIterator output_begin)
+    void applyDilationSimple_(Int struc_size, InputIterator input_begin, InputIterator input_end, OutputIterator output_begin) const
     {
       typedef typename InputIterator::value_type ValueType;
       const int size = input_end - input_begin;
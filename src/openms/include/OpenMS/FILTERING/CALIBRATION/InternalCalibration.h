@@ -105,7 +105,7 @@ namespace OpenMS
       @return Number of calibration masses found
 
     */
-    Size fillCalibrants(const PeakMap exp,
+    Size fillCalibrants(const PeakMap& exp,
                         const std::vector<InternalCalibration::LockMass>& ref_masses,
                         double tol_ppm,
                         bool lock_require_mono,
@@ -232,7 +232,7 @@ namespace OpenMS
       E.g., If we only have MS and MS/MS spectra: for 'target_mslvl' = {1} then all MS1 spectra and MS2 precursors are calibrated.
       If 'target_mslvl' = {2}, only MS2 spectra (not their precursors) are calibrated.
       If 'target_mslvl' = {1,2} all spectra and precursors are calibrated.
-            
+      The spectra are calibrated in parallel.
 
       @param exp Uncalibrated peak map
       @param target_mslvl List (can be unsorted) of MS levels to calibrate
@@ -172,6 +172,18 @@ namespace OpenMS
 
     */
     double predict(double mz) const;
+
+    /**
+      @brief Apply the model to a batch of uncalibrated m/z values (in place).
+
+      Gives the same results as calling predict(double) for each value, but
+      the coefficients and the model type are resolved once for the whole batch
+      (the power term is skipped for linear models), so the loop over the
+      contiguous values can be vectorized.
+
+      @param mzs The uncalibrated m/z values, replaced by the calibrated ones
+    */
+    void predict(std::vector<double>& mzs) const;
     
     /**
       @brief Binary search for the model nearest to a specific RT
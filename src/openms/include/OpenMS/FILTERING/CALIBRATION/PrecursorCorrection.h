@@ -100,10 +100,57 @@ class OPENMS_DLLAPI PrecursorCorrection
                            const std::vector<double> & mzs,
                            const std::vector<double> & rts);
      /**
+     @brief Determine the MS1 survey scan of every spectrum in a single pass.
+
+     Entry i is the index of the MS1 spectrum preceding MS2 spectrum i, i.e. the one referenced by the
+     "spectrum_ref" of the first precursor or otherwise the closest preceding MS1 spectrum (same as
+     MSExperiment::getPrecursorSpectrum()). Entries of all other spectra, and of MS2 spectra without
+     preceding MS1 spectrum, are exp.size().
+
+     @param exp: constant MSExperiment.
+     @return vector of Size with the index of the survey scan of each spectrum.
+     */
+     static std::vector<Size> getSurveyScanIndex(const MSExperiment & exp);
+
+     /**
+     @brief Index of the peak of @p survey_scan closest to @p mz, if it is within @p mz_tolerance (-1 otherwise).
+
+     The selection used by correctToNearestMS1Peak().
+
+     @param survey_scan: constant MS1 spectrum (sorted by m/z).
+     @param mz: double uncorrected precursor m/z.
+     @param mz_tolerance: double tolerance used for precursor correction in mass range.
+     @param ppm: bool enables usage of ppm.
+     @return int index of the peak or -1.
+     */
+     static int findNearestMS1Peak(const MSSpectrum & survey_scan,
+                                   double mz,
+                                   double mz_tolerance,
+                                   bool ppm);
+
+     /**
+     @brief Index of the peak of @p survey_scan with the highest intensity within @p mz_tolerance around @p mz (-1 if there is none).
+
+     The selection used by correctToHighestIntensityMS1Peak().
+
+     @param survey_scan: constant MS1 spectrum (sorted by m/z).
+     @param mz: double uncorrected precursor m/z.
+     @param mz_tolerance: double tolerance used for precursor correction in mass range.
+     @param ppm: bool enables usage of ppm.
+     @return int index of the peak or -1.
+     */
+     static int findHighestIntensityMS1Peak(const MSSpectrum & survey_scan,
+                                            double mz,
+                                            double mz_tolerance,
+                                            bool ppm);
+
+     /**
      @brief Selection of the peak in closest proximity as corrected precursor mass in a given mass range (e.g. precursor mass +/- 0.2 Da).
 
      For each MS2 spectrum the corresponding MS1 spectrum is determined by using the rt information of the precursor.
      In the MS1, the peak closest to the uncorrected precursor m/z is selected and used as corrected precursor m/z.
+     The precursors are matched in parallel (see getSurveyScanIndex()); for data which does not fit into memory,
+     use MSDataPrecursorCorrectionConsumer instead.
 
      @param exp: MSExperiment.
      @param mz_tolerance: double tolerance used for precursor correction in mass range.
@@ -125,6 +172,8 @@ class OPENMS_DLLAPI PrecursorCorrection
 
      For each MS2 spectrum the corresponding MS1 spectrum is determined by using the rt information of the precursor.
      In the MS1, the peak with the highest intensity in a given mass range to the uncorrected precursor m/z is selected and used as corrected precursor m/z.
+     The precursors are matched in parallel (see getSurveyScanIndex()); for data which does not fit into memory,
+     use MSDataPrecursorCorrectionConsumer instead.
 
      @param exp: MSExperiment.
      @param mz_tolerance: double tolerance used for precursor correction in mass range.
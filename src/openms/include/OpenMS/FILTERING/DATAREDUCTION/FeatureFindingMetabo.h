@@ -278,6 +278,24 @@ private:
      */
     double scoreMZByExpectedRange_(Size charge, const double diff_mz, double mt_variances, Range isotope_window) const;
 
+    /**
+     * @brief batched m/z scoring of many candidate traces against the same isotope hypothesis
+     *
+     * Gives the same results as scoreMZ_, applied to the m/z distances @p diff_mz and m/z variances
+     * @p mt_variances of the candidate pairs (positions >= @p first). Hypothesis-dependent terms are
+     * computed once and the per-candidate work runs over contiguous arrays.
+     *
+     * @param iso_pos isotopic position of the hypothesis
+     * @param charge charge of the hypothesis
+     * @param isotope_window expected isotope window (used with m/z scoring by elements)
+     * @param diff_mz m/z distances of the candidate pairs
+     * @param mt_variances summed m/z variances of the candidate pairs
+     * @param first first position to score
+     * @param mz_scores resulting scores (resized to the size of @p diff_mz, positions before @p first are untouched)
+     */
+    void scoreMZBatch_(Size iso_pos, Size charge, const Range& isotope_window, const std::vector<double>& diff_mz,
+                       const std::vector<double>& mt_variances, Size first, std::vector<double>& mz_scores) const;
+
     /** @brief Perform retention time scoring of two multiple mass traces
      *
      * Computes the similarity of the two peak shapes using cosine similarity
@@ -336,6 +354,9 @@ e conditions are fulfilled. Mainly the
 
     bool remove_single_traces_;
     std::vector<const Element*> elements_;
+
+    /// expected isotope m/z windows (see getTheoreticIsotopicMassWindow_) for isotopic positions 1, 2, ...
+    std::vector<Range> isotope_windows_;
   };
 
 }
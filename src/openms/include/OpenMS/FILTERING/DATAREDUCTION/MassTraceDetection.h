@@ -65,6 +65,12 @@ namespace OpenMS
       length as well as having the minimal sample rate criterion fulfilled) get
       added to the result.
 
+      With @p parallel_mz_bins > 1, the map is split into m/z bins which are
+      processed in parallel. Traces are narrow in m/z, so bins only influence
+      each other if the search window of a trace reaches across a bin border;
+      such bins are merged with their neighbour and processed again. The
+      result is therefore identical to the serial algorithm.
+
       @htmlinclude OpenMS_MassTraceDetection.parameters
 
       @ingroup Quantitation
@@ -112,6 +118,39 @@ namespace OpenMS
                   std::vector<MassTrace> & found_masstraces,
                   const Size max_traces = 0);
 
+        /// Peak index range [first, second) of each spectrum of the working map
+        typedef std::vector<std::pair<Size, Size> > SpectrumRanges;
+
+        /// Parallel variant of run_ on m/z bins (@p apices are given in the order of the serial algorithm)
+        void runBinned_(const std::vector<std::pair<Size, Size> >& apices,
+                        const PeakMap& work_exp,
+                        const std::vector<Size>& spec_offsets,
+                        const Size total_peak_count,
+                        const int fwhm_meta_idx,
+                        std::vector<MassTrace>& found_masstraces,
+                        const Size max_traces);
+
+        /**
+          @brief Extends a mass trace from an apex peak in both RT directions
+
+          Only peaks inside @p ranges are considered (all peaks if @p ranges is null).
+          @p mz_extent receives the smallest and largest m/z bound of all search windows used,
+          @p gathered_idx the (spectrum, peak) indices of the collected peaks.
+
+          @return true if the trace passes the length and quality filters (@p new_trace is set), false otherwise
+        */
+        template <typename VisitedMask>
+        bool extendTrace_(const Size apex_scan_idx,
+                          const Size apex_peak_idx,
+                          const PeakMap& work_exp,
+                          const std::vector<Size>& spec_offsets,
+                          const VisitedMask& peak_visited,
+                          const int fwhm_meta_idx,
+                          const SpectrumRanges* ranges,
+                          MassTrace& new_trace,
+                          std::vector<std::pair<Size, Size> >& gathered_idx,
+                          std::pair<double, double>& mz_extent);
+
         // parameter stuff
         double mass_error_ppm_;
         double noise_threshold_int_;
@@ -125,5 +164,7 @@ namespace OpenMS
         double max_trace_length_;
 
         bool reestimate_mt_sd_;
+
+        Size parallel_mz_bins_;
     };
 }
@@ -292,12 +292,9 @@ protected:
         histogram[bin] = 0;
         bin_value[bin] = (bin + 0.5) * bin_size;
       }
-      // bin in which a datapoint would fall
-      int to_bin = 0;
-
       // index of bin where the median is located
       int median_bin = 0;
-      // additive number of elements from left to x in histogram
+      // additive number of elements from left to median_bin (inclusive) in histogram
       int element_inc_count = 0;
 
       // tracks elements in current window, which may vary because of unevenly spaced data
@@ -310,16 +307,23 @@ protected:
 
       double noise;    // noise value of a datapoint
 
-      // determine how many elements we need to estimate (for progress estimation)
-      int windows_overall = 0;
+      // compute the bin of every datapoint once (each datapoint enters and
+      // leaves the window exactly once) and determine how many elements we
+      // need to estimate (for progress estimation)
+      std::vector<int> data_bins;
       PeakIterator run = scan_first_;
       while (run != scan_last_)
       {
-        ++windows_overall;
+        data_bins.push_back(std::max(std::min<int>((int)((*run).getIntensity() / bin_size), bin_count_minus_1), 0));
         ++run;
       }
+      int windows_overall = (int)data_bins.size();
       SignalToNoiseEstimator<Container>::startProgress(0, windows_overall, "noise estimation of data");
 
+      // data point indices of the window borders
+      Size borderleft_idx = 0;
+      Size borderright_idx = 0;
+
       // MAIN LOOP
       while (window_pos_center != scan_last_)
       {
@@ -327,21 +331,24 @@ protected:
         // erase all elements from histogram that will leave the window on the LEFT side
         while ((*window_pos_borderleft).getMZ() <  (*window_pos_center).getMZ() - window_half_size)
         {
-          to_bin = std::max(std::min<int>((int)((*window_pos_borderleft).getIntensity() / bin_size), bin_count_minus_1), 0);
+          int to_bin = data_bins[borderleft_idx];
           --histogram[to_bin];
+          if (to_bin <= median_bin) --element_inc_count;
           --elements_in_window;
           ++window_pos_borderleft;
+          ++borderleft_idx;
         }
 
         // add all elements to histogram that will enter the window on the RIGHT side
         while ((window_pos_borderright != scan_last_)
               && ((*window_pos_borderright).getMZ() <= (*window_pos_center).getMZ() + window_half_size))
         {
-          //std::cerr << (*window_pos_borderright).getIntensity() << " " << bin_size << " " << bin_count_minus_1 << std::endl;
-          to_bin = std::max(std::min<int>((int)((*window_pos_borderright).getIntensity() / bin_size), bin_count_minus_1), 0);
+          int to_bin = data_bins[borderright_idx];
           ++histogram[to_bin];
+          if (to_bin <= median_bin) ++element_inc_count;
           ++elements_in_window;
           ++window_pos_borderright;
+          ++borderright_idx;
         }
 
         if (elements_in_window < min_required_elements_)
@@ -351,10 +358,16 @@ protected:
         }
         else
         {
-          // find bin i where ceil[elements_in_window/2] <= sum_c(0..i){ histogram[c] }
-          median_bin = -1;
-          element_inc_count = 0;
+          // find the smallest bin i where ceil[elements_in_window/2] <= sum_c(0..i){ histogram[c] }
+          // (or the last bin). Since the window only changes by a few data
+          // points, we move the median bin of the previous window instead
+          // of scanning the histogram from the left.
           element_in_window_half = (elements_in_window + 1) / 2;
+          while (median_bin > 0 && element_inc_count - histogram[median_bin] >= element_in_window_half)
+          {
+            element_inc_count -= histogram[median_bin];
+            --median_bin;
+          }
           while (median_bin < bin_count_minus_1 && element_inc_count < element_in_window_half)
           {
             ++median_bin;
@@ -368,8 +381,9 @@ protected:
           noise = std::max(1.0, bin_value[median_bin]);
         }
 
-        // store result
-        stn_estimates_[*window_pos_center] = (*window_pos_center).getIntensity() / noise;
+        // store result (data points are sorted, so insertion at the end is constant time)
+        auto stn_it = stn_estimates_.emplace_hint(stn_estimates_.end(), *window_pos_center, 0.0);
+        stn_it->second = (*window_pos_center).getIntensity() / noise;
 
 
         // advance the window center by one datapoint
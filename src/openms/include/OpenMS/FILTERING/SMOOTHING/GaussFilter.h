@@ -188,20 +188,41 @@ public:
     /**
       @brief Smoothes an MSExperiment containing profile data.
 
-      @exception Exception::IllegalArgument is thrown, if the @em gaussian_width parameter is too small.
+      Spectra and chromatograms are smoothed in parallel.
+
+      @exception Exception::IllegalArgument is thrown, if the map contains chromatograms and @em use_ppm_tolerance is set.
     */
     void filterExperiment(PeakMap & map)
     {
+      if (!map.getChromatograms().empty() && param_.getValue("use_ppm_tolerance").toBool())
+      {
+        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "GaussFilter: Cannot use ppm tolerance on chromatograms");
+      }
+
       Size progress = 0;
       startProgress(0, map.size() + map.getChromatograms().size(), "smoothing data");
-      for (Size i = 0; i < map.size(); ++i)
+      // spectra and chromatograms are smoothed independently
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)map.size(); ++i)
       {
         filter(map[i]);
+#ifdef _OPENMP
+#pragma omp critical (GaussFilter_filterExperiment)
+#endif
         setProgress(++progress);
       }
-      for (Size i = 0; i < map.getChromatograms().size(); ++i)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)map.getChromatograms().size(); ++i)
       {
         filter(map.getChromatogram(i));
+#ifdef _OPENMP
+#pragma omp critical (GaussFilter_filterExperiment)
+#endif
         setProgress(++progress);
       }
       endProgress();
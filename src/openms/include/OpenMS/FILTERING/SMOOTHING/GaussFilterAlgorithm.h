@@ -38,6 +38,7 @@
 #include <OpenMS/CONCEPT/Constants.h>
 #include <OpenMS/INTERFACES/DataStructures.h>
 #include <OpenMS/INTERFACES/ISpectrumAccess.h>
+#include <algorithm>
 #include <cmath>
 #include <vector>
 
@@ -137,19 +138,34 @@ public:
         IterT mz_out,
         IterT int_out)
     {
+      // on uniformly spaced data (e.g. chromatograms) the kernel values at the
+      // data point distances are the same for all data points
+      double data_spacing = 0.0;
+      if (!use_ppm_tolerance_ && isUniformlySpaced_(mz_in_start, mz_in_end, data_spacing))
+      {
+        return filterUniform_(mz_in_start, mz_in_end, int_in_start, mz_out, int_out, data_spacing);
+      }
+
       bool found_signal = false;
+      // kernel for the current data point if ppm tolerance is used (does not
+      // touch the members, so the filter can be used from several threads)
+      std::vector<double> ppm_coeffs;
 
       ConstIterT mz_it = mz_in_start;
       ConstIterT int_it = int_in_start;
       for (; mz_it != mz_in_end; mz_it++, int_it++)
       {
+        double new_int;
         // if ppm tolerance is used, calculate a reasonable width value for this m/z
         if (use_ppm_tolerance_)
         {
-          initialize((*mz_it) * ppm_tolerance_ * 10e-6, spacing_, ppm_tolerance_, use_ppm_tolerance_ );
+          computeCoefficients_((*mz_it) * ppm_tolerance_ * 10e-6, spacing_, ppm_coeffs);
+          new_int = integrate_(mz_it, int_it, mz_in_start, mz_in_end, ppm_coeffs);
+        }
+        else
+        {
+          new_int = integrate_(mz_it, int_it, mz_in_start, mz_in_end, coeffs_);
         }
-
-        double new_int = integrate_(mz_it, int_it, mz_in_start, mz_in_end);
         
         // store new intensity and m/z into output iterator
         *mz_out = *mz_it;
@@ -177,14 +193,130 @@ protected:
     bool use_ppm_tolerance_;
     double ppm_tolerance_;
 
+    /// Computes the kernel coefficients for the given width (one side of the gaussian, tabulated with the given spacing)
+    static void computeCoefficients_(double gaussian_width, double spacing, std::vector<double>& coeffs);
+
+    /// Returns the (linearly interpolated) kernel value at the given distance from the kernel center
+    double interpolateCoefficient_(double distance_in_gaussian, const std::vector<double>& coeffs) const
+    {
+      int middle = (int)coeffs.size();
+      int left_position = (int)floor(distance_in_gaussian / spacing_);
+
+      // search for the true left adjacent data point (because of rounding errors)
+      for (int j = 0; j < 3; ++j)
+      {
+        if (((left_position - j) * spacing_ <= distance_in_gaussian) && ((left_position - j + 1) * spacing_ >= distance_in_gaussian))
+        {
+          left_position -= j;
+          break;
+        }
+
+        if (((left_position + j) * spacing_ < distance_in_gaussian) && ((left_position + j + 1) * spacing_ < distance_in_gaussian))
+        {
+          left_position += j;
+          break;
+        }
+      }
+      left_position = std::max(0, std::min(left_position, middle - 1));
+
+      int right_position = left_position + 1;
+      double d = fabs((left_position * spacing_) - distance_in_gaussian) / spacing_;
+      return (right_position < middle) ? (1 - d) * coeffs[left_position] + d * coeffs[right_position]
+                                       : coeffs[left_position];
+    }
+
+    /// Checks whether the positions are equally spaced (and returns the spacing)
+    template <typename ConstIterT>
+    static bool isUniformlySpaced_(ConstIterT first, ConstIterT last, double& data_spacing)
+    {
+      const Size n = std::distance(first, last);
+      if (n < 3) return false;
+
+      data_spacing = (*(last - 1) - *first) / (n - 1);
+      if (!(data_spacing > 0)) return false;
+
+      const double tolerance = 1e-6 * data_spacing;
+      for (ConstIterT it = first + 1; it != last; ++it)
+      {
+        if (fabs((*it - *(it - 1)) - data_spacing) > tolerance) return false;
+      }
+      return true;
+    }
+
+    /**
+      @brief Convolution of uniformly spaced data
+
+      Same integration as integrate_() (trapezoidal rule over the same data
+      points), but the kernel values at the distances k * data_spacing are
+      computed once, so each data point only needs two dot products.
+    */
+    template <typename ConstIterT, typename IterT>
+    bool filterUniform_(
+        ConstIterT x_in_start,
+        ConstIterT x_in_end,
+        ConstIterT int_in_start,
+        IterT x_out,
+        IterT int_out,
+        double data_spacing)
+    {
+      const Size n = std::distance(x_in_start, x_in_end);
+      const double half_width = coeffs_.size() * spacing_;
+
+      // kernel values at the data point distances and the cumulative kernel area
+      const Size nr_weights = std::min(n, (Size)(half_width / data_spacing) + 2);
+      std::vector<double> weights(nr_weights);
+      std::vector<double> norm_cum(nr_weights, 0.0);
+      for (Size k = 0; k < nr_weights; ++k)
+      {
+        weights[k] = interpolateCoefficient_(k * data_spacing, coeffs_);
+        if (k > 0) norm_cum[k] = norm_cum[k - 1] + data_spacing / 2. * (weights[k - 1] + weights[k]);
+      }
+
+      bool found_signal = false;
+      for (Size i = 0; i < n; ++i)
+      {
+        const double x = *(x_in_start + i);
+        const double start_pos = std::max(x - half_width, *x_in_start);
+        const double end_pos = std::min(x + half_width, *(x_in_end - 1));
+
+        // number of trapezoids left and right of x (same bounds as integrate_())
+        Size left = 0;
+        while (left < i && left + 1 < nr_weights && *(x_in_start + (i - left - 1)) > start_pos) ++left;
+        Size right = 0;
+        while (i + right + 1 < n && right + 1 < nr_weights && *(x_in_start + (i + right + 1)) < end_pos) ++right;
+
+        ConstIterT y = int_in_start + i;
+        double v = 0.;
+        for (Size k = 0; k < left; ++k)
+        {
+          v += *(y - k - 1) * weights[k + 1] + *(y - k) * weights[k];
+        }
+        for (Size k = 0; k < right; ++k)
+        {
+          v += *(y + k) * weights[k] + *(y + k + 1) * weights[k + 1];
+        }
+        v *= data_spacing / 2.;
+
+        double new_int = (v > 0) ? v / (norm_cum[left] + norm_cum[right]) : 0;
+
+        *x_out = x;
+        *int_out = new_int;
+        ++x_out;
+        ++int_out;
+
+        if (fabs(new_int) > 0) found_signal = true;
+      }
+      return found_signal;
+    }
+
     /// Computes the convolution of the raw data at position x and the gaussian kernel
     template <typename InputPeakIterator>
-    double integrate_(InputPeakIterator x /* mz */, InputPeakIterator y /* int */, InputPeakIterator first, InputPeakIterator last)
+    double integrate_(InputPeakIterator x /* mz */, InputPeakIterator y /* int */, InputPeakIterator first, InputPeakIterator last, const std::vector<double>& coeffs)
     {
       double v = 0.;
       // norm the gaussian kernel area to one
       double norm = 0.;
-      Size middle = coeffs_.size();
+      Size middle = coeffs.size();
 
       double start_pos = (( (*x) - (middle * spacing_)) > (*first)) ? ((*x) - (middle * spacing_)) : (*first);
       double end_pos = (( (*x) + (middle * spacing_)) < (*(last - 1))) ? ((*x) + (middle * spacing_)) : (*(last - 1));
@@ -223,16 +355,16 @@ protected:
         Size right_position = left_position + 1;
         double d = fabs((left_position * spacing_) - distance_in_gaussian) / spacing_;
         // check if the right data point in the gaussian exists
-        double coeffs_right = (right_position < middle) ? (1 - d) * coeffs_[left_position] + d * coeffs_[right_position]
-                                  : coeffs_[left_position];
+        double coeffsright = (right_position < middle) ? (1 - d) * coeffs[left_position] + d * coeffs[right_position]
+                                  : coeffs[left_position];
 #ifdef DEBUG_FILTERING
 
         std::cout << "distance_in_gaussian " << distance_in_gaussian << std::endl;
         std::cout << " right_position " << right_position << std::endl;
         std::cout << " left_position " << left_position << std::endl;
-        std::cout << "coeffs_ at left_position "  <<  coeffs_[left_position] << std::endl;
-        std::cout << "coeffs_ at right_position "  <<  coeffs_[right_position] << std::endl;
-        std::cout << "interpolated value left " << coeffs_right << std::endl;
+        std::cout << "coeffs at left_position "  <<  coeffs[left_position] << std::endl;
+        std::cout << "coeffs at right_position "  <<  coeffs[right_position] << std::endl;
+        std::cout << "interpolated value left " << coeffsright << std::endl;
 #endif
 
 
@@ -259,25 +391,25 @@ protected:
         // start the interpolation for the true value in the gaussian
         right_position = left_position + 1;
         d = fabs((left_position * spacing_) - distance_in_gaussian) / spacing_;
-        double coeffs_left = (right_position < middle) ? (1 - d) * coeffs_[left_position] + d * coeffs_[right_position]
-                                 : coeffs_[left_position];
+        double coeffsleft = (right_position < middle) ? (1 - d) * coeffs[left_position] + d * coeffs[right_position]
+                                 : coeffs[left_position];
 #ifdef DEBUG_FILTERING
 
         std::cout << " help_x-1 " << *(help_x - 1) << " distance_in_gaussian " << distance_in_gaussian << std::endl;
         std::cout << " right_position " << right_position << std::endl;
         std::cout << " left_position " << left_position << std::endl;
-        std::cout << "coeffs_ at left_position " <<  coeffs_[left_position] << std::endl;
-        std::cout << "coeffs_ at right_position " <<   coeffs_[right_position] << std::endl;
-        std::cout << "interpolated value right " << coeffs_left << std::endl;
+        std::cout << "coeffs at left_position " <<  coeffs[left_position] << std::endl;
+        std::cout << "coeffs at right_position " <<   coeffs[right_position] << std::endl;
+        std::cout << "interpolated value right " << coeffsleft << std::endl;
 
-        std::cout << " intensity " << fabs(*(help_x - 1) - (*help_x)) / 2. << " * " << *(help_y - 1) << " * " << coeffs_left << " + " << *help_y << "* " << coeffs_right
+        std::cout << " intensity " << fabs(*(help_x - 1) - (*help_x)) / 2. << " * " << *(help_y - 1) << " * " << coeffsleft << " + " << *help_y << "* " << coeffsright
                   << std::endl;
 #endif
 
 
-        norm += fabs((*(help_x - 1)) - (*help_x)) / 2. * (coeffs_left + coeffs_right);
+        norm += fabs((*(help_x - 1)) - (*help_x)) / 2. * (coeffsleft + coeffsright);
 
-        v += fabs((*(help_x - 1)) - (*help_x)) / 2. * (*(help_y - 1) * coeffs_left + (*help_y) * coeffs_right);
+        v += fabs((*(help_x - 1)) - (*help_x)) / 2. * (*(help_y - 1) * coeffsleft + (*help_y) * coeffsright);
         --help_x;
         --help_y;
       }
@@ -315,16 +447,16 @@ protected:
         // start the interpolation for the true value in the gaussian
         Size right_position = left_position + 1;
         double d = fabs((left_position * spacing_) - distance_in_gaussian) / spacing_;
-        double coeffs_left = (right_position < middle) ? (1 - d) * coeffs_[left_position] + d * coeffs_[right_position]
-                                 : coeffs_[left_position];
+        double coeffsleft = (right_position < middle) ? (1 - d) * coeffs[left_position] + d * coeffs[right_position]
+                                 : coeffs[left_position];
 
 #ifdef DEBUG_FILTERING
 
         std::cout << " help " << *help_x << " distance_in_gaussian " << distance_in_gaussian << std::endl;
         std::cout << " left_position " << left_position << std::endl;
-        std::cout << "coeffs_ at right_position " <<  coeffs_[left_position] << std::endl;
-        std::cout << "coeffs_ at left_position " <<  coeffs_[right_position] << std::endl;
-        std::cout << "interpolated value left " << coeffs_left << std::endl;
+        std::cout << "coeffs at right_position " <<  coeffs[left_position] << std::endl;
+        std::cout << "coeffs at left_position " <<  coeffs[right_position] << std::endl;
+        std::cout << "interpolated value left " << coeffsleft << std::endl;
 #endif
 
         // search for the corresponding datapoint for (help+1) in the gaussian (take the left most adjacent point)
@@ -350,24 +482,24 @@ protected:
         // start the interpolation for the true value in the gaussian
         right_position = left_position + 1;
         d = fabs((left_position * spacing_) - distance_in_gaussian) / spacing_;
-        double coeffs_right = (right_position < middle) ? (1 - d) * coeffs_[left_position] + d * coeffs_[right_position]
-                                  : coeffs_[left_position];
+        double coeffsright = (right_position < middle) ? (1 - d) * coeffs[left_position] + d * coeffs[right_position]
+                                  : coeffs[left_position];
 #ifdef DEBUG_FILTERING
 
         std::cout << " (help + 1) " << *(help_x + 1) << " distance_in_gaussian " << distance_in_gaussian << std::endl;
         std::cout << " left_position " << left_position << std::endl;
-        std::cout << "coeffs_ at right_position " <<   coeffs_[left_position] << std::endl;
-        std::cout << "coeffs_ at left_position " <<  coeffs_[right_position] << std::endl;
-        std::cout << "interpolated value right " << coeffs_right << std::endl;
+        std::cout << "coeffs at right_position " <<   coeffs[left_position] << std::endl;
+        std::cout << "coeffs at left_position " <<  coeffs[right_position] << std::endl;
+        std::cout << "interpolated value right " << coeffsright << std::endl;
 
         std::cout << " intensity " <<  fabs(*help_x - *(help_x + 1)) / 2.
-                  << " * " << *help_y << " * " << coeffs_left << " + " << *(help_y + 1)
-                  << "* " << coeffs_right
+                  << " * " << *help_y << " * " << coeffsleft << " + " << *(help_y + 1)
+                  << "* " << coeffsright
                   << std::endl;
 #endif
-        norm += fabs((*help_x) - (*(help_x + 1)) ) / 2. * (coeffs_left + coeffs_right);
+        norm += fabs((*help_x) - (*(help_x + 1)) ) / 2. * (coeffsleft + coeffsright);
 
-        v += fabs((*help_x) - (*(help_x + 1)) ) / 2. * ((*help_y) * coeffs_left + (*(help_y + 1)) * coeffs_right);
+        v += fabs((*help_x) - (*(help_x + 1)) ) / 2. * ((*help_y) * coeffsleft + (*(help_y + 1)) * coeffsright);
         ++help_x;
         ++help_y;
       }
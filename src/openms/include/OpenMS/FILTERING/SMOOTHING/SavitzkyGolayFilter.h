@@ -210,19 +210,34 @@ public:
 
     /**
       @brief Removed the noise from an MSExperiment containing profile data.
+
+      Spectra and chromatograms are smoothed in parallel.
     */
     void filterExperiment(PeakMap & map)
     {
       Size progress = 0;
       startProgress(0, map.size() + map.getChromatograms().size(), "smoothing data");
-      for (Size i = 0; i < map.size(); ++i)
+      // spectra and chromatograms are smoothed independently
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)map.size(); ++i)
       {
         filter(map[i]);
+#ifdef _OPENMP
+#pragma omp critical (SavitzkyGolayFilter_filterExperiment)
+#endif
         setProgress(++progress);
       }
-      for (Size i = 0; i < map.getChromatograms().size(); ++i)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)map.getChromatograms().size(); ++i)
       {
         filter(map.getChromatogram(i));
+#ifdef _OPENMP
+#pragma omp critical (SavitzkyGolayFilter_filterExperiment)
+#endif
         setProgress(++progress);
       }
       endProgress();
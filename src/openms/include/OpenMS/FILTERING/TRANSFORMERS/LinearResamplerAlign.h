@@ -37,6 +37,8 @@
 #include <OpenMS/FILTERING/TRANSFORMERS/LinearResampler.h>
 #include <OpenMS/CONCEPT/Macros.h>
 
+#include <algorithm>
+
 namespace OpenMS
 {
 
@@ -295,6 +297,78 @@ public:
       }
     }
 
+    /**
+        @brief Applies the resampling algorithm to contiguous arrays on an equally spaced raster.
+
+        Same as the raster() function above, but the resampling points are
+        given implicitly as start_pos + i * spacing (i = 0 ... resampled_size - 1),
+        which allows to compute the two enclosing resampling points of each
+        input point directly instead of walking the raster. The intensities are
+        added to @p resampled_intensity, which needs to hold @p resampled_size
+        values (in most cases zero). No memory is allocated.
+
+        Intensity of input points outside the raster is added to the first or
+        last resampling point.
+
+        @param mz Input m/z values (sorted)
+        @param intensity Input intensities
+        @param size Number of input points
+        @param start_pos Position of the first resampling point
+        @param spacing Distance between two resampling points
+        @param resampled_intensity Output intensities (caller-provided)
+        @param resampled_size Number of resampling points
+    */
+    template <typename MZType, typename IntensityType, typename ResampledIntensityType>
+    static void raster_uniform(const MZType* mz, const IntensityType* intensity, Size size,
+        double start_pos, double spacing, ResampledIntensityType* resampled_intensity, Size resampled_size)
+    {
+      OPENMS_PRECONDITION(resampled_size > 0, "Output cannot be empty")
+
+      if (resampled_size == 1)
+      {
+        for (Size k = 0; k < size; ++k) resampled_intensity[0] += intensity[k];
+        return;
+      }
+
+      const std::ptrdiff_t last_bin = (std::ptrdiff_t)resampled_size - 2;
+      const double last_pos = start_pos + (last_bin + 1) * spacing;
+
+      // bins and distances are computed for a block of points at once (independent
+      // of each other, so the compiler can vectorize), then the intensities are distributed
+      constexpr Size block_size = 256;
+      std::ptrdiff_t bins[block_size];
+      double dist_left[block_size];
+      double dist_right[block_size];
+
+      for (Size block_start = 0; block_start < size; block_start += block_size)
+      {
+        const Size n = std::min(block_size, size - block_start);
+        const MZType* block_mz = mz + block_start;
+
+#pragma omp simd
+        for (Size k = 0; k < n; ++k)
+        {
+          const double pos = std::min(std::max((double)block_mz[k], start_pos), last_pos);
+          std::ptrdiff_t bin = std::min(std::max((std::ptrdiff_t)((pos - start_pos) / spacing), (std::ptrdiff_t)0), last_bin);
+          // correct for rounding such that the two resampling points enclose pos
+          bin = (bin > 0 && pos < start_pos + bin * spacing) ? bin - 1 : bin;
+          bin = (bin < last_bin && pos >= start_pos + (bin + 1) * spacing) ? bin + 1 : bin;
+          bins[k] = bin;
+          dist_left[k] = pos - (start_pos + bin * spacing);
+          dist_right[k] = (start_pos + (bin + 1) * spacing) - pos;
+        }
+
+        const IntensityType* block_intensity = intensity + block_start;
+        for (Size k = 0; k < n; ++k)
+        {
+          // distribute the intensity of the raw point according to the distance to bin and bin+1
+          const double dist_sum = dist_left[k] + dist_right[k];
+          resampled_intensity[bins[k]] += block_intensity[k] * dist_right[k] / dist_sum;
+          resampled_intensity[bins[k] + 1] += block_intensity[k] * dist_left[k] / dist_sum;
+        }
+      }
+    }
+
     /**
         @brief Applies the resampling algorithm using a linear interpolation
 
@@ -120,6 +120,144 @@ protected:
 
     }; // end of SpectraDistance
 
+    /// Merges the spectra of a block into the master spectrum of the block
+    class BlockMerger_
+    {
+public:
+      explicit BlockMerger_(const DefaultParamHandler& merger)
+      {
+        double mz_binning_width(merger.getParameters().getValue("mz_binning_width"));
+        String mz_binning_unit(merger.getParameters().getValue("mz_binning_width_unit"));
+
+        // set up alignment
+        Param p;
+        p.setValue("tolerance", mz_binning_width);
+        if (!(mz_binning_unit == "Da" || mz_binning_unit == "ppm"))
+        {
+          throw Exception::IllegalSelfOperation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);  // sanity check
+        }
+
+        p.setValue("is_relative_tolerance", mz_binning_unit == "Da" ? "false" : "true");
+        alignment_.setParameters(p);
+      }
+
+      /**
+        @brief Returns the consensus spectrum of @p master and @p sacrifices (spectrum indices in @p exp)
+
+        The consensus spectrum gets MS level @p ms_level, the average RT and
+        (for MS2 and higher) the average precursor m/z of the block.
+        The peak counters are increased by the number of aligned / all peaks.
+      */
+      template <typename MapType>
+      typename MapType::SpectrumType merge(const MapType& exp, Size master, const std::vector<Size>& sacrifices, const UInt ms_level,
+                                           Size& count_peaks_aligned, Size& count_peaks_overall) const
+      {
+        typename MapType::SpectrumType consensus_spec = exp[master];
+        consensus_spec.setMSLevel(ms_level);
+
+        //typename MapType::SpectrumType all_peaks = exp[master];
+        double rt_average = consensus_spec.getRT();
+        double precursor_mz_average = 0.0;
+        Size precursor_count(0);
+        if (!consensus_spec.getPrecursors().empty())
+        {
+          precursor_mz_average = consensus_spec.getPrecursors()[0].getMZ();
+          ++precursor_count;
+        }
+
+        count_peaks_overall += consensus_spec.size();
+
+        std::vector<std::pair<Size, Size> > alignment;
+
+        // block elements
+        for (auto sit = sacrifices.begin(); sit != sacrifices.end(); ++sit)
+        {
+          consensus_spec.unify(exp[*sit]); // append meta info
+
+          rt_average += exp[*sit].getRT();
+          if (ms_level >= 2 && exp[*sit].getPrecursors().size() > 0)
+          {
+            precursor_mz_average += exp[*sit].getPrecursors()[0].getMZ();
+            ++precursor_count;
+          }
+
+          // merge data points
+          alignment_.getSpectrumAlignment(alignment, consensus_spec, exp[*sit]);
+          //std::cerr << "alignment of " << master << " with " << *sit << " yielded " << alignment.size() << " common peaks!\n";
+          count_peaks_aligned += alignment.size();
+          count_peaks_overall += exp[*sit].size();
+
+          Size align_index(0);
+          Size spec_b_index(0);
+
+          // sanity check for number of peaks
+          Size spec_a = consensus_spec.size(), spec_b = exp[*sit].size(), align_size = alignment.size();
+          for (auto pit = exp[*sit].begin(); pit != exp[*sit].end(); ++pit)
+          {
+            if (alignment.size() == 0 || alignment[align_index].second != spec_b_index)
+              // ... add unaligned peak
+            {
+              consensus_spec.push_back(*pit);
+            }
+            // or add aligned peak height to ALL corresponding existing peaks
+            else
+            {
+              Size counter(0);
+              Size copy_of_align_index(align_index);
+
+              while (alignment.size() > 0 && 
+                     copy_of_align_index < alignment.size() && 
+                     alignment[copy_of_align_index].second == spec_b_index)
+              {
+                ++copy_of_align_index;
+                ++counter;
+              } // Count the number of peaks in a which correspond to a single b peak.
+
+              while (alignment.size() > 0 &&
+                     align_index < alignment.size() &&  
+                     alignment[align_index].second == spec_b_index)
+              {
+                consensus_spec[alignment[align_index].first].setIntensity(consensus_spec[alignment[align_index].first].getIntensity() +
+                    (pit->getIntensity() / (double)counter)); // add the intensity divided by the number of peaks
+                ++align_index; // this aligned peak was explained, wait for next aligned peak ...
+                if (align_index == alignment.size())
+                {
+                  alignment.clear();  // end reached -> avoid going into this block again
+                }
+              }
+              align_size = align_size + 1 - counter; //Decrease align_size by number of
+            }
+            ++spec_b_index;
+          }
+          consensus_spec.sortByPosition(); // sort, otherwise next alignment will fail
+          if (spec_a + spec_b - align_size != consensus_spec.size())
+          {
+            OPENMS_LOG_WARN << "wrong number of features after merge. Expected: " << spec_a + spec_b - align_size << " got: " << consensus_spec.size() << "\n";
+          }
+        }
+        rt_average /= sacrifices.size() + 1;
+        consensus_spec.setRT(rt_average);
+
+        if (ms_level >= 2)
+        {
+          if (precursor_count)
+          {
+            precursor_mz_average /= precursor_count;
+          }
+          std::vector<Precursor> pcs = consensus_spec.getPrecursors();
+          //if (pcs.size()>1) OPENMS_LOG_WARN << "Removing excessive precursors - leaving only one per MS2 spectrum.\n";
+          pcs.resize(1);
+          pcs[0].setMZ(precursor_mz_average);
+          consensus_spec.setPrecursors(pcs);
+        }
+
+        return consensus_spec;
+      }
+
+protected:
+      SpectrumAlignment alignment_;
+    };
+
 public:
 
     /// blocks of spectra (master-spectrum index to sacrifice-spectra(the ones being merged into the master-spectrum))
@@ -205,71 +343,37 @@ public:
     {
 
       // convert spectra's precursors to clusterizable data
-      Size data_size;
-      std::vector<BinaryTreeNode> tree;
-      Map<Size, Size> index_mapping;
-      // local scope to save memory - we do not need the clustering stuff later
+      std::vector<BaseFeature> data;
+      std::vector<Size> index_mapping; // index in data ==> experiment index
+      for (Size i = 0; i < exp.size(); ++i)
       {
-        std::vector<BaseFeature> data;
-
-        for (Size i = 0; i < exp.size(); ++i)
+        if (exp[i].getMSLevel() != 2)
         {
-          if (exp[i].getMSLevel() != 2)
-          {
-            continue;
-          }
-
-          // remember which index in distance data ==> experiment index
-          index_mapping[data.size()] = i;
-
-          // make cluster element
-          BaseFeature bf;
-          bf.setRT(exp[i].getRT());
-          std::vector<Precursor> pcs = exp[i].getPrecursors();
-          if (pcs.empty())
-          {
-            throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("Scan #") + String(i) + " does not contain any precursor information! Unable to cluster!");
-          }
-          if (pcs.size() > 1)
-          {
-            OPENMS_LOG_WARN << "More than one precursor found. Using first one!" << std::endl;
-          }
-          bf.setMZ(pcs[0].getMZ());
-          data.push_back(bf);
+          continue;
         }
-        data_size = data.size();
 
-        SpectraDistance_ llc;
-        llc.setParameters(param_.copy("precursor_method:", true));
-        SingleLinkage sl;
-        DistanceMatrix<float> dist; // will be filled
-        ClusterHierarchical ch;
-
-        //ch.setThreshold(0.99);
-        // clustering ; threshold is implicitly at 1.0, i.e. distances of 1.0 (== similarity 0) will not be clustered
-        ch.cluster<BaseFeature, SpectraDistance_>(data, llc, sl, tree, dist);
-      }
+        // remember which index in distance data ==> experiment index
+        index_mapping.push_back(i);
 
-      // extract the clusters
-      ClusterAnalyzer ca;
-      std::vector<std::vector<Size> > clusters;
-      // count number of real tree nodes (not the -1 ones):
-      Size node_count = 0;
-      for (Size ii = 0; ii < tree.size(); ++ii)
-      {
-        if (tree[ii].distance >= 1)
+        // make cluster element
+        BaseFeature bf;
+        bf.setRT(exp[i].getRT());
+        const std::vector<Precursor>& pcs = exp[i].getPrecursors();
+        if (pcs.empty())
         {
-          tree[ii].distance = -1;  // manually set to disconnect, as SingleLinkage does not support it
+          throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("Scan #") + String(i) + " does not contain any precursor information! Unable to cluster!");
         }
-        if (tree[ii].distance != -1)
+        if (pcs.size() > 1)
         {
-          ++node_count;
+          OPENMS_LOG_WARN << "More than one precursor found. Using first one!" << std::endl;
         }
+        bf.setMZ(pcs[0].getMZ());
+        data.push_back(bf);
       }
-      ca.cut(data_size - node_count, tree, clusters);
 
-      //std::cerr << "Treesize: " << (tree.size()+1) << "   #clusters: " << clusters.size() << std::endl;
-      //std::cerr << "tree:\n" << ca.newickTree(tree, true) << "\n";
+      // single linkage clustering; distances of 1.0 (== similarity 0) are not clustered
+      std::vector<std::vector<Size> > clusters;
+      clusterPrecursors_(data, clusters);
 
       // convert to blocks
       MergeBlocks spectra_to_merge;
@@ -297,6 +401,34 @@ public:
       exp.sortSpectra();
     }
 
+    /**
+      @brief Merges a block of spectra into a single consensus spectrum
+
+      The spectra are merged the same way as a block in mergeSpectraBlockWise():
+      all other spectra of @p block are merged into the first (master) spectrum,
+      which gets MS level @p ms_level and the average RT of the block.
+      This allows to merge blocks which were collected elsewhere, e.g. while
+      streaming the data (see MSDataBlockMergingConsumer).
+
+      @return the merged spectrum (empty if all spectra of the block are empty)
+    */
+    template <typename MapType>
+    typename MapType::SpectrumType mergeBlock(const MapType& block, const UInt ms_level) const
+    {
+      if (block.empty())
+      {
+        return typename MapType::SpectrumType();
+      }
+      std::vector<Size> sacrifices;
+      for (Size i = 1; i < block.size(); ++i)
+      {
+        sacrifices.push_back(i);
+      }
+      Size count_peaks_aligned(0);
+      Size count_peaks_overall(0);
+      return BlockMerger_(*this).merge(block, 0, sacrifices, ms_level, count_peaks_aligned, count_peaks_overall);
+    }
+
     /**
      * @brief average over neighbouring spectra
      *
@@ -479,6 +611,19 @@ public:
 
 protected:
 
+    /**
+        @brief clusters precursors (single linkage) which are within the RT and m/z tolerance
+
+        Same result as hierarchical single linkage clustering with SpectraDistance_ (clusters
+        are the connected components of all pairs with distance < 1), but candidate pairs are
+        only searched in neighbouring cells of an RT / m/z grid with the tolerances as cell
+        size instead of filling a full distance matrix. Candidates are compared in parallel.
+
+        @param data precursors (RT and m/z)
+        @param clusters indices into @p data, sorted within each cluster and by first element
+    */
+    void clusterPrecursors_(const std::vector<BaseFeature>& data, std::vector<std::vector<Size> >& clusters) const;
+
     /**
         @brief merges blocks of spectra of a certain level
 
@@ -492,144 +637,36 @@ protected:
     template <typename MapType>
     void mergeSpectra_(MapType& exp, const MergeBlocks& spectra_to_merge, const UInt ms_level)
     {
-      double mz_binning_width(param_.getValue("mz_binning_width"));
-      String mz_binning_unit(param_.getValue("mz_binning_width_unit"));
-
-      // merge spectra
-      MapType merged_spectra;
-
       Map<Size, Size> cluster_sizes;
       std::set<Size> merged_indices;
-
-      // set up alignment
-      SpectrumAlignment sas;
-      Param p;
-      p.setValue("tolerance", mz_binning_width);
-      if (!(mz_binning_unit == "Da" || mz_binning_unit == "ppm"))
+      std::vector<MergeBlocks::const_iterator> blocks;
+      for (auto it = spectra_to_merge.begin(); it != spectra_to_merge.end(); ++it)
       {
-        throw Exception::IllegalSelfOperation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);  // sanity check
+        ++cluster_sizes[it->second.size() + 1]; // for stats
+        merged_indices.insert(it->first);
+        merged_indices.insert(it->second.begin(), it->second.end());
+        blocks.push_back(it);
       }
 
-      p.setValue("is_relative_tolerance", mz_binning_unit == "Da" ? "false" : "true");
-      sas.setParameters(p);
-      std::vector<std::pair<Size, Size> > alignment;
-
+      // merge spectra (each BLOCK independently)
+      BlockMerger_ merger(*this);
+      std::vector<typename MapType::SpectrumType> consensus_spectra(blocks.size());
       Size count_peaks_aligned(0);
       Size count_peaks_overall(0);
-
-      // each BLOCK
-      for (auto it = spectra_to_merge.begin(); it != spectra_to_merge.end(); ++it)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) reduction(+: count_peaks_aligned, count_peaks_overall)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)blocks.size(); ++i)
       {
-        ++cluster_sizes[it->second.size() + 1]; // for stats
-
-        typename MapType::SpectrumType consensus_spec = exp[it->first];
-        consensus_spec.setMSLevel(ms_level);
-
-        //consensus_spec.unify(exp[it->first]); // append meta info
-        merged_indices.insert(it->first);
-
-        //typename MapType::SpectrumType all_peaks = exp[it->first];
-        double rt_average = consensus_spec.getRT();
-        double precursor_mz_average = 0.0;
-        Size precursor_count(0);
-        if (!consensus_spec.getPrecursors().empty())
-        {
-          precursor_mz_average = consensus_spec.getPrecursors()[0].getMZ();
-          ++precursor_count;
-        }
-
-        count_peaks_overall += consensus_spec.size();
-
-        // block elements
-        for (auto sit = it->second.begin(); sit != it->second.end(); ++sit)
-        {
-          consensus_spec.unify(exp[*sit]); // append meta info
-          merged_indices.insert(*sit);
-
-          rt_average += exp[*sit].getRT();
-          if (ms_level >= 2 && exp[*sit].getPrecursors().size() > 0)
-          {
-            precursor_mz_average += exp[*sit].getPrecursors()[0].getMZ();
-            ++precursor_count;
-          }
-
-          // merge data points
-          sas.getSpectrumAlignment(alignment, consensus_spec, exp[*sit]);
-          //std::cerr << "alignment of " << it->first << " with " << *sit << " yielded " << alignment.size() << " common peaks!\n";
-          count_peaks_aligned += alignment.size();
-          count_peaks_overall += exp[*sit].size();
-
-          Size align_index(0);
-          Size spec_b_index(0);
-
-          // sanity check for number of peaks
-          Size spec_a = consensus_spec.size(), spec_b = exp[*sit].size(), align_size = alignment.size();
-          for (auto pit = exp[*sit].begin(); pit != exp[*sit].end(); ++pit)
-          {
-            if (alignment.size() == 0 || alignment[align_index].second != spec_b_index)
-              // ... add unaligned peak
-            {
-              consensus_spec.push_back(*pit);
-            }
-            // or add aligned peak height to ALL corresponding existing peaks
-            else
-            {
-              Size counter(0);
-              Size copy_of_align_index(align_index);
-
-              while (alignment.size() > 0 && 
-                     copy_of_align_index < alignment.size() && 
-                     alignment[copy_of_align_index].second == spec_b_index)
-              {
-                ++copy_of_align_index;
-                ++counter;
-              } // Count the number of peaks in a which correspond to a single b peak.
-
-              while (alignment.size() > 0 &&
-                     align_index < alignment.size() &&  
-                     alignment[align_index].second == spec_b_index)
-              {
-                consensus_spec[alignment[align_index].first].setIntensity(consensus_spec[alignment[align_index].first].getIntensity() +
-                    (pit->getIntensity() / (double)counter)); // add the intensity divided by the number of peaks
-                ++align_index; // this aligned peak was explained, wait for next aligned peak ...
-                if (align_index == alignment.size())
-                {
-                  alignment.clear();  // end reached -> avoid going into this block again
-                }
-              }
-              align_size = align_size + 1 - counter; //Decrease align_size by number of
-            }
-            ++spec_b_index;
-          }
-          consensus_spec.sortByPosition(); // sort, otherwise next alignment will fail
-          if (spec_a + spec_b - align_size != consensus_spec.size())
-          {
-            OPENMS_LOG_WARN << "wrong number of features after merge. Expected: " << spec_a + spec_b - align_size << " got: " << consensus_spec.size() << "\n";
-          }
-        }
-        rt_average /= it->second.size() + 1;
-        consensus_spec.setRT(rt_average);
-
-        if (ms_level >= 2)
-        {
-          if (precursor_count)
-          {
-            precursor_mz_average /= precursor_count;
-          }
-          std::vector<Precursor> pcs = consensus_spec.getPrecursors();
-          //if (pcs.size()>1) OPENMS_LOG_WARN << "Removing excessive precursors - leaving only one per MS2 spectrum.\n";
-          pcs.resize(1);
-          pcs[0].setMZ(precursor_mz_average);
-          consensus_spec.setPrecursors(pcs);
-        }
+        consensus_spectra[i] = merger.merge(exp, blocks[i]->first, blocks[i]->second, ms_level, count_peaks_aligned, count_peaks_overall);
+      }
 
-        if (consensus_spec.empty())
-        {
-          continue;
-        }
-        else
+      MapType merged_spectra;
+      for (typename MapType::SpectrumType& consensus_spec : consensus_spectra)
+      {
+        if (!consensus_spec.empty())
         {
-          merged_spectra.addSpectrum(consensus_spec);
+          merged_spectra.addSpectrum(std::move(consensus_spec));
         }
       }
 
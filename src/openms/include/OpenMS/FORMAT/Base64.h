@@ -48,6 +48,7 @@
 #include <algorithm>
 #include <iterator>
 #include <cmath>
+#include <cstring>
 #include <vector>
 
 #include <QByteArray>
@@ -93,6 +94,10 @@ public:
         @brief Decodes a Base64 string to a vector of floating point numbers
 
         You have to specify the byte order of the input and if it is zlib-compressed.
+
+        The data is decoded directly into the memory of @p out. For compressed
+        data, reserving the expected number of elements in @p out beforehand
+        avoids re-allocations during decompression.
     */
     template <typename ToType>
     static void decode(const String & in, ByteOrder from_byte_order, std::vector<ToType> & out, bool zlib_compression = false);
@@ -166,7 +171,7 @@ private:
     };
 
     static const char encoder_[];
-    static const char decoder_[];
+    static const Byte decoder_[256];
     /// Decodes a Base64 string to a vector of floating point numbers
     template <typename ToType>
     static void decodeUncompressed_(const String & in, ByteOrder from_byte_order, std::vector<ToType> & out);
@@ -182,6 +187,47 @@ private:
     ///Decodes a compressed Base64 string to a vector of integer numbers
     template <typename ToType>
     static void decodeIntegersCompressed_(const String & in, ByteOrder from_byte_order, std::vector<ToType> & out);
+
+    /**
+        @brief Decodes Base64 characters to raw bytes
+
+        Characters outside of the Base64 alphabet (e.g. whitespace) are
+        skipped, decoding stops at the first padding character. Blocks of 16
+        characters are decoded with SSSE3 instructions if the library was
+        compiled with SSSE3 support.
+
+        @param in The Base64 characters
+        @param in_size The number of characters
+        @param out The output buffer, needs to hold at least decodedSizeUpperBound_(in_size) bytes
+
+        @return The number of bytes written to @p out
+    */
+    static Size decodeRaw_(const char * in, Size in_size, Byte * out);
+
+    /// Upper bound for the number of bytes which decodeRaw_ produces from @p in_size characters
+    static Size decodedSizeUpperBound_(Size in_size)
+    {
+      return (in_size / 4) * 3 + 3;
+    }
+
+    /**
+        @brief Inflates zlib-compressed bytes directly into the memory of @p out
+
+        The capacity of @p out is used as initial size of the output buffer.
+        @p out is resized to at least the number of decompressed bytes.
+
+        @return The number of decompressed bytes
+    */
+    template <typename ToType>
+    static Size inflate_(const Byte * in, Size in_size, std::vector<ToType> & out);
+
+    /// Changes the byte order of each (32 or 64 bit) element in place
+    template <typename ToType>
+    static void swapByteOrder_(std::vector<ToType> & data);
+
+    /// Converts the raw bytes of 32 or 64 bit integers stored in @p data in place to ToType
+    template <typename ToType>
+    static void integersFromRawBytes_(std::vector<ToType> & data);
   };
 
   /// Endianizes a 32 bit type from big endian to little endian and vice versa
@@ -354,55 +400,25 @@ private:
 
     const Size element_size = sizeof(ToType);
 
-    String decompressed;
-
-    QByteArray qt_byte_array = QByteArray::fromRawData(in.c_str(), (int) in.size());
-    QByteArray bazip = QByteArray::fromBase64(qt_byte_array);
-    QByteArray czip;
-    czip.resize(4);
-    czip[0] = (bazip.size() & 0xff000000) >> 24;
-    czip[1] = (bazip.size() & 0x00ff0000) >> 16;
-    czip[2] = (bazip.size() & 0x0000ff00) >> 8;
-    czip[3] = (bazip.size() & 0x000000ff);
-    czip += bazip;
-    QByteArray base64_uncompressed = qUncompress(czip);
-
-    if (base64_uncompressed.isEmpty())
-    {
-      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Decompression error?");
-    }
-    decompressed.resize(base64_uncompressed.size());
-
-    std::copy(base64_uncompressed.begin(), base64_uncompressed.end(), decompressed.begin());
-
-    void* byte_buffer = reinterpret_cast<void *>(&decompressed[0]);
-    Size buffer_size = decompressed.size();
+    // decode Base64 into a byte buffer and inflate directly into the output vector
+    std::string compressed;
+    compressed.resize(decodedSizeUpperBound_(in.size()));
+    const Size compressed_size = decodeRaw_(in.c_str(), in.size(), reinterpret_cast<Byte *>(&compressed[0]));
+    const Size buffer_size = inflate_(reinterpret_cast<const Byte *>(compressed.data()), compressed_size, out);
 
-    const ToType * float_buffer = reinterpret_cast<const ToType *>(byte_buffer);
     if (buffer_size % element_size != 0)
     {
       throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Bad BufferCount?");
     }
     
     Size float_count = buffer_size / element_size;
+    out.resize(float_count);
     
     // change endianness if necessary
     if ((OPENMS_IS_BIG_ENDIAN && from_byte_order == Base64::BYTEORDER_LITTLEENDIAN) || (!OPENMS_IS_BIG_ENDIAN && from_byte_order == Base64::BYTEORDER_BIGENDIAN))
     {
-      if (element_size == 4) // 32 bit
-      {
-        UInt32 * p = reinterpret_cast<UInt32 *>(byte_buffer);
-        std::transform(p, p + float_count, p, endianize32);
-      }
-      else // 64 bit
-      {
-        UInt64 * p = reinterpret_cast<UInt64 *>(byte_buffer);
-        std::transform(p, p + float_count, p, endianize64);
-      }
+      swapByteOrder_(out);
     }
-
-    // copy values
-    out.assign(float_buffer, float_buffer + float_count);
   }
 
   template <typename ToType>
@@ -421,103 +437,79 @@ private:
       throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Malformed base64 input, length is not a multiple of 4.");
     }
 
-    Size src_size = in.size();
-    // last one or two '=' are skipped if contained
-    int padding = 0;
-    if (in[src_size - 1] == '=') padding++;
-    if (in[src_size - 2] == '=') padding++;
-
-    src_size -= padding;
-
-    UInt a;
-    UInt b;
-
-    UInt offset = 0;
-    int inc = 1;
-    UInt written = 0;
-
     const Size element_size = sizeof(ToType);
 
-    // enough for either float or double
-    char element[8] = "\x00\x00\x00\x00\x00\x00\x00";
+    // decode straight into the memory of the output vector, an incomplete
+    // trailing element is discarded
+    out.resize((decodedSizeUpperBound_(in.size()) + element_size - 1) / element_size);
+    const Size written = decodeRaw_(in.c_str(), in.size(), reinterpret_cast<Byte *>(&out[0]));
+    out.resize(written / element_size);
 
     // Parse little endian data in big endian OpenMS (or other way round)
     if ((OPENMS_IS_BIG_ENDIAN && from_byte_order == Base64::BYTEORDER_LITTLEENDIAN) || 
        (!OPENMS_IS_BIG_ENDIAN && from_byte_order == Base64::BYTEORDER_BIGENDIAN))
     {
-      offset = (element_size - 1);              // other endian
-      inc = -1;
+      swapByteOrder_(out);
     }
-    else
+  }
+
+  template <typename ToType>
+  Size Base64::inflate_(const Byte * in, Size in_size, std::vector<ToType> & out)
+  {
+    // Use the capacity reserved by the caller (e.g. the expected array
+    // length) as initial size of the output, otherwise guess from the input
+    // size. The buffer is grown on demand.
+    Size capacity = std::max(out.capacity(), (4 * in_size) / sizeof(ToType) + 1);
+    out.resize(capacity);
+
+    z_stream stream;
+    stream.zalloc = Z_NULL;
+    stream.zfree = Z_NULL;
+    stream.opaque = Z_NULL;
+    stream.next_in = const_cast<Bytef *>(reinterpret_cast<const Bytef *>(in));
+    stream.avail_in = (uInt) in_size;
+    if (inflateInit(&stream) != Z_OK)
     {
-      offset = 0;
-      inc = 1;
+      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Decompression error?");
     }
 
-    //reserve enough space in the output vector
-    out.reserve((UInt)(std::ceil((4.0 * src_size) / 3.0) + 6.0));
-
-    // sort all read bytes correctly into a char[4] (double) or
-    // char[8] (float) and push_back when necessary.
-    for (Size i = 0; i < src_size; i += 4)
+    Size written = 0;
+    int zlib_error;
+    do
     {
-      // decode 4 Base64-Chars to 3 Byte
-      // -------------------------------
-
-      // decode the first two chars
-      a = decoder_[(int)in[i] - 43] - 62;
-      b = decoder_[(int)in[i + 1] - 43] - 62;
-      if (i + 1 >= src_size)
+      if (written == out.size() * sizeof(ToType))
       {
-        b = 0;
+        out.resize(2 * out.size());
       }
-      // write first byte (6 bits from a and 2 highest bits from b)
-      element[offset] = (unsigned char) ((a << 2) | (b >> 4));
-      written++;
-      offset = (offset + inc) % element_size;
-
-      if (written % element_size == 0)
-      {
-        ToType * to_type = reinterpret_cast<ToType *>(&element[0]);
-        out.push_back((*to_type));
-        strcpy(element, "");
-      }
-
-      // decode the third char
-      a = decoder_[(int)in[i + 2] - 43] - 62;
-      if (i + 2 >= src_size)
-      {
-        a = 0;
-      }
-      // write second byte (4 lowest bits from b and 4 highest bits from a)
-      element[offset] = (unsigned char) (((b & 15) << 4) | (a >> 2));
-      written++;
-      offset = (offset + inc) % element_size;
+      stream.next_out = reinterpret_cast<Bytef *>(&out[0]) + written;
+      stream.avail_out = (uInt) (out.size() * sizeof(ToType) - written);
+      zlib_error = inflate(&stream, Z_NO_FLUSH);
+      written = (Size) stream.total_out;
+    }
+    while (zlib_error == Z_OK);
+    inflateEnd(&stream);
 
-      if (written % element_size == 0)
-      {
-        ToType * to_type = reinterpret_cast<ToType *>(&element[0]);
-        out.push_back((*to_type));
-        strcpy(element, "");
-      }
+    if (zlib_error != Z_STREAM_END)
+    {
+      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Decompression error?");
+    }
+    return written;
+  }
 
-      // decode the fourth char
-      b = decoder_[(int)in[i + 3] - 43] - 62;
-      if (i + 3 >= src_size)
-      {
-        b = 0;
-      }
-      // write third byte (2 lowest bits from a and 6 bits from b)
-      element[offset] = (unsigned char) (((a & 3) << 6) | b);
-      written++;
-      offset = (offset + inc) % element_size;
+  template <typename ToType>
+  void Base64::swapByteOrder_(std::vector<ToType> & data)
+  {
+    if (data.empty()) return;
 
-      if (written % element_size == 0)
-      {
-        ToType * to_type = reinterpret_cast<ToType *>(&element[0]);
-        out.push_back((*to_type));
-        strcpy(element, "");
-      }
+    if (sizeof(ToType) == 4) // 32 bit
+    {
+      UInt32 * p = reinterpret_cast<UInt32 *>(&data[0]);
+      std::transform(p, p + data.size(), p, endianize32);
+    }
+    else // 64 bit
+    {
+      UInt64 * p = reinterpret_cast<UInt64 *>(&data[0]);
+      std::transform(p, p + data.size(), p, endianize64);
     }
   }
 
@@ -648,109 +640,25 @@ private:
     if (in == "")
       return;
 
-    void * byte_buffer;
-    Size buffer_size;
     const Size element_size = sizeof(ToType);
 
-    String decompressed;
-
-    QByteArray qt_byte_array = QByteArray::fromRawData(in.c_str(), (int) in.size());
-    QByteArray bazip = QByteArray::fromBase64(qt_byte_array);
-    QByteArray czip;
-    czip.resize(4);
-    czip[0] = (bazip.size() & 0xff000000) >> 24;
-    czip[1] = (bazip.size() & 0x00ff0000) >> 16;
-    czip[2] = (bazip.size() & 0x0000ff00) >> 8;
-    czip[3] = (bazip.size() & 0x000000ff);
-    czip += bazip;
-    QByteArray base64_uncompressed = qUncompress(czip);
-    if (base64_uncompressed.isEmpty())
+    std::string compressed;
+    compressed.resize(decodedSizeUpperBound_(in.size()));
+    const Size compressed_size = decodeRaw_(in.c_str(), in.size(), reinterpret_cast<Byte *>(&compressed[0]));
+    const Size buffer_size = inflate_(reinterpret_cast<const Byte *>(compressed.data()), compressed_size, out);
+
+    if (buffer_size % element_size != 0)
     {
-      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Decompression error?");
+      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Bad BufferCount while decoding?");
     }
-    decompressed.resize(base64_uncompressed.size());
-
-    std::copy(base64_uncompressed.begin(), base64_uncompressed.end(), decompressed.begin());
-
-    byte_buffer = reinterpret_cast<void *>(&decompressed[0]);
-    buffer_size = decompressed.size();
+    out.resize(buffer_size / element_size);
 
     //change endianness if necessary
     if ((OPENMS_IS_BIG_ENDIAN && from_byte_order == Base64::BYTEORDER_LITTLEENDIAN) || (!OPENMS_IS_BIG_ENDIAN && from_byte_order == Base64::BYTEORDER_BIGENDIAN))
     {
-      if (element_size == 4)
-      {
-        const Int32 * float_buffer = reinterpret_cast<const Int32 *>(byte_buffer);
-        if (buffer_size % element_size != 0)
-          throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Bad BufferCount?");
-        Size float_count = buffer_size / element_size;
-        UInt32 * p = reinterpret_cast<UInt32 *>(byte_buffer);
-        std::transform(p, p + float_count, p, endianize32);
-
-        out.resize(float_count);
-        // do NOT use assign here, as it will give a lot of type conversion warnings on VS compiler
-        for (Size i = 0; i < float_count; ++i)
-        {
-          out[i] = (ToType) * float_buffer;
-          ++float_buffer;
-        }
-      }
-      else
-      {
-        const Int64 * float_buffer = reinterpret_cast<const Int64 *>(byte_buffer);
-
-        if (buffer_size % element_size != 0)
-          throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Bad BufferCount?");
-
-        Size float_count = buffer_size / element_size;
-
-        UInt64 * p = reinterpret_cast<UInt64 *>(byte_buffer);
-        std::transform(p, p + float_count, p, endianize64);
-
-        out.resize(float_count);
-        // do NOT use assign here, as it will give a lot of type conversion warnings on VS compiler
-        for (Size i = 0; i < float_count; ++i)
-        {
-          out[i] = (ToType) * float_buffer;
-          ++float_buffer;
-        }
-      }
-    }
-    else
-    {
-      if (element_size == 4)
-      {
-        const Int * float_buffer = reinterpret_cast<const Int *>(byte_buffer);
-        if (buffer_size % element_size != 0)
-          throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Bad BufferCount while decoding?");
-
-        Size float_count = buffer_size / element_size;
-        out.resize(float_count);
-        // do NOT use assign here, as it will give a lot of type conversion warnings on VS compiler
-        for (Size i = 0; i < float_count; ++i)
-        {
-          out[i] = (ToType) * float_buffer;
-          ++float_buffer;
-        }
-      }
-      else
-      {
-        const Int64 * float_buffer = reinterpret_cast<const Int64 *>(byte_buffer);
-
-        if (buffer_size % element_size != 0)
-          throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Bad BufferCount while decoding?");
-
-        Size float_count = buffer_size / element_size;
-        out.resize(float_count);
-        // do NOT use assign here, as it will give a lot of type conversion warnings on VS compiler
-        for (Size i = 0; i < float_count; ++i)
-        {
-          out[i] = (ToType) * float_buffer;
-          ++float_buffer;
-        }
-      }
+      swapByteOrder_(out);
     }
-
+    integersFromRawBytes_(out);
   }
 
   template <typename ToType>
@@ -765,131 +673,40 @@ private:
       return;
     }
 
-    Size src_size = in.size();
-    // last one or two '=' are skipped if contained
-    int padding = 0;
-    if (in[src_size - 1] == '=') padding++;
-    if (in[src_size - 2] == '=') padding++;
-
-    src_size -= padding;
-
-    UInt a;
-    UInt b;
-
-    UInt offset = 0;
-    int inc = 1;
-    UInt written = 0;
-
     const Size element_size = sizeof(ToType);
 
-    // enough for either float or double
-    char element[8] = "\x00\x00\x00\x00\x00\x00\x00";
+    // decode straight into the memory of the output vector, an incomplete
+    // trailing element is discarded
+    out.resize((decodedSizeUpperBound_(in.size()) + element_size - 1) / element_size);
+    const Size written = decodeRaw_(in.c_str(), in.size(), reinterpret_cast<Byte *>(&out[0]));
+    out.resize(written / element_size);
 
     if ((OPENMS_IS_BIG_ENDIAN && from_byte_order == Base64::BYTEORDER_LITTLEENDIAN) || (!OPENMS_IS_BIG_ENDIAN && from_byte_order == Base64::BYTEORDER_BIGENDIAN))
     {
-      offset = (element_size - 1);              // other endian
-      inc = -1;
-    }
-    else
-    {
-      offset = 0;
-      inc = 1;
+      swapByteOrder_(out);
     }
+    integersFromRawBytes_(out);
+  }
 
-    //reserve enough space in the output vector
-    out.reserve((UInt)(std::ceil((4.0 * src_size) / 3.0) + 6.0));
-
-    // sort all read bytes correctly into a char[4] (double) or
-    // char[8] (float) and push_back when necessary.
-    for (Size i = 0; i < src_size; i += 4)
+  template <typename ToType>
+  void Base64::integersFromRawBytes_(std::vector<ToType> & data)
+  {
+    // the output vector holds the raw bytes of 32 or 64 bit integers, convert
+    // them in place to the target type (do NOT use assign here, as it will
+    // give a lot of type conversion warnings on VS compiler)
+    for (Size i = 0; i < data.size(); ++i)
     {
-
-      // decode 4 Base64-Chars to 3 Byte
-      // -------------------------------
-
-      // decode the first two chars
-      a = decoder_[(int)in[i] - 43] - 62;
-      b = decoder_[(int)in[i + 1] - 43] - 62;
-      if (i + 1 >= src_size)
-      {
-        b = 0;
-      }
-      // write first byte (6 bits from a and 2 highest bits from b)
-      element[offset] = (unsigned char) ((a << 2) | (b >> 4));
-      written++;
-      offset = (offset + inc) % element_size;
-
-      if (written % element_size == 0)
-      {
-        ToType float_value;
-        if (element_size == 4)
-        {
-          Int32 * value = reinterpret_cast<Int32 *>(&element[0]);
-          float_value = (ToType) * value;
-        }
-        else
-        {
-          Int64 * value = reinterpret_cast<Int64 *>(&element[0]);
-          float_value = (ToType) * value;
-        }
-        out.push_back(float_value);
-        strcpy(element, "");
-      }
-
-      // decode the third char
-      a = decoder_[(int)in[i + 2] - 43] - 62;
-      if (i + 2 >= src_size)
+      if (sizeof(ToType) == 4)
       {
-        a = 0;
+        Int32 value;
+        std::memcpy(&value, &data[i], sizeof(value));
+        data[i] = (ToType) value;
       }
-      // write second byte (4 lowest bits from b and 4 highest bits from a)
-      element[offset] = (unsigned char) (((b & 15) << 4) | (a >> 2));
-      written++;
-      offset = (offset + inc) % element_size;
-
-      if (written % element_size == 0)
-      {
-        ToType float_value;
-        if (element_size == 4)
-        {
-          Int32 * value = reinterpret_cast<Int32 *>(&element[0]);
-          float_value = (ToType) * value;
-        }
-        else
-        {
-          Int64 * value = reinterpret_cast<Int64 *>(&element[0]);
-          float_value = (ToType) * value;
-        }
-        out.push_back(float_value);
-        strcpy(element, "");
-      }
-
-      // decode the fourth char
-      b = decoder_[(int)in[i + 3] - 43] - 62;
-      if (i + 3 >= src_size)
-      {
-        b = 0;
-      }
-      // write third byte (2 lowest bits from a and 6 bits from b)
-      element[offset] = (unsigned char) (((a & 3) << 6) | b);
-      written++;
-      offset = (offset + inc) % element_size;
-
-      if (written % element_size == 0)
+      else
       {
-        ToType float_value;
-        if (element_size == 4)
-        {
-          Int32 * value = reinterpret_cast<Int32 *>(&element[0]);
-          float_value = (ToType) * value;
-        }
-        else
-        {
-          Int64 * value = reinterpret_cast<Int64 *>(&element[0]);
-          float_value = (ToType) * value;
-        }
-        out.push_back(float_value);
-        strcpy(element, "");
+        Int64 value;
+        std::memcpy(&value, &data[i], sizeof(value));
+        data[i] = (ToType) value;
       }
     }
   }
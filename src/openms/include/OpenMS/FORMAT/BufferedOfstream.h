@@ -0,0 +1,79 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg, Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <fstream>
+#include <memory>
+
+namespace OpenMS
+{
+  namespace Internal
+  {
+    /// Owns the buffer of a BufferedOfstream (as a base class, so it is destroyed after the stream)
+    struct OPENMS_DLLAPI OfstreamBuffer
+    {
+      explicit OfstreamBuffer(Size size) :
+        buffer_(new char[size]),
+        buffer_size_(size)
+      {
+      }
+
+      std::unique_ptr<char[]> buffer_;
+      Size buffer_size_;
+    };
+  }
+
+  /**
+    @brief An output file stream with a large write buffer
+
+    The XML writers emit a lot of short pieces (tags, attributes and numbers, see NumericCodec); with the default
+    stream buffer of a few KB, this results in a large number of write calls. BufferedOfstream is a drop-in
+    replacement for std::ofstream that uses a buffer of @p buffer_size bytes (1 MB by default).
+
+    @ingroup FileIO
+  */
+  class OPENMS_DLLAPI BufferedOfstream :
+    private Internal::OfstreamBuffer,
+    public std::ofstream
+  {
+public:
+    /// Opens @p filename for writing (check the stream state for success, as for std::ofstream)
+    explicit BufferedOfstream(const String& filename, std::ios_base::openmode mode = std::ios_base::out, Size buffer_size = 1 << 20);
+  };
+
+} // namespace OpenMS
@@ -35,6 +35,7 @@
 #pragma once
 
 #include <OpenMS/config.h>
+#include <OpenMS/FORMAT/ReadAheadBuffer.h>
 #include <bzlib.h>
 #include <istream>
 
@@ -42,6 +43,9 @@ namespace OpenMS
 {
 /**
     @brief Decompresses files which are compressed in the bzip2 format (*.bz2)
+
+    Decompression runs on a background thread which stays one chunk ahead of
+    the reader (see ReadAheadBuffer).
 */
   class OPENMS_DLLAPI Bzip2Ifstream
   {
@@ -103,6 +107,8 @@ protected:
     int     bzerror_;
     ///true if end of file is reached
     bool stream_at_end_;
+    ///decompresses ahead of read() on a separate thread
+    ReadAheadBuffer read_ahead_;
 
     //not implemented
     Bzip2Ifstream(const Bzip2Ifstream & bzip2);
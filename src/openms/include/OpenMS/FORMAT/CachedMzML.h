@@ -36,8 +36,18 @@
 
 #include <OpenMS/KERNEL/MSExperiment.h>
 
+#include <boost/shared_ptr.hpp>
+
 #include <fstream>
 
+namespace boost
+{
+  namespace interprocess
+  {
+    class mapped_region;
+  }
+}
+
 namespace OpenMS
 {
 
@@ -49,6 +59,14 @@ namespace OpenMS
     be very fast and done in random order (once the in-memory index is built
     for the file).
 
+    The cached file is memory-mapped (read-only) when it is loaded, data items
+    are then read directly from the mapped memory without any seek or read
+    system calls. The mapping is shared between copies of the object and the
+    underlying pages are shared through the page cache between all processes
+    which access the same file. If the file cannot be mapped (e.g. files
+    larger than the address space on 32 bit systems), data is read through a
+    file stream instead.
+
   */
   class OPENMS_DLLAPI CachedmzML
   {
@@ -104,16 +122,55 @@ public:
     */
     static void load(const String& filename, CachedmzML& map);
 
+    /// Returns true if the cached file is accessed through a memory mapping (and not through a file stream)
+    bool isMemoryMapped() const;
+
 protected:
 
     void load_(const String& filename);
 
+    /**
+      @brief Opens the cached file of @p filename using meta data and index which are already available
+
+      No file is parsed or scanned, the cached data file @p filename + ".cached" only gets mapped.
+
+      @param filename The data location (ends in .mzML, expects an adjacent .mzML.cached file)
+      @param meta_data Meta data of all spectra and chromatograms in the cached file
+      @param spectra_index Positions of the spectra in the cached file
+      @param chrom_index Positions of the chromatograms in the cached file
+
+      @exception Exception::IllegalArgument is thrown if the index sizes do not agree with the meta data
+      @exception Exception::FileNotFound is thrown if the cached file does not exist
+    */
+    void load_(const String& filename, MSExperiment meta_data,
+               const std::vector<std::streampos>& spectra_index,
+               const std::vector<std::streampos>& chrom_index);
+
+    /// Tries to memory-map the cached file (the file stream is used if mapping fails)
+    void mapFile_();
+
+    /**
+      @brief Returns a pointer into the mapped file at position @p pos
+
+      @param pos The position in the cached file
+      @param available Output parameter to store the number of bytes which can be read from the returned position
+
+      @exception Exception::ParseError is thrown if @p pos is not within the mapped file
+    */
+    const char* mappedData_(std::streampos pos, Size& available) const;
+
+    /// Positions the file stream at @p pos
+    void seekFileStream_(std::streampos pos, Size id, const String& type);
+
     /// Meta data
     MSExperiment meta_ms_experiment_;
 
-    /// Internal filestream 
+    /// Internal filestream (only used if the file is not memory-mapped)
     std::ifstream ifs_;
 
+    /// Read-only mapping of the cached file (shared between copies)
+    boost::shared_ptr<boost::interprocess::mapped_region> mapped_file_;
+
     /// Name of the mzML file
     String filename_;
 
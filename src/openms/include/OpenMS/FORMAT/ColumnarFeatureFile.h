@@ -0,0 +1,250 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <limits>
+#include <map>
+#include <vector>
+
+namespace boost
+{
+  namespace interprocess
+  {
+    class mapped_region;
+  }
+}
+
+namespace OpenMS
+{
+  class ConsensusMap;
+  class FeatureMap;
+
+  /**
+    @brief Binary columnar storage of feature and consensus maps
+
+    featureXML and consensusXML spend most of their time converting numbers
+    to and from text. This format stores the data of a FeatureMap or
+    ConsensusMap column by column in native binary form (one contiguous
+    array per property, e.g. all RTs, all m/z values, all intensities), so
+    storing and loading are essentially memory copies.
+
+    Stored are, for every feature: RT, m/z, intensity, charge, overall and
+    per-dimension quality, width, unique id and the convex hulls; for
+    consensus features the feature handles instead of convex hulls, plus the
+    column headers of the map. Meta values of the features and of the map
+    itself are kept in a sparse side table (one row per meta value), so
+    features without meta values cost nothing.
+
+    Not stored are peptide and protein identifications, subordinate features
+    and data processing information. Use featureXML/consensusXML if these
+    are needed; this format is meant for fast handoff of quantitative data
+    between tools (e.g. feature detection, linking and alignment).
+
+    The file is memory-mapped read-only by open(). Only the column directory
+    is parsed at that point, a column is read when it is requested with
+    getColumn(), so e.g. only RT and m/z can be read from a large map without
+    touching the rest of the file. Parts of a column can be read as well, and
+    loadRange() restores a block of consecutive features, which allows
+    processing feature maps that do not fit into memory slab by slab.
+
+    All data is written in the byte order of the machine creating the file.
+  */
+  class OPENMS_DLLAPI ColumnarFeatureFile
+  {
+public:
+
+    /// Kind of map stored in a file
+    enum MapType
+    {
+      FEATURE_MAP,
+      CONSENSUS_MAP,
+      SIZE_OF_MAPTYPE
+    };
+
+    /// Element type of a column
+    enum ColumnType
+    {
+      DOUBLE_COLUMN,
+      FLOAT_COLUMN,
+      INT32_COLUMN,
+      INT64_COLUMN,
+      UINT32_COLUMN,
+      UINT64_COLUMN,
+      STRING_COLUMN,
+      SIZE_OF_COLUMNTYPE
+    };
+
+    /// Value of the meta row index column ("meta_row") which refers to the map itself
+    static const UInt64 MAP_ROW;
+
+    /// Default constructor (no file opened)
+    ColumnarFeatureFile();
+
+    /// Constructor which opens the file @p filename (see open())
+    explicit ColumnarFeatureFile(const String& filename);
+
+    /// Destructor
+    ~ColumnarFeatureFile();
+
+    /**
+      @brief Opens a file for lazy column access
+
+      Maps the file into memory and reads the column directory.
+
+      @exception Exception::FileNotFound is thrown if the file does not exist
+      @exception Exception::ParseError is thrown if the file is not a valid columnar feature file
+    */
+    void open(const String& filename);
+
+    /// Returns the kind of map stored in the opened file
+    MapType getMapType() const;
+
+    /// Returns the number of (consensus) features in the opened file
+    Size size() const;
+
+    /// Returns the names of all columns in the opened file
+    std::vector<String> getColumnNames() const;
+
+    /// Returns true if the opened file contains a column named @p name
+    bool hasColumn(const String& name) const;
+
+    /**
+      @brief Returns the number of elements of the column @p name
+
+      @exception Exception::ElementNotFound is thrown if there is no such column
+    */
+    Size getColumnSize(const String& name) const;
+
+    /**
+      @name Column access
+
+      Copy the elements [@p first, @p first + @p count) of the column @p name
+      from the mapped file into @p values (by default the whole column). The
+      range is clipped at the end of the column.
+
+      @exception Exception::ElementNotFound is thrown if there is no such column
+      @exception Exception::InvalidValue is thrown if the column has a different element type
+      @exception Exception::IndexOverflow is thrown if @p first is larger than the column size
+    */
+    //@{
+    void getColumn(const String& name, std::vector<double>& values, Size first = 0, Size count = std::numeric_limits<Size>::max()) const;
+    void getColumn(const String& name, std::vector<float>& values, Size first = 0, Size count = std::numeric_limits<Size>::max()) const;
+    void getColumn(const String& name, std::vector<Int32>& values, Size first = 0, Size count = std::numeric_limits<Size>::max()) const;
+    void getColumn(const String& name, std::vector<Int64>& values, Size first = 0, Size count = std::numeric_limits<Size>::max()) const;
+    void getColumn(const String& name, std::vector<UInt32>& values, Size first = 0, Size count = std::numeric_limits<Size>::max()) const;
+    void getColumn(const String& name, std::vector<UInt64>& values, Size first = 0, Size count = std::numeric_limits<Size>::max()) const;
+    void getColumn(const String& name, std::vector<String>& values, Size first = 0, Size count = std::numeric_limits<Size>::max()) const;
+    //@}
+
+    /**
+      @brief Loads the features [@p first, @p first + @p count) of the opened file into @p map
+
+      The features are restored completely (incl. convex hulls and meta
+      values), data of the map itself (meta values, unique id) is not. The
+      range is clipped at the end of the file.
+
+      @exception Exception::ParseError is thrown if the file is invalid or contains a consensus map
+      @exception Exception::IndexOverflow is thrown if @p first is larger than size()
+    */
+    void loadRange(Size first, Size count, FeatureMap& map) const;
+
+    /**
+      @brief Stores a feature map
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    static void store(const String& filename, const FeatureMap& map);
+
+    /**
+      @brief Stores a consensus map
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    static void store(const String& filename, const ConsensusMap& map);
+
+    /**
+      @brief Loads a feature map (replacing the content of @p map)
+
+      @exception Exception::FileNotFound is thrown if the file does not exist
+      @exception Exception::ParseError is thrown if the file is invalid or contains a consensus map
+    */
+    static void load(const String& filename, FeatureMap& map);
+
+    /**
+      @brief Loads a consensus map (replacing the content of @p map)
+
+      @exception Exception::FileNotFound is thrown if the file does not exist
+      @exception Exception::ParseError is thrown if the file is invalid or contains a feature map
+    */
+    static void load(const String& filename, ConsensusMap& map);
+
+protected:
+
+    /// Location of a column in the mapped file
+    struct ColumnEntry
+    {
+      ColumnType type;
+      UInt64 count; ///< number of elements
+      UInt64 offset; ///< start of the data in the file
+      UInt64 bytes; ///< size of the data in bytes
+    };
+
+    /// Returns the column @p name, checking its type against @p type
+    const ColumnEntry& getEntry_(const String& name, ColumnType type) const;
+
+    /// Returns the number of elements in [@p first, @p first + @p count) which lie inside the column @p entry
+    Size clipRange_(const ColumnEntry& entry, Size first, Size count) const;
+
+    /// Copies a part of a numeric column into @p values
+    template <typename T>
+    void getNumericColumn_(const String& name, ColumnType type, std::vector<T>& values, Size first, Size count) const;
+
+    /// Throws unless the opened file holds a map of type @p type
+    void checkMapType_(MapType type) const;
+
+    String filename_;
+    boost::shared_ptr<boost::interprocess::mapped_region> mapped_file_;
+    const char* data_;
+    MapType map_type_;
+    UInt64 size_;
+    std::map<String, ColumnEntry> columns_;
+  };
+
+} // namespace OpenMS
+
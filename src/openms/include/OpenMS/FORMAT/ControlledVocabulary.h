@@ -40,6 +40,8 @@
 #include <OpenMS/CONCEPT/Exception.h>
 
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 namespace OpenMS
 {
@@ -123,6 +125,17 @@ public:
     */
     void loadFromOBO(const String& name, const String& filename);
 
+    /**
+        @brief Returns the PSI-MS CV together with the CVs it refers to (PATO, UO, BTO and GO)
+
+        The OBO files are parsed only once, on first use, and shared by all callers (e.g. every mzML reader and writer).
+        This is thread-safe.
+
+        @exception Exception::FileNotFound is thrown if one of the files could not be found or opened
+        @exception Exception::ParseError is thrown if an error occurs during parsing
+    */
+    static const ControlledVocabulary& getPSIMSCV();
+
     /// Returns true if the term is in the CV. Returns false otherwise.
     bool exists(const String& id) const;
 
@@ -183,9 +196,11 @@ public:
     const ControlledVocabulary::CVTerm* checkAndGetTermByName(const OpenMS::String& name) const;
 
     /**
-        @brief Returns if @p child is a child of @p parent
+        @brief Returns if @p child is a (direct or indirect) child of @p parent
 
-        @exception Exception::InvalidValue is thrown if one of the terms is not present
+        The ancestors of all terms are precomputed when loading, so this is a hash lookup and a binary search.
+
+        @exception Exception::InvalidValue is thrown if @p child is not present
     */
     bool isChildOf(const String& child, const String& parent) const;
 
@@ -197,12 +212,19 @@ protected:
     */
     bool checkName_(const String& id, const String& name, bool ignore_case = true);
 
+    /// (Re-)computes term_index_ and ancestors_ from terms_
+    void updateAncestors_();
+
     ///Map from ID to CVTerm
     Map<String, CVTerm> terms_;
     ///Map from name to id
     Map<String, String> namesToIds_;
     ///Name set in the load method
     String name_;
+    ///Index of each term ID (in the order of terms_)
+    std::unordered_map<String, Size> term_index_;
+    ///Sorted indices of all (direct and indirect) parents of each term
+    std::vector<std::vector<Size> > ancestors_;
   };
 
   ///Print the contents to a stream.
@@ -0,0 +1,146 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <OpenMS/INTERFACES/IIdentificationConsumer.h>
+#include <OpenMS/FORMAT/IdXMLFile.h>
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <unordered_map>
+
+namespace OpenMS
+{
+
+  /**
+    @brief Consumer class that writes identifications to an idXML file incrementally.
+
+    Counterpart of IdXMLFile::transform for writing: identifications can be
+    filtered or converted in constant memory by streaming them from one file
+    to another.
+
+    Example usage:
+
+    @code
+    IdXMLWritingConsumer writer(out_file);
+    MyFilteringConsumer filter(&writer); // passes (modified) identifications on to "writer"
+    IdXMLFile().transform(in_file, &filter);
+    writer.close();
+    @endcode
+
+    The PeptideIdentifications of each run are written to a temporary file as
+    soon as they are consumed. close() (or the destructor) assembles the final
+    file, since idXML lists all search parameters before the first run.
+    Apart from the search parameters, only the look-up of protein
+    accessions is kept in memory. Runs are written in the order in which their
+    ProteinIdentifications were consumed, peptide identifications in the
+    order in which they were consumed.
+
+    @note A ProteinIdentification must be consumed before the
+    PeptideIdentifications referring to it. PeptideIdentifications without
+    hits or without a matching run are omitted (like in IdXMLFile::store).
+  */
+  class OPENMS_DLLAPI IdXMLWritingConsumer :
+    public Interfaces::IIdentificationConsumer
+  {
+  public:
+
+    /**
+      @brief Constructor
+
+      @param filename Filename of the output idXML
+      @param document_id Document identifier (optional)
+
+      @exception Exception::UnableToCreateFile is thrown if the file cannot be created
+    */
+    explicit IdXMLWritingConsumer(const String& filename, const String& document_id = "");
+
+    /// Destructor (calls close() if that was not done before)
+    ~IdXMLWritingConsumer() override;
+
+    /**
+      @brief Consume a protein identification (starts a new run)
+
+      @exception Exception::IllegalArgument is thrown if a run with the same identifier was consumed before
+    */
+    void consumeProteinIdentification(ProteinIdentification& prot_id) override;
+
+    /**
+      @brief Consume a batch of peptide identifications (written immediately)
+
+      @exception Exception::ElementNotFound is thrown if a peptide evidence refers to an unknown protein accession
+    */
+    void consumePeptideIdentifications(std::vector<PeptideIdentification>& pep_ids) override;
+
+    /**
+      @brief Writes the final idXML file (consuming afterwards is not possible)
+
+      @exception Exception::UnableToCreateFile is thrown if the file cannot be written
+    */
+    void close();
+
+  protected:
+
+    /// A run (ProteinIdentification) and the temporary file with its PeptideIdentifications
+    struct Run_
+    {
+      String identifier;
+      String tmp_file;
+      std::unique_ptr<std::ofstream> os;
+    };
+
+    String filename_;
+    String document_id_;
+
+    /// Provides the XML writing helpers
+    IdXMLFile id_xml_;
+
+    std::vector<ProteinIdentification::SearchParameters> params_;
+    std::vector<Run_> runs_;
+    /// Run identifier -> index in runs_
+    std::map<String, Size> run_index_;
+
+    /// Protein hit references ("PH_<index>") for the peptide evidences
+    UInt prot_count_;
+    std::unordered_map<std::string, UInt> accession_to_id_;
+
+    Size count_empty_;
+    Size count_missing_run_;
+    bool closed_;
+  };
+
+} //end namespace OpenMS
@@ -0,0 +1,137 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <OpenMS/INTERFACES/IMSDataConsumer.h>
+
+#include <OpenMS/KERNEL/StandardTypes.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/FILTERING/TRANSFORMERS/SpectraMerger.h>
+
+#include <map>
+#include <vector>
+
+namespace OpenMS
+{
+
+    /**
+      @brief Block-wise spectra merging consumer of MS data
+
+      Merges blocks of spectra on the fly, the same way as
+      SpectraMerger::mergeSpectraBlockWise (using the "block_method:*"
+      parameters of the given SpectraMerger), and passes the result on to the
+      next consumer (see Constructor). Only the currently open block of each
+      MS level and the spectra within its RT range are held in memory.
+
+      Spectra are passed on sorted by RT (as after mergeSpectraBlockWise),
+      which requires the input to be sorted by RT. Chromatograms are passed on
+      unchanged; since they usually follow all spectra, receiving a
+      chromatogram closes all open blocks.
+
+      @note The expected number of spectra passed to the next consumer is an
+      upper bound, since merging reduces the number of spectra.
+
+    */
+    class OPENMS_DLLAPI MSDataBlockMergingConsumer :
+      public Interfaces::IMSDataConsumer
+    {
+
+    public:
+
+      /**
+        @brief Constructor
+
+        @param next_consumer Consumer which receives the merged data
+        @param merger The configured spectra merger
+
+        @note This does not transfer ownership of the consumer
+      */
+      MSDataBlockMergingConsumer(Interfaces::IMSDataConsumer* next_consumer, const SpectraMerger& merger);
+
+      /**
+        @brief Destructor
+
+        Flushes data to next consumer
+
+        @note It is essential to not delete the underlying next_consumer before
+        deleting this object, otherwise we risk a memory error
+      */
+      ~MSDataBlockMergingConsumer() override;
+
+      /// Forwarded to the next consumer
+      void setExpectedSize(Size expectedSpectra, Size expectedChromatograms) override;
+
+      /// Forwarded to the next consumer
+      void setExperimentalSettings(const OpenMS::ExperimentalSettings& exp) override;
+
+      void consumeSpectrum(SpectrumType& s) override;
+
+      void consumeChromatogram(ChromatogramType& c) override;
+
+      /**
+        @brief Merges all open blocks and passes all remaining spectra on
+
+        Called automatically upon destruction and when the first chromatogram
+        is consumed.
+      */
+      void flush();
+
+    protected:
+
+      /**
+        @brief Closes the open block of @p ms_level
+
+        A block without any spectra to merge is passed on unchanged, unless it
+        is the @p last block of its MS level (same as in mergeSpectraBlockWise).
+      */
+      void closeBlock_(Int ms_level, bool last);
+
+      /// Passes on all buffered spectra with RT below @p rt_limit
+      void release_(double rt_limit);
+
+      Interfaces::IMSDataConsumer* next_consumer_;
+      SpectraMerger merger_;
+      std::vector<Int> ms_levels_;
+      Size rt_block_size_;
+      double rt_max_length_;
+      /// open block per MS level (first spectrum is the master spectrum)
+      std::map<Int, PeakMap> blocks_;
+      /// spectra waiting to be passed on, by RT
+      std::multimap<double, SpectrumType> output_;
+    };
+
+} //end namespace OpenMS
+
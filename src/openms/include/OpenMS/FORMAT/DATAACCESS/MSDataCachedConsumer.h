@@ -50,6 +50,10 @@ namespace OpenMS
       Is able to transform a spectrum on the fly while it is read using a
       function pointer that can be set on the object. The spectra is then
       cached to disk using the functions provided in CachedMzMLHandler.
+
+      The position of each data item is recorded while it is written, thus
+      getSpectraIndex() and getChromatogramIndex() are available without
+      calling createMemdumpIndex() on the finished file.
     */
     class OPENMS_DLLAPI MSDataCachedConsumer :
       public Internal::CachedMzMLHandler,
@@ -97,7 +101,8 @@ namespace OpenMS
       */
       void consumeChromatogram(ChromatogramType & c) override;
 
-      void setExpectedSize(Size /* expectedSpectra */, Size /* expectedChromatograms */) override {;}
+      /// Reserves space for the index of the expected number of spectra and chromatograms
+      void setExpectedSize(Size expectedSpectra, Size expectedChromatograms) override;
 
       void setExperimentalSettings(const ExperimentalSettings& /* exp */) override {;}
 
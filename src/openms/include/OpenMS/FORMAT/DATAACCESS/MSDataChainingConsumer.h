@@ -68,6 +68,8 @@ namespace OpenMS
     // now chaining_consumer can be passed to a function expecting a IMSDataConsumer interface
     @endcode
 
+    @see MSDataPipelineConsumer, which runs the consumers concurrently on worker threads
+
   */
   class OPENMS_DLLAPI MSDataChainingConsumer :
     public Interfaces::IMSDataConsumer
@@ -0,0 +1,132 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <OpenMS/INTERFACES/IMSDataConsumer.h>
+
+#include <OpenMS/KERNEL/StandardTypes.h>
+#include <OpenMS/KERNEL/MSSpectrum.h>
+#include <OpenMS/KERNEL/MSChromatogram.h>
+#include <OpenMS/TRANSFORMATIONS/RAW2PEAK/PeakPickerHiRes.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+
+    /**
+      @brief Peak picking consumer of MS data
+
+      Picks spectra and chromatograms on the fly using PeakPickerHiRes and
+      passes the centroided data on to the next consumer (see Constructor),
+      e.g. a PlainMSDataWritingConsumer. Incoming data is collected into
+      batches of @p batch_size items which are picked in parallel and then
+      forwarded in their original order, thus memory consumption is bounded by
+      a few batches independent of the size of the input.
+
+      Spectra are selected for picking the same way as in
+      PeakPickerHiRes::pickExperiment: if the "ms_levels" parameter is empty,
+      all spectra not annotated as centroided are picked, otherwise only
+      spectra of the given MS levels.
+
+      @note Since data is processed in batches, the spectra and chromatograms
+      passed to this consumer are copied and left unchanged.
+
+    */
+    class OPENMS_DLLAPI MSDataPeakPickingConsumer :
+      public Interfaces::IMSDataConsumer
+    {
+
+    public:
+
+      /**
+        @brief Constructor
+
+        @param next_consumer Consumer which receives the picked data
+        @param pp The configured peak picker
+        @param batch_size Number of spectra (chromatograms) picked together
+        @param check_spectrum_type Throw if a centroided spectrum is encountered on an MS level requested for picking
+
+        @note This does not transfer ownership of the consumer
+      */
+      MSDataPeakPickingConsumer(Interfaces::IMSDataConsumer* next_consumer, const PeakPickerHiRes& pp,
+                                Size batch_size = 64, bool check_spectrum_type = true);
+
+      /**
+        @brief Destructor
+
+        Flushes data to next consumer
+
+        @note It is essential to not delete the underlying next_consumer before
+        deleting this object, otherwise we risk a memory error
+      */
+      ~MSDataPeakPickingConsumer() override;
+
+      /// Forwarded to the next consumer
+      void setExpectedSize(Size expectedSpectra, Size expectedChromatograms) override;
+
+      /// Forwarded to the next consumer
+      void setExperimentalSettings(const OpenMS::ExperimentalSettings& exp) override;
+
+      void consumeSpectrum(SpectrumType& s) override;
+
+      void consumeChromatogram(ChromatogramType& c) override;
+
+      /**
+        @brief Picks all remaining spectra and chromatograms and passes them on
+
+        Called automatically upon destruction, call it explicitly to catch
+        errors during picking of the last batch.
+      */
+      void flush();
+
+    protected:
+
+      void flushSpectra_();
+
+      void flushChromatograms_();
+
+      Interfaces::IMSDataConsumer* next_consumer_;
+      PeakPickerHiRes pp_;
+      std::vector<Int> ms_levels_;
+      Size batch_size_;
+      bool check_spectrum_type_;
+      std::vector<SpectrumType> spectra_;
+      std::vector<ChromatogramType> chromatograms_;
+    };
+
+} //end namespace OpenMS
+
@@ -0,0 +1,176 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <OpenMS/INTERFACES/IMSDataConsumer.h>
+
+#include <memory>
+#include <vector>
+
+namespace OpenMS
+{
+
+  /**
+    @brief Consumer class that passes all consumed data through a pipeline of consumers running on worker threads
+
+    Like MSDataChainingConsumer, this consumer applies a list of consumers
+    one after another to every spectrum and chromatogram. However, each stage
+    of the chain runs on its own worker thread and the stages are connected by
+    bounded queues. Thus, the reader (e.g. the XML parser) and all stages work
+    concurrently and the throughput is limited by the slowest stage instead of
+    by the sum of all stages.
+
+    - A stage whose consumer may be called concurrently (e.g. a stateless
+      MSDataTransformingConsumer or the peak picking consumer) can be declared
+      parallel by assigning it more than one worker.
+    - A fan-out stage passes (a copy of) every item to several consumers which
+      run concurrently, e.g. to write mzML and sqMass and to collect QC
+      metrics from the same data. It has to be the last stage.
+
+    All stages with a single worker receive the data in the order in which it
+    was consumed, also behind parallel stages.
+
+    In contrast to MSDataChainingConsumer, consumeSpectrum() and
+    consumeChromatogram() pass a copy of the data into the pipeline and return
+    before it is processed; the caller's object is not modified. Processing is
+    complete once finish() returns. It has to be called before the results of
+    the consumers are used (or the consumers are destroyed). Exceptions thrown
+    by a consumer stop the pipeline and are rethrown by the next call of
+    consumeSpectrum(), consumeChromatogram() or finish().
+
+    Usage:
+
+    @code
+    MSDataPipelineConsumer pipeline;
+    pipeline.appendStage(&picking_consumer, 4); // thread-safe, four workers
+    pipeline.appendStage(&calibrating_consumer);
+    pipeline.appendFanOut({&mzml_writer, &sqmass_writer, &qc_consumer});
+
+    MzMLFile().transform(infile, &pipeline);
+    pipeline.finish();
+    @endcode
+
+    @note The consumers are not owned by the pipeline.
+  */
+  class OPENMS_DLLAPI MSDataPipelineConsumer :
+    public Interfaces::IMSDataConsumer
+  {
+  public:
+
+    /**
+     * @brief Constructor
+     *
+     * @param queue_size Maximal number of items buffered in front of each stage
+     *
+     */
+    explicit MSDataPipelineConsumer(Size queue_size = 64);
+
+    /**
+     * @brief Destructor
+     *
+     * Calls finish(); errors of the consumers that were not reported yet are
+     * logged. Does not destroy the underlying consumers.
+     *
+     */
+    ~MSDataPipelineConsumer() override;
+
+    /**
+     * @brief Appends a stage that applies @p consumer to all items
+     *
+     * With @p workers > 1, @p consumer is called concurrently by several
+     * threads and has to be thread-safe.
+     *
+     * @throw Exception::IllegalArgument if the last stage is a fan-out stage or consuming has started
+     *
+     */
+    void appendStage(Interfaces::IMSDataConsumer * consumer, Size workers = 1);
+
+    /**
+     * @brief Appends a stage that passes every item to all of @p consumers, which run concurrently
+     *
+     * Every consumer receives its own copy of the items, in order. No further
+     * stage may be appended afterwards.
+     *
+     * @throw Exception::IllegalArgument if the last stage is a fan-out stage or consuming has started
+     *
+     */
+    void appendFanOut(const std::vector<Interfaces::IMSDataConsumer *> & consumers);
+
+    /**
+     * @brief Set experimental settings for all consumers
+     *
+     */
+    void setExperimentalSettings(const ExperimentalSettings & settings) override;
+
+    /**
+     * @brief Set expected size for all consumers
+     *
+     */
+    void setExpectedSize(Size s_size, Size c_size) override;
+
+    /**
+     * @brief Passes a copy of @p s into the pipeline (waits if the first queue is full)
+     *
+     */
+    void consumeSpectrum(SpectrumType & s) override;
+
+    /**
+     * @brief Passes a copy of @p c into the pipeline (waits if the first queue is full)
+     *
+     */
+    void consumeChromatogram(ChromatogramType & c) override;
+
+    /**
+     * @brief Waits until all consumed data has passed all stages and stops the workers
+     *
+     * Rethrows the first exception thrown by a consumer (if not reported
+     * before). No data can be consumed afterwards.
+     *
+     */
+    void finish();
+
+  private:
+
+    struct Impl_;
+    std::unique_ptr<Impl_> impl_;
+
+    /// not implemented
+    MSDataPipelineConsumer(const MSDataPipelineConsumer &);
+    MSDataPipelineConsumer & operator=(const MSDataPipelineConsumer &);
+  };
+
+} //end namespace OpenMS
+
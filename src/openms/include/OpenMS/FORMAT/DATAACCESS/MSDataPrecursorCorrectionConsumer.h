@@ -0,0 +1,138 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/INTERFACES/IMSDataConsumer.h>
+
+#include <OpenMS/KERNEL/StandardTypes.h>
+#include <OpenMS/KERNEL/MSSpectrum.h>
+#include <OpenMS/KERNEL/MSChromatogram.h>
+
+#include <deque>
+#include <vector>
+
+namespace OpenMS
+{
+
+    /**
+      @brief Precursor correction consumer of MS data
+
+      Streaming counterpart of PrecursorCorrection::correctToNearestMS1Peak and
+      PrecursorCorrection::correctToHighestIntensityMS1Peak: the most recent
+      MS1 spectra are kept in a small ring buffer, and the first precursor of
+      each MS2 spectrum passing by is corrected to a peak of its survey scan
+      before the spectrum is passed on to the next consumer (see Constructor),
+      e.g. a PlainMSDataWritingConsumer. Memory consumption is thus bounded by
+      @p max_survey_scans spectra, independent of the size of the input.
+
+      The survey scan of an MS2 spectrum is the MS1 spectrum referenced by the
+      "spectrum_ref" of its first precursor or otherwise the most recent MS1
+      spectrum (as in PrecursorCorrection::getSurveyScanIndex). Referenced
+      spectra which are no longer in the buffer are treated like missing
+      references.
+
+      The uncorrected m/z, retention time and m/z shift of all corrected
+      precursors are recorded (e.g. for PrecursorCorrection::writeHist).
+    */
+    class OPENMS_DLLAPI MSDataPrecursorCorrectionConsumer :
+      public Interfaces::IMSDataConsumer
+    {
+
+    public:
+
+      /// Selection of the peak the precursor is corrected to
+      enum CorrectionMethod
+      {
+        NEAREST_PEAK,           ///< the closest peak (see PrecursorCorrection::findNearestMS1Peak)
+        HIGHEST_INTENSITY_PEAK  ///< the highest peak in the tolerance window (see PrecursorCorrection::findHighestIntensityMS1Peak), also corrects the precursor intensity
+      };
+
+      /**
+        @brief Constructor
+
+        @param next_consumer Consumer which receives the corrected data
+        @param method Selection of the peak in the survey scan
+        @param mz_tolerance Tolerance used for precursor correction
+        @param ppm Is @p mz_tolerance given in ppm (or in Th)?
+        @param max_survey_scans Number of most recent MS1 spectra kept for the correction
+
+        @note This does not transfer ownership of the consumer
+      */
+      MSDataPrecursorCorrectionConsumer(Interfaces::IMSDataConsumer* next_consumer, CorrectionMethod method,
+                                        double mz_tolerance, bool ppm, Size max_survey_scans = 8);
+
+      /// Destructor
+      ~MSDataPrecursorCorrectionConsumer() override = default;
+
+      /// Forwarded to the next consumer
+      void setExpectedSize(Size expectedSpectra, Size expectedChromatograms) override;
+
+      /// Forwarded to the next consumer
+      void setExperimentalSettings(const OpenMS::ExperimentalSettings& exp) override;
+
+      void consumeSpectrum(SpectrumType& s) override;
+
+      /// Forwarded to the next consumer
+      void consumeChromatogram(ChromatogramType& c) override;
+
+      /// Number of corrected precursors
+      Size getNumberOfCorrectedPrecursors() const;
+
+      /// m/z shifts (corrected - uncorrected) of the corrected precursors
+      const std::vector<double>& getDeltaMZs() const;
+
+      /// Uncorrected m/z of the corrected precursors
+      const std::vector<double>& getMZs() const;
+
+      /// Retention times of the spectra of the corrected precursors
+      const std::vector<double>& getRTs() const;
+
+    protected:
+
+      /// The survey scan of MS2 spectrum @p s (nullptr if there is none in the buffer)
+      const SpectrumType* findSurveyScan_(const SpectrumType& s) const;
+
+      Interfaces::IMSDataConsumer* next_consumer_;
+      CorrectionMethod method_;
+      double mz_tolerance_;
+      bool ppm_;
+      Size max_survey_scans_;
+      std::deque<SpectrumType> survey_scans_; ///< most recent MS1 spectra, oldest first
+      std::vector<double> delta_mzs_;
+      std::vector<double> mzs_;
+      std::vector<double> rts_;
+    };
+
+} //end namespace OpenMS
@@ -38,6 +38,8 @@
 
 #include <OpenMS/KERNEL/MSExperiment.h>
 
+#include <memory>
+
 namespace OpenMS
 {
 
@@ -56,6 +58,10 @@ namespace OpenMS
 
       It uses MzMLSqliteHandler internally to write batches of data to disk.
 
+      The batches are written by a background thread (encoding the binary data in
+      parallel and inserting each batch in a single transaction), so the producer
+      only waits if it generates data faster than it can be written.
+
     */
     class OPENMS_DLLAPI MSDataSqlConsumer :
       public Interfaces::IMSDataConsumer
@@ -89,8 +95,11 @@ namespace OpenMS
       /**
         @brief Flushes the data for good.
 
-        After calling this function, no more data is held in the buffer but the
-        class is still able to receive new data.
+        After calling this function, no more data is held in the buffer
+        and all data consumed so far is written to the file, but the class is
+        still able to receive new data.
+
+        @exception Any exception that occurred while writing a batch in the background
       */
       void flush();
 
@@ -110,6 +119,12 @@ namespace OpenMS
 
     protected:
 
+      /// hands the buffered data over to the writer thread (waits if it is still busy with earlier batches)
+      void flushAsync_();
+
+      /// writes batches of spectra and chromatograms on a background thread
+      struct Writer_;
+
       String filename_;
       OpenMS::Internal::MzMLSqliteHandler * handler_;
 
@@ -119,6 +134,7 @@ namespace OpenMS
       std::vector<ChromatogramType> chromatograms_;
 
       MSExperiment peak_meta_;
+      std::unique_ptr<Writer_> writer_;
     };
 
 } //end namespace OpenMS
@@ -80,6 +80,11 @@ namespace OpenMS
       chromatograms since this could lead to a situation with multiple
       @a spectrumList tags appear in an mzML file.
 
+      @note When multiple threads are available, consumed spectra and chromatograms
+      are buffered and written in batches whose binary data is encoded (and
+      compressed) in parallel. The file is complete once the consumer is
+      destroyed.
+
       @note The expected size will @a not be enforced but it will lead to an
       inconsistent mzML if the count attribute of spectrumList or
       chromatogramList is incorrect.
@@ -195,6 +200,12 @@ namespace OpenMS
       */
       virtual void doCleanup_();
 
+      /// Writes the buffered spectra
+      void flushSpectra_();
+
+      /// Writes the buffered chromatograms
+      void flushChromatograms_();
+
     protected:
 
       /// File stream (to write mzML)
@@ -226,6 +237,12 @@ namespace OpenMS
       std::vector<std::vector< ConstDataProcessingPtr > > dps_;
       /// The dataprocessing to be added to each spectrum/chromatogram
       DataProcessingPtr additional_dataprocessing_;
+
+      /// Spectra consumed but not yet written (see MzMLHandler::writeSpectra_())
+      std::vector<SpectrumType> pending_spectra_;
+
+      /// Chromatograms consumed but not yet written
+      std::vector<ChromatogramType> pending_chromatograms_;
     };
 
     /**
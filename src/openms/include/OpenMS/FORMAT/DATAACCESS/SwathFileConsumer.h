@@ -155,7 +155,7 @@ public:
       if (ms1_map_)
       {
         OpenSwath::SwathMap map;
-        map.sptr = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(ms1_map_);
+        map.sptr = getSpectrumAccess_(ms1_map_, -1);
         map.lower = -1;
         map.upper = -1;
         map.center = -1;
@@ -175,7 +175,7 @@ public:
       for (Size i = 0; i < swath_maps_.size(); i++)
       {
         OpenSwath::SwathMap map;
-        map.sptr = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(swath_maps_[i]);
+        map.sptr = getSpectrumAccess_(swath_maps_[i], static_cast<int>(i));
         map.lower = swath_map_boundaries_[i].lower;
         map.upper = swath_map_boundaries_[i].upper;
         map.center = swath_map_boundaries_[i].center;
@@ -303,6 +303,19 @@ protected:
      */
     virtual void ensureMapsAreFilled_() = 0;
 
+    /**
+     * @brief Provides spectrum access to a map after ensureMapsAreFilled_ was called
+     *
+     * @param map The MS1 map or a SWATH map
+     * @param swath_nr The number of the SWATH map (-1 for the MS1 map)
+     *
+     * The default implementation uses SimpleOpenMSSpectraFactory on @p map.
+     */
+    virtual OpenSwath::SpectrumAccessPtr getSpectrumAccess_(boost::shared_ptr<PeakMap> map, int /* swath_nr */)
+    {
+      return SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(map);
+    }
+
     /// A list of Swath map identifiers (lower/upper boundary and center)
     std::vector<OpenSwath::SwathMap> swath_map_boundaries_;
 
@@ -388,6 +401,12 @@ protected:
    * n+1 (n SWATH + 1 MS1 map) objects of MSDataCachedConsumer which can consume the
    * spectra and write them to disk immediately.
    *
+   * After all spectra are consumed, the meta data of the MS1 map and all SWATH
+   * maps are written in parallel. By default the meta data is then read back
+   * from disk. If setReloadMetaData(false) is used, the maps in memory and the
+   * index recorded while writing the cached files are directly handed to a
+   * (memory-mapped) SpectrumAccessOpenMSCached instead.
+   *
    */
   class OPENMS_DLLAPI CachedSwathFileConsumer :
     public FullSwathFileConsumer
@@ -404,7 +423,8 @@ public:
       cachedir_(cachedir),
       basename_(basename),
       nr_ms1_spectra_(nr_ms1_spectra),
-      nr_ms2_spectra_(nr_ms2_spectra)
+      nr_ms2_spectra_(nr_ms2_spectra),
+      reload_meta_data_(true)
     {}
 
     CachedSwathFileConsumer(std::vector<OpenSwath::SwathMap> known_window_boundaries,
@@ -415,22 +435,25 @@ public:
       cachedir_(cachedir),
       basename_(basename),
       nr_ms1_spectra_(nr_ms1_spectra),
-      nr_ms2_spectra_(nr_ms2_spectra)
+      nr_ms2_spectra_(nr_ms2_spectra),
+      reload_meta_data_(true)
     {}
 
     ~CachedSwathFileConsumer() override
     {
-      // Properly delete the MSDataCachedConsumer -> free memory and _close_ file stream
-      while (!swath_consumers_.empty())
-      {
-        delete swath_consumers_.back();
-        swath_consumers_.pop_back();
-      }
-      if (ms1_consumer_ != nullptr)
-      {
-        delete ms1_consumer_;
-        ms1_consumer_ = nullptr;
-      }
+      closeConsumers_();
+    }
+
+    /// Whether to read the meta data back from disk after writing it (default), otherwise the maps in memory are used
+    void setReloadMetaData(bool reload)
+    {
+      reload_meta_data_ = reload;
+    }
+
+    /// Whether the meta data is read back from disk after writing it
+    bool getReloadMetaData() const
+    {
+      return reload_meta_data_;
     }
 
 protected:
@@ -477,53 +500,18 @@ protected:
       ms1_map_->addSpectrum(s); // append for the metadata (actual data is deleted)
     }
 
-    void ensureMapsAreFilled_() override
-    {
-      size_t swath_consumers_size = swath_consumers_.size();
-      bool have_ms1 = (ms1_consumer_ != nullptr);
-
-      // Properly delete the MSDataCachedConsumer -> free memory and _close_ file stream
-      // The file streams to the cached data on disc can and should be closed
-      // here safely. Since ensureMapsAreFilled_ is called after consuming all
-      // the spectra, there will be no more spectra to append but the client
-      // might already want to read after this call, so all data needs to be
-      // present on disc and the file streams closed.
-      //
-      // TODO merge with destructor code into own function!
-      while (!swath_consumers_.empty())
-      {
-        delete swath_consumers_.back();
-        swath_consumers_.pop_back();
-      }
-      if (ms1_consumer_ != nullptr)
-      {
-        delete ms1_consumer_;
-        ms1_consumer_ = nullptr;
-      }
+    void ensureMapsAreFilled_() override;
 
-      if (have_ms1)
-      {
-        boost::shared_ptr<PeakMap > exp(new PeakMap);
-        String meta_file = cachedir_ + basename_ + "_ms1.mzML";
-        // write metadata to disk and store the correct data processing tag
-        Internal::CachedMzMLHandler().writeMetadata(*ms1_map_, meta_file, true);
-        MzMLFile().load(meta_file, *exp.get());
-        ms1_map_ = exp;
-      }
+    OpenSwath::SpectrumAccessPtr getSpectrumAccess_(boost::shared_ptr<PeakMap> map, int swath_nr) override;
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-      for (SignedSize i = 0; i < boost::numeric_cast<SignedSize>(swath_consumers_size); i++)
-      {
-        boost::shared_ptr<PeakMap > exp(new PeakMap);
-        String meta_file = cachedir_ + basename_ + "_" + String(i) +  ".mzML";
-        // write metadata to disk and store the correct data processing tag
-        Internal::CachedMzMLHandler().writeMetadata(*swath_maps_[i], meta_file, true);
-        MzMLFile().load(meta_file, *exp.get());
-        swath_maps_[i] = exp;
-      }
-    }
+    /**
+     * @brief Deletes all MSDataCachedConsumer objects (closes the file streams)
+     *
+     * @param ms1_index If not null, the index of the MS1 cached file is stored here
+     * @param swath_index If not null, the index of each SWATH cached file is stored here
+     */
+    void closeConsumers_(std::vector<std::streampos>* ms1_index = nullptr,
+                         std::vector<std::vector<std::streampos> >* swath_index = nullptr);
 
     MSDataCachedConsumer* ms1_consumer_;
     std::vector<MSDataCachedConsumer*> swath_consumers_;
@@ -532,6 +520,13 @@ protected:
     String basename_;
     int nr_ms1_spectra_;
     std::vector<int> nr_ms2_spectra_;
+
+    /// Whether the meta data is read back from disk
+    bool reload_meta_data_;
+
+    /// Spectrum access to the cached files (only used if the meta data is not read back)
+    OpenSwath::SpectrumAccessPtr ms1_access_;
+    std::vector<OpenSwath::SpectrumAccessPtr> swath_access_;
   };
 
   /**
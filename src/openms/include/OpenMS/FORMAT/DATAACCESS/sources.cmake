@@ -4,9 +4,14 @@ set(directory include/OpenMS/FORMAT/DATAACCESS)
 ### list all header files of the directory here
 set(sources_list_h
   CsiFingerIdMzTabWriter.h
+  IdXMLWritingConsumer.h
   MSDataAggregatingConsumer.h
+  MSDataBlockMergingConsumer.h
   MSDataCachedConsumer.h
   MSDataChainingConsumer.h
+  MSDataPeakPickingConsumer.h
+  MSDataPipelineConsumer.h
+  MSDataPrecursorCorrectionConsumer.h
   MSDataStoringConsumer.h
   MSDataSqlConsumer.h
   MSDataTransformingConsumer.h
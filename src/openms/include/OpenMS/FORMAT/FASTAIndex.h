@@ -0,0 +1,172 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <OpenMS/DATASTRUCTURES/String.h>
+#include <OpenMS/FORMAT/FASTAFile.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+namespace boost
+{
+  namespace interprocess
+  {
+    class mapped_region;
+  }
+}
+
+namespace OpenMS
+{
+
+  /**
+    @brief Random access to the entries of a memory-mapped FASTA file using a faidx-style index
+
+    The FASTA file is memory-mapped read-only by open(). Every entry is located
+    by one record of the index, which has the same layout as the '.fai' files
+    written by 'samtools faidx' (tab separated: name, number of residues, byte
+    offset of the sequence, residues per line, bytes per line). If an index
+    file (see indexFilename()) exists and is not older than the FASTA file, it
+    is used, otherwise the index is built with a single pass over the mapped
+    data. Use store() to write the index, so subsequent runs skip the scan.
+
+    Entries can then be read in any order (readEntry(), getSequence()), without
+    seeking in a stream. All const members are safe to be called from several
+    threads at the same time.
+
+    Entries are parsed like FASTAFile::readNext() does: the header line up to the
+    first whitespace is the identifier, the rest is the description, and all
+    whitespace is removed from the sequence. A PEFF header (lines starting with
+    '#' at the beginning of the file) is skipped.
+
+    Unlike 'samtools faidx', lines of varying length within an entry are accepted
+    (the line layout of the first line is reported in the index).
+  */
+  class OPENMS_DLLAPI FASTAIndex
+  {
+public:
+    /// One record of the index (one line of a '.fai' file)
+    struct Entry
+    {
+      String name; ///< identifier of the entry (header up to the first whitespace)
+      UInt64 length; ///< number of residues
+      UInt64 offset; ///< byte offset of the first residue (i.e. after the header line)
+      UInt64 line_bases; ///< residues in the first sequence line
+      UInt64 line_width; ///< bytes in the first sequence line, including the line break
+    };
+
+    /// Default constructor (no file opened)
+    FASTAIndex();
+
+    /// Constructor which opens the FASTA file @p fasta_file (see open())
+    explicit FASTAIndex(const String& fasta_file, bool use_index_file = true);
+
+    /// Destructor
+    ~FASTAIndex();
+
+    /**
+      @brief Maps the FASTA file @p fasta_file into memory and indexes its entries
+
+      @param fasta_file The FASTA file
+      @param use_index_file Use an up-to-date index file next to the FASTA file (see indexFilename()) instead of scanning the data
+
+      @exception Exception::FileNotFound is thrown if the file does not exist
+      @exception Exception::ParseError is thrown if the file cannot be mapped or is not a FASTA file
+    */
+    void open(const String& fasta_file, bool use_index_file = true);
+
+    /**
+      @brief Writes the index in the '.fai' format to @p fai_file
+
+      @exception Exception::UnableToCreateFile is thrown if the file cannot be written
+    */
+    void store(const String& fai_file) const;
+
+    /// name of the index file for @p fasta_file (i.e. @p fasta_file + ".fai")
+    static String indexFilename(const String& fasta_file);
+
+    /// name of the opened FASTA file
+    const String& getFileName() const;
+
+    /// number of entries
+    Size size() const;
+
+    /// no entries (or no file opened)?
+    bool empty() const;
+
+    /// index record of entry @p index (must be smaller than size())
+    const Entry& getEntry(Size index) const;
+
+    /// position of the (first) entry with identifier @p name, or -1 (i.e. the largest value of Size) if there is none
+    Size find(const String& name) const;
+
+    /**
+      @brief Reads entry @p index into @p protein
+
+      @return false if @p index is not smaller than size()
+    */
+    bool readEntry(Size index, FASTAFile::FASTAEntry& protein) const;
+
+    /**
+      @brief Retrieves the sequence of the entry with identifier @p name
+
+      The record is found in constant time, the sequence is copied from the mapped file.
+
+      @return false if there is no entry with this identifier
+    */
+    bool getSequence(const String& name, String& sequence) const;
+
+protected:
+    /// index all entries in the mapped data
+    void build_();
+
+    /// load the index from @p fai_file; returns false if it does not fit the mapped data
+    bool load_(const String& fai_file);
+
+    /// copy the residues of entry @p index into @p sequence
+    void readSequence_(Size index, String& sequence) const;
+
+    String filename_; ///< name of the FASTA file
+    boost::shared_ptr<boost::interprocess::mapped_region> mapped_file_; ///< the mapped FASTA file (empty for empty files)
+    const char* data_; ///< start of the mapped data
+    Size data_size_; ///< size of the mapped data
+    std::vector<Entry> entries_; ///< index records in file order
+    std::unordered_map<std::string, Size> name_to_index_; ///< identifier to position of its first occurrence in @p entries_
+  };
+
+} // namespace OpenMS
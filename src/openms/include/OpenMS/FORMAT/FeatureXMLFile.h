@@ -60,6 +60,13 @@ namespace OpenMS
     calling FeatureXMLFile::store().  There will be a message on OPENMS_LOG_INFO but
     we will make no attempt to fix the problem in this class.  (all developers)
 
+    @par Range index
+    If FeatureFileOptions::setWriteRangeIndex() is enabled, store() additionally writes a small text file next to the
+    featureXML file (see getRangeIndexFilename()). It holds the byte offsets of consecutive blocks of features together
+    with their RT, m/z and intensity bounds. Loads restricted to an RT, m/z or intensity range (see FeatureFileOptions)
+    then only read and parse the blocks which can contain matching features. The blocks follow the order of the features
+    in the map, so the index is most effective for maps sorted by RT or m/z. Missing or outdated indices are ignored.
+
     @note This format will eventually be replaced by the HUPO-PSI AnalysisXML
     (mzIdentML and mzQuantML) formats!
 
@@ -94,6 +101,8 @@ public:
     /**
         @brief stores the map @p feature_map in file with name @p filename.
 
+        Also writes the range index if requested in the options (and removes an outdated one otherwise).
+
         @exception Exception::UnableToCreateFile is thrown if the file could not be created
     */
     void store(const String& filename, const FeatureMap& feature_map);
@@ -107,6 +116,9 @@ public:
     /// setter for options for loading/storing
     void setOptions(const FeatureFileOptions&);
 
+    /// Name of the range index of the featureXML file @p filename (see class documentation)
+    static String getRangeIndexFilename(const String& filename);
+
 protected:
 
     // restore default state for next load/store operation
@@ -135,6 +147,15 @@ protected:
     */
     void updateCurrentFeature_(bool create);
 
+    /**
+        @brief Assembles the parts of @p filename needed for a range-restricted load, using the range index
+
+        The result (the file without the feature blocks outside of the ranges of the options) is written to @p buffer.
+
+        @return false if there is no range index or it does not match the file
+    */
+    bool readRangeIndexed_(const String& filename, std::string& buffer) const;
+
     /// allows for early return in parsing functions when certain sections should be ignored
     /// <=0 - parsing ON
     ///  >0 - this number of tags have been entered that forbid parsing and need to be exited before parsing continues
@@ -114,6 +114,7 @@ namespace OpenMS
       JSON,               ///< JavaScript Object Notation file (.json)
       RAW,                ///< Thermo Raw File (.raw)
       EXE,                ///< Executable (.exe)
+      TRBIN,              ///< OpenSWATH binary transition library, see TransitionBinaryFile
       SIZE_OF_TYPE        ///< No file type. Simply stores the number of types
     };
 
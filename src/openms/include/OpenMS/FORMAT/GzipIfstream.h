@@ -35,13 +35,21 @@
 #pragma once
 
 #include <OpenMS/config.h>
+#include <OpenMS/FORMAT/ReadAheadBuffer.h>
 
+#include <cstdio>
 #include <zlib.h>
 
 namespace OpenMS
 {
 /**
     @brief Decompresses files which are compressed in the gzip format (*.gzip)
+
+    Decompression runs on a background thread which stays one chunk ahead of
+    the reader (see ReadAheadBuffer), so parsing and inflating overlap.
+    Files in the blocked gzip format (BGZF, as written by bgzip/htslib)
+    state the size of every block, which is used to inflate several blocks
+    in parallel (OpenMP).
 */
   class OPENMS_DLLAPI GzipIfstream
   {
@@ -117,6 +125,10 @@ protected:
 
     ///a gzFile object(void*) . Necessary for decompression
     gzFile gzfile_;
+    ///the raw file if it is in BGZF format (then gzfile_ is not used)
+    FILE* bgzf_file_;
+    ///decompresses ahead of read() on a separate thread
+    ReadAheadBuffer read_ahead_;
     ///counts the last read duffer
     int n_buffer_;
     ///saves the last returned error by the read function
@@ -136,7 +148,7 @@ protected:
 
   inline bool GzipIfstream::isOpen() const
   {
-    return gzfile_ != nullptr;
+    return gzfile_ != nullptr || bgzf_file_ != nullptr;
   }
 
   inline bool GzipIfstream::streamEnd() const
@@ -183,6 +183,28 @@ public:
       @throws Exception::ParseError is thrown if the chromatogram size cannot be read
     */
     static std::vector<OpenSwath::BinaryDataArrayPtr> readChromatogramFast(std::ifstream& ifs);
+
+    /**
+      @brief Fast access to a spectrum stored in memory (e.g. a memory-mapped cached file)
+
+      @param buffer Pointer to the start of the spectrum
+      @param buffer_size Number of bytes which may be read starting at @p buffer
+      @param ms_level Output parameter to store the MS level of the spectrum (1, 2, 3 ...)
+      @param rt Output parameter to store the retention time of the spectrum
+
+      @throws Exception::ParseError is thrown if the spectrum cannot be read or exceeds the buffer
+    */
+    static std::vector<OpenSwath::BinaryDataArrayPtr> readSpectrumFast(const char* buffer, Size buffer_size, int& ms_level, double& rt);
+
+    /**
+      @brief Fast access to a chromatogram stored in memory (e.g. a memory-mapped cached file)
+
+      @param buffer Pointer to the start of the chromatogram
+      @param buffer_size Number of bytes which may be read starting at @p buffer
+
+      @throws Exception::ParseError is thrown if the chromatogram cannot be read or exceeds the buffer
+    */
+    static std::vector<OpenSwath::BinaryDataArrayPtr> readChromatogramFast(const char* buffer, Size buffer_size);
     //@}
 
     /**
@@ -205,8 +227,36 @@ public:
     */
     static void readChromatogram(ChromatogramType& chromatogram, std::ifstream& ifs);
 
+    /**
+      @brief Read a single spectrum stored in memory directly into an OpenMS MSSpectrum
+
+      @param spectrum Output spectrum
+      @param buffer Pointer to the start of the spectrum
+      @param buffer_size Number of bytes which may be read starting at @p buffer
+
+      @throws Exception::ParseError is thrown if the spectrum cannot be read or exceeds the buffer
+    */
+    static void readSpectrum(SpectrumType& spectrum, const char* buffer, Size buffer_size);
+
+    /**
+      @brief Read a single chromatogram stored in memory directly into an OpenMS MSChromatogram
+
+      @param chromatogram Output chromatogram
+      @param buffer Pointer to the start of the chromatogram
+      @param buffer_size Number of bytes which may be read starting at @p buffer
+
+      @throws Exception::ParseError is thrown if the chromatogram cannot be read or exceeds the buffer
+    */
+    static void readChromatogram(ChromatogramType& chromatogram, const char* buffer, Size buffer_size);
+
 protected:
 
+    /// fill a spectrum from the data arrays read by readSpectrumFast
+    static void fillSpectrum_(SpectrumType& spectrum, const std::vector<OpenSwath::BinaryDataArrayPtr>& data, int ms_level, double rt);
+
+    /// fill a chromatogram from the data arrays read by readChromatogramFast
+    static void fillChromatogram_(ChromatogramType& chromatogram, const std::vector<OpenSwath::BinaryDataArrayPtr>& data);
+
     /// write a single spectrum to filestream
     void writeSpectrum_(const SpectrumType& spectrum, std::ofstream& ofs) const;
 
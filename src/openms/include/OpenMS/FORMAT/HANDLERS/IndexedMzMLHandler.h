@@ -199,6 +199,20 @@ namespace Internal
     */
     void getMSSpectrumById(int id, OpenMS::MSSpectrum& s);
 
+    /**
+      @brief Retrieve the meta data part of the spectrum at position "id" as raw XML
+
+      Only the text of the <spectrum> element up to its
+      <binaryDataArrayList> is read from disk, which is much cheaper than
+      retrieving the full spectrum.
+
+      @throw Exception if getParsingSuccess() returns false
+      @throw Exception if id is not within [0, getNrSpectra()-1]
+
+      @param id The spectrum id
+    */
+    std::string getSpectrumHeaderById(int id);
+
     /**
       @brief Retrieve the raw data for the chromatogram at position "id"
 
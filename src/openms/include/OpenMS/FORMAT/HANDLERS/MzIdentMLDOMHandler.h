@@ -63,6 +63,7 @@
 #include <xercesc/util/XMLUni.hpp>
 #include <xercesc//framework/psvi/XSValue.hpp>
 
+#include <functional>
 #include <string>
 #include <stdexcept>
 #include <vector>
@@ -110,6 +111,23 @@ public:
 
       /// Provides the functionality of reading a mzid with a handler object
       void readMzIdentMLFile(const std::string& mzid_file);
+      /**
+        @brief Reads a mzid file with a SAX parser, without building the DOM tree of the whole file
+
+        The file is parsed element by element: small sections (search setup, inputs, protein detection)
+        are kept as DOM tree, each DBSequence, PeptideEvidence and SpectrumIdentificationResult is parsed
+        as soon as it is complete and released again. Memory thus scales with the reference tables (and the
+        Peptide elements, which are kept until the search setup is known), not with the number of PSMs.
+
+        If @p pep_id_callback is set, the PeptideIdentifications are handed to it in batches of @p batch_size
+        (the last one may be smaller) in file order and are not kept in the handler's pep_id_ output. The ProteinIdentifications
+        (runs) are written to pro_id_ before the first batch is handed out, their protein hits only at the end.
+        Cross-linking results are post-processed over all PeptideIdentifications and only handed out at the end.
+
+        @exception Exception::FileNotFound is thrown if the file does not exist
+        @exception Exception::ParseError is thrown if the file is not well-formed XML
+      */
+      void streamMzIdentMLFile(const std::string& mzid_file, const std::function<void(std::vector<PeptideIdentification>&)>& pep_id_callback = {}, Size batch_size = 10000);
       /// Provides the functionality to write a mzid with a handler object
       void writeMzIdentMLFile(const std::string& mzid_file);
 
@@ -159,6 +177,10 @@ protected:
       void parseProteinAmbiguityGroupElement_(xercesc::DOMElement* proteinAmbiguityGroupElement, ProteinIdentification& protein_identification);
       void parseProteinDetectionListElements_(xercesc::DOMNodeList* proteinDetectionListElements);
       static ProteinIdentification::SearchParameters findSearchParameters_(std::pair<CVTermList, std::map<String, DataValue> > as_params);
+      /// Parses cross-linking detection, AnalysisSoftware, Inputs, SpectrumIdentification and SpectrumIdentificationProtocol elements of @p xmlDoc
+      void parseSearchSetup_(xercesc::DOMDocument* xmlDoc);
+      /// Cross-linking specific post-processing of all read identifications (no-op for other searches)
+      void postProcessXLMS_();
       //@}
 
       /**@name Helper functions to build a DOM tree from the internal id structures*/
@@ -178,6 +200,9 @@ private:
       MzIdentMLDOMHandler(const MzIdentMLDOMHandler& rhs);
       MzIdentMLDOMHandler& operator=(const MzIdentMLDOMHandler& rhs);
 
+      /// SAX content handler building the DOM fragments for streamMzIdentMLFile()
+      class SAXFragmentBuilder_;
+
       ///Struct to hold the used analysis software for that file
       struct AnalysisSoftware
       {
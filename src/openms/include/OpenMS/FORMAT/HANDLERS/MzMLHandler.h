@@ -49,6 +49,8 @@
 #include <OpenMS/FORMAT/ControlledVocabulary.h>
 #include <OpenMS/FORMAT/VALIDATORS/SemanticValidator.h>
 
+#include <atomic>
+
 
 //MISSING:
 // - more than one selected ion per precursor (warning if more than one)
@@ -279,6 +281,14 @@ protected:
       /// Fills the current chromatogram with data points and meta data
       void fillChromatogramData_();
 
+      /**
+          @brief Returns whether the warnings about a faulty array length of another spectrum/chromatogram should be issued
+
+          Only the first few are reported per file (malformed files can have them for every spectrum).
+          Can be called in parallel.
+      */
+      bool reportArrayLengthWarning_();
+
       /// Handles CV terms
       void handleCVParam_(const String& parent_parent_tag,
                           const String& parent_tag,
@@ -309,7 +319,7 @@ protected:
                         const Internal::MzMLValidator& validator);
 
 
-      /// Write out a single spectrum
+      /// Write out a single spectrum (the offset for the index has to be recorded by the caller, see writeSpectra_())
       void writeSpectrum_(std::ostream& os,
                           const SpectrumType& spec,
                           Size spec_idx,
@@ -317,12 +327,41 @@ protected:
                           bool renew_native_ids,
                           std::vector<std::vector< ConstDataProcessingPtr > >& dps);
 
-      /// Write out a single chromatogram
+      /// Write out a single chromatogram (the offset for the index has to be recorded by the caller, see writeChromatograms_())
       void writeChromatogram_(std::ostream& os,
                               const ChromatogramType& chromatogram,
                               Size chrom_idx,
                               const Internal::MzMLValidator& validator);
 
+      /**
+        @brief Write out a batch of consecutive spectra and record their index offsets
+
+        The XML of the spectra (including encoding and compression of the binary data) is generated in parallel
+        into memory buffers, which are then written to @p os in order. Offsets are recorded in spectra_offsets_.
+
+        @param os The output stream
+        @param spectra The spectra to write
+        @param first_idx Index (in the file) of the first spectrum in @p spectra
+        @param validator Validator for the CV terms
+        @param renew_native_ids Use 'spectrum=<index>' as native ID for all spectra
+        @param dps Data processing of the experiment (see writeHeader_())
+      */
+      void writeSpectra_(std::ostream& os,
+                         const std::vector<const SpectrumType*>& spectra,
+                         Size first_idx,
+                         const Internal::MzMLValidator& validator,
+                         bool renew_native_ids,
+                         std::vector<std::vector< ConstDataProcessingPtr > >& dps);
+
+      /// Write out a batch of consecutive chromatograms and record their index offsets (see writeSpectra_())
+      void writeChromatograms_(std::ostream& os,
+                               const std::vector<const ChromatogramType*>& chromatograms,
+                               Size first_idx,
+                               const Internal::MzMLValidator& validator);
+
+      /// Number of spectra or chromatograms to encode in one parallel batch (1 if only a single thread is available)
+      static Size writeBatchSize_();
+
       template <typename ContainerT>
       void writeContainerData_(std::ostream& os, const PeakFileOptions& pf_options_, const ContainerT& container, String array_type);
 
@@ -426,6 +465,8 @@ protected:
       bool skip_chromatogram_{ false };
       /// Remember whether the RT of the spectrum was set or not
       bool rt_set_{ false };
+      /// Number of spectra/chromatograms with a faulty array length (see reportArrayLengthWarning_())
+      std::atomic<Size> array_length_warnings_{ 0 };
       /// Id of the current list. Used for referencing param group, source file, sample, software, ...
       String current_id_;
       /// The referencing param groups: id => array (accession, value)
@@ -438,8 +479,6 @@ protected:
       Map<String, Software> software_;
       /// The data processing list: id => Instrument
       Map<String, Instrument> instruments_;
-      /// CV terms-path-combinations that have been checked in validateCV_()
-      mutable Map<std::pair<String, String>, bool> cached_terms_;
       /// The data processing list: id => Instrument
       Map<String, std::vector< DataProcessingPtr > > processing_;
       /// id of the default data processing (used when no processing is defined)
@@ -506,9 +545,8 @@ protected:
       Int chrom_count_total_{ -1 }; ///< total number of chromatograms in mzML file (according to 'count' attribute)
       //@}
 
-      ///Controlled vocabulary (psi-ms from OpenMS/share/OpenMS/CV/psi-ms.obo)
-      ControlledVocabulary cv_;
-      CVMappings mapping_;
+      ///Controlled vocabulary (psi-ms from OpenMS/share/OpenMS/CV/psi-ms.obo, shared, see ControlledVocabulary::getPSIMSCV())
+      const ControlledVocabulary& cv_;
 
     };
 
@@ -115,6 +115,23 @@ public:
         consumer_ = consumer;
       }
 
+      /**
+        @brief Decodes the peaks of a single scan given as raw XML text
+
+        Used for index based loading: @p scan_xml starts at the opening
+        '<scan>' tag (as referenced by the scan index) and contains at least
+        the '<peaks>' element of this scan. Nested scans may follow, they are
+        ignored. The peaks are appended to @p spectrum, taking the m/z range,
+        intensity range and sorting options into account. If the native id of
+        @p spectrum is set, it has to match the scan number.
+
+        The handler is not modified, so several threads may decode scans
+        concurrently.
+
+        @exception Exception::ParseError is thrown if @p scan_xml does not contain a valid scan
+      */
+      void decodeScanPeaks(const String& scan_xml, SpectrumType& spectrum) const;
+
 protected:
 
       /// Peak type
@@ -184,7 +201,10 @@ protected:
       @note Do not modify any internal state variables of the class since
       this function will be executed in parallel.
       */
-      void doPopulateSpectraWithData_(SpectrumData & spectrum_data);
+      void doPopulateSpectraWithData_(SpectrumData & spectrum_data) const;
+
+      /// Returns the value of attribute @p name in the raw start tag @p tag (or @p default_value if it is not present)
+      static String tagAttribute_(const String& tag, const String& name, const String& default_value);
 
       /**
       @brief Populate all spectra on the stack with data from input
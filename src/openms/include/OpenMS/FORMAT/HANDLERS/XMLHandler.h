@@ -39,6 +39,7 @@
 
 #include <OpenMS/DATASTRUCTURES/ListUtils.h> // StringList
 #include <OpenMS/DATASTRUCTURES/DateTime.h>
+#include <OpenMS/DATASTRUCTURES/NumericCodec.h>
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
 #include <OpenMS/METADATA/MetaInfoInterface.h>
 
@@ -373,6 +374,41 @@ protected:
         return res;
       }
 
+      /// Conversion of a Xerces string to a double value (without transcoding it to a String, if possible)
+      inline double asDouble_(const XMLCh * in)
+      {
+        double res = 0.0;
+        if (xercesToDouble_(in, res)) return res;
+        return asDouble_(sm_.convert(in));
+      }
+
+      /**
+          @brief Conversion of a Xerces string holding a plain (ASCII) number to a double, using NumericCodec
+
+          Nothing is allocated, which matters for the millions of numbers in a large file.
+
+          @return false if @p in is not a number or contains non-ASCII characters (callers then fall back to the String conversion, which reports the error)
+      */
+      static bool xercesToDouble_(const XMLCh * in, double & value)
+      {
+        char buffer[NumericCodec::MAX_LENGTH];
+        Size length = 0;
+        for (; in[length] != 0; ++length)
+        {
+          if (length == NumericCodec::MAX_LENGTH || in[length] > 127) return false;
+          buffer[length] = static_cast<char>(in[length]);
+        }
+        return NumericCodec::parse(buffer, buffer + length, value);
+      }
+
+      /// Conversion of a Xerces string to a double value; throws Exception::ConversionError like String::toDouble()
+      inline double xercesAsDouble_(const XMLCh * in) const
+      {
+        double value = 0.0;
+        if (xercesToDouble_(in, value)) return value;
+        return sm_.convert(in).toDouble();
+      }
+
       /// Conversion of a String to a float value
       inline float asFloat_(const String & in)
       {
@@ -459,7 +495,7 @@ protected:
       {
         const XMLCh * val = a.getValue(sm_.convert(name).c_str());
         if (val == nullptr) fatalError(LOAD, String("Required attribute '") + name + "' not present!");
-        return String(sm_.convert(val)).toDouble();
+        return xercesAsDouble_(val);
       }
 
       /// Converts an attribute to a DoubleList
@@ -541,7 +577,7 @@ protected:
         const XMLCh * val = a.getValue(sm_.convert(name).c_str());
         if (val != nullptr)
         {
-          value = String(sm_.convert(val)).toDouble();
+          value = xercesAsDouble_(val);
           return true;
         }
         return false;
@@ -616,7 +652,7 @@ protected:
       {
         const XMLCh * val = a.getValue(name);
         if (val == nullptr) fatalError(LOAD, String("Required attribute '") + sm_.convert(name) + "' not present!");
-        return sm_.convert(val).toDouble();
+        return xercesAsDouble_(val);
       }
 
       /// Converts an attribute to a DoubleList
@@ -682,7 +718,7 @@ protected:
         const XMLCh * val = a.getValue(name);
         if (val != nullptr)
         {
-          value = sm_.convert(val).toDouble();
+          value = xercesAsDouble_(val);
           return true;
         }
         return false;
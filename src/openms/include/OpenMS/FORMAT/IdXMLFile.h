@@ -39,6 +39,7 @@
 #include <OpenMS/METADATA/PeptideIdentification.h>
 #include <OpenMS/FORMAT/HANDLERS/XMLHandler.h>
 #include <OpenMS/FORMAT/XMLFile.h>
+#include <OpenMS/INTERFACES/IIdentificationConsumer.h>
 
 #include <vector>
 
@@ -69,6 +70,8 @@ public:
     // both ConsensusXMLFile and FeatureXMLFile use some protected IdXML helper functions to parse identifications without code duplication
     friend class ConsensusXMLFile;
     friend class FeatureXMLFile;
+    // the incremental writer reuses the store() helpers
+    friend class IdXMLWritingConsumer;
 
     /// Constructor
     IdXMLFile();
@@ -104,6 +107,22 @@ public:
     */
     void store(const String& filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids, const String& document_id = "");
 
+    /**
+        @brief Streams the identifications of an idXML file into a consumer
+
+        In contrast to load(), the identifications are never held in memory all at once.
+        Each ProteinIdentification is passed to @p consumer as soon as it was read (i.e. before the PeptideIdentifications of its run),
+        PeptideIdentifications are passed in batches of (at most) @p batch_size in file order.
+        The identifiers of the PeptideIdentifications refer to the ProteinIdentification identifiers as they were read,
+        which are assigned in the same way as by load().
+
+        Use IdXMLWritingConsumer as consumer to write the (modified) identifications again.
+
+        @exception Exception::FileNotFound is thrown if the file could not be opened
+        @exception Exception::ParseError is thrown if an error occurs during parsing
+    */
+    void transform(const String& filename, Interfaces::IIdentificationConsumer* consumer, Size batch_size = 10000);
+
 
 protected:
     // Docu in base class
@@ -144,7 +163,36 @@ protected:
       * Helper function to parse fragment annotations from string
       */  
     static void parseFragmentAnnotation_(const String& s, std::vector<PeptideHit::PeakAnnotation> & annotations);
-    
+
+    /// @name helpers for writing (shared by store() and IdXMLWritingConsumer)
+    //@{
+    /// Write the XML declaration and the opening IdXML tag
+    void writeHeader_(std::ostream& os, const String& document_id) const;
+
+    /// Write the SearchParameters elements (referenced as "SP_<index>")
+    void writeSearchParameters_(std::ostream& os, const std::vector<ProteinIdentification::SearchParameters>& params) const;
+
+    /// Write the opening IdentificationRun tag and the ProteinIdentification; protein hits are numbered starting at @p prot_count (updated)
+    void writeRunStart_(std::ostream& os, const ProteinIdentification& protein_id, const std::vector<ProteinIdentification::SearchParameters>& params,
+                        UInt& prot_count, std::unordered_map<std::string, UInt>& accession_to_id);
+
+    /// Write a PeptideIdentification (hits sorted by score) of the run @p run_identifier
+    void writePeptideIdentification_(std::ostream& os, const PeptideIdentification& peptide_id, const std::unordered_map<std::string, UInt>& accession_to_id,
+                                     const String& run_identifier) const;
+
+    /// Write the closing IdXML tag (and an empty run if there was none)
+    void writeFooter_(std::ostream& os, bool no_runs) const;
+    //@}
+
+    /// Reset the members used for loading
+    void resetMembers_();
+
+    /// Pass the last ProteinIdentification to the consumer (if streaming) and keep only its identifier
+    void consumeProteinIdentification_();
+
+    /// Pass the collected PeptideIdentifications to the consumer (if streaming)
+    void flushPeptideIdentifications_();
+
 
     /// @name members for loading data
     //@{
@@ -178,6 +226,10 @@ protected:
     String* document_id_;
     /// true if a prot id is contained in the current run
     bool prot_id_in_run_;
+    /// Consumer for streaming (see transform()); nullptr while loading
+    Interfaces::IIdentificationConsumer* consumer_;
+    /// Number of PeptideIdentifications passed to the consumer at once
+    Size batch_size_;
     //@}
   };
 
@@ -84,6 +84,30 @@ namespace OpenMS
       return exp.openFile(filename);
     }
 
+    /**
+      @brief Load an indexed mzML file completely into memory
+
+      Uses the offsets stored in the index to parse the spectra and
+      chromatograms in parallel: the meta data is read in a single pass that
+      skips all binary data, after which every thread reads and decodes its
+      share of the <spectrum> and <chromatogram> elements (through
+      MzMLSpectrumDecoder) using its own file handle. The resulting @p exp is
+      identical to the one produced by MzMLFile::load.
+
+      Files without a valid index, as well as options that filter the data
+      points themselves (m/z or intensity range) or request meta data only,
+      are handled by the sequential MzMLFile parser.
+
+      @param filename Filename determines where the file is located
+      @param exp Object which will contain the data after the call
+
+      @return Whether the index was used (if false, the file was parsed sequentially)
+
+      @throw Exception::FileNotFound is thrown if the file could not be opened
+      @throw Exception::ParseError is thrown if an error occurs during parsing
+    */
+    bool load(const String& filename, PeakMap& exp);
+
     /**
       @brief Store a file from an on-disc data-structure
 
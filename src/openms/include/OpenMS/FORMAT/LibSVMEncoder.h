@@ -106,6 +106,22 @@ public:
                                                                      const String & allowed_characters,
                                                                      UInt maximum_sequence_length);
 
+    /**
+      @brief encodes composition vectors with additional length information for 'sequences' into one contiguous block of nodes
+
+      Every distinct sequence is encoded only once. 'vectors' contains one LibSVM vector per distinct
+      sequence (in order of first occurrence) and 'sequence_to_vector' the index in 'vectors' for each
+      of the 'sequences'. The vectors point into 'nodes' and stay valid as long as 'nodes' is not modified,
+      they must not be freed. The values are the same as in encodeLibSVMProblemWithCompositionAndLengthVectors().
+      The vectors can be predicted with SVMWrapper::predict(const std::vector<svm_node*>&, std::vector<double>&).
+    */
+    void encodeCompositionAndLengthVectors(const std::vector<String> & sequences,
+                                           const String & allowed_characters,
+                                           UInt maximum_sequence_length,
+                                           std::vector<svm_node> & nodes,
+                                           std::vector<svm_node *> & vectors,
+                                           std::vector<Size> & sequence_to_vector) const;
+
     /**
       @brief creates composition vectors with additional length and average weight information for 'sequences' and stores them in LibSVM compliant format
 
@@ -188,18 +204,27 @@ public:
                                                 const String & allowed_characters = "ACDEFGHIKLMNPQRSTVWY",
                                                 UInt maximum_sequence_length = 50)
     {
-      std::vector<double> predicted_retention_times;
-
+      // each distinct sequence is encoded and predicted only once
       LibSVMEncoder encoder;
-      std::vector<double> temp_rts;
-      temp_rts.resize(sequences.size(), 0);
-      svm_problem * prediction_data =
-          encoder.encodeLibSVMProblemWithCompositionAndLengthVectors(sequences,
-                                                                     temp_rts,
-                                                                     allowed_characters,
-                                                                     maximum_sequence_length);
-      svm.predict(prediction_data, predicted_retention_times);
-      LibSVMEncoder::destroyProblem(prediction_data);
+      std::vector<svm_node> nodes;
+      std::vector<svm_node *> vectors;
+      std::vector<Size> sequence_to_vector;
+      encoder.encodeCompositionAndLengthVectors(sequences,
+                                                allowed_characters,
+                                                maximum_sequence_length,
+                                                nodes,
+                                                vectors,
+                                                sequence_to_vector);
+      std::vector<double> distinct_retention_times;
+      svm.predict(vectors, distinct_retention_times);
+
+      std::vector<double> predicted_retention_times;
+      if (distinct_retention_times.size() != vectors.size()) return predicted_retention_times; // no model
+      predicted_retention_times.reserve(sequences.size());
+      for (Size index : sequence_to_vector)
+      {
+        predicted_retention_times.push_back(distinct_retention_times[index]);
+      }
       return predicted_retention_times;
     }
 
@@ -74,6 +74,8 @@ public:
     /**
         @brief Loads a map from a MSPFile file.
 
+        The header lines are processed sequentially, the peak lines of blocks of spectra are parsed in parallel.
+
         @param exp PeakMap which contains the spectra after reading
         @param filename the filename of the experiment
         @param ids output parameter which contains the peptide identifications from the spectra annotations
@@ -86,6 +86,9 @@ public:
     /**
       @brief Load the file's data and metadata, and save it into an `MSExperiment`.
 
+      The file is read in blocks of records (a record starts at a "Name" line); the records of a
+      block are parsed in parallel and then added to @p library in the order of the file.
+
       @param[in] filename Path to the MSP input file
       @param[out] library The variable into which the extracted information will be saved
 
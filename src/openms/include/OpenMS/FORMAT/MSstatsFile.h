@@ -93,25 +93,43 @@ namespace OpenMS
       static const char quote_ = '"';
 
       /*
-        *  @brief: Struct to aggregate intermediate information from ConsensusFeature and ConsensusMap,
-        *  such as filenames, intensities, retention times, labels and features (for further processing)
+        *  @brief: MSstats columns of one map (column) of the ConsensusMap, resolved once from the experimental design
         */
-      struct AggregatedConsensusInfo
+      struct MSstatsColumn_
       {
-        std::vector< std::vector< String > > consensus_feature_filenames;           //< Filenames of ConsensusFeature
-        std::vector< std::vector< Intensity > > consensus_feature_intensities;       //< Intensities of ConsensusFeature
-        std::vector< std::vector< Coordinate > > consensus_feature_retention_times; //< Retention times of ConsensusFeature
-        std::vector< std::vector< unsigned > > consensus_feature_labels;          //< Labels of ConsensusFeature
-        std::vector<BaseFeature> features;                                        //<s Features of ConsensusMap
+        bool resolved = false;     //< filled yet?
+        Size reference = 0;        //< id of the spectra file name (see storeRecords_)
+        unsigned msstats_run = 0;  //< MSstats run (label-free)
+        unsigned fractiongroup = 0; //< OpenMS fraction group
+        String run;                //< MSstats run as written
+        String condition;
+        String bioreplicate;
+        String mixture;            //< isobaric only
+        String techrepmixture;     //< isobaric only
+        String channel;            //< isobaric only
+        String fraction;
+        Size key = 0;              //< rank of (run, condition, bioreplicate[, mixture]) among all columns
+        Size channel_rank = 0;     //< rank of the channel among all columns (isobaric only)
       };
 
       /*
-        *  @brief: Aggregates information from ConsensusFeature and ConsensusMap,
-        *  such as filenames, intensities, retention times, labels and features.
-        *  Stores them in AggregatedConsensusInfo for later processing
+        *  @brief: One intensity of a quantifiable peptide hit in one map of the ConsensusMap.
+        *
+        *  Strings are stored as ids while collecting and replaced by their ranks before sorting,
+        *  so the records sort (and aggregate) exactly like the MSstats lines they represent.
         */
-      MSstatsFile::AggregatedConsensusInfo aggregateInfo_(const ConsensusMap& consensus_map,
-                                                          const std::vector<String>& spectra_paths);
+      struct MSstatsRecord_
+      {
+        Size sequence;    //< peptide sequence
+        Size accession;   //< protein accession(s)
+        Size key;         //< MSstatsColumn_::key
+        Size charge;      //< precursor charge (as string)
+        Size channel;     //< MSstatsColumn_::channel_rank
+        Intensity intensity;
+        Coordinate retention_time;
+        Size reference;   //< spectra file (isobaric: with native ID)
+        Size column;      //< map index in the ConsensusMap
+      };
 
       /*
         *  @brief: Internal function to check if MSstats_BioReplicate and MSstats_Condition exists in Experimental Design
@@ -287,15 +305,24 @@ namespace OpenMS
       };
 
       /*
-        *  @brief Constructs the lines and adds them to the TextFile
-        *  @param peptideseq_quantifyable Has to be a set (only) for deterministic  ordered output
+        *  @brief Sorts the records in the order of the MSstats lines and writes them to @p filename
+        *
+        *  Records of the same line prefix are aggregated over their retention times (unless @p rt_summarization_manual).
+        *  @p make_prefix creates the line prefix of a record, @p references contains the reference strings by rank.
+        */
+      template <class MakePrefix>
+      void storeRecords_(const String& filename,
+                         const String& header,
+                         const String& retention_time_summarization_method,
+                         const bool rt_summarization_manual,
+                         std::vector<MSstatsRecord_>& records,
+                         const std::vector<String>& references,
+                         MakePrefix make_prefix) const;
+
+      /*
+        *  @brief Computes MSstatsColumn_::key (and MSstatsColumn_::channel_rank if @p isobaric) of the resolved columns
         */
-      template <class LineType>
-      void constructFile_(const String& retention_time_summarization_method,
-                          const bool rt_summarization_manual,
-                          TextFile& csv_out,
-                          const std::set<String>& peptideseq_quantifyable,
-                          LineType & peptideseq_to_prefix_to_intensities) const;
+      static void rankColumns_(std::vector<MSstatsColumn_>& columns, const bool isobaric);
 
       /*
       *  @brief Constructs the accession to indist. group mapping
@@ -41,6 +41,7 @@
 #include <OpenMS/METADATA/ProteinIdentification.h>
 #include <OpenMS/METADATA/PeptideIdentification.h>
 
+#include <functional>
 #include <vector>
 
 namespace OpenMS
@@ -50,7 +51,7 @@ namespace OpenMS
 
       This file adapter exposes the internal MzIdentML processing capabilities to the library. The file
       adapter interface is kept the same as idXML file adapter for downward capability reasons.
-      For now, read-in will be performed with DOM write-out with STREAM
+      Read-in is performed with a SAX parser that builds small DOM fragments (see load()), write-out with STREAM
 
       @note due to the limited capabilities of idXML/PeptideIdentification/ProteinIdentification not all
         MzIdentML features can be supported. Development for these structures will be discontinued, a new
@@ -82,6 +83,21 @@ public:
     */
     void load(const String& filename, std::vector<ProteinIdentification>& poid, std::vector<PeptideIdentification>& peid);
 
+    /**
+        @brief Loads the identifications from a MzIdentML file, handing the peptide identifications out in batches.
+
+        Use this for large files: the PeptideIdentifications are passed to @p pep_id_callback in batches of
+        @p batch_size in file order (the callback may modify or move from them) and are never all held in memory.
+        The identification runs in @p poid are available from the first batch on; their protein hits are only
+        added at the end of the file.
+
+        @note Cross-linking results need to be post-processed as a whole, they are handed out in one batch at the end.
+
+        @exception Exception::FileNotFound is thrown if the file could not be opened
+        @exception Exception::ParseError is thrown if an error occurs during parsing
+    */
+    void load(const String& filename, std::vector<ProteinIdentification>& poid, const std::function<void(std::vector<PeptideIdentification>&)>& pep_id_callback, Size batch_size = 10000);
+
     /**
         @brief Stores the identifications in a MzIdentML file.
 
@@ -0,0 +1,107 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/INTERFACES/IMSDataConsumer.h>
+
+#include <string>
+
+namespace OpenMS
+{
+  /**
+    @brief Reads the spectra of an mzML file while it is still being written (like 'tail -f')
+
+    Each call to poll() reads the bytes appended to the file since the last call and passes
+    all spectra which are complete by now to a consumer. Incomplete spectra at the end of the
+    file are kept and delivered once the rest was written. The mzML header (everything up to
+    &lt;spectrumList&gt;) is kept as well, so each batch of spectra is parsed with full
+    meta data (e.g. referenceable param groups, instrument configurations).
+
+    The file does not need to exist when the follower is created (acquisition may not have started yet).
+    Use it with a timer or a FileWatcher to get updates with bounded latency; isComplete() tells you
+    when the writer has closed the spectrum list.
+
+    Chromatograms are ignored.
+
+    @ingroup FileIO
+  */
+  class OPENMS_DLLAPI MzMLFollower
+  {
+public:
+    /// Constructor for file @p filename (which may not exist yet)
+    explicit MzMLFollower(const String& filename);
+
+    /// Destructor
+    ~MzMLFollower() = default;
+
+    /// Mutable access to the options for loading (e.g. MS level filters)
+    PeakFileOptions& getOptions();
+
+    /**
+      @brief Passes all spectra completed since the last call to @p consumer
+
+      The first batch is preceded by a call to IMSDataConsumer::setExperimentalSettings().
+      IMSDataConsumer::setExpectedSize() is never called, since the final size is unknown.
+
+      @return The number of new spectra (before applying the options)
+
+      @exception Exception::FileNotReadable if the file exists but cannot be read
+      @exception Exception::ParseError if the file got shorter since the last call
+    */
+    Size poll(Interfaces::IMSDataConsumer* consumer);
+
+    /// true, once the closing tag of the spectrum list was read
+    bool isComplete() const;
+
+    /// number of spectra read so far
+    Size getNrSpectra() const;
+
+protected:
+    /// splits off all complete spectra from the front of buffer_; returns them along with the whitespace in-between
+    std::string extractSpectra_(Size& count);
+
+    String filename_;
+    MzMLFile mzml_;
+    std::streamoff offset_ = 0; ///< number of bytes consumed from the file
+    std::string header_;        ///< start of the file up to and including the <spectrumList> start tag
+    std::string footer_;        ///< closing tags to make a valid document from header_ and some spectra
+    std::string buffer_;        ///< read, but not yet parsed data
+    Size nr_spectra_ = 0;
+    bool complete_ = false;
+    bool settings_sent_ = false;
+  };
+
+} // namespace OpenMS
@@ -85,7 +85,8 @@ namespace OpenMS
       const bool export_unidentified_features,
       const bool export_unassigned_ids,
       const bool export_subfeatures,
-      const bool export_empty_pep_ids = false) const;
+      const bool export_empty_pep_ids = false,
+      const String& title = "ConsensusMap export from OpenMS") const;
 
     // Set store behaviour of optional "reliability" and "uri" columns (default=no)
     void storeProteinReliabilityColumn(bool store);
@@ -155,10 +156,9 @@ namespace OpenMS
 
     String generateMzTabSectionRow_(const MzTabOSMSectionRow& row, const std::vector<String>& optional_columns, const MzTabMetaData& meta, size_t& n_columns) const;
 
-    /// Generate an mzTab section comprising multiple rows of the same type and perform sanity check
-    template <typename SectionRow> void generateMzTabSection_(const std::vector<SectionRow>& rows, const std::vector<String>& optional_columns, const MzTabMetaData& meta, StringList& output, size_t n_header_columns) const
+    /// Generate an mzTab section comprising multiple rows of the same type and perform sanity check (@p output needs a push_back(const String&) member, each row is passed on as soon as it is generated)
+    template <typename SectionRow, typename LineSink> void generateMzTabSection_(const std::vector<SectionRow>& rows, const std::vector<String>& optional_columns, const MzTabMetaData& meta, LineSink& output, size_t n_header_columns) const
     {
-      output.reserve(output.size() + rows.size() + 1);
       for (const auto& row : rows)
       {
         size_t n_section_columns = 0;
@@ -75,6 +75,11 @@ public:
 
         @p map has to be a MSExperiment or have the same interface.
 
+        If the file contains a scan index, the meta data is read in a first
+        (sequential) pass while the peak data is then read and decoded in
+        parallel, using the byte offsets of the index. Files without a
+        valid index are parsed sequentially.
+
         @exception Exception::FileNotFound is thrown if the file could not be opened
         @exception Exception::ParseError is thrown if an error occurs during parsing
     */
@@ -130,6 +135,16 @@ protected:
     /// Perform first pass through the file and retrieve the meta-data to initialize the consumer
     void transformFirstPass_(const String& filename_in, Interfaces::IMSDataConsumer * consumer, bool skip_full_count);
 
+    /**
+      @brief Loads @p map using the scan index of the file
+
+      Each thread reads the scans assigned to it through its own file handle
+      and decodes them into the (already allocated) spectra of @p map.
+
+      @return false if the file has no usable index (@p map is not valid then)
+    */
+    bool loadIndexed_(const String& filename, MapType& map);
+
 private:
 
     PeakFileOptions options_;
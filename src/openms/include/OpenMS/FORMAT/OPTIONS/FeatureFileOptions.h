@@ -99,6 +99,16 @@ public:
     ///returns the intensity range
     const DRange<1> & getIntensityRange() const;
 
+    ///@name range index options (see FeatureXMLFile)
+    ///sets whether or not to write a range index next to stored files
+    void setWriteRangeIndex(bool write);
+    ///returns whether or not to write a range index next to stored files
+    bool getWriteRangeIndex() const;
+    ///sets whether or not to use an existing range index for loads restricted to an RT, m/z or intensity range
+    void setUseRangeIndex(bool use);
+    ///returns whether or not to use an existing range index for range-restricted loads
+    bool getUseRangeIndex() const;
+
 private:
     bool loadConvexhull_;
     bool loadSubordinates_;
@@ -107,6 +117,8 @@ private:
     bool has_mz_range_;
     bool has_intensity_range_;
     bool size_only_;
+    bool write_range_index_;
+    bool use_range_index_;
     DRange<1> rt_range_;
     DRange<1> mz_range_;
     DRange<1> intensity_range_;
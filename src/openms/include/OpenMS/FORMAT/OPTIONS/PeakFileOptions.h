@@ -115,6 +115,9 @@ public:
 
         With this option, MS level filters can be set.
 
+        @note MS level and RT filters are evaluated on the spectrum header (for mzML), i.e. the binary data of
+        filtered spectra is neither copied nor decoded. m/z and intensity filters need the decoded peaks.
+
         @note The original spectrum identifiers are stored as the nativeID of the spectrum.
     */
     //@{
@@ -38,10 +38,17 @@
 #include <OpenMS/DATASTRUCTURES/String.h>
 #include <OpenMS/KERNEL/StandardTypes.h>
 
+#include <iosfwd>
 #include <map>
+#include <memory>
+#include <vector>
+
+struct sqlite3_stmt;
 
 namespace OpenMS
 {
+  class SqliteConnector;
+
   /**
     @brief This class serves for reading in and writing OpenSWATH OSW files.
 
@@ -68,16 +75,75 @@ public:
     virtual ~OSWFile();
 
     /**
-      @brief Reads an OSW SQLite file and returns the data on MS1-, MS2- or transition-level
-      as stringstream TXT input for PercolatorAdapter.
+      @brief Writes the MS1-, MS2- or transition-level results of Percolator to an OSW file, one feature at a time
+
+      The score table (score_ms1, score_ms2 or score_transition) is replaced within a single transaction, using one
+      prepared statement for all features, so the scores do not need to be collected beforehand. They become visible
+      in the file with commit(); if the writer is destroyed before, the file is left unchanged.
     */
-    void read(const std::string& in_osw, const std::string& osw_level, std::stringstream& pin_output, const double& ipf_max_peakgroup_pep, const double& ipf_max_transition_isotope_overlap, const double& ipf_min_transition_sn);
+    class OPENMS_DLLAPI ScoreWriter
+    {
+public:
+      /// Starts replacing the scores of level @p osw_level ("ms1", "ms2" or "transition") of file @p in_osw
+      ScoreWriter(const std::string& in_osw, const std::string& osw_level);
+
+      /// Rolls back if commit() was not called
+      ~ScoreWriter();
+
+      ScoreWriter(const ScoreWriter&) = delete;
+      ScoreWriter& operator=(const ScoreWriter&) = delete;
+
+      /**
+        @brief Adds the scores of feature @p id (on transition level: "<feature id>_<transition id>")
+
+        @throw Exception::IllegalArgument if the database rejects the row
+      */
+      void add(const std::string& id, double score, double qvalue, double pep);
+
+      /// Makes the added scores persistent
+      void commit();
+
+private:
+      std::unique_ptr<SqliteConnector> conn_;
+      sqlite3_stmt* stmt_;
+      bool transition_level_;
+      bool committed_;
+    };
+
+    /**
+      @brief Reads an OSW SQLite file and writes the data on MS1-, MS2- or transition-level
+      as TXT input for PercolatorAdapter to @p pin_output.
+
+      The rows are streamed from the database to @p pin_output (e.g. directly into the input file of Percolator),
+      so the generated input is never held in memory as a whole.
+    */
+    void read(const std::string& in_osw, const std::string& osw_level, std::ostream& pin_output, const double& ipf_max_peakgroup_pep, const double& ipf_max_transition_isotope_overlap, const double& ipf_min_transition_sn);
 
     /**
     @brief Updates an OpenSWATH OSW SQLite files with the MS1-, MS2- or transition-level results of Percolator.
+
+    The first three values of each entry are the score, q-value and PEP (see ScoreWriter, which does not need the
+    scores of all features at once).
     */
     void write(const std::string& in_osw, const std::string& osw_level, const std::map< std::string, std::vector<double> >& features);
 
+    /**
+      @brief Merges the OSW files of several shards of the same run into a single OSW file.
+
+      Each input is the output of OpenSwathWorkflow on one shard of the same assay library ('shard_count' /
+      'shard_index'), so all of them contain the same library tables. The feature tables (FEATURE, FEATURE_MS1,
+      FEATURE_MS2, FEATURE_TRANSITION) of all shards are combined and their runs are unified by file name.
+      Scoring (PyProphet, PercolatorAdapter) has to happen after merging.
+
+      Every shard is merged in a single transaction into a temporary copy of the first shard, which only
+      replaces @p out_osw once all shards were merged. If merging fails, @p out_osw is not written.
+
+      @throw Exception::FileNotFound if one of the input files does not exist
+      @throw Exception::IllegalArgument if an input file already contains scores
+      @throw Exception::UnableToCreateFile if @p out_osw cannot be written
+    */
+    void mergeShards(const std::vector<std::string>& in_osw, const std::string& out_osw);
+
   };
 
 } // namespace OpenMS
@@ -0,0 +1,107 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/config.h>
+#include <OpenMS/CONCEPT/Types.h>
+
+#include <functional>
+#include <memory>
+
+namespace OpenMS
+{
+  /**
+    @brief Runs a data source on a background thread and buffers its output ahead of the reader
+
+    The producer is called repeatedly on a separate thread to fill chunks of
+    @p chunk_size bytes, while read() hands out the data of already filled
+    chunks. With the default of two chunks this is classic double buffering:
+    decompression of the next chunk overlaps with the parsing of the current
+    one. Used by GzipIfstream and Bzip2Ifstream.
+
+    The producer returns the number of bytes it wrote into the given buffer;
+    returning 0 signals the end of the data. Exceptions thrown by the
+    producer are passed on to the reader by the read() call that reaches the
+    position of the failure.
+  */
+  class OPENMS_DLLAPI ReadAheadBuffer
+  {
+public:
+    /// fills the given buffer with up to @p size bytes and returns the number of bytes written (0 = end of data)
+    typedef std::function<size_t(char* buffer, size_t size)> Producer;
+
+    /// Constructor
+    explicit ReadAheadBuffer(Size chunk_size = 1 << 20, Size num_chunks = 2);
+
+    /// Destructor (stops the producer thread)
+    ~ReadAheadBuffer();
+
+    /// Starts reading ahead from @p producer (a running producer is stopped first)
+    void start(Producer producer);
+
+    /**
+      @brief Copies the next @p n bytes into @p s, waiting for the producer if required
+
+      @return The number of bytes copied. It is smaller than @p n only if the end of the data was reached.
+
+      @exception Any exception thrown by the producer
+    */
+    size_t read(char* s, size_t n);
+
+    /// true if the producer is finished and all of its data was read
+    bool atEnd() const;
+
+    /// true if start() was called and the buffer was not stopped since
+    bool isRunning() const;
+
+    /// Stops the producer thread (waiting for the chunk in progress) and discards buffered data
+    void stop();
+
+    /// sets the chunk size used by the next call of start()
+    void setChunkSize(Size chunk_size);
+
+    /// returns the chunk size
+    Size getChunkSize() const;
+
+private:
+    struct Impl_;
+    std::unique_ptr<Impl_> impl_;
+
+    /// not implemented
+    ReadAheadBuffer(const ReadAheadBuffer&);
+    ReadAheadBuffer& operator=(const ReadAheadBuffer&);
+  };
+
+} // namespace OpenMS
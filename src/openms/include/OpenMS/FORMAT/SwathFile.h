@@ -106,6 +106,20 @@ public:
     /// Loads a Swath run from a single sqMass file
     std::vector<OpenSwath::SwathMap> loadSqMass(String file, boost::shared_ptr<ExperimentalSettings>& /* exp_meta */);
 
+    /**
+      @brief Whether the meta data of cached files is read back from disk (readoptions "cache")
+
+      By default, the meta data is written to disk after caching and parsed again
+      to create the spectrum access. If set to false, the meta data in memory and
+      the index recorded while writing the cached data are directly handed to a
+      (memory-mapped) SpectrumAccessOpenMSCached. The meta data files are written
+      in both cases.
+    */
+    void setReloadCachedMetaData(bool reload);
+
+    /// Whether the meta data of cached files is read back from disk
+    bool getReloadCachedMetaData() const;
+
 protected:
 
     /// Cache a file to disk
@@ -120,6 +134,9 @@ protected:
                             std::vector<int>& swath_counter, int& nr_ms1_spectra, 
                             std::vector<OpenSwath::SwathMap>& known_window_boundaries);
 
+    /// Whether the meta data of cached files is read back from disk
+    bool reload_cached_meta_data_ = true;
+
   };
 }
 
@@ -73,6 +73,17 @@ public:
       ///return the version of the schema
       const String& getVersion() const;
 
+      /**
+        @brief Initializes the Xerces-C platform once per process
+
+        XMLPlatformUtils::Initialize() and Terminate() keep a plain reference count and are not thread-safe.
+        All OpenMS code that uses Xerces calls this function instead, so that concurrent parsers cannot race.
+        Xerces is not terminated before the program exits.
+
+        @exception xercesc::XMLException is thrown if Xerces cannot be initialized; the next call tries again
+      */
+      static void initializeXerces();
+
 protected:
       /**
         @brief Parses the XML file given by @p filename using the handler given by @p handler.
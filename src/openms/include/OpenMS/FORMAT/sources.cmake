@@ -20,9 +20,11 @@ set(sources_list_h
 AbsoluteQuantitationMethodFile.h
 AbsoluteQuantitationStandardsFile.h
 Base64.h
+BufferedOfstream.h
 Bzip2Ifstream.h
 Bzip2InputStream.h
 CachedMzML.h
+ColumnarFeatureFile.h
 ChromeleonFile.h
 CompressedInputSource.h
 CVMappingFile.h
@@ -34,6 +36,7 @@ DTAFile.h
 EDTAFile.h
 ExperimentalDesignFile.h
 FASTAFile.h
+FASTAIndex.h
 FeatureXMLFile.h
 FileHandler.h
 GzipIfstream.h
@@ -60,6 +63,7 @@ MascotXMLFile.h
 MsInspectFile.h
 MzDataFile.h
 MzMLFile.h
+MzMLFollower.h
 MzTab.h
 MzTabFile.h
 MzXMLFile.h
@@ -76,6 +80,7 @@ PepXMLFileMascot.h
 PercolatorOutfile.h
 ProtXMLFile.h
 QcMLFile.h
+ReadAheadBuffer.h
 SequestInfile.h
 SequestOutfile.h
 SpecArrayFile.h
@@ -0,0 +1,90 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <OpenMS/config.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  class ProteinIdentification;
+  class PeptideIdentification;
+
+namespace Interfaces
+{
+
+    /**
+      @brief The interface of a consumer of protein and peptide identifications
+
+      The counterpart of IMSDataConsumer for identification data: the consumer
+      receives the identifications while they are read (e.g. by
+      IdXMLFile::transform) and can process them without the full set of
+      identifications ever being held in memory.
+
+      A ProteinIdentification is always consumed before the
+      PeptideIdentifications that refer to it (via the identifier).
+      PeptideIdentifications are consumed in batches, in file order.
+
+      Implementations in OpenMS can be found in OpenMS/FORMAT/DATAACCESS
+    */
+    class OPENMS_DLLAPI IIdentificationConsumer
+    {
+    public:
+      virtual ~IIdentificationConsumer() {}
+
+      /**
+        @brief Consume a protein identification (run)
+
+        The protein identification may be modified or moved from.
+
+        @param prot_id The protein identification to be consumed
+      */
+      virtual void consumeProteinIdentification(ProteinIdentification& prot_id) = 0;
+
+      /**
+        @brief Consume a batch of peptide identifications
+
+        The peptide identifications may be modified or moved from; the vector
+        is cleared by the caller afterwards.
+
+        @param pep_ids The peptide identifications to be consumed
+      */
+      virtual void consumePeptideIdentifications(std::vector<PeptideIdentification>& pep_ids) = 0;
+    };
+
+} //end namespace Interfaces
+} //end namespace OpenMS
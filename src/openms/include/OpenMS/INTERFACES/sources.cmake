@@ -4,6 +4,7 @@ set(directory include/OpenMS/INTERFACES)
 ### list all header files of the directory here
 set(sources_list_h
 DataStructures.h
+IIdentificationConsumer.h
 ISpectrumAccess.h
 IMSDataConsumer.h
 )
@@ -211,6 +211,27 @@ public:
     */
     OPENMS_DLLAPI ConsensusMap& appendColumns(const ConsensusMap& rhs);
 
+    /**
+      @brief Adds the entries of several consensus maps as new rows at once, consuming them.
+
+      Same result as calling appendRows(const ConsensusMap&) for each map in @p maps,
+      but consensus elements, identifications and meta data are moved instead of copied,
+      storage is allocated once and the unique id index is rebuilt only once at the end.
+
+      @param maps The consensus maps to be merged (empty afterwards)
+    */
+    OPENMS_DLLAPI ConsensusMap& appendRows(std::vector<ConsensusMap>&& maps);
+
+    /**
+      @brief Adds the entries of several consensus maps as new columns at once, consuming them.
+
+      Same result as calling appendColumns(const ConsensusMap&) for each map in @p maps
+      (see appendRows(std::vector<ConsensusMap>&&) for the differences).
+
+      @param maps The consensus maps to be merged (empty afterwards)
+    */
+    OPENMS_DLLAPI ConsensusMap& appendColumns(std::vector<ConsensusMap>&& maps);
+
 
     /**
       @brief Clears all data and meta data
@@ -193,6 +193,18 @@ public:
     */
     OPENMS_DLLAPI FeatureMap& operator+=(const FeatureMap& rhs);
 
+    /**
+      @brief Appends several feature maps at once, consuming them.
+
+      Same result as calling operator+= for each map in @p maps, but features,
+      identifications and meta data are moved instead of copied, storage is
+      allocated once and the unique id index is rebuilt only once at the end.
+      This makes merging many maps linear in the total number of features.
+
+      @param maps The maps to append (empty afterwards)
+    */
+    OPENMS_DLLAPI FeatureMap& append(std::vector<FeatureMap>&& maps);
+
     /**
       @name Sorting.
       These simplified sorting methods are supported in addition to
@@ -42,6 +42,8 @@
 #include <OpenMS/KERNEL/MSSpectrum.h>
 #include <OpenMS/METADATA/ExperimentalSettings.h>
 
+#include <limits>
+#include <unordered_map>
 #include <vector>
 
 
@@ -398,6 +400,21 @@ public:
     */
     void updateRanges(Int ms_level);
 
+    /**
+      @brief Updates the ranges after only some spectra were changed
+
+      Only the peaks of the spectra in @p changed_spectra are scanned again. For all other spectra and
+      for the chromatograms, their own (cached) ranges are combined, i.e. these need to be up to date
+      (e.g. from a previous call of updateRanges()). The result is the same as updateRanges(ms_level),
+      but no peaks of unchanged spectra are visited.
+
+      @param changed_spectra Indices of the spectra that were changed (or added)
+      @param ms_level MS level to consider for m/z range , RT range and intensity range (All MS levels if negative)
+
+      @exception Exception::IndexOverflow is thrown if an index is out of range
+    */
+    void updateRanges(const std::vector<Size>& changed_spectra, Int ms_level = -1);
+
     /// returns the minimal m/z value
     CoordinateType getMinMZ() const;
 
@@ -425,6 +442,29 @@ public:
 
     ///@}
 
+    ///@name Bulk access to the peaks of all spectra
+    ///@{
+    /**
+      @brief Copies m/z and intensity values of all spectra into contiguous arrays
+
+      The peaks of spectrum @em i are stored at the indices [offsets[i], offsets[i + 1]) of @p mz and @p intensity,
+      i.e. @p offsets has one entry more than there are spectra. Memory of the arrays is re-used.
+      This is considerably faster than accessing the spectra one by one for consumers which work on plain arrays
+      (e.g. NumPy in pyOpenMS).
+    */
+    void getPeakArrays(std::vector<CoordinateType>& mz, std::vector<IntensityType>& intensity, std::vector<Size>& offsets) const;
+
+    /**
+      @brief Replaces the peaks of all spectra by the values of contiguous arrays (the inverse of getPeakArrays())
+
+      Spectrum meta data is kept. Call updateRanges() afterwards if ranges are needed.
+
+      @exception Exception::Precondition is thrown if @p offsets does not have size() + 1 ascending entries starting with 0
+      and ending with the size of @p mz and @p intensity
+    */
+    void setPeakArrays(const std::vector<CoordinateType>& mz, const std::vector<IntensityType>& intensity, const std::vector<Size>& offsets);
+    ///@}
+
     ///@name Sorting spectra and peaks
     ///@{
     /**
@@ -479,6 +519,34 @@ public:
     /// Swaps the content of this map with the content of @p from
     void swap(MSExperiment& from);
 
+    /**
+      @name Lookup indices
+
+      Lookups by native ID or precursor m/z use indices which are built on first use.
+      An index is rebuilt automatically if the spectrum (chromatogram) list changed its size or
+      was reallocated, or if a result does not match the data anymore. After changing native IDs
+      or precursors of existing spectra in place, call clearLookupIndices().
+      The lookups can be called concurrently.
+    */
+    //@{
+    /// Returns the index of the (first) spectrum with native ID @p native_id, or -1 if there is none
+    SignedSize findSpectrumByNativeID(const String& native_id) const;
+
+    /// Returns the index of the (first) chromatogram with native ID @p native_id, or -1 if there is none
+    SignedSize findChromatogramByNativeID(const String& native_id) const;
+
+    /**
+      @brief Returns the indices (in ascending order) of all MSn spectra (MS level > 1) whose first precursor has an m/z in [@p mz_low, @p mz_high] and whose RT is in [@p rt_low, @p rt_high]
+
+      Uses a table of (precursor m/z, RT) sorted by m/z, i.e. a query takes O(log n) plus the number of spectra in the m/z range.
+    */
+    std::vector<Size> findSpectraByPrecursorMZ(double mz_low, double mz_high,
+                                               double rt_low = -std::numeric_limits<double>::max(), double rt_high = std::numeric_limits<double>::max()) const;
+
+    /// Discards all lookup indices (they are rebuilt when needed)
+    void clearLookupIndices();
+    //@}
+
     /// sets the spectrum list
     void setSpectra(const std::vector<MSSpectrum>& spectra);
 
@@ -554,6 +622,9 @@ public:
 
 protected:
 
+    /// Combines the (already updated) ranges of all spectra and chromatograms, see updateRanges(Int)
+    void combineRanges_(Int ms_level);
+
     /// MS levels of the data
     std::vector<UInt> ms_levels_;
     /// Number of all data points
@@ -565,6 +636,32 @@ protected:
     /// spectra
     std::vector<SpectrumType> spectra_;
 
+    /// Identifies the state of a spectrum/chromatogram list a lookup index was built for
+    struct IndexState_
+    {
+      const void* data = nullptr;
+      Size size = 0;
+      bool built = false;
+    };
+
+    /// Entry of the precursor lookup table
+    struct PrecursorEntry_
+    {
+      double mz;
+      double rt;
+      Size index;
+    };
+
+    /// @name Lazily built lookup indices (not copied, see findSpectrumByNativeID())
+    //@{
+    mutable std::unordered_map<String, Size> spectrum_id_index_;
+    mutable IndexState_ spectrum_id_state_;
+    mutable std::unordered_map<String, Size> chromatogram_id_index_;
+    mutable IndexState_ chromatogram_id_state_;
+    mutable std::vector<PrecursorEntry_> precursor_index_; ///< sorted by m/z
+    mutable IndexState_ precursor_state_;
+    //@}
+
 private:
 
     /// Helper class to add either general data points in set2DData or use mass traces from meta values
@@ -0,0 +1,172 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Precomputed RT/m/z tile index for fast area queries on an MSExperiment
+
+    MSExperiment::areaBeginConst() locates the RT range by binary search but
+    then has to skip spectra of other MS levels one by one and run a binary
+    search over the full peak list of every spectrum in range. For many small
+    queries on the same map (e.g. extracting EICs or computing the visible
+    peaks of a 2D view) this becomes the dominating cost.
+
+    This index is built once for all spectra of one MS level. The indexed
+    spectra are grouped into RT blocks of a fixed number of consecutive
+    spectra and the m/z range of the experiment is divided into equally wide
+    bins. For each spectrum, the offset of the first peak in every m/z bin is
+    stored, so an m/z query only searches the peaks of the bins it touches.
+    For each tile (RT block x m/z bin) the number of peaks and the maximum
+    intensity are stored. Queries skip RT blocks without peaks in the
+    requested m/z bins and getMaxIntensity() gives a tile-resolution upper
+    bound of the intensity in an area without touching any peak (useful for
+    level-of-detail decisions).
+
+    The index refers to spectra and peaks by position. After the indexed
+    experiment was modified, build() has to be called again.
+
+    @note The experiment has to be sorted by RT and all spectra by m/z (see MSExperiment::isSorted()).
+
+    @ingroup Kernel
+  */
+  class OPENMS_DLLAPI MSExperimentTileIndex
+  {
+public:
+    /// Coordinate type (RT and m/z)
+    typedef MSExperiment::CoordinateType CoordinateType;
+
+    /// Peaks [begin, end) of the spectrum with index @p spectrum in the experiment
+    struct PeakRange
+    {
+      Size spectrum;
+      Size begin;
+      Size end;
+    };
+
+    /// Default constructor (empty index)
+    MSExperimentTileIndex();
+
+    /// Constructor building the index (see build())
+    MSExperimentTileIndex(const MSExperiment& exp, UInt ms_level = 1, Size spectra_per_block = 16, Size mz_bins = 64);
+
+    /**
+      @brief Builds the index for all spectra of level @p ms_level in @p exp
+
+      @param exp The experiment (sorted by RT and m/z)
+      @param ms_level MS level of the indexed spectra
+      @param spectra_per_block Number of consecutive indexed spectra forming one RT block
+      @param mz_bins Number of m/z bins the m/z range of the indexed spectra is divided into
+
+      @exception Exception::InvalidParameter is thrown if @p spectra_per_block or @p mz_bins is zero
+      @exception Exception::Precondition is thrown if the spectra are not sorted by RT
+    */
+    void build(const MSExperiment& exp, UInt ms_level = 1, Size spectra_per_block = 16, Size mz_bins = 64);
+
+    /// Removes all data from the index
+    void clear();
+
+    /// Returns if no spectrum is indexed
+    bool empty() const;
+
+    /// Returns the number of indexed spectra
+    Size size() const;
+
+    /// Returns the MS level of the indexed spectra
+    UInt getMSLevel() const;
+
+    /// Returns the number of RT blocks
+    Size getNumberOfRTBlocks() const;
+
+    /// Returns the number of m/z bins
+    Size getNumberOfMZBins() const;
+
+    /// Returns the number of peaks in the tile (@p rt_block, @p mz_bin)
+    Size getTilePeakCount(Size rt_block, Size mz_bin) const;
+
+    /// Returns the maximum peak intensity in the tile (@p rt_block, @p mz_bin) (0 for empty tiles)
+    float getTileMaxIntensity(Size rt_block, Size mz_bin) const;
+
+    /**
+      @brief Collects the peaks of the indexed spectra inside an area
+
+      For every indexed spectrum with RT in [@p min_rt, @p max_rt] and at least one peak with
+      m/z in [@p min_mz, @p max_mz], a PeakRange is appended (in RT order), i.e. the result
+      contains the same peaks as MSExperiment::areaBeginConst() for MS level 1.
+
+      @param exp The experiment the index was built for
+      @param ranges The peak ranges (cleared first)
+
+      @note @p exp has to be unchanged since build() was called.
+    */
+    void getPeakRanges(const MSExperiment& exp, CoordinateType min_rt, CoordinateType max_rt, CoordinateType min_mz, CoordinateType max_mz, std::vector<PeakRange>& ranges) const;
+
+    /**
+      @brief Returns an upper bound of the peak intensity in an area (0 if the area contains no peaks)
+
+      The maximum intensity of all tiles overlapping the area is returned, i.e. the
+      result is exact up to the tile resolution. No peak data is accessed.
+    */
+    float getMaxIntensity(CoordinateType min_rt, CoordinateType max_rt, CoordinateType min_mz, CoordinateType max_mz) const;
+
+protected:
+    /// Returns the m/z bin containing @p mz (clamped to the valid bins)
+    Size mzBin_(CoordinateType mz) const;
+
+    /// MS level of the indexed spectra
+    UInt ms_level_;
+    /// Number of indexed spectra in one RT block
+    Size spectra_per_block_;
+    /// Index of the indexed spectra in the experiment
+    std::vector<Size> spectra_;
+    /// RT of the indexed spectra
+    std::vector<CoordinateType> rts_;
+    /// Lower m/z boundary of each bin
+    std::vector<CoordinateType> bin_bounds_;
+    /// Offset of the first peak in each bin, (number of bins + 1) entries per indexed spectrum
+    std::vector<UInt> bin_offsets_;
+    /// Number of peaks per tile (RT block major)
+    std::vector<UInt> tile_peak_count_;
+    /// Maximum intensity per tile (RT block major)
+    std::vector<float> tile_max_intensity_;
+  };
+
+} // namespace OpenMS
+
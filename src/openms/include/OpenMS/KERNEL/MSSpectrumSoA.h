@@ -0,0 +1,185 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/KERNEL/MSSpectrum.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Structure-of-arrays copy of the peaks of an MSSpectrum
+
+    MSSpectrum stores its peaks as an array of Peak1D, i.e. m/z and intensity
+    values are interleaved in memory. Algorithms which only need one of the
+    two (e.g. a binary search on m/z or a scan over intensities) therefore
+    always pull both into the cache. This class holds the m/z and intensity
+    values of a spectrum in two contiguous arrays which can be processed
+    (and auto-vectorized) independently.
+
+    Index @em i of mz() and intensity() refers to the peak at @em spectrum[i]
+    (or @em spectrum.begin() + i), i.e. indices returned by the search
+    functions can be used directly with the existing MSSpectrum iterator
+    API. After the peaks of the spectrum have been changed, call assign()
+    to bring the arrays in sync again. Modified values can be written back
+    into the spectrum using writeTo().
+
+    @note Only the peaks are copied, spectrum meta data and data arrays are not part of this class.
+
+    @ingroup Kernel
+  */
+  class OPENMS_DLLAPI MSSpectrumSoA
+  {
+public:
+    /// Coordinate (m/z) type
+    typedef MSSpectrum::PeakType::CoordinateType CoordinateType;
+    /// Intensity type
+    typedef MSSpectrum::PeakType::IntensityType IntensityType;
+
+    /// Default constructor (no peaks)
+    MSSpectrumSoA() = default;
+
+    /// Constructor copying the peaks of @p spectrum
+    explicit MSSpectrumSoA(const MSSpectrum& spectrum);
+
+    /// Copy constructor
+    MSSpectrumSoA(const MSSpectrumSoA&) = default;
+
+    /// Move constructor
+    MSSpectrumSoA(MSSpectrumSoA&&) = default;
+
+    /// Assignment operator
+    MSSpectrumSoA& operator=(const MSSpectrumSoA&) = default;
+
+    /// Move assignment operator
+    MSSpectrumSoA& operator=(MSSpectrumSoA&&) = default;
+
+    /// Destructor
+    ~MSSpectrumSoA() = default;
+
+    /// (Re-)reads the peaks of @p spectrum (memory is re-used)
+    void assign(const MSSpectrum& spectrum);
+
+    /**
+      @brief Writes m/z and intensity values back into the peaks of @p spectrum
+
+      @exception Exception::Precondition is thrown if @p spectrum has a different number of peaks
+    */
+    void writeTo(MSSpectrum& spectrum) const;
+
+    /// Removes all peaks
+    void clear();
+
+    /// Number of peaks
+    Size size() const
+    {
+      return mz_.size();
+    }
+
+    /// Returns true if there are no peaks
+    bool empty() const
+    {
+      return mz_.empty();
+    }
+
+    /// Contiguous array of m/z values
+    const std::vector<CoordinateType>& mz() const
+    {
+      return mz_;
+    }
+
+    /// Mutable contiguous array of m/z values (the number of entries must not be changed)
+    std::vector<CoordinateType>& mz()
+    {
+      return mz_;
+    }
+
+    /// Contiguous array of intensity values
+    const std::vector<IntensityType>& intensity() const
+    {
+      return intensity_;
+    }
+
+    /// Mutable contiguous array of intensity values (the number of entries must not be changed)
+    std::vector<IntensityType>& intensity()
+    {
+      return intensity_;
+    }
+
+    /**
+      @brief Binary search for the index of the first peak with m/z not smaller than @p mz
+
+      @note The peaks must be sorted by m/z, otherwise the result is undefined.
+    */
+    Size mzBegin(CoordinateType mz) const;
+
+    /**
+      @brief Binary search for the index of the first peak with m/z larger than @p mz (i.e. the past-the-end index of a range)
+
+      @note The peaks must be sorted by m/z, otherwise the result is undefined.
+    */
+    Size mzEnd(CoordinateType mz) const;
+
+    /**
+      @brief Binary search for the peak nearest to a specific m/z
+
+      @note The peaks must be sorted by m/z, otherwise the result is undefined.
+
+      @exception Exception::Precondition is thrown if there are no peaks
+    */
+    Size findNearest(CoordinateType mz) const;
+
+    /**
+      @brief Binary search for the peak nearest to a specific m/z given a +/- tolerance window in Th
+
+      @return Returns the index of the peak or -1 if no peak is present in the tolerance window
+
+      @note The peaks must be sorted by m/z, otherwise the result is undefined.
+      @note Peaks exactly on borders are considered in tolerance window.
+    */
+    Int findNearest(CoordinateType mz, CoordinateType tolerance) const;
+
+    /// Sum of the intensities of the peaks with index in [begin, end)
+    double sumIntensity(Size begin, Size end) const;
+
+protected:
+    /// m/z values
+    std::vector<CoordinateType> mz_;
+    /// intensity values
+    std::vector<IntensityType> intensity_;
+  };
+
+} // namespace OpenMS
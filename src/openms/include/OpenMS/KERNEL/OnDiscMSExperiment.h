@@ -73,6 +73,23 @@ namespace OpenMS
 
 public:
 
+    /**
+      @brief Compact per-spectrum summary, see getSpectrumHeaders()
+
+      Holds what many tools need to select spectra (RT, MS level and the
+      first precursor) without the full SpectrumSettings. The native id is
+      stored in a shared string pool, use getSpectrumNativeID() to access it.
+    */
+    struct SpectrumHeader
+    {
+      double rt; ///< retention time in seconds
+      double precursor_mz; ///< m/z of the first precursor (0 if there is none)
+      Int precursor_charge; ///< charge of the first precursor (0 if unknown)
+      UInt ms_level; ///< MS level
+      UInt64 native_id_offset; ///< position of the native id in the string pool
+      UInt64 native_id_length; ///< length of the native id
+    };
+
     /**
       @brief Constructor
 
@@ -92,6 +109,8 @@ public:
     bool openFile(const String& filename, bool skipMetaData = false)
     {
       filename_ = filename;
+      spectrum_headers_.clear();
+      spectrum_header_ids_.clear();
       indexed_mzml_file_.openFile(filename);
       if (filename != "" && !skipMetaData)
       {
@@ -104,7 +123,9 @@ public:
     OnDiscMSExperiment(const OnDiscMSExperiment& source) :
       filename_(source.filename_),
       indexed_mzml_file_(source.indexed_mzml_file_),
-      meta_ms_experiment_(source.meta_ms_experiment_)
+      meta_ms_experiment_(source.meta_ms_experiment_),
+      spectrum_headers_(source.spectrum_headers_),
+      spectrum_header_ids_(source.spectrum_header_ids_)
     {
     }
 
@@ -178,11 +199,48 @@ public:
       return boost::static_pointer_cast<const ExperimentalSettings>(meta_ms_experiment_);
     }
 
+    /// returns the meta data (null if the file was opened with skipMetaData and loadMetaData() was not called)
     boost::shared_ptr<PeakMap> getMetaData() const
     {
       return meta_ms_experiment_;
     }
 
+    /**
+      @brief Parses the full meta data of the file (if it was skipped in openFile)
+
+      Afterwards, getSpectrum() and getChromatogram() return data with all
+      meta information.
+    */
+    void loadMetaData();
+
+    /**
+      @brief Returns the header table of all spectra
+
+      The table is built on first access and is much cheaper to get than the
+      full meta data. Only the beginning of each <spectrum> element is
+      scanned, the SpectrumSettings are never parsed. The result is cached in
+      a sidecar file (see getSpectrumHeaderFilename()) which is used
+      for later calls as long as it is not older than the mzML file. If the
+      meta data was already loaded, the table is derived from it.
+
+      Spectra whose MS level or RT cannot be read from the header text (e.g.
+      because they are given in a referenceableParamGroup) trigger loading
+      the full meta data.
+
+      @throw Exception::ParseError if the file was not opened successfully
+    */
+    const std::vector<SpectrumHeader>& getSpectrumHeaders();
+
+    /**
+      @brief Returns the native id of the spectrum with index @p id from the header table
+
+      @throw Exception::IndexOverflow if @p id is not a valid spectrum index
+    */
+    String getSpectrumNativeID(Size id);
+
+    /// returns the name of the sidecar file caching the spectrum headers of @p filename
+    static String getSpectrumHeaderFilename(const String& filename);
+
     /// alias for getSpectrum
     inline MSSpectrum operator[](Size n)
     {
@@ -264,6 +322,18 @@ private:
 
     MSSpectrum getMetaSpectrumById_(const std::string& id);
 
+    /// fills the header table from the meta data
+    void buildSpectrumHeadersFromMetaData_();
+
+    /// fills the header table by scanning the beginning of each spectrum, returns false if information is missing
+    bool buildSpectrumHeadersFromFile_();
+
+    /// reads the header table from the sidecar file, returns false if it does not exist or is outdated
+    bool loadSpectrumHeaders_(const String& header_file);
+
+    /// writes the header table to the sidecar file (failures are ignored, the file is only a cache)
+    void storeSpectrumHeaders_(const String& header_file) const;
+
 protected:
 
     /// The filename of the underlying data file
@@ -276,6 +346,10 @@ protected:
     std::unordered_map< std::string, Size > chromatograms_native_ids_;
     /// Mapping of spectra native ids to offsets
     std::unordered_map< std::string, Size > spectra_native_ids_;
+    /// Header table of all spectra (empty until getSpectrumHeaders() is called)
+    std::vector<SpectrumHeader> spectrum_headers_;
+    /// String pool holding the native ids of spectrum_headers_
+    String spectrum_header_ids_;
   };
 
 typedef OpenMS::OnDiscMSExperiment OnDiscPeakMap;
@@ -21,7 +21,9 @@ MRMFeature.h
 MRMTransitionGroup.h
 MSChromatogram.h
 MSExperiment.h
+MSExperimentTileIndex.h
 MSSpectrum.h
+MSSpectrumSoA.h
 OnDiscMSExperiment.h
 Peak1D.h
 Peak2D.h
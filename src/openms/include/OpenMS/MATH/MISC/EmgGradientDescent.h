@@ -373,6 +373,40 @@ private:
       const double tau
     ) const;
 
+    /**
+      @brief Compute the loss function E and its partial derivatives in a single pass
+
+      Gives the same results as Loss_function(), E_wrt_h(), E_wrt_mu(),
+      E_wrt_sigma() and E_wrt_tau(), but evaluates the EMG function only once
+      per point and shares the common terms between the derivatives.
+      Used at every iteration of the gradient descent algorithm.
+
+      @param[in] xs Positions
+      @param[in] ys Intensities
+      @param[in] h Amplitude
+      @param[in] mu Mean
+      @param[in] sigma Standard deviation
+      @param[in] tau Exponent relaxation time
+      @param[out] diff_E_h Partial derivative of E with respect to `h`
+      @param[out] diff_E_mu Partial derivative of E with respect to `mu`
+      @param[out] diff_E_sigma Partial derivative of E with respect to `sigma`
+      @param[out] diff_E_tau Partial derivative of E with respect to `tau`
+
+      @return The computed loss
+    */
+    double Loss_and_gradients(
+      const std::vector<double>& xs,
+      const std::vector<double>& ys,
+      const double h,
+      const double mu,
+      const double sigma,
+      const double tau,
+      double& diff_E_h,
+      double& diff_E_mu,
+      double& diff_E_sigma,
+      double& diff_E_tau
+    ) const;
+
     /**
       @brief Compute EMG's z parameter
 
@@ -457,6 +491,22 @@ public:
       return emg_gd_.Loss_function(xs, ys, h, mu, sigma, tau);
     }
 
+    double Loss_and_gradients(
+      const std::vector<double>& xs,
+      const std::vector<double>& ys,
+      const double h,
+      const double mu,
+      const double sigma,
+      const double tau,
+      double& diff_E_h,
+      double& diff_E_mu,
+      double& diff_E_sigma,
+      double& diff_E_tau
+    ) const
+    {
+      return emg_gd_.Loss_and_gradients(xs, ys, h, mu, sigma, tau, diff_E_h, diff_E_mu, diff_E_sigma, diff_E_tau);
+    }
+
     double computeMuMaxDistance(const std::vector<double>& xs) const
     {
       return emg_gd_.computeMuMaxDistance(xs);
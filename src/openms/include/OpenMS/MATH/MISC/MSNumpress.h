@@ -75,6 +75,12 @@
 #define MS_NUMPRESS_THROW_ON_OVERFLOW true
 #endif
 
+// minimal number of values for which the element-wise Slof kernels are run in
+// parallel (OpenMP only); smaller arrays are not worth the threading overhead
+#ifndef MS_NUMPRESS_PARALLEL_MIN_SIZE
+#define MS_NUMPRESS_PARALLEL_MIN_SIZE 65536
+#endif
+
 namespace ms {
 namespace numpress {
 
@@ -252,6 +252,13 @@ public:
       void tryGnuplot(const String& gp_file);
 
 private:
+      /// computeLLAndIncorrectPosteriorsFromLogDensities() for weighted data points (empty @p weights: every data point has weight one)
+      double computeLLAndIncorrectPosteriors_(
+          const std::vector<double>& incorrect_log_density,
+          const std::vector<double>& correct_log_density,
+          const std::vector<double>& weights,
+          std::vector<double>& incorrect_posterior) const;
+
       /// transform different score types to a range and score orientation that the model can handle (engine string is assumed in upper-case)
       void processOutliers_(std::vector<double>& x_scores, const String& outlier_handling) const;
 
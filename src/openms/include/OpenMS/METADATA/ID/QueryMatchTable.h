@@ -0,0 +1,135 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hendrik Weisser $
+// $Authors: Hendrik Weisser $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <OpenMS/METADATA/ID/IdentificationData.h>
+
+namespace OpenMS
+{
+  /*!
+    @brief Columnar view of the molecule-query matches (e.g. PSMs) in an IdentificationData object
+
+    The matches are stored in node-based containers in IdentificationData, with scores in per-match maps.
+    Algorithms that scan all matches (filtering, FDR) are faster on contiguous arrays.
+    This class assigns a row index to every match (in the order of IdentificationData::getMoleculeQueryMatches(), i.e. grouped by data query) and provides:
+    - integer-coded references to data queries and identified molecules,
+    - one contiguous score vector per score type (see addScoreColumn()).
+
+    The table does not update itself. It stays valid while scores are added (IdentificationData::addScore), but not after matches are removed or registered.
+  */
+  class OPENMS_DLLAPI QueryMatchTable
+  {
+  public:
+
+    /// Build the table (match references and integer-coded queries/molecules)
+    explicit QueryMatchTable(const IdentificationData& id_data);
+
+    /// Number of rows (matches)
+    Size size() const
+    {
+      return match_refs_.size();
+    }
+
+    /// Match reference for each row
+    const std::vector<IdentificationData::QueryMatchRef>& getMatchRefs() const
+    {
+      return match_refs_;
+    }
+
+    /// Index into getQueries() for each row (rows of the same query are consecutive)
+    const std::vector<Size>& getQueryIndices() const
+    {
+      return query_indices_;
+    }
+
+    /// Distinct data queries
+    const std::vector<IdentificationData::DataQueryRef>& getQueries() const
+    {
+      return queries_;
+    }
+
+    /// Index into getMolecules() for each row
+    const std::vector<Size>& getMoleculeIndices() const
+    {
+      return molecule_indices_;
+    }
+
+    /// Distinct identified molecules
+    const std::vector<IdentificationData::IdentifiedMoleculeRef>& getMolecules() const
+    {
+      return molecules_;
+    }
+
+    /*!
+      @brief Extract the scores of type @p score_ref into a column (if not done before)
+
+      Scores are looked up as in ScoredProcessingResult::getScore(ScoreTypeRef), i.e. the most recent processing step wins.
+
+      @return The score per row (NaN for matches without such a score)
+    */
+    const std::vector<double>& addScoreColumn(IdentificationData::ScoreTypeRef score_ref);
+
+    /*!
+      @brief Return a column added with addScoreColumn()
+
+      @throw Exception::ElementNotFound if the column was not added
+    */
+    const std::vector<double>& getScoreColumn(IdentificationData::ScoreTypeRef score_ref) const;
+
+    /*!
+      @brief Return the row of the best match for each data query (see IdentificationData::getBestMatchPerQuery())
+
+      Queries without any score of type @p score_ref are skipped.
+
+      @throw Exception::ElementNotFound if the score column was not added
+    */
+    std::vector<Size> getBestMatchPerQuery(IdentificationData::ScoreTypeRef score_ref) const;
+
+  protected:
+
+    std::vector<IdentificationData::QueryMatchRef> match_refs_;
+
+    std::vector<Size> query_indices_;
+
+    std::vector<IdentificationData::DataQueryRef> queries_;
+
+    std::vector<Size> molecule_indices_;
+
+    std::vector<IdentificationData::IdentifiedMoleculeRef> molecules_;
+
+    std::map<IdentificationData::ScoreTypeRef, std::vector<double>> score_columns_;
+  };
+}
@@ -18,6 +18,7 @@ MoleculeQueryMatch.h
 ParentMolecule.h
 ParentMoleculeGroup.h
 QueryMatchGroup.h
+QueryMatchTable.h
 ScoreType.h
 ScoredProcessingResult.h
 )
@@ -40,7 +40,7 @@
 #include <OpenMS/METADATA/MetaInfoRegistry.h>
 #include <OpenMS/DATASTRUCTURES/DataValue.h>
 
-#include <boost/container/flat_map.hpp>
+#include <boost/container/small_vector.hpp>
 
 namespace OpenMS
 {
@@ -63,6 +63,12 @@ namespace OpenMS
       member. MetaInfoInterface implements a full interface to a MetaInfo
       member and is more memory efficient if no meta info gets added.
 
+      The values are kept in a vector sorted by index. The first few values
+      are stored inside the MetaInfo object itself, so objects with only a
+      handful of meta values (the common case for features and peptide hits)
+      need no separate allocation for them, which also makes copying them
+      cheap.
+
       @ingroup Metadata
   */
   class OPENMS_DLLAPI MetaInfo
@@ -126,12 +132,23 @@ public:
     void clear();
 
 private:
-    using MapType = boost::container::flat_map<UInt, DataValue>;
+    /// Number of values stored without a separate allocation
+    static constexpr Size INLINE_VALUES = 4;
+
+    using MapType = boost::container::small_vector<std::pair<UInt, DataValue>, INLINE_VALUES>;
+
+    /// Returns the position of @p index (or the position where it would have to be inserted)
+    MapType::const_iterator lowerBound_(UInt index) const;
+    /// Returns the position of @p index (or the position where it would have to be inserted)
+    MapType::iterator lowerBound_(UInt index);
+
+    /// Returns the position of @p index or end() if there is no value for it
+    MapType::const_iterator find_(UInt index) const;
 
     /// Static MetaInfoRegistry
     static MetaInfoRegistry registry_;
 
-    /// The actual mapping of indexes to values
+    /// The actual mapping of indexes to values (sorted by index)
     MapType index_to_value_;
   };
 
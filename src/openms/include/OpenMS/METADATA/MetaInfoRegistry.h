@@ -34,15 +34,16 @@
 
 #pragma once
 
-#include <map>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include <OpenMS/CONCEPT/Exception.h>
 #include <OpenMS/CONCEPT/Types.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
 
-#include <unordered_map>
-
 #ifdef OPENMS_COMPILER_MSVC
 #pragma warning( push )
 #pragma warning( disable : 4251 )     // disable MSVC dll-interface warning
@@ -70,11 +71,42 @@ namespace OpenMS
       12 - low_quality<BR>
       13 - charge<BR>
 
+      The reserved indices are also available as ReservedIndex constants, which
+      can be passed to the index versions of the meta value accessors (e.g.
+      MetaInfoInterface::setMetaValue(UInt, const DataValue&)) to skip the name
+      lookup. For other names that are used in hot loops, resolve the index
+      once with registerName() before the loop; indices never change.
+
+      Looking up indices (getIndex()) and names (getName()) and registering an
+      already known name never block: names are kept in an append-only table
+      and found through a hash table which is republished atomically when it
+      grows. Only registering new names and access to descriptions and units
+      are serialized by a mutex. Assignment must not run concurrently with
+      other accesses to the same registry.
+
       @ingroup Metadata
   */
   class OPENMS_DLLAPI MetaInfoRegistry
   {
 public:
+    /// Fixed indices of the reserved names
+    enum ReservedIndex : UInt
+    {
+      ISOTOPIC_RANGE = 1,
+      CLUSTER_ID = 2,
+      LABEL = 3,
+      ICON = 4,
+      COLOR = 5,
+      RT = 6,
+      MZ = 7,
+      PREDICTED_RT = 8,
+      PREDICTED_RT_P_VALUE = 9,
+      SPECTRUM_REFERENCE = 10,
+      ID = 11,
+      LOW_QUALITY = 12,
+      CHARGE = 13
+    };
+
     /// Default constructor
     MetaInfoRegistry();
 
@@ -161,19 +193,37 @@ public:
     String getUnit(const String& name) const;
 
 private:
+    /// A registered name with its index, description and unit
+    struct Entry;
+    /// Fixed-size array of atomic entry pointers
+    struct Table;
+
+    /// Registers @p name under @p index (the mutex has to be held)
+    void insert_(const String& name, UInt index, const String& description, const String& unit);
+
+    /// Returns the entry for @p name or nullptr (lock-free)
+    const Entry* findName_(const String& name) const;
+
+    /// Returns the entry for @p index or nullptr (lock-free)
+    const Entry* findIndex_(UInt index) const;
+
+    /// Returns the entry for @p index, throws Exception::InvalidValue for unregistered indices
+    const Entry& getEntry_(UInt index) const;
+
+    /// Serializes registration of new names and access to descriptions and units
+    mutable std::mutex mutex_;
     /// internal counter, that stores the next index to assign
     UInt next_index_;
-    using MapString2IndexType = std::unordered_map<std::string, UInt>;
-    using MapIndex2StringType = std::unordered_map<UInt, std::string>;
-    
-    /// map from name to index
-    MapString2IndexType name_to_index_;
-    /// map from index to name
-    MapIndex2StringType index_to_name_;
-    /// map from index to description
-    MapIndex2StringType index_to_description_;
-    /// map from index to unit
-    MapIndex2StringType index_to_unit_;
+    /// number of registered names
+    Size size_;
+    /// all registered names (addresses are stable)
+    std::vector<std::unique_ptr<Entry> > entries_;
+    /// all tables ever published (replaced tables are kept, readers may still use them)
+    std::vector<std::unique_ptr<Table> > tables_;
+    /// hash table (open addressing) from name to entry
+    std::atomic<const Table*> name_table_;
+    /// table from index to entry
+    std::atomic<const Table*> index_table_;
   };
 
 } // namespace OpenMS
@@ -35,6 +35,7 @@
 #pragma once
 
 #include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/DATASTRUCTURES/InternedString.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
 
 namespace OpenMS
@@ -96,6 +97,12 @@ public:
     /// get the protein accession the peptide matches to. If not available the empty string is returned.
     const String& getProteinAccession() const;
 
+    /// get the protein accession as interned string (for O(1) comparison and hashing)
+    const InternedString& getInternedProteinAccession() const
+    {
+      return accession_;
+    }
+
     /// set the protein accession the peptide matches to. If not available set to empty string.
     void setProteinAccession(const String& s);
 
@@ -124,7 +131,7 @@ public:
     char getAAAfter() const;
 
 protected:
-    String accession_;
+    InternedString accession_; ///< shared by all evidences of the same protein
 
     Int start_;
 
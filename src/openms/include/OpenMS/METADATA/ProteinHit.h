@@ -42,6 +42,7 @@
 
 #include <OpenMS/CHEMISTRY/ResidueModification.h>
 #include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/DATASTRUCTURES/InternedString.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
 #include <OpenMS/METADATA/MetaInfoInterface.h>
 
@@ -63,13 +64,13 @@ public:
 
     /// @name Hashes for ProteinHit
     //@{
-    /// Hash of a ProteinHit based on its accession only!
+    /// Hash of a ProteinHit based on its accession only! (O(1), accessions are interned)
     class OPENMS_DLLAPI ProteinHitAccessionHash
     {
     public:
       size_t operator()(const ProteinHit & p)
       {
-        return std::hash<std::string>{}(p.getAccession());
+        return p.accession_.hash();
       }
 
     };
@@ -78,7 +79,7 @@ public:
     public:
       size_t operator()(const ProteinHit * p)
       {
-        return std::hash<std::string>{}(p->getAccession());
+        return p->accession_.hash();
       }
 
     };
@@ -172,6 +173,12 @@ public:
 
     /// returns the accession of the protein
     const String & getAccession() const;
+
+    /// returns the accession of the protein as interned string (for O(1) comparison and hashing)
+    const InternedString & getInternedAccession() const
+    {
+      return accession_;
+    }
     
     /// returns the description of the protein
     String getDescription() const;
@@ -207,7 +214,7 @@ public:
 protected:
     double score_;       ///< the score of the protein hit
     UInt rank_;          ///< the position(rank) where the hit appeared in the hit list
-    String accession_;   ///< the protein identifier
+    InternedString accession_;   ///< the protein identifier
     String sequence_;    ///< the amino acid sequence of the protein hit
     double coverage_;    ///< coverage of the protein based upon the matched peptide sequences
     std::set<std::pair<Size, ResidueModification> > modifications_; ///< modified positions in a protein
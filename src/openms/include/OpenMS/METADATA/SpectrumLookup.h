@@ -39,6 +39,8 @@
 
 #include <boost/regex.hpp>
 
+#include <unordered_map>
+
 namespace OpenMS
 {
   /**
@@ -115,7 +117,7 @@ namespace OpenMS
         Int scan_no = -1;
         if (!scan_regexp.empty())
         {
-          scan_no = extractScanNumber(native_id, scan_regexp_, true);
+          scan_no = extractScanNumber_(native_id);
           if (scan_no < 0)
           {
             OPENMS_LOG_WARN << "Warning: Could not extract scan number from spectrum native ID '" + native_id + "' using regular expression '" + scan_regexp + "'. Look-up by scan number may not work properly." << std::endl;
@@ -183,6 +185,8 @@ namespace OpenMS
        @return Index of the spectrum that matched
 
        The regular expressions in SpectrumLookup::reference_formats are matched against the spectrum reference in order. The first one that matches is used to look up the spectrum.
+
+       Simple formats consisting of a literal text followed by a number (e.g. "scan=(?<SCAN>\\d+)", optionally followed by "$") that were registered via addReferenceFormat() are matched without evaluating the regular expression.
     */
     Size findByReference(const String& spectrum_ref) const;
 
@@ -227,8 +231,52 @@ namespace OpenMS
     std::vector<String> regexp_name_list_; ///< Named groups in vector format
 
     std::map<double, Size> rts_; ///< Mapping: RT -> spectrum index
-    std::map<String, Size> ids_; ///< Mapping: native ID -> spectrum index
-    std::map<Size, Size> scans_; ///< Mapping: scan number -> spectrum index
+    std::unordered_map<String, Size> ids_; ///< Mapping: native ID -> spectrum index
+    std::unordered_map<Size, Size> scans_; ///< Mapping: scan number -> spectrum index
+
+    /// Format of the form "<literal>(?<GROUP>\d+)" (optionally followed by "$"), which can be matched without a regular expression
+    struct SimpleFormat_
+    {
+      bool valid = false; ///< Can the regular expression be matched this way?
+      String literal; ///< Literal text preceding the number
+      String group; ///< Name of the group
+      bool anchored = false; ///< Does the number have to be at the end?
+    };
+
+    std::vector<SimpleFormat_> simple_formats_; ///< Simple versions of the reference formats (if added via addReferenceFormat())
+
+    SimpleFormat_ simple_scan_format_; ///< Simple version of the regular expression to extract scan numbers
+
+    /**
+       @brief Check whether a regular expression has the form of a SimpleFormat_ (with a group usable for look-ups)
+
+       @return The simple format (not valid if the regular expression is more complex)
+    */
+    static SimpleFormat_ parseSimpleFormat_(const String& regexp);
+
+    /**
+       @brief Match a simple format against a string (like boost::regex_search would)
+
+       @param format Format to match
+       @param input String to search
+       @param last_match Use the last of all (non-overlapping) matches instead of the first one
+       @param value The matched number
+
+       @return 1 if the format matched, 0 if not, -1 if the regular expression needs to be used (line breaks in @p input)
+    */
+    static int matchSimpleFormat_(const SimpleFormat_& format, const String& input, bool last_match, String& value);
+
+    /// Extract the scan number from a native ID using the current scan regular expression (-1 on failure)
+    Int extractScanNumber_(const String& native_id) const;
+
+    /**
+       @brief Look up spectrum by the value of a named group from a spectrum reference
+
+       @throw Exception::ElementNotFound if no matching spectrum was found
+
+       @return Index of the spectrum that matched
+    */
+    Size findByGroupValue_(const String& group, const String& value) const;
 
     /**
        @brief Add a look-up entry for a spectrum
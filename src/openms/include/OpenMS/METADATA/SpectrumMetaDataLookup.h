@@ -222,11 +222,20 @@ namespace OpenMS
       setScanRegExp_(scan_regexp);
       // mapping: MS level -> RT of previous spectrum of that level
       std::map<Size, double> precursor_rts;
+      const boost::regex no_scan_regexp; // scan numbers are extracted below
       for (Size i = 0; i < n_spectra_; ++i)
       {
         const MSSpectrum& spectrum = spectra[i];
         SpectrumMetaData meta;
-        getSpectrumMetaData(spectrum, meta, scan_regexp_, precursor_rts);
+        getSpectrumMetaData(spectrum, meta, no_scan_regexp, precursor_rts);
+        if (!scan_regexp.empty())
+        {
+          meta.scan_number = extractScanNumber_(meta.native_id);
+          if (meta.scan_number < 0)
+          {
+            OPENMS_LOG_ERROR << "Error: Could not extract scan number from spectrum native ID '" + meta.native_id + "' using regular expression '" + scan_regexp + "'." << std::endl;
+          }
+        }
         if (get_precursor_rt) precursor_rts[meta.ms_level] = meta.rt;
         addEntry_(i, meta.rt, meta.scan_number, meta.native_id);
         metadata_.push_back(meta);
@@ -58,6 +58,12 @@ namespace OpenMS
       The precursor spectrum is the first spectrum before this spectrum, that has a lower MS-level than
       the current spectrum.
 
+      The instrument settings, acquisition info and source file are usually identical for
+      many spectra and rarely changed after loading. They are therefore shared between copies
+      (copy-on-write): copying a spectrum only copies pointers to them and the mutable
+      accessors (getInstrumentSettings(), getAcquisitionInfo(), getSourceFile()) create a
+      private copy before the first modification. Prefer the const accessors for read access.
+
       @ingroup Metadata
   */
   class OPENMS_DLLAPI SpectrumSettings :
@@ -81,15 +87,15 @@ public:
     SpectrumSettings();
     /// Copy constructor
     SpectrumSettings(const SpectrumSettings &) = default;
-    /// Move constructor
-    SpectrumSettings(SpectrumSettings&&) = default;
+    /// Move constructor (shared settings stay valid in @p rhs)
+    SpectrumSettings(SpectrumSettings&& rhs) noexcept;
     /// Destructor
     ~SpectrumSettings();
 
     // Assignment operator
     SpectrumSettings & operator=(const SpectrumSettings &) = default;
-    /// Move assignment operator
-    SpectrumSettings& operator=(SpectrumSettings&&) & = default;
+    /// Move assignment operator (shared settings stay valid in @p rhs)
+    SpectrumSettings& operator=(SpectrumSettings&& rhs) & noexcept;
 
     /// Equality operator
     bool operator==(const SpectrumSettings & rhs) const;
@@ -116,21 +122,21 @@ public:
 
     /// returns a const reference to the instrument settings of the current spectrum
     const InstrumentSettings & getInstrumentSettings() const;
-    /// returns a mutable reference to the instrument settings of the current spectrum
+    /// returns a mutable reference to the instrument settings of the current spectrum (detaches shared settings)
     InstrumentSettings & getInstrumentSettings();
     /// sets the instrument settings of the current spectrum
     void setInstrumentSettings(const InstrumentSettings & instrument_settings);
 
     /// returns a const reference to the acquisition info
     const AcquisitionInfo & getAcquisitionInfo() const;
-    /// returns a mutable reference to the acquisition info
+    /// returns a mutable reference to the acquisition info (detaches shared settings)
     AcquisitionInfo & getAcquisitionInfo();
     /// sets the acquisition info
     void setAcquisitionInfo(const AcquisitionInfo & acquisition_info);
 
     /// returns a const reference to the source file
     const SourceFile & getSourceFile() const;
-    /// returns a mutable reference to the source file
+    /// returns a mutable reference to the source file (detaches shared settings)
     SourceFile & getSourceFile();
     /// sets the source file
     void setSourceFile(const SourceFile & source_file);
@@ -170,9 +176,9 @@ protected:
     SpectrumType type_;
     String native_id_;
     String comment_;
-    InstrumentSettings instrument_settings_;
-    SourceFile source_file_;
-    AcquisitionInfo acquisition_info_;
+    boost::shared_ptr<InstrumentSettings> instrument_settings_; ///< shared, see class documentation
+    boost::shared_ptr<SourceFile> source_file_; ///< shared, see class documentation
+    boost::shared_ptr<AcquisitionInfo> acquisition_info_; ///< shared, see class documentation
     std::vector<Precursor> precursors_;
     std::vector<Product> products_;
     std::vector<PeptideIdentification> identification_;
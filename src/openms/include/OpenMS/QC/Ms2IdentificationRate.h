@@ -69,6 +69,9 @@ namespace OpenMS
     /// container that stores results
     std::vector<IdentificationRateData> rate_result_;
 
+    /// counts the identifications in @p feature_map and stores the result for @p ms2_level_counter MS2 spectra
+    void compute_(const FeatureMap& feature_map, UInt64 ms2_level_counter, bool force_fdr);
+
   public:
     /// Default constructor
     Ms2IdentificationRate() = default;
@@ -92,6 +95,17 @@ namespace OpenMS
      */
     void compute(const FeatureMap& feature_map, const MSExperiment& exp, bool force_fdr = false);
 
+    /**
+     * @brief Same as above, but counts the MS2 spectra from a (precomputed) spectra summary
+     *
+     * @param feature_map Input FeatureMap with target/decoy annotation
+     * @param summary Summary of the MSExperiment for counting number of MS2 spectra
+     * @param force_fdr Count all(!) PepIDs towards number of identified MS2 spectra (ignore target/decoy information if any)
+     * @exception Exception::MissingInformation is thrown if the summary is empty or contains no MS2 spectra
+     * @exception Exception::Precondition is thrown if there are more identifications than MS2 spectra
+     */
+    void compute(const FeatureMap& feature_map, const QCBase::SpectraSummary& summary, bool force_fdr = false);
+
     /// returns the name of the metric
     const String& getName() const override;
     
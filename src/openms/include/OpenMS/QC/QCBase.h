@@ -39,10 +39,13 @@
 
 #include <ostream>
 #include <map>
+#include <vector>
 
 namespace OpenMS
 {
   class MSExperiment;
+  class MSSpectrum;
+  class MSChromatogram;
   class ConsensusMap;
 
   /**
@@ -106,6 +109,66 @@ namespace OpenMS
       std::map<String, UInt64> nativeid_to_index_; //< nativeID to index
     };
 
+    /**
+     * @brief Per-spectrum values (MS level, RT, TIC, base peak intensity) shared by several metrics
+
+     Metrics like TIC or Ms2IdentificationRate only need a few numbers per spectrum. Gathering them
+     once (in a single, parallel pass over all peaks) avoids that every metric walks the whole
+     MSExperiment again. Spectra can also be added one by one, e.g. from an IMSDataConsumer while
+     streaming an mzML file, so the peaks do not need to be kept in memory.
+    */
+    class OPENMS_DLLAPI SpectraSummary
+    {
+    public:
+      /// values of a single spectrum
+      struct Entry
+      {
+        double rt = 0.;
+        UInt ms_level = 0;
+        double tic = 0.;          //< sum of all intensities
+        double base_peak_intensity = 0.; //< highest intensity (0 for empty spectra)
+      };
+
+      /// Constructor
+      SpectraSummary() = default;
+
+      /// CTor which allows immediate summarizing of an MSExperiment
+      explicit SpectraSummary(const MSExperiment& exp);
+
+      /// Destructor
+      ~SpectraSummary() = default;
+
+      /// summarize all spectra of @p exp, delete the old summary
+      void calculate(const MSExperiment& exp);
+
+      /// append the values of @p spec (in order of acquisition, i.e. the index of the entry equals the spectrum index)
+      void addSpectrum(const MSSpectrum& spec);
+
+      /// entries in order of the spectra
+      const std::vector<Entry>& getEntries() const;
+
+      /// number of spectra with MS level @p ms_level
+      Size getNrSpectra(UInt ms_level) const;
+
+      /// the TIC of all MS1 spectra, identical to MSExperiment::getTIC()
+      MSChromatogram getTIC(float rt_bin_size = 0) const;
+
+      /// clear the summary
+      void clear();
+
+      /// check if empty
+      bool empty() const;
+
+      /// number of summarized spectra
+      Size size() const;
+
+    private:
+      /// values of @p spec
+      static Entry summarize_(const MSSpectrum& spec);
+
+      std::vector<Entry> entries_; //< one entry per spectrum
+    };
+
 
     /**
      @brief Storing a status of available/needed inputs (i.e. a set of Requires) as UInt64
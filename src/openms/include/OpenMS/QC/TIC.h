@@ -73,6 +73,14 @@ namespace OpenMS
     **/
     void compute(const MSExperiment &exp, float bin_size=0);
 
+    /**
+    @brief Same as above, but computed from a (precomputed) spectra summary, i.e. without iterating all peaks again
+
+    @param summary Summary of the peak map to compute the MS1 tick from
+    @param bin_size RT bin size in seconds
+    **/
+    void compute(const QCBase::SpectraSummary& summary, float bin_size=0);
+
     const String& getName() const override;
 
     const std::vector<MSChromatogram>& getResults() const ;
@@ -113,14 +113,31 @@ protected:
      */
     void add1DSignal_(Feature& feature, SimTypes::MSSimExperiment& experiment, SimTypes::MSSimExperiment& experiment_ct);
 
+    /// Raw and centroided (ground truth) signal of a single feature in consecutive scans (the first one being @p first_scan)
+    struct FeatureSignal_
+    {
+      Size first_scan = 0;
+      std::vector<std::vector<SimTypes::SimPointType> > raw;
+      std::vector<std::vector<SimTypes::SimPointType> > centroided;
+    };
+
     /**
-     @brief Add a 2D signal for a single feature
+     @brief Sample a 2D signal for a single feature
+
+     Does not modify @p experiment, so several features can be sampled in parallel. Use addSignals_() to add the result.
 
      @param feature The feature which should be simulated
-     @param experiment The experiment to which the simulated signals should be added
-     @param experiment_ct Ground truth for picked peaks
+     @param experiment The experiment providing the scans (RT, distortion)
+     @param signal The sampled signals
+     @param rng Random number generator (for m/z and intensity errors) used for this feature
      */
-    void add2DSignal_(Feature& feature, SimTypes::MSSimExperiment& experiment, SimTypes::MSSimExperiment& experiment_ct);
+    void add2DSignal_(Feature& feature, const SimTypes::MSSimExperiment& experiment, FeatureSignal_& signal, boost::random::mt19937_64& rng);
+
+    /// Append the sampled @p signals (in their order) to the scans of @p experiment and @p experiment_ct
+    void addSignals_(const std::vector<FeatureSignal_>& signals, SimTypes::MSSimExperiment& experiment, SimTypes::MSSimExperiment& experiment_ct);
+
+    /// Draw @p count seeds from the technical random number generator (for independent random streams per feature or scan)
+    std::vector<UInt64> drawSeeds_(const Size count);
 
     /**
      @brief Samples signals for the given 1D model
@@ -147,18 +164,20 @@ protected:
      @param mz_end End coordinate (in m/z dimension) of the region where the signals will be sampled
      @param rt_start Start coordinate (in rt dimension) of the region where the signals will be sampled
      @param rt_end End coordinate (in rt dimension) of the region where the signals will be sampled
-     @param experiment Experiment to which the sampled signals will be added
-     @param experiment_ct Experiment to which the centroided Ground Truth sampled signals will be added
+     @param experiment Experiment providing the scans in which the signals will be sampled
+     @param signal The sampled signals (raw and centroided Ground Truth)
      @param activeFeature The current feature that is simulated
+     @param rng Random number generator for the m/z error
      */
     void samplePeptideModel2D_(const ProductModel<2>& pm,
                                const SimTypes::SimCoordinateType mz_start,
                                const SimTypes::SimCoordinateType mz_end,
                                SimTypes::SimCoordinateType rt_start,
                                SimTypes::SimCoordinateType rt_end,
-                               SimTypes::MSSimExperiment& experiment,
-                               SimTypes::MSSimExperiment& experiment_ct,
-                               Feature& activeFeature);
+                               const SimTypes::MSSimExperiment& experiment,
+                               FeatureSignal_& signal,
+                               Feature& activeFeature,
+                               boost::random::mt19937_64& rng);
 
     /**
      @brief Add the correct Elution profile to the passed ProductModel
@@ -208,11 +227,13 @@ protected:
      *
      * @param feature_intensity Intensity of the current feature.
      * @param natural_scaling_factor Additional scaling factor used by some of the sampling models.
+     * @param rng Random number generator for the intensity noise.
      *
      * @return Rescaled feature intensity.
      */
     SimTypes::SimIntensityType getFeatureScaledIntensity_(const SimTypes::SimIntensityType feature_intensity,
-                                                          const SimTypes::SimIntensityType natural_scaling_factor);
+                                                          const SimTypes::SimIntensityType natural_scaling_factor,
+                                                          boost::random::mt19937_64& rng);
 
 
     /**
@@ -261,19 +282,6 @@ protected:
 
     std::vector<ContaminantInfo> contaminants_;
 
-    /**
-    @p threaded_random_numbers keeps a set of random numbers for each thread simulating a feature.
-      */
-    std::vector<std::vector<double> > threaded_random_numbers_;
-
-    /**
-      Indicates which random numbers each thread has used already and if the random number pool
-      should be rebuild.
-      */
-    std::vector<Size> threaded_random_numbers_index_;
-
-    static const Size THREADED_RANDOM_NUMBER_POOL_SIZE_ = 500;
-
     bool contaminants_loaded_;
   };
 
@@ -103,12 +103,34 @@ namespace OpenMS
      */
     ExternalProcess::RETURNSTATE run(const QString& exe, const QStringList& args, const QString& working_dir, const bool verbose);
 
+    /**
+      @brief Starts a program, but does not wait for it to finish (non-blocking counterpart of run()).
+
+      Call isRunning() until it returns false (this forwards the output to the callbacks) and query the result using getResult().
+      This allows to run and monitor several external processes concurrently from a single thread.
+
+      @param exe The program to call (can contain spaces in path, no problem)
+      @param args A list of extra arguments (can be empty)
+      @param verbose Report the call command and errors via the callbacks (default: false)
+      @param working_dir Execute the external process in the given directory. Leave empty to use the current working directory.
+      @param[out] error_msg Message to display to the user if the program failed to start
+      @return SUCCESS if the program was started, FAILED_TO_START otherwise
+    */
+    RETURNSTATE start(const QString& exe, const QStringList& args, const QString& working_dir, const bool verbose, String& error_msg);
+
+    /// Forwards available output to the callbacks (waiting at most @p msecs for new output) and returns true while the program started by start() is still running
+    bool isRunning(int msecs = 50);
+
+    /// Result of the program started by start(), once isRunning() returned false
+    RETURNSTATE getResult(const bool verbose, String& error_msg);
+
   private slots:
     void processStdOut_();
     void processStdErr_();
 
   private:
     QProcess* qp_; ///< pointer to avoid including the QProcess header here (it's huge)
+    QString exe_; ///< the program started last (for error messages)
     std::function<void(const String&)> callbackStdOut_;
     std::function<void(const String&)> callbackStdErr_;
   };
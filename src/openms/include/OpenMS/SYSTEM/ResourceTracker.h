@@ -0,0 +1,150 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/DATASTRUCTURES/String.h>
+#include <OpenMS/SYSTEM/StopWatch.h>
+
+#include <iosfwd>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Records wall time, CPU time and memory of a process, optionally broken down into named stages
+
+    start() begins the measurement. Each call to checkpoint() closes a stage, which covers the time since the
+    previous checkpoint (or since start()). stop() ends the measurement; time after the last checkpoint is not
+    attributed to any stage.
+
+    CPU time is accumulated over all threads of the process, so the ratio of CPU time and wall time
+    (getThreadUtilization()) tells how well the available threads were used.
+
+    Used by TOPPBase to write a resource report (option '-resource_report') that allows workflow managers to
+    choose memory and thread requests of jobs.
+
+    @ingroup System
+  */
+  class OPENMS_DLLAPI ResourceTracker
+  {
+public:
+    /// resources used by a stage
+    struct OPENMS_DLLAPI Stage
+    {
+      String name;
+      double wall_time = 0.0; ///< in seconds
+      double cpu_time = 0.0; ///< user + system time of all threads, in seconds
+      size_t memory_kb = 0; ///< memory in use at the end of the stage
+      size_t peak_memory_kb = 0; ///< peak memory of the process up to the end of the stage
+    };
+
+    /// Default constructor (not started)
+    ResourceTracker();
+
+    /// Starts the measurement (and forgets previous stages)
+    void start();
+
+    /// Closes the current stage under the name @p name (ignored if not running)
+    void checkpoint(const String& name);
+
+    /// Stops the measurement
+    void stop();
+
+    /// Is the measurement running?
+    bool isRunning() const;
+
+    /// Wall time since start() (until stop()) in seconds
+    double getWallTime() const;
+
+    /// CPU time (user + system, all threads) since start() (until stop()) in seconds
+    double getCPUTime() const;
+
+    /// User time since start() (until stop()) in seconds
+    double getUserTime() const;
+
+    /// System time since start() (until stop()) in seconds
+    double getSystemTime() const;
+
+    /// Peak memory of the process in KB (0 if not supported by the OS)
+    size_t getPeakMemory() const;
+
+    /// Average fraction of @p threads that was busy, i.e. CPU time / (wall time * threads); 0 if no time has passed
+    double getThreadUtilization(Size threads) const;
+
+    /// The stages recorded by checkpoint()
+    const std::vector<Stage>& getStages() const;
+
+    /**
+      @brief Writes the resource usage as JSON object
+
+      @param os Output stream
+      @param tool Name of the tool (or program) that was measured
+      @param threads Number of threads the program was allowed to use
+      @param exit_code Exit code of the program
+    */
+    void writeJSON(std::ostream& os, const String& tool, Size threads, Int exit_code) const;
+
+    /**
+      @brief Writes the resource usage as JSON file (see writeJSON())
+
+      @exception Exception::UnableToCreateFile if the file cannot be written
+    */
+    void storeJSON(const String& filename, const String& tool, Size threads, Int exit_code) const;
+
+    /**
+      @brief Reads the total peak memory (in KB) from a file written by storeJSON()
+
+      Used by TOPPAS to learn the memory footprint of tools from their resource reports.
+
+      @return 0 if the file does not exist or contains no peak memory
+    */
+    static size_t loadPeakMemory(const String& filename);
+
+protected:
+    /// measures total time
+    StopWatch watch_;
+
+    /// stages closed so far
+    std::vector<Stage> stages_;
+
+    /// wall and CPU time at the last checkpoint
+    double last_wall_time_;
+    double last_cpu_time_;
+
+    /// peak memory at stop()
+    size_t peak_memory_kb_;
+  };
+
+} // namespace OpenMS
@@ -26,6 +26,7 @@ JavaInfo.h
 NetworkGetRequest.h
 PythonInfo.h
 RWrapper.h
+ResourceTracker.h
 StopWatch.h
 SysInfo.h
 UpdateCheck.h
@@ -97,6 +97,20 @@ protected:
   // blacklist
   MSExperiment exp_blacklist_;
 
+  // only multiplets with RT in [rt_core_begin_, rt_core_end_) are reported (core of the current RT window)
+  double rt_core_begin_;
+  double rt_core_end_;
+
+  /**
+   * @brief runs the algorithm independently on overlapping RT windows of the experiment (parameter 'algorithm:rt_window')
+   *
+   * The windows are processed in parallel. Each window reports the multiplets within its core,
+   * the results are merged into the feature and consensus maps and the blacklist.
+   *
+   * @param exp    experimental data, sorted by RT and with updated ranges
+   */
+  void runWindowed_(const MSExperiment& exp);
+
   /**
    * @brief generate list of m/z shifts
    *
@@ -223,13 +223,19 @@ protected:
     /** @brief Computes the isotope wavelet transform of charge state @p c.
         * @param c_trans The transform.
         * @param c_ref The reference spectrum.
-        * @param c The charge state minus 1 (e.g. c=2 means charge state 3) at which you want to compute the transform. */
+        * @param c The charge state minus 1 (e.g. c=2 means charge state 3) at which you want to compute the transform.
+        *
+        * Only reads the state set by initializeScan(), so the transforms of several charge states of a scan can be computed
+        * concurrently (each into its own @p c_trans). Large scans are transformed in parallel. */
     virtual void getTransform(MSSpectrum& c_trans, const MSSpectrum& c_ref, const UInt c);
 
     /** @brief Computes the isotope wavelet transform of charge state @p c.
         * @param c_trans The transform.
         * @param c_ref The reference spectrum.
-        * @param c The charge state minus 1 (e.g. c=2 means charge state 3) at which you want to compute the transform. */
+        * @param c The charge state minus 1 (e.g. c=2 means charge state 3) at which you want to compute the transform.
+        *
+        * Only reads the state set by initializeScan(), so the transforms of several charge states of a scan can be computed
+        * concurrently (each into its own @p c_trans). Large scans are transformed in parallel. */
     virtual void getTransformHighRes(MSSpectrum& c_trans, const MSSpectrum& c_ref, const UInt c);
 
     /** @brief Given an isotope wavelet transformed spectrum @p candidates, this function assigns to every significant
@@ -565,30 +571,41 @@ protected:
     Int spec_size((Int)c_ref.size());
     //in the very unlikely case that size_t will not fit to int anymore this will be a problem of course
     //for the sake of simplicity (we need here a signed int) we do not cast at every following comparison individually
-    UInt charge = c + 1;
-    double value, T_boundary_left, T_boundary_right, old, c_diff, current, old_pos, my_local_MZ, my_local_lambda, origin, c_mz;
+    const UInt charge = c + 1;
+    const Int from_max_to_left = from_max_to_left_;
+    const double min_spacing = min_spacing_;
+
+    //contiguous copies of the data: every position is read once per data point within the wavelet's support
+    std::vector<double> mzs(spec_size), intens(spec_size);
+    for (Int i = 0; i < spec_size; ++i)
+    {
+      mzs[i] = c_ref[i].getMZ();
+      intens[i] = c_ref[i].getIntensity();
+    }
 
+    //the data points are independent of each other
+#pragma omp parallel for schedule(static, 256) if (spec_size >= 4096)
     for (Int my_local_pos = 0; my_local_pos < spec_size; ++my_local_pos)
     {
-      value = 0; T_boundary_left = 0; T_boundary_right = IsotopeWavelet::getMzPeakCutOffAtMonoPos(c_ref[my_local_pos].getMZ(), charge) / (double)charge;
-      old = 0; old_pos = (my_local_pos - from_max_to_left_ - 1 >= 0) ? c_ref[my_local_pos - from_max_to_left_ - 1].getMZ() : c_ref[0].getMZ() - min_spacing_;
-      my_local_MZ = c_ref[my_local_pos].getMZ(); my_local_lambda = IsotopeWavelet::getLambdaL(my_local_MZ * charge);
-      c_diff = 0;
-      origin = -my_local_MZ + Constants::IW_QUARTER_NEUTRON_MASS / (double)charge;
+      const double T_boundary_left = 0, T_boundary_right = IsotopeWavelet::getMzPeakCutOffAtMonoPos(mzs[my_local_pos], charge) / (double)charge;
+      double value = 0, old = 0, old_pos = (my_local_pos - from_max_to_left - 1 >= 0) ? mzs[my_local_pos - from_max_to_left - 1] : mzs[0] - min_spacing;
+      const double my_local_MZ = mzs[my_local_pos], my_local_lambda = IsotopeWavelet::getLambdaL(my_local_MZ * charge);
+      double c_diff = 0;
+      const double origin = -my_local_MZ + Constants::IW_QUARTER_NEUTRON_MASS / (double)charge;
 
-      for (Int current_conv_pos =  std::max(0, my_local_pos - from_max_to_left_); c_diff < T_boundary_right; ++current_conv_pos)
+      for (Int current_conv_pos =  std::max(0, my_local_pos - from_max_to_left); c_diff < T_boundary_right; ++current_conv_pos)
       {
         if (current_conv_pos >= spec_size)
         {
-          value += 0.5 * old * min_spacing_;
+          value += 0.5 * old * min_spacing;
           break;
         }
 
-        c_mz = c_ref[current_conv_pos].getMZ();
+        const double c_mz = mzs[current_conv_pos];
         c_diff = c_mz + origin;
 
         //Attention! The +1. has nothing to do with the charge, it is caused by the wavelet's formula (tz1).
-        current = c_diff > T_boundary_left && c_diff <= T_boundary_right ? IsotopeWavelet::getValueByLambda(my_local_lambda, c_diff * charge + 1.) * c_ref[current_conv_pos].getIntensity() : 0;
+        const double current = c_diff > T_boundary_left && c_diff <= T_boundary_right ? IsotopeWavelet::getValueByLambda(my_local_lambda, c_diff * charge + 1.) * intens[current_conv_pos] : 0;
 
         value += 0.5 * (current + old) * (c_mz - old_pos);
 
@@ -596,8 +613,6 @@ protected:
         old_pos = c_mz;
       }
 
-
-
       c_trans[my_local_pos].setIntensity(value);
     }
   }
@@ -608,32 +623,34 @@ protected:
     Int spec_size((Int)c_ref.size());
     //in the very unlikely case that size_t will not fit to int anymore this will be a problem of course
     //for the sake of simplicity (we need here a signed int) we do not cast at every following comparison individually
-    UInt charge = c + 1;
-    double value, T_boundary_left, T_boundary_right, c_diff, current, my_local_MZ, my_local_lambda, origin, c_mz;
+    const UInt charge = c + 1;
+    const Int from_max_to_left = from_max_to_left_;
 
-    for (Int my_local_pos = 0; my_local_pos < spec_size; ++my_local_pos)
+    //contiguous copies of the data (see getTransform())
+    std::vector<double> mzs(spec_size), intens(spec_size);
+    for (Int i = 0; i < spec_size; ++i)
     {
-      value = 0; T_boundary_left = 0; T_boundary_right = IsotopeWavelet::getMzPeakCutOffAtMonoPos(c_ref[my_local_pos].getMZ(), charge) / (double)charge;
-
+      mzs[i] = c_ref[i].getMZ();
+      intens[i] = c_ref[i].getIntensity();
+    }
 
-      my_local_MZ = c_ref[my_local_pos].getMZ(); my_local_lambda = IsotopeWavelet::getLambdaL(my_local_MZ * charge);
-      c_diff = 0;
-      origin = -my_local_MZ + Constants::IW_QUARTER_NEUTRON_MASS / (double)charge;
+#pragma omp parallel for schedule(static, 256) if (spec_size >= 4096)
+    for (Int my_local_pos = 0; my_local_pos < spec_size; ++my_local_pos)
+    {
+      const double T_boundary_left = 0, T_boundary_right = IsotopeWavelet::getMzPeakCutOffAtMonoPos(mzs[my_local_pos], charge) / (double)charge;
+      const double my_local_MZ = mzs[my_local_pos], my_local_lambda = IsotopeWavelet::getLambdaL(my_local_MZ * charge);
+      const double origin = -my_local_MZ + Constants::IW_QUARTER_NEUTRON_MASS / (double)charge;
+      double value = 0, c_diff = 0;
 
-      for (Int current_conv_pos =  std::max(0, my_local_pos - from_max_to_left_); c_diff < T_boundary_right; ++current_conv_pos)
+      for (Int current_conv_pos =  std::max(0, my_local_pos - from_max_to_left); c_diff < T_boundary_right && current_conv_pos < spec_size; ++current_conv_pos)
       {
-        if (current_conv_pos >= spec_size)
-        {
-          break;
-        }
-
-        c_mz = c_ref[current_conv_pos].getMZ();
-        c_diff = c_mz + origin;
+        c_diff = mzs[current_conv_pos] + origin;
 
         //Attention! The +1. has nothing to do with the charge, it is caused by the wavelet's formula (tz1).
-        current = c_diff > T_boundary_left && c_diff <= T_boundary_right ? IsotopeWavelet::getValueByLambda(my_local_lambda, c_diff * charge + 1.) * c_ref[current_conv_pos].getIntensity() : 0;
-
-        value += current;
+        if (c_diff > T_boundary_left && c_diff <= T_boundary_right)
+        {
+          value += IsotopeWavelet::getValueByLambda(my_local_lambda, c_diff * charge + 1.) * intens[current_conv_pos];
+        }
       }
 
       c_trans[my_local_pos].setIntensity(value);
@@ -89,6 +89,8 @@ public:
 
         @note Before starting the transformation you have to call the init function
 
+        For resolution != 1 the data are resampled to equidistant positions. The transform then is a discrete
+        convolution, which is computed using the FFT if the wavelet covers many data points (see useFFT_()).
     */
     template <typename InputPeakIterator>
     void transform(InputPeakIterator begin_input,
@@ -151,10 +153,23 @@ public:
         }
         
         // TODO avoid to compute the cwt for the zeros in signal
-        for (Int i = 0; i < n; ++i)
+        if (useFFT_(spacing))
         {
-          signal_[i].setMZ(origin + i * spacing);
-          signal_[i].setIntensity((Peak1D::IntensityType)integrate_(processed_input, spacing, i));
+          std::vector<double> transformed;
+          integrateFFT_(processed_input, spacing, transformed);
+          for (Int i = 0; i < n; ++i)
+          {
+            signal_[i].setMZ(origin + i * spacing);
+            signal_[i].setIntensity((Peak1D::IntensityType)transformed[i]);
+          }
+        }
+        else
+        {
+          for (Int i = 0; i < n; ++i)
+          {
+            signal_[i].setMZ(origin + i * spacing);
+            signal_[i].setIntensity((Peak1D::IntensityType)integrate_(processed_input, spacing, i));
+          }
         }
 
         begin_right_padding_ = n;
@@ -192,97 +207,50 @@ protected:
       double end_pos = ((x->getMZ() + middle_spacing) < (last - 1)->getMZ()) ? (x->getMZ() + middle_spacing)
                        : (last - 1)->getMZ();
 
-      InputPeakIterator help = x;
-
-#ifdef DEBUG_PEAK_PICKING
-      std::cout << "integrate from middle to start_pos " << help->getMZ() << " until " << start_pos << std::endl;
-#endif
-
-      //integrate from middle to start_pos
-      while ((help != first) && ((help - 1)->getMZ() > start_pos))
+      // the wavelet value at a data point is shared by the two intervals adjacent to it, so it is looked up only once
+      const double x_mz = x->getMZ();
+      auto wavelet_at = [this, x_mz](InputPeakIterator it)
       {
-        // search for the corresponding data point of help in the wavelet (take the left most adjacent point)
-        double distance = fabs(x->getMZ() - help->getMZ());
-        Size index_w_r = (Size) Math::round(distance / spacing_);
-        if (index_w_r >= wavelet_.size())
+        // search for the corresponding data point in the wavelet (take the left most adjacent point)
+        Size index_w = (Size) Math::round(fabs(x_mz - it->getMZ()) / spacing_);
+        if (index_w >= wavelet_.size())
         {
-          index_w_r = wavelet_.size() - 1;
+          index_w = wavelet_.size() - 1;
         }
-        double wavelet_right =  wavelet_[index_w_r];
+        return wavelet_[index_w];
+      };
+      const double wavelet_middle = wavelet_at(x);
 
 #ifdef DEBUG_PEAK_PICKING
-        std::cout << "distance x help " << distance << std::endl;
-        std::cout << "distance in wavelet_ " << index_w_r * spacing_ << std::endl;
-        std::cout << "wavelet_right "  <<  wavelet_right << std::endl;
-#endif
-
-        // search for the corresponding datapoint for (help-1) in the wavelet (take the left most adjacent point)
-        distance = fabs(x->getMZ() - (help - 1)->getMZ());
-        Size index_w_l = (Size) Math::round(distance / spacing_);
-        if (index_w_l >= wavelet_.size())
-        {
-          index_w_l = wavelet_.size() - 1;
-        }
-        double wavelet_left =  wavelet_[index_w_l];
-
-        // start the interpolation for the true value in the wavelet
-
-#ifdef DEBUG_PEAK_PICKING
-        std::cout << " help-1 " << (help - 1)->getMZ() << " distance x, help-1" << distance << std::endl;
-        std::cout << "distance in wavelet_ " << index_w_l * spacing_ << std::endl;
-        std::cout << "wavelet_ at left " <<   wavelet_left << std::endl;
-
-        std::cout << " intensity " << fabs((help - 1)->getMZ() - help->getMZ()) / 2. << " * " << (help - 1)->getIntensity() << " * " << wavelet_left << " + " << (help)->getIntensity() << "* " << wavelet_right
-                  << std::endl;
+      std::cout << "integrate from middle to start_pos " << x->getMZ() << " until " << start_pos << std::endl;
 #endif
 
+      //integrate from middle to start_pos
+      InputPeakIterator help = x;
+      double wavelet_right = wavelet_middle;
+      while ((help != first) && ((help - 1)->getMZ() > start_pos))
+      {
+        double wavelet_left = wavelet_at(help - 1);
         v += fabs((help - 1)->getMZ() - help->getMZ()) / 2. * ((help - 1)->getIntensity() * wavelet_left + help->getIntensity() * wavelet_right);
+        wavelet_right = wavelet_left;
         --help;
       }
 
+#ifdef DEBUG_PEAK_PICKING
+      std::cout << "integrate from middle to endpos " << x->getMZ() << " until " << end_pos << std::endl;
+#endif
 
       //integrate from middle to end_pos
       help = x;
-#ifdef DEBUG_PEAK_PICKING
-      std::cout << "integrate from middle to endpos " << (help)->getMZ() << " until " << end_pos << std::endl;
-#endif
+      double wavelet_left = wavelet_middle;
       while ((help != (last - 1)) && ((help + 1)->getMZ() < end_pos))
       {
-        // search for the corresponding datapoint for help in the wavelet (take the left most adjacent point)
-        double distance = fabs(x->getMZ() - help->getMZ());
-        Size index_w_l = (Size) Math::round(distance / spacing_);
-        if (index_w_l >= wavelet_.size())
-        {
-          index_w_l = wavelet_.size() - 1;
-        }
-        double wavelet_left =  wavelet_[index_w_l];
-
-#ifdef DEBUG_PEAK_PICKING
-        std::cout << " help " << (help)->getMZ() << " distance x, help" << distance << std::endl;
-        std::cout << "distance in wavelet_ " << index_w_l * spacing_ << std::endl;
-        std::cout << "wavelet_ at left " <<   wavelet_left << std::endl;
-#endif
-
-        // search for the corresponding datapoint for (help+1) in the wavelet (take the left most adjacent point)
-        distance = fabs(x->getMZ() - (help + 1)->getMZ());
-        Size index_w_r = (Size) Math::round(distance / spacing_);
-        if (index_w_r >= wavelet_.size())
-        {
-          index_w_r = wavelet_.size() - 1;
-        }
-        double wavelet_right =  wavelet_[index_w_r];
-
-#ifdef DEBUG_PEAK_PICKING
-        std::cout << " help+1 " << (help + 1)->getMZ() << " distance x, help+1" << distance << std::endl;
-        std::cout << "distance in wavelet_ " << index_w_r * spacing_ << std::endl;
-        std::cout << "wavelet_ at right " <<   wavelet_right << std::endl;
-#endif
-
+        double wavelet_right = wavelet_at(help + 1);
         v += fabs(help->getMZ() - (help + 1)->getMZ()) / 2. * (help->getIntensity() * wavelet_left + (help + 1)->getIntensity() * wavelet_right);
+        wavelet_left = wavelet_right;
         ++help;
       }
 
-
 #ifdef DEBUG_PEAK_PICKING
       std::cout << "return" << (v / sqrt(scale_)) << std::endl;
 #endif
@@ -292,6 +260,22 @@ protected:
     /// Computes the convolution of the wavelet and the profile data at position x with resolution > 1
     double integrate_(const std::vector<double> & processed_input, double spacing_data, int index);
 
+    /**
+        @brief Computes the convolution of the wavelet and the resampled profile data at all positions using the FFT
+
+        Yields the same values as integrate_() (up to rounding), including its handling of the borders.
+    */
+    void integrateFFT_(const std::vector<double> & processed_input, double spacing_data, std::vector<double> & result) const;
+
+    /// Is integrateFFT_() faster than integrate_() for resampled data with spacing @p spacing_data?
+    bool useFFT_(double spacing_data) const;
+
+    /// Number of data points with spacing @p spacing_data covered by one half of the wavelet
+    int halfWidthInData_(double spacing_data) const;
+
+    /// Index into wavelet_ for the data point @p k positions (of spacing @p spacing_data) away from the center
+    int waveletIndex_(int k, double spacing_data) const;
+
     /// Computes the Marr wavelet at position x
     inline double marr_(const double x) const
     {
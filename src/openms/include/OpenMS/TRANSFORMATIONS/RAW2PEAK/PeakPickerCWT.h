@@ -154,6 +154,18 @@ protected:
     /// Switch for the 2D optimization of peak parameters
     bool two_d_optimization_;
 
+    /// The wavelet transform, tabulated for the current scale and spacing (copied for every spectrum)
+    ContinuousWaveletTransformNumIntegration wt_;
+
+    /// The wavelet transform used for the deconvolution (tabulated for charge 2)
+    ContinuousWaveletTransformNumIntegration wt_deconvolution_;
+
+    /// The peak bound in the CWT corresponding to peak_bound_ (see initializeWT_())
+    double peak_bound_cwt_;
+
+    /// The peak bound in the CWT corresponding to peak_bound_ms2_level_ (see initializeWT_())
+    double peak_bound_ms2_level_cwt_;
+
 
     void updateMembers_() override;
 
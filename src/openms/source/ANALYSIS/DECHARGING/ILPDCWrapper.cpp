@@ -39,12 +39,15 @@
 #include <OpenMS/SYSTEM/StopWatch.h>
 #include <OpenMS/KERNEL/FeatureMap.h>
 
+#include <exception>
 #include <fstream>
+#include <numeric>
 
 namespace OpenMS
 {
 
-  ILPDCWrapper::ILPDCWrapper()
+  ILPDCWrapper::ILPDCWrapper() :
+    greedy_threshold_(0)
   {
   }
 
@@ -52,7 +55,17 @@ namespace OpenMS
   {
   }
 
-  double ILPDCWrapper::compute(const FeatureMap fm, PairsType& pairs, Size verbose_level) const
+  void ILPDCWrapper::setGreedyThreshold(Size max_edges)
+  {
+    greedy_threshold_ = max_edges;
+  }
+
+  Size ILPDCWrapper::getGreedyThreshold() const
+  {
+    return greedy_threshold_;
+  }
+
+  double ILPDCWrapper::compute(const FeatureMap& fm, PairsType& pairs, Size verbose_level) const
   {
     if (fm.empty())
     {
@@ -193,16 +206,40 @@ namespace OpenMS
     StopWatch time1;
     time1.start();
 
-    // split problem into slices and have each one solved by the ILPS
-    double score = 0;
-// OMP currently causes spurious segfaults in Release mode; OMP fix applied, however: disable if problem persists
-//#ifdef _OPENMP
-//#pragma omp parallel for schedule(dynamic, 1), reduction(+: score)
-//#endif
+    // split problem into slices and have each one solved by the ILPS.
+    // The slices touch disjoint ranges of 'pairs', so edge scoring and greedy slices run
+    // concurrently. The LP model of a slice is built and solved inside a critical section,
+    // since the LP solvers are not thread-safe (see computeSlice_).
+    // Biggest slices first, so a large slice is not started last and ends up running alone.
+    std::stable_sort(bins.begin(), bins.end(), [](const std::pair<Size, Size>& a, const std::pair<Size, Size>& b)
+    {
+      return (a.second - a.first) > (b.second - b.first);
+    });
+    std::vector<double> slice_scores(bins.size(), 0.0);
+    std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 1)
     for (SignedSize i = 0; i < static_cast<SignedSize>(bins.size()); ++i)
     {
-      score = computeSlice_(fm, pairs, bins[i].first, bins[i].second, verbose_level);
+      try
+      {
+        if (greedy_threshold_ > 0 && bins[i].second - bins[i].first > greedy_threshold_)
+        {
+          slice_scores[i] = computeSliceGreedy_(fm, pairs, bins[i].first, bins[i].second);
+        }
+        else
+        {
+          slice_scores[i] = computeSlice_(fm, pairs, bins[i].first, bins[i].second, verbose_level);
+        }
+      }
+      catch (...)
+      {
+#pragma omp critical (ILPDCWrapper_error)
+        if (!error) error = std::current_exception();
+      }
     }
+    if (error) std::rethrow_exception(error);
+    // sum in bin order, independent of the thread schedule
+    double score = std::accumulate(slice_scores.begin(), slice_scores.end(), 0.0);
     time1.stop();
     OPENMS_LOG_INFO << " Branch and cut took " << time1.getClockTime() << " seconds, "
              << " with objective value: " << score << "."
@@ -216,7 +253,7 @@ namespace OpenMS
     f_set[rota_l].insert(v);
   }
 
-  double ILPDCWrapper::computeSlice_(const FeatureMap fm,
+  double ILPDCWrapper::computeSlice_(const FeatureMap& fm,
                                      PairsType& pairs,
                                      const PairsIndex margin_left,
                                      const PairsIndex margin_right,
@@ -226,12 +263,8 @@ namespace OpenMS
     typedef std::map<Size, FeatureType_> r_type;
     r_type features;
 
-
-    LPWrapper build;
-    build.setSolver(LPWrapper::SOLVER_COINOR);
-    build.setObjectiveSense(LPWrapper::MAX); // maximize
-
-    // add ALL edges first. Their result is what is interesting to us later
+    // score ALL edges first. Their result is what is interesting to us later.
+    // Edge i becomes column (i - margin_left) of the model below.
     for (PairsIndex i = margin_left; i < margin_right; ++i)
     {
       // log scores are good for addition in ILP - but they are < 0, thus not suitable for maximizing
@@ -239,86 +272,156 @@ namespace OpenMS
       double score = exp(getLogScore_(pairs[i], fm));
       pairs[i].setEdgeScore(score * pairs[i].getEdgeScore()); // multiply with preset score
 
-      // create the column representing the edge
-      Int index = build.addColumn();
-      build.setColumnBounds(index, 0, 1, LPWrapper::DOUBLE_BOUNDED);
-      build.setColumnType(index, LPWrapper::INTEGER); // integer variable
-      build.setObjective(index, pairs[i].getEdgeScore());
-
       // create feature variants set
+      Size index = i - margin_left;
       String rota_l = String(pairs[i].getElementIndex(0)) + pairs[i].getCompomer().getAdductsAsString(0) + "_" + pairs[i].getCharge(0);
       updateFeatureVariant_(features[pairs[i].getElementIndex(0)], rota_l, index);
       String rota_r = String(pairs[i].getElementIndex(1)) + pairs[i].getCompomer().getAdductsAsString(1) + "_" + pairs[i].getCharge(1);
       updateFeatureVariant_(features[pairs[i].getElementIndex(1)], rota_r, index);
     }
 
-    // ADD Features (multiple variants of one feature are constrained to size=1)
-    Size count(0); // each entry is a feature idx --->    Map["AdductCgf"]->adjacentEdges
-    for (r_type::iterator it = features.begin(); it != features.end(); ++it)
+    double objective(0);
+    std::exception_ptr error;
+    // the LP solvers (GLPK in particular) are not thread-safe and caused spurious segfaults in
+    // Release mode when slices were solved concurrently; only the scoring above runs in parallel
+#pragma omp critical (ILPDCWrapper_LPWrapper)
     {
-      ++count;
-      std::vector<Int> columns;
-      std::vector<double> elements;
-      for (FeatureType_::const_iterator iti = it->second.begin(); iti != it->second.end(); ++iti)
+      try
       {
-        Int index = build.addColumn();
-        build.setColumnBounds(index, 0, 1, LPWrapper::DOUBLE_BOUNDED);
-        build.setColumnType(index, LPWrapper::INTEGER); // integer variable
-        build.setObjective(index, 0); // obj value of feature must be a constant, as it must be neutral
-        columns.push_back(index);
-        elements.push_back(1.0);
-
-        /* allow connected edges only if this variant of the feature is chosen */
-        /* get adjacent edges */
-        std::vector<Int> columns_e;
-        std::vector<double> elements_e;
-        for (std::set<Size>::const_iterator it_e = iti->second.begin(); it_e != iti->second.end(); ++it_e)
+        LPWrapper build;
+        build.setSolver(LPWrapper::SOLVER_COINOR);
+        build.setObjectiveSense(LPWrapper::MAX); // maximize
+
+        // add ALL edges first
+        for (PairsIndex i = margin_left; i < margin_right; ++i)
         {
-          columns_e.push_back((Int) * it_e);
-          elements_e.push_back(-1.0);
+          // create the column representing the edge
+          Int index = build.addColumn();
+          build.setColumnBounds(index, 0, 1, LPWrapper::DOUBLE_BOUNDED);
+          build.setColumnType(index, LPWrapper::INTEGER); // integer variable
+          build.setObjective(index, pairs[i].getEdgeScore());
         }
-        columns_e.push_back((Int) index);
-        elements_e.push_back(iti->second.size()); // factor of variant is number of adjacent edges
-        String se = String("cv") + index;
-        build.addRow(columns_e, elements_e, se, 0, 10000, LPWrapper::LOWER_BOUND_ONLY);
-      }
-      String s = String("c") + count;
-      // only allow exactly one charge variant
-      build.addRow(columns, elements, s, 1, 1, LPWrapper::FIXED);
-    }
 
-    LPWrapper::SolverParam param;
-    param.enable_mir_cuts = true;
-    param.enable_cov_cuts = true;
-    param.enable_feas_pump_heuristic = true;
-    param.enable_binarization = false;
-    param.enable_clq_cuts = true;
-    param.enable_gmi_cuts = true;
-    param.enable_presolve = true;
+        // ADD Features (multiple variants of one feature are constrained to size=1)
+        Size count(0); // each entry is a feature idx --->    Map["AdductCgf"]->adjacentEdges
+        for (r_type::iterator it = features.begin(); it != features.end(); ++it)
+        {
+          ++count;
+          std::vector<Int> columns;
+          std::vector<double> elements;
+          for (FeatureType_::const_iterator iti = it->second.begin(); iti != it->second.end(); ++iti)
+          {
+            Int index = build.addColumn();
+            build.setColumnBounds(index, 0, 1, LPWrapper::DOUBLE_BOUNDED);
+            build.setColumnType(index, LPWrapper::INTEGER); // integer variable
+            build.setObjective(index, 0); // obj value of feature must be a constant, as it must be neutral
+            columns.push_back(index);
+            elements.push_back(1.0);
+
+            /* allow connected edges only if this variant of the feature is chosen */
+            /* get adjacent edges */
+            std::vector<Int> columns_e;
+            std::vector<double> elements_e;
+            for (std::set<Size>::const_iterator it_e = iti->second.begin(); it_e != iti->second.end(); ++it_e)
+            {
+              columns_e.push_back((Int) * it_e);
+              elements_e.push_back(-1.0);
+            }
+            columns_e.push_back((Int) index);
+            elements_e.push_back(iti->second.size()); // factor of variant is number of adjacent edges
+            String se = String("cv") + index;
+            build.addRow(columns_e, elements_e, se, 0, 10000, LPWrapper::LOWER_BOUND_ONLY);
+          }
+          String s = String("c") + count;
+          // only allow exactly one charge variant
+          build.addRow(columns, elements, s, 1, 1, LPWrapper::FIXED);
+        }
 
-    build.solve(param);
+        LPWrapper::SolverParam param;
+        param.enable_mir_cuts = true;
+        param.enable_cov_cuts = true;
+        param.enable_feas_pump_heuristic = true;
+        param.enable_binarization = false;
+        param.enable_clq_cuts = true;
+        param.enable_gmi_cuts = true;
+        param.enable_presolve = true;
 
-    for (UInt iColumn = 0; iColumn < margin_right - margin_left; ++iColumn)
-    {
-      double value = build.getColumnValue(iColumn);
-      if (fabs(value) > 0.5)
-      {
-        pairs[margin_left + iColumn].setActive(true);
+        build.solve(param);
+
+        for (UInt iColumn = 0; iColumn < margin_right - margin_left; ++iColumn)
+        {
+          double value = build.getColumnValue(iColumn);
+          if (fabs(value) > 0.5)
+          {
+            pairs[margin_left + iColumn].setActive(true);
+          }
+          else
+          {
+            // DEBUG
+            //std::cerr << " edge " << iColumn << " with " << value << "\n";
+          }
+        }
+
+        objective = build.getObjectiveValue();
       }
-      else
+      catch (...)
       {
-        // DEBUG
-        //std::cerr << " edge " << iColumn << " with " << value << "\n";
+        // exceptions must not leave the critical section
+        error = std::current_exception();
       }
     }
+    if (error) std::rethrow_exception(error);
+    return objective;
 
-    return build.getObjectiveValue();
+  }
 
+  double ILPDCWrapper::computeSliceGreedy_(const FeatureMap& fm,
+                                           PairsType& pairs,
+                                           const PairsIndex margin_left,
+                                           const PairsIndex margin_right) const
+  {
+    // same edge scores as for the ILP
+    std::vector<PairsIndex> order;
+    order.reserve(margin_right - margin_left);
+    for (PairsIndex i = margin_left; i < margin_right; ++i)
+    {
+      double score = exp(getLogScore_(pairs[i], fm));
+      pairs[i].setEdgeScore(score * pairs[i].getEdgeScore()); // multiply with preset score
+      order.push_back(i);
+    }
+    std::stable_sort(order.begin(), order.end(), [&pairs](PairsIndex a, PairsIndex b)
+    {
+      return pairs[a].getEdgeScore() > pairs[b].getEdgeScore();
+    });
+
+    // as in the ILP, every feature gets exactly one charge variant and an edge can only be
+    // active if it agrees with the variants of both of its features
+    std::map<Size, String> variants;
+    double objective = 0;
+    for (PairsIndex i : order)
+    {
+      Size f_l = pairs[i].getElementIndex(0);
+      Size f_r = pairs[i].getElementIndex(1);
+      String rota_l = pairs[i].getCompomer().getAdductsAsString(0) + "_" + pairs[i].getCharge(0);
+      String rota_r = pairs[i].getCompomer().getAdductsAsString(1) + "_" + pairs[i].getCharge(1);
+      std::map<Size, String>::const_iterator it_l = variants.find(f_l);
+      std::map<Size, String>::const_iterator it_r = variants.find(f_r);
+      if ((it_l != variants.end() && it_l->second != rota_l) ||
+          (it_r != variants.end() && it_r->second != rota_r))
+      {
+        continue;
+      }
+      variants[f_l] = rota_l;
+      variants[f_r] = rota_r;
+      pairs[i].setActive(true);
+      objective += pairs[i].getEdgeScore();
+    }
+    return objective;
   }
 
   // old version, slower, as ILP has different layout (i.e, the same as described in paper)
 
-  double ILPDCWrapper::computeSliceOld_(const FeatureMap fm,
+  double ILPDCWrapper::computeSliceOld_(const FeatureMap& fm,
                                         PairsType& pairs,
                                         const PairsIndex margin_left,
                                         const PairsIndex margin_right,
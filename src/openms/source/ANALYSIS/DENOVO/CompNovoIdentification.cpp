@@ -34,12 +34,14 @@
 //
 
 #include <OpenMS/ANALYSIS/DENOVO/CompNovoIdentification.h>
+#include <OpenMS/CONCEPT/ParallelExecution.h>
 #include <OpenMS/FILTERING/TRANSFORMERS/Normalizer.h>
 #include <OpenMS/COMPARISON/SPECTRA/SpectrumAlignmentScore.h>
 #include <OpenMS/CHEMISTRY/ModificationsDB.h>
 #include <OpenMS/CHEMISTRY/ResidueDB.h>
 #include <OpenMS/ANALYSIS/DENOVO/CompNovoIonScoring.h>
 
+
 //#define DAC_DEBUG
 //#define ESTIMATE_PRECURSOR_DEBUG
 
@@ -79,47 +81,57 @@ namespace OpenMS
 
   void CompNovoIdentification::getIdentifications(vector<PeptideIdentification> & pep_ids, const PeakMap & exp)
   {
-    Size count(1);
-    for (PeakMap::ConstIterator it = exp.begin(); it != exp.end(); ++it, ++count)
+    // pair each CID spectrum with the following ETD spectrum
+    vector<pair<Size, Size> > spectrum_pairs;
+    vector<PeptideIdentification> ids;
+    for (Size i = 0; i < exp.size(); ++i)
     {
-      //cerr << count << "/" << exp.size() / 2 << endl;
-
-      PeptideIdentification id;
-      PeakSpectrum CID_spec(*it);
-      double cid_rt(it->getRT());
+      const MSSpectrum& cid = exp[i];
+      double cid_rt(cid.getRT());
       double cid_mz(0);
-      if (!it->getPrecursors().empty())
+      if (!cid.getPrecursors().empty())
       {
-        cid_mz = it->getPrecursors().begin()->getMZ();
+        cid_mz = cid.getPrecursors().begin()->getMZ();
       }
 
-      if (it->getPrecursors().empty() || cid_mz == 0)
+      if (cid.getPrecursors().empty() || cid_mz == 0)
       {
-        cerr << "CompNovoIdentification: Spectrum id=\"" << it->getNativeID() << "\" at RT=" << cid_rt << " does not have valid precursor information." << endl;
+        cerr << "CompNovoIdentification: Spectrum id=\"" << cid.getNativeID() << "\" at RT=" << cid_rt << " does not have valid precursor information." << endl;
         continue;
       }
-      id.setRT(cid_rt);
-      id.setMZ(cid_mz);
 
-      if ((it + 1) != exp.end() && !(it + 1)->getPrecursors().empty())
+      if (i + 1 < exp.size() && !exp[i + 1].getPrecursors().empty())
       {
-        double etd_rt = (it + 1)->getRT();
-        double etd_mz = (it + 1)->getPrecursors().begin()->getMZ();
+        double etd_rt = exp[i + 1].getRT();
+        double etd_mz = exp[i + 1].getPrecursors().begin()->getMZ();
 
         if (fabs(etd_rt - cid_rt) < 10 &&         // RT distance is not too large
             fabs(etd_mz - cid_mz) < 0.01)             // same precursor used
         {
-          PeakSpectrum ETD_spec(*(++it));
-
-          subspec_to_sequences_.clear();
-          permute_cache_.clear();
-
-          getIdentification(id, CID_spec, ETD_spec);
-          //cerr << "size_of id=" << id.getHits().size() << endl;
-          pep_ids.push_back(id);
+          spectrum_pairs.emplace_back(i, i + 1);
+          PeptideIdentification id;
+          id.setRT(cid_rt);
+          id.setMZ(cid_mz);
+          ids.push_back(id);
+          ++i;
         }
       }
     }
+
+    // The pairs are independent of each other. Every thread works on its own
+    // copy of the algorithm, since the subspectrum and decomposition caches
+    // and the decomposition algorithm are modified while searching.
+    ParallelExecution::forEachWithState(0, (SignedSize)spectrum_pairs.size(),
+      [this]() { return CompNovoIdentification(*this); },
+      [&](CompNovoIdentification& worker, SignedSize i)
+      {
+        worker.subspec_to_sequences_.clear();
+        worker.permute_cache_.clear();
+
+        worker.getIdentification(ids[i], exp[spectrum_pairs[i].first], exp[spectrum_pairs[i].second]);
+      }, ParallelExecution::Schedule::DYNAMIC);
+
+    pep_ids.insert(pep_ids.end(), ids.begin(), ids.end());
   }
 
   void CompNovoIdentification::getIdentification(PeptideIdentification & id, const PeakSpectrum & CID_spec, const PeakSpectrum & ETD_spec)
@@ -34,11 +34,13 @@
 //
 
 #include <OpenMS/ANALYSIS/DENOVO/CompNovoIdentificationCID.h>
+#include <OpenMS/CONCEPT/ParallelExecution.h>
 
 #include <OpenMS/FILTERING/TRANSFORMERS/Normalizer.h>
 #include <OpenMS/COMPARISON/SPECTRA/SpectrumAlignmentScore.h>
 #include <OpenMS/ANALYSIS/DENOVO/CompNovoIonScoringCID.h>
 
+
 //#define DAC_DEBUG
 
 //#define WRITE_SCORED_SPEC
@@ -84,33 +86,29 @@ namespace OpenMS
 
   void CompNovoIdentificationCID::getIdentifications(vector<PeptideIdentification> & pep_ids, const PeakMap & exp)
   {
-    Size count(1);
-    for (PeakMap::ConstIterator it = exp.begin(); it != exp.end(); ++it, ++count)
+    vector<PeptideIdentification> ids(exp.size());
+    for (Size i = 0; i != exp.size(); ++i)
     {
-      //cerr << count << "/" << exp.size() << endl;
-      PeptideIdentification id;
       // TODO check if both CID and ETD is present;
-      PeakSpectrum CID_spec(*it);
-      id.setRT(it->getRT());
-      id.setMZ(it->getPrecursors().begin()->getMZ());
-
-      subspec_to_sequences_.clear();
-      permute_cache_.clear();
-      decomp_cache_.clear();
+      ids[i].setRT(exp[i].getRT());
+      ids[i].setMZ(exp[i].getPrecursors().begin()->getMZ());
+    }
 
-      getIdentification(id, CID_spec);
-      //cerr << "size_of id=" << id.getHits().size() << endl;
-      pep_ids.push_back(id);
+    // The spectra are independent of each other. Every thread works on its
+    // own copy of the algorithm, since the subspectrum and decomposition
+    // caches and the decomposition algorithm are modified while searching.
+    ParallelExecution::forEachWithState(0, (SignedSize)exp.size(),
+      [this]() { return CompNovoIdentificationCID(*this); },
+      [&](CompNovoIdentificationCID& worker, SignedSize i)
+      {
+        worker.subspec_to_sequences_.clear();
+        worker.permute_cache_.clear();
+        worker.decomp_cache_.clear();
 
-      //++it;
+        worker.getIdentification(ids[i], exp[i]);
+      }, ParallelExecution::Schedule::DYNAMIC);
 
-      //
-      //if (count == 10)
-      //{
-      //return;
-      //}
-    }
-    return;
+    pep_ids.insert(pep_ids.end(), ids.begin(), ids.end());
   }
 
   void CompNovoIdentificationCID::getIdentification(PeptideIdentification & id, const PeakSpectrum & CID_spec)
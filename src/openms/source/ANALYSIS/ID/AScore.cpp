@@ -71,7 +71,7 @@ namespace OpenMS
   {
   }
 
-  PeptideHit AScore::compute(const PeptideHit& hit, PeakSpectrum& real_spectrum)
+  PeptideHit AScore::compute(const PeptideHit& hit, PeakSpectrum& real_spectrum) const
   {
     PeptideHit phospho = hit;
     
@@ -129,10 +129,10 @@ namespace OpenMS
     vector<PeakSpectrum> windows_top10 = peakPickingPerWindowsInSpectrum_(real_spectrum);
 
     // compute match probability for a peak depth of 1
-    base_match_probability_ = computeBaseProbability_(real_spectrum.back().getMZ());
+    const double base_match_probability = computeBaseProbability_(real_spectrum.back().getMZ());
 
     // calculate peptide score for each possible phospho site permutation
-    vector<vector<double>> peptide_site_scores = calculatePermutationPeptideScores_(th_spectra, windows_top10);
+    vector<vector<double>> peptide_site_scores = calculatePermutationPeptideScores_(th_spectra, windows_top10, base_match_probability);
 
     // rank peptide permutations ascending
     multimap<double, Size> ranking = rankWeightedPermutationPeptideScores_(peptide_site_scores);
@@ -167,7 +167,7 @@ namespace OpenMS
 
         computeSiteDeterminingIons_(th_spectra, *s_it, site_determining_ions);
         Size N = site_determining_ions[0].size(); // all possibilities have the same number so take the first one
-        double p = static_cast<double>(s_it->peak_depth) * base_match_probability_;
+        double p = static_cast<double>(s_it->peak_depth) * base_match_probability;
 
         Size n_first = 0; // number of matching peaks for first peptide
         for (Size window_idx = 0; window_idx != windows_top10.size(); ++window_idx) // for each 100 m/z window
@@ -378,6 +378,23 @@ namespace OpenMS
     }
     
     window_reduced.sortByPosition();
+    return countMatchedIons_(th, window_reduced);
+  }
+
+  vector<PeakSpectrum> AScore::reduceWindows_(const vector<PeakSpectrum>& windows, Size depth) const
+  {
+    vector<PeakSpectrum> windows_reduced(windows.size());
+    for (Size i = 0; i < windows.size(); ++i)
+    {
+      // windows are sorted by intensity (see peakPickingPerWindowsInSpectrum_()), so keep the first 'depth' peaks
+      windows_reduced[i].insert(windows_reduced[i].end(), windows[i].begin(), windows[i].begin() + std::min(depth, windows[i].size()));
+      windows_reduced[i].sortByPosition();
+    }
+    return windows_reduced;
+  }
+
+  Size AScore::countMatchedIons_(const PeakSpectrum& th, const PeakSpectrum& window_reduced) const
+  {
     Size matched_peaks(0);
     if (fragment_tolerance_ppm_)
     {
@@ -501,8 +518,28 @@ namespace OpenMS
   vector<PeakSpectrum> AScore::createTheoreticalSpectra_(const vector<vector<Size>>& permutations, const AASequence& seq_without_phospho) const
   {
     vector<PeakSpectrum> th_spectra;
+
+    // b- and y-ion ladder of the unphosphorylated peptide (with ion names, to know which residues each ion contains);
+    // we mono-charge spectra, generating b- and y-ions is the default behavior of the TSG
     TheoreticalSpectrumGenerator spectrum_generator;
-    
+    Param param = spectrum_generator.getParameters();
+    param.setValue("add_metainfo", "true");
+    spectrum_generator.setParameters(param);
+    PeakSpectrum ladder;
+    spectrum_generator.getSpectrum(ladder, seq_without_phospho, 1, 1);
+
+    // type (prefix or suffix ion) and number of residues of each ladder ion, e.g. "b3+" or "y5+"
+    vector<pair<bool, Size>> ions;
+    if (!ladder.getStringDataArrays().empty())
+    {
+      for (const String& name : ladder.getStringDataArrays()[0])
+      {
+        ions.emplace_back(name[0] == 'b', (Size)String(name.substr(1, name.find('+') - 1)).toInt());
+      }
+    }
+
+    const Size n = seq_without_phospho.size();
+    vector<double> prefix_shift(n + 1); // phospho mass added to the first k residues
     th_spectra.resize(permutations.size());
     for (Size i = 0; i < permutations.size(); ++i)
     {
@@ -523,9 +560,20 @@ namespace OpenMS
         }
       }
 
-      // we mono-charge spectra, generating b- and y-ions is the default behavior of the TSG
-      spectrum_generator.getSpectrum(th_spectra[i], seq, 1, 1);
-      th_spectra[i].setName(seq.toString());
+      // ions only differ from the ladder by the mass of the phospho sites they contain
+      for (Size as = 0; as < n; ++as)
+      {
+        prefix_shift[as + 1] = prefix_shift[as] + (seq[as].getMonoWeight(Residue::Internal) - seq_without_phospho[as].getMonoWeight(Residue::Internal));
+      }
+      PeakSpectrum& th = th_spectra[i];
+      th.reserve(ladder.size());
+      for (Size k = 0; k < ladder.size(); ++k)
+      {
+        const double shift = ions[k].first ? prefix_shift[ions[k].second] : prefix_shift[n] - prefix_shift[n - ions[k].second];
+        th.emplace_back(ladder[k].getMZ() + shift, ladder[k].getIntensity());
+      }
+      th.sortByPosition();
+      th.setName(seq.toString());
     }
     return th_spectra;
   }
@@ -563,9 +611,15 @@ namespace OpenMS
     return windows_top10;
   }
   
-  std::vector<std::vector<double>> AScore::calculatePermutationPeptideScores_(vector<PeakSpectrum>& th_spectra, const vector<PeakSpectrum>& windows_top10) const
+  std::vector<std::vector<double>> AScore::calculatePermutationPeptideScores_(vector<PeakSpectrum>& th_spectra, const vector<PeakSpectrum>& windows_top10, double base_match_probability) const
   {
-    //prepare peak depth for all windows in the actual spectrum
+    //prepare peak depth for all windows in the actual spectrum (once, shared by all permutations)
+    vector<vector<PeakSpectrum>> windows_by_depth(10);
+    for (Size i = 1; i <= 10; ++i)
+    {
+      windows_by_depth[i - 1] = reduceWindows_(windows_top10, i);
+    }
+
     vector<vector<double>> permutation_peptide_scores(th_spectra.size());
     vector<vector<double>>::iterator site_score = permutation_peptide_scores.begin();
     
@@ -578,11 +632,11 @@ namespace OpenMS
       for (Size i = 1; i <= 10; ++i)
       {
         Size n = 0;
-        for (Size current_win = 0; current_win < windows_top10.size(); ++current_win) // count matched ions over all 100 Da windows
+        for (const PeakSpectrum& window : windows_by_depth[i - 1]) // count matched ions over all 100 Da windows
         {
-          n += numberOfMatchedIons_(*it, windows_top10[current_win], i);
+          n += countMatchedIons_(*it, window);
         }
-        double p = static_cast<double>(i) * base_match_probability_;
+        double p = static_cast<double>(i) * base_match_probability;
         double cumulative_score = computeCumulativeScore_(N, n, p);
 
         //abs is used to avoid -0 score values
@@ -35,8 +35,11 @@
 #include <OpenMS/ANALYSIS/ID/AccurateMassSearchEngine.h>
 #include <OpenMS/CHEMISTRY/EmpiricalFormula.h>
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsotopeDistribution.h>
+#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternCache.h>
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternGenerator.h>
 #include <OpenMS/CONCEPT/Constants.h>
+#include <OpenMS/CONCEPT/ParallelExecution.h>
+#include <OpenMS/CONCEPT/Profiler.h>
 #include <OpenMS/FORMAT/TextFile.h>
 #include <OpenMS/MATH/MISC/MathFunctions.h>
 #include <OpenMS/METADATA/ProteinIdentification.h>
@@ -564,24 +567,10 @@ namespace OpenMS
     }
 
     // Depending on ion_mode_internal_, either positive or negative adducts are used
-    std::vector<AdductInfo>::const_iterator it_s, it_e;
-    if (ion_mode == "positive")
-    {
-      it_s = pos_adducts_.begin();
-      it_e = pos_adducts_.end();
-    }
-    else if (ion_mode == "negative")
-    {
-      it_s = neg_adducts_.begin();
-      it_e = neg_adducts_.end();
-    }
-    else
-    {
-      throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("Ion mode cannot be set to '") + ion_mode + "'. Must be 'positive' or 'negative'!");
-    }
+    const std::vector<AdductInfo>& adducts = getAdducts_(ion_mode);
 
     std::pair<Size, Size> hit_idx;
-    for (std::vector<AdductInfo>::const_iterator it = it_s; it != it_e; ++it)
+    for (std::vector<AdductInfo>::const_iterator it = adducts.begin(); it != adducts.end(); ++it)
     {
       if (observed_charge != 0 && (std::abs(observed_charge) != std::abs(it->getCharge())))
       { // charge of evidence and adduct must match in absolute terms (absolute, since any FeatureFinder gives only positive charges, even for negative-mode spectra)
@@ -597,87 +586,183 @@ namespace OpenMS
 
       // get potential hits as indices in masskey_table
       double neutral_mass = it->getNeutralMass(observed_mz); // calculate mass of uncharged small molecule without adduct mass
-
-      // Our database is just a set of neutral masses (i.e., without adducts)
-      // However, given is either an absolute m/z tolerance or a ppm tolerance for the observed m/z
-      // We now need an upper bound on the absolute allowed mass difference, given the above tolerance in m/z.
-      // The selected candidates then have an mass tolerance which corresponds to the user's m/z tolerance.
-      // (the other approach is to precompute m/z values for all combinations of adducts, charges and DB entries -- too much)
-      double diff_mz;
-      // check if mass error window is given in ppm or Da
-      if (mass_error_unit_ == "ppm")
-      {
-        // convert ppm to absolute m/z tolerance for the current candidate
-        diff_mz = (observed_mz / 1e6) * mass_error_value_;
-      }
-      else
-      {
-        diff_mz = mass_error_value_;
-      }
-      // convert absolute m/z diff to absolute mass diff
-      // What about the adduct?
-      // absolute mass error: the adduct itself is irrelevant here since its a constant for both the theoretical and observed mass
-      //       ppm tolerance: the diff_mz accounts for it already (heavy adducts lead to larger m/z tolerance)
-      double diff_mass = diff_mz * std::abs(it->getCharge()); // do not use observed charge (could be 0=unknown)
+      double diff_mass = getMassTolerance_(observed_mz, *it);
 
       searchMass_(neutral_mass, diff_mass, hit_idx);
 
       //std::cerr << ion_mode_internal_ << " adduct: " << adduct_name << ", " << adduct_mass << " Da, " << query_mass << " qm(against DB), " << charge << " q\n";
 
       // store information from query hits in AccurateMassSearchResult objects
-      for (Size i = hit_idx.first; i < hit_idx.second; ++i)
+      appendHits_(observed_mz, neutral_mass, *it, hit_idx, results);
+    }
+
+    // if result is empty, add a 'not-found' indicator if empty hits should be stored
+    if (results.empty() && keep_unidentified_masses_)
+    {
+      appendUnidentified_(observed_mz, observed_charge, results);
+    }
+
+    return;
+  }
+
+  void AccurateMassSearchEngine::queryByMZs(const std::vector<double>& observed_mzs, const std::vector<Int>& observed_charges, const String& ion_mode, std::vector<std::vector<AccurateMassSearchResult> >& results) const
+  {
+    OPENMS_PROFILE_SCOPE("AccurateMassSearchEngine::queryByMZs");
+    if (!is_initialized_)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "AccurateMassSearchEngine::init() was not called!");
+    }
+    if (observed_mzs.size() != observed_charges.size())
+    {
+      throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, observed_charges.size());
+    }
+
+    const std::vector<AdductInfo>& adducts = getAdducts_(ion_mode);
+
+    results.clear();
+    results.resize(observed_mzs.size());
+    if (observed_mzs.empty()) return;
+    if (masses_.empty())
+    {
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "There are no entries found in mass-to-ids mapping file! Aborting... ", "0");
+    }
+
+    // process the queries in order of increasing m/z: the tolerance windows then move monotonically through the sorted database
+    std::vector<Size> order(observed_mzs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&observed_mzs](Size a, Size b) { return observed_mzs[a] < observed_mzs[b]; });
+
+    const Size db_size = masses_.size();
+    for (std::vector<AdductInfo>::const_iterator it = adducts.begin(); it != adducts.end(); ++it)
+    {
+      std::pair<Size, Size> hit_idx(0, 0);
+      for (Size q : order)
       {
-        // check if DB entry is compatible to the adduct
-        if (!it->isCompatible(EmpiricalFormula(mass_mappings_[i].formula)))
+        const double observed_mz = observed_mzs[q];
+        const Int observed_charge = observed_charges[q];
+        if (observed_charge != 0 && (std::abs(observed_charge) != std::abs(it->getCharge())))
         {
-          // only written if TOPP tool has --debug
-          OPENMS_LOG_DEBUG << "'" << mass_mappings_[i].formula << "' cannot have adduct '" << it->getName() << "'. Omitting.\n";
           continue;
         }
 
-        // compute ppm errors
-        double db_mass = mass_mappings_[i].mass;
-        double theoretical_mz = it->getMZ(db_mass);
-        double error_ppm_mz = Math::getPPM(observed_mz, theoretical_mz); // negative values are allowed!
-
-        AccurateMassSearchResult ams_result;
-        ams_result.setObservedMZ(observed_mz);
-        ams_result.setCalculatedMZ(theoretical_mz);
-        ams_result.setQueryMass(neutral_mass);
-        ams_result.setFoundMass(db_mass);
-        ams_result.setCharge(std::abs(it->getCharge())); // use theoretical adducts charge (is always valid); native charge might be zero
-        ams_result.setMZErrorPPM(error_ppm_mz);
-        ams_result.setMatchingIndex(i);
-        ams_result.setFoundAdduct(it->getName());
-        ams_result.setEmpiricalFormula(mass_mappings_[i].formula);
-        ams_result.setMatchingHMDBids(mass_mappings_[i].massIDs);
-
-        results.push_back(ams_result);
-
-        // ams_result.outputResults();
-        // std::cout << "****************************************************" << std::endl;
+        double neutral_mass = it->getNeutralMass(observed_mz);
+        double diff_mass = getMassTolerance_(observed_mz, *it);
+        double lower_mass = neutral_mass - diff_mass;
+        double upper_mass = neutral_mass + diff_mass;
+
+        // first element equal or larger than lower_mass
+        if (hit_idx.first > 0 && masses_[hit_idx.first - 1] >= lower_mass)
+        { // window moved backwards (only for extreme tolerances)
+          hit_idx.first = std::lower_bound(masses_.begin(), masses_.begin() + hit_idx.first, lower_mass) - masses_.begin();
+        }
+        while (hit_idx.first < db_size && masses_[hit_idx.first] < lower_mass) ++hit_idx.first;
+
+        // first element greater than upper_mass
+        hit_idx.second = std::max(hit_idx.second, hit_idx.first);
+        if (hit_idx.second > hit_idx.first && masses_[hit_idx.second - 1] > upper_mass)
+        {
+          hit_idx.second = std::upper_bound(masses_.begin() + hit_idx.first, masses_.begin() + hit_idx.second, upper_mass) - masses_.begin();
+        }
+        while (hit_idx.second < db_size && masses_[hit_idx.second] <= upper_mass) ++hit_idx.second;
+
+        appendHits_(observed_mz, neutral_mass, *it, hit_idx, results[q]);
       }
+    }
 
+    if (keep_unidentified_masses_)
+    {
+      for (Size q = 0; q < results.size(); ++q)
+      {
+        if (results[q].empty()) appendUnidentified_(observed_mzs[q], observed_charges[q], results[q]);
+      }
     }
+  }
 
-    // if result is empty, add a 'not-found' indicator if empty hits should be stored
-    if (results.empty() && keep_unidentified_masses_)
+  const std::vector<AdductInfo>& AccurateMassSearchEngine::getAdducts_(const String& ion_mode) const
+  {
+    if (ion_mode == "positive")
+    {
+      return pos_adducts_;
+    }
+    else if (ion_mode == "negative")
+    {
+      return neg_adducts_;
+    }
+    throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("Ion mode cannot be set to '") + ion_mode + "'. Must be 'positive' or 'negative'!");
+  }
+
+  double AccurateMassSearchEngine::getMassTolerance_(double observed_mz, const AdductInfo& adduct) const
+  {
+    // Our database is just a set of neutral masses (i.e., without adducts)
+    // However, given is either an absolute m/z tolerance or a ppm tolerance for the observed m/z
+    // We now need an upper bound on the absolute allowed mass difference, given the above tolerance in m/z.
+    // The selected candidates then have an mass tolerance which corresponds to the user's m/z tolerance.
+    // (the other approach is to precompute m/z values for all combinations of adducts, charges and DB entries -- too much)
+    double diff_mz;
+    // check if mass error window is given in ppm or Da
+    if (mass_error_unit_ == "ppm")
+    {
+      // convert ppm to absolute m/z tolerance for the current candidate
+      diff_mz = (observed_mz / 1e6) * mass_error_value_;
+    }
+    else
     {
+      diff_mz = mass_error_value_;
+    }
+    // convert absolute m/z diff to absolute mass diff
+    // What about the adduct?
+    // absolute mass error: the adduct itself is irrelevant here since its a constant for both the theoretical and observed mass
+    //       ppm tolerance: the diff_mz accounts for it already (heavy adducts lead to larger m/z tolerance)
+    return diff_mz * std::abs(adduct.getCharge()); // do not use observed charge (could be 0=unknown)
+  }
+
+  void AccurateMassSearchEngine::appendHits_(double observed_mz, double neutral_mass, const AdductInfo& adduct, const std::pair<Size, Size>& hit_indices, std::vector<AccurateMassSearchResult>& results) const
+  {
+    for (Size i = hit_indices.first; i < hit_indices.second; ++i)
+    {
+      // check if DB entry is compatible to the adduct
+      if (!adduct.isCompatible(EmpiricalFormula(mass_mappings_[i].formula)))
+      {
+        // only written if TOPP tool has --debug
+        OPENMS_LOG_DEBUG << "'" << mass_mappings_[i].formula << "' cannot have adduct '" << adduct.getName() << "'. Omitting.\n";
+        continue;
+      }
+
+      // compute ppm errors
+      double db_mass = mass_mappings_[i].mass;
+      double theoretical_mz = adduct.getMZ(db_mass);
+      double error_ppm_mz = Math::getPPM(observed_mz, theoretical_mz); // negative values are allowed!
+
       AccurateMassSearchResult ams_result;
       ams_result.setObservedMZ(observed_mz);
-      ams_result.setCalculatedMZ(std::numeric_limits<double>::quiet_NaN());
-      ams_result.setQueryMass(std::numeric_limits<double>::quiet_NaN());
-      ams_result.setFoundMass(std::numeric_limits<double>::quiet_NaN());
-      ams_result.setCharge(observed_charge);
-      ams_result.setMZErrorPPM(std::numeric_limits<double>::quiet_NaN());
-      ams_result.setMatchingIndex(-1); // this is checked to identify 'not-found'
-      ams_result.setFoundAdduct("null");
-      ams_result.setEmpiricalFormula("");
-      ams_result.setMatchingHMDBids(std::vector<String>(1, "null"));
+      ams_result.setCalculatedMZ(theoretical_mz);
+      ams_result.setQueryMass(neutral_mass);
+      ams_result.setFoundMass(db_mass);
+      ams_result.setCharge(std::abs(adduct.getCharge())); // use theoretical adducts charge (is always valid); native charge might be zero
+      ams_result.setMZErrorPPM(error_ppm_mz);
+      ams_result.setMatchingIndex(i);
+      ams_result.setFoundAdduct(adduct.getName());
+      ams_result.setEmpiricalFormula(mass_mappings_[i].formula);
+      ams_result.setMatchingHMDBids(mass_mappings_[i].massIDs);
+
       results.push_back(ams_result);
     }
+  }
 
-    return;
+  void AccurateMassSearchEngine::appendUnidentified_(double observed_mz, Int observed_charge, std::vector<AccurateMassSearchResult>& results) const
+  {
+    AccurateMassSearchResult ams_result;
+    ams_result.setObservedMZ(observed_mz);
+    ams_result.setCalculatedMZ(std::numeric_limits<double>::quiet_NaN());
+    ams_result.setQueryMass(std::numeric_limits<double>::quiet_NaN());
+    ams_result.setFoundMass(std::numeric_limits<double>::quiet_NaN());
+    ams_result.setCharge(observed_charge);
+    ams_result.setMZErrorPPM(std::numeric_limits<double>::quiet_NaN());
+    ams_result.setMatchingIndex(-1); // this is checked to identify 'not-found'
+    ams_result.setFoundAdduct("null");
+    ams_result.setEmpiricalFormula("");
+    ams_result.setMatchingHMDBids(std::vector<String>(1, "null"));
+    results.push_back(ams_result);
   }
 
   void AccurateMassSearchEngine::queryByFeature(const Feature& feature, const Size& feature_index, const String& ion_mode, std::vector<AccurateMassSearchResult>& results) const
@@ -775,6 +860,7 @@ namespace OpenMS
 
   void AccurateMassSearchEngine::run(FeatureMap& fmap, MzTab& mztab_out) const
   {
+    OPENMS_PROFILE_SCOPE("AccurateMassSearchEngine::runFeatureMap");
     if (!is_initialized_)
     {
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "AccurateMassSearchEngine::init() was not called!");
@@ -786,25 +872,25 @@ namespace OpenMS
       ion_mode_internal = resolveAutoMode_(fmap);
     }
 
-    // map for storing overall results
-    QueryResultsTable overall_results;
-    Size dummy_count(0);
-    for (Size i = 0; i < fmap.size(); ++i)
+    // query all features in parallel (the database is only read); annotation of the map is done afterwards
+    QueryResultsTable query_results_all(fmap.size());
+    ParallelExecution::forEach(0, (SignedSize)fmap.size(), [&](SignedSize i)
     {
-      std::vector<AccurateMassSearchResult> query_results;
+      std::vector<AccurateMassSearchResult>& query_results = query_results_all[i];
 
       // std::cout << i << ": " << fmap[i].getMetaValue(3) << " mass: " << fmap[i].getMZ() << " num_traces: " << fmap[i].getMetaValue("num_of_masstraces") << " charge: " << fmap[i].getCharge() << std::endl;
       queryByFeature(fmap[i], i, ion_mode_internal, query_results);
 
-      if (query_results.size() == 0) continue; // cannot happen if a 'not-found' dummy was added
+      if (query_results.size() == 0) return; // cannot happen if a 'not-found' dummy was added
 
       bool is_dummy = (query_results[0].getMatchingIndex() == (Size)-1);
-      if (is_dummy) ++dummy_count;
-
       if (iso_similarity_ && !is_dummy)
       {
         if (!fmap[i].metaValueExists("num_of_masstraces"))
         {
+#ifdef _OPENMP
+#pragma omp critical (LOG_WARN_access)
+#endif
           OPENMS_LOG_WARN << "Feature does not contain meta value 'num_of_masstraces'. Cannot compute isotope similarity.";
         }
         else if ((Size)fmap[i].getMetaValue("num_of_masstraces") > 1)
@@ -818,6 +904,18 @@ namespace OpenMS
           }
         }
       }
+    }, ParallelExecution::Schedule::DYNAMIC, 100);
+
+    // map for storing overall results
+    QueryResultsTable overall_results;
+    Size dummy_count(0);
+    for (Size i = 0; i < fmap.size(); ++i)
+    {
+      const std::vector<AccurateMassSearchResult>& query_results = query_results_all[i];
+      if (query_results.size() == 0) continue; // cannot happen if a 'not-found' dummy was added
+
+      bool is_dummy = (query_results[0].getMatchingIndex() == (Size)-1);
+      if (is_dummy) ++dummy_count;
 
       // debug output
       //        for (Size hit_idx = 0; hit_idx < query_results.size(); ++hit_idx)
@@ -886,6 +984,7 @@ namespace OpenMS
 
   void AccurateMassSearchEngine::run(ConsensusMap& cmap, MzTab& mztab_out)  const
   {
+    OPENMS_PROFILE_SCOPE("AccurateMassSearchEngine::runConsensusMap");
     if (!is_initialized_)
     {
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "AccurateMassSearchEngine::init() was not called!");
@@ -901,15 +1000,16 @@ namespace OpenMS
     Size num_of_maps = fd_map.size();
 
     // map for storing overall results
-    QueryResultsTable overall_results;
+    QueryResultsTable overall_results(cmap.size());
+    ParallelExecution::forEach(0, (SignedSize)cmap.size(), [&](SignedSize i)
+    {
+      // std::cout << i << ": " << cmap[i].getMetaValue(3) << " mass: " << cmap[i].getMZ() << " num_traces: " << cmap[i].getMetaValue("num_of_masstraces") << " charge: " << cmap[i].getCharge() << std::endl;
+      queryByConsensusFeature(cmap[i], i, num_of_maps, ion_mode_internal, overall_results[i]);
+    }, ParallelExecution::Schedule::DYNAMIC, 100);
 
     for (Size i = 0; i < cmap.size(); ++i)
     {
-      std::vector<AccurateMassSearchResult> query_results;
-      // std::cout << i << ": " << cmap[i].getMetaValue(3) << " mass: " << cmap[i].getMZ() << " num_traces: " << cmap[i].getMetaValue("num_of_masstraces") << " charge: " << cmap[i].getCharge() << std::endl;
-      queryByConsensusFeature(cmap[i], i, num_of_maps, ion_mode_internal, query_results);
-      annotate_(query_results, cmap[i]);
-      overall_results.push_back(query_results);
+      annotate_(overall_results[i], cmap[i]);
     }
     // add dummy protein identification which is required to keep peptidehits alive during store()
     cmap.getProteinIdentifications().resize(cmap.getProteinIdentifications().size() + 1);
@@ -1280,6 +1380,7 @@ namespace OpenMS
   void AccurateMassSearchEngine::parseMappingFile_(const StringList& db_mapping_file)
   {
     mass_mappings_.clear();
+    masses_.clear();
 
     // load map_fname mapping file
     for (StringList::const_iterator it_f = db_mapping_file.begin(); it_f != db_mapping_file.end(); ++it_f)
@@ -1378,6 +1479,12 @@ namespace OpenMS
       }
     }
     std::sort(mass_mappings_.begin(), mass_mappings_.end(), CompareEntryAndMass_());
+    masses_.clear();
+    masses_.reserve(mass_mappings_.size());
+    for (const MappingEntry_& entry : mass_mappings_)
+    {
+      masses_.push_back(entry.mass);
+    }
 
     OPENMS_LOG_INFO << "Read " << mass_mappings_.size() << " entries from mapping file!" << std::endl;
 
@@ -1460,17 +1567,17 @@ namespace OpenMS
     //OPENMS_LOG_INFO << "searchMass: neutral_query_mass=" << neutral_query_mass << " diff_mz=" << diff_mz << " ppm allowed:" << mass_error_value_ << std::endl;
 
     // binary search for formulas which are within diff_mz distance
-    if (mass_mappings_.empty())
+    if (masses_.empty())
     {
       throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "There are no entries found in mass-to-ids mapping file! Aborting... ", "0");
     }
 
-    std::vector<MappingEntry_>::const_iterator lower_it = std::lower_bound(mass_mappings_.begin(), mass_mappings_.end(), neutral_query_mass - diff_mass, CompareEntryAndMass_()); // first element equal or larger
-    std::vector<MappingEntry_>::const_iterator upper_it = std::upper_bound(mass_mappings_.begin(), mass_mappings_.end(), neutral_query_mass + diff_mass, CompareEntryAndMass_()); // first element greater than
+    // search the contiguous mass array (same order as mass_mappings_), not the (large) mapping entries
+    std::vector<double>::const_iterator lower_it = std::lower_bound(masses_.begin(), masses_.end(), neutral_query_mass - diff_mass); // first element equal or larger
+    std::vector<double>::const_iterator upper_it = std::upper_bound(lower_it, masses_.end(), neutral_query_mass + diff_mass); // first element greater than
 
-    //std::cout << *lower_it << " " << *upper_it << "idx: " << lower_it - masskey_table_.begin() << " " << upper_it - masskey_table_.begin() << std::endl;
-    Size start_idx = std::distance(mass_mappings_.begin(), lower_it);
-    Size end_idx = std::distance(mass_mappings_.begin(), upper_it);
+    Size start_idx = std::distance(masses_.begin(), lower_it);
+    Size end_idx = std::distance(masses_.begin(), upper_it);
 
     hit_indices.first = start_idx;
     hit_indices.second = end_idx;
@@ -1511,7 +1618,7 @@ namespace OpenMS
     Size common_size = std::min(num_traces, MAX_THEORET_ISOS);
 
     // compute theoretical isotope distribution
-    IsotopeDistribution iso_dist(form.getIsotopeDistribution(CoarseIsotopePatternGenerator((UInt)common_size)));
+    IsotopeDistribution iso_dist(CoarseIsotopePatternCache::getInstance()->getIsotopeDistribution(form, common_size));
     std::vector<double> theoretical_iso_dist;
     std::transform(
       iso_dist.begin(),
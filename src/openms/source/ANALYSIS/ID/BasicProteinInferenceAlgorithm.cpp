@@ -75,12 +75,7 @@ namespace OpenMS
   {
     Size min_peptides_per_protein = static_cast<Size>(param_.getValue("min_peptides_per_protein"));
 
-    std::unordered_map<std::string, std::map<Int, PeptideHit*>> best_pep;
-    std::unordered_map<std::string, std::pair<ProteinHit*, Size>> acc_to_protein_hitP_and_count;
-
     processRun_(
-        acc_to_protein_hitP_and_count,
-        best_pep,
         prot_id,
         pep_ids,
         min_peptides_per_protein
@@ -100,14 +95,9 @@ namespace OpenMS
   {
     Size min_peptides_per_protein = static_cast<Size>(param_.getValue("min_peptides_per_protein"));
 
-    std::unordered_map<std::string, std::map<Int, PeptideHit*>> best_pep;
-    std::unordered_map<std::string, std::pair<ProteinHit*, Size>> acc_to_protein_hitP_and_count;
-
     for (auto &prot_run : prot_ids)
     {
       processRun_(
-          acc_to_protein_hitP_and_count,
-          best_pep,
           prot_run,
           pep_ids,
           min_peptides_per_protein
@@ -120,9 +110,36 @@ namespace OpenMS
     }
   }
 
+  namespace
+  {
+    /// best PSMs per peptide (key: (un)modified sequence), in order of first occurrence
+    struct BestPeptides_
+    {
+      std::unordered_map<String, Size> index;
+      std::vector<std::map<Int, PeptideHit*>> by_charge; ///< charge (0 when unconsidered) -> best PSM
+
+      /// records @p hit if it is the first or a better PSM for its sequence/charge
+      void update(const String& seq, Int charge, PeptideHit* hit, bool higher_better)
+      {
+        auto ins = index.emplace(seq, by_charge.size());
+        if (ins.second) by_charge.emplace_back();
+        std::map<Int, PeptideHit*>& entry = by_charge[ins.first->second];
+        auto charge_it = entry.find(charge);
+        if (charge_it == entry.end())
+        {
+          entry[charge] = hit;
+        }
+        else if (
+            (higher_better && (hit->getScore() > charge_it->second->getScore())) ||
+            (!higher_better && (hit->getScore() < charge_it->second->getScore())))
+        {
+          charge_it->second = hit;
+        }
+      }
+    };
+  }
+
   void BasicProteinInferenceAlgorithm::processRun_(
-      std::unordered_map<std::string, std::pair<ProteinHit*, Size>>& acc_to_protein_hitP_and_count,
-      std::unordered_map<std::string, std::map<Int, PeptideHit*>>& best_pep,
       ProteinIdentification& prot_run,
       std::vector<PeptideIdentification>& pep_ids,
       Size min_peptides_per_protein) const
@@ -152,10 +169,6 @@ namespace OpenMS
       aggregation_method = AggregationMethod::SUM;
     }
 
-    //TODO think about only clearing values or using a big map for all runs together
-    acc_to_protein_hitP_and_count.clear();
-    best_pep.clear();
-
     prot_run.setInferenceEngine("TOPPProteinInference");
     prot_run.setInferenceEngineVersion(VersionInfo::getVersion());
     ProteinIdentification::SearchParameters sp = prot_run.getSearchParameters();
@@ -179,12 +192,22 @@ namespace OpenMS
        break;
     }
 
-    //create Accession to ProteinHit and peptide count map. To have quick access later.
+    //create Accession to ProteinHit index map (interned accessions), scores and peptide counts are aggregated by index.
     //If a protein occurs in multiple runs, it picks the last
-    for (auto &phit : prot_run.getHits())
+    std::vector<ProteinHit>& protein_hits = prot_run.getHits();
+    std::unordered_map<String, Size> acc_to_protein_index;
+    acc_to_protein_index.reserve(protein_hits.size());
+    for (Size i = 0; i < protein_hits.size(); ++i)
+    {
+      acc_to_protein_index[protein_hits[i].getAccession()] = i;
+      protein_hits[i].setScore(initScore);
+    }
+    std::vector<double> protein_scores(protein_hits.size(), initScore);
+    std::vector<Size> protein_counts(protein_hits.size(), 0);
+    std::vector<char> protein_used(protein_hits.size(), false); // referenced by the accession map
+    for (const auto& entry : acc_to_protein_index)
     {
-      acc_to_protein_hitP_and_count[phit.getAccession()] = std::make_pair<ProteinHit*, Size>(&phit, 0);
-      phit.setScore(initScore);
+      protein_used[entry.second] = true;
     }
 
     String overall_score_type = "";
@@ -216,7 +239,7 @@ namespace OpenMS
         || overall_score_type != "pep" // from Percolator
         || overall_score_type != "MS:1001493"); // from Percolator
 
-    for (auto &pep : pep_ids)
+    for (const auto &pep : pep_ids)
     {
       if (pep.getScoreType() != overall_score_type)
       {
@@ -226,125 +249,149 @@ namespace OpenMS
             OPENMS_PRETTY_FUNCTION,
             "Differing score_types in the PeptideHits. Aborting...");
       }
-      //skip if it does not belong to run
-      if (pep.getIdentifier() != prot_run.getIdentifier())
-        continue;
-      //skip if no hits (which almost could be considered and error or warning.
-      if (pep.getHits().empty())
-        continue;
-      //make sure that first = best hit
-      pep.sort();
-
-      //TODO think about if using any but the best PSM per spectrum makes sense in such a simple aggregation scheme
-      //for (auto& hit : pep.getHits())
-      //{
-      PeptideHit &hit = pep.getHits()[0];
-      //skip if shared and option not enabled
-      //TODO warn if not present but requested?
-      //TODO use nr of evidences to re-calculate sharedness?
-      if (!use_shared_peptides &&
-          (!hit.metaValueExists("protein_references") || (hit.getMetaValue("protein_references") == "non-unique")))
-        continue;
-
-      //TODO refactor: this is very similar to IDFilter best per peptide functionality
-      String lookup_seq;
-      if (!treat_modification_variants_separately)
-      {
-        lookup_seq = hit.getSequence().toUnmodifiedString();
-      }
-      else
-      {
-        lookup_seq = hit.getSequence().toString();
-      }
+    }
 
-      int lookup_charge = 0;
-      if (treat_charge_variants_separately)
+    // find the best PSM per peptide (and charge) in parallel over chunks of
+    // spectra; the chunks are merged in order, so that the result is the same
+    // as for a serial pass (first PSM wins in case of ties)
+    const Size chunk_size = 1024;
+    const Size n_chunks = (pep_ids.size() + chunk_size - 1) / chunk_size;
+    std::vector<BestPeptides_> chunk_best(n_chunks);
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize c = 0; c < (SignedSize)n_chunks; ++c)
+    {
+      const Size end = std::min(pep_ids.size(), (c + 1) * chunk_size);
+      for (Size i = c * chunk_size; i < end; ++i)
       {
-        lookup_charge = hit.getCharge();
+        PeptideIdentification& pep = pep_ids[i];
+        //skip if it does not belong to run
+        if (pep.getIdentifier() != prot_run.getIdentifier())
+          continue;
+        //skip if no hits (which almost could be considered and error or warning.
+        if (pep.getHits().empty())
+          continue;
+        //make sure that first = best hit
+        pep.sort();
+
+        //TODO think about if using any but the best PSM per spectrum makes sense in such a simple aggregation scheme
+        PeptideHit &hit = pep.getHits()[0];
+        //skip if shared and option not enabled
+        //TODO warn if not present but requested?
+        //TODO use nr of evidences to re-calculate sharedness?
+        if (!use_shared_peptides &&
+            (!hit.metaValueExists("protein_references") || (hit.getMetaValue("protein_references") == "non-unique")))
+          continue;
+
+        //TODO refactor: this is very similar to IDFilter best per peptide functionality
+        String lookup_seq;
+        if (!treat_modification_variants_separately)
+        {
+          lookup_seq = hit.getSequence().toUnmodifiedString();
+        }
+        else
+        {
+          lookup_seq = hit.getSequence().toString();
+        }
+
+        int lookup_charge = 0;
+        if (treat_charge_variants_separately)
+        {
+          lookup_charge = hit.getCharge();
+        }
+
+        chunk_best[c].update(lookup_seq, lookup_charge, &hit, higher_better);
       }
+    }
 
-      auto current_best_pep_it = best_pep.find(lookup_seq);
-      if (current_best_pep_it == best_pep.end())
+    BestPeptides_ best_pep;
+    for (BestPeptides_& chunk : chunk_best)
+    {
+      std::vector<const String*> seqs(chunk.by_charge.size());
+      for (const auto& entry : chunk.index)
       {
-        auto &new_entry = best_pep[lookup_seq];
-        new_entry = std::map<Int, PeptideHit *>();
-        new_entry[lookup_charge] = &hit;
+        seqs[entry.second] = &entry.first;
       }
-      else
+      for (Size k = 0; k < seqs.size(); ++k)
       {
-        auto current_best_pep_charge_it = current_best_pep_it->second.find(lookup_charge);
-        if (current_best_pep_charge_it == current_best_pep_it->second.end())
-        {
-          current_best_pep_it->second[lookup_charge] = &hit;
-        }
-        else if (
-            (higher_better && (hit.getScore() > current_best_pep_charge_it->second->getScore())) ||
-            (!higher_better && (hit.getScore() < current_best_pep_charge_it->second->getScore())))
+        for (const auto& pep_hit : chunk.by_charge[k])
         {
-          current_best_pep_charge_it->second = &hit;
+          best_pep.update(*seqs[k], pep_hit.first, pep_hit.second, higher_better);
         }
       }
-      //}
+      chunk = BestPeptides_(); // free memory
     }
 
-    // update protein scores
-    for (const auto &charge_to_pep_hit_map : best_pep)
+    // resolve the proteins of each peptide in parallel
+    // (Size(-1): accession not found in the protein hits)
+    // The next step assumes that PeptideHits of different charge states necessarily share the same
+    // protein accessions
+    // TODO this could be done for mods, too (first hashing AASeq, then the mods)
+    std::vector<std::vector<Size>> peptide_proteins(best_pep.by_charge.size());
+#pragma omp parallel for schedule(dynamic, 256)
+    for (SignedSize k = 0; k < (SignedSize)best_pep.by_charge.size(); ++k)
     {
-      // The next line assumes that PeptideHits of different charge states necessarily share the same
-      // protein accessions
-      // TODO this could be done for mods, too (first hashing AASeq, then the mods)
-      for (const auto &acc : charge_to_pep_hit_map.second.begin()->second->extractProteinAccessionsSet())
+      for (const auto &acc : best_pep.by_charge[k].begin()->second->extractProteinAccessionsSet())
       {
-        for (const auto &pep_hit : charge_to_pep_hit_map.second)
+        auto prot_it = acc_to_protein_index.find(acc);
+        peptide_proteins[k].push_back(prot_it == acc_to_protein_index.end() ? Size(-1) : prot_it->second);
+      }
+    }
+
+    // update protein scores (serially, in order of the peptides' first occurrence)
+    for (Size k = 0; k < best_pep.by_charge.size(); ++k)
+    {
+      for (Size prot_idx : peptide_proteins[k])
+      {
+        for (const auto &pep_hit : best_pep.by_charge[k])
         {
-          auto prot_count_pair_it = acc_to_protein_hitP_and_count.find(std::string(acc));
-          if (prot_count_pair_it == acc_to_protein_hitP_and_count.end())
+          if (prot_idx == Size(-1))
           {
             std::cout << "Warning, skipping pep that maps to a non existent protein accession. " << pep_hit.second->getSequence().toUnmodifiedString() << std::endl;
             continue; // very weird, has an accession that was not in the proteins loaded in the beginning
             //TODO error? Suppress log?
           }
 
-          ProteinHit *protein = prot_count_pair_it->second.first;
-          prot_count_pair_it->second.second++;
+          protein_counts[prot_idx]++;
 
           double new_score = pep_hit.second->getScore();
 
           if (!higher_better && pep_scores) // convert PEP to PP
             new_score = 1. - new_score;
 
+          double& score = protein_scores[prot_idx];
           switch (aggregation_method)
           {
-            //TODO Why are protein scores just floats???
             case AggregationMethod::PROD :
               if (new_score > 0.0) //TODO for 0 probability peptides we could also multiply a minimum value
-                protein->setScore(protein->getScore() * new_score);
+                score *= new_score;
               break;
             case AggregationMethod::SUM :
-              protein->setScore(protein->getScore() + new_score);
+              score += new_score;
               break;
             case AggregationMethod::MAXIMUM :
-              protein->setScore(std::fmax(double(protein->getScore()), new_score));
+              score = std::fmax(score, new_score);
               break;
           }
         }
       }
     }
-    if (!skip_count_annotation)
+
+    for (Size i = 0; i < protein_hits.size(); ++i)
     {
-      for (auto& entry : acc_to_protein_hitP_and_count)
+      if (!protein_used[i]) continue; // duplicate accession, the last one is used
+      ProteinHit& phit = protein_hits[i];
+      if (!skip_count_annotation)
       {
-        entry.second.first->setMetaValue("nr_found_peptides", entry.second.second);
+        phit.setMetaValue("nr_found_peptides", protein_counts[i]);
       }
-    }
-
-    //normalize in case of SUM
-    if (aggregation_method == AggregationMethod::SUM)
-    {
-      for (auto& entry : acc_to_protein_hitP_and_count)
+      //normalize in case of SUM
+      if (aggregation_method == AggregationMethod::SUM)
+      {
+        phit.setScore(protein_scores[i] / protein_counts[i]);
+      }
+      else
       {
-        ProteinHit* phitp = entry.second.first;
-        phitp->setScore(phitp->getScore() / entry.second.second);
+        phit.setScore(protein_scores[i]);
       }
     }
 
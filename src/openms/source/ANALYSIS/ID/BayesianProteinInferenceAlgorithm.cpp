@@ -64,11 +64,45 @@ namespace OpenMS
     unsigned int debug_lvl_;
     unsigned long cnt_;
 
+    // Parameters are parsed once here instead of on every call since the functor is usually
+    // applied to thousands of tiny connected components.
+    bool update_PSM_probabilities_;
+    bool annotate_group_posterior_;
+    bool user_defined_priors_;
+    bool regularize_;
+    double pnorm_;
+    double pep_emission_;
+    double pep_spurious_emission_;
+    double prot_prior_;
+    double pep_prior_;
+    unsigned long max_messages_;
+    double dampening_lambda_;
+    double convergence_threshold_;
+    String scheduler_type_;
+
     explicit GraphInferenceFunctor(const Param& param, unsigned int debug_lvl):
         param_(param),
         debug_lvl_(debug_lvl),
-        cnt_(0)
-    {}
+        cnt_(0),
+        update_PSM_probabilities_(param.getValue("update_PSM_probabilities").toBool()),
+        annotate_group_posterior_(param.getValue("annotate_group_probabilities").toBool()),
+        user_defined_priors_(param.getValue("user_defined_priors").toBool()),
+        regularize_(param.getValue("model_parameters:regularize").toBool()),
+        pnorm_(param.getValue("loopy_belief_propagation:p_norm_inference")),
+        pep_emission_(param.getValue("model_parameters:pep_emission")),
+        pep_spurious_emission_(param.getValue("model_parameters:pep_spurious_emission")),
+        prot_prior_(param.getValue("model_parameters:prot_prior")),
+        pep_prior_(param.getValue("model_parameters:pep_prior")),
+        max_messages_(param.getValue("loopy_belief_propagation:max_nr_iterations")),
+        dampening_lambda_(param.getValue("loopy_belief_propagation:dampening_lambda")),
+        convergence_threshold_(param.getValue("loopy_belief_propagation:convergence_threshold")),
+        scheduler_type_(param.getValue("loopy_belief_propagation:scheduling_type"))
+    {
+      if (pnorm_ <= 0)
+      {
+        pnorm_ = std::numeric_limits<double>::infinity();
+      }
+    }
 
     unsigned long operator() (IDBoostGraph::Graph& fg, unsigned int idx) {
       //TODO do quick bruteforce calculation if the cc is really small?
@@ -88,21 +122,12 @@ namespace OpenMS
         }
 
         bool graph_mp_ownership_acquired = false;
-        bool update_PSM_probabilities = param_.getValue("update_PSM_probabilities").toBool();
-        bool annotate_group_posterior = param_.getValue("annotate_group_probabilities").toBool();
-        bool user_defined_priors = param_.getValue("user_defined_priors").toBool();
-        bool regularize = param_.getValue("model_parameters:regularize").toBool();
-        double pnorm = param_.getValue("loopy_belief_propagation:p_norm_inference");
-        if (pnorm <= 0)
-        {
-          pnorm = std::numeric_limits<double>::infinity();
-        }
 
-        MessagePasserFactory<IDBoostGraph::vertex_t> mpf (param_.getValue("model_parameters:pep_emission"),
-                                                 param_.getValue("model_parameters:pep_spurious_emission"),
-                                                 param_.getValue("model_parameters:prot_prior"),
-                                                 pnorm,
-                                                 param_.getValue("model_parameters:pep_prior")); // the p used for marginalization: 1 = sum product, inf = max product
+        MessagePasserFactory<IDBoostGraph::vertex_t> mpf (pep_emission_,
+                                                 pep_spurious_emission_,
+                                                 prot_prior_,
+                                                 pnorm_,
+                                                 pep_prior_); // the p used for marginalization: 1 = sum product, inf = max product
         evergreen::BetheInferenceGraphBuilder<IDBoostGraph::vertex_t> bigb;
 
         IDBoostGraph::Graph::vertex_iterator ui, ui_end;
@@ -145,7 +170,7 @@ namespace OpenMS
 
             if (fg[*ui].which() == 6) // pep hit = psm
             {
-              if (regularize)
+              if (regularize_)
               {
                 bigb.insert_dependency(mpf.createRegularizingSumEvidenceFactor(boost::get<PeptideHit *>(fg[*ui])
                                                                                    ->getPeptideEvidences().size(), in[0], *ui));
@@ -158,7 +183,7 @@ namespace OpenMS
 
               bigb.insert_dependency(mpf.createPeptideEvidenceFactor(*ui,
                                                                      boost::get<PeptideHit *>(fg[*ui])->getScore()));
-              if (update_PSM_probabilities)
+              if (update_PSM_probabilities_)
               {
                 posteriorVars.push_back({*ui});
               }
@@ -170,7 +195,7 @@ namespace OpenMS
             else if (fg[*ui].which() == 1) // prot group
             {
               bigb.insert_dependency(mpf.createPeptideProbabilisticAdderFactor(in, *ui));
-              if (annotate_group_posterior)
+              if (annotate_group_posterior_)
               {
                 posteriorVars.push_back({*ui});
               }
@@ -179,7 +204,7 @@ namespace OpenMS
             {
               //TODO modify createProteinFactor to start with a modified prior based on the number of missing
               // peptides (later tweak to include conditional prob. for that peptide
-              if (user_defined_priors)
+              if (user_defined_priors_)
               {
                 bigb.insert_dependency(mpf.createProteinFactor(*ui,
                                                                (double) boost::get<ProteinHit *>(fg[*ui])
@@ -197,43 +222,34 @@ namespace OpenMS
           evergreen::InferenceGraph <IDBoostGraph::vertex_t> ig = bigb.to_graph();
           graph_mp_ownership_acquired = true;
 
-          unsigned long maxMessages = param_
-              .getValue("loopy_belief_propagation:max_nr_iterations");
-          double initDampeningLambda = param_
-              .getValue("loopy_belief_propagation:dampening_lambda");
-          double initConvergenceThreshold = param_.getValue(
-              "loopy_belief_propagation:convergence_threshold");
-          String scheduler_type = param_.getValue(
-              "loopy_belief_propagation:scheduling_type");
-
           evergreen::Scheduler<IDBoostGraph::vertex_t>* scheduler;
-          if (scheduler_type == "priority")
+          if (scheduler_type_ == "priority")
           {
              scheduler =
-                new evergreen::PriorityScheduler<IDBoostGraph::vertex_t>(initDampeningLambda,
-                                                                     initConvergenceThreshold,
-                                                                     maxMessages);
+                new evergreen::PriorityScheduler<IDBoostGraph::vertex_t>(dampening_lambda_,
+                                                                     convergence_threshold_,
+                                                                     max_messages_);
           }
-          else if (scheduler_type == "subtree")
+          else if (scheduler_type_ == "subtree")
           {
             scheduler =
-                new evergreen::RandomSubtreeScheduler<IDBoostGraph::vertex_t>(initDampeningLambda,
-                                                                          initConvergenceThreshold,
-                                                                          maxMessages);
+                new evergreen::RandomSubtreeScheduler<IDBoostGraph::vertex_t>(dampening_lambda_,
+                                                                          convergence_threshold_,
+                                                                          max_messages_);
           }
-          else if (scheduler_type == "fifo")
+          else if (scheduler_type_ == "fifo")
           {
             scheduler =
-                new evergreen::FIFOScheduler<IDBoostGraph::vertex_t>(initDampeningLambda,
-                                                                 initConvergenceThreshold,
-                                                                 maxMessages);
+                new evergreen::FIFOScheduler<IDBoostGraph::vertex_t>(dampening_lambda_,
+                                                                 convergence_threshold_,
+                                                                 max_messages_);
           }
           else
           {
             scheduler =
-                new evergreen::PriorityScheduler<IDBoostGraph::vertex_t>(initDampeningLambda,
-                                                                     initConvergenceThreshold,
-                                                                     maxMessages);
+                new evergreen::PriorityScheduler<IDBoostGraph::vertex_t>(dampening_lambda_,
+                                                                     convergence_threshold_,
+                                                                     max_messages_);
           }
           scheduler->add_ab_initio_edges(ig);
 
@@ -241,19 +257,19 @@ namespace OpenMS
 
           vector<evergreen::LabeledPMF<IDBoostGraph::vertex_t>> posteriorFactors;
           unsigned long nrEdgesSq = nrEdges*nrEdges;
-          if (maxMessages < nrEdgesSq * 3ul)
+          if (max_messages_ < nrEdgesSq * 3ul)
           {
             posteriorFactors = bpie.estimate_posteriors_in_steps(posteriorVars,
             {
-                std::make_tuple(maxMessages, initDampeningLambda, initConvergenceThreshold)});
+                std::make_tuple(max_messages_, dampening_lambda_, convergence_threshold_)});
           }
           else
           {
             posteriorFactors = bpie.estimate_posteriors_in_steps(posteriorVars,
             {
-                std::make_tuple(std::max<unsigned long>(10000ul, nrEdgesSq*2ul), initDampeningLambda, initConvergenceThreshold),
-                std::make_tuple(nrEdgesSq, std::min(0.49,initDampeningLambda*10), std::min(0.01,initConvergenceThreshold*10)),
-                std::make_tuple(nrEdgesSq/2ul, std::min(0.49,initDampeningLambda*100), std::min(0.01,initConvergenceThreshold*100))
+                std::make_tuple(std::max<unsigned long>(10000ul, nrEdgesSq*2ul), dampening_lambda_, convergence_threshold_),
+                std::make_tuple(nrEdgesSq, std::min(0.49,dampening_lambda_*10), std::min(0.01,convergence_threshold_*10)),
+                std::make_tuple(nrEdgesSq/2ul, std::min(0.49,dampening_lambda_*100), std::min(0.01,convergence_threshold_*100))
             });
           }
 
@@ -308,7 +324,7 @@ namespace OpenMS
             ofs.open ("failed_cc_a"+ String(param_.getValue("model_parameters:pep_emission")) +
                 "_b" + String(param_.getValue("model_parameters:pep_spurious_emission")) + "_g" +
                 String(param_.getValue("model_parameters:prot_prior")) + "_c" +
-                String(param_.getValue("model_parameters:pep_prior")) + "_p" + String(pnorm) + "_"
+                String(param_.getValue("model_parameters:pep_prior")) + "_p" + String(pnorm_) + "_"
                 + String(idx) + ".dot"
                 , std::ofstream::out);
             IDBoostGraph::printGraph(ofs, fg);
@@ -34,6 +34,8 @@
 
 #include <OpenMS/ANALYSIS/ID/ConsensusIDAlgorithmPEPMatrix.h>
 
+#include <limits>
+
 using namespace std;
 
 namespace OpenMS
@@ -48,8 +50,6 @@ namespace OpenMS
     defaults_.setMinInt("penalty", 1);
 
     defaultsToParam_();
-
-    ::seqan::resize(rows(alignment_), 2);
   }
 
 
@@ -78,11 +78,85 @@ namespace OpenMS
                                        msg);
     }
 
+    penalty_ = penalty;
+    // best score of each amino acid, for bounds on alignment scores:
+    SeqAnSequence alphabet = "ARNDCQEGHILKMFPSTWYVBZX*";
+    best_scores_.assign(::seqan::ValueSize< ::seqan::AminoAcid>::VALUE, 0);
+    for (Size i = 0; i < ::seqan::length(alphabet); ++i)
+    {
+      int best = std::numeric_limits<int>::min();
+      for (Size j = 0; j < ::seqan::length(alphabet); ++j)
+      {
+        best = max(best, int(::seqan::score(scoring_method_, alphabet[i], alphabet[j])));
+      }
+      best_scores_[::seqan::ordValue(alphabet[i])] = best;
+    }
+
     // new parameters may affect the similarity calculation, so clear cache:
     similarities_.clear();
   }
 
 
+  int ConsensusIDAlgorithmPEPMatrix::bandedAlignmentScore_(
+    const SeqAnSequence& seq1, const SeqAnSequence& seq2, Size band) const
+  {
+    // linear gap costs, rows: seq. 1, columns: seq. 2, diagonal: "j - i"
+    const int m = int(::seqan::length(seq1)), n = int(::seqan::length(seq2));
+    const int lowest = min(0, n - m) - int(band), highest = max(0, n - m) + int(band);
+    const int none = std::numeric_limits<int>::min() / 2; // outside of band
+    vector<int> prev(n + 2, none), cur(n + 2, none);
+    for (int j = 0; j <= min(n, highest); ++j) prev[j] = -penalty_ * j;
+
+    for (int i = 1; i <= m; ++i)
+    {
+      const int j_min = max(0, i + lowest), j_max = min(n, i + highest);
+      if (j_min > 0) cur[j_min - 1] = none;
+      for (int j = j_min; j <= j_max; ++j)
+      {
+        if (j == 0)
+        {
+          cur[0] = -penalty_ * i;
+          continue;
+        }
+        int best = prev[j - 1] + int(::seqan::score(scoring_method_, seq1[i - 1], seq2[j - 1]));
+        best = max(best, prev[j] - penalty_);
+        best = max(best, cur[j - 1] - penalty_);
+        cur[j] = best;
+      }
+      cur[j_max + 1] = none; // not in the band of this row
+      swap(prev, cur);
+    }
+    return prev[n];
+  }
+
+
+  int ConsensusIDAlgorithmPEPMatrix::alignmentScore_(
+    const SeqAnSequence& seq1, const SeqAnSequence& seq2) const
+  {
+    const Size m = ::seqan::length(seq1), n = ::seqan::length(seq2);
+    const Size band = 2;
+    if (band >= max(m, n)) return bandedAlignmentScore_(seq1, seq2, max(m, n));
+
+    int score = bandedAlignmentScore_(seq1, seq2, band);
+    // an alignment leaving the band needs at least "|n - m| + 2 * (band + 1)"
+    // gaps; its aligned pairs can't score more than the best scores of the
+    // residues involved:
+    int max_pairs1 = 0, max_pairs2 = 0;
+    for (Size i = 0; i < m; ++i)
+    {
+      max_pairs1 += max(0, best_scores_[::seqan::ordValue(seq1[i])]);
+    }
+    for (Size j = 0; j < n; ++j)
+    {
+      max_pairs2 += max(0, best_scores_[::seqan::ordValue(seq2[j])]);
+    }
+    const int min_gaps = int(max(m, n) - min(m, n) + 2 * (band + 1));
+    if (score >= min(max_pairs1, max_pairs2) - penalty_ * min_gaps) return score;
+
+    return bandedAlignmentScore_(seq1, seq2, max(m, n)); // full alignment
+  }
+
+
   double ConsensusIDAlgorithmPEPMatrix::getSimilarity_(AASequence seq1,
                                                        AASequence seq2)
   {
@@ -95,25 +169,15 @@ namespace OpenMS
     seq1 = AASequence::fromString(unmod_seq1);
     seq2 = AASequence::fromString(unmod_seq2);
     pair<AASequence, AASequence> seq_pair = make_pair(seq1, seq2);
-    SimilarityCache::iterator pos = similarities_.find(seq_pair);
-    if (pos != similarities_.end()) return pos->second; // score found in cache
-    
-    // use SeqAn similarity scoring:
+    double cached = 0.0;
+    if (lookupSimilarity_(seq_pair, cached)) return cached; // score found in cache
+
+    // alignment-based similarity scoring:
     SeqAnSequence seqan_seq1 = unmod_seq1.c_str();
     SeqAnSequence seqan_seq2 = unmod_seq2.c_str();
-    // seq. 1 against itself:
-    ::seqan::assignSource(row(alignment_, 0), seqan_seq1);
-    ::seqan::assignSource(row(alignment_, 1), seqan_seq1);
-    double score_self1 = globalAlignment(alignment_, scoring_method_,
-                                         ::seqan::NeedlemanWunsch());
-    // seq. 1 against seq. 2:
-    ::seqan::assignSource(row(alignment_, 1), seqan_seq2);
-    double score_sim = globalAlignment(alignment_, scoring_method_, 
-                                       ::seqan::NeedlemanWunsch());
-    // seq. 2 against itself:
-    ::seqan::assignSource(row(alignment_, 0), seqan_seq2);
-    double score_self2 = globalAlignment(alignment_, scoring_method_,
-                                         ::seqan::NeedlemanWunsch());
+    double score_self1 = alignmentScore_(seqan_seq1, seqan_seq1);
+    double score_sim = alignmentScore_(seqan_seq1, seqan_seq2);
+    double score_self2 = alignmentScore_(seqan_seq2, seqan_seq2);
     if (score_sim < 0)
     {
       score_sim = 0;
@@ -122,7 +186,7 @@ namespace OpenMS
     {
       score_sim /= min(score_self1, score_self2); // normalize
     }
-    similarities_[seq_pair] = score_sim; // cache the similarity score
+    cacheSimilarity_(seq_pair, score_sim); // cache the similarity score
 
     return score_sim;
   }
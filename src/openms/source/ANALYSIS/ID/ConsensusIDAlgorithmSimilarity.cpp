@@ -35,6 +35,8 @@
 #include <OpenMS/ANALYSIS/ID/ConsensusIDAlgorithmSimilarity.h>
 #include <OpenMS/CONCEPT/LogStream.h>
 
+#include <exception>
+
 using namespace std;
 
 namespace OpenMS
@@ -45,6 +47,31 @@ namespace OpenMS
   }
 
 
+  bool ConsensusIDAlgorithmSimilarity::lookupSimilarity_(
+    const pair<AASequence, AASequence>& seq_pair, double& similarity) const
+  {
+    bool found = false;
+#pragma omp critical (ConsensusIDAlgorithmSimilarity_cache)
+    {
+      SimilarityCache::const_iterator pos = similarities_.find(seq_pair);
+      if (pos != similarities_.end())
+      {
+        similarity = pos->second;
+        found = true;
+      }
+    }
+    return found;
+  }
+
+
+  void ConsensusIDAlgorithmSimilarity::cacheSimilarity_(
+    const pair<AASequence, AASequence>& seq_pair, double similarity)
+  {
+#pragma omp critical (ConsensusIDAlgorithmSimilarity_cache)
+    similarities_[seq_pair] = similarity;
+  }
+
+
   void ConsensusIDAlgorithmSimilarity::apply_(
     vector<PeptideIdentification>& ids,
     const map<String, String>& se_info,
@@ -63,6 +90,48 @@ namespace OpenMS
       }
     }
 
+    // collect the sequence pairs that need to be compared (each sequence is
+    // scored only for its first occurrence, see below) and compute the
+    // similarities in parallel:
+    vector<pair<const AASequence*, const AASequence*> > seq_pairs;
+    set<AASequence> seen;
+    for (vector<PeptideIdentification>::iterator id1 = ids.begin();
+         id1 != ids.end(); ++id1)
+    {
+      for (const PeptideHit& hit1 : id1->getHits())
+      {
+        if ((results.find(hit1.getSequence()) != results.end()) ||
+            !seen.insert(hit1.getSequence()).second) continue;
+        for (vector<PeptideIdentification>::iterator id2 = ids.begin();
+             id2 != ids.end(); ++id2)
+        {
+          if (id1 == id2) continue;
+          for (const PeptideHit& hit2 : id2->getHits())
+          {
+            seq_pairs.emplace_back(&hit1.getSequence(), &hit2.getSequence());
+          }
+        }
+      }
+    }
+    vector<double> similarities(seq_pairs.size());
+    std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 16) if (seq_pairs.size() >= 64)
+    for (SignedSize i = 0; i < SignedSize(seq_pairs.size()); ++i)
+    {
+      try
+      {
+        similarities[i] = getSimilarity_(*seq_pairs[i].first,
+                                         *seq_pairs[i].second);
+      }
+      catch (...)
+      {
+#pragma omp critical (ConsensusIDAlgorithmSimilarity_error)
+        if (!error) error = std::current_exception();
+      }
+    }
+    if (error) std::rethrow_exception(error);
+    vector<double>::const_iterator next_similarity = similarities.begin();
+
     for (vector<PeptideIdentification>::iterator id1 = ids.begin();
          id1 != ids.end(); ++id1)
     {
@@ -108,8 +177,7 @@ namespace OpenMS
           for (vector<PeptideHit>::iterator hit2 = id2->getHits().begin();
                hit2 != id2->getHits().end(); ++hit2)
           {
-            double sim_score = getSimilarity_(hit1->getSequence(),
-                                              hit2->getSequence());
+            double sim_score = *next_similarity++; // same order as above
             // use "1 - PEP" so higher scores are better (for "max_element"):
             current_matches.push_back(make_pair(sim_score,
                                                 1.0 - hit2->getScore()));
@@ -35,6 +35,7 @@
 #include <OpenMS/ANALYSIS/ID/ConsensusMapMergerAlgorithm.h>
 #include <OpenMS/METADATA/PeptideIdentification.h>
 #include <unordered_map>
+#include <unordered_set>
 
 using namespace std;
 namespace OpenMS
@@ -199,8 +200,16 @@ namespace OpenMS
     }
 
     vector<ProteinIdentification> new_prot_ids{new_size};
-    //TODO preallocate with sum of proteins?
-    unordered_map<ProteinHit,set<Size>,hash_type,equal_type> proteins_collected_hits_runs(0, accessionHash_, accessionEqual_);
+    // unique protein hits (in the order of their first occurrence) with their destination runs
+    vector<pair<ProteinHit, set<Size>>> proteins_collected_hits_runs;
+    unordered_map<InternedString, Size> accession_to_collected_idx;
+
+    unordered_map<String, ProteinIdentification*> run_id_to_old_run;
+    for (auto& old_prot_id : cmap.getProteinIdentifications())
+    {
+      // the first run with an identifier is used
+      run_id_to_old_run.emplace(old_prot_id.getIdentifier(), &old_prot_id);
+    }
 
     // we only need to store an offset if we append the primaryRunPaths
     //(oldRunID, newRunIdx) -> newMergeIdxOffset
@@ -209,12 +218,7 @@ namespace OpenMS
     for (auto& runid2newrunidcs_pair : run_id_to_new_run_idcs)
     {
       // find old run
-      auto it = cmap.getProteinIdentifications().begin();
-      for (; it != cmap.getProteinIdentifications().end(); ++it)
-      {
-        if (it->getIdentifier() == runid2newrunidcs_pair.first)
-          break;
-      }
+      ProteinIdentification* it = run_id_to_old_run.at(runid2newrunidcs_pair.first);
 
       for (const auto& newrunid : runid2newrunidcs_pair.second)
       {
@@ -254,8 +258,13 @@ namespace OpenMS
       // add destination run indices
       for (auto& hit : it->getHits())
       {
-        const auto& foundIt = proteins_collected_hits_runs.emplace(std::move(hit), set<Size>());
-        foundIt.first->second.insert(runid2newrunidcs_pair.second.begin(), runid2newrunidcs_pair.second.end());
+        const auto& found_it = accession_to_collected_idx.emplace(hit.getInternedAccession(), proteins_collected_hits_runs.size());
+        if (found_it.second)
+        {
+          proteins_collected_hits_runs.emplace_back(std::move(hit), set<Size>());
+        }
+        set<Size>& runs = proteins_collected_hits_runs[found_it.first->second].second;
+        runs.insert(runid2newrunidcs_pair.second.begin(), runid2newrunidcs_pair.second.end());
       }
       it->getHits().clear(); //not needed anymore and moved anyway
     }
@@ -345,27 +354,24 @@ namespace OpenMS
     }
     new_prot_id_run.setPrimaryMSRunPath(merged_origin_files);
 
-    unordered_set<ProteinHit,hash_type,equal_type> proteins_collected_hits(0, accessionHash_, accessionEqual_);
+    // unique protein hits in the order of their first occurrence (the first hit of an accession is kept)
+    std::vector<ProteinHit>& proteins_collected_hits = new_prot_id_run.getHits();
+    unordered_set<InternedString> accessions_collected;
 
     std::vector<ProteinIdentification>& old_prot_runs = cmap.getProteinIdentifications();
-    typedef std::vector<ProteinHit>::iterator iter_t;
     for (auto& prot_run : old_prot_runs)
     {
       auto& hits = prot_run.getHits();
-      proteins_collected_hits.insert(
-          std::move_iterator<iter_t>(hits.begin()),
-          std::move_iterator<iter_t>(hits.end())
-      );
+      for (auto& hit : hits)
+      {
+        if (accessions_collected.insert(hit.getInternedAccession()).second)
+        {
+          proteins_collected_hits.emplace_back(std::move(hit));
+        }
+      }
       hits.clear();
     }
 
-    std::map<String, Size> run_id_to_run_idx;
-    for (Size old_prot_run_idx = 0; old_prot_run_idx < old_prot_runs.size(); ++old_prot_run_idx)
-    {
-      ProteinIdentification& protIDRun = old_prot_runs[old_prot_run_idx];
-      run_id_to_run_idx[protIDRun.getIdentifier()] = old_prot_run_idx;
-    }
-
     const String& new_prot_id_run_string = new_prot_id_run.getIdentifier();
 
     function<void(PeptideIdentification &)> fun =
@@ -394,12 +400,6 @@ namespace OpenMS
 
     cmap.applyFunctionOnPeptideIDs(fun);
 
-    auto& hits = new_prot_id_run.getHits();
-    for (auto& prot : proteins_collected_hits)
-    {
-      hits.emplace_back(std::move(const_cast<ProteinHit&>(prot))); //careful this completely invalidates the set
-    }
-    proteins_collected_hits.clear();
     cmap.getProteinIdentifications().resize(1);
     swap(cmap.getProteinIdentifications()[0], new_prot_id_run);
     //TODO remove unreferenced proteins? Can this happen when merging all? I think not.
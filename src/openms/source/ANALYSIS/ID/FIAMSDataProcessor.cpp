@@ -147,6 +147,12 @@ namespace OpenMS {
   }
 
   void FIAMSDataProcessor::runAccurateMassSearch(FeatureMap& input, OpenMS::MzTab& output) {
+    AccurateMassSearchEngine ams;
+    configureAccurateMassSearch(ams);
+    ams.run(input, output);
+  }
+
+  void FIAMSDataProcessor::configureAccurateMassSearch(AccurateMassSearchEngine& ams) const {
     Param ams_param;
     ams_param.setValue("ionization_mode", "auto");
     ams_param.setValue("mass_error_value", 1e+06 / (static_cast<float>(param_.getValue("resolution"))*2));
@@ -155,11 +161,8 @@ namespace OpenMS {
     ams_param.setValue("positive_adducts", param_.getValue("positive_adducts"));
     ams_param.setValue("negative_adducts", param_.getValue("negative_adducts"));
 
-    AccurateMassSearchEngine ams;
     ams.setParameters(ams_param);
     ams.init();
-
-    ams.run(input, output);
   }
 
   MSSpectrum FIAMSDataProcessor::trackNoise(const MSSpectrum& input) {
@@ -189,6 +192,12 @@ namespace OpenMS {
   }
 
   bool FIAMSDataProcessor::run(const MSExperiment& experiment, const float n_seconds, OpenMS::MzTab& output, const bool load_cached_spectrum) {
+    AccurateMassSearchEngine ams;
+    configureAccurateMassSearch(ams);
+    return run(experiment, n_seconds, output, ams, load_cached_spectrum);
+  }
+
+  bool FIAMSDataProcessor::run(const MSExperiment& experiment, const float n_seconds, OpenMS::MzTab& output, const AccurateMassSearchEngine& ams, const bool load_cached_spectrum) {
     String postfix = String(static_cast<int>(n_seconds));
     String dir_output_ = param_.getValue("dir_output");
     String filename_ = param_.getValue("filename");
@@ -219,7 +228,7 @@ namespace OpenMS {
     MSSpectrum signal_to_noise = trackNoise(picked_spectrum);
     FeatureMap picked_features = convertToFeatureMap(picked_spectrum);
     storeSpectrum_(signal_to_noise, dir_output_ + "/" + filename_ + "_signal_to_noise_" + postfix + ".mzML");
-    runAccurateMassSearch(picked_features, output);
+    ams.run(picked_features, output);
     OpenMS::MzTabFile mztab_outfile;
     mztab_outfile.store(dir_output_ + "/" + filename_ + "_" + postfix + ".mzTab", output);
     return is_cached;
@@ -34,6 +34,9 @@
 
 #include <OpenMS/ANALYSIS/ID/FIAMSDataProcessor.h>
 #include <OpenMS/ANALYSIS/ID/FIAMSScheduler.h>
+#include <OpenMS/ANALYSIS/ID/AccurateMassSearchEngine.h>
+
+#include <exception>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -70,35 +73,68 @@ namespace OpenMS {
     }
   }
 
-  void FIAMSScheduler::run() {
-    #pragma omp parallel for
-    for (int i = 0; i < (int)samples_.size(); ++i) {
-      MSExperiment exp;
-      MzMLFile mzml;
-      mzml.load(base_dir_ + samples_[i].at("dir_input") + "/" + samples_[i].at("filename") + ".mzML", exp);
+  Param FIAMSScheduler::getProcessorParameters_(Size i) const {
+    Param p;
+    p.setValue("filename", samples_[i].at("filename"));
+    p.setValue("dir_output", base_dir_ + samples_[i].at("dir_output"));
+    p.setValue("resolution", std::stof(samples_[i].at("resolution")));
+    p.setValue("polarity", samples_[i].at("charge"));
+    p.setValue("db:mapping", ListUtils::create<String>(base_dir_ + samples_[i].at("db_mapping")));
+    p.setValue("db:struct", ListUtils::create<String>(base_dir_ + samples_[i].at("db_struct")));
+    p.setValue("positive_adducts", base_dir_ + samples_[i].at("positive_adducts"));
+    p.setValue("negative_adducts", base_dir_ + samples_[i].at("negative_adducts"));
+    return p;
+  }
 
-      FIAMSDataProcessor fia_processor;
-      Param p;
-      p.setValue("filename", samples_[i].at("filename"));
-      p.setValue("dir_output", base_dir_ + samples_[i].at("dir_output"));
-      p.setValue("resolution", std::stof(samples_[i].at("resolution")));
-      p.setValue("polarity", samples_[i].at("charge"));
-      p.setValue("db:mapping", ListUtils::create<String>(base_dir_ + samples_[i].at("db_mapping")));
-      p.setValue("db:struct", ListUtils::create<String>(base_dir_ + samples_[i].at("db_struct")));
-      p.setValue("positive_adducts", base_dir_ + samples_[i].at("positive_adducts"));
-      p.setValue("negative_adducts", base_dir_ + samples_[i].at("negative_adducts"));
-      fia_processor.setParameters(p);
+  void FIAMSScheduler::run(Size max_concurrent_samples) {
+    // load the databases and adducts once for every distinct search setup;
+    // the engines are only read from while the samples are processed
+    std::map<String, AccurateMassSearchEngine> engines;
+    std::vector<const AccurateMassSearchEngine*> sample_engines(samples_.size());
+    for (Size i = 0; i < samples_.size(); ++i) {
+      const std::map<String, String>& sample = samples_[i];
+      String key = sample.at("resolution") + "\t" + sample.at("db_mapping") + "\t" + sample.at("db_struct") + "\t" +
+                   sample.at("positive_adducts") + "\t" + sample.at("negative_adducts");
+      auto it = engines.find(key);
+      if (it == engines.end()) {
+        it = engines.emplace(key, AccurateMassSearchEngine()).first;
+        FIAMSDataProcessor fia_processor;
+        fia_processor.setParameters(getProcessorParameters_(i));
+        fia_processor.configureAccurateMassSearch(it->second);
+      }
+      sample_engines[i] = &it->second;
+    }
 
-      String time = samples_[i].at("time");
-      std::vector<String> times;
-      time.split(";", times);
-      for (Size j = 0; j < times.size(); ++j) {
-        OPENMS_LOG_INFO << "Started " << samples_[i].at("filename") << " for " << times[j] << " seconds" << std::endl;
-        MzTab mztab_output;
-        fia_processor.run(exp, std::stof(times[j]), mztab_output, load_cached_);
-        OPENMS_LOG_INFO << "Finished " << samples_[i].at("filename") << " for " << times[j] << " seconds" << std::endl;
+#ifdef _OPENMP
+    int n_threads = max_concurrent_samples > 0 ? static_cast<int>(max_concurrent_samples) : omp_get_max_threads();
+#endif
+    std::exception_ptr error;
+    #pragma omp parallel for schedule(dynamic, 1) num_threads(n_threads)
+    for (SignedSize i = 0; i < (SignedSize)samples_.size(); ++i) {
+      try {
+        MSExperiment exp;
+        MzMLFile mzml;
+        mzml.load(base_dir_ + samples_[i].at("dir_input") + "/" + samples_[i].at("filename") + ".mzML", exp);
+
+        FIAMSDataProcessor fia_processor;
+        fia_processor.setParameters(getProcessorParameters_(i));
+
+        String time = samples_[i].at("time");
+        std::vector<String> times;
+        time.split(";", times);
+        for (Size j = 0; j < times.size(); ++j) {
+          OPENMS_LOG_INFO << "Started " << samples_[i].at("filename") << " for " << times[j] << " seconds" << std::endl;
+          MzTab mztab_output;
+          fia_processor.run(exp, std::stof(times[j]), mztab_output, *sample_engines[i], load_cached_);
+          OPENMS_LOG_INFO << "Finished " << samples_[i].at("filename") << " for " << times[j] << " seconds" << std::endl;
+        }
+      }
+      catch (...) {
+        #pragma omp critical (FIAMSScheduler_error)
+        if (!error) error = std::current_exception();
       }
     }
+    if (error) std::rethrow_exception(error);
   }
 
   const std::vector<std::map<String, String>>& FIAMSScheduler::getSamples() {
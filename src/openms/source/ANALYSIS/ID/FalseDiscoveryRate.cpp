@@ -35,10 +35,16 @@
 #include <OpenMS/ANALYSIS/ID/FalseDiscoveryRate.h>
 #include <OpenMS/ANALYSIS/ID/IDScoreGetterSetter.h>
 #include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/METADATA/ID/QueryMatchTable.h>
 
 #include <algorithm>
+#include <cmath>
 #include <numeric>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 // #define FALSE_DISCOVERY_RATE_DEBUG
 // #undef  FALSE_DISCOVERY_RATE_DEBUG
 
@@ -46,6 +52,68 @@ using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// Inputs smaller than this are processed sequentially (parallelization does not pay off)
+    const Size min_parallel_size = 100000;
+
+    /// Sorts the chunks of the range in parallel and merges them pairwise, falls back to std::sort for small inputs
+    template <typename Iterator, typename Comparator>
+    void parallelSort(Iterator begin, Iterator end, Comparator comp)
+    {
+      const Size n = std::distance(begin, end);
+#ifdef _OPENMP
+      const Size chunks = static_cast<Size>(std::max(1, omp_get_max_threads()));
+      if (chunks > 1 && n >= min_parallel_size)
+      {
+        std::vector<Size> bounds(chunks + 1);
+        for (Size c = 0; c <= chunks; ++c)
+        {
+          bounds[c] = n * c / chunks;
+        }
+        // sort the chunks independently ...
+#pragma omp parallel for schedule(static)
+        for (SignedSize c = 0; c < static_cast<SignedSize>(chunks); ++c)
+        {
+          std::sort(begin + bounds[c], begin + bounds[c + 1], comp);
+        }
+        // ... and merge neighbouring runs pairwise
+        for (Size width = 1; width < chunks; width *= 2)
+        {
+          const SignedSize step = static_cast<SignedSize>(2 * width);
+#pragma omp parallel for schedule(static)
+          for (SignedSize c = 0; c < static_cast<SignedSize>(chunks); c += step)
+          {
+            const Size mid = std::min(c + width, chunks);
+            const Size last = std::min(c + 2 * width, chunks);
+            if (mid < last)
+            {
+              std::inplace_merge(begin + bounds[c], begin + bounds[mid], begin + bounds[last], comp);
+            }
+          }
+        }
+        return;
+      }
+#endif
+      (void) n;
+      std::sort(begin, end, comp);
+    }
+
+    /// Sorts by score only, the order of the labels within equal scores is irrelevant for the FDR
+    void sortByScore(ScoreToTgtDecLabelPairs& scores_labels, bool higher_score_better)
+    {
+      typedef ScoreToTgtDecLabelPairs::value_type Entry;
+      if (higher_score_better)
+      { // decreasing
+        parallelSort(scores_labels.begin(), scores_labels.end(), [](const Entry& a, const Entry& b) { return a.first > b.first; });
+      }
+      else
+      { // increasing
+        parallelSort(scores_labels.begin(), scores_labels.end(), [](const Entry& a, const Entry& b) { return a.first < b.first; });
+      }
+    }
+  }
+
   FalseDiscoveryRate::FalseDiscoveryRate() :
     DefaultParamHandler("FalseDiscoveryRate")
   {
@@ -566,27 +634,56 @@ namespace OpenMS
   {
     bool use_all_hits = param_.getValue("use_all_hits").toBool();
     bool include_decoys = param_.getValue("add_decoy_peptides").toBool();
-    vector<double> target_scores, decoy_scores;
-    map<IdentificationData::IdentifiedMoleculeRef, bool> molecule_to_decoy;
-    map<IdentificationData::QueryMatchRef, double> match_to_score;
+
+    // scan contiguous columns instead of the node-based match container:
+    QueryMatchTable table(id_data);
+    const vector<double>& scores = table.addScoreColumn(score_ref);
+    vector<Size> rows;
     if (use_all_hits)
     {
-      for (auto it = id_data.getMoleculeQueryMatches().begin();
-           it != id_data.getMoleculeQueryMatches().end(); ++it)
-      {
-        handleQueryMatch_(it, score_ref, target_scores, decoy_scores,
-                          molecule_to_decoy, match_to_score);
-      }
+      rows.resize(table.size());
+      iota(rows.begin(), rows.end(), 0);
     }
     else
     {
-      vector<IdentificationData::QueryMatchRef> best_matches =
-          id_data.getBestMatchPerQuery(score_ref);
-      for (auto match_ref : best_matches) // NOTE: performs copy, should not be necessary?
+      rows = table.getBestMatchPerQuery(score_ref);
+    }
+
+    vector<double> target_scores, decoy_scores;
+    // target/decoy status per molecule (-1: not determined yet):
+    vector<Int> molecule_is_decoy(table.getMolecules().size(), -1);
+    vector<bool> row_used(table.size(), false);
+    for (Size row : rows)
+    {
+      if (std::isnan(scores[row])) continue; // no score of this type
+      const IdentificationData::QueryMatchRef& match_ref = table.getMatchRefs()[row];
+      IdentificationData::MoleculeType molecule_type =
+        match_ref->getMoleculeType();
+      if (molecule_type == IdentificationData::MoleculeType::COMPOUND)
+      {
+        continue; // compounds don't have parents with target/decoy status
+      }
+      Int& is_decoy = molecule_is_decoy[table.getMoleculeIndices()[row]];
+      if (is_decoy < 0) // new molecule
+      {
+        if (molecule_type == IdentificationData::MoleculeType::PROTEIN)
+        {
+          is_decoy = match_ref->getIdentifiedPeptideRef()->allParentsAreDecoys();
+        }
+        else // if (molecule_type == IdentificationData::MoleculeType::RNA)
+        {
+          is_decoy = match_ref->getIdentifiedOligoRef()->allParentsAreDecoys();
+        }
+      }
+      if (is_decoy)
       {
-        handleQueryMatch_(match_ref, score_ref, target_scores, decoy_scores,
-                          molecule_to_decoy, match_to_score);
+        decoy_scores.push_back(scores[row]);
       }
+      else
+      {
+        target_scores.push_back(scores[row]);
+      }
+      row_used[row] = true;
     }
 
     map<double, double> score_to_fdr;
@@ -607,75 +704,18 @@ namespace OpenMS
     }
     IdentificationData::ScoreTypeRef fdr_ref =
         id_data.registerScoreType(fdr_score);
-    for (IdentificationData::MoleculeQueryMatches::iterator it =
-        id_data.getMoleculeQueryMatches().begin(); it !=
-                                                   id_data.getMoleculeQueryMatches().end(); ++it)
+    for (Size row = 0; row < table.size(); ++row)
     {
-      if (!include_decoys)
-      {
-        auto pos = molecule_to_decoy.find(it->identified_molecule_ref);
-        if ((pos != molecule_to_decoy.end()) && pos->second) continue;
-      }
-      auto pos = match_to_score.find(it);
-      if (pos == match_to_score.end()) continue;
-      double fdr = score_to_fdr.at(pos->second);
-      // @TODO: find a more efficient way to add a score
-      // IdentificationData::MoleculeQueryMatch copy(*it);
-      // copy.scores.push_back(make_pair(fdr_ref, fdr));
-      // id_data.registerMoleculeQueryMatch(copy);
-      id_data.addScore(it, fdr_ref, fdr);
+      if (!row_used[row]) continue;
+      if (!include_decoys &&
+          (molecule_is_decoy[table.getMoleculeIndices()[row]] == 1)) continue;
+      double fdr = score_to_fdr.at(scores[row]);
+      id_data.addScore(table.getMatchRefs()[row], fdr_ref, fdr);
     }
     return fdr_ref;
   }
 
 
-  void FalseDiscoveryRate::handleQueryMatch_(
-    IdentificationData::QueryMatchRef match_ref,
-    IdentificationData::ScoreTypeRef score_ref,
-    vector<double>& target_scores, vector<double>& decoy_scores,
-    map<IdentificationData::IdentifiedMoleculeRef, bool>& molecule_to_decoy,
-    map<IdentificationData::QueryMatchRef, double>& match_to_score) const
-  {
-    IdentificationData::MoleculeType molecule_type =
-      match_ref->getMoleculeType();
-    if (molecule_type == IdentificationData::MoleculeType::COMPOUND)
-    {
-      return; // compounds don't have parents with target/decoy status
-    }
-    pair<double, bool> score = match_ref->getScore(score_ref);
-    if (!score.second) return; // no score of this type
-    match_to_score[match_ref] = score.first;
-    IdentificationData::IdentifiedMoleculeRef molecule_ref =
-      match_ref->identified_molecule_ref;
-    auto pos = molecule_to_decoy.find(molecule_ref);
-    bool is_decoy;
-    if (pos == molecule_to_decoy.end()) // new molecule
-    {
-      if (molecule_type == IdentificationData::MoleculeType::PROTEIN)
-      {
-        is_decoy = match_ref->getIdentifiedPeptideRef()->allParentsAreDecoys();
-      }
-      else // if (molecule_type == IdentificationData::MoleculeType::RNA)
-      {
-        is_decoy = match_ref->getIdentifiedOligoRef()->allParentsAreDecoys();
-      }
-      molecule_to_decoy[molecule_ref] = is_decoy;
-    }
-    else
-    {
-      is_decoy = pos->second;
-    }
-    if (is_decoy)
-    {
-      decoy_scores.push_back(score.first);
-    }
-    else
-    {
-      target_scores.push_back(score.first);
-    }
-  }
-
-
   void FalseDiscoveryRate::calculateFDRs_(map<double, double>& score_to_fdr, vector<double>& target_scores, vector<double>& decoy_scores, bool q_value, bool higher_score_better) const
   {
     Size number_of_target_scores = target_scores.size();
@@ -975,7 +1015,7 @@ namespace OpenMS
           {
             if (c == 0) continue;
             IDScoreGetterSetter::getPeptideScoresFromMap_(scores_labels, cmap, include_unassigned_peptides, all_hits, c, protID.getIdentifier());
-            map<double, double> scores_to_fdr;
+            ScoreToFDRTable scores_to_fdr;
             calculateFDRBasic_(scores_to_fdr, scores_labels, q_value, higher_score_better);
             IDScoreGetterSetter::setPeptideScoresForMap_(scores_to_fdr, cmap, include_unassigned_peptides, score_type, higher_score_better, add_decoy_peptides, c,  protID.getIdentifier());
           }
@@ -983,7 +1023,7 @@ namespace OpenMS
         else
         {
           IDScoreGetterSetter::getPeptideScoresFromMap_(scores_labels, cmap, include_unassigned_peptides, all_hits, protID.getIdentifier());
-          map<double, double> scores_to_fdr;
+          ScoreToFDRTable scores_to_fdr;
           calculateFDRBasic_(scores_to_fdr, scores_labels, q_value, higher_score_better);
           IDScoreGetterSetter::setPeptideScoresForMap_(scores_to_fdr, cmap, include_unassigned_peptides, score_type, higher_score_better, add_decoy_peptides, protID.getIdentifier());
         }
@@ -992,7 +1032,7 @@ namespace OpenMS
     else
     {
       IDScoreGetterSetter::getPeptideScoresFromMap_(scores_labels, cmap, include_unassigned_peptides, all_hits);
-      map<double, double> scores_to_fdr;
+      ScoreToFDRTable scores_to_fdr;
       calculateFDRBasic_(scores_to_fdr, scores_labels, q_value, higher_score_better);
       IDScoreGetterSetter::setPeptideScoresForMap_(scores_to_fdr, cmap, include_unassigned_peptides, score_type, higher_score_better, add_decoy_peptides);
     }
@@ -1011,7 +1051,7 @@ namespace OpenMS
 
     ScoreToTgtDecLabelPairs scores_labels;
     scores_labels.reserve(id.getHits().size());
-    std::map<double,double> scores_to_FDR;
+    ScoreToFDRTable scores_to_FDR;
 
     // TODO this could be a separate function.. And it could actually be sped up.
     //  We could store the number of decoys/targets in the group, or we only update the
@@ -1079,7 +1119,7 @@ namespace OpenMS
     //bool treat_runs_separately = param_.getValue("treat_runs_separately").toBool();
 
     ScoreToTgtDecLabelPairs scores_labels;
-    std::map<double,double> scores_to_FDR;
+    ScoreToFDRTable scores_to_FDR;
 
     std::vector<int> charges = {0};
     std::vector<String> identifiers = {""};
@@ -1125,7 +1165,7 @@ namespace OpenMS
     }
 
     ScoreToTgtDecLabelPairs scores_labels;
-    std::map<double,double> scores_to_FDR;
+    ScoreToFDRTable scores_to_FDR;
     //TODO actually we do not need the labels for estimated FDR and it currently fails if we do not have TD annotations
     //TODO maybe separate getScores and getScoresAndLabels
     IDScoreGetterSetter::getScores_(scores_labels, ids[0]);
@@ -1313,28 +1353,21 @@ namespace OpenMS
 
   // Actually this does not need the bool entries in the scores_labels, but leads to less code
   // Assumes P(E)Probabilities as scores
-  void FalseDiscoveryRate::calculateEstimatedQVal_(std::map<double, double> &scores_to_FDR,
+  void FalseDiscoveryRate::calculateEstimatedQVal_(ScoreToFDRTable &scores_to_FDR,
                                                    ScoreToTgtDecLabelPairs &scores_labels,
                                                    bool higher_score_better) const
   {
+    scores_to_FDR.clear();
     if (scores_labels.empty())
     {
      OPENMS_LOG_WARN << "Warning: No scores extracted for FDR calculation. Skipping. Do you have target-decoy annotated Hits?" << std::endl;
       return;
     }
 
-    if (higher_score_better)
-    { // decreasing
-      std::sort(scores_labels.rbegin(), scores_labels.rend());
-    }
-    else
-    { // increasing
-      std::sort(scores_labels.begin(), scores_labels.end());
-    }
+    sortByScore(scores_labels, higher_score_better);
 
     //TODO I think we can just do it "in-place" to save space
-    std::vector<double> estimatedFDR;
-    estimatedFDR.reserve(scores_labels.size());
+    std::vector<double> estimatedFDR(scores_labels.size());
 
     // Basically a running average
     double sum = 0.0;
@@ -1350,87 +1383,125 @@ namespace OpenMS
       std::transform(estimatedFDR.begin(), estimatedFDR.end(), estimatedFDR.begin(), [&](double d) { return 1 - d; });
     }
 
-    // In case of multiple equal scores, this will add the _last_ fdr that it finds. Since fdrs are decreasing
-    // in either way in estimatedFDR, this adds the minimal FDR to the map for this score.
-    std::transform(scores_labels.begin(), scores_labels.end(), estimatedFDR.begin(), std::inserter(scores_to_FDR, scores_to_FDR.begin()), [&](std::pair<double,bool> sl, double fdr){return make_pair(sl.first, fdr);});
+    // In case of multiple equal scores, only the first fdr that is found for this score is recorded
+    // (same as inserting into a map).
+    scores_to_FDR.reserve(scores_labels.size());
+    for (size_t j = 0; j < scores_labels.size(); ++j)
+    {
+      if (scores_to_FDR.empty() || scores_to_FDR.back().first != scores_labels[j].first)
+      {
+        scores_to_FDR.emplace_back(scores_labels[j].first, estimatedFDR[j]);
+      }
+    }
+    // the table is looked up in increasing score order
+    if (higher_score_better)
+    {
+      std::reverse(scores_to_FDR.begin(), scores_to_FDR.end());
+    }
   }
 
   void FalseDiscoveryRate::calculateFDRBasic_(
-      std::map<double,double>& scores_to_FDR,
+      ScoreToFDRTable& scores_to_FDR,
       ScoreToTgtDecLabelPairs& scores_labels,
       bool qvalue,
       bool higher_score_better) const
   {
     //TODO put in separate function to avoid ifs in iteration
     bool conservative = param_.getValue("conservative").toBool();
+    scores_to_FDR.clear();
     if (scores_labels.empty())
     {
       OPENMS_LOG_WARN << "Warning: No scores extracted for FDR calculation. Skipping. Do you have target-decoy annotated Hits?" << std::endl;
       return;
     }
 
-    if (higher_score_better)
-    { // decreasing
-      std::sort(scores_labels.rbegin(), scores_labels.rend());
+    sortByScore(scores_labels, higher_score_better);
+
+    // Uniquify scores and add decoy proportions. This is a prefix scan over the decoy counts: every chunk
+    // first counts its decoys and the number of distinct scores ending in it, the offsets are accumulated
+    // and then every chunk writes its part of the table independently.
+    const Size n = scores_labels.size();
+    Size chunks = 1;
+#ifdef _OPENMP
+    if (n >= min_parallel_size)
+    {
+      chunks = static_cast<Size>(std::max(1, omp_get_max_threads()));
     }
-    else
-    { // increasing
-      std::sort(scores_labels.begin(), scores_labels.end());
+#endif
+    std::vector<Size> bounds(chunks + 1);
+    for (Size c = 0; c <= chunks; ++c)
+    {
+      bounds[c] = n * c / chunks;
     }
 
-    //uniquify scores and add decoy proportions
-    size_t decoys = 0;
-    double last_score = scores_labels[0].first;
-
-    size_t j = 0;
-    for (; j < scores_labels.size(); ++j)
+    // a block of equal scores ends at index i if the next score differs (or i is the last index)
+    auto isBlockEnd = [&scores_labels, n](Size i)
     {
       //TODO think about double comparison here, but an equal should actually be fine here.
-      if (scores_labels[j].first != last_score)
+      return i + 1 == n || scores_labels[i + 1].first != scores_labels[i].first;
+    };
+
+    std::vector<Size> decoy_offsets(chunks + 1, 0);
+    std::vector<Size> table_offsets(chunks + 1, 0);
+#pragma omp parallel for schedule(static) if (chunks > 1)
+    for (SignedSize c = 0; c < static_cast<SignedSize>(chunks); ++c)
+    {
+      Size decoys = 0, blocks = 0;
+      for (Size i = bounds[c]; i < bounds[c + 1]; ++i)
       {
+        if (!scores_labels[i].second) ++decoys;
+        if (isBlockEnd(i)) ++blocks;
+      }
+      decoy_offsets[c + 1] = decoys;
+      table_offsets[c + 1] = blocks;
+    }
+    std::partial_sum(decoy_offsets.begin(), decoy_offsets.end(), decoy_offsets.begin());
+    std::partial_sum(table_offsets.begin(), table_offsets.end(), table_offsets.begin());
+
+    scores_to_FDR.resize(table_offsets[chunks]);
+#pragma omp parallel for schedule(static) if (chunks > 1)
+    for (SignedSize c = 0; c < static_cast<SignedSize>(chunks); ++c)
+    {
+      Size decoys = decoy_offsets[c];
+      Size out = table_offsets[c];
+      for (Size i = bounds[c]; i < bounds[c + 1]; ++i)
+      {
+        if (!scores_labels[i].second) ++decoys;
+        if (!isBlockEnd(i)) continue;
+
+        const double j = i + 1.0; // number of hits with this score or better
         #ifdef FALSE_DISCOVERY_RATE_DEBUG
-        std::cerr << "Recording score: " << last_score << " with " << decoys << " decoys at index+1 = " << (j+1) << " -> fdr: " << decoys/(j+1.0) << std::endl;
+        std::cerr << "Recording score: " << scores_labels[i].first << " with " << decoys << " decoys at index+1 = " << (j+1) << " -> fdr: " << decoys/(j+1.0) << std::endl;
         #endif
         //we are using the conservative formula (Decoy + 1) / (Tgts)
         if (conservative)
         {
-          scores_to_FDR[last_score] = (decoys+1.0)/(j+1.0-decoys);
+          scores_to_FDR[out++] = make_pair(scores_labels[i].first, (decoys+1.0)/(j+1.0-decoys));
         }
         else
         {
-          scores_to_FDR[last_score] = (decoys+1.0)/(j+1.0);
+          scores_to_FDR[out++] = make_pair(scores_labels[i].first, (decoys+1.0)/(j+1.0));
         }
-
-        last_score = scores_labels[j].first;
-      }
-
-      if (!scores_labels[j].second)
-      {
-        decoys++;
       }
     }
 
-    // in case there is only one score and generally to include the last score, I guess we need to do this
-    if (conservative)
-    {
-      scores_to_FDR[last_score] = (decoys+1.0)/(j+1.0-decoys);
-    }
-    else
+    // the table is looked up in increasing score order
+    if (higher_score_better)
     {
-      scores_to_FDR[last_score] = (decoys+1.0)/(j+1.0);
+      std::reverse(scores_to_FDR.begin(), scores_to_FDR.end());
     }
 
-    if (qvalue) //apply a cumulative minimum on the map (from low to high fdrs)
+    if (qvalue) //apply a cumulative minimum on the table (from low to high scores)
     {
       double cummin = 1.0;
 
-      for (auto&& rit = scores_to_FDR.begin(); rit != scores_to_FDR.end(); ++rit)
+      for (auto& entry : scores_to_FDR)
       {
         #ifdef FALSE_DISCOVERY_RATE_DEBUG
-        std::cerr << "Comparing " << rit->second << " to " << cummin << std::endl;
+        std::cerr << "Comparing " << entry.second << " to " << cummin << std::endl;
         #endif
-        cummin = std::min(rit->second, cummin);
-        rit->second = cummin;
+        cummin = std::min(entry.second, cummin);
+        entry.second = cummin;
       }
     }
   }
@@ -0,0 +1,326 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/ANALYSIS/ID/FragmentIndex.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/DATASTRUCTURES/Param.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+
+namespace OpenMS
+{
+
+  namespace
+  {
+    const char FRAGMENT_INDEX_MAGIC[] = "OPENMS_FRAGMENT_INDEX_1";
+
+    template <typename T>
+    void writeValue_(std::ofstream& ofs, const T& value)
+    {
+      ofs.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void writeString_(std::ofstream& ofs, const String& s)
+    {
+      writeValue_(ofs, (UInt64)s.size());
+      ofs.write(s.c_str(), s.size());
+    }
+
+    template <typename T>
+    void readValue_(std::ifstream& ifs, T& value, const String& filename)
+    {
+      ifs.read(reinterpret_cast<char*>(&value), sizeof(T));
+      if (!ifs)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Unexpected end of fragment index file.");
+      }
+    }
+
+    void readString_(std::ifstream& ifs, String& s, const String& filename)
+    {
+      UInt64 size;
+      readValue_(ifs, size, filename);
+      s.resize(size);
+      if (size > 0) ifs.read(&s[0], size);
+      if (!ifs)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Unexpected end of fragment index file.");
+      }
+    }
+  }
+
+  FragmentIndex::FragmentIndex(double bucket_width) :
+    bucket_width_(bucket_width),
+    built_(false)
+  {
+    // b- and y-ions, first prefix ion included (as used for scoring by the search engines)
+    Param param(spectrum_generator_.getParameters());
+    param.setValue("add_first_prefix_ion", "true");
+    param.setValue("add_metainfo", "false");
+    spectrum_generator_.setParameters(param);
+  }
+
+  void FragmentIndex::addPeptide(const String& unmodified_sequence, Size mod_index, const AASequence& peptide)
+  {
+    spectrum_generator_.getIonSeries(mz_buffer_, peptide, 1, 1);
+    std::vector<float> fragments(mz_buffer_.begin(), mz_buffer_.end());
+
+    peptides_.push_back(Peptide{unmodified_sequence, mod_index, peptide.toString(), peptide.getMonoWeight()});
+    peptide_fragments_.push_back(std::move(fragments));
+    built_ = false;
+  }
+
+  void FragmentIndex::build()
+  {
+    // sort peptides by mass, ties broken by sequence for a reproducible order
+    std::vector<Size> order(peptides_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](Size a, Size b)
+    {
+      if (peptides_[a].mass != peptides_[b].mass) return peptides_[a].mass < peptides_[b].mass;
+      return peptides_[a].sequence < peptides_[b].sequence;
+    });
+
+    std::vector<Peptide> sorted_peptides;
+    sorted_peptides.reserve(peptides_.size());
+    float max_mz = 0;
+    for (Size i : order)
+    {
+      sorted_peptides.push_back(std::move(peptides_[i]));
+      for (float mz : peptide_fragments_[i]) max_mz = std::max(max_mz, mz);
+    }
+
+    // counting sort of all fragments into buckets (stable, thus ordered by peptide within a bucket)
+    bucket_offsets_.assign(bucket_(max_mz) + 2, 0);
+    for (const std::vector<float>& fragments : peptide_fragments_)
+    {
+      for (float mz : fragments) ++bucket_offsets_[bucket_(mz) + 1];
+    }
+    std::partial_sum(bucket_offsets_.begin(), bucket_offsets_.end(), bucket_offsets_.begin());
+
+    fragments_.resize(bucket_offsets_.back());
+    std::vector<Size> fill(bucket_offsets_.begin(), bucket_offsets_.end() - 1);
+    for (Size pep = 0; pep < order.size(); ++pep)
+    {
+      for (float mz : peptide_fragments_[order[pep]])
+      {
+        fragments_[fill[bucket_(mz)]++] = Fragment_{(UInt32)pep, mz};
+      }
+    }
+
+    peptides_.swap(sorted_peptides);
+    std::vector<std::vector<float> >().swap(peptide_fragments_);
+    built_ = true;
+  }
+
+  void FragmentIndex::clear()
+  {
+    peptides_.clear();
+    peptide_fragments_.clear();
+    bucket_offsets_.clear();
+    fragments_.clear();
+    built_ = false;
+  }
+
+  Size FragmentIndex::size() const
+  {
+    return peptides_.size();
+  }
+
+  Size FragmentIndex::getNrFragments() const
+  {
+    return fragments_.size();
+  }
+
+  const FragmentIndex::Peptide& FragmentIndex::getPeptide(Size index) const
+  {
+    return peptides_[index];
+  }
+
+  Size FragmentIndex::bucket_(double mz) const
+  {
+    return mz <= 0 ? 0 : (Size)(mz / bucket_width_);
+  }
+
+  void FragmentIndex::query(const MSSpectrum& spectrum,
+                            double min_mass,
+                            double max_mass,
+                            double fragment_tolerance,
+                            bool fragment_tolerance_ppm,
+                            Size min_matched_peaks,
+                            std::vector<std::pair<Size, Size> >& candidates) const
+  {
+    if (!built_)
+    {
+      throw Exception::Precondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "FragmentIndex::build() needs to be called before querying.");
+    }
+    candidates.clear();
+
+    // candidates within the precursor mass window
+    auto mass_less = [](const Peptide& p, double m) { return p.mass < m; };
+    const UInt32 first = std::lower_bound(peptides_.begin(), peptides_.end(), min_mass, mass_less) - peptides_.begin();
+    const UInt32 last = std::upper_bound(peptides_.begin(), peptides_.end(), max_mass,
+        [](double m, const Peptide& p) { return m < p.mass; }) - peptides_.begin();
+    if (first >= last || bucket_offsets_.empty()) return;
+
+    std::vector<UInt32> matched(last - first, 0);
+    const Size nr_buckets = bucket_offsets_.size() - 1;
+    for (const Peak1D& peak : spectrum)
+    {
+      const double mz = peak.getMZ();
+      const double tolerance = fragment_tolerance_ppm ? mz * fragment_tolerance * 1e-6 : fragment_tolerance;
+      const double left = mz - tolerance;
+      const double right = mz + tolerance;
+
+      const Size last_bucket = std::min(bucket_(right), nr_buckets - 1);
+      for (Size b = bucket_(left); b <= last_bucket; ++b)
+      {
+        std::vector<Fragment_>::const_iterator it = fragments_.begin() + bucket_offsets_[b];
+        std::vector<Fragment_>::const_iterator end = fragments_.begin() + bucket_offsets_[b + 1];
+        it = std::lower_bound(it, end, first, [](const Fragment_& f, UInt32 p) { return f.peptide < p; });
+        for (; it != end && it->peptide < last; ++it)
+        {
+          if (it->mz >= left && it->mz <= right)
+          {
+            ++matched[it->peptide - first];
+          }
+        }
+      }
+    }
+
+    for (Size i = 0; i < matched.size(); ++i)
+    {
+      if (matched[i] > 0 && matched[i] >= min_matched_peaks)
+      {
+        candidates.emplace_back(first + i, matched[i]);
+      }
+    }
+  }
+
+  void FragmentIndex::store(const String& filename, const String& key) const
+  {
+    if (!built_)
+    {
+      throw Exception::Precondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "FragmentIndex::build() needs to be called before storing.");
+    }
+
+    std::ofstream ofs(filename.c_str(), std::ios::binary);
+    if (!ofs)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    ofs.write(FRAGMENT_INDEX_MAGIC, sizeof(FRAGMENT_INDEX_MAGIC));
+    writeString_(ofs, key);
+    writeValue_(ofs, bucket_width_);
+
+    writeValue_(ofs, (UInt64)peptides_.size());
+    for (const Peptide& p : peptides_)
+    {
+      writeString_(ofs, p.unmodified_sequence);
+      writeValue_(ofs, (UInt64)p.mod_index);
+      writeString_(ofs, p.sequence);
+      writeValue_(ofs, p.mass);
+    }
+
+    writeValue_(ofs, (UInt64)bucket_offsets_.size());
+    for (Size offset : bucket_offsets_) writeValue_(ofs, (UInt64)offset);
+    ofs.write(reinterpret_cast<const char*>(fragments_.data()), fragments_.size() * sizeof(Fragment_));
+
+    if (!ofs)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+  }
+
+  bool FragmentIndex::load(const String& filename, const String& key)
+  {
+    clear();
+
+    std::ifstream ifs(filename.c_str(), std::ios::binary);
+    if (!ifs) return false;
+
+    char magic[sizeof(FRAGMENT_INDEX_MAGIC)];
+    ifs.read(magic, sizeof(magic));
+    if (!ifs || std::string(magic, sizeof(magic)) != std::string(FRAGMENT_INDEX_MAGIC, sizeof(FRAGMENT_INDEX_MAGIC)))
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Not a fragment index file.");
+    }
+
+    String stored_key;
+    readString_(ifs, stored_key, filename);
+    if (stored_key != key) return false;
+    readValue_(ifs, bucket_width_, filename);
+
+    UInt64 nr_peptides;
+    readValue_(ifs, nr_peptides, filename);
+    peptides_.resize(nr_peptides);
+    for (Peptide& p : peptides_)
+    {
+      UInt64 mod_index;
+      readString_(ifs, p.unmodified_sequence, filename);
+      readValue_(ifs, mod_index, filename);
+      p.mod_index = mod_index;
+      readString_(ifs, p.sequence, filename);
+      readValue_(ifs, p.mass, filename);
+    }
+
+    UInt64 nr_offsets;
+    readValue_(ifs, nr_offsets, filename);
+    bucket_offsets_.resize(nr_offsets);
+    for (Size& offset : bucket_offsets_)
+    {
+      UInt64 o;
+      readValue_(ifs, o, filename);
+      offset = o;
+    }
+    fragments_.resize(bucket_offsets_.empty() ? 0 : bucket_offsets_.back());
+    ifs.read(reinterpret_cast<char*>(fragments_.data()), fragments_.size() * sizeof(Fragment_));
+    if (!ifs)
+    {
+      clear();
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Unexpected end of fragment index file.");
+    }
+
+    built_ = true;
+    return true;
+  }
+
+} // namespace OpenMS
+
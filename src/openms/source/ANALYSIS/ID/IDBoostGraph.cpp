@@ -45,6 +45,7 @@
 #include <boost/graph/graph_utility.hpp>
 #include <boost/graph/connected_components.hpp>
 
+#include <numeric>
 #include <ostream>
 #ifdef _OPENMP
 #include <omp.h>
@@ -617,15 +618,19 @@ namespace OpenMS
       throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "No connected components annotated. Run computeConnectedComponents first!");
     }
 
-    // Use dynamic schedule because big CCs take much longer!
-    #pragma omp parallel for schedule(dynamic) default(none) shared(functor)
-    for (int i = 0; i < static_cast<int>(ccs_.size()); i += 1)
+    // Use dynamic schedule because big CCs take much longer! Biggest first, so that the long running
+    // inference on the few huge CCs does not end up on one thread after all the small ones are done.
+    const std::vector<Size> order = getCCsBySizeDescending_();
+
+    #pragma omp parallel for schedule(dynamic, 1) default(none) shared(functor, order)
+    for (int k = 0; k < static_cast<int>(order.size()); k += 1)
     {
       #ifdef INFERENCE_BENCH
       StopWatch sw;
       sw.start();
       #endif
 
+      const unsigned int i = static_cast<unsigned int>(order[k]);
       Graph& curr_cc = ccs_.at(i);
 
       #ifdef INFERENCE_MT_DEBUG
@@ -666,6 +671,17 @@ namespace OpenMS
     #endif
   }
 
+  std::vector<Size> IDBoostGraph::getCCsBySizeDescending_() const
+  {
+    std::vector<Size> order(ccs_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](Size a, Size b)
+    {
+      return boost::num_edges(ccs_[a]) > boost::num_edges(ccs_[b]);
+    });
+    return order;
+  }
+
   /// Do sth on ccs single-threaded
   void IDBoostGraph::applyFunctorOnCCsST(const std::function<void(Graph&)>& functor)
   {
@@ -33,6 +33,7 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/ANALYSIS/ID/IDMapper.h>
+#include <OpenMS/DATASTRUCTURES/BoundingBoxIndex.h>
 #include <OpenMS/MATH/MISC/MathFunctions.h>
 
 using namespace std;
@@ -252,6 +253,45 @@ namespace OpenMS
     double rt_pep;
     IntList charges;
 
+    // spatial index over the regions in which IDs can match the consensus
+    // features (or their subelements); only the candidates returned by it are
+    // checked in detail
+    vector<DBoundingBox<2> > match_boxes;
+    vector<Size> box_to_feature;
+    for (Size cm_index = 0; cm_index < map.size(); ++cm_index)
+    {
+      if (!measure_from_subelements)
+      {
+        match_boxes.push_back(getMatchBox_(map[cm_index].getRT(), map[cm_index].getMZ()));
+        box_to_feature.push_back(cm_index);
+      }
+      else
+      {
+        for (const FeatureHandle& handle : map[cm_index].getFeatures())
+        {
+          match_boxes.push_back(getMatchBox_(handle.getRT(), handle.getMZ()));
+          box_to_feature.push_back(cm_index);
+        }
+      }
+    }
+    const BoundingBoxIndex box_index(match_boxes);
+    match_boxes.clear();
+
+    // collect the candidate consensus features (ascending) for an RT and several m/z values
+    auto getCandidates = [&box_index, &box_to_feature](double rt, const DoubleList& mzs, vector<Size>& candidates)
+    {
+      candidates.clear();
+      vector<Size> boxes;
+      for (double mz : mzs)
+      {
+        box_index.query(DPosition<2>(rt, mz), boxes);
+        for (Size box : boxes) candidates.push_back(box_to_feature[box]);
+      }
+      sort(candidates.begin(), candidates.end());
+      candidates.erase(unique(candidates.begin(), candidates.end()), candidates.end());
+    };
+    vector<Size> candidates;
+
     // for statistics
     Size id_matches_none(0), id_matches_single(0), id_matches_multiple(0);
 
@@ -264,8 +304,9 @@ namespace OpenMS
 
       bool id_mapped(false);
 
-      // iterate over the features
-      for (Size cm_index = 0; cm_index < map.size(); ++cm_index)
+      // iterate over the candidate features
+      getCandidates(rt_pep, mz_values, candidates);
+      for (Size cm_index : candidates)
       {
         // if set to TRUE, we leave the i_mz-loop as we added the whole ID with all hits
         bool was_added = false; // was current pep-m/z matched?!
@@ -426,8 +467,9 @@ namespace OpenMS
         }
         precursor_empty_id.setIdentifier(empty_protein_id.getIdentifier());
 
-        // iterate over the consensus features
-        for (Size cm_index = 0; cm_index < map.size(); ++cm_index)
+        // iterate over the candidate consensus features
+        getCandidates(rt_value, DoubleList(1, mz_p), candidates);
+        for (Size cm_index : candidates)
         {
           // charge states to use for checking:
           IntList current_charges;
@@ -566,128 +608,103 @@ namespace OpenMS
       max_rt = max(max_rt, box.maxPosition().getX());
     }
 
-    // hash bounding boxes of features by RT:
-    // RT range is partitioned into slices (bins) of 1 second; every feature
-    // that overlaps a certain slice is hashed into the corresponding bin
-    vector<vector<SignedSize> > hash_table;
-    // make sure the RT hash table has indices >= 0 and doesn't waste space
-    // in the beginning:
-    SignedSize offset(0);
-
-    if (map.size() > 0)
-    {
-      // cout << "Setting up hash table..." << endl;
-      offset = SignedSize(floor(min_rt));
-      // this only works if features were found
-      hash_table.resize(SignedSize(floor(max_rt)) - offset + 1);
-      for (Size index = 0; index < boxes.size(); ++index)
-      {
-        const DBoundingBox<2> & box = boxes[index];
-        for (SignedSize i = SignedSize(floor(box.minPosition().getX()));
-             i <= SignedSize(floor(box.maxPosition().getX())); ++i)
-        {
-          hash_table[i - offset].push_back(index);
-        }
-      }
-    }
-    else
+    // spatial index over the feature bounding boxes (RT x m/z), only the
+    // candidates returned by it are checked against charges and convex hulls
+    BoundingBoxIndex box_index(boxes);
+    if (map.empty())
     {
       OPENMS_LOG_WARN << "IDMapper received an empty FeatureMap! All peptides are mapped as 'unassigned'!" << endl;
     }
 
-    // for statistics:
-    Size matches_none = 0, matches_single = 0, matches_multi = 0;
+    // does the feature match a peptide ID position (inside the feature bounding box)?
+    auto matchesFeature = [&](const Feature& feat, const DPosition<2>& id_pos) -> bool
+    {
+      if (use_centroid_mz)
+      {
+        // only one m/z value to check, which was already incorporated
+        // into the overall bounding box -> success!
+        return true;
+      }
+      // else: check all the mass traces
+      for (const ConvexHull2D& hull : feat.getConvexHulls())
+      {
+        DBoundingBox<2> box = hull.getBoundingBox();
+        if (use_centroid_rt)
+        {
+          box.setMinX(feat.getRT());
+          box.setMaxX(feat.getRT());
+        }
+        increaseBoundingBox_(box);
+        if (box.encloses(id_pos)) return true; // success!
+      }
+      return false;
+    };
 
     // cout << "Finding matches..." << endl;
-    // iterate over peptide IDs:
-    for (vector<PeptideIdentification>::const_iterator id_it =
-         ids.begin(); id_it != ids.end(); ++id_it)
+    // find the matching features of all peptide IDs in parallel (read-only),
+    // then annotate in the order of the IDs:
+    vector<vector<Size> > id_features(ids.size());
+#pragma omp parallel for schedule(dynamic, 100)
+    for (SignedSize i = 0; i < (SignedSize)ids.size(); ++i)
     {
-      // cout << "Peptide ID: " << id_it - ids.begin() << endl;
-
-      if (id_it->getHits().empty()) continue;
+      const PeptideIdentification& id = ids[i];
+      if (id.getHits().empty()) continue;
 
       DoubleList mz_values;
       double rt_value;
       IntList charges;
-      getIDDetails_(*id_it, rt_value, mz_values, charges, use_avg_mass);
+      getIDDetails_(id, rt_value, mz_values, charges, use_avg_mass);
 
-      if ((rt_value < min_rt) || (rt_value > max_rt)) // RT out of bounds
-      {
-        map.getUnassignedPeptideIdentifications().push_back(*id_it);
-        ++matches_none;
-        continue;
-      }
+      if ((rt_value < min_rt) || (rt_value > max_rt)) continue; // RT out of bounds
 
-      // iterate over candidate features:
-      Size index = SignedSize(floor(rt_value)) - offset;
-      Size matching_features = 0;
-      for (vector<SignedSize>::iterator hash_it =
-           hash_table[index].begin(); hash_it != hash_table[index].end();
-           ++hash_it)
+      // iterate over m/z values (only one if "mz_ref." is "precursor"):
+      vector<Size> candidates;
+      vector<Size>& matches = id_features[i];
+      for (Size l_index = 0; l_index < mz_values.size(); ++l_index)
       {
-        Feature & feat = map[*hash_it];
-
-        // need to check the charge state?
-        bool check_charge = !ignore_charge_;
-        if (check_charge && (mz_values.size() == 1))               // check now
+        DPosition<2> id_pos(rt_value, mz_values[l_index]);
+        box_index.query(id_pos, candidates); // potential matches
+        for (Size f_index : candidates)
         {
-          if (!ListUtils::contains(charges, feat.getCharge())) continue;
-          check_charge = false;                 // don't need to check later
-        }
-
-        // iterate over m/z values (only one if "mz_ref." is "precursor"):
-        Size l_index = 0;
-        for (DoubleList::iterator mz_it = mz_values.begin();
-             mz_it != mz_values.end(); ++mz_it, ++l_index)
-        {
-          if (check_charge && (charges[l_index] != feat.getCharge()))
-          {
-            continue;                   // charge states need to match
-          }
-
-          DPosition<2> id_pos(rt_value, *mz_it);
-          if (boxes[*hash_it].encloses(id_pos))                 // potential match
+          const Feature& feat = map[f_index];
+          // need to check the charge state?
+          if (!ignore_charge_)
           {
-            if (use_centroid_mz)
+            if (mz_values.size() == 1)
             {
-              // only one m/z value to check, which was already incorporated
-              // into the overall bounding box -> success!
-              feat.getPeptideIdentifications().push_back(*id_it);
-              ++matching_features;
-              break;                     // "mz_it" loop
+              if (!ListUtils::contains(charges, feat.getCharge())) continue;
             }
-            // else: check all the mass traces
-            bool found_match = false;
-            for (vector<ConvexHull2D>::iterator ch_it =
-                 feat.getConvexHulls().begin(); ch_it !=
-                 feat.getConvexHulls().end(); ++ch_it)
+            else if (charges[l_index] != feat.getCharge())
             {
-              DBoundingBox<2> box = ch_it->getBoundingBox();
-              if (use_centroid_rt)
-              {
-                box.setMinX(feat.getRT());
-                box.setMaxX(feat.getRT());
-              }
-              increaseBoundingBox_(box);
-              if (box.encloses(id_pos)) // success!
-              {
-                feat.getPeptideIdentifications().push_back(*id_it);
-                ++matching_features;
-                found_match = true;
-                break; // "ch_it" loop
-              }
+              continue; // charge states need to match
             }
-            if (found_match) break; // "mz_it" loop
           }
+          if (matchesFeature(feat, id_pos)) matches.push_back(f_index);
         }
       }
-      if (matching_features == 0)
+      // each feature is annotated at most once per ID
+      sort(matches.begin(), matches.end());
+      matches.erase(unique(matches.begin(), matches.end()), matches.end());
+    }
+
+    // for statistics:
+    Size matches_none = 0, matches_single = 0, matches_multi = 0;
+
+    for (Size i = 0; i < ids.size(); ++i)
+    {
+      if (ids[i].getHits().empty()) continue;
+
+      const vector<Size>& matches = id_features[i];
+      for (Size f_index : matches)
+      {
+        map[f_index].getPeptideIdentifications().push_back(ids[i]);
+      }
+      if (matches.empty())
       {
-        map.getUnassignedPeptideIdentifications().push_back(*id_it);
+        map.getUnassignedPeptideIdentifications().push_back(ids[i]);
         ++matches_none;
       }
-      else if (matching_features == 1)
+      else if (matches.size() == 1)
       {
         ++matches_single;
       }
@@ -696,6 +713,7 @@ namespace OpenMS
         ++matches_multi;
       }
     }
+    id_features.clear();
 
     vector<Size> unidentified = mapPrecursorsToIdentifications(spectra, ids).unidentified;
 
@@ -749,8 +767,9 @@ namespace OpenMS
           continue;
         }
 
-        // iterate over candidate features:
-        Size index = SignedSize(floor(rt_value)) - offset;
+        DPosition<2> id_pos(rt_value, mz_p);
+        vector<Size> candidates;
+        box_index.query(id_pos, candidates); // potential matches
         Size matching_features = 0;
 
         PeptideIdentification precursor_empty_id;
@@ -764,11 +783,10 @@ namespace OpenMS
         precursor_empty_id.setIdentifier(empty_protein_id.getIdentifier());
         //precursor_empty_id.setCharge(z_p);
 
-        for (vector<SignedSize>::iterator hash_it =
-           hash_table[index].begin(); hash_it != hash_table[index].end();
-           ++hash_it)
+        // iterate over candidate features:
+        for (Size f_index : candidates)
         {
-          Feature & feat = map[*hash_it];
+          Feature & feat = map[f_index];
 
           // (optinally) check charge state
           if (!ignore_charge_)
@@ -776,41 +794,19 @@ namespace OpenMS
             if (z_p != feat.getCharge()) continue;
           }
 
-          DPosition<2> id_pos(rt_value, mz_p);
-
-          if (boxes[*hash_it].encloses(id_pos)) // potential match
+          if (use_centroid_mz)
           {
-            if (use_centroid_mz)
-            {
-              // only one m/z value to check, which was already incorporated
-              // into the overall bounding box -> success!
-              feat.getPeptideIdentifications().push_back(precursor_empty_id);
-              ++spectrum_matches;
-              break; // "mz_it" loop
-            }
-            // else: check all the mass traces
-            bool found_match = false;
-            for (vector<ConvexHull2D>::iterator ch_it =
-                  feat.getConvexHulls().begin(); ch_it !=
-                  feat.getConvexHulls().end(); ++ch_it)
-            {
-              DBoundingBox<2> box = ch_it->getBoundingBox();
-              if (use_centroid_rt)
-              {
-                box.setMinX(feat.getRT());
-                box.setMaxX(feat.getRT());
-              }
-              increaseBoundingBox_(box);
-              if (box.encloses(id_pos)) // success!
-              {
-                feat.getPeptideIdentifications().push_back(precursor_empty_id);
-                ++matching_features;
-                found_match = true;
-                break; // "ch_it" loop
-              }
-            }
-
-            if (found_match) break; // "mz_it" loop
+            // only one m/z value to check, which was already incorporated
+            // into the overall bounding box -> success!
+            feat.getPeptideIdentifications().push_back(precursor_empty_id);
+            ++spectrum_matches;
+            break;
+          }
+          if (matchesFeature(feat, id_pos))
+          {
+            feat.getPeptideIdentifications().push_back(precursor_empty_id);
+            ++matching_features;
+            break;
           }
         }
 
@@ -912,7 +908,7 @@ namespace OpenMS
     }
   }
 
-  void IDMapper::increaseBoundingBox_(DBoundingBox<2>& box)
+  void IDMapper::increaseBoundingBox_(DBoundingBox<2>& box) const
   {
     DPosition<2> sub_min(rt_tolerance_,
                          getAbsoluteMZTolerance_(box.minPosition().getY())),
@@ -922,6 +918,26 @@ namespace OpenMS
     box.setMax(box.maxPosition() + add_max);
   }
 
+  DBoundingBox<2> IDMapper::getMatchBox_(const double rt, const double mz) const
+  {
+    // slightly larger than required, so rounding never excludes a match
+    const double slack = 1.0 + 1e-6;
+    double rt_tol = rt_tolerance_ * slack + 1e-9;
+    double mz_tol = numeric_limits<double>::max();
+    if (measure_ == MEASURE_DA)
+    {
+      mz_tol = mz_tolerance_ * slack + 1e-9;
+    }
+    else if (mz_tolerance_ < 1e6)
+    {
+      // the ppm deviation is relative to the m/z of the ID, which can be smaller than @p mz
+      const double t = mz_tolerance_ / 1e6;
+      mz_tol = fabs(mz) * t / (1.0 - t) * slack + 1e-9;
+    }
+    DBoundingBox<2> box(DPosition<2>(rt - rt_tol, mz - mz_tol), DPosition<2>(rt + rt_tol, mz + mz_tol));
+    return box;
+  }
+
   bool IDMapper::checkMassType_(const vector<DataProcessing>& processing) const
   {
     bool use_avg_mass = false;
@@ -33,8 +33,8 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/ANALYSIS/ID/IDMergerAlgorithm.h>
+#include <OpenMS/CONCEPT/ParallelExecution.h>
 #include <OpenMS/METADATA/PeptideIdentification.h>
-#include <unordered_map>
 
 using namespace std;
 namespace OpenMS
@@ -48,7 +48,8 @@ namespace OpenMS
       IDMergerAlgorithm::DefaultParamHandler("IDMergerAlgorithm"),
       prot_result_(),
       pep_result_(),
-      collected_protein_hits_(0, accessionHash_, accessionEqual_),
+      collected_protein_hits_(),
+      collected_protein_idx_(),
       id_(runIdentifier)
   {
     defaults_.setValue("annotate_origin",
@@ -139,11 +140,13 @@ namespace OpenMS
     //reset internals
     file_origin_to_idx_.clear();
 
-    for (auto& p : collected_protein_hits_)
-      prots.getHits().push_back(std::move(const_cast<ProteinHit&>(p)));
-    // above invalidates set but we clear right after
+    auto& hits = prots.getHits();
+    hits.insert(hits.end(),
+                std::make_move_iterator(collected_protein_hits_.begin()),
+                std::make_move_iterator(collected_protein_hits_.end()));
 
     collected_protein_hits_.clear();
+    collected_protein_idx_.clear();
   }
 
   String IDMergerAlgorithm::getNewIdentifier_() const
@@ -162,21 +165,25 @@ namespace OpenMS
       vector<ProteinIdentification>&& old_protRuns
   )
   {
-    typedef std::vector<ProteinHit>::iterator iter_t;
     for (auto& protRun : old_protRuns) //TODO check run ID when option is added
     {
       auto& hits = protRun.getHits();
-      collected_protein_hits_.insert(
-          std::move_iterator<iter_t>(hits.begin()),
-          std::move_iterator<iter_t>(hits.end())
-      );
+      collected_protein_idx_.reserve(collected_protein_idx_.size() + hits.size());
+      for (auto& hit : hits)
+      {
+        // the first occurrence of an accession is kept
+        if (collected_protein_idx_.emplace(hit.getInternedAccession(), collected_protein_hits_.size()).second)
+        {
+          collected_protein_hits_.emplace_back(std::move(hit));
+        }
+      }
       hits.clear();
     }
   }
 
   void IDMergerAlgorithm::updateAndMovePepIDs_(
       vector<PeptideIdentification>&& pepIDs,
-      const map<String, Size>& runID_to_runIdx,
+      const unordered_map<String, Size>& runID_to_runIdx,
       const vector<StringList>& originFiles,
       bool annotate_origin)
   {
@@ -184,8 +191,14 @@ namespace OpenMS
     // then use the iterator to update and move
     // the IDs, then erase them so we dont encounter them in
     // subsequent calls of this function
-    for (auto &pid : pepIDs)
+
+    // the origins of all runs are already in file_origin_to_idx_, so the IDs can be updated
+    // independently (and in parallel). They are moved afterwards to keep their order.
+    vector<char> keep(pepIDs.size(), 0);
+    const String& new_identifier = prot_result_.getIdentifier();
+    ParallelExecution::forEach(0, (SignedSize)pepIDs.size(), [&](SignedSize i)
     {
+      PeptideIdentification& pid = pepIDs[i];
       const String &runID = pid.getIdentifier();
 
       const auto& runIdxIt = runID_to_runIdx.find(runID);
@@ -193,7 +206,7 @@ namespace OpenMS
       if (runIdxIt == runID_to_runIdx.end())
       {
         //This is an easy way to just merge peptides from a certain run
-        continue;
+        return;
         /*
         throw Exception::MissingInformation(
             __FILE__,
@@ -236,11 +249,17 @@ namespace OpenMS
               "(" + String(pid.getMZ()) + ", " + String(pid.getRT()) + ") but"
               " the index exceeds the number of files in the run.");
         }
-        pid.setMetaValue("id_merge_index", file_origin_to_idx_[origins[oldFileIdx]]);
+        pid.setMetaValue("id_merge_index", file_origin_to_idx_.at(origins[oldFileIdx]));
       }
-      pid.setIdentifier(prot_result_.getIdentifier());
-      //move peptides into right vector
-      pep_result_.emplace_back(std::move(pid));
+      pid.setIdentifier(new_identifier);
+      keep[i] = 1;
+    });
+
+    //move peptides into right vector
+    pep_result_.reserve(pep_result_.size() + pepIDs.size());
+    for (Size i = 0; i < pepIDs.size(); ++i)
+    {
+      if (keep[i]) pep_result_.emplace_back(std::move(pepIDs[i]));
     }
   }
 
@@ -278,7 +297,7 @@ namespace OpenMS
       toFill.clear();
     }
 
-    std::map<String, Size> runIDToRunIdx;
+    unordered_map<String, Size> runIDToRunIdx;
     for (Size oldProtRunIdx = 0; oldProtRunIdx < old_protRuns.size(); ++oldProtRunIdx)
     {
       ProteinIdentification &protIDRun = old_protRuns[oldProtRunIdx];
@@ -71,7 +71,7 @@ namespace OpenMS
   * score_type and higher_better unused since ProteinGroups do not carry that information.
   * You have to assume that groups will always have the same scores as the ProteinHits
   */
-  void IDScoreGetterSetter::setScores_(const map<double, double> &scores_to_FDR,
+  void IDScoreGetterSetter::setScores_(const ScoreToFDRTable &scores_to_FDR,
                                       vector <ProteinIdentification::ProteinGroup> &grps,
                                       const string & /*score_type*/,
                                       bool /*higher_better*/)
@@ -40,6 +40,7 @@
 
 #include <boost/dynamic_bitset.hpp>
 
+#include <OpenMS/COMPARISON/SPECTRA/SpectralLibraryIndex.h>
 #include <OpenMS/FILTERING/TRANSFORMERS/SpectraMerger.h>
 #include <OpenMS/FILTERING/TRANSFORMERS/WindowMower.h>
 
@@ -441,13 +442,8 @@ namespace OpenMS
   {
     sort(spec_db.begin(), spec_db.end(), PrecursorMZLess);
 
-    vector<double> mz_keys;
-
-    // copy precursor m/z values to vector for searching
-    for (Size spec_idx = 0; spec_idx < spec_db.size(); ++spec_idx)
-    {
-      mz_keys.push_back(spec_db[spec_idx].getPrecursors()[0].getMZ());
-    }
+    // index library spectra by precursor m/z for searching
+    SpectralLibraryIndex library_index(spec_db.getSpectra());
 
     // remove potential noise peaks by selecting the ten most intense peak per 100 Da window
     WindowMower wm;
@@ -466,14 +462,20 @@ namespace OpenMS
     wm.filterPeakMap(msexp);
 
 
-    // container storing results
-    vector<SpectralMatch> matching_results;
+    // container storing results (per query spectrum, so they can be computed in parallel)
+    vector<vector<SpectralMatch> > spectrum_results(msexp.size());
 
     bool fragment_error_unit_ppm(true);
     if (mz_error_unit_ == "Da") { fragment_error_unit_ppm = false; }
 
-    for (Size spec_idx = 0; spec_idx < msexp.size(); ++spec_idx)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (SignedSize signed_spec_idx = 0; signed_spec_idx < (SignedSize)msexp.size(); ++signed_spec_idx)
     {
+      const Size spec_idx(signed_spec_idx);
+      vector<SpectralMatch>& matching_results = spectrum_results[spec_idx];
+
       // cout << "merged spectrum no. " << spec_idx << " with #fragment ions: " << msexp[spec_idx].size() << endl;
 
       // iterate over all precursor masses
@@ -501,18 +503,15 @@ namespace OpenMS
         // cout << "lower mz: " << prec_mz_lowerbound << " ";
         // cout << "upper mz: " << prec_mz_upperbound << endl;
 
-        vector<double>::const_iterator lower_it = lower_bound(mz_keys.begin(), mz_keys.end(), prec_mz_lowerbound);
-        vector<double>::const_iterator upper_it = upper_bound(mz_keys.begin(), mz_keys.end(), prec_mz_upperbound);
-
-        Size start_idx(lower_it - mz_keys.begin());
-        Size end_idx(upper_it - mz_keys.begin());
+        std::pair<SpectralLibraryIndex::ConstIterator, SpectralLibraryIndex::ConstIterator> candidates = library_index.findByPrecursorMZ(prec_mz_lowerbound, prec_mz_upperbound);
 
         //cout << "identifying " << msexp[spec_idx].getMetaValue("Massbank_Accession_ID") << endl;
 
         vector<SpectralMatch> partial_results;
 
-        for (Size search_idx = start_idx; search_idx < end_idx; ++search_idx)
+        for (SpectralLibraryIndex::ConstIterator cand_it = candidates.first; cand_it != candidates.second; ++cand_it)
         {
+          const Size search_idx(cand_it->second);
           // do spectral matching
           // cout << "scanning " << spec_db[search_idx].getPrecursors()[0].getMZ() << " " << spec_db[search_idx].getMetaValue("Metabolite_Name") << endl;
 
@@ -580,6 +579,12 @@ namespace OpenMS
       } // end precursor loop
     } // end spectra loop
 
+    vector<SpectralMatch> matching_results;
+    for (Size spec_idx = 0; spec_idx < spectrum_results.size(); ++spec_idx)
+    {
+      matching_results.insert(matching_results.end(), spectrum_results[spec_idx].begin(), spectrum_results[spec_idx].end());
+    }
+
     // write final results to MzTab
     exportMzTab_(matching_results, mztab_out);
   }
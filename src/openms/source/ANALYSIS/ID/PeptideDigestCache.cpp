@@ -0,0 +1,332 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/ANALYSIS/ID/PeptideDigestCache.h>
+
+#include <OpenMS/ANALYSIS/RNPXL/ModifiedPeptideGenerator.h>
+#include <OpenMS/CHEMISTRY/AASequence.h>
+#include <OpenMS/CHEMISTRY/ProteaseDigestion.h>
+#include <OpenMS/CHEMISTRY/ResidueMassTable.h>
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/FORMAT/FileHandler.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <QCryptographicHash>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <set>
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+using namespace std;
+
+namespace OpenMS
+{
+
+  namespace
+  {
+    const char DIGEST_CACHE_MAGIC[16] = "OPENMS_DIGEST_1";
+
+    /// header size after the key, padded to a multiple of 8 so the records are aligned
+    Size alignedSize_(Size size)
+    {
+      return (size + 7) / 8 * 8;
+    }
+
+    /// a candidate during construction of the cache
+    struct Candidate_
+    {
+      double mass;
+      Size unmodified;
+      Size mod_index;
+      String sequence;
+    };
+  }
+
+  String PeptideDigestCache::Settings::toString() const
+  {
+    return enzyme
+      + "|" + String(missed_cleavages)
+      + "|" + String(min_length) + "-" + String(max_length)
+      + "|" + String(min_mass) + "-" + String(max_mass)
+      + "|" + ListUtils::concatenate(fixed_modifications, ",")
+      + "|" + ListUtils::concatenate(variable_modifications, ",")
+      + "|" + String(max_variable_mods_per_peptide)
+      + "|" + database_tag;
+  }
+
+  PeptideDigestCache::PeptideDigestCache() :
+    entries_(nullptr),
+    size_(0),
+    sequences_(nullptr)
+  {
+  }
+
+  PeptideDigestCache::~PeptideDigestCache() = default;
+
+  String PeptideDigestCache::getKey(const String& fasta_file, const Settings& settings)
+  {
+    QCryptographicHash crypto(QCryptographicHash::Sha1);
+    crypto.addData(FileHandler::computeFileHash(fasta_file).c_str());
+    crypto.addData(settings.toString().c_str());
+    return String((QString)crypto.result().toHex());
+  }
+
+  String PeptideDigestCache::getFilename(const String& directory, const String& key)
+  {
+    return directory + "/" + key + ".digest";
+  }
+
+  void PeptideDigestCache::build(const vector<FASTAFile::FASTAEntry>& proteins, const Settings& settings, const String& key, const String& filename)
+  {
+    ProteaseDigestion digestor;
+    digestor.setEnzyme(settings.enzyme);
+    digestor.setMissedCleavages(settings.missed_cleavages);
+
+    const ModifiedPeptideGenerator::MapToResidueType fixed_modifications = ModifiedPeptideGenerator::getModifications(settings.fixed_modifications);
+    const ModifiedPeptideGenerator::MapToResidueType variable_modifications = ModifiedPeptideGenerator::getModifications(settings.variable_modifications);
+
+    // masses of the unmodified peptides (with fixed modifications) and the range variable modifications can add
+    vector<const ResidueModification*> fixed_mods, variable_mods;
+    for (const auto& m : fixed_modifications.val) { fixed_mods.push_back(m.first); }
+    for (const auto& m : variable_modifications.val) { variable_mods.push_back(m.first); }
+    const ResidueMassTable mass_table(fixed_mods);
+    double min_shift(0), max_shift(0);
+    mass_table.getVariableModificationShiftRange(variable_mods, settings.max_variable_mods_per_peptide, min_shift, max_shift);
+
+    // unique unmodified peptides (views into the protein sequences)
+    set<StringView> unique_peptides;
+    for (const FASTAFile::FASTAEntry& protein : proteins)
+    {
+      vector<StringView> current_digest;
+      digestor.digestUnmodified(protein.sequence, current_digest, settings.min_length, settings.max_length);
+      for (const StringView& c : current_digest)
+      {
+        const String current_peptide = c.getString();
+        if (current_peptide.find_first_of("XBZ") != std::string::npos) { continue; }
+
+        // skip peptides if none of their modified variants can be in the mass range
+        const double mass = mass_table.getMonoWeight(c);
+        if (mass + max_shift < settings.min_mass || (settings.max_mass > 0 && mass + min_shift > settings.max_mass)) { continue; }
+
+        unique_peptides.insert(c);
+      }
+    }
+    const vector<StringView> peptides(unique_peptides.begin(), unique_peptides.end());
+
+    // expand modified variants (ResidueDB and ModificationsDB are thread-safe)
+    vector<Candidate_> candidates;
+#pragma omp parallel
+    {
+      vector<Candidate_> local_candidates;
+#pragma omp for schedule(dynamic, 1000) nowait
+      for (SignedSize i = 0; i < (SignedSize)peptides.size(); ++i)
+      {
+        AASequence aas = AASequence::fromString(peptides[i].getString());
+        vector<AASequence> all_modified_peptides;
+        ModifiedPeptideGenerator::applyFixedModifications(fixed_modifications, aas);
+        ModifiedPeptideGenerator::applyVariableModifications(variable_modifications, aas, settings.max_variable_mods_per_peptide, all_modified_peptides);
+
+        for (Size mod_index = 0; mod_index < all_modified_peptides.size(); ++mod_index)
+        {
+          const double mass = all_modified_peptides[mod_index].getMonoWeight();
+          if (mass < settings.min_mass || (settings.max_mass > 0 && mass > settings.max_mass)) { continue; }
+          local_candidates.push_back(Candidate_{mass, (Size)i, mod_index, all_modified_peptides[mod_index].toString()});
+        }
+      }
+#pragma omp critical (PeptideDigestCache_build)
+      candidates.insert(candidates.end(), make_move_iterator(local_candidates.begin()), make_move_iterator(local_candidates.end()));
+    }
+
+    // sort by mass (ties broken by sequence so the file does not depend on the number of threads)
+    sort(candidates.begin(), candidates.end(), [](const Candidate_& a, const Candidate_& b)
+    {
+      if (a.mass != b.mass) return a.mass < b.mass;
+      return a.sequence < b.sequence;
+    });
+
+    // sequence block: all unmodified peptide sequences, followed by the modified ones
+    vector<UInt64> unmodified_offsets(peptides.size());
+    UInt64 sequences_size = 0;
+    for (Size i = 0; i < peptides.size(); ++i)
+    {
+      unmodified_offsets[i] = sequences_size;
+      sequences_size += peptides[i].size();
+    }
+
+    vector<Entry_> entries;
+    entries.reserve(candidates.size());
+    for (const Candidate_& c : candidates)
+    {
+      entries.push_back(Entry_{c.mass, unmodified_offsets[c.unmodified], sequences_size, 
+        (UInt32)peptides[c.unmodified].size(), (UInt32)c.sequence.size(), (UInt64)c.mod_index});
+      sequences_size += c.sequence.size();
+    }
+
+    // write under a temporary name first, so concurrent readers never see a partial file
+    const String tmp_filename = filename + "." + File::getUniqueName() + ".tmp";
+    {
+      ofstream ofs(tmp_filename.c_str(), ios::binary);
+      if (!ofs)
+      {
+        throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+      }
+
+      ofs.write(DIGEST_CACHE_MAGIC, sizeof(DIGEST_CACHE_MAGIC));
+      const UInt64 key_size = key.size();
+      ofs.write(reinterpret_cast<const char*>(&key_size), sizeof(key_size));
+      vector<char> padded_key(alignedSize_(key.size()), 0);
+      std::copy(key.begin(), key.end(), padded_key.begin());
+      ofs.write(padded_key.data(), padded_key.size());
+
+      const UInt64 nr_entries = entries.size();
+      ofs.write(reinterpret_cast<const char*>(&nr_entries), sizeof(nr_entries));
+      ofs.write(reinterpret_cast<const char*>(&sequences_size), sizeof(sequences_size));
+      ofs.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(Entry_));
+      for (const StringView& p : peptides)
+      {
+        ofs << p.getString();
+      }
+      for (const Candidate_& c : candidates)
+      {
+        ofs << c.sequence;
+      }
+
+      if (!ofs)
+      {
+        throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+      }
+    }
+
+    if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+    {
+      File::remove(tmp_filename);
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    OPENMS_LOG_INFO << "Peptide digest cache: " << peptides.size() << " peptides, " << entries.size() << " candidates written to " << filename << endl;
+  }
+
+  bool PeptideDigestCache::load(const String& filename, const String& key)
+  {
+    clear();
+    if (!File::exists(filename)) return false;
+
+    boost::shared_ptr<boost::interprocess::mapped_region> mapped_file;
+    try
+    {
+      boost::interprocess::file_mapping mapping(filename.c_str(), boost::interprocess::read_only);
+      mapped_file.reset(new boost::interprocess::mapped_region(mapping, boost::interprocess::read_only));
+    }
+    catch (boost::interprocess::interprocess_exception& e)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, String("Could not memory-map file: ") + e.what());
+    }
+
+    const char* data = static_cast<const char*>(mapped_file->get_address());
+    const Size file_size = mapped_file->get_size();
+    Size pos = sizeof(DIGEST_CACHE_MAGIC) + sizeof(UInt64);
+    if (file_size < pos || memcmp(data, DIGEST_CACHE_MAGIC, sizeof(DIGEST_CACHE_MAGIC)) != 0)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Not a peptide digest cache file.");
+    }
+
+    UInt64 key_size;
+    memcpy(&key_size, data + sizeof(DIGEST_CACHE_MAGIC), sizeof(key_size));
+    if (file_size < pos + alignedSize_(key_size) + 2 * sizeof(UInt64))
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Truncated peptide digest cache file.");
+    }
+    if (String(data + pos, data + pos + key_size) != key) return false;
+    pos += alignedSize_(key_size);
+
+    UInt64 nr_entries, sequences_size;
+    memcpy(&nr_entries, data + pos, sizeof(nr_entries));
+    memcpy(&sequences_size, data + pos + sizeof(UInt64), sizeof(sequences_size));
+    pos += 2 * sizeof(UInt64);
+    if (file_size != pos + nr_entries * sizeof(Entry_) + sequences_size)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Truncated peptide digest cache file.");
+    }
+
+    mapped_file_ = mapped_file;
+    entries_ = reinterpret_cast<const Entry_*>(data + pos);
+    size_ = nr_entries;
+    sequences_ = data + pos + nr_entries * sizeof(Entry_);
+    return true;
+  }
+
+  void PeptideDigestCache::clear()
+  {
+    mapped_file_.reset();
+    entries_ = nullptr;
+    size_ = 0;
+    sequences_ = nullptr;
+  }
+
+  Size PeptideDigestCache::size() const
+  {
+    return size_;
+  }
+
+  double PeptideDigestCache::getMass(Size index) const
+  {
+    return entries_[index].mass;
+  }
+
+  PeptideDigestCache::Peptide PeptideDigestCache::getPeptide(Size index) const
+  {
+    const Entry_& e = entries_[index];
+    return Peptide{e.mass, (Size)e.mod_index,
+      StringView(sequences_ + e.unmodified_offset, e.unmodified_length),
+      StringView(sequences_ + e.modified_offset, e.modified_length)};
+  }
+
+  Size PeptideDigestCache::lowerBound(double mass) const
+  {
+    return std::lower_bound(entries_, entries_ + size_, mass, [](const Entry_& e, double m) { return e.mass < m; }) - entries_;
+  }
+
+} // namespace OpenMS
+
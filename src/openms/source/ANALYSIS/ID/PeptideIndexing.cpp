@@ -93,6 +93,13 @@ using namespace std;
     defaults_.setValue("IL_equivalent", "false", "Treat the isobaric amino acids isoleucine ('I') and leucine ('L') as equivalent (indistinguishable). Also occurences of 'J' will be treated as 'I' thus avoiding ambiguous matching.");
     defaults_.setValidStrings("IL_equivalent", ListUtils::create<String>("true,false"));
 
+    defaults_.setValue("search_backend", "aho-corasick", "Algorithm for finding peptides in the database. 'aho-corasick' streams the database through a trie of all peptides."
+                                                         " 'suffix_array' indexes the database instead, which pays off for large databases and repeated runs (see 'index_file').");
+    defaults_.setValidStrings("search_backend", ListUtils::create<String>("aho-corasick,suffix_array"));
+
+    defaults_.setValue("index_file", "", "Persistent suffix array index of the FASTA database (only used with search_backend 'suffix_array')."
+                                         " The index is loaded if it was built from the same database with the same 'IL_equivalent' setting; otherwise it is (re)built and written to this file.");
+
     defaultsToParam_();
   }
 
@@ -114,6 +121,8 @@ using namespace std;
     IL_equivalent_ = param_.getValue("IL_equivalent").toBool();
     aaa_max_ = static_cast<Int>(param_.getValue("aaa_max"));
     mm_max_ = static_cast<Int>(param_.getValue("mismatches_max"));
+    search_backend_ = static_cast<String>(param_.getValue("search_backend"));
+    index_file_ = static_cast<String>(param_.getValue("index_file"));
   }
 
 const String &PeptideIndexing::getDecoyString() const
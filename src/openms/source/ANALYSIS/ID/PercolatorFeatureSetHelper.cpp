@@ -34,7 +34,9 @@
 
 #include <OpenMS/config.h>
 #include <OpenMS/CONCEPT/Constants.h>
+#include <OpenMS/CONCEPT/ParallelExecution.h>
 #include <OpenMS/ANALYSIS/ID/PercolatorFeatureSetHelper.h>
+#include <OpenMS/METADATA/MetaInfoRegistry.h>
 
 using namespace std;
 
@@ -56,18 +58,42 @@ namespace OpenMS
       feature_set.push_back("MSGF:sqMeanErrorTop7");
       feature_set.push_back("MSGF:StdevErrorTop7");
       
-      for (vector<PeptideIdentification>::iterator it = peptide_ids.begin(); it != peptide_ids.end(); ++it)
+      // resolve the meta value keys once instead of for every PSM
+      MetaInfoRegistry& registry = MetaInfoInterface::metaRegistry();
+      const UInt num_matched_main_ions_key = registry.registerName("NumMatchedMainIons");
+      const UInt mean_error_top7_key = registry.registerName("MeanErrorTop7");
+      const UInt stdev_error_top7_key = registry.registerName("StdevErrorTop7");
+      const UInt raw_score_key = registry.registerName("MS:1002049");
+      const UInt denovo_score_key = registry.registerName("MS:1002050");
+      const UInt evalue_key = registry.registerName("MS:1002053");
+      const UInt explained_ion_current_ratio_key = registry.registerName("ExplainedIonCurrentRatio");
+      const UInt nterm_ion_current_ratio_key = registry.registerName("NTermIonCurrentRatio");
+      const UInt cterm_ion_current_ratio_key = registry.registerName("CTermIonCurrentRatio");
+      const UInt ms2_ion_current_key = registry.registerName("MS2IonCurrent");
+      const UInt score_ratio_key = registry.registerName("MSGF:ScoreRatio");
+      const UInt energy_key = registry.registerName("MSGF:Energy");
+      const UInt ln_evalue_key = registry.registerName("MSGF:lnEValue");
+      const UInt ln_explained_ion_current_ratio_key = registry.registerName("MSGF:lnExplainedIonCurrentRatio");
+      const UInt ln_nterm_ion_current_ratio_key = registry.registerName("MSGF:lnNTermIonCurrentRatio");
+      const UInt ln_cterm_ion_current_ratio_key = registry.registerName("MSGF:lnCTermIonCurrentRatio");
+      const UInt ln_ms2_ion_current_key = registry.registerName("MSGF:lnMS2IonCurrent");
+      const UInt msgf_mean_error_top7_key = registry.registerName("MSGF:MeanErrorTop7");
+      const UInt msgf_sq_mean_error_top7_key = registry.registerName("MSGF:sqMeanErrorTop7");
+      const UInt msgf_stdev_error_top7_key = registry.registerName("MSGF:StdevErrorTop7");
+
+      // the PSMs are independent of each other
+      ParallelExecution::forEach(0, (SignedSize)peptide_ids.size(), [&](SignedSize i)
       {
-        for (vector<PeptideHit>::iterator hit = it->getHits().begin(); hit != it->getHits().end(); ++hit)
+        for (PeptideHit& hit : peptide_ids[i].getHits())
         {
           // Some Hits have no NumMatchedMainIons, and MeanError, etc. values. Have to ignore them!
-          if (hit->metaValueExists("NumMatchedMainIons"))
+          if (hit.metaValueExists(num_matched_main_ions_key))
           {
             // only take features from first ranked entries and only with meanerrortop7 != 0.0
-            if (hit->getMetaValue("MeanErrorTop7").toString().toDouble() != 0.0)
+            if (hit.getMetaValue(mean_error_top7_key).toString().toDouble() != 0.0)
             {
-              double raw_score = hit->getMetaValue("MS:1002049").toString().toDouble();
-              double denovo_score = hit->getMetaValue("MS:1002050").toString().toDouble();
+              double raw_score = hit.getMetaValue(raw_score_key).toString().toDouble();
+              double denovo_score = hit.getMetaValue(denovo_score_key).toString().toDouble();
               
               double energy = denovo_score - raw_score;
               double score_ratio = raw_score * 10000;
@@ -75,29 +101,30 @@ namespace OpenMS
               {
                 score_ratio = (raw_score / denovo_score);
               }
-              hit->setMetaValue("MSGF:ScoreRatio", score_ratio);
-              hit->setMetaValue("MSGF:Energy", energy);
+              hit.setMetaValue(score_ratio_key, score_ratio);
+              hit.setMetaValue(energy_key, energy);
               
-              double ln_eval = -log(hit->getMetaValue("MS:1002053").toString().toDouble());
-              hit->setMetaValue("MSGF:lnEValue", ln_eval);
+              double ln_eval = -log(hit.getMetaValue(evalue_key).toString().toDouble());
+              hit.setMetaValue(ln_evalue_key, ln_eval);
               
-              double ln_explained_ion_current_ratio = log(hit->getMetaValue("ExplainedIonCurrentRatio").toString().toDouble() + 0.0001);           // @andsi: wtf?!
-              double ln_NTerm_ion_current_ratio = log(hit->getMetaValue("NTermIonCurrentRatio").toString().toDouble() + 0.0001);           // @andsi: wtf?!
-              double ln_CTerm_ion_current_ratio = log(hit->getMetaValue("CTermIonCurrentRatio").toString().toDouble() + 0.0001);           // @andsi: wtf?!
-              hit->setMetaValue("MSGF:lnExplainedIonCurrentRatio", ln_explained_ion_current_ratio);
-              hit->setMetaValue("MSGF:lnNTermIonCurrentRatio", ln_NTerm_ion_current_ratio);
-              hit->setMetaValue("MSGF:lnCTermIonCurrentRatio", ln_CTerm_ion_current_ratio);
+              double ln_explained_ion_current_ratio = log(hit.getMetaValue(explained_ion_current_ratio_key).toString().toDouble() + 0.0001);           // @andsi: wtf?!
+              double ln_NTerm_ion_current_ratio = log(hit.getMetaValue(nterm_ion_current_ratio_key).toString().toDouble() + 0.0001);           // @andsi: wtf?!
+              double ln_CTerm_ion_current_ratio = log(hit.getMetaValue(cterm_ion_current_ratio_key).toString().toDouble() + 0.0001);           // @andsi: wtf?!
+              hit.setMetaValue(ln_explained_ion_current_ratio_key, ln_explained_ion_current_ratio);
+              hit.setMetaValue(ln_nterm_ion_current_ratio_key, ln_NTerm_ion_current_ratio);
+              hit.setMetaValue(ln_cterm_ion_current_ratio_key, ln_CTerm_ion_current_ratio);
               
-              double ln_MS2_ion_current = log(hit->getMetaValue("MS2IonCurrent").toString().toDouble());
-              hit->setMetaValue("MSGF:lnMS2IonCurrent", ln_MS2_ion_current);
+              double ln_MS2_ion_current = log(hit.getMetaValue(ms2_ion_current_key).toString().toDouble());
+              hit.setMetaValue(ln_ms2_ion_current_key, ln_MS2_ion_current);
               
-              double mean_error_top7 = hit->getMetaValue("MeanErrorTop7").toString().toDouble();
-              int num_matched_main_ions =  hit->getMetaValue("NumMatchedMainIons").toString().toInt();
+              double mean_error_top7 = hit.getMetaValue(mean_error_top7_key).toString().toDouble();
+              int num_matched_main_ions =  hit.getMetaValue(num_matched_main_ions_key).toString().toInt();
 
               double stdev_error_top7 = 0.0;
-              if (hit->getMetaValue("StdevErrorTop7").toString() != "NaN")
+              const String stdev_error_top7_string = hit.getMetaValue(stdev_error_top7_key).toString();
+              if (stdev_error_top7_string != "NaN")
               {
-                stdev_error_top7 = hit->getMetaValue("StdevErrorTop7").toString().toDouble();
+                stdev_error_top7 = stdev_error_top7_string.toDouble();
                 if (stdev_error_top7 == 0.0)
                 {
                   stdev_error_top7 = mean_error_top7;
@@ -112,14 +139,14 @@ namespace OpenMS
               mean_error_top7 = rescaleFragmentFeature_(mean_error_top7, num_matched_main_ions);
               double sq_mean_error_top7 = rescaleFragmentFeature_(mean_error_top7 * mean_error_top7, num_matched_main_ions);
               stdev_error_top7 = rescaleFragmentFeature_(stdev_error_top7, num_matched_main_ions);
-              hit->setMetaValue("MSGF:MeanErrorTop7", mean_error_top7);
-              hit->setMetaValue("MSGF:sqMeanErrorTop7", sq_mean_error_top7);
-              hit->setMetaValue("MSGF:StdevErrorTop7", stdev_error_top7);
+              hit.setMetaValue(msgf_mean_error_top7_key, mean_error_top7);
+              hit.setMetaValue(msgf_sq_mean_error_top7_key, sq_mean_error_top7);
+              hit.setMetaValue(msgf_stdev_error_top7_key, stdev_error_top7);
             }
           }
           else OPENMS_LOG_WARN << "MS-GF+ PSM with missing NumMatchedMainIons skipped." << endl;
         }
-      }
+      });
     }
     
     void PercolatorFeatureSetHelper::addXTANDEMFeatures(vector<PeptideIdentification>& peptide_ids, StringList& feature_set)
@@ -174,49 +201,67 @@ namespace OpenMS
       feature_set.push_back("COMET:lnRankSP"); // log(rank based on Sp score)
       feature_set.push_back("COMET:IonFrac"); // matched_ions / total_ions
       
-      for (vector<PeptideIdentification>::iterator it = peptide_ids.begin(); it != peptide_ids.end(); ++it)
+      // resolve the meta value keys once instead of for every PSM
+      MetaInfoRegistry& registry = MetaInfoInterface::metaRegistry();
+      const UInt xcorr_key = registry.registerName("MS:1002252");
+      const UInt sp_key = registry.registerName("MS:1002255");
+      const UInt rank_sp_key = registry.registerName("MS:1002256");
+      const UInt expect_key = registry.registerName("MS:1002257");
+      const UInt matched_ions_key = registry.registerName("MS:1002258");
+      const UInt total_ions_key = registry.registerName("MS:1002259");
+      const UInt num_matched_peptides_key = registry.registerName("num_matched_peptides");
+      const UInt delta_cn_key = registry.registerName("COMET:deltCn");
+      const UInt delta_last_cn_key = registry.registerName("COMET:deltLCn");
+      const UInt ln_expect_key = registry.registerName("COMET:lnExpect");
+      const UInt ln_num_sp_key = registry.registerName("COMET:lnNumSP");
+      const UInt ln_rank_sp_key = registry.registerName("COMET:lnRankSP");
+      const UInt ion_frac_key = registry.registerName("COMET:IonFrac");
+
+      // the spectra are independent of each other
+      ParallelExecution::forEach(0, (SignedSize)peptide_ids.size(), [&](SignedSize i)
       {
+        vector<PeptideHit>& hits = peptide_ids[i].getHits();
         double worst_xcorr = 0, second_xcorr = 0;
         Int cnt = 0;
-        for (vector<PeptideHit>::iterator hit = it->getHits().begin(); hit != it->getHits().end(); ++hit)
+        for (const PeptideHit& hit : hits)
         {
-          double xcorr = hit->getMetaValue("MS:1002252").toString().toDouble();
+          double xcorr = hit.getMetaValue(xcorr_key).toString().toDouble();
           worst_xcorr = xcorr;
           if (cnt == 1) { second_xcorr = xcorr; }
           ++cnt;
         }
         
-        for (vector<PeptideHit>::iterator hit = it->getHits().begin(); hit != it->getHits().end(); ++hit)
+        for (PeptideHit& hit : hits)
         {
-          double xcorr = hit->getMetaValue("MS:1002252").toString().toDouble();
+          double xcorr = hit.getMetaValue(xcorr_key).toString().toDouble();
           double delta_cn = (xcorr - second_xcorr) / max(1.0, xcorr);
           double delta_last_cn = (xcorr - worst_xcorr) / max(1.0, xcorr);
-          hit->setMetaValue("COMET:deltCn", delta_cn);
-          hit->setMetaValue("COMET:deltLCn", delta_last_cn);
+          hit.setMetaValue(delta_cn_key, delta_cn);
+          hit.setMetaValue(delta_last_cn_key, delta_last_cn);
           
-          double ln_expect = log(hit->getMetaValue("MS:1002257").toString().toDouble());
-          hit->setMetaValue("COMET:lnExpect", ln_expect);
+          double ln_expect = log(hit.getMetaValue(expect_key).toString().toDouble());
+          hit.setMetaValue(ln_expect_key, ln_expect);
          
           double ln_num_sp;   
-          if (hit->metaValueExists("num_matched_peptides"))
+          if (hit.metaValueExists(num_matched_peptides_key))
           {
-            double num_sp = hit->getMetaValue("num_matched_peptides").toString().toDouble();
+            double num_sp = hit.getMetaValue(num_matched_peptides_key).toString().toDouble();
             ln_num_sp = log(max(1.0, num_sp));  // if recorded, one can be safely assumed
           }
           else // fallback
           {
-            ln_num_sp = hit->getMetaValue("MS:1002255").toString().toDouble();
+            ln_num_sp = hit.getMetaValue(sp_key).toString().toDouble();
           }
-          double ln_rank_sp = log(max(1.0, hit->getMetaValue("MS:1002256").toString().toDouble()));
-          hit->setMetaValue("COMET:lnNumSP", ln_num_sp);
-          hit->setMetaValue("COMET:lnRankSP", ln_rank_sp);
+          double ln_rank_sp = log(max(1.0, hit.getMetaValue(rank_sp_key).toString().toDouble()));
+          hit.setMetaValue(ln_num_sp_key, ln_num_sp);
+          hit.setMetaValue(ln_rank_sp_key, ln_rank_sp);
           
-          double num_matched_ions = hit->getMetaValue("MS:1002258").toString().toDouble();
-          double num_total_ions = hit->getMetaValue("MS:1002259").toString().toDouble();
+          double num_matched_ions = hit.getMetaValue(matched_ions_key).toString().toDouble();
+          double num_total_ions = hit.getMetaValue(total_ions_key).toString().toDouble();
           double ion_frac = num_matched_ions / num_total_ions;
-          hit->setMetaValue("COMET:IonFrac", ion_frac);
+          hit.setMetaValue(ion_frac_key, ion_frac);
         }
-      }
+      });
     }
 
     /**
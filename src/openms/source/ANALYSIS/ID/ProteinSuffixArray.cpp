@@ -0,0 +1,485 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/ANALYSIS/ID/ProteinSuffixArray.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/FORMAT/FileHandler.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <QCryptographicHash>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+using namespace std;
+
+namespace OpenMS
+{
+
+  namespace
+  {
+    const char SUFFIX_ARRAY_MAGIC[16] = "OPENMS_SUFFIX_1";
+
+    /// header size after the key, padded to a multiple of 8 so the arrays are aligned
+    Size alignedSize_(Size size)
+    {
+      return (size + 7) / 8 * 8;
+    }
+
+    /// does the ambiguous amino acid @p amb (in the protein) stand for @p aa (in the peptide)?
+    bool covers_(char amb, char aa)
+    {
+      switch (amb)
+      {
+        case 'B': return aa == 'D' || aa == 'N';
+        case 'J': return aa == 'I' || aa == 'L';
+        case 'Z': return aa == 'E' || aa == 'Q';
+        case 'X': return true;
+        default: return false;
+      }
+    }
+
+    bool isAmbiguous_(char c)
+    {
+      return c == 'B' || c == 'J' || c == 'Z' || c == 'X';
+    }
+  }
+
+  ProteinSuffixArray::ProteinSuffixArray()
+  {
+    clear();
+  }
+
+  ProteinSuffixArray::~ProteinSuffixArray() = default;
+
+  String ProteinSuffixArray::getKey(const String& fasta_file, const String& settings)
+  {
+    QCryptographicHash crypto(QCryptographicHash::Sha1);
+    crypto.addData(FileHandler::computeFileHash(fasta_file).c_str());
+    crypto.addData(settings.c_str());
+    return String((QString)crypto.result().toHex());
+  }
+
+  void ProteinSuffixArray::clear()
+  {
+    mapped_file_.reset();
+    own_text_.clear();
+    own_suffix_array_.clear();
+    own_protein_starts_.assign(1, 0);
+    own_accession_starts_.assign(1, 0);
+    own_accessions_.clear();
+    built_ = false;
+    updateViews_();
+  }
+
+  void ProteinSuffixArray::updateViews_()
+  {
+    text_ = own_text_.data();
+    text_size_ = own_text_.size();
+    suffix_array_ = own_suffix_array_.data();
+    protein_starts_ = own_protein_starts_.data();
+    accession_starts_ = own_accession_starts_.data();
+    accessions_ = own_accessions_.data();
+    nr_proteins_ = own_protein_starts_.size() - 1;
+  }
+
+  void ProteinSuffixArray::addProtein(const String& accession, const String& sequence)
+  {
+    if (built_)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Cannot add proteins to an index which was already built.");
+    }
+    own_text_.append(sequence);
+    own_text_.push_back('\0'); // separator, never matches a residue
+    own_protein_starts_.push_back(own_text_.size());
+    own_accessions_.append(accession);
+    own_accession_starts_.push_back(own_accessions_.size());
+    updateViews_();
+  }
+
+  void ProteinSuffixArray::build()
+  {
+    // Prefix doubling: bucket all suffixes by their first 2 characters, sort the buckets by the first 8
+    // characters, then repeatedly sort the groups of suffixes which are still tied by the rank of the
+    // suffix k positions further (k = 8, 16, 32, ...). Groups are independent of each other, so they are
+    // sorted in parallel.
+    const Size n = own_text_.size();
+    const unsigned char* text = reinterpret_cast<const unsigned char*>(own_text_.data());
+    vector<UInt64>& sa = own_suffix_array_;
+    sa.resize(n);
+
+    vector<UInt64> keys(n); // first 8 characters, big endian
+#pragma omp parallel for
+    for (SignedSize i = 0; i < (SignedSize)n; ++i)
+    {
+      UInt64 key = 0;
+      for (Size j = 0; j < 8; ++j)
+      {
+        key = (key << 8) | ((Size)i + j < n ? text[i + j] : 0);
+      }
+      keys[i] = key;
+    }
+
+    // counting sort by the first 2 characters;
+    // rank of a suffix = 1 + position of the first suffix of its group in the suffix array
+    vector<Size> bucket_starts((1 << 16) + 1, 0);
+    for (Size i = 0; i < n; ++i) ++bucket_starts[(keys[i] >> 48) + 1];
+    std::partial_sum(bucket_starts.begin(), bucket_starts.end(), bucket_starts.begin());
+    vector<UInt64> rank(n);
+    {
+      vector<Size> fill(bucket_starts.begin(), bucket_starts.end() - 1);
+      for (Size i = 0; i < n; ++i)
+      {
+        const Size bucket = keys[i] >> 48;
+        sa[fill[bucket]++] = i;
+        rank[i] = bucket_starts[bucket] + 1;
+      }
+    }
+    vector<pair<Size, Size>> groups; // [begin, end) of groups with more than one suffix
+    for (Size bucket = 0; bucket + 1 < bucket_starts.size(); ++bucket)
+    {
+      if (bucket_starts[bucket + 1] - bucket_starts[bucket] > 1) groups.emplace_back(bucket_starts[bucket], bucket_starts[bucket + 1]);
+    }
+
+    // the first round sorts by the 8 character prefix, all further ones by the rank k characters further
+    vector<UInt64> new_rank(n); // indexed by suffix array position
+    for (Size k = 0; !groups.empty(); k = (k == 0 ? 8 : 2 * k))
+    {
+      // suffixes reaching beyond the text are smaller than all others and ordered by length
+      // (the padding is indistinguishable from a separator otherwise, e.g. for empty proteins)
+      auto sortKey = [&rank, &keys, n, k](UInt64 pos) -> UInt64
+      {
+        if (k == 0) return keys[pos];
+        return pos + k < n ? n + rank[pos + k] : n - pos;
+      };
+
+      vector<pair<Size, Size>> next_groups;
+#pragma omp parallel
+      {
+        vector<pair<Size, Size>> thread_groups;
+        vector<pair<UInt64, UInt64>> buffer; // (key, suffix), sorted locally for cache efficiency
+#pragma omp for schedule(dynamic, 16)
+        for (SignedSize g = 0; g < (SignedSize)groups.size(); ++g)
+        {
+          const Size b = groups[g].first, e = groups[g].second;
+          buffer.clear();
+          for (Size j = b; j < e; ++j) buffer.emplace_back(sortKey(sa[j]), sa[j]);
+          std::sort(buffer.begin(), buffer.end());
+          Size head = b;
+          for (Size j = b; j < e; ++j)
+          {
+            if (j > b && buffer[j - b].first != buffer[j - b - 1].first)
+            {
+              if (j - head > 1) thread_groups.emplace_back(head, j);
+              head = j;
+            }
+            sa[j] = buffer[j - b].second;
+            new_rank[j] = head + 1;
+          }
+          if (e - head > 1) thread_groups.emplace_back(head, e);
+        }
+        // ranks may only change after all groups were sorted, since they are read across groups
+#pragma omp for schedule(dynamic, 16)
+        for (SignedSize g = 0; g < (SignedSize)groups.size(); ++g)
+        {
+          for (Size j = groups[g].first; j < groups[g].second; ++j)
+          {
+            rank[sa[j]] = new_rank[j];
+          }
+        }
+#pragma omp critical (ProteinSuffixArray_build)
+        next_groups.insert(next_groups.end(), thread_groups.begin(), thread_groups.end());
+      }
+      groups.swap(next_groups);
+      if (k == 0) vector<UInt64>().swap(keys);
+    }
+
+    built_ = true;
+    updateViews_();
+  }
+
+  void ProteinSuffixArray::store(const String& filename, const String& key) const
+  {
+    if (!built_)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "index was not built");
+    }
+    // write under a temporary name first, so concurrent readers never see a partial file
+    const String tmp_filename = filename + "." + File::getUniqueName() + ".tmp";
+    {
+      ofstream ofs(tmp_filename.c_str(), ios::binary);
+      if (!ofs)
+      {
+        throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+      }
+
+      ofs.write(SUFFIX_ARRAY_MAGIC, sizeof(SUFFIX_ARRAY_MAGIC));
+      const UInt64 key_size = key.size();
+      ofs.write(reinterpret_cast<const char*>(&key_size), sizeof(key_size));
+      vector<char> padded_key(alignedSize_(key.size()), 0);
+      std::copy(key.begin(), key.end(), padded_key.begin());
+      ofs.write(padded_key.data(), padded_key.size());
+
+      const UInt64 sizes[3] = {nr_proteins_, text_size_, accession_starts_[nr_proteins_]};
+      ofs.write(reinterpret_cast<const char*>(sizes), sizeof(sizes));
+      ofs.write(reinterpret_cast<const char*>(protein_starts_), (nr_proteins_ + 1) * sizeof(UInt64));
+      ofs.write(reinterpret_cast<const char*>(accession_starts_), (nr_proteins_ + 1) * sizeof(UInt64));
+      ofs.write(reinterpret_cast<const char*>(suffix_array_), text_size_ * sizeof(UInt64));
+      ofs.write(text_, text_size_);
+      ofs.write(accessions_, accession_starts_[nr_proteins_]);
+
+      if (!ofs)
+      {
+        throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+      }
+    }
+
+    if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+    {
+      File::remove(tmp_filename);
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    OPENMS_LOG_INFO << "Protein suffix array: " << nr_proteins_ << " proteins (" << text_size_ << " residues) written to " << filename << endl;
+  }
+
+  bool ProteinSuffixArray::load(const String& filename, const String& key)
+  {
+    clear();
+    if (!File::exists(filename)) return false;
+
+    boost::shared_ptr<boost::interprocess::mapped_region> mapped_file;
+    try
+    {
+      boost::interprocess::file_mapping mapping(filename.c_str(), boost::interprocess::read_only);
+      mapped_file.reset(new boost::interprocess::mapped_region(mapping, boost::interprocess::read_only));
+    }
+    catch (boost::interprocess::interprocess_exception& e)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, String("Could not memory-map file: ") + e.what());
+    }
+
+    const char* data = static_cast<const char*>(mapped_file->get_address());
+    const Size file_size = mapped_file->get_size();
+    Size pos = sizeof(SUFFIX_ARRAY_MAGIC) + sizeof(UInt64);
+    if (file_size < pos || memcmp(data, SUFFIX_ARRAY_MAGIC, sizeof(SUFFIX_ARRAY_MAGIC)) != 0)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Not a protein suffix array file.");
+    }
+
+    UInt64 key_size;
+    memcpy(&key_size, data + sizeof(SUFFIX_ARRAY_MAGIC), sizeof(key_size));
+    UInt64 sizes[3];
+    if (file_size < pos + alignedSize_(key_size) + sizeof(sizes))
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Truncated protein suffix array file.");
+    }
+    if (String(data + pos, data + pos + key_size) != key) return false;
+    pos += alignedSize_(key_size);
+
+    memcpy(sizes, data + pos, sizeof(sizes));
+    pos += sizeof(sizes);
+    const UInt64 nr_proteins = sizes[0], text_size = sizes[1], accessions_size = sizes[2];
+    if (file_size != pos + (2 * (nr_proteins + 1) + text_size) * sizeof(UInt64) + text_size + accessions_size)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Truncated protein suffix array file.");
+    }
+
+    mapped_file_ = mapped_file;
+    nr_proteins_ = nr_proteins;
+    protein_starts_ = reinterpret_cast<const UInt64*>(data + pos);
+    pos += (nr_proteins + 1) * sizeof(UInt64);
+    accession_starts_ = reinterpret_cast<const UInt64*>(data + pos);
+    pos += (nr_proteins + 1) * sizeof(UInt64);
+    suffix_array_ = reinterpret_cast<const UInt64*>(data + pos);
+    pos += text_size * sizeof(UInt64);
+    text_ = data + pos;
+    text_size_ = text_size;
+    accessions_ = data + pos + text_size;
+    built_ = true;
+    return true;
+  }
+
+  Size ProteinSuffixArray::size() const
+  {
+    return nr_proteins_;
+  }
+
+  String ProteinSuffixArray::getAccession(Size index) const
+  {
+    return String(accessions_ + accession_starts_[index], accessions_ + accession_starts_[index + 1]);
+  }
+
+  StringView ProteinSuffixArray::getSequence(Size index) const
+  {
+    // without the separator
+    return StringView(text_ + protein_starts_[index], protein_starts_[index + 1] - protein_starts_[index] - 1);
+  }
+
+  void ProteinSuffixArray::narrow_(Size lo, Size hi, Size depth, char c, Size& lo_out, Size& hi_out) const
+  {
+    const unsigned char uc = static_cast<unsigned char>(c);
+    // first suffix with a character >= c (resp. > c) at depth
+    Size l = lo, h = hi;
+    while (l < h)
+    {
+      const Size mid = l + (h - l) / 2;
+      if (static_cast<unsigned char>(charAt_(mid, depth)) < uc) l = mid + 1;
+      else h = mid;
+    }
+    lo_out = l;
+    h = hi;
+    while (l < h)
+    {
+      const Size mid = l + (h - l) / 2;
+      if (static_cast<unsigned char>(charAt_(mid, depth)) <= uc) l = mid + 1;
+      else h = mid;
+    }
+    hi_out = l;
+  }
+
+  void ProteinSuffixArray::findAll(const String& peptide, Size aaa_max, Size mm_max, vector<Hit>& hits) const
+  {
+    if (!built_ || peptide.empty() || text_size_ == 0) return;
+    findAll_(peptide, 0, 0, text_size_, aaa_max, mm_max, hits);
+  }
+
+  void ProteinSuffixArray::findProteins(const vector<string>& tags, Size min_tags, vector<Size>& proteins) const
+  {
+    proteins.clear();
+    if (!built_ || text_size_ == 0) return;
+    min_tags = std::max(min_tags, Size(1));
+
+    vector<string> unique_tags(tags);
+    std::sort(unique_tags.begin(), unique_tags.end());
+    unique_tags.erase(std::unique(unique_tags.begin(), unique_tags.end()), unique_tags.end());
+    if (unique_tags.size() < min_tags) return;
+
+    // proteins of every tag (once per tag), then count the tags per protein
+    vector<Size> tag_proteins, candidates;
+    for (const string& tag : unique_tags)
+    {
+      if (tag.empty()) continue;
+      Size lo = 0, hi = text_size_;
+      for (Size depth = 0; depth < tag.size() && lo < hi; ++depth)
+      {
+        narrow_(lo, hi, depth, tag[depth], lo, hi);
+      }
+      tag_proteins.clear();
+      for (Size i = lo; i < hi; ++i)
+      {
+        const Size text_pos = suffix_array_[i];
+        tag_proteins.push_back(std::upper_bound(protein_starts_, protein_starts_ + nr_proteins_ + 1, text_pos) - protein_starts_ - 1);
+      }
+      std::sort(tag_proteins.begin(), tag_proteins.end());
+      tag_proteins.erase(std::unique(tag_proteins.begin(), tag_proteins.end()), tag_proteins.end());
+      candidates.insert(candidates.end(), tag_proteins.begin(), tag_proteins.end());
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+    for (Size i = 0, j = 0; i < candidates.size(); i = j)
+    {
+      while (j < candidates.size() && candidates[j] == candidates[i]) ++j;
+      if (j - i >= min_tags) proteins.push_back(candidates[i]);
+    }
+  }
+
+  void ProteinSuffixArray::findAll_(const String& peptide, Size depth, Size lo, Size hi, Size aaa_left, Size mm_left, vector<Hit>& hits) const
+  {
+    if (lo >= hi) return;
+
+    if (depth == peptide.size())
+    { // all suffixes in the interval start with the peptide
+      for (Size i = lo; i < hi; ++i)
+      {
+        const Size text_pos = suffix_array_[i];
+        const Size protein = std::upper_bound(protein_starts_, protein_starts_ + nr_proteins_ + 1, text_pos) - protein_starts_ - 1;
+        hits.push_back(Hit{protein, text_pos - protein_starts_[protein]});
+      }
+      return;
+    }
+
+    const char aa = peptide[depth];
+    Size l, h;
+    if (mm_left == 0)
+    { // only the residue itself and the ambiguous ones covering it
+      narrow_(lo, hi, depth, aa, l, h);
+      findAll_(peptide, depth + 1, l, h, aaa_left, 0, hits);
+      if (aaa_left > 0)
+      {
+        for (char amb : {'B', 'J', 'Z', 'X'})
+        {
+          if (amb == aa || !covers_(amb, aa)) continue;
+          narrow_(lo, hi, depth, amb, l, h);
+          findAll_(peptide, depth + 1, l, h, aaa_left - 1, 0, hits);
+        }
+      }
+      return;
+    }
+
+    // with mismatches: enumerate all residues present at this depth
+    for (Size i = lo; i < hi; i = h)
+    {
+      const char c = charAt_(i, depth);
+      narrow_(i, hi, depth, c, l, h);
+      if (c == '\0') continue; // end of protein
+      if (c == aa)
+      {
+        findAll_(peptide, depth + 1, l, h, aaa_left, mm_left, hits);
+      }
+      else if (aaa_left > 0 && isAmbiguous_(c) && covers_(c, aa))
+      {
+        findAll_(peptide, depth + 1, l, h, aaa_left - 1, mm_left, hits);
+      }
+      else
+      {
+        findAll_(peptide, depth + 1, l, h, aaa_left, mm_left - 1, hits);
+      }
+    }
+  }
+
+} // namespace OpenMS
@@ -35,16 +35,20 @@
 #include <OpenMS/ANALYSIS/ID/SimpleSearchEngineAlgorithm.h>
 
 
+#include <OpenMS/ANALYSIS/ID/PeptideDigestCache.h>
 #include <OpenMS/ANALYSIS/ID/PeptideIndexing.h>
+#include <OpenMS/ANALYSIS/ID/PrecursorMassIndex.h>
 #include <OpenMS/ANALYSIS/RNPXL/HyperScore.h>
 
 #include <OpenMS/CHEMISTRY/ModificationsDB.h>
 #include <OpenMS/CHEMISTRY/TheoreticalSpectrumGenerator.h>
 #include <OpenMS/CHEMISTRY/ResidueModification.h>
+#include <OpenMS/CHEMISTRY/ResidueMassTable.h>
 #include <OpenMS/CHEMISTRY/DecoyGenerator.h>
 
 
 #include <OpenMS/CONCEPT/Constants.h>
+#include <OpenMS/CONCEPT/Profiler.h>
 #include <OpenMS/CONCEPT/VersionInfo.h>
 
 #include <OpenMS/DATASTRUCTURES/Param.h>
@@ -57,6 +61,7 @@
 #include <OpenMS/FILTERING/TRANSFORMERS/WindowMower.h>
 #include <OpenMS/FILTERING/TRANSFORMERS/Normalizer.h>
 
+#include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/FORMAT/FASTAFile.h>
 
@@ -146,6 +151,26 @@ namespace OpenMS
     defaults_.setValue("report:top_hits", 1, "Maximum number of top scoring hits per spectrum that are reported.");
     defaults_.setSectionDescription("report", "Reporting Options");
 
+    defaults_.setValue("fragment_index:enabled", "false", "Use a fragment ion index to preselect candidates per spectrum. Only candidates sharing at least 'min_matched_peaks' fragments with a spectrum are scored.");
+    defaults_.setValidStrings("fragment_index:enabled", {"true","false"} );
+    defaults_.setValue("fragment_index:file", "", "If set, the fragment ion index is loaded from this file if it matches the database and digestion settings. Otherwise it is built and stored to this file.");
+    defaults_.setValue("fragment_index:min_matched_peaks", 3, "Minimum number of matching fragment peaks for a candidate to be scored.");
+    defaults_.setMinInt("fragment_index:min_matched_peaks", 1);
+    defaults_.setSectionDescription("fragment_index", "Fragment Index Options");
+
+    defaults_.setValue("digest_cache:directory", "", "If set, the digested and modified candidate peptides are stored in (and reused from) a cache file in this directory. The cache is specific to the database content and the digestion and modification settings.");
+    defaults_.setSectionDescription("digest_cache", "Peptide Digest Cache Options");
+
+    defaults_.setValue("shard:database_count", 1, "Split the target database into this many consecutive ranges of proteins and only search one of them (see 'database_index'). Decoys are generated per shard.");
+    defaults_.setMinInt("shard:database_count", 1);
+    defaults_.setValue("shard:database_index", 0, "Index (0-based) of the protein range to search, needs to be smaller than 'database_count'.");
+    defaults_.setMinInt("shard:database_index", 0);
+    defaults_.setValue("shard:spectrum_count", 1, "Split the MS2 spectra into this many consecutive ranges and only search one of them (see 'spectrum_index').");
+    defaults_.setMinInt("shard:spectrum_count", 1);
+    defaults_.setValue("shard:spectrum_index", 0, "Index (0-based) of the spectrum range to search, needs to be smaller than 'spectrum_count'.");
+    defaults_.setMinInt("shard:spectrum_index", 0);
+    defaults_.setSectionDescription("shard", "Sharding Options: every shard reports the top hits of its part of the search. Use mergeShards() (SimpleSearchEngine -shards) to combine the results of all shards exactly before FDR estimation.");
+
     defaultsToParam_();
   }
 
@@ -180,6 +205,75 @@ namespace OpenMS
 
     decoys_ = param_.getValue("decoys") == "true";
     annotate_psm_ = param_.getValue("annotate:PSM");
+
+    fragment_index_enabled_ = param_.getValue("fragment_index:enabled") == "true";
+    fragment_index_file_ = param_.getValue("fragment_index:file");
+    fragment_index_min_matched_peaks_ = (Int)param_.getValue("fragment_index:min_matched_peaks");
+
+    digest_cache_directory_ = param_.getValue("digest_cache:directory");
+
+    shard_database_count_ = (Int)param_.getValue("shard:database_count");
+    shard_database_index_ = (Int)param_.getValue("shard:database_index");
+    shard_spectrum_count_ = (Int)param_.getValue("shard:spectrum_count");
+    shard_spectrum_index_ = (Int)param_.getValue("shard:spectrum_index");
+  }
+
+  // static
+  std::pair<Size, Size> SimpleSearchEngineAlgorithm::getShardRange_(Size size, Size shard_index, Size shard_count)
+  {
+    return std::make_pair(size * shard_index / shard_count, size * (shard_index + 1) / shard_count);
+  }
+
+  void SimpleSearchEngineAlgorithm::appendDecoys_(std::vector<FASTAFile::FASTAEntry>& fasta_db) const
+  {
+    DecoyGenerator decoy_generator;
+
+    // append decoy proteins
+    const size_t old_size = fasta_db.size();
+    for (size_t i = 0; i != old_size; ++i)
+    {
+      FASTAFile::FASTAEntry e = fasta_db[i];
+      e.sequence = decoy_generator.reversePeptides(AASequence::fromString(e.sequence), enzyme_).toString();
+      e.identifier = "DECOY_" + e.identifier;
+      fasta_db.push_back(e);
+    }
+    // randomize order of targets and decoys to introduce no global bias in the case that
+    // many targets have the same score as their decoy. (As we always take the first best scoring one)
+    std::random_shuffle(fasta_db.begin(), fasta_db.end());
+  }
+
+  SimpleSearchEngineAlgorithm::ExitCodes SimpleSearchEngineAlgorithm::indexPeptides_(std::vector<FASTAFile::FASTAEntry>& fasta_db,
+    std::vector<ProteinIdentification>& protein_ids,
+    std::vector<PeptideIdentification>& peptide_ids) const
+  {
+    PeptideIndexing indexer;
+    Param param_pi = indexer.getParameters();
+    param_pi.setValue("decoy_string", "DECOY_");
+    param_pi.setValue("decoy_string_position", "prefix");
+    param_pi.setValue("enzyme:name", enzyme_);
+    param_pi.setValue("enzyme:specificity", "full");
+    param_pi.setValue("missing_decoy_action", "silent");
+    indexer.setParameters(param_pi);
+
+    PeptideIndexing::ExitCodes indexer_exit = indexer.run(fasta_db, protein_ids, peptide_ids);
+
+    if ((indexer_exit != PeptideIndexing::EXECUTION_OK) &&
+        (indexer_exit != PeptideIndexing::PEPTIDE_IDS_EMPTY))
+    {
+      if (indexer_exit == PeptideIndexing::DATABASE_EMPTY)
+      {
+        return ExitCodes::INPUT_FILE_EMPTY;
+      }
+      else if (indexer_exit == PeptideIndexing::UNEXPECTED_RESULT)
+      {
+        return ExitCodes::UNEXPECTED_RESULT;
+      }
+      else
+      {
+        return ExitCodes::UNKNOWN_ERROR;
+      }
+    }
+    return ExitCodes::EXECUTION_OK;
   }
 
   // static
@@ -229,6 +323,56 @@ namespace OpenMS
     }
   }
 
+  void SimpleSearchEngineAlgorithm::buildFragmentIndex_(const vector<FASTAFile::FASTAEntry>& fasta_db,
+    const ModifiedPeptideGenerator::MapToResidueType& fixed_modifications,
+    const ModifiedPeptideGenerator::MapToResidueType& variable_modifications,
+    FragmentIndex& fragment_index) const
+  {
+    boost::regex peptide_motif_regex(peptide_motif_);
+
+    ProteaseDigestion digestor;
+    digestor.setEnzyme(enzyme_);
+    digestor.setMissedCleavages(peptide_missed_cleavages_);
+
+    startProgress(0, fasta_db.size(), "Building fragment index...");
+    set<String> processed_peptides;
+    for (Size fasta_index = 0; fasta_index < fasta_db.size(); ++fasta_index)
+    {
+      setProgress(fasta_index);
+
+      vector<StringView> current_digest;
+      digestor.digestUnmodified(fasta_db[fasta_index].sequence, current_digest, peptide_min_size_, peptide_max_size_);
+
+      for (auto const & c : current_digest)
+      {
+        const String current_peptide = c.getString();
+        if (current_peptide.find_first_of("XBZ") != std::string::npos) { continue; }
+
+        // if a peptide motif is provided skip all peptides without match
+        if (!peptide_motif_.empty() && !boost::regex_match(current_peptide, peptide_motif_regex)) { continue; }
+
+        // peptide (and all modified variants) already added
+        if (!processed_peptides.insert(current_peptide).second) { continue; }
+
+        vector<AASequence> all_modified_peptides;
+        AASequence aas = AASequence::fromString(current_peptide);
+        ModifiedPeptideGenerator::applyFixedModifications(fixed_modifications, aas);
+        ModifiedPeptideGenerator::applyVariableModifications(variable_modifications, aas, modifications_max_variable_mods_per_peptide_, all_modified_peptides);
+
+        for (Size mod_pep_idx = 0; mod_pep_idx < all_modified_peptides.size(); ++mod_pep_idx)
+        {
+          fragment_index.addPeptide(current_peptide, mod_pep_idx, all_modified_peptides[mod_pep_idx]);
+        }
+      }
+    }
+    fragment_index.build();
+    endProgress();
+
+    OPENMS_LOG_INFO << "Fragment index: " << processed_peptides.size() << " peptides, "
+                    << fragment_index.size() << " candidates, "
+                    << fragment_index.getNrFragments() << " fragments" << endl;
+  }
+
 void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp, 
       std::vector<std::vector<SimpleSearchEngineAlgorithm::AnnotatedHit_> >& annotated_hits, 
       std::vector<ProteinIdentification>& protein_ids, 
@@ -263,6 +407,11 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
     bool annotation_precursor_error_ppm = std::find(annotate_psm_.begin(), annotate_psm_.end(), Constants::UserParam::PRECURSOR_ERROR_PPM_USERPARAM) != annotate_psm_.end();
     bool annotation_fragment_error_ppm = std::find(annotate_psm_.begin(), annotate_psm_.end(), Constants::UserParam::FRAGMENT_ERROR_MEDIAN_PPM_USERPARAM) != annotate_psm_.end();
 
+    // resolve the meta value names once instead of for every hit
+    const UInt scan_index_key = MetaInfoInterface::metaRegistry().registerName("scan_index");
+    const UInt precursor_error_key = MetaInfoInterface::metaRegistry().registerName(Constants::UserParam::PRECURSOR_ERROR_PPM_USERPARAM);
+    const UInt fragment_error_key = MetaInfoInterface::metaRegistry().registerName(Constants::UserParam::FRAGMENT_ERROR_MEDIAN_PPM_USERPARAM);
+
 #pragma omp parallel for
     for (SignedSize scan_index = 0; scan_index < (SignedSize)annotated_hits.size(); ++scan_index)
     {
@@ -271,8 +420,8 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
         const MSSpectrum& spec = exp[scan_index];
         // create empty PeptideIdentification object and fill meta data
         PeptideIdentification pi{};
-        pi.setMetaValue("spectrum_reference", spec.getNativeID());
-        pi.setMetaValue("scan_index", static_cast<unsigned int>(scan_index));
+        pi.setMetaValue(MetaInfoRegistry::SPECTRUM_REFERENCE, spec.getNativeID());
+        pi.setMetaValue(scan_index_key, static_cast<unsigned int>(scan_index));
         pi.setScoreType("hyperscore");
         pi.setHigherScoreBetter(true);
         double mz = spec.getPrecursors()[0].getMZ();
@@ -317,14 +466,14 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
             }
             double median_ppm_error(0);
             if (!err.empty()) { median_ppm_error = Math::median(err.begin(), err.end(), false); }
-            ph.setMetaValue(Constants::UserParam::FRAGMENT_ERROR_MEDIAN_PPM_USERPARAM, median_ppm_error);
+            ph.setMetaValue(fragment_error_key, median_ppm_error);
           }
 
           if (annotation_precursor_error_ppm)
           {
             double theo_mz = fixed_and_variable_modified_peptide.getMonoWeight(Residue::Full, charge)/static_cast<double>(charge);
             double ppm_difference = Math::getPPM(mz, theo_mz);
-            ph.setMetaValue(Constants::UserParam::PRECURSOR_ERROR_PPM_USERPARAM, ppm_difference);
+            ph.setMetaValue(precursor_error_key, ppm_difference);
           }
           // store PSM
           phs.push_back(ph);
@@ -377,6 +526,7 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
 
   SimpleSearchEngineAlgorithm::ExitCodes SimpleSearchEngineAlgorithm::search(const String& in_mzML, const String& in_db, vector<ProteinIdentification>& protein_ids, vector<PeptideIdentification>& peptide_ids) const
   {
+    OPENMS_PROFILE_SCOPE("SimpleSearchEngineAlgorithm::search");
     boost::regex peptide_motif_regex(peptide_motif_);
 
     bool precursor_mass_tolerance_unit_ppm = (precursor_mass_tolerance_unit_ == "ppm");
@@ -416,9 +566,17 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
     preprocessSpectra_(spectra, fragment_mass_tolerance_, fragment_mass_tolerance_unit_ppm);
     endProgress();
 
-    // build multimap of precursor mass to scan index
-    multimap<double, Size> multimap_mass_2_scan_index;
-    for (PeakMap::ConstIterator s_it = spectra.begin(); s_it != spectra.end(); ++s_it)
+    if (shard_spectrum_index_ >= shard_spectrum_count_ || shard_database_index_ >= shard_database_count_)
+    {
+      cout << "shard index needs to be smaller than the number of shards." << endl;
+      return ExitCodes::ILLEGAL_PARAMETERS;
+    }
+
+    // build index of precursor mass to scan index (spectra outside of the spectrum shard are not searched,
+    // but are kept so that scan indices refer to the whole file in all shards)
+    const std::pair<Size, Size> spectrum_shard = getShardRange_(spectra.size(), shard_spectrum_index_, shard_spectrum_count_);
+    PrecursorMassIndex<Size> precursor_mass_index;
+    for (PeakMap::ConstIterator s_it = spectra.begin() + spectrum_shard.first; s_it != spectra.begin() + spectrum_shard.second; ++s_it)
     {
       int scan_index = s_it - spectra.begin();
       vector<Precursor> precursor = s_it->getPrecursors();
@@ -444,10 +602,11 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
           // correct for monoisotopic misassignments of the precursor annotation
           if (isotope_number != 0) { precursor_mass -= isotope_number * Constants::C13C12_MASSDIFF_U; }
 
-          multimap_mass_2_scan_index.insert(make_pair(precursor_mass, scan_index));
+          precursor_mass_index.add(precursor_mass, scan_index);
         }
       }
     }
+    precursor_mass_index.build();
 
     // create spectrum generator
     TheoreticalSpectrumGenerator spectrum_generator;
@@ -471,6 +630,18 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
     FASTAFile::load(in_db, fasta_db);
     endProgress();
 
+    // only keep the proteins of the database shard (before generating decoys, so each shard has the decoys of its targets)
+    const bool database_sharded = shard_database_count_ > 1;
+    if (database_sharded)
+    {
+      const std::pair<Size, Size> database_shard = getShardRange_(fasta_db.size(), shard_database_index_, shard_database_count_);
+      fasta_db.erase(fasta_db.begin() + database_shard.second, fasta_db.end());
+      fasta_db.erase(fasta_db.begin(), fasta_db.begin() + database_shard.first);
+      OPENMS_LOG_INFO << "Searching database shard " << shard_database_index_ + 1 << " of " << shard_database_count_
+                      << " (" << fasta_db.size() << " proteins)." << endl;
+    }
+    const String database_shard_tag = database_sharded ? "shard " + String(shard_database_index_) + "/" + String(shard_database_count_) : "";
+
     ProteaseDigestion digestor;
     digestor.setEnzyme(enzyme_);
     // generate decoy protein sequences by reversing them
@@ -478,156 +649,326 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
     {
       digestor.setMissedCleavages(0);
       startProgress(0, 1, "Generate decoys...");
-
-      DecoyGenerator decoy_generator;
-
-      // append decoy proteins
-      const size_t old_size = fasta_db.size();
-      for (size_t i = 0; i != old_size; ++i)
-      {
-        FASTAFile::FASTAEntry e = fasta_db[i];
-        e.sequence = decoy_generator.reversePeptides(AASequence::fromString(e.sequence), enzyme_).toString();
-        e.identifier = "DECOY_" + e.identifier;
-        fasta_db.push_back(e);
-      }
-      // randomize order of targets and decoys to introduce no global bias in the case that
-      // many targets have the same score as their decoy. (As we always take the first best scoring one)
-      std::random_shuffle(fasta_db.begin(), fasta_db.end());
+      appendDecoys_(fasta_db);
       endProgress();
       digestor.setMissedCleavages(peptide_missed_cleavages_);
     }
-    startProgress(0, fasta_db.size(), "Scoring peptide models against spectra...");
 
-    // lookup for processed peptides. must be defined outside of omp section and synchronized
-    set<StringView> processed_petides;
+    // scores a candidate against all spectra in its precursor mass window and stores the hits
+    // (theo_mz, theo_ion_types and the precursor cursor are per-thread and reused for all candidates)
+    auto scoreCandidate = [&](const AASequence& candidate, const StringView& unmodified_sequence, SignedSize mod_pep_idx,
+                              vector<double>& theo_mz, vector<char>& theo_ion_types, PrecursorMassIndex<Size>::Cursor& precursor_cursor)
+    {
+      Profiler::addCounter("SimpleSearchEngineAlgorithm::candidates");
+      double current_peptide_mass = candidate.getMonoWeight();
+
+      // determine MS2 precursors that match to the current peptide mass
+      const double tolerance = precursor_mass_tolerance_unit_ppm ? 0.5 * current_peptide_mass * precursor_mass_tolerance_ * 1e-6 : 0.5 * precursor_mass_tolerance_;
+      const PrecursorMassIndex<Size>::Range range = precursor_cursor.getRange(current_peptide_mass - tolerance, current_peptide_mass + tolerance);
 
-    Size count_proteins(0), count_peptides(0);
+      // no matching precursor in data
+      if (range.first == range.second) { return; }
 
-#pragma omp parallel for schedule(static) default(none) shared(annotated_hits, spectrum_generator, multimap_mass_2_scan_index, fixed_modifications, variable_modifications, fasta_db, digestor, processed_petides, count_proteins, count_peptides, precursor_mass_tolerance_unit_ppm, fragment_mass_tolerance_unit_ppm, peptide_motif_regex, spectra, annotated_hits_lock)
-      for (SignedSize fasta_index = 0; fasta_index < (SignedSize)fasta_db.size(); ++fasta_index)
+      // create theoretical spectrum: sorted b and y ions with charge 1
+      spectrum_generator.getIonSeries(theo_mz, theo_ion_types, candidate, 1, 1);
+
+      for (Size pos = range.first; pos != range.second; ++pos)
       {
+        const Size& scan_index = precursor_mass_index.getValue(pos);
+        const PeakSpectrum& exp_spectrum = spectra[scan_index];
+        // const int& charge = exp_spectrum.getPrecursors()[0].getCharge();
+        const double& score = HyperScore::compute(fragment_mass_tolerance_, fragment_mass_tolerance_unit_ppm, exp_spectrum, theo_mz, theo_ion_types);
+
+        if (score == 0) { continue; } // no hit?
 
-      #pragma omp atomic
-      ++count_proteins;
+        // add peptide hit
+        AnnotatedHit_ ah;
+        ah.sequence = unmodified_sequence;
+        ah.peptide_mod_index = mod_pep_idx;
+        ah.score = score;
 
-      IF_MASTERTHREAD
+#ifdef _OPENMP
+        omp_set_lock(&(annotated_hits_lock[scan_index]));
+        {
+#endif
+          annotated_hits[scan_index].push_back(ah);
+
+          // prevent vector from growing indefinitly (memory) but don't shrink the vector every time
+          if (annotated_hits[scan_index].size() >= 2 * report_top_hits_)
+          {
+            std::partial_sort(annotated_hits[scan_index].begin(), annotated_hits[scan_index].begin() + report_top_hits_, annotated_hits[scan_index].end(), AnnotatedHit_::hasBetterScore);
+            annotated_hits[scan_index].resize(report_top_hits_); 
+          }
+#ifdef _OPENMP
+        }
+        omp_unset_lock(&(annotated_hits_lock[scan_index]));
+#endif
+      }
+    };
+
+    // the fragment index and the digest cache own the sequences referenced by the annotated hits and need to outlive post-processing
+    FragmentIndex fragment_index;
+    PeptideDigestCache digest_cache;
+
+    if (fragment_index_enabled_)
+    {
+      // the index depends on the database content and on all settings that change the set of candidates
+      String index_key = FileHandler::computeFileHash(in_db)
+        + "|" + enzyme_
+        + "|" + String(peptide_missed_cleavages_)
+        + "|" + String(peptide_min_size_) + "-" + String(peptide_max_size_)
+        + "|" + peptide_motif_
+        + "|" + ListUtils::concatenate(modifications_fixed_, ",")
+        + "|" + ListUtils::concatenate(modifications_variable_, ",")
+        + "|" + String(modifications_max_variable_mods_per_peptide_)
+        + "|" + (decoys_ ? "decoys" : "")
+        + "|" + database_shard_tag;
+
+      if (fragment_index_file_.empty() || !fragment_index.load(fragment_index_file_, index_key))
+      {
+        buildFragmentIndex_(fasta_db, fixed_modifications, variable_modifications, fragment_index);
+        if (!fragment_index_file_.empty())
+        {
+          fragment_index.store(fragment_index_file_, index_key);
+        }
+      }
+      else
       {
-        setProgress(count_proteins);
+        OPENMS_LOG_INFO << "Fragment index loaded from: " << fragment_index_file_ << endl;
       }
 
-      vector<StringView> current_digest;
-      digestor.digestUnmodified(fasta_db[fasta_index].sequence, current_digest, peptide_min_size_, peptide_max_size_);
+      // precursor masses (including isotope corrections) of each spectrum
+      vector<vector<double> > precursor_masses(spectra.size());
+      for (Size pos = 0; pos != precursor_mass_index.size(); ++pos)
+      {
+        precursor_masses[precursor_mass_index.getValue(pos)].push_back(precursor_mass_index.getMass(pos));
+      }
 
-      for (auto const & c : current_digest)
-      { 
-        const String current_peptide = c.getString();
-        if (current_peptide.find_first_of("XBZ") != std::string::npos) { continue; }
+      startProgress(0, spectra.size(), "Scoring candidates from fragment index against spectra...");
+      Size count_spectra(0), count_candidates(0);
 
-        // if a peptide motif is provided skip all peptides without match
-        if (!peptide_motif_.empty() && !boost::regex_match(current_peptide, peptide_motif_regex)) { continue; }          
-      
-        bool already_processed = false;
-        #pragma omp critical (processed_peptides_access)
+      // each spectrum is only accessed by a single thread: no locking of the hits required
+#pragma omp parallel reduction(+: count_candidates)
+      {
+        vector<double> theo_mz;
+        vector<char> theo_ion_types;
+        vector<pair<Size, Size> > candidates;
+
+#pragma omp for schedule(dynamic)
+        for (SignedSize scan_index = 0; scan_index < (SignedSize)spectra.size(); ++scan_index)
         {
-          // peptide (and all modified variants) already processed so skip it
-          if (processed_petides.find(c) != processed_petides.end())
+          #pragma omp atomic
+          ++count_spectra;
+
+          IF_MASTERTHREAD
           {
-            already_processed = true;
+            setProgress(count_spectra);
           }
-          else
+
+          const PeakSpectrum& exp_spectrum = spectra[scan_index];
+          for (double precursor_mass : precursor_masses[scan_index])
           {
-            processed_petides.insert(c);
+            const double tolerance = precursor_mass_tolerance_unit_ppm ? 0.5 * precursor_mass * precursor_mass_tolerance_ * 1e-6 : 0.5 * precursor_mass_tolerance_;
+            fragment_index.query(exp_spectrum, precursor_mass - tolerance, precursor_mass + tolerance,
+              fragment_mass_tolerance_, fragment_mass_tolerance_unit_ppm, fragment_index_min_matched_peaks_, candidates);
+            Profiler::addSample("SimpleSearchEngineAlgorithm::fragmentIndexCandidates", candidates.size());
+
+            for (const auto& candidate : candidates)
+            {
+              const FragmentIndex::Peptide& peptide = fragment_index.getPeptide(candidate.first);
+              ++count_candidates;
+
+              // create theoretical spectrum: sorted b and y ions with charge 1
+              spectrum_generator.getIonSeries(theo_mz, theo_ion_types, AASequence::fromString(peptide.sequence), 1, 1);
+
+              const double score = HyperScore::compute(fragment_mass_tolerance_, fragment_mass_tolerance_unit_ppm, exp_spectrum, theo_mz, theo_ion_types);
+              if (score == 0) { continue; } // no hit?
+
+              AnnotatedHit_ ah;
+              ah.sequence = peptide.unmodified_sequence;
+              ah.peptide_mod_index = peptide.mod_index;
+              ah.score = score;
+              annotated_hits[scan_index].push_back(ah);
+
+              // prevent vector from growing indefinitly (memory) but don't shrink the vector every time
+              if (annotated_hits[scan_index].size() >= 2 * report_top_hits_)
+              {
+                std::partial_sort(annotated_hits[scan_index].begin(), annotated_hits[scan_index].begin() + report_top_hits_, annotated_hits[scan_index].end(), AnnotatedHit_::hasBetterScore);
+                annotated_hits[scan_index].resize(report_top_hits_);
+              }
+            }
           }
         }
+      }
+      endProgress();
 
-        // skip peptides that have already been processed
-        if (already_processed) { continue; }
+      OPENMS_LOG_INFO << "Spectra: " << count_spectra << endl;
+      OPENMS_LOG_INFO << "Scored candidates: " << count_candidates << endl;
+    }
+    else if (!digest_cache_directory_.empty())
+    {
+      PeptideDigestCache::Settings settings;
+      settings.enzyme = enzyme_;
+      settings.missed_cleavages = peptide_missed_cleavages_;
+      settings.min_length = peptide_min_size_;
+      settings.max_length = peptide_max_size_;
+      settings.fixed_modifications = modifications_fixed_;
+      settings.variable_modifications = modifications_variable_;
+      settings.max_variable_mods_per_peptide = modifications_max_variable_mods_per_peptide_;
+      settings.database_tag = decoys_ ? "reversed decoys" : "";
+      if (database_sharded) { settings.database_tag += (settings.database_tag.empty() ? "" : " ") + database_shard_tag; }
+
+      const String key = PeptideDigestCache::getKey(in_db, settings);
+      const String cache_file = PeptideDigestCache::getFilename(digest_cache_directory_, key);
+      if (!digest_cache.load(cache_file, key))
+      {
+        startProgress(0, 1, "Building peptide digest cache...");
+        PeptideDigestCache::build(fasta_db, settings, key, cache_file);
+        digest_cache.load(cache_file, key);
+        endProgress();
+      }
+      else
+      {
+        OPENMS_LOG_INFO << "Peptide digest cache loaded from: " << cache_file << endl;
+      }
 
-        #pragma omp atomic
-        ++count_peptides;
+      // candidates are sorted by mass: only stream the range covered by the precursors
+      Size first_candidate(0), last_candidate(0);
+      if (!precursor_mass_index.empty())
+      {
+        const double min_precursor_mass = precursor_mass_index.getMass(0);
+        const double max_precursor_mass = precursor_mass_index.getMass(precursor_mass_index.size() - 1);
+        // the precursor window is centered on the candidate mass, so this range is conservative
+        const double tolerance = precursor_mass_tolerance_unit_ppm ? max_precursor_mass * precursor_mass_tolerance_ * 1e-6 : precursor_mass_tolerance_;
+        first_candidate = digest_cache.lowerBound(min_precursor_mass - tolerance);
+        last_candidate = digest_cache.lowerBound(max_precursor_mass + tolerance);
+      }
 
-        vector<AASequence> all_modified_peptides;
+      startProgress(first_candidate, last_candidate, "Scoring peptide models against spectra...");
+      Size count_candidates(0);
 
-        // this critial section is because ResidueDB is not thread safe and new residues are created based on the PTMs
-        #pragma omp critical (residuedb_access)
+#pragma omp parallel default(none) shared(scoreCandidate, digest_cache, first_candidate, last_candidate, count_candidates, peptide_motif_regex, precursor_mass_index)
+      {
+        vector<double> theo_mz;
+        vector<char> theo_ion_types;
+        // candidates are visited in ascending mass order within each chunk
+        PrecursorMassIndex<Size>::Cursor precursor_cursor(precursor_mass_index);
+
+#pragma omp for schedule(dynamic, 1000)
+        for (SignedSize cache_index = first_candidate; cache_index < (SignedSize)last_candidate; ++cache_index)
         {
-          AASequence aas = AASequence::fromString(current_peptide);
-          ModifiedPeptideGenerator::applyFixedModifications(fixed_modifications, aas);
-          ModifiedPeptideGenerator::applyVariableModifications(variable_modifications, aas, modifications_max_variable_mods_per_peptide_, all_modified_peptides);
+          #pragma omp atomic
+          ++count_candidates;
+
+          IF_MASTERTHREAD
+          {
+            setProgress(first_candidate + count_candidates);
+          }
+
+          const PeptideDigestCache::Peptide peptide = digest_cache.getPeptide(cache_index);
+
+          // if a peptide motif is provided skip all peptides without match
+          if (!peptide_motif_.empty() && !boost::regex_match(peptide.unmodified_sequence.getString(), peptide_motif_regex)) { continue; }
+
+          scoreCandidate(AASequence::fromString(peptide.sequence.getString()), peptide.unmodified_sequence, peptide.mod_index, theo_mz, theo_ion_types, precursor_cursor);
         }
+      }
+      endProgress();
+
+      OPENMS_LOG_INFO << "Candidates (total): " << digest_cache.size() << endl;
+      OPENMS_LOG_INFO << "Candidates (in precursor mass range): " << count_candidates << endl;
+    }
+    else
+    {
+      startProgress(0, fasta_db.size(), "Scoring peptide models against spectra...");
 
-        for (SignedSize mod_pep_idx = 0; mod_pep_idx < (SignedSize)all_modified_peptides.size(); ++mod_pep_idx)
+      // lookup for processed peptides. must be defined outside of omp section and synchronized
+      set<StringView> processed_petides;
+
+      Size count_proteins(0), count_peptides(0);
+
+      // masses of unmodified peptides (with fixed modifications) and the range variable modifications can add,
+      // used to skip peptides without matching precursor before any AASequence is built
+      vector<const ResidueModification*> fixed_mods, variable_mods;
+      for (const auto& m : fixed_modifications.val) { fixed_mods.push_back(m.first); }
+      for (const auto& m : variable_modifications.val) { variable_mods.push_back(m.first); }
+      ResidueMassTable mass_table(fixed_mods);
+      double min_shift(0), max_shift(0);
+      mass_table.getVariableModificationShiftRange(variable_mods, modifications_max_variable_mods_per_peptide_, min_shift, max_shift);
+
+#pragma omp parallel for schedule(static) default(none) shared(scoreCandidate, fixed_modifications, variable_modifications, fasta_db, digestor, processed_petides, count_proteins, count_peptides, peptide_motif_regex, mass_table, min_shift, max_shift, precursor_mass_index, precursor_mass_tolerance_unit_ppm)
+        for (SignedSize fasta_index = 0; fasta_index < (SignedSize)fasta_db.size(); ++fasta_index)
         {
-          const AASequence& candidate = all_modified_peptides[mod_pep_idx];
-          double current_peptide_mass = candidate.getMonoWeight();
 
-          // determine MS2 precursors that match to the current peptide mass
-          multimap<double, Size>::const_iterator low_it;
-          multimap<double, Size>::const_iterator up_it;
+        #pragma omp atomic
+        ++count_proteins;
 
-          if (precursor_mass_tolerance_unit_ppm) // ppm
-          {
-            low_it = multimap_mass_2_scan_index.lower_bound(current_peptide_mass - 0.5 * current_peptide_mass * precursor_mass_tolerance_ * 1e-6);
-            up_it = multimap_mass_2_scan_index.upper_bound(current_peptide_mass + 0.5 * current_peptide_mass * precursor_mass_tolerance_ * 1e-6);
-          }
-          else // Dalton
-          {
-            low_it = multimap_mass_2_scan_index.lower_bound(current_peptide_mass - 0.5 * precursor_mass_tolerance_);
-            up_it = multimap_mass_2_scan_index.upper_bound(current_peptide_mass + 0.5 * precursor_mass_tolerance_);
-          }
+        IF_MASTERTHREAD
+        {
+          setProgress(count_proteins);
+        }
+
+        vector<StringView> current_digest;
+        digestor.digestUnmodified(fasta_db[fasta_index].sequence, current_digest, peptide_min_size_, peptide_max_size_);
 
-          // no matching precursor in data
-          if (low_it == up_it) { continue; }
+        // theoretical spectrum buffers and precursor cursor, reused for all peptides of this protein
+        vector<double> theo_mz;
+        vector<char> theo_ion_types;
+        PrecursorMassIndex<Size>::Cursor precursor_cursor(precursor_mass_index);
 
-          // create theoretical spectrum
-          PeakSpectrum theo_spectrum;
+        for (auto const & c : current_digest)
+        { 
+          const String current_peptide = c.getString();
+          if (current_peptide.find_first_of("XBZ") != std::string::npos) { continue; }
 
-          // add peaks for b and y ions with charge 1
-          spectrum_generator.getSpectrum(theo_spectrum, candidate, 1, 1);
+          // if a peptide motif is provided skip all peptides without match
+          if (!peptide_motif_.empty() && !boost::regex_match(current_peptide, peptide_motif_regex)) { continue; }          
 
-          // sort by mz
-          theo_spectrum.sortByPosition();
+          // skip peptides if none of their modified variants can match a precursor mass
+          const double unmodified_mass = mass_table.getMonoWeight(c);
+          const double max_variant_mass = unmodified_mass + max_shift;
+          const double tolerance = precursor_mass_tolerance_unit_ppm ? 0.5 * max_variant_mass * precursor_mass_tolerance_ * 1e-6 : 0.5 * precursor_mass_tolerance_;
+          const PrecursorMassIndex<Size>::Range variant_range = precursor_cursor.getRange(unmodified_mass + min_shift - tolerance, max_variant_mass + tolerance);
+          if (variant_range.first == variant_range.second) { continue; }
 
-          for (; low_it != up_it; ++low_it)
+          bool already_processed = false;
+          #pragma omp critical (processed_peptides_access)
           {
-            const Size& scan_index = low_it->second;
-            const PeakSpectrum& exp_spectrum = spectra[scan_index];
-            // const int& charge = exp_spectrum.getPrecursors()[0].getCharge();
-            const double& score = HyperScore::compute(fragment_mass_tolerance_, fragment_mass_tolerance_unit_ppm, exp_spectrum, theo_spectrum);
+            // peptide (and all modified variants) already processed so skip it
+            if (processed_petides.find(c) != processed_petides.end())
+            {
+              already_processed = true;
+            }
+            else
+            {
+              processed_petides.insert(c);
+            }
+          }
 
-            if (score == 0) { continue; } // no hit?
+          // skip peptides that have already been processed
+          if (already_processed) { continue; }
 
-            // add peptide hit
-            AnnotatedHit_ ah;
-            ah.sequence = c;
-            ah.peptide_mod_index = mod_pep_idx;
-            ah.score = score;
+          #pragma omp atomic
+          ++count_peptides;
 
-#ifdef _OPENMP
-            omp_set_lock(&(annotated_hits_lock[scan_index]));
-            {
-#endif
-              annotated_hits[scan_index].push_back(ah);
+          vector<AASequence> all_modified_peptides;
 
-              // prevent vector from growing indefinitly (memory) but don't shrink the vector every time
-              if (annotated_hits[scan_index].size() >= 2 * report_top_hits_)
-              {
-                std::partial_sort(annotated_hits[scan_index].begin(), annotated_hits[scan_index].begin() + report_top_hits_, annotated_hits[scan_index].end(), AnnotatedHit_::hasBetterScore);
-                annotated_hits[scan_index].resize(report_top_hits_); 
-              }
-#ifdef _OPENMP
-            }
-            omp_unset_lock(&(annotated_hits_lock[scan_index]));
-#endif
+          AASequence aas = AASequence::fromString(current_peptide);
+          ModifiedPeptideGenerator::applyFixedModifications(fixed_modifications, aas);
+          ModifiedPeptideGenerator::applyVariableModifications(variable_modifications, aas, modifications_max_variable_mods_per_peptide_, all_modified_peptides);
+
+          for (SignedSize mod_pep_idx = 0; mod_pep_idx < (SignedSize)all_modified_peptides.size(); ++mod_pep_idx)
+          {
+            scoreCandidate(all_modified_peptides[mod_pep_idx], c, mod_pep_idx, theo_mz, theo_ion_types, precursor_cursor);
           }
         }
       }
-    }
-    endProgress();
+      endProgress();
 
-    OPENMS_LOG_INFO << "Proteins: " << count_proteins << endl;
-    OPENMS_LOG_INFO << "Peptides: " << count_peptides << endl;
-    OPENMS_LOG_INFO << "Processed peptides: " << processed_petides.size() << endl;
+      OPENMS_LOG_INFO << "Proteins: " << count_proteins << endl;
+      OPENMS_LOG_INFO << "Peptides: " << count_peptides << endl;
+      OPENMS_LOG_INFO << "Processed peptides: " << processed_petides.size() << endl;
+    }
 
     startProgress(0, 1, "Post-processing PSMs...");
     SimpleSearchEngineAlgorithm::postProcessHits_(spectra, 
@@ -655,41 +996,89 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
     // add meta data on spectra file
     protein_ids[0].setPrimaryMSRunPath({in_mzML}, spectra);
 
-    // reindex peptides to proteins
-    PeptideIndexing indexer;
-    Param param_pi = indexer.getParameters();
-    param_pi.setValue("decoy_string", "DECOY_");
-    param_pi.setValue("decoy_string_position", "prefix");
-    param_pi.setValue("enzyme:name", enzyme_);
-    param_pi.setValue("enzyme:specificity", "full");
-    param_pi.setValue("missing_decoy_action", "silent");
-    indexer.setParameters(param_pi);
+#ifdef _OPENMP
+    // free locks
+    for (size_t i = 0; i != annotated_hits_lock.size(); i++) { omp_destroy_lock(&(annotated_hits_lock[i])); }
+#endif
 
-    PeptideIndexing::ExitCodes indexer_exit = indexer.run(fasta_db, protein_ids, peptide_ids);
+    // reindex peptides to proteins (only to the proteins of the database shard; mergeShards() reindexes against the whole database)
+    return indexPeptides_(fasta_db, protein_ids, peptide_ids);
+  }
 
-    if ((indexer_exit != PeptideIndexing::EXECUTION_OK) &&
-        (indexer_exit != PeptideIndexing::PEPTIDE_IDS_EMPTY))
+  SimpleSearchEngineAlgorithm::ExitCodes SimpleSearchEngineAlgorithm::mergeShards(
+    const std::vector<std::vector<ProteinIdentification> >& shard_protein_ids,
+    const std::vector<std::vector<PeptideIdentification> >& shard_peptide_ids,
+    const String& in_db,
+    std::vector<ProteinIdentification>& protein_ids,
+    std::vector<PeptideIdentification>& peptide_ids) const
+  {
+    OPENMS_PRECONDITION(shard_protein_ids.size() == shard_peptide_ids.size(), "One protein and one peptide identification list per shard expected.");
+    if (shard_protein_ids.empty() || shard_protein_ids[0].size() != 1)
     {
-      if (indexer_exit == PeptideIndexing::DATABASE_EMPTY)
-      {
-        return ExitCodes::INPUT_FILE_EMPTY;       
-      }
-      else if (indexer_exit == PeptideIndexing::UNEXPECTED_RESULT)
+      cout << "expected a single protein identification run per shard." << endl;
+      return ExitCodes::ILLEGAL_PARAMETERS;
+    }
+
+    // search settings, date and run identifier of the first shard; protein hits are recomputed below
+    protein_ids = vector<ProteinIdentification>(1, shard_protein_ids[0][0]);
+    protein_ids[0].getHits().clear();
+    protein_ids[0].getIndistinguishableProteins().clear();
+    protein_ids[0].getProteinGroups().clear();
+    protein_ids[0].getSearchParameters().db = in_db;
+    const String& run_identifier = protein_ids[0].getIdentifier();
+
+    // collect the hits of the same spectrum from all shards; every shard reported its top hits,
+    // so the overall top hits are among them and ranking the union is exact
+    std::map<unsigned int, PeptideIdentification> merged; // by scan index
+    std::map<unsigned int, std::map<String, PeptideHit> > merged_hits; // by scan index and (modified) sequence with charge
+    for (const vector<PeptideIdentification>& shard : shard_peptide_ids)
+    {
+      for (const PeptideIdentification& pi : shard)
       {
-        return ExitCodes::UNEXPECTED_RESULT;
+        const unsigned int scan_index = (unsigned int)pi.getMetaValue("scan_index");
+        auto it = merged.find(scan_index);
+        if (it == merged.end())
+        {
+          PeptideIdentification merged_pi = pi;
+          merged_pi.setHits(vector<PeptideHit>());
+          merged_pi.setIdentifier(run_identifier);
+          merged.emplace(scan_index, std::move(merged_pi));
+        }
+        std::map<String, PeptideHit>& hits = merged_hits[scan_index];
+        for (const PeptideHit& ph : pi.getHits())
+        {
+          // the same peptide can be a candidate in several database shards: it has the same score in all of them
+          hits.emplace(ph.getSequence().toString() + "/" + String(ph.getCharge()), ph);
+        }
       }
-      else
+    }
+
+    peptide_ids.clear();
+    peptide_ids.reserve(merged.size());
+    for (auto& m : merged)
+    {
+      vector<PeptideHit> hits;
+      hits.reserve(merged_hits[m.first].size());
+      for (auto& h : merged_hits[m.first])
       {
-        return ExitCodes::UNKNOWN_ERROR;
+        PeptideHit& ph = h.second;
+        ph.setPeptideEvidences(vector<PeptideEvidence>());
+        ph.removeMetaValue("target_decoy");
+        ph.removeMetaValue("protein_references");
+        hits.push_back(std::move(ph));
       }
-    } 
-
-#ifdef _OPENMP
-    // free locks
-    for (size_t i = 0; i != annotated_hits_lock.size(); i++) { omp_destroy_lock(&(annotated_hits_lock[i])); }
-#endif
+      std::stable_sort(hits.begin(), hits.end(), [](const PeptideHit& a, const PeptideHit& b) { return a.getScore() > b.getScore(); });
+      if (hits.size() > report_top_hits_) { hits.resize(report_top_hits_); }
+      m.second.setHits(std::move(hits));
+      m.second.assignRanks();
+      peptide_ids.push_back(std::move(m.second));
+    }
 
-    return ExitCodes::EXECUTION_OK;
+    // reindex against the whole database (including the decoys of all shards)
+    vector<FASTAFile::FASTAEntry> fasta_db;
+    FASTAFile::load(in_db, fasta_db);
+    if (decoys_) { appendDecoys_(fasta_db); }
+    return indexPeptides_(fasta_db, protein_ids, peptide_ids);
   }
 
 } // namespace OpenMS
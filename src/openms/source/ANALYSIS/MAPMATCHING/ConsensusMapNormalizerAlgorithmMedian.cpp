@@ -43,6 +43,66 @@ using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// ConsensusMapNormalizerAlgorithmMedian::passesFilters_ with already compiled regular expressions
+    bool passesCompiledFilters_(ConsensusMap::ConstIterator cf_it, const ConsensusMap& map, const String& acc_filter, const boost::regex& acc_regexp,
+                                const String& desc_filter, const boost::regex& desc_regexp)
+    {
+      boost::cmatch m;
+
+      if ((acc_filter == "" || boost::regex_search("", m, acc_regexp)) &&
+          (desc_filter == "" || boost::regex_search("", m, desc_regexp)))
+      {
+        // feature passes (even if it has no identification!)
+        return true;
+      }
+
+      const vector<ProteinIdentification>& prot_ids = map.getProteinIdentifications();
+      const vector<PeptideIdentification>& pep_ids = cf_it->getPeptideIdentifications();
+
+      for (vector<PeptideIdentification>::const_iterator p_it = pep_ids.begin(); p_it != pep_ids.end(); ++p_it)
+      {
+        const vector<PeptideHit>& hits = p_it->getHits();
+        for (vector<PeptideHit>::const_iterator h_it = hits.begin(); h_it != hits.end(); ++h_it)
+        {
+          const set<String>& accs = h_it->extractProteinAccessionsSet();
+          for (set<String>::const_iterator acc_it = accs.begin(); acc_it != accs.end(); ++acc_it)
+          {
+            // does accession match?
+            if (!(acc_filter == "" ||
+                  boost::regex_search("", m, acc_regexp) ||
+                  boost::regex_search(acc_it->c_str(), m, acc_regexp)))
+            {
+              //no
+              continue;
+            }
+
+            // yes. does description match, too?
+            if (desc_filter == "" || boost::regex_search("", m, desc_regexp))
+            {
+              return true;
+            }
+            for (vector<ProteinIdentification>::const_iterator pr_it = prot_ids.begin(); pr_it != prot_ids.end(); ++pr_it)
+            {
+              std::vector<ProteinHit>::const_iterator pr_hit = const_cast<ProteinIdentification&>(*pr_it).findHit(*acc_it);
+              if (pr_hit != pr_it->getHits().end())
+              {
+                const char* desc = pr_hit->getDescription().c_str();
+                if (boost::regex_search(desc, m, desc_regexp))
+                {
+                  return true;
+                }
+              }
+            }
+          }
+        }
+      }
+
+      return false;
+    }
+  }
+
   ConsensusMapNormalizerAlgorithmMedian::ConsensusMapNormalizerAlgorithmMedian()
   {
   }
@@ -84,11 +144,17 @@ namespace OpenMS
     }
 
     // fill feature_int with intensities
+    // (the regular expressions are compiled only once, not for every feature)
+    const boost::regex acc_regexp(acc_filter);
+    const boost::regex desc_regexp(desc_filter);
+    boost::cmatch m;
+    const bool all_pass = (acc_filter == "" || boost::regex_search("", m, acc_regexp)) &&
+                          (desc_filter == "" || boost::regex_search("", m, desc_regexp));
     Size pass_counter = 0;
     ConsensusMap::ConstIterator cf_it;
     for (cf_it = map.begin(); cf_it != map.end(); ++cf_it)
     {
-      if (!passesFilters_(cf_it, map, acc_filter, desc_filter))
+      if (!all_pass && !passesCompiledFilters_(cf_it, map, acc_filter, acc_regexp, desc_filter, desc_regexp))
       {
         continue;
       }
@@ -125,7 +191,8 @@ namespace OpenMS
     else
     {
       //compute medians
-      for (UInt j = 0; j < number_of_maps; j++)
+#pragma omp parallel for schedule(dynamic, 1)
+      for (SignedSize j = 0; j < (SignedSize)number_of_maps; j++)
       {
         vector<double>& ints_j = feature_int[j];
         medians[j] = Math::median(ints_j.begin(), ints_j.end());
@@ -142,7 +209,6 @@ namespace OpenMS
       OPENMS_LOG_WARN << endl << "WARNING: normalization using median shifting is not recommended for regular log-normal MS data. Use this only if you know exactly what you're doing!" << endl << endl;
     }
 
-    ConsensusMap::Iterator cf_it;
     ProgressLogger progresslogger;
     progresslogger.setLogType(ProgressLogger::CMD);
     progresslogger.startProgress(0, map.size(), "normalizing maps");
@@ -150,32 +216,51 @@ namespace OpenMS
     vector<double> medians;
     Size index_of_largest_map = computeMedians(map, medians, acc_filter, desc_filter);
 
-    for (cf_it = map.begin(); cf_it != map.end(); ++cf_it)
+    // intensity correction for each map: new = old * factor + offset
+    vector<double> factors(medians.size(), 1.0), offsets(medians.size(), 0.0);
+    if (method == NM_SCALE)
     {
-      progresslogger.setProgress(cf_it - map.begin());
-      ConsensusFeature::HandleSetType::const_iterator f_it;
-      for (f_it = cf_it->getFeatures().begin(); f_it != cf_it->getFeatures().end(); ++f_it)
+      // scale to median of map with largest number of features
+      for (Size i = 0; i < medians.size(); ++i)
+      {
+        factors[i] = medians[index_of_largest_map] / medians[i];
+      }
+    }
+    else // method == NM_SHIFT
+    {
+      // shift to median of map with largest median in order to avoid negative intensities
+      double max_median(numeric_limits<double>::min());
+      Size max_median_index(0);
+      for (Size i = 0; i < medians.size(); ++i)
+      {
+        if (medians[i] > max_median)
+        {
+          max_median = medians[i];
+          max_median_index = i;
+        }
+      }
+      for (Size i = 0; i < medians.size(); ++i)
+      {
+        offsets[i] = medians[max_median_index] - medians[i];
+      }
+    }
+
+    // consensus features are independent of each other
+#pragma omp parallel for
+    for (SignedSize i = 0; i < (SignedSize)map.size(); ++i)
+    {
+      IF_MASTERTHREAD progresslogger.setProgress(i);
+      const ConsensusFeature::HandleSetType& handles = map[i].getFeatures();
+      for (ConsensusFeature::HandleSetType::const_iterator f_it = handles.begin(); f_it != handles.end(); ++f_it)
       {
         Size map_index = f_it->getMapIndex();
         if (method == NM_SCALE)
         {
-          // scale to median of map with largest number of features
-          f_it->asMutable().setIntensity(f_it->getIntensity() * medians[index_of_largest_map] / medians[map_index]);
+          f_it->asMutable().setIntensity(f_it->getIntensity() * factors[map_index]);
         }
-        else // method == NM_SHIFT
+        else
         {
-          // shift to median of map with largest median in order to avoid negative intensities
-          double max_median(numeric_limits<double>::min());
-          Size max_median_index(0);
-          for (Size i = 0; i < medians.size(); ++i)
-          {
-            if (medians[i] > max_median)
-            {
-              max_median = medians[i];
-              max_median_index = i;
-            }
-          }
-          f_it->asMutable().setIntensity(f_it->getIntensity() + medians[max_median_index] - medians[map_index]);
+          f_it->asMutable().setIntensity(f_it->getIntensity() + offsets[map_index]);
         }
       }
     }
@@ -184,59 +269,7 @@ namespace OpenMS
 
   bool ConsensusMapNormalizerAlgorithmMedian::passesFilters_(ConsensusMap::ConstIterator cf_it, const ConsensusMap& map, const String& acc_filter, const String& desc_filter)
   {
-    boost::regex acc_regexp(acc_filter);
-    boost::regex desc_regexp(desc_filter);
-    boost::cmatch m;
-
-    if ((acc_filter == "" || boost::regex_search("", m, acc_regexp)) &&
-        (desc_filter == "" || boost::regex_search("", m, desc_regexp)))
-    {
-      // feature passes (even if it has no identification!)
-      return true;
-    }
-
-    const vector<ProteinIdentification>& prot_ids = map.getProteinIdentifications();
-    const vector<PeptideIdentification>& pep_ids = cf_it->getPeptideIdentifications();
-
-    for (vector<PeptideIdentification>::const_iterator p_it = pep_ids.begin(); p_it != pep_ids.end(); ++p_it)
-    {
-      const vector<PeptideHit>& hits = p_it->getHits();
-      for (vector<PeptideHit>::const_iterator h_it = hits.begin(); h_it != hits.end(); ++h_it)
-      {
-        const set<String>& accs = h_it->extractProteinAccessionsSet();
-        for (set<String>::const_iterator acc_it = accs.begin(); acc_it != accs.end(); ++acc_it)
-        {
-          // does accession match?
-          if (!(acc_filter == "" ||
-                boost::regex_search("", m, acc_regexp) ||
-                boost::regex_search(acc_it->c_str(), m, acc_regexp)))
-          {
-            //no
-            continue;
-          }
-
-          // yes. does description match, too?
-          if (desc_filter == "" || boost::regex_search("", m, desc_regexp))
-          {
-            return true;
-          }
-          for (vector<ProteinIdentification>::const_iterator pr_it = prot_ids.begin(); pr_it != prot_ids.end(); ++pr_it)
-          {
-            std::vector<ProteinHit>::const_iterator pr_hit = const_cast<ProteinIdentification&>(*pr_it).findHit(*acc_it);
-            if (pr_hit != pr_it->getHits().end())
-            {
-              const char* desc = pr_hit->getDescription().c_str();
-              if (boost::regex_search(desc, m, desc_regexp))
-              {
-                return true;
-              }
-            }
-          }
-        }
-      }
-    }
-
-    return false;
+    return passesCompiledFilters_(cf_it, map, acc_filter, boost::regex(acc_filter), desc_filter, boost::regex(desc_filter));
   }
 
 }
@@ -66,61 +66,57 @@ namespace OpenMS
       }
     }
 
-    //resample n data points from each sorted intensity distribution (from the different maps), n = maximum number of features in any map
-    vector<vector<double> > resampled_sorted_data;
-    for (Size i = 0; i < number_of_maps; ++i)
+    // The maps are independent of each other: sort (via an index permutation,
+    // which is also needed to write the values back) and resample each one in
+    // parallel. resample n data points from each sorted intensity distribution
+    // (from the different maps), n = maximum number of features in any map
+    vector<vector<UInt> > sort_indices(number_of_maps);
+    vector<vector<double> > resampled_sorted_data(number_of_maps);
+#pragma omp parallel for schedule(dynamic, 1)
+    for (SignedSize i = 0; i < (SignedSize)number_of_maps; ++i)
     {
-      vector<double> sorted = feature_ints[i];
-      std::sort(sorted.begin(), sorted.end());
-      vector<double> resampled(largest_number_of_features);
-      resample(sorted, resampled, static_cast<UInt>(largest_number_of_features));
-      resampled_sorted_data.push_back(resampled);
+      const vector<double>& ints = feature_ints[i];
+      vector<UInt>& indices = sort_indices[i];
+      indices.resize(ints.size());
+      for (Size j = 0; j < indices.size(); ++j)
+      {
+        indices[j] = static_cast<UInt>(j);
+      }
+      // ties are ordered by index
+      std::sort(indices.begin(), indices.end(), [&ints](UInt a, UInt b)
+      {
+        return ints[a] < ints[b] || (ints[a] == ints[b] && a < b);
+      });
+      vector<double> sorted(ints.size());
+      for (Size j = 0; j < indices.size(); ++j)
+      {
+        sorted[j] = ints[indices[j]];
+      }
+      resample(sorted, resampled_sorted_data[i], static_cast<UInt>(largest_number_of_features));
     }
 
     //compute reference distribution from all resampled distributions
     vector<double> reference_distribution(largest_number_of_features);
-    for (Size i = 0; i < number_of_maps; ++i)
+#pragma omp parallel for
+    for (SignedSize j = 0; j < (SignedSize)largest_number_of_features; ++j)
     {
-      for (Size j = 0; j < largest_number_of_features; ++j)
+      for (Size i = 0; i < number_of_maps; ++i)
       {
         reference_distribution[j] += (resampled_sorted_data[i][j] / (double)number_of_maps);
       }
     }
+    resampled_sorted_data.clear();
 
     //for each map: resample from the reference distribution down to the respective original size again
-    vector<vector<double> > normalized_sorted_ints(number_of_maps);
-    for (Size i = 0; i < number_of_maps; ++i)
+    //and set the intensities of feature_ints to the normalized intensities (same ranks as before)
+#pragma omp parallel for schedule(dynamic, 1)
+    for (SignedSize i = 0; i < (SignedSize)number_of_maps; ++i)
     {
-      vector<double> ints;
-      resample(reference_distribution, ints, static_cast<UInt>(feature_ints[i].size()));
-      normalized_sorted_ints[i] = ints;
-    }
-
-    //set the intensities of feature_ints to the normalized intensities
-    for (Size i = 0; i < number_of_maps; ++i)
-    {
-      // We do not want to change the order in feature_ints[i] but normalized_sorted_ints
-      // comes sorted, so we transfer the values in feature_ints[i] into pairs that store
-      // the value and the index in feature_ints[i]. Then we sort the vector of pair and as
-      // a result store the indexes of feature_ints[i] in a sorted order in sort_indices.
-      std::vector<std::pair<double, UInt> > sort_pairs;
-      sort_pairs.reserve(feature_ints[i].size());
-      for (Size j = 0; j < feature_ints[i].size(); ++j)
-      {
-        sort_pairs.push_back(std::make_pair(feature_ints[i][j], j));
-      }
-      std::sort(sort_pairs.begin(), sort_pairs.end());
-      vector<Size> sort_indices;
-      sort_indices.reserve(sort_pairs.size());
-      for (Size j = 0; j < sort_pairs.size(); ++j)
-      {
-        sort_indices.push_back(sort_pairs.at(j).second);
-      }
-      Size k = 0;
-      for (Size j = 0; j < sort_indices.size(); ++j)
+      vector<double> normalized_sorted_ints;
+      resample(reference_distribution, normalized_sorted_ints, static_cast<UInt>(feature_ints[i].size()));
+      for (Size j = 0; j < sort_indices[i].size(); ++j)
       {
-        Size idx = sort_indices[j];
-        feature_ints[i][idx] = normalized_sorted_ints[i][k++];
+        feature_ints[i][sort_indices[i][j]] = normalized_sorted_ints[j];
       }
     }
 
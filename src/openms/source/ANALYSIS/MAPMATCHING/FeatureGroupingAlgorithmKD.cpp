@@ -37,11 +37,107 @@
 #include <OpenMS/METADATA/ProteinIdentification.h>
 #include <OpenMS/METADATA/PeptideIdentification.h>
 #include <OpenMS/FORMAT/FeatureXMLFile.h>
+#include <OpenMS/FORMAT/ColumnarFeatureFile.h>
+#include <OpenMS/MATH/MISC/MathFunctions.h>
+
+#include <queue>
+#include <tuple>
 
 using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// number of values read at once when streaming a column from a file
+    const Size COLUMN_CHUNK_SIZE = 65536;
+
+    /// Reads the (m/z-sorted) "mz" column of a columnar feature file chunk by chunk
+    class MZStream_
+    {
+public:
+      MZStream_(const ColumnarFeatureFile& file, const String& filename) :
+        file_(&file),
+        filename_(filename),
+        next_row_(0),
+        pos_(0)
+      {
+        fill_();
+      }
+
+      bool atEnd() const
+      {
+        return pos_ >= chunk_.size();
+      }
+
+      double current() const
+      {
+        return chunk_[pos_];
+      }
+
+      void advance()
+      {
+        if (++pos_ >= chunk_.size()) fill_();
+      }
+
+private:
+      void fill_()
+      {
+        const double last = chunk_.empty() ? -numeric_limits<double>::max() : chunk_.back();
+        pos_ = 0;
+        if (next_row_ >= file_->size())
+        {
+          chunk_.clear();
+          return;
+        }
+        file_->getColumn("mz", chunk_, next_row_, COLUMN_CHUNK_SIZE);
+        next_row_ += chunk_.size();
+        if (!is_sorted(chunk_.begin(), chunk_.end()) || chunk_.front() < last)
+        {
+          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Features in '" + filename_ + "' are not sorted by m/z.");
+        }
+      }
+
+      const ColumnarFeatureFile* file_;
+      String filename_;
+      Size next_row_;
+      Size pos_;
+      vector<double> chunk_;
+    };
+
+    /// Returns the first row >= @p begin of @p file whose m/z is not smaller than @p mz
+    Size lowerBoundMZ_(const ColumnarFeatureFile& file, Size begin, double mz)
+    {
+      Size lo = begin, hi = file.size();
+      vector<double> value;
+      while (lo < hi)
+      {
+        Size mid = lo + (hi - lo) / 2;
+        file.getColumn("mz", value, mid, 1);
+        if (value[0] < mz)
+        {
+          lo = mid + 1;
+        }
+        else
+        {
+          hi = mid;
+        }
+      }
+      return lo;
+    }
+
+    /// Loads the features of the next partition (ending at @p partition_end) of every file into @p slab
+    void loadSlab_(const vector<ColumnarFeatureFile>& inputs, double partition_end, vector<Size>& cursors, vector<FeatureMap>& slab)
+    {
+      slab.resize(inputs.size());
+      for (Size k = 0; k < inputs.size(); ++k)
+      {
+        const Size end = lowerBoundMZ_(inputs[k], cursors[k], partition_end);
+        inputs[k].loadRange(cursors[k], end - cursors[k], slab[k]);
+        cursors[k] = end;
+      }
+    }
+  }
 
   FeatureGroupingAlgorithmKD::FeatureGroupingAlgorithmKD() :
     ProgressLogger(),
@@ -112,12 +208,6 @@ namespace OpenMS
   void FeatureGroupingAlgorithmKD::group_(const vector<MapType>& input_maps,
                                           ConsensusMap& out)
   {
-    // set parameters
-    String mz_unit(param_.getValue("mz_unit").toString());
-    mz_ppm_ = mz_unit == "ppm";
-    mz_tol_ = (double)(param_.getValue("link:mz_tol"));
-    rt_tol_secs_ = (double)(param_.getValue("link:rt_tol"));
-
     // check that the number of maps is ok:
     if (input_maps.size() < 2)
     {
@@ -145,44 +235,20 @@ namespace OpenMS
       }
     }
 
-    // set up distance functor
-    Param distance_params;
-    distance_params.insert("", param_.copy("distance_RT:"));
-    distance_params.insert("", param_.copy("distance_MZ:"));
-    distance_params.insert("", param_.copy("distance_intensity:"));
-    distance_params.setValue("distance_RT:max_difference", rt_tol_secs_);
-    distance_params.setValue("distance_MZ:max_difference", mz_tol_);
-    distance_params.setValue("distance_MZ:unit", (mz_ppm_ ? "ppm" : "Da"));
-    feature_distance_ = FeatureDistance(max_intensity, false);
-    feature_distance_.setParameters(distance_params);
+    setUpParameters_(max_intensity);
 
     // partition at boundaries -> this should be safe because there cannot be
     // any cluster reaching across boundaries
 
     sort(massrange.begin(), massrange.end());
-    int pts_per_partition = massrange.size() / (int)(param_.getValue("nr_partitions"));
-
-    double warp_mz_tol = (double)(param_.getValue("warp:mz_tol"));
-    double max_mz_tol = max(mz_tol_, warp_mz_tol);
-
-    // compute partition boundaries
-    vector<double> partition_boundaries;
-    partition_boundaries.push_back(massrange.front());
-    for (size_t j = 0; j < massrange.size()-1; j++)
-    {
-      // minimal differences between two m/z values
-      double massrange_diff = mz_ppm_ ? max_mz_tol * 1e-6 * massrange[j+1] : max_mz_tol;
-
-      if (fabs(massrange[j] - massrange[j+1]) > massrange_diff)
+    vector<double>::const_iterator mz_it = massrange.begin();
+    vector<double> partition_boundaries = computePartitionBoundaries_(massrange.size(),
+      [&mz_it, &massrange](double& mz)
       {
-        if (j >= (partition_boundaries.size() ) * pts_per_partition  )
-        {
-          partition_boundaries.push_back((massrange[j] + massrange[j+1])/2.0);
-        }
-      }
-    }
-    // add last partition (a bit more since we use "smaller than" below)
-    partition_boundaries.push_back(massrange.back() + 1.0);
+        if (mz_it == massrange.end()) return false;
+        mz = *mz_it++;
+        return true;
+      });
 
     // ------------ compute RT transformation models ------------
 
@@ -277,6 +343,60 @@ namespace OpenMS
     postprocess_(input_maps, out);
   }
 
+  void FeatureGroupingAlgorithmKD::setUpParameters_(double max_intensity)
+  {
+    String mz_unit(param_.getValue("mz_unit").toString());
+    mz_ppm_ = mz_unit == "ppm";
+    mz_tol_ = (double)(param_.getValue("link:mz_tol"));
+    rt_tol_secs_ = (double)(param_.getValue("link:rt_tol"));
+
+    // set up distance functor
+    Param distance_params;
+    distance_params.insert("", param_.copy("distance_RT:"));
+    distance_params.insert("", param_.copy("distance_MZ:"));
+    distance_params.insert("", param_.copy("distance_intensity:"));
+    distance_params.setValue("distance_RT:max_difference", rt_tol_secs_);
+    distance_params.setValue("distance_MZ:max_difference", mz_tol_);
+    distance_params.setValue("distance_MZ:unit", (mz_ppm_ ? "ppm" : "Da"));
+    feature_distance_ = FeatureDistance(max_intensity, false);
+    feature_distance_.setParameters(distance_params);
+  }
+
+  vector<double> FeatureGroupingAlgorithmKD::computePartitionBoundaries_(Size nr_points, const std::function<bool(double&)>& next_mz) const
+  {
+    vector<double> partition_boundaries;
+    double mz(0.0), next(0.0);
+    if (!next_mz(mz))
+    {
+      return partition_boundaries;
+    }
+
+    int pts_per_partition = nr_points / (int)(param_.getValue("nr_partitions"));
+
+    double warp_mz_tol = (double)(param_.getValue("warp:mz_tol"));
+    double max_mz_tol = max(mz_tol_, warp_mz_tol);
+
+    partition_boundaries.push_back(mz);
+    for (size_t j = 0; next_mz(next); j++)
+    {
+      // minimal differences between two m/z values
+      double massrange_diff = mz_ppm_ ? max_mz_tol * 1e-6 * next : max_mz_tol;
+
+      if (fabs(mz - next) > massrange_diff)
+      {
+        if (j >= (partition_boundaries.size() ) * pts_per_partition  )
+        {
+          partition_boundaries.push_back((mz + next)/2.0);
+        }
+      }
+      mz = next;
+    }
+    // add last partition (a bit more since we use "smaller than" below)
+    partition_boundaries.push_back(mz + 1.0);
+
+    return partition_boundaries;
+  }
+
   void FeatureGroupingAlgorithmKD::group(const std::vector<FeatureMap>& maps,
                                          ConsensusMap& out)
   {
@@ -289,6 +409,233 @@ namespace OpenMS
     group_(maps, out);
   }
 
+  void FeatureGroupingAlgorithmKD::groupFromFiles(const StringList& files, ConsensusMap& out)
+  {
+    if (files.size() < 2)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+                                       "At least two maps must be given!");
+    }
+
+    out.clear(false);
+
+    // open files (only the column directories are read), find intensity maximum
+    vector<ColumnarFeatureFile> inputs(files.size());
+    Size nr_features(0);
+    double max_intensity(0.0);
+    vector<float> intensities;
+    for (Size k = 0; k < files.size(); ++k)
+    {
+      inputs[k].open(files[k]);
+      if (inputs[k].getMapType() != ColumnarFeatureFile::FEATURE_MAP)
+      {
+        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+                                         "File '" + files[k] + "' does not contain a feature map.");
+      }
+      for (Size first = 0; first < inputs[k].size(); first += COLUMN_CHUNK_SIZE)
+      {
+        inputs[k].getColumn("intensity", intensities, first, COLUMN_CHUNK_SIZE);
+        for (float inty : intensities)
+        {
+          max_intensity = max(max_intensity, double(inty));
+        }
+      }
+      nr_features += inputs[k].size();
+    }
+
+    setUpParameters_(max_intensity);
+
+    // merge the sorted m/z columns of all files to compute partition boundaries
+    vector<MZStream_> streams;
+    streams.reserve(inputs.size());
+    typedef pair<double, Size> QueueEntry;
+    priority_queue<QueueEntry, vector<QueueEntry>, greater<QueueEntry> > queue;
+    for (Size k = 0; k < inputs.size(); ++k)
+    {
+      streams.push_back(MZStream_(inputs[k], files[k]));
+      if (!streams[k].atEnd()) queue.push(QueueEntry(streams[k].current(), k));
+    }
+    vector<double> partition_boundaries = computePartitionBoundaries_(nr_features,
+      [&streams, &queue](double& mz)
+      {
+        if (queue.empty()) return false;
+        mz = queue.top().first;
+        Size k = queue.top().second;
+        queue.pop();
+        streams[k].advance();
+        if (!streams[k].atEnd()) queue.push(QueueEntry(streams[k].current(), k));
+        return true;
+      });
+    streams.clear();
+
+    if (partition_boundaries.empty())
+    {
+      return; // no features
+    }
+
+    // ------------ compute RT transformation models ------------
+
+    MapAlignmentAlgorithmKD aligner(files.size(), param_);
+    bool align = param_.getValue("warp:enabled").toString() == "true";
+    vector<FeatureMap> slab;
+    if (align)
+    {
+      vector<Size> cursors(inputs.size(), 0);
+      Size progress = 0;
+      startProgress(0, partition_boundaries.size(), "computing RT transformations");
+      for (size_t j = 0; j + 1 < partition_boundaries.size(); j++)
+      {
+        loadSlab_(inputs, partition_boundaries[j+1], cursors, slab);
+        KDTreeFeatureMaps kd_data(slab, param_);
+        aligner.addRTFitData(kd_data);
+        setProgress(progress++);
+      }
+
+      // fit LOWESS on RT fit data collected across all partitions
+      try
+      {
+        aligner.fitLOWESS();
+      }
+      catch (Exception::BaseException& e)
+      {
+        OPENMS_LOG_ERROR << "Error: " << e.what() << endl;
+        return;
+      }
+
+      endProgress();
+    }
+
+    // ------------ run alignment + feature linking on individual partitions ------------
+    vector<Size> cursors(inputs.size(), 0);
+    Size progress = 0;
+    startProgress(0, partition_boundaries.size(), "linking features");
+    for (size_t j = 0; j + 1 < partition_boundaries.size(); j++)
+    {
+      loadSlab_(inputs, partition_boundaries[j+1], cursors, slab);
+      KDTreeFeatureMaps kd_data(slab, param_);
+      if (align)
+      {
+        aligner.transform(kd_data);
+      }
+      runClustering_(kd_data, out);
+      setProgress(progress++);
+    }
+    endProgress();
+
+    // canonical ordering (see FeatureGroupingAlgorithm::postprocess_)
+    out.sortByQuality();
+    out.sortByMaps();
+    out.sortBySize();
+  }
+
+  void FeatureGroupingAlgorithmKD::addToConsensus(const std::vector<FeatureMap>& maps, ConsensusMap& consensus)
+  {
+    if (maps.empty()) return;
+
+    ConsensusMap::ColumnHeaders& headers = consensus.getColumnHeaders();
+    const Size first_index = headers.empty() ? 0 : headers.rbegin()->first + 1;
+
+    double max_intensity(0.0);
+    for (const ConsensusFeature& cf : consensus)
+    {
+      max_intensity = max(max_intensity, double(cf.getIntensity()));
+    }
+    for (const FeatureMap& map : maps)
+    {
+      for (const Feature& feature : map)
+      {
+        max_intensity = max(max_intensity, double(feature.getIntensity()));
+      }
+    }
+    setUpParameters_(max_intensity);
+    const String merge_charge(param_.getValue("link:charge_merging").toString());
+    const String merge_adduct(param_.getValue("link:adduct_merging").toString());
+
+    // kd-tree on the existing consensus centroids (all in "map" 0)
+    KDTreeFeatureMaps centroids;
+    centroids.setParameters(param_);
+    for (const ConsensusFeature& cf : consensus)
+    {
+      centroids.addFeature(0, &cf);
+    }
+    centroids.optimizeTree();
+
+    // match the features of each new map to the consensus features; every
+    // consensus feature receives at most one feature per map, closest pairs first
+    vector<FeatureMap> unmatched(first_index + maps.size()); // keep map indices for runClustering_
+    vector<bool> updated(consensus.size(), false);
+    vector<Size> last_added(consensus.size(), numeric_limits<Size>::max()); // new map last added to a consensus feature
+    startProgress(0, maps.size(), "adding features to consensus map");
+    for (Size k = 0; k < maps.size(); ++k)
+    {
+      const FeatureMap& map = maps[k];
+      typedef std::tuple<double, Size, Size> Match; // distance, feature index, consensus feature index
+      vector<Match> matches;
+      for (Size f = 0; f < map.size(); ++f)
+      {
+        pair<double, double> rt_win = Math::getTolWindow(map[f].getRT(), rt_tol_secs_, false);
+        pair<double, double> mz_win = Math::getTolWindow(map[f].getMZ(), mz_tol_, mz_ppm_);
+        vector<Size> candidates;
+        centroids.queryRegion(rt_win.first, rt_win.second, mz_win.first, mz_win.second, candidates);
+        for (Size c : candidates)
+        {
+          if (!isCompatible_(consensus[c], map[f], merge_charge, merge_adduct)) continue;
+          matches.emplace_back(feature_distance_(consensus[c], map[f]).second, f, c);
+        }
+      }
+      sort(matches.begin(), matches.end());
+
+      vector<bool> feature_done(map.size(), false);
+      for (const Match& match : matches)
+      {
+        const Size f = std::get<1>(match), c = std::get<2>(match);
+        if (feature_done[f] || last_added[c] == k) continue;
+        consensus[c].insert(first_index + k, map[f]);
+        updated[c] = true;
+        last_added[c] = k;
+        feature_done[f] = true;
+      }
+      for (Size f = 0; f < map.size(); ++f)
+      {
+        if (!feature_done[f]) unmatched[first_index + k].push_back(map[f]);
+      }
+
+      // column header and identifications of the new map (cf. FeatureGroupingAlgorithm::postprocess_)
+      StringList ms_runs;
+      map.getPrimaryMSRunPath(ms_runs);
+      if (ms_runs.size() == 1) headers[first_index + k].filename = ms_runs.front();
+      headers[first_index + k].size = map.size();
+      headers[first_index + k].unique_id = map.getUniqueId();
+      consensus.getProteinIdentifications().insert(consensus.getProteinIdentifications().end(),
+        map.getProteinIdentifications().begin(), map.getProteinIdentifications().end());
+      for (PeptideIdentification pep_id : map.getUnassignedPeptideIdentifications())
+      {
+        pep_id.setMetaValue("map_index", first_index + k);
+        consensus.getUnassignedPeptideIdentifications().push_back(pep_id);
+      }
+      setProgress(k);
+    }
+    endProgress();
+
+    for (Size c = 0; c < updated.size(); ++c)
+    {
+      if (updated[c]) consensus[c].computeConsensus();
+    }
+
+    // features without a match are linked among themselves (new consensus features)
+    for (FeatureMap& map : unmatched)
+    {
+      map.updateRanges();
+    }
+    KDTreeFeatureMaps kd_data(unmatched, param_);
+    runClustering_(kd_data, consensus);
+
+    // canonical ordering (see FeatureGroupingAlgorithm::postprocess_)
+    consensus.sortByQuality();
+    consensus.sortByMaps();
+    consensus.sortBySize();
+  }
+
   void FeatureGroupingAlgorithmKD::runClustering_(const KDTreeFeatureMaps& kd_data, ConsensusMap& out)
   {
     Size n = kd_data.size();
@@ -369,6 +716,73 @@ namespace OpenMS
     }
   }
 
+  bool FeatureGroupingAlgorithmKD::isCompatible_(const BaseFeature& center, const BaseFeature& other, const String& merge_charge, const String& merge_adduct) const
+  {
+    if (merge_charge == "Identical")
+    {
+      if (other.getCharge() != center.getCharge())
+      {
+        return false;
+      }
+    }
+    // what to consider for linking with existing features _that have charge_. This ensures that we won't collect different non-zero charges.
+    else if (merge_charge == "With_charge_zero")
+    {
+      if ((other.getCharge() != center.getCharge()) && (other.getCharge() != 0))
+      {
+        return false;
+      }
+    }
+    // else if (merge_charge == "Any")
+    //{
+    //  //we allow to merge all
+    //}
+
+    // analogous adduct block
+    if (merge_adduct == "Identical")
+    {
+      // subcase 1: one has adduct, other not
+      if (other.metaValueExists("dc_charge_adducts") != center.metaValueExists("dc_charge_adducts"))
+      {
+        return false;
+      }
+      // subcase 2: both have adduct, but is it the same?
+      if (other.metaValueExists("dc_charge_adducts"))
+      {
+        if (EmpiricalFormula(other.getMetaValue("dc_charge_adducts")) != EmpiricalFormula(center.getMetaValue("dc_charge_adducts")))
+        {
+          return false;
+        }  
+      }
+    }
+    // what to consider for linking with existing features _that have adduct_. If one has no adduct, it's fine
+    // anyway. If one has an adduct we have to compare.
+    else if (merge_adduct == "With_unknown_adducts")
+    {
+      // subcase1: other has adduct, but center not. don't want to collect potentially different adducts to previous without adduct 
+      if ((other.metaValueExists("dc_charge_adducts")) && (!center.metaValueExists("dc_charge_adducts")))
+      {
+        return false;
+      }
+      // subcase2: both have adduct
+      if ((other.metaValueExists("dc_charge_adducts")) && (center.metaValueExists("dc_charge_adducts")))
+      {
+        // cheaper string check first, only check EF extensively if strings differ (might be just different element orders)
+        if ((other.getMetaValue("dc_charge_adducts") != center.getMetaValue("dc_charge_adducts")) &&
+            (EmpiricalFormula(other.getMetaValue("dc_charge_adducts")) != EmpiricalFormula(center.getMetaValue("dc_charge_adducts"))))
+        {
+          return false;
+        }
+      }
+    }
+    // else if (merge_adduct == "Any")
+    //{
+    //  //we allow to merge all
+    //}
+
+    return true;
+  }
+
   ClusterProxyKD FeatureGroupingAlgorithmKD::computeBestClusterForCenter_(Size i, vector<Size>& cf_indices, const vector<Int>& assigned, const KDTreeFeatureMaps& kd_data) const
   {
     //Parameters how to use charge/adduct information
@@ -380,7 +794,6 @@ namespace OpenMS
     map<Size, vector<Size> > points_for_map_index;
     vector<Size> neighbors;
     kd_data.getNeighborhood(i, neighbors, rt_tol_secs_, mz_tol_, mz_ppm_, true);
-    Int charge_i = kd_data.charge(i);
     const BaseFeature* f_i = kd_data.feature(i);
     for (vector<Size>::const_iterator it = neighbors.begin(); it != neighbors.end(); ++it)
     {
@@ -390,67 +803,10 @@ namespace OpenMS
         continue;
       }
 
-      if (merge_charge == "Identical")
-      {
-        if (kd_data.charge(*it) != charge_i)
-        {
-          continue;
-        }
-      }
-      // what to consider for linking with existing features _that have charge_. This ensures that we won't collect different non-zero charges.
-      else if (merge_charge == "With_charge_zero")
-      {
-        if ((kd_data.charge(*it) != charge_i) && (kd_data.charge(*it) != 0))
-        {
-          continue;
-        }
-      }
-      // else if (merge_charge == "Any")
-      //{
-      //  //we allow to merge all
-      //}
-
-      // analogous adduct block
-      if (merge_adduct == "Identical")
-      {
-        // subcase 1: one has adduct, other not
-        if (kd_data.feature(*it)->metaValueExists("dc_charge_adducts") != f_i->metaValueExists("dc_charge_adducts"))
-        {
-          continue;
-        }
-        // subcase 2: both have adduct, but is it the same?
-        if (kd_data.feature(*it)->metaValueExists("dc_charge_adducts"))
-        {
-          if (EmpiricalFormula(kd_data.feature(*it)->getMetaValue("dc_charge_adducts")) != EmpiricalFormula(f_i->getMetaValue("dc_charge_adducts")))
-          {
-            continue;
-          }  
-        }
-      }
-      // what to consider for linking with existing features _that have adduct_. If one has no adduct, it's fine
-      // anyway. If one has an adduct we have to compare.
-      else if (merge_adduct == "With_unknown_adducts")
+      if (!isCompatible_(*f_i, *(kd_data.feature(*it)), merge_charge, merge_adduct))
       {
-        // subcase1: *it has adduct, but i not. don't want to collect potentially different adducts to previous without adduct 
-        if ((kd_data.feature(*it)->metaValueExists("dc_charge_adducts")) && (!f_i->metaValueExists("dc_charge_adducts")))
-        {
-          continue;
-        }
-        // subcase2: both have adduct
-        if ((kd_data.feature(*it)->metaValueExists("dc_charge_adducts")) && (f_i->metaValueExists("dc_charge_adducts")))
-        {
-          // cheaper string check first, only check EF extensively if strings differ (might be just different element orders)
-          if ((kd_data.feature(*it)->getMetaValue("dc_charge_adducts") != f_i->getMetaValue("dc_charge_adducts")) &&
-              (EmpiricalFormula(kd_data.feature(*it)->getMetaValue("dc_charge_adducts")) != EmpiricalFormula(f_i->getMetaValue("dc_charge_adducts"))))
-          {
-            continue;
-          }
-        }
+        continue;
       }
-      // else if (merge_adduct == "Any")
-      //{
-      //  //we allow to merge all
-      //}
 
       // if everything is OK, add feature
       points_for_map_index[kd_data.mapIndex(*it)].push_back(*it);
@@ -36,6 +36,10 @@
 #include <OpenMS/FORMAT/FeatureXMLFile.h>
 #include <OpenMS/FORMAT/FileHandler.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 
 namespace OpenMS
@@ -56,10 +60,8 @@ namespace OpenMS
   void MapAlignmentAlgorithmPoseClustering::updateMembers_()
   {
     superimposer_.setParameters(param_.copy("superimposer:", true));
-    superimposer_.setLogType(getLogType());
 
     pairfinder_.setParameters(param_.copy("pairfinder:", true));
-    pairfinder_.setLogType(getLogType());
 
     max_num_peaks_considered_ = param_.getValue("max_num_peaks_considered");
   }
@@ -68,31 +70,49 @@ namespace OpenMS
   {
   }
 
-  void MapAlignmentAlgorithmPoseClustering::align(const FeatureMap& map, TransformationDescription& trafo)
+  void MapAlignmentAlgorithmPoseClustering::align(const FeatureMap& map, TransformationDescription& trafo) const
   {
     ConsensusMap map_scene;
     MapConversion::convert(1, map, map_scene, max_num_peaks_considered_);
-    align(map_scene, trafo);
+    alignScene_(map_scene, trafo);
   }
 
-  void MapAlignmentAlgorithmPoseClustering::align(const PeakMap& map, TransformationDescription& trafo)
+  void MapAlignmentAlgorithmPoseClustering::align(const PeakMap& map, TransformationDescription& trafo) const
   {
     ConsensusMap map_scene;
     PeakMap map2(map);
     MapConversion::convert(1, map2, map_scene, max_num_peaks_considered_); // copy MSExperiment here, since it is sorted internally by intensity
-    align(map_scene, trafo);
+    alignScene_(map_scene, trafo);
   }
 
-  void MapAlignmentAlgorithmPoseClustering::align(const ConsensusMap& map, TransformationDescription& trafo)
+  void MapAlignmentAlgorithmPoseClustering::align(const ConsensusMap& map, TransformationDescription& trafo) const
+  {
+    ConsensusMap map_scene = map;
+    alignScene_(map_scene, trafo);
+  }
+
+  void MapAlignmentAlgorithmPoseClustering::alignScene_(ConsensusMap& map_scene, TransformationDescription& trafo) const
   {
-    // TODO: move this to updateMembers_? (if ConsensusMap prevails)
     // TODO: why does superimposer work on consensus map???
     const ConsensusMap & map_model = reference_;
-    ConsensusMap map_scene = map;
+
+    // superimposer and pair finder keep state during run(), so use private
+    // instances to allow concurrent calls (progress is only logged if we are
+    // not inside a parallel region)
+    LogType log_type = getLogType();
+#ifdef _OPENMP
+    if (omp_in_parallel()) log_type = NONE;
+#endif
+    PoseClusteringAffineSuperimposer superimposer;
+    superimposer.setParameters(superimposer_.getParameters());
+    superimposer.setLogType(log_type);
+    StablePairFinder pairfinder;
+    pairfinder.setParameters(pairfinder_.getParameters());
+    pairfinder.setLogType(log_type);
 
     // run superimposer to find the global transformation
     TransformationDescription si_trafo;
-    superimposer_.run(map_model, map_scene, si_trafo);
+    superimposer.run(map_model, map_scene, si_trafo);
 
     // apply transformation to consensus features and contained feature
     // handles
@@ -112,8 +132,8 @@ namespace OpenMS
     // TODO: add another 2-map interface to pairfinder?
     std::vector<ConsensusMap> input(2);
     input[0] = map_model;
-    input[1] = map_scene;
-    pairfinder_.run(input, result);
+    input[1].swap(map_scene);
+    pairfinder.run(input, result);
 
     // calculate the local transformation
     si_trafo.invert(); // to undo the transformation applied above
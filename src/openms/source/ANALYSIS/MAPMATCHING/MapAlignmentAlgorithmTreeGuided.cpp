@@ -46,6 +46,8 @@
 
 #include <include/OpenMS/APPLICATIONS/MapAlignerBase.h>
 
+#include <exception>
+
 using namespace std;
 
 namespace OpenMS
@@ -162,15 +164,46 @@ namespace OpenMS
   // Extract RTs given for individual features of each map, calculate distances for each pair of maps and cluster hierarchical using average linkage.
   void MapAlignmentAlgorithmTreeGuided::buildTree(std::vector<FeatureMap>& feature_maps, std::vector<BinaryTreeNode>& tree,
                                                   std::vector<std::vector<double>>& maps_ranges)
+  {
+    DistanceMatrix<float> dist_matrix; // will be filled
+    buildTree(feature_maps, tree, maps_ranges, dist_matrix);
+  }
+
+  void MapAlignmentAlgorithmTreeGuided::buildTree(std::vector<FeatureMap>& feature_maps, std::vector<BinaryTreeNode>& tree,
+                                                  std::vector<std::vector<double>>& maps_ranges, DistanceMatrix<float>& dist_matrix)
   {
     vector<SeqAndRTList> maps_seq_and_rt(feature_maps.size());
     extractSeqAndRt_(feature_maps, maps_seq_and_rt, maps_ranges);
     PeptideIdentificationsPearsonDistance_ pep_dist;
     AverageLinkage al;
-    DistanceMatrix<float> dist_matrix; // will be filled
     ClusterHierarchical ch;
 
-    ch.cluster<SeqAndRTList, PeptideIdentificationsPearsonDistance_>(maps_seq_and_rt, pep_dist, al, tree, dist_matrix);
+    // keep the distances that are already known, compute the rows of all other maps
+    const Size n_maps = maps_seq_and_rt.size();
+    const Size n_known = dist_matrix.dimensionsize() <= n_maps ? dist_matrix.dimensionsize() : 0;
+    DistanceMatrix<float> known(dist_matrix);
+    dist_matrix.resize(n_maps, 1);
+    for (Size i = 1; i < n_known; ++i)
+    {
+      for (Size j = 0; j < i; ++j)
+      {
+        dist_matrix.setValueQuick(i, j, known.getValue(i, j));
+      }
+    }
+    // rows get longer with increasing index -> dynamic schedule
+#pragma omp parallel for schedule(dynamic, 1)
+    for (SignedSize i = n_known; i < static_cast<SignedSize>(n_maps); ++i)
+    {
+      for (SignedSize j = 0; j < i; ++j)
+      {
+        // distance value is 1-similarity value, since similarity is in range of [0,1]
+        dist_matrix.setValueQuick(i, j, 1 - pep_dist(maps_seq_and_rt[i], maps_seq_and_rt[j]));
+      }
+    }
+
+    // clustering merges rows of the matrix it is given, so keep the original for the caller
+    DistanceMatrix<float> cluster_matrix(dist_matrix);
+    ch.cluster<SeqAndRTList, PeptideIdentificationsPearsonDistance_>(maps_seq_and_rt, pep_dist, al, tree, cluster_matrix);
   }
 
   // Align feature maps tree guided using align() of MapAlignmentAlgorithmIdentification and use TreeNode with larger 10/90 percentile range as reference.
@@ -181,8 +214,6 @@ namespace OpenMS
                                                             std::vector<Size>& trafo_order)
   {
     Size last_trafo = 0;  // to get final transformation order from map_sets
-    vector<TransformationDescription> transformations_align;  // temporary for aligner output
-    vector<FeatureMap> to_align;
 
     // helper to memorize rt transformation order
     vector<vector<Size>> map_sets(feature_maps_transformed.size());
@@ -191,9 +222,6 @@ namespace OpenMS
       map_sets[i].push_back(i);
     }
 
-    Size ref;
-    Size to_transform;
-
     // check RT ranges of IDs
     for (size_t i = 0; i < maps_ranges.size(); ++i)
     {
@@ -202,64 +230,99 @@ namespace OpenMS
       if (maps_ranges[i].empty()) throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "FeatureMap originating from '" + ListUtils::concatenate(p, "', '") + "' contains no Peptide Identifications. Cannot align!");
     }
 
-    for (const auto& node : tree)
+    // group the tree nodes into "waves": a node can be aligned as soon as the nodes that built both of its clusters
+    // are done. Nodes of the same wave merge disjoint clusters and are independent of each other.
+    vector<Size> cluster_ready(feature_maps_transformed.size(), 0); // first wave in which a cluster can be used
+    vector<vector<Size>> waves;
+    for (Size k = 0; k < tree.size(); ++k)
     {
-      // ----------------
-      // prepare alignment
-      // ----------------
-      //  determine the map with larger RT range for 10/90 percentile (->reference)
-      double left_range = maps_ranges[node.left_child][maps_ranges[node.left_child].size()*0.9] - maps_ranges[node.left_child][maps_ranges[node.left_child].size()*0.1];
-      double right_range = maps_ranges[node.right_child][maps_ranges[node.right_child].size()*0.9] - maps_ranges[node.right_child][maps_ranges[node.right_child].size()*0.1];
-
-      if (left_range > right_range)
-      {
-        ref = node.left_child;
-        to_transform = node.right_child;
-      }
-      else
-      {
-        ref = node.right_child;
-        to_transform = node.left_child;
-      }
-
-      vector<double> tmp;
-      std::merge(maps_ranges[node.right_child].begin(), maps_ranges[node.right_child].end(), maps_ranges[node.left_child].begin(), maps_ranges[node.left_child].end(), std::back_inserter(tmp));
-
-      to_align.push_back(feature_maps_transformed[to_transform]);
-      to_align.push_back(feature_maps_transformed[ref]);
-
-      // ----------------
-      // perform alignment
-      // ----------------
-      align_algorithm_.align(to_align, transformations_align, 1);
-
-      // transform retention times of non-identity for next iteration
-      transformations_align[0].fitModel(model_type_, model_param_);
-      MapAlignmentTransformer::transformRetentionTimes(feature_maps_transformed[to_transform],
-              transformations_align[0], true);
+      const Size wave = std::max(cluster_ready[tree[k].left_child], cluster_ready[tree[k].right_child]);
+      if (waves.size() <= wave) waves.resize(wave + 1);
+      waves[wave].push_back(k);
+      cluster_ready[tree[k].left_child] = wave + 1;
+      cluster_ready[tree[k].right_child] = wave + 1;
+    }
 
-      // combine aligned maps, store at smaller index, because tree always calls smaller number
-      // clear feature map at larger index to save memory
-      feature_maps_transformed[ref] += feature_maps_transformed[to_transform];
-      feature_maps_transformed[ref].updateRanges();
-      if (ref < to_transform)
-      {
-        feature_maps_transformed[to_transform].clear(true);
-        last_trafo = ref;
-      }
-      else
+    const Param align_param = align_algorithm_.getParameters();
+    for (const vector<Size>& wave : waves)
+    {
+      std::exception_ptr align_error;
+#pragma omp parallel for schedule(dynamic, 1)
+      for (SignedSize w = 0; w < static_cast<SignedSize>(wave.size()); ++w)
       {
-        feature_maps_transformed[to_transform] = feature_maps_transformed[ref];
-        feature_maps_transformed[ref].clear(true);
-        last_trafo = to_transform;
+        try
+        {
+          const BinaryTreeNode& node = tree[wave[w]];
+          Size ref;
+          Size to_transform;
+
+          // ----------------
+          // prepare alignment
+          // ----------------
+          //  determine the map with larger RT range for 10/90 percentile (->reference)
+          double left_range = maps_ranges[node.left_child][maps_ranges[node.left_child].size()*0.9] - maps_ranges[node.left_child][maps_ranges[node.left_child].size()*0.1];
+          double right_range = maps_ranges[node.right_child][maps_ranges[node.right_child].size()*0.9] - maps_ranges[node.right_child][maps_ranges[node.right_child].size()*0.1];
+
+          if (left_range > right_range)
+          {
+            ref = node.left_child;
+            to_transform = node.right_child;
+          }
+          else
+          {
+            ref = node.right_child;
+            to_transform = node.left_child;
+          }
+
+          vector<FeatureMap> to_align;
+          to_align.push_back(feature_maps_transformed[to_transform]);
+          to_align.push_back(feature_maps_transformed[ref]);
+
+          // ----------------
+          // perform alignment
+          // ----------------
+          // the aligner keeps state between calls, so every node uses its own
+          MapAlignmentAlgorithmIdentification aligner;
+          aligner.setParameters(align_param);
+          vector<TransformationDescription> transformations_align;  // temporary for aligner output
+          aligner.align(to_align, transformations_align, 1);
+          to_align.clear();
+
+          // transform retention times of non-identity for next iteration
+          transformations_align[0].fitModel(model_type_, model_param_);
+          MapAlignmentTransformer::transformRetentionTimes(feature_maps_transformed[to_transform],
+                  transformations_align[0], true);
+
+          // combine aligned maps, store at smaller index, because tree always calls smaller number
+          // clear feature map at larger index to save memory
+          feature_maps_transformed[ref] += feature_maps_transformed[to_transform];
+          feature_maps_transformed[ref].updateRanges();
+          if (ref < to_transform)
+          {
+            feature_maps_transformed[to_transform].clear(true);
+          }
+          else
+          {
+            feature_maps_transformed[to_transform] = feature_maps_transformed[ref];
+            feature_maps_transformed[ref].clear(true);
+          }
+
+          // update order of alignment for both aligned maps
+          map_sets[ref].insert(map_sets[ref].end(), map_sets[to_transform].begin(), map_sets[to_transform].end());
+          map_sets[to_transform] = map_sets[ref];
+        }
+        catch (...)
+        {
+#pragma omp critical (MapAlignmentAlgorithmTreeGuided_error)
+          if (!align_error) align_error = std::current_exception();
+        }
       }
-
-      // update order of alignment for both aligned maps
-      map_sets[ref].insert(map_sets[ref].end(), map_sets[to_transform].begin(), map_sets[to_transform].end());
-      map_sets[to_transform] = map_sets[ref];
-
-      transformations_align.clear();
-      to_align.clear();
+      if (align_error) std::rethrow_exception(align_error);
+    }
+    if (!tree.empty())
+    {
+      // the last node merges everything (at the smaller index)
+      last_trafo = std::min(tree.back().left_child, tree.back().right_child);
     }
     // copy last transformed FeatureMap for reference return
     map_transformed = feature_maps_transformed[last_trafo];
@@ -59,26 +59,38 @@ namespace OpenMS
   {
     msexp.clearRanges();
 
-    // Transform spectra
+    // Transform spectra (RTs are collected and transformed as one batch,
+    // which is much faster for sorted input):
+    vector<double> rts;
+    rts.reserve(msexp.size());
     for (PeakMap::iterator mse_iter = msexp.begin();
          mse_iter != msexp.end(); ++mse_iter)
     {
       double rt = mse_iter->getRT();
       if (store_original_rt) storeOriginalRT_(*mse_iter, rt);
-      mse_iter->setRT(trafo.apply(rt));
+      rts.push_back(rt);
+    }
+    trafo.apply(rts);
+    for (Size i = 0; i < msexp.size(); ++i)
+    {
+      msexp[i].setRT(rts[i]);
     }
 
     // Also transform chromatograms
     for (Size i = 0; i < msexp.getNrChromatograms(); ++i)
     {
       MSChromatogram& chromatogram = msexp.getChromatogram(i);
+      rts.resize(chromatogram.size());
+      for (Size j = 0; j < chromatogram.size(); j++)
+      {
+        rts[j] = chromatogram[j].getRT();
+      }
       vector<double> original_rts;
-      if (store_original_rt) original_rts.reserve(chromatogram.size());
+      if (store_original_rt) original_rts = rts;
+      trafo.apply(rts);
       for (Size j = 0; j < chromatogram.size(); j++)
       {
-        double rt = chromatogram[j].getRT();
-        if (store_original_rt) original_rts.push_back(rt);
-        chromatogram[j].setRT(trafo.apply(rt));
+        chromatogram[j].setRT(rts[j]);
       }
       if (store_original_rt && !chromatogram.metaValueExists("original_rt"))
       {
@@ -83,6 +83,15 @@ namespace OpenMS
                                            "The minimal scaling is the reciprocal of this.", ListUtils::create<String>("advanced"));
     defaults_.setMinFloat("max_scaling", 1.);
 
+    defaults_.setValue("coarse_to_fine:num_used_points", 0, "If positive, the transformation is first estimated by pose clustering on only this many elements per map (the most intense ones), "
+                                                              "then refined using all 'num_used_points' elements.  The refinement only considers element pairs that agree with the first estimate "
+                                                              "within 'coarse_to_fine:rt_tol' and runs in time linear in the number of elements, so much larger values of 'num_used_points' become affordable.  "
+                                                              "Set to 0 to disable.", ListUtils::create<String>("advanced"));
+    defaults_.setMinInt("coarse_to_fine:num_used_points", 0);
+    defaults_.setValue("coarse_to_fine:rt_tol", 30.0, "Maximal RT deviation (in seconds) from the coarse estimate for element pairs used in the refinement.", ListUtils::create<String>("advanced"));
+    defaults_.setMinFloat("coarse_to_fine:rt_tol", 0.);
+    defaults_.setSectionDescription("coarse_to_fine", "Two-stage (coarse-to-fine) estimation for large numbers of elements");
+
     defaults_.setValue("dump_buckets", "", "[DEBUG] If non-empty, base filename where hash table buckets will be dumped to.  "
                                            "A serial number for each invocation will be appended automatically.", ListUtils::create<String>("advanced"));
 
@@ -732,6 +741,115 @@ namespace OpenMS
     return total_int_model_map / total_int_scene_map;
   }
 
+  /**
+    @brief Refines an affine transformation (model RT = slope * scene RT + intercept) using all elements.
+
+    For every element of the model map, the best matching element of the
+    scene map (within @p mz_pair_max_distance and @p rt_tol of the current
+    estimate) is selected.  A line is fitted to these pairs by weighted least
+    squares (weighted by intensity similarity), followed by iterative removal
+    of outliers.  Both maps need to be sorted by m/z.  The running time is
+    linear in the number of elements (times the number of elements per m/z
+    window).
+
+    If there are too few pairs, the estimate is left unchanged.
+  */
+  void refineAffineTransformation(const std::vector<Peak2D> & model_map,
+                                  const std::vector<Peak2D> & scene_map,
+                                  const double mz_pair_max_distance,
+                                  const double rt_tol,
+                                  const double total_intensity_ratio,
+                                  const double cutoff_stdev_multiplier,
+                                  const UInt loops_cutoff,
+                                  double& slope,
+                                  double& intercept)
+  {
+    struct Pair
+    {
+      double x, y, weight;
+    };
+    std::vector<Pair> pairs;
+    pairs.reserve(model_map.size());
+    for (Size i = 0, k_low = 0, k_high = 0; i < model_map.size(); ++i)
+    {
+      const double mz = model_map[i].getMZ();
+      while (k_low < scene_map.size() && scene_map[k_low].getMZ() < mz - mz_pair_max_distance)
+        ++k_low;
+      if (k_high < k_low)
+        k_high = k_low;
+      while (k_high < scene_map.size() && scene_map[k_high].getMZ() <= mz + mz_pair_max_distance)
+        ++k_high;
+
+      // scene element closest to the estimated position of model element i
+      double best_deviation = rt_tol;
+      Size best_k = k_high;
+      for (Size k = k_low; k < k_high; ++k)
+      {
+        const double deviation = std::fabs(model_map[i].getRT() - (slope * scene_map[k].getRT() + intercept));
+        if (deviation <= best_deviation)
+        {
+          best_deviation = deviation;
+          best_k = k;
+        }
+      }
+      if (best_k == k_high)
+        continue;
+
+      const double int_i = model_map[i].getIntensity();
+      const double int_k = scene_map[best_k].getIntensity() * total_intensity_ratio;
+      const double similarity = (int_i < int_k) ? int_i / int_k : int_k / int_i;
+      if (!(similarity > 0))
+        continue;
+      Pair pair = { scene_map[best_k].getRT(), model_map[i].getRT(), similarity };
+      pairs.push_back(pair);
+    }
+
+    // too few pairs for a reliable fit
+    const Size min_pairs = 10;
+    for (UInt loop = 0; loop <= loops_cutoff && pairs.size() >= min_pairs; ++loop)
+    {
+      double sw = 0, sx = 0, sy = 0, sxx = 0, sxy = 0;
+      for (const Pair& pair : pairs)
+      {
+        sw += pair.weight;
+        sx += pair.weight * pair.x;
+        sy += pair.weight * pair.y;
+        sxx += pair.weight * pair.x * pair.x;
+        sxy += pair.weight * pair.x * pair.y;
+      }
+      const double denominator = sw * sxx - sx * sx;
+      if (!(std::fabs(denominator) > std::numeric_limits<double>::epsilon() * sw * sxx))
+        return; // all pairs at the same RT
+      const double new_slope = (sw * sxy - sx * sy) / denominator;
+      const double new_intercept = (sy - new_slope * sx) / sw;
+      if (boost::math::isinf(new_slope) || boost::math::isnan(new_slope) || boost::math::isinf(new_intercept) || boost::math::isnan(new_intercept))
+        return;
+      slope = new_slope;
+      intercept = new_intercept;
+      if (loop == loops_cutoff)
+        break;
+
+      // remove outliers based on the weighted standard deviation of the residuals
+      double squared_residuals = 0;
+      for (const Pair& pair : pairs)
+      {
+        const double residual = pair.y - (slope * pair.x + intercept);
+        squared_residuals += pair.weight * residual * residual;
+      }
+      const double cutoff = cutoff_stdev_multiplier * std::sqrt(squared_residuals / sw);
+      std::vector<Pair> inliers;
+      inliers.reserve(pairs.size());
+      for (const Pair& pair : pairs)
+      {
+        if (std::fabs(pair.y - (slope * pair.x + intercept)) <= cutoff)
+          inliers.push_back(pair);
+      }
+      if (inliers.size() == pairs.size())
+        break;
+      pairs.swap(inliers);
+    }
+  }
+
   void PoseClusteringAffineSuperimposer::run(const std::vector<Peak2D> & map_model,
                                              const std::vector<Peak2D> & map_scene, 
                                              TransformationDescription & transformation)
@@ -830,6 +948,27 @@ namespace OpenMS
     // sort by ascending m/z
     std::sort(model_map.begin(), model_map.end(), Peak2D::MZLess());
     std::sort(scene_map.begin(), scene_map.end(), Peak2D::MZLess());
+
+    // coarse-to-fine: pose clustering uses only the most abundant points, all
+    // points are used for refining its estimate afterwards (Step 6)
+    const Size num_coarse_points = (Int) param_.getValue("coarse_to_fine:num_used_points");
+    const bool refine = num_coarse_points > 0 && (model_map.size() > num_coarse_points || scene_map.size() > num_coarse_points);
+    std::vector<Peak2D> refine_model_map, refine_scene_map;
+    if (refine)
+    {
+      refine_model_map = model_map;
+      refine_scene_map = scene_map;
+      for (std::vector<Peak2D>* map : {&model_map, &scene_map})
+      {
+        if (map->size() > num_coarse_points)
+        {
+          std::nth_element(map->begin(), map->begin() + num_coarse_points, map->end(),
+                           [](const Peak2D& a, const Peak2D& b) { return a.getIntensity() > b.getIntensity(); });
+          map->resize(num_coarse_points);
+          std::sort(map->begin(), map->end(), Peak2D::MZLess());
+        }
+      }
+    }
     setProgress((actual_progress = 10));
 
     //**************************************************************************
@@ -1028,10 +1167,24 @@ namespace OpenMS
     // 5.2 compute slope and intercept from matching high/low retention times
     {
       Param params;
-      const double slope = ((rt_high_image - rt_low_image) / (rt_high - rt_low));
-      params.setValue("slope", slope);
+      double slope = ((rt_high_image - rt_low_image) / (rt_high - rt_low));
+      double intercept = rt_low_image - rt_low * slope;
 
-      const double intercept = rt_low_image - rt_low * slope;
+      //************************************************************************
+      // Step 6 (optional): Refine the coarse estimate using all points
+      //************************************************************************
+      if (refine && !(boost::math::isinf(slope) || boost::math::isnan(slope) || boost::math::isinf(intercept) || boost::math::isnan(intercept)))
+      {
+        refineAffineTransformation(refine_model_map, refine_scene_map,
+                                   mz_pair_max_distance,
+                                   param_.getValue("coarse_to_fine:rt_tol"),
+                                   computeIntensityRatio(refine_model_map, refine_scene_map),
+                                   scaling_cutoff_stdev_multiplier,
+                                   loops_mean_stdev_cutoff,
+                                   slope, intercept);
+      }
+
+      params.setValue("slope", slope);
       params.setValue("intercept", intercept);
 
       if (boost::math::isinf(slope) || boost::math::isnan(slope) || boost::math::isinf(intercept) || boost::math::isnan(intercept))
@@ -37,17 +37,34 @@
 #include <OpenMS/METADATA/PeptideIdentification.h>
 #include <OpenMS/KERNEL/FeatureHandle.h>
 
+#include <algorithm>
+
 // #define DEBUG_QTCLUSTERFINDER
 
 using std::list;
 using std::vector;
 using std::max;
 using std::make_pair;
-using std::unordered_set;
 
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// adds a cluster id to the ids of a feature in the element mapping (unless it is there already)
+    void addClusterId_(vector<Size>& ids, Size id)
+    {
+      if (std::find(ids.begin(), ids.end(), id) == ids.end()) ids.push_back(id);
+    }
+
+    /// removes a cluster id from the ids of a feature in the element mapping
+    void removeClusterId_(vector<Size>& ids, Size id)
+    {
+      vector<Size>::iterator pos = std::find(ids.begin(), ids.end(), id);
+      if (pos != ids.end()) ids.erase(pos);
+    }
+  }
+
   QTClusterFinder::QTClusterFinder() :
     BaseGroupFinder(), feature_distance_(FeatureDistance())
   {
@@ -55,7 +72,7 @@ namespace OpenMS
 
     defaults_.setValue("use_identifications", "false", "Never link features that are annotated with different peptides (only the best hit per peptide identification is taken into account).");
     defaults_.setValidStrings("use_identifications", ListUtils::create<String>("true,false"));
-    defaults_.setValue("nr_partitions", 100, "How many partitions in m/z space should be used for the algorithm (more partitions means faster runtime and more memory efficient execution )");
+    defaults_.setValue("nr_partitions", 100, "How many partitions in m/z space should be used for the algorithm (more partitions means faster runtime and more memory efficient execution; partitions are processed in parallel)");
     defaults_.setMinInt("nr_partitions", 1);
 
 
@@ -120,6 +137,13 @@ namespace OpenMS
     }
     else
     {
+      // checked here, as exceptions cannot leave the parallel loop below
+      if (input_maps.size() < 2)
+      {
+        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+                                         "At least two input maps required");
+      }
+
       // partition at boundaries -> this should be safe because there cannot be
       // any cluster reaching across boundaries
 
@@ -156,7 +180,15 @@ namespace OpenMS
       Size progress = 0;
       logger.setLogType(ProgressLogger::CMD);
       logger.startProgress(0, partition_boundaries.size(), "Linking features");
-      for (size_t j = 0; j < partition_boundaries.size()-1; j++)
+
+      // partitions are independent: cluster them in parallel (every thread
+      // uses its own finder, since the clustering state is kept in members)
+      // and append the results in partition order afterwards
+      const SignedSize nr_partitions = partition_boundaries.size() - 1;
+      vector<ConsensusMap> partition_results(nr_partitions);
+      const Param parameters = param_;
+#pragma omp parallel for schedule(dynamic, 1)
+      for (SignedSize j = 0; j < nr_partitions; j++)
       {
         double partition_start = partition_boundaries[j];
         double partition_end = partition_boundaries[j+1];
@@ -179,10 +211,22 @@ namespace OpenMS
         }
 
         // run algo on current partition
-        run_internal_(tmp_input_maps, result_map, false);
+        QTClusterFinder partition_finder;
+        partition_finder.setParameters(parameters);
+        partition_finder.run_internal_(tmp_input_maps, partition_results[j], false);
+#pragma omp critical (QTClusterFinder_progress)
         logger.setProgress(progress++);
       }
 
+      for (ConsensusMap& partition_result : partition_results)
+      {
+        for (ConsensusFeature& feature : partition_result)
+        {
+          result_map.push_back(std::move(feature));
+        }
+        partition_result.clear(true);
+      }
+
       logger.endProgress();
     }
   }
@@ -213,6 +257,15 @@ namespace OpenMS
     }
     setParameters_(max_intensity, max_mz);
 
+    // positions of the features of each map in the element mapping
+    map_offsets_.assign(num_maps_, 0);
+    Size num_features = 0;
+    for (Size map_index = 0; map_index < num_maps_; ++map_index)
+    {
+      map_offsets_[map_index] = num_features;
+      num_features += input_maps[map_index].size();
+    }
+
     // create the hash grid and fill it with features:
     // std::cout << "Hashing..." << std::endl;
     list<OpenMS::GridFeature> grid_features;
@@ -252,7 +305,7 @@ namespace OpenMS
     vector<QTCluster::BulkData> cluster_data;
 
     // map to get ids from clusters, who contain a certain grid feature
-    ElementMapping element_mapping;
+    ElementMapping element_mapping(num_features);
 
     computeClustering_(grid, cluster_heads, cluster_data, handles, element_mapping);
 
@@ -341,7 +394,7 @@ namespace OpenMS
     Size id = cluster.getId();
     for (const auto& element : cluster.getElements())
     {
-      element_mapping[element.feature].erase(id);
+      removeClusterId_(element_mapping[elementIndex_(element.feature)], id);
     }
   }
 
@@ -356,7 +409,7 @@ void QTClusterFinder::createConsensusFeature_(ConsensusFeature& feature,
     {
       // Store the id of already used features (important: needs to be done
       // before updateClustering()) (not to be confused with the cluster id)
-      already_used_.insert(element.feature);
+      already_used_[elementIndex_(element.feature)] = true;
 
       BaseFeature& elem_feat = const_cast<BaseFeature&>(element.feature->getFeature());
       feature.insert(element.map_index, elem_feat);
@@ -381,16 +434,17 @@ void QTClusterFinder::createConsensusFeature_(ConsensusFeature& feature,
       const GridFeature* const curr_feature = element.feature;
 
       // ids of clusters the current feature belonged to
-      unordered_set<Size>& cluster_ids = element_mapping[curr_feature];
+      vector<Size>& cluster_ids = element_mapping[elementIndex_(curr_feature)];
 
       // delete the id of the current best cluster
       // we do not want to unnecessarily update it in the loop below
-      cluster_ids.erase(best_id);
+      removeClusterId_(cluster_ids, best_id);
 
       // Identify all features that could potentially have been touched by this
       // Get all clusters that may potentially need updating
 
-      ElementMapping tmp_element_mapping; // modify copy, then update
+      // (element index, cluster id) pairs: modify copy, then update
+      vector<std::pair<Size, Size> > tmp_element_mapping;
 
       for (const Size curr_id : cluster_ids)
       {
@@ -439,7 +493,7 @@ void QTClusterFinder::createConsensusFeature_(ConsensusFeature& feature,
 
             for (const auto& neighbor : cluster.getElements())
             {
-              tmp_element_mapping[neighbor.feature].insert(curr_id);
+              tmp_element_mapping.emplace_back(elementIndex_(neighbor.feature), curr_id);
             }
           }
         }
@@ -448,12 +502,9 @@ void QTClusterFinder::createConsensusFeature_(ConsensusFeature& feature,
       // we merge the tmp_element_mapping into the element_mapping after all clusters
       // that contained one feature of the current best cluster have been updated,
       // i.e. after every iteration of the outer loop
-      for (const auto& cluster_ids: tmp_element_mapping)
+      for (const auto& entry : tmp_element_mapping)
       {
-        for (const Size id : cluster_ids.second)
-        {
-          element_mapping[cluster_ids.first].insert(id);
-        }
+        addClusterId_(element_mapping[entry.first], entry.second);
       }
     }
 
@@ -498,7 +549,7 @@ void QTClusterFinder::createConsensusFeature_(ConsensusFeature& feature,
 
             // Skip features that we have already used -> we cannot add them to
             // be neighbors any more
-            if (already_used_.find(neighbor_feature) != already_used_.end() )
+            if (already_used_[elementIndex_(neighbor_feature)])
             {
               continue;
             }
@@ -562,7 +613,7 @@ void QTClusterFinder::createConsensusFeature_(ConsensusFeature& feature,
                                            ElementMapping& element_mapping)
   {
     cluster_heads.clear();
-    already_used_.clear();
+    already_used_.assign(element_mapping.size(), false);
     cluster_data.clear();
     handles.clear();
 
@@ -602,7 +653,7 @@ void QTClusterFinder::createConsensusFeature_(ConsensusFeature& feature,
       // register the new cluster for all its elements in the element mapping
       for (const auto& element : (*handles.back()).getElements())
       {
-        element_mapping[element.feature].insert(id);
+        addClusterId_(element_mapping[elementIndex_(element.feature)], id);
       }
 
       // next cluster gets the next id
@@ -610,6 +661,11 @@ void QTClusterFinder::createConsensusFeature_(ConsensusFeature& feature,
     }
   }
 
+  Size QTClusterFinder::elementIndex_(const OpenMS::GridFeature* feature) const
+  {
+    return map_offsets_[feature->getMapIndex()] + feature->getFeatureIndex();
+  }
+
   double QTClusterFinder::getDistance_(const OpenMS::GridFeature* left,
                                        const OpenMS::GridFeature* right)
   {
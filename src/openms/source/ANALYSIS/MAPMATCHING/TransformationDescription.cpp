@@ -133,6 +133,11 @@ namespace OpenMS
     return model_->evaluate(value);
   }
 
+  void TransformationDescription::apply(std::vector<double>& values) const
+  {
+    model_->evaluateBatch(values);
+  }
+
   const String& TransformationDescription::getModelType() const
   {
     return model_type_;
@@ -83,6 +83,14 @@ namespace OpenMS
   {
   }
 
+  void TransformationModel::evaluateBatch(std::vector<double>& values) const
+  {
+    for (double& value : values)
+    {
+      value = evaluate(value);
+    }
+  }
+
   double TransformationModel::evaluate(double value) const
   {
     return value;
@@ -37,6 +37,7 @@
 // Spline2dInterpolator
 #include <OpenMS/MATH/MISC/CubicSpline2d.h>
 
+#include <algorithm>
 #include <numeric>
 
 // AkimaInterpolator
@@ -163,6 +164,28 @@ public:
       }
     }
 
+    void evalSorted(std::vector<double>::iterator first, std::vector<double>::iterator last) const override
+    {
+      // same as eval(), but the segment search continues where the previous value was found
+      Size idx = 1;
+      for (; first != last; ++first)
+      {
+        const double x = *first;
+        while (idx < x_.size() && x_[idx] <= x)
+        {
+          ++idx;
+        }
+        if (idx == x_.size())
+        {
+          *first = y_.back();
+        }
+        else
+        {
+          *first = y_[idx - 1] + (y_[idx] - y_[idx - 1]) * (x - x_[idx - 1]) / (x_[idx] - x_[idx - 1]);
+        }
+      }
+    }
+
     ~LinearInterpolator() override
     {
     }
@@ -418,6 +441,27 @@ private:
     return interp_->eval(value);
   }
 
+  void TransformationModelInterpolated::evaluateBatch(std::vector<double>& values) const
+  {
+    if (!std::is_sorted(values.begin(), values.end()))
+    {
+      TransformationModel::evaluateBatch(values);
+      return;
+    }
+    // split into [front extrapolation | interpolation | back extrapolation]:
+    std::vector<double>::iterator inner_begin = std::lower_bound(values.begin(), values.end(), x_.front());
+    std::vector<double>::iterator inner_end = std::upper_bound(inner_begin, values.end(), x_.back());
+    for (std::vector<double>::iterator it = values.begin(); it != inner_begin; ++it)
+    {
+      *it = lm_front_->evaluate(*it);
+    }
+    interp_->evalSorted(inner_begin, inner_end);
+    for (std::vector<double>::iterator it = inner_end; it != values.end(); ++it)
+    {
+      *it = lm_back_->evaluate(*it);
+    }
+  }
+
   void TransformationModelInterpolated::getDefaultParameters(Param& params)
   {
     params.clear();
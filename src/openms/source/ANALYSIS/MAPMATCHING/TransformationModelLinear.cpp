@@ -110,6 +110,21 @@ namespace OpenMS
     return eval;
   }
 
+  void TransformationModelLinear::evaluateBatch(std::vector<double>& values) const
+  {
+    if (weighting_)
+    {
+      TransformationModel::evaluateBatch(values);
+      return;
+    }
+    // plain loop without branches, so the compiler can vectorize it
+    const double slope = slope_, intercept = intercept_;
+    for (double& value : values)
+    {
+      value = slope * value + intercept;
+    }
+  }
+
   void TransformationModelLinear::invert()
   {
     if (slope_ == 0)
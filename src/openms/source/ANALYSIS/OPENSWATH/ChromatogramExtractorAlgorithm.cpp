@@ -34,14 +34,40 @@
 
 #include <OpenMS/ANALYSIS/OPENSWATH/ChromatogramExtractorAlgorithm.h>
 
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessIonMobilityIndexed.h>
+
 #include <OpenMS/DATASTRUCTURES/String.h>
 
 #include <OpenMS/CONCEPT/Exception.h>
+
+#include <algorithm>
 #include <iostream>
 
 namespace OpenMS
 {
 
+  namespace
+  {
+    /// Index of the first element at or after @p first for which before(data[i], value) is false.
+    /// Searches exponentially from @p first since consecutive bounds are usually close together.
+    template <typename Compare>
+    inline Size gallopFrom_(const double* data, Size first, Size n, double value, Compare before)
+    {
+      if (first >= n || !before(data[first], value)) return first;
+
+      Size prev = first; // before(data[prev], value) holds
+      Size step = 1;
+      while (first + step < n && before(data[first + step], value))
+      {
+        prev = first + step;
+        step *= 2;
+      }
+      const Size last = std::min(first + step, n);
+      return std::partition_point(data + prev + 1, data + last,
+          [&](double x) { return before(x, value); }) - data;
+    }
+  }
+
   void ChromatogramExtractorAlgorithm::extract_value_tophat(
       const std::vector<double>::const_iterator& mz_start,
             std::vector<double>::const_iterator& mz_it,
@@ -267,6 +293,36 @@ namespace OpenMS
     }
   }
 
+  void ChromatogramExtractorAlgorithm::extract_values_tophat(
+      const std::vector<double>& mz_array,
+      const std::vector<double>& int_array,
+      const std::vector<double>& left,
+      const std::vector<double>& right,
+      std::vector<double>& integrated_intensities)
+  {
+    integrated_intensities.assign(left.size(), 0.0);
+
+    const Size n = mz_array.size();
+    const double* mz = mz_array.data();
+    const double* intensity = int_array.data();
+
+    // both bounds move monotonically through the spectrum
+    Size lo = 0;
+    Size hi = 0;
+    for (Size k = 0; k < left.size(); ++k)
+    {
+      lo = gallopFrom_(mz, lo, n, left[k], [](double x, double v) { return x <= v; }); // first m/z > left
+      hi = gallopFrom_(mz, std::max(lo, hi), n, right[k], [](double x, double v) { return x < v; }); // first m/z >= right
+
+      double integrated_intensity = 0.0;
+      for (Size i = lo; i < hi; ++i)
+      {
+        integrated_intensity += intensity[i];
+      }
+      integrated_intensities[k] = integrated_intensity;
+    }
+  }
+
   void ChromatogramExtractorAlgorithm::extractChromatograms(const OpenSwath::SpectrumAccessPtr input,
       std::vector< OpenSwath::ChromatogramPtr >& output,
       const std::vector<ExtractionCoordinates>& extraction_coordinates,
@@ -296,6 +352,27 @@ namespace OpenMS
         "Input to extractChromatogram needs to be sorted by m/z");
     }
 
+    // compute the extraction windows once (they are sorted since the coordinates are)
+    std::vector<double> left(extraction_coordinates.size()), right(extraction_coordinates.size());
+    for (Size k = 0; k < extraction_coordinates.size(); ++k)
+    {
+      const double mz = extraction_coordinates[k].mz;
+      if (ppm)
+      {
+        left[k]  = mz - mz * mz_extraction_window / 2.0 * 1.0e-6;
+        right[k] = mz + mz * mz_extraction_window / 2.0 * 1.0e-6;
+      }
+      else
+      {
+        left[k]  = mz - mz_extraction_window / 2.0;
+        right[k] = mz + mz_extraction_window / 2.0;
+      }
+    }
+    std::vector<double> integrated_intensities;
+
+    // an ion mobility index allows us to only look at the relevant ion mobility slice of each frame
+    const SpectrumAccessIonMobilityIndexed* im_indexed_input = dynamic_cast<const SpectrumAccessIonMobilityIndexed*>(input.get());
+
     //go through all spectra
     startProgress(0, input_size, "Extracting chromatograms");
     for (Size scan_idx = 0; scan_idx < input_size; ++scan_idx)
@@ -334,6 +411,32 @@ namespace OpenMS
         }
       }
 
+      // without ion mobility, extract all windows in a single pass over the spectrum
+      if (!has_im && used_filter == 1)
+      {
+        extract_values_tophat(mz_arr->data, int_arr->data, left, right, integrated_intensities);
+
+        const double current_rt = s_meta.RT;
+        for (Size k = 0; k < extraction_coordinates.size(); ++k)
+        {
+          if (extraction_coordinates[k].rt_end - extraction_coordinates[k].rt_start > 0 &&
+               (current_rt < extraction_coordinates[k].rt_start ||
+                current_rt > extraction_coordinates[k].rt_end) )
+          {
+            continue;
+          }
+          output[k]->getTimeArray()->data.push_back(current_rt);
+          output[k]->getIntensityArray()->data.push_back(integrated_intensities[k]);
+        }
+        continue;
+      }
+
+      SpectrumAccessIonMobilityIndexed::FrameIndexPtr frame_index;
+      if (has_im && im_indexed_input != nullptr)
+      {
+        frame_index = im_indexed_input->getFrameIndex(scan_idx);
+      }
+
       // go through all transitions / chromatograms which are sorted by
       // ProductMZ. We can use this to step through the spectrum and at the
       // same time step through the transitions. We increase the peak counter
@@ -361,9 +464,18 @@ namespace OpenMS
           {
             std::cerr << "WARNING : Drift time of ion is negative!" << std::endl;
           }
-          extract_value_tophat(mz_start, mz_it, mz_end, int_it, im_it,
-                               extraction_coordinates[k].mz, extraction_coordinates[k].ion_mobility,
-                               integrated_intensity, mz_extraction_window, im_extraction_window, ppm);
+          if (frame_index)
+          {
+            const double im = extraction_coordinates[k].ion_mobility;
+            integrated_intensity = frame_index->integrate(left[k], right[k],
+                                                          im - im_extraction_window / 2.0, im + im_extraction_window / 2.0);
+          }
+          else
+          {
+            extract_value_tophat(mz_start, mz_it, mz_end, int_it, im_it,
+                                 extraction_coordinates[k].mz, extraction_coordinates[k].ion_mobility,
+                                 integrated_intensity, mz_extraction_window, im_extraction_window, ppm);
+          }
         }
         else if (used_filter == 2)
         {
@@ -0,0 +1,145 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessIonMobilityIndexed.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+
+#include <cmath>
+
+namespace OpenMS
+{
+
+  SpectrumAccessIonMobilityIndexed::FrameIndex::FrameIndex(const OpenSwath::Spectrum& frame, Size nr_buckets) :
+    im_min_(0.0),
+    bucket_width_(1.0),
+    bucket_start_(std::max(nr_buckets, Size(1)) + 1, 0)
+  {
+    OpenSwath::BinaryDataArrayPtr im_arr = frame.getDriftTimeArray();
+    if (im_arr == nullptr)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "Cannot create an ion mobility index for a spectrum without ion mobility array.");
+    }
+    const std::vector<double>& mz = frame.getMZArray()->data;
+    const std::vector<double>& intensity = frame.getIntensityArray()->data;
+    const std::vector<double>& im = im_arr->data;
+    if (mz.empty()) return;
+
+    auto im_range = std::minmax_element(im.begin(), im.end());
+    im_min_ = *im_range.first;
+    double im_range_width = *im_range.second - *im_range.first;
+    if (im_range_width > 0.0) bucket_width_ = im_range_width / getNrBuckets();
+
+    // counting sort by bucket: the input is sorted by m/z and a stable
+    // distribution keeps each bucket sorted by m/z
+    std::vector<Size> peak_bucket(mz.size());
+    for (Size k = 0; k < mz.size(); ++k)
+    {
+      peak_bucket[k] = bucketIndex_(im[k]);
+      ++bucket_start_[peak_bucket[k] + 1];
+    }
+    for (Size b = 1; b < bucket_start_.size(); ++b)
+    {
+      bucket_start_[b] += bucket_start_[b - 1];
+    }
+
+    mz_.resize(mz.size());
+    im_.resize(mz.size());
+    intensity_.resize(mz.size());
+    std::vector<Size> insert_pos(bucket_start_.begin(), bucket_start_.end() - 1);
+    for (Size k = 0; k < mz.size(); ++k)
+    {
+      Size pos = insert_pos[peak_bucket[k]]++;
+      mz_[pos] = mz[k];
+      im_[pos] = im[k];
+      intensity_[pos] = intensity[k];
+    }
+  }
+
+  Size SpectrumAccessIonMobilityIndexed::FrameIndex::bucketIndex_(double im) const
+  {
+    double b = std::floor((im - im_min_) / bucket_width_);
+    if (b <= 0.0) return 0;
+    return std::min(Size(b), getNrBuckets() - 1);
+  }
+
+  double SpectrumAccessIonMobilityIndexed::FrameIndex::integrate(double left, double right, double left_im, double right_im) const
+  {
+    double integrated_intensity = 0.0;
+    forEachPeak(left, right, left_im, right_im,
+      [&](double mz, double im, double intensity)
+      {
+        if (mz > left && mz < right && im > left_im && im < right_im) integrated_intensity += intensity;
+      });
+    return integrated_intensity;
+  }
+
+  SpectrumAccessIonMobilityIndexed::SpectrumAccessIonMobilityIndexed(OpenSwath::ISpectrumAccess & origin, Size nr_buckets) :
+    SpectrumAccessOpenMSInMemory(origin)
+  {
+    frame_indices_.resize(getNrSpectra());
+    for (Size i = 0; i < getNrSpectra(); ++i)
+    {
+      OpenSwath::SpectrumPtr sptr = getSpectrumById(i);
+      if (sptr->getDriftTimeArray() != nullptr)
+      {
+        frame_indices_[i] = FrameIndexPtr(new FrameIndex(*sptr, nr_buckets));
+      }
+    }
+  }
+
+  SpectrumAccessIonMobilityIndexed::~SpectrumAccessIonMobilityIndexed() {}
+
+  SpectrumAccessIonMobilityIndexed::SpectrumAccessIonMobilityIndexed(const SpectrumAccessIonMobilityIndexed & rhs) :
+    SpectrumAccessOpenMSInMemory(rhs),
+    frame_indices_(rhs.frame_indices_)
+  {
+    // this only copies the pointers and not the actual data ...
+  }
+
+  boost::shared_ptr<OpenSwath::ISpectrumAccess> SpectrumAccessIonMobilityIndexed::lightClone() const
+  {
+    return boost::shared_ptr<SpectrumAccessIonMobilityIndexed>(new SpectrumAccessIonMobilityIndexed(*this));
+  }
+
+  SpectrumAccessIonMobilityIndexed::FrameIndexPtr SpectrumAccessIonMobilityIndexed::getFrameIndex(int id) const
+  {
+    OPENMS_PRECONDITION(id >= 0, "Id needs to be larger than zero");
+    OPENMS_PRECONDITION(id < (int)getNrSpectra(), "Id cannot be larger than number of spectra");
+    return frame_indices_[id];
+  }
+
+} //end namespace OpenMS
@@ -45,6 +45,13 @@ namespace OpenMS
   {
   }
 
+  SpectrumAccessOpenMSCached::SpectrumAccessOpenMSCached(const String& filename, MSExperimentType meta_data,
+                                                         const std::vector<std::streampos>& spectra_index,
+                                                         const std::vector<std::streampos>& chrom_index)
+  {
+    load_(filename, std::move(meta_data), spectra_index, chrom_index);
+  }
+
   SpectrumAccessOpenMSCached::~SpectrumAccessOpenMSCached()
   {
   }
@@ -68,16 +75,18 @@ namespace OpenMS
     int ms_level = -1;
     double rt = -1.0;
 
-    if ( !ifs_.seekg(spectra_index_[id]) )
+    OpenSwath::SpectrumPtr sptr(new OpenSwath::Spectrum);
+    if (mapped_file_)
     {
-      std::cerr << "Error while reading spectrum " << id << " - seekg created an error when trying to change position to " << spectra_index_[id] << "." << std::endl;
-      std::cerr << "Maybe an invalid position was supplied to seekg, this can happen for example when reading large files (>2GB) on 32bit systems." << std::endl;
-      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-        "Error while changing position of input stream pointer.", filename_cached_);
+      Size available;
+      const char* data = mappedData_(spectra_index_[id], available);
+      sptr->getDataArrays() = Internal::CachedMzMLHandler::readSpectrumFast(data, available, ms_level, rt);
+    }
+    else
+    {
+      seekFileStream_(spectra_index_[id], id, "spectrum");
+      sptr->getDataArrays() = Internal::CachedMzMLHandler::readSpectrumFast(ifs_, ms_level, rt);
     }
-
-    OpenSwath::SpectrumPtr sptr(new OpenSwath::Spectrum);
-    sptr->getDataArrays() = Internal::CachedMzMLHandler::readSpectrumFast(ifs_, ms_level, rt);
 
     return sptr;
   }
@@ -98,16 +107,18 @@ namespace OpenMS
     OPENMS_PRECONDITION(id >= 0, "Id needs to be larger than zero");
     OPENMS_PRECONDITION(id < (int)getNrChromatograms(), "Id cannot be larger than number of chromatograms");
 
-    if ( !ifs_.seekg(chrom_index_[id]) )
+    OpenSwath::ChromatogramPtr cptr(new OpenSwath::Chromatogram);
+    if (mapped_file_)
     {
-      std::cerr << "Error while reading chromatogram " << id << " - seekg created an error when trying to change position to " << chrom_index_[id] << "." << std::endl;
-      std::cerr << "Maybe an invalid position was supplied to seekg, this can happen for example when reading large files (>2GB) on 32bit systems." << std::endl;
-      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-        "Error while changing position of input stream pointer.", filename_cached_);
+      Size available;
+      const char* data = mappedData_(chrom_index_[id], available);
+      cptr->getDataArrays() = Internal::CachedMzMLHandler::readChromatogramFast(data, available);
+    }
+    else
+    {
+      seekFileStream_(chrom_index_[id], id, "chromatogram");
+      cptr->getDataArrays() = Internal::CachedMzMLHandler::readChromatogramFast(ifs_);
     }
-
-    OpenSwath::ChromatogramPtr cptr(new OpenSwath::Chromatogram);
-    cptr->getDataArrays() = Internal::CachedMzMLHandler::readChromatogramFast(ifs_);
     return cptr;
   }
 
@@ -38,7 +38,10 @@
 #include <OpenMS/OPENSWATHALGO/ALGO/StatsHelpers.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DIAHelper.h>
 
+#include <exception>
 #include <iostream>
+#include <limits>
+#include <numeric>
 
 namespace OpenMS
 {
@@ -82,100 +85,178 @@ namespace OpenMS
     OpenSwath::TransitionHelper::convert(transition_exp_used, transmap);
     // std::cout << "nr peptides : " << transmap.size() << std::endl;
 
-    Mmap::iterator m_begin = transmap.begin();
-    Mmap::iterator m_end = transmap.end();
+    // the theoretical spectra only depend on the transition groups, compute them once
+    const Size nr_groups = transmap.size();
     std::vector<std::string> transitionsNames;
+    std::vector<TheoreticalSpectrum> theo(nr_groups);
+    // m/z range covered by the integration windows of each transition group
+    std::vector<std::pair<double, double> > ranges(nr_groups,
+      std::make_pair(std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest()));
+    Size g = 0;
+    for (Mmap::const_iterator m_it = transmap.begin(); m_it != transmap.end(); ++m_it, ++g)
+    {
+      transitionsNames.push_back(m_it->first);
+      computeTheoreticalSpectrum(m_it->second, theo[g]);
+      if (!theo[g].masses.empty())
+      {
+        ranges[g] = std::make_pair(theo[g].masses.front() - dia_extract_window_ / 2.0,
+                                   theo[g].masses.back() + dia_extract_window_ / 2.0);
+      }
+    }
 
-    for (; m_begin != m_end; ++m_begin)
+    // transition groups sorted by the lower end of their m/z range
+    std::vector<Size> by_lower(nr_groups);
+    std::iota(by_lower.begin(), by_lower.end(), 0);
+    std::sort(by_lower.begin(), by_lower.end(),
+      [&ranges](Size a, Size b) { return ranges[a].first < ranges[b].first; });
+    std::vector<double> sorted_lower;
+    sorted_lower.reserve(nr_groups);
+    for (Size k : by_lower)
     {
-      transitionsNames.push_back(m_begin->first);
+      sorted_lower.push_back(ranges[k].first);
     }
 
     ivw->colnames(transitionsNames);
-    //iterate over spectra
 
-    for (UInt i = 0; i < swath_ptr->getNrSpectra(); ++i)
+    // score blocks of spectra in parallel, the scores are written in order after each block
+    const SignedSize nr_spectra = (SignedSize)swath_ptr->getNrSpectra();
+    const SignedSize block_size = 64;
+    for (SignedSize block_begin = 0; block_begin < nr_spectra; block_begin += block_size)
     {
+      const SignedSize block_end = std::min(block_begin + block_size, nr_spectra);
+      std::vector<std::vector<double> > score1v(block_end - block_begin), score2v(block_end - block_begin);
+      std::vector<double> spectrum_rt(block_end - block_begin);
+      std::exception_ptr error;
+
+#pragma omp parallel
+      {
+        // each thread needs its own spectrum access and integration buffers
+        OpenSwath::SpectrumAccessPtr thread_ptr;
+        std::vector<double> int_exp, mz_exp;
+#pragma omp critical (DiaPrescore_lightClone)
+        thread_ptr = swath_ptr->lightClone();
 
-      OpenSwath::SpectrumPtr spec = swath_ptr->getSpectrumById(i);
-      OpenSwath::SpectrumMeta specmeta = swath_ptr->getSpectrumMetaById(i);
-      std::cout << "Processing Spectrum  " << i << "RT " << specmeta.RT << std::endl;
-
-      //iterate over spectra
-      size_t xx = 0;
-      Mmap::iterator beg = transmap.begin();
-      Mmap::iterator end = transmap.end();
-      std::vector<double> score1v;
-      std::vector<double> score2v;
-      for (; beg != end; ++beg, ++xx)
+#pragma omp for schedule(dynamic, 1)
+        for (SignedSize i = block_begin; i < block_end; ++i)
+        {
+          try
+          {
+            OpenSwath::SpectrumPtr spec = thread_ptr->getSpectrumById((int)i);
+            spectrum_rt[i - block_begin] = thread_ptr->getSpectrumMetaById((int)i).RT;
+
+            // transition groups without peaks in the m/z range of the spectrum get the scores of an empty spectrum
+            std::vector<double>& score1 = score1v[i - block_begin]; // dotprod
+            std::vector<double>& score2 = score2v[i - block_begin]; // manhattan
+            score1.assign(nr_groups, 0.0);
+            score2.resize(nr_groups);
+            for (Size k = 0; k < nr_groups; ++k)
+            {
+              score2[k] = theo[k].empty_manhattan;
+            }
+
+            const std::vector<double>& mz = spec->getMZArray()->data;
+            if (mz.empty()) continue;
+            const Size nr_candidates = std::distance(sorted_lower.begin(),
+              std::upper_bound(sorted_lower.begin(), sorted_lower.end(), mz.back()));
+            for (Size k = 0; k < nr_candidates; ++k)
+            {
+              const Size group = by_lower[k];
+              if (ranges[group].second < mz.front()) continue;
+              score_(spec, theo[group], int_exp, mz_exp, score1[group], score2[group]);
+            }
+          }
+          catch (...)
+          {
+#pragma omp critical (DiaPrescore_error)
+            if (!error) error = std::current_exception();
+          }
+        }
+      }
+      if (error) std::rethrow_exception(error);
+
+      for (SignedSize i = block_begin; i < block_end; ++i)
       {
-        //std::cout << "analysing transition" << xx << beg->second.size()
-        //    << " " << beg->first << std::endl;
-        double score1;
-        double score2;
-        //OpenSwath::LightPeptide pep;
-        score(spec, beg->second, score1, score2);
-
-        score1v.push_back(score1);
-        score2v.push_back(score2);
-      } //end of forloop over transitions
-
-      //std::string ispectrum = boost::lexical_cast<std::string>(i);
-      std::string specRT = boost::lexical_cast<std::string>(specmeta.RT);
-      ivw->store("score1_" + specRT, score1v);
-      ivw->store("score2_" + specRT, score2v);
+        std::cout << "Processing Spectrum  " << i << "RT " << spectrum_rt[i - block_begin] << std::endl;
+
+        //std::string ispectrum = boost::lexical_cast<std::string>(i);
+        std::string specRT = boost::lexical_cast<std::string>(spectrum_rt[i - block_begin]);
+        ivw->store("score1_" + specRT, score1v[i - block_begin]);
+        ivw->store("score2_" + specRT, score2v[i - block_begin]);
+      }
     } //end of forloop over spectra
   }
 
-  void DiaPrescore::score(OpenSwath::SpectrumPtr spec,
-                          const std::vector<OpenSwath::LightTransition>& lt,
-                          double& dotprod,
-                          double& manhattan)
+  void DiaPrescore::computeTheoreticalSpectrum(const std::vector<OpenSwath::LightTransition>& lt,
+                                               TheoreticalSpectrum& theo) const
   {
     std::vector<std::pair<double, double> > res;
     getMZIntensityFromTransition(lt, res);
-    std::vector<double> firstIstotope, theomasses;
+    std::vector<double> firstIstotope;
     DIAHelpers::extractFirst(res, firstIstotope);
-    std::vector<std::pair<double, double> > spectrum, spectrum2;
+    std::vector<std::pair<double, double> > spectrum;
     DIAHelpers::addIsotopes2Spec(res, spectrum, nr_charges_);
-    spectrum2.resize(spectrum.size());
-    std::copy(spectrum.begin(), spectrum.end(), spectrum2.begin());
-    //std::cout << spectrum.size() << std::endl;
     DIAHelpers::addPreisotopeWeights(firstIstotope, spectrum, 2, 0.0);
     //extracts masses from spectrum
-    DIAHelpers::extractFirst(spectrum, theomasses);
-    std::vector<double>  theorint;
+    theo.masses.clear();
+    DIAHelpers::extractFirst(spectrum, theo.masses);
+
+    std::vector<double> theorint;
     DIAHelpers::extractSecond(spectrum, theorint);
-    std::vector<double> intExp, mzExp;
-    DIAHelpers::integrateWindows(spec, theomasses, dia_extract_window_, intExp, mzExp);
-    std::transform(intExp.begin(), intExp.end(), intExp.begin(), OpenSwath::mySqrt());
     std::transform(theorint.begin(), theorint.end(), theorint.begin(), OpenSwath::mySqrt());
 
-    double intExptotal = std::accumulate(intExp.begin(), intExp.end(), 0.0);
+    theo.manhattan_intensities = theorint;
     double intTheorTotal = std::accumulate(theorint.begin(), theorint.end(), 0.0);
+    OpenSwath::normalize(theo.manhattan_intensities, intTheorTotal, theo.manhattan_intensities);
 
-    OpenSwath::normalize(intExp, intExptotal, intExp);
-    OpenSwath::normalize(theorint, intTheorTotal, theorint);
+    theo.dotprod_intensities = theorint;
+    intTheorTotal = OpenSwath::norm(theorint.begin(), theorint.end());
+    OpenSwath::normalize(theo.dotprod_intensities, intTheorTotal, theo.dotprod_intensities);
 
-    manhattan = OpenSwath::manhattanDist(intExp.begin(), intExp.end(), theorint.begin());
+    // an empty spectrum integrates to zero in all windows
+    const std::vector<double> empty(theo.masses.size(), 0.0);
+    theo.empty_manhattan = OpenSwath::manhattanDist(empty.begin(), empty.end(), theo.manhattan_intensities.begin());
+  }
 
-    //std::cout << spectrum.size() << std::endl;
-    DIAHelpers::addPreisotopeWeights(firstIstotope, spectrum2, 2, -0.5);
-    std::vector<double>  theorint2;
-    DIAHelpers::extractSecond(spectrum, theorint2);
-    std::transform(theorint2.begin(), theorint2.end(), theorint2.begin(), OpenSwath::mySqrt());
+  void DiaPrescore::score(OpenSwath::SpectrumPtr spec,
+                          const std::vector<OpenSwath::LightTransition>& lt,
+                          double& dotprod,
+                          double& manhattan) const
+  {
+    TheoreticalSpectrum theo;
+    computeTheoreticalSpectrum(lt, theo);
+    score(spec, theo, dotprod, manhattan);
+  }
 
-    intExptotal = OpenSwath::norm(intExp.begin(), intExp.end());
-    intTheorTotal = OpenSwath::norm(theorint2.begin(), theorint2.end());
+  void DiaPrescore::score(OpenSwath::SpectrumPtr spec,
+                          const TheoreticalSpectrum& theo,
+                          double& dotprod,
+                          double& manhattan) const
+  {
+    std::vector<double> intExp, mzExp;
+    score_(spec, theo, intExp, mzExp, dotprod, manhattan);
+  }
 
+  void DiaPrescore::score_(const OpenSwath::SpectrumPtr& spec,
+                           const TheoreticalSpectrum& theo,
+                           std::vector<double>& intExp,
+                           std::vector<double>& mzExp,
+                           double& dotprod,
+                           double& manhattan) const
+  {
+    intExp.clear();
+    mzExp.clear();
+    DIAHelpers::integrateWindows(spec, theo.masses, dia_extract_window_, intExp, mzExp);
+    std::transform(intExp.begin(), intExp.end(), intExp.begin(), OpenSwath::mySqrt());
+
+    double intExptotal = std::accumulate(intExp.begin(), intExp.end(), 0.0);
+    OpenSwath::normalize(intExp, intExptotal, intExp);
+
+    manhattan = OpenSwath::manhattanDist(intExp.begin(), intExp.end(), theo.manhattan_intensities.begin());
+
+    intExptotal = OpenSwath::norm(intExp.begin(), intExp.end());
     OpenSwath::normalize(intExp, intExptotal, intExp);
-    OpenSwath::normalize(theorint2, intTheorTotal, theorint2);
 
-    //    std::copy(intExp.begin(), intExp.end(), std::ostream_iterator<double>(std::cout, ", "));
-    //    std::cout << std::endl;
-    //    std::copy(theorint2.begin(), theorint2.end(), std::ostream_iterator<double>(std::cout, ", "));
-    //    std::cout << std::endl;
-    dotprod = OpenSwath::dotProd(intExp.begin(), intExp.end(), theorint2.begin());
+    dotprod = OpenSwath::dotProd(intExp.begin(), intExp.end(), theo.dotprod_intensities.begin());
   }
 
   void DiaPrescore::updateMembers_()
@@ -35,6 +35,7 @@
 #include <OpenMS/ANALYSIS/OPENSWATH/DIAScoring.h>
 
 #include <OpenMS/CONCEPT/Constants.h>
+#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternCache.h>
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternGenerator.h>
 
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/FeatureFinderAlgorithmPickedHelperStructs.h>
@@ -392,14 +393,12 @@ namespace OpenMS
     if (!sum_formula.empty())
     {
       // create the theoretical distribution from the sum formula
-      EmpiricalFormula empf(sum_formula);
-      isotope_dist = empf.getIsotopeDistribution(CoarseIsotopePatternGenerator(dia_nr_isotopes_));
+      isotope_dist = CoarseIsotopePatternCache::getInstance()->getIsotopeDistribution(String(sum_formula), dia_nr_isotopes_);
     }
     else
     {
       // create the theoretical distribution from the peptide weight
-      CoarseIsotopePatternGenerator solver(dia_nr_isotopes_ + 1);
-      isotope_dist = solver.estimateFromPeptideWeight(std::fabs(product_mz * putative_fragment_charge));
+      isotope_dist = CoarseIsotopePatternCache::getInstance()->estimateFromPeptideWeight(std::fabs(product_mz * putative_fragment_charge), dia_nr_isotopes_ + 1);
     }
 
 
@@ -34,10 +34,96 @@
 
 #include <OpenMS/ANALYSIS/OPENSWATH/MRMAssay.h>
 
+#include <exception>
+
 using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// Theoretical transitions ("ion type" -> "fragment m/z") of one peptidoform
+    struct PeptidoformIons_
+    {
+      std::string unmodified;
+      std::string modified;
+      MRMAssay::IonSeries ions;
+    };
+
+    /// In silico peptidoforms of one peptide
+    struct InSilicoPeptide_
+    {
+      int swath = -1;
+      bool skipped = false;
+      std::vector<PeptidoformIons_> peptidoforms;
+    };
+
+    /// Identification transition of one peptide, named once its global index is known
+    struct GeneratedTransition_
+    {
+      Size index; ///< index within the transitions of the peptide
+      String name_suffix;
+      ReactionMonitoringTransition transition;
+    };
+
+    /// Identification transitions of one peptide
+    struct GeneratedAssay_
+    {
+      Size num_indices = 0; ///< number of transition indices used by the peptide
+      std::vector<GeneratedTransition_> transitions;
+    };
+
+    /// computes the (rounded) theoretical transitions of all @p peptidoforms
+    void computePeptidoformIons_(MRMIonSeries& mrmis, const std::vector<AASequence>& peptidoforms, int precursor_charge, double precursor_mz,
+                                 const std::vector<String>& fragment_types, const std::vector<size_t>& fragment_charges,
+                                 bool enable_specific_losses, bool enable_unspecific_losses, bool enable_ms2_precursors, int round_decPow,
+                                 std::vector<PeptidoformIons_>& result)
+    {
+      result.resize(peptidoforms.size());
+      for (Size j = 0; j < peptidoforms.size(); ++j)
+      {
+        const AASequence& alt_aa = peptidoforms[j];
+        PeptidoformIons_& form = result[j];
+        form.unmodified = alt_aa.toUnmodifiedString();
+        form.modified = alt_aa.toString();
+
+        // Generate theoretical ion series
+        auto ionseries = mrmis.getIonSeries(alt_aa, precursor_charge,
+            fragment_types, fragment_charges, enable_specific_losses,
+            enable_unspecific_losses);
+
+        form.ions.reserve(ionseries.size() + 1);
+        if (enable_ms2_precursors)
+        {
+          // Add precursor to theoretical transitions
+          form.ions.emplace_back("MS2_Precursor_i0", Math::roundDecimal(precursor_mz, round_decPow));
+        }
+        for (const auto& im_it : ionseries)
+        {
+          form.ions.emplace_back(im_it.first, Math::roundDecimal(im_it.second, round_decPow));
+        }
+      }
+    }
+
+    /// numbers and names the transitions of @p assays consecutively and appends them to @p transitions
+    void appendAssays_(std::vector<GeneratedAssay_>& assays, MRMAssay::TransitionVectorType& transitions)
+    {
+      Size offset = 0;
+      for (GeneratedAssay_& assay : assays)
+      {
+        for (GeneratedTransition_& tr : assay.transitions)
+        {
+          String identifier = String(offset + tr.index) + tr.name_suffix;
+          tr.transition.setName(identifier);
+          tr.transition.setNativeID(identifier);
+          OPENMS_LOG_DEBUG << "[uis] Transition " << identifier << std::endl;
+          transitions.push_back(std::move(tr.transition));
+        }
+        offset += assay.num_indices;
+      }
+    }
+  }
+
   MRMAssay::MRMAssay()
   {
   }
@@ -66,6 +152,43 @@ namespace OpenMS
     return isoforms;
   }
 
+  std::vector<std::string> MRMAssay::getMatchingPeptidoformsSorted_(const double fragment_ion,
+                                                                    const FragmentSeqMap& ions,
+                                                                    const double mz_threshold)
+  {
+    std::vector<std::string> isoforms;
+
+    // same criterion as getMatchingPeptidoforms_(); both bounds are monotonic in the fragment m/z
+    auto it = std::lower_bound(ions.begin(), ions.end(), fragment_ion,
+                               [mz_threshold](const std::pair<double, std::string>& ion, double mz) { return ion.first + mz_threshold < mz; });
+    for (; it != ions.end() && it->first - mz_threshold <= fragment_ion; ++it)
+    {
+      isoforms.push_back(it->second);
+    }
+
+    std::sort(isoforms.begin(), isoforms.end());
+    isoforms.erase(std::unique(isoforms.begin(), isoforms.end()), isoforms.end());
+
+    return isoforms;
+  }
+
+  void MRMAssay::sortIonMap_(IonMapT& ion_map)
+  {
+    std::vector<FragmentSeqMap*> ion_lists;
+    for (auto& swath : ion_map)
+    {
+      for (auto& seq : swath.second)
+      {
+        ion_lists.push_back(&seq.second);
+      }
+    }
+#pragma omp parallel for schedule(dynamic, 16)
+    for (SignedSize i = 0; i < (SignedSize)ion_lists.size(); ++i)
+    {
+      std::sort(ion_lists[i]->begin(), ion_lists[i]->end());
+    }
+  }
+
   int MRMAssay::getSwath_(const std::vector<std::pair<double, double> >& swathes, const double precursor_mz)
   {
     int swath = -1;
@@ -325,64 +448,83 @@ namespace OpenMS
                                             IonMapT & TargetIonMap,
                                             PeptideMapT& TargetPeptideMap)
   {
-    OpenMS::MRMIonSeries mrmis;
-
     // Step 1: Generate target in silico peptide map containing theoretical transitions
+    // The peptidoforms and their ion series are computed in parallel, then merged into the maps in input order.
+    const std::vector<TargetedExperiment::Peptide>& peptides = exp.getPeptides();
+    std::vector<InSilicoPeptide_> in_silico(peptides.size());
+
     Size progress = 0;
-    startProgress(0, exp.getPeptides().size(), "Generation of target in silico peptide map");
-    for (size_t i = 0; i < exp.getPeptides().size(); ++i)
+    startProgress(0, peptides.size(), "Generation of target in silico peptide map");
+    std::exception_ptr error;
+#pragma omp parallel
     {
-      setProgress(progress++);
+      OpenMS::MRMIonSeries mrmis;
 
-      TargetedExperiment::Peptide peptide = exp.getPeptides()[i];
-      OpenMS::AASequence peptide_sequence = TargetedExperimentHelper::getAASequence(peptide);
-      int precursor_charge = 1;
-      if (peptide.hasCharge()) 
+#pragma omp for schedule(dynamic, 16)
+      for (SignedSize i = 0; i < (SignedSize)peptides.size(); ++i)
       {
-        precursor_charge = peptide.getChargeState();
-      }
-      double precursor_mz = peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge;
-      int precursor_swath = getSwath_(swathes, precursor_mz);
+        try
+        {
+          const TargetedExperiment::Peptide& peptide = peptides[i];
+          OpenMS::AASequence peptide_sequence = TargetedExperimentHelper::getAASequence(peptide);
+          int precursor_charge = 1;
+          if (peptide.hasCharge())
+          {
+            precursor_charge = peptide.getChargeState();
+          }
+          double precursor_mz = peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge;
+          in_silico[i].swath = getSwath_(swathes, precursor_mz);
+
+          // Compute all alternative peptidoforms compatible with ModificationsDB
+          const vector<AASequence> alternative_peptide_sequences = generateTheoreticalPeptidoforms_(peptide_sequence);
 
-      // Compute all alternative peptidoforms compatible with ModificationsDB
-      const vector<AASequence> alternative_peptide_sequences = generateTheoreticalPeptidoforms_(peptide_sequence);  
+          // Some permutations might be too complex, skip if threshold is reached
+          if (alternative_peptide_sequences.size() > max_num_alternative_localizations)
+          {
+            in_silico[i].skipped = true;
+          }
+          else
+          {
+            computePeptidoformIons_(mrmis, alternative_peptide_sequences, precursor_charge, precursor_mz, fragment_types, fragment_charges,
+                                    enable_specific_losses, enable_unspecific_losses, enable_ms2_precursors, round_decPow, in_silico[i].peptidoforms);
+          }
+        }
+        catch (...)
+        {
+#pragma omp critical (MRMAssay_error)
+          if (!error) error = std::current_exception();
+        }
+#pragma omp critical (MRMAssay_progress)
+        setProgress(++progress);
+      }
+    }
+    endProgress();
+    if (error) std::rethrow_exception(error);
 
-      // Some permutations might be too complex, skip if threshold is reached
-      if (alternative_peptide_sequences.size() > max_num_alternative_localizations)
+    for (Size i = 0; i < peptides.size(); ++i)
+    {
+      const String& peptide_id = peptides[i].id;
+      if (in_silico[i].skipped)
       {
-        OPENMS_LOG_DEBUG << "[uis] Peptide skipped (too many permutations possible): " << peptide.id << std::endl;
+        OPENMS_LOG_DEBUG << "[uis] Peptide skipped (too many permutations possible): " << peptide_id << std::endl;
         continue;
       }
 
-      // Iterate over all peptidoforms
-      for (const auto& alt_aa : alternative_peptide_sequences)
-      { 
+      for (const PeptidoformIons_& form : in_silico[i].peptidoforms)
+      {
         // Append peptidoform to index
-        TargetSequenceMap[precursor_swath][alt_aa.toUnmodifiedString()].insert(alt_aa.toString());
-        // Generate theoretical ion series
-        auto ionseries = mrmis.getIonSeries(alt_aa, precursor_charge,
-            fragment_types, fragment_charges, enable_specific_losses,
-            enable_unspecific_losses);
-
-        if (enable_ms2_precursors)
+        TargetSequenceMap[in_silico[i].swath][form.unmodified].insert(form.modified);
+        // Append transitions to indices to find interfering transitions
+        FragmentSeqMap& swath_ions = TargetIonMap[in_silico[i].swath][form.unmodified];
+        IonSeries& peptide_ions = TargetPeptideMap[peptide_id];
+        for (const auto& ion : form.ions)
         {
-          // Add precursor to theoretical transitions
-          double prec_mz = Math::roundDecimal(precursor_mz, round_decPow);
-          TargetIonMap[precursor_swath][alt_aa.toUnmodifiedString()].emplace_back(prec_mz, alt_aa.toString());
-          TargetPeptideMap[peptide.id].emplace_back("MS2_Precursor_i0", prec_mz);
-        }
-
-        // Iterate over all theoretical transitions
-        for (const auto& im_it : ionseries)
-        {
-          // Append transition to indices to find interfering transitions
-          double fragment_mz = Math::roundDecimal(im_it.second, round_decPow);
-          TargetIonMap[precursor_swath][alt_aa.toUnmodifiedString()].emplace_back(fragment_mz, alt_aa.toString());
-          TargetPeptideMap[peptide.id].emplace_back(im_it.first, fragment_mz);
+          swath_ions.emplace_back(ion.second, form.modified);
+          peptide_ions.push_back(ion);
         }
       }
     }
-    endProgress();
+    sortIonMap_(TargetIonMap);
   }
 
   void MRMAssay::generateDecoySequences_(const SequenceMapT& TargetSequenceMap,
@@ -464,69 +606,91 @@ namespace OpenMS
                                            IonMapT & DecoyIonMap,
                                            PeptideMapT& DecoyPeptideMap)
   {
-    MRMIonSeries mrmis;
-
     // Step 2b: Generate decoy in silico peptide map containing theoretical transitions
-    Size progress = 0;
-    startProgress(0, exp.getPeptides().size(), "Generation of decoy in silico peptide map");
-    for (size_t i = 0; i < exp.getPeptides().size(); ++i)
-    {
-      setProgress(progress++);
-
-      TargetedExperiment::Peptide peptide = exp.getPeptides()[i];
-      int precursor_charge = 1;
-      if (peptide.hasCharge()) 
-      {
-        precursor_charge = peptide.getChargeState();
-      }
+    const std::vector<TargetedExperiment::Peptide>& peptides = exp.getPeptides();
 
+    // Copy properties of target peptides to decoys and get sequences from map (serial, modifies the maps)
+    std::vector<const TargetedExperiment::Peptide*> decoy_peptides(peptides.size(), nullptr);
+    for (Size i = 0; i < peptides.size(); ++i)
+    {
+      const TargetedExperiment::Peptide& peptide = peptides[i];
       // Skip if target peptide is not in map, e.g. permutation threshold was reached
       if (TargetPeptideMap.find(peptide.id) == TargetPeptideMap.end())
       {
         continue;
       }
-
-      OpenMS::AASequence peptide_sequence = TargetedExperimentHelper::getAASequence(peptide);
-      double precursor_mz = peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge;
-      int precursor_swath = getSwath_(swathes, precursor_mz);
-
-      // Copy properties of target peptide to decoy and get sequence from map
       TargetedExperiment::Peptide decoy_peptide = peptide;
       decoy_peptide.sequence = DecoySequenceMap[peptide.sequence];
-
       TargetDecoyMap[peptide.id] = decoy_peptide;
-      OpenMS::AASequence decoy_peptide_sequence = TargetedExperimentHelper::getAASequence(decoy_peptide);
+      decoy_peptides[i] = &TargetDecoyMap[peptide.id]; // references stay valid on rehashing
+    }
 
-      // Compute all alternative peptidoforms compatible with ModificationsDB
-      // Infers residue specificity from target sequence but is applied to decoy sequence
-      const vector<AASequence> alternative_decoy_peptide_sequences = generateTheoreticalPeptidoformsDecoy_(peptide_sequence, decoy_peptide_sequence);
+    std::vector<InSilicoPeptide_> in_silico(peptides.size());
+    Size progress = 0;
+    startProgress(0, peptides.size(), "Generation of decoy in silico peptide map");
+    std::exception_ptr error;
+#pragma omp parallel
+    {
+      MRMIonSeries mrmis;
 
-      // Iterate over all peptidoforms
-      for (const auto& alt_aa : alternative_decoy_peptide_sequences)
+#pragma omp for schedule(dynamic, 16)
+      for (SignedSize i = 0; i < (SignedSize)peptides.size(); ++i)
       {
-        // Generate theoretical ion series
-        MRMIonSeries::IonSeries ionseries = mrmis.getIonSeries(alt_aa, precursor_charge, // use same charge state as target
-                                                               fragment_types, fragment_charges, enable_specific_losses, enable_unspecific_losses);  
+        try
+        {
+          if (decoy_peptides[i] != nullptr)
+          {
+            const TargetedExperiment::Peptide& peptide = peptides[i];
+            int precursor_charge = 1;
+            if (peptide.hasCharge())
+            {
+              precursor_charge = peptide.getChargeState();
+            }
 
-        if (enable_ms2_precursors)
+            OpenMS::AASequence peptide_sequence = TargetedExperimentHelper::getAASequence(peptide);
+            double precursor_mz = peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge;
+            in_silico[i].swath = getSwath_(swathes, precursor_mz);
+
+            OpenMS::AASequence decoy_peptide_sequence = TargetedExperimentHelper::getAASequence(*decoy_peptides[i]);
+
+            // Compute all alternative peptidoforms compatible with ModificationsDB
+            // Infers residue specificity from target sequence but is applied to decoy sequence
+            const vector<AASequence> alternative_decoy_peptide_sequences = generateTheoreticalPeptidoformsDecoy_(peptide_sequence, decoy_peptide_sequence);
+
+            // use same charge state as target
+            computePeptidoformIons_(mrmis, alternative_decoy_peptide_sequences, precursor_charge, precursor_mz, fragment_types, fragment_charges,
+                                    enable_specific_losses, enable_unspecific_losses, enable_ms2_precursors, round_decPow, in_silico[i].peptidoforms);
+          }
+        }
+        catch (...)
         {
-          // Add precursor to theoretical transitions
-          double prec_mz = Math::roundDecimal(precursor_mz, round_decPow);
-          DecoyIonMap[precursor_swath][alt_aa.toUnmodifiedString()].emplace_back(prec_mz, alt_aa.toString());
-          DecoyPeptideMap[peptide.id].emplace_back("MS2_Precursor_i0", prec_mz);
+#pragma omp critical (MRMAssay_error)
+          if (!error) error = std::current_exception();
         }
+#pragma omp critical (MRMAssay_progress)
+        setProgress(++progress);
+      }
+    }
+    endProgress();
+    if (error) std::rethrow_exception(error);
 
-        // Iterate over all theoretical transitions
-        for (const auto& im_it : ionseries)
+    for (Size i = 0; i < peptides.size(); ++i)
+    {
+      if (decoy_peptides[i] == nullptr) continue;
+
+      for (const PeptidoformIons_& form : in_silico[i].peptidoforms)
+      {
+        // Append transitions to indices to find interfering transitions
+        FragmentSeqMap& swath_ions = DecoyIonMap[in_silico[i].swath][form.unmodified];
+        IonSeries& peptide_ions = DecoyPeptideMap[decoy_peptides[i]->id];
+        for (const auto& ion : form.ions)
         {
-          // Append transition to indices to find interfering transitions
-          double fragment_mz = Math::roundDecimal(im_it.second, round_decPow);
-          DecoyIonMap[precursor_swath][alt_aa.toUnmodifiedString()].emplace_back(fragment_mz, alt_aa.toString());
-          DecoyPeptideMap[decoy_peptide.id].emplace_back(im_it.first, fragment_mz);
+          swath_ions.emplace_back(ion.second, form.modified);
+          peptide_ions.push_back(ion);
         }
       }
     }
-    endProgress();
+    sortIonMap_(DecoyIonMap);
   }
 
  void MRMAssay::generateTargetAssays_(const OpenMS::TargetedExperiment& exp,
@@ -537,71 +701,92 @@ namespace OpenMS
                                       const PeptideMapT& TargetPeptideMap,
                                       const IonMapT & TargetIonMap)
   {
-    MRMIonSeries mrmis;
-
     // Step 3: Generate target identification transitions
-    Size progress = 0;
-    startProgress(0, TargetPeptideMap.size(), "Generation of target identification transitions");
-
-    // Iterate over all target peptides
-    int transition_index = 0;
+    // Peptides are processed in parallel, the transitions are appended (and numbered) in the order of TargetPeptideMap.
+    std::vector<const PeptideMapT::value_type*> entries;
+    std::vector<const TargetedExperiment::Peptide*> peptides;
+    entries.reserve(TargetPeptideMap.size());
+    peptides.reserve(TargetPeptideMap.size());
     for (const auto& pep_it : TargetPeptideMap)
-    { 
-      setProgress(progress++);
+    {
+      entries.push_back(&pep_it);
+      peptides.push_back(&exp.getPeptideByRef(pep_it.first)); // not thread-safe on first use
+    }
+    std::vector<GeneratedAssay_> assays(entries.size());
 
-      TargetedExperiment::Peptide peptide = exp.getPeptideByRef(pep_it.first);
-      int precursor_charge = 1;
-      if (peptide.hasCharge()) 
-      {
-        precursor_charge = peptide.getChargeState();
-      }
-      AASequence peptide_sequence = TargetedExperimentHelper::getAASequence(peptide);
-      int target_precursor_swath = getSwath_(swathes, peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge);
+    Size progress = 0;
+    startProgress(0, entries.size(), "Generation of target identification transitions");
+    std::exception_ptr error;
+#pragma omp parallel
+    {
+      MRMIonSeries mrmis;
 
-      // Sort all transitions and make them unique
-      auto transition_vector = pep_it.second;
-      std::sort(transition_vector.begin(), transition_vector.end());
-      auto tr_vec_end = std::unique(transition_vector.begin(), transition_vector.end());
+#pragma omp for schedule(dynamic, 16)
+      for (SignedSize k = 0; k < (SignedSize)entries.size(); ++k)
+      {
+        try
+        {
+          const TargetedExperiment::Peptide& peptide = *peptides[k];
+          int precursor_charge = 1;
+          if (peptide.hasCharge())
+          {
+            precursor_charge = peptide.getChargeState();
+          }
+          AASequence peptide_sequence = TargetedExperimentHelper::getAASequence(peptide);
+          int target_precursor_swath = getSwath_(swathes, peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge);
+          const FragmentSeqMap& target_ions = TargetIonMap.at(target_precursor_swath).at(peptide_sequence.toUnmodifiedString());
+
+          // Sort all transitions and make them unique
+          auto transition_vector = entries[k]->second;
+          std::sort(transition_vector.begin(), transition_vector.end());
+          auto tr_vec_end = std::unique(transition_vector.begin(), transition_vector.end());
+
+          // Iterate over all transitions
+          Size transition_index = 0;
+          for (auto tr_it = transition_vector.begin(); tr_it != tr_vec_end; ++tr_it)
+          {
+            // Compute the set of peptidoforms mapping to this transition
+            vector<string> isoforms = getMatchingPeptidoformsSorted_(tr_it->second, target_ions, mz_threshold);
 
-      // Iterate over all transitions
-      for (auto tr_it = transition_vector.begin(); tr_it != tr_vec_end; ++tr_it)
-      { 
-        // Compute the set of peptidoforms mapping to this transition
-        vector<string> isoforms = getMatchingPeptidoforms_(
-            tr_it->second, TargetIonMap.at(target_precursor_swath).at(peptide_sequence.toUnmodifiedString()), mz_threshold);
+            // Check that transition maps to at least one peptidoform
+            if (isoforms.size() > 0)
+            {
+              ReactionMonitoringTransition trn;
+              trn.setDetectingTransition(false);
+              trn.setMetaValue("insilico_transition", "true");
+              trn.setPrecursorMZ(Math::roundDecimal(peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge, round_decPow));
+              trn.setProductMZ(tr_it->second);
+              trn.setPeptideRef(peptide.id);
+              mrmis.annotateTransitionCV(trn, tr_it->first);
+              trn.setIdentifyingTransition(true);
+              trn.setQuantifyingTransition(false);
+
+              // Transition name containing mapping to peptidoforms with potential peptidoforms enumerated in brackets (prefixed by the index)
+              String name_suffix = "_" + String("UIS") +
+                "_{" + ListUtils::concatenate(isoforms, "|") + "}_" +
+                String(trn.getPrecursorMZ()) + "_" + String(trn.getProductMZ()) + "_" +
+                String(peptide.getRetentionTime()) + "_" + tr_it->first;
+              trn.setMetaValue("Peptidoforms", ListUtils::concatenate(isoforms, "|"));
 
-        // Check that transition maps to at least one peptidoform
-        if (isoforms.size() > 0)
+              assays[k].transitions.push_back(GeneratedTransition_{transition_index, name_suffix, std::move(trn)});
+            }
+            transition_index++;
+          }
+          assays[k].num_indices = transition_index;
+        }
+        catch (...)
         {
-          ReactionMonitoringTransition trn;
-          trn.setDetectingTransition(false);
-          trn.setMetaValue("insilico_transition", "true");
-          trn.setPrecursorMZ(Math::roundDecimal(peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge, round_decPow));
-          trn.setProductMZ(tr_it->second);
-          trn.setPeptideRef(peptide.id);
-          mrmis.annotateTransitionCV(trn, tr_it->first);
-          trn.setIdentifyingTransition(true);
-          trn.setQuantifyingTransition(false);
-
-          // Set transition name containing mapping to peptidoforms with potential peptidoforms enumerated in brackets
-          String identifier = String(transition_index) + "_" + String("UIS") +  \
-            "_{" + ListUtils::concatenate(isoforms, "|") + "}_" +  \
-            String(trn.getPrecursorMZ()) + "_" + String(trn.getProductMZ()) + "_" + 
-            String(peptide.getRetentionTime()) + "_" + tr_it->first; 
-          trn.setName(identifier); 
-          trn.setNativeID(identifier);
-          trn.setMetaValue("Peptidoforms", ListUtils::concatenate(isoforms, "|"));
-
-          OPENMS_LOG_DEBUG << "[uis] Transition " << trn.getNativeID() << std::endl;
-
-          // Append transition
-          transitions.push_back(trn);
+#pragma omp critical (MRMAssay_error)
+          if (!error) error = std::current_exception();
         }
-        transition_index++;
+#pragma omp critical (MRMAssay_progress)
+        setProgress(++progress);
       }
-      OPENMS_LOG_DEBUG << "[uis] Peptide " << peptide.id << std::endl;
     }
     endProgress();
+    if (error) std::rethrow_exception(error);
+
+    appendAssays_(assays, transitions);
   }
 
  void MRMAssay::generateDecoyAssays_(const OpenMS::TargetedExperiment& exp,
@@ -614,85 +799,108 @@ namespace OpenMS
                                      const IonMapT& DecoyIonMap,
                                      const IonMapT& TargetIonMap)
   {
-    MRMIonSeries mrmis;
-
     // Step 4: Generate decoy identification transitions
-    Size progress = 0;
-    startProgress(0, DecoyPeptideMap.size(), "Generation of decoy identification transitions");
+    // Peptides are processed in parallel, the transitions are appended (and numbered) in the order of DecoyPeptideMap.
+    std::vector<const PeptideMapT::value_type*> entries;
+    std::vector<const TargetedExperiment::Peptide*> target_peptides;
+    std::vector<const TargetedExperiment::Peptide*> decoy_peptides;
+    entries.reserve(DecoyPeptideMap.size());
+    target_peptides.reserve(DecoyPeptideMap.size());
+    decoy_peptides.reserve(DecoyPeptideMap.size());
+    for (const auto& decoy_pep_it : DecoyPeptideMap)
+    {
+      entries.push_back(&decoy_pep_it);
+      target_peptides.push_back(&exp.getPeptideByRef(decoy_pep_it.first)); // not thread-safe on first use
+      decoy_peptides.push_back(&TargetDecoyMap[decoy_pep_it.first]);
+    }
+    std::vector<GeneratedAssay_> assays(entries.size());
 
-    // Iterate over all decoy peptides
-    int transition_index = 0;
-    for (const auto & decoy_pep_it : DecoyPeptideMap)
+    Size progress = 0;
+    startProgress(0, entries.size(), "Generation of decoy identification transitions");
+    std::exception_ptr error;
+#pragma omp parallel
     {
-      setProgress(progress++);
-      TargetedExperiment::Peptide target_peptide = exp.getPeptideByRef(decoy_pep_it.first);
-      int precursor_charge = 1;
-      if (target_peptide.hasCharge()) 
+      MRMIonSeries mrmis;
+
+#pragma omp for schedule(dynamic, 16)
+      for (SignedSize k = 0; k < (SignedSize)entries.size(); ++k)
       {
-        precursor_charge = target_peptide.getChargeState();
-      }
-      AASequence target_peptide_sequence = TargetedExperimentHelper::getAASequence(target_peptide);
-      int target_precursor_swath = getSwath_(swathes, target_peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge);
+        try
+        {
+          const TargetedExperiment::Peptide& target_peptide = *target_peptides[k];
+          int precursor_charge = 1;
+          if (target_peptide.hasCharge())
+          {
+            precursor_charge = target_peptide.getChargeState();
+          }
+          AASequence target_peptide_sequence = TargetedExperimentHelper::getAASequence(target_peptide);
+          int target_precursor_swath = getSwath_(swathes, target_peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge);
 
-      TargetedExperiment::Peptide decoy_peptide = TargetDecoyMap[decoy_pep_it.first];
-      OpenMS::AASequence decoy_peptide_sequence = TargetedExperimentHelper::getAASequence(decoy_peptide);
+          const TargetedExperiment::Peptide& decoy_peptide = *decoy_peptides[k];
+          OpenMS::AASequence decoy_peptide_sequence = TargetedExperimentHelper::getAASequence(decoy_peptide);
 
-      // Sort all transitions and make them unique
-      auto transition_vector = decoy_pep_it.second;
-      std::sort(transition_vector.begin(), transition_vector.end());
-      auto tr_vec_end = std::unique(transition_vector.begin(), transition_vector.end());
+          const FragmentSeqMap& decoy_ions = DecoyIonMap.at(target_precursor_swath).at(decoy_peptide_sequence.toUnmodifiedString());
+          const FragmentSeqMap& target_ions = TargetIonMap.at(target_precursor_swath).at(target_peptide_sequence.toUnmodifiedString());
 
-      // Iterate over all transitions
-      for (auto decoy_tr_it = transition_vector.begin(); decoy_tr_it != tr_vec_end; ++decoy_tr_it)
-      {
-        // Check mapping of transitions to other peptidoforms
-        vector<string> decoy_isoforms = getMatchingPeptidoforms_(
-            decoy_tr_it->second, DecoyIonMap.at(target_precursor_swath).at(decoy_peptide_sequence.toUnmodifiedString()), mz_threshold);
+          // Sort all transitions and make them unique
+          auto transition_vector = entries[k]->second;
+          std::sort(transition_vector.begin(), transition_vector.end());
+          auto tr_vec_end = std::unique(transition_vector.begin(), transition_vector.end());
 
-        // Check that transition maps to at least one peptidoform
-        if (decoy_isoforms.size() > 0)
-        {
-          ReactionMonitoringTransition trn;
-          trn.setDecoyTransitionType(ReactionMonitoringTransition::DECOY);
-          trn.setDetectingTransition(false);
-          trn.setMetaValue("insilico_transition", "true");
-          trn.setPrecursorMZ(Math::roundDecimal(target_peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge, round_decPow));
-          trn.setProductMZ(decoy_tr_it->second);
-          trn.setPeptideRef(decoy_peptide.id);
-          mrmis.annotateTransitionCV(trn, decoy_tr_it->first);
-          trn.setIdentifyingTransition(true);
-          trn.setQuantifyingTransition(false);
-
-          // Set transition name containing mapping to peptidoforms with potential peptidoforms enumerated in brackets
-          String identifier = String(transition_index) + "_" + String("UISDECOY") +
+          // Iterate over all transitions
+          Size transition_index = 0;
+          for (auto decoy_tr_it = transition_vector.begin(); decoy_tr_it != tr_vec_end; ++decoy_tr_it)
+          {
+            // Check mapping of transitions to other peptidoforms
+            vector<string> decoy_isoforms = getMatchingPeptidoformsSorted_(decoy_tr_it->second, decoy_ions, mz_threshold);
+
+            // Check that transition maps to at least one peptidoform
+            if (decoy_isoforms.size() > 0)
+            {
+              // Check if decoy transition is overlapping with target transition
+              if (!getMatchingPeptidoformsSorted_(decoy_tr_it->second, target_ions, mz_threshold).empty())
+              {
+                OPENMS_LOG_DEBUG << "[uis] Skipping overlapping decoy transition " << decoy_tr_it->second << std::endl;
+                continue; // does not advance the transition index
+              }
+
+              ReactionMonitoringTransition trn;
+              trn.setDecoyTransitionType(ReactionMonitoringTransition::DECOY);
+              trn.setDetectingTransition(false);
+              trn.setMetaValue("insilico_transition", "true");
+              trn.setPrecursorMZ(Math::roundDecimal(target_peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge, round_decPow));
+              trn.setProductMZ(decoy_tr_it->second);
+              trn.setPeptideRef(decoy_peptide.id);
+              mrmis.annotateTransitionCV(trn, decoy_tr_it->first);
+              trn.setIdentifyingTransition(true);
+              trn.setQuantifyingTransition(false);
+
+              // Transition name containing mapping to peptidoforms with potential peptidoforms enumerated in brackets (prefixed by the index)
+              String name_suffix = "_" + String("UISDECOY") +
                 "_{" + ListUtils::concatenate(decoy_isoforms, "|") + "}_" +
                 String(trn.getPrecursorMZ()) + "_" + String(trn.getProductMZ()) + "_" +
                 String(decoy_peptide.getRetentionTime()) + "_" + decoy_tr_it->first;
-          trn.setName(identifier); 
-          trn.setNativeID(identifier);
-          trn.setMetaValue("Peptidoforms", ListUtils::concatenate(decoy_isoforms, "|"));
-
-          OPENMS_LOG_DEBUG << "[uis] Decoy transition " << trn.getNativeID() << std::endl;
+              trn.setMetaValue("Peptidoforms", ListUtils::concatenate(decoy_isoforms, "|"));
 
-          // Check if decoy transition is overlapping with target transition
-          vector<string> target_isoforms_overlap = getMatchingPeptidoforms_(
-              decoy_tr_it->second, TargetIonMap.at(target_precursor_swath).at(target_peptide_sequence.toUnmodifiedString()), mz_threshold);
-
-          if (target_isoforms_overlap.size() > 0)
-          {
-            OPENMS_LOG_DEBUG << "[uis] Skipping overlapping decoy transition " << trn.getNativeID() << std::endl;
-            continue;
-          }
-          else
-          {
-            // Append transition
-            transitions.push_back(trn);
+              assays[k].transitions.push_back(GeneratedTransition_{transition_index, name_suffix, std::move(trn)});
+            }
+            transition_index++;
           }
+          assays[k].num_indices = transition_index;
+        }
+        catch (...)
+        {
+#pragma omp critical (MRMAssay_error)
+          if (!error) error = std::current_exception();
         }
-        transition_index++;
+#pragma omp critical (MRMAssay_progress)
+        setProgress(++progress);
       }
     }
     endProgress();
+    if (error) std::rethrow_exception(error);
+
+    appendAssays_(assays, transitions);
   }
 
   void MRMAssay::reannotateTransitions(OpenMS::TargetedExperiment& exp,
@@ -38,6 +38,11 @@
 
 #include <OpenMS/CONCEPT/LogStream.h>
 
+#include <boost/unordered_set.hpp>
+
+#include <algorithm>
+#include <random>
+
 namespace OpenMS
 {
 
@@ -323,7 +328,8 @@ namespace OpenMS
   }
 
 
-  void switchKR(OpenMS::TargetedExperiment::Peptide& peptide)
+  /// switches the terminal K/R of @p peptide (or replaces other terminal residues randomly, using @p seed)
+  void switchKR(OpenMS::TargetedExperiment::Peptide& peptide, int seed)
   {
     static std::string aa[] =
     {
@@ -332,9 +338,9 @@ namespace OpenMS
     };
     int aa_size = 17;
 
-    static boost::mt19937 generator(42);
-    static boost::uniform_int<> uni_dist;
-    static boost::variate_generator<boost::mt19937&, boost::uniform_int<> > pseudoRNG(generator, uni_dist);
+    boost::mt19937 generator(seed);
+    boost::uniform_int<> uni_dist;
+    boost::variate_generator<boost::mt19937&, boost::uniform_int<> > pseudoRNG(generator, uni_dist);
 
     Size lastAA = peptide.sequence.size() -1;
     if (peptide.sequence[lastAA] == 'K')
@@ -374,9 +380,9 @@ namespace OpenMS
                                 const String& decoy_tag, const int max_attempts, const double identity_threshold,
                                 const double precursor_mz_shift, const double product_mz_shift, const double product_mz_threshold,
                                 const std::vector<String>& fragment_types, const std::vector<size_t>& fragment_charges,
-                                const bool enable_specific_losses, const bool enable_unspecific_losses, const int round_decPow) const
+                                const bool enable_specific_losses, const bool enable_unspecific_losses, const int round_decPow,
+                                const int seed) const
   {
-    MRMIonSeries mrmis;
     MRMDecoy::PeptideVectorType peptides, decoy_peptides;
     MRMDecoy::ProteinVectorType proteins, decoy_proteins;
     MRMDecoy::TransitionVectorType decoy_transitions;
@@ -387,7 +393,9 @@ namespace OpenMS
       proteins.push_back(protein);
     }
 
-    srand(time(0));
+    // all random decisions derive from this seed (per peptide, independent of the thread executing it)
+    const unsigned int base_seed = (seed == -1) ? (unsigned int)time(nullptr) : (unsigned int)seed;
+
     std::vector<size_t> item_list, selection_list;
     item_list.reserve(exp.getPeptides().size());
     for (Size k = 0; k < exp.getPeptides().size(); k++) {item_list.push_back(k);}
@@ -398,7 +406,8 @@ namespace OpenMS
     }
     else if ( aim_decoy_fraction < 1.0)
     {
-      std::random_shuffle(item_list.begin(), item_list.end());
+      std::mt19937 generator(base_seed);
+      std::shuffle(item_list.begin(), item_list.end(), generator);
       selection_list.reserve(aim_decoy_fraction * exp.getPeptides().size());
       Size k = 0;
       while (selection_list.size() < aim_decoy_fraction * exp.getPeptides().size())
@@ -411,15 +420,32 @@ namespace OpenMS
       selection_list = item_list;
     }
 
-    std::vector<String> exclusion_peptides;
+    // target sequences (with modifications), decoys colliding with any of them are removed
+    boost::unordered_set<String> target_sequences;
+    if (method != "shift") // shift decoys have the target sequence by design
+    {
+      std::vector<String> sequences(exp.getPeptides().size());
+#pragma omp parallel for
+      for (SignedSize i = 0; i < (SignedSize)exp.getPeptides().size(); ++i)
+      {
+        sequences[i] = TargetedExperimentHelper::getAASequence(exp.getPeptides()[i]).toString();
+      }
+      target_sequences.insert(sequences.begin(), sequences.end());
+    }
+
     // Go through all peptides and apply the decoy method to the sequence
     // (pseudo-reverse, reverse or shuffle). Then set the peptides and proteins of the decoy
     // experiment.
+    peptides.resize(selection_list.size());
+    std::vector<char> excluded(selection_list.size(), false);
     Size progress = 0;
     startProgress(0, selection_list.size(), "Generating decoy peptides");
-    for (const auto& pep_idx : selection_list)
+#pragma omp parallel for schedule(dynamic, 64)
+    for (SignedSize s = 0; s < (SignedSize)selection_list.size(); ++s)
     {
-      setProgress(++progress);
+      const Size pep_idx = selection_list[s];
+      // seed of the peptide (non-negative, as -1 requests a time-based seed)
+      const int peptide_seed = (int)((base_seed + 2654435761u * (unsigned int)pep_idx) & 0x7fffffffu);
 
       OpenMS::TargetedExperiment::Peptide peptide = exp.getPeptides()[pep_idx];
 
@@ -436,12 +462,12 @@ namespace OpenMS
         if (MRMDecoy::hasCNterminalMods_(peptide, do_switchKR))
         {
           OPENMS_LOG_DEBUG << "[peptide] Skipping " << peptide.id << " due to C/N-terminal modifications" << std::endl;
-          exclusion_peptides.push_back(peptide.id);
+          excluded[s] = true;
         }
         else
         {
           peptide = MRMDecoy::pseudoreversePeptide_(peptide);
-          if (do_switchKR) switchKR(peptide);
+          if (do_switchKR) switchKR(peptide, peptide_seed);
         }
       }
       else if (method == "reverse")
@@ -450,7 +476,7 @@ namespace OpenMS
         if (MRMDecoy::hasCNterminalMods_(peptide, false))
         {
           OPENMS_LOG_DEBUG << "[peptide] Skipping " << peptide.id << " due to C/N-terminal modifications" << std::endl;
-          exclusion_peptides.push_back(peptide.id);
+          excluded[s] = true;
         }
         else
         {
@@ -459,13 +485,20 @@ namespace OpenMS
       }
       else if (method == "shuffle")
       {
-        peptide = MRMDecoy::shufflePeptide(peptide, identity_threshold, -1, max_attempts);
+        peptide = MRMDecoy::shufflePeptide(peptide, identity_threshold, peptide_seed, max_attempts);
         if (do_switchKR && MRMDecoy::hasCNterminalMods_(peptide, do_switchKR))
         {
           OPENMS_LOG_DEBUG << "[peptide] Skipping " << peptide.id << " due to C/N-terminal modifications" << std::endl;
-          exclusion_peptides.push_back(peptide.id);
+          excluded[s] = true;
         }
-        else if (do_switchKR) switchKR(peptide);
+        else if (do_switchKR) switchKR(peptide, peptide_seed);
+      }
+
+      if (!excluded[s] && !target_sequences.empty() &&
+          target_sequences.count(TargetedExperimentHelper::getAASequence(peptide).toString()) > 0)
+      {
+        OPENMS_LOG_DEBUG << "[peptide] Skipping " << peptide.id << " due to identical target sequence" << std::endl;
+        excluded[s] = true;
       }
 
       for (Size prot_idx = 0; prot_idx < peptide.protein_refs.size(); ++prot_idx)
@@ -473,10 +506,24 @@ namespace OpenMS
         peptide.protein_refs[prot_idx] = decoy_tag + peptide.protein_refs[prot_idx];
       }
 
-      peptides.push_back(peptide);
+      peptides[s] = std::move(peptide);
+#pragma omp critical (MRMDecoy_progress)
+      setProgress(++progress);
     }
     endProgress();
-    dec.setPeptides(peptides); // temporary set peptides, overwrite later again!
+
+    boost::unordered_set<String> exclusion_peptides;
+    boost::unordered_map<String, const TargetedExperiment::Peptide*> decoy_peptide_map;
+    for (Size s = 0; s < peptides.size(); ++s)
+    {
+      if (excluded[s]) exclusion_peptides.insert(peptides[s].id);
+      decoy_peptide_map[peptides[s].id] = &peptides[s];
+    }
+    boost::unordered_map<String, const TargetedExperiment::Peptide*> target_peptide_map;
+    for (const auto& peptide : exp.getPeptides())
+    {
+      target_peptide_map[peptide.id] = &peptide;
+    }
 
     // hash of the peptide reference containing all transitions
     MRMDecoy::PeptideTransitionMapType peptide_trans_map;
@@ -484,107 +531,131 @@ namespace OpenMS
     {
       peptide_trans_map[exp.getTransitions()[i].getPeptideRef()].push_back(&exp.getTransitions()[i]);
     }
-
-    progress = 0;
-    startProgress(0, peptide_trans_map.size(), "Generating decoy transitions");
-    for (MRMDecoy::PeptideTransitionMapType::iterator pep_it = peptide_trans_map.begin();
-         pep_it != peptide_trans_map.end(); ++pep_it)
+    std::vector<MRMDecoy::PeptideTransitionMapType::const_iterator> pep_its;
+    pep_its.reserve(peptide_trans_map.size());
+    for (auto pep_it = peptide_trans_map.cbegin(); pep_it != peptide_trans_map.cend(); ++pep_it)
     {
-      setProgress(++progress);
-
-      String peptide_ref = pep_it->first;
-      String decoy_peptide_ref = decoy_tag + pep_it->first; // see above, the decoy peptide id is computed deterministically from the target id
-      if (!dec.hasPeptide(decoy_peptide_ref)) {continue;}
-      const TargetedExperiment::Peptide target_peptide = exp.getPeptideByRef(peptide_ref);
-
-      const TargetedExperiment::Peptide decoy_peptide = dec.getPeptideByRef(decoy_peptide_ref);
-      OpenMS::AASequence target_peptide_sequence = TargetedExperimentHelper::getAASequence(target_peptide);
-      OpenMS::AASequence decoy_peptide_sequence = TargetedExperimentHelper::getAASequence(decoy_peptide);
-
-      int decoy_charge = 1;
-      int target_charge = 1;
-      if (decoy_peptide.hasCharge()) {decoy_charge = decoy_peptide.getChargeState();}
-      if (target_peptide.hasCharge()) {target_charge = target_peptide.getChargeState();}
+      pep_its.push_back(pep_it);
+    }
 
-      MRMIonSeries::IonSeries decoy_ionseries = mrmis.getIonSeries(decoy_peptide_sequence, decoy_charge,
-            fragment_types, fragment_charges, enable_specific_losses,
-            enable_unspecific_losses, round_decPow);
-      MRMIonSeries::IonSeries target_ionseries = mrmis.getIonSeries(target_peptide_sequence, target_charge,
-            fragment_types, fragment_charges, enable_specific_losses,
-            enable_unspecific_losses, round_decPow);
+    // decoy transitions and peptides without annotation, per target peptide
+    std::vector<MRMDecoy::TransitionVectorType> peptide_decoy_transitions(pep_its.size());
+    std::vector<std::vector<String> > peptide_exclusions(pep_its.size());
 
-      // Compute (new) decoy precursor m/z based on the K/R replacement and the AA changes in the shuffle algorithm
-      double decoy_precursor_mz = decoy_peptide_sequence.getMonoWeight(Residue::Full, decoy_charge) / decoy_charge;
-      decoy_precursor_mz += precursor_mz_shift; // fix for TOPPView: Duplicate precursor MZ is not displayed.
+    progress = 0;
+    startProgress(0, pep_its.size(), "Generating decoy transitions");
+#pragma omp parallel
+    {
+      MRMIonSeries mrmis;
 
-      for (Size i = 0; i < pep_it->second.size(); i++)
+#pragma omp for schedule(dynamic, 64)
+      for (SignedSize p = 0; p < (SignedSize)pep_its.size(); ++p)
       {
-        const ReactionMonitoringTransition tr = *(pep_it->second[i]);
-
-        if (!tr.isDetectingTransition() || tr.getDecoyTransitionType() == ReactionMonitoringTransition::DECOY)
+        MRMDecoy::PeptideTransitionMapType::const_iterator pep_it = pep_its[p];
+#pragma omp critical (MRMDecoy_progress)
+        setProgress(++progress);
+
+        const String& peptide_ref = pep_it->first;
+        String decoy_peptide_ref = decoy_tag + pep_it->first; // see above, the decoy peptide id is computed deterministically from the target id
+        auto decoy_it = decoy_peptide_map.find(decoy_peptide_ref);
+        auto target_it = target_peptide_map.find(peptide_ref);
+        if (decoy_it == decoy_peptide_map.end() || target_it == target_peptide_map.end()) {continue;}
+        const TargetedExperiment::Peptide& target_peptide = *target_it->second;
+
+        const TargetedExperiment::Peptide& decoy_peptide = *decoy_it->second;
+        OpenMS::AASequence target_peptide_sequence = TargetedExperimentHelper::getAASequence(target_peptide);
+        OpenMS::AASequence decoy_peptide_sequence = TargetedExperimentHelper::getAASequence(decoy_peptide);
+
+        int decoy_charge = 1;
+        int target_charge = 1;
+        if (decoy_peptide.hasCharge()) {decoy_charge = decoy_peptide.getChargeState();}
+        if (target_peptide.hasCharge()) {target_charge = target_peptide.getChargeState();}
+
+        // ion series of target and decoy, computed once and used for all transitions of the peptide
+        MRMIonSeries::IonSeries decoy_ionseries = mrmis.getIonSeries(decoy_peptide_sequence, decoy_charge,
+              fragment_types, fragment_charges, enable_specific_losses,
+              enable_unspecific_losses, round_decPow);
+        MRMIonSeries::IonSeries target_ionseries = mrmis.getIonSeries(target_peptide_sequence, target_charge,
+              fragment_types, fragment_charges, enable_specific_losses,
+              enable_unspecific_losses, round_decPow);
+
+        // Compute (new) decoy precursor m/z based on the K/R replacement and the AA changes in the shuffle algorithm
+        double decoy_precursor_mz = decoy_peptide_sequence.getMonoWeight(Residue::Full, decoy_charge) / decoy_charge;
+        decoy_precursor_mz += precursor_mz_shift; // fix for TOPPView: Duplicate precursor MZ is not displayed.
+
+        for (Size i = 0; i < pep_it->second.size(); i++)
         {
-          continue;
-        }
+          const ReactionMonitoringTransition& tr = *(pep_it->second[i]);
 
-        ReactionMonitoringTransition decoy_tr = tr; // copy the target transition
+          if (!tr.isDetectingTransition() || tr.getDecoyTransitionType() == ReactionMonitoringTransition::DECOY)
+          {
+            continue;
+          }
 
-        decoy_tr.setNativeID(decoy_tag + tr.getNativeID());
-        decoy_tr.setDecoyTransitionType(ReactionMonitoringTransition::DECOY);
-        decoy_tr.setPrecursorMZ(decoy_precursor_mz);
+          ReactionMonitoringTransition decoy_tr = tr; // copy the target transition
 
-        // determine the current annotation for the target ion and then select
-        // the appropriate decoy ion for this target transition
-        std::pair<String, double> targetion = mrmis.annotateIon(target_ionseries, tr.getProductMZ(), product_mz_threshold);
-        std::pair<String, double> decoyion = mrmis.getIon(decoy_ionseries, targetion.first);
+          decoy_tr.setNativeID(decoy_tag + tr.getNativeID());
+          decoy_tr.setDecoyTransitionType(ReactionMonitoringTransition::DECOY);
+          decoy_tr.setPrecursorMZ(decoy_precursor_mz);
 
-        if (method == "shift")
-        {
-          decoy_tr.setProductMZ(decoyion.second + product_mz_shift);
-        }
-        else
-        {
-          decoy_tr.setProductMZ(decoyion.second);
-        }
-        decoy_tr.setPeptideRef(decoy_tag + tr.getPeptideRef());
+          // determine the current annotation for the target ion and then select
+          // the appropriate decoy ion for this target transition
+          std::pair<String, double> targetion = mrmis.annotateIon(target_ionseries, tr.getProductMZ(), product_mz_threshold);
+          std::pair<String, double> decoyion = mrmis.getIon(decoy_ionseries, targetion.first);
 
-        if (decoyion.second > 0)
-        {
-          decoy_transitions.push_back(decoy_tr);
-        }
-        else
-        {
-          // transition could not be annotated, remove whole peptide
-          exclusion_peptides.push_back(decoy_tr.getPeptideRef());
-          OPENMS_LOG_DEBUG << "[peptide] Skipping " << decoy_tr.getPeptideRef() << " due to missing annotation" << std::endl;
-        }
-      } // end loop over transitions
+          if (method == "shift")
+          {
+            decoy_tr.setProductMZ(decoyion.second + product_mz_shift);
+          }
+          else
+          {
+            decoy_tr.setProductMZ(decoyion.second);
+          }
+          decoy_tr.setPeptideRef(decoy_tag + tr.getPeptideRef());
 
-    } // end loop over peptides
+          if (decoyion.second > 0)
+          {
+            peptide_decoy_transitions[p].push_back(decoy_tr);
+          }
+          else
+          {
+            // transition could not be annotated, remove whole peptide
+            peptide_exclusions[p].push_back(decoy_tr.getPeptideRef());
+            OPENMS_LOG_DEBUG << "[peptide] Skipping " << decoy_tr.getPeptideRef() << " due to missing annotation" << std::endl;
+          }
+        } // end loop over transitions
+      } // end loop over peptides
+    }
     endProgress();
 
+    for (Size p = 0; p < pep_its.size(); ++p)
+    {
+      exclusion_peptides.insert(peptide_exclusions[p].begin(), peptide_exclusions[p].end());
+    }
+
     MRMDecoy::TransitionVectorType filtered_decoy_transitions;
-    for (MRMDecoy::TransitionVectorType::iterator tr_it = decoy_transitions.begin(); tr_it != decoy_transitions.end(); ++tr_it)
+    for (MRMDecoy::TransitionVectorType& transitions : peptide_decoy_transitions)
     {
-      if (std::find(exclusion_peptides.begin(), exclusion_peptides.end(), tr_it->getPeptideRef()) == exclusion_peptides.end())
+      for (ReactionMonitoringTransition& tr : transitions)
       {
-        filtered_decoy_transitions.push_back(*tr_it);
+        if (exclusion_peptides.find(tr.getPeptideRef()) == exclusion_peptides.end())
+        {
+          filtered_decoy_transitions.push_back(std::move(tr));
+        }
       }
     }
     dec.setTransitions(filtered_decoy_transitions);
 
-    std::vector<String> protein_ids;
+    boost::unordered_set<String> protein_ids;
     for (Size i = 0; i < peptides.size(); ++i)
     {
-      TargetedExperiment::Peptide peptide = peptides[i];
+      const TargetedExperiment::Peptide& peptide = peptides[i];
 
       // Check if peptide has any transitions left
-      if (std::find(exclusion_peptides.begin(), exclusion_peptides.end(), peptide.id) == exclusion_peptides.end())
+      if (exclusion_peptides.find(peptide.id) == exclusion_peptides.end())
       {
         decoy_peptides.push_back(peptide);
-        for (Size j = 0; j < peptide.protein_refs.size(); ++j)
-        {
-          protein_ids.push_back(peptide.protein_refs[j]);
-        }
+        protein_ids.insert(peptide.protein_refs.begin(), peptide.protein_refs.end());
       }
       else
       {
@@ -594,10 +665,10 @@ namespace OpenMS
 
     for (Size i = 0; i < proteins.size(); ++i)
     {
-      OpenMS::TargetedExperiment::Protein protein = proteins[i];
+      const OpenMS::TargetedExperiment::Protein& protein = proteins[i];
 
       // Check if protein has any peptides left
-      if (find(protein_ids.begin(), protein_ids.end(), protein.id) != protein_ids.end())
+      if (protein_ids.find(protein.id) != protein_ids.end())
       {
         decoy_proteins.push_back(protein);
       }
@@ -613,4 +684,3 @@ namespace OpenMS
   }
 
 }
-
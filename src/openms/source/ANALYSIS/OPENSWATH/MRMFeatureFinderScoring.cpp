@@ -50,6 +50,8 @@
 #include <boost/range/adaptor/map.hpp>
 #include <boost/foreach.hpp>
 
+#include <exception>
+
 #define run_identifier "unique_run_identifier"
 
 bool SortDoubleDoublePairFirst(const std::pair<double, double>& left, const std::pair<double, double>& right)
@@ -228,31 +230,83 @@ namespace OpenMS
     // Step 3
     //
     // Go through all transition groups: first create consensus features, then score them
-    MRMTransitionGroupPicker trgroup_picker;
     Param trgroup_picker_param = param_.copy("TransitionGroupPicker:", true);
     // If use_total_mi_score is defined, we need to instruct MRMTransitionGroupPicker to compute the score
     if (su_.use_total_mi_score_)
     {
       trgroup_picker_param.setValue("compute_total_mi", "true");
     }
-    trgroup_picker.setParameters(trgroup_picker_param);
 
-    Size progress = 0;
-    startProgress(0, transition_group_map.size(), "picking peaks");
+    // The transition groups are independent of each other and are processed
+    // in parallel. The features of each group are collected separately and
+    // appended in the order of the transition group map, so the output does
+    // not depend on the number of threads.
+    std::vector<MRMTransitionGroupType*> transition_groups;
     for (TransitionGroupMapType::iterator trgroup_it = transition_group_map.begin(); trgroup_it != transition_group_map.end(); ++trgroup_it)
     {
-
-      setProgress(++progress);
       MRMTransitionGroupType& transition_group = trgroup_it->second;
       if (transition_group.getChromatograms().empty() || transition_group.getTransitions().empty())
       {
         continue;
       }
+      transition_groups.push_back(&transition_group);
+    }
+    std::vector<FeatureMap> group_features(transition_groups.size());
+
+    Size progress = 0;
+    startProgress(0, transition_groups.size(), "picking peaks");
+    std::exception_ptr error;
+#pragma omp parallel
+    {
+      // Picker, scoring objects and spectrum access are not thread-safe:
+      // every thread works on its own instances (the spectrum addition caches
+      // are synchronized and shared)
+      MRMTransitionGroupPicker trgroup_picker;
+      trgroup_picker.setParameters(trgroup_picker_param);
+
+      MRMFeatureFinderScoring scoring;
+      scoring.setParameters(param_);
+      scoring.setStrictFlag(strict_);
+      scoring.setSpectrumAdditionCaches(ms2_spectrum_cache_, ms1_spectrum_cache_);
+      if (ms1_map_)
+      {
+        scoring.setMS1Map(ms1_map_->lightClone());
+      }
+      scoring.PeptideRefMap_ = PeptideRefMap_;
+
+      std::vector<OpenSwath::SwathMap> thread_swath_maps = swath_maps;
+      for (OpenSwath::SwathMap& m : thread_swath_maps)
+      {
+        if (m.sptr) m.sptr = m.sptr->lightClone();
+      }
 
-      trgroup_picker.pickTransitionGroup(transition_group);
-      scorePeakgroups(trgroup_it->second, trafo, swath_maps, output);
+#pragma omp for schedule(dynamic, 1)
+      for (SignedSize i = 0; i < (SignedSize)transition_groups.size(); ++i)
+      {
+        try
+        {
+          trgroup_picker.pickTransitionGroup(*transition_groups[i]);
+          scoring.scorePeakgroups(*transition_groups[i], trafo, thread_swath_maps, group_features[i]);
+        }
+        catch (...)
+        {
+#pragma omp critical (MRMFeatureFinderScoring_error)
+          if (!error) error = std::current_exception();
+        }
+#pragma omp critical (MRMFeatureFinderScoring_progress)
+        setProgress(++progress);
+      }
     }
     endProgress();
+    if (error) std::rethrow_exception(error);
+
+    for (FeatureMap& features : group_features)
+    {
+      for (Feature& feature : features)
+      {
+        output.push_back(std::move(feature));
+      }
+    }
 
     //output.sortByPosition(); // if the exact same order is needed
     return;
@@ -544,6 +598,7 @@ namespace OpenMS
                       im_extra_drift_,
                       su_,
                       spectrum_addition_method_);
+    scorer.setSpectrumAdditionCaches(ms2_spectrum_cache_, ms1_spectrum_cache_);
 
     ProteaseDigestion pd;
     pd.setEnzyme("Trypsin");
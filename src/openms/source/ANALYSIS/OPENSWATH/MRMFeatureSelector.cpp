@@ -36,6 +36,7 @@
 #include <OpenMS/DATASTRUCTURES/LPWrapper.h>
 #include <OpenMS/KERNEL/FeatureMap.h>
 #include <algorithm>
+#include <exception>
 #include <set>
 
 namespace OpenMS
@@ -145,12 +146,29 @@ namespace OpenMS
   ) const
   {
     result.clear();
-    std::set<String> variables;
+    std::map<String, Int> variables; // name -> column index (avoids lookups in the LP model)
     LPWrapper problem;
     // problem.setSolver(LPWrapper::SOLVER_GLPK); // glpk
     problem.setObjectiveSense(LPWrapper::MIN);
     Size n_constraints = 0;
     Size n_variables = 0;
+
+    // every feature score is needed for each of its neighbours, so compute them once
+    const Size n_score_weights = parameters.score_weights.size();
+    std::vector<std::vector<double>> scores(time_to_name.size());
+    for (Size cnt = 0; cnt < time_to_name.size(); ++cnt)
+    {
+      for (const Feature& feature : feature_name_map.at(time_to_name[cnt].second))
+      {
+        double score = computeScore_(feature, parameters.score_weights);
+        if (n_score_weights > 1)
+        {
+          score = std::pow(score, 1.0 / n_score_weights);
+        }
+        scores[cnt].push_back(score);
+      }
+    }
+
     for (Int cnt1 = 0; static_cast<Size>(cnt1) < time_to_name.size(); ++cnt1)
     {
       const Size start_iter = std::max(cnt1 - parameters.nn_threshold, 0);
@@ -162,26 +180,16 @@ namespace OpenMS
       {
         const String name1 = time_to_name[cnt1].second + "_" + String(feature_row1[i].getUniqueId());
 
-        if (variables.count(name1) == 0)
+        auto var1 = variables.find(name1);
+        if (var1 == variables.end())
         {
-          constraints.push_back(addVariable_(problem, name1, true, 0, parameters.variable_type));
-          variables.insert(name1);
+          var1 = variables.emplace(name1, addVariable_(problem, name1, true, 0, parameters.variable_type)).first;
           ++n_variables;
         }
-        else
-        {
-          constraints.push_back(problem.getColumnIndex(name1));
-        }
+        const Int index1 = var1->second;
+        constraints.push_back(index1);
 
-        double score_1 = computeScore_(feature_row1[i], parameters.score_weights);
-        const Size n_score_weights = parameters.score_weights.size();
-
-        if (n_score_weights > 1)
-        {
-          score_1 = std::pow(score_1, 1.0 / n_score_weights);
-        }
-
-        const Int index1 = problem.getColumnIndex(name1);
+        const double score_1 = scores[cnt1][i];
 
         for (Size cnt2 = start_iter; cnt2 < stop_iter; ++cnt2)
         {
@@ -199,25 +207,20 @@ namespace OpenMS
           for (Size j = 0; j < feature_row2.size(); ++j)
           {
             const String name2 = time_to_name[cnt2].second + "_" + String(feature_row2[j].getUniqueId());
-            if (variables.count(name2) == 0)
+            auto var2 = variables.find(name2);
+            if (var2 == variables.end())
             {
-              addVariable_(problem, name2, true, 0, parameters.variable_type);
-              variables.insert(name2);
+              var2 = variables.emplace(name2, addVariable_(problem, name2, true, 0, parameters.variable_type)).first;
               ++n_variables;
             }
+            const Int index2 = var2->second;
 
             const String var_qp_name = time_to_name[cnt1].second + "_" + String(i) + "-" + time_to_name[cnt2].second + "_" + String(j);
 
             const Int index_var_qp = addVariable_(problem, var_qp_name, true, 0, VariableType::CONTINUOUS);
             const Int index_var_abs = addVariable_(problem, var_qp_name + "-ABS", false, 1, VariableType::CONTINUOUS);
 
-            const Int index2 = problem.getColumnIndex(name2);
-
-            double score_2 = computeScore_(feature_row2[j], parameters.score_weights);
-            if (n_score_weights > 1)
-            {
-              score_2 = std::pow(score_2, 1.0 / n_score_weights);
-            }
+            const double score_2 = scores[cnt2][j];
 
             const double tr_delta = feature_row1[i].getRT() - feature_row2[j].getRT();
             const double score = locality_weight * score_1 * score_2 * (tr_delta - tr_delta_expected);
@@ -325,15 +328,29 @@ namespace OpenMS
     {
       ++n_segments;
     }
+    // the segments are independent problems (each builds its own model), so they are solved concurrently
+    std::vector<std::vector<String>> segment_results(n_segments);
+    std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 1)
+    for (SignedSize i = 0; i < static_cast<SignedSize>(n_segments); ++i)
+    {
+      try
+      {
+        const Size start = step_length * i;
+        const Size end = std::min(start + window_length, time_to_name.size());
+        const std::vector<std::pair<double, String>> time_slice(time_to_name.begin() + start, time_to_name.begin() + end);
+        optimize(time_slice, feature_name_map, segment_results[i], parameters);
+      }
+      catch (...)
+      {
+#pragma omp critical (MRMFeatureSelector_error)
+        if (!error) error = std::current_exception();
+      }
+    }
+    if (error) std::rethrow_exception(error);
     std::vector<String> result_names;
-
-    for (Size i = 0; i < n_segments; ++i)
+    for (const std::vector<String>& result : segment_results)
     {
-      const Size start = step_length * i;
-      const Size end = std::min(start + window_length, time_to_name.size());
-      const std::vector<std::pair<double, String>> time_slice(time_to_name.begin() + start, time_to_name.begin() + end);
-      std::vector<String> result;
-      optimize(time_slice, feature_name_map, result, parameters);
       result_names.insert(result_names.end(), result.begin(), result.end());
     }
     const std::set<String> result_names_set(result_names.begin(), result_names.end());
@@ -34,6 +34,10 @@
 
 #include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathHelper.h>
 
+#include <algorithm>
+#include <functional>
+#include <queue>
+
 namespace OpenMS
 {
   void OpenSwathHelper::selectSwathTransitions(const OpenMS::TargetedExperiment& targeted_exp,
@@ -125,6 +129,74 @@ namespace OpenMS
     }
   }
 
+  void OpenSwathHelper::selectShard(const OpenSwath::LightTargetedExperiment& targeted_exp,
+                                    OpenSwath::LightTargetedExperiment& shard,
+                                    Size shard_index, Size shard_count)
+  {
+    if (shard_index >= shard_count)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "Shard index " + String(shard_index) + " is out of range for " + String(shard_count) + " shards.");
+    }
+
+    std::map<std::string, Size> nr_transitions;
+    for (const OpenSwath::LightTransition& tr : targeted_exp.transitions)
+    {
+      ++nr_transitions[tr.getPeptideRef()];
+    }
+
+    // balance the shards by library size: largest compounds first, each to the currently smallest shard
+    const std::vector<OpenSwath::LightCompound>& compounds = targeted_exp.compounds;
+    std::vector<std::pair<Size, Size> > order; // (number of transitions, compound index)
+    order.reserve(compounds.size());
+    for (Size i = 0; i < compounds.size(); ++i)
+    {
+      order.push_back(std::make_pair(nr_transitions[compounds[i].id], i));
+    }
+    std::stable_sort(order.begin(), order.end(),
+      [](const std::pair<Size, Size>& a, const std::pair<Size, Size>& b) { return a.first > b.first; });
+
+    typedef std::pair<Size, Size> ShardLoad; // (number of transitions, shard index)
+    std::priority_queue<ShardLoad, std::vector<ShardLoad>, std::greater<ShardLoad> > loads;
+    for (Size s = 0; s < shard_count; ++s)
+    {
+      loads.push(ShardLoad(0, s));
+    }
+    std::vector<bool> selected(compounds.size(), false);
+    for (const std::pair<Size, Size>& compound : order)
+    {
+      ShardLoad smallest = loads.top();
+      loads.pop();
+      selected[compound.second] = (smallest.second == shard_index);
+      smallest.first += compound.first;
+      loads.push(smallest);
+    }
+
+    std::set<std::string> matching_compounds;
+    std::set<std::string> matching_proteins;
+    for (Size i = 0; i < compounds.size(); ++i)
+    {
+      if (!selected[i]) continue;
+      shard.compounds.push_back(compounds[i]);
+      matching_compounds.insert(compounds[i].id);
+      matching_proteins.insert(compounds[i].protein_refs.begin(), compounds[i].protein_refs.end());
+    }
+    for (const OpenSwath::LightTransition& tr : targeted_exp.transitions)
+    {
+      if (matching_compounds.find(tr.getPeptideRef()) != matching_compounds.end())
+      {
+        shard.transitions.push_back(tr);
+      }
+    }
+    for (const OpenSwath::LightProtein& protein : targeted_exp.proteins)
+    {
+      if (matching_proteins.find(protein.id) != matching_proteins.end())
+      {
+        shard.proteins.push_back(protein);
+      }
+    }
+  }
+
   std::pair<double,double> OpenSwathHelper::estimateRTRange(const OpenSwath::LightTargetedExperiment & exp)
   {
     if (exp.getCompounds().empty()) 
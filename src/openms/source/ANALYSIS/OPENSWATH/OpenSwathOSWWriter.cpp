@@ -35,12 +35,118 @@
 #include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathOSWWriter.h>
 
 #include <OpenMS/FORMAT/SqliteConnector.h>
+#include <OpenMS/CONCEPT/LogStream.h>
 
 #include <sqlite3.h>
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
 namespace OpenMS
 {
 
+  struct OpenSwathOSWWriter::AsyncWriter_
+  {
+    std::mutex mutex;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+    std::deque<std::vector<String> > queue;
+    Size max_queued;
+    bool done;
+    std::exception_ptr error;
+    std::thread thread;
+
+    explicit AsyncWriter_(Size max_queued_batches) :
+      max_queued(std::max(max_queued_batches, Size(1))),
+      done(false)
+    {
+    }
+
+    void run(const String& filename)
+    {
+      try
+      {
+        SqliteConnector conn(filename);
+        // readers expect a self-contained file, so WAL mode is only used while writing
+        conn.executeStatement("PRAGMA journal_mode = WAL");
+        std::vector<std::vector<String> > batches;
+        while (true)
+        {
+          {
+            std::unique_lock<std::mutex> lock(mutex);
+            not_empty.wait(lock, [this] { return done || !queue.empty(); });
+            if (queue.empty()) break; // done and nothing left
+            batches.assign(std::make_move_iterator(queue.begin()), std::make_move_iterator(queue.end()));
+            queue.clear();
+          }
+          not_full.notify_all();
+
+          // everything that piled up goes into a single transaction
+          conn.executeStatement("BEGIN TRANSACTION");
+          for (const auto& batch : batches)
+          {
+            for (const auto& statement : batch)
+            {
+              conn.executeStatement(statement);
+            }
+          }
+          conn.executeStatement("END TRANSACTION");
+          batches.clear();
+        }
+        conn.executeStatement("PRAGMA journal_mode = DELETE");
+      }
+      catch (...)
+      {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          error = std::current_exception();
+          queue.clear();
+        }
+        not_full.notify_all();
+      }
+    }
+  };
+
+  OpenSwathOSWWriter::~OpenSwathOSWWriter()
+  {
+    try
+    {
+      finishAsyncWriting();
+    }
+    catch (Exception::BaseException& e)
+    {
+      OPENMS_LOG_ERROR << "Error writing OSW output " << output_filename_ << ": " << e.what() << std::endl;
+    }
+    catch (...)
+    {
+      OPENMS_LOG_ERROR << "Error writing OSW output " << output_filename_ << std::endl;
+    }
+  }
+
+  void OpenSwathOSWWriter::startAsyncWriting(Size max_queued_batches)
+  {
+    if (!doWrite_ || async_) return;
+    async_ = std::make_shared<AsyncWriter_>(max_queued_batches);
+    async_->thread = std::thread(&AsyncWriter_::run, async_.get(), output_filename_);
+  }
+
+  void OpenSwathOSWWriter::finishAsyncWriting()
+  {
+    if (!async_) return;
+    {
+      std::lock_guard<std::mutex> lock(async_->mutex);
+      async_->done = true;
+    }
+    async_->not_empty.notify_all();
+    async_->thread.join();
+    std::exception_ptr error = async_->error;
+    async_.reset();
+    if (error) std::rethrow_exception(error);
+  }
+
   bool OpenSwathOSWWriter::isActive() const
   {
     return doWrite_;
@@ -470,6 +576,18 @@ namespace OpenMS
 
   void OpenSwathOSWWriter::writeLines(const std::vector<String>& to_osw_output)
   {
+    if (async_)
+    {
+      {
+        std::unique_lock<std::mutex> lock(async_->mutex);
+        async_->not_full.wait(lock, [this] { return async_->queue.size() < async_->max_queued || async_->error; });
+        if (async_->error) std::rethrow_exception(async_->error);
+        async_->queue.push_back(to_osw_output);
+      }
+      async_->not_empty.notify_one();
+      return;
+    }
+
     SqliteConnector conn(output_filename_);
     conn.executeStatement("BEGIN TRANSACTION");
     for (Size i = 0; i < to_osw_output.size(); i++)
@@ -126,6 +126,12 @@ namespace OpenMS
     this->su_ = su;
   }
 
+  void OpenSwathScoring::setSpectrumAdditionCaches(SpectrumAdditionCachePtr ms2_cache, SpectrumAdditionCachePtr ms1_cache)
+  {
+    ms2_spectrum_cache_ = ms2_cache;
+    ms1_spectrum_cache_ = ms1_cache;
+  }
+
   void OpenSwathScoring::calculateDIAScores(OpenSwath::IMRMFeature* imrmfeature,
                                             const std::vector<TransitionType>& transitions,
                                             const std::vector<OpenSwath::SwathMap>& swath_maps,
@@ -499,7 +505,7 @@ namespace OpenMS
   OpenSwath::SpectrumPtr OpenSwathScoring::fetchSpectrumSwath(OpenSwath::SpectrumAccessPtr swath_map,
                                                               double RT, int nr_spectra_to_add, const double drift_lower, const double drift_upper)
   {
-    return getAddedSpectra_(swath_map, RT, nr_spectra_to_add, drift_lower, drift_upper);
+    return getAddedSpectra_(swath_map, RT, nr_spectra_to_add, drift_lower, drift_upper, ms1_spectrum_cache_.get());
   }
 
   OpenSwath::SpectrumPtr OpenSwathScoring::fetchSpectrumSwath(std::vector<OpenSwath::SwathMap> swath_maps,
@@ -507,7 +513,7 @@ namespace OpenMS
   {
     if (swath_maps.size() == 1)
     {
-      return getAddedSpectra_(swath_maps[0].sptr, RT, nr_spectra_to_add, drift_lower, drift_upper);
+      return getAddedSpectra_(swath_maps[0].sptr, RT, nr_spectra_to_add, drift_lower, drift_upper, ms2_spectrum_cache_.get());
     }
     else
     {
@@ -572,7 +578,8 @@ namespace OpenMS
 
 
   OpenSwath::SpectrumPtr OpenSwathScoring::getAddedSpectra_(OpenSwath::SpectrumAccessPtr swath_map,
-                                                            double RT, int nr_spectra_to_add, const double drift_lower, const double drift_upper)
+                                                            double RT, int nr_spectra_to_add, const double drift_lower, const double drift_upper,
+                                                            SpectrumAdditionCache* cache)
   {
     std::vector<std::size_t> indices = swath_map->getSpectraByRT(RT, 0.0);
     OpenSwath::SpectrumPtr added_spec(new OpenSwath::Spectrum);
@@ -591,6 +598,14 @@ namespace OpenMS
       closest_idx--;
     }
 
+    // peak groups close in RT share the same added-up spectrum
+    SpectrumAdditionCache::Key cache_key = {closest_idx, nr_spectra_to_add, drift_lower, drift_upper};
+    if (cache != nullptr)
+    {
+      OpenSwath::SpectrumPtr cached = cache->get(cache_key);
+      if (cached) return cached;
+    }
+
     if (nr_spectra_to_add == 1)
     {
       added_spec = swath_map->getSpectrumById(closest_idx);
@@ -660,6 +675,10 @@ namespace OpenMS
            added_spec->getMZArray()->data.end(), std::greater<double>()) == added_spec->getMZArray()->data.end(),
            "Postcondition violated: m/z vector needs to be sorted!" )
 
+    if (cache != nullptr)
+    {
+      cache->insert(cache_key, added_spec);
+    }
     return added_spec;
   }
 
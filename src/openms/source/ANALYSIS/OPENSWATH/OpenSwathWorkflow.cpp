@@ -34,6 +34,11 @@
 
 #include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathWorkflow.h>
 
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessIonMobilityIndexed.h>
+#include <OpenMS/CONCEPT/Profiler.h>
+
+#include <future>
+
 // OpenSwathCalibrationWorkflow
 namespace OpenMS
 {
@@ -454,8 +459,11 @@ namespace OpenMS
     int ms1_isotopes,
     bool load_into_memory)
   {
+    OPENMS_PROFILE_SCOPE("OpenSwathWorkflow::performExtraction");
     tsv_writer.writeHeader();
     osw_writer.writeHeader();
+    // scoring threads only queue their OSW output, a background thread writes it
+    osw_writer.startAsyncWriting();
 
     bool ms1_only = (swath_maps.size() == 1 && swath_maps[0].ms1);
 
@@ -538,206 +546,336 @@ namespace OpenMS
     }
 
     // (iii) Perform extraction and scoring of fragment ion chromatograms (MS2)
-    // We set dynamic scheduling such that the maps are worked on in the order
-    // in which they were given to the program / acquired. This gives much
-    // better load balancing than static allocation.
-#ifdef _OPENMP
-#ifdef MT_ENABLE_NESTED_OPENMP
-    int total_nr_threads = omp_get_max_threads(); // store total number of threads we are allowed to use
-    if (threads_outer_loop_ > -1)
-    {
-      std::cout << "Setting up nested loop with " << std::min(threads_outer_loop_, omp_get_max_threads()) << " threads out of "<< omp_get_max_threads() << std::endl;
-      omp_set_nested(1);
-      omp_set_dynamic(0);
-      omp_set_num_threads(std::min(threads_outer_loop_, omp_get_max_threads()) ); // use at most threads_outer_loop_ threads here
-    }
-    else
-    {
-      std::cout << "Use non-nested loop with " << total_nr_threads << " threads." << std::endl;
-    }
-#endif
-#pragma omp parallel for schedule(dynamic,1)
-#endif
-    for (SignedSize i = 0; i < boost::numeric_cast<SignedSize>(swath_maps.size()); ++i)
+
+    // Step 1: select which transitions to extract for SWATH window "i"
+    auto selectWindowTransitions = [&](SignedSize i, OpenSwath::LightTargetedExperiment& transition_exp_used_all)
     {
-      if (!swath_maps[i].ms1) // skip MS1
+      if (!prm_)
       {
-
-        // Step 1: select which transitions to extract (proceed in batches)
-        OpenSwath::LightTargetedExperiment transition_exp_used_all;
-        if (!prm_)
-        {
-          // Step 1.1: select transitions matching the window
-          OpenSwathHelper::selectSwathTransitions(transition_exp, transition_exp_used_all,
-              cp.min_upper_edge_dist, swath_maps[i].lower, swath_maps[i].upper);
-        }
-        else
+        // Step 1.1: select transitions matching the window
+        OpenSwathHelper::selectSwathTransitions(transition_exp, transition_exp_used_all,
+            cp.min_upper_edge_dist, swath_maps[i].lower, swath_maps[i].upper);
+      }
+      else
+      {
+        // Step 1.2: select transitions based on matching PRM window (best window)
+        std::set<std::string> matching_compounds;
+        for (Size k = 0; k < prm_map.size(); k++)
         {
-          // Step 1.2: select transitions based on matching PRM window (best window)
-          std::set<std::string> matching_compounds;
-          for (Size k = 0; k < prm_map.size(); k++)
+          if (prm_map[k] == i)
           {
-            if (prm_map[k] == i)
-            {
-               const OpenSwath::LightTransition& tr = transition_exp.transitions[k];
-               transition_exp_used_all.transitions.push_back(tr);
-               matching_compounds.insert(tr.getPeptideRef());
-            }
+             const OpenSwath::LightTransition& tr = transition_exp.transitions[k];
+             transition_exp_used_all.transitions.push_back(tr);
+             matching_compounds.insert(tr.getPeptideRef());
           }
+        }
 
-          std::set<std::string> matching_proteins;
-          for (Size i = 0; i < transition_exp.compounds.size(); i++)
+        std::set<std::string> matching_proteins;
+        for (Size i = 0; i < transition_exp.compounds.size(); i++)
+        {
+          if (matching_compounds.find(transition_exp.compounds[i].id) != matching_compounds.end())
           {
-            if (matching_compounds.find(transition_exp.compounds[i].id) != matching_compounds.end())
+            transition_exp_used_all.compounds.push_back( transition_exp.compounds[i] );
+            for (Size j = 0; j < transition_exp.compounds[i].protein_refs.size(); j++)
             {
-              transition_exp_used_all.compounds.push_back( transition_exp.compounds[i] );
-              for (Size j = 0; j < transition_exp.compounds[i].protein_refs.size(); j++)
-              {
-                matching_proteins.insert(transition_exp.compounds[i].protein_refs[j]);
-              }
+              matching_proteins.insert(transition_exp.compounds[i].protein_refs[j]);
             }
           }
-          for (Size i = 0; i < transition_exp.proteins.size(); i++)
+        }
+        for (Size i = 0; i < transition_exp.proteins.size(); i++)
+        {
+          if (matching_proteins.find(transition_exp.proteins[i].id) != matching_proteins.end())
           {
-            if (matching_proteins.find(transition_exp.proteins[i].id) != matching_proteins.end())
-            {
-              transition_exp_used_all.proteins.push_back( transition_exp.proteins[i] );
-            }
+            transition_exp_used_all.proteins.push_back( transition_exp.proteins[i] );
           }
         }
+      }
+    };
 
-        if (transition_exp_used_all.getTransitions().size() > 0) // skip if no transitions found
+    // Size of the batches in which the compounds of a single window are processed
+    auto computeBatchSize = [&](const OpenSwath::LightTargetedExperiment& transition_exp_used_all)
+    {
+      if (batchSize <= 0 || batchSize >= (int)transition_exp_used_all.getCompounds().size())
+      {
+        return (int)transition_exp_used_all.getCompounds().size();
+      }
+      return batchSize;
+    };
+
+    // Added-up spectra around peak group apices are shared between all
+    // batches of a window (and between all windows for the MS1 map) since
+    // peak groups of different compounds often use the same spectra
+    SpectrumAdditionCachePtr ms1_spectrum_cache;
+    if (ms1_map_ != nullptr) ms1_spectrum_cache.reset(new SpectrumAdditionCache);
+
+    // Steps 2 - 4: extract, score and write out batch "pep_idx" of SWATH window "i"
+    auto processBatch = [&](SignedSize i, OpenSwath::SpectrumAccessPtr current_swath_map_inner,
+        const OpenSwath::LightTargetedExperiment& transition_exp_used_all, int batch_size,
+        SignedSize pep_idx, SignedSize nr_batches, SpectrumAdditionCachePtr ms2_spectrum_cache)
+    {
+#ifdef _OPENMP
+#pragma omp critical (osw_write_stdout)
+#endif
+      {
+        std::cout << "Thread " <<
+#ifdef _OPENMP
+        omp_get_thread_num() << "_0 " <<
+#else
+        "0" << 
+#endif
+        "will analyze " << transition_exp_used_all.getCompounds().size() <<  " compounds and "
+        << transition_exp_used_all.getTransitions().size() <<  " transitions "
+        "from SWATH " << i << " (batch " << pep_idx << " out of " << nr_batches << ")" << std::endl;
+      }
+
+      OPENMS_PROFILE_SCOPE("OpenSwathWorkflow::processBatch");
+
+      // Create the new, batch-size transition experiment
+      OpenSwath::LightTargetedExperiment transition_exp_used;
+      selectCompoundsForBatch_(transition_exp_used_all, transition_exp_used, batch_size, pep_idx);
+      Profiler::addCounter("OpenSwathWorkflow::compounds", transition_exp_used.getCompounds().size());
+      Profiler::addCounter("OpenSwathWorkflow::transitions", transition_exp_used.getTransitions().size());
+
+      // Extract MS1 chromatograms for this batch
+      std::vector< MSChromatogram > ms1_chromatograms;
+      if (ms1_map_ != nullptr) 
+      {
+        OPENMS_PROFILE_SCOPE("OpenSwathWorkflow::extractMS1");
+        OpenSwath::SpectrumAccessPtr threadsafe_ms1 = ms1_map_->lightClone();
+        MS1Extraction_(threadsafe_ms1, swath_maps, ms1_chromatograms, chromConsumer, ms1_cp,
+            transition_exp_used, trafo_inverse, ms1_only, ms1_isotopes);
+      }
+
+      // Step 2.1: extract these transitions
+      PeakMap chrom_exp;
+      {
+        OPENMS_PROFILE_SCOPE("OpenSwathWorkflow::extractMS2");
+        ChromatogramExtractor extractor;
+        std::vector< OpenSwath::ChromatogramPtr > chrom_list;
+        std::vector< ChromatogramExtractor::ExtractionCoordinates > coordinates;
+
+        // Step 2.2: prepare the extraction coordinates and extract chromatograms
+        // chrom_list contains one entry for each fragment ion (transition) in transition_exp_used
+        prepareExtractionCoordinates_(chrom_list, coordinates, transition_exp_used, trafo_inverse, cp);
+        extractor.extractChromatograms(current_swath_map_inner, chrom_list, coordinates, cp.mz_extraction_window,
+            cp.ppm, cp.im_extraction_window, cp.extraction_function);
+
+        // Step 2.3: convert chromatograms back to OpenMS::MSChromatogram and write to output
+        extractor.return_chromatogram(chrom_list, coordinates, transition_exp_used,  SpectrumSettings(), 
+                                      chrom_exp.getChromatograms(), false, cp.im_extraction_window);
+      }
+
+      // Step 3: score these extracted transitions
+      FeatureMap featureFile;
+      {
+        OPENMS_PROFILE_SCOPE("OpenSwathWorkflow::score");
+        std::vector< OpenSwath::SwathMap > tmp = {swath_maps[i]};
+        tmp.back().sptr = current_swath_map_inner;
+        scoreAllChromatograms_(chrom_exp.getChromatograms(), ms1_chromatograms, tmp, transition_exp_used,
+            feature_finder_param, trafo, cp.rt_extraction_window, featureFile, tsv_writer, osw_writer, ms1_isotopes,
+            false, ms2_spectrum_cache, ms1_spectrum_cache);
+      }
+
+      // Step 4: write all chromatograms and features out into an output object / file
+      // (this needs to be done in a critical section since we only have one
+      // output file and one output map).
+      OPENMS_PROFILE_SCOPE("OpenSwathWorkflow::writeOut");
+#ifdef _OPENMP
+#pragma omp critical (osw_write_out)
+#endif
+      {
+        writeOutFeaturesAndChroms_(chrom_exp.getChromatograms(), featureFile, out_featureFile, store_features, chromConsumer);
+      }
+    };
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+    // Every batch of compounds of a SWATH window is an OpenMP task. A single
+    // thread prepares the windows in the order in which they were given to
+    // the program / acquired and creates the tasks for each batch, idle
+    // threads pick up the next pending batch from any window. This keeps all
+    // threads busy even though windows differ a lot in the number of
+    // transitions, and extraction / scoring of one window overlaps with
+    // preparing (and loading) the next one.
+    //
+    // Preparing a window may load its data into memory, so the number of
+    // windows in flight is bounded by threads_outer_loop_ (if set) or by the
+    // number of threads when loading into memory.
+    struct SwathWindowTask
+    {
+      OpenSwath::LightTargetedExperiment transition_exp_used_all;
+      OpenSwath::SpectrumAccessPtr swath_map;
+      SpectrumAdditionCachePtr spectrum_cache;
+      int batch_size;
+      SignedSize nr_batches;
+      SignedSize remaining_batches;
+    };
+
+    SignedSize max_windows_in_flight = boost::numeric_cast<SignedSize>(swath_maps.size());
+    if (threads_outer_loop_ > 0) max_windows_in_flight = threads_outer_loop_;
+    else if (load_into_memory) max_windows_in_flight = omp_get_max_threads();
+    max_windows_in_flight = std::max(max_windows_in_flight, SignedSize(1));
+
+    // When loading windows into memory, the next SWATH window is decoded in
+    // a background thread while the current one is being extracted and
+    // scored, which overlaps most of the I/O with compute. At most one
+    // window is prefetched in addition to the windows in flight.
+    auto loadIntoMemory = [&swath_maps, &cp](SignedSize map_idx) -> OpenSwath::SpectrumAccessPtr
+    {
+      OpenSwath::SpectrumAccessPtr origin = swath_maps[map_idx].sptr->lightClone();
+      if (cp.im_extraction_window > 0.0)
+      {
+        // index the frames by ion mobility for faster extraction
+        return boost::shared_ptr<SpectrumAccessIonMobilityIndexed>( new SpectrumAccessIonMobilityIndexed(*origin) );
+      }
+      return boost::shared_ptr<SpectrumAccessOpenMSInMemory>( new SpectrumAccessOpenMSInMemory(*origin) );
+    };
+    auto nextMS2Map = [&swath_maps](SignedSize map_idx) -> SignedSize
+    {
+      for (++map_idx; map_idx < boost::numeric_cast<SignedSize>(swath_maps.size()); ++map_idx)
+      {
+        if (!swath_maps[map_idx].ms1) return map_idx;
+      }
+      return -1;
+    };
+
+#pragma omp parallel
+#pragma omp single
+    {
+      SignedSize windows_in_flight = 0;
+      SignedSize prefetched_idx = -1;
+      std::future<OpenSwath::SpectrumAccessPtr> prefetched_map;
+      auto prefetchAfter = [&](SignedSize map_idx)
+      {
+        // replacing the future waits for a pending (now unused) prefetch
+        prefetched_idx = nextMS2Map(map_idx);
+        prefetched_map = std::future<OpenSwath::SpectrumAccessPtr>();
+        if (prefetched_idx >= 0)
         {
+          prefetched_map = std::async(std::launch::async, loadIntoMemory, prefetched_idx);
+        }
+      };
+      for (SignedSize i = 0; i < boost::numeric_cast<SignedSize>(swath_maps.size()); ++i)
+      {
+        boost::shared_ptr<SwathWindowTask> window(new SwathWindowTask);
+        if (!swath_maps[i].ms1) // skip MS1
+        {
+          selectWindowTransitions(i, window->transition_exp_used_all);
+        }
 
-          OpenSwath::SpectrumAccessPtr current_swath_map = swath_maps[i].sptr;
-          if (load_into_memory)
-          {
-            // This creates an InMemory object that keeps all data in memory
-            current_swath_map = boost::shared_ptr<SpectrumAccessOpenMSInMemory>( new SpectrumAccessOpenMSInMemory(*current_swath_map) );
-          }
+        if (window->transition_exp_used_all.getTransitions().empty()) // skip if no transitions found
+        {
+          if (load_into_memory && prefetched_idx == i) prefetchAfter(i);
+#pragma omp critical (progress)
+          this->setProgress(++progress);
+          continue;
+        }
 
-          int batch_size;
-          if (batchSize <= 0 || batchSize >= (int)transition_exp_used_all.getCompounds().size())
+        if (windows_in_flight >= max_windows_in_flight)
+        {
+          // wait for all batches created so far (this thread also works on them)
+#pragma omp taskwait
+          windows_in_flight = 0;
+        }
+        ++windows_in_flight;
+
+        window->swath_map = swath_maps[i].sptr;
+        if (load_into_memory)
+        {
+          // This creates an InMemory object that keeps all data in memory
+          if (prefetched_idx == i)
           {
-            batch_size = transition_exp_used_all.getCompounds().size();
+            window->swath_map = prefetched_map.get();
           }
           else
           {
-            batch_size = batchSize;
+            window->swath_map = loadIntoMemory(i);
           }
 
-          SignedSize nr_batches = (transition_exp_used_all.getCompounds().size() / batch_size);
+          // start decoding the next window in the background
+          prefetchAfter(i);
+        }
+        window->spectrum_cache.reset(new SpectrumAdditionCache);
+        window->batch_size = computeBatchSize(window->transition_exp_used_all);
+        window->nr_batches = (window->transition_exp_used_all.getCompounds().size() / window->batch_size);
+        window->remaining_batches = window->nr_batches + 1;
 
-#ifdef _OPENMP
-#ifdef MT_ENABLE_NESTED_OPENMP
-          // If we have a multiple of threads_outer_loop_ here, then use nested
-          // parallelization here. E.g. if we use 8 threads for the outer loop,
-          // but we have a total of 24 cores available, each of the 8 threads
-          // will then create a team of 3 threads to work on the batches
-          // individually.
-          //
-          // We should avoid oversubscribing the CPUs, therefore we use integer division.
-          // -- see https://docs.oracle.com/cd/E19059-01/stud.10/819-0501/2_nested.html
-          int outer_thread_nr = omp_get_thread_num();
-          omp_set_num_threads(std::max(1, total_nr_threads / threads_outer_loop_) );
-#pragma omp parallel for schedule(dynamic, 1)
-#endif
-#endif
-          for (SignedSize pep_idx = 0; pep_idx <= nr_batches; pep_idx++)
+        for (SignedSize pep_idx = 0; pep_idx <= window->nr_batches; pep_idx++)
+        {
+#pragma omp task firstprivate(i, pep_idx, window)
           {
-            OpenSwath::SpectrumAccessPtr current_swath_map_inner = current_swath_map;
-
-#ifdef _OPENMP
-#ifdef MT_ENABLE_NESTED_OPENMP
             // To ensure multi-threading safe access to the individual spectra, we
             // need to use a light clone of the spectrum access (if multiple threads
             // share a single filestream and call seek on it, chaos will ensue).
-            if (total_nr_threads / threads_outer_loop_ > 1)
-            {
-              current_swath_map_inner = current_swath_map->lightClone();
-            }
-#endif
-#pragma omp critical (osw_write_stdout)
-#endif
-            {
-              std::cout << "Thread " <<
-#ifdef _OPENMP
-#ifdef MT_ENABLE_NESTED_OPENMP
-              outer_thread_nr << "_" << omp_get_thread_num() << " " <<
-#else
-              omp_get_thread_num() << "_0 " <<
-#endif
-#else
-              "0" << 
-#endif
-              "will analyze " << transition_exp_used_all.getCompounds().size() <<  " compounds and "
-              << transition_exp_used_all.getTransitions().size() <<  " transitions "
-              "from SWATH " << i << " (batch " << pep_idx << " out of " << nr_batches << ")" << std::endl;
-            }
+            // The in-memory object is read-only and can be shared directly.
+            OpenSwath::SpectrumAccessPtr current_swath_map_inner =
+              load_into_memory ? window->swath_map : window->swath_map->lightClone();
 
-            // Create the new, batch-size transition experiment
-            OpenSwath::LightTargetedExperiment transition_exp_used;
-            selectCompoundsForBatch_(transition_exp_used_all, transition_exp_used, batch_size, pep_idx);
+            processBatch(i, current_swath_map_inner, window->transition_exp_used_all,
+                         window->batch_size, pep_idx, window->nr_batches, window->spectrum_cache);
 
-            // Extract MS1 chromatograms for this batch
-            std::vector< MSChromatogram > ms1_chromatograms;
-            if (ms1_map_ != nullptr) 
+            SignedSize remaining;
+#pragma omp atomic capture
+            remaining = --window->remaining_batches;
+            if (remaining == 0)
             {
-              OpenSwath::SpectrumAccessPtr threadsafe_ms1 = ms1_map_->lightClone();
-              MS1Extraction_(threadsafe_ms1, swath_maps, ms1_chromatograms, chromConsumer, ms1_cp,
-                  transition_exp_used, trafo_inverse, ms1_only, ms1_isotopes);
+#pragma omp critical (progress)
+              this->setProgress(++progress);
             }
+          }
+        }
+      }
+    } // implicit barrier: all tasks are done here
+#else
+    // We set dynamic scheduling such that the maps are worked on in the order
+    // in which they were given to the program / acquired. This gives much
+    // better load balancing than static allocation.
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,1)
+#endif
+    for (SignedSize i = 0; i < boost::numeric_cast<SignedSize>(swath_maps.size()); ++i)
+    {
+      if (!swath_maps[i].ms1) // skip MS1
+      {
+        // Step 1: select which transitions to extract (proceed in batches)
+        OpenSwath::LightTargetedExperiment transition_exp_used_all;
+        selectWindowTransitions(i, transition_exp_used_all);
 
-            // Step 2.1: extract these transitions
-            ChromatogramExtractor extractor;
-            std::vector< OpenSwath::ChromatogramPtr > chrom_list;
-            std::vector< ChromatogramExtractor::ExtractionCoordinates > coordinates;
-
-            // Step 2.2: prepare the extraction coordinates and extract chromatograms
-            // chrom_list contains one entry for each fragment ion (transition) in transition_exp_used
-            prepareExtractionCoordinates_(chrom_list, coordinates, transition_exp_used, trafo_inverse, cp);
-            extractor.extractChromatograms(current_swath_map_inner, chrom_list, coordinates, cp.mz_extraction_window,
-                cp.ppm, cp.im_extraction_window, cp.extraction_function);
-
-            // Step 2.3: convert chromatograms back to OpenMS::MSChromatogram and write to output
-            PeakMap chrom_exp;
-            extractor.return_chromatogram(chrom_list, coordinates, transition_exp_used,  SpectrumSettings(), 
-                                          chrom_exp.getChromatograms(), false, cp.im_extraction_window);
+        if (transition_exp_used_all.getTransitions().size() > 0) // skip if no transitions found
+        {
 
+          OpenSwath::SpectrumAccessPtr current_swath_map = swath_maps[i].sptr;
+          if (load_into_memory && cp.im_extraction_window > 0.0)
+          {
+            // This creates an InMemory object with an ion mobility index for each frame
+            current_swath_map = boost::shared_ptr<SpectrumAccessIonMobilityIndexed>( new SpectrumAccessIonMobilityIndexed(*current_swath_map) );
+          }
+          else if (load_into_memory)
+          {
+            // This creates an InMemory object that keeps all data in memory
+            current_swath_map = boost::shared_ptr<SpectrumAccessOpenMSInMemory>( new SpectrumAccessOpenMSInMemory(*current_swath_map) );
+          }
 
-            // Step 3: score these extracted transitions
-            FeatureMap featureFile;
-            std::vector< OpenSwath::SwathMap > tmp = {swath_maps[i]};
-            tmp.back().sptr = current_swath_map_inner;
-            scoreAllChromatograms_(chrom_exp.getChromatograms(), ms1_chromatograms, tmp, transition_exp_used,
-                feature_finder_param, trafo, cp.rt_extraction_window, featureFile, tsv_writer, osw_writer, ms1_isotopes);
+          int batch_size = computeBatchSize(transition_exp_used_all);
+          SignedSize nr_batches = (transition_exp_used_all.getCompounds().size() / batch_size);
 
-            // Step 4: write all chromatograms and features out into an output object / file
-            // (this needs to be done in a critical section since we only have one
-            // output file and one output map).
-            #pragma omp critical (osw_write_out)
-            {
-              writeOutFeaturesAndChroms_(chrom_exp.getChromatograms(), featureFile, out_featureFile, store_features, chromConsumer);
-            }
+          SpectrumAdditionCachePtr spectrum_cache(new SpectrumAdditionCache);
+          for (SignedSize pep_idx = 0; pep_idx <= nr_batches; pep_idx++)
+          {
+            processBatch(i, current_swath_map, transition_exp_used_all, batch_size, pep_idx, nr_batches, spectrum_cache);
           }
 
         } // continue 2 (no continue due to OpenMP)
       } // continue 1 (no continue due to OpenMP)
 
-      #pragma omp critical (progress)
+#ifdef _OPENMP
+#pragma omp critical (progress)
+#endif
       this->setProgress(++progress);
 
     }
+#endif
     this->endProgress();
-    
-#ifdef _OPENMP
-#ifdef MT_ENABLE_NESTED_OPENMP
-    if (threads_outer_loop_ > -1)
-    {
-      omp_set_num_threads(total_nr_threads); // set number of available threads back to initial value
-    }
-#endif    
-#endif    
+    osw_writer.finishAsyncWriting();
   }
 
   void OpenSwathWorkflow::writeOutFeaturesAndChroms_(
@@ -823,7 +961,9 @@ namespace OpenMS
     OpenSwathTSVWriter & tsv_writer,
     OpenSwathOSWWriter & osw_writer,
     int nr_ms1_isotopes,
-    bool ms1only) const
+    bool ms1only,
+    SpectrumAdditionCachePtr ms2_spectrum_cache,
+    SpectrumAdditionCachePtr ms1_spectrum_cache) const
   {
     TransformationDescription trafo_inv = trafo;
     trafo_inv.invert();
@@ -855,6 +995,7 @@ namespace OpenMS
 
     featureFinder.setParameters(feature_finder_param);
     featureFinder.prepareProteinPeptideMaps_(transition_exp);
+    featureFinder.setSpectrumAdditionCaches(ms2_spectrum_cache, ms1_spectrum_cache);
 
     // Map ms1 chromatogram id to sequence number
     std::map<String, int> ms1_chromatogram_map;
@@ -1096,6 +1237,7 @@ namespace OpenMS
     {
       tsv_writer.writeHeader();
       osw_writer.writeHeader();
+      osw_writer.startAsyncWriting();
 
       // Compute inversion of the transformation
       TransformationDescription trafo_inverse = trafo;
@@ -1258,6 +1400,7 @@ namespace OpenMS
         this->setProgress(++progress);
       }
       this->endProgress();
+      osw_writer.finishAsyncWriting();
     }
 
 
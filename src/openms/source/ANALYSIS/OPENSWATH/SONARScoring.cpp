@@ -78,6 +78,12 @@ namespace OpenMS
     /// Cross Correlation matrix
     typedef std::vector<std::vector<XCorrArrayType> > XCorrMatrixType;
 
+    // normalize each profile once (the profiles are standardized in place, as before)
+    for (std::size_t i = 0; i < sonar_profiles.size(); i++)
+    {
+      OpenSwath::Scoring::standardize_data(sonar_profiles[i]);
+    }
+
     XCorrMatrixType xcorr_matrix;
     xcorr_matrix.resize(sonar_profiles.size());
     for (std::size_t i = 0; i < sonar_profiles.size(); i++)
@@ -86,7 +92,7 @@ namespace OpenMS
       for (std::size_t j = i; j < sonar_profiles.size(); j++)
       {
         // compute normalized cross correlation
-        xcorr_matrix[i][j] = OpenSwath::Scoring::normalizedCrossCorrelation(
+        xcorr_matrix[i][j] = OpenSwath::Scoring::normalizedCrossCorrelationPost(
                                   sonar_profiles[i], sonar_profiles[j], boost::numeric_cast<int>(sonar_profiles[i].size()), 1);
       }
     }
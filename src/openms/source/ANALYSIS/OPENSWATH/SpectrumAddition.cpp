@@ -109,19 +109,14 @@ namespace OpenMS
       ++cnt;
     }
 
-    LinearResamplerAlign lresampler;
     // resample all spectra and add to master spectrum
+    double* resampled_intensity = resampled_peak_container->getIntensityArray()->data.data();
     for (Size curr_sp = 0; curr_sp < all_spectra.size(); curr_sp++)
     {
-      lresampler.raster(all_spectra[curr_sp]->getMZArray()->data.begin(),
-                        all_spectra[curr_sp]->getMZArray()->data.end(),
-                        all_spectra[curr_sp]->getIntensityArray()->data.begin(),
-                        all_spectra[curr_sp]->getIntensityArray()->data.end(),
-                        resampled_peak_container->getMZArray()->data.begin(),
-                        resampled_peak_container->getMZArray()->data.end(),
-                        resampled_peak_container->getIntensityArray()->data.begin(),
-                        resampled_peak_container->getIntensityArray()->data.end()
-      );
+      const std::vector<double>& mz_data = all_spectra[curr_sp]->getMZArray()->data;
+      const std::vector<double>& int_data = all_spectra[curr_sp]->getIntensityArray()->data;
+      LinearResamplerAlign::raster_uniform(mz_data.data(), int_data.data(), mz_data.size(),
+                                           min, sampling_rate, resampled_intensity, number_resampled_points);
     }
 
     if (!filter_zeros)
@@ -187,31 +182,31 @@ namespace OpenMS
 
     // generate the resampled peaks at positions origin+i*spacing_
     int number_resampled_points = (max - min) / sampling_rate + 1;
-    MSSpectrum resampled_peak_container;
-    resampled_peak_container.resize(number_resampled_points);
-    MSSpectrum::iterator it = resampled_peak_container.begin();
-    for (int i = 0; i < number_resampled_points; ++i)
-    {
-      it->setMZ(min + i * sampling_rate);
-      it->setIntensity(0);
-      ++it;
-    }
-
-    // resample all spectra and add to master spectrum
-    LinearResamplerAlign lresampler;
-    MSSpectrum master_spectrum = resampled_peak_container;
+    // resample all spectra into a common buffer (the input peaks are copied
+    // into contiguous arrays, which are reused for all spectra)
+    std::vector<double> resampled_intensity(number_resampled_points, 0.0);
+    std::vector<double> mz_data;
+    std::vector<double> int_data;
     for (Size curr_sp = 0; curr_sp < all_spectra.size(); curr_sp++)
     {
-      MSSpectrum input_spectrum;
-      MSSpectrum output_spectrum = resampled_peak_container;
-
-      lresampler.raster(all_spectra[curr_sp].begin(), all_spectra[curr_sp].end(), output_spectrum.begin(), output_spectrum.end());
-
-      // add to master spectrum
-      for (Size i = 0; i < output_spectrum.size(); ++i)
+      const MSSpectrum& spec = all_spectra[curr_sp];
+      mz_data.resize(spec.size());
+      int_data.resize(spec.size());
+      for (Size k = 0; k < spec.size(); ++k)
       {
-        master_spectrum[i].setIntensity(master_spectrum[i].getIntensity() + output_spectrum[i].getIntensity());
+        mz_data[k] = spec[k].getMZ();
+        int_data[k] = spec[k].getIntensity();
       }
+      LinearResamplerAlign::raster_uniform(mz_data.data(), int_data.data(), mz_data.size(),
+                                           min, sampling_rate, resampled_intensity.data(), number_resampled_points);
+    }
+
+    MSSpectrum master_spectrum;
+    master_spectrum.resize(number_resampled_points);
+    for (int i = 0; i < number_resampled_points; ++i)
+    {
+      master_spectrum[i].setMZ(min + i * sampling_rate);
+      master_spectrum[i].setIntensity(resampled_intensity[i]);
     }
 
     if (!filter_zeros)
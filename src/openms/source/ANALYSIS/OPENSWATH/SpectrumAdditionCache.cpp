@@ -0,0 +1,130 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/ANALYSIS/OPENSWATH/SpectrumAdditionCache.h>
+
+namespace OpenMS
+{
+  bool SpectrumAdditionCache::Key::operator<(const Key& rhs) const
+  {
+    if (closest_idx != rhs.closest_idx) return closest_idx < rhs.closest_idx;
+    if (nr_spectra_to_add != rhs.nr_spectra_to_add) return nr_spectra_to_add < rhs.nr_spectra_to_add;
+    if (drift_lower != rhs.drift_lower) return drift_lower < rhs.drift_lower;
+    return drift_upper < rhs.drift_upper;
+  }
+
+  SpectrumAdditionCache::SpectrumAdditionCache(Size max_bytes) :
+    bytes_(0),
+    max_bytes_(max_bytes)
+  {
+  }
+
+  OpenSwath::SpectrumPtr SpectrumAdditionCache::get(const Key& key)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::map<Key, EntryList::iterator>::iterator it = index_.find(key);
+    if (it == index_.end()) return OpenSwath::SpectrumPtr();
+
+    // move to front (most recently used)
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->second;
+  }
+
+  void SpectrumAdditionCache::insert(const Key& key, const OpenSwath::SpectrumPtr& spectrum)
+  {
+    if (!spectrum) return;
+    const Size bytes = spectrumBytes_(spectrum);
+    if (bytes > max_bytes_) return; // would evict everything else
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::map<Key, EntryList::iterator>::iterator it = index_.find(key);
+    if (it != index_.end())
+    {
+      // another thread was faster
+      bytes_ -= spectrumBytes_(it->second->second);
+      entries_.erase(it->second);
+      index_.erase(it);
+    }
+    entries_.push_front(std::make_pair(key, spectrum));
+    index_[key] = entries_.begin();
+    bytes_ += bytes;
+    evict_();
+  }
+
+  Size SpectrumAdditionCache::size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+  }
+
+  Size SpectrumAdditionCache::getMemoryUsage() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_;
+  }
+
+  Size SpectrumAdditionCache::getMaxBytes() const
+  {
+    return max_bytes_;
+  }
+
+  void SpectrumAdditionCache::clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    index_.clear();
+    bytes_ = 0;
+  }
+
+  Size SpectrumAdditionCache::spectrumBytes_(const OpenSwath::SpectrumPtr& spectrum)
+  {
+    Size bytes = 0;
+    for (const auto& arr : spectrum->getDataArrays())
+    {
+      if (arr) bytes += arr->data.size() * sizeof(double);
+    }
+    return bytes;
+  }
+
+  void SpectrumAdditionCache::evict_()
+  {
+    while (bytes_ > max_bytes_ && !entries_.empty())
+    {
+      bytes_ -= spectrumBytes_(entries_.back().second);
+      index_.erase(entries_.back().first);
+      entries_.pop_back();
+    }
+  }
+
+}
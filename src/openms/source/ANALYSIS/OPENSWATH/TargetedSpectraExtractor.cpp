@@ -489,39 +489,62 @@ namespace OpenMS
     extractSpectra(experiment, targeted_exp, extracted_spectra, extracted_features, compute_features);
   }
 
-  void TargetedSpectraExtractor::matchSpectrum(
-    const MSSpectrum& input_spectrum,
+  void TargetedSpectraExtractor::topMatches_(
+    std::vector<std::pair<Size,double>>& scores,
     const Comparator& cmp,
+    Size n,
     std::vector<Match>& matches
   )
   {
-    // TODO: remove times debug info
-    // std::clock_t start;
-    // start = std::clock();
     matches.clear();
-    std::vector<std::pair<Size,double>> scores;
-
-    cmp.generateScores(input_spectrum, scores, min_match_score_);
+    // Set the number of best matches to return
+    n = std::min(n, scores.size());
 
-    // Sort the vector of scores
-    std::sort(scores.begin(), scores.end(),
+    // Only the best n scores need to be sorted
+    std::partial_sort(scores.begin(), scores.begin() + n, scores.end(),
       [](const std::pair<Size,double>& a, const std::pair<Size,double>& b)
       {
-        return a.second > b.second;
+        return a.second > b.second || (a.second == b.second && a.first < b.first);
       });
 
-    // Set the number of best matches to return
-    const Size n = std::min(top_matches_to_report_, scores.size());
-
     // Construct a vector of n `Match`es
+    matches.reserve(n);
     for (Size i = 0; i < n; ++i)
     {
       const Size spec_idx { scores[i].first };
       const double spec_score { scores[i].second };
       matches.emplace_back(cmp.getLibrary()[spec_idx], spec_score);
     }
+  }
 
-    // std::cout << "MATCH TIME: " << ((std::clock() - start) / (double)CLOCKS_PER_SEC) << std::endl;
+  void TargetedSpectraExtractor::matchSpectrum(
+    const MSSpectrum& input_spectrum,
+    const Comparator& cmp,
+    std::vector<Match>& matches
+  )
+  {
+    std::vector<std::pair<Size,double>> scores;
+    cmp.generateScores(input_spectrum, scores, min_match_score_);
+    topMatches_(scores, cmp, top_matches_to_report_, matches);
+  }
+
+  void TargetedSpectraExtractor::matchSpectra(
+    const std::vector<MSSpectrum>& input_spectra,
+    const Comparator& cmp,
+    std::vector<std::vector<Match>>& matches
+  ) const
+  {
+    std::vector<std::vector<std::pair<Size,double>>> scores;
+    cmp.generateScores(input_spectra, scores, min_match_score_);
+
+    matches.clear();
+    matches.resize(input_spectra.size());
+#pragma omp parallel for schedule(dynamic, 64)
+    for (SignedSize i = 0; i < (SignedSize)input_spectra.size(); ++i)
+    {
+      topMatches_(scores[i], cmp, top_matches_to_report_, matches[i]);
+      std::vector<std::pair<Size,double>>().swap(scores[i]);
+    }
   }
 
   void TargetedSpectraExtractor::targetedMatching(
@@ -535,14 +558,16 @@ namespace OpenMS
       throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
     }
 
+    // score all spectra at once (in parallel); only the best match is needed
+    std::vector<std::vector<std::pair<Size,double>>> scores;
+    cmp.generateScores(spectra, scores, min_match_score_);
+
     std::vector<Size> no_matches_idx; // to keep track of those features without a match
-    const Size tmp = top_matches_to_report_;
-    top_matches_to_report_ = 1;
 
     for (Size i = 0; i < spectra.size(); ++i)
     {
       std::vector<Match> matches;
-      matchSpectrum(spectra[i], cmp, matches);
+      topMatches_(scores[i], cmp, 1, matches);
       if (matches.size())
       {
         features[i].setMetaValue("spectral_library_name", matches[0].spectrum.getName());
@@ -560,8 +585,6 @@ namespace OpenMS
       }
     }
 
-    top_matches_to_report_ = tmp;
-
     if (no_matches_idx.size())
     {
       String warn_msg = "No match was found for " + std::to_string(no_matches_idx.size()) + " `Feature`s. Indices: ";
@@ -582,10 +605,21 @@ namespace OpenMS
     features.clear(true);
 
     std::vector<MSSpectrum> picked(spectra.size());
-    for (Size i = 0; i < spectra.size(); ++i)
+    std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 8)
+    for (SignedSize i = 0; i < (SignedSize)spectra.size(); ++i)
     {
-      pickSpectrum(spectra[i], picked[i]);
+      try
+      {
+        pickSpectrum(spectra[i], picked[i]);
+      }
+      catch (...)
+      {
+#pragma omp critical (TargetedSpectraExtractor_error)
+        if (!error) error = std::current_exception();
+      }
     }
+    if (error) std::rethrow_exception(error);
 
     // remove empty picked<> spectra
     for (Int i = spectra.size() - 1; i >= 0; --i)
@@ -0,0 +1,541 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/ANALYSIS/OPENSWATH/TransitionBinaryFile.h>
+
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/DataAccessHelper.h>
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <unordered_map>
+
+namespace OpenMS
+{
+
+  namespace
+  {
+    const char TRBIN_MAGIC[16] = "OPENMS_TRBIN_01";
+
+    const UInt64 TRBIN_VERSION = 1;
+
+    /// version, number of TSV rows, light transitions, compounds, proteins, byte offset of the light section
+    const Size HEADER_ENTRIES = 6;
+
+    const Size HEADER_SIZE = sizeof(TRBIN_MAGIC) + HEADER_ENTRIES * sizeof(UInt64);
+
+    Size alignedSize_(Size size)
+    {
+      return (size + 7) / 8 * 8;
+    }
+
+    /**
+      Collects the blocks (flat arrays) of a file in memory and interns all strings into one pool.
+
+      Each block is written as its size in bytes, followed by the data, padded to 8 bytes.
+      The string pool (offsets, characters) comes first, so it is available when the blocks are read.
+    */
+    class Writer_
+    {
+  public:
+      Writer_() :
+        pool_offsets_(1, 0)
+      {
+      }
+
+      template <typename Row, typename T>
+      void column(std::vector<Row>& rows, T Row::* field)
+      {
+        std::vector<T> values;
+        values.reserve(rows.size());
+        for (const Row& row : rows)
+        {
+          values.push_back(row.*field);
+        }
+        add_(values);
+      }
+
+      template <typename Row, typename S>
+      void strings(std::vector<Row>& rows, S Row::* field)
+      {
+        std::vector<UInt32> ids;
+        ids.reserve(rows.size());
+        for (const Row& row : rows)
+        {
+          ids.push_back(intern_(row.*field));
+        }
+        add_(ids);
+      }
+
+      template <typename Row, typename S>
+      void stringLists(std::vector<Row>& rows, std::vector<S> Row::* field)
+      {
+        std::vector<UInt64> offsets(1, 0);
+        std::vector<UInt32> ids;
+        for (const Row& row : rows)
+        {
+          for (const S& s : row.*field)
+          {
+            ids.push_back(intern_(s));
+          }
+          offsets.push_back(ids.size());
+        }
+        add_(offsets);
+        add_(ids);
+      }
+
+      template <typename Row, typename T>
+      void lists(std::vector<Row>& rows, std::vector<T> Row::* field)
+      {
+        std::vector<UInt64> offsets(1, 0);
+        std::vector<T> values;
+        for (const Row& row : rows)
+        {
+          values.insert(values.end(), (row.*field).begin(), (row.*field).end());
+          offsets.push_back(values.size());
+        }
+        add_(offsets);
+        add_(values);
+      }
+
+      /// up to 8 boolean fields, packed into one byte per row
+      template <typename Row>
+      void flags(std::vector<Row>& rows, std::initializer_list<bool Row::*> fields)
+      {
+        std::vector<unsigned char> values;
+        values.reserve(rows.size());
+        for (const Row& row : rows)
+        {
+          unsigned char value = 0, bit = 1;
+          for (bool Row::* field : fields)
+          {
+            if (row.*field) value |= bit;
+            bit <<= 1;
+          }
+          values.push_back(value);
+        }
+        add_(values);
+      }
+
+      /// all following blocks belong to the light section
+      void startLightSection()
+      {
+        light_block_ = blocks_.size();
+      }
+
+      void write(const String& filename, const UInt64 (&counts)[4]) const
+      {
+        std::ofstream out(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+          throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+        }
+
+        const std::string pool_offsets(reinterpret_cast<const char*>(pool_offsets_.data()), pool_offsets_.size() * sizeof(UInt64));
+        UInt64 light_offset = HEADER_SIZE + blockSize_(pool_offsets) + blockSize_(pool_chars_);
+        for (Size i = 0; i < light_block_; ++i)
+        {
+          light_offset += blockSize_(blocks_[i]);
+        }
+
+        UInt64 header[HEADER_ENTRIES] = {TRBIN_VERSION, counts[0], counts[1], counts[2], counts[3], light_offset};
+        out.write(TRBIN_MAGIC, sizeof(TRBIN_MAGIC));
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+        writeBlock_(out, pool_offsets);
+        writeBlock_(out, pool_chars_);
+        for (const std::string& block : blocks_)
+        {
+          writeBlock_(out, block);
+        }
+        if (!out)
+        {
+          throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Error while writing the file.");
+        }
+      }
+
+  private:
+      UInt32 intern_(const std::string& s)
+      {
+        auto it = pool_index_.insert(std::make_pair(s, UInt32(pool_offsets_.size() - 1))).first;
+        if (it->second == pool_offsets_.size() - 1)
+        {
+          pool_chars_.append(s);
+          pool_offsets_.push_back(pool_chars_.size());
+        }
+        return it->second;
+      }
+
+      template <typename T>
+      void add_(const std::vector<T>& values)
+      {
+        blocks_.emplace_back(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+      }
+
+      static Size blockSize_(const std::string& block)
+      {
+        return sizeof(UInt64) + alignedSize_(block.size());
+      }
+
+      static void writeBlock_(std::ostream& out, const std::string& block)
+      {
+        const char padding[8] = {0};
+        const UInt64 bytes = block.size();
+        out.write(reinterpret_cast<const char*>(&bytes), sizeof(bytes));
+        out.write(block.data(), block.size());
+        out.write(padding, alignedSize_(block.size()) - block.size());
+      }
+
+      std::vector<std::string> blocks_;
+      Size light_block_ = 0;
+      std::unordered_map<std::string, UInt32> pool_index_;
+      std::vector<UInt64> pool_offsets_;
+      std::string pool_chars_;
+    };
+
+    /// reads the blocks written by Writer_ (in the same order) from the memory-mapped file
+    class Reader_
+    {
+  public:
+      explicit Reader_(const String& filename) :
+        filename_(filename)
+      {
+        if (!File::exists(filename))
+        {
+          throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+        }
+        if (File::empty(filename)) error_("Not a binary transition library.");
+        try
+        {
+          boost::interprocess::file_mapping mapping(filename.c_str(), boost::interprocess::read_only);
+          mapped_file_.reset(new boost::interprocess::mapped_region(mapping, boost::interprocess::read_only));
+        }
+        catch (boost::interprocess::interprocess_exception& e)
+        {
+          error_(String("Could not memory-map file: ") + e.what());
+        }
+        data_ = static_cast<const char*>(mapped_file_->get_address());
+        size_ = mapped_file_->get_size();
+
+        if (size_ < HEADER_SIZE || memcmp(data_, TRBIN_MAGIC, sizeof(TRBIN_MAGIC)) != 0)
+        {
+          error_("Not a binary transition library.");
+        }
+        memcpy(header_, data_ + sizeof(TRBIN_MAGIC), sizeof(header_));
+        if (header_[0] != TRBIN_VERSION)
+        {
+          error_("Unsupported version " + String(header_[0]) + " of binary transition library.");
+        }
+        pos_ = HEADER_SIZE;
+
+        Size pool_bytes = 0;
+        const char* pool_offsets = block_(pool_bytes);
+        if (pool_bytes == 0 || pool_bytes % sizeof(UInt64) != 0) error_("Invalid string pool.");
+        pool_offsets_ = reinterpret_cast<const UInt64*>(pool_offsets);
+        pool_size_ = pool_bytes / sizeof(UInt64) - 1;
+        Size chars_bytes = 0;
+        pool_chars_ = block_(chars_bytes);
+        for (Size i = 0; i < pool_size_; ++i)
+        {
+          if (pool_offsets_[i] > pool_offsets_[i + 1]) error_("Invalid string pool.");
+        }
+        if (pool_offsets_[0] != 0 || pool_offsets_[pool_size_] != chars_bytes) error_("Invalid string pool.");
+      }
+
+      /// entry @p i of the header counts (TSV rows, light transitions, compounds, proteins)
+      UInt64 count(Size i) const
+      {
+        return header_[i + 1];
+      }
+
+      /// continue reading at the light section
+      void startLightSection()
+      {
+        if (header_[5] < pos_ || header_[5] > size_) error_("Invalid offset of light section.");
+        pos_ = header_[5];
+      }
+
+      template <typename Row, typename T>
+      void column(std::vector<Row>& rows, T Row::* field)
+      {
+        const T* values = array_<T>(rows.size());
+        for (Size i = 0; i < rows.size(); ++i)
+        {
+          rows[i].*field = values[i];
+        }
+      }
+
+      template <typename Row, typename S>
+      void strings(std::vector<Row>& rows, S Row::* field)
+      {
+        const UInt32* ids = array_<UInt32>(rows.size());
+        for (Size i = 0; i < rows.size(); ++i)
+        {
+          rows[i].*field = string_(ids[i]);
+        }
+      }
+
+      template <typename Row, typename S>
+      void stringLists(std::vector<Row>& rows, std::vector<S> Row::* field)
+      {
+        const UInt64* offsets = offsets_(rows.size());
+        const UInt32* ids = array_<UInt32>(offsets[rows.size()]);
+        for (Size i = 0; i < rows.size(); ++i)
+        {
+          std::vector<S>& list = rows[i].*field;
+          list.clear();
+          list.reserve(offsets[i + 1] - offsets[i]);
+          for (UInt64 k = offsets[i]; k < offsets[i + 1]; ++k)
+          {
+            list.push_back(string_(ids[k]));
+          }
+        }
+      }
+
+      template <typename Row, typename T>
+      void lists(std::vector<Row>& rows, std::vector<T> Row::* field)
+      {
+        const UInt64* offsets = offsets_(rows.size());
+        const T* values = array_<T>(offsets[rows.size()]);
+        for (Size i = 0; i < rows.size(); ++i)
+        {
+          (rows[i].*field).assign(values + offsets[i], values + offsets[i + 1]);
+        }
+      }
+
+      template <typename Row>
+      void flags(std::vector<Row>& rows, std::initializer_list<bool Row::*> fields)
+      {
+        const unsigned char* values = array_<unsigned char>(rows.size());
+        for (Size i = 0; i < rows.size(); ++i)
+        {
+          unsigned char bit = 1;
+          for (bool Row::* field : fields)
+          {
+            rows[i].*field = (values[i] & bit) != 0;
+            bit <<= 1;
+          }
+        }
+      }
+
+  private:
+      [[noreturn]] void error_(const String& message) const
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_, message);
+      }
+
+      /// next block; sets @p bytes to its size
+      const char* block_(Size& bytes)
+      {
+        UInt64 size;
+        if (size_ - pos_ < sizeof(size)) error_("Truncated binary transition library.");
+        memcpy(&size, data_ + pos_, sizeof(size));
+        pos_ += sizeof(size);
+        if (size_ - pos_ < size) error_("Truncated binary transition library.");
+        const char* block = data_ + pos_;
+        pos_ += std::min(alignedSize_(size), size_ - pos_);
+        bytes = size;
+        return block;
+      }
+
+      /// next block, which must hold @p count elements of type T (blocks are 8 byte aligned)
+      template <typename T>
+      const T* array_(UInt64 count)
+      {
+        Size bytes = 0;
+        const char* block = block_(bytes);
+        if (bytes != count * sizeof(T)) error_("Invalid block size in binary transition library.");
+        return reinterpret_cast<const T*>(block);
+      }
+
+      /// next block of list offsets for @p count rows
+      const UInt64* offsets_(Size count)
+      {
+        const UInt64* offsets = array_<UInt64>(count + 1);
+        for (Size i = 0; i < count; ++i)
+        {
+          if (offsets[i] > offsets[i + 1]) error_("Invalid list offsets in binary transition library.");
+        }
+        if (offsets[0] != 0) error_("Invalid list offsets in binary transition library.");
+        return offsets;
+      }
+
+      std::string string_(UInt32 id) const
+      {
+        if (id >= pool_size_) error_("Invalid string reference in binary transition library.");
+        return std::string(pool_chars_ + pool_offsets_[id], pool_chars_ + pool_offsets_[id + 1]);
+      }
+
+      String filename_;
+      boost::shared_ptr<boost::interprocess::mapped_region> mapped_file_;
+      const char* data_ = nullptr;
+      Size size_ = 0;
+      Size pos_ = 0;
+      UInt64 header_[HEADER_ENTRIES];
+      const UInt64* pool_offsets_ = nullptr;
+      Size pool_size_ = 0;
+      const char* pool_chars_ = nullptr;
+    };
+  }
+
+  TransitionBinaryFile::TransitionBinaryFile() :
+    TransitionTSVFile()
+  {
+  }
+
+  TransitionBinaryFile::~TransitionBinaryFile()
+  {
+  }
+
+  template <typename Archive>
+  void TransitionBinaryFile::serializeRows_(Archive& ar, std::vector<TSVTransition>& rows)
+  {
+    ar.column(rows, &TSVTransition::precursor);
+    ar.column(rows, &TSVTransition::product);
+    ar.column(rows, &TSVTransition::rt_calibrated);
+    ar.column(rows, &TSVTransition::CE);
+    ar.column(rows, &TSVTransition::library_intensity);
+    ar.column(rows, &TSVTransition::fragment_mzdelta);
+    ar.column(rows, &TSVTransition::drift_time);
+    ar.column(rows, &TSVTransition::fragment_nr);
+    ar.column(rows, &TSVTransition::fragment_modification);
+    ar.flags(rows, {&TSVTransition::decoy, &TSVTransition::detecting_transition,
+                    &TSVTransition::identifying_transition, &TSVTransition::quantifying_transition});
+    ar.strings(rows, &TSVTransition::transition_name);
+    ar.strings(rows, &TSVTransition::group_id);
+    ar.strings(rows, &TSVTransition::PeptideSequence);
+    ar.strings(rows, &TSVTransition::GeneName);
+    ar.strings(rows, &TSVTransition::Annotation);
+    ar.strings(rows, &TSVTransition::FullPeptideName);
+    ar.strings(rows, &TSVTransition::CompoundName);
+    ar.strings(rows, &TSVTransition::SMILES);
+    ar.strings(rows, &TSVTransition::SumFormula);
+    ar.strings(rows, &TSVTransition::Adducts);
+    ar.strings(rows, &TSVTransition::precursor_charge);
+    ar.strings(rows, &TSVTransition::peptide_group_label);
+    ar.strings(rows, &TSVTransition::label_type);
+    ar.strings(rows, &TSVTransition::fragment_charge);
+    ar.strings(rows, &TSVTransition::fragment_type);
+    ar.stringLists(rows, &TSVTransition::ProteinName);
+    ar.stringLists(rows, &TSVTransition::uniprot_id);
+    ar.stringLists(rows, &TSVTransition::peptidoforms);
+  }
+
+  template <typename Archive>
+  void TransitionBinaryFile::serializeLight_(Archive& ar, OpenSwath::LightTargetedExperiment& exp)
+  {
+    typedef OpenSwath::LightTransition LT;
+    ar.strings(exp.transitions, &LT::transition_name);
+    ar.strings(exp.transitions, &LT::peptide_ref);
+    ar.column(exp.transitions, &LT::library_intensity);
+    ar.column(exp.transitions, &LT::product_mz);
+    ar.column(exp.transitions, &LT::precursor_mz);
+    ar.column(exp.transitions, &LT::fragment_charge);
+    ar.flags(exp.transitions, {&LT::decoy, &LT::detecting_transition, &LT::quantifying_transition, &LT::identifying_transition});
+
+    typedef OpenSwath::LightCompound LC;
+    ar.column(exp.compounds, &LC::drift_time);
+    ar.column(exp.compounds, &LC::rt);
+    ar.column(exp.compounds, &LC::charge);
+    ar.strings(exp.compounds, &LC::sequence);
+    ar.strings(exp.compounds, &LC::peptide_group_label);
+    ar.strings(exp.compounds, &LC::gene_name);
+    ar.strings(exp.compounds, &LC::id);
+    ar.strings(exp.compounds, &LC::sum_formula);
+    ar.strings(exp.compounds, &LC::compound_name);
+    ar.stringLists(exp.compounds, &LC::protein_refs);
+    ar.lists(exp.compounds, &LC::modifications);
+
+    typedef OpenSwath::LightProtein LP;
+    ar.strings(exp.proteins, &LP::id);
+    ar.strings(exp.proteins, &LP::sequence);
+  }
+
+  void TransitionBinaryFile::convertTargetedExperimentToBinary(const char* filename, OpenMS::TargetedExperiment& targeted_exp)
+  {
+    if (targeted_exp.containsInvalidReferences())
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "Your input file contains invalid references, cannot process file.");
+    }
+
+    std::vector<TSVTransition> rows;
+    rows.reserve(targeted_exp.getTransitions().size());
+    Size progress = 0;
+    startProgress(0, targeted_exp.getTransitions().size(), "writing binary transition library");
+    for (const auto& tr : targeted_exp.getTransitions())
+    {
+      rows.push_back(convertTransition_(&tr, targeted_exp));
+      setProgress(progress++);
+    }
+    endProgress();
+
+    OpenSwath::LightTargetedExperiment light_exp;
+    OpenSwathDataAccessHelper::convertTargetedExp(targeted_exp, light_exp);
+
+    Writer_ writer;
+    serializeRows_(writer, rows);
+    writer.startLightSection();
+    serializeLight_(writer, light_exp);
+    const UInt64 counts[4] = {rows.size(), light_exp.transitions.size(), light_exp.compounds.size(), light_exp.proteins.size()};
+    writer.write(filename, counts);
+  }
+
+  void TransitionBinaryFile::convertBinaryToTargetedExperiment(const char* filename, OpenMS::TargetedExperiment& targeted_exp)
+  {
+    Reader_ reader(filename);
+    std::vector<TSVTransition> rows(reader.count(0));
+    serializeRows_(reader, rows);
+    TSVToTargetedExperiment_(rows, targeted_exp);
+  }
+
+  void TransitionBinaryFile::convertBinaryToTargetedExperiment(const char* filename, OpenSwath::LightTargetedExperiment& targeted_exp)
+  {
+    Reader_ reader(filename);
+    reader.startLightSection();
+    OpenSwath::LightTargetedExperiment light_exp;
+    light_exp.transitions.resize(reader.count(1));
+    light_exp.compounds.resize(reader.count(2));
+    light_exp.proteins.resize(reader.count(3));
+    serializeLight_(reader, light_exp);
+    targeted_exp = std::move(light_exp);
+  }
+
+}
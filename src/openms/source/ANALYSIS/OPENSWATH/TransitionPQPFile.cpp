@@ -34,9 +34,13 @@
 
 #include <OpenMS/ANALYSIS/OPENSWATH/TransitionPQPFile.h>
 
-#include <sqlite3.h>
+#include <OpenMS/CHEMISTRY/AASequence.h>
+#include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/FORMAT/SqliteConnector.h>
 
+#include <boost/numeric/conversion/cast.hpp>
+#include <sqlite3.h>
+
 namespace OpenMS
 {
 
@@ -705,5 +709,324 @@ namespace OpenMS
     TSVToTargetedExperiment_(transition_list, targeted_exp);
   }
 
+  void TransitionPQPFile::convertPQPToLightTargetedExperiment(const char* filename,
+                                                              OpenSwath::LightTargetedExperiment& targeted_exp,
+                                                              bool legacy_traml_id,
+                                                              double precursor_mz_lower,
+                                                              double precursor_mz_upper)
+  {
+    sqlite3 *db;
+    sqlite3_stmt * stmt;
+
+    // Use legacy TraML identifiers for precursors (transition_group_id) and transitions (transition_name)?
+    std::string traml_id = "ID";
+    if (legacy_traml_id)
+    {
+      traml_id = "TRAML_ID";
+    }
+
+    startProgress(0, 1, "reading PQP file (SQL warmup)");
+
+    // Open database
+    SqliteConnector conn(filename);
+    db = conn.getDB();
+
+    String select_drift_time = ", -1 AS drift_time ";
+    if (SqliteConnector::columnExists(db, "PRECURSOR", "LIBRARY_DRIFT_TIME"))
+    {
+      select_drift_time = ", PRECURSOR.LIBRARY_DRIFT_TIME AS drift_time ";
+    }
+
+    String select_gene = ", 'NA' AS gene_name ";
+    String join_gene = "";
+    if (SqliteConnector::tableExists(db, "GENE"))
+    {
+      select_gene = ", GENE.GENE_NAME AS gene_name ";
+      join_gene = "INNER JOIN PEPTIDE_GENE_MAPPING ON PEPTIDE.ID = PEPTIDE_GENE_MAPPING.PEPTIDE_ID " \
+                  "INNER JOIN GENE ON PEPTIDE_GENE_MAPPING.GENE_ID = GENE.ID ";
+    }
+
+    // both queries are restricted to the requested precursor m/z range
+    String where_mz = "WHERE PRECURSOR.PRECURSOR_MZ >= ?1 AND PRECURSOR.PRECURSOR_MZ <= ?2 ";
+
+    // Step 1: read all precursors (one row per peptide or compound precursor)
+    String select_sql = "SELECT " \
+                        "PRECURSOR.ID, " \
+                        "PRECURSOR." + traml_id + ", " \
+                        "PRECURSOR.LIBRARY_RT, " \
+                        "PRECURSOR.CHARGE, " \
+                        "PRECURSOR.GROUP_LABEL, " \
+                        "PEPTIDE.UNMODIFIED_SEQUENCE, " \
+                        "PEPTIDE.MODIFIED_SEQUENCE, " \
+                        "PROTEIN_AGGREGATED.PROTEIN_ACCESSION, " \
+                        "NULL AS CompoundName, " \
+                        "NULL AS SumFormula" +
+                        select_drift_time +
+                        select_gene +
+                        "FROM PRECURSOR " \
+                        "INNER JOIN PRECURSOR_PEPTIDE_MAPPING ON PRECURSOR.ID = PRECURSOR_PEPTIDE_MAPPING.PRECURSOR_ID " \
+                        "INNER JOIN PEPTIDE ON PRECURSOR_PEPTIDE_MAPPING.PEPTIDE_ID = PEPTIDE.ID " +
+                        join_gene +
+                        "INNER JOIN " \
+                          "(SELECT PEPTIDE_ID, GROUP_CONCAT(PROTEIN_ACCESSION,';') AS PROTEIN_ACCESSION " \
+                          "FROM PROTEIN " \
+                          "INNER JOIN PEPTIDE_PROTEIN_MAPPING ON PROTEIN.ID = PEPTIDE_PROTEIN_MAPPING.PROTEIN_ID "\
+                          "GROUP BY PEPTIDE_ID) " \
+                          "AS PROTEIN_AGGREGATED ON PEPTIDE.ID = PROTEIN_AGGREGATED.PEPTIDE_ID " +
+                        where_mz +
+                        "UNION ALL SELECT " \
+                        "PRECURSOR.ID, " \
+                        "PRECURSOR." + traml_id + ", " \
+                        "PRECURSOR.LIBRARY_RT, " \
+                        "PRECURSOR.CHARGE, " \
+                        "PRECURSOR.GROUP_LABEL, " \
+                        "NULL AS UNMODIFIED_SEQUENCE, " \
+                        "NULL AS MODIFIED_SEQUENCE, " \
+                        "NULL AS PROTEIN_ACCESSION, " \
+                        "COMPOUND.COMPOUND_NAME AS CompoundName, " \
+                        "COMPOUND.SUM_FORMULA AS SumFormula" +
+                        select_drift_time +
+                        ", 'NA' AS gene_name " \
+                        "FROM PRECURSOR " \
+                        "INNER JOIN PRECURSOR_COMPOUND_MAPPING ON PRECURSOR.ID = PRECURSOR_COMPOUND_MAPPING.PRECURSOR_ID " \
+                        "INNER JOIN COMPOUND ON PRECURSOR_COMPOUND_MAPPING.COMPOUND_ID = COMPOUND.ID " +
+                        where_mz + ";";
+
+    SqliteConnector::prepareStatement(db, &stmt, select_sql);
+    sqlite3_bind_double(stmt, 1, precursor_mz_lower);
+    sqlite3_bind_double(stmt, 2, precursor_mz_upper);
+    sqlite3_step(stmt);
+
+    // compounds are only added to the experiment once a transition refers to them
+    std::vector<OpenSwath::LightCompound> precursors;
+    std::map<int, Size> precursor_map; // PRECURSOR.ID -> index in precursors
+    while (sqlite3_column_type(stmt, 0) != SQLITE_NULL)
+    {
+      int precursor_id = sqlite3_column_int(stmt, 0);
+      if (precursor_map.find(precursor_id) != precursor_map.end())
+      {
+        // multiple genes / peptides for the same precursor: keep the first one
+        sqlite3_step(stmt);
+        continue;
+      }
+
+      OpenSwath::LightCompound compound;
+      double rt = -1, drift_time = -1;
+      String charge, tmp_field, full_peptide_name;
+      Sql::extractValue<std::string>(&compound.id, stmt, 1);
+      Sql::extractValue<double>(&rt, stmt, 2);
+      Sql::extractValueIntStr(&charge, stmt, 3);
+      Sql::extractValue<std::string>(&compound.peptide_group_label, stmt, 4);
+      Sql::extractValue<std::string>(&compound.sequence, stmt, 5);
+      Sql::extractValue<String>(&full_peptide_name, stmt, 6);
+      if (Sql::extractValue<String>(&tmp_field, stmt, 7))
+      {
+        std::vector<String> protein_refs;
+        tmp_field.split(';', protein_refs);
+        compound.protein_refs.assign(protein_refs.begin(), protein_refs.end());
+      }
+      Sql::extractValue<std::string>(&compound.compound_name, stmt, 8);
+      Sql::extractValue<std::string>(&compound.sum_formula, stmt, 9);
+      Sql::extractValue<double>(&drift_time, stmt, 10);
+      Sql::extractValue<std::string>(&compound.gene_name, stmt, 11);
+
+      if (compound.gene_name == "NA") compound.gene_name = "";
+      if (!charge.empty() && charge != "NA") compound.charge = charge.toInt();
+      if (drift_time >= 0.0) compound.drift_time = drift_time;
+      compound.rt = rt;
+      if (retentionTimeInterpretation_ == "minutes") compound.rt = 60 * rt;
+
+      if (compound.isPeptide())
+      {
+        // same modification handling as createPeptide_, but without the
+        // detour through TargetedExperiment::Peptide
+        AASequence aa_sequence;
+        String sequence = full_peptide_name;
+        if (sequence.empty()) sequence = compound.sequence;
+        try
+        {
+          aa_sequence = AASequence::fromString(sequence);
+        } catch (Exception::InvalidValue & e)
+        {
+          OPENMS_LOG_DEBUG << "Invalid sequence when parsing '" << full_peptide_name << "'" << std::endl;
+          if (!force_invalid_mods_)
+          {
+            std::cerr << "Error while reading file (use 'force_invalid_mods' parameter to override): " << e.what() << std::endl;
+            throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+                "Invalid input, cannot parse: " + full_peptide_name);
+          }
+          // fallback: parse the "naked" peptide sequence which should always work
+          aa_sequence = AASequence::fromString(compound.sequence);
+        }
+
+        bool add_mods = true;
+        if (compound.sequence != aa_sequence.toUnmodifiedString())
+        {
+          if (force_invalid_mods_)
+          {
+            // something is wrong, do not try and add any modifications
+            add_mods = false;
+          }
+          else
+          {
+            OPENMS_LOG_WARN << "Warning: The peptide sequence " << compound.sequence << " and the full peptide name " << aa_sequence <<
+              " are not equal. Please check your input." << std::endl;
+            OPENMS_LOG_WARN << "(use force_invalid_mods to override)" << std::endl;
+          }
+        }
+
+        if (add_mods)
+        {
+          OpenSwath::LightModification light_mod;
+          if (aa_sequence.hasNTerminalModification())
+          {
+            light_mod.location = -1;
+            light_mod.unimod_id = aa_sequence.getNTerminalModification()->getUniModRecordId();
+            compound.modifications.push_back(light_mod);
+          }
+          if (aa_sequence.hasCTerminalModification())
+          {
+            light_mod.location = boost::numeric_cast<int>(aa_sequence.size());
+            light_mod.unimod_id = aa_sequence.getCTerminalModification()->getUniModRecordId();
+            compound.modifications.push_back(light_mod);
+          }
+          for (Size i = 0; i != aa_sequence.size(); i++)
+          {
+            if (aa_sequence[i].isModified())
+            {
+              light_mod.location = boost::numeric_cast<int>(i);
+              light_mod.unimod_id = aa_sequence.getResidue(i).getModification()->getUniModRecordId();
+              compound.modifications.push_back(light_mod);
+            }
+          }
+        }
+      }
+      else
+      {
+        // peptide group labels are not stored for metabolites (see createCompound_)
+        compound.peptide_group_label = "";
+      }
+
+      precursor_map[precursor_id] = precursors.size();
+      precursors.push_back(compound);
+      sqlite3_step(stmt);
+    }
+    sqlite3_finalize(stmt);
+
+    // Step 2: read all transitions and link them to their precursors
+    select_sql = "SELECT " \
+                 "TRANSITION_PRECURSOR_MAPPING.PRECURSOR_ID, " \
+                 "TRANSITION." + traml_id + ", " \
+                 "PRECURSOR.PRECURSOR_MZ, " \
+                 "TRANSITION.PRODUCT_MZ, " \
+                 "TRANSITION.CHARGE, " \
+                 "TRANSITION.LIBRARY_INTENSITY, " \
+                 "TRANSITION.DECOY, " \
+                 "TRANSITION.DETECTING, " \
+                 "TRANSITION.IDENTIFYING, " \
+                 "TRANSITION.QUANTIFYING " \
+                 "FROM TRANSITION " \
+                 "INNER JOIN TRANSITION_PRECURSOR_MAPPING ON TRANSITION.ID = TRANSITION_PRECURSOR_MAPPING.TRANSITION_ID " \
+                 "INNER JOIN PRECURSOR ON TRANSITION_PRECURSOR_MAPPING.PRECURSOR_ID = PRECURSOR.ID " +
+                 where_mz + ";";
+
+    SqliteConnector::prepareStatement(db, &stmt, select_sql);
+    sqlite3_bind_double(stmt, 1, precursor_mz_lower);
+    sqlite3_bind_double(stmt, 2, precursor_mz_upper);
+    sqlite3_step(stmt);
+
+    std::vector<bool> precursor_used(precursors.size(), false);
+    std::set<std::string> protein_set;
+    Size progress = 0;
+    startProgress(0, precursors.size(), "reading PQP file");
+    while (sqlite3_column_type(stmt, 0) != SQLITE_NULL)
+    {
+      auto pr_it = precursor_map.find(sqlite3_column_int(stmt, 0));
+      if (pr_it == precursor_map.end())
+      {
+        // precursor without peptide (protein) or compound, skip as in readPQPInput_
+        sqlite3_step(stmt);
+        continue;
+      }
+      const OpenSwath::LightCompound& compound = precursors[pr_it->second];
+
+      OpenSwath::LightTransition transition;
+      String fragment_charge;
+      int decoy = 0, detecting = 1, identifying = 0, quantifying = 1;
+      Sql::extractValue<std::string>(&transition.transition_name, stmt, 1);
+      Sql::extractValue<double>(&transition.precursor_mz, stmt, 2);
+      Sql::extractValue<double>(&transition.product_mz, stmt, 3);
+      Sql::extractValueIntStr(&fragment_charge, stmt, 4);
+      Sql::extractValue<double>(&transition.library_intensity, stmt, 5);
+      Sql::extractValue<int>(&decoy, stmt, 6);
+      Sql::extractValue<int>(&detecting, stmt, 7);
+      Sql::extractValue<int>(&identifying, stmt, 8);
+      Sql::extractValue<int>(&quantifying, stmt, 9);
+
+      transition.peptide_ref = compound.id;
+      if (!fragment_charge.empty() && fragment_charge != "NA")
+      {
+        transition.fragment_charge = fragment_charge.toInt();
+      }
+      transition.decoy = decoy;
+      transition.detecting_transition = detecting;
+      transition.identifying_transition = identifying;
+      transition.quantifying_transition = quantifying;
+      targeted_exp.transitions.push_back(transition);
+
+      // add the compound and its proteins the first time they are referenced
+      if (!precursor_used[pr_it->second])
+      {
+        precursor_used[pr_it->second] = true;
+        targeted_exp.compounds.push_back(compound);
+        if (compound.isPeptide())
+        {
+          for (const auto& protein_ref : compound.protein_refs)
+          {
+            if (protein_set.insert(protein_ref).second)
+            {
+              OpenSwath::LightProtein protein;
+              protein.id = protein_ref;
+              protein.sequence = "";
+              targeted_exp.proteins.push_back(protein);
+            }
+          }
+        }
+        setProgress(progress++);
+      }
+      sqlite3_step(stmt);
+    }
+    sqlite3_finalize(stmt);
+    endProgress();
+
+    // same sanity check as resolveMixedSequenceGroups_: a peptide label
+    // group should not contain different peptide sequences
+    std::map<std::string, std::string> label_sequence_map;
+    for (auto& compound : targeted_exp.compounds)
+    {
+      if (compound.peptide_group_label.empty()) continue;
+      auto lbl_it = label_sequence_map.find(compound.peptide_group_label);
+      if (lbl_it == label_sequence_map.end())
+      {
+        label_sequence_map[compound.peptide_group_label] = compound.sequence;
+      }
+      else if (!lbl_it->second.empty() && compound.sequence != lbl_it->second)
+      {
+        if (override_group_label_check_)
+        {
+          OPENMS_LOG_WARN << "Warning: Found multiple peptide sequences for peptide label group " << lbl_it->first <<
+            ". Since 'override_group_label_check' is on, nothing will be changed." << std::endl;
+        }
+        else
+        {
+          OPENMS_LOG_WARN << "Warning: Found multiple peptide sequences for peptide label group " << lbl_it->first <<
+            ". This is most likely an error and to fix this, a new peptide label group will be inferred - " <<
+            "to override this decision, please use the override_group_label_check parameter." << std::endl;
+          compound.peptide_group_label = compound.id;
+        }
+      }
+    }
+  }
+
 }
 
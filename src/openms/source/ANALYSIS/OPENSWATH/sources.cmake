@@ -35,9 +35,11 @@ set(sources_list
   SwathWindowLoader.cpp
   SwathQC.cpp
   SpectrumAddition.cpp
+  SpectrumAdditionCache.cpp
   TargetedSpectraExtractor.cpp
   TransitionTSVFile.cpp
   TransitionPQPFile.cpp
+  TransitionBinaryFile.cpp
 )
 
 ### add path to the filenames
@@ -64,6 +64,7 @@
 #include <numeric>
 #include <boost/math/special_functions/erf.hpp>
 #include <algorithm>
+#include <exception>
 
 namespace OpenMS
 {
@@ -222,29 +223,33 @@ namespace OpenMS
     // reset biases
     biases.clear();
 
+    // the (inverted) calibration curve is the same for all points (see applyCalibration())
+    TransformationModel::DataPoints no_data;
+    TransformationDescription tmd(no_data);
+    tmd.fitModel(transformation_model, transformation_model_params);
+    tmd.invert();
+
     // extract out the calibration points
-    std::vector<double> concentration_ratios, feature_amounts_ratios;
     TransformationModel::DataPoints data;
     TransformationModel::DataPoint point;
     for (size_t i = 0; i < component_concentrations.size(); ++i)
     {
+      const double ratio = calculateRatio(component_concentrations[i].feature,
+        component_concentrations[i].IS_feature,
+        feature_name);
 
       // calculate the actual and calculated concentration ratios
-      double calculated_concentration_ratio = applyCalibration(component_concentrations[i].feature,
-        component_concentrations[i].IS_feature,
-        feature_name,
-        transformation_model,
-        transformation_model_params);
+      double calculated_concentration_ratio = tmd.apply(ratio);
+      if (calculated_concentration_ratio < 0.0)
+      {
+        calculated_concentration_ratio = 0.0;
+      }
 
       double actual_concentration_ratio = component_concentrations[i].actual_concentration/
         component_concentrations[i].IS_actual_concentration;
-      concentration_ratios.push_back(component_concentrations[i].actual_concentration);
 
       // extract out the feature amount ratios
-      double feature_amount_ratio = calculateRatio(component_concentrations[i].feature,
-        component_concentrations[i].IS_feature,
-        feature_name)/component_concentrations[i].dilution_factor;
-      feature_amounts_ratios.push_back(feature_amount_ratio);
+      double feature_amount_ratio = ratio/component_concentrations[i].dilution_factor;
 
       // calculate the bias
       double bias = calculateBias(actual_concentration_ratio, calculated_concentration_ratio);
@@ -556,32 +561,32 @@ namespace OpenMS
     // the data points with one removed pair. The combination resulting in
     // highest rsq is considered corresponding to the outlier candidate. The
     // corresponding iterator position is then returned.
-    std::vector<double> rsq_tmp;
-    Param optimized_params = transformation_model_params;
-
-    for (Size i = 0; i < component_concentrations.size(); i++)
+    //
+    // The rsq (see calculateBiasAndR()) is computed from the weighted calibration points only, i.e. it does not
+    // depend on the fitted curve. Thus, the points are extracted and weighted once and no model is refitted.
+    TransformationModel::DataPoints data;
+    data.reserve(component_concentrations.size());
+    for (const AbsoluteQuantitationStandards::featureConcentration& cc : component_concentrations)
     {
-      std::vector<AbsoluteQuantitationStandards::featureConcentration> component_concentrations_tmp = component_concentrations;
-      component_concentrations_tmp.erase(component_concentrations_tmp.begin() + i);
-
-      // fit the model
-      optimized_params = fitCalibration(component_concentrations_tmp,
-        feature_name,
-        transformation_model,
-        optimized_params);
-
-      // calculate the R2 and bias
-      std::vector<double> biases;
-      double correlation_coefficient = 0.0;
-      calculateBiasAndR(
-        component_concentrations_tmp,
-        feature_name,
-        transformation_model,
-        optimized_params,
-        biases,
-        correlation_coefficient);
+      data.emplace_back(cc.actual_concentration / cc.IS_actual_concentration,
+        calculateRatio(cc.feature, cc.IS_feature, feature_name) / cc.dilution_factor);
+    }
+    TransformationModel tm(data, transformation_model_params);
+    tm.weightData(data);
 
-      rsq_tmp.push_back(correlation_coefficient);
+    std::vector<double> rsq_tmp;
+    std::vector<double> x, y;
+    for (Size i = 0; i < data.size(); i++)
+    {
+      x.clear();
+      y.clear();
+      for (Size j = 0; j < data.size(); ++j)
+      {
+        if (j == i) continue;
+        x.push_back(data[j].first);
+        y.push_back(data[j].second);
+      }
+      rsq_tmp.push_back(Math::pearsonCorrelationCoefficient(x.begin(), x.end(), y.begin(), y.end()));
     }
     return max_element(rsq_tmp.begin(), rsq_tmp.end()) - rsq_tmp.begin();
   }
@@ -619,78 +624,100 @@ namespace OpenMS
   void AbsoluteQuantitation::optimizeCalibrationCurves(
     std::map<String, std::vector<AbsoluteQuantitationStandards::featureConcentration>> & components_concentrations)
   {
-    std::map<String, std::vector<AbsoluteQuantitationStandards::featureConcentration>>& cc = components_concentrations;
+    if (optimization_method_ != "iterative")
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "Unsupported calibration curve optimization method '" + optimization_method_ + "'.");
+    }
+
+    // the components are independent of each other, so their curves are optimized concurrently
+    std::vector<std::pair<AbsoluteQuantitationMethod*, std::vector<AbsoluteQuantitationStandards::featureConcentration>*>> jobs;
     for (std::pair<const String, AbsoluteQuantitationMethod>& quant_method : quant_methods_)
     {
-      const String& component_name = quant_method.first;
-      AbsoluteQuantitationMethod& component_aqm = quant_method.second;
-      if (cc.count(component_name) && optimization_method_ == "iterative")
+      auto cc_it = components_concentrations.find(quant_method.first);
+      if (cc_it == components_concentrations.end())
       {
-        // optimize the calibration curve for the component
-        Param optimized_params;
-        bool optimal_calibration_found = optimizeCalibrationCurveIterative(
-          cc[component_name],
-          component_aqm.getFeatureName(),
-          component_aqm.getTransformationModel(),
-          component_aqm.getTransformationModelParams(),
-          optimized_params);
-
-        // order component concentrations and update the lloq and uloq
-        std::vector<AbsoluteQuantitationStandards::featureConcentration>::const_iterator it;
-        it = std::min_element(cc[component_name].begin(), cc[component_name].end(), [](
-            const AbsoluteQuantitationStandards::featureConcentration& lhs,
-            const AbsoluteQuantitationStandards::featureConcentration& rhs
-          )
-          {
-            return lhs.actual_concentration < rhs.actual_concentration;
-          }
-        );
-        component_aqm.setLLOQ(it->actual_concentration);
-        it = std::max_element(cc[component_name].begin(), cc[component_name].end(), [](
-            const AbsoluteQuantitationStandards::featureConcentration& lhs,
-            const AbsoluteQuantitationStandards::featureConcentration& rhs
-          )
-          {
-            return lhs.actual_concentration < rhs.actual_concentration;
-          }
-        );
-        component_aqm.setULOQ(it->actual_concentration);
+        OPENMS_LOG_DEBUG << "Warning: Standards not found for component " << quant_method.first << ".";
+        continue;
+      }
+      jobs.emplace_back(&quant_method.second, &cc_it->second);
+    }
 
-        if (optimal_calibration_found)
-        {
-          // calculate the R2 and bias
-          std::vector<double> biases;
-          double correlation_coefficient = 0.0;
-          calculateBiasAndR(
-            cc[component_name],
-            component_aqm.getFeatureName(),
-            component_aqm.getTransformationModel(),
-            optimized_params,
-            biases,
-            correlation_coefficient);
-
-          // record the updated information
-          component_aqm.setCorrelationCoefficient(correlation_coefficient);
-          component_aqm.setTransformationModelParams(optimized_params);
-          component_aqm.setNPoints(cc[component_name].size());
-        }
-        else 
-        {
-          component_aqm.setCorrelationCoefficient(0.0);
-          component_aqm.setNPoints(0);
-          component_aqm.setLLOQ(0.0);
-          component_aqm.setULOQ(0.0);
-        }
+    std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 1)
+    for (SignedSize job = 0; job < (SignedSize)jobs.size(); ++job)
+    {
+      try
+      {
+        optimizeCalibrationCurve_(*jobs[job].first, *jobs[job].second);
       }
-      else if (optimization_method_ != "iterative")
+      catch (...)
       {
-        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-          "Unsupported calibration curve optimization method '" + optimization_method_ + "'.");
+#pragma omp critical (AbsoluteQuantitation_error)
+        if (!error) error = std::current_exception();
       }
-      else
+    }
+    if (error) std::rethrow_exception(error);
+  }
+
+  void AbsoluteQuantitation::optimizeCalibrationCurve_(
+    AbsoluteQuantitationMethod& component_aqm,
+    std::vector<AbsoluteQuantitationStandards::featureConcentration>& component_concentrations)
+  {
+    // optimize the calibration curve for the component
+    Param optimized_params;
+    bool optimal_calibration_found = optimizeCalibrationCurveIterative(
+      component_concentrations,
+      component_aqm.getFeatureName(),
+      component_aqm.getTransformationModel(),
+      component_aqm.getTransformationModelParams(),
+      optimized_params);
+
+    // order component concentrations and update the lloq and uloq
+    std::vector<AbsoluteQuantitationStandards::featureConcentration>::const_iterator it;
+    it = std::min_element(component_concentrations.begin(), component_concentrations.end(), [](
+        const AbsoluteQuantitationStandards::featureConcentration& lhs,
+        const AbsoluteQuantitationStandards::featureConcentration& rhs
+      )
+      {
+        return lhs.actual_concentration < rhs.actual_concentration;
+      }
+    );
+    component_aqm.setLLOQ(it->actual_concentration);
+    it = std::max_element(component_concentrations.begin(), component_concentrations.end(), [](
+        const AbsoluteQuantitationStandards::featureConcentration& lhs,
+        const AbsoluteQuantitationStandards::featureConcentration& rhs
+      )
       {
-        OPENMS_LOG_DEBUG << "Warning: Standards not found for component " << component_name << ".";
+        return lhs.actual_concentration < rhs.actual_concentration;
       }
+    );
+    component_aqm.setULOQ(it->actual_concentration);
+
+    if (optimal_calibration_found)
+    {
+      // calculate the R2 and bias
+      std::vector<double> biases;
+      double correlation_coefficient = 0.0;
+      calculateBiasAndR(
+        component_concentrations,
+        component_aqm.getFeatureName(),
+        component_aqm.getTransformationModel(),
+        optimized_params,
+        biases,
+        correlation_coefficient);
+
+      // record the updated information
+      component_aqm.setCorrelationCoefficient(correlation_coefficient);
+      component_aqm.setTransformationModelParams(optimized_params);
+      component_aqm.setNPoints(component_concentrations.size());
+    }
+    else
+    {
+      component_aqm.setCorrelationCoefficient(0.0);
+      component_aqm.setNPoints(0);
+      component_aqm.setLLOQ(0.0);
+      component_aqm.setULOQ(0.0);
     }
   }
 
@@ -38,11 +38,13 @@
 #include <OpenMS/ANALYSIS/QUANTITATION/TMTTenPlexQuantitationMethod.h>
 #include <OpenMS/ANALYSIS/QUANTITATION/TMTElevenPlexQuantitationMethod.h>
 #include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/CONCEPT/ParallelExecution.h>
 #include <OpenMS/KERNEL/RangeUtils.h>
 #include <OpenMS/KERNEL/ConsensusFeature.h>
 #include <OpenMS/KERNEL/ConsensusMap.h>
 #include <OpenMS/MATH/STATISTICS/StatisticFunctions.h>
 
+
 // #define ISOBARIC_CHANNEL_EXTRACTOR_DEBUG
 // #undef ISOBARIC_CHANNEL_EXTRACTOR_DEBUG
 
@@ -67,6 +69,32 @@ namespace OpenMS
     int signal_not_unique;  ///< counts if more than one peak was found within the search window of each reporter position
   };
 
+  namespace
+  {
+    /// reporter ion lookup result of a single channel in a single scan
+    struct ExtractedChannelQC_
+    {
+      bool found = false; ///< a non-zero peak was found close to the expected reporter position
+      double mz_delta = 0.0; ///< m/z distance between expected and observed reporter ion
+      bool not_unique = false; ///< more than one peak was found within the allowed reporter mass shift
+    };
+
+    /// a quantifiable scan, its survey scans and the extracted channel intensities
+    struct ExtractedScan_
+    {
+      PeakMap::ConstIterator spec; ///< the scan used for quantification (MS2 or MS3)
+      PeakMap::ConstIterator ms2_spec; ///< the MS2 scan holding the MS1 precursor information
+      PeakMap::ConstIterator precursor_scan; ///< the MS1 scan preceding spec
+      PeakMap::ConstIterator follow_up_scan; ///< the MS1 scan following spec
+      double precursor_purity = -1.0;
+      bool extracted = false; ///< all filters passed and channel intensities are available
+      String message; ///< reason why the scan was skipped
+      String error; ///< missing information that prevents the extraction
+      std::vector<Peak2D::IntensityType> channel_intensities;
+      std::vector<ExtractedChannelQC_> channel_qc;
+    };
+  }
+
 
   IsobaricChannelExtractor::PuritySate_::PuritySate_(const PeakMap& targetExp) :
     baseExperiment(targetExp)
@@ -416,7 +444,10 @@ namespace OpenMS
     return precursor_intensity / total_intensity;
   }
 
-  double IsobaricChannelExtractor::computePrecursorPurity_(const PeakMap::ConstIterator& ms2_spec, const PuritySate_& pState) const
+  double IsobaricChannelExtractor::computePrecursorPurity_(const PeakMap::ConstIterator& ms2_spec,
+                                                           const PeakMap::ConstIterator& precursor_scan,
+                                                           const PeakMap::ConstIterator& follow_up_scan,
+                                                           const PeakMap::ConstIterator& exp_end) const
   {
     // we cannot analyze precursors without a charge
     if (ms2_spec->getPrecursors()[0].getCharge() == 0)
@@ -430,18 +461,18 @@ namespace OpenMS
 #endif
 
       // compute purity of preceding ms1 scan
-      double early_scan_purity = computeSingleScanPrecursorPurity_(ms2_spec, *(pState.precursorScan));
+      double early_scan_purity = computeSingleScanPrecursorPurity_(ms2_spec, *precursor_scan);
 
-      if (pState.hasFollowUpScan && interpolate_precursor_purity_)
+      if (follow_up_scan != exp_end && interpolate_precursor_purity_)
       {
-        double late_scan_purity = computeSingleScanPrecursorPurity_(ms2_spec, *(pState.followUpScan));
+        double late_scan_purity = computeSingleScanPrecursorPurity_(ms2_spec, *follow_up_scan);
 
         // calculating the extrapolated, S2I value as a time weighted linear combination of the two scans
         // see: Savitski MM, Sweetman G, Askenazi M, Marto JA, Lang M, Zinn N, et al. (2011).
         // Analytical chemistry 83: 8959–67. http://www.ncbi.nlm.nih.gov/pubmed/22017476
         // std::fabs is applied to compensate for potentially negative RTs
-        return std::fabs(ms2_spec->getRT() - pState.precursorScan->getRT()) *
-               ((late_scan_purity - early_scan_purity) / std::fabs(pState.followUpScan->getRT() - pState.precursorScan->getRT()))
+        return std::fabs(ms2_spec->getRT() - precursor_scan->getRT()) *
+               ((late_scan_purity - early_scan_purity) / std::fabs(follow_up_scan->getRT() - precursor_scan->getRT()))
                + early_scan_purity;
       }
       else
@@ -518,9 +549,11 @@ namespace OpenMS
     const double qc_dist_mz = 0.5; // fixed! Do not change!
 
     Size number_of_channels = quant_method_->getNumberOfChannels();
+    const IsobaricQuantitationMethod::IsobaricChannelList& channels = quant_method_->getChannelInformation();
 
-    PeakMap::ConstIterator it_last_MS2 = ms_exp_data.end(); // remember last MS2 spec, to get precursor in MS1 (also if quant is in MS3)
-
+    // first pass: collect all quantifiable scans together with their survey (MS1) scans,
+    // which only depends on the scan order and is therefore done sequentially
+    std::vector<ExtractedScan_> scans;
     for (PeakMap::ConstIterator it = ms_exp_data.begin(); it != ms_exp_data.end(); ++it)
     {
       // remember the last MS1 spectra as we assume it to be the precursor spectrum
@@ -528,8 +561,6 @@ namespace OpenMS
       {
         // remember potential precursor and continue
         pState.precursorScan = it;
-        // reset last MS2 -- we expect to see a new one soon and the old one should not be used for the following MS3 (if any)
-        it_last_MS2 = ms_exp_data.end();
         continue;
       }
 
@@ -551,64 +582,68 @@ namespace OpenMS
         continue;
       }
 
+      if (pState.precursorScan == ms_exp_data.end())
+      {
+        OPENMS_LOG_INFO << "No precursor available for spectrum: " << it->getNativeID() << std::endl;
+      }
+
+      ExtractedScan_ scan;
+      scan.spec = it;
+      scan.precursor_scan = pState.precursorScan;
+      scan.follow_up_scan = pState.hasFollowUpScan ? pState.followUpScan : ms_exp_data.end();
+      scans.push_back(scan);
+    }
+
+    // second pass: compute purity and extract the reporter intensities of each scan independently
+    ParallelExecution::forEach(0, static_cast<SignedSize>(scans.size()), [&](SignedSize i)
+    {
+      ExtractedScan_& scan = scans[i];
+      const PeakMap::ConstIterator it = scan.spec;
+
       // check precursor purity if we have a valid precursor ..
-      double precursor_purity = -1.0;
-      if (pState.precursorScan != ms_exp_data.end())
+      if (scan.precursor_scan != ms_exp_data.end())
       {
-        precursor_purity = computePrecursorPurity_(it, pState);
+        scan.precursor_purity = computePrecursorPurity_(it, scan.precursor_scan, scan.follow_up_scan, ms_exp_data.end());
         // check if purity is high enough
-        if (precursor_purity < min_precursor_purity_)
+        if (scan.precursor_purity < min_precursor_purity_)
         {
-          OPENMS_LOG_DEBUG << "Skip spectrum " << it->getNativeID() << ": Precursor purity is below the threshold. [purity = " << precursor_purity << "]" << std::endl;
-          continue;
+          scan.message = String("Skip spectrum ") + it->getNativeID() + ": Precursor purity is below the threshold. [purity = " + String(scan.precursor_purity) + "]";
+          return;
         }
       }
-      else
-      {
-        OPENMS_LOG_INFO << "No precursor available for spectrum: " << it->getNativeID() << std::endl;
-      }
 
       if (it->getMSLevel() == 3)
       {
         // we cannot save just the last MS2 but need to compare to the precursor info stored in the (potential MS3 spectrum)
-        it_last_MS2 = ms_exp_data.getPrecursorSpectrum(it);
+        scan.ms2_spec = ms_exp_data.getPrecursorSpectrum(it);
 
-        if (it_last_MS2 == ms_exp_data.end())
+        if (scan.ms2_spec == ms_exp_data.end())
         { // this only happens if an MS3 spec does not have a preceding MS2
-          throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("No MS2 precursor information given for MS3 scan native ID ") + it->getNativeID() + " with RT " + String(it->getRT()));
+          scan.error = String("No MS2 precursor information given for MS3 scan native ID ") + it->getNativeID() + " with RT " + String(it->getRT());
+          return;
         }
       }
       else
       {
-        it_last_MS2 = it;
+        scan.ms2_spec = it;
       }
 
       // check if MS1 precursor info is available
-      if (it_last_MS2->getPrecursors().empty())
+      if (scan.ms2_spec->getPrecursors().empty())
       {
-        throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("No precursor information given for scan native ID ") + it->getNativeID() + " with RT " + String(it->getRT()));
+        scan.error = String("No precursor information given for scan native ID ") + it->getNativeID() + " with RT " + String(it->getRT());
+        return;
       }
 
-      // store RT of MS2 scan and MZ of MS1 precursor ion as centroid of ConsensusFeature
-      ConsensusFeature cf;
-      cf.setUniqueId();
-      cf.setRT(it_last_MS2->getRT());
-      cf.setMZ(it_last_MS2->getPrecursors()[0].getMZ());
-
-      Peak2D channel_value;
-      channel_value.setRT(it->getRT());
-      // for each each channel
-      UInt64 map_index = 0;
-      Peak2D::IntensityType overall_intensity = 0;
+      scan.channel_intensities.resize(channels.size(), 0);
+      scan.channel_qc.resize(channels.size());
 
-      for (IsobaricQuantitationMethod::IsobaricChannelList::const_iterator cl_it = quant_method_->getChannelInformation().begin();
-            cl_it != quant_method_->getChannelInformation().end();
-            ++cl_it)
+      Size channel_idx = 0;
+      for (IsobaricQuantitationMethod::IsobaricChannelList::const_iterator cl_it = channels.begin();
+            cl_it != channels.end();
+            ++cl_it, ++channel_idx)
       {
-        // set mz-position of channel
-        channel_value.setMZ(cl_it->center);
-        // reset intensity
-        channel_value.setIntensity(0);
+        Peak2D::IntensityType channel_intensity = 0;
 
         // as every evaluation requires time, we cache the MZEnd iterator
         const PeakMap::SpectrumType::ConstIterator mz_end = it->MZEnd(cl_it->center + qc_dist_mz);
@@ -634,21 +669,69 @@ namespace OpenMS
         {
           double mz_delta = cl_it->center - idx_nearest->getMZ();
           // stats: we don't care what shift the user specified
-          channel_mz_delta[cl_it->name].mz_deltas.push_back(mz_delta);
-          if (peak_count > 1) ++channel_mz_delta[cl_it->name].signal_not_unique;
+          scan.channel_qc[channel_idx].found = true;
+          scan.channel_qc[channel_idx].mz_delta = mz_delta;
+          scan.channel_qc[channel_idx].not_unique = peak_count > 1;
           // pass user threshold
           if (std::fabs(mz_delta) < reporter_mass_shift_)
           {
-            channel_value.setIntensity(idx_nearest->getIntensity());
+            channel_intensity = idx_nearest->getIntensity();
           }
         }
 
         // discard contribution of this channel as it is below the required intensity threshold
-        if (channel_value.getIntensity() < min_reporter_intensity_)
+        if (channel_intensity < min_reporter_intensity_)
+        {
+          channel_intensity = 0;
+        }
+        scan.channel_intensities[channel_idx] = channel_intensity;
+      } // ! channel_iterator
+
+      scan.extracted = true;
+    }, ParallelExecution::Schedule::DYNAMIC, 16);
+
+    // third pass: assemble the consensus features in the order of the scans in the experiment
+    for (std::vector<ExtractedScan_>::const_iterator scan_it = scans.begin(); scan_it != scans.end(); ++scan_it)
+    {
+      if (!scan_it->error.empty())
+      {
+        throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, scan_it->error);
+      }
+      if (!scan_it->extracted)
+      {
+        OPENMS_LOG_DEBUG << scan_it->message << std::endl;
+        continue;
+      }
+
+      const PeakMap::ConstIterator it = scan_it->spec;
+
+      // store RT of MS2 scan and MZ of MS1 precursor ion as centroid of ConsensusFeature
+      ConsensusFeature cf;
+      cf.setUniqueId();
+      cf.setRT(scan_it->ms2_spec->getRT());
+      cf.setMZ(scan_it->ms2_spec->getPrecursors()[0].getMZ());
+
+      Peak2D channel_value;
+      channel_value.setRT(it->getRT());
+      // for each each channel
+      UInt64 map_index = 0;
+      Peak2D::IntensityType overall_intensity = 0;
+
+      for (IsobaricQuantitationMethod::IsobaricChannelList::const_iterator cl_it = channels.begin();
+            cl_it != channels.end();
+            ++cl_it)
+      {
+        const ExtractedChannelQC_& qc = scan_it->channel_qc[map_index];
+        if (qc.found)
         {
-          channel_value.setIntensity(0);
+          channel_mz_delta[cl_it->name].mz_deltas.push_back(qc.mz_delta);
+          if (qc.not_unique) ++channel_mz_delta[cl_it->name].signal_not_unique;
         }
 
+        // set mz-position and intensity of channel
+        channel_value.setMZ(cl_it->center);
+        channel_value.setIntensity(scan_it->channel_intensities[map_index]);
+
         overall_intensity += channel_value.getIntensity();
         // add channel to ConsensusFeature
         cf.insert(map_index, channel_value, element_index);
@@ -667,9 +750,9 @@ namespace OpenMS
         cf.setMetaValue("all_empty", String("true"));
       }
       // add purity information if we could compute it
-      if (precursor_purity > 0.0)
+      if (scan_it->precursor_purity > 0.0)
       {
-        cf.setMetaValue("precursor_purity", precursor_purity);
+        cf.setMetaValue("precursor_purity", scan_it->precursor_purity);
       }
 
       // embed the id of the scan from which the quantitative information was extracted
@@ -74,10 +74,6 @@ namespace OpenMS
     // convert to Eigen matrix
     EigenMatrixXdPtr m(convertOpenMSMatrix2EigenMatrixXd(correction_matrix));
     Eigen::FullPivLU<Eigen::MatrixXd> ludecomp(*m);
-    Eigen::VectorXd b;
-    b.resize(quant_method->getNumberOfChannels());
-    b.setZero();
-    std::vector<double> x(quant_method->getNumberOfChannels(), 0);
 
     if (!ludecomp.isInvertible())
     {
@@ -85,9 +81,25 @@ namespace OpenMS
       throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "IsobaricIsotopeCorrector: The given isotope correction matrix is not invertible!");
     }
 
+    // resolve the channel ids of the input map's columns only once
+    const std::map<Size, Int> channel_ids = getChannelIds_(consensus_map_in);
+
+    // collect the reporter intensities of all consensus elements (one column per element) ..
+    const Size channel_count = quant_method->getNumberOfChannels();
+    Eigen::MatrixXd b_all(channel_count, consensus_map_in.size());
+    for (ConsensusMap::size_type i = 0; i < consensus_map_in.size(); ++i)
+    {
+      Eigen::VectorXd b(Eigen::VectorXd::Zero(channel_count));
+      fillInputVector_(b, consensus_map_in[i], channel_ids);
+      b_all.col(i) = b;
+    }
+
+    // .. and solve them at once, reusing the factorization of the correction matrix
+    const Eigen::MatrixXd x_all = ludecomp.solve(b_all);
+
     // data structures for NNLS
-    Matrix<double> m_b(quant_method->getNumberOfChannels(), 1);
-    Matrix<double> m_x(quant_method->getNumberOfChannels(), 1);
+    Matrix<double> m_b(channel_count, 1);
+    Matrix<double> m_x(channel_count, 1);
 
     // correct all consensus elements
     for (ConsensusMap::size_type i = 0; i < consensus_map_out.size(); ++i)
@@ -98,43 +110,59 @@ namespace OpenMS
       // delete only the consensus handles from the output map
       consensus_map_out[i].clear();
 
-      // fill b vector
-      fillInputVector_(b, m_b, consensus_map_in[i], consensus_map_in);
-
-      //solve
-      Eigen::MatrixXd e_mx = ludecomp.solve(b);
-      if (!((*m) * e_mx).isApprox(b))
+      const Eigen::MatrixXd e_mx = x_all.col(i);
+      if (!((*m) * e_mx).isApprox(b_all.col(i)))
       {
         throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "IsobaricIsotopeCorrector: Cannot multiply!");
       }
+
+      // the NNLS solver keeps its state in static variables, so the elements are corrected sequentially
+      for (Size row = 0; row < channel_count; ++row)
+      {
+        m_b(row, 0) = b_all(row, i);
+      }
       solveNNLS_(correction_matrix, m_b, m_x);
 
       // update the output consensus map with the corrected intensities
-      float cf_intensity = updateOutpuMap_(consensus_map_in, consensus_map_out, i, m_x);
+      float cf_intensity = updateOutpuMap_(consensus_map_in, consensus_map_out, i, m_x, channel_ids);
 
       // check consistency
-      computeStats_(m_x, e_mx, cf_intensity, quant_method, stats);    
+      computeStats_(m_x, e_mx, cf_intensity, quant_method, stats);
     }
 
     return stats;
   }
 
+  std::map<Size, Int>
+  IsobaricIsotopeCorrector::getChannelIds_(const ConsensusMap& cm)
+  {
+    std::map<Size, Int> channel_ids;
+    for (ConsensusMap::ColumnHeaders::const_iterator it = cm.getColumnHeaders().begin();
+         it != cm.getColumnHeaders().end();
+         ++it)
+    {
+      if (it->second.metaValueExists("channel_id"))
+      {
+        channel_ids[it->first] = Int(it->second.getMetaValue("channel_id"));
+      }
+    }
+    return channel_ids;
+  }
+
   void
   IsobaricIsotopeCorrector::fillInputVector_(Eigen::VectorXd& b,
-                                             Matrix<double>& m_b, const ConsensusFeature& cf, const ConsensusMap& cm)
+                                             const ConsensusFeature& cf, const std::map<Size, Int>& channel_ids)
   {
     for (ConsensusFeature::HandleSetType::const_iterator it_elements = cf.getFeatures().begin();
          it_elements != cf.getFeatures().end();
          ++it_elements)
     {
       //find channel_id of current element
-      Int index = Int(cm.getColumnHeaders().find(it_elements->getMapIndex())->second.getMetaValue("channel_id"));
+      Int index = channel_ids.find(it_elements->getMapIndex())->second;
 #ifdef ISOBARIC_QUANT_DEBUG
       std::cout << "  map_index " << it_elements->getMapIndex() << "-> id " << index << " with intensity " << it_elements->getIntensity() << "\n" << std::endl;
 #endif
-      // this is deprecated, but serves as quality measurement
       b(index) = it_elements->getIntensity();
-      m_b(index, 0) = it_elements->getIntensity();
     }
   }
 
@@ -192,7 +220,8 @@ namespace OpenMS
   float
   IsobaricIsotopeCorrector::updateOutpuMap_(
     const ConsensusMap& consensus_map_in, ConsensusMap& consensus_map_out,
-    ConsensusMap::size_type current_cf, const Matrix<double>& m_x)
+    ConsensusMap::size_type current_cf, const Matrix<double>& m_x,
+    const std::map<Size, Int>& channel_ids)
   {
     float cf_intensity(0);
     for (ConsensusFeature::HandleSetType::const_iterator it_elements = consensus_map_in[current_cf].begin();
@@ -201,7 +230,7 @@ namespace OpenMS
     {
       FeatureHandle handle = *it_elements;
       //find channel_id of current element
-      Int index = Int(consensus_map_out.getColumnHeaders()[it_elements->getMapIndex()].getMetaValue("channel_id"));
+      Int index = channel_ids.find(it_elements->getMapIndex())->second;
       handle.setIntensity(float(m_x(index, 0)));
 
       consensus_map_out[current_cf].insert(handle);
@@ -36,6 +36,12 @@
 #include <OpenMS/ANALYSIS/QUANTITATION/PeptideAndProteinQuant.h>
 #include <OpenMS/MATH/STATISTICS/StatisticFunctions.h>
 
+#include <boost/functional/hash.hpp>
+
+#include <limits>
+#include <tuple>
+#include <unordered_map>
+
 using namespace std;
 
 namespace OpenMS
@@ -70,17 +76,50 @@ namespace OpenMS
     defaultsToParam_();
   }
 
+  Size PeptideAndProteinQuant::SequenceHash_::operator()(const AASequence* seq) const
+  {
+    // AASequence::operator< compares one letter codes and modifications of the residues and the ids of terminal modifications
+    Size hash = seq->size();
+    for (const Residue& residue : *seq)
+    {
+      boost::hash_combine(hash, std::hash<String>()(residue.getOneLetterCode()));
+      boost::hash_combine(hash, residue.getModification());
+    }
+    if (seq->hasNTerminalModification())
+    {
+      boost::hash_combine(hash, std::hash<String>()(seq->getNTerminalModification()->getId()));
+    }
+    if (seq->hasCTerminalModification())
+    {
+      boost::hash_combine(hash, std::hash<String>()(seq->getCTerminalModification()->getId()) + 1);
+    }
+    return hash;
+  }
+
+  PeptideAndProteinQuant::PeptideData& PeptideAndProteinQuant::getPeptideData_(
+    const AASequence& seq,
+    PeptideIndex_& index)
+  {
+    PeptideIndex_::const_iterator pos = index.find(&seq);
+    if (pos != index.end()) return *pos->second;
+
+    PeptideQuant::iterator entry = pep_quant_.insert(PeptideQuant::value_type(seq, PeptideData())).first;
+    index.emplace(&entry->first, &entry->second);
+    return entry->second;
+  }
+
   // doesn't only count but also some initialization TODO: rename
   void PeptideAndProteinQuant::countPeptides_(
     vector<PeptideIdentification>& peptides, 
-    const Size& n_fractions)
+    const Size& n_fractions,
+    PeptideIndex_& index)
   {
     for (auto & pep : peptides)
     {
       if (pep.getHits().empty()) continue;
       pep.sort(); // TODO: move this out of count peptides
       const PeptideHit& hit = pep.getHits()[0]; // get best hit
-      PeptideData& data = pep_quant_[hit.getSequence()];
+      PeptideData& data = getPeptideData_(hit.getSequence(), index);
       data.psm_count++;
 
       // TODO: why is this needed
@@ -122,14 +161,15 @@ namespace OpenMS
   void PeptideAndProteinQuant::quantifyFeature_(const FeatureHandle& feature,
                                                 const size_t fraction,
                                                 const size_t sample,
-                                                const PeptideHit& hit)
+                                                const PeptideHit& hit,
+                                                PeptideIndex_& index)
   {
     // return if annotation for the feature is ambiguous or missing
     if (hit == PeptideHit()) { return; }
 
     stats_.quant_features++;
     const AASequence& seq = hit.getSequence();
-    pep_quant_[seq].abundances[fraction][hit.getCharge()][sample] +=
+    getPeptideData_(seq, index).abundances[fraction][hit.getCharge()][sample] +=
       feature.getIntensity(); // new map element is initialized with 0
   }
 
@@ -194,9 +234,10 @@ namespace OpenMS
 
     //////////////////////////////////////////////////////
     // second, perform the actual peptide quantification:
+    const bool best_charge_and_fraction = param_.getValue("best_charge_and_fraction") == "true";
     for (auto & pep_q : pep_quant_)
     {
-      if (param_.getValue("best_charge_and_fraction") == "true")
+      if (best_charge_and_fraction)
       { // quantify according to the best charge state only:
 
         // determine which fraction and charge state yields the maximum number of abundances 
@@ -383,6 +424,8 @@ namespace OpenMS
 
     // for (auto & a : accession_to_leader) { std::cout << a.first << "\tis led by:\t" << a.second << endl; }
 
+    // interned proteins: accession -> entry in prot_quant_ (hashing instead of repeated string comparisons)
+    std::unordered_map<String, ProteinData*> protein_index;
     for (auto const& pep_q : pep_quant_)
     {
       String accession = getAccession_(pep_q.second.accessions,
@@ -395,18 +438,26 @@ namespace OpenMS
       // proteotypic peptide
       const String peptide = pep_q.first.toUnmodifiedString();
 
-      prot_quant_[accession].psm_count += pep_q.second.psm_count;
+      std::unordered_map<String, ProteinData*>::const_iterator pos = protein_index.find(accession);
+      if (pos == protein_index.end())
+      {
+        pos = protein_index.emplace(accession, &prot_quant_[accession]).first;
+      }
+      ProteinData& protein = *pos->second;
+      protein.psm_count += pep_q.second.psm_count;
 
       // transfer abundances and counts from peptides->protein
       // summarize abundances and counts between different peptidoforms       
+      SampleAbundances& abundances = protein.abundances[peptide];
       for (auto const & sta : pep_q.second.total_abundances)
       {
-        prot_quant_[accession].abundances[peptide][sta.first] += sta.second;
+        abundances[sta.first] += sta.second;
       }
 
+      SampleAbundances& psm_counts = protein.psm_counts[peptide];
       for (auto const & sta : pep_q.second.total_psm_counts)
       {
-        prot_quant_[accession].psm_counts[peptide][sta.first] += sta.second;
+        psm_counts[sta.first] += sta.second;
       }
     }
 
@@ -415,8 +466,20 @@ namespace OpenMS
     bool include_all = param_.getValue("include_all") == "true";
     bool fix_peptides = param_.getValue("consensus:fix_peptides") == "true";
 
-    for (auto & prot_q : prot_quant_)
+    // proteins are independent of each other: roll up in parallel
+    std::vector<ProteinQuant::iterator> protein_its;
+    protein_its.reserve(prot_quant_.size());
+    for (ProteinQuant::iterator it = prot_quant_.begin(); it != prot_quant_.end(); ++it)
     {
+      protein_its.push_back(it);
+    }
+    Size too_few_peptides(0), quant_proteins(0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 50) reduction(+: too_few_peptides, quant_proteins)
+#endif
+    for (SignedSize prot_idx = 0; prot_idx < (SignedSize)protein_its.size(); ++prot_idx)
+    {
+      ProteinQuant::value_type& prot_q = *protein_its[prot_idx];
       const ProteinData& pd = prot_q.second;
 
       // calculate PSM counts based on all (!) peptides of a protein (group)
@@ -435,7 +498,7 @@ namespace OpenMS
       // select which peptides of the current protein (group) are quantified 
       if ((top > 0) && (prot_q.second.abundances.size() < top))
       { // not enough proteotypic peptides? skip protein (except if user chose to include the nevertheless)
-        stats_.too_few_peptides++;
+        too_few_peptides++;
         if (!include_all) { continue; }
       }
 
@@ -468,45 +531,49 @@ namespace OpenMS
       // done selecting peptides for quantification
 
       // consider only the selected peptides for quantification:
-      map<UInt64, DoubleList> abundances; // all peptide abundances by sample
+      vector<DoubleList> abundances; // all peptide abundances by sample (dense: index = sample ID)
       for (const auto & pep : peptides) // for all selected peptides
       { 
-        for (auto & sa : prot_q.second.abundances[pep]) // copy over abundances
+        for (auto & sa : prot_q.second.abundances.at(pep)) // copy over abundances
         {
+          if (sa.first >= abundances.size()) abundances.resize(sa.first + 1);
           abundances[sa.first].push_back(sa.second);
         }
       }
 
-      for (auto & ab : abundances)
+      for (UInt64 sample = 0; sample < abundances.size(); ++sample)
       {
+        DoubleList& sample_abundances = abundances[sample];
+        if (sample_abundances.empty()) continue; // no peptide quantified in this sample
+
         // check if the protein has enough peptides in this sample
-        if (!include_all && (top > 0) && (ab.second.size() < top))
+        if (!include_all && (top > 0) && (sample_abundances.size() < top))
         {
           continue;
         }
 
         // if we have more than "top", reduce to the top ones
-        if ((top > 0) && (ab.second.size() > top))
+        if ((top > 0) && (sample_abundances.size() > top))
         {
           // sort descending:
-          sort(ab.second.begin(), ab.second.end(), greater<double>());
-          ab.second.resize(top); // remove all but best "top" values
+          sort(sample_abundances.begin(), sample_abundances.end(), greater<double>());
+          sample_abundances.resize(top); // remove all but best "top" values
         }
 
         double abundance_result;
         if (average == "median")
         {
-          abundance_result = Math::median(ab.second.begin(), ab.second.end());
+          abundance_result = Math::median(sample_abundances.begin(), sample_abundances.end());
         }
         else if (average == "mean")
         {
-          abundance_result = Math::mean(ab.second.begin(), ab.second.end());
+          abundance_result = Math::mean(sample_abundances.begin(), sample_abundances.end());
         }
         else if (average == "weighted_mean")
         {
           double sum_intensities = 0;
           double sum_intensities_squared = 0;
-          for (auto const & in : ab.second)
+          for (auto const & in : sample_abundances)
           {
             sum_intensities += in;
             sum_intensities_squared += in * in;
@@ -515,22 +582,25 @@ namespace OpenMS
         }
         else // "sum"
         {
-          abundance_result = Math::sum(ab.second.begin(), ab.second.end());
+          abundance_result = Math::sum(sample_abundances.begin(), sample_abundances.end());
         }
-        
-        prot_q.second.total_abundances[ab.first] = abundance_result;
+
+        // samples come in ascending order, so the new entry is appended
+        prot_q.second.total_abundances.emplace_hint(prot_q.second.total_abundances.end(), sample, 0.0)->second = abundance_result;
       }
 
       // update statistics:
       if (prot_q.second.total_abundances.empty()) 
       { 
-        stats_.too_few_peptides++; 
+        too_few_peptides++; 
       }
       else 
       {
-        stats_.quant_proteins++;
+        quant_proteins++;
       }
     }
+    stats_.too_few_peptides += too_few_peptides;
+    stats_.quant_proteins += quant_proteins;
   }
 
 
@@ -546,6 +616,7 @@ namespace OpenMS
 
     stats_.total_features = features.size();
 
+    PeptideIndex_ index;
     for (auto & f : features)
     {
       if (f.getPeptideIdentifications().empty())
@@ -554,13 +625,13 @@ namespace OpenMS
         continue;
       }
        
-      countPeptides_(f.getPeptideIdentifications(), 1);
+      countPeptides_(f.getPeptideIdentifications(), 1, index);
       PeptideHit hit = getAnnotation_(f.getPeptideIdentifications());
       FeatureHandle handle(0, f);
       const size_t fraction(1), sample(1);
-      quantifyFeature_(handle, fraction, sample, hit); // updates "stats_.quant_features"
+      quantifyFeature_(handle, fraction, sample, hit, index); // updates "stats_.quant_features"
     }
-    countPeptides_(features.getUnassignedPeptideIdentifications(), 1);
+    countPeptides_(features.getUnassignedPeptideIdentifications(), 1, index);
     stats_.total_peptides = pep_quant_.size();
     stats_.ambig_features = stats_.total_features - stats_.blank_features -
                             stats_.quant_features;
@@ -588,6 +659,22 @@ namespace OpenMS
     OPENMS_LOG_DEBUG << "  Fractions       : " << stats_.n_fractions << endl;
     OPENMS_LOG_DEBUG << "  Samples (Assays): " << stats_.n_samples << endl;
 
+    const ExperimentalDesign::MSFileSection& ms_file_section = ed.getMSFileSection();
+
+    // Abundances are first summed up in a dense matrix with one row per peptide, fraction and charge
+    // and one column per sample, and are copied to the nested maps in pep_quant_ once at the end.
+    Size n_columns = 0;
+    for (const ExperimentalDesign::MSFileSectionEntry& row : ms_file_section)
+    {
+      n_columns = std::max(n_columns, Size(row.sample) + 1);
+    }
+    typedef std::tuple<PeptideData*, Int, Int> RowKey; // peptide, fraction, charge
+    std::vector<RowKey> rows;
+    std::map<RowKey, Size> row_index;
+    std::vector<double> abundance_matrix;
+    std::vector<char> observed; // distinguishes "no feature" from an intensity of zero
+
+    PeptideIndex_ index;
     for (auto & c : consensus)
     {
       stats_.total_features += c.getFeatures().size();
@@ -599,20 +686,56 @@ namespace OpenMS
         continue;
       }
 
-      countPeptides_(c.getPeptideIdentifications(), stats_.n_fractions);
+      countPeptides_(c.getPeptideIdentifications(), stats_.n_fractions, index);
       PeptideHit hit = getAnnotation_(c.getPeptideIdentifications());
+      // return if annotation for the feature is ambiguous or missing
+      if (hit == PeptideHit()) { continue; }
+
+      // look up the peptide only once for all features
+      PeptideData* data = &getPeptideData_(hit.getSequence(), index);
+      const Int charge = hit.getCharge();
+      size_t current_fraction = std::numeric_limits<size_t>::max();
+      Size current_row = 0;
       for (auto const & f : c.getFeatures())
       {
         // indices in experimental design are 1-based (as in text file)
         // so we need to convert between them
         //TODO MULTIPLEXED: needs to be adapted for multiplexed experiments
-        size_t row = f.getMapIndex();
-        size_t fraction = ed.getMSFileSection()[row].fraction;
-        size_t sample = ed.getMSFileSection()[row].sample;
-        quantifyFeature_(f, fraction, sample, hit); // updates "stats_.quant_features"
+        const ExperimentalDesign::MSFileSectionEntry& row = ms_file_section[f.getMapIndex()];
+        if (row.fraction != current_fraction)
+        {
+          current_fraction = row.fraction;
+          RowKey key(data, Int(current_fraction), charge);
+          std::map<RowKey, Size>::const_iterator pos = row_index.find(key);
+          if (pos == row_index.end())
+          {
+            pos = row_index.emplace(key, rows.size()).first;
+            rows.push_back(key);
+            abundance_matrix.resize(abundance_matrix.size() + n_columns, 0.0);
+            observed.resize(observed.size() + n_columns, 0);
+          }
+          current_row = pos->second;
+        }
+        stats_.quant_features++;
+        const Size cell = current_row * n_columns + row.sample;
+        abundance_matrix[cell] += f.getIntensity();
+        observed[cell] = 1;
+      }
+    }
+    countPeptides_(consensus.getUnassignedPeptideIdentifications(), stats_.n_fractions, index);
+
+    // copy the dense abundances to pep_quant_ (same sums, as each cell was summed up in feature order)
+    for (Size r = 0; r < rows.size(); ++r)
+    {
+      SampleAbundances& sample_abundances = std::get<0>(rows[r])->abundances[std::get<1>(rows[r])][std::get<2>(rows[r])];
+      for (Size sample = 0; sample < n_columns; ++sample)
+      {
+        const Size cell = r * n_columns + sample;
+        if (!observed[cell]) continue;
+        // new map element is initialized with 0 (and samples come in ascending order)
+        sample_abundances.emplace_hint(sample_abundances.end(), sample, 0.0)->second += abundance_matrix[cell];
       }
     }
-    countPeptides_(consensus.getUnassignedPeptideIdentifications(), stats_.n_fractions);
     stats_.total_peptides = pep_quant_.size();
     stats_.ambig_features = stats_.total_features - stats_.blank_features -
                             stats_.quant_features;
@@ -637,7 +760,8 @@ namespace OpenMS
 
     stats_.total_features = peptides.size();
 
-    countPeptides_(peptides, stats_.n_fractions);
+    PeptideIndex_ index;
+    countPeptides_(peptides, stats_.n_fractions, index);
 
     map<String, String> identifier_to_ms_file;
     for (Size i = 0; i < proteins.size(); ++i)
@@ -700,7 +824,7 @@ namespace OpenMS
       size_t fraction = row->fraction;
 
       // count peptides in the different fractions, charge states, and samples
-      pep_quant_[seq].abundances[fraction][hit.getCharge()][sample] += 1;
+      getPeptideData_(seq, index).abundances[fraction][hit.getCharge()][sample] += 1;
     }
     stats_.total_peptides = pep_quant_.size();
   }
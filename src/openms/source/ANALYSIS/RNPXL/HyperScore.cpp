@@ -35,7 +35,9 @@
 #include <OpenMS/ANALYSIS/RNPXL/HyperScore.h>
 
 #include <OpenMS/KERNEL/MSSpectrum.h>
-#include <OpenMS/DATASTRUCTURES/MatchedIterator.h>
+#include <OpenMS/COMPARISON/SPECTRA/PeakMatcher.h>
+
+#include <cmath>
 
 using std::vector;
 
@@ -73,45 +75,30 @@ namespace OpenMS
       return 0.0;
     }
 
+    std::vector<double> theo_mz, exp_mz;
+    PeakMatcher::getMZs(theo_spectrum, theo_mz);
+    PeakMatcher::getMZs(exp_spectrum, exp_mz);
+    std::vector<double> lower, upper;
+    PeakMatcher::getToleranceWindows(theo_mz, fragment_mass_tolerance, fragment_mass_tolerance_unit_ppm, lower, upper);
+    std::vector<std::pair<Size, Size> > matches;
+    PeakMatcher::matchClosest(theo_mz, lower, upper, exp_mz, matches);
+
     int y_ion_count = 0;
     int b_ion_count = 0;
     double dot_product = 0.0;
-    if (fragment_mass_tolerance_unit_ppm) 
+    for (const auto& m : matches)
     {
-      MatchedIterator<PeakSpectrum, PpmTrait, true> it(theo_spectrum, exp_spectrum, fragment_mass_tolerance);
-      for (; it != it.end(); ++it)
+      dot_product += exp_spectrum[m.second].getIntensity() * theo_spectrum[m.first].getIntensity(); /* * mass_error */;
+      // fragment annotations in XL-MS data are more complex and do not start with the ion type, but the ion type always follows after a $
+      const String& ion_name = (*ion_names)[m.first];
+      if (ion_name[0] == 'y' || ion_name.hasSubstring("$y"))
       {
-        dot_product += (*it).getIntensity() * it.ref().getIntensity(); /* * mass_error */;
-        // fragment annotations in XL-MS data are more complex and do not start with the ion type, but the ion type always follows after a $
-        auto i = it.refIdx();
-        if ((*ion_names)[i][0] == 'y' || (*ion_names)[i].hasSubstring("$y"))
-        {
-          ++y_ion_count;
-        }
-        else if ((*ion_names)[i][0] == 'b' || (*ion_names)[i].hasSubstring("$b"))
-        {
-          ++b_ion_count;
-        }
+        ++y_ion_count;
       }
-    }
-    else
-    {
-      MatchedIterator<PeakSpectrum, DaTrait, true> it(theo_spectrum, exp_spectrum, fragment_mass_tolerance);
-      for (; it != it.end(); ++it)
+      else if (ion_name[0] == 'b' || ion_name.hasSubstring("$b"))
       {
-        dot_product += (*it).getIntensity() * it.ref().getIntensity(); /* * mass_error */;
-        // fragment annotations in XL-MS data are more complex and do not start with the ion type, but the ion type always follows after a $
-        auto i = it.refIdx();
-        if ((*ion_names)[i][0] == 'y' || (*ion_names)[i].hasSubstring("$y"))
-        {
-          ++y_ion_count;
-        }
-        else if ((*ion_names)[i][0] == 'b' || (*ion_names)[i].hasSubstring("$b"))
-        {
-          ++b_ion_count;
-        }
+        ++b_ion_count;
       }
-
     }
 
     // inefficient: calculates logs repeatedly
@@ -125,5 +112,44 @@ namespace OpenMS
     return hyperScore;
   }
 
+  double HyperScore::compute(double fragment_mass_tolerance, bool fragment_mass_tolerance_unit_ppm, const PeakSpectrum& exp_spectrum, const vector<double>& theo_mz, const vector<char>& theo_ion_types)
+  {
+    if (exp_spectrum.size() < 1 || theo_mz.size() < 1)
+    {
+      std::cout << "Warning: HyperScore: One of the given spectra is empty." << std::endl;
+      return 0.0;
+    }
+
+    std::vector<double> exp_mz;
+    PeakMatcher::getMZs(exp_spectrum, exp_mz);
+    std::vector<double> lower, upper;
+    PeakMatcher::getToleranceWindows(theo_mz, fragment_mass_tolerance, fragment_mass_tolerance_unit_ppm, lower, upper);
+
+    // same matching as MatchedIterator: the closest experimental peak (if within tolerance) for each theoretical peak
+    std::vector<std::pair<Size, Size> > matches;
+    PeakMatcher::matchClosest(theo_mz, lower, upper, exp_mz, matches);
+
+    int y_ion_count = 0;
+    int b_ion_count = 0;
+    double dot_product = 0.0;
+    for (const auto& m : matches)
+    {
+      dot_product += exp_spectrum[m.second].getIntensity();
+      if (theo_ion_types[m.first] == 'y')
+      {
+        ++y_ion_count;
+      }
+      else if (theo_ion_types[m.first] == 'b')
+      {
+        ++b_ion_count;
+      }
+    }
+
+    const int i_min = std::min(y_ion_count, b_ion_count);
+    const int i_max = std::max(y_ion_count, b_ion_count);
+    const double hyperScore = log1p(dot_product) + 2*logfactorial_(i_min) + logfactorial_(i_max, i_min + 1);
+    return hyperScore;
+  }
+
 }
 
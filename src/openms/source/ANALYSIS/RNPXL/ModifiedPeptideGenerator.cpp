@@ -175,9 +175,6 @@ namespace OpenMS
       return;
     }
 
-    const int N_TERM_MODIFICATION_INDEX = -1; // magic constant to distinguish N_TERM only modifications from ANYWHERE modifications placed at N-term residue
-    const int C_TERM_MODIFICATION_INDEX = -2; // magic constant to distinguish C_TERM only modifications from ANYWHERE modifications placed at C-term residue
-
     //keep a list of all possible modifications of this peptide
     vector<AASequence> modified_peptides;
 
@@ -187,6 +184,79 @@ namespace OpenMS
       modified_peptides.push_back(peptide);
     }
 
+    // iterate over each residue and build compatibility mapping describing
+    // which amino acid (peptide index) is compatible with which modification
+    const map<int, vector<const ResidueModification*> > map_compatibility = getCompatibleSites_(var_mods, peptide);
+
+    // Check if no compatible site that can be modified by variable
+    // modification. If so just return peptides without variable modifications.
+    const Size compatible_mod_sites = map_compatibility.size();
+    if (compatible_mod_sites == 0)
+    {
+      if (keep_unmodified)
+      {
+        all_modified_peptides.push_back(peptide);
+      }
+      return;
+    }
+
+    // generate powerset of max_variable_mods_per_peptide sized subset of all compatible modification sites
+    Size max_placements = std::min(max_variable_mods_per_peptide, compatible_mod_sites);
+    for (Size n_var_mods = 1; n_var_mods <= max_placements; ++n_var_mods)
+    {
+      // enumerate all modified peptides with n_var_mods variable modified residues
+      Size zeros = std::max((Size)0, compatible_mod_sites - n_var_mods);
+      vector<bool> subset_mask;
+
+      for (Size i = 0; i != compatible_mod_sites; ++i)
+      {
+        // create mask 000011 to select last (e.g. n_var_mods = 2) two compatible sites as subset from the set of all compatible sites
+        if (i < zeros)
+        {
+          subset_mask.push_back(false);
+        }
+        else
+        {
+          subset_mask.push_back(true);
+        }
+      }
+
+      // generate all subsets of compatible sites {000011, ... , 101000, 110000} with current number of allowed variable modifications per peptide
+      do
+      {
+        // create subset indices e.g.{4,12} from subset mask e.g. 1010000 corresponding to the positions in the peptide sequence
+        vector<int> subset_indices;
+        map<int, vector<const ResidueModification*> >::const_iterator mit = map_compatibility.begin();
+        for (Size i = 0; i != compatible_mod_sites; ++i, ++mit)
+        {
+          if (subset_mask[i])
+          {
+            subset_indices.push_back(mit->first);
+          }
+        }
+
+        // now enumerate all modifications
+        recurseAndGenerateVariableModifiedPeptides_(subset_indices, map_compatibility, var_mods, 0, peptide, modified_peptides);
+      } while (next_permutation(subset_mask.begin(), subset_mask.end()));
+    }
+    // add modified version of the current peptide to the list of all peptides
+    
+    all_modified_peptides.insert(
+      all_modified_peptides.end(), 
+      make_move_iterator(modified_peptides.begin()), 
+      make_move_iterator(modified_peptides.end())); 
+      
+  }
+
+
+  // static
+  map<int, vector<const ResidueModification*> > ModifiedPeptideGenerator::getCompatibleSites_(
+    const MapToResidueType& var_mods,
+    const AASequence& peptide)
+  {
+    const int N_TERM_MODIFICATION_INDEX = N_TERM_SITE; // magic constant to distinguish N_TERM only modifications from ANYWHERE modifications placed at N-term residue
+    const int C_TERM_MODIFICATION_INDEX = C_TERM_SITE; // magic constant to distinguish C_TERM only modifications from ANYWHERE modifications placed at C-term residue
+
     // iterate over each residue and build compatibility mapping describing
     // which amino acid (peptide index) is compatible with which modification
     map<int, vector<const ResidueModification*> > map_compatibility;
@@ -252,67 +322,9 @@ namespace OpenMS
       }
     }
 
-    // Check if no compatible site that can be modified by variable
-    // modification. If so just return peptides without variable modifications.
-    const Size compatible_mod_sites = map_compatibility.size();
-    if (compatible_mod_sites == 0)
-    {
-      if (keep_unmodified)
-      {
-        all_modified_peptides.push_back(peptide);
-      }
-      return;
-    }
-
-    // generate powerset of max_variable_mods_per_peptide sized subset of all compatible modification sites
-    Size max_placements = std::min(max_variable_mods_per_peptide, compatible_mod_sites);
-    for (Size n_var_mods = 1; n_var_mods <= max_placements; ++n_var_mods)
-    {
-      // enumerate all modified peptides with n_var_mods variable modified residues
-      Size zeros = std::max((Size)0, compatible_mod_sites - n_var_mods);
-      vector<bool> subset_mask;
-
-      for (Size i = 0; i != compatible_mod_sites; ++i)
-      {
-        // create mask 000011 to select last (e.g. n_var_mods = 2) two compatible sites as subset from the set of all compatible sites
-        if (i < zeros)
-        {
-          subset_mask.push_back(false);
-        }
-        else
-        {
-          subset_mask.push_back(true);
-        }
-      }
-
-      // generate all subsets of compatible sites {000011, ... , 101000, 110000} with current number of allowed variable modifications per peptide
-      do
-      {
-        // create subset indices e.g.{4,12} from subset mask e.g. 1010000 corresponding to the positions in the peptide sequence
-        vector<int> subset_indices;
-        map<int, vector<const ResidueModification*> >::const_iterator mit = map_compatibility.begin();
-        for (Size i = 0; i != compatible_mod_sites; ++i, ++mit)
-        {
-          if (subset_mask[i])
-          {
-            subset_indices.push_back(mit->first);
-          }
-        }
-
-        // now enumerate all modifications
-        recurseAndGenerateVariableModifiedPeptides_(subset_indices, map_compatibility, var_mods, 0, peptide, modified_peptides);
-      } while (next_permutation(subset_mask.begin(), subset_mask.end()));
-    }
-    // add modified version of the current peptide to the list of all peptides
-    
-    all_modified_peptides.insert(
-      all_modified_peptides.end(), 
-      make_move_iterator(modified_peptides.begin()), 
-      make_move_iterator(modified_peptides.end())); 
-      
+    return map_compatibility;
   }
 
-
   // static
   void ModifiedPeptideGenerator::recurseAndGenerateVariableModifiedPeptides_(
     const vector<int>& subset_indices, 
@@ -322,8 +334,8 @@ namespace OpenMS
     const AASequence& current_peptide, 
     vector<AASequence>& modified_peptides)
   {
-    const int N_TERM_MODIFICATION_INDEX = -1; // magic constant to distinguish N_TERM only modifications from ANYWHERE modifications placed at N-term residue
-    const int C_TERM_MODIFICATION_INDEX = -2; // magic constant to distinguish C_TERM only modifications from ANYWHERE modifications placed at C-term residue
+    const int N_TERM_MODIFICATION_INDEX = N_TERM_SITE; // magic constant to distinguish N_TERM only modifications from ANYWHERE modifications placed at N-term residue
+    const int C_TERM_MODIFICATION_INDEX = C_TERM_SITE; // magic constant to distinguish C_TERM only modifications from ANYWHERE modifications placed at C-term residue
 
     // cout << depth << " " << subset_indices.size() << " " << current_peptide.toString() << endl;
 
@@ -422,5 +434,140 @@ namespace OpenMS
       }
     }
   }
-}
 
+  ModifiedPeptideGenerator::VariantEnumerator::VariantEnumerator(
+    const MapToResidueType& var_mods,
+    const AASequence& peptide,
+    Size max_variable_mods_per_peptide,
+    bool keep_unmodified) :
+    var_mods_(var_mods),
+    peptide_(peptide),
+    keep_unmodified_(keep_unmodified),
+    max_placements_(0),
+    n_mods_(0),
+    mass_delta_(0.0),
+    started_(false)
+  {
+    if (!var_mods.val.empty() && max_variable_mods_per_peptide != 0)
+    {
+      const map<int, vector<const ResidueModification*> > map_compatibility = getCompatibleSites_(var_mods, peptide);
+      sites_.assign(map_compatibility.begin(), map_compatibility.end());
+    }
+    max_placements_ = std::min(max_variable_mods_per_peptide, sites_.size());
+  }
+
+  void ModifiedPeptideGenerator::VariantEnumerator::initSubset_()
+  {
+    // mask 000011 selects the last n_mods_ sites first (as in applyVariableModifications())
+    subset_mask_.assign(sites_.size(), false);
+    std::fill(subset_mask_.end() - n_mods_, subset_mask_.end(), true);
+    initPlacements_();
+  }
+
+  void ModifiedPeptideGenerator::VariantEnumerator::initPlacements_()
+  {
+    subset_.clear();
+    for (Size i = 0; i != subset_mask_.size(); ++i)
+    {
+      if (subset_mask_[i]) subset_.push_back(i);
+    }
+    choice_.assign(subset_.size(), 0);
+    placements_.resize(subset_.size());
+    mass_delta_ = 0.0;
+    for (Size d = 0; d != subset_.size(); ++d)
+    {
+      const auto& site = sites_[subset_[d]];
+      placements_[d] = ModificationPlacement{site.first, site.second[0]};
+      mass_delta_ += site.second[0]->getDiffMonoMass();
+    }
+  }
+
+  bool ModifiedPeptideGenerator::VariantEnumerator::next()
+  {
+    if (!started_)
+    {
+      started_ = true;
+      if (keep_unmodified_) return true; // the unmodified peptide comes first
+      if (max_placements_ == 0) return false;
+      n_mods_ = 1;
+      initSubset_();
+      return true;
+    }
+    if (n_mods_ == 0) // we just reported the unmodified peptide
+    {
+      if (max_placements_ == 0) return false;
+      n_mods_ = 1;
+      initSubset_();
+      return true;
+    }
+
+    // next modification of the current subset: the last site changes fastest (like the recursion in applyVariableModifications())
+    for (Size d = subset_.size(); d-- > 0; )
+    {
+      const vector<const ResidueModification*>& mods = sites_[subset_[d]].second;
+      mass_delta_ -= placements_[d].mod->getDiffMonoMass();
+      if (++choice_[d] < mods.size())
+      {
+        placements_[d].mod = mods[choice_[d]];
+        mass_delta_ += placements_[d].mod->getDiffMonoMass();
+        return true;
+      }
+      choice_[d] = 0;
+      placements_[d].mod = mods[0];
+      mass_delta_ += placements_[d].mod->getDiffMonoMass();
+    }
+
+    // next subset of sites
+    if (std::next_permutation(subset_mask_.begin(), subset_mask_.end()))
+    {
+      initPlacements_();
+      return true;
+    }
+
+    // more modifications per variant
+    if (n_mods_ == max_placements_) return false;
+    ++n_mods_;
+    initSubset_();
+    return true;
+  }
+
+  bool ModifiedPeptideGenerator::VariantEnumerator::next(double min_delta, double max_delta)
+  {
+    while (next())
+    {
+      if (mass_delta_ >= min_delta && mass_delta_ <= max_delta) return true;
+    }
+    return false;
+  }
+
+  const vector<ModifiedPeptideGenerator::ModificationPlacement>& ModifiedPeptideGenerator::VariantEnumerator::getPlacements() const
+  {
+    return placements_;
+  }
+
+  double ModifiedPeptideGenerator::VariantEnumerator::getMassDelta() const
+  {
+    return mass_delta_;
+  }
+
+  AASequence ModifiedPeptideGenerator::VariantEnumerator::getPeptide() const
+  {
+    AASequence peptide = peptide_;
+    for (const ModificationPlacement& p : placements_)
+    {
+      if (p.site == C_TERM_SITE)
+      {
+        peptide.setCTerminalModification(p.mod);
+      }
+      else if (p.site == N_TERM_SITE)
+      {
+        peptide.setNTerminalModification(p.mod);
+      }
+      else
+      {
+        peptide.setModification(p.site, var_mods_.val.at(p.mod)); // map modification to the modified residue
+      }
+    }
+    return peptide;
+  }
+}
@@ -34,6 +34,7 @@
 
 #include <OpenMS/ANALYSIS/RNPXL/MorpheusScore.h>
 #include <OpenMS/KERNEL/MSSpectrum.h>
+#include <OpenMS/COMPARISON/SPECTRA/PeakMatcher.h>
 #include <cmath>
 
 namespace OpenMS
@@ -50,61 +51,24 @@ namespace OpenMS
 
     if (n_t == 0 || n_e == 0) { return psm; }
 
-    Size t(0), e(0), matches(0);
-    double total_intensity(0);
+    std::vector<double> theo_mz, exp_mz, exp_intensities;
+    PeakMatcher::getMZs(theo_spectrum, theo_mz);
+    PeakMatcher::getMZs(exp_spectrum, exp_mz);
+    PeakMatcher::getIntensities(exp_spectrum, exp_intensities);
+
+    std::vector<double> lower, upper;
+    PeakMatcher::getToleranceWindows(theo_mz, fragment_mass_tolerance, fragment_mass_tolerance_unit_ppm, lower, upper);
 
     // count matching peaks and make sure that every theoretical peak is matched at most once
-    while (t < n_t && e < n_e)
-    {
-      const double theo_mz = theo_spectrum[t].getMZ();
-      const double exp_mz = exp_spectrum[e].getMZ();
-      const double d = exp_mz - theo_mz;
-      const double max_dist_dalton = fragment_mass_tolerance_unit_ppm ? theo_mz * fragment_mass_tolerance * 1e-6 : fragment_mass_tolerance;
-      if (fabs(d) <= max_dist_dalton) // match in tolerance window? 
-      {
-        ++matches;
-        ++t;  // count theoretical peak only once
-      }
-      else if (d < 0) // exp. peak is left of theo. peak (outside of tolerance window)
-      {
-        total_intensity += exp_spectrum[e].getIntensity();
-        ++e; 
-      }
-      else if (d > 0) // theo. peak is left of exp. peak (outside of tolerance window)
-      {
-        ++t;
-      }
-    }
+    const Size matches = PeakMatcher::countMatchedReference(lower, upper, exp_mz);
 
-    for (; e < n_e; ++e) { total_intensity += exp_spectrum[e].getIntensity(); }
+    double total_intensity(0);
+    for (double intensity : exp_intensities) { total_intensity += intensity; }
 
-    // similar to above but we now make sure that the intensity of every matched experimental peak is summed up to form match_intensity
-    t = 0; 
-    e = 0;
-    double match_intensity(0.0);
+    // make sure that the intensity of every matched experimental peak is summed up only once to form match_intensity
+    Size matched_exp(0);
     double sum_error(0.0);
-
-    while (t < n_t && e < n_e)
-    {
-      const double theo_mz = theo_spectrum[t].getMZ();
-      const double exp_mz = exp_spectrum[e].getMZ();
-      const double d = exp_mz - theo_mz;
-      const double max_dist_dalton = fragment_mass_tolerance_unit_ppm ? theo_mz * fragment_mass_tolerance * 1e-6 : fragment_mass_tolerance;
-      if (fabs(d) <= max_dist_dalton) // match in tolerance window? 
-      {
-        match_intensity += exp_spectrum[e].getIntensity();
-        sum_error += fabs(d);
-        ++e; // sum up experimental peak intensity only once
-      }
-      else if (d < 0) // exp. peak is left of theo. peak (outside of tolerance window)
-      {
-        ++e; 
-      }
-      else if (d > 0) // theo. peak is left of exp. peak (outside of tolerance window)
-      {
-        ++t;
-      }
-    }
+    const double match_intensity = PeakMatcher::sumMatchedTarget(theo_mz, lower, upper, exp_mz, exp_intensities, matched_exp, sum_error);
 
     const double intensity_fraction = match_intensity / total_intensity; 
 
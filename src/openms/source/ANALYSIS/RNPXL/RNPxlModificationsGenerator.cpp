@@ -39,29 +39,46 @@
 #include <OpenMS/CHEMISTRY/ModificationsDB.h>
 #include <OpenMS/CONCEPT/LogStream.h>
 
+#include <fstream>
+
 using namespace std;
 
 namespace OpenMS
 {
 
-//static
-bool RNPxlModificationsGenerator::notInSeq(String res_seq, String query)
+namespace
 {
-  // special case: empty query is in every seq -> false
-  if (query.empty()) { return false; }
+  const char MODIFICATION_MASSES_MAGIC[] = "# RNPxl precursor adducts v1";
+}
 
-  // test all k-mers with k=size of query
-  for (Int l = 0; l <= (Int)res_seq.size() - (Int)query.size(); ++l)
+//static
+std::map<Size, std::set<String> > RNPxlModificationsGenerator::getSortedKMers_(const StringList& sequences, const std::set<Size>& lengths)
+{
+  // one set per k, filled in parallel (each k only by one thread)
+  vector<Size> ks(lengths.begin(), lengths.end());
+  vector<set<String> > kmers(ks.size());
+#pragma omp parallel for schedule(dynamic)
+  for (SignedSize i = 0; i < (SignedSize)ks.size(); ++i)
   {
-    String a = res_seq.substr(l, query.size());
-    String b = query;
-
-    sort(a.begin(), a.end());
-    sort(b.begin(), b.end());
+    const Size k = ks[i];
+    if (k == 0) { continue; }
+    for (const String& seq : sequences)
+    {
+      for (Size l = 0; l + k <= seq.size(); ++l)
+      {
+        String kmer = seq.substr(l, k);
+        sort(kmer.begin(), kmer.end());
+        kmers[i].insert(kmer);
+      }
+    }
+  }
 
-    if (a == b) { return false; }
+  map<Size, set<String> > result;
+  for (Size i = 0; i != ks.size(); ++i)
+  {
+    result[ks[i]].swap(kmers[i]);
   }
-  return true;
+  return result;
 }
 
 //static
@@ -288,33 +305,55 @@ RNPxlModificationMassesResult RNPxlModificationsGenerator::initModificationMasse
     // In every loop iteration, an unmodified target_nucleotide (e.g., "U", "A", ... ) is added to the chain
     // The first element of the chain is an unmodified AND modified nucleotides.
     // That way, at most one modified nucleotide is part of the chain
-    vector<EmpiricalFormula> all_combinations = actual_combinations;
+    // Chains with the same empirical formula have the same extensions: only distinct formulas are extended.
+    using FormulaEntry = pair<String, EmpiricalFormula>; // formula string, formula
+    vector<FormulaEntry> distinct_combinations;
+    {
+      set<String> seen;
+      for (EmpiricalFormula const & ac : actual_combinations)
+      {
+        const String formula = ac.toString();
+        if (seen.insert(formula).second) { distinct_combinations.push_back(make_pair(formula, ac)); }
+      }
+    }
+    for (FormulaEntry const & fe : distinct_combinations)
+    {
+      result.mod_masses[fe.first] = fe.second.getMonoWeight();
+    }
+
+    vector<pair<String, EmpiricalFormula> > nucleotides(map_target_to_formula.begin(), map_target_to_formula.end());
+    const EmpiricalFormula water("H2O");
     for (Int i = 0; i < max_length - 1; ++i)
     {
-      vector<EmpiricalFormula> new_combinations;
-      for (auto const & target_to_formula : map_target_to_formula) // loop over nucleotides (unmodified)
+      // formulas of all (i+1)-mers: computed in parallel, merged in nucleotide order below
+      const Size n_combinations = distinct_combinations.size();
+      vector<FormulaEntry> extended(nucleotides.size() * n_combinations);
+#pragma omp parallel for schedule(dynamic, 64)
+      for (SignedSize k = 0; k < (SignedSize)extended.size(); ++k)
       {
-        const String & target_nucleotide = target_to_formula.first;
-        const EmpiricalFormula & target_nucleotide_formula = target_to_formula.second;
+        const EmpiricalFormula e = nucleotides[k / n_combinations].second + distinct_combinations[k % n_combinations].second - water; // -H2O because of condensation reaction
+        extended[k] = make_pair(e.toString(), e);
+      }
 
-        for (EmpiricalFormula const & ac : actual_combinations) // append unmodified nucleotide to yield a (i+1)-mer
+      vector<FormulaEntry> new_combinations;
+      set<String> seen;
+      for (Size k = 0; k != extended.size(); ++k)
+      {
+        const String & target_nucleotide = nucleotides[k / n_combinations].first;
+        const set<String>& ambiguities = result.mod_combinations[distinct_combinations[k % n_combinations].first];
+        set<String>& new_ambiguities = result.mod_combinations[extended[k].first];
+        for (auto const & s : ambiguities)
         {
-          new_combinations.push_back(target_nucleotide_formula + ac - EmpiricalFormula("H2O")); // -H2O because of condensation reaction
-          all_combinations.push_back(target_nucleotide_formula + ac - EmpiricalFormula("H2O")); // " "
-          const set<String>& ambiguities = result.mod_combinations[ac.toString()];
-          for (auto const & s : ambiguities)
-          {
-            result.mod_combinations[all_combinations.back().toString()].insert(target_nucleotide + s);
-            OPENMS_LOG_DEBUG << target_nucleotide + s << endl;
-          }
+          new_ambiguities.insert(target_nucleotide + s);
+          OPENMS_LOG_DEBUG << target_nucleotide + s << endl;
+        }
+        if (seen.insert(extended[k].first).second)
+        {
+          result.mod_masses[extended[k].first] = extended[k].second.getMonoWeight();
+          new_combinations.push_back(extended[k]);
         }
       }
-      actual_combinations = new_combinations;
-    }
-
-    for (Size i = 0; i != all_combinations.size(); ++i)
-    {
-      result.mod_masses[all_combinations[i].toString()] = all_combinations[i].getMonoWeight();
+      distinct_combinations.swap(new_combinations);
     }
   }
 
@@ -323,11 +362,26 @@ RNPxlModificationMassesResult RNPxlModificationsGenerator::initModificationMasse
   // Remove precursor adducts that
   // 1) do not contain a cross-linkable nucleotide
   // 2) or contain no cross-linkable nucleotide that is part of the restricted target sequences
-  std::vector<pair<String, String> > violates_restriction; // elemental composition, nucleotide style formula
-  for (Map<String, double>::ConstIterator mit = result.mod_masses.begin(); mit != result.mod_masses.end(); ++mit)
+  std::vector<String> formulas;
+  std::set<Size> formula_lengths;
+  for (auto const & m : result.mod_masses)
+  {
+    formulas.push_back(m.first);
+    for (String const & s : result.mod_combinations[m.first])
+    {
+      formula_lengths.insert(min(min(s.find('-'), s.find('+')), s.size()));
+    }
+  }
+
+  // a nucleotide formula is contained in a target sequence if one of the k-mers of the sequence has the same nucleotides
+  const map<Size, set<String> > target_kmers = getSortedKMers_(target_sequences, formula_lengths);
+
+  std::vector<std::vector<pair<String, String> > > formula_violations(formulas.size()); // elemental composition, nucleotide style formula
+#pragma omp parallel for schedule(dynamic)
+  for (SignedSize f = 0; f < (SignedSize)formulas.size(); ++f)
   {
     // remove additive or subtractive modifications from string as these are not used in string comparison
-    const set<String>& ambiguities = result.mod_combinations[mit->first];
+    const set<String>& ambiguities = result.mod_combinations.at(formulas[f]);
     for (String const & s : ambiguities)
     {
       String nucleotide_style_formula(s);
@@ -347,7 +401,7 @@ RNPxlModificationMassesResult RNPxlModificationsGenerator::initModificationMasse
 
       if (!has_xl_nt) 
       { // no cross-linked nucleotide => not valid
-        violates_restriction.push_back(make_pair(mit->first, s)); 
+        formula_violations[f].push_back(make_pair(formulas[f], s)); 
         continue;
       }
 
@@ -360,27 +414,34 @@ RNPxlModificationMassesResult RNPxlModificationsGenerator::initModificationMasse
       // nucleotide stile formula (e.g. AATU matches to more than one group (e.g., RNA and DNA))?
       if (found_in_n_groups > 1)
       {
-        violates_restriction.push_back(make_pair(mit->first, s)); 
+        formula_violations[f].push_back(make_pair(formulas[f], s)); 
         continue;
       }
 
       // check if nucleotide is contained in at least one of the target sequences
-      bool containment_violated(false);
-      Size violation_count(0);
-      for (auto const & current_target_seq : target_sequences)
+      // (an empty formula is contained in every sequence)
+      bool containment_violated(target_sequences.empty());
+      if (!containment_violated && !nucleotide_style_formula.empty())
       {
-        if (notInSeq(current_target_seq, nucleotide_style_formula)) { ++violation_count; }
+        String sorted_formula(nucleotide_style_formula);
+        sort(sorted_formula.begin(), sorted_formula.end());
+        const set<String>& kmers = target_kmers.at(nucleotide_style_formula.size());
+        containment_violated = kmers.find(sorted_formula) == kmers.end();
       }
 
-      if (violation_count == target_sequences.size()) { containment_violated = true; }
-
       if (containment_violated)
       { 
-        violates_restriction.push_back(make_pair(mit->first, s)); // chemical formula, nucleotide style formula pair violates restrictions
+        formula_violations[f].push_back(make_pair(formulas[f], s)); // chemical formula, nucleotide style formula pair violates restrictions
       }
     }
   }
 
+  std::vector<pair<String, String> > violates_restriction; // elemental composition, nucleotide style formula
+  for (auto const & v : formula_violations)
+  {
+    violates_restriction.insert(violates_restriction.end(), v.begin(), v.end());
+  }
+
   for (size_t i = 0; i != violates_restriction.size(); ++i)
   {
     const String& chemical_formula = violates_restriction[i].first;
@@ -465,6 +526,86 @@ RNPxlModificationMassesResult RNPxlModificationsGenerator::initModificationMasse
   return result;
 }
 
+//static
+String RNPxlModificationsGenerator::getModificationMassesKey(const StringList& target_nucleotides,
+                                                            const StringList& nt_groups,
+                                                            const std::set<char>& can_xl,
+                                                            const StringList& mappings,
+                                                            const StringList& modifications,
+                                                            const String& sequence_restriction,
+                                                            bool cysteine_adduct,
+                                                            Int max_length)
+{
+  return ListUtils::concatenate(target_nucleotides, ",")
+    + "|" + ListUtils::concatenate(nt_groups, ",")
+    + "|" + String(can_xl.begin(), can_xl.end())
+    + "|" + ListUtils::concatenate(mappings, ",")
+    + "|" + ListUtils::concatenate(modifications, ",")
+    + "|" + sequence_restriction
+    + "|" + (cysteine_adduct ? "cysteine_adduct" : "")
+    + "|" + String(max_length);
+}
+
+//static
+void RNPxlModificationsGenerator::storeModificationMasses(const String& filename, const String& key, const RNPxlModificationMassesResult& result)
+{
+  ofstream ofs(filename.c_str());
+  if (!ofs)
+  {
+    throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+  }
+
+  // one line per empirical formula: formula, mass and the nucleotide formulas (tab separated)
+  ofs << MODIFICATION_MASSES_MAGIC << "\n" << key << "\n";
+  ofs.precision(17);
+  for (auto const & m : result.mod_masses)
+  {
+    ofs << m.first << "\t" << m.second;
+    auto it = result.mod_combinations.find(m.first);
+    if (it != result.mod_combinations.end())
+    {
+      for (String const & s : it->second) { ofs << "\t" << s; }
+    }
+    ofs << "\n";
+  }
+
+  if (!ofs)
+  {
+    throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+  }
+}
+
+//static
+bool RNPxlModificationsGenerator::loadModificationMasses(const String& filename, const String& key, RNPxlModificationMassesResult& result)
+{
+  ifstream ifs(filename.c_str());
+  if (!ifs) { return false; }
+
+  std::string line;
+  if (!getline(ifs, line) || line != MODIFICATION_MASSES_MAGIC)
+  {
+    throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Not a precursor adduct file.");
+  }
+  if (!getline(ifs, line) || line != key) { return false; }
+
+  RNPxlModificationMassesResult loaded;
+  while (getline(ifs, line))
+  {
+    if (line.empty()) { continue; }
+    vector<String> fields;
+    String(line).split('\t', fields);
+    if (fields.size() < 2)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, line, "Expected formula and mass in precursor adduct file '" + filename + "'.");
+    }
+    loaded.mod_masses[fields[0]] = fields[1].toDouble();
+    set<String>& combinations = loaded.mod_combinations[fields[0]];
+    combinations.insert(fields.begin() + 2, fields.end());
+  }
+  result = loaded;
+  return true;
+}
+
 //static
 void  RNPxlModificationsGenerator::generateTargetSequences(const String& res_seq,
                                                            Size param_pos,
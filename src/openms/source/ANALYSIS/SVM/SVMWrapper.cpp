@@ -40,6 +40,7 @@
 #include <OpenMS/CONCEPT/LogStream.h>
 
 
+#include <exception>
 #include <fstream>
 
 #include <boost/math/distributions/normal.hpp>
@@ -531,11 +532,12 @@ namespace OpenMS
           problem = computeKernelMatrix(problem, training_set_);
         }
       }
-      results.reserve(problem->l);
+      // svm_predict only reads the model
+      results.resize(problem->l);
+#pragma omp parallel for
       for (Int i = 0; i < problem->l; i++)
       {
-        double label = svm_predict(model_, problem->x[i]);
-        results.push_back(label);
+        results[i] = svm_predict(model_, problem->x[i]);
       }
 
       if (kernel_type_ == OLIGO)
@@ -566,10 +568,11 @@ namespace OpenMS
       else if (model_ != nullptr)
       {
         struct svm_problem* prediction_problem = computeKernelMatrix(problem, training_data_);
-        for (Size i = 0; i < problem.sequences.size(); i++)
+        results.resize(problem.sequences.size());
+#pragma omp parallel for
+        for (SignedSize i = 0; i < (SignedSize)problem.sequences.size(); i++)
         {
-          double label = svm_predict(model_, prediction_problem->x[i]);
-          results.push_back(label);
+          results[i] = svm_predict(model_, prediction_problem->x[i]);
         }
 
         LibSVMEncoder::destroyProblem(prediction_problem);
@@ -1298,10 +1301,11 @@ namespace OpenMS
 
     if (model_ != nullptr)
     {
-      for (Size i = 0; i < vectors.size(); i++)
+      results.resize(vectors.size());
+#pragma omp parallel for
+      for (SignedSize i = 0; i < (SignedSize)vectors.size(); i++)
       {
-        double label = svm_predict(model_, vectors[i]);
-        results.push_back(label);
+        results[i] = svm_predict(model_, vectors[i]);
       }
     }
   }
@@ -1342,17 +1346,19 @@ namespace OpenMS
           problem = computeKernelMatrix(problem, training_set_);
         }
       }
+      probabilities.resize(problem->l);
+      prediction_labels.resize(problem->l);
+#pragma omp parallel for firstprivate(temp_prob_estimates)
       for (int i = 0; i < problem->l; ++i)
       {
-        double temp_label = svm_predict_probability(model_, problem->x[i], &(temp_prob_estimates[0]));
-        prediction_labels.push_back(temp_label);
+        prediction_labels[i] = svm_predict_probability(model_, problem->x[i], &(temp_prob_estimates[0]));
         if (labels[0] >= 0)
         {
-          probabilities.push_back(temp_prob_estimates[0]);
+          probabilities[i] = temp_prob_estimates[0];
         }
         else
         {
-          probabilities.push_back(1 - temp_prob_estimates[0]);
+          probabilities[i] = 1 - temp_prob_estimates[0];
         }
       }
       if (kernel_type_ == OLIGO)
@@ -1612,9 +1618,11 @@ namespace OpenMS
       kernel_matrix->x[i][problem2->l + 1].index = -1;
     }
 
+    // every (i, j) cell is written by exactly one row i, so the rows can be filled concurrently
     if (problem1 == problem2)
     {
-      for (Size i = 0; i < number_of_sequences; i++)
+#pragma omp parallel for schedule(dynamic, 10) private(temp)
+      for (SignedSize i = 0; i < (SignedSize)number_of_sequences; i++)
       {
         for (Size j = i; j < number_of_sequences; j++)
         {
@@ -1628,7 +1636,8 @@ namespace OpenMS
     }
     else
     {
-      for (Size i = 0; i < number_of_sequences; i++)
+#pragma omp parallel for private(temp)
+      for (SignedSize i = 0; i < (SignedSize)number_of_sequences; i++)
       {
         for (Size j = 0; j < (Size) problem2->l; j++)
         {
@@ -1673,33 +1682,58 @@ namespace OpenMS
       kernel_matrix->x[i][problem2.labels.size() + 1].index = -1;
     }
 
+    // every (i, j) cell is written by exactly one row i, so the rows can be filled concurrently
+    std::exception_ptr error;
     if (&problem1 == &problem2)
     {
-      for (Size i = 0; i < number_of_sequences; i++)
+#pragma omp parallel for schedule(dynamic, 10) private(temp)
+      for (SignedSize i = 0; i < (SignedSize)number_of_sequences; i++)
       {
-        for (Size j = i; j < number_of_sequences; j++)
+        try
         {
-          temp = SVMWrapper::kernelOligo(problem1.sequences[i], problem2.sequences[j], gauss_table_);
-          kernel_matrix->x[i][j + 1].index = int(j) + 1;
-          kernel_matrix->x[i][j + 1].value = temp;
-          kernel_matrix->x[j][i + 1].index = int(i) + 1;
-          kernel_matrix->x[j][i + 1].value = temp;
+          for (Size j = i; j < number_of_sequences; j++)
+          {
+            temp = SVMWrapper::kernelOligo(problem1.sequences[i], problem2.sequences[j], gauss_table_);
+            kernel_matrix->x[i][j + 1].index = int(j) + 1;
+            kernel_matrix->x[i][j + 1].value = temp;
+            kernel_matrix->x[j][i + 1].index = int(i) + 1;
+            kernel_matrix->x[j][i + 1].value = temp;
+          }
+        }
+        catch (...)
+        {
+#pragma omp critical (SVMWrapper_kernel_error)
+          if (!error) error = std::current_exception();
         }
       }
     }
     else
     {
-      for (Size i = 0; i < number_of_sequences; i++)
+#pragma omp parallel for private(temp)
+      for (SignedSize i = 0; i < (SignedSize)number_of_sequences; i++)
       {
-        for (Size j = 0; j < problem2.labels.size(); j++)
+        try
         {
-          temp = SVMWrapper::kernelOligo(problem1.sequences[i], problem2.sequences[j], gauss_table_);
+          for (Size j = 0; j < problem2.labels.size(); j++)
+          {
+            temp = SVMWrapper::kernelOligo(problem1.sequences[i], problem2.sequences[j], gauss_table_);
 
-          kernel_matrix->x[i][j + 1].index = int(j) + 1;
-          kernel_matrix->x[i][j + 1].value = temp;
+            kernel_matrix->x[i][j + 1].index = int(j) + 1;
+            kernel_matrix->x[i][j + 1].value = temp;
+          }
+        }
+        catch (...)
+        {
+#pragma omp critical (SVMWrapper_kernel_error)
+          if (!error) error = std::current_exception();
         }
       }
     }
+    if (error)
+    {
+      LibSVMEncoder::destroyProblem(kernel_matrix);
+      std::rethrow_exception(error);
+    }
     return kernel_matrix;
   }
 
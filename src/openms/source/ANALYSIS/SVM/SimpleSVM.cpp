@@ -174,9 +174,6 @@ void SimpleSVM::predict(vector<Prediction>& predictions, vector<Size> indexes) c
   Size n_classes = svm_get_nr_class(model_);
   vector<Int> labels(n_classes);
   svm_get_labels(model_, &(labels[0]));
-  vector<double> probabilities(n_classes);
-  predictions.clear();
-  predictions.reserve(indexes.size());
   for (vector<Size>::iterator it = indexes.begin(); it != indexes.end(); ++it)
   {
     if (*it >= n_obs)
@@ -186,14 +183,21 @@ void SimpleSVM::predict(vector<Prediction>& predictions, vector<Size> indexes) c
       throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
                                     msg, String(*it));
     }
-    Prediction pred;
-    pred.label = Int(svm_predict_probability(model_, &(nodes_[*it][0]), 
+  }
+  vector<double> probabilities(n_classes);
+  predictions.clear();
+  predictions.resize(indexes.size());
+  // the model is only read from, so the observations can be predicted concurrently
+#pragma omp parallel for firstprivate(probabilities)
+  for (SignedSize p = 0; p < (SignedSize)indexes.size(); ++p)
+  {
+    Prediction& pred = predictions[p];
+    pred.label = Int(svm_predict_probability(model_, &(nodes_[indexes[p]][0]), 
                                              &(probabilities[0])));
     for (Size i = 0; i < n_classes; ++i)
     {
       pred.probabilities[labels[i]] = probabilities[i];
     }
-    predictions.push_back(pred);
   }
 }
 
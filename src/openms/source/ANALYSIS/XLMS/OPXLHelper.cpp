@@ -98,11 +98,11 @@ namespace OpenMS
       first_loop = lower_bound(first_loop, conservative_upper_bound, min_peptide_mass, OPXLDataStructs::AASeqWithMassComparator());
       last_loop = upper_bound(last_loop, conservative_upper_bound, max_peptide_mass, OPXLDataStructs::AASeqWithMassComparator());
 
-      int first_index = first_loop - peptides.cbegin();
-      int last_index = last_loop - peptides.cbegin();
+      Size first_index = first_loop - peptides.cbegin();
+      Size last_index = last_loop - peptides.cbegin();
 
-#pragma omp parallel for
-      for (int p1 = first_index; p1 < last_index; ++p1)
+      // these windows are narrow (one peptide mass within the tolerance), no need to split them up between threads
+      for (Size p1 = first_index; p1 < last_index; ++p1)
       {
         const String& seq_first = peptides[p1].unmodified_seq;
         // test if this peptide could have loop-links: one cross-link with both sides attached to the same peptide
@@ -140,13 +140,10 @@ namespace OpenMS
          precursor.alpha_seq = seq_first;
          precursor.beta_seq = "";
 
-#pragma omp critical (mass_to_candidates_access)
-         {
-           mass_to_candidates.push_back(precursor);
-           precursor_correction_positions.push_back(pm);
-         }
+         mass_to_candidates.push_back(precursor);
+         precursor_correction_positions.push_back(pm);
         }
-      } // end of parallel loop over loop-link candidates
+      } // end of loop over loop-link candidates
 
       // ################################ Enumerate Mono-Links #################
       for (Size i = 0; i < cross_link_mass_mono_link.size(); i++)
@@ -164,8 +161,7 @@ namespace OpenMS
         first_index = first_mono - peptides.cbegin();
         last_index = last_mono - peptides.cbegin();
 
-#pragma omp parallel for
-        for (int p1 = first_index; p1 < last_index; ++p1)
+        for (Size p1 = first_index; p1 < last_index; ++p1)
         {
           // Monoisotopic weight of the peptide + cross-linker
           double cross_linked_peptide_mass = peptides[p1].peptide_mass + mono_link_mass;
@@ -178,11 +174,8 @@ namespace OpenMS
           precursor.alpha_seq = peptides[p1].unmodified_seq;
           precursor.beta_seq = "";
 
-#pragma omp critical (mass_to_candidates_access)
-         {
-           mass_to_candidates.push_back(precursor);
-           precursor_correction_positions.push_back(pm);
-         }
+          mass_to_candidates.push_back(precursor);
+          precursor_correction_positions.push_back(pm);
         } // end of loop over candidates for a specific mono-link mass
       } // end of loop over mono-link masses
 
@@ -192,47 +185,71 @@ namespace OpenMS
       // maximal mass: difference between precursor mass and the smallest peptide + cross-linker
       max_peptide_mass = precursor_mass - cross_link_mass - peptides[0].peptide_mass + allowed_error;
       last_alpha = upper_bound(last_alpha, conservative_upper_bound, max_peptide_mass, OPXLDataStructs::AASeqWithMassComparator());
-      int last_alpha_index = last_alpha - peptides.cbegin();
+      Size last_alpha_index = last_alpha - peptides.cbegin();
 
-#pragma omp parallel for
-      for (int p1 = 0; p1 < last_alpha_index; ++p1)
+      // Alpha is the lighter peptide of the pair (alpha_index <= beta_index). The heavier alpha gets, the lighter
+      // beta has to be, so within a block of alphas the beta window is only moved downwards (two-pointer walk)
+      // instead of being searched for every alpha. The walk stops as soon as beta would be lighter than alpha.
+      // Blocks are processed in parallel and concatenated in order afterwards.
+      const Size alpha_block_size = 512;
+      Size alpha_blocks = (last_alpha_index + alpha_block_size - 1) / alpha_block_size;
+      vector< vector<OPXLDataStructs::XLPrecursor> > block_candidates(alpha_blocks);
+
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize block = 0; block < static_cast<SignedSize>(alpha_blocks); ++block)
       {
-        // Constrain search for beta
-        double min_peptide_mass_beta = precursor_mass - cross_link_mass - peptides[p1].peptide_mass - allowed_error;
-        double max_peptide_mass_beta = precursor_mass - cross_link_mass - peptides[p1].peptide_mass + allowed_error;
+        Size alpha_begin = block * alpha_block_size;
+        Size alpha_end = std::min(alpha_begin + alpha_block_size, last_alpha_index);
 
         // the last_alpha upper bound is also a conservative upper bound here
-        vector<OPXLDataStructs::AASeqWithMass>::const_iterator first_beta = lower_bound(peptides.cbegin()+p1, last_alpha, min_peptide_mass_beta, OPXLDataStructs::AASeqWithMassComparator());
-        vector<OPXLDataStructs::AASeqWithMass>::const_iterator last_beta = upper_bound(peptides.cbegin()+p1, last_alpha, max_peptide_mass_beta, OPXLDataStructs::AASeqWithMassComparator());
+        double min_peptide_mass_beta = precursor_mass - cross_link_mass - peptides[alpha_begin].peptide_mass - allowed_error;
+        double max_peptide_mass_beta = precursor_mass - cross_link_mass - peptides[alpha_begin].peptide_mass + allowed_error;
+        Size first_beta = lower_bound(peptides.cbegin() + alpha_begin, last_alpha, min_peptide_mass_beta, OPXLDataStructs::AASeqWithMassComparator()) - peptides.cbegin();
+        Size last_beta = upper_bound(peptides.cbegin() + alpha_begin, last_alpha, max_peptide_mass_beta, OPXLDataStructs::AASeqWithMassComparator()) - peptides.cbegin();
 
-        if (first_beta == last_beta)
+        vector<OPXLDataStructs::XLPrecursor>& candidates = block_candidates[block];
+        for (Size p1 = alpha_begin; p1 < alpha_end; ++p1)
         {
-          continue;
-        }
+          // Constrain search for beta
+          min_peptide_mass_beta = precursor_mass - cross_link_mass - peptides[p1].peptide_mass - allowed_error;
+          max_peptide_mass_beta = precursor_mass - cross_link_mass - peptides[p1].peptide_mass + allowed_error;
 
-        Size first_beta_index = first_beta - peptides.begin();
-        Size last_beta_index = last_beta - peptides.begin();
-
-        for (Size p2 = first_beta_index; p2 < last_beta_index; ++p2)
-        {
-          // Monoisotopic weight of the first peptide + the second peptide + cross-linker
-          double cross_linked_pair_mass = peptides[p1].peptide_mass + peptides[p2].peptide_mass + cross_link_mass;
-
-          // this time both peptides have valid indices
-          OPXLDataStructs::XLPrecursor precursor;
-          precursor.precursor_mass = cross_linked_pair_mass;
-          precursor.alpha_index = p1;
-          precursor.beta_index = p2;
-          precursor.alpha_seq = peptides[p1].unmodified_seq;
-          precursor.beta_seq = peptides[p2].unmodified_seq;
+          while (last_beta > p1 && peptides[last_beta - 1].peptide_mass > max_peptide_mass_beta)
+          {
+            --last_beta;
+          }
+          if (last_beta <= p1)
+          {
+            break; // no beta left that is at least as heavy as alpha, the same holds for all heavier alphas
+          }
+          while (first_beta > p1 && peptides[first_beta - 1].peptide_mass >= min_peptide_mass_beta)
+          {
+            --first_beta;
+          }
+          first_beta = std::max(first_beta, p1);
 
-#pragma omp critical (mass_to_candidates_access)
-         {
-           mass_to_candidates.push_back(precursor);
-           precursor_correction_positions.push_back(pm);
-         }
-        } // end of loop over betas
-      } // end of parallel loop over alphas
+          for (Size p2 = first_beta; p2 < last_beta; ++p2)
+          {
+            // Monoisotopic weight of the first peptide + the second peptide + cross-linker
+            double cross_linked_pair_mass = peptides[p1].peptide_mass + peptides[p2].peptide_mass + cross_link_mass;
+
+            // this time both peptides have valid indices
+            OPXLDataStructs::XLPrecursor precursor;
+            precursor.precursor_mass = cross_linked_pair_mass;
+            precursor.alpha_index = p1;
+            precursor.beta_index = p2;
+            precursor.alpha_seq = peptides[p1].unmodified_seq;
+            precursor.beta_seq = peptides[p2].unmodified_seq;
+            candidates.push_back(precursor);
+          } // end of loop over betas
+        } // end of loop over alphas in this block
+      } // end of parallel loop over alpha blocks
+
+      for (vector<OPXLDataStructs::XLPrecursor>& candidates : block_candidates)
+      {
+        mass_to_candidates.insert(mass_to_candidates.end(), std::make_move_iterator(candidates.begin()), std::make_move_iterator(candidates.end()));
+        precursor_correction_positions.insert(precursor_correction_positions.end(), candidates.size(), pm);
+      }
     } // end of loop over precursor masses
     return mass_to_candidates;
   }
@@ -1326,8 +1343,6 @@ namespace OpenMS
                                                                                                 bool use_sequence_tags,
                                                                                                 const std::vector<std::string>& tags)
   {
-    // determine candidates
-    std::vector< OPXLDataStructs::XLPrecursor > candidates;
     std::vector< double > spectrum_precursor_vector;
     std::vector< double > allowed_error_vector;
 
@@ -1351,34 +1366,40 @@ namespace OpenMS
 
     } // end correction mass loop
 
-    std::vector< int > precursor_correction_positions;
+    vector <OPXLDataStructs::ProteinProteinCrossLink> cross_link_candidates;
     // if sequence tags are used and no tags were found, don't bother combining peptide pairs
-    if ( (use_sequence_tags && tags.size() > 0) ||
-         !use_sequence_tags)
+    if (use_sequence_tags && tags.empty())
     {
-      candidates = OPXLHelper::enumerateCrossLinksAndMasses(filtered_peptide_masses, cross_link_mass, cross_link_mass_mono_link, cross_link_residue1, cross_link_residue2, spectrum_precursor_vector, precursor_correction_positions, precursor_mass_tolerance, precursor_mass_tolerance_unit_ppm);
+      return cross_link_candidates;
     }
 
-    // an empty vector of sequence tags implies no filtering should be done in this case
-    if (use_sequence_tags)
+    // enumerate and build the candidates one precursor correction at a time,
+    // so that only the peptide pairs of one precursor mass are held as XLPrecursors
+    for (Size pm = 0; pm < spectrum_precursor_vector.size(); ++pm)
     {
-      Size candidates_size = candidates.size();
-      OPXLHelper::filterPrecursorsByTags(candidates, precursor_correction_positions, tags);
+      std::vector< int > precursor_correction_positions;
+      std::vector< OPXLDataStructs::XLPrecursor > candidates = OPXLHelper::enumerateCrossLinksAndMasses(filtered_peptide_masses, cross_link_mass, cross_link_mass_mono_link, cross_link_residue1, cross_link_residue2, std::vector< double >(1, spectrum_precursor_vector[pm]), precursor_correction_positions, precursor_mass_tolerance, precursor_mass_tolerance_unit_ppm);
 
-#pragma omp critical (LOG_DEBUG_access)
+      // an empty vector of sequence tags implies no filtering should be done in this case
+      if (use_sequence_tags)
       {
-        OPENMS_LOG_DEBUG << "Number of sequence tags: " << tags.size() << std::endl;
-        OPENMS_LOG_DEBUG << "Candidate Peptide Pairs before sequence tag filtering: " << candidates_size << std::endl;
-        OPENMS_LOG_DEBUG << "Candidate Peptide Pairs  after sequence tag filtering: " << candidates.size() << std::endl;
+        Size candidates_size = candidates.size();
+        OPXLHelper::filterPrecursorsByTags(candidates, precursor_correction_positions, tags);
+
+#pragma omp critical (LOG_DEBUG_access)
+        {
+          OPENMS_LOG_DEBUG << "Number of sequence tags: " << tags.size() << std::endl;
+          OPENMS_LOG_DEBUG << "Candidate Peptide Pairs before sequence tag filtering: " << candidates_size << std::endl;
+          OPENMS_LOG_DEBUG << "Candidate Peptide Pairs  after sequence tag filtering: " << candidates.size() << std::endl;
+        }
       }
-    }
 
-    vector< int > precursor_corrections;
-    for (Size pc = 0; pc < precursor_correction_positions.size(); ++pc)
-    {
-      precursor_corrections.push_back(precursor_correction_steps[precursor_correction_positions[pc]]);
+      // positions refer to the single precursor mass given above
+      std::fill(precursor_correction_positions.begin(), precursor_correction_positions.end(), static_cast<int>(pm));
+      std::vector< int > precursor_corrections(candidates.size(), precursor_correction_steps[pm]);
+      vector <OPXLDataStructs::ProteinProteinCrossLink> pm_candidates = OPXLHelper::buildCandidates(candidates, precursor_corrections, precursor_correction_positions, filtered_peptide_masses, cross_link_residue1, cross_link_residue2, cross_link_mass, cross_link_mass_mono_link, spectrum_precursor_vector, allowed_error_vector, cross_link_name);
+      cross_link_candidates.insert(cross_link_candidates.end(), std::make_move_iterator(pm_candidates.begin()), std::make_move_iterator(pm_candidates.end()));
     }
-    vector <OPXLDataStructs::ProteinProteinCrossLink> cross_link_candidates = OPXLHelper::buildCandidates(candidates, precursor_corrections, precursor_correction_positions, filtered_peptide_masses, cross_link_residue1, cross_link_residue2, cross_link_mass, cross_link_mass_mono_link, spectrum_precursor_vector, allowed_error_vector, cross_link_name);
     return cross_link_candidates;
   }
 
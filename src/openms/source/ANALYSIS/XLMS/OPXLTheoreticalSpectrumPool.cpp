@@ -0,0 +1,118 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Eugen Netz $
+// $Authors: Eugen Netz $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/ANALYSIS/XLMS/OPXLTheoreticalSpectrumPool.h>
+
+#include <OpenMS/CHEMISTRY/AASequence.h>
+
+namespace OpenMS
+{
+  OPXLTheoreticalSpectrumPool::OPXLTheoreticalSpectrumPool(const SimpleTSGXLMS& generator, Size max_entries) :
+    generator_(generator),
+    max_entries_(max_entries)
+  {
+  }
+
+  OPXLTheoreticalSpectrumPool::SimpleSpectrumPtr OPXLTheoreticalSpectrumPool::getLinearIonSpectrum(const AASequence& peptide, Size link_pos, int charge, Size link_pos_2)
+  {
+    String key = String("L|") + peptide.toString() + "|" + link_pos + "|" + link_pos_2 + "|" + charge;
+    SimpleSpectrumPtr spectrum = find_(key);
+    if (spectrum)
+    {
+      return spectrum;
+    }
+
+    // generate outside of the lock, two threads may end up generating the same spectrum
+    boost::shared_ptr<SimpleSpectrum> generated(new SimpleSpectrum);
+    AASequence seq(peptide);
+    generator_.getLinearIonSpectrum(*generated, seq, link_pos, charge, link_pos_2);
+    insert_(key, generated);
+    return generated;
+  }
+
+  OPXLTheoreticalSpectrumPool::SimpleSpectrumPtr OPXLTheoreticalSpectrumPool::getXLinkIonSpectrum(const OPXLDataStructs::ProteinProteinCrossLink& crosslink, bool frag_alpha, int mincharge, int maxcharge)
+  {
+    if (!crosslink.alpha)
+    {
+      return SimpleSpectrumPtr(new SimpleSpectrum);
+    }
+    String key = String("X|") + crosslink.alpha->toString() + "|" + (crosslink.beta ? crosslink.beta->toString() : String()) + "|" +
+                 crosslink.cross_link_position.first + "|" + crosslink.cross_link_position.second + "|" +
+                 String(crosslink.cross_linker_mass) + "|" + (frag_alpha ? "a" : "b") + "|" + mincharge + "|" + maxcharge;
+    SimpleSpectrumPtr spectrum = find_(key);
+    if (spectrum)
+    {
+      return spectrum;
+    }
+
+    boost::shared_ptr<SimpleSpectrum> generated(new SimpleSpectrum);
+    OPXLDataStructs::ProteinProteinCrossLink link(crosslink);
+    generator_.getXLinkIonSpectrum(*generated, link, frag_alpha, mincharge, maxcharge);
+    insert_(key, generated);
+    return generated;
+  }
+
+  Size OPXLTheoreticalSpectrumPool::size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pool_.size();
+  }
+
+  void OPXLTheoreticalSpectrumPool::clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pool_.clear();
+  }
+
+  OPXLTheoreticalSpectrumPool::SimpleSpectrumPtr OPXLTheoreticalSpectrumPool::find_(const String& key) const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = pool_.find(key);
+    if (it == pool_.end())
+    {
+      return SimpleSpectrumPtr();
+    }
+    return it->second;
+  }
+
+  void OPXLTheoreticalSpectrumPool::insert_(const String& key, const SimpleSpectrumPtr& spectrum)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pool_.size() < max_entries_)
+    {
+      pool_.emplace(key, spectrum);
+    }
+  }
+}
@@ -36,6 +36,7 @@
 #include <OpenMS/CHEMISTRY/ModificationsDB.h>
 #include <OpenMS/ANALYSIS/XLMS/OPXLSpectrumProcessingAlgorithms.h>
 #include <OpenMS/ANALYSIS/XLMS/OPXLHelper.h>
+#include <OpenMS/ANALYSIS/XLMS/OPXLTheoreticalSpectrumPool.h>
 #include <OpenMS/ANALYSIS/XLMS/XQuestScores.h>
 #include <OpenMS/KERNEL/SpectrumHelper.h>
 #include <OpenMS/ANALYSIS/RNPXL/ModifiedPeptideGenerator.h>
@@ -338,6 +339,10 @@ using namespace OpenMS;
     specGenParams_mainscore.setValue("add_k_linked_ions", "false");
     specGen_mainscore.setParameters(specGenParams_mainscore);
 
+    // the same peptides are candidates for many spectra, share their theoretical spectra
+    OPXLTheoreticalSpectrumPool spectrum_pool(specGen_mainscore);
+    const OPXLTheoreticalSpectrumPool::SimpleSpectrumPtr no_peaks(new OPXLTheoreticalSpectrumPool::SimpleSpectrum);
+
     // use a less stringent tolerance for the tagger
     double tagger_tol;
     if (fragment_mass_tolerance_unit_ppm_) // ppm: increase tolerance by 50%
@@ -439,12 +444,6 @@ using namespace OpenMS;
       {
         OPXLDataStructs::ProteinProteinCrossLink cross_link_candidate = cross_link_candidates[i];
 
-        std::vector< SimpleTSGXLMS::SimplePeak > theoretical_spec_linear_alpha;
-        theoretical_spec_linear_alpha.reserve(1500);
-        std::vector< SimpleTSGXLMS::SimplePeak > theoretical_spec_linear_beta;
-        std::vector< SimpleTSGXLMS::SimplePeak > theoretical_spec_xlinks_alpha;
-        std::vector< SimpleTSGXLMS::SimplePeak > theoretical_spec_xlinks_beta;
-
         bool type_is_cross_link = cross_link_candidate.getType() == OPXLDataStructs::CROSS;
         bool type_is_loop = cross_link_candidate.getType() == OPXLDataStructs::LOOP;
         Size link_pos_B = 0;
@@ -457,12 +456,10 @@ using namespace OpenMS;
         if (cross_link_candidate.alpha) { alpha = *cross_link_candidate.alpha; }
         if (cross_link_candidate.beta) { beta = *cross_link_candidate.beta; }
 
-        specGen_mainscore.getLinearIonSpectrum(theoretical_spec_linear_alpha, alpha, cross_link_candidate.cross_link_position.first, 2, link_pos_B);
-        if (type_is_cross_link)
-        {
-          theoretical_spec_linear_beta.reserve(1500);
-          specGen_mainscore.getLinearIonSpectrum(theoretical_spec_linear_beta, beta, cross_link_candidate.cross_link_position.second, 2);
-        }
+        OPXLTheoreticalSpectrumPool::SimpleSpectrumPtr linear_alpha = spectrum_pool.getLinearIonSpectrum(alpha, cross_link_candidate.cross_link_position.first, 2, link_pos_B);
+        OPXLTheoreticalSpectrumPool::SimpleSpectrumPtr linear_beta = type_is_cross_link ? spectrum_pool.getLinearIonSpectrum(beta, cross_link_candidate.cross_link_position.second, 2) : no_peaks;
+        const std::vector< SimpleTSGXLMS::SimplePeak >& theoretical_spec_linear_alpha = *linear_alpha;
+        const std::vector< SimpleTSGXLMS::SimplePeak >& theoretical_spec_linear_beta = *linear_beta;
 
         // Something like this can happen, e.g. with a loop link connecting the first and last residue of a peptide
         if ( theoretical_spec_linear_alpha.empty() )
@@ -489,19 +486,23 @@ using namespace OpenMS;
         {
           continue;
         }
-        theoretical_spec_xlinks_alpha.reserve(1500);
-
+        OPXLTheoreticalSpectrumPool::SimpleSpectrumPtr xlinks_alpha;
+        OPXLTheoreticalSpectrumPool::SimpleSpectrumPtr xlinks_beta = no_peaks;
         if (type_is_cross_link)
         {
-          theoretical_spec_xlinks_beta.reserve(1500);
-          specGen_mainscore.getXLinkIonSpectrum(theoretical_spec_xlinks_alpha, cross_link_candidate, true, 2, precursor_charge);
-          specGen_mainscore.getXLinkIonSpectrum(theoretical_spec_xlinks_beta, cross_link_candidate, false, 2, precursor_charge);
+          xlinks_alpha = spectrum_pool.getXLinkIonSpectrum(cross_link_candidate, true, 2, precursor_charge);
+          xlinks_beta = spectrum_pool.getXLinkIonSpectrum(cross_link_candidate, false, 2, precursor_charge);
         }
         else
         {
-          // Function for mono-links or loop-links
-          specGen_mainscore.getXLinkIonSpectrum(theoretical_spec_xlinks_alpha, alpha, cross_link_candidate.cross_link_position.first, precursor_mass, 1, precursor_charge, link_pos_B);
+          // Function for mono-links or loop-links, these depend on the precursor mass and are not pooled
+          OPXLTheoreticalSpectrumPool::SimpleSpectrum mono_loop_xlinks;
+          mono_loop_xlinks.reserve(1500);
+          specGen_mainscore.getXLinkIonSpectrum(mono_loop_xlinks, alpha, cross_link_candidate.cross_link_position.first, precursor_mass, 1, precursor_charge, link_pos_B);
+          xlinks_alpha.reset(new OPXLTheoreticalSpectrumPool::SimpleSpectrum(std::move(mono_loop_xlinks)));
         }
+        const std::vector< SimpleTSGXLMS::SimplePeak >& theoretical_spec_xlinks_alpha = *xlinks_alpha;
+        const std::vector< SimpleTSGXLMS::SimplePeak >& theoretical_spec_xlinks_beta = *xlinks_beta;
         if (theoretical_spec_xlinks_alpha.empty())
         {
           continue;
@@ -34,6 +34,7 @@
 
 
 #include <OpenMS/ANALYSIS/XLMS/XQuestScores.h>
+#include <OpenMS/COMPARISON/SPECTRA/PeakMatcher.h>
 #include <OpenMS/MATH/STATISTICS/StatisticFunctions.h>
 #include <boost/math/distributions/binomial.hpp>
 #include <numeric>
@@ -392,29 +393,11 @@ namespace OpenMS
       return 0.0;
     }
 
-    double maxionsize = std::max(spec1[spec1.size()-1].getMZ(), spec2[spec2.size()-1].getMZ());
-    Int table_size = ceil(maxionsize / tolerance)+1;
-    std::vector< double > ion_table1(table_size, 0);
-    std::vector< double > ion_table2(table_size, 0);
-
-    // Build tables of the same size, each bin has the size of the tolerance
-    for (Size i = 0; i < spec1.size(); ++i)
-    {
-      Size pos = static_cast<Size>(ceil(spec1[i].getMZ() / tolerance));
-      ion_table1[pos] = 1;
-    }
-    for (Size i = 0; i < spec2.size(); ++i)
-    {
-      Size pos =static_cast<Size>(ceil(spec2[i].getMZ() / tolerance));
-      ion_table2[pos] = 1;
-
-    }
-
-    double dot_product = 0.0;
-    for (Size i = 0; i < ion_table1.size(); ++i)
-    {
-      dot_product += ion_table1[i] * ion_table2[i];
-    }
+    // each bin has the size of the tolerance, count the bins both spectra have a peak in
+    std::vector< double > mz1, mz2;
+    PeakMatcher::getMZs(spec1, mz1);
+    PeakMatcher::getMZs(spec2, mz2);
+    double dot_product = PeakMatcher::countSharedBins(mz1, mz2, tolerance);
 
     // determine the smaller spectrum and normalize by the number of peaks in it
     double peaks = std::min(spec1.size(), spec2.size());
@@ -38,6 +38,8 @@
 #include <OpenMS/APPLICATIONS/ParameterInformation.h>
 #include <OpenMS/APPLICATIONS/ToolHandler.h>
 
+#include <OpenMS/CONCEPT/ParallelExecution.h>
+#include <OpenMS/CONCEPT/Profiler.h>
 #include <OpenMS/CONCEPT/VersionInfo.h>
 
 #include <OpenMS/DATASTRUCTURES/Date.h>
@@ -47,6 +49,7 @@
 
 #include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/FORMAT/FileTypes.h>
+#include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/FORMAT/ParamXMLFile.h>
 #include <OpenMS/FORMAT/VALIDATORS/XMLValidator.h>
 
@@ -54,8 +57,12 @@
 #include <OpenMS/KERNEL/ConsensusMap.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 
+#include <OpenMS/METADATA/PeptideIdentification.h>
+#include <OpenMS/METADATA/ProteinIdentification.h>
+
 #include <OpenMS/SYSTEM/ExternalProcess.h>
 #include <OpenMS/SYSTEM/File.h>
+#include <OpenMS/SYSTEM/ResourceTracker.h>
 #include <OpenMS/SYSTEM/StopWatch.h>
 #include <OpenMS/SYSTEM/SysInfo.h>
 #include <OpenMS/SYSTEM/UpdateCheck.h>
@@ -70,6 +77,8 @@
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
+#include <memory>
+#include <unordered_set>
 
 // OpenMP support
 #ifdef _OPENMP
@@ -90,22 +99,24 @@ namespace OpenMS
 
   using namespace Exception;
 
+  namespace
+  {
+    /// Common options that describe a single run (e.g. where to write diagnostics); they are neither written to nor read from INI or CTD files
+    bool isCommandLineOnly(const String& name)
+    {
+      return name == "thread_affinity" || name == "profile" || name == "resource_report";
+    }
+  }
+
   String TOPPBase::topp_ini_file_ = String(QDir::homePath()) + "/.TOPP.ini";
   const Citation TOPPBase::cite_openms_ = { "Rost HL, Sachsenberg T, Aiche S, Bielow C et al.",
       "OpenMS: a flexible open-source software platform for mass spectrometry data analysis",
       "Nat Meth. 2016; 13, 9: 741-748",
       "10.1038/nmeth.3959" };
 
-  void TOPPBase::setMaxNumberOfThreads(int
-#ifdef _OPENMP
-                                       num_threads // to avoid the unused warning we enable this
-                                                   // argument only if openmp is available
-#endif
-                                       )
+  void TOPPBase::setMaxNumberOfThreads(int num_threads)
   {
-#ifdef _OPENMP
-    omp_set_num_threads(num_threads);
-#endif
+    ParallelExecution::setNumberOfThreads(num_threads);
   }
 
   TOPPBase::TOPPBase(const String& tool_name, const String& tool_description, bool official, const std::vector<Citation>& citations) :
@@ -163,8 +174,12 @@ namespace OpenMS
     registerIntOption_("instance", "<n>", 1, "Instance number for the TOPP INI file", false, true);
     registerIntOption_("debug", "<n>", 0, "Sets the debug level", false, true);
     registerIntOption_("threads", "<n>", 1, "Sets the number of threads allowed to be used by the TOPP tool", false);
+    registerStringOption_("thread_affinity", "<mode>", "none", "Pins the threads to CPU cores: 'close' packs them onto as few sockets as possible, 'spread' distributes them over all sockets (NUMA nodes). Ignored if OMP_PROC_BIND or OMP_PLACES are set. Linux only (command line only, not stored in INI files).", false, true);
+    setValidStrings_("thread_affinity", ListUtils::create<String>("none,close,spread"));
     registerStringOption_("write_ini", "<file>", "", "Writes the default configuration file", false);
     registerStringOption_("write_ctd", "<out_dir>", "", "Writes the common tool description file(s) (Toolname(s).ctd) to <out_dir>", false, true);
+    registerStringOption_("profile", "<file>", "", "Records the run time of instrumented code regions and writes them as Chrome trace (JSON) to this file (command line only, not stored in INI files)", false, true);
+    registerStringOption_("resource_report", "<file>", "", "Writes wall time, CPU time, peak memory and thread utilization of this run (in total and per processing stage) as JSON to this file (command line only, not stored in INI files)", false, true);
     registerFlag_("no_progress", "Disables progress logging to command line", true);
     registerFlag_("force", "Overrides tool-specific checks", true);
     registerFlag_("test", "Enables the test mode (needed for internal use only)", true);
@@ -326,6 +341,10 @@ namespace OpenMS
 
 
         finalParam.remove("ini"); // not contained in default params; remove to avoid "unknown param" in update()
+        for (const ParameterInformation& info : parameters_)
+        {
+          if (isCommandLineOnly(info.name)) finalParam.remove(info.name); // not contained in default params either
+        }
 
         // finally: augment default values with INI/CLI values
         // note the copy(getIniLocation_(),..) as we want the param tree without instance
@@ -342,6 +361,15 @@ namespace OpenMS
           param_.setValue("type", finalParam.getValue("type"));
         }
 
+        // command line only options are taken as given
+        for (const ParameterInformation& info : parameters_)
+        {
+          if (isCommandLineOnly(info.name) && param_cmdline_.exists(info.name))
+          {
+            param_.setValue(info.name, param_cmdline_.getValue(info.name));
+          }
+        }
+
         // check if all parameters are registered and have the correct type
         checkParam_(param_instance_, (String)value_ini, getIniLocation_());
         checkParam_(param_common_tool_, (String)value_ini, "common:" + tool_name_ + "::");
@@ -401,22 +429,77 @@ namespace OpenMS
       //threads
       //----------------------------------------------------------
       TOPPBase::setMaxNumberOfThreads(getParamAsInt_("threads", 1));
+      const String thread_affinity = getParamAsString_("thread_affinity", "none");
+      const StringList& affinity_modes = findEntry_("thread_affinity").valid_strings;
+      if (std::find(affinity_modes.begin(), affinity_modes.end(), thread_affinity) == affinity_modes.end())
+      {
+        // command line only options are not checked against the defaults
+        throw InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Invalid value '" + thread_affinity + "' for -thread_affinity. Valid values are: " + ListUtils::concatenate(affinity_modes, ", "));
+      }
+      if (thread_affinity != "none")
+      {
+        ParallelExecution::setThreadAffinity(thread_affinity == "spread" ? ParallelExecution::ThreadAffinity::SPREAD : ParallelExecution::ThreadAffinity::CLOSE);
+      }
+
+      //----------------------------------------------------------
+      //profiling
+      //----------------------------------------------------------
+      const String profile_file = getParamAsString_("profile");
+      if (!profile_file.empty())
+      {
+        Profiler::setEnabled(true);
+      }
 
       //----------------------------------------------------------
       //main
       //----------------------------------------------------------
       StopWatch sw;
       sw.start();
-      result = main_(argc, argv);
+      resource_tracker_.start();
+      {
+        Profiler::ScopedTimer main_timer(Profiler::intern(tool_name_));
+        result = main_(argc, argv);
+      }
+      resource_tracker_.stop();
       sw.stop();
       // useful for benchmarking and for execution on clusters with schedulers
+      size_t mem_virtual(0);
+      SysInfo::getProcessPeakMemoryConsumption(mem_virtual);
       String mem_usage;
+      if (mem_virtual != 0) mem_usage = String("; Peak Memory Usage: ") + (mem_virtual / 1024) + " MB";
+      if (!profile_file.empty())
       {
-        size_t mem_virtual(0);
-        SysInfo::getProcessPeakMemoryConsumption(mem_virtual);
-        if (mem_virtual != 0) mem_usage = String("; Peak Memory Usage: ") + (mem_virtual / 1024) + " MB";
+        // recorded in the trace for pipeline benchmarks (see PipelineBenchmark)
+        Profiler::addCounter("peak_memory_kb", Int64(mem_virtual));
+        Profiler::setEnabled(false);
+        Profiler::storeChromeTrace(profile_file);
+        if (debug_level_ > 0)
+        {
+          Profiler::printSummary(OpenMS_Log_debug);
+        }
+        OPENMS_LOG_INFO << "Profile written to '" << profile_file << "'." << std::endl;
       }
       OPENMS_LOG_INFO << this->tool_name_ << " took " << sw.toString() << mem_usage << "." << std::endl;
+
+      //----------------------------------------------------------
+      //resource usage
+      //----------------------------------------------------------
+      Size threads = 1;
+#ifdef _OPENMP
+      threads = omp_get_max_threads();
+#endif
+      for (const ResourceTracker::Stage& stage : resource_tracker_.getStages())
+      {
+        writeDebug_(String("Stage '") + stage.name + "': " + String::number(stage.wall_time, 2) + " s wall time, "
+                    + String::number(stage.cpu_time, 2) + " s CPU time, " + (stage.peak_memory_kb / 1024) + " MB peak memory", 1);
+      }
+      writeDebug_(String("CPU time: ") + String::number(resource_tracker_.getCPUTime(), 2) + " s; thread utilization: "
+                  + String::number(100.0 * resource_tracker_.getThreadUtilization(threads), 1) + "% of " + threads + " thread(s)", 1);
+      const String resource_file = getParamAsString_("resource_report");
+      if (!resource_file.empty())
+      {
+        resource_tracker_.storeJSON(resource_file, tool_name_, threads, Int(result));
+      }
     } // end try{}
     //----------------------------------------------------------
     //error handling
@@ -1511,6 +1594,11 @@ namespace OpenMS
     }
   }
 
+  void TOPPBase::addResourceCheckpoint_(const String& name)
+  {
+    resource_tracker_.checkpoint(name);
+  }
+
   TOPPBase::ExitCodes TOPPBase::runExternalProcess_(const QString& executable, const QStringList& arguments, const QString& workdir) const
   {
     String sstdout, sstderr; // collect all output (might be useful if program crashes, see below)
@@ -1533,6 +1621,144 @@ namespace OpenMS
     return EXECUTION_OK;
   }
 
+  TOPPBase::ExitCodes TOPPBase::runExternalProcesses_(const QString& executable, const std::vector<QStringList>& arguments, const QString& workdir, Size max_concurrent) const
+  {
+    const Size n = arguments.size();
+    if (max_concurrent == 0) max_concurrent = n;
+
+    // output of each process is collected separately (callbacks of concurrent processes would interleave otherwise)
+    std::vector<String> sstdout(n), sstderr(n);
+    std::vector<std::pair<Size, std::unique_ptr<ExternalProcess>>> running;
+    auto report = [&](Size i)
+    {
+      if (debug_level_ >= 4) return;  // already written in callback
+      writeLog_("Standard output (process " + String(i + 1) + " of " + String(n) + "): " + sstdout[i]);
+      writeLog_("Standard error (process " + String(i + 1) + " of " + String(n) + "): " + sstderr[i]);
+    };
+
+    bool failed = false;
+    Size next = 0;
+    while ((!failed && next < n) || !running.empty())
+    {
+      // fill free slots
+      while (!failed && next < n && running.size() < max_concurrent)
+      {
+        String* out = &sstdout[next];
+        String* err = &sstderr[next];
+        auto lam_out = [out, this](const String& o) { *out += o; if (debug_level_ >= 4) OPENMS_LOG_INFO << o; };
+        auto lam_err = [err, this](const String& o) { *err += o; if (debug_level_ >= 4) OPENMS_LOG_INFO << o; };
+        std::unique_ptr<ExternalProcess> ep(new ExternalProcess(lam_out, lam_err));
+        String error_msg;
+        if (ep->start(executable, arguments[next], workdir, true, error_msg) != ExternalProcess::RETURNSTATE::SUCCESS)
+        {
+          report(next);
+          failed = true;
+        }
+        else
+        {
+          running.emplace_back(next, std::move(ep));
+        }
+        ++next;
+      }
+
+      // forward output and collect finished processes
+      for (auto it = running.begin(); it != running.end(); )
+      {
+        if (it->second->isRunning(50 / running.size() + 1))
+        {
+          ++it;
+          continue;
+        }
+        String error_msg;
+        if (it->second->getResult(true, error_msg) != ExternalProcess::RETURNSTATE::SUCCESS)
+        {
+          report(it->first);
+          failed = true;
+        }
+        it = running.erase(it);
+      }
+    }
+
+    return failed ? EXTERNAL_PROGRAM_ERROR : EXECUTION_OK;
+  }
+
+  StringList TOPPBase::writeSpectrumChunks_(const PeakMap& exp, Size chunks, const String& file_prefix) const
+  {
+    Size n_msn(0);
+    bool has_ms1(false);
+    for (const MSSpectrum& spec : exp)
+    {
+      if (spec.getMSLevel() > 1) ++n_msn;
+      else has_ms1 = true;
+    }
+    chunks = std::max(Size(1), std::min(chunks, n_msn));
+    const Size per_chunk = (n_msn + chunks - 1) / chunks;
+
+    StringList files;
+    Size begin(0), count(0);
+    for (Size i = 0; i < exp.size(); ++i)
+    {
+      if (exp[i].getMSLevel() > 1) ++count;
+      const bool last = (i + 1 == exp.size());
+      // cut once the chunk is full, but not between an MS1 spectrum and its fragment spectra
+      if (!last && (count < per_chunk || (has_ms1 && exp[i + 1].getMSLevel() > 1))) continue;
+
+      PeakMap chunk;
+      chunk.ExperimentalSettings::operator=(exp);
+      chunk.reserveSpaceSpectra(i + 1 - begin);
+      for (Size s = begin; s <= i; ++s)
+      {
+        chunk.addSpectrum(exp[s]);
+      }
+      const String filename = file_prefix + "_" + String(files.size() + 1) + ".mzML";
+      writeDebug_("Writing spectra " + String(begin) + " to " + String(i) + " to '" + filename + "'", 2);
+      MzMLFile().store(filename, chunk);
+      files.push_back(filename);
+      begin = i + 1;
+      count = 0;
+    }
+    return files;
+  }
+
+  void TOPPBase::mergeChunkIdentifications_(std::vector<ProteinIdentification>& proteins, std::vector<PeptideIdentification>& peptides,
+                                            std::vector<ProteinIdentification>& chunk_proteins, std::vector<PeptideIdentification>& chunk_peptides)
+  {
+    if (proteins.empty())
+    {
+      if (chunk_proteins.empty())
+      {
+        throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "No protein identification run found for the first chunk.");
+      }
+      proteins.push_back(std::move(chunk_proteins[0]));
+    }
+    ProteinIdentification& run = proteins[0];
+
+    std::unordered_set<String> accessions;
+    for (const ProteinHit& hit : run.getHits())
+    {
+      accessions.insert(hit.getAccession());
+    }
+    for (ProteinIdentification& chunk_run : chunk_proteins)
+    {
+      for (ProteinHit& hit : chunk_run.getHits())
+      {
+        if (accessions.insert(hit.getAccession()).second)
+        {
+          run.insertHit(std::move(hit));
+        }
+      }
+    }
+    chunk_proteins.clear();
+
+    peptides.reserve(peptides.size() + chunk_peptides.size());
+    for (PeptideIdentification& pep : chunk_peptides)
+    {
+      pep.setIdentifier(run.getIdentifier());
+      peptides.push_back(std::move(pep));
+    }
+    chunk_peptides.clear();
+  }
+
   String TOPPBase::getParamAsString_(const String& key, const String& default_value) const
   {
     const DataValue& tmp = getParam_(key);
@@ -1909,7 +2135,7 @@ namespace OpenMS
     //parameters
     for (vector<ParameterInformation>::const_iterator it = parameters_.begin(); it != parameters_.end(); ++it)
     {
-      if (it->name == "ini" || it->name == "-help" || it->name == "-helphelp" || it->name == "instance" || it->name == "write_ini" || it->name == "write_ctd") // do not store those params in ini file
+      if (it->name == "ini" || it->name == "-help" || it->name == "-helphelp" || it->name == "instance" || it->name == "write_ini" || it->name == "write_ctd" || isCommandLineOnly(it->name)) // do not store those params in ini file
       {
         continue;
       }
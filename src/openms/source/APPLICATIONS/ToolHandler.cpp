@@ -226,6 +226,7 @@ namespace OpenMS
     util_map["OpenSwathWorkflow"] = Internal::ToolDescription("OpenSwathWorkflow", util_category);
     util_map["OpenSwathRewriteToFeatureXML"] = Internal::ToolDescription("OpenSwathRewriteToFeatureXML", "Targeted Experiments");
     util_map["OpenSwathFileSplitter"] = Internal::ToolDescription("OpenSwathFileSplitter", "Targeted Experiments");
+    util_map["OpenSwathShardMerger"] = Internal::ToolDescription("OpenSwathShardMerger", "Targeted Experiments");
     util_map["OpenSwathDIAPreScoring"] = Internal::ToolDescription("OpenSwathDIAPreScoring", "Targeted Experiments");
     util_map["OpenSwathMzMLFileCacher"] = Internal::ToolDescription("OpenSwathMzMLFileCacher", "Targeted Experiments");
     util_map["PeakPickerIterative"] = Internal::ToolDescription("PeakPickerIterative", "Signal processing and preprocessing");
@@ -237,6 +238,7 @@ namespace OpenMS
     util_map["QCExtractor"] = Internal::ToolDescription("QCExtractor", util_category);
     util_map["QCExporter"] = Internal::ToolDescription("QCExporter", util_category);
     util_map["QCImporter"] = Internal::ToolDescription("QCImporter", util_category);
+    util_map["QCLiveMonitor"] = Internal::ToolDescription("QCLiveMonitor", util_category);
     util_map["QCMerger"] = Internal::ToolDescription("QCMerger", util_category);
     util_map["QCShrinker"] = Internal::ToolDescription("QCExporter", util_category);
     util_map["RNADigestor"] = Internal::ToolDescription("RNADigestor", util_category);
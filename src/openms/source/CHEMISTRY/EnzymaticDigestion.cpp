@@ -51,6 +51,7 @@ namespace OpenMS
     re_(enzyme_->getRegEx()),
     specificity_(SPEC_FULL)
   {
+    parseSiteRules_(enzyme_->getRegEx(), site_rules_);
   }
 
   EnzymaticDigestion::~EnzymaticDigestion()
@@ -68,9 +69,105 @@ namespace OpenMS
   }
 
   void EnzymaticDigestion::setEnzyme(const DigestionEnzyme* enzyme)
+  {
+    compileEnzyme_(enzyme);
+  }
+
+  void EnzymaticDigestion::compileEnzyme_(const DigestionEnzyme* enzyme)
   {
     enzyme_ = enzyme;
     re_ = boost::regex(enzyme_->getRegEx());
+    parseSiteRules_(enzyme_->getRegEx(), site_rules_);
+  }
+
+  namespace
+  {
+    /// parses a residue or a bracket expression of residues (e.g. 'P' or '[KR]') at @p pos into @p set
+    bool parseResidueSet(const String& regex, Size& pos, std::bitset<256>& set)
+    {
+      set.reset();
+      if (pos >= regex.size()) return false;
+      if (regex[pos] != '[')
+      {
+        if (!isalpha((unsigned char)regex[pos])) return false;
+        set.set((unsigned char)regex[pos++]);
+        return true;
+      }
+      ++pos; // skip '['
+      while (pos < regex.size() && isalpha((unsigned char)regex[pos]))
+      {
+        set.set((unsigned char)regex[pos++]);
+      }
+      if (pos >= regex.size() || regex[pos] != ']' || set.none()) return false; // ranges, negation, escapes, ...
+      ++pos;
+      return true;
+    }
+  }
+
+  bool EnzymaticDigestion::parseSiteRules_(const String& regex, std::vector<SiteRule_>& rules)
+  {
+    rules.clear();
+    rules.push_back(SiteRule_());
+    Size depth = 0; // nesting of plain (capturing) groups
+    Size pos = 0;
+    while (pos < regex.size())
+    {
+      if (regex.compare(pos, 2, "(?") == 0)
+      {
+        SiteRule_& rule = rules.back();
+        std::bitset<256> set;
+        if (regex.compare(pos, 4, "(?<=") == 0)
+        {
+          pos += 4;
+          if (!parseResidueSet(regex, pos, set)) break;
+          rule.before = rule.has_before ? (rule.before & set) : set;
+          rule.has_before = true;
+        }
+        else if (regex.compare(pos, 3, "(?=") == 0)
+        {
+          pos += 3;
+          if (!parseResidueSet(regex, pos, set)) break;
+          rule.after = rule.has_after ? (rule.after & set) : set;
+          rule.has_after = true;
+        }
+        else if (regex.compare(pos, 3, "(?!") == 0)
+        {
+          pos += 3;
+          if (!parseResidueSet(regex, pos, set)) break;
+          rule.not_after |= set;
+          rule.has_not_after = true;
+        }
+        else break; // other extensions
+        if (pos >= regex.size() || regex[pos] != ')') break; // look-around of more than one residue
+        ++pos;
+      }
+      else if (regex[pos] == '(')
+      {
+        ++depth;
+        ++pos;
+      }
+      else if (regex[pos] == ')' && depth > 0)
+      {
+        --depth;
+        ++pos;
+      }
+      else if (regex[pos] == '|' && depth == 0)
+      {
+        rules.push_back(SiteRule_());
+        ++pos;
+      }
+      else break; // residues outside of look-arounds, quantifiers, alternatives inside groups, ...
+    }
+    bool valid = (pos == regex.size() && depth == 0);
+    for (const SiteRule_& rule : rules)
+    { // rules without a residue (e.g. '(?!P)' or an empty alternative) also match in empty ranges, leave those to the regex
+      valid = valid && (rule.has_before || rule.has_after);
+    }
+    if (!valid)
+    {
+      rules.clear();
+    }
+    return valid;
   }
 
   String EnzymaticDigestion::getEnzymeName() const
@@ -104,7 +201,29 @@ namespace OpenMS
     start = std::max(0, start);
     if (end < 0 || end > (int)sequence.size()) end = (int)sequence.size();
 
-    if (enzyme_->getRegEx() != "()") // if it's not "no cleavage"
+    if (enzyme_->getRegEx() != "()" && !site_rules_.empty()) // single pass over the sequence, without the regex engine
+    {
+      if (start >= end) return positions;
+      // like boost::sregex_token_iterator: report 'start' first, then every site (a site at 'start' yields an
+      // additional 'start' for the empty leading token, a site at 'end' is not reported); look-behinds cannot see
+      // residues before 'start'
+      positions.push_back(start);
+      const unsigned char* seq = reinterpret_cast<const unsigned char*>(sequence.c_str());
+      for (int i = start; i < end; ++i)
+      {
+        for (const SiteRule_& rule : site_rules_)
+        {
+          if ((!rule.has_before || (i > start && rule.before[seq[i - 1]])) &&
+              (!rule.has_after || rule.after[seq[i]]) &&
+              (!rule.has_not_after || !rule.not_after[seq[i]]))
+          {
+            positions.push_back(i);
+            break;
+          }
+        }
+      }
+    }
+    else if (enzyme_->getRegEx() != "()") // if it's not "no cleavage"
     {
       boost::sregex_token_iterator i(sequence.begin() + start, sequence.begin() + end, re_, -1);
       boost::sregex_token_iterator j;
@@ -0,0 +1,242 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternCache.h>
+
+#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternGenerator.h>
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+namespace OpenMS
+{
+
+  bool CoarseIsotopePatternCache::Key::operator<(const Key& rhs) const
+  {
+    if (max_isotope != rhs.max_isotope) return max_isotope < rhs.max_isotope;
+    if (round_masses != rhs.round_masses) return round_masses < rhs.round_masses;
+    return formula < rhs.formula;
+  }
+
+  CoarseIsotopePatternCache::CoarseIsotopePatternCache(Size max_entries) :
+    max_entries_(max_entries)
+  {
+  }
+
+  CoarseIsotopePatternCache* CoarseIsotopePatternCache::getInstance()
+  {
+    static CoarseIsotopePatternCache* cache_ = new CoarseIsotopePatternCache();
+    return cache_;
+  }
+
+  IsotopeDistribution CoarseIsotopePatternCache::getIsotopeDistribution(const EmpiricalFormula& formula, Size max_isotope, bool round_masses)
+  {
+    Key key = {formula.toString(), max_isotope, round_masses};
+    return get_(key, formula);
+  }
+
+  IsotopeDistribution CoarseIsotopePatternCache::getIsotopeDistribution(const String& formula, Size max_isotope, bool round_masses)
+  {
+    Key key = {formula, max_isotope, round_masses};
+    IsotopeDistribution result;
+    if (find_(key, result)) return result;
+    return get_(key, EmpiricalFormula(formula));
+  }
+
+  IsotopeDistribution CoarseIsotopePatternCache::estimateFromPeptideWeight(double average_weight, Size max_isotope)
+  {
+    // Element counts are from Senko's Averagine model (as in CoarseIsotopePatternGenerator::estimateFromPeptideWeight)
+    EmpiricalFormula ef;
+    ef.estimateFromWeightAndComp(average_weight, 4.9384, 7.7583, 1.3577, 1.4773, 0.0417, 0);
+    return getIsotopeDistribution(ef, max_isotope);
+  }
+
+  IsotopeDistribution CoarseIsotopePatternCache::estimateFromPeptideWeightInterpolated(double average_weight, Size max_isotope, double bucket_width)
+  {
+    if (!(bucket_width > 0))
+    {
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "The mass bucket width needs to be positive.", String(bucket_width));
+    }
+
+    double bucket = std::floor(average_weight / bucket_width);
+    double lower_weight = bucket * bucket_width;
+    double fraction = (average_weight - lower_weight) / bucket_width;
+    IsotopeDistribution lower = estimateFromPeptideWeight(lower_weight, max_isotope);
+    if (fraction <= 0) return lower;
+    IsotopeDistribution upper = estimateFromPeptideWeight(lower_weight + bucket_width, max_isotope);
+
+    // interpolate peak by peak (missing peaks have zero intensity at the mass of the other distribution)
+    IsotopeDistribution::ContainerType peaks(std::max(lower.size(), upper.size()));
+    for (Size i = 0; i < peaks.size(); ++i)
+    {
+      bool has_lower = i < lower.size(), has_upper = i < upper.size();
+      double mz_lower = has_lower ? lower.getContainer()[i].getMZ() : upper.getContainer()[i].getMZ() - bucket_width;
+      double mz_upper = has_upper ? upper.getContainer()[i].getMZ() : lower.getContainer()[i].getMZ() + bucket_width;
+      double int_lower = has_lower ? lower.getContainer()[i].getIntensity() : 0.0;
+      double int_upper = has_upper ? upper.getContainer()[i].getIntensity() : 0.0;
+      peaks[i].setMZ((1 - fraction) * mz_lower + fraction * mz_upper);
+      peaks[i].setIntensity((1 - fraction) * int_lower + fraction * int_upper);
+    }
+    IsotopeDistribution result;
+    result.set(peaks);
+    result.renormalize();
+    return result;
+  }
+
+  void CoarseIsotopePatternCache::precomputeAveragine(double max_weight, Size max_isotope, double bucket_width)
+  {
+    if (!(bucket_width > 0))
+    {
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "The mass bucket width needs to be positive.", String(bucket_width));
+    }
+
+    SignedSize nr_buckets = (SignedSize)std::ceil(max_weight / bucket_width) + 1;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+    for (SignedSize i = 0; i < nr_buckets; ++i)
+    {
+      estimateFromPeptideWeight(i * bucket_width, max_isotope);
+    }
+  }
+
+  void CoarseIsotopePatternCache::store(const String& filename) const
+  {
+    std::ofstream os(filename.c_str());
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    os.precision(std::numeric_limits<double>::digits10 + 2);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    // one line per distribution: formula, max. isotope, rounded masses, followed by m/z and intensity of each peak
+    for (const auto& entry : cache_)
+    {
+      os << entry.first.formula << '\t' << entry.first.max_isotope << '\t' << (entry.first.round_masses ? 1 : 0);
+      for (const auto& peak : entry.second)
+      {
+        os << '\t' << peak.getMZ() << '\t' << peak.getIntensity();
+      }
+      os << '\n';
+    }
+  }
+
+  void CoarseIsotopePatternCache::load(const String& filename)
+  {
+    if (!File::exists(filename))
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    std::ifstream is(filename.c_str());
+
+    std::string line;
+    Size line_number = 0;
+    while (std::getline(is, line))
+    {
+      ++line_number;
+      if (line.empty()) continue;
+
+      std::vector<String> fields;
+      String(line).split('\t', fields);
+      if (fields.size() < 3 || (fields.size() - 3) % 2 != 0)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, line, "Invalid isotope distribution in line " + String(line_number) + " of " + filename);
+      }
+
+      try
+      {
+        Key key = {fields[0], (Size)fields[1].toInt(), fields[2].toInt() != 0};
+        IsotopeDistribution::ContainerType peaks;
+        for (Size i = 3; i < fields.size(); i += 2)
+        {
+          peaks.push_back(IsotopeDistribution::MassAbundance(fields[i].toDouble(), fields[i + 1].toDouble()));
+        }
+        IsotopeDistribution dist;
+        dist.set(peaks);
+        insert_(key, dist);
+      }
+      catch (Exception::ConversionError&)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, line, "Invalid number in line " + String(line_number) + " of " + filename);
+      }
+    }
+  }
+
+  Size CoarseIsotopePatternCache::size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cache_.size();
+  }
+
+  void CoarseIsotopePatternCache::clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_.clear();
+  }
+
+  IsotopeDistribution CoarseIsotopePatternCache::get_(const Key& key, const EmpiricalFormula& formula)
+  {
+    IsotopeDistribution result;
+    if (find_(key, result)) return result;
+
+    // compute without holding the lock (concurrent requests for the same key compute the same result)
+    result = formula.getIsotopeDistribution(CoarseIsotopePatternGenerator(key.max_isotope, key.round_masses));
+    insert_(key, result);
+    return result;
+  }
+
+  bool CoarseIsotopePatternCache::find_(const Key& key, IsotopeDistribution& result) const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = cache_.find(key);
+    if (it == cache_.end()) return false;
+    result = it->second;
+    return true;
+  }
+
+  void CoarseIsotopePatternCache::insert_(const Key& key, const IsotopeDistribution& result)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (cache_.size() < max_entries_)
+    {
+      cache_.insert(std::make_pair(key, result));
+    }
+  }
+
+}
@@ -36,6 +36,9 @@
 
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsotopeDistribution.h>
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsoSpecWrapper.h>
+#include <OpenMS/CHEMISTRY/Element.h>
+
+#include <map>
 
 namespace OpenMS
 {
@@ -57,5 +60,57 @@ namespace OpenMS
     }
   }
 
+  std::vector<IsotopeDistribution> FineIsotopePatternGenerator::runBatch(const std::vector<EmpiricalFormula>& formulas) const
+  {
+    // extract the isotope tables of all elements in the batch once (zero
+    // abundances are skipped, IsoSpec requires all probabilities to be positive)
+    typedef std::pair<std::vector<double>, std::vector<double> > IsotopeTable;
+    std::map<const Element*, IsotopeTable> tables;
+    for (const EmpiricalFormula& formula : formulas)
+    {
+      for (const auto& elem : formula)
+      {
+        if (tables.find(elem.first) != tables.end()) continue;
+        IsotopeTable& table = tables[elem.first];
+        for (const auto& iso : elem.first->getIsotopeDistribution())
+        {
+          if (iso.getIntensity() <= 0.0) continue;
+          table.first.push_back(iso.getMZ());
+          table.second.push_back(iso.getIntensity());
+        }
+      }
+    }
+
+    std::vector<IsotopeDistribution> result(formulas.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)formulas.size(); ++i)
+    {
+      const EmpiricalFormula& formula = formulas[i];
+      std::vector<int> isotope_numbers, atom_counts;
+      std::vector<std::vector<double> > isotope_masses, isotope_probabilities;
+      for (const auto& elem : formula)
+      {
+        const IsotopeTable& table = tables.find(elem.first)->second;
+        atom_counts.push_back(elem.second);
+        isotope_numbers.push_back(table.first.size());
+        isotope_masses.push_back(table.first);
+        isotope_probabilities.push_back(table.second);
+      }
+
+      if (use_total_prob_)
+      {
+        result[i] = IsoSpecTotalProbWrapper(isotope_numbers, atom_counts, isotope_masses, isotope_probabilities, 1.0-stop_condition_, true).run();
+      }
+      else
+      {
+        result[i] = IsoSpecThresholdWrapper(isotope_numbers, atom_counts, isotope_masses, isotope_probabilities, stop_condition_, absolute_).run();
+      }
+      result[i].sortByMass();
+    }
+    return result;
+  }
+
 }
 
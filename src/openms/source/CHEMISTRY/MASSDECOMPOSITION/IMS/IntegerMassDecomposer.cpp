@@ -0,0 +1,90 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Anton Pervukhin <Anton.Pervukhin@CeBiTec.Uni-Bielefeld.DE> $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CHEMISTRY/MASSDECOMPOSITION/IMS/IntegerMassDecomposer.h>
+
+#include <OpenMS/SYSTEM/File.h>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cstdio>
+
+namespace OpenMS
+{
+  namespace ims
+  {
+    namespace Internal
+    {
+
+      bool MappedERTFile::map(const std::string & filename)
+      {
+        region_.reset();
+        data_ = nullptr;
+        size_ = 0;
+        if (!File::exists(filename))
+        {
+          return false;
+        }
+        try
+        {
+          boost::interprocess::file_mapping mapping(filename.c_str(), boost::interprocess::read_only);
+          region_.reset(new boost::interprocess::mapped_region(mapping, boost::interprocess::read_only));
+        }
+        catch (boost::interprocess::interprocess_exception &)
+        {
+          return false; // e.g. an empty file, which cannot be mapped
+        }
+        data_ = static_cast<const char *>(region_->get_address());
+        size_ = region_->get_size();
+        return true;
+      }
+
+      std::string MappedERTFile::temporaryName(const std::string & filename)
+      {
+        return filename + "." + File::getUniqueName() + ".tmp";
+      }
+
+      void MappedERTFile::replace(const std::string & tmp_filename, const std::string & filename)
+      {
+        if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+        {
+          std::remove(tmp_filename.c_str());
+          throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+        }
+      }
+
+    } // namespace Internal
+  } // namespace ims
+} // namespace OpenMS
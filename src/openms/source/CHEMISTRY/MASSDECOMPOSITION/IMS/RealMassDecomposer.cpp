@@ -51,7 +51,17 @@ namespace OpenMS
         new integer_decomposer_type(weights));
     }
 
-    RealMassDecomposer::decompositions_type RealMassDecomposer::getDecompositions(double mass, double error)
+    RealMassDecomposer::RealMassDecomposer(const Weights & weights, const std::string & table_file) :
+      weights_(weights)
+    {
+
+      rounding_errors_ = std::make_pair(weights.getMinRoundingError(), weights.getMaxRoundingError());
+      precision_ = weights.getPrecision();
+      decomposer_ = std::shared_ptr<integer_decomposer_type>(
+        new integer_decomposer_type(weights, table_file));
+    }
+
+    RealMassDecomposer::decompositions_type RealMassDecomposer::getDecompositions(double mass, double error) const
     {
       // defines the range of integers to be decomposed
       integer_value_type start_integer_mass = static_cast<integer_value_type>(
@@ -89,7 +99,7 @@ namespace OpenMS
     }
 
     RealMassDecomposer::decompositions_type RealMassDecomposer::getDecompositions(double mass, double error,
-                                                                                  const constraints_type & constraints)
+                                                                                  const constraints_type & constraints) const
     {
 
       // defines the range of integers to be decomposed
@@ -148,7 +158,7 @@ namespace OpenMS
       return all_decompositions_from_range;
     }
 
-    RealMassDecomposer::number_of_decompositions_type RealMassDecomposer::getNumberOfDecompositions(double mass, double error)
+    RealMassDecomposer::number_of_decompositions_type RealMassDecomposer::getNumberOfDecompositions(double mass, double error) const
     {
       // defines the range of integers to be decomposed
       integer_value_type start_integer_mass = static_cast<integer_value_type>(1);
@@ -6,6 +6,7 @@ set(sources_list
 IMSAlphabet.cpp
 IMSElement.cpp
 IMSIsotopeDistribution.cpp
+IntegerMassDecomposer.cpp
 RealMassDecomposer.cpp
 Weights.cpp
 IMSAlphabetTextParser.cpp
@@ -37,8 +37,10 @@
 #include <OpenMS/CHEMISTRY/ResidueDB.h>
 #include <OpenMS/CHEMISTRY/ModificationDefinition.h>
 #include <OpenMS/CHEMISTRY/ModificationDefinitionsSet.h>
+#include <OpenMS/CONCEPT/LogStream.h>
 
 #include <iostream>
+#include <sstream>
 using namespace std;
 
 namespace OpenMS
@@ -50,6 +52,7 @@ namespace OpenMS
   {
     defaults_.setValue("decomp_weights_precision", 0.01, "precision used to calculate the decompositions, this only affects cache usage!", ListUtils::create<String>("advanced"));
     defaults_.setValue("tolerance", 0.3, "tolerance which is allowed for the decompositions");
+    defaults_.setValue("decomp_table_cache", "", "directory to cache the decomposition tables in (one file per alphabet and precision), such that they are computed only once; empty disables caching", ListUtils::create<String>("advanced"));
 
     vector<String> all_mods;
     ModificationsDB::getInstance()->getAllSearchModifications(all_mods);
@@ -74,7 +77,7 @@ namespace OpenMS
     delete decomposer_;
   }
 
-  void MassDecompositionAlgorithm::getDecompositions(vector<MassDecomposition> & decomps, double mass)
+  void MassDecompositionAlgorithm::getDecompositions(vector<MassDecomposition> & decomps, double mass) const
   {
     double tolerance((double) param_.getValue("tolerance"));
     ims::RealMassDecomposer::decompositions_type decompositions = decomposer_->getDecompositions(mass, tolerance);
@@ -207,7 +210,35 @@ namespace OpenMS
     weights.divideByGCD();
 
     // decomposes real values
-    decomposer_ = new ims::RealMassDecomposer(weights);
+    String cache_dir = param_.getValue("decomp_table_cache").toString();
+    if (cache_dir.empty())
+    {
+      decomposer_ = new ims::RealMassDecomposer(weights);
+      return;
+    }
+
+    // the integer weights identify the table (they encode alphabet and precision), the file itself is validated on loading
+    UInt64 key = 14695981039346656037ULL; // FNV-1a
+    for (ims::Weights::size_type i = 0; i < weights.size(); ++i)
+    {
+      ims::Weights::weight_type w = weights.getWeight(i);
+      for (Size b = 0; b < sizeof(w); ++b)
+      {
+        key = (key ^ ((w >> (8 * b)) & 0xFF)) * 1099511628211ULL;
+      }
+    }
+    std::stringstream name;
+    name << "MassDecomposition_" << std::hex << key << ".ert";
+    String table_file = cache_dir.ensureLastChar('/') + String(name.str());
+    try
+    {
+      decomposer_ = new ims::RealMassDecomposer(weights, table_file);
+    }
+    catch (Exception::UnableToCreateFile&)
+    {
+      OPENMS_LOG_WARN << "MassDecompositionAlgorithm: Warning: cannot write decomposition table to '" << table_file << "', table is not cached!" << endl;
+      decomposer_ = new ims::RealMassDecomposer(weights);
+    }
 
     return;
   }
@@ -97,6 +97,11 @@ namespace OpenMS
 
   ModificationsDB::ModificationsDB(OpenMS::String unimod_file, OpenMS::String psimod_file, OpenMS::String xlmod_file)
   {
+    for (Size i = 0; i != ADDED_NAMES_FILTER_WORDS; ++i)
+    {
+      added_names_filter_[i].store(0, std::memory_order_relaxed);
+    }
+
     if (!unimod_file.empty())
     {
       readFromUnimodXMLFile(unimod_file);
@@ -138,56 +143,86 @@ namespace OpenMS
     return s;
   }
 
-  const ResidueModification* ModificationsDB::searchModificationsFast(const String& mod_name_,
+  const set<const ResidueModification*>* ModificationsDB::findModifications_(const String& mod_name, set<const ResidueModification*>& buffer) const
+  {
+    const set<const ResidueModification*>* mods(nullptr);
+    auto it = modification_names_.find(mod_name);
+    if (it != modification_names_.end()) mods = &it->second;
+
+    // names that were never passed to addModification() are completely
+    // described by the constant index and need no lock
+    const Size hash = std::hash<std::string>()(mod_name);
+    const UInt64 bit = UInt64(1) << (hash % 64);
+    if ((added_names_filter_[(hash / 64) % ADDED_NAMES_FILTER_WORDS].load(std::memory_order_acquire) & bit) == 0)
+    {
+      return mods;
+    }
+
+    bool found(false);
+    #pragma omp critical(OpenMS_ModificationsDB)
+    {
+      auto added = added_modification_names_.find(mod_name);
+      if (added != added_modification_names_.end())
+      {
+        buffer = added->second;
+        found = true;
+      }
+    }
+    if (!found) return mods;
+
+    if (mods != nullptr) buffer.insert(mods->begin(), mods->end());
+    return &buffer;
+  }
+
+  void ModificationsDB::addModificationName_(const String& name, const ResidueModification* mod)
+  {
+    added_modification_names_[name].insert(mod);
+    const Size hash = std::hash<std::string>()(name);
+    added_names_filter_[(hash / 64) % ADDED_NAMES_FILTER_WORDS].fetch_or(UInt64(1) << (hash % 64), std::memory_order_release);
+  }
+
+  const ResidueModification* ModificationsDB::searchModificationsFast(const String& mod_name,
                                                                       bool& multiple_matches,
                                                                       const String& residue,
                                                                       ResidueModification::TermSpecificity term_spec
                                                                       ) const
   {
     const ResidueModification* mod(nullptr);
-
-    String mod_name = mod_name_;
     multiple_matches = false;
 
     char res = '?'; // empty
     if (!residue.empty()) res = residue[0];
 
-    #pragma omp critical(OpenMS_ModificationsDB)
+    set<const ResidueModification*> buffer;
+    const set<const ResidueModification*>* modifications = findModifications_(mod_name, buffer);
+    if (modifications == nullptr)
     {
-      bool found = true;
-      auto modifications = modification_names_.find(mod_name);
-      if (modifications == modification_names_.end())
+      // Try to fix things, Skyline for example uses unimod:10 and not UniMod:10 syntax
+      String fixed_name = mod_name;
+      if (mod_name.size() > 6 && mod_name.prefix(6).toLower() == "unimod")
       {
-        // Try to fix things, Skyline for example uses unimod:10 and not UniMod:10 syntax
-        if (mod_name.size() > 6 && mod_name.prefix(6).toLower() == "unimod")
-        {
-          mod_name = "UniMod" + mod_name.substr(6, mod_name.size() - 6);
-        }
-
-        modifications = modification_names_.find(mod_name);
-        if (modifications == modification_names_.end())
-        {
-          OPENMS_LOG_WARN << OPENMS_PRETTY_FUNCTION << "Modification not found: " << mod_name << endl;
-          found = false; 
-        }
+        fixed_name = "UniMod" + mod_name.substr(6, mod_name.size() - 6);
+        modifications = findModifications_(fixed_name, buffer);
       }
+      if (modifications == nullptr)
+      {
+        OPENMS_LOG_WARN << OPENMS_PRETTY_FUNCTION << "Modification not found: " << fixed_name << endl;
+        return mod;
+      }
+    }
 
-      int nr_mods = 0;
-      if (found)
+    int nr_mods = 0;
+    for (const auto& it : *modifications)
+    {
+      if ( residuesMatch_(res, it) &&
+           (term_spec == ResidueModification::NUMBER_OF_TERM_SPECIFICITY ||
+           (term_spec == it->getTermSpecificity())))
       {
-        for (const auto& it : modifications->second)
-        {
-          if ( residuesMatch_(res, it) &&
-               (term_spec == ResidueModification::NUMBER_OF_TERM_SPECIFICITY ||
-               (term_spec == it->getTermSpecificity())))
-          {
-            mod = it;
-            nr_mods++;
-          }
-        }
+        mod = it;
+        nr_mods++;
       }
-      if (nr_mods > 1) multiple_matches = true;
     }
+    if (nr_mods > 1) multiple_matches = true;
     return mod;
   }
 
@@ -198,50 +233,42 @@ namespace OpenMS
   }
 
   void ModificationsDB::searchModifications(set<const ResidueModification*>& mods,
-                                            const String& mod_name_,
+                                            const String& mod_name,
                                             const String& residue,
                                             ResidueModification::TermSpecificity term_spec) const
   {
     mods.clear();
 
-    String mod_name = mod_name_;
-
     char res = '?'; // empty
     if (!residue.empty()) res = residue[0];
 
-    #pragma omp critical(OpenMS_ModificationsDB)
+    set<const ResidueModification*> buffer;
+    const set<const ResidueModification*>* modifications = findModifications_(mod_name, buffer);
+    if (modifications == nullptr)
     {
-      bool found = true;
-      auto modifications = modification_names_.find(mod_name);
-      if (modifications == modification_names_.end())
+      // Try to fix things, Skyline for example uses unimod:10 and not UniMod:10 syntax
+      String fixed_name = mod_name;
+      if (mod_name.size() > 6 && mod_name.prefix(6).toLower() == "unimod")
       {
-        // Try to fix things, Skyline for example uses unimod:10 and not UniMod:10 syntax
-        if (mod_name.size() > 6 && mod_name.prefix(6).toLower() == "unimod")
-        {
-          mod_name = "UniMod" + mod_name.substr(6, mod_name.size() - 6);
-        }
-
-        modifications = modification_names_.find(mod_name);
-        if (modifications == modification_names_.end())
-        {
-          OPENMS_LOG_WARN << OPENMS_PRETTY_FUNCTION << "Modification not found: " << mod_name << endl;
-          found = false; 
-        }
+        fixed_name = "UniMod" + mod_name.substr(6, mod_name.size() - 6);
+        modifications = findModifications_(fixed_name, buffer);
       }
+      if (modifications == nullptr)
+      {
+        OPENMS_LOG_WARN << OPENMS_PRETTY_FUNCTION << "Modification not found: " << fixed_name << endl;
+        return;
+      }
+    }
 
-      if (found)
+    for (const auto& it : *modifications)
+    {
+      if ( residuesMatch_(res, it) &&
+           (term_spec == ResidueModification::NUMBER_OF_TERM_SPECIFICITY ||
+           (term_spec == it->getTermSpecificity())))
       {
-        for (const auto& it : modifications->second)
-        {
-          if ( residuesMatch_(res, it) &&
-               (term_spec == ResidueModification::NUMBER_OF_TERM_SPECIFICITY ||
-               (term_spec == it->getTermSpecificity())))
-          {
-            mods.insert(it);
-          }
-        }
+        mods.insert(it);
       }
-    } 
+    }
   }
 
   const ResidueModification* ModificationsDB::getModification(const String& mod_name, const String& residue, ResidueModification::TermSpecificity term_spec) const
@@ -279,38 +306,27 @@ namespace OpenMS
 
   bool ModificationsDB::has(String modification) const
   {
-    bool has_mod;
-    #pragma omp critical(OpenMS_ModificationsDB)
-    {
-      has_mod = (modification_names_.find(modification) != modification_names_.end());
-    }
-    return has_mod;
+    set<const ResidueModification*> buffer;
+    return findModifications_(modification, buffer) != nullptr;
   }
 
   Size ModificationsDB::findModificationIndex(const String & mod_name) const
   {
-    if (!has(mod_name))
+    set<const ResidueModification*> buffer;
+    const set<const ResidueModification*>* modifications = findModifications_(mod_name, buffer);
+    if (modifications == nullptr)
     {
       throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Modification not found: " + mod_name);
     }
-
-    bool one_mod(true);
-    #pragma omp critical(OpenMS_ModificationsDB)
-    {
-      if (modification_names_.find(mod_name)->second.size() > 1)
-      {
-        one_mod = false;
-      }
-    }
-    if (!one_mod) 
+    if (modifications->size() > 1)
     {
       throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "More than one modification with name: " + mod_name);
     }
 
+    const ResidueModification* mod = *modifications->begin();
     Size index(numeric_limits<Size>::max());
     #pragma omp critical(OpenMS_ModificationsDB)
     {
-      const ResidueModification* mod = *(modification_names_.find(mod_name)->second.begin());
       for (Size i = 0; i != mods_.size(); ++i)
       {
         if (mods_[i] == mod)
@@ -412,10 +428,11 @@ namespace OpenMS
 
     #pragma omp critical(OpenMS_ModificationsDB)
     {
-      modification_names_[new_mod->getFullId()].insert(new_mod);
-      modification_names_[new_mod->getId()].insert(new_mod);
-      modification_names_[new_mod->getFullName()].insert(new_mod);
-      modification_names_[new_mod->getUniModAccession()].insert(new_mod);
+      // readers access modification_names_ without locking, so new names go into a separate index
+      addModificationName_(new_mod->getFullId(), new_mod);
+      addModificationName_(new_mod->getId(), new_mod);
+      addModificationName_(new_mod->getFullName(), new_mod);
+      addModificationName_(new_mod->getUniModAccession(), new_mod);
       mods_.push_back(new_mod); // we probably want that
     }
   }
@@ -193,8 +193,10 @@ namespace OpenMS
 
 
   MSSpectrum NucleicAcidSpectrumGenerator::getUnchargedSpectrum_(
-    const NASequence& oligo) const
+    const NASequence& oligo,
+    vector<pair<FragmentLadder::Source, Size>>* sources) const
   {
+    typedef FragmentLadder::Source Source;
     static const double H_mass = EmpiricalFormula("H").getMonoWeight();
     // phosphate minus water:
     static const double backbone_mass =
@@ -233,6 +235,20 @@ namespace OpenMS
     spectrum.getStringDataArrays().resize(1);
     spectrum.getStringDataArrays()[0].setName("IonNames");
 
+    // origin of the peaks added last (only if requested):
+    auto record = [&](Source source, Size first, Size last)
+    {
+      if (sources == nullptr) return;
+      for (Size i = first; i < last; ++i)
+      {
+        sources->emplace_back(source, i);
+        if ((source == Source::A_MINUS_B) && oligo[i]->isAmbiguous())
+        {
+          sources->emplace_back(source, i); // two peaks
+        }
+      }
+    };
+
     vector<double> fragments_left, fragments_right;
     Size start = add_first_prefix_ion_ ? 0 : 1;
     if ((add_a_ions_ || add_b_ions_ || add_c_ions_ || add_d_ions_ ||
@@ -249,25 +265,30 @@ namespace OpenMS
       {
         addFragmentPeaks_(spectrum, fragments_left, "a", a_ion_offset,
                           a_intensity_, start);
+        record(Source::PREFIX, start, fragments_left.size());
       }
       if (add_b_ions_)
       {
         addFragmentPeaks_(spectrum, fragments_left, "b", b_ion_offset,
                           b_intensity_, start);
+        record(Source::PREFIX, start, fragments_left.size());
       }
       if (add_c_ions_)
       {
         addFragmentPeaks_(spectrum, fragments_left, "c", c_ion_offset,
                           c_intensity_, start);
+        record(Source::PREFIX, start, fragments_left.size());
       }
       if (add_d_ions_)
       {
         addFragmentPeaks_(spectrum, fragments_left, "d", d_ion_offset,
                           d_intensity_, start);
+        record(Source::PREFIX, start, fragments_left.size());
       }
       if (add_aB_ions_) // special case
       {
         addAMinusBPeaks_(spectrum, fragments_left, oligo, start);
+        record(Source::A_MINUS_B, start, fragments_left.size());
       }
     }
 
@@ -286,21 +307,25 @@ namespace OpenMS
       {
         addFragmentPeaks_(spectrum, fragments_right, "w", w_ion_offset,
                           w_intensity_);
+        record(Source::SUFFIX, 0, fragments_right.size());
       }
       if (add_x_ions_)
       {
         addFragmentPeaks_(spectrum, fragments_right, "x", x_ion_offset,
                           x_intensity_);
+        record(Source::SUFFIX, 0, fragments_right.size());
       }
       if (add_y_ions_)
       {
         addFragmentPeaks_(spectrum, fragments_right, "y", y_ion_offset,
                           y_intensity_);
+        record(Source::SUFFIX, 0, fragments_right.size());
       }
       if (add_z_ions_)
       {
         addFragmentPeaks_(spectrum, fragments_right, "z", z_ion_offset,
                           z_intensity_);
+        record(Source::SUFFIX, 0, fragments_right.size());
       }
     }
 
@@ -328,6 +353,8 @@ namespace OpenMS
         peak.setMZ(oligo.getMonoWeight(NASequence::Full, 0));
       }
       spectrum.push_back(peak);
+      // index 1: mass not derived from the fragments
+      if (sources) sources->emplace_back(Source::PRECURSOR, (have_left || have_right) ? 0 : 1);
       if (add_metainfo_)
       {
         spectrum.getStringDataArrays()[0].push_back("M");
@@ -416,6 +443,117 @@ namespace OpenMS
   {
     spectra.clear();
     if (charges.empty()) return;
+    addChargedSpectra_(spectra, getUnchargedSpectrum_(oligo), charges, base_charge);
+  }
+
+
+  void NucleicAcidSpectrumGenerator::getMultipleSpectra(map<Int, MSSpectrum>& spectra, const FragmentLadder& ladder, const NASequence& oligo, const set<Int>& charges, Int base_charge) const
+  {
+    spectra.clear();
+    if (charges.empty()) return;
+    addChargedSpectra_(spectra, deriveUnchargedSpectrum_(ladder, oligo), charges, base_charge);
+  }
+
+
+  NucleicAcidSpectrumGenerator::FragmentLadder NucleicAcidSpectrumGenerator::getLadder(const NASequence& oligo) const
+  {
+    FragmentLadder ladder;
+    ladder.uncharged = getUnchargedSpectrum_(oligo, &ladder.sources);
+    ladder.ribos.resize(oligo.size());
+    for (Size i = 0; i < oligo.size(); ++i)
+    {
+      ladder.ribos[i] = oligo[i];
+    }
+    ladder.five_prime = oligo.getFivePrimeMod();
+    ladder.three_prime = oligo.getThreePrimeMod();
+    return ladder;
+  }
+
+
+  MSSpectrum NucleicAcidSpectrumGenerator::deriveUnchargedSpectrum_(const FragmentLadder& ladder, const NASequence& oligo) const
+  {
+    typedef FragmentLadder::Source Source;
+    static const double H_mass = EmpiricalFormula("H").getMonoWeight();
+
+    const Size n = oligo.size();
+    if ((n != ladder.ribos.size()) || (ladder.sources.size() != ladder.uncharged.size()))
+    {
+      return getUnchargedSpectrum_(oligo);
+    }
+
+    // mass differences of the positions and chain ends:
+    auto end_mass = [](const RibonucleotideChainEnd* mod)
+    {
+      return (mod == nullptr) ? 0.0 : mod->getMonoMass() - H_mass;
+    };
+    const double five_prime_delta = end_mass(oligo.getFivePrimeMod()) - end_mass(ladder.five_prime);
+    const double three_prime_delta = end_mass(oligo.getThreePrimeMod()) - end_mass(ladder.three_prime);
+    vector<double> ribo_delta(n, 0.0), base_loss_delta(n, 0.0);
+    bool changed = (five_prime_delta != 0.0) || (three_prime_delta != 0.0);
+    for (Size i = 0; i < n; ++i)
+    {
+      const Ribonucleotide* ribo = oligo[i];
+      const Ribonucleotide* ladder_ribo = ladder.ribos[i];
+      if (ribo == ladder_ribo) continue;
+      if (add_aB_ions_ && (ribo->isAmbiguous() != ladder_ribo->isAmbiguous()))
+      {
+        return getUnchargedSpectrum_(oligo); // different number of a-B peaks
+      }
+      ribo_delta[i] = ribo->getMonoMass() - ladder_ribo->getMonoMass();
+      if (add_aB_ions_)
+      {
+        base_loss_delta[i] = ribo->getBaselossFormula().getMonoWeight() -
+          ladder_ribo->getBaselossFormula().getMonoWeight();
+      }
+      changed = true;
+    }
+
+    MSSpectrum spectrum = ladder.uncharged;
+    if (!changed || n == 0) return spectrum;
+
+    // shifts of the prefix/suffix fragments (see "getUnchargedSpectrum_"):
+    vector<double> prefix_delta(n), suffix_delta(n);
+    prefix_delta[0] = five_prime_delta + ribo_delta[0];
+    suffix_delta[0] = three_prime_delta + ribo_delta[n - 1];
+    for (Size i = 1; i < n; ++i)
+    {
+      prefix_delta[i] = prefix_delta[i - 1] + ribo_delta[i];
+      suffix_delta[i] = suffix_delta[i - 1] + ribo_delta[n - i - 1];
+    }
+
+    for (Size i = 0; i < spectrum.size(); ++i)
+    {
+      const Size index = ladder.sources[i].second;
+      Peak1D& peak = spectrum[i];
+      switch (ladder.sources[i].first)
+      {
+        case Source::PREFIX:
+          peak.setMZ(peak.getMZ() + prefix_delta[index]);
+          break;
+        case Source::SUFFIX:
+          peak.setMZ(peak.getMZ() + suffix_delta[index]);
+          break;
+        case Source::A_MINUS_B: // the first a-B ion does not contain the 5' end
+          peak.setMZ(peak.getMZ() + base_loss_delta[index] + (index > 0 ? prefix_delta[index - 1] : 0.0));
+          break;
+        case Source::PRECURSOR:
+          if (index == 0)
+          {
+            peak.setMZ(peak.getMZ() + prefix_delta[n - 1] + three_prime_delta);
+          }
+          else
+          {
+            peak.setMZ(oligo.getMonoWeight(NASequence::Full, 0));
+          }
+          break;
+      }
+    }
+    return spectrum;
+  }
+
+
+  void NucleicAcidSpectrumGenerator::addChargedSpectra_(map<Int, MSSpectrum>& spectra, const MSSpectrum& uncharged_spectrum, const set<Int>& charges, Int base_charge) const
+  {
     bool negative_mode = *charges.begin() < 0;
     bool add_all_precursors = (add_precursor_peaks_ &&
                                add_all_precursor_charges_);
@@ -434,8 +572,6 @@ namespace OpenMS
       }
     }
 
-    MSSpectrum uncharged_spectrum = getUnchargedSpectrum_(oligo);
-
     if (negative_mode)
     {
       if (base_charge > 0) base_charge = -base_charge;
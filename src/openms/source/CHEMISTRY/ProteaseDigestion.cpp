@@ -47,8 +47,7 @@ namespace OpenMS
 {
   void ProteaseDigestion::setEnzyme(const String& enzyme_name)
   {
-    enzyme_ = ProteaseDB::getInstance()->getEnzyme(enzyme_name);
-    re_ = boost::regex(enzyme_->getRegEx());
+    compileEnzyme_(ProteaseDB::getInstance()->getEnzyme(enzyme_name));
   }
 
   bool ProteaseDigestion::isValidProduct(const String& protein,
@@ -51,7 +51,8 @@ using namespace std;
 
 namespace OpenMS
 {
-  ResidueDB::ResidueDB()
+  ResidueDB::ResidueDB() :
+    modified_residue_index_(nullptr)
   {
     readResiduesFromFile_("CHEMISTRY/Residues.xml");
     buildResidueNames_();
@@ -66,6 +67,7 @@ namespace OpenMS
   ResidueDB::~ResidueDB()
   {
     clear_();
+    for (auto& index : modified_residue_indices_) { delete index; }
   }
 
   const Residue* ResidueDB::getResidue(const String& name) const
@@ -75,17 +77,13 @@ namespace OpenMS
       throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "No residue specified.", "");
     }
 
-    Residue* r(nullptr);
-    #pragma omp critical (ResidueDB)
-    {   
-      auto it = residue_names_.find(name);
-      if (it != residue_names_.end()) r = it->second;
-    }
-    if (r == nullptr)
+    // no lock required here because the names of unmodified residues are only set in the constructor
+    auto it = residue_names_.find(name);
+    if (it == residue_names_.end())
     {
       throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Residue not found: ", name);
     }
-    return r;
+    return it->second;
   }
 
   const Residue* ResidueDB::getResidue(const unsigned char& one_letter_code) const
@@ -166,6 +164,7 @@ namespace OpenMS
       }
       residues_.insert(r);
       const_residues_.insert(r);
+      buildResidueNames_();
     }
     else
     {
@@ -195,28 +194,25 @@ namespace OpenMS
         }
       }
     }
-    buildResidueNames_();
     return;
   }
 
   bool ResidueDB::hasResidue(const String& res_name) const
   {
-    bool found = false;
-    #pragma omp critical (ResidueDB)
-    {
-      found = residue_names_.find(res_name) != residue_names_.end();
-    }  
-    return found;
+    return residue_names_.find(res_name) != residue_names_.end();
   }
 
   bool ResidueDB::hasResidue(const Residue* residue) const
   {
-    bool found = false;
+    if (const_residues_.find(residue) != const_residues_.end()) return true;
+    const ModifiedResidueIndex_* index = modified_residue_index_.load(std::memory_order_acquire);
+    if (index->residues.find(residue) != index->residues.end()) return true;
+
+    bool found(false);
     #pragma omp critical (ResidueDB)
     {
-      found = (const_residues_.find(residue) != const_residues_.end() ||
-          const_modified_residues_.find(residue) != const_modified_residues_.end());
-    } 
+      found = recent_modified_residues_.residues.find(residue) != recent_modified_residues_.residues.end();
+    }
     return found;
   }
 
@@ -305,6 +301,46 @@ namespace OpenMS
     modified_residues_.clear();
     residue_mod_names_.clear();
     const_modified_residues_.clear();
+
+    for (auto& index : modified_residue_indices_) { delete index; }
+    modified_residue_indices_.clear();
+    modified_residue_indices_.push_back(new ModifiedResidueIndex_());
+    modified_residue_index_.store(modified_residue_indices_.back(), std::memory_order_release);
+    recent_modified_residues_ = ModifiedResidueIndex_();
+  }
+
+  const Residue* ResidueDB::ModifiedResidueIndex_::find(const String& residue_name, const String& modification) const
+  {
+    const auto& by_residue = by_name.find(residue_name);
+    if (by_residue == by_name.end()) return nullptr;
+    const auto& by_mod = by_residue->second.find(modification);
+    return by_mod == by_residue->second.end() ? nullptr : by_mod->second;
+  }
+
+  void ResidueDB::publishModifiedResidue_(const String& residue_name, const String& modification, const Residue* residue)
+  {
+    recent_modified_residues_.by_name[residue_name][modification] = residue;
+    recent_modified_residues_.residues.insert(residue);
+    ++recent_modified_residues_.size;
+
+    // merge only once the recent entries are as many as the immutable ones: every entry is
+    // copied O(1) times on average and all indices together are at most twice the final one
+    const Size min_merge_size = 16;
+    const ModifiedResidueIndex_* current = modified_residue_index_.load(std::memory_order_relaxed);
+    if (recent_modified_residues_.size < std::max(min_merge_size, current->size)) return;
+
+    ModifiedResidueIndex_* index = new ModifiedResidueIndex_(*current);
+    for (const auto& by_residue : recent_modified_residues_.by_name)
+    {
+      auto& target = index->by_name[by_residue.first];
+      target.insert(by_residue.second.begin(), by_residue.second.end());
+    }
+    index->residues.insert(recent_modified_residues_.residues.begin(), recent_modified_residues_.residues.end());
+    index->size = current->size + recent_modified_residues_.size;
+    modified_residue_indices_.push_back(index);
+    // readers that load the new index also see the fully constructed residues
+    modified_residue_index_.store(index, std::memory_order_release);
+    recent_modified_residues_ = ModifiedResidueIndex_();
   }
 
   Residue* ResidueDB::parseResidue_(Map<String, String>& values)
@@ -510,10 +546,18 @@ namespace OpenMS
     OPENMS_PRECONDITION(!modification.empty(), "Modification cannot be empty")
     // search if the mod already exists
     const String & res_name = residue->getName();
-    Residue* res(nullptr);
+
+    // fast path without locking: this residue was requested with the same modification name before
+    const Residue* res = modified_residue_index_.load(std::memory_order_acquire)->find(res_name, modification);
+    if (res != nullptr) return res;
+
     bool residue_found(true), mod_found(true);
     #pragma omp critical (ResidueDB)
     {
+      // another thread may have registered it in the meantime (possibly merged into a new immutable index)
+      res = recent_modified_residues_.find(res_name, modification);
+      if (res == nullptr) res = modified_residue_index_.load(std::memory_order_relaxed)->find(res_name, modification);
+
       // Perform a single lookup of the residue name in our database, we assume
       // that if it is present in residue_mod_names_ then we have seen it
       // before and can directly grab it. If its not present, we may have as
@@ -529,7 +573,7 @@ namespace OpenMS
         }
       }
 
-      if (residue_found)
+      if (residue_found && res == nullptr)
       {
         const ResidueModification* mod;
         try
@@ -562,10 +606,12 @@ namespace OpenMS
           if (!found)
           {
             // create and register this modified residue
-            res = new Residue(*residue_names_[res_name]);
-            res->setModification_(*mod);
-            addResidue_(res);
+            Residue* new_res = new Residue(*residue_names_[res_name]);
+            new_res->setModification_(*mod);
+            addResidue_(new_res);
+            res = new_res;
           }
+          publishModifiedResidue_(res_name, modification, res);
         }
       }
     }
@@ -0,0 +1,194 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CHEMISTRY/ResidueMassTable.h>
+
+#include <OpenMS/CHEMISTRY/Residue.h>
+#include <OpenMS/CHEMISTRY/ResidueDB.h>
+#include <OpenMS/CHEMISTRY/ResidueModification.h>
+#include <OpenMS/CONCEPT/Exception.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+namespace OpenMS
+{
+  ResidueMassTable::ResidueMassTable()
+  {
+    ResidueDB* rdb = ResidueDB::getInstance();
+    const double water = Residue::getInternalToFull().getMonoWeight();
+    static const Residue* rx = rdb->getResidue("X");
+
+    for (Size i = 0; i != 256; ++i)
+    {
+      // AASequence::getMonoWeight() refuses residue X as its mass is unknown
+      const Residue* r = rdb->getResidue(static_cast<unsigned char>(i));
+      residue_masses_[i] = (r == nullptr || r == rx) ? numeric_limits<double>::quiet_NaN() : r->getMonoWeight(Residue::Internal);
+      n_terminal_masses_[i] = water;
+      c_terminal_masses_[i] = 0.0;
+    }
+  }
+
+  ResidueMassTable::ResidueMassTable(const vector<const ResidueModification*>& fixed_modifications) :
+    ResidueMassTable()
+  {
+    ResidueDB* rdb = ResidueDB::getInstance();
+    const double water = Residue::getInternalToFull().getMonoWeight();
+
+    // the first terminal modification without residue check is set for all peptides ...
+    bool n_term_set(false), c_term_set(false);
+    for (const ResidueModification* f : fixed_modifications)
+    {
+      if (f->getTermSpecificity() == ResidueModification::N_TERM && !n_term_set)
+      {
+        fill(n_terminal_masses_, n_terminal_masses_ + 256, water + f->getDiffMonoMass());
+        n_term_set = true;
+      }
+      else if (f->getTermSpecificity() == ResidueModification::C_TERM && !c_term_set)
+      {
+        fill(c_terminal_masses_, c_terminal_masses_ + 256, f->getDiffMonoMass());
+        c_term_set = true;
+      }
+    }
+
+    // ... and overwritten by the last one matching the terminal residue, residue modifications are applied in order (last one wins)
+    for (const ResidueModification* f : fixed_modifications)
+    {
+      const unsigned char origin = static_cast<unsigned char>(f->getOrigin());
+      if (std::isnan(residue_masses_[origin])) { continue; }
+
+      switch (f->getTermSpecificity())
+      {
+        case ResidueModification::ANYWHERE:
+          residue_masses_[origin] = rdb->getModifiedResidue(rdb->getResidue(origin), f->getFullId())->getMonoWeight(Residue::Internal);
+          break;
+
+        case ResidueModification::N_TERM:
+          n_terminal_masses_[origin] = water + f->getDiffMonoMass();
+          break;
+
+        case ResidueModification::C_TERM:
+          c_terminal_masses_[origin] = f->getDiffMonoMass();
+          break;
+
+        default:
+          break;
+      }
+    }
+  }
+
+  double ResidueMassTable::getMonoWeight(const StringView& sequence) const
+  {
+    if (sequence.size() == 0)
+    {
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Cannot compute the mass of an empty sequence.", "");
+    }
+
+    double mass = getTerminalMass(sequence[0], sequence[sequence.size() - 1]);
+    for (Size i = 0; i != sequence.size(); ++i)
+    {
+      mass += getResidueMass(sequence[i]);
+    }
+
+    if (std::isnan(mass))
+    {
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Sequence contains a residue without mass.", sequence.getString());
+    }
+    return mass;
+  }
+
+  void ResidueMassTable::getPrefixMonoWeights(const StringView& sequence, vector<double>& masses) const
+  {
+    masses.resize(sequence.size());
+
+    double residue_sum(0);
+    for (Size i = 0; i != sequence.size(); ++i)
+    {
+      residue_sum += getResidueMass(sequence[i]);
+      masses[i] = residue_sum + getTerminalMass(sequence[0], sequence[i]);
+    }
+  }
+
+  void ResidueMassTable::getVariableModificationShiftRange(const vector<const ResidueModification*>& variable_modifications,
+                                                           Size max_mods,
+                                                           double& min_shift,
+                                                           double& max_shift) const
+  {
+    ResidueDB* rdb = ResidueDB::getInstance();
+    const double water = Residue::getInternalToFull().getMonoWeight();
+
+    // largest and smallest shift of a single modification
+    double min_single(0), max_single(0);
+    for (const ResidueModification* v : variable_modifications)
+    {
+      const unsigned char origin = static_cast<unsigned char>(v->getOrigin());
+      switch (v->getTermSpecificity())
+      {
+        case ResidueModification::ANYWHERE:
+        {
+          const Residue* unmodified = rdb->getResidue(origin);
+          if (unmodified == nullptr) { break; }
+          const double shift = rdb->getModifiedResidue(unmodified, v->getFullId())->getMonoWeight(Residue::Internal) - unmodified->getMonoWeight(Residue::Internal);
+          min_single = min(min_single, shift);
+          max_single = max(max_single, shift);
+          break;
+        }
+
+        case ResidueModification::N_TERM:
+        case ResidueModification::C_TERM:
+        {
+          // a terminal modification may replace a fixed one
+          const double* fixed = v->getTermSpecificity() == ResidueModification::N_TERM ? n_terminal_masses_ : c_terminal_masses_;
+          const double offset = v->getTermSpecificity() == ResidueModification::N_TERM ? water : 0.0;
+          for (Size i = 0; i != 256; ++i)
+          {
+            const double shift = v->getDiffMonoMass() - (fixed[i] - offset);
+            min_single = min(min_single, shift);
+            max_single = max(max_single, shift);
+          }
+          break;
+        }
+
+        default:
+          break;
+      }
+    }
+
+    min_shift = min_single * max_mods;
+    max_shift = max_single * max_mods;
+  }
+}
@@ -219,6 +219,150 @@ namespace OpenMS
   }
 
 
+  namespace
+  {
+    /// position in a prefix or suffix ion series, which is generated in ascending m/z order
+    struct IonSeriesCursor_
+    {
+      double mass; ///< protons, terminal modification and all residues of the current ion
+      double ion_offset; ///< internal to ion type mass offset
+      double charge;
+      SignedSize next; ///< index of the residue added by the next ion
+      SignedSize step; ///< +1 for prefix ions, -1 for suffix ions
+      Size remaining; ///< number of ions left (including the current one)
+      char ion_type;
+
+      double mz() const
+      {
+        return (mass + ion_offset) / charge;
+      }
+    };
+  }
+
+  void TheoreticalSpectrumGenerator::getIonSeries(std::vector<double>& mz, std::vector<char>& ion_types, const AASequence& peptide, Int min_charge, Int max_charge) const
+  {
+    getIonSeries_(mz, &ion_types, peptide, min_charge, max_charge);
+  }
+
+  void TheoreticalSpectrumGenerator::getIonSeries(std::vector<double>& mz, const AASequence& peptide, Int min_charge, Int max_charge) const
+  {
+    getIonSeries_(mz, nullptr, peptide, min_charge, max_charge);
+  }
+
+  void TheoreticalSpectrumGenerator::getIonSeries_(std::vector<double>& mz, std::vector<char>* ion_types, const AASequence& peptide, Int min_charge, Int max_charge) const
+  {
+    mz.clear();
+    if (ion_types) ion_types->clear();
+    if (peptide.empty()) return;
+
+    const SignedSize n = peptide.size();
+    if ((add_c_ions_ || add_x_ions_) && n < 2)
+    {
+      throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 1);
+    }
+
+    static const double stat_a = Residue::getInternalToAIon().getMonoWeight();
+    static const double stat_b = Residue::getInternalToBIon().getMonoWeight();
+    static const double stat_c = Residue::getInternalToCIon().getMonoWeight();
+    static const double stat_x = Residue::getInternalToXIon().getMonoWeight();
+    static const double stat_y = Residue::getInternalToYIon().getMonoWeight();
+    static const double stat_z = Residue::getInternalToZIon().getMonoWeight();
+
+    const double n_term_mod = peptide.hasNTerminalModification() ? peptide.getNTerminalModification()->getDiffMonoMass() : 0.0;
+    const double c_term_mod = peptide.hasCTerminalModification() ? peptide.getCTerminalModification()->getDiffMonoMass() : 0.0;
+
+    // one cursor per ion series, in the same order as the chunks of getSpectrum() (equal m/z values keep that order)
+    const Size max_series = 32;
+    IonSeriesCursor_ cursors[max_series];
+    Size nr_series = 0;
+    Size nr_ions = 0;
+
+    auto addSeries = [&](bool prefix, double ion_offset, char ion_type, Int charge)
+    {
+      if (nr_series == max_series)
+      {
+        throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Too many ion series (ion types times charges) requested.");
+      }
+      IonSeriesCursor_& c = cursors[nr_series];
+      c.mass = Constants::PROTON_MASS_U * charge;
+      c.ion_offset = ion_offset;
+      c.charge = charge;
+      c.ion_type = ion_type;
+      if (prefix)
+      {
+        c.mass += n_term_mod;
+        c.step = 1;
+        c.next = 0;
+        if (!add_first_prefix_ion_)
+        {
+          c.mass += peptide[0].getMonoWeight(Residue::Internal);
+          c.next = 1;
+        }
+        // the full peptide is not a fragment ion
+        c.remaining = std::max(SignedSize(0), n - 1 - c.next);
+      }
+      else
+      {
+        c.mass += c_term_mod;
+        c.step = -1;
+        c.next = n - 1;
+        c.remaining = n - 1;
+      }
+      if (c.remaining == 0) return;
+
+      // move to the first ion
+      c.mass += peptide[c.next].getMonoWeight(Residue::Internal);
+      c.next += c.step;
+      nr_ions += c.remaining;
+      ++nr_series;
+    };
+
+    for (Int z = min_charge; z <= max_charge; ++z)
+    {
+      if (add_b_ions_) addSeries(true, stat_b, 'b', z);
+      if (add_y_ions_) addSeries(false, stat_y, 'y', z);
+      if (add_a_ions_) addSeries(true, stat_a, 'a', z);
+      if (add_c_ions_) addSeries(true, stat_c, 'c', z);
+      if (add_x_ions_) addSeries(false, stat_x, 'x', z);
+      if (add_z_ions_) addSeries(false, stat_z, 'z', z);
+    }
+
+    mz.reserve(nr_ions);
+    if (ion_types) ion_types->reserve(nr_ions);
+
+    // k-way merge of the (individually sorted) series
+    while (nr_series > 0)
+    {
+      Size best = 0;
+      double best_mz = cursors[0].mz();
+      for (Size i = 1; i < nr_series; ++i)
+      {
+        const double current_mz = cursors[i].mz();
+        if (current_mz < best_mz)
+        {
+          best = i;
+          best_mz = current_mz;
+        }
+      }
+
+      mz.push_back(best_mz);
+      IonSeriesCursor_& c = cursors[best];
+      if (ion_types) ion_types->push_back(c.ion_type);
+
+      if (--c.remaining == 0)
+      {
+        // remove exhausted series while keeping the order of the others
+        std::copy(cursors + best + 1, cursors + nr_series, cursors + best);
+        --nr_series;
+      }
+      else
+      {
+        c.mass += peptide[c.next].getMonoWeight(Residue::Internal);
+        c.next += c.step;
+      }
+    }
+  }
+
   void TheoreticalSpectrumGenerator::addAbundantImmoniumIons_(PeakSpectrum& spectrum, const AASequence& peptide, DataArrays::StringDataArray& ion_names, DataArrays::IntegerDataArray& charges) const
   {
     // Proline immonium ion (C4H8N)
@@ -25,6 +25,7 @@ ProteaseDB.cpp
 ProteaseDigestion.cpp
 Residue.cpp
 ResidueDB.cpp
+ResidueMassTable.cpp
 ResidueModification.cpp
 RNaseDB.cpp
 RNaseDigestion.cpp
@@ -38,6 +38,10 @@
 #include <OpenMS/COMPARISON/CLUSTERING/CompleteLinkage.h>
 #include <OpenMS/COMPARISON/CLUSTERING/AverageLinkage.h>
 #include <OpenMS/CONCEPT/Factory.h>
+#include <OpenMS/CONCEPT/ProgressLogger.h>
+
+#include <algorithm>
+#include <limits>
 
 using namespace std;
 
@@ -67,6 +71,92 @@ namespace OpenMS
     Factory<ClusterFunctor>::registerProduct(AverageLinkage::getProductName(), &AverageLinkage::create);
   }
 
+  void ClusterFunctor::nearestNeighborChain_(DistanceMatrix<float> & original_distance, std::vector<BinaryTreeNode> & cluster_tree, const float threshold, LinkageUpdate update, const ProgressLogger & progress)
+  {
+    const Size n = original_distance.dimensionsize();
+    // input MUST have >= 2 elements!
+    if (n < 2)
+    {
+      throw ClusterFunctor::InsufficientInput(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Distance matrix to start from only contains one element");
+    }
+
+    // a cluster is identified by its lowest element index, merged clusters keep the lower one
+    vector<Size> cluster_size(n, 1);
+    vector<bool> active(n, true);
+    vector<BinaryTreeNode> merges;
+    merges.reserve(n - 1);
+    vector<Size> chain;
+    chain.reserve(n);
+    Size first_active = 0;
+
+    progress.startProgress(0, n - 1, "clustering data");
+    while (merges.size() < n - 1)
+    {
+      if (chain.empty())
+      {
+        while (!active[first_active]) ++first_active;
+        chain.push_back(first_active);
+      }
+      const Size a = chain.back();
+      const Size previous = chain.size() > 1 ? chain[chain.size() - 2] : n;
+
+      // nearest neighbour of a; on ties the previous chain element wins, so that the chain always ends
+      Size nearest = previous;
+      float nearest_distance = previous < n ? original_distance.getValue(a, previous) : numeric_limits<float>::max();
+      for (Size k = 0; k < n; ++k)
+      {
+        if (!active[k] || k == a) continue;
+        const float d = original_distance.getValue(a, k);
+        if (nearest == n || d < nearest_distance)
+        {
+          nearest = k;
+          nearest_distance = d;
+        }
+      }
+
+      if (nearest != previous)
+      {
+        chain.push_back(nearest);
+        continue;
+      }
+
+      // a and previous are reciprocal nearest neighbours: merge them
+      chain.pop_back();
+      chain.pop_back();
+      const Size i = min(a, previous), j = max(a, previous);
+      merges.emplace_back(i, j, nearest_distance);
+      for (Size k = 0; k < n; ++k)
+      {
+        if (!active[k] || k == i || k == j) continue;
+        original_distance.setValueQuick(i, k, update(original_distance.getValue(i, k), original_distance.getValue(j, k), cluster_size[i], cluster_size[j]));
+      }
+      cluster_size[i] += cluster_size[j];
+      active[j] = false;
+      progress.setProgress(merges.size());
+    }
+
+    // report the merges in the order of the closest-pair search (children are merged before their parents)
+    stable_sort(merges.begin(), merges.end(), [](const BinaryTreeNode & x, const BinaryTreeNode & y) { return x.distance < y.distance; });
+
+    cluster_tree.clear();
+    cluster_tree.reserve(n - 1);
+    vector<bool> merged(n, false);
+    for (const BinaryTreeNode & node : merges)
+    {
+      if (!(node.distance < threshold)) break;
+      cluster_tree.push_back(node);
+      merged[node.right_child] = true;
+    }
+
+    //fill tree with dummy nodes
+    for (Size k = 1; k < n && cluster_tree.size() < n - 1; ++k)
+    {
+      if (!merged[k]) cluster_tree.emplace_back(0, k, -1.0);
+    }
+
+    progress.endProgress();
+  }
+
   ClusterFunctor::InsufficientInput::InsufficientInput(const char * file, int line, const char * function, const char * message) throw() :
     BaseException(file, line, function, "ClusterFunctor::InsufficentInput", message)
   {
@@ -39,6 +39,26 @@ using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// number of bins filled in both vectors (merge over the sorted index arrays, no temporaries)
+    Size countSharedBins_(const BinnedSpectrum::SparseVectorType& a, const BinnedSpectrum::SparseVectorType& b)
+    {
+      const auto* ia = a.innerIndexPtr();
+      const auto* ib = b.innerIndexPtr();
+      const auto* const ea = ia + a.nonZeros();
+      const auto* const eb = ib + b.nonZeros();
+      Size shared(0);
+      while (ia != ea && ib != eb)
+      {
+        if (*ia < *ib) { ++ia; }
+        else if (*ib < *ia) { ++ib; }
+        else { ++shared; ++ia; ++ib; }
+      }
+      return shared;
+    }
+  }
+
   BinnedSharedPeakCount::BinnedSharedPeakCount() :
     BinnedSpectrumCompareFunctor()
   {
@@ -79,12 +99,19 @@ namespace OpenMS
 
     size_t denominator(max(spec1.getBins().nonZeros(), spec2.getBins().nonZeros()));
 
-    // Note: keep in single expression for faster computation via expression templates
-    // Calculate coefficient-wise product and count non-zero entries
-    BinnedSpectrum::SparseVectorType s = spec1.getBins().cwiseProduct(spec2.getBins());
-    
     // resulting score normalized to interval [0,1]
-    return static_cast<double>(s.nonZeros()) / denominator;
+    return static_cast<double>(countSharedBins_(spec1.getBins(), spec2.getBins())) / denominator;
+  }
+
+  void BinnedSharedPeakCount::compareBatch(const BinnedSpectrum& query, const std::vector<BinnedSpectrum>& targets, std::vector<double>& scores) const
+  {
+    scores.resize(targets.size());
+    for (Size i = 0; i < targets.size(); ++i)
+    {
+      OPENMS_PRECONDITION(BinnedSpectrum::isCompatible(query, targets[i]), "Binned spectra have different bin size or spread");
+      size_t denominator(max(query.getBins().nonZeros(), targets[i].getBins().nonZeros()));
+      scores[i] = static_cast<double>(countSharedBins_(query.getBins(), targets[i].getBins())) / denominator;
+    }
   }
 
 }
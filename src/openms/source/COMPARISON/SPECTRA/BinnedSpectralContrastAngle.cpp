@@ -85,5 +85,18 @@ namespace OpenMS
 
     return score;
   }
+
+  void BinnedSpectralContrastAngle::compareBatch(const BinnedSpectrum& query, const std::vector<BinnedSpectrum>& targets, std::vector<double>& scores) const
+  {
+    scores.resize(targets.size());
+    const double sum1 = query.getBins().dot(query.getBins());
+    for (Size i = 0; i < targets.size(); ++i)
+    {
+      OPENMS_PRECONDITION(BinnedSpectrum::isCompatible(query, targets[i]), "Binned spectra have different bin size or spread");
+      const double sum2 = targets[i].getBins().dot(targets[i].getBins());
+      const double numerator = query.getBins().dot(targets[i].getBins());
+      scores[i] = numerator / (sqrt(sum1 * sum2));
+    }
+  }
 }
 
@@ -67,6 +67,15 @@ namespace OpenMS
     return *this;
   }
 
+  void BinnedSpectrumCompareFunctor::compareBatch(const BinnedSpectrum& query, const std::vector<BinnedSpectrum>& targets, std::vector<double>& scores) const
+  {
+    scores.resize(targets.size());
+    for (Size i = 0; i < targets.size(); ++i)
+    {
+      scores[i] = operator()(query, targets[i]);
+    }
+  }
+
   void BinnedSpectrumCompareFunctor::registerChildren()
   {
     Factory<BinnedSpectrumCompareFunctor>::registerProduct(BinnedSharedPeakCount::getProductName(), &BinnedSharedPeakCount::create);
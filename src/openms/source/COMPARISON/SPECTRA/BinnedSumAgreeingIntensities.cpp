@@ -39,6 +39,37 @@ using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /**
+      Sum of max(0, mean(a,b) - |a-b|) over all bins. Bins filled in only one vector
+      never contribute (a/2 - |a| <= 0), so only the intersection of the sorted index
+      arrays is visited and no temporaries are created.
+    */
+    double sumAgreeing_(const BinnedSpectrum::SparseVectorType& a, const BinnedSpectrum::SparseVectorType& b)
+    {
+      const auto* ia = a.innerIndexPtr();
+      const auto* ib = b.innerIndexPtr();
+      const auto* const ea = ia + a.nonZeros();
+      const auto* const eb = ib + b.nonZeros();
+      const float* va = a.valuePtr();
+      const float* vb = b.valuePtr();
+      double sum_nn(0);
+      while (ia != ea && ib != eb)
+      {
+        if (*ia < *ib) { ++ia; ++va; }
+        else if (*ib < *ia) { ++ib; ++vb; }
+        else
+        {
+          const float x = (*va + *vb) * 0.5f - std::fabs(*va - *vb);
+          if (x > 0) sum_nn += x;
+          ++ia; ++va; ++ib; ++vb;
+        }
+      }
+      return sum_nn;
+    }
+  }
+
   BinnedSumAgreeingIntensities::BinnedSumAgreeingIntensities() :
     BinnedSpectrumCompareFunctor()
   {
@@ -80,15 +111,26 @@ namespace OpenMS
     const double sum1 = spec1.getBins().sum();
     const double sum2 = spec2.getBins().sum();
 
-    // For maximum speed, keep in single expression
     // 1. calculate mean minus difference: x = mean(a,b) - abs(a-b)
     // 2. truncate negative values:        y = max(0, x)
     // 3. calculate sum of entries:   sum_nn = y.sum()
-    BinnedSpectrum::SparseVectorType s = ((spec1.getBins() + spec2.getBins()) * 0.5) - ((spec1.getBins() - spec2.getBins()).cwiseAbs());
-    double sum_nn = s.coeffs().cwiseMax(0).sum();
+    const double sum_nn = sumAgreeing_(spec1.getBins(), spec2.getBins());
 
     // resulting score normalized to interval [0,1]
     return min(sum_nn / ((sum1 + sum2) / 2.0), 1.0);
   }
+
+  void BinnedSumAgreeingIntensities::compareBatch(const BinnedSpectrum& query, const std::vector<BinnedSpectrum>& targets, std::vector<double>& scores) const
+  {
+    scores.resize(targets.size());
+    const double sum1 = query.getBins().sum();
+    for (Size i = 0; i < targets.size(); ++i)
+    {
+      OPENMS_PRECONDITION(BinnedSpectrum::isCompatible(query, targets[i]), "Binned spectra have different bin size or spread");
+      const double sum2 = targets[i].getBins().sum();
+      const double sum_nn = sumAgreeing_(query.getBins(), targets[i].getBins());
+      scores[i] = min(sum_nn / ((sum1 + sum2) / 2.0), 1.0);
+    }
+  }
 }
 
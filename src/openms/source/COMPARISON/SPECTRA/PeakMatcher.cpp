@@ -0,0 +1,179 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+// --------------------------------------------------------------------------
+
+#include <OpenMS/COMPARISON/SPECTRA/PeakMatcher.h>
+
+#include <OpenMS/KERNEL/MSSpectrum.h>
+
+#include <cmath>
+
+namespace OpenMS
+{
+  void PeakMatcher::getMZs(const PeakSpectrum& spectrum, std::vector<double>& mz)
+  {
+    mz.reserve(mz.size() + spectrum.size());
+    for (const Peak1D& p : spectrum)
+    {
+      mz.push_back(p.getMZ());
+    }
+  }
+
+  void PeakMatcher::getIntensities(const PeakSpectrum& spectrum, std::vector<double>& intensities)
+  {
+    intensities.reserve(intensities.size() + spectrum.size());
+    for (const Peak1D& p : spectrum)
+    {
+      intensities.push_back(p.getIntensity());
+    }
+  }
+
+  void PeakMatcher::getToleranceWindows(const std::vector<double>& mz, double tolerance, bool tolerance_unit_ppm, std::vector<double>& lower, std::vector<double>& upper)
+  {
+    const Size n = mz.size();
+    lower.resize(n);
+    upper.resize(n);
+    // simple loops without branches, these are vectorized by the compiler
+    if (tolerance_unit_ppm)
+    {
+      const double factor = tolerance * 1e-6;
+      for (Size i = 0; i < n; ++i)
+      {
+        const double max_dist = mz[i] * factor;
+        lower[i] = mz[i] - max_dist;
+        upper[i] = mz[i] + max_dist;
+      }
+    }
+    else
+    {
+      for (Size i = 0; i < n; ++i)
+      {
+        lower[i] = mz[i] - tolerance;
+        upper[i] = mz[i] + tolerance;
+      }
+    }
+  }
+
+  Size PeakMatcher::matchClosest(const std::vector<double>& ref_mz, const std::vector<double>& lower, const std::vector<double>& upper,
+                                 const std::vector<double>& tgt_mz, std::vector<std::pair<Size, Size> >& matches)
+  {
+    const Size n_r = ref_mz.size();
+    const Size n_t = tgt_mz.size();
+    if (n_r == 0 || n_t == 0) { return 0; }
+
+    const Size old_size = matches.size();
+    Size t = 0;
+    for (Size r = 0; r < n_r; ++r)
+    {
+      // forward iterate over the target peaks until the distance gets worse
+      const double mz = ref_mz[r];
+      while (t + 1 < n_t && std::fabs(tgt_mz[t + 1] - mz) < std::fabs(tgt_mz[t] - mz))
+      {
+        ++t;
+      }
+      if (tgt_mz[t] >= lower[r] && tgt_mz[t] <= upper[r])
+      {
+        matches.emplace_back(r, t);
+      }
+    }
+    return matches.size() - old_size;
+  }
+
+  Size PeakMatcher::countMatchedReference(const std::vector<double>& lower, const std::vector<double>& upper, const std::vector<double>& tgt_mz)
+  {
+    const Size n_r = lower.size();
+    const Size n_t = tgt_mz.size();
+    Size matched = 0;
+    Size t = 0;
+    for (Size r = 0; r < n_r && t < n_t; ++r)
+    {
+      // skip target peaks left of the window
+      while (t < n_t && tgt_mz[t] < lower[r]) { ++t; }
+      if (t < n_t && tgt_mz[t] <= upper[r]) { ++matched; }
+    }
+    return matched;
+  }
+
+  double PeakMatcher::sumMatchedTarget(const std::vector<double>& ref_mz, const std::vector<double>& lower, const std::vector<double>& upper,
+                                       const std::vector<double>& tgt_mz, const std::vector<double>& tgt_intensities, Size& matched, double& sum_error)
+  {
+    const Size n_r = ref_mz.size();
+    const Size n_t = tgt_mz.size();
+    double intensity = 0.0;
+    matched = 0;
+    sum_error = 0.0;
+    Size r = 0;
+    for (Size t = 0; t < n_t && r < n_r; ++t)
+    {
+      // skip reference windows left of the target peak
+      while (r < n_r && upper[r] < tgt_mz[t]) { ++r; }
+      if (r < n_r && lower[r] <= tgt_mz[t])
+      {
+        intensity += tgt_intensities[t];
+        sum_error += std::fabs(tgt_mz[t] - ref_mz[r]);
+        ++matched;
+      }
+    }
+    return intensity;
+  }
+
+  Size PeakMatcher::countSharedBins(const std::vector<double>& mz1, const std::vector<double>& mz2, double bin_size)
+  {
+    // bin indices are ascending for sorted m/z values, so a merge of both spectra finds the shared bins
+    Size shared = 0;
+    Size i = 0, j = 0;
+    while (i < mz1.size() && j < mz2.size())
+    {
+      const double b1 = std::ceil(mz1[i] / bin_size);
+      const double b2 = std::ceil(mz2[j] / bin_size);
+      if (b1 < b2)
+      {
+        ++i;
+      }
+      else if (b2 < b1)
+      {
+        ++j;
+      }
+      else
+      {
+        ++shared;
+        // skip all peaks of both spectra in this bin
+        while (i < mz1.size() && std::ceil(mz1[i] / bin_size) == b1) { ++i; }
+        while (j < mz2.size() && std::ceil(mz2[j] / bin_size) == b1) { ++j; }
+      }
+    }
+    return shared;
+  }
+}
@@ -0,0 +1,106 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/COMPARISON/SPECTRA/SpectralLibraryIndex.h>
+
+#include <OpenMS/COMPARISON/SPECTRA/SpectraSTSimilarityScore.h>
+
+#include <algorithm>
+
+namespace OpenMS
+{
+  SpectralLibraryIndex::SpectralLibraryIndex()
+  {
+  }
+
+  SpectralLibraryIndex::SpectralLibraryIndex(const std::vector<MSSpectrum>& library, bool bin_spectra)
+  {
+    entries_.reserve(library.size());
+    for (Size i = 0; i < library.size(); ++i)
+    {
+      if (library[i].getPrecursors().empty()) continue;
+      entries_.push_back(std::make_pair(library[i].getPrecursors()[0].getMZ(), i));
+    }
+    // ties are resolved by library position
+    std::sort(entries_.begin(), entries_.end());
+
+    if (bin_spectra)
+    {
+      SpectraSTSimilarityScore spectrast;
+      binned_spectra_.reserve(library.size());
+      for (Size i = 0; i < library.size(); ++i)
+      {
+        binned_spectra_.push_back(spectrast.transform(library[i]));
+      }
+    }
+  }
+
+  Size SpectralLibraryIndex::size() const
+  {
+    return entries_.size();
+  }
+
+  bool SpectralLibraryIndex::empty() const
+  {
+    return entries_.empty();
+  }
+
+  std::pair<SpectralLibraryIndex::ConstIterator, SpectralLibraryIndex::ConstIterator> SpectralLibraryIndex::findByPrecursorMZ(double mz_low, double mz_high) const
+  {
+    ConstIterator begin = std::lower_bound(entries_.begin(), entries_.end(), mz_low,
+                                           [](const Entry& e, double mz) { return e.first < mz; });
+    ConstIterator end = std::upper_bound(begin, entries_.end(), mz_high,
+                                         [](double mz, const Entry& e) { return mz < e.first; });
+    return std::make_pair(begin, end);
+  }
+
+  bool SpectralLibraryIndex::hasBinnedSpectra() const
+  {
+    return !binned_spectra_.empty();
+  }
+
+  const BinnedSpectrum& SpectralLibraryIndex::getBinnedSpectrum(Size position) const
+  {
+    if (binned_spectra_.empty())
+    {
+      throw Exception::Precondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Binned spectra were not precomputed.");
+    }
+    if (position >= binned_spectra_.size())
+    {
+      throw Exception::IndexOverflow(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, position, binned_spectra_.size());
+    }
+    return binned_spectra_[position];
+  }
+
+}
@@ -39,6 +39,22 @@ using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// traceback directions of the alignment matrix
+    enum TraceDirection_ : unsigned char { ALIGN_, UP_, LEFT_ };
+
+    /// true if no two consecutive positions lie within 2 * @p tolerance (i.e. tolerance windows do not overlap)
+    bool windowsSeparated_(const vector<double>& mz, double tolerance)
+    {
+      for (Size i = 1; i < mz.size(); ++i)
+      {
+        if (mz[i] - mz[i - 1] <= 2.0 * tolerance) return false;
+      }
+      return true;
+    }
+  }
+
   SpectrumAlignment::SpectrumAlignment() :
     DefaultParamHandler("SpectrumAlignment")
   {
@@ -66,4 +82,123 @@ namespace OpenMS
     return *this;
   }
 
+  SpectrumAlignment::Workspace_& SpectrumAlignment::workspace_()
+  {
+    static thread_local Workspace_ ws;
+    return ws;
+  }
+
+  void SpectrumAlignment::getAbsoluteAlignment_(vector<pair<Size, Size> >& alignment, Workspace_& ws, double tolerance)
+  {
+    const vector<double>& mz1 = ws.mz1;
+    const vector<double>& mz2 = ws.mz2;
+    const Size n = mz1.size();
+    const Size m = mz2.size();
+    if (n == 0 || m == 0) return;
+
+    // fast path: every peak has at most one partner within the tolerance and all such pairs
+    // are compatible, so the optimal alignment simply contains all of them
+    if (windowsSeparated_(mz1, tolerance) && windowsSeparated_(mz2, tolerance))
+    {
+      Size j = 0;
+      for (Size i = 0; i < n; ++i)
+      {
+        while (j < m && mz2[j] < mz1[i] - tolerance) ++j;
+        if (j == m) break;
+        if (fabs(mz1[i] - mz2[j]) <= tolerance) alignment.emplace_back(i, j);
+      }
+      return;
+    }
+
+    // banded alignment: row i (peak i - 1 of s1) covers columns [row_first[i], row_last[i]], all other cells
+    // (including row and column 0) are scored as if reached by gaps only
+    ws.row_offset.assign(n + 1, 0);
+    ws.row_first.assign(n + 1, 1);
+    ws.row_last.assign(n + 1, 0);
+    ws.score.clear();
+    ws.trace.clear();
+
+    auto cell = [&ws, tolerance](Size i, Size j)
+    {
+      if (i != 0 && j >= ws.row_first[i] && j <= ws.row_last[i])
+      {
+        return ws.score[ws.row_offset[i] + j - ws.row_first[i]];
+      }
+      return (i + j) * tolerance;
+    };
+
+    Size left_ptr(1);
+    Size last_i(0), last_j(0);
+    for (Size i = 1; i <= n; ++i)
+    {
+      double pos1(mz1[i - 1]);
+      ws.row_offset[i] = ws.score.size();
+      ws.row_first[i] = left_ptr;
+      ws.row_last[i] = left_ptr - 1;
+
+      for (Size j = left_ptr; j <= m; ++j)
+      {
+        double pos2(mz2[j - 1]);
+        double diff_align = fabs(pos1 - pos2);
+
+        // running off the right border of the band?
+        bool off_band = pos2 > pos1 && diff_align > tolerance && i < n && j < m && mz1[i] < pos2;
+
+        // can we tighten the left border of the band?
+        if (pos1 > pos2 && diff_align > tolerance && j > left_ptr + 1)
+        {
+          ++left_ptr;
+        }
+
+        // find min of the three possible directions
+        double score_align = diff_align + cell(i - 1, j - 1);
+        double score_up = tolerance + cell(i, j - 1);
+        double score_left = tolerance + cell(i - 1, j);
+
+        if (score_align <= score_up && score_align <= score_left && diff_align <= tolerance)
+        {
+          ws.score.push_back(score_align);
+          ws.trace.push_back(ALIGN_);
+          last_i = i;
+          last_j = j;
+        }
+        else if (score_up <= score_left)
+        {
+          ws.score.push_back(score_up);
+          ws.trace.push_back(UP_);
+        }
+        else
+        {
+          ws.score.push_back(score_left);
+          ws.trace.push_back(LEFT_);
+        }
+        ws.row_last[i] = j;
+
+        if (off_band) break;
+      }
+    }
+
+    // do traceback (stops at the matrix border or when leaving the band)
+    Size i = last_i;
+    Size j = last_j;
+    while (i >= 1 && j >= ws.row_first[i] && j <= ws.row_last[i])
+    {
+      switch (ws.trace[ws.row_offset[i] + j - ws.row_first[i]])
+      {
+        case ALIGN_:
+          alignment.emplace_back(i - 1, j - 1);
+          --i;
+          --j;
+          break;
+        case UP_:
+          --j;
+          break;
+        default:
+          --i;
+      }
+    }
+
+    std::reverse(alignment.begin(), alignment.end());
+  }
+
 }
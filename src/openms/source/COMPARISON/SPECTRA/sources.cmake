@@ -9,8 +9,10 @@ BinnedSpectrum.cpp
 BinnedSpectrumCompareFunctor.cpp
 BinnedSumAgreeingIntensities.cpp
 PeakAlignment.cpp
+PeakMatcher.cpp
 PeakSpectrumCompareFunctor.cpp
 SpectraSTSimilarityScore.cpp
+SpectralLibraryIndex.cpp
 SpectrumAlignment.cpp
 SpectrumAlignmentScore.cpp
 SpectrumCheapDPCorr.cpp
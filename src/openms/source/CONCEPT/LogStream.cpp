@@ -544,6 +544,11 @@ namespace OpenMS
       std::ostream::flush();
     }
 
+    bool LogStream::hasStreams() const
+    {
+      return bound_() && !const_cast<LogStream *>(this)->rdbuf()->stream_list_.empty();
+    }
+
   }   // namespace Logger
 
 
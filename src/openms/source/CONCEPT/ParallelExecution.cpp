@@ -0,0 +1,190 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ParallelExecution.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+  #include <sched.h>
+#endif
+
+namespace OpenMS
+{
+  namespace
+  {
+#ifdef __linux__
+    /// CPU quota (in cores, rounded up) of the cgroup of the process, or 0 if not limited
+    int cgroupCpuQuota()
+    {
+      // cgroup v2: "<quota> <period>" or "max <period>"
+      {
+        std::ifstream cpu_max("/sys/fs/cgroup/cpu.max");
+        std::string quota;
+        double period = 0;
+        if (cpu_max >> quota >> period && quota != "max" && period > 0)
+        {
+          return std::max(1, (int)std::ceil(std::stod(quota) / period));
+        }
+      }
+      // cgroup v1: quota is -1 if not limited
+      {
+        std::ifstream quota_file("/sys/fs/cgroup/cpu/cpu.cfs_quota_us");
+        std::ifstream period_file("/sys/fs/cgroup/cpu/cpu.cfs_period_us");
+        double quota = -1, period = 0;
+        if (quota_file >> quota && period_file >> period && quota > 0 && period > 0)
+        {
+          return std::max(1, (int)std::ceil(quota / period));
+        }
+      }
+      return 0;
+    }
+
+    /// the CPUs the process may run on (determined once, before any thread was pinned)
+    const std::vector<int>& allowedCpus()
+    {
+      static const std::vector<int> cpus = []()
+      {
+        std::vector<int> result;
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0)
+        {
+          for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+          {
+            if (CPU_ISSET(cpu, &cpu_set)) result.push_back(cpu);
+          }
+        }
+        return result;
+      }();
+      return cpus;
+    }
+#endif
+  }
+
+  void ParallelExecution::setNumberOfThreads(int
+#ifdef _OPENMP
+                                             num_threads // to avoid the unused warning we enable this
+                                                         // argument only if openmp is available
+#endif
+                                             )
+  {
+#ifdef _OPENMP
+    const int available = getAvailableCores();
+    if (num_threads < 1 || num_threads > available) num_threads = available;
+    omp_set_num_threads(num_threads);
+    // parallel regions inside of parallel regions are executed by a single thread
+    omp_set_max_active_levels(1);
+#endif
+  }
+
+  int ParallelExecution::getNumberOfThreads()
+  {
+#ifdef _OPENMP
+    return inParallelRegion() ? 1 : omp_get_max_threads();
+#else
+    return 1;
+#endif
+  }
+
+  int ParallelExecution::getAvailableCores()
+  {
+    int cores = (int)std::thread::hardware_concurrency();
+#ifdef __linux__
+    if (!allowedCpus().empty())
+    {
+      cores = (int)allowedCpus().size();
+    }
+    const int quota = cgroupCpuQuota();
+    if (quota > 0) cores = std::min(cores, quota);
+#endif
+    return std::max(cores, 1);
+  }
+
+  void ParallelExecution::setThreadAffinity(ThreadAffinity
+#if defined(__linux__) && defined(_OPENMP)
+                                            affinity // only used if pinning is supported
+#endif
+                                            )
+  {
+#if defined(__linux__) && defined(_OPENMP)
+    // explicit settings of the OpenMP runtime take precedence
+    if (std::getenv("OMP_PROC_BIND") != nullptr || std::getenv("OMP_PLACES") != nullptr) return;
+
+    const std::vector<int>& cpus = allowedCpus();
+    if (cpus.empty()) return;
+    const int nr_cpus = (int)cpus.size();
+    const int nr_threads = getNumberOfThreads();
+
+#pragma omp parallel num_threads(nr_threads)
+    {
+      cpu_set_t cpu_set;
+      CPU_ZERO(&cpu_set);
+      const int thread = omp_get_thread_num();
+      if (affinity == ThreadAffinity::NONE)
+      {
+        for (int cpu : cpus) CPU_SET(cpu, &cpu_set);
+      }
+      else if (affinity == ThreadAffinity::CLOSE)
+      {
+        CPU_SET(cpus[thread % nr_cpus], &cpu_set);
+      }
+      else // SPREAD
+      {
+        CPU_SET(cpus[(Size(thread) * nr_cpus / nr_threads) % nr_cpus], &cpu_set);
+      }
+      sched_setaffinity(0, sizeof(cpu_set), &cpu_set); // 0: the calling thread
+    }
+#endif
+  }
+
+  bool ParallelExecution::inParallelRegion()
+  {
+#ifdef _OPENMP
+    return omp_in_parallel() != 0;
+#else
+    return false;
+#endif
+  }
+
+  void ParallelExecution::runTasks(const std::vector<std::function<void()> >& tasks)
+  {
+    forEach(0, (SignedSize)tasks.size(), [&tasks](SignedSize i) { tasks[i](); }, Schedule::DYNAMIC);
+  }
+
+} // namespace OpenMS
@@ -0,0 +1,448 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/Profiler.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+#include <OpenMS/SYSTEM/StopWatch.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace OpenMS
+{
+  namespace
+  {
+    /// a completed region of one thread
+    struct TraceEvent_
+    {
+      const char* name;
+      Int64 start;
+      Int64 end;
+    };
+
+    /// aggregated durations (in ns) of a region
+    struct TimerStats_
+    {
+      Size count = 0;
+      Int64 total = 0;
+      Int64 min = std::numeric_limits<Int64>::max();
+      Int64 max = 0;
+
+      void add(Int64 duration)
+      {
+        ++count;
+        total += duration;
+        min = std::min(min, duration);
+        max = std::max(max, duration);
+      }
+
+      void merge(const TimerStats_& other)
+      {
+        count += other.count;
+        total += other.total;
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+      }
+    };
+
+    /// histogram with logarithmic (base 2) bins: bin i holds values in [2^(i-32), 2^(i-31)), bin 0 also everything smaller (including values <= 0)
+    struct Histogram_
+    {
+      static const int BINS = 64;
+
+      Size count = 0;
+      double sum = 0.0;
+      double min = std::numeric_limits<double>::max();
+      double max = std::numeric_limits<double>::lowest();
+      std::array<Size, BINS> bins{};
+
+      static int binOf(double value)
+      {
+        if (!(value > 0.0)) return 0;
+        int exponent;
+        std::frexp(value, &exponent); // value = m * 2^exponent, m in [0.5, 1)
+        return std::max(0, std::min(BINS - 1, exponent - 1 + 32));
+      }
+
+      /// lower bound of bin @p i
+      static double binStart(int i)
+      {
+        return std::ldexp(1.0, i - 32);
+      }
+
+      void add(double value)
+      {
+        ++count;
+        sum += value;
+        min = std::min(min, value);
+        max = std::max(max, value);
+        ++bins[binOf(value)];
+      }
+    };
+
+    /// everything recorded by one thread
+    struct ThreadData_
+    {
+      Size tid = 0;
+      std::mutex mutex;
+      std::vector<TraceEvent_> events;
+      Size dropped_events = 0;
+      std::unordered_map<const char*, TimerStats_> timers;
+      std::unordered_map<const char*, Int64> counters;
+      std::unordered_map<const char*, Histogram_> histograms;
+    };
+
+    struct Registry_
+    {
+      std::mutex mutex;
+      /// shared with the owning thread, so data of finished threads is kept
+      std::vector<std::shared_ptr<ThreadData_> > threads;
+      /// node based, i.e. pointers to the contained strings stay valid
+      std::set<std::string> interned;
+    };
+
+    Registry_& registry_()
+    {
+      // intentionally leaked: threads may still record while static objects are destroyed
+      static Registry_* registry = new Registry_();
+      return *registry;
+    }
+
+    ThreadData_& threadData_()
+    {
+      thread_local std::shared_ptr<ThreadData_> data;
+      if (!data)
+      {
+        data = std::make_shared<ThreadData_>();
+        Registry_& registry = registry_();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        data->tid = registry.threads.size();
+        registry.threads.push_back(data);
+      }
+      return *data;
+    }
+
+    /// merged (over threads and over equal names at different addresses) view of the collected data
+    struct Snapshot_
+    {
+      std::vector<std::pair<Size, std::vector<TraceEvent_> > > events; ///< per thread id
+      Size dropped_events = 0;
+      std::map<std::string, TimerStats_> timers;
+      std::map<std::string, Int64> counters;
+      std::map<std::string, std::map<Size, Histogram_> > histograms; ///< per name and thread id
+    };
+
+    Snapshot_ takeSnapshot_(bool with_events)
+    {
+      Snapshot_ snapshot;
+      Registry_& registry = registry_();
+      std::lock_guard<std::mutex> registry_lock(registry.mutex);
+      for (const std::shared_ptr<ThreadData_>& data : registry.threads)
+      {
+        std::lock_guard<std::mutex> lock(data->mutex);
+        if (with_events && !data->events.empty())
+        {
+          snapshot.events.emplace_back(data->tid, data->events);
+        }
+        snapshot.dropped_events += data->dropped_events;
+        for (const auto& timer : data->timers)
+        {
+          snapshot.timers[timer.first].merge(timer.second);
+        }
+        for (const auto& counter : data->counters)
+        {
+          snapshot.counters[counter.first] += counter.second;
+        }
+        for (const auto& histogram : data->histograms)
+        {
+          snapshot.histograms[histogram.first][data->tid] = histogram.second;
+        }
+      }
+      return snapshot;
+    }
+
+    /// writes @p s as quoted JSON string
+    void writeJSONString_(std::ostream& os, const std::string& s)
+    {
+      os << '"';
+      for (char c : s)
+      {
+        switch (c)
+        {
+          case '"': os << "\\\""; break;
+          case '\\': os << "\\\\"; break;
+          case '\n': os << "\\n"; break;
+          case '\t': os << "\\t"; break;
+          default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+              os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec << std::setfill(' ');
+            }
+            else
+            {
+              os << c;
+            }
+        }
+      }
+      os << '"';
+    }
+  }
+
+  std::atomic<bool> Profiler::enabled_(false);
+
+  void Profiler::setEnabled(bool enabled)
+  {
+    now(); // fix the time origin before the first region starts
+    enabled_.store(enabled);
+  }
+
+  void Profiler::clear()
+  {
+    Registry_& registry = registry_();
+    std::lock_guard<std::mutex> registry_lock(registry.mutex);
+    for (const std::shared_ptr<ThreadData_>& data : registry.threads)
+    {
+      std::lock_guard<std::mutex> lock(data->mutex);
+      data->events.clear();
+      data->dropped_events = 0;
+      data->timers.clear();
+      data->counters.clear();
+      data->histograms.clear();
+    }
+  }
+
+  Int64 Profiler::now()
+  {
+    static const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+  }
+
+  void Profiler::addEvent(const char* name, Int64 start, Int64 end)
+  {
+    if (!isEnabled()) return;
+    ThreadData_& data = threadData_();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    if (data.events.size() < MAX_EVENTS_PER_THREAD)
+    {
+      data.events.push_back(TraceEvent_{name, start, end});
+    }
+    else
+    {
+      ++data.dropped_events;
+    }
+    data.timers[name].add(end - start);
+  }
+
+  void Profiler::addStopWatch(const char* name, const StopWatch& sw)
+  {
+    if (!isEnabled()) return;
+    ThreadData_& data = threadData_();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    data.timers[name].add(static_cast<Int64>(sw.getClockTime() * 1e9));
+  }
+
+  void Profiler::addCounter_(const char* name, Int64 value)
+  {
+    ThreadData_& data = threadData_();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    data.counters[name] += value;
+  }
+
+  void Profiler::addSample_(const char* name, double value)
+  {
+    ThreadData_& data = threadData_();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    data.histograms[name].add(value);
+  }
+
+  const char* Profiler::intern(const String& name)
+  {
+    Registry_& registry = registry_();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return registry.interned.insert(name).first->c_str();
+  }
+
+  Int64 Profiler::getCounter(const String& name)
+  {
+    const Snapshot_ snapshot = takeSnapshot_(false);
+    std::map<std::string, Int64>::const_iterator it = snapshot.counters.find(name);
+    return it == snapshot.counters.end() ? 0 : it->second;
+  }
+
+  Size Profiler::getTimerCount(const String& name)
+  {
+    const Snapshot_ snapshot = takeSnapshot_(false);
+    std::map<std::string, TimerStats_>::const_iterator it = snapshot.timers.find(name);
+    return it == snapshot.timers.end() ? 0 : it->second.count;
+  }
+
+  void Profiler::storeChromeTrace(const String& filename)
+  {
+    std::ofstream os(filename.c_str());
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    const Int64 end_time = now();
+    const Snapshot_ snapshot = takeSnapshot_(true);
+
+    // timestamps and durations are given in microseconds
+    os << std::setprecision(15);
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const auto& thread : snapshot.events)
+    {
+      os << (first ? "\n" : ",\n");
+      first = false;
+      os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.first
+         << ",\"args\":{\"name\":\"thread " << thread.first << "\"}}";
+      for (const TraceEvent_& event : thread.second)
+      {
+        os << ",\n{\"name\":";
+        writeJSONString_(os, event.name);
+        os << ",\"cat\":\"OpenMS\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread.first
+           << ",\"ts\":" << event.start / 1000.0 << ",\"dur\":" << (event.end - event.start) / 1000.0 << "}";
+      }
+    }
+    for (const auto& counter : snapshot.counters)
+    {
+      os << (first ? "\n" : ",\n");
+      first = false;
+      os << "{\"name\":";
+      writeJSONString_(os, counter.first);
+      os << ",\"cat\":\"OpenMS\",\"ph\":\"C\",\"pid\":1,\"tid\":0,\"ts\":" << end_time / 1000.0
+         << ",\"args\":{\"value\":" << counter.second << "}}";
+    }
+    os << "\n],\n\"otherData\":{\"dropped_events\":" << snapshot.dropped_events << "},\n\"histograms\":{";
+
+    // histograms are kept per thread; bins are given as [lower bound, count]
+    first = true;
+    for (const auto& histogram : snapshot.histograms)
+    {
+      os << (first ? "\n" : ",\n");
+      first = false;
+      writeJSONString_(os, histogram.first);
+      os << ":{";
+      bool first_thread = true;
+      for (const auto& thread : histogram.second)
+      {
+        const Histogram_& h = thread.second;
+        os << (first_thread ? "" : ",") << "\"" << thread.first << "\":{\"count\":" << h.count << ",\"sum\":" << h.sum
+           << ",\"min\":" << h.min << ",\"max\":" << h.max << ",\"bins\":[";
+        first_thread = false;
+        bool first_bin = true;
+        for (int i = 0; i < Histogram_::BINS; ++i)
+        {
+          if (h.bins[i] == 0) continue;
+          os << (first_bin ? "" : ",") << "[" << (i == 0 ? 0.0 : Histogram_::binStart(i)) << "," << h.bins[i] << "]";
+          first_bin = false;
+        }
+        os << "]}";
+      }
+      os << "}";
+    }
+    os << "\n}}\n";
+  }
+
+  void Profiler::printSummary(std::ostream& os)
+  {
+    const Snapshot_ snapshot = takeSnapshot_(false);
+
+    if (!snapshot.timers.empty())
+    {
+      // most expensive regions first
+      std::vector<std::pair<std::string, TimerStats_> > timers(snapshot.timers.begin(), snapshot.timers.end());
+      std::sort(timers.begin(), timers.end(), [](const std::pair<std::string, TimerStats_>& a, const std::pair<std::string, TimerStats_>& b)
+      {
+        return a.second.total > b.second.total;
+      });
+      os << "Timers (summed over threads; times in ms):\n";
+      os << "  " << std::left << std::setw(50) << "name" << std::right << std::setw(12) << "count" << std::setw(14) << "total"
+         << std::setw(12) << "mean" << std::setw(12) << "min" << std::setw(12) << "max" << "\n";
+      os << std::fixed << std::setprecision(3);
+      for (const auto& timer : timers)
+      {
+        const TimerStats_& t = timer.second;
+        os << "  " << std::left << std::setw(50) << timer.first << std::right << std::setw(12) << t.count << std::setw(14) << t.total / 1e6
+           << std::setw(12) << t.total / 1e6 / t.count << std::setw(12) << t.min / 1e6 << std::setw(12) << t.max / 1e6 << "\n";
+      }
+      os.unsetf(std::ios_base::floatfield);
+    }
+
+    if (!snapshot.counters.empty())
+    {
+      os << "Counters:\n";
+      for (const auto& counter : snapshot.counters)
+      {
+        os << "  " << std::left << std::setw(50) << counter.first << std::right << std::setw(12) << counter.second << "\n";
+      }
+    }
+
+    if (!snapshot.histograms.empty())
+    {
+      os << "Histograms (merged over threads):\n";
+      for (const auto& histogram : snapshot.histograms)
+      {
+        Histogram_ merged;
+        for (const auto& thread : histogram.second)
+        {
+          const Histogram_& h = thread.second;
+          merged.count += h.count;
+          merged.sum += h.sum;
+          merged.min = std::min(merged.min, h.min);
+          merged.max = std::max(merged.max, h.max);
+        }
+        os << "  " << std::left << std::setw(50) << histogram.first << std::right << " count: " << merged.count
+           << " mean: " << merged.sum / merged.count << " min: " << merged.min << " max: " << merged.max << "\n";
+      }
+    }
+    os << std::flush;
+  }
+
+} // namespace OpenMS
@@ -35,6 +35,7 @@
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 #include <OpenMS/CONCEPT/Macros.h>
 #include <OpenMS/CONCEPT/Factory.h>
+#include <OpenMS/CONCEPT/Profiler.h>
 
 #include <OpenMS/SYSTEM/StopWatch.h>
 
@@ -167,7 +168,11 @@ public:
     Factory<ProgressLogger::ProgressLoggerImpl>::registerProduct(NoProgressLoggerImpl::getProductName(), &NoProgressLoggerImpl::create);
   }
 
-  int ProgressLogger::recursion_depth_ = 0;
+  namespace
+  {
+    /// nesting depth of progress reports; per thread, so algorithms running concurrently (e.g. from several Python threads) do not interfere
+    thread_local int recursion_depth_ = 0;
+  }
 
   String ProgressLogger::logTypeToFactoryName_(ProgressLogger::LogType type)
   {
@@ -244,6 +249,10 @@ public:
     last_invoke_ = time(nullptr);
     current_logger_->startProgress(begin, end, label, recursion_depth_);
     ++recursion_depth_;
+    if (Profiler::isEnabled())
+    {
+      profile_regions_.emplace_back(Profiler::intern(label), Profiler::now());
+    }
   }
 
   void ProgressLogger::setProgress(SignedSize value) const
@@ -271,6 +280,11 @@ public:
       --recursion_depth_;
     }
     current_logger_->endProgress(recursion_depth_);
+    if (!profile_regions_.empty())
+    {
+      Profiler::addEvent(profile_regions_.back().first, profile_regions_.back().second, Profiler::now());
+      profile_regions_.pop_back();
+    }
   }
 
 
@@ -38,25 +38,47 @@
 
 namespace OpenMS
 {
-  UInt64 UniqueIdGenerator::seed_ = 0;
-  UniqueIdGenerator* UniqueIdGenerator::instance_ = nullptr;
-  boost::mt19937_64* UniqueIdGenerator::rng_ = nullptr;
-  boost::uniform_int<UInt64>* UniqueIdGenerator::dist_ = nullptr;
+  namespace
+  {
+    /// ids of the random sequence reserved by one thread
+    struct IdBlock
+    {
+      static const Size SIZE = 64;
+
+      UInt64 generation; ///< generation of the generator the ids were drawn from (0: never filled)
+      Size pos; ///< next unused id
+      UInt64 ids[SIZE];
+    };
+
+    thread_local IdBlock id_block; // zero-initialized, i.e. empty
+  }
 
   UInt64 UniqueIdGenerator::getUniqueId()
   {
     UniqueIdGenerator& instance = getInstance_();
-#ifdef _OPENMP
-    UInt64 val;
-#pragma omp critical (OPENMS_UniqueIdGenerator_getUniqueId)
+    IdBlock& block = id_block;
+    if (block.generation != instance.generation_.load(std::memory_order_acquire) || block.pos == IdBlock::SIZE)
     {
-      val = (*instance.dist_)(*instance.rng_);
+      block.generation = instance.drawIds_(block.ids, IdBlock::SIZE);
+      block.pos = 0;
     }
-    // note: OpenMP can only work on a structured block, return needs to be outside that block
-    return val; 
-#else
-    return (*instance.dist_)(*instance.rng_);
+    return block.ids[block.pos++];
+  }
+
+  UInt64 UniqueIdGenerator::drawIds_(UInt64* ids, Size count)
+  {
+    UInt64 generation;
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_UniqueIdGenerator_rng)
 #endif
+    {
+      for (Size i = 0; i < count; ++i)
+      {
+        ids[i] = dist_(rng_);
+      }
+      generation = generation_.load(std::memory_order_relaxed);
+    }
+    return generation;
   }
 
   UInt64 UniqueIdGenerator::getSeed()
@@ -68,61 +90,43 @@ namespace OpenMS
   {
   // modifies static members
 #ifdef _OPENMP
-#pragma omp critical (OPENMS_UniqueIdGenerator_setSeed)
+#pragma omp critical (OPENMS_UniqueIdGenerator_rng)
 #endif
     {
       UniqueIdGenerator& instance = getInstance_();
       instance.seed_ = seed;
-      instance.rng_->seed( instance.seed_ );
-      instance.dist_->reset();
+      instance.rng_.seed(instance.seed_);
+      instance.dist_.reset();
+      instance.generation_.fetch_add(1, std::memory_order_release);
     }
   }
 
-  UniqueIdGenerator::UniqueIdGenerator()
+  UniqueIdGenerator::UniqueIdGenerator() :
+    seed_(0),
+    dist_(0, std::numeric_limits<UInt64>::max()),
+    generation_(1)
   {
+    // find a seed:
+    // get something with high resolution (around microseconds) -- its hard to do better on Windows --
+    // which has absolute system time (there is higher resolution available for the time since program startup, but 
+    // we do not want this here since this seed usually gets initialized at the same program uptime).
+    // Reason for high-res: in pipelines, instances of TOPP tools can get initialized almost simultaneously (i.e., resolution in seconds is not enough),
+    // leading to identical random numbers (e.g. feature-IDs) in two or more distinct files.
+    // C++11 note: C++ build-in alternative once C++11 can be presumed: 'std::chrono::high_resolution_clock'
+    boost::posix_time::ptime t(boost::posix_time::microsec_clock::local_time() );
+    seed_ = t.time_of_day().ticks();  // independent of implementation; as opposed to nanoseconds(), which need not be available on every platform
+    rng_.seed(seed_);
   }
 
   UniqueIdGenerator & UniqueIdGenerator::getInstance_()
   {
-  // modifies static members
-#ifdef _OPENMP
-#pragma omp critical (OPENMS_UniqueIdGenerator_getInstance_)
-#endif
-    {
-      if (!instance_)
-      {
-        instance_ = new UniqueIdGenerator();
-        instance_->init_();
-      }
-    }
-    return *instance_;
-  }
-
-  void UniqueIdGenerator::init_()
-  {
-  // modifies static members
-#ifdef _OPENMP
-#pragma omp critical (OPENMS_UniqueIdGenerator_init_)
-#endif
-    { 
-      // find a seed:
-      // get something with high resolution (around microseconds) -- its hard to do better on Windows --
-      // which has absolute system time (there is higher resolution available for the time since program startup, but 
-      // we do not want this here since this seed usually gets initialized at the same program uptime).
-      // Reason for high-res: in pipelines, instances of TOPP tools can get initialized almost simultaneously (i.e., resolution in seconds is not enough),
-      // leading to identical random numbers (e.g. feature-IDs) in two or more distinct files.
-      // C++11 note: C++ build-in alternative once C++11 can be presumed: 'std::chrono::high_resolution_clock'
-      boost::posix_time::ptime t(boost::posix_time::microsec_clock::local_time() );
-      seed_ = t.time_of_day().ticks();  // independent of implementation; as opposed to nanoseconds(), which need not be available on every platform
-      rng_ = new boost::mt19937_64 (seed_);
-      dist_ = new boost::uniform_int<UInt64> (0, std::numeric_limits<UInt64>::max());
-    }
+    // initialization of function-local statics is thread-safe and lock-free once done
+    static UniqueIdGenerator instance;
+    return instance;
   }
 
   UniqueIdGenerator::~UniqueIdGenerator()
   {
-    delete rng_;
-    delete dist_;
   }
 
 }
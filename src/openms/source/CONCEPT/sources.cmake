@@ -11,7 +11,9 @@ GlobalExceptionHandler.cpp
 Init.cpp
 LogConfigHandler.cpp
 LogStream.cpp
+ParallelExecution.cpp
 PrecisionWrapper.cpp
+Profiler.cpp
 ProgressLogger.cpp
 RAIICleanup.cpp
 SingletonRegistry.cpp
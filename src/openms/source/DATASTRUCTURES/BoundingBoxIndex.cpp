@@ -0,0 +1,176 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/DATASTRUCTURES/BoundingBoxIndex.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace OpenMS
+{
+  BoundingBoxIndex::BoundingBoxIndex() :
+    min_x_(0.0),
+    max_x_(-1.0),
+    bin_width_(1.0)
+  {
+  }
+
+  BoundingBoxIndex::BoundingBoxIndex(const std::vector<BoxType>& boxes, double bin_width) :
+    BoundingBoxIndex()
+  {
+    build(boxes, bin_width);
+  }
+
+  void BoundingBoxIndex::build(const std::vector<BoxType>& boxes, double bin_width)
+  {
+    clear();
+    boxes_ = boxes;
+
+    // extent and typical width in the first dimension
+    std::vector<double> widths;
+    widths.reserve(boxes_.size());
+    min_x_ = std::numeric_limits<double>::max();
+    max_x_ = -std::numeric_limits<double>::max();
+    for (const BoxType& box : boxes_)
+    {
+      if (box.isEmpty()) continue;
+      min_x_ = std::min(min_x_, box.minX());
+      max_x_ = std::max(max_x_, box.maxX());
+      widths.push_back(box.width());
+    }
+    if (widths.empty()) // no (non-empty) boxes
+    {
+      min_x_ = 0.0;
+      max_x_ = -1.0;
+      return;
+    }
+
+    if (bin_width <= 0.0)
+    {
+      std::nth_element(widths.begin(), widths.begin() + widths.size() / 2, widths.end());
+      bin_width = widths[widths.size() / 2];
+    }
+    // limit the number of bins (also covers zero width boxes)
+    const Size max_bins = std::max<Size>(1024, 4 * widths.size());
+    bin_width_ = std::max(bin_width, (max_x_ - min_x_) / max_bins);
+    if (bin_width_ <= 0.0) bin_width_ = 1.0;
+    const Size n_bins = Size((max_x_ - min_x_) / bin_width_) + 1;
+
+    // counting sort of the boxes into the bins they overlap
+    auto binOf = [this, n_bins](double x) { return std::min(n_bins - 1, Size((x - min_x_) / bin_width_)); };
+    bin_begin_.assign(n_bins + 1, 0);
+    for (const BoxType& box : boxes_)
+    {
+      if (box.isEmpty()) continue;
+      for (Size b = binOf(box.minX()); b <= binOf(box.maxX()); ++b) ++bin_begin_[b + 1];
+    }
+    for (Size b = 0; b < n_bins; ++b) bin_begin_[b + 1] += bin_begin_[b];
+
+    entries_.resize(bin_begin_.back());
+    bin_max_height_.assign(n_bins, 0.0);
+    std::vector<Size> fill(bin_begin_.begin(), bin_begin_.end() - 1);
+    for (Size i = 0; i < boxes_.size(); ++i)
+    {
+      const BoxType& box = boxes_[i];
+      if (box.isEmpty()) continue;
+      for (Size b = binOf(box.minX()); b <= binOf(box.maxX()); ++b)
+      {
+        entries_[fill[b]++] = Entry_{box.minY(), box.maxY(), i};
+        bin_max_height_[b] = std::max(bin_max_height_[b], box.height());
+      }
+    }
+    for (Size b = 0; b < n_bins; ++b)
+    {
+      std::sort(entries_.begin() + bin_begin_[b], entries_.begin() + bin_begin_[b + 1],
+                [](const Entry_& a, const Entry_& b) { return a.min_y < b.min_y || (a.min_y == b.min_y && a.index < b.index); });
+    }
+  }
+
+  void BoundingBoxIndex::clear()
+  {
+    boxes_.clear();
+    min_x_ = 0.0;
+    max_x_ = -1.0;
+    bin_width_ = 1.0;
+    bin_begin_.clear();
+    bin_max_height_.clear();
+    entries_.clear();
+  }
+
+  Size BoundingBoxIndex::size() const
+  {
+    return boxes_.size();
+  }
+
+  bool BoundingBoxIndex::empty() const
+  {
+    return boxes_.empty();
+  }
+
+  const BoundingBoxIndex::BoxType& BoundingBoxIndex::getBox(Size index) const
+  {
+    if (index >= boxes_.size())
+    {
+      throw Exception::IndexOverflow(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, index, boxes_.size());
+    }
+    return boxes_[index];
+  }
+
+  void BoundingBoxIndex::query(const PositionType& position, std::vector<Size>& result) const
+  {
+    result.clear();
+    const double x = position.getX();
+    const double y = position.getY();
+    if (bin_begin_.empty() || !(x >= min_x_ && x <= max_x_)) return;
+
+    const Size bin = std::min(bin_begin_.size() - 2, Size((x - min_x_) / bin_width_));
+    std::vector<Entry_>::const_iterator it = entries_.begin() + bin_begin_[bin];
+    std::vector<Entry_>::const_iterator end = entries_.begin() + bin_begin_[bin + 1];
+
+    // boxes with a lower bound below this can not reach y (with some slack for rounding of the heights)
+    const double lowest = y - bin_max_height_[bin] * (1.0 + 1e-9) - 1e-9;
+    it = std::lower_bound(it, end, lowest, [](const Entry_& e, double v) { return e.min_y < v; });
+    for (; it != end && it->min_y <= y; ++it)
+    {
+      if (it->max_y >= y && boxes_[it->index].encloses(position))
+      {
+        result.push_back(it->index);
+      }
+    }
+    std::sort(result.begin(), result.end());
+  }
+
+} // namespace OpenMS
@@ -34,12 +34,34 @@
 
 #include <OpenMS/DATASTRUCTURES/ConvexHull2D.h>
 
+#include <algorithm>
+
 namespace OpenMS
 {
+  namespace
+  {
+    /// is @p mz within the m/z range interpolated at @p rt between two scans (given by RT and m/z range)?
+    bool enclosedBetweenScans(double rt, double mz,
+                              double rt_lower, double min_lower, double max_lower,
+                              double rt_upper, double min_upper, double max_upper)
+    {
+      double mz_low = min_lower // m/z offset
+                      + ((rt - rt_lower) / (rt_upper - rt_lower))  // factor (0-1)
+                      * (min_upper - min_lower);                   // m/z range
+
+      double mz_high = max_lower // m/z offset
+                       + ((rt - rt_lower) / (rt_upper - rt_lower)) // factor (0-1)
+                       * (max_upper - max_lower);                  // m/z range
+
+      DBoundingBox<1> range(mz_low, mz_high);
+      return range.encloses(mz);
+    }
+  }
 
   ConvexHull2D::ConvexHull2D() :
     map_points_(),
-    outer_points_()
+    outer_points_(),
+    bounding_box_()
   {
   }
 
@@ -51,6 +73,7 @@ namespace OpenMS
 
     map_points_ = rhs.map_points_;
     outer_points_ = rhs.outer_points_;
+    bounding_box_ = rhs.bounding_box_;
 
     return *this;
   }
@@ -91,6 +114,7 @@ namespace OpenMS
   {
     map_points_.clear();
     outer_points_.clear();
+    bounding_box_ = DBoundingBox<2>();
   }
 
   /// accessor for the points
@@ -133,6 +157,12 @@ namespace OpenMS
   {
     map_points_.clear();
     outer_points_ = points;
+
+    bounding_box_ = DBoundingBox<2>();
+    for (PointArrayType::const_iterator it = outer_points_.begin(); it != outer_points_.end(); ++it)
+    {
+      bounding_box_.enlarge((*it)[0], (*it)[1]);
+    }
   }
 
   void ConvexHull2D::expandToBoundingBox()
@@ -149,43 +179,32 @@ namespace OpenMS
   /// returns the bounding box of the convex hull points
   DBoundingBox<2> ConvexHull2D::getBoundingBox() const
   {
-    DBoundingBox<2> bb;
-
-    // the internal structure might not be defined, but we try it first
-    if (map_points_.size() > 0)
-    {
-      for (HullPointType::ConstIterator it = map_points_.begin(); it != map_points_.end(); ++it)
-      {
-        bb.enlarge(it->first, it->second.minPosition()[0]);
-        bb.enlarge(it->first, it->second.maxPosition()[0]);
-      }
-    }
-    else if (outer_points_.size() > 0)
-    {
-      for (PointArrayType::const_iterator it = outer_points_.begin(); it != outer_points_.end(); ++it)
-      {
-        bb.enlarge((*it)[0], (*it)[1]);
-      }
-    }
-
-    return bb;
+    return bounding_box_;
   }
 
   bool ConvexHull2D::addPoint(const PointType& point)
   {
     outer_points_.clear();
 
-    if (map_points_.has(point[0]))
+    // the bounding box is derived from the internal structure from now on (not from user-given hull points)
+    if (map_points_.empty())
+    {
+      bounding_box_ = DBoundingBox<2>();
+    }
+
+    HullPointType::iterator it = map_points_.find(point[0]);
+    if (it != map_points_.end())
     {
-      if (map_points_[point[0]].encloses(point[1]))
+      if (it->second.encloses(point[1]))
         return false;
 
-      map_points_[point[0]].enlarge(point[1]);
+      it->second.enlarge(point[1]);
     }
     else
     {
       map_points_[point[0]] = DBoundingBox<1>(point[1], point[1]);
     }
+    bounding_box_.enlarge(point[0], point[1]);
 
     return true;
   }
@@ -246,41 +265,71 @@ namespace OpenMS
       throw Exception::NotImplemented(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
     }
 
-    if (map_points_.has(point[0]))
+    // find the two RT scans surrounding the point (keys are sorted by ascending RT):
+    HullPointType::ConstIterator it_lower = map_points_.lower_bound(point[0]); // first scan not before the point
+    HullPointType::ConstIterator it_upper = it_lower;
+    if (it_upper != map_points_.end() && it_upper->first == point[0])
     {
-      if (map_points_[point[0]].encloses(point[1]))
+      if (it_upper->second.encloses(point[1]))
         return true;
-    }
-
-    // find the two RT scans surrounding the point:
-    HullPointType::ConstIterator it_upper = map_points_.end(), it_lower = map_points_.end();
-    // iterate over keys (which are sorted by ascending RT)
-    for (HullPointType::ConstIterator it = map_points_.begin(); it != map_points_.end(); ++it)
-    {
-      // lower bound
-      if (((it->first) < (point[0])))
-        it_lower = it;
-      // upper bound
-      if ((it_upper == map_points_.end()) && ((it->first) > (point[0])))
-        it_upper = it;
+      ++it_upper;
     }
 
     // point is not between two scans
-    if ((it_lower == map_points_.end()) || (it_upper == map_points_.end()))
+    if ((it_lower == map_points_.begin()) || (it_upper == map_points_.end()))
       return false;
+    --it_lower;
 
     // check if point is within bounds
-    double mz_low = it_lower->second.minPosition()[0] // m/z offset
-                    + ((point[0] - (it_lower->first)) / ((it_upper->first) - (it_lower->first)))      // factor (0-1)
-                    * (it_upper->second.minPosition()[0] - it_lower->second.minPosition()[0]);                           // m/z range
+    return enclosedBetweenScans(point[0], point[1],
+                                it_lower->first, it_lower->second.minPosition()[0], it_lower->second.maxPosition()[0],
+                                it_upper->first, it_upper->second.minPosition()[0], it_upper->second.maxPosition()[0]);
+  }
+
+  void ConvexHull2D::encloses(const PointArrayType& points, std::vector<bool>& result) const
+  {
+    if ((map_points_.empty()) && outer_points_.size() > 0) // we cannot answer the query as we lack the internal data structure
+    {
+      throw Exception::NotImplemented(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
+    }
 
-    double mz_high = it_lower->second.maxPosition()[0] // m/z offset
-                     + ((point[0] - (it_lower->first)) / ((it_upper->first) - (it_lower->first)))     // factor (0-1)
-                     * (it_upper->second.maxPosition()[0] - it_lower->second.maxPosition()[0]);                          // m/z range
+    result.assign(points.size(), false);
+    if (map_points_.empty()) return;
 
+    // flat copy of the scans for the binary searches
+    std::vector<double> rts, mz_min, mz_max;
+    rts.reserve(map_points_.size());
+    mz_min.reserve(map_points_.size());
+    mz_max.reserve(map_points_.size());
+    for (HullPointType::ConstIterator it = map_points_.begin(); it != map_points_.end(); ++it)
+    {
+      rts.push_back(it->first);
+      mz_min.push_back(it->second.minPosition()[0]);
+      mz_max.push_back(it->second.maxPosition()[0]);
+    }
 
-    DBoundingBox<1> range(mz_low, mz_high);
-    return range.encloses(point[1]);
+    const Size n = rts.size();
+    for (Size i = 0; i < points.size(); ++i)
+    {
+      const double rt = points[i][0], mz = points[i][1];
+      // scans [0, lower_end) are before the point
+      const Size lower_end = std::lower_bound(rts.begin(), rts.end(), rt) - rts.begin();
+      Size upper = lower_end;
+      if (upper < n && rts[upper] == rt)
+      {
+        if (mz_min[upper] <= mz && mz <= mz_max[upper])
+        {
+          result[i] = true;
+          continue;
+        }
+        ++upper;
+      }
+      // point is not between two scans
+      if (lower_end == 0 || upper >= n) continue;
+
+      const Size lower = lower_end - 1;
+      result[i] = enclosedBetweenScans(rt, mz, rts[lower], mz_min[lower], mz_max[lower], rts[upper], mz_min[upper], mz_max[upper]);
+    }
   }
 
 } // namespace OpenMS
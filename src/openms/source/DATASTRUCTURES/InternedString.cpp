@@ -0,0 +1,101 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/DATASTRUCTURES/InternedString.h>
+
+#include <mutex>
+#include <unordered_set>
+
+namespace OpenMS
+{
+  namespace
+  {
+    struct InternPool
+    {
+      std::mutex mutex;
+      std::unordered_set<String> values; ///< node based: pointers to the values stay valid
+    };
+
+    /// the pool is never destroyed, so values stay valid during static destruction
+    InternPool& getPool()
+    {
+      static InternPool* pool = new InternPool();
+      return *pool;
+    }
+
+    const String* emptyValue()
+    {
+      static const String* empty = []()
+      {
+        InternPool& pool = getPool();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        return &*pool.values.insert(String()).first;
+      }();
+      return empty;
+    }
+  }
+
+  InternedString::InternedString() :
+    value_(emptyValue())
+  {
+  }
+
+  InternedString::InternedString(const String& s) :
+    value_(intern_(s))
+  {
+  }
+
+  InternedString& InternedString::operator=(const String& s)
+  {
+    value_ = intern_(s);
+    return *this;
+  }
+
+  Size InternedString::poolSize()
+  {
+    InternPool& pool = getPool();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    return pool.values.size();
+  }
+
+  const String* InternedString::intern_(const String& s)
+  {
+    if (s.empty()) return emptyValue();
+
+    InternPool& pool = getPool();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    return &*pool.values.insert(s).first;
+  }
+
+} // namespace OpenMS
@@ -0,0 +1,142 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg, Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/DATASTRUCTURES/NumericCodec.h>
+
+#include <OpenMS/DATASTRUCTURES/StringUtils.h>
+
+namespace OpenMS
+{
+  bool NumericCodec::parse(const char* begin, const char* end, double& value)
+  {
+    double result;
+    skipSpace_(begin, end);
+    if (!StringUtils::extractDouble(begin, end, result)) return false;
+    skipSpace_(begin, end);
+    if (begin != end) return false;
+    value = result;
+    return true;
+  }
+
+  bool NumericCodec::parse(const char* begin, const char* end, float& value)
+  {
+    float result;
+    skipSpace_(begin, end);
+    if (!StringUtils::extractFloat(begin, end, result)) return false;
+    skipSpace_(begin, end);
+    if (begin != end) return false;
+    value = result;
+    return true;
+  }
+
+  bool NumericCodec::parseInteger_(const char* begin, const char* end, Int64& value)
+  {
+    Int64 result;
+    skipSpace_(begin, end);
+    if (!boost::spirit::qi::parse(begin, end, boost::spirit::qi::int_parser<Int64>(), result)) return false;
+    skipSpace_(begin, end);
+    if (begin != end) return false;
+    value = result;
+    return true;
+  }
+
+  bool NumericCodec::parseInteger_(const char* begin, const char* end, UInt64& value)
+  {
+    UInt64 result;
+    skipSpace_(begin, end);
+    if (begin != end && *begin == '+') ++begin; // accepted by String::toInt(), but not by qi::uint_parser
+    if (!boost::spirit::qi::parse(begin, end, boost::spirit::qi::uint_parser<UInt64>(), result)) return false;
+    skipSpace_(begin, end);
+    if (begin != end) return false;
+    value = result;
+    return true;
+  }
+
+  Size NumericCodec::writeInteger_(Int64 value, char* buffer)
+  {
+    char* end = buffer;
+    boost::spirit::karma::generate(end, boost::spirit::karma::int_generator<Int64>(), value);
+    return end - buffer;
+  }
+
+  Size NumericCodec::writeInteger_(UInt64 value, char* buffer)
+  {
+    char* end = buffer;
+    boost::spirit::karma::generate(end, boost::spirit::karma::uint_generator<UInt64>(), value);
+    return end - buffer;
+  }
+
+  Size NumericCodec::write(double value, char* buffer, bool full_precision)
+  {
+    char* end = buffer;
+    if (full_precision)
+    {
+      boost::spirit::karma::generate(end, StringConversions::BK_PrecPolicyDouble, value);
+    }
+    else
+    {
+      boost::spirit::karma::generate(end, value);
+    }
+    return end - buffer;
+  }
+
+  Size NumericCodec::write(float value, char* buffer, bool full_precision)
+  {
+    char* end = buffer;
+    if (full_precision)
+    {
+      boost::spirit::karma::generate(end, StringConversions::BK_PrecPolicyFloat, value);
+    }
+    else
+    {
+      boost::spirit::karma::generate(end, value);
+    }
+    return end - buffer;
+  }
+
+  Size NumericCodec::write(long double value, char* buffer, bool full_precision)
+  {
+    char* end = buffer;
+    if (full_precision)
+    {
+      boost::spirit::karma::generate(end, StringConversions::BK_PrecPolicyLongDouble, value);
+    }
+    else
+    {
+      boost::spirit::karma::generate(end, value);
+    }
+    return end - buffer;
+  }
+
+} // namespace OpenMS
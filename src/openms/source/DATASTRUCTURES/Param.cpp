@@ -436,29 +436,74 @@ namespace OpenMS
   //********************************* Param **************************************
 
   Param::Param() :
-    root_("ROOT", "")
+    root_(std::make_shared<ParamNode>("ROOT", "")),
+    index_(),
+    lookups_(0)
   {
   }
 
+  Param::Param(const Param& rhs) :
+    root_(rhs.root_),
+    index_(std::atomic_load(&rhs.index_)),
+    lookups_(rhs.lookups_.load())
+  {
+  }
+
+  Param::Param(Param&& rhs) :
+    root_(std::move(rhs.root_)),
+    index_(std::atomic_load(&rhs.index_)),
+    lookups_(rhs.lookups_.load())
+  {
+    // leave a valid, empty Param behind
+    rhs.root_ = std::make_shared<ParamNode>("ROOT", "");
+    std::atomic_store(&rhs.index_, std::shared_ptr<const EntryIndex>());
+    rhs.lookups_ = 0;
+  }
+
   Param::~Param()
   {
   }
 
+  Param& Param::operator=(const Param& rhs)
+  {
+    if (&rhs == this) return *this;
+    root_ = rhs.root_;
+    std::atomic_store(&index_, std::atomic_load(&rhs.index_));
+    lookups_ = rhs.lookups_.load();
+    return *this;
+  }
+
+  Param& Param::operator=(Param&& rhs) &
+  {
+    if (&rhs == this) return *this;
+    root_.swap(rhs.root_);
+    std::shared_ptr<const EntryIndex> index = std::atomic_load(&rhs.index_);
+    std::atomic_store(&rhs.index_, std::atomic_load(&index_));
+    std::atomic_store(&index_, index);
+    const UInt lookups = rhs.lookups_.load();
+    rhs.lookups_ = lookups_.load();
+    lookups_ = lookups;
+    return *this;
+  }
+
   Param::Param(const ParamNode& node) :
-    root_(node)
+    root_(std::make_shared<ParamNode>(node)),
+    index_(),
+    lookups_(0)
   {
-    root_.name = "ROOT";
-    root_.description = "";
+    root_->name = "ROOT";
+    root_->description = "";
   }
 
   bool Param::operator==(const Param& rhs) const
   {
-    return root_ == rhs.root_;
+    return root_ == rhs.root_ || *root_ == *rhs.root_;
   }
 
   void Param::setValue(const String& key, const DataValue& value, const String& description, const StringList& tags)
   {
-    root_.insert(ParamEntry("", value, description, tags), key);
+    detach_();
+    root_->insert(ParamEntry("", value, description, tags), key);
   }
 
   void Param::setValidStrings(const String& key, const std::vector<String>& strings)
@@ -531,7 +576,7 @@ namespace OpenMS
     //static initialization and thus cannot rely on String::EMPTY been initialized.
     static String empty;
 
-    ParamNode* node = root_.findParentOf(key);
+    ParamNode* node = root_->findParentOf(key);
     if (node == nullptr)
     {
       return empty;
@@ -548,14 +593,17 @@ namespace OpenMS
 
   void Param::insert(const String& prefix, const Param& param)
   {
+    // keep the other tree alive (and unchanged) if it is shared with this one
+    const std::shared_ptr<ParamNode> other = param.root_;
+    detach_();
     //std::cerr << "INSERT PARAM (" << prefix << ")" << std::endl;
-    for (Param::ParamNode::NodeIterator it = param.root_.nodes.begin(); it != param.root_.nodes.end(); ++it)
+    for (Param::ParamNode::NodeIterator it = other->nodes.begin(); it != other->nodes.end(); ++it)
     {
-      root_.insert(*it, prefix);
+      root_->insert(*it, prefix);
     }
-    for (Param::ParamNode::EntryIterator it = param.root_.entries.begin(); it != param.root_.entries.end(); ++it)
+    for (Param::ParamNode::EntryIterator it = other->entries.begin(); it != other->entries.end(); ++it)
     {
-      root_.insert(*it, prefix);
+      root_->insert(*it, prefix);
     }
   }
 
@@ -575,7 +623,8 @@ namespace OpenMS
         if (showMessage)
           std::cerr << "Setting " << prefix2 + it.getName() << " to " << it->value << std::endl;
         String name = prefix2 + it.getName();
-        root_.insert(ParamEntry("", it->value, it->description), name);
+        detach_();
+        root_->insert(ParamEntry("", it->value, it->description), name);
         //copy tags
         for (std::set<String>::const_iterator tag_it = it->tags.begin(); tag_it != it->tags.end(); ++tag_it)
         {
@@ -628,12 +677,13 @@ namespace OpenMS
 
   void Param::remove(const String& key)
   {
+    detach_();
     String keyname = key;
     if (key.hasSuffix(':')) // delete section
     {
       keyname = key.chop(1);
 
-      ParamNode* node_parent = root_.findParentOf(keyname);
+      ParamNode* node_parent = root_->findParentOf(keyname);
       if (node_parent != nullptr)
       {
         Param::ParamNode::NodeIterator it = node_parent->findNode(node_parent->suffix(keyname));
@@ -651,7 +701,7 @@ namespace OpenMS
     }
     else
     {
-      ParamNode* node = root_.findParentOf(keyname);
+      ParamNode* node = root_->findParentOf(keyname);
       if (node != nullptr)
       {
         String entryname = node->suffix(keyname); // get everything beyond last ':'
@@ -671,9 +721,10 @@ namespace OpenMS
 
   void Param::removeAll(const String& prefix)
   {
+    detach_();
     if (prefix.hasSuffix(':')) //we have to delete one node only (and its subnodes)
     {
-      ParamNode* node = root_.findParentOf(prefix.chop(1));
+      ParamNode* node = root_->findParentOf(prefix.chop(1));
       if (node != nullptr)
       {
         Param::ParamNode::NodeIterator it = node->findNode(node->suffix(prefix.chop(1)));
@@ -691,7 +742,7 @@ namespace OpenMS
     }
     else //we have to delete all entries and nodes starting with the prefix
     {
-      ParamNode* node = root_.findParentOf(prefix);
+      ParamNode* node = root_->findParentOf(prefix);
       if (node != nullptr)
       {
         String suffix = node->suffix(prefix); // name behind last ":"
@@ -732,10 +783,10 @@ namespace OpenMS
   {
     ParamNode out("ROOT", "");
 
-    for (const auto& entry : subset.root_.entries)
+    for (const auto& entry : subset.root_->entries)
     {
-      const auto& n = root_.findEntry(entry.name);
-      if (n == root_.entries.end())
+      const auto& n = root_->findEntry(entry.name);
+      if (n == root_->entries.end())
       {
         OPENMS_LOG_WARN << "Warning: Trying to copy non-existent parameter entry " << entry.name << std::endl;
       }
@@ -745,10 +796,10 @@ namespace OpenMS
       }
     }
 
-    for (const auto& node : subset.root_.nodes)
+    for (const auto& node : subset.root_->nodes)
     {
-      const auto& n = root_.findNode(node.name);
-      if (n == root_.nodes.end())
+      const auto& n = root_->findNode(node.name);
+      if (n == root_->nodes.end())
       {
         OPENMS_LOG_WARN << "Warning: Trying to copy non-existent parameter node " << node.name << std::endl;
       }
@@ -764,7 +815,7 @@ namespace OpenMS
   {
     ParamNode out("ROOT", "");
 
-    ParamNode* node = root_.findParentOf(prefix);
+    ParamNode* node = root_->findParentOf(prefix);
     if (node == nullptr)
     {
       return Param();
@@ -823,6 +874,7 @@ namespace OpenMS
 
   void Param::parseCommandLine(const int argc, const char** argv, const String& prefix)
   {
+    detach_();
     //determine prefix
     String prefix2 = prefix;
     if (prefix2 != "")
@@ -855,25 +907,25 @@ namespace OpenMS
       //flag (option without text argument)
       if (arg_is_option && arg1_is_option)
       {
-        root_.insert(ParamEntry(arg, String(), ""), prefix2);
+        root_->insert(ParamEntry(arg, String(), ""), prefix2);
       }
       //option with argument
       else if (arg_is_option && !arg1_is_option)
       {
-        root_.insert(ParamEntry(arg, arg1, ""), prefix2);
+        root_->insert(ParamEntry(arg, arg1, ""), prefix2);
         ++i;
       }
       //just text arguments (not preceded by an option)
       else
       {
 
-        ParamEntry* misc_entry = root_.findEntryRecursive(prefix2 + "misc");
+        ParamEntry* misc_entry = root_->findEntryRecursive(prefix2 + "misc");
         if (misc_entry == nullptr)
         {
           StringList sl;
           sl.push_back(arg);
           // create "misc"-Node:
-          root_.insert(ParamEntry("misc", sl, ""), prefix2);
+          root_->insert(ParamEntry("misc", sl, ""), prefix2);
         }
         else
         {
@@ -887,6 +939,7 @@ namespace OpenMS
 
   void Param::parseCommandLine(const int argc, const char** argv, const Map<String, String>& options_with_one_argument, const Map<String, String>& options_without_argument, const Map<String, String>& options_with_multiple_argument, const String& misc, const String& unknown)
   {
+    detach_();
     //determine misc key
     String misc_key = misc;
 
@@ -920,7 +973,7 @@ namespace OpenMS
         //next argument is an option
         if (arg1_is_option)
         {
-          root_.insert(ParamEntry("", StringList(), ""), options_with_multiple_argument.find(arg)->second);
+          root_->insert(ParamEntry("", StringList(), ""), options_with_multiple_argument.find(arg)->second);
         }
         //next argument is not an option
         else
@@ -935,14 +988,14 @@ namespace OpenMS
               arg1 = argv[j];
           }
 
-          root_.insert(ParamEntry("", sl, ""), options_with_multiple_argument.find(arg)->second);
+          root_->insert(ParamEntry("", sl, ""), options_with_multiple_argument.find(arg)->second);
           i = j - 1;
         }
       }
       //without argument
       else if (options_without_argument.has(arg))
       {
-        root_.insert(ParamEntry("", String("true"), ""), options_without_argument.find(arg)->second);
+        root_->insert(ParamEntry("", String("true"), ""), options_without_argument.find(arg)->second);
       }
       //with one argument
       else if (options_with_one_argument.has(arg))
@@ -950,25 +1003,25 @@ namespace OpenMS
         //next argument is not an option
         if (!arg1_is_option)
         {
-          root_.insert(ParamEntry("", arg1, ""), options_with_one_argument.find(arg)->second);
+          root_->insert(ParamEntry("", arg1, ""), options_with_one_argument.find(arg)->second);
           ++i;
         }
         //next argument is an option
         else
         {
 
-          root_.insert(ParamEntry("", String(), ""), options_with_one_argument.find(arg)->second);
+          root_->insert(ParamEntry("", String(), ""), options_with_one_argument.find(arg)->second);
         }
       }
       //unknown option
       else if (arg_is_option)
       {
-        ParamEntry* unknown_entry = root_.findEntryRecursive(unknown);
+        ParamEntry* unknown_entry = root_->findEntryRecursive(unknown);
         if (unknown_entry == nullptr)
         {
           StringList sl;
           sl.push_back(arg);
-          root_.insert(ParamEntry("", sl, ""), unknown);
+          root_->insert(ParamEntry("", sl, ""), unknown);
         }
         else
         {
@@ -980,13 +1033,13 @@ namespace OpenMS
       //just text argument
       else
       {
-        ParamEntry* misc_entry = root_.findEntryRecursive(misc);
+        ParamEntry* misc_entry = root_->findEntryRecursive(misc);
         if (misc_entry == nullptr)
         {
           StringList sl;
           sl.push_back(arg);
           // create "misc"-Node:
-          root_.insert(ParamEntry("", sl, ""), misc);
+          root_->insert(ParamEntry("", sl, ""), misc);
         }
         else
         {
@@ -1019,7 +1072,7 @@ namespace OpenMS
 
   Size Param::size() const
   {
-    return root_.size();
+    return root_->size();
   }
 
   bool Param::empty() const
@@ -1029,7 +1082,8 @@ namespace OpenMS
 
   void Param::clear()
   {
-    root_ = ParamNode("ROOT", "");
+    root_ = std::make_shared<ParamNode>("ROOT", "");
+    detach_();
   }
 
   void Param::checkDefaults(const String& name, const Param& defaults, const String& prefix) const
@@ -1055,7 +1109,7 @@ namespace OpenMS
       }
 
       //different types
-      ParamEntry* default_value = defaults.root_.findEntryRecursive(prefix2 + it.getName());
+      ParamEntry* default_value = defaults.root_->findEntryRecursive(prefix2 + it.getName());
       if (default_value == nullptr)
         continue;
       if (default_value->value.valueType() != it->value.valueType())
@@ -1220,7 +1274,8 @@ OPENMS_THREAD_CRITICAL(oms_log)
             {
               prefix = it.getName().substr(0, 1 + it.getName().find_last_of(':'));
             }
-            this->root_.insert(local_entry, prefix); //->setValue(it.getName(), local_entry.value, local_entry.description, local_entry.tags);
+            detach_();
+            this->root_->insert(local_entry, prefix); //->setValue(it.getName(), local_entry.value, local_entry.description, local_entry.tags);
           }
           else if (verbose)
           {
@@ -1297,6 +1352,7 @@ OPENMS_THREAD_CRITICAL(oms_log)
 
   void Param::merge(const OpenMS::Param& toMerge)
   {
+    detach_();
     // keep track of the path inside the param tree
     String pathname;
 
@@ -1312,7 +1368,7 @@ OPENMS_THREAD_CRITICAL(oms_log)
       {
         Param::ParamEntry entry = *it;
         OPENMS_LOG_DEBUG << "[Param::merge] merging " << it.getName() << std::endl;
-        this->root_.insert(entry, prefix);
+        this->root_->insert(entry, prefix);
       }
 
       //copy section descriptions
@@ -1347,28 +1403,38 @@ OPENMS_THREAD_CRITICAL(oms_log)
 
   void Param::setSectionDescription(const String& key, const String& description)
   {
-    ParamNode* node = root_.findParentOf(key);
-    if (node == nullptr)
+    auto find_section = [&key, this]()
     {
-      throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, key);
-    }
+      ParamNode* node = root_->findParentOf(key);
+      if (node == nullptr)
+      {
+        throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, key);
+      }
+      Param::ParamNode::NodeIterator it = node->findNode(node->suffix(key));
+      if (it == node->nodes.end())
+      {
+        throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, key);
+      }
+      return it;
+    };
 
-    Param::ParamNode::NodeIterator it = node->findNode(node->suffix(key));
-    if (it == node->nodes.end())
+    if (find_section()->description == description)
     {
-      throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, key);
+      return; // unchanged, no need to un-share the tree
     }
-    it->description = description;
+    detach_();
+    find_section()->description = description;
   }
 
   void Param::addSection(const String& key, const String& description)
   {
-    root_.insert(ParamNode("",description),key);
+    detach_();
+    root_->insert(ParamNode("",description),key);
   }
 
   Param::ParamIterator Param::begin() const
   {
-    return ParamIterator(root_);
+    return ParamIterator(*root_);
   }
 
   Param::ParamIterator Param::end() const
@@ -1552,7 +1618,7 @@ OPENMS_THREAD_CRITICAL(oms_log)
 
   StringList Param::getTags(const String& key) const
   {
-    ParamEntry& entry = getEntry_(key);
+    const ParamEntry& entry = getEntry_(key);
     StringList list;
     for (std::set<String>::const_iterator it = entry.tags.begin(); it != entry.tags.end(); ++it)
     {
@@ -1573,12 +1639,68 @@ OPENMS_THREAD_CRITICAL(oms_log)
 
   bool Param::exists(const String& key) const
   {
-    return root_.findEntryRecursive(key);
+    return findEntry_(key) != nullptr;
+  }
+
+  Param::ParamEntry* Param::findEntry_(const String& key) const
+  {
+    // Parameters which are still being assembled (e.g. while registering defaults) are modified and queried in turns.
+    // An index is only built once a number of lookups happened without modification, otherwise the tree is searched.
+    static constexpr UInt lookups_before_indexing = 16;
+
+    std::shared_ptr<const EntryIndex> index = std::atomic_load(&index_);
+    if (!index)
+    {
+      if (++lookups_ < lookups_before_indexing)
+      {
+        return root_->findEntryRecursive(key);
+      }
+      std::shared_ptr<EntryIndex> new_index = std::make_shared<EntryIndex>();
+      indexEntries_(*root_, "", *new_index);
+      index = new_index;
+      std::atomic_store(&index_, index); // concurrent readers might build the same index, one of them wins
+    }
+    const auto it = index->find(key);
+    return it == index->end() ? nullptr : it->second;
+  }
+
+  void Param::indexEntries_(ParamNode& node, const String& prefix, EntryIndex& index)
+  {
+    for (ParamEntry& entry : node.entries)
+    {
+      index.emplace(prefix + entry.name, &entry); // first one wins, as in ParamNode::findEntry()
+    }
+    for (ParamNode& child : node.nodes)
+    {
+      indexEntries_(child, prefix + child.name + ":", index);
+    }
+  }
+
+  void Param::detach_()
+  {
+    if (root_.use_count() > 1)
+    {
+      root_ = std::make_shared<ParamNode>(*root_);
+    }
+    std::atomic_store(&index_, std::shared_ptr<const EntryIndex>());
+    lookups_ = 0;
+  }
+
+  const Param::ParamEntry& Param::getEntry_(const String& key) const
+  {
+    const ParamEntry* entry = findEntry_(key);
+    if (entry == nullptr)
+    {
+      throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, key);
+    }
+
+    return *entry;
   }
 
-  Param::ParamEntry& Param::getEntry_(const String& key) const
+  Param::ParamEntry& Param::getEntry_(const String& key)
   {
-    ParamEntry* entry = root_.findEntryRecursive(key);
+    detach_();
+    ParamEntry* entry = root_->findEntryRecursive(key);
     if (entry == nullptr)
     {
       throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, key);
@@ -0,0 +1,127 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/DATASTRUCTURES/RadixSort.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+namespace OpenMS
+{
+  namespace RadixSort
+  {
+    namespace
+    {
+      /// below this size std::stable_sort is faster
+      const Size MIN_RADIX_SIZE = 1024;
+      const UInt DIGIT_BITS = 11;
+      const UInt NUM_BUCKETS = 1u << DIGIT_BITS;
+
+      /// maps a double to an unsigned integer with the same order
+      inline std::uint64_t orderedBits(double value)
+      {
+        if (std::isnan(value)) return std::numeric_limits<std::uint64_t>::max();
+        if (value == 0.0) value = 0.0; // -0.0 == 0.0
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        // negative numbers: flip all bits (reverses their order), positive numbers: set the sign bit
+        return (bits & 0x8000000000000000ULL) ? ~bits : (bits | 0x8000000000000000ULL);
+      }
+    }
+
+    std::vector<Size> sortPermutation(const std::vector<double>& keys)
+    {
+      const Size n = keys.size();
+      std::vector<Size> result(n);
+      std::iota(result.begin(), result.end(), 0);
+      if (n < MIN_RADIX_SIZE)
+      {
+        std::stable_sort(result.begin(), result.end(), [&keys](Size a, Size b) { return orderedBits(keys[a]) < orderedBits(keys[b]); });
+        return result;
+      }
+
+      // key and index are moved together for memory locality
+      struct Entry
+      {
+        std::uint64_t bits;
+        Size index;
+      };
+      std::vector<Entry> entries(n), entries_tmp(n);
+      const UInt num_passes = (64 + DIGIT_BITS - 1) / DIGIT_BITS;
+      // histograms of all digits, computed in a single pass over the keys
+      std::vector<Size> count(num_passes * NUM_BUCKETS);
+      for (Size i = 0; i < n; ++i)
+      {
+        const std::uint64_t bits = orderedBits(keys[i]);
+        entries[i] = Entry{bits, i};
+        for (UInt pass = 0; pass < num_passes; ++pass)
+        {
+          ++count[pass * NUM_BUCKETS + ((bits >> (pass * DIGIT_BITS)) & (NUM_BUCKETS - 1))];
+        }
+      }
+
+      for (UInt pass = 0; pass < num_passes; ++pass)
+      {
+        const UInt shift = pass * DIGIT_BITS;
+        Size* bucket = &count[pass * NUM_BUCKETS];
+        // all keys share this digit (typical for the high bits): nothing to do
+        if (bucket[(entries[0].bits >> shift) & (NUM_BUCKETS - 1)] == n) continue;
+
+        // exclusive prefix sums: start of each bucket
+        Size sum = 0;
+        for (UInt b = 0; b < NUM_BUCKETS; ++b)
+        {
+          const Size c = bucket[b];
+          bucket[b] = sum;
+          sum += c;
+        }
+        for (const Entry& e : entries)
+        {
+          entries_tmp[bucket[(e.bits >> shift) & (NUM_BUCKETS - 1)]++] = e;
+        }
+        entries.swap(entries_tmp);
+      }
+
+      for (Size i = 0; i < n; ++i)
+      {
+        result[i] = entries[i].index;
+      }
+      return result;
+    }
+  }
+} // namespace OpenMS
@@ -532,7 +532,7 @@ namespace OpenMS
   ::size_t hash_value(String const& s)
   {
     boost::hash<std::string> hasher;
-    return hasher(static_cast<std::string>(s));
+    return hasher(static_cast<const std::string&>(s));
   }
 
 } // namespace OpenMS
@@ -5,6 +5,7 @@ set(directory source/DATASTRUCTURES)
 set(sources_list
 Adduct.cpp
 BinaryTreeNode.cpp
+BoundingBoxIndex.cpp
 CalibrationData.cpp
 ChargePair.cpp
 Compomer.cpp
@@ -25,6 +26,7 @@ DefaultParamHandler.cpp
 DistanceMatrix.cpp
 FASTAContainer.cpp
 GridFeature.cpp
+InternedString.cpp
 ListUtils.cpp
 ListUtilsIO.cpp
 LPWrapper.cpp
@@ -32,8 +34,10 @@ Map.cpp
 MassExplainer.cpp
 MatchedIterator.cpp
 Matrix.cpp
+NumericCodec.cpp
 Param.cpp
 QTCluster.cpp
+RadixSort.cpp
 String.cpp
 StringListUtils.cpp
 StringUtils.cpp
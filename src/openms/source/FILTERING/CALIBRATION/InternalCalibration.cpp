@@ -35,8 +35,10 @@
 
 #include <OpenMS/FILTERING/CALIBRATION/InternalCalibration.h>
 
+#include <OpenMS/CONCEPT/ParallelExecution.h>
 #include <OpenMS/FORMAT/SVOutStream.h>
 #include <OpenMS/KERNEL/FeatureMap.h>
+#include <OpenMS/KERNEL/MSSpectrumSoA.h>
 #include <OpenMS/MATH/STATISTICS/StatisticFunctions.h>
 #include <OpenMS/MATH/MISC/MathFunctions.h>
 #include <OpenMS/SYSTEM/File.h>
@@ -69,13 +71,10 @@ namespace OpenMS
   
   void InternalCalibration::applyTransformation_(PeakMap::SpectrumType& spec, const MZTrafoModel& trafo)
   {
-    typedef PeakMap::SpectrumType::Iterator SpecIt;
-
-    // calibrate the spectrum itself
-    for (SpecIt it = spec.begin(); it != spec.end(); ++it)
-    {
-      it->setMZ(trafo.predict(it->getMZ()));
-    }
+    // calibrate the spectrum itself (on a contiguous copy of the m/z values)
+    MSSpectrumSoA soa(spec);
+    trafo.predict(soa.mz());
+    soa.writeTo(spec);
   }
 
   void InternalCalibration::applyTransformation(PeakMap::SpectrumType& spec, const IntList& target_mslvl, const MZTrafoModel& trafo)
@@ -94,13 +93,13 @@ namespace OpenMS
 
   void InternalCalibration::applyTransformation(PeakMap& exp, const IntList& target_mslvl, const MZTrafoModel& trafo)
   {
-    for (PeakMap::Iterator it = exp.begin(); it != exp.end(); ++it)
+    ParallelExecution::forEach(0, (SignedSize)exp.size(), [&](SignedSize i)
     {
-      applyTransformation(*it, target_mslvl, trafo);
-    }
+      applyTransformation(exp[i], target_mslvl, trafo);
+    });
   }
 
-  Size InternalCalibration::fillCalibrants(const PeakMap exp,
+  Size InternalCalibration::fillCalibrants(const PeakMap& exp,
                                            const std::vector<InternalCalibration::LockMass>& ref_masses,
                                            double tol_ppm,
                                            bool lock_require_mono,
@@ -113,28 +112,33 @@ namespace OpenMS
     //
     // find lock masses in data and build calibrant table
     //
-    std::map<Size, Size> stats_cal_per_spectrum;
-    typedef PeakMap::ConstIterator ExpCIt;
-    for (ExpCIt it = exp.begin(); it != exp.end(); ++it)
+    // The spectra are searched in parallel. The calibrants of each spectrum are collected
+    // separately and inserted in spectrum order afterwards, so the result does not depend
+    // on the number of threads.
+    struct LockMassHit
     {
-      // empty spectrum
-      if (it->empty()) {
-        ++stats_cal_per_spectrum[0];
-        continue;
-      }
-
-      Size cnt_cd = cal_data_.size();
+      double rt, mz_obs, intensity, mz_ref, weight;
+      int group;
+      bool failed;
+    };
+    std::vector<std::vector<LockMassHit> > hits(exp.size());
+    ParallelExecution::forEach(0, (SignedSize)exp.size(), [&](SignedSize i)
+    {
+      const MSSpectrum& spec = exp[i];
+      if (spec.empty()) return;
+      std::vector<LockMassHit>& spec_hits = hits[i];
       // iterate over calibrants
       for (std::vector<InternalCalibration::LockMass>::const_iterator itl = ref_masses.begin(); itl != ref_masses.end(); ++itl)
       {
         // calibrant meant for this MS level?
-        if (it->getMSLevel() != itl->ms_level) continue;
+        if (spec.getMSLevel() != itl->ms_level) continue;
 
-        Size s = it->findNearest(itl->mz);
-        const double mz_obs = (*it)[s].getMZ();
+        const int group = (int)std::distance(ref_masses.begin(), itl);
+        Size s = spec.findNearest(itl->mz);
+        const double mz_obs = spec[s].getMZ();
         if (Math::getPPMAbs(mz_obs, itl->mz) > tol_ppm)
         {
-          failed_lock_masses.insertCalibrationPoint(it->getRT(), itl->mz, 0.0, itl->mz, 0.0, std::distance(ref_masses.begin(), itl));
+          spec_hits.push_back({spec.getRT(), itl->mz, 0.0, itl->mz, 0.0, group, true});
         }
         else
         {
@@ -142,11 +146,11 @@ namespace OpenMS
           {
             // check if its the monoisotopic .. discard otherwise
             const double mz_iso_left = mz_obs - (Constants::C13C12_MASSDIFF_U / itl->charge);
-            Size s_left = it->findNearest(mz_iso_left);
-            if (Math::getPPMAbs(mz_iso_left, (*it)[s_left].getMZ()) < 0.5) // intra-scan ppm should be very good!
+            Size s_left = spec.findNearest(mz_iso_left);
+            if (Math::getPPMAbs(mz_iso_left, spec[s_left].getMZ()) < 0.5) // intra-scan ppm should be very good!
             { // peak nearby lock mass was not the monoisotopic
-              if (verbose) OPENMS_LOG_INFO << "peak at [RT, m/z] " << it->getRT() << ", " << (*it)[s].getMZ() << " is NOT monoisotopic. Skipping it!\n";
-              failed_lock_masses.insertCalibrationPoint(it->getRT(), itl->mz, 1.0, itl->mz, 0.0, std::distance(ref_masses.begin(), itl));
+              if (verbose) OPENMS_LOG_INFO << "peak at [RT, m/z] " << spec.getRT() << ", " << spec[s].getMZ() << " is NOT monoisotopic. Skipping it!\n";
+              spec_hits.push_back({spec.getRT(), itl->mz, 1.0, itl->mz, 0.0, group, true});
               continue;
             }
           }
@@ -154,17 +158,34 @@ namespace OpenMS
           {
             // require it to have a +1 isotope?!
             const double mz_iso_right = mz_obs + Constants::C13C12_MASSDIFF_U / itl->charge;
-            Size s_right = it->findNearest(mz_iso_right);
-            if (!(Math::getPPMAbs(mz_iso_right, (*it)[s_right].getMZ()) < 0.5)) // intra-scan ppm should be very good!
+            Size s_right = spec.findNearest(mz_iso_right);
+            if (!(Math::getPPMAbs(mz_iso_right, spec[s_right].getMZ()) < 0.5)) // intra-scan ppm should be very good!
             { // peak has no +1iso.. weird
-              if (verbose) OPENMS_LOG_INFO << "peak at [RT, m/z] " << it->getRT() << ", " << (*it)[s].getMZ() << " has no +1 isotope (ppm to closest: " << Math::getPPM(mz_iso_right, (*it)[s_right].getMZ()) << ")... Skipping it!\n";
-              failed_lock_masses.insertCalibrationPoint(it->getRT(), itl->mz, 2.0, itl->mz, 0.0, std::distance(ref_masses.begin(), itl));
+              if (verbose) OPENMS_LOG_INFO << "peak at [RT, m/z] " << spec.getRT() << ", " << spec[s].getMZ() << " has no +1 isotope (ppm to closest: " << Math::getPPM(mz_iso_right, spec[s_right].getMZ()) << ")... Skipping it!\n";
+              spec_hits.push_back({spec.getRT(), itl->mz, 2.0, itl->mz, 0.0, group, true});
               continue;
             }
           }
-          cal_data_.insertCalibrationPoint(it->getRT(), mz_obs, (*it)[s].getIntensity(), itl->mz, std::log((*it)[s].getIntensity()), std::distance(ref_masses.begin(), itl));
+          spec_hits.push_back({spec.getRT(), mz_obs, spec[s].getIntensity(), itl->mz, std::log(spec[s].getIntensity()), group, false});
         }
       }
+    }, ParallelExecution::Schedule::DYNAMIC, 64);
+
+    std::map<Size, Size> stats_cal_per_spectrum;
+    for (Size i = 0; i < exp.size(); ++i)
+    {
+      // empty spectrum
+      if (exp[i].empty())
+      {
+        ++stats_cal_per_spectrum[0];
+        continue;
+      }
+      Size cnt_cd = cal_data_.size();
+      for (const LockMassHit& h : hits[i])
+      {
+        CalibrationData& target = h.failed ? failed_lock_masses : cal_data_;
+        target.insertCalibrationPoint(h.rt, h.mz_obs, h.intensity, h.mz_ref, h.weight, h.group);
+      }
       // how many locks found in this spectrum?!
       ++stats_cal_per_spectrum[cal_data_.size()-cnt_cd];
     }
@@ -300,6 +321,8 @@ namespace OpenMS
     else
     { // one model per spectrum (not all might be needed, if certain MS levels are excluded from calibration)
       tms.reserve(exp.size());
+      // pairs of (index into exp[], index into tms[]); the models are applied in parallel once all are known
+      std::vector<std::pair<Size, Size> > spectrum_to_model;
       // go through spectra and calibrate
       Size i(0), i_mslvl(0);
       for (PeakMap::Iterator it = exp.begin(); it != exp.end(); ++it, ++i)
@@ -324,7 +347,7 @@ namespace OpenMS
         }
         else
         {
-          applyTransformation(*it, target_mslvl, tms.back());
+          spectrum_to_model.emplace_back(i, i_mslvl);
         }
         ++i_mslvl;
       } // MSExp::iter
@@ -363,13 +386,19 @@ namespace OpenMS
           {
             model_index = p + dist_right;
           }
-          applyTransformation(exp[it->second], target_mslvl, tms[model_index]);
+          spectrum_to_model.emplace_back(it->second, model_index); // valid models do not change below
           tms_new[p].setCoefficients(tms[model_index]); // overwrite invalid model
         }
         tms_new.swap(tms);
         // consistency check: all models must be valid at this point
         for (Size j = 0; j < tms.size(); ++j) if (!MZTrafoModel::isValidModel(tms[j])) throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "InternalCalibration::calibrate(): Internal error. Not all models are valid!", String(j));
       }
+
+      // apply the models (each spectrum is calibrated exactly once)
+      ParallelExecution::forEach(0, (SignedSize)spectrum_to_model.size(), [&](SignedSize j)
+      {
+        applyTransformation(exp[spectrum_to_model[j].first], target_mslvl, tms[spectrum_to_model[j].second]);
+      });
     }
     endProgress();
 
@@ -132,6 +132,38 @@ namespace OpenMS
     return predict;
   }
 
+  void MZTrafoModel::predict(std::vector<double>& mzs) const
+  {
+    const double a = coeff_[0];
+    const double b = coeff_[1];
+    const double c = coeff_[2];
+    double* mz = mzs.data();
+    const Size n = mzs.size();
+    // same arithmetic as predict(double); for linear models (c == 0) the power term is a no-op
+    if (use_ppm_)
+    {
+      if (c == 0.0)
+      {
+        for (Size i = 0; i < n; ++i) mz[i] = Math::ppmToMass(-(a + b * mz[i]), mz[i]) + mz[i];
+      }
+      else
+      {
+        for (Size i = 0; i < n; ++i) mz[i] = Math::ppmToMass(-(a + b * mz[i] + c * mz[i] * mz[i]), mz[i]) + mz[i];
+      }
+    }
+    else
+    {
+      if (c == 0.0)
+      {
+        for (Size i = 0; i < n; ++i) mz[i] = -(a + b * mz[i]) + mz[i];
+      }
+      else
+      {
+        for (Size i = 0; i < n; ++i) mz[i] = -(a + b * mz[i] + c * mz[i] * mz[i]) + mz[i];
+      }
+    }
+  }
+
   bool MZTrafoModel::train( const CalibrationData& cd, MODELTYPE md, bool use_RANSAC, double rt_left /*= -std::numeric_limits<double>::max()*/, double rt_right /*= std::numeric_limits<double>::max() */ )
   {
     std::vector<double> obs_mz;
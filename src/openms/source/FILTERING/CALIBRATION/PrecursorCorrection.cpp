@@ -38,6 +38,9 @@
 
 #include <OpenMS/METADATA/Precursor.h>
 #include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/CONCEPT/ParallelExecution.h>
+
+#include <unordered_map>
 
 
 using namespace std;
@@ -89,6 +92,109 @@ namespace OpenMS
       csv_file.close();
     }
 
+    vector<Size> PrecursorCorrection::getSurveyScanIndex(const MSExperiment & exp)
+    {
+      // single forward pass, equivalent to MSExperiment::getPrecursorSpectrum() for every MS2 spectrum
+      vector<Size> survey_scans(exp.size(), exp.size());
+      unordered_map<String, Size> ms1_by_native_id; // most recent MS1 spectrum of each native ID
+      Size last_ms1 = exp.size();
+      for (Size i = 0; i != exp.size(); ++i)
+      {
+        const MSSpectrum& spec = exp[i];
+        if (spec.getMSLevel() == 1)
+        {
+          ms1_by_native_id[spec.getNativeID()] = i;
+          last_ms1 = i;
+          continue;
+        }
+        if (spec.getMSLevel() != 2) continue;
+        // the spectrum referenced by the (first) precursor takes precedence
+        if (!spec.getPrecursors().empty() && spec.getPrecursors()[0].metaValueExists("spectrum_ref"))
+        {
+          unordered_map<String, Size>::const_iterator it = ms1_by_native_id.find(spec.getPrecursors()[0].getMetaValue("spectrum_ref"));
+          if (it != ms1_by_native_id.end())
+          {
+            survey_scans[i] = it->second;
+            continue;
+          }
+        }
+        survey_scans[i] = last_ms1;
+      }
+      return survey_scans;
+    }
+
+    int PrecursorCorrection::findNearestMS1Peak(const MSSpectrum & survey_scan,
+                                                double mz,
+                                                double mz_tolerance,
+                                                bool ppm)
+    {
+      if (survey_scan.empty()) return -1;
+
+      // find peak (index) closest to expected position
+      Size nearest_peak_idx = survey_scan.findNearest(mz);
+
+      // get actual position of closest peak
+      double nearest_peak_mz = survey_scan[nearest_peak_idx].getMZ();
+
+      // calculate error between expected and actual position
+      double nearestPeakError = ppm ? abs(nearest_peak_mz - mz)/mz * 1e6 : abs(nearest_peak_mz - mz);
+
+      // check if error is small enough
+      return nearestPeakError < mz_tolerance ? (int)nearest_peak_idx : -1;
+    }
+
+    int PrecursorCorrection::findHighestIntensityMS1Peak(const MSSpectrum & survey_scan,
+                                                         double mz,
+                                                         double mz_tolerance,
+                                                         bool ppm)
+    {
+      // get tolerance window and index of highest peak
+      std::pair<double,double> tolerance_window = Math::getTolWindow(mz, mz_tolerance, ppm);
+      return survey_scan.findHighestInWindow(mz, mz-tolerance_window.first, tolerance_window.second-mz);
+    }
+
+    namespace
+    {
+      /// result of the correction of one precursor
+      struct PrecursorMatch_
+      {
+        Size spectrum_idx = 0; ///< index of the MS2 spectrum
+        bool has_survey_scan = false; ///< was an MS1 spectrum found?
+        int peak_idx = -1; ///< index of the matching peak in the MS1 spectrum (-1 if none)
+        double peak_mz = 0.0;
+        double peak_intensity = 0.0;
+      };
+
+      /// finds the survey scan and the matching peak of every precursor (in parallel), @p find_peak selects the method
+      template <typename FindPeak>
+      vector<PrecursorMatch_> matchPrecursors_(const MSExperiment & exp,
+                                               const vector<Precursor> & precursors,
+                                               const vector<double> & precursors_rt,
+                                               const FindPeak & find_peak)
+      {
+        const vector<Size> survey_scans = PrecursorCorrection::getSurveyScanIndex(exp);
+        vector<PrecursorMatch_> matches(precursors_rt.size());
+        ParallelExecution::forEach(0, (SignedSize)precursors_rt.size(), [&](SignedSize i)
+        {
+          PrecursorMatch_& match = matches[i];
+
+          // retrieves iterator of the MS2 fragment spectrum and store its index
+          match.spectrum_idx = exp.RTBegin(precursors_rt[i] - 1e-8) - exp.begin();
+
+          // get parent (MS1) of precursor spectrum
+          if (match.spectrum_idx >= exp.size() || survey_scans[match.spectrum_idx] == exp.size()) return;
+          match.has_survey_scan = true;
+          const MSSpectrum& survey_scan = exp[survey_scans[match.spectrum_idx]];
+
+          match.peak_idx = find_peak(survey_scan, precursors[i].getMZ());
+          if (match.peak_idx == -1) return;
+          match.peak_mz = survey_scan[match.peak_idx].getMZ();
+          match.peak_intensity = survey_scan[match.peak_idx].getIntensity();
+        }, ParallelExecution::Schedule::DYNAMIC, 256);
+        return matches;
+      }
+    }
+
      set<Size> PrecursorCorrection::correctToNearestMS1Peak(MSExperiment & exp,
                                                             double mz_tolerance,
                                                             bool ppm,
@@ -103,63 +209,39 @@ namespace OpenMS
       vector<Size> precursor_scan_index;
       getPrecursors(exp, precursors, precursors_rt, precursor_scan_index);
 
+      const vector<PrecursorMatch_> matches = matchPrecursors_(exp, precursors, precursors_rt,
+        [&](const MSSpectrum& survey_scan, double mz) { return findNearestMS1Peak(survey_scan, mz, mz_tolerance, ppm); });
+
+      // apply the corrections in the order of the precursors
       for (Size i = 0; i != precursors_rt.size(); ++i)
       {
-        // get precursor rt
-        double rt = precursors_rt[i];
-
-        // get precursor MZ
-        double mz = precursors[i].getMZ();
-
-        //cout << rt << " " << mz << endl;
-
-        // get precursor spectrum
-        MSExperiment::ConstIterator rt_it = exp.RTBegin(rt - 1e-8);
-
-        // store index of MS2 spectrum
-        UInt precursor_spectrum_idx = rt_it - exp.begin();
-
-        // get parent (MS1) of precursor spectrum
-        rt_it = exp.getPrecursorSpectrum(rt_it);
-
-        if (rt_it == exp.end() 
-        || rt_it->getMSLevel() != 1)
+        const PrecursorMatch_& match = matches[i];
+        if (!match.has_survey_scan)
         {
           OPENMS_LOG_WARN << "Warning: no MS1 spectrum for this precursor" << endl;
-          continue;          
+          continue;
         }
+        if (match.peak_idx == -1) continue;
 
-        //cout << rt_it->getRT() << " " << rt_it->size() << endl;
-
-        // find peak (index) closest to expected position
-        Size nearest_peak_idx = rt_it->findNearest(mz);
-
-        // get actual position of closest peak
-        double nearest_peak_mz = (*rt_it)[nearest_peak_idx].getMZ();
-
-        // calculate error between expected and actual position
-        double nearestPeakError = ppm ? abs(nearest_peak_mz - mz)/mz * 1e6 : abs(nearest_peak_mz - mz);
+        double rt = precursors_rt[i];
+        double mz = precursors[i].getMZ();
+        Size precursor_spectrum_idx = match.spectrum_idx;
 
-        // check if error is small enough
-        if (nearestPeakError < mz_tolerance)
+        // sanity check: do we really have the same precursor in the original and the picked spectrum
+        if (fabs(exp[precursor_spectrum_idx].getPrecursors()[0].getMZ() - mz) > 0.0001)
         {
-          // sanity check: do we really have the same precursor in the original and the picked spectrum
-          if (fabs(exp[precursor_spectrum_idx].getPrecursors()[0].getMZ() - mz) > 0.0001)
-          {
-            OPENMS_LOG_WARN << "Error: index is referencing different precursors in original and picked spectrum." << endl;
-          }
-
-          // cout << mz << " -> " << nearest_peak_mz << endl;
-          double delta_mz = nearest_peak_mz - mz;
-          delta_mzs.push_back(delta_mz);
-          mzs.push_back(mz);
-          rts.push_back(rt);
-          // correct entries
-          Precursor corrected_prec = precursors[i];
-          corrected_prec.setMZ(nearest_peak_mz);
-          exp[precursor_spectrum_idx].getPrecursors()[0] = corrected_prec;
-          corrected_precursors.insert(precursor_spectrum_idx);
+          OPENMS_LOG_WARN << "Error: index is referencing different precursors in original and picked spectrum." << endl;
         }
+
+        double delta_mz = match.peak_mz - mz;
+        delta_mzs.push_back(delta_mz);
+        mzs.push_back(mz);
+        rts.push_back(rt);
+        // correct entries
+        Precursor corrected_prec = precursors[i];
+        corrected_prec.setMZ(match.peak_mz);
+        exp[precursor_spectrum_idx].getPrecursors()[0] = corrected_prec;
+        corrected_precursors.insert(precursor_spectrum_idx);
       }
       return corrected_precursors;
     }
@@ -180,53 +262,39 @@ namespace OpenMS
       getPrecursors(exp, precursors, precursors_rt, precursor_scan_index);
       int count_error_highest_intenstiy = 0;
 
+      const vector<PrecursorMatch_> matches = matchPrecursors_(exp, precursors, precursors_rt,
+        [&](const MSSpectrum& survey_scan, double mz) { return findHighestIntensityMS1Peak(survey_scan, mz, mz_tolerance, ppm); });
+
+      // apply the corrections in the order of the precursors
       for (Size i = 0; i != precursors_rt.size(); ++i)
       {
-        double rt = precursors_rt[i]; // get precursor rt        
-        double mz = precursors[i].getMZ(); // get precursor MZ
-
-        // retrieves iterator of the MS2 fragment sprectrum
-        MSExperiment::ConstIterator rt_it = exp.RTBegin(rt - 1e-8);
-
-        // store index of MS2 spectrum
-        UInt precursor_spectrum_idx = rt_it - exp.begin();
-
-        // get parent (MS1) of precursor spectrum
-        rt_it = exp.getPrecursorSpectrum(rt_it);
-
-        if (rt_it == exp.end() 
-        || rt_it->getMSLevel() != 1)
+        const PrecursorMatch_& match = matches[i];
+        if (!match.has_survey_scan)
         {
           OPENMS_LOG_WARN << "Warning: no MS1 spectrum for this precursor" << endl;
           continue;
         }
 
-        // get tolerance window and index of highest peak
-        std::pair<double,double> tolerance_window = Math::getTolWindow(mz, mz_tolerance, ppm);
-        int highest_peak_idx = rt_it->findHighestInWindow(mz, mz-tolerance_window.first, tolerance_window.second-mz);
-
         // no MS1 precursor peak in +- tolerance window found
-        if (highest_peak_idx == -1)
+        if (match.peak_idx == -1)
         {
           count_error_highest_intenstiy += 1;
           continue;
         }
 
-        // get actual position and intensity of highest intensity peak
-        double highest_peak_mz = (*rt_it)[highest_peak_idx].getMZ();
-        double highest_peak_int = (*rt_it)[highest_peak_idx].getIntensity();
+        double rt = precursors_rt[i]; // get precursor rt
+        double mz = precursors[i].getMZ(); // get precursor MZ
 
-        // cout << mz << " -> " << nearest_peak_mz << endl;
-        double delta_mz = highest_peak_mz - mz;
+        double delta_mz = match.peak_mz - mz;
         delta_mzs.push_back(delta_mz);
         mzs.push_back(mz);
         rts.push_back(rt);
         // correct entries
         Precursor corrected_prec = precursors[i];
-        corrected_prec.setMZ(highest_peak_mz);
-        corrected_prec.setIntensity(highest_peak_int);
-        exp[precursor_spectrum_idx].getPrecursors()[0] = corrected_prec;
-        corrected_precursors.insert(precursor_spectrum_idx);
+        corrected_prec.setMZ(match.peak_mz);
+        corrected_prec.setIntensity(match.peak_intensity);
+        exp[match.spectrum_idx].getPrecursors()[0] = corrected_prec;
+        corrected_precursors.insert(match.spectrum_idx);
       }
 
       if (count_error_highest_intenstiy != 0)
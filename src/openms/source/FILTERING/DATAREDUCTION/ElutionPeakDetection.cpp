@@ -33,6 +33,7 @@
 // --------------------------------------------------------------------------
 
 
+#include <OpenMS/CONCEPT/Profiler.h>
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
 #include <OpenMS/FILTERING/DATAREDUCTION/ElutionPeakDetection.h>
 #include <OpenMS/FILTERING/SMOOTHING/SavitzkyGolayFilter.h>
@@ -326,6 +327,7 @@ namespace OpenMS
 
   void ElutionPeakDetection::detectPeaks(std::vector<MassTrace>& mt_vec, std::vector<MassTrace>& single_mtraces)
   {
+    OPENMS_PROFILE_SCOPE("ElutionPeakDetection::detectPeaks");
     // make sure that single_mtraces is empty
     single_mtraces.clear();
 
@@ -33,7 +33,9 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/FILTERING/DATAREDUCTION/FeatureFindingMetabo.h>
+#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternCache.h>
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternGenerator.h>
+#include <OpenMS/CONCEPT/Profiler.h>
 #include <OpenMS/SYSTEM/File.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathHelper.h>
 
@@ -356,6 +358,14 @@ namespace OpenMS
     use_mz_scoring_by_element_range_ = param_.getValue("mz_scoring_by_elements").toBool();
     std::string elements_list_ = param_.getValue("elements");
     elements_ = elementsFromString_(elements_list_);
+
+    // the isotope windows only depend on the parameters: compute them once instead of per candidate set
+    isotope_windows_.clear();
+    Size iso_pos_max(static_cast<Size>(std::floor(charge_upper_bound_ * local_mz_range_)));
+    for (Size iso_pos = 1; iso_pos <= iso_pos_max; ++iso_pos)
+    {
+      isotope_windows_.push_back(getTheoreticIsotopicMassWindow_(elements_, iso_pos));
+    }
   }
 
 
@@ -371,8 +381,7 @@ namespace OpenMS
 
   double FeatureFindingMetabo::computeAveragineSimScore_(const std::vector<double>& hypo_ints, const double& mol_weight) const
   {
-    CoarseIsotopePatternGenerator solver(hypo_ints.size());
-    auto isodist = solver.estimateFromPeptideWeight(mol_weight);
+    auto isodist = CoarseIsotopePatternCache::getInstance()->estimateFromPeptideWeight(mol_weight, hypo_ints.size());
     // isodist.renormalize();
 
     IsotopeDistribution::ContainerType averagine_dist = isodist.getContainer();
@@ -626,6 +635,57 @@ namespace OpenMS
     return mz_score;
   }
   
+  void FeatureFindingMetabo::scoreMZBatch_(Size iso_pos, Size charge, const Range& isotope_window, const std::vector<double>& diff_mz,
+                                           const std::vector<double>& mt_variances, Size first, std::vector<double>& mz_scores) const
+  {
+    // same arithmetic as scoreMZByExpectedMean_ / scoreMZByExpectedRange_, with the terms that only
+    // depend on the hypothesis hoisted out of the loop
+    const Size n(diff_mz.size());
+    mz_scores.resize(n);
+    const double sigma_mult(3.0);
+
+    if (use_mz_scoring_by_element_range_)
+    {
+      const double lbound(isotope_window.left_boundary / charge);
+      const double rbound(isotope_window.right_boundary / charge);
+      for (Size i = first; i < n; ++i)
+      {
+        const double mt_sigma(std::sqrt(mt_variances[i]));
+        const double max_allowed_deviation(mt_sigma * sigma_mult);
+        const double d(diff_mz[i]);
+        double mz_score(0.0);
+        if ((d < rbound) && (d > lbound))
+        {
+          mz_score = 1.0;
+        }
+        else if ((d < rbound + max_allowed_deviation) && (d > lbound - max_allowed_deviation))
+        {
+          const double tmp_exponent((d < lbound) ? (lbound - d) / mt_sigma : (d - rbound) / mt_sigma);
+          mz_score = std::exp(-0.5 * tmp_exponent * tmp_exponent);
+        }
+        mz_scores[i] = mz_score;
+      }
+    }
+    else
+    {
+      const double mu(use_mz_scoring_C13_ ? (Constants::C13C12_MASSDIFF_U * iso_pos) / charge : (1.000857 * iso_pos + 0.001091) / charge);
+      const double sd((0.0016633 * iso_pos - 0.0004751) / charge);
+      const double sd_squared(std::exp(2 * std::log(sd)));
+      for (Size i = first; i < n; ++i)
+      {
+        const double score_sigma(std::sqrt(sd_squared + mt_variances[i]));
+        const double d(diff_mz[i]);
+        double mz_score(0.0);
+        if ((d < mu + sigma_mult * score_sigma) && (d > mu - sigma_mult * score_sigma))
+        {
+          const double tmp_exponent((d - mu) / score_sigma);
+          mz_score = std::exp(-0.5 * tmp_exponent * tmp_exponent);
+        }
+        mz_scores[i] = mz_score;
+      }
+    }
+  }
+
   double FeatureFindingMetabo::scoreRT_(const MassTrace& tr1, const MassTrace& tr2) const
   {
     // return success if this filter is disabled
@@ -771,6 +831,22 @@ namespace OpenMS
       output_hypotheses.push_back(tmp_hypo);
     }
 
+    // The pair terms which do not depend on the charge / isotope hypothesis are computed once
+    // and packed into arrays. Pairs failing the RT filter can never be part of a hypothesis.
+    std::vector<Size> pair_idx; // candidate index of each pair (ascending)
+    std::vector<double> pair_rt_score, pair_diff_mz, pair_mt_variances, mz_scores;
+    const double mono_mz(candidates[0]->getCentroidMZ());
+    const double mono_variance(std::exp(2 * std::log(candidates[0]->getCentroidSD())));
+    for (Size mt_idx = 1; mt_idx < candidates.size(); ++mt_idx)
+    {
+      double rt_score(scoreRT_(*candidates[0], *candidates[mt_idx]));
+      if (!(rt_score > 0.0)) continue;
+      pair_idx.push_back(mt_idx);
+      pair_rt_score.push_back(rt_score);
+      pair_diff_mz.push_back(std::fabs(candidates[mt_idx]->getCentroidMZ() - mono_mz));
+      pair_mt_variances.push_back(mono_variance + std::exp(2 * std::log(candidates[mt_idx]->getCentroidSD())));
+    }
+
     for (Size charge = charge_lower_bound_; charge <= charge_upper_bound_; ++charge)
     {
       FeatureHypothesis fh_tmp;
@@ -786,16 +862,27 @@ namespace OpenMS
       for (Size iso_pos = 1; iso_pos <= iso_pos_max; ++iso_pos)
       {
         //estimate expected m/z window for iso_pos
-        Range isotope_window = getTheoreticIsotopicMassWindow_(elements_, iso_pos);
+        const Range& isotope_window = isotope_windows_[iso_pos - 1];
         // Find mass trace that best agrees with current hypothesis of charge
         // and isotopic position
         double best_so_far(0.0);
         Size best_idx(0);
-        for (Size mt_idx = last_iso_idx + 1; mt_idx < candidates.size(); ++mt_idx)
+
+        const Size first = std::upper_bound(pair_idx.begin(), pair_idx.end(), last_iso_idx) - pair_idx.begin();
+        scoreMZBatch_(iso_pos, charge, isotope_window, pair_diff_mz, pair_mt_variances, first, mz_scores);
+
+        std::vector<double> hypo_ints;
+        if (isotope_filtering_model_ == "peptides")
+        {
+          hypo_ints = fh_tmp.getAllIntensities();
+          hypo_ints.push_back(0.0); // placeholder for the candidate
+        }
+
+        for (Size p = first; p < pair_idx.size(); ++p)
         {
-          // double tmp_iso_rt(candidates[mt_idx]->getCentroidRT());
-          // double tmp_iso_mz(candidates[mt_idx]->getCentroidMZ());
-          // double tmp_iso_int(candidates[mt_idx]->computePeakArea());
+          // a pair with a zero score can never become the best one
+          if (!(mz_scores[p] > 0.0)) continue;
+          Size mt_idx(pair_idx[p]);
 
 #ifdef FFM_DEBUG
           std::cout << "scoring " << candidates[0]->getLabel() << " " << candidates[0]->getCentroidMZ() << 
@@ -803,8 +890,8 @@ namespace OpenMS
 #endif
 
           // Score current mass trace candidates against hypothesis
-          double rt_score(scoreRT_(*candidates[0], *candidates[mt_idx]));
-          double mz_score(scoreMZ_(*candidates[0], *candidates[mt_idx], iso_pos, charge, isotope_window));
+          double rt_score(pair_rt_score[p]);
+          double mz_score(mz_scores[p]);
 
           // disable intensity scoring for now...
           double int_score(1.0);
@@ -812,9 +899,8 @@ namespace OpenMS
 
           if (isotope_filtering_model_ == "peptides")
           {
-            std::vector<double> tmp_ints(fh_tmp.getAllIntensities());
-            tmp_ints.push_back(candidates[mt_idx]->getIntensity(use_smoothed_intensities_));
-            int_score = computeAveragineSimScore_(tmp_ints, candidates[mt_idx]->getCentroidMZ() * charge);
+            hypo_ints.back() = candidates[mt_idx]->getIntensity(use_smoothed_intensities_);
+            int_score = computeAveragineSimScore_(hypo_ints, candidates[mt_idx]->getCentroidMZ() * charge);
           }
 
 #ifdef FFM_DEBUG
@@ -868,6 +954,7 @@ namespace OpenMS
 
   void FeatureFindingMetabo::run(std::vector<MassTrace>& input_mtraces, FeatureMap& output_featmap, std::vector<std::vector< OpenMS::MSChromatogram > >& output_chromatograms)
   {
+    OPENMS_PROFILE_SCOPE("FeatureFindingMetabo::run");
 
     if (use_mz_scoring_by_element_range_ && isotope_filtering_model_ != "none")
     {
@@ -34,6 +34,7 @@
 
 #include <OpenMS/FILTERING/DATAREDUCTION/IsotopeDistributionCache.h>
 
+#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternCache.h>
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternGenerator.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
 
@@ -52,8 +53,7 @@ namespace OpenMS
     for (Size index = 0; index < num_isotopes; ++index)
     {
       //log_ << "Calculating iso dist for mass: " << 0.5*mass_window_width_ + index * mass_window_width_ << std::endl;
-      CoarseIsotopePatternGenerator solver(20);
-      auto d = solver.estimateFromPeptideWeight(0.5 * mass_window_width + index * mass_window_width);
+      auto d = CoarseIsotopePatternCache::getInstance()->estimateFromPeptideWeight(0.5 * mass_window_width + index * mass_window_width, 20);
 
       //trim left and right. And store the number of isotopes on the left, to reconstruct the monoisotopic peak
       Size size_before = d.size();
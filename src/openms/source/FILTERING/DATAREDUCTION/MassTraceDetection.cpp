@@ -34,10 +34,14 @@
 
 #include <OpenMS/FILTERING/DATAREDUCTION/MassTraceDetection.h>
 
+#include <OpenMS/CONCEPT/Profiler.h>
 #include <OpenMS/MATH/STATISTICS/StatisticFunctions.h>
 
 #include <boost/dynamic_bitset.hpp>
 
+#include <algorithm>
+#include <iterator>
+
 namespace OpenMS
 {
     MassTraceDetection::MassTraceDetection() :
@@ -62,6 +66,9 @@ namespace OpenMS
       defaults_.setValue("min_trace_length", 5.0, "Minimum expected length of a mass trace (in seconds).", ListUtils::create<String>("advanced"));
       defaults_.setValue("max_trace_length", -1.0, "Maximum expected length of a mass trace (in seconds). Set to a negative value to disable maximal length check during mass trace detection.", ListUtils::create<String>("advanced"));
 
+      defaults_.setValue("parallel_mz_bins", 0, "Number of m/z bins in which mass traces are detected in parallel (0 or 1: serial detection). Bins whose traces reach across a bin border are merged with their neighbour, so the result is identical to serial detection.", ListUtils::create<String>("advanced"));
+      defaults_.setMinInt("parallel_mz_bins", 0);
+
       defaultsToParam_();
 
       this->setLogType(CMD);
@@ -189,6 +196,7 @@ namespace OpenMS
 
     void MassTraceDetection::run(const PeakMap& input_exp, std::vector<MassTrace>& found_masstraces, const Size max_traces)
     {
+      OPENMS_PROFILE_SCOPE("MassTraceDetection::run");
       // make sure the output vector is empty
       found_masstraces.clear();
 
@@ -254,6 +262,31 @@ namespace OpenMS
       return;
     } // end of MassTraceDetection::run
 
+    namespace
+    {
+      /// m/z bin of the binned (parallel) trace detection
+      struct MZBin_
+      {
+        double mz_lo; ///< inclusive lower m/z bound
+        double mz_hi; ///< exclusive upper m/z bound
+        std::vector<Size> apex_ranks; ///< apices (as position in the serial processing order) inside the bin, ascending
+        std::vector<std::pair<Size, MassTrace> > traces; ///< detected traces together with the rank of their apex
+        bool crosses_lo; ///< a search window reached below mz_lo
+        bool crosses_hi; ///< a search window reached beyond mz_hi
+        bool done; ///< results are valid and need not be recomputed
+      };
+
+      /// nearest peak to @p mz among the peaks [begin, end) of @p spec (same tie-breaking as MSSpectrum::findNearest)
+      Size findNearestInRange_(const MSSpectrum& spec, Size begin, Size end, double mz)
+      {
+        Size i = std::lower_bound(spec.begin() + begin, spec.begin() + end, mz, MSSpectrum::PeakType::MZLess()) - spec.begin();
+        if (i == begin) return begin;
+        if (i == end) return end - 1;
+        if (std::fabs(spec[i].getMZ() - mz) < std::fabs(spec[i - 1].getMZ() - mz)) return i;
+        return i - 1;
+      }
+    }
+
     void MassTraceDetection::run_(const MapIdxSortedByInt& chrom_apices,
                                   const Size total_peak_count,
                                   const PeakMap& work_exp,
@@ -261,9 +294,6 @@ namespace OpenMS
                                   std::vector<MassTrace>& found_masstraces,
                                   const Size max_traces)
     {
-      boost::dynamic_bitset<> peak_visited(total_peak_count);
-      Size trace_number(1);
-
       // check presence of FWHM meta data
       int fwhm_meta_idx(-1);
       Size fwhm_meta_count(0);
@@ -286,6 +316,21 @@ namespace OpenMS
                                       String("FWHM meta arrays are expected to be missing or present for all MS spectra [") + fwhm_meta_count + "/" + work_exp.size() + "].");
       }
 
+      if (parallel_mz_bins_ > 1 && chrom_apices.size() >= parallel_mz_bins_)
+      {
+        // apices in the order in which the serial algorithm processes them
+        std::vector<std::pair<Size, Size> > apices;
+        apices.reserve(chrom_apices.size());
+        for (MapIdxSortedByInt::const_reverse_iterator m_it = chrom_apices.rbegin(); m_it != chrom_apices.rend(); ++m_it)
+        {
+          apices.push_back(m_it->second);
+        }
+        runBinned_(apices, work_exp, spec_offsets, total_peak_count, fwhm_meta_idx, found_masstraces, max_traces);
+        return;
+      }
+
+      boost::dynamic_bitset<> peak_visited(total_peak_count);
+      Size trace_number(1);
 
       this->startProgress(0, total_peak_count, "mass trace detection");
       Size peaks_detected(0);
@@ -300,6 +345,218 @@ namespace OpenMS
           continue;
         }
 
+        MassTrace new_trace;
+        std::vector<std::pair<Size, Size> > gathered_idx;
+        std::pair<double, double> mz_extent;
+        if (extendTrace_(apex_scan_idx, apex_peak_idx, work_exp, spec_offsets, peak_visited, fwhm_meta_idx, nullptr, new_trace, gathered_idx, mz_extent))
+        {
+          // mark all peaks as visited
+          for (Size i = 0; i < gathered_idx.size(); ++i)
+          {
+            peak_visited[spec_offsets[gathered_idx[i].first] +  gathered_idx[i].second] = true;
+          }
+
+          new_trace.setLabel("T" + String(trace_number));
+          ++trace_number;
+
+          found_masstraces.push_back(new_trace);
+
+          peaks_detected += new_trace.getSize();
+          this->setProgress(peaks_detected);
+
+          // check if we already reached the (optional) maximum number of traces
+          if (max_traces > 0 && found_masstraces.size() == max_traces) break;
+        }
+      }
+
+      this->endProgress();
+
+    }
+
+    void MassTraceDetection::runBinned_(const std::vector<std::pair<Size, Size> >& apices,
+                                        const PeakMap& work_exp,
+                                        const std::vector<Size>& spec_offsets,
+                                        const Size total_peak_count,
+                                        const int fwhm_meta_idx,
+                                        std::vector<MassTrace>& found_masstraces,
+                                        const Size max_traces)
+    {
+      // Traces are narrow in m/z: as long as no search window of any apex in a bin reaches across
+      // the bin borders, the bins do not influence each other and detecting the traces of each bin
+      // separately (keeping the serial order within the bin) yields exactly the serial result.
+      // Bins for which this does not hold are merged with the neighbour they reach into and
+      // recomputed, until all bins are independent (in the worst case, a single bin remains).
+
+      // initial bin borders at m/z quantiles of the apices
+      std::vector<double> apex_mz(apices.size());
+      for (Size i = 0; i < apices.size(); ++i)
+      {
+        apex_mz[i] = work_exp[apices[i].first][apices[i].second].getMZ();
+      }
+      std::vector<double> sorted_mz(apex_mz);
+      std::sort(sorted_mz.begin(), sorted_mz.end());
+
+      std::vector<double> borders(1, -std::numeric_limits<double>::max());
+      for (Size b = 1; b < parallel_mz_bins_; ++b)
+      {
+        Size k = b * sorted_mz.size() / parallel_mz_bins_;
+        double border = (sorted_mz[k - 1] + sorted_mz[k]) / 2.0;
+        if (sorted_mz[k - 1] < sorted_mz[k] && border > borders.back()) borders.push_back(border);
+      }
+      borders.push_back(std::numeric_limits<double>::max());
+
+      std::vector<MZBin_> bins(borders.size() - 1);
+      for (Size b = 0; b < bins.size(); ++b)
+      {
+        bins[b].mz_lo = borders[b];
+        bins[b].mz_hi = borders[b + 1];
+        bins[b].done = false;
+      }
+      for (Size i = 0; i < apices.size(); ++i)
+      {
+        Size b = std::upper_bound(borders.begin(), borders.end(), apex_mz[i]) - borders.begin() - 1;
+        bins[b].apex_ranks.push_back(i);
+      }
+
+      // visited flags need byte granularity, bins are written concurrently
+      std::vector<char> peak_visited(total_peak_count, 0);
+
+      this->startProgress(0, apices.size(), "mass trace detection");
+      Size apices_done(0);
+
+      while (true)
+      {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for (SignedSize b = 0; b < (SignedSize)bins.size(); ++b)
+        {
+          MZBin_& bin = bins[b];
+          if (bin.done) continue;
+
+          // peaks of each spectrum inside the bin (all visited flags written here belong to them)
+          SpectrumRanges ranges(work_exp.size());
+          for (Size s = 0; s < work_exp.size(); ++s)
+          {
+            ranges[s].first = work_exp[s].MZBegin(bin.mz_lo) - work_exp[s].begin();
+            ranges[s].second = work_exp[s].MZBegin(bin.mz_hi) - work_exp[s].begin();
+            std::fill(peak_visited.begin() + spec_offsets[s] + ranges[s].first, peak_visited.begin() + spec_offsets[s] + ranges[s].second, 0);
+          }
+
+          bin.traces.clear();
+          bin.crosses_lo = bin.crosses_hi = false;
+          for (Size i = 0; i < bin.apex_ranks.size(); ++i)
+          {
+            Size apex_scan_idx(apices[bin.apex_ranks[i]].first);
+            Size apex_peak_idx(apices[bin.apex_ranks[i]].second);
+
+            if (peak_visited[spec_offsets[apex_scan_idx] + apex_peak_idx])
+            {
+              continue;
+            }
+
+            MassTrace new_trace;
+            std::vector<std::pair<Size, Size> > gathered_idx;
+            std::pair<double, double> mz_extent;
+            bool passed = extendTrace_(apex_scan_idx, apex_peak_idx, work_exp, spec_offsets, peak_visited, fwhm_meta_idx, &ranges, new_trace, gathered_idx, mz_extent);
+
+            bin.crosses_lo = mz_extent.first < bin.mz_lo;
+            bin.crosses_hi = mz_extent.second >= bin.mz_hi;
+            if (bin.crosses_lo || bin.crosses_hi) break; // results of this bin are invalid
+
+            if (passed)
+            {
+              for (Size j = 0; j < gathered_idx.size(); ++j)
+              {
+                peak_visited[spec_offsets[gathered_idx[j].first] + gathered_idx[j].second] = 1;
+              }
+              bin.traces.push_back(std::make_pair(bin.apex_ranks[i], new_trace));
+            }
+          }
+          bin.done = !(bin.crosses_lo || bin.crosses_hi);
+
+          if (bin.done)
+          {
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_MassTraceDetection_progress)
+#endif
+            {
+              apices_done += bin.apex_ranks.size();
+              this->setProgress(apices_done);
+            }
+          }
+        }
+
+        // merge bins that reached into their neighbour
+        std::vector<MZBin_> merged;
+        bool all_done(true);
+        for (Size b = 0; b < bins.size(); ++b)
+        {
+          if (!merged.empty() && (merged.back().crosses_hi || bins[b].crosses_lo))
+          {
+            MZBin_& last = merged.back();
+            if (last.done) apices_done -= last.apex_ranks.size();
+            if (bins[b].done) apices_done -= bins[b].apex_ranks.size();
+
+            std::vector<Size> ranks;
+            ranks.reserve(last.apex_ranks.size() + bins[b].apex_ranks.size());
+            std::merge(last.apex_ranks.begin(), last.apex_ranks.end(), bins[b].apex_ranks.begin(), bins[b].apex_ranks.end(), std::back_inserter(ranks));
+            last.apex_ranks.swap(ranks);
+            last.mz_hi = bins[b].mz_hi;
+            last.crosses_hi = bins[b].crosses_hi;
+            last.crosses_lo = false; // only the upper border may have been crossed in the merged bin
+            last.done = false;
+            last.traces.clear();
+            all_done = false;
+          }
+          else
+          {
+            merged.push_back(MZBin_());
+            merged.back().mz_lo = bins[b].mz_lo;
+            merged.back().mz_hi = bins[b].mz_hi;
+            merged.back().apex_ranks.swap(bins[b].apex_ranks);
+            merged.back().traces.swap(bins[b].traces);
+            merged.back().crosses_lo = bins[b].crosses_lo;
+            merged.back().crosses_hi = bins[b].crosses_hi;
+            merged.back().done = bins[b].done;
+          }
+        }
+        bins.swap(merged);
+        if (all_done) break;
+      }
+
+      // stitch: restore the serial order (by apex rank) and labels
+      std::vector<std::pair<Size, MassTrace> > ranked_traces;
+      for (Size b = 0; b < bins.size(); ++b)
+      {
+        std::move(bins[b].traces.begin(), bins[b].traces.end(), std::back_inserter(ranked_traces));
+      }
+      std::sort(ranked_traces.begin(), ranked_traces.end(),
+                [](const std::pair<Size, MassTrace>& a, const std::pair<Size, MassTrace>& b) { return a.first < b.first; });
+      if (max_traces > 0 && ranked_traces.size() > max_traces) ranked_traces.resize(max_traces);
+
+      found_masstraces.reserve(ranked_traces.size());
+      for (Size i = 0; i < ranked_traces.size(); ++i)
+      {
+        ranked_traces[i].second.setLabel("T" + String(i + 1));
+        found_masstraces.push_back(std::move(ranked_traces[i].second));
+      }
+
+      this->endProgress();
+    }
+
+    template <typename VisitedMask>
+    bool MassTraceDetection::extendTrace_(const Size apex_scan_idx,
+                                          const Size apex_peak_idx,
+                                          const PeakMap& work_exp,
+                                          const std::vector<Size>& spec_offsets,
+                                          const VisitedMask& peak_visited,
+                                          const int fwhm_meta_idx,
+                                          const SpectrumRanges* ranges,
+                                          MassTrace& new_trace,
+                                          std::vector<std::pair<Size, Size> >& gathered_idx,
+                                          std::pair<double, double>& mz_extent)
+    {
         Peak2D apex_peak;
         apex_peak.setRT(work_exp[apex_scan_idx].getRT());
         apex_peak.setMZ(work_exp[apex_scan_idx][apex_peak_idx].getMZ());
@@ -319,12 +576,13 @@ namespace OpenMS
 
         updateIterativeWeightedMeanMZ(apex_peak.getMZ(), apex_peak.getIntensity(), centroid_mz, prev_counter, prev_denom);
 
-        std::vector<std::pair<Size, Size> > gathered_idx;
+        gathered_idx.clear();
         gathered_idx.push_back(std::make_pair(apex_scan_idx, apex_peak_idx));
         if (fwhm_meta_idx != -1)
         {
           fwhms_mz.push_back(work_exp[apex_scan_idx].getFloatDataArrays()[fwhm_meta_idx][apex_peak_idx]);
         }
+        mz_extent = std::make_pair(apex_peak.getMZ(), apex_peak.getMZ());
 
         Size up_hitting_peak(0), down_hitting_peak(0);
         Size up_scan_counter(0), down_scan_counter(0);
@@ -356,14 +614,24 @@ namespace OpenMS
             const MSSpectrum& spec_trace_down = work_exp[trace_down_idx - 1];
             if (!spec_trace_down.empty())
             {
-              Size next_down_peak_idx = spec_trace_down.findNearest(centroid_mz);
-              double next_down_peak_mz = spec_trace_down[next_down_peak_idx].getMZ();
-              double next_down_peak_int = spec_trace_down[next_down_peak_idx].getIntensity();
-
               double right_bound = centroid_mz + 3 * ftl_sd;
               double left_bound = centroid_mz - 3 * ftl_sd;
+              mz_extent.first = std::min(mz_extent.first, left_bound);
+              mz_extent.second = std::max(mz_extent.second, right_bound);
 
-              if ((next_down_peak_mz <= right_bound) &&
+              // restricted to a bin, an empty range means that no peak is within the bounds
+              const bool in_range = (ranges == nullptr || (*ranges)[trace_down_idx - 1].first < (*ranges)[trace_down_idx - 1].second);
+              Size next_down_peak_idx(0);
+              if (in_range)
+              {
+                next_down_peak_idx = (ranges == nullptr) ? spec_trace_down.findNearest(centroid_mz) :
+                  findNearestInRange_(spec_trace_down, (*ranges)[trace_down_idx - 1].first, (*ranges)[trace_down_idx - 1].second, centroid_mz);
+              }
+              double next_down_peak_mz = spec_trace_down[next_down_peak_idx].getMZ();
+              double next_down_peak_int = spec_trace_down[next_down_peak_idx].getIntensity();
+
+              if (in_range &&
+                  (next_down_peak_mz <= right_bound) &&
                   (next_down_peak_mz >= left_bound) &&
                   !peak_visited[spec_offsets[trace_down_idx - 1] + next_down_peak_idx]
                       )
@@ -434,14 +702,23 @@ namespace OpenMS
             const MSSpectrum& spec_trace_up = work_exp[trace_up_idx + 1];
             if (!spec_trace_up.empty())
             {
-              Size next_up_peak_idx = spec_trace_up.findNearest(centroid_mz);
-              double next_up_peak_mz = spec_trace_up[next_up_peak_idx].getMZ();
-              double next_up_peak_int = spec_trace_up[next_up_peak_idx].getIntensity();
-
               double right_bound = centroid_mz + 3 * ftl_sd;
               double left_bound = centroid_mz - 3 * ftl_sd;
+              mz_extent.first = std::min(mz_extent.first, left_bound);
+              mz_extent.second = std::max(mz_extent.second, right_bound);
 
-              if ((next_up_peak_mz <= right_bound) &&
+              const bool in_range = (ranges == nullptr || (*ranges)[trace_up_idx + 1].first < (*ranges)[trace_up_idx + 1].second);
+              Size next_up_peak_idx(0);
+              if (in_range)
+              {
+                next_up_peak_idx = (ranges == nullptr) ? spec_trace_up.findNearest(centroid_mz) :
+                  findNearestInRange_(spec_trace_up, (*ranges)[trace_up_idx + 1].first, (*ranges)[trace_up_idx + 1].second, centroid_mz);
+              }
+              double next_up_peak_mz = spec_trace_up[next_up_peak_idx].getMZ();
+              double next_up_peak_int = spec_trace_up[next_up_peak_idx].getIntensity();
+
+              if (in_range &&
+                  (next_up_peak_mz <= right_bound) &&
                   (next_up_peak_mz >= left_bound) &&
                   !peak_visited[spec_offsets[trace_up_idx + 1] + next_up_peak_idx])
               {
@@ -518,37 +795,17 @@ namespace OpenMS
         bool max_trace_criteria = (max_trace_length_ < 0.0 || rt_range < max_trace_length_);
         if (rt_range >= min_trace_length_ && max_trace_criteria && mt_quality >= min_sample_rate_)
         {
-          // std::cout << "T" << trace_number << "\t" << mt_quality << std::endl;
-
-          // mark all peaks as visited
-          for (Size i = 0; i < gathered_idx.size(); ++i)
-          {
-            peak_visited[spec_offsets[gathered_idx[i].first] +  gathered_idx[i].second] = true;
-          }
-
           // create new MassTrace object and store collected peaks from list current_trace
-          MassTrace new_trace(current_trace);
+          new_trace = MassTrace(current_trace);
           new_trace.updateWeightedMeanRT();
           new_trace.updateWeightedMeanMZ();
           if (!fwhms_mz.empty()) new_trace.fwhm_mz_avg = Math::median(fwhms_mz.begin(), fwhms_mz.end());
           new_trace.setQuantMethod(quant_method_);
           //new_trace.setCentroidSD(ftl_sd);
           new_trace.updateWeightedMZsd();
-          new_trace.setLabel("T" + String(trace_number));
-          ++trace_number;
-
-          found_masstraces.push_back(new_trace);
-
-          peaks_detected += new_trace.getSize();
-          this->setProgress(peaks_detected);
-
-          // check if we already reached the (optional) maximum number of traces
-          if (max_traces > 0 && found_masstraces.size() == max_traces) break;
+          return true;
         }
-      }
-
-      this->endProgress();
-
+        return false;
     }
 
     void MassTraceDetection::updateMembers_()
@@ -564,6 +821,7 @@ namespace OpenMS
       min_trace_length_ = (double)param_.getValue("min_trace_length");
       max_trace_length_ = (double)param_.getValue("max_trace_length");
       reestimate_mt_sd_ = param_.getValue("reestimate_mt_sd").toBool();
+      parallel_mz_bins_ = (Size)param_.getValue("parallel_mz_bins");
     }
 
 }
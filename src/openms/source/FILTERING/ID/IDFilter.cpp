@@ -34,6 +34,9 @@
 
 #include <OpenMS/FILTERING/ID/IDFilter.h>
 #include <OpenMS/CHEMISTRY/ModificationsDB.h>
+#include <OpenMS/METADATA/ID/QueryMatchTable.h>
+
+#include <cmath>
 
 using namespace std;
 
@@ -789,16 +792,18 @@ namespace OpenMS
   {
     if (id_data.getMoleculeQueryMatches().size() <= 1) return; // nothing to do
 
-    vector<IdentificationData::QueryMatchRef> best_matches =
-      id_data.getBestMatchPerQuery(score_ref);
-    auto best_match_it = best_matches.begin();
+    QueryMatchTable table(id_data);
+    table.addScoreColumn(score_ref);
+    vector<Size> best_rows = table.getBestMatchPerQuery(score_ref);
+    auto best_row_it = best_rows.begin();
+    Size row = 0;
     for (auto it = id_data.query_matches_.begin();
-         it != id_data.query_matches_.end(); )
+         it != id_data.query_matches_.end(); ++row)
     {
-      if (it == *best_match_it)
+      if ((best_row_it != best_rows.end()) && (row == *best_row_it))
       {
         ++it;
-        ++best_match_it;
+        ++best_row_it;
       }
       else
       {
@@ -816,12 +821,16 @@ namespace OpenMS
   {
     bool higher_better = score_ref->higher_better;
 
+    // look up all scores up front; rows are in container order:
+    QueryMatchTable table(id_data);
+    const vector<double>& scores = table.addScoreColumn(score_ref);
+    Size row = 0;
     id_data.removeFromSetIf_(
-      id_data.query_matches_, [&](IdentificationData::QueryMatchRef it) -> bool
+      id_data.query_matches_, [&](IdentificationData::QueryMatchRef) -> bool
       {
-        pair<double, bool> score = it->getScore(score_ref);
-        return !score.second || id_data.isBetterScore(cutoff, score.first,
-                                                      higher_better);
+        double score = scores[row++];
+        return std::isnan(score) || id_data.isBetterScore(cutoff, score,
+                                                          higher_better);
       });
 
     id_data.cleanup();
@@ -49,6 +49,7 @@
 
 #include <cmath>
 #include <algorithm>    // std::min, std::max
+#include <cstddef>
 #include <cstdlib>
 #include <vector>
 
@@ -511,8 +512,6 @@ public:
                ContainerType& weights   // vector res
                )
     {
-      bool fit_ok;
-
       size_t ns, n(x.size());
       if (n < 2)
       {
@@ -525,28 +524,54 @@ public:
       size_t tmp = (size_t)(frac * (double)n);
       ns = std::max(std::min(tmp, n), (size_t)2);
 
+      // The points at which a local regression is computed, and their
+      // neighborhoods, only depend on x and delta. Determine them once; the
+      // local fits are then independent of each other and can be computed in
+      // parallel. Skipped points and ties are filled in afterwards in the
+      // original (sequential) order, which gives the same result as the
+      // classic single-pass algorithm.
+      std::vector<size_t> fit_index, fit_nleft, fit_nright;
+      {
+        size_t i(0), last(-1), nleft(0), nright(ns - 1);
+        do
+        {
+          update_neighborhood(x, n, i, nleft, nright);
+          fit_index.push_back(i);
+          fit_nleft.push_back(nleft);
+          fit_nright.push_back(nright);
+          update_indices(x, n, delta, i, last, ys);
+        } while (last < n - 1);
+      }
+      const std::ptrdiff_t n_fits = static_cast<std::ptrdiff_t>(fit_index.size());
+      std::vector<ValueType> fitted(n_fits);
+      std::vector<char> fitted_ok(n_fits); // not vector<bool>: written concurrently
+
       // robustness iterations
       for (int iter = 1; iter <= nsteps + 1; iter++)
       {
+        // Calculate weights and apply fit (original lowest function) at each
+        // point; every thread needs its own weight vector
+#pragma omp parallel if (n_fits > 1000)
+        {
+          ContainerType thread_weights(weights);
+#pragma omp for schedule(static)
+          for (std::ptrdiff_t k = 0; k < n_fits; ++k)
+          {
+            const size_t i = fit_index[k];
+            fitted_ok[k] = lowest(x, y, n, x[i], fitted[k], fit_nleft[k], fit_nright[k],
+                                  thread_weights, (iter > 1), resid_weights);
+          }
+        }
+
         // start of array in C++ at 0 / in FORTRAN at 1
         // last: index of prev estimated point
         // i: index of current point
-        size_t i(0), last(-1), nleft(0), nright(ns -1);
-
-        // Fit all data points y[i] until the end of the array
-        do
+        size_t i(0), last(-1);
+        for (std::ptrdiff_t k = 0; k < n_fits; ++k)
         {
-          // Identify the neighborhood around the current x[i]
-          // -> get the nearest ns points
-          update_neighborhood(x, n, i, nleft, nright);
-
-          // Calculate weights and apply fit (original lowest function)
-          fit_ok = lowest(x, y, n, x[i], ys[i], nleft, nright,
-                          weights, (iter > 1), resid_weights);
-
           // if something went wrong during the fit, use y[i] as the
           // fitted value at x[i]
-          if (!fit_ok) ys[i] = y[i];
+          ys[i] = fitted_ok[k] ? fitted[k] : y[i];
 
           // If we skipped some points (because of how delta was set), go back
           // and fit them by linear interpolation.
@@ -556,10 +581,9 @@ public:
           }
 
           // Update the last fit counter to indicate we've now fit this point.
-          // Find the next i for which we'll run a regression.
+          // Find the next i for which we'll run a regression (fit_index[k + 1]).
           update_indices(x, n, delta, i, last, ys);
-
-        } while (last < n - 1);
+        }
 
         // compute current residuals
         for (i = 0; i < n; i++)
@@ -57,17 +57,10 @@ namespace OpenMS
     use_ppm_tolerance_ = use_ppm_tolerance;
     ppm_tolerance_ = ppm_tolerance;
     sigma_ = gaussian_width / 8.0;
-    Size number_of_points_right = (Size)(ceil(4 * sigma_ / spacing_)) + 1;
-    coeffs_.resize(number_of_points_right);
-    coeffs_[0] = 1.0 / (sigma_ * sqrt(2.0 * Constants::PI));
-
-    for (Size i = 1; i < number_of_points_right; i++)
-    {
-      coeffs_[i] = 1.0 / (sigma_ * sqrt(2.0 * Constants::PI)) * exp(-((i * spacing_) * (i * spacing_)) / (2 * sigma_ * sigma_));
-    }
+    computeCoefficients_(gaussian_width, spacing_, coeffs_);
 #ifdef DEBUG_FILTERING
     std::cout << "Coeffs: " << std::endl;
-    for (Size i = 0; i < number_of_points_right; i++)
+    for (Size i = 0; i < coeffs_.size(); i++)
     {
       std::cout << i * spacing_ << ' ' << coeffs_[i] << std::endl;
     }
@@ -75,4 +68,17 @@ namespace OpenMS
 
   }
 
+  void GaussFilterAlgorithm::computeCoefficients_(double gaussian_width, double spacing, std::vector<double>& coeffs)
+  {
+    double sigma = gaussian_width / 8.0;
+    Size number_of_points_right = (Size)(ceil(4 * sigma / spacing)) + 1;
+    coeffs.resize(number_of_points_right);
+    coeffs[0] = 1.0 / (sigma * sqrt(2.0 * Constants::PI));
+
+    for (Size i = 1; i < number_of_points_right; i++)
+    {
+      coeffs[i] = 1.0 / (sigma * sqrt(2.0 * Constants::PI)) * exp(-((i * spacing) * (i * spacing)) / (2 * sigma * sigma));
+    }
+  }
+
 }
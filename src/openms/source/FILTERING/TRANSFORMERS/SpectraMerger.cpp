@@ -35,6 +35,8 @@
 
 #include <OpenMS/FILTERING/TRANSFORMERS/SpectraMerger.h>
 
+#include <map>
+
 using namespace std;
 namespace OpenMS
 {
@@ -112,4 +114,93 @@ namespace OpenMS
     return *this;
   }
 
+  void SpectraMerger::clusterPrecursors_(const std::vector<BaseFeature>& data, std::vector<std::vector<Size> >& clusters) const
+  {
+    clusters.clear();
+
+    SpectraDistance_ llc;
+    llc.setParameters(param_.copy("precursor_method:", true));
+    double rt_tolerance = param_.getValue("precursor_method:rt_tolerance");
+    double mz_tolerance = param_.getValue("precursor_method:mz_tolerance");
+    // all pairs within tolerance are in the same or in adjacent cells
+    double rt_cell = rt_tolerance > 0 ? rt_tolerance : 1.0;
+    double mz_cell = mz_tolerance > 0 ? mz_tolerance : 1.0;
+
+    typedef std::pair<Int64, Int64> Cell;
+    std::vector<Cell> cells(data.size());
+    std::map<Cell, std::vector<Size> > grid;
+    for (Size i = 0; i < data.size(); ++i)
+    {
+      cells[i] = Cell((Int64)floor(data[i].getRT() / rt_cell), (Int64)floor(data[i].getMZ() / mz_cell));
+      grid[cells[i]].push_back(i);
+    }
+
+    // find all linked pairs (distance < 1, as in ClusterHierarchical which stores 1 - similarity as float)
+    std::vector<std::pair<Size, Size> > links;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      std::vector<std::pair<Size, Size> > links_local;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 100) nowait
+#endif
+      for (SignedSize i = 0; i < (SignedSize)data.size(); ++i)
+      {
+        for (Int64 d_rt = -1; d_rt <= 1; ++d_rt)
+        {
+          for (Int64 d_mz = -1; d_mz <= 1; ++d_mz)
+          {
+            auto cell_it = grid.find(Cell(cells[i].first + d_rt, cells[i].second + d_mz));
+            if (cell_it == grid.end()) continue;
+            for (Size j : cell_it->second)
+            {
+              if (j >= (Size)i) break; // each pair once (cell members are sorted)
+              if ((float)(1 - llc(data[i], data[j])) < 1.0f)
+              {
+                links_local.push_back(std::make_pair(j, (Size)i));
+              }
+            }
+          }
+        }
+      }
+#ifdef _OPENMP
+#pragma omp critical (SpectraMerger_clusterPrecursors)
+#endif
+      links.insert(links.end(), links_local.begin(), links_local.end());
+    }
+
+    // connected components (union-find)
+    std::vector<Size> parent(data.size());
+    for (Size i = 0; i < parent.size(); ++i) parent[i] = i;
+    auto find_root = [&parent](Size i)
+    {
+      while (parent[i] != i)
+      {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+      }
+      return i;
+    };
+    for (const auto& link : links)
+    {
+      Size a = find_root(link.first), b = find_root(link.second);
+      if (a != b) parent[std::max(a, b)] = std::min(a, b);
+    }
+
+    // the root is the smallest index of each cluster, so clusters are ordered by their first element
+    std::map<Size, Size> cluster_index;
+    for (Size i = 0; i < data.size(); ++i)
+    {
+      Size root = find_root(i);
+      auto it = cluster_index.find(root);
+      if (it == cluster_index.end())
+      {
+        it = cluster_index.insert(std::make_pair(root, clusters.size())).first;
+        clusters.push_back(std::vector<Size>());
+      }
+      clusters[it->second].push_back(i);
+    }
+  }
+
 }
@@ -33,10 +33,15 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/FORMAT/Base64.h>
+#include <OpenMS/FORMAT/ZlibCompression.h>
 
 #include <QtCore/QList>
 #include <QtCore/QString>
 
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
 using namespace std;
 
 namespace OpenMS
@@ -81,48 +86,160 @@ namespace OpenMS
      +   = 43       ->       62
      /   = 47       ->       63
 
+  The decoder uses a direct mapping of all 256 possible byte values which
+  allows lookup[char] without any adding or subtraction step. Characters
+  outside of the alphabet (including '=' and whitespace) map to 255. The
+  table can be produced by this Python snippet:
 
-  this can be done by first subtracting 43 from each value
-  and then looking up a value in a table as found in the code,
-  e.g. lookup[char - 43] - 62
+enc = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"
+lookup = [255] * 256
+for i, c in enumerate(enc):
+  lookup[ord(c)] = i
+print(lookup)
 
-  The following string can be produced by this Python snippet:
+  */
 
-offset = 62
-s = ""
-s += chr(62 + offset)
-s += '$' * 3
-s += "".join([ chr(52 + i + offset) for i in range(10) ])
-s += '$' * 7
-s += "".join([ chr(i + offset) for i in range(26) ])
-s += '$' * 6
-s += "".join([ chr(26 + i + offset) for i in range(26) ])
-print s
+  const char Base64::encoder_[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  const Byte Base64::decoder_[256] =
+  {
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,  62, 255, 255, 255,  63,
+     52,  53,  54,  55,  56,  57,  58,  59,  60,  61, 255, 255, 255, 255, 255, 255,
+    255,   0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,
+     15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25, 255, 255, 255, 255, 255,
+    255,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,
+     41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  51, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255
+  };
+
+#ifdef __SSSE3__
+  namespace
+  {
+    /**
+      @brief Decodes 16 Base64 characters to 12 bytes
 
-"|$$$rstuvwxyz{$$$$$$$>?@ABCDEFGHIJKLMNOPQRSTUVW$$$$$$XYZ[\]^_`abcdefghijklmnopq"
+      Characters are mapped to their 6 bit values by adding a per-range
+      offset (A-Z: -65, a-z: -71, 0-9: +4, '+': +19, '/': +16), then four
+      6 bit values are merged into 24 bits with two multiply-add steps and
+      the resulting bytes are shuffled into big endian order.
 
-  however, this is basically just convenience to produce printable characters.
-  We could also go for a direct mapping:
+      @note Writes 16 bytes to @p out (of which the last 4 are undefined)
 
-s = '$' * 42
-s += hex(62)
-s += '$' * 3
-s += "".join([ hex(52 + i) for i in range(10) ])
-s += '$' * 7
-s += "".join([ hex(i) for i in range(26) ])
-s += '$' * 6
-s += "".join([ hex(26 + i) for i in range(26) ])
-print s
+      @return false if any character is outside of the Base64 alphabet (nothing is decoded in that case)
+    */
+    inline bool decodeBlockSSSE3_(const char* in, Byte* out)
+    {
+      const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+      const __m128i range_AZ = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(chars, _mm_set1_epi8('Z' + 1)));
+      const __m128i range_az = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(chars, _mm_set1_epi8('z' + 1)));
+      const __m128i range_09 = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+      const __m128i is_plus = _mm_cmpeq_epi8(chars, _mm_set1_epi8('+'));
+      const __m128i is_slash = _mm_cmpeq_epi8(chars, _mm_set1_epi8('/'));
+
+      const __m128i valid = _mm_or_si128(_mm_or_si128(range_AZ, range_az), _mm_or_si128(range_09, _mm_or_si128(is_plus, is_slash)));
+      if (_mm_movemask_epi8(valid) != 0xFFFF)
+      {
+        return false;
+      }
 
-"$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$0x3e$$$0x340x350x360x370x380x390x3a0x3b0x3c0x3d$$$$$$$0x00x10x20x30x40x50x60x70x80x90xa0xb0xc0xd0xe0xf0x100x110x120x130x140x150x160x170x180x19$$$$$$0x1a0x1b0x1c0x1d0x1e0x1f0x200x210x220x230x240x250x260x270x280x290x2a0x2b0x2c0x2d0x2e0x2f0x300x310x320x33"
+      __m128i shift = _mm_and_si128(range_AZ, _mm_set1_epi8(-65));
+      shift = _mm_or_si128(shift, _mm_and_si128(range_az, _mm_set1_epi8(-71)));
+      shift = _mm_or_si128(shift, _mm_and_si128(range_09, _mm_set1_epi8(4)));
+      shift = _mm_or_si128(shift, _mm_and_si128(is_plus, _mm_set1_epi8(19)));
+      shift = _mm_or_si128(shift, _mm_and_si128(is_slash, _mm_set1_epi8(16)));
+      const __m128i values = _mm_add_epi8(chars, shift);
+
+      // 00aaaaaa 00bbbbbb -> 0000aaaa aabbbbbb (16 bit), then -> 24 bit per 32 bit lane
+      const __m128i merged_pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+      const __m128i merged = _mm_madd_epi16(merged_pairs, _mm_set1_epi32(0x00011000));
+      const __m128i packed = _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out), packed);
+      return true;
+    }
+  }
+#endif
 
-  which would allow lookup[char] without any adding or subtraction step (but
-  needs a 42 byte extra memory in the local cache).
+  Size Base64::decodeRaw_(const char* in, Size in_size, Byte* out)
+  {
+    const Byte* it = reinterpret_cast<const Byte*>(in);
+    const Byte* end = it + in_size;
+    Byte* to = out;
 
-  */
+    UInt32 bits = 0;
+    UInt nr_bits = 0;
+    while (it != end)
+    {
+      if (nr_bits == 0)
+      {
+#ifdef __SSSE3__
+        // fast path: 16 characters at once (the block writes 16 bytes, make
+        // sure we stay within the upper bound of the output buffer)
+        while (end - it >= 20 && decodeBlockSSSE3_(reinterpret_cast<const char*>(it), to))
+        {
+          it += 16;
+          to += 12;
+        }
+#endif
+        // fast path: 4 valid characters at once
+        while (end - it >= 4)
+        {
+          const UInt32 a = decoder_[it[0]];
+          const UInt32 b = decoder_[it[1]];
+          const UInt32 c = decoder_[it[2]];
+          const UInt32 d = decoder_[it[3]];
+          if ((a | b | c | d) & 0x80) break; // invalid character or padding
+
+          const UInt32 int_24bit = (a << 18) | (b << 12) | (c << 6) | d;
+          to[0] = (Byte) (int_24bit >> 16);
+          to[1] = (Byte) (int_24bit >> 8);
+          to[2] = (Byte) int_24bit;
+          it += 4;
+          to += 3;
+        }
+        if (it == end) break;
+      }
 
-  const char Base64::encoder_[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-  const char Base64::decoder_[] = "|$$$}rstuvwxyz{$$$$$$$>?@ABCDEFGHIJKLMNOPQRSTUVW$$$$$$XYZ[\\]^_`abcdefghijklmnopq";
+      // slow path: single character, skip anything outside of the alphabet
+      const Byte c = *it++;
+      const UInt32 value = decoder_[c];
+      if (value & 0x80)
+      {
+        if (c == '=') break; // padding, we are done
+        continue;
+      }
+      bits = (bits << 6) | value;
+      nr_bits += 6;
+      if (nr_bits >= 8)
+      {
+        nr_bits -= 8;
+        *to++ = (Byte) (bits >> nr_bits);
+        bits &= (1u << nr_bits) - 1;
+      }
+    }
+
+    // complete the last group of 4 characters with zero bits, i.e. always
+    // 3 bytes are written per (possibly padded) group
+    while (nr_bits != 0)
+    {
+      bits <<= 6;
+      nr_bits += 6;
+      if (nr_bits >= 8)
+      {
+        nr_bits -= 8;
+        *to++ = (Byte) (bits >> nr_bits);
+        bits &= (1u << nr_bits) - 1;
+      }
+    }
+    return (Size) (to - out);
+  }
 
   void Base64::encodeStrings(const std::vector<String>& in, String& out, bool zlib_compression, bool append_null_byte)
   {
@@ -256,19 +373,9 @@ print s
     base64_uncompressed = QByteArray::fromBase64(herewego);
     if (zlib_compression)
     {
-      QByteArray czip;
-      czip.resize(4);
-      czip[0] = (base64_uncompressed.size() & 0xff000000) >> 24;
-      czip[1] = (base64_uncompressed.size() & 0x00ff0000) >> 16;
-      czip[2] = (base64_uncompressed.size() & 0x0000ff00) >> 8;
-      czip[3] = (base64_uncompressed.size() & 0x000000ff);
-      czip += base64_uncompressed;
-      base64_uncompressed = qUncompress(czip);
-
-      if (base64_uncompressed.isEmpty())
-      {
-        throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Decompression error?");
-      }
+      QByteArray compressed;
+      compressed.swap(base64_uncompressed);
+      ZlibCompression::uncompressString(compressed, base64_uncompressed);
     }
   }
 
@@ -42,22 +42,9 @@ using namespace std;
 namespace OpenMS
 {
   Bzip2Ifstream::Bzip2Ifstream(const char * filename) :
-    n_buffer_(0), stream_at_end_(false)
+    file_(nullptr), bzip2file_(nullptr), n_buffer_(0), bzerror_(0), stream_at_end_(false)
   {
-    file_ = fopen(filename, "rb");       //read binary: always open in binary mode because windows and mac open in text mode
-
-    //aborting, ahhh!
-    if (!file_)
-    {
-      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
-    }
-
-    bzip2file_ = BZ2_bzReadOpen(&bzerror_, file_, 0, 0, nullptr, 0);
-    if (bzerror_ != BZ_OK)
-    {
-      close();
-      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "bzip2 compression failed: ");
-    }
+    open(filename);
   }
 
   Bzip2Ifstream::Bzip2Ifstream() :
@@ -74,22 +61,20 @@ namespace OpenMS
   {
     if (bzip2file_ != nullptr)
     {
-      bzerror_ = BZ_OK;
-      n_buffer_ = BZ2_bzRead(&bzerror_, bzip2file_, s, (unsigned int)n /* size of buf */);
-      if (bzerror_ == BZ_OK)
+      try
       {
-        return n_buffer_;
+        n_buffer_ = read_ahead_.read(s, n);
       }
-      else if (bzerror_ != BZ_STREAM_END)
+      catch (...)
       {
         close();
-        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, " ", "bzip2 compression failed: ");
+        throw;
       }
-      else
+      if (n_buffer_ < n) // end of stream
       {
         close();
-        return n_buffer_;
       }
+      return n_buffer_;
     }
     else
     {
@@ -115,10 +100,32 @@ namespace OpenMS
       throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "bzip2 compression failed: ");
     }
     stream_at_end_ = false;
+
+    // BZ2_bzRead must not be called again once it reported the end of the stream
+    BZFILE* bzip2file = bzip2file_;
+    bool at_end = false;
+    read_ahead_.start([bzip2file, at_end](char* buffer, size_t size) mutable
+    {
+      size_t total = 0;
+      while (!at_end && total < size)
+      {
+        int error = BZ_OK;
+        int count = BZ2_bzRead(&error, bzip2file, buffer + total, (int)(size - total) /* size of buf */);
+        if (error != BZ_OK && error != BZ_STREAM_END)
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, " ", "bzip2 compression failed: ");
+        }
+        total += count;
+        at_end = (error == BZ_STREAM_END);
+      }
+      return total;
+    });
   }
 
   void Bzip2Ifstream::close()
   {
+    // the producer thread has to be finished before its file handle goes away
+    read_ahead_.stop();
     if (bzip2file_ != nullptr)
     {
       BZ2_bzReadClose(&bzerror_, bzip2file_);
@@ -41,8 +41,13 @@
 #include <OpenMS/CONCEPT/Types.h>
 #include <OpenMS/CONCEPT/Exception.h>
 #include <OpenMS/CONCEPT/Macros.h>
+#include <OpenMS/CONCEPT/LogStream.h>
 
 #include <OpenMS/FORMAT/HANDLERS/CachedMzMLHandler.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 
 namespace OpenMS
 {
@@ -58,16 +63,19 @@ namespace OpenMS
 
   CachedmzML::~CachedmzML()
   {
-    ifs_.close();
+    if (ifs_.is_open()) ifs_.close();
   }
 
   CachedmzML::CachedmzML(const CachedmzML & rhs) :
     meta_ms_experiment_(rhs.meta_ms_experiment_),
-    ifs_(rhs.filename_cached_.c_str(), std::ios::binary),
+    mapped_file_(rhs.mapped_file_),
     filename_(rhs.filename_),
+    filename_cached_(rhs.filename_cached_),
     spectra_index_(rhs.spectra_index_),
     chrom_index_(rhs.chrom_index_)
   {
+    // only open a separate file stream if we cannot share the mapping
+    if (!mapped_file_) ifs_.open(filename_cached_.c_str(), std::ios::binary);
   }
 
   void CachedmzML::load_(const String& filename)
@@ -81,27 +89,100 @@ namespace OpenMS
     spectra_index_ = cache.getSpectraIndex();
     chrom_index_ = cache.getChromatogramIndex();;
 
-    // open the filestream
-    ifs_.open(filename_cached_.c_str(), std::ios::binary);
+    // map the file into memory or open the filestream
+    mapFile_();
+    if (!mapped_file_) ifs_.open(filename_cached_.c_str(), std::ios::binary);
 
     // load the meta data from disk
     MzMLFile().load(filename, meta_ms_experiment_);
   }
 
-  MSSpectrum CachedmzML::getSpectrum(Size id)
+  void CachedmzML::load_(const String& filename, MSExperiment meta_data,
+                         const std::vector<std::streampos>& spectra_index,
+                         const std::vector<std::streampos>& chrom_index)
   {
-    OPENMS_PRECONDITION(id < getNrSpectra(), "Id cannot be larger than number of spectra");
+    if (spectra_index.size() != meta_data.size() || chrom_index.size() != meta_data.getChromatograms().size())
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "Index of " + String(spectra_index.size()) + " spectra and " + String(chrom_index.size()) +
+        " chromatograms does not match meta data with " + String(meta_data.size()) + " spectra and " +
+        String(meta_data.getChromatograms().size()) + " chromatograms.");
+    }
+
+    filename_cached_ = filename + ".cached";
+    filename_ = filename;
+    if (!File::exists(filename_cached_))
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_cached_);
+    }
+
+    spectra_index_ = spectra_index;
+    chrom_index_ = chrom_index;
+    meta_ms_experiment_ = std::move(meta_data);
+
+    mapFile_();
+    if (!mapped_file_) ifs_.open(filename_cached_.c_str(), std::ios::binary);
+  }
+
+  void CachedmzML::mapFile_()
+  {
+    mapped_file_.reset();
+    try
+    {
+      boost::interprocess::file_mapping mapping(filename_cached_.c_str(), boost::interprocess::read_only);
+      mapped_file_.reset(new boost::interprocess::mapped_region(mapping, boost::interprocess::read_only));
+    }
+    catch (boost::interprocess::interprocess_exception& e)
+    {
+      OPENMS_LOG_DEBUG << "Could not memory-map '" << filename_cached_ << "' (" << e.what() << "), using file stream instead." << std::endl;
+      mapped_file_.reset();
+    }
+  }
+
+  bool CachedmzML::isMemoryMapped() const
+  {
+    return mapped_file_ != nullptr;
+  }
 
-    if ( !ifs_.seekg(spectra_index_[id]) )
+  const char* CachedmzML::mappedData_(std::streampos pos, Size& available) const
+  {
+    const std::streamoff offset = pos;
+    if (offset < 0 || Size(offset) >= mapped_file_->get_size())
     {
-      std::cerr << "Error while reading spectrum " << id << " - seekg created an error when trying to change position to " << spectra_index_[id] << "." << std::endl;
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "Position " + String(Size(offset)) + " is outside of the mapped file.", filename_cached_);
+    }
+    available = mapped_file_->get_size() - Size(offset);
+    return static_cast<const char*>(mapped_file_->get_address()) + offset;
+  }
+
+  void CachedmzML::seekFileStream_(std::streampos pos, Size id, const String& type)
+  {
+    if ( !ifs_.seekg(pos) )
+    {
+      std::cerr << "Error while reading " << type << " " << id << " - seekg created an error when trying to change position to " << pos << "." << std::endl;
       std::cerr << "Maybe an invalid position was supplied to seekg, this can happen for example when reading large files (>2GB) on 32bit systems." << std::endl;
       throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
         "Error while changing position of input stream pointer.", filename_cached_);
     }
+  }
+
+  MSSpectrum CachedmzML::getSpectrum(Size id)
+  {
+    OPENMS_PRECONDITION(id < getNrSpectra(), "Id cannot be larger than number of spectra");
 
     MSSpectrum s = meta_ms_experiment_.getSpectrum(id);
-    Internal::CachedMzMLHandler::readSpectrum(s, ifs_);
+    if (mapped_file_)
+    {
+      Size available;
+      const char* data = mappedData_(spectra_index_[id], available);
+      Internal::CachedMzMLHandler::readSpectrum(s, data, available);
+    }
+    else
+    {
+      seekFileStream_(spectra_index_[id], id, "spectrum");
+      Internal::CachedMzMLHandler::readSpectrum(s, ifs_);
+    }
     return s;
   }
 
@@ -109,16 +190,18 @@ namespace OpenMS
   {
     OPENMS_PRECONDITION(id < getNrChromatograms(), "Id cannot be larger than number of chromatograms");
 
-    if ( !ifs_.seekg(chrom_index_[id]) )
+    MSChromatogram c = meta_ms_experiment_.getChromatogram(id);
+    if (mapped_file_)
     {
-      std::cerr << "Error while reading chromatogram " << id << " - seekg created an error when trying to change position to " << chrom_index_[id] << "." << std::endl;
-      std::cerr << "Maybe an invalid position was supplied to seekg, this can happen for example when reading large files (>2GB) on 32bit systems." << std::endl;
-      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-        "Error while changing position of input stream pointer.", filename_cached_);
+      Size available;
+      const char* data = mappedData_(chrom_index_[id], available);
+      Internal::CachedMzMLHandler::readChromatogram(c, data, available);
+    }
+    else
+    {
+      seekFileStream_(chrom_index_[id], id, "chromatogram");
+      Internal::CachedMzMLHandler::readChromatogram(c, ifs_);
     }
-
-    MSChromatogram c = meta_ms_experiment_.getChromatogram(id);
-    Internal::CachedMzMLHandler::readChromatogram(c, ifs_);
     return c;
   }
 
@@ -0,0 +1,982 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/ColumnarFeatureFile.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/KERNEL/ConsensusMap.h>
+#include <OpenMS/KERNEL/FeatureMap.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+using namespace std;
+
+namespace OpenMS
+{
+
+  namespace
+  {
+    const char COLUMNAR_MAGIC[16] = "OPENMS_COLUMNS1";
+
+    const Size COLUMN_NAME_LENGTH = 48;
+
+    /// column directory record as written to the file
+    struct DirectoryRecord
+    {
+      char name[COLUMN_NAME_LENGTH];
+      UInt64 type;
+      UInt64 count;
+      UInt64 offset;
+      UInt64 bytes;
+    };
+
+    /// magic, map type, number of rows, number of columns
+    const Size HEADER_SIZE = sizeof(COLUMNAR_MAGIC) + 3 * sizeof(UInt64);
+
+    Size alignedSize_(Size size)
+    {
+      return (size + 7) / 8 * 8;
+    }
+
+    Size elementSize_(ColumnarFeatureFile::ColumnType type)
+    {
+      switch (type)
+      {
+        case ColumnarFeatureFile::DOUBLE_COLUMN: return sizeof(double);
+        case ColumnarFeatureFile::FLOAT_COLUMN: return sizeof(float);
+        case ColumnarFeatureFile::INT32_COLUMN: return sizeof(Int32);
+        case ColumnarFeatureFile::INT64_COLUMN: return sizeof(Int64);
+        case ColumnarFeatureFile::UINT32_COLUMN: return sizeof(UInt32);
+        case ColumnarFeatureFile::UINT64_COLUMN: return sizeof(UInt64);
+        default: return 0; // strings have no fixed size
+      }
+    }
+
+    /// collects columns in memory and writes them to a file
+    class ColumnWriter_
+    {
+  public:
+      template <typename T>
+      void add(const String& name, ColumnarFeatureFile::ColumnType type, const vector<T>& values)
+      {
+        Column column(name, type, values.size());
+        column.data.assign(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+        columns_.push_back(column);
+      }
+
+      /// string columns: (count + 1) offsets into the character data, followed by the characters
+      void add(const String& name, const vector<String>& values)
+      {
+        vector<UInt64> offsets(1, 0);
+        offsets.reserve(values.size() + 1);
+        for (const String& value : values)
+        {
+          offsets.push_back(offsets.back() + value.size());
+        }
+        Column column(name, ColumnarFeatureFile::STRING_COLUMN, values.size());
+        column.data.reserve(offsets.size() * sizeof(UInt64) + offsets.back());
+        column.data.assign(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(UInt64));
+        for (const String& value : values)
+        {
+          column.data.append(value);
+        }
+        columns_.push_back(column);
+      }
+
+      void write(const String& filename, ColumnarFeatureFile::MapType map_type, UInt64 size) const
+      {
+        ofstream out(filename.c_str(), ios::out | ios::binary | ios::trunc);
+        if (!out)
+        {
+          throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+        }
+        UInt64 header[3] = {UInt64(map_type), size, UInt64(columns_.size())};
+        out.write(COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC));
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+        UInt64 offset = HEADER_SIZE + columns_.size() * sizeof(DirectoryRecord);
+        for (const Column& column : columns_)
+        {
+          DirectoryRecord record;
+          memset(&record, 0, sizeof(record));
+          strncpy(record.name, column.name.c_str(), COLUMN_NAME_LENGTH - 1);
+          record.type = column.type;
+          record.count = column.count;
+          record.offset = offset;
+          record.bytes = column.data.size();
+          out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+          offset += alignedSize_(column.data.size());
+        }
+
+        const char padding[8] = {0};
+        for (const Column& column : columns_)
+        {
+          out.write(column.data.data(), column.data.size());
+          out.write(padding, alignedSize_(column.data.size()) - column.data.size());
+        }
+        if (!out)
+        {
+          throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Error while writing the file.");
+        }
+      }
+
+  private:
+      struct Column
+      {
+        Column(const String& n, ColumnarFeatureFile::ColumnType t, UInt64 c) :
+          name(n), type(t), count(c)
+        {
+        }
+
+        String name;
+        ColumnarFeatureFile::ColumnType type;
+        UInt64 count;
+        string data;
+      };
+
+      vector<Column> columns_;
+    };
+
+    /**
+      Sparse meta value table: one row per meta value, the values themselves
+      are stored in typed pools (lists occupy several consecutive pool entries).
+    */
+    class MetaTable_
+    {
+  public:
+      void add(UInt64 row, const MetaInfoInterface& meta)
+      {
+        if (meta.isMetaEmpty()) return;
+        vector<String> keys;
+        meta.getKeys(keys);
+        for (const String& key : keys)
+        {
+          const DataValue& value = meta.getMetaValue(key);
+          auto it = key_index_.insert(make_pair(key, UInt32(key_names_.size()))).first;
+          if (it->second == key_names_.size()) key_names_.push_back(key);
+
+          rows_.push_back(row);
+          keys_.push_back(it->second);
+          types_.push_back(UInt32(value.valueType()));
+          switch (value.valueType())
+          {
+            case DataValue::STRING_VALUE:
+              addValues_(strings_, vector<String>(1, value.toString()));
+              break;
+            case DataValue::INT_VALUE:
+              addValues_(ints_, vector<Int64>(1, Int64(value)));
+              break;
+            case DataValue::DOUBLE_VALUE:
+              addValues_(doubles_, vector<double>(1, double(value)));
+              break;
+            case DataValue::STRING_LIST:
+              addValues_(strings_, value.toStringList());
+              break;
+            case DataValue::INT_LIST:
+            {
+              IntList list = value.toIntList();
+              addValues_(ints_, vector<Int64>(list.begin(), list.end()));
+              break;
+            }
+            case DataValue::DOUBLE_LIST:
+              addValues_(doubles_, value.toDoubleList());
+              break;
+            default: // empty value
+              begins_.push_back(0);
+              counts_.push_back(0);
+          }
+        }
+      }
+
+      void write(ColumnWriter_& writer) const
+      {
+        writer.add("meta_row", ColumnarFeatureFile::UINT64_COLUMN, rows_);
+        writer.add("meta_key", ColumnarFeatureFile::UINT32_COLUMN, keys_);
+        writer.add("meta_type", ColumnarFeatureFile::UINT32_COLUMN, types_);
+        writer.add("meta_value_begin", ColumnarFeatureFile::UINT64_COLUMN, begins_);
+        writer.add("meta_value_count", ColumnarFeatureFile::UINT64_COLUMN, counts_);
+        writer.add("meta_key_name", key_names_);
+        writer.add("meta_string", strings_);
+        writer.add("meta_int", ColumnarFeatureFile::INT64_COLUMN, ints_);
+        writer.add("meta_double", ColumnarFeatureFile::DOUBLE_COLUMN, doubles_);
+      }
+
+  private:
+      template <typename T>
+      void addValues_(vector<T>& pool, const vector<T>& values)
+      {
+        begins_.push_back(pool.size());
+        counts_.push_back(values.size());
+        pool.insert(pool.end(), values.begin(), values.end());
+      }
+
+      map<String, UInt32> key_index_;
+      vector<String> key_names_;
+      vector<UInt64> rows_;
+      vector<UInt32> keys_;
+      vector<UInt32> types_;
+      vector<UInt64> begins_;
+      vector<UInt64> counts_;
+      vector<String> strings_;
+      vector<Int64> ints_;
+      vector<double> doubles_;
+    };
+
+    void checkLength_(const String& filename, const String& name, Size length, Size expected)
+    {
+      if (length != expected)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Column '" + name + "' has " + String(length) + " entries, expected " + String(expected) + ".");
+      }
+    }
+
+    /// checks that the offset column @p name (count + 1 entries) indexes a column of size @p target_size
+    void checkOffsets_(const String& filename, const String& name, const vector<UInt64>& offsets, Size expected, Size target_size)
+    {
+      checkLength_(filename, name, offsets.size(), expected + 1);
+      for (Size i = 0; i < expected; ++i)
+      {
+        if (offsets[i] > offsets[i + 1])
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Column '" + name + "' is not sorted.");
+        }
+      }
+      if (offsets[0] != 0 || offsets.back() != target_size)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Column '" + name + "' does not match the indexed data.");
+      }
+    }
+
+    /// like checkOffsets_, for a part of an offset column (which indexes a part of a column of size @p target_size)
+    void checkRangeOffsets_(const String& filename, const String& name, const vector<UInt64>& offsets, Size expected, Size target_size)
+    {
+      checkLength_(filename, name, offsets.size(), expected + 1);
+      for (Size i = 0; i < expected; ++i)
+      {
+        if (offsets[i] > offsets[i + 1])
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Column '" + name + "' is not sorted.");
+        }
+      }
+      if (offsets.back() > target_size)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Column '" + name + "' does not match the indexed data.");
+      }
+    }
+
+    /// returns the first meta table entry with a row index >= @p row (entries are sorted by row)
+    Size metaLowerBound_(const ColumnarFeatureFile& file, UInt64 row)
+    {
+      Size lo = 0, hi = file.getColumnSize("meta_row");
+      vector<UInt64> value;
+      while (lo < hi)
+      {
+        Size mid = lo + (hi - lo) / 2;
+        file.getColumn("meta_row", value, mid, 1);
+        if (value[0] < row)
+        {
+          lo = mid + 1;
+        }
+        else
+        {
+          hi = mid;
+        }
+      }
+      return lo;
+    }
+
+    /// value pool (0: strings, 1: ints, 2: doubles) used by a meta value type, -1 for empty values
+    int poolOf_(UInt32 type)
+    {
+      switch (type)
+      {
+        case DataValue::STRING_VALUE: case DataValue::STRING_LIST: return 0;
+        case DataValue::INT_VALUE: case DataValue::INT_LIST: return 1;
+        case DataValue::DOUBLE_VALUE: case DataValue::DOUBLE_LIST: return 2;
+        default: return -1;
+      }
+    }
+
+    /**
+      Restores the meta values of the entries [first, first + count) of the meta table.
+      Entries for ColumnarFeatureFile::MAP_ROW go to the map itself, the others to
+      map[row - row_offset].
+    */
+    template <typename MapType>
+    void readMetaTable_(const ColumnarFeatureFile& file, const String& filename, MapType& map, UInt64 row_offset, Size first, Size count)
+    {
+      if (count == 0) return;
+      vector<UInt64> rows, begins, counts;
+      vector<UInt32> keys, types;
+      vector<String> key_names;
+      file.getColumn("meta_row", rows, first, count);
+      file.getColumn("meta_key", keys, first, count);
+      file.getColumn("meta_type", types, first, count);
+      file.getColumn("meta_value_begin", begins, first, count);
+      file.getColumn("meta_value_count", counts, first, count);
+      file.getColumn("meta_key_name", key_names);
+      checkLength_(filename, "meta_row", rows.size(), count);
+      checkLength_(filename, "meta_key", keys.size(), count);
+      checkLength_(filename, "meta_type", types.size(), count);
+      checkLength_(filename, "meta_value_begin", begins.size(), count);
+      checkLength_(filename, "meta_value_count", counts.size(), count);
+
+      // read only the part of each value pool that is used by these entries
+      Size pool_first[3] = {numeric_limits<Size>::max(), numeric_limits<Size>::max(), numeric_limits<Size>::max()};
+      Size pool_end[3] = {0, 0, 0};
+      for (Size i = 0; i < count; ++i)
+      {
+        const int pool = poolOf_(types[i]);
+        if (pool < 0 || counts[i] == 0) continue;
+        if (begins[i] + counts[i] < begins[i])
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Invalid meta value entry " + String(first + i) + ".");
+        }
+        pool_first[pool] = min(pool_first[pool], Size(begins[i]));
+        pool_end[pool] = max(pool_end[pool], Size(begins[i] + counts[i]));
+      }
+      for (Size pool = 0; pool < 3; ++pool)
+      {
+        if (pool_end[pool] == 0) pool_first[pool] = 0;
+      }
+      vector<String> strings;
+      vector<Int64> ints;
+      vector<double> doubles;
+      if (pool_end[0] > 0)
+      {
+        if (pool_first[0] > file.getColumnSize("meta_string")) checkLength_(filename, "meta_string", file.getColumnSize("meta_string"), pool_end[0]);
+        file.getColumn("meta_string", strings, pool_first[0], pool_end[0] - pool_first[0]);
+      }
+      if (pool_end[1] > 0)
+      {
+        if (pool_first[1] > file.getColumnSize("meta_int")) checkLength_(filename, "meta_int", file.getColumnSize("meta_int"), pool_end[1]);
+        file.getColumn("meta_int", ints, pool_first[1], pool_end[1] - pool_first[1]);
+      }
+      if (pool_end[2] > 0)
+      {
+        if (pool_first[2] > file.getColumnSize("meta_double")) checkLength_(filename, "meta_double", file.getColumnSize("meta_double"), pool_end[2]);
+        file.getColumn("meta_double", doubles, pool_first[2], pool_end[2] - pool_first[2]);
+      }
+      checkLength_(filename, "meta_string", strings.size(), pool_end[0] - pool_first[0]);
+      checkLength_(filename, "meta_int", ints.size(), pool_end[1] - pool_first[1]);
+      checkLength_(filename, "meta_double", doubles.size(), pool_end[2] - pool_first[2]);
+
+      for (Size i = 0; i < count; ++i)
+      {
+        const bool map_row = rows[i] == ColumnarFeatureFile::MAP_ROW;
+        if ((!map_row && (rows[i] < row_offset || rows[i] - row_offset >= map.size())) || keys[i] >= key_names.size())
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Invalid meta value entry " + String(first + i) + ".");
+        }
+
+        const int pool = poolOf_(types[i]);
+        const Size begin = pool < 0 ? 0 : begins[i] - pool_first[pool];
+        const Size end = begin + counts[i];
+        DataValue value;
+        switch (types[i])
+        {
+          case DataValue::STRING_VALUE:
+            if (counts[i] == 1) value = DataValue(strings[begin]);
+            break;
+          case DataValue::INT_VALUE:
+            if (counts[i] == 1) value = DataValue((long long)ints[begin]);
+            break;
+          case DataValue::DOUBLE_VALUE:
+            if (counts[i] == 1) value = DataValue(doubles[begin]);
+            break;
+          case DataValue::STRING_LIST:
+            value = DataValue(StringList(strings.begin() + begin, strings.begin() + end));
+            break;
+          case DataValue::INT_LIST:
+            value = DataValue(IntList(ints.begin() + begin, ints.begin() + end));
+            break;
+          case DataValue::DOUBLE_LIST:
+            value = DataValue(DoubleList(doubles.begin() + begin, doubles.begin() + end));
+            break;
+          default:
+            break;
+        }
+
+        if (map_row)
+        {
+          map.setMetaValue(key_names[keys[i]], value);
+        }
+        else
+        {
+          map[rows[i] - row_offset].setMetaValue(key_names[keys[i]], value);
+        }
+      }
+    }
+
+    /// columns shared by features and consensus features
+    void writeBaseFeatures_(ColumnWriter_& writer, const vector<const BaseFeature*>& features)
+    {
+      const Size n = features.size();
+      vector<double> rt(n), mz(n);
+      vector<float> intensity(n), quality(n), width(n);
+      vector<Int32> charge(n);
+      vector<UInt64> unique_id(n);
+      for (Size i = 0; i < n; ++i)
+      {
+        const BaseFeature& feature = *features[i];
+        rt[i] = feature.getRT();
+        mz[i] = feature.getMZ();
+        intensity[i] = feature.getIntensity();
+        quality[i] = feature.getQuality();
+        width[i] = feature.getWidth();
+        charge[i] = feature.getCharge();
+        unique_id[i] = feature.getUniqueId();
+      }
+      writer.add("rt", ColumnarFeatureFile::DOUBLE_COLUMN, rt);
+      writer.add("mz", ColumnarFeatureFile::DOUBLE_COLUMN, mz);
+      writer.add("intensity", ColumnarFeatureFile::FLOAT_COLUMN, intensity);
+      writer.add("quality", ColumnarFeatureFile::FLOAT_COLUMN, quality);
+      writer.add("width", ColumnarFeatureFile::FLOAT_COLUMN, width);
+      writer.add("charge", ColumnarFeatureFile::INT32_COLUMN, charge);
+      writer.add("unique_id", ColumnarFeatureFile::UINT64_COLUMN, unique_id);
+    }
+
+    /// reads rows [first, first + map.size()) of the columns shared by features and consensus features
+    template <typename MapType>
+    void readBaseFeatures_(const ColumnarFeatureFile& file, const String& filename, MapType& map, Size first)
+    {
+      const Size n = map.size();
+      vector<double> rt, mz;
+      vector<float> intensity, quality, width;
+      vector<Int32> charge;
+      vector<UInt64> unique_id;
+      file.getColumn("rt", rt, first, n);
+      file.getColumn("mz", mz, first, n);
+      file.getColumn("intensity", intensity, first, n);
+      file.getColumn("quality", quality, first, n);
+      file.getColumn("width", width, first, n);
+      file.getColumn("charge", charge, first, n);
+      file.getColumn("unique_id", unique_id, first, n);
+      checkLength_(filename, "rt", rt.size(), n);
+      checkLength_(filename, "mz", mz.size(), n);
+      checkLength_(filename, "intensity", intensity.size(), n);
+      checkLength_(filename, "quality", quality.size(), n);
+      checkLength_(filename, "width", width.size(), n);
+      checkLength_(filename, "charge", charge.size(), n);
+      checkLength_(filename, "unique_id", unique_id.size(), n);
+      for (Size i = 0; i < n; ++i)
+      {
+        BaseFeature& feature = map[i];
+        feature.setRT(rt[i]);
+        feature.setMZ(mz[i]);
+        feature.setIntensity(intensity[i]);
+        feature.setQuality(quality[i]);
+        feature.setWidth(width[i]);
+        feature.setCharge(charge[i]);
+        feature.setUniqueId(unique_id[i]);
+      }
+    }
+  }
+
+  const UInt64 ColumnarFeatureFile::MAP_ROW = numeric_limits<UInt64>::max();
+
+  ColumnarFeatureFile::ColumnarFeatureFile() :
+    data_(nullptr),
+    map_type_(FEATURE_MAP),
+    size_(0)
+  {
+  }
+
+  ColumnarFeatureFile::ColumnarFeatureFile(const String& filename) :
+    ColumnarFeatureFile()
+  {
+    open(filename);
+  }
+
+  ColumnarFeatureFile::~ColumnarFeatureFile() = default;
+
+  void ColumnarFeatureFile::open(const String& filename)
+  {
+    if (!File::exists(filename))
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    filename_ = filename;
+    mapped_file_.reset();
+    data_ = nullptr;
+    size_ = 0;
+    columns_.clear();
+
+    boost::shared_ptr<boost::interprocess::mapped_region> mapped_file;
+    try
+    {
+      boost::interprocess::file_mapping mapping(filename.c_str(), boost::interprocess::read_only);
+      mapped_file.reset(new boost::interprocess::mapped_region(mapping, boost::interprocess::read_only));
+    }
+    catch (boost::interprocess::interprocess_exception& e)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, String("Could not memory-map file: ") + e.what());
+    }
+
+    const char* data = static_cast<const char*>(mapped_file->get_address());
+    const Size file_size = mapped_file->get_size();
+    if (file_size < HEADER_SIZE || memcmp(data, COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC)) != 0)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Not a columnar feature file.");
+    }
+    UInt64 header[3];
+    memcpy(header, data + sizeof(COLUMNAR_MAGIC), sizeof(header));
+    if (header[0] >= SIZE_OF_MAPTYPE || header[2] > (file_size - HEADER_SIZE) / sizeof(DirectoryRecord))
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Invalid columnar feature file header.");
+    }
+
+    map<String, ColumnEntry> columns;
+    for (UInt64 i = 0; i < header[2]; ++i)
+    {
+      DirectoryRecord record;
+      memcpy(&record, data + HEADER_SIZE + i * sizeof(DirectoryRecord), sizeof(record));
+      record.name[COLUMN_NAME_LENGTH - 1] = 0;
+      const ColumnType type = ColumnType(record.type);
+      bool valid = record.type < SIZE_OF_COLUMNTYPE && record.offset % 8 == 0 &&
+                   record.offset <= file_size && record.bytes <= file_size - record.offset;
+      if (valid && type == STRING_COLUMN)
+      {
+        valid = record.count < record.bytes / sizeof(UInt64);
+      }
+      else if (valid)
+      {
+        valid = record.bytes / elementSize_(type) == record.count && record.bytes % elementSize_(type) == 0;
+      }
+      if (!valid)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, String("Invalid entry for column '") + record.name + "'.");
+      }
+      ColumnEntry entry = {type, record.count, record.offset, record.bytes};
+      columns[record.name] = entry;
+    }
+
+    mapped_file_ = mapped_file;
+    data_ = data;
+    map_type_ = MapType(header[0]);
+    size_ = header[1];
+    columns_.swap(columns);
+  }
+
+  ColumnarFeatureFile::MapType ColumnarFeatureFile::getMapType() const
+  {
+    return map_type_;
+  }
+
+  Size ColumnarFeatureFile::size() const
+  {
+    return size_;
+  }
+
+  vector<String> ColumnarFeatureFile::getColumnNames() const
+  {
+    vector<String> names;
+    for (const auto& column : columns_)
+    {
+      names.push_back(column.first);
+    }
+    return names;
+  }
+
+  bool ColumnarFeatureFile::hasColumn(const String& name) const
+  {
+    return columns_.find(name) != columns_.end();
+  }
+
+  const ColumnarFeatureFile::ColumnEntry& ColumnarFeatureFile::getEntry_(const String& name, ColumnType type) const
+  {
+    auto it = columns_.find(name);
+    if (it == columns_.end())
+    {
+      throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, name);
+    }
+    if (it->second.type != type)
+    {
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Column '" + name + "' has a different type", String(it->second.type));
+    }
+    return it->second;
+  }
+
+  Size ColumnarFeatureFile::getColumnSize(const String& name) const
+  {
+    auto it = columns_.find(name);
+    if (it == columns_.end())
+    {
+      throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, name);
+    }
+    return it->second.count;
+  }
+
+  Size ColumnarFeatureFile::clipRange_(const ColumnEntry& entry, Size first, Size count) const
+  {
+    if (first > entry.count)
+    {
+      throw Exception::IndexOverflow(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, first, entry.count);
+    }
+    return min(count, Size(entry.count - first));
+  }
+
+  template <typename T>
+  void ColumnarFeatureFile::getNumericColumn_(const String& name, ColumnType type, vector<T>& values, Size first, Size count) const
+  {
+    const ColumnEntry& entry = getEntry_(name, type);
+    count = clipRange_(entry, first, count);
+    values.resize(count);
+    if (count > 0) memcpy(values.data(), data_ + entry.offset + first * sizeof(T), count * sizeof(T));
+  }
+
+  void ColumnarFeatureFile::getColumn(const String& name, vector<double>& values, Size first, Size count) const
+  {
+    getNumericColumn_(name, DOUBLE_COLUMN, values, first, count);
+  }
+
+  void ColumnarFeatureFile::getColumn(const String& name, vector<float>& values, Size first, Size count) const
+  {
+    getNumericColumn_(name, FLOAT_COLUMN, values, first, count);
+  }
+
+  void ColumnarFeatureFile::getColumn(const String& name, vector<Int32>& values, Size first, Size count) const
+  {
+    getNumericColumn_(name, INT32_COLUMN, values, first, count);
+  }
+
+  void ColumnarFeatureFile::getColumn(const String& name, vector<Int64>& values, Size first, Size count) const
+  {
+    getNumericColumn_(name, INT64_COLUMN, values, first, count);
+  }
+
+  void ColumnarFeatureFile::getColumn(const String& name, vector<UInt32>& values, Size first, Size count) const
+  {
+    getNumericColumn_(name, UINT32_COLUMN, values, first, count);
+  }
+
+  void ColumnarFeatureFile::getColumn(const String& name, vector<UInt64>& values, Size first, Size count) const
+  {
+    getNumericColumn_(name, UINT64_COLUMN, values, first, count);
+  }
+
+  void ColumnarFeatureFile::getColumn(const String& name, vector<String>& values, Size first, Size count) const
+  {
+    const ColumnEntry& entry = getEntry_(name, STRING_COLUMN);
+    count = clipRange_(entry, first, count);
+    const Size offsets_bytes = (entry.count + 1) * sizeof(UInt64);
+    vector<UInt64> offsets(count + 1);
+    memcpy(offsets.data(), data_ + entry.offset + first * sizeof(UInt64), offsets.size() * sizeof(UInt64));
+    checkRangeOffsets_(filename_, name, offsets, count, entry.bytes - offsets_bytes);
+    const char* chars = data_ + entry.offset + offsets_bytes;
+    values.resize(count);
+    for (Size i = 0; i < count; ++i)
+    {
+      values[i] = String(chars + offsets[i], chars + offsets[i + 1]);
+    }
+  }
+
+  void ColumnarFeatureFile::checkMapType_(MapType type) const
+  {
+    if (map_type_ != type)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_, type == FEATURE_MAP ? "File contains a consensus map, not a feature map." : "File contains a feature map, not a consensus map.");
+    }
+  }
+
+  void ColumnarFeatureFile::store(const String& filename, const FeatureMap& map)
+  {
+    ColumnWriter_ writer;
+    vector<const BaseFeature*> features;
+    features.reserve(map.size());
+    vector<float> quality_rt, quality_mz;
+    quality_rt.reserve(map.size());
+    quality_mz.reserve(map.size());
+    vector<UInt64> hull_begin(1, 0), hull_point_begin(1, 0);
+    hull_begin.reserve(map.size() + 1);
+    vector<double> hull_point_rt, hull_point_mz;
+    MetaTable_ meta;
+    for (Size i = 0; i < map.size(); ++i)
+    {
+      const Feature& feature = map[i];
+      features.push_back(&feature);
+      quality_rt.push_back(feature.getQuality(0));
+      quality_mz.push_back(feature.getQuality(1));
+      for (const ConvexHull2D& hull : feature.getConvexHulls())
+      {
+        for (const ConvexHull2D::PointType& point : hull.getHullPoints())
+        {
+          hull_point_rt.push_back(point.getX());
+          hull_point_mz.push_back(point.getY());
+        }
+        hull_point_begin.push_back(hull_point_rt.size());
+      }
+      hull_begin.push_back(hull_point_begin.size() - 1);
+      meta.add(i, feature);
+    }
+    meta.add(MAP_ROW, map);
+
+    writeBaseFeatures_(writer, features);
+    writer.add("quality_rt", FLOAT_COLUMN, quality_rt);
+    writer.add("quality_mz", FLOAT_COLUMN, quality_mz);
+    writer.add("hull_begin", UINT64_COLUMN, hull_begin);
+    writer.add("hull_point_begin", UINT64_COLUMN, hull_point_begin);
+    writer.add("hull_point_rt", DOUBLE_COLUMN, hull_point_rt);
+    writer.add("hull_point_mz", DOUBLE_COLUMN, hull_point_mz);
+    writer.add("map_unique_id", UINT64_COLUMN, vector<UInt64>(1, map.getUniqueId()));
+    meta.write(writer);
+    writer.write(filename, FEATURE_MAP, map.size());
+  }
+
+  void ColumnarFeatureFile::store(const String& filename, const ConsensusMap& map)
+  {
+    ColumnWriter_ writer;
+    vector<const BaseFeature*> features;
+    features.reserve(map.size());
+    vector<UInt64> handle_begin(1, 0), handle_map_index, handle_unique_id;
+    handle_begin.reserve(map.size() + 1);
+    vector<double> handle_rt, handle_mz;
+    vector<float> handle_intensity, handle_width;
+    vector<Int32> handle_charge;
+    MetaTable_ meta;
+    for (Size i = 0; i < map.size(); ++i)
+    {
+      const ConsensusFeature& feature = map[i];
+      features.push_back(&feature);
+      for (const FeatureHandle& handle : feature.getFeatures())
+      {
+        handle_map_index.push_back(handle.getMapIndex());
+        handle_unique_id.push_back(handle.getUniqueId());
+        handle_rt.push_back(handle.getRT());
+        handle_mz.push_back(handle.getMZ());
+        handle_intensity.push_back(handle.getIntensity());
+        handle_width.push_back(handle.getWidth());
+        handle_charge.push_back(handle.getCharge());
+      }
+      handle_begin.push_back(handle_map_index.size());
+      meta.add(i, feature);
+    }
+    meta.add(MAP_ROW, map);
+
+    vector<UInt64> header_index, header_size, header_unique_id;
+    vector<String> header_filename, header_label;
+    for (const auto& header : map.getColumnHeaders())
+    {
+      header_index.push_back(header.first);
+      header_filename.push_back(header.second.filename);
+      header_label.push_back(header.second.label);
+      header_size.push_back(header.second.size);
+      header_unique_id.push_back(header.second.unique_id);
+    }
+
+    writeBaseFeatures_(writer, features);
+    writer.add("handle_begin", UINT64_COLUMN, handle_begin);
+    writer.add("handle_map_index", UINT64_COLUMN, handle_map_index);
+    writer.add("handle_unique_id", UINT64_COLUMN, handle_unique_id);
+    writer.add("handle_rt", DOUBLE_COLUMN, handle_rt);
+    writer.add("handle_mz", DOUBLE_COLUMN, handle_mz);
+    writer.add("handle_intensity", FLOAT_COLUMN, handle_intensity);
+    writer.add("handle_width", FLOAT_COLUMN, handle_width);
+    writer.add("handle_charge", INT32_COLUMN, handle_charge);
+    writer.add("column_header_index", UINT64_COLUMN, header_index);
+    writer.add("column_header_filename", header_filename);
+    writer.add("column_header_label", header_label);
+    writer.add("column_header_size", UINT64_COLUMN, header_size);
+    writer.add("column_header_unique_id", UINT64_COLUMN, header_unique_id);
+    writer.add("map_unique_id", UINT64_COLUMN, vector<UInt64>(1, map.getUniqueId()));
+    writer.add("experiment_type", vector<String>(1, map.getExperimentType()));
+    meta.write(writer);
+    writer.write(filename, CONSENSUS_MAP, map.size());
+  }
+
+  void ColumnarFeatureFile::loadRange(Size first, Size count, FeatureMap& map) const
+  {
+    checkMapType_(FEATURE_MAP);
+    if (first > size_)
+    {
+      throw Exception::IndexOverflow(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, first, size_);
+    }
+    const Size n = min(count, Size(size_ - first));
+    map.clear(false);
+    map.resize(n);
+    readBaseFeatures_(*this, filename_, map, first);
+
+    vector<float> quality_rt, quality_mz;
+    getColumn("quality_rt", quality_rt, first, n);
+    getColumn("quality_mz", quality_mz, first, n);
+    checkLength_(filename_, "quality_rt", quality_rt.size(), n);
+    checkLength_(filename_, "quality_mz", quality_mz.size(), n);
+
+    // hulls of the features and points of these hulls
+    vector<UInt64> hull_begin, hull_point_begin;
+    vector<double> hull_point_rt, hull_point_mz;
+    if (getColumnSize("hull_point_begin") == 0)
+    {
+      checkLength_(filename_, "hull_point_begin", 0, 1);
+    }
+    getColumn("hull_begin", hull_begin, first, n + 1);
+    checkRangeOffsets_(filename_, "hull_begin", hull_begin, n, getColumnSize("hull_point_begin") - 1);
+    getColumn("hull_point_begin", hull_point_begin, hull_begin.front(), hull_begin.back() - hull_begin.front() + 1);
+    checkRangeOffsets_(filename_, "hull_point_begin", hull_point_begin, hull_begin.back() - hull_begin.front(), getColumnSize("hull_point_rt"));
+    getColumn("hull_point_rt", hull_point_rt, hull_point_begin.front(), hull_point_begin.back() - hull_point_begin.front());
+    getColumn("hull_point_mz", hull_point_mz, hull_point_begin.front(), hull_point_begin.back() - hull_point_begin.front());
+    checkLength_(filename_, "hull_point_mz", hull_point_mz.size(), hull_point_rt.size());
+
+    for (Size i = 0; i < n; ++i)
+    {
+      Feature& feature = map[i];
+      feature.setQuality(0, quality_rt[i]);
+      feature.setQuality(1, quality_mz[i]);
+      vector<ConvexHull2D>& hulls = feature.getConvexHulls();
+      hulls.resize(hull_begin[i + 1] - hull_begin[i]);
+      for (Size h = 0; h < hulls.size(); ++h)
+      {
+        const Size hull_index = hull_begin[i] + h - hull_begin.front();
+        const Size point_begin = hull_point_begin[hull_index] - hull_point_begin.front();
+        const Size point_end = hull_point_begin[hull_index + 1] - hull_point_begin.front();
+        ConvexHull2D::PointArrayType points;
+        points.reserve(point_end - point_begin);
+        for (Size p = point_begin; p < point_end; ++p)
+        {
+          points.push_back(ConvexHull2D::PointType(hull_point_rt[p], hull_point_mz[p]));
+        }
+        hulls[h].setHullPoints(points);
+      }
+    }
+
+    const Size meta_first = metaLowerBound_(*this, first);
+    readMetaTable_(*this, filename_, map, first, meta_first, metaLowerBound_(*this, first + n) - meta_first);
+    map.updateRanges();
+  }
+
+  void ColumnarFeatureFile::load(const String& filename, FeatureMap& map)
+  {
+    ColumnarFeatureFile file(filename);
+    file.checkMapType_(FEATURE_MAP);
+    map.clear(true);
+    file.loadRange(0, file.size(), map);
+
+    // meta values of the map itself
+    const Size map_meta_first = metaLowerBound_(file, MAP_ROW);
+    readMetaTable_(file, filename, map, 0, map_meta_first, file.getColumnSize("meta_row") - map_meta_first);
+    vector<UInt64> map_unique_id;
+    file.getColumn("map_unique_id", map_unique_id);
+    checkLength_(filename, "map_unique_id", map_unique_id.size(), 1);
+    map.setUniqueId(map_unique_id[0]);
+  }
+
+  void ColumnarFeatureFile::load(const String& filename, ConsensusMap& map)
+  {
+    ColumnarFeatureFile file(filename);
+    file.checkMapType_(CONSENSUS_MAP);
+    const Size n = file.size();
+    map.clear(true);
+    map.resize(n);
+    readBaseFeatures_(file, filename, map, 0);
+
+    vector<UInt64> handle_begin, handle_map_index, handle_unique_id;
+    vector<double> handle_rt, handle_mz;
+    vector<float> handle_intensity, handle_width;
+    vector<Int32> handle_charge;
+    file.getColumn("handle_begin", handle_begin);
+    file.getColumn("handle_map_index", handle_map_index);
+    file.getColumn("handle_unique_id", handle_unique_id);
+    file.getColumn("handle_rt", handle_rt);
+    file.getColumn("handle_mz", handle_mz);
+    file.getColumn("handle_intensity", handle_intensity);
+    file.getColumn("handle_width", handle_width);
+    file.getColumn("handle_charge", handle_charge);
+    const Size nr_handles = handle_map_index.size();
+    checkLength_(filename, "handle_unique_id", handle_unique_id.size(), nr_handles);
+    checkLength_(filename, "handle_rt", handle_rt.size(), nr_handles);
+    checkLength_(filename, "handle_mz", handle_mz.size(), nr_handles);
+    checkLength_(filename, "handle_intensity", handle_intensity.size(), nr_handles);
+    checkLength_(filename, "handle_width", handle_width.size(), nr_handles);
+    checkLength_(filename, "handle_charge", handle_charge.size(), nr_handles);
+    checkOffsets_(filename, "handle_begin", handle_begin, n, nr_handles);
+
+    for (Size i = 0; i < n; ++i)
+    {
+      ConsensusFeature::HandleSetType handles;
+      for (Size h = handle_begin[i]; h < handle_begin[i + 1]; ++h)
+      {
+        FeatureHandle handle;
+        handle.setMapIndex(handle_map_index[h]);
+        handle.setUniqueId(handle_unique_id[h]);
+        handle.setRT(handle_rt[h]);
+        handle.setMZ(handle_mz[h]);
+        handle.setIntensity(handle_intensity[h]);
+        handle.setWidth(handle_width[h]);
+        handle.setCharge(handle_charge[h]);
+        handles.insert(handles.end(), handle);
+      }
+      map[i].setFeatures(handles);
+    }
+
+    vector<UInt64> header_index, header_size, header_unique_id;
+    vector<String> header_filename, header_label;
+    file.getColumn("column_header_index", header_index);
+    file.getColumn("column_header_filename", header_filename);
+    file.getColumn("column_header_label", header_label);
+    file.getColumn("column_header_size", header_size);
+    file.getColumn("column_header_unique_id", header_unique_id);
+    checkLength_(filename, "column_header_filename", header_filename.size(), header_index.size());
+    checkLength_(filename, "column_header_label", header_label.size(), header_index.size());
+    checkLength_(filename, "column_header_size", header_size.size(), header_index.size());
+    checkLength_(filename, "column_header_unique_id", header_unique_id.size(), header_index.size());
+    ConsensusMap::ColumnHeaders& headers = map.getColumnHeaders();
+    headers.clear();
+    for (Size i = 0; i < header_index.size(); ++i)
+    {
+      ConsensusMap::ColumnHeader& header = headers[header_index[i]];
+      header.filename = header_filename[i];
+      header.label = header_label[i];
+      header.size = header_size[i];
+      header.unique_id = header_unique_id[i];
+    }
+
+    readMetaTable_(file, filename, map, 0, 0, file.getColumnSize("meta_row"));
+    vector<UInt64> map_unique_id;
+    vector<String> experiment_type;
+    file.getColumn("map_unique_id", map_unique_id);
+    file.getColumn("experiment_type", experiment_type);
+    checkLength_(filename, "map_unique_id", map_unique_id.size(), 1);
+    checkLength_(filename, "experiment_type", experiment_type.size(), 1);
+    map.setUniqueId(map_unique_id[0]);
+    map.setExperimentType(experiment_type[0]);
+    map.updateRanges();
+  }
+
+} // namespace OpenMS
@@ -35,9 +35,12 @@
 #include <OpenMS/FORMAT/ControlledVocabulary.h>
 
 #include <OpenMS/FORMAT/HANDLERS/XMLHandler.h>
+#include <OpenMS/SYSTEM/File.h>
 
-#include <iostream>
+#include <algorithm>
 #include <fstream>
+#include <functional>
+#include <iostream>
 
 using namespace std;
 
@@ -185,6 +188,22 @@ namespace OpenMS
 
   }
 
+  const ControlledVocabulary& ControlledVocabulary::getPSIMSCV()
+  {
+    // initialization of a function-local static is thread-safe
+    static const ControlledVocabulary cv = []()
+    {
+      ControlledVocabulary psi_ms;
+      psi_ms.loadFromOBO("MS", File::find("/CV/psi-ms.obo"));
+      psi_ms.loadFromOBO("PATO", File::find("/CV/quality.obo"));
+      psi_ms.loadFromOBO("UO", File::find("/CV/unit.obo"));
+      psi_ms.loadFromOBO("BTO", File::find("/CV/brenda.obo"));
+      psi_ms.loadFromOBO("GO", File::find("/CV/goslim_goa.obo"));
+      return psi_ms;
+    }();
+    return cv;
+  }
+
   void ControlledVocabulary::loadFromOBO(const String& name, const String& filename)
   {
     bool in_term = false;
@@ -441,6 +460,47 @@ namespace OpenMS
         namesToIds_.insert(pair<String, String>(s, it->first));
       }
     }
+
+    updateAncestors_();
+  }
+
+  void ControlledVocabulary::updateAncestors_()
+  {
+    // all parents are part of terms_ (see loadFromOBO()), so every ID referenced anywhere has an index
+    term_index_.clear();
+    term_index_.reserve(terms_.size());
+    std::vector<const CVTerm*> terms;
+    terms.reserve(terms_.size());
+    for (const auto& t : terms_)
+    {
+      term_index_.emplace(t.first, terms.size());
+      terms.push_back(&t.second);
+    }
+
+    ancestors_.assign(terms.size(), std::vector<Size>());
+    std::vector<bool> visited(terms.size(), false);
+    std::function<const std::vector<Size>&(Size)> collect = [&](Size i) -> const std::vector<Size>&
+    {
+      if (visited[i]) return ancestors_[i]; // done (or a cycle in a broken ontology)
+      visited[i] = true;
+      std::vector<Size> ancestors;
+      for (const String& parent : terms[i]->parents)
+      {
+        const auto it = term_index_.find(parent);
+        if (it == term_index_.end()) continue;
+        ancestors.push_back(it->second);
+        const std::vector<Size>& indirect = collect(it->second);
+        ancestors.insert(ancestors.end(), indirect.begin(), indirect.end());
+      }
+      std::sort(ancestors.begin(), ancestors.end());
+      ancestors.erase(std::unique(ancestors.begin(), ancestors.end()), ancestors.end());
+      ancestors_[i].swap(ancestors);
+      return ancestors_[i];
+    };
+    for (Size i = 0; i < terms.size(); ++i)
+    {
+      collect(i);
+    }
   }
 
   const ControlledVocabulary::CVTerm& ControlledVocabulary::getTerm(const String& id) const
@@ -512,26 +572,18 @@ namespace OpenMS
 
   bool ControlledVocabulary::isChildOf(const String& child, const String& parent) const
   {
-    // cout << "CHECK child:" << child << " parent: " << parent << "\n";
-    const CVTerm& ch = getTerm(child);
-
-    for (const auto & it : ch.parents)
+    const auto ch = term_index_.find(child);
+    if (ch == term_index_.end())
     {
-      // cout << "Parent: " << it << "\n";
-
-      // check if it is a direct parent
-      if (it == parent)
-      {
-        return true;
-      }
-      // check if it is an indirect parent
-      else if (isChildOf(it, parent))
-      {
-        return true;
-      }
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Invalid CV identifier!", child);
     }
-
-    return false;
+    const auto pa = term_index_.find(parent);
+    if (pa == term_index_.end())
+    {
+      return false;
+    }
+    const std::vector<Size>& ancestors = ancestors_[ch->second];
+    return std::binary_search(ancestors.begin(), ancestors.end(), pa->second);
   }
 
   std::ostream& operator<<(std::ostream& os, const ControlledVocabulary& cv)
@@ -0,0 +1,172 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/FORMAT/DATAACCESS/IdXMLWritingConsumer.h>
+
+#include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/FORMAT/FileHandler.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <algorithm>
+
+namespace OpenMS
+{
+
+  IdXMLWritingConsumer::IdXMLWritingConsumer(const String& filename, const String& document_id) :
+    filename_(filename),
+    document_id_(document_id),
+    prot_count_(0),
+    count_empty_(0),
+    count_missing_run_(0),
+    closed_(false)
+  {
+    if (!FileHandler::hasValidExtension(filename, FileTypes::IDXML))
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename,
+          "invalid file extension, expected '" + FileTypes::typeToName(FileTypes::IDXML) + "'");
+    }
+    // fail early (the file is written in close())
+    std::ofstream os(filename.c_str());
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    id_xml_.file_ = filename;
+  }
+
+  IdXMLWritingConsumer::~IdXMLWritingConsumer()
+  {
+    if (closed_) return;
+    try
+    {
+      close();
+    }
+    catch (Exception::BaseException& e)
+    {
+      OPENMS_LOG_ERROR << "Error while writing '" << filename_ << "': " << e.what() << std::endl;
+    }
+  }
+
+  void IdXMLWritingConsumer::consumeProteinIdentification(ProteinIdentification& prot_id)
+  {
+    if (closed_)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Cannot consume after close()");
+    }
+    if (run_index_.count(prot_id.getIdentifier()))
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "ProteinIdentifications are not unique, which leads to loss of unique PeptideIdentification assignment. Duplicated Protein-ID is: " + prot_id.getIdentifier());
+    }
+    if (std::find(params_.begin(), params_.end(), prot_id.getSearchParameters()) == params_.end())
+    {
+      params_.push_back(prot_id.getSearchParameters());
+    }
+
+    Run_ run;
+    run.identifier = prot_id.getIdentifier();
+    run.tmp_file = File::getTemporaryFile();
+    run.os.reset(new std::ofstream(run.tmp_file.c_str()));
+    if (!*run.os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, run.tmp_file);
+    }
+    run.os->precision(writtenDigits<double>(0.0));
+    id_xml_.writeRunStart_(*run.os, prot_id, params_, prot_count_, accession_to_id_);
+
+    run_index_[run.identifier] = runs_.size();
+    runs_.push_back(std::move(run));
+  }
+
+  void IdXMLWritingConsumer::consumePeptideIdentifications(std::vector<PeptideIdentification>& pep_ids)
+  {
+    if (closed_)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Cannot consume after close()");
+    }
+    for (const PeptideIdentification& pep_id : pep_ids)
+    {
+      if (pep_id.getHits().empty())
+      {
+        ++count_empty_;
+        continue;
+      }
+      auto pos = run_index_.find(pep_id.getIdentifier());
+      if (pos == run_index_.end())
+      {
+        ++count_missing_run_;
+        continue;
+      }
+      const Run_& run = runs_[pos->second];
+      id_xml_.writePeptideIdentification_(*run.os, pep_id, accession_to_id_, run.identifier);
+    }
+  }
+
+  void IdXMLWritingConsumer::close()
+  {
+    if (closed_) return;
+    closed_ = true;
+
+    std::ofstream os(filename_.c_str());
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_);
+    }
+    id_xml_.writeHeader_(os, document_id_);
+    id_xml_.writeSearchParameters_(os, params_);
+    for (Run_& run : runs_)
+    {
+      run.os->close();
+      std::ifstream is(run.tmp_file.c_str());
+      if (is.peek() != std::ifstream::traits_type::eof()) // 'rdbuf' sets failbit on empty input
+      {
+        os << is.rdbuf();
+      }
+      is.close();
+      os << "\t</IdentificationRun>\n";
+      File::remove(run.tmp_file);
+    }
+    id_xml_.writeFooter_(os, runs_.empty());
+    os.close();
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_);
+    }
+
+    if (count_empty_) OPENMS_LOG_WARN << "Omitted writing of " << count_empty_ << " peptide identifications due to empty hits." << std::endl;
+    if (count_missing_run_) OPENMS_LOG_WARN << "Omitted writing of " << count_missing_run_ << " peptide identifications because of missing ProteinIdentification while writing '" << filename_ << "'!" << std::endl;
+  }
+
+} //end namespace OpenMS
@@ -0,0 +1,163 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataBlockMergingConsumer.h>
+
+#include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/DATASTRUCTURES/ListUtils.h>
+
+#include <limits>
+
+namespace OpenMS
+{
+
+  MSDataBlockMergingConsumer::MSDataBlockMergingConsumer(Interfaces::IMSDataConsumer* next_consumer, const SpectraMerger& merger) :
+    next_consumer_(next_consumer),
+    merger_(merger),
+    ms_levels_(merger.getParameters().getValue("block_method:ms_levels").toIntList()),
+    rt_block_size_((Size)(Int)merger.getParameters().getValue("block_method:rt_block_size")),
+    rt_max_length_(merger.getParameters().getValue("block_method:rt_max_length"))
+  {
+    if (rt_max_length_ == 0) // no rt restriction set?
+    {
+      rt_max_length_ = (std::numeric_limits<double>::max)(); // set max rt span to very large value
+    }
+  }
+
+  MSDataBlockMergingConsumer::~MSDataBlockMergingConsumer()
+  {
+    try
+    {
+      flush();
+    }
+    catch (Exception::BaseException& e)
+    {
+      OPENMS_LOG_ERROR << "Error while merging the last blocks of spectra: " << e.what() << std::endl;
+    }
+  }
+
+  void MSDataBlockMergingConsumer::setExpectedSize(Size expectedSpectra, Size expectedChromatograms)
+  {
+    next_consumer_->setExpectedSize(expectedSpectra, expectedChromatograms);
+  }
+
+  void MSDataBlockMergingConsumer::setExperimentalSettings(const OpenMS::ExperimentalSettings& exp)
+  {
+    next_consumer_->setExperimentalSettings(exp);
+  }
+
+  void MSDataBlockMergingConsumer::consumeSpectrum(SpectrumType& s)
+  {
+    Int ms_level = (Int)s.getMSLevel();
+    if (!ListUtils::contains(ms_levels_, ms_level))
+    {
+      output_.insert(std::make_pair(s.getRT(), s));
+    }
+    else
+    {
+      // block full if it contains a maximum number of scans or if maximum rt length spanned
+      auto block_it = blocks_.find(ms_level);
+      if (block_it != blocks_.end() &&
+          (block_it->second.size() >= rt_block_size_ ||
+           s.getRT() - block_it->second[0].getRT() > rt_max_length_))
+      {
+        closeBlock_(ms_level, false);
+      }
+      blocks_[ms_level].addSpectrum(s);
+    }
+
+    // merged spectra get the average RT of their block, so nothing before the
+    // first spectrum of an open block can be preceded by a later spectrum
+    double rt_limit = s.getRT();
+    for (const auto& block : blocks_)
+    {
+      rt_limit = std::min(rt_limit, block.second[0].getRT());
+    }
+    release_(rt_limit);
+  }
+
+  void MSDataBlockMergingConsumer::consumeChromatogram(ChromatogramType& c)
+  {
+    flush();
+    next_consumer_->consumeChromatogram(c);
+  }
+
+  void MSDataBlockMergingConsumer::flush()
+  {
+    while (!blocks_.empty())
+    {
+      closeBlock_(blocks_.begin()->first, true);
+    }
+    for (auto& entry : output_)
+    {
+      next_consumer_->consumeSpectrum(entry.second);
+    }
+    output_.clear();
+  }
+
+  void MSDataBlockMergingConsumer::closeBlock_(Int ms_level, bool last)
+  {
+    auto block_it = blocks_.find(ms_level);
+    if (block_it == blocks_.end()) return;
+
+    PeakMap& block = block_it->second;
+    if (block.size() == 1 && !last)
+    {
+      output_.insert(std::make_pair(block[0].getRT(), block[0]));
+    }
+    else
+    {
+      SpectrumType merged = merger_.mergeBlock(block, ms_level);
+      if (!merged.empty())
+      {
+        double rt = merged.getRT();
+        output_.insert(std::make_pair(rt, std::move(merged)));
+      }
+    }
+    blocks_.erase(block_it);
+  }
+
+  void MSDataBlockMergingConsumer::release_(double rt_limit)
+  {
+    auto end = output_.lower_bound(rt_limit);
+    for (auto it = output_.begin(); it != end; ++it)
+    {
+      next_consumer_->consumeSpectrum(it->second);
+    }
+    output_.erase(output_.begin(), end);
+  }
+
+} // namespace OpenMS
@@ -63,6 +63,12 @@ namespace OpenMS
     ofs_.close();
   }
 
+  void MSDataCachedConsumer::setExpectedSize(Size expectedSpectra, Size expectedChromatograms)
+  {
+    spectra_index_.reserve(expectedSpectra);
+    chrom_index_.reserve(expectedChromatograms);
+  }
+
   void MSDataCachedConsumer::consumeSpectrum(SpectrumType & s)
   {
     if (chromatograms_written_ > 0)
@@ -70,6 +76,7 @@ namespace OpenMS
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
         "Cannot write spectra after writing chromatograms.");
     }
+    spectra_index_.push_back(ofs_.tellp());
     writeSpectrum_(s, ofs_);
     spectra_written_++;
 
@@ -87,6 +94,7 @@ namespace OpenMS
 
   void MSDataCachedConsumer::consumeChromatogram(ChromatogramType & c)
   {
+    chrom_index_.push_back(ofs_.tellp());
     writeChromatogram_(c, ofs_);
     chromatograms_written_++;
 
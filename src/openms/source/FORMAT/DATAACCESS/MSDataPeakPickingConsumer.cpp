@@ -0,0 +1,198 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataPeakPickingConsumer.h>
+
+#include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/DATASTRUCTURES/ListUtils.h>
+
+namespace OpenMS
+{
+
+  MSDataPeakPickingConsumer::MSDataPeakPickingConsumer(Interfaces::IMSDataConsumer* next_consumer, const PeakPickerHiRes& pp,
+                                                       Size batch_size, bool check_spectrum_type) :
+    next_consumer_(next_consumer),
+    pp_(pp),
+    ms_levels_(pp.getParameters().getValue("ms_levels").toIntList()),
+    batch_size_(std::max(batch_size, Size(1))),
+    check_spectrum_type_(check_spectrum_type)
+  {
+    spectra_.reserve(batch_size_);
+  }
+
+  MSDataPeakPickingConsumer::~MSDataPeakPickingConsumer()
+  {
+    try
+    {
+      flush();
+    }
+    catch (Exception::BaseException& e)
+    {
+      OPENMS_LOG_ERROR << "Error while picking the last batch of data: " << e.what() << std::endl;
+    }
+  }
+
+  void MSDataPeakPickingConsumer::setExpectedSize(Size expectedSpectra, Size expectedChromatograms)
+  {
+    next_consumer_->setExpectedSize(expectedSpectra, expectedChromatograms);
+  }
+
+  void MSDataPeakPickingConsumer::setExperimentalSettings(const OpenMS::ExperimentalSettings& exp)
+  {
+    next_consumer_->setExperimentalSettings(exp);
+  }
+
+  void MSDataPeakPickingConsumer::consumeSpectrum(SpectrumType& s)
+  {
+    // keep the order of spectra and chromatograms intact
+    if (!chromatograms_.empty()) flushChromatograms_();
+
+    spectra_.push_back(s);
+    if (spectra_.size() >= batch_size_) flushSpectra_();
+  }
+
+  void MSDataPeakPickingConsumer::consumeChromatogram(ChromatogramType& c)
+  {
+    if (!spectra_.empty()) flushSpectra_();
+
+    chromatograms_.push_back(c);
+    if (chromatograms_.size() >= batch_size_) flushChromatograms_();
+  }
+
+  void MSDataPeakPickingConsumer::flush()
+  {
+    flushSpectra_();
+    flushChromatograms_();
+  }
+
+  void MSDataPeakPickingConsumer::flushSpectra_()
+  {
+    if (spectra_.empty()) return;
+
+    Size errCount = 0;
+    String error_message;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)spectra_.size(); ++i)
+    {
+      SpectrumType& s = spectra_[i];
+      try
+      {
+        // same selection as in PeakPickerHiRes::pickExperiment
+        if (ms_levels_.empty())
+        {
+          if (s.getType(true) == SpectrumSettings::CENTROID) continue;
+        }
+        else if (!ListUtils::contains(ms_levels_, s.getMSLevel()))
+        {
+          continue;
+        }
+        else if (check_spectrum_type_ && s.getType(true) == SpectrumSettings::CENTROID)
+        {
+          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Error: Centroided data provided but profile spectra expected.");
+        }
+
+        SpectrumType picked;
+        pp_.pick(s, picked);
+        s = std::move(picked);
+      }
+      catch (Exception::BaseException& e)
+      {
+#ifdef _OPENMP
+#pragma omp critical (MSDataPeakPickingConsumer_error)
+#endif
+        {
+          ++errCount;
+          error_message = e.what();
+        }
+      }
+    }
+    if (errCount != 0)
+    {
+      spectra_.clear();
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, error_message);
+    }
+
+    for (SpectrumType& s : spectra_)
+    {
+      next_consumer_->consumeSpectrum(s);
+    }
+    spectra_.clear();
+  }
+
+  void MSDataPeakPickingConsumer::flushChromatograms_()
+  {
+    if (chromatograms_.empty()) return;
+
+    Size errCount = 0;
+    String error_message;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)chromatograms_.size(); ++i)
+    {
+      try
+      {
+        ChromatogramType picked;
+        pp_.pick(chromatograms_[i], picked);
+        chromatograms_[i] = std::move(picked);
+      }
+      catch (Exception::BaseException& e)
+      {
+#ifdef _OPENMP
+#pragma omp critical (MSDataPeakPickingConsumer_error)
+#endif
+        {
+          ++errCount;
+          error_message = e.what();
+        }
+      }
+    }
+    if (errCount != 0)
+    {
+      chromatograms_.clear();
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, error_message);
+    }
+
+    for (ChromatogramType& c : chromatograms_)
+    {
+      next_consumer_->consumeChromatogram(c);
+    }
+    chromatograms_.clear();
+  }
+
+} // namespace OpenMS
+
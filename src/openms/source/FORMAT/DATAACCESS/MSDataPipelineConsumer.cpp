@@ -0,0 +1,380 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataPipelineConsumer.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/KERNEL/MSChromatogram.h>
+#include <OpenMS/KERNEL/MSSpectrum.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace OpenMS
+{
+  namespace
+  {
+    /// a spectrum or chromatogram passing through the pipeline
+    struct Item_
+    {
+      Size index = 0; ///< position in the order of consumption
+      bool is_spectrum = true;
+      MSSpectrum spectrum;
+      MSChromatogram chromatogram;
+    };
+
+    typedef std::unique_ptr<Item_> ItemPtr_;
+
+    /**
+      Queue that hands out the items strictly in the order of their index, independent of the order in
+      which they were pushed. push() waits until the index lies within the next @p capacity items to be
+      popped, so the item that is needed next can always be pushed.
+    */
+    class OrderedQueue_
+    {
+    public:
+      explicit OrderedQueue_(Size capacity) :
+        capacity_(std::max(capacity, Size(1)))
+      {
+      }
+
+      /// returns false if the queue was aborted
+      bool push(ItemPtr_ item)
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        const Size index = item->index;
+        not_full_.wait(lock, [&] { return aborted_ || index < next_ + capacity_; });
+        if (aborted_) return false;
+        items_.emplace(index, std::move(item));
+        if (index == next_) ready_.notify_all();
+        return true;
+      }
+
+      /// returns the next item, or nullptr once all items were popped or the queue was aborted
+      ItemPtr_ pop()
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_.wait(lock, [&] { return aborted_ || next_ == end_ || (!items_.empty() && items_.begin()->first == next_); });
+        if (aborted_ || next_ == end_) return nullptr;
+        ItemPtr_ item = std::move(items_.begin()->second);
+        items_.erase(items_.begin());
+        ++next_;
+        not_full_.notify_all();
+        if (!items_.empty() && items_.begin()->first == next_) ready_.notify_all(); // for other workers
+        return item;
+      }
+
+      /// sets the total number of items that will be pushed
+      void close(Size end)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        end_ = end;
+        ready_.notify_all();
+      }
+
+      /// wakes up all waiting threads; all further calls of push() and pop() fail
+      void abort()
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        aborted_ = true;
+        ready_.notify_all();
+        not_full_.notify_all();
+      }
+
+    private:
+      std::mutex mutex_;
+      std::condition_variable ready_;    ///< signalled when the next item becomes available
+      std::condition_variable not_full_; ///< signalled when an item was popped
+      std::map<Size, ItemPtr_> items_;
+      Size capacity_;
+      Size next_ = 0; ///< index of the next item to pop
+      Size end_ = std::numeric_limits<Size>::max();
+      bool aborted_ = false;
+    };
+  }
+
+  struct MSDataPipelineConsumer::Impl_
+  {
+    /// a consumer of a stage with its input queue
+    struct Branch
+    {
+      Interfaces::IMSDataConsumer * consumer;
+      Size workers;
+      std::unique_ptr<OrderedQueue_> queue;
+    };
+
+    /// a stage has a single branch or, for fan-out stages, one branch per consumer
+    typedef std::vector<Branch> Stage;
+
+    Size queue_size;
+    std::vector<Stage> stages;
+    bool fan_out = false; ///< is the last stage a fan-out stage?
+    bool started = false;
+    bool finished = false;
+    Size count = 0; ///< number of consumed items
+    std::vector<std::thread> threads;
+
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    bool error_reported = false;
+
+    explicit Impl_(Size size) :
+      queue_size(size)
+    {
+    }
+
+    void checkAppend(const Interfaces::IMSDataConsumer * consumer) const
+    {
+      if (consumer == nullptr)
+      {
+        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Consumer must not be null.");
+      }
+      if (started || finished)
+      {
+        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Cannot append a stage after consuming has started.");
+      }
+      if (fan_out)
+      {
+        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Cannot append a stage after a fan-out stage.");
+      }
+    }
+
+    /// passes @p item to all branches of stage @p s (copies for all but the last branch)
+    bool push(Size s, ItemPtr_ item)
+    {
+      Stage& stage = stages[s];
+      for (Size b = 0; b + 1 < stage.size(); ++b)
+      {
+        if (!stage[b].queue->push(ItemPtr_(new Item_(*item)))) return false;
+      }
+      return stage.back().queue->push(std::move(item));
+    }
+
+    /// remembers the first error and stops the pipeline
+    void fail(std::exception_ptr e)
+    {
+      {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) error = e;
+      }
+      for (Stage& stage : stages)
+      {
+        for (Branch& branch : stage) branch.queue->abort();
+      }
+    }
+
+    /// rethrows the first error, unless it was reported before
+    void rethrowError()
+    {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if (error && !error_reported)
+      {
+        error_reported = true;
+        std::rethrow_exception(error);
+      }
+    }
+
+    void work(Size s, Size b)
+    {
+      Branch& branch = stages[s][b];
+      try
+      {
+        while (ItemPtr_ item = branch.queue->pop())
+        {
+          if (item->is_spectrum)
+          {
+            branch.consumer->consumeSpectrum(item->spectrum);
+          }
+          else
+          {
+            branch.consumer->consumeChromatogram(item->chromatogram);
+          }
+          if (s + 1 < stages.size() && !push(s + 1, std::move(item))) return;
+        }
+      }
+      catch (...)
+      {
+        fail(std::current_exception());
+      }
+    }
+
+    void start()
+    {
+      started = true;
+      try
+      {
+        for (Size s = 0; s < stages.size(); ++s)
+        {
+          for (Size b = 0; b < stages[s].size(); ++b)
+          {
+            for (Size w = 0; w < stages[s][b].workers; ++w)
+            {
+              threads.emplace_back(&Impl_::work, this, s, b);
+            }
+          }
+        }
+      }
+      catch (...)
+      {
+        fail(std::current_exception());
+        join();
+        rethrowError();
+      }
+    }
+
+    void join()
+    {
+      for (std::thread& t : threads)
+      {
+        if (t.joinable()) t.join();
+      }
+      threads.clear();
+    }
+
+    void consume(ItemPtr_ item)
+    {
+      rethrowError();
+      if (finished)
+      {
+        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Cannot consume data after finish() was called.");
+      }
+      if (stages.empty()) return;
+      if (!started) start();
+      item->index = count++;
+      if (!push(0, std::move(item))) rethrowError();
+    }
+  };
+
+  MSDataPipelineConsumer::MSDataPipelineConsumer(Size queue_size) :
+    impl_(new Impl_(queue_size))
+  {
+  }
+
+  MSDataPipelineConsumer::~MSDataPipelineConsumer()
+  {
+    try
+    {
+      finish();
+    }
+    catch (std::exception& e)
+    {
+      OPENMS_LOG_ERROR << "MSDataPipelineConsumer: error in a consumer: " << e.what() << std::endl;
+    }
+    catch (...)
+    {
+      OPENMS_LOG_ERROR << "MSDataPipelineConsumer: unknown error in a consumer." << std::endl;
+    }
+  }
+
+  void MSDataPipelineConsumer::appendStage(Interfaces::IMSDataConsumer * consumer, Size workers)
+  {
+    impl_->checkAppend(consumer);
+    Impl_::Stage stage(1);
+    stage[0].consumer = consumer;
+    stage[0].workers = std::max(workers, Size(1));
+    stage[0].queue.reset(new OrderedQueue_(impl_->queue_size));
+    impl_->stages.push_back(std::move(stage));
+  }
+
+  void MSDataPipelineConsumer::appendFanOut(const std::vector<Interfaces::IMSDataConsumer *> & consumers)
+  {
+    if (consumers.empty())
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "A fan-out stage needs at least one consumer.");
+    }
+    Impl_::Stage stage(consumers.size());
+    for (Size b = 0; b < consumers.size(); ++b)
+    {
+      impl_->checkAppend(consumers[b]);
+      stage[b].consumer = consumers[b];
+      stage[b].workers = 1;
+      stage[b].queue.reset(new OrderedQueue_(impl_->queue_size));
+    }
+    impl_->stages.push_back(std::move(stage));
+    impl_->fan_out = true;
+  }
+
+  void MSDataPipelineConsumer::setExperimentalSettings(const ExperimentalSettings & settings)
+  {
+    for (Impl_::Stage& stage : impl_->stages)
+    {
+      for (Impl_::Branch& branch : stage) branch.consumer->setExperimentalSettings(settings);
+    }
+  }
+
+  void MSDataPipelineConsumer::setExpectedSize(Size s_size, Size c_size)
+  {
+    for (Impl_::Stage& stage : impl_->stages)
+    {
+      for (Impl_::Branch& branch : stage) branch.consumer->setExpectedSize(s_size, c_size);
+    }
+  }
+
+  void MSDataPipelineConsumer::consumeSpectrum(SpectrumType & s)
+  {
+    ItemPtr_ item(new Item_);
+    item->spectrum = s;
+    impl_->consume(std::move(item));
+  }
+
+  void MSDataPipelineConsumer::consumeChromatogram(ChromatogramType & c)
+  {
+    ItemPtr_ item(new Item_);
+    item->is_spectrum = false;
+    item->chromatogram = c;
+    impl_->consume(std::move(item));
+  }
+
+  void MSDataPipelineConsumer::finish()
+  {
+    if (!impl_->finished)
+    {
+      impl_->finished = true;
+      for (Impl_::Stage& stage : impl_->stages)
+      {
+        for (Impl_::Branch& branch : stage) branch.queue->close(impl_->count);
+      }
+      impl_->join();
+    }
+    impl_->rethrowError();
+  }
+
+} //end namespace OpenMS
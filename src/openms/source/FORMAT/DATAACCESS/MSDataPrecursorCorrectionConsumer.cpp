@@ -0,0 +1,138 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataPrecursorCorrectionConsumer.h>
+
+#include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/FILTERING/CALIBRATION/PrecursorCorrection.h>
+
+namespace OpenMS
+{
+
+  MSDataPrecursorCorrectionConsumer::MSDataPrecursorCorrectionConsumer(Interfaces::IMSDataConsumer* next_consumer, CorrectionMethod method,
+                                                                       double mz_tolerance, bool ppm, Size max_survey_scans) :
+    next_consumer_(next_consumer),
+    method_(method),
+    mz_tolerance_(mz_tolerance),
+    ppm_(ppm),
+    max_survey_scans_(std::max(max_survey_scans, Size(1)))
+  {
+  }
+
+  void MSDataPrecursorCorrectionConsumer::setExpectedSize(Size expectedSpectra, Size expectedChromatograms)
+  {
+    next_consumer_->setExpectedSize(expectedSpectra, expectedChromatograms);
+  }
+
+  void MSDataPrecursorCorrectionConsumer::setExperimentalSettings(const OpenMS::ExperimentalSettings& exp)
+  {
+    next_consumer_->setExperimentalSettings(exp);
+  }
+
+  void MSDataPrecursorCorrectionConsumer::consumeSpectrum(SpectrumType& s)
+  {
+    if (s.getMSLevel() == 1)
+    {
+      if (survey_scans_.size() == max_survey_scans_) survey_scans_.pop_front();
+      survey_scans_.push_back(s);
+    }
+    else if (s.getMSLevel() == 2 && !s.getPrecursors().empty())
+    {
+      const SpectrumType* survey_scan = findSurveyScan_(s);
+      if (survey_scan == nullptr)
+      {
+        OPENMS_LOG_WARN << "Warning: no MS1 spectrum for this precursor" << std::endl;
+      }
+      else
+      {
+        Precursor& pc = s.getPrecursors()[0];
+        const double mz = pc.getMZ();
+        const int peak_idx = (method_ == NEAREST_PEAK) ?
+          PrecursorCorrection::findNearestMS1Peak(*survey_scan, mz, mz_tolerance_, ppm_) :
+          PrecursorCorrection::findHighestIntensityMS1Peak(*survey_scan, mz, mz_tolerance_, ppm_);
+        if (peak_idx != -1)
+        {
+          const Peak1D& peak = (*survey_scan)[peak_idx];
+          delta_mzs_.push_back(peak.getMZ() - mz);
+          mzs_.push_back(mz);
+          rts_.push_back(s.getRT());
+          pc.setMZ(peak.getMZ());
+          if (method_ == HIGHEST_INTENSITY_PEAK) pc.setIntensity(peak.getIntensity());
+        }
+      }
+    }
+    next_consumer_->consumeSpectrum(s);
+  }
+
+  void MSDataPrecursorCorrectionConsumer::consumeChromatogram(ChromatogramType& c)
+  {
+    next_consumer_->consumeChromatogram(c);
+  }
+
+  Size MSDataPrecursorCorrectionConsumer::getNumberOfCorrectedPrecursors() const
+  {
+    return delta_mzs_.size();
+  }
+
+  const std::vector<double>& MSDataPrecursorCorrectionConsumer::getDeltaMZs() const
+  {
+    return delta_mzs_;
+  }
+
+  const std::vector<double>& MSDataPrecursorCorrectionConsumer::getMZs() const
+  {
+    return mzs_;
+  }
+
+  const std::vector<double>& MSDataPrecursorCorrectionConsumer::getRTs() const
+  {
+    return rts_;
+  }
+
+  const MSDataPrecursorCorrectionConsumer::SpectrumType* MSDataPrecursorCorrectionConsumer::findSurveyScan_(const SpectrumType& s) const
+  {
+    if (survey_scans_.empty()) return nullptr;
+    const Precursor& pc = s.getPrecursors()[0];
+    if (pc.metaValueExists("spectrum_ref"))
+    {
+      const String ref = pc.getMetaValue("spectrum_ref");
+      for (std::deque<SpectrumType>::const_reverse_iterator it = survey_scans_.rbegin(); it != survey_scans_.rend(); ++it)
+      {
+        if (it->getNativeID() == ref) return &(*it);
+      }
+    }
+    return &survey_scans_.back();
+  }
+
+} // namespace OpenMS
@@ -35,10 +35,122 @@
 #include <OpenMS/FORMAT/DATAACCESS/MSDataSqlConsumer.h>
 
 #include <OpenMS/FORMAT/HANDLERS/MzMLSqliteHandler.h>
+#include <OpenMS/CONCEPT/LogStream.h>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
 
 namespace OpenMS
 {
 
+  struct MSDataSqlConsumer::Writer_
+  {
+    struct Batch
+    {
+      std::vector<SpectrumType> spectra;
+      std::vector<ChromatogramType> chromatograms;
+    };
+
+    /// maximal number of batches waiting to be written
+    static const Size MAX_PENDING = 2;
+
+    Internal::MzMLSqliteHandler * handler;
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<Batch> pending;
+    bool busy = false; ///< is a batch being written?
+    bool stop = false;
+    bool failed = false; ///< after an error, no further batches are written
+    std::exception_ptr error; ///< error not reported yet
+    std::thread thread;
+
+    explicit Writer_(Internal::MzMLSqliteHandler * h) :
+      handler(h)
+    {
+      thread = std::thread(&Writer_::run, this);
+    }
+
+    ~Writer_()
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+      }
+      changed.notify_all();
+      thread.join();
+    }
+
+    void run()
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (true)
+      {
+        changed.wait(lock, [this] { return stop || !pending.empty(); });
+        if (pending.empty()) break; // stopped and all data written
+        Batch batch = std::move(pending.front());
+        pending.pop_front();
+        busy = true;
+        const bool skip = failed;
+        lock.unlock();
+        changed.notify_all();
+
+        std::exception_ptr batch_error;
+        if (!skip)
+        {
+          try
+          {
+            handler->writeSpectra(batch.spectra);
+            handler->writeChromatograms(batch.chromatograms);
+          }
+          catch (...)
+          {
+            batch_error = std::current_exception();
+          }
+        }
+
+        lock.lock();
+        if (batch_error)
+        {
+          failed = true;
+          error = batch_error;
+        }
+        busy = false;
+        changed.notify_all();
+      }
+    }
+
+    void push(Batch && batch)
+    {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this] { return pending.size() < MAX_PENDING; });
+        pending.push_back(std::move(batch));
+      }
+      changed.notify_all();
+    }
+
+    /// waits until all batches are written
+    void wait()
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      changed.wait(lock, [this] { return pending.empty() && !busy; });
+    }
+
+    /// rethrows an error of the writer thread (once)
+    void rethrowError()
+    {
+      std::exception_ptr e;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::swap(e, error);
+      }
+      if (e) std::rethrow_exception(e);
+    }
+  };
+
   MSDataSqlConsumer::MSDataSqlConsumer(String filename, int flush_after, bool full_meta, bool lossy_compression, double linear_mass_acc) :
         filename_(filename),
         handler_(new OpenMS::Internal::MzMLSqliteHandler(filename) ),
@@ -50,11 +162,24 @@ namespace OpenMS
 
     handler_->setConfig(full_meta, lossy_compression, linear_mass_acc, flush_after_);
     handler_->createTables();
+    writer_.reset(new Writer_(handler_));
   }
 
   MSDataSqlConsumer::~MSDataSqlConsumer()
   {
-    flush();
+    try
+    {
+      flush();
+    }
+    catch (std::exception& e)
+    {
+      OPENMS_LOG_ERROR << "Error while writing to " << filename_ << ": " << e.what() << std::endl;
+    }
+    catch (...)
+    {
+      OPENMS_LOG_ERROR << "Unknown error while writing to " << filename_ << "." << std::endl;
+    }
+    writer_.reset();
 
     // Write run level information into the file (e.g. run id, run name and mzML structure)
     bool write_full_meta = full_meta_;
@@ -67,19 +192,23 @@ namespace OpenMS
 
   void MSDataSqlConsumer::flush()
   {
-    if (!spectra_.empty() ) 
-    {
-      handler_->writeSpectra(spectra_);
-      spectra_.clear();
-      spectra_.reserve(flush_after_);
-    }
+    flushAsync_();
+    writer_->wait();
+    writer_->rethrowError();
+  }
 
-    if (!chromatograms_.empty() ) 
-    {
-      handler_->writeChromatograms(chromatograms_);
-      chromatograms_.clear();
-      chromatograms_.reserve(flush_after_);
-    }
+  void MSDataSqlConsumer::flushAsync_()
+  {
+    writer_->rethrowError();
+    if (spectra_.empty() && chromatograms_.empty()) return;
+
+    Writer_::Batch batch;
+    batch.spectra.swap(spectra_);
+    batch.chromatograms.swap(chromatograms_);
+    writer_->push(std::move(batch));
+
+    spectra_.reserve(flush_after_);
+    chromatograms_.reserve(flush_after_);
   }
 
   void MSDataSqlConsumer::consumeSpectrum(SpectrumType & s)
@@ -88,7 +217,7 @@ namespace OpenMS
     s.clear(false);
     if (full_meta_) peak_meta_.addSpectrum(s);
 
-    if (spectra_.size() >= flush_after_) {flush();}
+    if (spectra_.size() >= flush_after_) {flushAsync_();}
   }
 
   void MSDataSqlConsumer::consumeChromatogram(ChromatogramType & c)
@@ -97,7 +226,7 @@ namespace OpenMS
     c.clear(false);
     if (full_meta_) peak_meta_.addChromatogram(c);
 
-    if (chromatograms_.size() >= flush_after_) {flush();}
+    if (chromatograms_.size() >= flush_after_) {flushAsync_();}
   }
 
   void MSDataSqlConsumer::setExpectedSize(Size /* expectedSpectra */, Size /* expectedChromatograms */) {;}
@@ -111,11 +111,14 @@ namespace OpenMS
       ofs_ << "\t\t<spectrumList count=\"" << spectra_expected_ << "\" defaultDataProcessingRef=\"dp_sp_0\">\n";
       writing_spectra_ = true;
     }
-    bool renew_native_ids = false;
     // TODO writeSpectrum assumes that dps_ has at least one value -> assert
     // this here ...
-    Internal::MzMLHandler::writeSpectrum_(ofs_, scpy,
-            spectra_written_++, *validator_, renew_native_ids, dps_);
+    pending_spectra_.push_back(std::move(scpy));
+    ++spectra_written_;
+    if (pending_spectra_.size() >= writeBatchSize_())
+    {
+      flushSpectra_();
+    }
   }
 
    void MSDataWritingConsumer::consumeChromatogram(ChromatogramType & c)
@@ -123,6 +126,7 @@ namespace OpenMS
     // make sure to close an open List tag
     if (writing_spectra_)
     {
+      flushSpectra_();
       ofs_ << "\t\t</spectrumList>\n";
       writing_spectra_ = false;
     }
@@ -156,8 +160,40 @@ namespace OpenMS
       ofs_ << "\t\t<chromatogramList count=\"" << chromatograms_expected_ << "\" defaultDataProcessingRef=\"dp_sp_0\">\n";
       writing_chromatograms_ = true;
     }
-    Internal::MzMLHandler::writeChromatogram_(ofs_, ccpy,
-            chromatograms_written_++, *validator_);
+    pending_chromatograms_.push_back(std::move(ccpy));
+    ++chromatograms_written_;
+    if (pending_chromatograms_.size() >= writeBatchSize_())
+    {
+      flushChromatograms_();
+    }
+  }
+
+  void MSDataWritingConsumer::flushSpectra_()
+  {
+    if (pending_spectra_.empty()) return;
+
+    std::vector<const SpectrumType*> batch;
+    for (const SpectrumType& spec : pending_spectra_)
+    {
+      batch.push_back(&spec);
+    }
+    bool renew_native_ids = false;
+    Internal::MzMLHandler::writeSpectra_(ofs_, batch, spectra_written_ - pending_spectra_.size(),
+                                         *validator_, renew_native_ids, dps_);
+    pending_spectra_.clear();
+  }
+
+  void MSDataWritingConsumer::flushChromatograms_()
+  {
+    if (pending_chromatograms_.empty()) return;
+
+    std::vector<const ChromatogramType*> batch;
+    for (const ChromatogramType& chrom : pending_chromatograms_)
+    {
+      batch.push_back(&chrom);
+    }
+    Internal::MzMLHandler::writeChromatograms_(ofs_, batch, chromatograms_written_ - pending_chromatograms_.size(), *validator_);
+    pending_chromatograms_.clear();
   }
 
    void MSDataWritingConsumer::addDataProcessing(DataProcessing d)
@@ -178,10 +214,12 @@ namespace OpenMS
     // make sure to close an open List tag
     if (writing_spectra_)
     {
+      flushSpectra_();
       ofs_ << "\t\t</spectrumList>\n";
     }
     else if (writing_chromatograms_)
     {
+      flushChromatograms_();
       ofs_ << "\t\t</chromatogramList>\n";
     }
 
@@ -34,7 +34,101 @@
 
 #include <OpenMS/FORMAT/DATAACCESS/SwathFileConsumer.h>
 
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessOpenMSCached.h>
+#include <OpenMS/FORMAT/MzMLFile.h>
+
+#include <exception>
+
 namespace OpenMS
 {
 
+  void CachedSwathFileConsumer::closeConsumers_(std::vector<std::streampos>* ms1_index,
+                                                std::vector<std::vector<std::streampos> >* swath_index)
+  {
+    if (swath_index != nullptr)
+    {
+      swath_index->clear();
+      for (const MSDataCachedConsumer* consumer : swath_consumers_)
+      {
+        swath_index->push_back(consumer->getSpectraIndex());
+      }
+    }
+    while (!swath_consumers_.empty())
+    {
+      delete swath_consumers_.back();
+      swath_consumers_.pop_back();
+    }
+    if (ms1_consumer_ != nullptr)
+    {
+      if (ms1_index != nullptr) *ms1_index = ms1_consumer_->getSpectraIndex();
+      delete ms1_consumer_;
+      ms1_consumer_ = nullptr;
+    }
+  }
+
+  void CachedSwathFileConsumer::ensureMapsAreFilled_()
+  {
+    SignedSize swath_consumers_size = boost::numeric_cast<SignedSize>(swath_consumers_.size());
+    bool have_ms1 = (ms1_consumer_ != nullptr);
+
+    // Properly delete the MSDataCachedConsumer -> free memory and _close_ file stream
+    // The file streams to the cached data on disc can and should be closed
+    // here safely. Since ensureMapsAreFilled_ is called after consuming all
+    // the spectra, there will be no more spectra to append but the client
+    // might already want to read after this call, so all data needs to be
+    // present on disc and the file streams closed.
+    std::vector<std::streampos> ms1_index;
+    std::vector<std::vector<std::streampos> > swath_index;
+    closeConsumers_(&ms1_index, &swath_index);
+
+    const std::vector<std::streampos> no_chromatograms;
+    ms1_access_.reset();
+    swath_access_.assign(swath_consumers_size, OpenSwath::SpectrumAccessPtr());
+
+    // the MS1 map (i == -1) and all SWATH maps are independent of each other
+    std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 1)
+    for (SignedSize i = (have_ms1 ? -1 : 0); i < swath_consumers_size; ++i)
+    {
+      try
+      {
+        boost::shared_ptr<PeakMap>& map = (i < 0 ? ms1_map_ : swath_maps_[i]);
+        String meta_file = cachedir_ + basename_ + (i < 0 ? String("_ms1") : String("_") + String(i)) + ".mzML";
+
+        // write metadata to disk and store the correct data processing tag
+        Internal::CachedMzMLHandler().writeMetadata(*map, meta_file, true);
+
+        if (reload_meta_data_)
+        {
+          boost::shared_ptr<PeakMap > exp(new PeakMap);
+          MzMLFile().load(meta_file, *exp.get());
+          map = exp;
+        }
+        else
+        {
+          // hand the meta data over to the spectrum access, only an empty map is kept
+          OpenSwath::SpectrumAccessPtr access(new SpectrumAccessOpenMSCached(meta_file, std::move(*map),
+            (i < 0 ? ms1_index : swath_index[i]), no_chromatograms));
+          map = boost::shared_ptr<PeakMap>(new PeakMap);
+          (i < 0 ? ms1_access_ : swath_access_[i]) = access;
+        }
+      }
+      catch (...)
+      {
+#pragma omp critical (OPENMS_CachedSwathFileConsumer_error)
+        if (!error) error = std::current_exception();
+      }
+    }
+    if (error) std::rethrow_exception(error);
+  }
+
+  OpenSwath::SpectrumAccessPtr CachedSwathFileConsumer::getSpectrumAccess_(boost::shared_ptr<PeakMap> map, int swath_nr)
+  {
+    if (reload_meta_data_)
+    {
+      return FullSwathFileConsumer::getSpectrumAccess_(map, swath_nr);
+    }
+    return swath_nr < 0 ? ms1_access_ : swath_access_[swath_nr];
+  }
+
 } // namespace OpenMS
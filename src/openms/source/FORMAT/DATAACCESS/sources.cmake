@@ -6,9 +6,14 @@ set(sources_list
   CsiFingerIdMzTabWriter.cpp
   MSDataWritingConsumer.cpp
   MSDataTransformingConsumer.cpp
+  IdXMLWritingConsumer.cpp
   MSDataAggregatingConsumer.cpp
+  MSDataBlockMergingConsumer.cpp
   MSDataCachedConsumer.cpp
   MSDataChainingConsumer.cpp
+  MSDataPeakPickingConsumer.cpp
+  MSDataPipelineConsumer.cpp
+  MSDataPrecursorCorrectionConsumer.cpp
   MSDataStoringConsumer.cpp
   MSDataSqlConsumer.cpp
   MSDataTransformingConsumer.cpp
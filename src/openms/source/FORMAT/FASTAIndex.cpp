@@ -0,0 +1,346 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/FORMAT/FASTAIndex.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/DATASTRUCTURES/NumericCodec.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <QtCore/QFileInfo>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+using namespace std;
+
+namespace OpenMS
+{
+  namespace
+  {
+    /// end of the line starting at @p p (position of the '\n' or @p end)
+    const char* lineEnd(const char* p, const char* end)
+    {
+      const char* le = static_cast<const char*>(memchr(p, '\n', end - p));
+      return le == nullptr ? end : le;
+    }
+
+    /// start of the line following the line which ends at @p le
+    const char* nextLine(const char* le, const char* end)
+    {
+      return le == end ? end : le + 1;
+    }
+
+    bool isSpace(char c)
+    {
+      return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    /// split a header line (without the '>') into identifier and description, like FASTAFile::readNext()
+    void splitHeader(const char* begin, const char* end, String& identifier, String& description)
+    {
+      String id(begin, end);
+      id.trim();
+      String::size_type position = id.find_first_of(" \v\t");
+      if (position == String::npos)
+      {
+        identifier = std::move(id);
+        description = "";
+      }
+      else
+      {
+        identifier = id.substr(0, position);
+        description = id.suffix(id.size() - position - 1);
+      }
+    }
+  }
+
+  FASTAIndex::FASTAIndex() :
+    filename_(),
+    mapped_file_(),
+    data_(nullptr),
+    data_size_(0),
+    entries_(),
+    name_to_index_()
+  {
+  }
+
+  FASTAIndex::FASTAIndex(const String& fasta_file, bool use_index_file) :
+    FASTAIndex()
+  {
+    open(fasta_file, use_index_file);
+  }
+
+  FASTAIndex::~FASTAIndex() = default;
+
+  void FASTAIndex::open(const String& fasta_file, bool use_index_file)
+  {
+    if (!File::exists(fasta_file))
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, fasta_file);
+    }
+    filename_ = fasta_file;
+    mapped_file_.reset();
+    data_ = nullptr;
+    data_size_ = 0;
+    entries_.clear();
+    name_to_index_.clear();
+
+    if (!File::empty(fasta_file)) // empty files cannot be mapped
+    {
+      try
+      {
+        boost::interprocess::file_mapping mapping(fasta_file.c_str(), boost::interprocess::read_only);
+        mapped_file_.reset(new boost::interprocess::mapped_region(mapping, boost::interprocess::read_only));
+      }
+      catch (boost::interprocess::interprocess_exception& e)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, fasta_file, String("Could not memory-map file: ") + e.what());
+      }
+      data_ = static_cast<const char*>(mapped_file_->get_address());
+      data_size_ = mapped_file_->get_size();
+    }
+
+    const String fai_file = indexFilename(fasta_file);
+    if (use_index_file && File::exists(fai_file) &&
+        QFileInfo(fai_file.toQString()).lastModified() >= QFileInfo(fasta_file.toQString()).lastModified())
+    {
+      if (load_(fai_file)) return;
+      OPENMS_LOG_WARN << "Index file '" << fai_file << "' does not match '" << fasta_file << "' and is ignored." << endl;
+    }
+    build_();
+  }
+
+  void FASTAIndex::build_()
+  {
+    entries_.clear();
+    name_to_index_.clear();
+    const char* p = data_;
+    const char* end = data_ + data_size_;
+
+    // skip the header of PEFF files (http://www.psidev.info/peff)
+    while (p < end && *p == '#')
+    {
+      p = nextLine(lineEnd(p, end), end);
+    }
+
+    String description;
+    while (p < end)
+    {
+      if (*p != '>')
+      {
+        if (!isSpace(*p))
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_,
+                                      "Error while parsing FASTA file! Expected '>' at byte offset " + String(p - data_) + ".");
+        }
+        ++p;
+        continue;
+      }
+
+      Entry entry;
+      const char* header_end = lineEnd(p, end);
+      splitHeader(p + 1, header_end, entry.name, description);
+      p = nextLine(header_end, end);
+      entry.offset = p - data_;
+      entry.length = 0;
+      entry.line_bases = 0;
+      entry.line_width = 0;
+      while (p < end && *p != '>')
+      {
+        const char* le = lineEnd(p, end);
+        UInt64 bases = 0;
+        for (const char* c = p; c < le; ++c)
+        {
+          if (!isSpace(*c)) ++bases;
+        }
+        const char* next = nextLine(le, end);
+        if (entry.line_width == 0 && bases > 0)
+        {
+          entry.line_bases = bases;
+          entry.line_width = next - p;
+        }
+        entry.length += bases;
+        p = next;
+      }
+      name_to_index_.emplace(entry.name, entries_.size());
+      entries_.push_back(std::move(entry));
+    }
+  }
+
+  bool FASTAIndex::load_(const String& fai_file)
+  {
+    ifstream is(fai_file.c_str(), ios::binary);
+    if (!is) return false;
+
+    vector<Entry> entries;
+    UInt64 min_offset = 0;
+    String identifier, description;
+    string line;
+    while (getline(is, line))
+    {
+      if (!line.empty() && line.back() == '\r') line.pop_back();
+      if (line.empty()) continue;
+
+      // NAME, LENGTH, OFFSET, LINEBASES, LINEWIDTH
+      vector<String> fields;
+      String(line).split('\t', fields);
+      Entry entry;
+      if (fields.size() != 5 ||
+          !NumericCodec::parse(fields[1].c_str(), fields[1].c_str() + fields[1].size(), entry.length) ||
+          !NumericCodec::parse(fields[2].c_str(), fields[2].c_str() + fields[2].size(), entry.offset) ||
+          !NumericCodec::parse(fields[3].c_str(), fields[3].c_str() + fields[3].size(), entry.line_bases) ||
+          !NumericCodec::parse(fields[4].c_str(), fields[4].c_str() + fields[4].size(), entry.line_width))
+      {
+        return false;
+      }
+      entry.name = fields[0];
+
+      // the record must point right behind a header line with the same name, in file order
+      if (entry.offset < min_offset || entry.offset > data_size_ || entry.length > data_size_ - entry.offset) return false;
+      const char* header_end = data_ + entry.offset;
+      if (header_end > data_ && header_end[-1] == '\n') --header_end;
+      const char* header = header_end;
+      while (header > data_ && header[-1] != '\n') --header;
+      if (header == header_end || *header != '>') return false;
+      splitHeader(header + 1, header_end, identifier, description);
+      if (identifier != entry.name) return false;
+
+      min_offset = entry.offset + entry.length;
+      entries.push_back(std::move(entry));
+    }
+
+    entries_.swap(entries);
+    for (Size i = 0; i < entries_.size(); ++i)
+    {
+      name_to_index_.emplace(entries_[i].name, i);
+    }
+    return true;
+  }
+
+  void FASTAIndex::store(const String& fai_file) const
+  {
+    ofstream os(fai_file.c_str(), ios::binary);
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, fai_file);
+    }
+    for (const Entry& entry : entries_)
+    {
+      os << entry.name << '\t' << entry.length << '\t' << entry.offset << '\t' << entry.line_bases << '\t' << entry.line_width << '\n';
+    }
+    os.close();
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, fai_file);
+    }
+  }
+
+  String FASTAIndex::indexFilename(const String& fasta_file)
+  {
+    return fasta_file + ".fai";
+  }
+
+  const String& FASTAIndex::getFileName() const
+  {
+    return filename_;
+  }
+
+  Size FASTAIndex::size() const
+  {
+    return entries_.size();
+  }
+
+  bool FASTAIndex::empty() const
+  {
+    return entries_.empty();
+  }
+
+  const FASTAIndex::Entry& FASTAIndex::getEntry(Size index) const
+  {
+    return entries_[index];
+  }
+
+  Size FASTAIndex::find(const String& name) const
+  {
+    auto it = name_to_index_.find(name);
+    return it == name_to_index_.end() ? numeric_limits<Size>::max() : it->second;
+  }
+
+  bool FASTAIndex::readEntry(Size index, FASTAFile::FASTAEntry& protein) const
+  {
+    if (index >= entries_.size()) return false;
+
+    // the header line ends right before the sequence
+    const char* header_end = data_ + entries_[index].offset;
+    if (header_end > data_ && header_end[-1] == '\n') --header_end;
+    const char* header = header_end;
+    while (header > data_ && header[-1] != '\n') --header;
+    splitHeader(header + 1, header_end, protein.identifier, protein.description);
+
+    readSequence_(index, protein.sequence);
+    return true;
+  }
+
+  bool FASTAIndex::getSequence(const String& name, String& sequence) const
+  {
+    Size index = find(name);
+    if (index == numeric_limits<Size>::max()) return false;
+    readSequence_(index, sequence);
+    return true;
+  }
+
+  void FASTAIndex::readSequence_(Size index, String& sequence) const
+  {
+    const Entry& entry = entries_[index];
+    sequence.clear();
+    sequence.reserve(entry.length);
+    const char* p = data_ + entry.offset;
+    const char* end = data_ + data_size_;
+    while (p < end && *p != '>')
+    {
+      const char* le = lineEnd(p, end);
+      sequence.append(p, le);
+      p = nextLine(le, end);
+    }
+    if (sequence.size() != entry.length) sequence.removeWhitespaces(); // e.g. '\r' of Windows line breaks
+  }
+
+} // namespace OpenMS
@@ -33,19 +33,64 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/FORMAT/FeatureXMLFile.h>
+#include <OpenMS/FORMAT/BufferedOfstream.h>
 
 #include <OpenMS/KERNEL/FeatureMap.h>
 #include <OpenMS/FORMAT/IdXMLFile.h>
 #include <OpenMS/METADATA/DataProcessing.h>
 #include <OpenMS/CHEMISTRY/ProteaseDB.h>
 #include <OpenMS/FORMAT/FileHandler.h>
+#include <OpenMS/SYSTEM/File.h>
 
+#include <cmath>
+#include <cstring>
 #include <fstream>
 
 using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// first line of a range index file (contains the format version)
+    const char* const RANGE_INDEX_HEADER_ = "featureXML range index 1";
+
+    /// number of (top-level) features per block of the range index
+    const Size RANGE_INDEX_BLOCK_SIZE_ = 256;
+
+    /// byte range and bounds of a block of consecutive features in a featureXML file
+    struct RangeIndexBlock_
+    {
+      UInt64 begin = 0;
+      UInt64 end = 0;
+      double bounds[3][2] = {{0, 0}, {0, 0}, {0, 0}}; // RT, m/z, intensity (min, max)
+
+      void add(const Feature& feature, bool first)
+      {
+        const double values[3] = {feature.getRT(), feature.getMZ(), feature.getIntensity()};
+        for (Size d = 0; d < 3; ++d)
+        {
+          if (first || values[d] < bounds[d][0]) bounds[d][0] = values[d];
+          if (first || values[d] > bounds[d][1]) bounds[d][1] = values[d];
+        }
+      }
+
+      /// may the block contain values inside @p range in dimension @p d? (the bounds are widened slightly to be robust against rounding when reading them back)
+      bool overlaps(Size d, const DRange<1>& range) const
+      {
+        const double slack = 1e-6 * std::max(std::fabs(bounds[d][0]), std::fabs(bounds[d][1]));
+        return bounds[d][1] + slack >= range.minPosition()[0] && bounds[d][0] - slack <= range.maxPosition()[0];
+      }
+    };
+
+    /// does @p text contain @p tag at @p pos (after whitespace)?
+    bool startsWithTag_(const std::string& text, Size pos, const char* tag)
+    {
+      pos = text.find_first_not_of(" \t\r\n", pos);
+      return pos != std::string::npos && text.compare(pos, strlen(tag), tag) == 0;
+    }
+  }
+
   FeatureXMLFile::FeatureXMLFile() :
     Internal::XMLHandler("", "1.9"),
     Internal::XMLFile("/SCHEMAS/FeatureXML_1_9.xsd", "1.9")
@@ -112,7 +157,17 @@ namespace OpenMS
     map_->setLoadedFileType(file_);
     map_->setLoadedFilePath(file_);
 
-    parse_(filename, this);
+    std::string buffer;
+    if (options_.getUseRangeIndex()
+       && (options_.hasRTRange() || options_.hasMZRange() || options_.hasIntensityRange())
+       && readRangeIndexed_(filename, buffer))
+    {
+      parseBuffer_(buffer, this);
+    }
+    else
+    {
+      parse_(filename, this);
+    }
 
     // !!! Hack: set feature FWHM from meta info entries as
     // long as featureXML doesn't support a width entry.
@@ -141,7 +196,7 @@ namespace OpenMS
     }
 
     //open stream
-    ofstream os(filename.c_str());
+    BufferedOfstream os(filename);
     if (!os)
     {
       throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
@@ -306,23 +361,165 @@ namespace OpenMS
 
     // write features with their corresponding attributes
     os << "\t<featureList count=\"" << feature_map.size() << "\">\n";
+    const bool write_index = options_.getWriteRangeIndex();
+    const UInt64 features_begin = write_index ? UInt64(os.tellp()) : 0;
+    vector<RangeIndexBlock_> index_blocks;
     startProgress(0, feature_map.size(), "Storing featureXML file");
     for (Size s = 0; s < feature_map.size(); s++)
     {
+      const bool block_begin = write_index && s % RANGE_INDEX_BLOCK_SIZE_ == 0;
+      if (block_begin)
+      {
+        const UInt64 pos = os.tellp();
+        if (!index_blocks.empty()) index_blocks.back().end = pos;
+        index_blocks.emplace_back();
+        index_blocks.back().begin = pos;
+      }
       writeFeature_(filename, os, feature_map[s], "f_", feature_map[s].getUniqueId(), 0);
+      if (write_index) index_blocks.back().add(feature_map[s], block_begin);
       setProgress(s);
       // writeFeature_(filename, os, feature_map[s], "f_", s, 0);
     }
     endProgress();
+    const UInt64 features_end = write_index ? UInt64(os.tellp()) : 0;
+    if (!index_blocks.empty()) index_blocks.back().end = features_end;
 
     os << "\t</featureList>\n";
     os << "</featureMap>\n";
 
+    // write the range index (or remove an old one, which no longer matches the file)
+    const String index_filename = getRangeIndexFilename(filename);
+    if (write_index)
+    {
+      const UInt64 file_size = os.tellp();
+      os.close();
+      ofstream index(index_filename.c_str());
+      if (!index)
+      {
+        throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, index_filename);
+      }
+      index.precision(writtenDigits<double>(0.0));
+      index << RANGE_INDEX_HEADER_ << "\n"
+            << file_size << ' ' << features_begin << ' ' << features_end << ' ' << index_blocks.size() << "\n";
+      for (const RangeIndexBlock_& block : index_blocks)
+      {
+        index << block.begin << ' ' << block.end;
+        for (Size d = 0; d < 3; ++d)
+        {
+          index << ' ' << block.bounds[d][0] << ' ' << block.bounds[d][1];
+        }
+        index << "\n";
+      }
+      if (!index)
+      {
+        throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, index_filename);
+      }
+    }
+    else if (File::exists(index_filename))
+    {
+      File::remove(index_filename);
+    }
+
     //Clear members
     accession_to_id_.clear();
     identifier_id_.clear();
   }
 
+  String FeatureXMLFile::getRangeIndexFilename(const String& filename)
+  {
+    return filename + ".ridx";
+  }
+
+  bool FeatureXMLFile::readRangeIndexed_(const String& filename, std::string& buffer) const
+  {
+    const String index_filename = getRangeIndexFilename(filename);
+    ifstream index(index_filename.c_str());
+    if (!index)
+    {
+      return false;
+    }
+
+    // read the index
+    std::string header;
+    std::getline(index, header);
+    UInt64 file_size(0), features_begin(0), features_end(0);
+    Size block_count(0);
+    index >> file_size >> features_begin >> features_end >> block_count;
+    vector<RangeIndexBlock_> blocks(index ? block_count : 0);
+    for (RangeIndexBlock_& block : blocks)
+    {
+      index >> block.begin >> block.end;
+      for (Size d = 0; d < 3; ++d)
+      {
+        index >> block.bounds[d][0] >> block.bounds[d][1];
+      }
+    }
+    if (header != RANGE_INDEX_HEADER_ || !index)
+    {
+      OPENMS_LOG_WARN << "Warning: ignoring invalid range index '" << index_filename << "'." << std::endl;
+      return false;
+    }
+
+    // the index must belong to this version of the file
+    ifstream in(filename.c_str(), ios::binary);
+    in.seekg(0, ios::end);
+    bool valid = in && UInt64(in.tellg()) == file_size && features_begin <= features_end && features_end <= file_size;
+    UInt64 last_end = features_begin;
+    for (const RangeIndexBlock_& block : blocks)
+    {
+      valid = valid && block.begin >= last_end && block.begin <= block.end && block.end <= features_end;
+      last_end = block.end;
+    }
+    if (!valid)
+    {
+      OPENMS_LOG_WARN << "Warning: ignoring outdated range index '" << index_filename << "'." << std::endl;
+      return false;
+    }
+
+    auto selected = [this](const RangeIndexBlock_& block)
+    {
+      return (!options_.hasRTRange() || block.overlaps(0, options_.getRTRange()))
+             && (!options_.hasMZRange() || block.overlaps(1, options_.getMZRange()))
+             && (!options_.hasIntensityRange() || block.overlaps(2, options_.getIntensityRange()));
+    };
+    auto read = [&in, &buffer](UInt64 begin, UInt64 end)
+    {
+      const Size size = buffer.size();
+      buffer.resize(size + (end - begin));
+      in.seekg(begin);
+      in.read(&buffer[size], end - begin);
+    };
+
+    // everything before the features, the selected blocks (adjacent ones in a single read) and everything after;
+    // the file is checked to have tags at the indexed offsets, as a cheap test against modified files of the same size
+    buffer.clear();
+    read(0, features_begin);
+    valid = buffer.rfind("<featureList") != std::string::npos;
+    for (Size i = 0; i < blocks.size() && valid; ++i)
+    {
+      if (!selected(blocks[i])) continue;
+      const UInt64 begin = blocks[i].begin;
+      while (i + 1 < blocks.size() && blocks[i + 1].begin == blocks[i].end && selected(blocks[i + 1]))
+      {
+        ++i;
+      }
+      const Size pos = buffer.size();
+      read(begin, blocks[i].end);
+      valid = startsWithTag_(buffer, pos, "<feature ");
+    }
+    const Size suffix = buffer.size();
+    read(features_end, file_size);
+    valid = valid && in && startsWithTag_(buffer, suffix, "</featureList>");
+
+    if (!valid)
+    {
+      OPENMS_LOG_WARN << "Warning: ignoring outdated range index '" << index_filename << "'." << std::endl;
+      buffer.clear();
+      return false;
+    }
+    return true;
+  }
+
   FeatureFileOptions& FeatureXMLFile::getOptions()
   {
     return options_;
@@ -941,19 +1138,19 @@ namespace OpenMS
     String& current_tag = open_tags_.back();
     if (current_tag == "intensity")
     {
-      current_feature_->setIntensity(asDouble_(sm_.convert(chars)));
+      current_feature_->setIntensity(asDouble_(chars));
     }
     else if (current_tag == "position")
     {
-      current_feature_->getPosition()[dim_] = asDouble_(sm_.convert(chars));
+      current_feature_->getPosition()[dim_] = asDouble_(chars);
     }
     else if (current_tag == "quality")
     {
-      current_feature_->setQuality(dim_, asDouble_(sm_.convert(chars)));
+      current_feature_->setQuality(dim_, asDouble_(chars));
     }
     else if (current_tag == "overallquality")
     {
-      current_feature_->setOverallQuality(asDouble_(sm_.convert(chars)));
+      current_feature_->setOverallQuality(asDouble_(chars));
     }
     else if (current_tag == "charge")
     {
@@ -961,7 +1158,7 @@ namespace OpenMS
     }
     else if (current_tag == "hposition")
     {
-      hull_position_[dim_] = asDouble_(sm_.convert(chars));
+      hull_position_[dim_] = asDouble_(chars);
     }
   }
 
@@ -144,6 +144,7 @@ namespace OpenMS
     targetMap[FileTypes::JSON] = "json";
     targetMap[FileTypes::RAW] = "raw";
     targetMap[FileTypes::EXE] = "exe";
+    targetMap[FileTypes::TRBIN] = "trbin";
 
     return targetMap;
   }
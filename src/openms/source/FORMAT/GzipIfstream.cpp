@@ -36,19 +36,186 @@
 #include <OpenMS/FORMAT/GzipIfstream.h>
 #include <OpenMS/CONCEPT/Exception.h>
 #include <cstdlib>
+#include <exception>
+#include <memory>
+#include <vector>
 
 using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// maximal uncompressed size of a BGZF block
+    const size_t BGZF_MAX_BLOCK_SIZE = 65536;
+
+    /// size of the read-ahead chunks for regular gzip files
+    const Size GZIP_CHUNK_SIZE = 1 << 20;
+
+    /// BGZF files are read in larger chunks, so there are enough blocks to inflate in parallel
+    const Size BGZF_CHUNK_SIZE = 64 * BGZF_MAX_BLOCK_SIZE;
+
+    UInt32 readLE32_(const unsigned char* p)
+    {
+      return UInt32(p[0]) | (UInt32(p[1]) << 8) | (UInt32(p[2]) << 16) | (UInt32(p[3]) << 24);
+    }
+
+    /// true if the file starts with a BGZF block header (gzip member with a 'BC' extra subfield)
+    bool isBGZF_(const char* filename)
+    {
+      FILE* file = fopen(filename, "rb");
+      if (file == nullptr) return false;
+      unsigned char header[16];
+      size_t n = fread(header, 1, 16, file);
+      fclose(file);
+      return n == 16 && header[0] == 31 && header[1] == 139 && header[2] == 8 && (header[3] & 4) != 0 &&
+             header[10] >= 6 && header[12] == 'B' && header[13] == 'C' && header[14] == 2 && header[15] == 0;
+    }
+
+    /**
+      @brief Reads a BGZF file block by block and inflates the blocks of one chunk in parallel
+
+      Each BGZF block is a complete gzip member whose header stores the
+      compressed size and whose footer stores the uncompressed size and CRC32,
+      so the output position of every block is known before inflating it.
+    */
+    class BGZFReader_
+    {
+  public:
+      explicit BGZFReader_(FILE* file) :
+        file_(file), has_pending_(false)
+      {
+      }
+
+      size_t read(char* buffer, size_t size)
+      {
+        std::vector<Block> blocks;
+        size_t total = 0;
+        if (has_pending_)
+        {
+          total += pending_.isize;
+          blocks.push_back(std::move(pending_));
+          has_pending_ = false;
+        }
+        Block block;
+        while (readBlock_(block))
+        {
+          if (block.isize == 0) continue; // empty blocks (e.g. the EOF marker)
+          if (total + block.isize > size)
+          {
+            pending_ = std::move(block);
+            has_pending_ = true;
+            break;
+          }
+          total += block.isize;
+          blocks.push_back(std::move(block));
+          block = Block();
+        }
+
+        std::vector<size_t> offsets(blocks.size(), 0);
+        for (Size i = 1; i < blocks.size(); ++i)
+        {
+          offsets[i] = offsets[i - 1] + blocks[i - 1].isize;
+        }
+
+        std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (SignedSize i = 0; i < (SignedSize)blocks.size(); ++i)
+        {
+          try
+          {
+            inflate_(blocks[i], reinterpret_cast<unsigned char*>(buffer + offsets[i]));
+          }
+          catch (...)
+          {
+#ifdef _OPENMP
+#pragma omp critical (BGZFReader_error)
+#endif
+            if (!error) error = std::current_exception();
+          }
+        }
+        if (error) std::rethrow_exception(error);
+        return total;
+      }
+
+  private:
+      struct Block
+      {
+        std::vector<unsigned char> data; ///< deflate payload followed by CRC32 and ISIZE
+        UInt32 crc = 0;
+        UInt32 isize = 0;
+      };
+
+      static void corrupt_(const char* reason)
+      {
+        throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, std::string("gzip file seems to be corrupted: ") + reason);
+      }
+
+      /// reads the next block; returns false at the end of the file
+      bool readBlock_(Block& block)
+      {
+        unsigned char header[12];
+        size_t n = fread(header, 1, 12, file_);
+        if (n == 0) return false;
+        if (n < 12 || header[0] != 31 || header[1] != 139 || header[2] != 8 || (header[3] & 4) == 0)
+        {
+          corrupt_("invalid BGZF block header");
+        }
+        size_t xlen = header[10] | (header[11] << 8);
+        std::vector<unsigned char> extra(xlen);
+        if (fread(extra.data(), 1, xlen, file_) != xlen) corrupt_("truncated BGZF block header");
+
+        size_t block_size = 0;
+        for (size_t p = 0; p + 4 <= xlen; p += 4 + (extra[p + 2] | (extra[p + 3] << 8)))
+        {
+          if (extra[p] == 'B' && extra[p + 1] == 'C' && extra[p + 2] == 2 && extra[p + 3] == 0 && p + 6 <= xlen)
+          {
+            block_size = size_t(extra[p + 4] | (extra[p + 5] << 8)) + 1;
+            break;
+          }
+        }
+        if (block_size < 12 + xlen + 8) corrupt_("missing BGZF block size");
+
+        block.data.resize(block_size - 12 - xlen);
+        if (fread(block.data.data(), 1, block.data.size(), file_) != block.data.size()) corrupt_("truncated BGZF block");
+        const unsigned char* footer = block.data.data() + block.data.size() - 8;
+        block.crc = readLE32_(footer);
+        block.isize = readLE32_(footer + 4);
+        if (block.isize > BGZF_MAX_BLOCK_SIZE) corrupt_("BGZF block too large");
+        return true;
+      }
+
+      static void inflate_(const Block& block, unsigned char* out)
+      {
+        z_stream zs = z_stream();
+        if (inflateInit2(&zs, -15) != Z_OK) corrupt_("cannot initialize zlib");
+        zs.next_in = const_cast<Bytef*>(block.data.data());
+        zs.avail_in = static_cast<uInt>(block.data.size() - 8);
+        zs.next_out = out;
+        zs.avail_out = block.isize;
+        int ret = ::inflate(&zs, Z_FINISH);
+        uLong written = zs.total_out;
+        inflateEnd(&zs);
+        if (ret != Z_STREAM_END || written != block.isize) corrupt_("cannot inflate BGZF block");
+        if (crc32(crc32(0L, Z_NULL, 0), out, block.isize) != block.crc) corrupt_("CRC mismatch in BGZF block");
+      }
+
+      FILE* file_;
+      Block pending_; ///< block which did not fit into the previous chunk
+      bool has_pending_;
+    };
+  }
+
   GzipIfstream::GzipIfstream(const char * filename) :
-    gzfile_(nullptr), n_buffer_(0), stream_at_end_(false)
+    gzfile_(nullptr), bgzf_file_(nullptr), n_buffer_(0), gzerror_(0), stream_at_end_(false)
   {
     open(filename);
   }
 
   GzipIfstream::GzipIfstream() :
-    gzfile_(nullptr), n_buffer_(0), gzerror_(0), stream_at_end_(true)
+    gzfile_(nullptr), bgzf_file_(nullptr), n_buffer_(0), gzerror_(0), stream_at_end_(true)
   {
   }
 
@@ -59,18 +226,20 @@ namespace OpenMS
 
   size_t GzipIfstream::read(char * s, size_t n)
   {
-    if (gzfile_ != nullptr)
+    if (isOpen())
     {
-      n_buffer_ = gzread(gzfile_, s, (unsigned int) n /* size of buf */);
-      if (gzeof(gzfile_) == 1)
+      try
+      {
+        n_buffer_ = (int) read_ahead_.read(s, n);
+      }
+      catch (...)
       {
         close();
-        stream_at_end_ = true;
+        throw;
       }
-      if (n_buffer_ < 0)
+      if ((size_t) n_buffer_ < n) // end of file
       {
         close();
-        throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "gzip file seems to be corrupted");
       }
       return n_buffer_;
     }
@@ -82,10 +251,25 @@ namespace OpenMS
 
   void GzipIfstream::open(const char * filename)
   {
-    if (gzfile_ != nullptr)
+    if (isOpen())
     {
       close();
     }
+
+    if (isBGZF_(filename))
+    {
+      bgzf_file_ = fopen(filename, "rb");
+    }
+    if (bgzf_file_ != nullptr)
+    {
+      // the reader is owned by the producer and destroyed together with it
+      std::shared_ptr<BGZFReader_> reader(new BGZFReader_(bgzf_file_));
+      read_ahead_.setChunkSize(BGZF_CHUNK_SIZE);
+      read_ahead_.start([reader](char* buffer, size_t size) { return reader->read(buffer, size); });
+      stream_at_end_ = false;
+      return;
+    }
+
     gzfile_ = gzopen(filename, "rb"); // read binary: always open in binary mode because windows and mac open in text mode
 
     //aborting, ahhh!
@@ -97,6 +281,17 @@ namespace OpenMS
     else
     {
       stream_at_end_ = false;
+      gzFile file = gzfile_;
+      read_ahead_.setChunkSize(GZIP_CHUNK_SIZE);
+      read_ahead_.start([file](char* buffer, size_t size)
+      {
+        int n = gzread(file, buffer, (unsigned int) size /* size of buf */);
+        if (n < 0)
+        {
+          throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "gzip file seems to be corrupted");
+        }
+        return (size_t) n;
+      });
       /*		crc  = crc32(0L, Z_NULL, 0);
               FILE* file =  fopen(filename,"rb");
               fseek(file,8,SEEK_END);
@@ -139,11 +334,18 @@ namespace OpenMS
 
   void GzipIfstream::close()
   {
+    // the producer thread has to be finished before its file handle goes away
+    read_ahead_.stop();
     if (gzfile_ != nullptr)
     {
       gzclose(gzfile_);
     }
+    if (bgzf_file_ != nullptr)
+    {
+      fclose(bgzf_file_);
+    }
     gzfile_ = nullptr;
+    bgzf_file_ = nullptr;
     stream_at_end_ = true;
   }
 
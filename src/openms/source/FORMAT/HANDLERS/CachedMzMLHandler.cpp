@@ -37,6 +37,8 @@
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 
+#include <cstring>
+
 namespace OpenMS
 {
 namespace Internal
@@ -378,6 +380,126 @@ namespace Internal
     return;
   }
 
+  namespace
+  {
+    /// Sequential, bounds-checked reading from a memory buffer
+    class BufferReader_
+    {
+    public:
+      BufferReader_(const char* buffer, Size buffer_size) :
+        pos_(buffer),
+        end_(buffer + buffer_size)
+      {
+      }
+
+      void read(void* target, Size nr_bytes)
+      {
+        checkAvailable_(nr_bytes);
+        std::memcpy(target, pos_, nr_bytes);
+        pos_ += nr_bytes;
+      }
+
+      void skip(Size nr_bytes)
+      {
+        checkAvailable_(nr_bytes);
+        pos_ += nr_bytes;
+      }
+
+      void readArray(OpenSwath::BinaryDataArray& array, Size nr_elements)
+      {
+        checkAvailable_(nr_elements * sizeof(CachedMzMLHandler::DatumSingleton));
+        const CachedMzMLHandler::DatumSingleton* first = reinterpret_cast<const CachedMzMLHandler::DatumSingleton*>(pos_);
+        array.data.assign(first, first + nr_elements);
+        pos_ += nr_elements * sizeof(CachedMzMLHandler::DatumSingleton);
+      }
+
+    private:
+      void checkAvailable_(Size nr_bytes) const
+      {
+        if (nr_bytes > Size(end_ - pos_))
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+            "Read past the end of the cached data, something is wrong here. Aborting.", "memory buffer");
+        }
+      }
+
+      const char* pos_;
+      const char* end_;
+    };
+
+    void readDataFromBuffer_(BufferReader_& reader, std::vector<OpenSwath::BinaryDataArrayPtr>& data, Size data_size, Size nr_float_arrays)
+    {
+      reader.readArray(*data[0], data_size);
+      reader.readArray(*data[1], data_size);
+
+      for (Size k = 0; k < nr_float_arrays; k++)
+      {
+        data.push_back(OpenSwath::BinaryDataArrayPtr(new OpenSwath::BinaryDataArray));
+        Size len, len_name;
+        reader.read(&len, sizeof(len));
+        reader.read(&len_name, sizeof(len_name));
+
+        // We will not read data longer than 1024 bytes (see readDataFast_)
+        if (len_name > 1023)
+        {
+          reader.skip(len_name);
+        }
+        else
+        {
+          data.back()->description.resize(len_name);
+          if (len_name > 0) reader.read(&data.back()->description[0], len_name);
+        }
+        reader.readArray(*data.back(), len);
+      }
+    }
+  }
+
+  std::vector<OpenSwath::BinaryDataArrayPtr> CachedMzMLHandler::readSpectrumFast(const char* buffer, Size buffer_size, int& ms_level, double& rt)
+  {
+    std::vector<OpenSwath::BinaryDataArrayPtr> data;
+    data.push_back(OpenSwath::BinaryDataArrayPtr(new OpenSwath::BinaryDataArray));
+    data.push_back(OpenSwath::BinaryDataArrayPtr(new OpenSwath::BinaryDataArray));
+
+    BufferReader_ reader(buffer, buffer_size);
+    Size spec_size = -1;
+    Size nr_float_arrays = -1;
+    reader.read(&spec_size, sizeof(spec_size));
+    reader.read(&nr_float_arrays, sizeof(nr_float_arrays));
+    reader.read(&ms_level, sizeof(ms_level));
+    reader.read(&rt, sizeof(rt));
+
+    if (static_cast<int>(spec_size) < 0)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
+        "Read an invalid spectrum length, something is wrong here. Aborting.", "memory buffer");
+    }
+
+    readDataFromBuffer_(reader, data, spec_size, nr_float_arrays);
+    return data;
+  }
+
+  std::vector<OpenSwath::BinaryDataArrayPtr> CachedMzMLHandler::readChromatogramFast(const char* buffer, Size buffer_size)
+  {
+    std::vector<OpenSwath::BinaryDataArrayPtr> data;
+    data.push_back(OpenSwath::BinaryDataArrayPtr(new OpenSwath::BinaryDataArray));
+    data.push_back(OpenSwath::BinaryDataArrayPtr(new OpenSwath::BinaryDataArray));
+
+    BufferReader_ reader(buffer, buffer_size);
+    Size chrom_size = -1;
+    Size nr_float_arrays = -1;
+    reader.read(&chrom_size, sizeof(chrom_size));
+    reader.read(&nr_float_arrays, sizeof(nr_float_arrays));
+
+    if (static_cast<int>(chrom_size) < 0)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
+        "Read an invalid chromatogram length, something is wrong here. Aborting.", "memory buffer");
+    }
+
+    readDataFromBuffer_(reader, data, chrom_size, nr_float_arrays);
+    return data;
+  }
+
   std::vector<OpenSwath::BinaryDataArrayPtr> CachedMzMLHandler::readChromatogramFast(std::ifstream& ifs)
   {
     std::vector<OpenSwath::BinaryDataArrayPtr> data;
@@ -404,6 +526,31 @@ namespace Internal
     int ms_level;
     double rt;
     std::vector<OpenSwath::BinaryDataArrayPtr> data = readSpectrumFast(ifs, ms_level, rt);
+    fillSpectrum_(spectrum, data, ms_level, rt);
+  }
+
+  void CachedMzMLHandler::readChromatogram(ChromatogramType& chromatogram, std::ifstream& ifs)
+  {
+    std::vector<OpenSwath::BinaryDataArrayPtr> data = readChromatogramFast(ifs);
+    fillChromatogram_(chromatogram, data);
+  }
+
+  void CachedMzMLHandler::readSpectrum(SpectrumType& spectrum, const char* buffer, Size buffer_size)
+  {
+    int ms_level;
+    double rt;
+    std::vector<OpenSwath::BinaryDataArrayPtr> data = readSpectrumFast(buffer, buffer_size, ms_level, rt);
+    fillSpectrum_(spectrum, data, ms_level, rt);
+  }
+
+  void CachedMzMLHandler::readChromatogram(ChromatogramType& chromatogram, const char* buffer, Size buffer_size)
+  {
+    std::vector<OpenSwath::BinaryDataArrayPtr> data = readChromatogramFast(buffer, buffer_size);
+    fillChromatogram_(chromatogram, data);
+  }
+
+  void CachedMzMLHandler::fillSpectrum_(SpectrumType& spectrum, const std::vector<OpenSwath::BinaryDataArrayPtr>& data, int ms_level, double rt)
+  {
     spectrum.reserve(data[0]->data.size());
     spectrum.setMSLevel(ms_level);
     spectrum.setRT(rt);
@@ -425,9 +572,8 @@ namespace Internal
     }
   }
 
-  void CachedMzMLHandler::readChromatogram(ChromatogramType& chromatogram, std::ifstream& ifs)
+  void CachedMzMLHandler::fillChromatogram_(ChromatogramType& chromatogram, const std::vector<OpenSwath::BinaryDataArrayPtr>& data)
   {
-    std::vector<OpenSwath::BinaryDataArrayPtr> data = readChromatogramFast(ifs);
     chromatogram.reserve(data[0]->data.size());
 
     for (Size j = 0; j < data[0]->data.size(); j++)
@@ -443,7 +589,7 @@ namespace Internal
     {
       MSChromatogram::FloatDataArray fda;
       fda.reserve(data[j]->data.size());
-      for (const auto& k : fda) fda.push_back(k);
+      for (const auto& k : data[j]->data) fda.push_back(k);
       fda.setName(data[j]->description);
       fdas.push_back(fda);
     }
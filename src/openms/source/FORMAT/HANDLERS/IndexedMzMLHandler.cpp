@@ -99,7 +99,9 @@ namespace Internal
   IndexedMzMLHandler::IndexedMzMLHandler(const IndexedMzMLHandler& source) :
     filename_(source.filename_),
     spectra_offsets_(source.spectra_offsets_),
+    spectra_native_ids_(source.spectra_native_ids_),
     chromatograms_offsets_(source.chromatograms_offsets_),
+    chromatograms_native_ids_(source.chromatograms_native_ids_),
     index_offset_(source.index_offset_),
     spectra_before_chroms_(source.spectra_before_chroms_),
     // do not copy the filestream itself but open a new filestream using the same file
@@ -291,6 +293,46 @@ namespace Internal
     MzMLSpectrumDecoder(skip_xml_checks_).domParseSpectrum(text, s);
   }
 
+  std::string IndexedMzMLHandler::getSpectrumHeaderById(int id)
+  {
+    if (!parsing_success_)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
+          "Parsing was unsuccessful, cannot read file", "");
+    }
+    if (id < 0 || id >= (int)getNrSpectra())
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String( 
+            "id needs to be within [0, " + String(getNrSpectra()) + "), was " + String(id) ));
+    }
+
+    // read in small blocks until the binary data (or the end of the spectrum) starts
+    const Size block_size = 4096;
+    std::string text;
+    Size searched = 0;
+    filestream_.seekg(spectra_offsets_[id], filestream_.beg);
+    while (filestream_)
+    {
+      Size old_size = text.size();
+      text.resize(old_size + block_size);
+      filestream_.read(&text[old_size], block_size);
+      text.resize(old_size + filestream_.gcount());
+
+      // the tag may straddle two blocks
+      Size from = searched > 20 ? searched - 20 : 0;
+      Size end = text.find("<binaryDataArrayList", from);
+      if (end == std::string::npos) end = text.find("</spectrum>", from);
+      if (end != std::string::npos)
+      {
+        text.resize(end);
+        break;
+      }
+      searched = text.size();
+    }
+    filestream_.clear(); // reading up to the end of the file is no error
+    return text;
+  }
+
   OpenMS::Interfaces::ChromatogramPtr IndexedMzMLHandler::getChromatogramById(int id)
   {
     OpenMS::Interfaces::ChromatogramPtr cptr(new OpenMS::Interfaces::Chromatogram);
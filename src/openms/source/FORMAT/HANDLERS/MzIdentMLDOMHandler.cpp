@@ -33,6 +33,7 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/FORMAT/HANDLERS/MzIdentMLDOMHandler.h>
+#include <OpenMS/FORMAT/XMLFile.h>
 #include <OpenMS/SYSTEM/File.h>
 
 #include <OpenMS/CHEMISTRY/ModificationsDB.h>
@@ -43,8 +44,16 @@
 
 #include <boost/lexical_cast.hpp>
 
+#include <xercesc/framework/LocalFileInputSource.hpp>
+#include <xercesc/sax/SAXParseException.hpp>
+#include <xercesc/sax2/Attributes.hpp>
+#include <xercesc/sax2/DefaultHandler.hpp>
+#include <xercesc/sax2/SAX2XMLReader.hpp>
+#include <xercesc/sax2/XMLReaderFactory.hpp>
+
 #include <sys/stat.h>
 #include <cerrno>
+#include <memory>
 
 using namespace std;
 using namespace xercesc;
@@ -71,7 +80,7 @@ namespace OpenMS
 
       try
       {
-        XMLPlatformUtils::Initialize(); // Initialize Xerces infrastructure
+        XMLFile::initializeXerces(); // Initialize Xerces infrastructure (once per process)
       }
       catch (XMLException& e)
       {
@@ -105,7 +114,7 @@ namespace OpenMS
 
       try
       {
-        XMLPlatformUtils::Initialize(); // Initialize Xerces infrastructure
+        XMLFile::initializeXerces(); // Initialize Xerces infrastructure (once per process)
       }
       catch (XMLException& e)
       {
@@ -124,8 +133,8 @@ namespace OpenMS
 
     /*
      *  Class destructor frees memory used to hold the XML tag and
-     *  attribute definitions. It also terminates use of the xerces-C
-     *  framework.
+     *  attribute definitions. Xerces is not terminated here, since other
+     *  threads may still be using it (see XMLFile::initializeXerces()).
      */
     MzIdentMLDOMHandler::~MzIdentMLDOMHandler()
     {
@@ -140,18 +149,6 @@ namespace OpenMS
       {
         OPENMS_LOG_ERROR << "Unknown exception encountered in 'TagNames' destructor" << endl;
       }
-
-      // Terminate Xerces
-      try
-      {
-        XMLPlatformUtils::Terminate(); // Terminate after release of memory
-      }
-      catch (xercesc::XMLException& e)
-      {
-        char* message = xercesc::XMLString::transcode(e.getMessage());
-        OPENMS_LOG_ERROR << "XML toolkit teardown error: " << message << endl;
-        XMLString::release(&message);
-      }
     }
 
     /*
@@ -191,60 +188,7 @@ namespace OpenMS
         // no need to free this pointer - owned by the parent parser object
         xercesc::DOMDocument* xmlDoc = mzid_parser_.getDocument();
 
-        // Catch special case: Cross-Linking MS
-        DOMNodeList* additionalSearchParams = xmlDoc->getElementsByTagName(XMLString::transcode("AdditionalSearchParams"));
-        const  XMLSize_t as_node_count = additionalSearchParams->getLength();
-
-        for (XMLSize_t i = 0; i < as_node_count; ++i)
-        {
-          DOMNode* current_sp = additionalSearchParams->item(i);
-
-          DOMElement* element_SearchParams = dynamic_cast<xercesc::DOMElement*>(current_sp);
-          String cross_linking_search = XMLString::transcode(element_SearchParams->getAttribute(XMLString::transcode("id")));
-          DOMElement* child = element_SearchParams->getFirstElementChild();
-
-          while (child && !xl_ms_search_)
-          {
-            String accession = XMLString::transcode(child->getAttribute(XMLString::transcode("accession")));
-            if (accession == "MS:1002494") // accession for "cross-linking search"
-            {
-              xl_ms_search_ = true;
-            }
-            child = child->getNextElementSibling();
-          }
-        }
-
-        if (xl_ms_search_)
-        {
-          OPENMS_LOG_DEBUG << "Reading a Cross-Linking MS file." << endl;
-        }
-
-        // 0. AnalysisSoftwareList {0,1}
-        DOMNodeList* analysisSoftwareElements = xmlDoc->getElementsByTagName(XMLString::transcode("AnalysisSoftware"));
-        parseAnalysisSoftwareList_(analysisSoftwareElements);
-
-        // 1. DataCollection {1,1}
-        DOMNodeList* spectraDataElements = xmlDoc->getElementsByTagName(XMLString::transcode("SpectraData"));
-        if (spectraDataElements->getLength() == 0) throw(runtime_error("No SpectraData nodes"));
-        parseInputElements_(spectraDataElements);
-
-        // 1.2. SearchDatabase {0,unbounded}
-        DOMNodeList* searchDatabaseElements = xmlDoc->getElementsByTagName(XMLString::transcode("SearchDatabase"));
-        parseInputElements_(searchDatabaseElements);
-
-        // 1.1 SourceFile {0,unbounded}
-        DOMNodeList* sourceFileElements = xmlDoc->getElementsByTagName(XMLString::transcode("SourceFile"));
-        parseInputElements_(sourceFileElements);
-
-        // 2. SpectrumIdentification  {1,unbounded} ! creates identification runs (or ProteinIdentifications)
-        DOMNodeList* spectrumIdentificationElements = xmlDoc->getElementsByTagName(XMLString::transcode("SpectrumIdentification"));
-        if (spectrumIdentificationElements->getLength() == 0) throw(runtime_error("No SpectrumIdentification nodes"));
-        parseSpectrumIdentificationElements_(spectrumIdentificationElements);
-
-        // 3. AnalysisProtocolCollection {1,1} SpectrumIdentificationProtocol  {1,unbounded} ! identification run parameters
-        DOMNodeList* spectrumIdentificationProtocolElements = xmlDoc->getElementsByTagName(XMLString::transcode("SpectrumIdentificationProtocol"));
-        if (spectrumIdentificationProtocolElements->getLength() == 0) throw(runtime_error("No SpectrumIdentificationProtocol nodes"));
-        parseSpectrumIdentificationProtocolElements_(spectrumIdentificationProtocolElements);
+        parseSearchSetup_(xmlDoc);
 
         // 4. SequenceCollection nodes {0,1} DBSequenceElement {1,unbounded} Peptide {0,unbounded} PeptideEvidence {0,unbounded}
         DOMNodeList* dbSequenceElements = xmlDoc->getElementsByTagName(XMLString::transcode("DBSequence"));
@@ -285,6 +229,69 @@ namespace OpenMS
         OPENMS_LOG_ERROR << "XERCES error parsing file: " << message << flush << endl;
         XMLString::release(&message);
       }
+      postProcessXLMS_();
+    }
+
+    void MzIdentMLDOMHandler::parseSearchSetup_(xercesc::DOMDocument* xmlDoc)
+    {
+      // Catch special case: Cross-Linking MS
+      DOMNodeList* additionalSearchParams = xmlDoc->getElementsByTagName(XMLString::transcode("AdditionalSearchParams"));
+      const  XMLSize_t as_node_count = additionalSearchParams->getLength();
+
+      for (XMLSize_t i = 0; i < as_node_count; ++i)
+      {
+        DOMNode* current_sp = additionalSearchParams->item(i);
+
+        DOMElement* element_SearchParams = dynamic_cast<xercesc::DOMElement*>(current_sp);
+        String cross_linking_search = XMLString::transcode(element_SearchParams->getAttribute(XMLString::transcode("id")));
+        DOMElement* child = element_SearchParams->getFirstElementChild();
+
+        while (child && !xl_ms_search_)
+        {
+          String accession = XMLString::transcode(child->getAttribute(XMLString::transcode("accession")));
+          if (accession == "MS:1002494") // accession for "cross-linking search"
+          {
+            xl_ms_search_ = true;
+          }
+          child = child->getNextElementSibling();
+        }
+      }
+
+      if (xl_ms_search_)
+      {
+        OPENMS_LOG_DEBUG << "Reading a Cross-Linking MS file." << endl;
+      }
+
+      // 0. AnalysisSoftwareList {0,1}
+      DOMNodeList* analysisSoftwareElements = xmlDoc->getElementsByTagName(XMLString::transcode("AnalysisSoftware"));
+      parseAnalysisSoftwareList_(analysisSoftwareElements);
+
+      // 1. DataCollection {1,1}
+      DOMNodeList* spectraDataElements = xmlDoc->getElementsByTagName(XMLString::transcode("SpectraData"));
+      if (spectraDataElements->getLength() == 0) throw(runtime_error("No SpectraData nodes"));
+      parseInputElements_(spectraDataElements);
+
+      // 1.2. SearchDatabase {0,unbounded}
+      DOMNodeList* searchDatabaseElements = xmlDoc->getElementsByTagName(XMLString::transcode("SearchDatabase"));
+      parseInputElements_(searchDatabaseElements);
+
+      // 1.1 SourceFile {0,unbounded}
+      DOMNodeList* sourceFileElements = xmlDoc->getElementsByTagName(XMLString::transcode("SourceFile"));
+      parseInputElements_(sourceFileElements);
+
+      // 2. SpectrumIdentification  {1,unbounded} ! creates identification runs (or ProteinIdentifications)
+      DOMNodeList* spectrumIdentificationElements = xmlDoc->getElementsByTagName(XMLString::transcode("SpectrumIdentification"));
+      if (spectrumIdentificationElements->getLength() == 0) throw(runtime_error("No SpectrumIdentification nodes"));
+      parseSpectrumIdentificationElements_(spectrumIdentificationElements);
+
+      // 3. AnalysisProtocolCollection {1,1} SpectrumIdentificationProtocol  {1,unbounded} ! identification run parameters
+      DOMNodeList* spectrumIdentificationProtocolElements = xmlDoc->getElementsByTagName(XMLString::transcode("SpectrumIdentificationProtocol"));
+      if (spectrumIdentificationProtocolElements->getLength() == 0) throw(runtime_error("No SpectrumIdentificationProtocol nodes"));
+      parseSpectrumIdentificationProtocolElements_(spectrumIdentificationProtocolElements);
+    }
+
+    void MzIdentMLDOMHandler::postProcessXLMS_()
+    {
       if (xl_ms_search_)
       {
         OPXLHelper::addProteinPositionMetaValues(*this->pep_id_);
@@ -296,6 +303,296 @@ namespace OpenMS
       }
     }
 
+    namespace
+    {
+      /// DOMNodeList of a single node, to hand a streamed element to the DOM parse functions
+      class SingleNodeList_ :
+        public DOMNodeList
+      {
+      public:
+        explicit SingleNodeList_(DOMNode* node) :
+          node_(node)
+        {
+        }
+
+        DOMNode* item(XMLSize_t index) const override
+        {
+          return index == 0 ? node_ : nullptr;
+        }
+
+        XMLSize_t getLength() const override
+        {
+          return 1;
+        }
+
+      private:
+        DOMNode* node_;
+      };
+    }
+
+    /*
+     * Builds the DOM tree of a mzid file while it is SAX parsed, except for the
+     * (numerous) DBSequence, Peptide, PeptideEvidence and SpectrumIdentificationResult
+     * elements: those are built into separate fragment documents, parsed with the
+     * regular DOM parse functions as soon as they are complete and released again.
+     */
+    class MzIdentMLDOMHandler::SAXFragmentBuilder_ :
+      public DefaultHandler
+    {
+    public:
+      SAXFragmentBuilder_(MzIdentMLDOMHandler& handler, const std::string& filename, const std::function<void(vector<PeptideIdentification>&)>& pep_id_callback, Size batch_size) :
+        handler_(handler),
+        filename_(filename),
+        pep_id_callback_(pep_id_callback),
+        batch_size_(std::max(batch_size, Size(1)))
+      {
+        const char* names[SIZE_OF_TAGS] = {"SequenceCollection", "DBSequence", "Peptide", "PeptideEvidence",
+                                           "SpectrumIdentificationList", "SpectrumIdentificationResult", "ProteinDetectionList", "Fragments", "XML 1.0"};
+        for (Size i = 0; i < SIZE_OF_TAGS; ++i)
+        {
+          tags_[i] = XMLString::transcode(names[i]);
+        }
+        impl_ = DOMImplementationRegistry::getDOMImplementation(tags_[IMPLEMENTATION]);
+        skeleton_ = impl_->createDocument();
+        peptides_ = createFragmentDocument_();
+        fragments_ = createFragmentDocument_();
+      }
+
+      ~SAXFragmentBuilder_() override
+      {
+        skeleton_->release();
+        if (peptides_ != nullptr) peptides_->release();
+        fragments_->release();
+        for (Size i = 0; i < SIZE_OF_TAGS; ++i)
+        {
+          XMLString::release(&tags_[i]);
+        }
+      }
+
+      void startElement(const XMLCh* const /*uri*/, const XMLCh* const /*localname*/, const XMLCh* const qname, const Attributes& attrs) override
+      {
+        appendCharacters_();
+        if (XMLString::equals(qname, tags_[SPECTRUM_IDENTIFICATION_LIST]))
+        {
+          // everything the identifications refer to precedes the AnalysisData (schema order)
+          if (!setup_parsed_) parseSearchSetup_();
+          sil_found_ = true;
+        }
+
+        DOMElement* element = nullptr;
+        if (open_.empty()) // root element
+        {
+          element = skeleton_->createElement(qname);
+          skeleton_->appendChild(element);
+        }
+        else if (streamed_ == nullptr && isStreamed_(open_.back(), qname))
+        {
+          // Peptides can only be parsed once the search setup is known (cross-linking), they wait in their own document
+          xercesc::DOMDocument* doc = (!setup_parsed_ && XMLString::equals(qname, tags_[PEPTIDE])) ? peptides_ : fragments_;
+          // the parse functions may look at the parent (e.g. for the SpectrumIdentificationList id), so a shallow copy of it is kept
+          DOMNode* parent = doc->importNode(open_.back(), false);
+          doc->getDocumentElement()->appendChild(parent);
+          element = doc->createElement(qname);
+          parent->appendChild(element);
+          streamed_ = element;
+        }
+        else
+        {
+          element = open_.back()->getOwnerDocument()->createElement(qname);
+          open_.back()->appendChild(element);
+        }
+
+        const XMLSize_t attr_count = attrs.getLength();
+        for (XMLSize_t i = 0; i < attr_count; ++i)
+        {
+          element->setAttribute(attrs.getQName(i), attrs.getValue(i));
+        }
+        open_.push_back(element);
+      }
+
+      void endElement(const XMLCh* const /*uri*/, const XMLCh* const /*localname*/, const XMLCh* const qname) override
+      {
+        appendCharacters_();
+        DOMElement* element = open_.back();
+        open_.pop_back();
+        if (element != streamed_) return;
+
+        streamed_ = nullptr;
+        if (element->getOwnerDocument() == peptides_) return; // parsed in parseSearchSetup_()
+
+        SingleNodeList_ streamed(element);
+        if (XMLString::equals(qname, tags_[DB_SEQUENCE]))
+        {
+          handler_.parseDBSequenceElements_(&streamed);
+        }
+        else if (XMLString::equals(qname, tags_[PEPTIDE]))
+        {
+          handler_.parsePeptideElements_(&streamed);
+        }
+        else if (XMLString::equals(qname, tags_[PEPTIDE_EVIDENCE]))
+        {
+          handler_.parsePeptideEvidenceElements_(&streamed);
+        }
+        else // SpectrumIdentificationResult: parsed as the only one of its list
+        {
+          SingleNodeList_ list(element->getParentNode());
+          handler_.parseSpectrumIdentificationListElements_(&list);
+          // cross-linking post-processing needs all identifications
+          if (pep_id_callback_ && !handler_.xl_ms_search_ && handler_.pep_id_->size() >= batch_size_)
+          {
+            flushPeptideIdentifications();
+          }
+        }
+
+        DOMNode* parent = fragments_->getDocumentElement()->removeChild(element->getParentNode());
+        parent->release();
+        // released nodes are recycled, but the attribute values are only freed with their document
+        if (++fragment_count_ % 1024 == 0)
+        {
+          fragments_->release();
+          fragments_ = createFragmentDocument_();
+        }
+      }
+
+      void characters(const XMLCh* const chars, const XMLSize_t length) override
+      {
+        chars_.append(chars, length);
+      }
+
+      void fatalError(const SAXParseException& exception) override
+      {
+        char* message = XMLString::transcode(exception.getMessage());
+        String error_message = String("line ") + String(exception.getLineNumber()) + ", column " + String(exception.getColumnNumber()) + ": " + message;
+        XMLString::release(&message);
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_, error_message);
+      }
+
+      /// Parses the sections that are kept as DOM tree; call after the whole file was parsed
+      void finish()
+      {
+        if (!setup_parsed_) parseSearchSetup_();
+        if (!sil_found_) throw(runtime_error("No SpectrumIdentificationList nodes"));
+        handler_.parseProteinDetectionListElements_(skeleton_->getElementsByTagName(tags_[PROTEIN_DETECTION_LIST]));
+      }
+
+      /// Hands the collected PeptideIdentifications to the callback
+      void flushPeptideIdentifications()
+      {
+        if (!pep_id_callback_ || handler_.pep_id_->empty()) return;
+        pep_id_callback_(*handler_.pep_id_);
+        handler_.pep_id_->clear();
+      }
+
+    private:
+      enum Tag_
+      {
+        SEQUENCE_COLLECTION,
+        DB_SEQUENCE,
+        PEPTIDE,
+        PEPTIDE_EVIDENCE,
+        SPECTRUM_IDENTIFICATION_LIST,
+        SPECTRUM_IDENTIFICATION_RESULT,
+        PROTEIN_DETECTION_LIST,
+        FRAGMENTS,
+        IMPLEMENTATION,
+        SIZE_OF_TAGS
+      };
+
+      xercesc::DOMDocument* createFragmentDocument_() const
+      {
+        xercesc::DOMDocument* doc = impl_->createDocument();
+        doc->appendChild(doc->createElement(tags_[FRAGMENTS]));
+        return doc;
+      }
+
+      bool isStreamed_(const DOMElement* parent, const XMLCh* const qname) const
+      {
+        if (XMLString::equals(parent->getTagName(), tags_[SEQUENCE_COLLECTION]))
+        {
+          return XMLString::equals(qname, tags_[DB_SEQUENCE]) || XMLString::equals(qname, tags_[PEPTIDE]) || XMLString::equals(qname, tags_[PEPTIDE_EVIDENCE]);
+        }
+        return XMLString::equals(parent->getTagName(), tags_[SPECTRUM_IDENTIFICATION_LIST]) && XMLString::equals(qname, tags_[SPECTRUM_IDENTIFICATION_RESULT]);
+      }
+
+      /// Text content is only kept if it is not whitespace between elements
+      void appendCharacters_()
+      {
+        if (chars_.empty()) return;
+        if (!open_.empty() && !XMLString::isAllWhiteSpace(chars_.c_str()))
+        {
+          open_.back()->appendChild(open_.back()->getOwnerDocument()->createTextNode(chars_.c_str()));
+        }
+        chars_.clear();
+      }
+
+      void parseSearchSetup_()
+      {
+        handler_.parseSearchSetup_(skeleton_);
+        handler_.parsePeptideElements_(peptides_->getElementsByTagName(tags_[PEPTIDE]));
+        peptides_->release();
+        peptides_ = nullptr;
+        setup_parsed_ = true;
+      }
+
+      MzIdentMLDOMHandler& handler_;
+      const std::string filename_;
+      const std::function<void(vector<PeptideIdentification>&)>& pep_id_callback_;
+      const Size batch_size_;
+
+      XMLCh* tags_[SIZE_OF_TAGS];
+      DOMImplementation* impl_ = nullptr;
+      xercesc::DOMDocument* skeleton_ = nullptr; ///< all small sections
+      xercesc::DOMDocument* peptides_ = nullptr; ///< Peptides waiting for the search setup
+      xercesc::DOMDocument* fragments_ = nullptr; ///< streamed elements
+      Size fragment_count_ = 0;
+
+      std::vector<DOMElement*> open_; ///< open elements, innermost last
+      DOMElement* streamed_ = nullptr; ///< the open streamed element
+      std::basic_string<XMLCh> chars_; ///< character data of the current text node
+      bool setup_parsed_ = false;
+      bool sil_found_ = false;
+    };
+
+    void MzIdentMLDOMHandler::streamMzIdentMLFile(const std::string& mzid_file, const std::function<void(vector<PeptideIdentification>&)>& pep_id_callback, Size batch_size)
+    {
+      if (!File::exists(mzid_file))
+      {
+        throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, mzid_file);
+      }
+
+      SAXFragmentBuilder_ builder(*this, mzid_file, pep_id_callback, batch_size);
+      std::unique_ptr<SAX2XMLReader> parser(XMLReaderFactory::createXMLReader());
+      parser->setFeature(XMLUni::fgSAX2CoreNameSpaces, false);
+      parser->setFeature(XMLUni::fgSAX2CoreNameSpacePrefixes, false);
+      parser->setFeature(XMLUni::fgSAX2CoreValidation, false);
+      parser->setFeature(XMLUni::fgXercesLoadExternalDTD, false);
+      parser->setContentHandler(&builder);
+      parser->setErrorHandler(&builder);
+
+      try
+      {
+        XMLCh* file = XMLString::transcode(mzid_file.c_str());
+        LocalFileInputSource source(file);
+        XMLString::release(&file);
+        parser->parse(source);
+      }
+      catch (const XMLException& e)
+      {
+        char* message = XMLString::transcode(e.getMessage());
+        String error_message(message);
+        XMLString::release(&message);
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, mzid_file, error_message);
+      }
+      builder.finish();
+
+      for (vector<ProteinIdentification>::iterator it = pro_id_->begin(); it != pro_id_->end(); ++it)
+      {
+        it->sort();
+      }
+      postProcessXLMS_();
+      builder.flushPeptideIdentifications();
+    }
+
     void MzIdentMLDOMHandler::writeMzIdentMLFile(const std::string& mzid_file)
     {
       DOMImplementation* impl =  DOMImplementationRegistry::getDOMImplementation(XMLString::transcode("XML 1.0")); //XML 3?!
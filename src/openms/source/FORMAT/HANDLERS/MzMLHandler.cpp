@@ -36,6 +36,7 @@
 
 #include <OpenMS/CONCEPT/Exception.h>
 #include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/CONCEPT/Profiler.h>
 #include <OpenMS/CONCEPT/VersionInfo.h>
 #include <OpenMS/FORMAT/Base64.h>
 #include <OpenMS/FORMAT/CVMappingFile.h>
@@ -44,11 +45,103 @@
 #include <OpenMS/INTERFACES/IMSDataConsumer.h>
 #include <OpenMS/SYSTEM/File.h>
 
+#include <exception>
+#include <mutex>
+#include <sstream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace OpenMS
 {
   namespace Internal
   {
 
+    /// the CV mapping rules of mzML (only needed for validation), loaded once on first use
+    static const CVMappings& getMzMLMapping_()
+    {
+      static const CVMappings mapping = []()
+      {
+        CVMappings m;
+        CVMappingFile().load(File::find("/MAPPING/ms-mapping.xml"), m);
+        return m;
+      }();
+      return mapping;
+    }
+
+    /**
+      @brief Per-thread pool of the buffers which binary data arrays are decoded into
+
+      Decoding a batch allocates and frees several arrays per spectrum on every OpenMP thread, so the
+      threads contend in the allocator. The decoded values are copied into the spectrum right away, thus
+      the buffers are only lent to a spectrum for decoding and afterwards reused for the next spectrum
+      decoded on the same thread. Only a few buffers of bounded size are kept per thread.
+    */
+    class DecodeBufferPool_
+    {
+public:
+      /// Returns the pool of the calling thread
+      static DecodeBufferPool_& get()
+      {
+        static thread_local DecodeBufferPool_ pool;
+        return pool;
+      }
+
+      /// Gives every array of @p data an (empty) buffer from the pool
+      void lend(std::vector<MzMLHandlerHelper::BinaryData>& data)
+      {
+        for (MzMLHandlerHelper::BinaryData& d : data)
+        {
+          take_(floats_32_, d.floats_32);
+          take_(floats_64_, d.floats_64);
+          take_(ints_32_, d.ints_32);
+          take_(ints_64_, d.ints_64);
+        }
+      }
+
+      /// Returns the buffers of @p data to the pool and releases all other memory of @p data
+      void reclaim(std::vector<MzMLHandlerHelper::BinaryData>& data)
+      {
+        for (MzMLHandlerHelper::BinaryData& d : data)
+        {
+          give_(floats_32_, d.floats_32);
+          give_(floats_64_, d.floats_64);
+          give_(ints_32_, d.ints_32);
+          give_(ints_64_, d.ints_64);
+        }
+        std::vector<MzMLHandlerHelper::BinaryData>().swap(data);
+      }
+
+private:
+      /// at most this many buffers of each type are kept
+      static const Size max_buffers_ = 8;
+      /// larger buffers are freed instead of kept (in bytes)
+      static const Size max_buffer_bytes_ = Size(1) << 26;
+
+      template <typename T>
+      static void take_(std::vector<std::vector<T> >& pool, std::vector<T>& buffer)
+      {
+        if (pool.empty() || buffer.capacity() != 0) return;
+        buffer.swap(pool.back());
+        pool.pop_back();
+      }
+
+      template <typename T>
+      static void give_(std::vector<std::vector<T> >& pool, std::vector<T>& buffer)
+      {
+        if (buffer.capacity() == 0 || pool.size() >= max_buffers_ || buffer.capacity() * sizeof(T) > max_buffer_bytes_) return;
+        buffer.clear(); // the decoders clear() and resize(), so the capacity is reused
+        pool.push_back(std::vector<T>());
+        pool.back().swap(buffer);
+      }
+
+      std::vector<std::vector<float> > floats_32_;
+      std::vector<std::vector<double> > floats_64_;
+      std::vector<std::vector<Int32> > ints_32_;
+      std::vector<std::vector<Int64> > ints_64_;
+    };
+
     /// Constructor for a read-only handler
     MzMLHandler::MzMLHandler(MapType& exp, const String& filename, const String& version, const ProgressLogger& logger)
       : MzMLHandler(filename, version, logger)
@@ -66,16 +159,9 @@ namespace OpenMS
     /// delegated c'tor for the common things
     MzMLHandler::MzMLHandler(const String& filename, const String& version, const ProgressLogger& logger)
       : XMLHandler(filename, version),
-        logger_(logger)
+        logger_(logger),
+        cv_(ControlledVocabulary::getPSIMSCV())
     {
-      cv_.loadFromOBO("MS", File::find("/CV/psi-ms.obo"));
-      cv_.loadFromOBO("PATO", File::find("/CV/quality.obo"));
-      cv_.loadFromOBO("UO", File::find("/CV/unit.obo"));
-      cv_.loadFromOBO("BTO", File::find("/CV/brenda.obo"));
-      cv_.loadFromOBO("GO", File::find("/CV/goslim_goa.obo"));
-
-      CVMappingFile().load(File::find("/MAPPING/ms-mapping.xml"), mapping_);
-
       // check the version number of the mzML handler
       if (VersionInfo::VersionDetails::create(version_) == VersionInfo::VersionDetails::EMPTY)
       {
@@ -144,6 +230,8 @@ namespace OpenMS
       // Whether spectrum should be populated with data
       if (options_.getFillData())
       {
+        OPENMS_PROFILE_SCOPE("MzMLHandler::decodeSpectra");
+        Profiler::addCounter("MzMLHandler::decodedSpectra", spectrum_data_.size());
         size_t errCount = 0;
         String error_message;
 #ifdef _OPENMP
@@ -156,6 +244,9 @@ namespace OpenMS
           {
             try
             {
+              OPENMS_PROFILE_SCOPE("MzMLHandler::decodeSpectrum");
+              DecodeBufferPool_& buffers = DecodeBufferPool_::get();
+              buffers.lend(spectrum_data_[i].data);
               populateSpectraWithData_(spectrum_data_[i].data,
                                        spectrum_data_[i].default_array_length,
                                        options_,
@@ -164,6 +255,9 @@ namespace OpenMS
               {
                 spectrum_data_[i].spectrum.sortByPosition();
               }
+              // keep the decoded buffers for the next spectrum and release the encoded data on the
+              // thread which decoded it, instead of freeing the whole batch serially afterwards
+              buffers.reclaim(spectrum_data_[i].data);
             }
 
             catch (OpenMS::Exception::BaseException& e)
@@ -215,6 +309,8 @@ namespace OpenMS
       // Whether chromatogram should be populated with data
       if (options_.getFillData())
       {
+        OPENMS_PROFILE_SCOPE("MzMLHandler::decodeChromatograms");
+        Profiler::addCounter("MzMLHandler::decodedChromatograms", chromatogram_data_.size());
         size_t errCount = 0;
         String error_message;
 #ifdef _OPENMP
@@ -225,6 +321,9 @@ namespace OpenMS
           // parallel exception catching and re-throwing business
           try
           {
+            OPENMS_PROFILE_SCOPE("MzMLHandler::decodeChromatogram");
+            DecodeBufferPool_& buffers = DecodeBufferPool_::get();
+            buffers.lend(chromatogram_data_[i].data);
             populateChromatogramsWithData_(chromatogram_data_[i].data,
                                            chromatogram_data_[i].default_array_length,
                                            options_,
@@ -233,6 +332,7 @@ namespace OpenMS
             {
               chromatogram_data_[i].chromatogram.sortByPosition();
             }
+            buffers.reclaim(chromatogram_data_[i].data);
           }
           catch (OpenMS::Exception::BaseException& e)
           {
@@ -345,7 +445,7 @@ namespace OpenMS
       if (int_index == -1 || mz_index == -1)
       {
         //if defaultArrayLength > 0 : warn that no m/z or int arrays is present
-        if (default_arr_length != 0)
+        if (default_arr_length != 0 && reportArrayLengthWarning_())
         {
           warning(LOAD, String("The m/z or intensity array of spectrum '") + spectrum.getNativeID() + "' is missing and default_arr_length is " + default_arr_length + ".");
         }
@@ -370,21 +470,21 @@ namespace OpenMS
       {
         fatalError(LOAD, String("The length of m/z and integer values of spectrum '") + spectrum.getNativeID() + "' differ (mz-size: " + mz_size + ", int-size: " + int_size + "! Not reading spectrum!");
       }
-      bool repair_array_length = false;
-      if (default_arr_length != mz_size)
-      {
-        warning(LOAD, String("The m/z array of spectrum '") + spectrum.getNativeID() + "' has the size " + mz_size + ", but it should have size " + default_arr_length + " (defaultArrayLength).");
-        repair_array_length = true;
-      }
-      if (default_arr_length != int_size)
-      {
-        warning(LOAD, String("The intensity array of spectrum '") + spectrum.getNativeID() + "' has the size " + int_size + ", but it should have size " + default_arr_length + " (defaultArrayLength).");
-        repair_array_length = true;
-      }
-      if (repair_array_length)
+      if (default_arr_length != mz_size || default_arr_length != int_size)
       {
+        if (reportArrayLengthWarning_())
+        {
+          if (default_arr_length != mz_size)
+          {
+            warning(LOAD, String("The m/z array of spectrum '") + spectrum.getNativeID() + "' has the size " + mz_size + ", but it should have size " + default_arr_length + " (defaultArrayLength).");
+          }
+          if (default_arr_length != int_size)
+          {
+            warning(LOAD, String("The intensity array of spectrum '") + spectrum.getNativeID() + "' has the size " + int_size + ", but it should have size " + default_arr_length + " (defaultArrayLength).");
+          }
+          warning(LOAD, String("Fixing faulty defaultArrayLength to ") + int_size + ".");
+        }
         default_arr_length = int_size;
-        warning(LOAD, String("Fixing faulty defaultArrayLength to ") + default_arr_length + ".");
       }
 
       //create meta data arrays and reserve enough space for the content
@@ -492,6 +592,17 @@ namespace OpenMS
       }
     }
 
+    bool MzMLHandler::reportArrayLengthWarning_()
+    {
+      const Size max_warnings = 10;
+      const Size count = array_length_warnings_.fetch_add(1, std::memory_order_relaxed);
+      if (count == max_warnings)
+      {
+        warning(LOAD, String("Found more than ") + max_warnings + " spectra or chromatograms with faulty array lengths, further ones are not reported.");
+      }
+      return count < max_warnings;
+    }
+
     void MzMLHandler::populateChromatogramsWithData_(std::vector<MzMLHandlerHelper::BinaryData>& input_data,
                                                      Size& default_arr_length,
                                                      const PeakFileOptions& peak_file_options,
@@ -514,7 +625,7 @@ namespace OpenMS
       if (int_index == -1 || rt_index == -1)
       {
         //if defaultArrayLength > 0 : warn that no time or int arrays is present
-        if (default_arr_length != 0)
+        if (default_arr_length != 0 && reportArrayLengthWarning_())
         {
           warning(LOAD, String("The time or intensity array of chromatogram '") +
               inp_chromatogram.getNativeID() + "' is missing and default_arr_length is " + default_arr_length + ".");
@@ -530,22 +641,22 @@ namespace OpenMS
       {
         fatalError(LOAD, String("The length of RT and intensity values of chromatogram '") + inp_chromatogram.getNativeID() + "' differ (rt-size: " + rt_size + ", int-size: " + int_size + "! Not reading chromatogram!");
       }
-      bool repair_array_length = false;
-      if (default_arr_length != rt_size)
-      {
-        warning(LOAD, String("The base64-decoded rt array of chromatogram '") + inp_chromatogram.getNativeID() + "' has the size " + rt_size + ", but it should have size " + default_arr_length + " (defaultArrayLength).");
-        repair_array_length = true;
-      }
-      if (default_arr_length != int_size)
-      {
-        warning(LOAD, String("The base64-decoded intensity array of chromatogram '") + inp_chromatogram.getNativeID() + "' has the size " + int_size + ", but it should have size " + default_arr_length + " (defaultArrayLength).");
-        repair_array_length = true;
-      }
       // repair size of array, accessing memory that is beyond int_size will lead to segfaults later
-      if (repair_array_length)
+      if (default_arr_length != rt_size || default_arr_length != int_size)
       {
+        if (reportArrayLengthWarning_())
+        {
+          if (default_arr_length != rt_size)
+          {
+            warning(LOAD, String("The base64-decoded rt array of chromatogram '") + inp_chromatogram.getNativeID() + "' has the size " + rt_size + ", but it should have size " + default_arr_length + " (defaultArrayLength).");
+          }
+          if (default_arr_length != int_size)
+          {
+            warning(LOAD, String("The base64-decoded intensity array of chromatogram '") + inp_chromatogram.getNativeID() + "' has the size " + int_size + ", but it should have size " + default_arr_length + " (defaultArrayLength).");
+          }
+          warning(LOAD, String("Fixing faulty defaultArrayLength to ") + int_size + ".");
+        }
         default_arr_length = int_size; // set to length of actual data (int_size and rt_size are equal, s.a.)
-        warning(LOAD, String("Fixing faulty defaultArrayLength to ") + default_arr_length + ".");
       }
 
       // Create meta data arrays and reserve enough space for the content
@@ -669,6 +780,8 @@ namespace OpenMS
 
       if (current_tag == "binary")
       {
+        // the payload would be dropped undecoded in endElement(), so do not even copy it
+        if (!options_.getFillData()) return;
         // Since we convert a Base64 string here, it can only contain plain ASCII
         sm_.appendASCII(chars, length, bin_data_.back().base64);
       }
@@ -854,7 +967,26 @@ namespace OpenMS
       }
       else if (tag == "binaryDataArrayList" /* && in_spectrum_list_*/)
       {
-        bin_data_.reserve(attributeAsInt_(attributes, s_count));
+        // The spectrum header is complete here (the binary data arrays come last). If the RT is only given as
+        // elution time, apply the RT filter now, such that filtered spectra are skipped before their payload is read.
+        if (in_spectrum_list_ && !rt_set_ && spec_.metaValueExists("elution time (seconds)"))
+        {
+          spec_.setRT(spec_.getMetaValue("elution time (seconds)"));
+          rt_set_ = true;
+          if (options_.hasRTRange() && !options_.getRTRange().encloses(DPosition<1>(spec_.getRT())))
+          {
+            skip_spectrum_ = true;
+          }
+          else if (load_detail_ == XMLHandler::LD_COUNTS_WITHOPTIONS)
+          { // RT is ok, but we only want to count
+            skip_spectrum_ = true;
+            ++scan_count_;
+          }
+        }
+        if (!skip_spectrum_)
+        {
+          bin_data_.reserve(attributeAsInt_(attributes, s_count));
+        }
       }
       else if (tag == "binaryDataArray" /* && in_spectrum_list_*/)
       {
@@ -3377,15 +3509,23 @@ namespace OpenMS
 
     bool MzMLHandler::validateCV_(const ControlledVocabulary::CVTerm& c, const String& path, const Internal::MzMLValidator& validator) const
     {
-      // We remember already validated path-term-combinations in cached_terms_
+      // We remember already validated path-term-combinations in cached_terms
       // This avoids recomputing SemanticValidator::locateTerm() multiple times for the same terms and paths
       // validateCV_() is called very often for the same path-term-combinations, so we save lots of repetitive computations
       // By caching these combinations we save about 99% of the runtime of validateCV_()
 
-      const auto it = cached_terms_.find(std::make_pair(path, c.id));
-      if (it != cached_terms_.end())
+      // The cache is shared by all handlers of the process, as they all validate against the same mapping rules and CV
+      // (see getMzMLMapping_() and ControlledVocabulary::getPSIMSCV()). It is used by all threads writing spectra in
+      // parallel (see writeSpectra_()) and by handlers running in different (not necessarily OpenMP) threads.
+      static Map<std::pair<String, String>, bool> cached_terms;
+      static std::mutex cached_terms_mutex;
       {
-        return it->second;
+        std::lock_guard<std::mutex> lock(cached_terms_mutex);
+        const auto it = cached_terms.find(std::make_pair(path, c.id));
+        if (it != cached_terms.end())
+        {
+          return it->second;
+        }
       }
 
       SemanticValidator::CVTerm sc;
@@ -3395,7 +3535,8 @@ namespace OpenMS
       sc.has_unit_name = false;
 
       bool isValid = validator.SemanticValidator::locateTerm(path, sc);
-      cached_terms_[std::make_pair(path, c.id)] = isValid;
+      std::lock_guard<std::mutex> lock(cached_terms_mutex);
+      cached_terms[std::make_pair(path, c.id)] = isValid;
       return isValid;
     }
 
@@ -3946,7 +4087,7 @@ namespace OpenMS
       const MapType& exp = *(cexp_);
       logger_.startProgress(0, exp.size() + exp.getChromatograms().size(), "storing mzML file");
       int progress = 0;
-      Internal::MzMLValidator validator(mapping_, cv_);
+      Internal::MzMLValidator validator(getMzMLMapping_(), cv_);
 
       std::vector<std::vector< ConstDataProcessingPtr > > dps;
       //--------------------------------------------------------------------------------------------
@@ -3982,12 +4123,19 @@ namespace OpenMS
           warning(STORE, String("Invalid native IDs detected. Using spectrum identifier nativeID format (spectrum=xsd:nonNegativeInteger) for all spectra."));
         }
 
-        // write actual data
-        for (Size s_idx = 0; s_idx < exp.size(); ++s_idx)
+        // write actual data (encoded in parallel batches)
+        const Size batch_size = writeBatchSize_();
+        std::vector<const SpectrumType*> batch;
+        for (Size s_idx = 0; s_idx < exp.size(); s_idx += batch_size)
         {
-          logger_.setProgress(progress++);
-          const SpectrumType& spec = exp[s_idx];
-          writeSpectrum_(os, spec, s_idx, validator, renew_native_ids, dps);
+          logger_.setProgress(progress);
+          batch.clear();
+          for (Size i = s_idx; i < std::min(s_idx + batch_size, exp.size()); ++i)
+          {
+            batch.push_back(&exp[i]);
+          }
+          writeSpectra_(os, batch, s_idx, validator, renew_native_ids, dps);
+          progress += batch.size();
         }
         os << "\t\t</spectrumList>\n";
       }
@@ -4002,11 +4150,18 @@ namespace OpenMS
         // meta information needs to be stored here but the actual data is
         // stored somewhere else).
         os << "\t\t<chromatogramList count=\"" << exp.getChromatograms().size() << "\" defaultDataProcessingRef=\"dp_sp_0\">\n";
-        for (Size c_idx = 0; c_idx != exp.getChromatograms().size(); ++c_idx)
+        const Size batch_size = writeBatchSize_();
+        std::vector<const ChromatogramType*> batch;
+        for (Size c_idx = 0; c_idx < exp.getChromatograms().size(); c_idx += batch_size)
         {
-          logger_.setProgress(progress++);
-          const ChromatogramType& chromatogram = exp.getChromatograms()[c_idx];
-          writeChromatogram_(os, chromatogram, c_idx, validator);
+          logger_.setProgress(progress);
+          batch.clear();
+          for (Size i = c_idx; i < std::min(c_idx + batch_size, exp.getChromatograms().size()); ++i)
+          {
+            batch.push_back(&exp.getChromatograms()[i]);
+          }
+          writeChromatograms_(os, batch, c_idx, validator);
+          progress += batch.size();
         }
         os << "\t\t</chromatogramList>" << "\n";
       }
@@ -4948,6 +5103,107 @@ namespace OpenMS
 
     }
 
+    namespace
+    {
+      /**
+        @brief Generates the XML of @p count elements in parallel and appends it to @p os in order
+
+        @p write_element(stream, i) writes element i; each thread writes into its own memory buffer.
+        @p record_offset(i, offset) is called (in order) with the position of element i in @p os.
+      */
+      template <typename WriteFunc, typename OffsetFunc>
+      void writeInParallel(std::ostream& os, Size count, const WriteFunc& write_element, const OffsetFunc& record_offset)
+      {
+        if (count == 1)
+        {
+          record_offset(0, Int64(os.tellp()));
+          write_element(os, 0);
+          return;
+        }
+
+        std::vector<std::string> buffers(count);
+        std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (SignedSize i = 0; i < (SignedSize)count; ++i)
+        {
+          try
+          {
+            std::ostringstream buffer;
+            buffer.copyfmt(os); // same precision etc. as a direct write
+            write_element(buffer, Size(i));
+            buffers[i] = buffer.str();
+          }
+          catch (...)
+          {
+#ifdef _OPENMP
+#pragma omp critical (MzMLHandler_writeInParallel)
+#endif
+            if (!error) error = std::current_exception();
+          }
+        }
+        if (error) std::rethrow_exception(error);
+
+        for (Size i = 0; i < count; ++i)
+        {
+          record_offset(i, Int64(os.tellp()));
+          os.write(buffers[i].data(), buffers[i].size());
+          std::string().swap(buffers[i]); // release memory early
+        }
+      }
+    }
+
+    Size MzMLHandler::writeBatchSize_()
+    {
+#ifdef _OPENMP
+      const int threads = omp_get_max_threads();
+      if (threads > 1)
+      {
+        // enough work for each thread while bounding the memory used by buffered XML
+        return Size(threads) * 16;
+      }
+#endif
+      return 1;
+    }
+
+    void MzMLHandler::writeSpectra_(std::ostream& os,
+                                    const std::vector<const SpectrumType*>& spectra,
+                                    Size first_idx,
+                                    const Internal::MzMLValidator& validator,
+                                    bool renew_native_ids,
+                                    std::vector<std::vector< ConstDataProcessingPtr > >& dps)
+    {
+      OPENMS_PROFILE_SCOPE("MzMLHandler::writeSpectra");
+      writeInParallel(os, spectra.size(),
+        [&](std::ostream& out, Size i)
+        {
+          writeSpectrum_(out, *spectra[i], first_idx + i, validator, renew_native_ids, dps);
+        },
+        [&](Size i, Int64 offset)
+        {
+          const String native_id = renew_native_ids ? String("spectrum=") + (first_idx + i) : spectra[i]->getNativeID();
+          spectra_offsets_.push_back(make_pair(native_id, offset + 3)); // skip the three tabs before <spectrum
+        });
+    }
+
+    void MzMLHandler::writeChromatograms_(std::ostream& os,
+                                          const std::vector<const ChromatogramType*>& chromatograms,
+                                          Size first_idx,
+                                          const Internal::MzMLValidator& validator)
+    {
+      OPENMS_PROFILE_SCOPE("MzMLHandler::writeChromatograms");
+      writeInParallel(os, chromatograms.size(),
+        [&](std::ostream& out, Size i)
+        {
+          writeChromatogram_(out, *chromatograms[i], first_idx + i, validator);
+        },
+        [&](Size i, Int64 offset)
+        {
+          chromatograms_offsets_.push_back(make_pair(chromatograms[i]->getNativeID(), offset + 3)); // skip the three tabs before <chromatogram
+        });
+    }
+
     void MzMLHandler::writeSpectrum_(std::ostream& os,
                                      const SpectrumType& spec,
                                      Size s,
@@ -4962,10 +5218,7 @@ namespace OpenMS
         native_id = String("spectrum=") + s;
       }
 
-      Int64 offset = os.tellp();
-      spectra_offsets_.push_back(make_pair(native_id, offset + 3));
-
-      // IMPORTANT make sure the offset (above) corresponds to the start of the <spectrum tag
+      // IMPORTANT the offset recorded by writeSpectra_() is the start of the <spectrum tag, i.e. after the three tabs
       os << "\t\t\t<spectrum id=\"" << writeXMLEscape(native_id) << "\" index=\"" << s << "\" defaultArrayLength=\"" << spec.size() << "\"";
       if (spec.getSourceFile() != SourceFile())
       {
@@ -5530,11 +5783,8 @@ namespace OpenMS
                                          Size c,
                                          const Internal::MzMLValidator& validator)
     {
-      Int64 offset = os.tellp();
-      chromatograms_offsets_.push_back(make_pair(chromatogram.getNativeID(), offset + 3));
-
       // TODO native id with chromatogram=?? prefix?
-      // IMPORTANT make sure the offset (above) corresponds to the start of the <chromatogram tag
+      // IMPORTANT the offset recorded by writeChromatograms_() is the start of the <chromatogram tag, i.e. after the three tabs
       os << "\t\t\t<chromatogram id=\"" << writeXMLEscape(chromatogram.getNativeID()) << "\" index=\"" << c << "\" defaultArrayLength=\"" << chromatogram.size() << "\">" << "\n";
 
       // write cvParams (chromatogram type)
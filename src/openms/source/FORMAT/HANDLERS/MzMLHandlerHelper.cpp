@@ -213,6 +213,8 @@ namespace OpenMS
         }
         else if (bindata.precision == BinaryData::PRE_64)
         {
+          // the expected length allows zlib to inflate directly into the final buffer
+          if (bindata.compression) bindata.floats_64.reserve(bindata.size);
           Base64::decode(bindata.base64, Base64::BYTEORDER_LITTLEENDIAN, bindata.floats_64, bindata.compression);
           if (bindata.size != bindata.floats_64.size())
           {
@@ -223,6 +225,7 @@ namespace OpenMS
         }
         else if (bindata.precision == BinaryData::PRE_32)
         {
+          if (bindata.compression) bindata.floats_32.reserve(bindata.size);
           Base64::decode(bindata.base64, Base64::BYTEORDER_LITTLEENDIAN, bindata.floats_32, bindata.compression);
           if (bindata.size != bindata.floats_32.size())
           {
@@ -247,6 +250,7 @@ namespace OpenMS
       {
         if (bindata.precision == BinaryData::PRE_64)
         {
+          if (bindata.compression) bindata.ints_64.reserve(bindata.size);
           Base64::decodeIntegers(bindata.base64, Base64::BYTEORDER_LITTLEENDIAN, bindata.ints_64, bindata.compression);
           if (bindata.size != bindata.ints_64.size())
           {
@@ -257,6 +261,7 @@ namespace OpenMS
         }
         else if (bindata.precision == BinaryData::PRE_32)
         {
+          if (bindata.compression) bindata.ints_32.reserve(bindata.size);
           Base64::decodeIntegers(bindata.base64, Base64::BYTEORDER_LITTLEENDIAN, bindata.ints_32, bindata.compression);
           if (bindata.size != bindata.ints_32.size())
           {
@@ -83,6 +83,51 @@ namespace OpenMS
       return tmp;
     }
 
+    /*
+     * @brief Raw data array as read from the DATA table (before decoding)
+     *
+     */
+    struct RawDataArray_
+    {
+      Size container_idx;
+      int compression;
+      int data_type;
+      std::string blob;
+      std::vector<double> data;
+    };
+
+    /*
+     * @brief Decode a single binary data array
+     *
+     * compression is one of 0 = no, 1 = zlib, 2 = np-linear, 3 = np-slof, 4 =
+     * np-pic, 5 = np-linear + zlib, 6 = np-slof + zlib, 7 = np-pic + zlib
+     *
+     */
+    void decodeRawDataArray_(const std::string& blob, int compression, std::vector<double>& data)
+    {
+      std::string uncompressed;
+      OpenMS::ZlibCompression::uncompressString(blob.data(), blob.size(), uncompressed);
+      if (compression == 1)
+      {
+        void* byte_buffer = reinterpret_cast<void *>(&uncompressed[0]);
+        Size buffer_size = uncompressed.size();
+        const double* float_buffer = reinterpret_cast<const double *>(byte_buffer);
+        if (buffer_size % sizeof(double) != 0)
+        {
+          throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Bad BufferCount?");
+        }
+        Size float_count = buffer_size / sizeof(double);
+        // copy values
+        data.assign(float_buffer, float_buffer + float_count);
+      }
+      else
+      {
+        MSNumpressCoder::NumpressConfig config;
+        config.setCompression(compression == 5 ? "linear" : "slof");
+        MSNumpressCoder().decodeNPRaw(uncompressed, data, config);
+      }
+    }
+
     /*
      *
      * This function populates a set of empty data containers (MSSpectrum or
@@ -99,6 +144,10 @@ namespace OpenMS
      * It is designed to work with containers of type MSSpectrum and
      * MSChromatogram to provide a single function for both use-cases.
      *
+     * Reading from SQLite is sequential, but the (expensive) decompression and
+     * decoding of the binary data is performed in parallel once all rows have
+     * been read.
+     *
      */
     template<class ContainerT>
     void populateContainer_sub_(sqlite3_stmt *stmt, std::vector<ContainerT>& containers)
@@ -106,7 +155,7 @@ namespace OpenMS
       // perform first step
       sqlite3_step(stmt);
 
-      std::vector<int> cont_data; cont_data.resize(containers.size());
+      std::vector<RawDataArray_> raw_arrays;
       std::map<Size,Size> sql_container_map;
       while (sqlite3_column_type( stmt, 0 ) != SQLITE_NULL)
       {
@@ -134,104 +183,95 @@ namespace OpenMS
               String("Native id for spectrum / chromatogram doesnt match: ") + native_id + " != " +  containers[curr_id].getNativeID() );
         }
 
-        int compression = sqlite3_column_int( stmt, 2 );
-        int data_type = sqlite3_column_int( stmt, 3 );
+        RawDataArray_ raw;
+        raw.container_idx = curr_id;
+        raw.compression = sqlite3_column_int( stmt, 2 );
+        raw.data_type = sqlite3_column_int( stmt, 3 );
 
-        const void * raw_text = sqlite3_column_blob(stmt, 4);
-        size_t blob_bytes = sqlite3_column_bytes(stmt, 4);
-
-        // data_type is one of 0 = mz, 1 = int, 2 = rt
-        // compression is one of 0 = no, 1 = zlib, 2 = np-linear, 3 = np-slof, 4 = np-pic, 5 = np-linear + zlib, 6 = np-slof + zlib, 7 = np-pic + zlib
-        std::vector<double> data;
-        if (compression == 1)
+        if (raw.compression != 1 && raw.compression != 5 && raw.compression != 6)
         {
-          std::string uncompressed;
-          OpenMS::ZlibCompression::uncompressString(raw_text, blob_bytes, uncompressed);
-
-          void* byte_buffer = reinterpret_cast<void *>(&uncompressed[0]);
-          Size buffer_size = uncompressed.size();
-          const double* float_buffer = reinterpret_cast<const double *>(byte_buffer);
-          if (buffer_size % sizeof(double) != 0)
-          {
-            throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Bad BufferCount?");
-          }
-          Size float_count = buffer_size / sizeof(double);
-          // copy values
-          data.assign(float_buffer, float_buffer + float_count);
+          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
+              "Compression not supported");
         }
-        else if (compression == 5)
+
+        // data_type is one of 0 = mz, 1 = int, 2 = rt
+        if (raw.data_type == 0 && boost::is_same<ContainerT, MSChromatogram>::value) 
         {
-          std::string uncompressed;
-          OpenMS::ZlibCompression::uncompressString(raw_text, blob_bytes, uncompressed);
-          MSNumpressCoder::NumpressConfig config;
-          config.setCompression("linear");
-          MSNumpressCoder().decodeNPRaw(uncompressed, data, config);
+          // mz (should only occur in spectra)
+          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
+              "Found m/z data type for chromatogram (instead of retention time)");
         }
-        else if (compression == 6)
+        else if (raw.data_type == 2 && boost::is_same<ContainerT, MSSpectrum >::value) 
         {
-          std::string uncompressed;
-          OpenMS::ZlibCompression::uncompressString(raw_text, blob_bytes, uncompressed);
-          MSNumpressCoder::NumpressConfig config;
-          config.setCompression("slof");
-          MSNumpressCoder().decodeNPRaw(uncompressed, data, config);
+          // rt (should only occur in chromatograms)
+          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
+              "Found retention time data type for spectrum (instead of m/z)");
         }
-        else
+        else if (raw.data_type < 0 || raw.data_type > 2)
         {
           throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
-              "Compression not supported");
+              "Found data type other than RT/Intensity for spectra");
         }
 
-        if (data_type == 1)
+        // the blob is only valid until the next step, keep a copy for decoding
+        const char * raw_text = reinterpret_cast<const char*>(sqlite3_column_blob(stmt, 4));
+        size_t blob_bytes = sqlite3_column_bytes(stmt, 4);
+        raw.blob.assign(raw_text, blob_bytes);
+        raw_arrays.push_back(std::move(raw));
+
+        sqlite3_step( stmt );
+      }
+
+      // decode all data arrays (exceptions must not leave the parallel region)
+      String decode_error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (raw_arrays.size() > 2)
+#endif
+      for (SignedSize k = 0; k < (SignedSize)raw_arrays.size(); k++)
+      {
+        try
         {
-          // intensity
-          if (containers[curr_id].empty()) containers[curr_id].resize(data.size());
-          std::vector< double >::iterator data_it = data.begin();
-          for (auto it = containers[curr_id].begin(); it != containers[curr_id].end(); ++it, ++data_it)
-          {
-            it->setIntensity(*data_it);
-          }
-          cont_data[curr_id] += 1;
+          decodeRawDataArray_(raw_arrays[k].blob, raw_arrays[k].compression, raw_arrays[k].data);
         }
-        else if (data_type == 0)
+        catch (Exception::BaseException& e)
         {
-          // mz (should only occur in spectra)
-          if (boost::is_same<ContainerT, MSChromatogram>::value) 
-          {
-            throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
-                "Found m/z data type for chromatogram (instead of retention time)");
-          }
+#ifdef _OPENMP
+#pragma omp critical (populateContainer_sub_error)
+#endif
+          if (decode_error.empty()) decode_error = e.what();
+        }
+        std::string().swap(raw_arrays[k].blob);
+      }
+      if (!decode_error.empty())
+      {
+        throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, decode_error);
+      }
 
-          if (containers[curr_id].empty()) containers[curr_id].resize(data.size());
-          std::vector< double >::iterator data_it = data.begin();
-          for (auto it = containers[curr_id].begin(); it != containers[curr_id].end(); ++it, ++data_it)
+      // assign the data in the order in which it was read from the database
+      std::vector<int> cont_data; cont_data.resize(containers.size());
+      for (RawDataArray_& raw : raw_arrays)
+      {
+        ContainerT& container = containers[raw.container_idx];
+        if (container.empty()) container.resize(raw.data.size());
+        std::vector< double >::const_iterator data_it = raw.data.begin();
+        if (raw.data_type == 1)
+        {
+          // intensity
+          for (auto it = container.begin(); it != container.end(); ++it, ++data_it)
           {
-            it->setMZ(*data_it);
+            it->setIntensity(*data_it);
           }
-          cont_data[curr_id] += 1;
         }
-        else if (data_type == 2)
+        else
         {
-          // rt (should only occur in chromatograms)
-          if (boost::is_same<ContainerT, MSSpectrum >::value) 
-          {
-            throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
-                "Found retention time data type for spectrum (instead of m/z)");
-          }
-          if (containers[curr_id].empty()) containers[curr_id].resize(data.size());
-          std::vector< double >::iterator data_it = data.begin();
-          for (auto it = containers[curr_id].begin(); it != containers[curr_id].end(); ++it, ++data_it)
+          // mz (spectra) or rt (chromatograms)
+          for (auto it = container.begin(); it != container.end(); ++it, ++data_it)
           {
             it->setMZ(*data_it);
           }
-          cont_data[curr_id] += 1;
-        }
-        else
-        {
-          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
-              "Found data type other than RT/Intensity for spectra");
         }
-
-        sqlite3_step( stmt );
+        std::vector<double>().swap(raw.data);
+        cont_data[raw.container_idx] += 1;
       }
 
       // ensure that all spectra/chromatograms have their data: we expect two data arrays per container (int and mz/rt)
@@ -980,6 +1020,9 @@ namespace OpenMS
         }
       }
 
+      // all inserts of the batch (including the binary data) are committed in a single transaction
+      conn.executeStatement("BEGIN TRANSACTION");
+
       int nr_precursors = 0;
       int nr_products = 0;
       for (Size k = 0; k < spectra.size(); k++)
@@ -1057,7 +1100,7 @@ namespace OpenMS
 
         // encode mz data (zlib or np-linear + zlib)
         {
-          data.push_back(encoded_strings_mz[k]);
+          data.push_back(std::move(encoded_strings_mz[k]));
           if (use_lossy_compression_)
           {
             prepare_statement += String("(") + spec_id_ + ", 0, 5, ?" + sql_it++ + " ),";
@@ -1070,7 +1113,7 @@ namespace OpenMS
 
         // encode intensity data (zlib or np-slof + zlib)
         {
-          data.push_back(encoded_strings_int[k]);
+          data.push_back(std::move(encoded_strings_int[k]));
           if (use_lossy_compression_)
           {
             prepare_statement += String("(") + spec_id_ + ", 1, 6, ?" + sql_it++ + " ),";
@@ -1105,7 +1148,6 @@ namespace OpenMS
         conn.executeBindStatement(prepare_statement, data);
       }
 
-      conn.executeStatement("BEGIN TRANSACTION");
       conn.executeStatement(insert_spectra_sql);
       if (nr_precursors > 0) conn.executeStatement(insert_precursor_sql);
       if (nr_products > 0) conn.executeStatement(insert_product_sql);
@@ -1202,6 +1244,9 @@ namespace OpenMS
         }
       }
 
+      // all inserts of the batch (including the binary data) are committed in a single transaction
+      conn.executeStatement("BEGIN TRANSACTION");
+
       std::vector<String> data;
       for (Size k = 0; k < chroms.size(); k++)
       {
@@ -1250,7 +1295,7 @@ namespace OpenMS
 
         // encode retention time data (zlib or np-linear + zlib)
         {
-          data.push_back(encoded_strings_rt[k]);
+          data.push_back(std::move(encoded_strings_rt[k]));
           if (use_lossy_compression_)
           {
             prepare_statement += String("(") + chrom_id_ + ", 2, 5, ?" + sql_it++ + " ),";
@@ -1263,7 +1308,7 @@ namespace OpenMS
 
         // encode intensity data (zlib or np-slof + zlib)
         {
-          data.push_back(encoded_strings_int[k]);
+          data.push_back(std::move(encoded_strings_int[k]));
           if (use_lossy_compression_)
           {
             prepare_statement += String("(") + chrom_id_ + ", 1, 6, ?" + sql_it++ + " ),";
@@ -1298,7 +1343,6 @@ namespace OpenMS
         conn.executeBindStatement(prepare_statement, data);
       }
 
-      conn.executeStatement("BEGIN TRANSACTION");
       conn.executeStatement(insert_chrom_sql);
       conn.executeStatement(insert_precursor_sql);
       conn.executeStatement(insert_product_sql);
@@ -38,7 +38,9 @@
 #include <OpenMS/INTERFACES/IMSDataConsumer.h>
 #include <OpenMS/FORMAT/Base64.h>
 
+#include <algorithm>
 #include <atomic>
+#include <cctype>
 #include <stack>
 
 namespace OpenMS
@@ -224,6 +226,12 @@ namespace OpenMS
         {
           error(LOAD, String("Invalid compression type ") + spectrum_data_.back().compressionType_ + "in elements 'peaks'. Must be 'none' or 'zlib'! ");
         }
+        // the base64 text arrives in many chunks => allocate the (uncompressed) size in one go
+        if (options_.getFillData() && !skip_spectrum_ && spectrum_data_.back().compressionType_ == "none")
+        {
+          Size bytes = 2 * Size(spectrum_data_.back().peak_count_) * (spectrum_data_.back().precision_ == "64" ? 8 : 4);
+          spectrum_data_.back().char_rest_.reserve((bytes + 2) / 3 * 4);
+        }
       }
       else if (tag == "precursorMz")
       {
@@ -1152,7 +1160,7 @@ namespace OpenMS
       }
     }
 
-    void MzXMLHandler::doPopulateSpectraWithData_(SpectrumData & spectrum_data)
+    void MzXMLHandler::doPopulateSpectraWithData_(SpectrumData & spectrum_data) const
     {
       typedef SpectrumType::PeakType PeakType;
 
@@ -1219,6 +1227,82 @@ namespace OpenMS
       }
     }
 
+    void MzXMLHandler::decodeScanPeaks(const String& scan_xml, SpectrumType& spectrum) const
+    {
+      Size scan_tag_end = scan_xml.find('>');
+      if (!scan_xml.hasPrefix("<scan") || scan_tag_end == String::npos)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, scan_xml.prefix(std::min(scan_xml.size(), Size(20))), "Index offset does not point to a 'scan' element in file '" + file_ + "'");
+      }
+      const String scan_tag = scan_xml.prefix(scan_tag_end);
+      if (spectrum.getNativeID().hasPrefix("scan=") && tagAttribute_(scan_tag, "num", "") != spectrum.getNativeID().substr(5))
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, scan_tag, "Index offset of '" + spectrum.getNativeID() + "' points to a different scan in file '" + file_ + "'");
+      }
+
+      SpectrumData spectrum_data;
+      spectrum_data.peak_count_ = tagAttribute_(scan_tag, "peaksCount", "0").toInt();
+
+      // the peaks of this scan precede any nested scans
+      Size peaks_begin = scan_xml.find("<peaks", scan_tag_end);
+      Size peaks_tag_end = (peaks_begin == String::npos) ? String::npos : scan_xml.find('>', peaks_begin);
+      if (peaks_tag_end == String::npos)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, scan_tag, "No 'peaks' element found in scan of file '" + file_ + "'");
+      }
+      const String peaks_tag = scan_xml.substr(peaks_begin, peaks_tag_end - peaks_begin);
+      spectrum_data.precision_ = tagAttribute_(peaks_tag, "precision", "32");
+      spectrum_data.compressionType_ = tagAttribute_(peaks_tag, "compressionType", "none");
+      if ((spectrum_data.precision_ != "32" && spectrum_data.precision_ != "64") ||
+          (spectrum_data.compressionType_ != "none" && spectrum_data.compressionType_ != "zlib"))
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, peaks_tag, "Invalid precision or compression type in file '" + file_ + "'");
+      }
+      if (scan_xml[peaks_tag_end - 1] != '/') // not an empty element
+      {
+        Size peaks_end = scan_xml.find("</peaks>", peaks_tag_end);
+        if (peaks_end == String::npos)
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, peaks_tag, "Unterminated 'peaks' element in file '" + file_ + "'");
+        }
+        spectrum_data.char_rest_ = scan_xml.substr(peaks_tag_end + 1, peaks_end - peaks_tag_end - 1);
+      }
+
+      std::swap(spectrum_data.spectrum, spectrum);
+      try
+      {
+        doPopulateSpectraWithData_(spectrum_data);
+      }
+      catch (...)
+      {
+        std::swap(spectrum_data.spectrum, spectrum);
+        throw;
+      }
+      std::swap(spectrum_data.spectrum, spectrum);
+      if (options_.getSortSpectraByMZ() && !spectrum.isSorted())
+      {
+        spectrum.sortByPosition();
+      }
+    }
+
+    String MzXMLHandler::tagAttribute_(const String& tag, const String& name, const String& default_value)
+    {
+      // attributes are separated by whitespace; the writer puts blanks around '=' as well
+      for (Size pos = tag.find(name); pos != String::npos; pos = tag.find(name, pos + 1))
+      {
+        if (pos == 0 || !isspace((unsigned char)tag[pos - 1])) continue;
+        Size eq = pos + name.size();
+        while (eq < tag.size() && isspace((unsigned char)tag[eq])) ++eq;
+        if (eq >= tag.size() || tag[eq] != '=') continue;
+        Size quote = tag.find_first_of("\"'", eq);
+        if (quote == String::npos) break;
+        Size quote_end = tag.find(tag[quote], quote + 1);
+        if (quote_end == String::npos) break;
+        return tag.substr(quote + 1, quote_end - quote - 1);
+      }
+      return default_value;
+    }
+
     void MzXMLHandler::populateSpectraWithData_()
     {
 
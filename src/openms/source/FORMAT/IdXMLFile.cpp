@@ -33,6 +33,7 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/FORMAT/IdXMLFile.h>
+#include <OpenMS/FORMAT/BufferedOfstream.h>
 
 #include <OpenMS/CONCEPT/Constants.h>
 #include <OpenMS/CONCEPT/LogStream.h>
@@ -43,6 +44,7 @@
 #include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/SYSTEM/File.h>
 
+#include <algorithm>
 #include <fstream>
 #include <unordered_map>
 
@@ -56,7 +58,9 @@ namespace OpenMS
     XMLFile("/SCHEMAS/IdXML_1_5.xsd", "1.5"),
     last_meta_(nullptr),
     document_id_(),
-    prot_id_in_run_(false)
+    prot_id_in_run_(false),
+    consumer_(nullptr),
+    batch_size_(0)
   {
   }
 
@@ -82,7 +86,41 @@ namespace OpenMS
 
     parse_(filename, this);
 
-    //reset members
+    resetMembers_();
+
+    endProgress();
+  }
+
+  void IdXMLFile::transform(const String& filename, Interfaces::IIdentificationConsumer* consumer, Size batch_size)
+  {
+    startProgress(0, 0, "Streaming idXML");
+    //Filename for error messages in XMLHandler
+    file_ = filename;
+
+    // protein identifications are only kept as stubs (identifier) after they were consumed;
+    // peptide identifications are collected until a batch is full
+    std::vector<ProteinIdentification> protein_ids;
+    std::vector<PeptideIdentification> peptide_ids;
+    peptide_ids.reserve(batch_size);
+    String document_id;
+
+    prot_ids_ = &protein_ids;
+    pep_ids_ = &peptide_ids;
+    document_id_ = &document_id;
+    consumer_ = consumer;
+    batch_size_ = std::max(batch_size, Size(1));
+
+    parse_(filename, this);
+    flushPeptideIdentifications_();
+
+    consumer_ = nullptr;
+    resetMembers_();
+
+    endProgress();
+  }
+
+  void IdXMLFile::resetMembers_()
+  {
     prot_ids_ = nullptr;
     pep_ids_ = nullptr;
     last_meta_ = nullptr;
@@ -94,8 +132,25 @@ namespace OpenMS
     prot_hit_ = ProteinHit();
     pep_hit_ = PeptideHit();
     proteinid_to_accession_.clear();
+  }
 
-    endProgress();
+  void IdXMLFile::consumeProteinIdentification_()
+  {
+    if (consumer_ == nullptr) return;
+    // peptide identifications of the previous run go first
+    flushPeptideIdentifications_();
+    // subsequent peptide identifications only need the identifier
+    ProteinIdentification stub;
+    stub.setIdentifier(prot_ids_->back().getIdentifier());
+    consumer_->consumeProteinIdentification(prot_ids_->back());
+    prot_ids_->back() = std::move(stub);
+  }
+
+  void IdXMLFile::flushPeptideIdentifications_()
+  {
+    if ((consumer_ == nullptr) || pep_ids_->empty()) return;
+    consumer_->consumePeptideIdentifications(*pep_ids_);
+    pep_ids_->clear();
   }
 
   void IdXMLFile::store(const String& filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids, const String& document_id)
@@ -114,7 +169,7 @@ namespace OpenMS
     file_ = filename;
 
     //open stream
-    std::ofstream os(filename.c_str());
+    BufferedOfstream os(filename);
     if (!os)
     {
       throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
@@ -122,6 +177,90 @@ namespace OpenMS
 
     startProgress(0, peptide_ids.size(), "Storing idXML");
 
+    writeHeader_(os, document_id);
+
+    // look up different search parameters
+    std::vector<ProteinIdentification::SearchParameters> params;
+    for (std::vector<ProteinIdentification>::const_iterator it = protein_ids.begin(); it != protein_ids.end(); ++it)
+    {
+      if (find(params.begin(), params.end(), it->getSearchParameters()) == params.end())
+      {
+        params.push_back(it->getSearchParameters());
+      }
+    }
+    writeSearchParameters_(os, params);
+
+    // throws if protIDs are not unique, i.e. PeptideIDs will be randomly assigned (bad!)
+    checkUniqueIdentifiers_(protein_ids);
+
+    UInt prot_count = 0;
+    std::unordered_map<string, UInt> accession_to_id;
+    size_t protein_count{0};
+    for (const auto& pi : protein_ids)
+    {
+      protein_count += pi.getHits().size();
+    }
+    accession_to_id.reserve(protein_count); // expect this many keys (avoid rehashing)
+
+    // identifiers of protein identifications that are already written
+    std::vector<String> done_identifiers;
+
+    // write ProteinIdentification Runs
+    for (Size i = 0; i < protein_ids.size(); ++i)
+    {
+      done_identifiers.push_back(protein_ids[i].getIdentifier());
+
+      writeRunStart_(os, protein_ids[i], params, prot_count, accession_to_id);
+
+      //write PeptideIdentifications
+
+      Size count_wrong_id(0);
+      Size count_empty(0);
+
+      for (Size l = 0; l < peptide_ids.size(); ++l)
+      {
+        setProgress(l);
+
+        if (peptide_ids[l].getIdentifier() != protein_ids[i].getIdentifier())
+        {
+          ++count_wrong_id;
+          continue;
+        }
+        else if (peptide_ids[l].getHits().empty())
+        {
+          ++count_empty;
+          continue;
+        }
+
+        writePeptideIdentification_(os, peptide_ids[l], accession_to_id, protein_ids[i].getIdentifier());
+      }
+
+      os << "\t</IdentificationRun>\n";
+
+      // on more than one protein Ids (=runs) there must be wrong mappings and the message would be useless. However, a single run should not have wrong mappings!
+      if (count_wrong_id && protein_ids.size() == 1) OPENMS_LOG_WARN << "Omitted writing of " << count_wrong_id << " peptide identifications due to wrong protein mapping." << std::endl;
+      if (count_empty) OPENMS_LOG_WARN << "Omitted writing of " << count_empty << " peptide identifications due to empty hits." << std::endl;
+    }
+
+    for (Size i = 0; i < peptide_ids.size(); ++i)
+    {
+      if (find(done_identifiers.begin(), done_identifiers.end(), peptide_ids[i].getIdentifier()) == done_identifiers.end())
+      {
+        warning(STORE, String("Omitting peptide identification because of missing ProteinIdentification with identifier '") + peptide_ids[i].getIdentifier() + "' while writing '" + filename + "'!");
+      }
+    }
+    writeFooter_(os, protein_ids.empty());
+
+    // close stream
+    os.close();
+
+    endProgress();
+
+    resetMembers_();
+  }
+
+  void IdXMLFile::writeHeader_(std::ostream& os, const String& document_id) const
+  {
     os.precision(writtenDigits<double>(0.0));
 
     // write header
@@ -133,17 +272,10 @@ namespace OpenMS
       os << " id=\"" << document_id << "\"";
     }
     os << " xsi:noNamespaceSchemaLocation=\"https://www.openms.de/xml-schema/IdXML_1_5.xsd\" xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\">\n";
+  }
 
-    // look up different search parameters
-    std::vector<ProteinIdentification::SearchParameters> params;
-    for (std::vector<ProteinIdentification>::const_iterator it = protein_ids.begin(); it != protein_ids.end(); ++it)
-    {
-      if (find(params.begin(), params.end(), it->getSearchParameters()) == params.end())
-      {
-        params.push_back(it->getSearchParameters());
-      }
-    }
-
+  void IdXMLFile::writeSearchParameters_(std::ostream& os, const std::vector<ProteinIdentification::SearchParameters>& params) const
+  {
     // write search parameters
     for (Size i = 0; i != params.size(); ++i)
     {
@@ -199,264 +331,203 @@ namespace OpenMS
     {
       os << "<SearchParameters charges=\"+0, +0\" id=\"ID_1\" db_version=\"0\" mass_type=\"monoisotopic\" peak_mass_tolerance=\"0.0\" precursor_peak_tolerance=\"0.0\" db=\"Unknown\"/>\n";
     }
+  }
 
-    // throws if protIDs are not unique, i.e. PeptideIDs will be randomly assigned (bad!)
-    checkUniqueIdentifiers_(protein_ids);
-
-    UInt prot_count = 0;
-    std::unordered_map<string, UInt> accession_to_id;
-    size_t protein_count{0};
-    for (const auto& pi : protein_ids)
+  void IdXMLFile::writeRunStart_(std::ostream& os, const ProteinIdentification& protein_id,
+                                 const std::vector<ProteinIdentification::SearchParameters>& params,
+                                 UInt& prot_count, std::unordered_map<std::string, UInt>& accession_to_id)
+  {
+    os << "\t<IdentificationRun ";
+    os << "date=\"" << protein_id.getDateTime().getDate() << "T" << protein_id.getDateTime().getTime() << "\" ";
+    os << "search_engine=\"" << writeXMLEscape(protein_id.getSearchEngine()) << "\" ";
+    os << "search_engine_version=\"" << writeXMLEscape(protein_id.getSearchEngineVersion()) << "\" ";
+    // identifier
+    for (Size j = 0; j != params.size(); ++j)
     {
-      protein_count += pi.getHits().size();
+      if (params[j] == protein_id.getSearchParameters())
+      {
+        os << "search_parameters_ref=\"SP_" << j << "\" ";
+        break;
+      }
     }
-    accession_to_id.reserve(protein_count); // expect this many keys (avoid rehashing)
-
-    // identifiers of protein identifications that are already written
-    std::vector<String> done_identifiers;
-
-    // write ProteinIdentification Runs
-    for (Size i = 0; i < protein_ids.size(); ++i)
+    os << ">\n";
+    os << "\t\t<ProteinIdentification ";
+    os << "score_type=\"" << writeXMLEscape(protein_id.getScoreType()) << "\" ";
+    if (protein_id.isHigherScoreBetter())
     {
-      done_identifiers.push_back(protein_ids[i].getIdentifier());
+      os << "higher_score_better=\"true\" ";
+    }
+    else
+    {
+      os << "higher_score_better=\"false\" ";
+    }
+    os << "significance_threshold=\"" << protein_id.getSignificanceThreshold() << "\" >\n";
 
-      os << "\t<IdentificationRun ";
-      os << "date=\"" << protein_ids[i].getDateTime().getDate() << "T" << protein_ids[i].getDateTime().getTime() << "\" ";
-      os << "search_engine=\"" << writeXMLEscape(protein_ids[i].getSearchEngine()) << "\" ";
-      os << "search_engine_version=\"" << writeXMLEscape(protein_ids[i].getSearchEngineVersion()) << "\" ";
-      // identifier
-      for (Size j = 0; j != params.size(); ++j)
-      {
-        if (params[j] == protein_ids[i].getSearchParameters())
-        {
-          os << "search_parameters_ref=\"SP_" << j << "\" ";
-          break;
-        }
-      }
-      os << ">\n";
-      os << "\t\t<ProteinIdentification ";
-      os << "score_type=\"" << writeXMLEscape(protein_ids[i].getScoreType()) << "\" ";
-      if (protein_ids[i].isHigherScoreBetter())
-      {
-        os << "higher_score_better=\"true\" ";
-      }
-      else
+    // write protein hits
+    size_t hit_count { protein_id.getHits().size() };
+    for (Size j = 0; j < hit_count; ++j)
+    {
+      os << "\t\t\t<ProteinHit "
+         << "id=\"PH_" << String(prot_count) << "\" "
+         << "accession=\"" << writeXMLEscape(protein_id.getHits()[j].getAccession()) << "\" "
+         << "score=\"" << String(protein_id.getHits()[j].getScore()) << "\" ";
+      accession_to_id[protein_id.getHits()[j].getAccession()] = prot_count;
+      ++prot_count;
+
+      double coverage = protein_id.getHits()[j].getCoverage();
+      if (coverage != ProteinHit::COVERAGE_UNKNOWN)
       {
-        os << "higher_score_better=\"false\" ";
+        os << "coverage=\"" << String(coverage) << "\" ";
       }
-      os << "significance_threshold=\"" << protein_ids[i].getSignificanceThreshold() << "\" >\n";
 
-      // write protein hits
-      size_t hit_count { protein_ids[i].getHits().size() };
-      for (Size j = 0; j < hit_count; ++j)
-      {
-        os << "\t\t\t<ProteinHit "
-           << "id=\"PH_" << String(prot_count) << "\" "
-           << "accession=\"" << writeXMLEscape(protein_ids[i].getHits()[j].getAccession()) << "\" "
-           << "score=\"" << String(protein_ids[i].getHits()[j].getScore()) << "\" ";
-        accession_to_id[protein_ids[i].getHits()[j].getAccession()] = prot_count;
-        ++prot_count;
-
-        double coverage = protein_ids[i].getHits()[j].getCoverage();
-        if (coverage != ProteinHit::COVERAGE_UNKNOWN)
-        {
-          os << "coverage=\"" << String(coverage) << "\" ";
-        }
+      os << "sequence=\"" << writeXMLEscape(protein_id.getHits()[j].getSequence()) << "\" >\n";
+      writeUserParam_("UserParam", os, protein_id.getHits()[j], 4);
+      os << "\t\t\t</ProteinHit>\n";
+    }
 
-        os << "sequence=\"" << writeXMLEscape(protein_ids[i].getHits()[j].getSequence()) << "\" >\n";
-        writeUserParam_("UserParam", os, protein_ids[i].getHits()[j], 4);
-        os << "\t\t\t</ProteinHit>\n";
-      }
+    // add ProteinGroup info to metavalues (hack)
+    MetaInfoInterface meta = protein_id;
+    addProteinGroups_(meta, protein_id.getProteinGroups(),
+                      "protein_group", accession_to_id, STORE);
+    addProteinGroups_(meta, protein_id.getIndistinguishableProteins(),
+                      "indistinguishable_proteins", accession_to_id, STORE);
+    writeUserParam_("UserParam", os, meta, 3);
 
-      // add ProteinGroup info to metavalues (hack)
-      MetaInfoInterface meta = protein_ids[i];
-      addProteinGroups_(meta, protein_ids[i].getProteinGroups(),
-                        "protein_group", accession_to_id, STORE);
-      addProteinGroups_(meta, protein_ids[i].getIndistinguishableProteins(),
-                        "indistinguishable_proteins", accession_to_id, STORE);
-      writeUserParam_("UserParam", os, meta, 3);
+    os << "\t\t</ProteinIdentification>\n";
+  }
 
-      os << "\t\t</ProteinIdentification>\n";
+  void IdXMLFile::writePeptideIdentification_(std::ostream& os, const PeptideIdentification& peptide_id,
+                                              const std::unordered_map<std::string, UInt>& accession_to_id,
+                                              const String& run_identifier) const
+  {
+    os << "\t\t<PeptideIdentification "
+       << "score_type=\"" << writeXMLEscape(peptide_id.getScoreType()) << "\" ";
+    if (peptide_id.isHigherScoreBetter())
+    {
+      os << "higher_score_better=\"true\" ";
+    }
+    else
+    {
+      os << "higher_score_better=\"false\" ";
+    }
+    os << "significance_threshold=\"" << String(peptide_id.getSignificanceThreshold()) << "\" ";
+    // mz
+    if (peptide_id.hasMZ())
+    {
+      os << "MZ=\"" << String(peptide_id.getMZ()) << "\" ";
+    }
+    // rt
+    if (peptide_id.hasRT())
+    {
+      os << "RT=\"" << String(peptide_id.getRT()) << "\" ";
+    }
+    // spectrum_reference
+    const DataValue& dv = peptide_id.getMetaValue("spectrum_reference");
+    if (dv != DataValue::EMPTY)
+    {
+      os << "spectrum_reference=\"" << writeXMLEscape(dv.toString()) << "\" ";
+    }
+    os << ">\n";
 
-      //write PeptideIdentifications
+    // write peptide hits
+    std::vector<String> protein_accessions;
 
-      Size count_wrong_id(0);
-      Size count_empty(0);
+    // copy current hit
+    PeptideIdentification pep_id = peptide_id;
 
-      for (Size l = 0; l < peptide_ids.size(); ++l)
-      {
-        setProgress(l);
+    // sort by score
+    pep_id.sort();
+    const vector<PeptideHit>& pep_hits = pep_id.getHits();
 
-        if (peptide_ids[l].getIdentifier() != protein_ids[i].getIdentifier())
-        {
-          ++count_wrong_id;
-          continue;
-        }
-        else if (peptide_ids[l].getHits().empty())
-        {
-          ++count_empty;
-          continue;
-        }
+    for (const PeptideHit& p_hit : pep_hits)
+    {
+      os << "\t\t\t<PeptideHit"
+         << " score=\"" << String(p_hit.getScore()) << "\""
+         << " sequence=\"" << writeXMLEscape(p_hit.getSequence().toString()) << "\""
+         << " charge=\"" << String(p_hit.getCharge()) << "\"";
 
-        os << "\t\t<PeptideIdentification "
-           << "score_type=\"" << writeXMLEscape(peptide_ids[l].getScoreType()) << "\" ";
-        if (peptide_ids[l].isHigherScoreBetter())
-        {
-          os << "higher_score_better=\"true\" ";
-        }
-        else
-        {
-          os << "higher_score_better=\"false\" ";
-        }
-        os << "significance_threshold=\"" << String(peptide_ids[l].getSignificanceThreshold()) << "\" ";
-        // mz
-        if (peptide_ids[l].hasMZ())
-        {
-          os << "MZ=\"" << String(peptide_ids[l].getMZ()) << "\" ";
-        }
-        // rt
-        if (peptide_ids[l].hasRT())
-        {
-          os << "RT=\"" << String(peptide_ids[l].getRT()) << "\" ";
-        }
-        // spectrum_reference
-        const DataValue& dv = peptide_ids[l].getMetaValue("spectrum_reference");
-        if (dv != DataValue::EMPTY)
-        {
-          os << "spectrum_reference=\"" << writeXMLEscape(dv.toString()) << "\" ";
-        }
-        os << ">\n";
+      const std::vector<PeptideEvidence>& pes = p_hit.getPeptideEvidences();
 
-        // write peptide hits
-        std::vector<String> protein_accessions;
+      createFlankingAAXMLString_(pes, os);
+      createPositionXMLString_(pes, os);
 
-        // copy current hit
-        PeptideIdentification pep_id = peptide_ids[l];
+      // Extract all protein accessions.
+      // Note: protein accessions correspond to neighboring AAs and start/end
+      // positions, so we have to keep the same order and allow duplicates
+      // (for peptides matching multiple times in the same protein)
 
-        // sort by score
-        pep_id.sort();
-        const vector<PeptideHit>& pep_hits = pep_id.getHits();
+      protein_accessions.clear();
+      for (vector<PeptideEvidence>::const_iterator pe = pes.begin(); pe != pes.end(); ++pe)
+      {
+        const String& protein_accession = pe->getProteinAccession();
 
-        for (const PeptideHit& p_hit : pep_hits)
+        // empty accessions are not written out (legacy code)
+        if (!protein_accession.empty())
         {
-          os << "\t\t\t<PeptideHit"
-             << " score=\"" << String(p_hit.getScore()) << "\""
-             << " sequence=\"" << writeXMLEscape(p_hit.getSequence().toString()) << "\""
-             << " charge=\"" << String(p_hit.getCharge()) << "\"";
-
-          const std::vector<PeptideEvidence>& pes = p_hit.getPeptideEvidences();
-
-          createFlankingAAXMLString_(pes, os);
-          createPositionXMLString_(pes, os);
-
-          // Extract all protein accessions.
-          // Note: protein accessions correspond to neighboring AAs and start/end
-          // positions, so we have to keep the same order and allow duplicates
-          // (for peptides matching multiple times in the same protein)
-
-          protein_accessions.clear();
-          for (vector<PeptideEvidence>::const_iterator pe = pes.begin(); pe != pes.end(); ++pe)
+          const auto acc = accession_to_id.find(protein_accession);
+          if (acc != accession_to_id.end())
           {
-            const String& protein_accession = pe->getProteinAccession();
-
-            // empty accessions are not written out (legacy code)
-            if (!protein_accession.empty())
-            {
-              const auto acc = accession_to_id.find(protein_accession);
-              if (acc != accession_to_id.end())
-              {
-                protein_accessions.emplace_back("PH_" + String(acc->second));
-              }
-              else
-              {
-                throw Exception::ElementNotFound(
-                    __FILE__,
-                    __LINE__,
-                    OPENMS_PRETTY_FUNCTION,
-                    "No accession " + protein_accession + " found in run '" + protein_ids[i].getIdentifier() +
-                    "' for PSM " + p_hit.getSequence().toString() + "_" + String(p_hit.getCharge()) +
-                    ". Please contact the maintainer of this tool e.g. on GitHub as this should not happen.");
-              }
-            }
+            protein_accessions.emplace_back("PH_" + String(acc->second));
           }
-
-          if (!protein_accessions.empty())
+          else
           {
-            os << " protein_refs=\"" << ListUtils::concatenate(protein_accessions, " ") << "\"";
+            throw Exception::ElementNotFound(
+                __FILE__,
+                __LINE__,
+                OPENMS_PRETTY_FUNCTION,
+                "No accession " + protein_accession + " found in run '" + run_identifier +
+                "' for PSM " + p_hit.getSequence().toString() + "_" + String(p_hit.getCharge()) +
+                ". Please contact the maintainer of this tool e.g. on GitHub as this should not happen.");
           }
+        }
+      }
+
+      if (!protein_accessions.empty())
+      {
+        os << " protein_refs=\"" << ListUtils::concatenate(protein_accessions, " ") << "\"";
+      }
 
-          os << " >\n";
-          writeFragmentAnnotations_("UserParam", os, p_hit.getPeakAnnotations(), 4);
-          writeUserParam_("UserParam", os, p_hit, 4);
+      os << " >\n";
+      writeFragmentAnnotations_("UserParam", os, p_hit.getPeakAnnotations(), 4);
+      writeUserParam_("UserParam", os, p_hit, 4);
 
-          // write out the (optional) peptide prophet / interprophet results as UserParams
+      // write out the (optional) peptide prophet / interprophet results as UserParams
+      {
+        int k = 0;
+        for (std::vector<PeptideHit::PepXMLAnalysisResult>::const_iterator ar_it = p_hit.getAnalysisResults().begin();
+            ar_it != p_hit.getAnalysisResults().end(); ++ar_it, ++k)
+        {
+          os << "\t\t\t\t<UserParam type=\"string\" name=\"_ar_" << String(k) << "_score_type\" value=\"" << ar_it->score_type << "\"/>" << "\n";
+          os << "\t\t\t\t<UserParam type=\"float\" name=\"_ar_" << String(k) << "_score\" value=\"" << String(ar_it->main_score) << "\"/>" << "\n";
+          if (!ar_it->sub_scores.empty())
           {
-            int k = 0;
-            for (std::vector<PeptideHit::PepXMLAnalysisResult>::const_iterator ar_it = p_hit.getAnalysisResults().begin();
-                ar_it != p_hit.getAnalysisResults().end(); ++ar_it, ++k)
+            for (std::map<String, double>::const_iterator subscore_it = ar_it->sub_scores.begin();
+                subscore_it != ar_it->sub_scores.end(); ++subscore_it)
             {
-              os << "\t\t\t\t<UserParam type=\"string\" name=\"_ar_" << String(k) << "_score_type\" value=\"" << ar_it->score_type << "\"/>" << "\n";
-              os << "\t\t\t\t<UserParam type=\"float\" name=\"_ar_" << String(k) << "_score\" value=\"" << String(ar_it->main_score) << "\"/>" << "\n";
-              if (!ar_it->sub_scores.empty())
-              {
-                for (std::map<String, double>::const_iterator subscore_it = ar_it->sub_scores.begin();
-                    subscore_it != ar_it->sub_scores.end(); ++subscore_it)
-                {
-                  os << "\t\t\t\t<UserParam type=\"float\" name=\"_ar_" << String(k) << "_subscore_" << subscore_it->first <<"\" value=\"" << String(subscore_it->second) << "\"/>" << "\n";
-                }
-              }
+              os << "\t\t\t\t<UserParam type=\"float\" name=\"_ar_" << String(k) << "_subscore_" << subscore_it->first <<"\" value=\"" << String(subscore_it->second) << "\"/>" << "\n";
             }
-
           }
-          os << "\t\t\t</PeptideHit>\n";
         }
 
-        // do not write "spectrum_reference" since it is written as attribute already
-        pep_id.removeMetaValue("spectrum_reference");
-        writeUserParam_("UserParam", os, pep_id, 3);
-        os << "\t\t</PeptideIdentification>\n";
       }
-
-      os << "\t</IdentificationRun>\n";
-
-      // on more than one protein Ids (=runs) there must be wrong mappings and the message would be useless. However, a single run should not have wrong mappings!
-      if (count_wrong_id && protein_ids.size() == 1) OPENMS_LOG_WARN << "Omitted writing of " << count_wrong_id << " peptide identifications due to wrong protein mapping." << std::endl;
-      if (count_empty) OPENMS_LOG_WARN << "Omitted writing of " << count_empty << " peptide identifications due to empty hits." << std::endl;
+      os << "\t\t\t</PeptideHit>\n";
     }
 
+    // do not write "spectrum_reference" since it is written as attribute already
+    pep_id.removeMetaValue("spectrum_reference");
+    writeUserParam_("UserParam", os, pep_id, 3);
+    os << "\t\t</PeptideIdentification>\n";
+  }
+
+  void IdXMLFile::writeFooter_(std::ostream& os, bool no_runs) const
+  {
     // empty protein ids  parameters
-    if (protein_ids.empty())
+    if (no_runs)
     {
       os << "<IdentificationRun date=\"1900-01-01T01:01:01.0Z\" search_engine=\"Unknown\" search_parameters_ref=\"ID_1\" search_engine_version=\"0\"/>\n";
     }
-
-    for (Size i = 0; i < peptide_ids.size(); ++i)
-    {
-      if (find(done_identifiers.begin(), done_identifiers.end(), peptide_ids[i].getIdentifier()) == done_identifiers.end())
-      {
-        warning(STORE, String("Omitting peptide identification because of missing ProteinIdentification with identifier '") + peptide_ids[i].getIdentifier() + "' while writing '" + filename + "'!");
-      }
-    }
     // write footer
     os << "</IdXML>\n";
-
-    // close stream
-    os.close();
-
-    endProgress();
-
-    //reset members
-    prot_ids_ = nullptr;
-    pep_ids_ = nullptr;
-    last_meta_ = nullptr;
-    parameters_.clear();
-    param_ = ProteinIdentification::SearchParameters();
-    id_ = "";
-    prot_id_ = ProteinIdentification();
-    pep_id_ = PeptideIdentification();
-    prot_hit_ = ProteinHit();
-    pep_hit_ = PeptideHit();
-    proteinid_to_accession_.clear();
   }
 
   void IdXMLFile::startElement(const XMLCh* const /*uri*/, const XMLCh* const /*local_name*/, const XMLCh* const qname, const xercesc::Attributes& attributes)
@@ -616,6 +687,7 @@ namespace OpenMS
       {
         prot_ids_->push_back(prot_id_);
         prot_id_in_run_ = true; // set to true, cause we have created one; will be reset for next run
+        consumeProteinIdentification_();
       }
 
       //set identifier
@@ -890,6 +962,7 @@ namespace OpenMS
       prot_id_ = ProteinIdentification();
       last_meta_  = nullptr;
       prot_id_in_run_ = true;
+      consumeProteinIdentification_();
     }
     else if (tag == "IdentificationRun")
     {
@@ -897,6 +970,7 @@ namespace OpenMS
       {
         // add empty <ProteinIdentification> if there was none so far (that's where the IdentificationRun parameters are stored)
         prot_ids_->emplace_back(std::move(prot_id_));
+        consumeProteinIdentification_();
       }
       prot_id_ = ProteinIdentification();
       last_meta_ = nullptr;
@@ -913,6 +987,10 @@ namespace OpenMS
       pep_ids_->emplace_back(std::move(pep_id_));
       pep_id_ = PeptideIdentification();
       last_meta_ = nullptr;
+      if ((consumer_ != nullptr) && (pep_ids_->size() >= batch_size_))
+      {
+        flushPeptideIdentifications_();
+      }
     }
     else if (tag == "PeptideHit")
     {
@@ -34,6 +34,8 @@
 
 #include <OpenMS/FORMAT/IndexedMzMLFileLoader.h>
 
+#include <OpenMS/FORMAT/HANDLERS/IndexedMzMLHandler.h>
+
 namespace OpenMS
 {
 
@@ -59,4 +61,99 @@ namespace OpenMS
   {
       options_ = options;
   }
+
+  bool IndexedMzMLFileLoader::load(const String& filename, PeakMap& exp)
+  {
+    Internal::IndexedMzMLHandler index(filename);
+    if (!index.getParsingSuccess() ||
+        !options_.getFillData() ||
+        options_.getMetadataOnly() ||
+        options_.hasMZRange() ||
+        options_.hasIntensityRange())
+    {
+      MzMLFile f;
+      f.setOptions(options_);
+      f.load(filename, exp);
+      return false;
+    }
+    index.setSkipXMLChecks(options_.getSkipXMLChecks());
+
+    // first pass: meta data only (spectra are filtered by RT / MS level here)
+    MzMLFile f;
+    PeakFileOptions meta_options = options_;
+    meta_options.setFillData(false);
+    f.setOptions(meta_options);
+    f.load(filename, exp);
+
+    // second pass: decode the binary data of each spectrum / chromatogram in parallel
+    std::vector<MSSpectrum>& spectra = exp.getSpectra();
+    std::vector<MSChromatogram>& chromatograms = exp.getChromatograms();
+    Size errCount = 0;
+    String error_message;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      // the copy opens its own file stream, see IndexedMzMLHandler copy constructor
+      Internal::IndexedMzMLHandler thread_index(index);
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16) nowait
+#endif
+      for (SignedSize i = 0; i < (SignedSize)spectra.size(); ++i)
+      {
+        if (errCount) continue; // no need to parse further if an error was encountered
+        try
+        {
+          thread_index.getMSSpectrumByNativeId(spectra[i].getNativeID(), spectra[i]);
+          if (options_.getSortSpectraByMZ() && !spectra[i].isSorted())
+          {
+            spectra[i].sortByPosition();
+          }
+        }
+        catch (Exception::BaseException& e)
+        {
+#ifdef _OPENMP
+#pragma omp critical (IndexedMzMLFileLoader_error)
+#endif
+          {
+            ++errCount;
+            error_message = e.what();
+          }
+        }
+      }
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)chromatograms.size(); ++i)
+      {
+        if (errCount) continue;
+        try
+        {
+          thread_index.getMSChromatogramByNativeId(chromatograms[i].getNativeID(), chromatograms[i]);
+          if (options_.getSortChromatogramsByRT() && !chromatograms[i].isSorted())
+          {
+            chromatograms[i].sortByPosition();
+          }
+        }
+        catch (Exception::BaseException& e)
+        {
+#ifdef _OPENMP
+#pragma omp critical (IndexedMzMLFileLoader_error)
+#endif
+          {
+            ++errCount;
+            error_message = e.what();
+          }
+        }
+      }
+    }
+
+    if (errCount != 0)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Error during parsing of binary data: '" + error_message + "'");
+    }
+    return true;
+  }
 }
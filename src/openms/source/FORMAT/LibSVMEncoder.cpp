@@ -38,6 +38,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <unordered_map>
 
 using namespace std;
 
@@ -215,6 +216,68 @@ namespace OpenMS
     return encodeLibSVMProblem(vectors, labels);
   }
 
+  void LibSVMEncoder::encodeCompositionAndLengthVectors(const vector<String>& sequences,
+                                                       const String& allowed_characters,
+                                                       UInt maximum_sequence_length,
+                                                       vector<svm_node>& nodes,
+                                                       vector<svm_node*>& vectors,
+                                                       vector<Size>& sequence_to_vector) const
+  {
+    nodes.clear();
+    vectors.clear();
+    sequence_to_vector.clear();
+    sequence_to_vector.reserve(sequences.size());
+
+    std::unordered_map<String, Size> sequence_index; // distinct sequence -> index of its vector
+    vector<Size> offsets; // start of each vector in 'nodes'
+    vector<Size> counts(allowed_characters.size());
+    svm_node node;
+
+    for (const String& sequence : sequences)
+    {
+      auto it = sequence_index.emplace(sequence, offsets.size());
+      sequence_to_vector.push_back(it.first->second);
+      if (!it.second) continue; // already encoded
+
+      offsets.push_back(nodes.size());
+      std::fill(counts.begin(), counts.end(), 0);
+      Size total_count = 0;
+      for (Size i = 0; i < sequence.size(); ++i)
+      {
+        const Size pos = allowed_characters.find(sequence[i]);
+        if (pos != String::npos)
+        {
+          ++counts[pos];
+          ++total_count;
+        }
+      }
+
+      // composition (see encodeCompositionVector), length and terminating node
+      for (Size i = 0; i < counts.size(); ++i)
+      {
+        if (counts[i] > 0)
+        {
+          node.index = Int(i + 1);
+          node.value = ((double) counts[i]) / total_count;
+          nodes.push_back(node);
+        }
+      }
+      node.index = Int(allowed_characters.size() + 1);
+      node.value = ((double) sequence.length()) / maximum_sequence_length;
+      nodes.push_back(node);
+      node.index = -1;
+      node.value = 0;
+      nodes.push_back(node);
+    }
+
+    // 'nodes' does not grow anymore
+    vectors.reserve(offsets.size());
+    for (Size offset : offsets)
+    {
+      vectors.push_back(&nodes[offset]);
+    }
+  }
+
   svm_problem* LibSVMEncoder::encodeLibSVMProblemWithCompositionLengthAndWeightVectors(const vector<String>& sequences,
                                                                                        std::vector<double>& labels,
                                                                                        const String& allowed_characters)
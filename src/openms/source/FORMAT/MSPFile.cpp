@@ -38,12 +38,50 @@
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/SYSTEM/File.h>
 
+#include <exception>
 #include <fstream>
 
 using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// number of spectra whose peak lines are parsed in parallel
+    const Size SPECTRA_PER_BLOCK = 1024;
+
+    /// parses the peak lines [@p first, @p last) of a spectrum into @p spec
+    void parsePeakLines_(const vector<String>& lines, const vector<Size>& line_numbers, Size first, Size last,
+                         bool spectrast_format, bool parse_peakinfo, PeakSpectrum& spec)
+    {
+      spec.reserve(last - first);
+      vector<String> split;
+      for (Size i = first; i < last; ++i)
+      {
+        const String& line = lines[i];
+        line.split('\t', split);
+        Peak1D peak;
+        if (spectrast_format && split.size() != 4)
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+              line, "not <mz><tab><intensity><tab>\"<annotation>\"<tab>\"<comment>\" in line " + String(line_numbers[i]));
+        }
+        else if (!spectrast_format && split.size() != 3)
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+              line, "not <mz><tab><intensity><tab>\"<comment>\" in line " + String(line_numbers[i]));
+        }
+        peak.setMZ(split[0].toFloat());
+        peak.setIntensity(split[1].toFloat());
+        if (parse_peakinfo)
+        {
+          spec.getStringDataArrays()[0].push_back(split[2]);
+        }
+        spec.push_back(peak);
+      }
+    }
+  }
+
   MSPFile::MSPFile() :
     DefaultParamHandler("MSPFile")
   {
@@ -138,6 +176,48 @@ namespace OpenMS
     // line number counter
     Size line_number = 0;
 
+    // Peak lines of the spectra that were already added to 'exp' but are not parsed yet. The header
+    // lines have to be processed sequentially, the peak lines of a block of spectra are parsed in parallel.
+    vector<String> peak_lines; // reused between blocks
+    vector<Size> peak_line_numbers;
+    Size n_peak_lines = 0;
+    vector<Size> pending_begin;
+    vector<bool> pending_spectrast_format;
+
+    auto parse_pending = [&]()
+    {
+      const Size n_pending = pending_begin.size();
+      const Size first_spectrum = exp.size() - n_pending;
+      pending_begin.push_back(n_peak_lines);
+
+      // report the first erroneous line of the file, independent of the order in which the spectra are parsed
+      std::exception_ptr error;
+      Size error_index = n_pending;
+#pragma omp parallel for schedule(dynamic, 16)
+      for (SignedSize k = 0; k < (SignedSize)n_pending; ++k)
+      {
+        try
+        {
+          parsePeakLines_(peak_lines, peak_line_numbers, pending_begin[k], pending_begin[k + 1],
+                          pending_spectrast_format[k], parse_peakinfo, exp[first_spectrum + k]);
+        }
+        catch (...)
+        {
+#pragma omp critical (MSPFile_error)
+          if ((Size)k < error_index)
+          {
+            error_index = k;
+            error = std::current_exception();
+          }
+        }
+      }
+      if (error) std::rethrow_exception(error);
+
+      pending_begin.clear();
+      pending_spectrast_format.clear();
+      n_peak_lines = 0;
+    };
+
     while (getline(is, line))
     {
       ++line_number;
@@ -267,28 +347,19 @@ namespace OpenMS
         }
         else
         {
+          // the peak lines are only collected here, they are parsed later (see parse_pending)
+          pending_begin.push_back(n_peak_lines);
+          pending_spectrast_format.push_back(spectrast_format);
           while (getline(is, line) && ++line_number && line.size() > 0 && isdigit(line[0]))
           {
-            vector<String> split;
-            line.split('\t', split);
-            Peak1D peak;
-            if (spectrast_format && split.size() != 4)
-            {
-              throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-                  line, "not <mz><tab><intensity><tab>\"<annotation>\"<tab>\"<comment>\" in line " + String(line_number));
-            }
-            else if (!spectrast_format && split.size() != 3)
+            if (n_peak_lines == peak_lines.size())
             {
-              throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-                  line, "not <mz><tab><intensity><tab>\"<comment>\" in line " + String(line_number));
+              peak_lines.emplace_back();
+              peak_line_numbers.emplace_back();
             }
-            peak.setMZ(split[0].toFloat());
-            peak.setIntensity(split[1].toFloat());
-            if (parse_peakinfo)
-            {
-              spec.getStringDataArrays()[0].push_back(split[2]);
-            }
-            spec.push_back(peak);
+            peak_lines[n_peak_lines].swap(line);
+            peak_line_numbers[n_peak_lines] = line_number;
+            ++n_peak_lines;
           }
           spec.setNativeID(String("index=") + spectrum_number);
           exp.addSpectrum(spec);
@@ -296,14 +367,20 @@ namespace OpenMS
           spec.clear(true);
           spec.getStringDataArrays().resize(1);
           spec.getStringDataArrays()[0].setName("MSPPeakInfo");
+
+          if (pending_begin.size() == SPECTRA_PER_BLOCK)
+          {
+            parse_pending();
+          }
         }
         spectrum_number++;
       }
     }
 
-    // last spectrum, if available
-
-
+    if (!pending_begin.empty())
+    {
+      parse_pending();
+    }
   }
 
   void MSPFile::parseHeader_(const String & header, PeakSpectrum & spec)
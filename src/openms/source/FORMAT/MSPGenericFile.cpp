@@ -36,10 +36,79 @@
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/KERNEL/SpectrumHelper.h>
 #include <boost/regex.hpp>
+#include <exception>
 #include <fstream>
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// number of records that are parsed in parallel before they are added to the library
+    const Size RECORDS_PER_BLOCK { 4096 };
+
+    /// the (thread-safe) regular expressions used to parse the lines of a record
+    struct MSPRegexes_
+    {
+      boost::regex name { "^Name: (.+)", boost::regex::no_mod_s };
+      boost::regex synon { "^synon(?:yms?)?: (.+)", boost::regex::no_mod_s | boost::regex::icase };
+      boost::regex points_line { "^\\d" };
+      boost::regex point { "(\\d+(?:\\.\\d+)?)[: ](\\d+(?:\\.\\d+)?);? ?" };
+      boost::regex cas_nist { "^CAS#: ([\\d-]+);  NIST#: (\\d+)" }; // specific to NIST db
+      boost::regex metadatum { "^(.+): (.+)", boost::regex::no_mod_s };
+    };
+
+    /// parses the lines [@p first, @p last) of a single record into @p spectrum and @p synonyms
+    void parseRecord_(
+      const std::vector<std::string>& lines,
+      Size first,
+      Size last,
+      const MSPRegexes_& re,
+      MSSpectrum& spectrum,
+      std::vector<String>& synonyms
+    )
+    {
+      spectrum.setMetaValue("is_valid", 0); // to avoid adding invalid spectra to the library
+      boost::cmatch m;
+      for (Size i = first; i < last; ++i)
+      {
+        const char* line = lines[i].c_str();
+        // Peaks
+        if (boost::regex_search(line, m, re.points_line))
+        {
+          boost::regex_search(line, m, re.point);
+          do
+          {
+            const double position { std::stod(m[1]) };
+            const double intensity { std::stod(m[2]) };
+            spectrum.push_back( Peak1D(position, intensity) );
+          } while ( boost::regex_search(m[0].second, m, re.point) );
+        }
+        // Synon
+        else if (boost::regex_search(line, m, re.synon))
+        {
+          synonyms.push_back(String(m[1]));
+        }
+        // Name (only the first line of a record)
+        else if (boost::regex_search(line, m, re.name))
+        {
+          spectrum.setName( String(m[1]) );
+          spectrum.setMetaValue("is_valid", 1);
+        }
+        // Specific case of NIST's exported msp
+        else if (boost::regex_search(line, m, re.cas_nist))
+        {
+          spectrum.setMetaValue(String("CAS#"), String(m[1]));
+          spectrum.setMetaValue(String("NIST#"), String(m[2]));
+        }
+        // Other metadata
+        else if (boost::regex_search(line, m, re.metadatum))
+        {
+          spectrum.setMetaValue(String(m[1]), String(m[2]));
+        }
+      }
+    }
+  }
+
   MSPGenericFile::MSPGenericFile() :
     DefaultParamHandler("MSPGenericFile")
   {
@@ -75,70 +144,66 @@ namespace OpenMS
     {
       throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
     }
-    const Size BUFSIZE { 65536 };
-    char line[BUFSIZE];
     library.clear(true);
-    MSSpectrum spectrum;
-    spectrum.setMetaValue("is_valid", 0); // to avoid adding invalid spectra to the library
 
-    boost::cmatch m;
-    boost::regex re_name("^Name: (.+)", boost::regex::no_mod_s);
-    boost::regex re_synon("^synon(?:yms?)?: (.+)", boost::regex::no_mod_s | boost::regex::icase);
-    boost::regex re_points_line("^\\d");
-    boost::regex re_point("(\\d+(?:\\.\\d+)?)[: ](\\d+(?:\\.\\d+)?);? ?");
-    boost::regex re_cas_nist("^CAS#: ([\\d-]+);  NIST#: (\\d+)"); // specific to NIST db
-    boost::regex re_metadatum("^(.+): (.+)", boost::regex::no_mod_s);
+    const MSPRegexes_ re;
 
     OPENMS_LOG_INFO << "\nLoading spectra from .msp file. Please wait." << std::endl;
 
-    while (!ifs.eof())
+    // The file is read in blocks of records. Every record starts at a "Name" line (lines before
+    // the first one do not belong to any spectrum), so the records of a block can be parsed
+    // independently of each other. They are added to the library in file order afterwards.
+    std::vector<std::string> lines; // reused between blocks
+    std::vector<Size> record_begin;
+    Size n_lines { 0 };
+    std::string line;
+    boost::cmatch m;
+
+    auto add_records = [&]()
     {
-      ifs.getline(line, BUFSIZE);
-      // Peaks
-      if (boost::regex_search(line, m, re_points_line))
+      record_begin.push_back(n_lines);
+      const Size n_records { record_begin.size() - 1 };
+      std::vector<MSSpectrum> spectra(n_records);
+      std::vector<std::vector<String>> synonyms(n_records);
+
+      std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 64)
+      for (SignedSize r = 0; r < (SignedSize)n_records; ++r)
       {
-        // OPENMS_LOG_DEBUG << "re_points_line\n";
-        boost::regex_search(line, m, re_point);
-        do
+        try
         {
-          // OPENMS_LOG_DEBUG << "{" << m[1] << "} {" << m[2] << "}; ";
-          const double position { std::stod(m[1]) };
-          const double intensity { std::stod(m[2]) };
-          spectrum.push_back( Peak1D(position, intensity) );
-        } while ( boost::regex_search(m[0].second, m, re_point) );
-      }
-      // Synon
-      else if (boost::regex_search(line, m, re_synon))
-      {
-        // OPENMS_LOG_DEBUG << "Synon: " << m[1] << "\n";
-        synonyms_.push_back(String(m[1]));
-      }
-      // Name
-      else if (boost::regex_search(line, m, re_name))
-      {
-        addSpectrumToLibrary(spectrum, library);
-        // OPENMS_LOG_DEBUG << "\n\nName: " << m[1] << "\n";
-        spectrum.clear(true);
-        synonyms_.clear();
-        spectrum.setName( String(m[1]) );
-        spectrum.setMetaValue("is_valid", 1);
+          parseRecord_(lines, record_begin[r], record_begin[r + 1], re, spectra[r], synonyms[r]);
+        }
+        catch (...)
+        {
+#pragma omp critical (MSPGenericFile_error)
+          if (!error) error = std::current_exception();
+        }
       }
-      // Specific case of NIST's exported msp
-      else if (boost::regex_search(line, m, re_cas_nist))
+      if (error) std::rethrow_exception(error);
+
+      for (Size r = 0; r < n_records; ++r)
       {
-        // OPENMS_LOG_DEBUG << "CAS#: " << m[1] << "; NIST#: " << m[2] << "\n";
-        spectrum.setMetaValue(String("CAS#"), String(m[1]));
-        spectrum.setMetaValue(String("NIST#"), String(m[2]));
+        synonyms_.swap(synonyms[r]);
+        addSpectrumToLibrary(spectra[r], library);
       }
-      // Other metadata
-      else if (boost::regex_search(line, m, re_metadatum))
+      record_begin.clear();
+      n_lines = 0;
+    };
+
+    while (std::getline(ifs, line))
+    {
+      if (line.compare(0, 6, "Name: ") == 0 && boost::regex_search(line.c_str(), m, re.name))
       {
-        // OPENMS_LOG_DEBUG << m[1] << m[2] << "\n";
-        spectrum.setMetaValue(String(m[1]), String(m[2]));
+        if (record_begin.size() == RECORDS_PER_BLOCK) add_records();
+        record_begin.push_back(n_lines);
       }
+      if (record_begin.empty()) continue;
+
+      if (n_lines == lines.size()) lines.emplace_back();
+      lines[n_lines++].swap(line);
     }
-    // To make sure a spectrum is added even if no empty line is present before EOF
-    addSpectrumToLibrary(spectrum, library);
+    if (!record_begin.empty()) add_records();
     OPENMS_LOG_INFO << "Loading spectra from .msp file completed." << std::endl;
   }
 
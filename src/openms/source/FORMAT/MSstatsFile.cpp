@@ -34,6 +34,8 @@
 
 #include <OpenMS/FORMAT/MSstatsFile.h>
 
+#include <fstream>
+#include <numeric>
 #include <tuple>
 
 using namespace std;
@@ -72,141 +74,175 @@ void OpenMS::MSstatsFile::checkConditionISO_(const ExperimentalDesign::SampleSec
 }
 
 
-//TODO why do we need this method and store everything three times??? (Once in the CMap, once in the feature
-// of aggregatedConsensusInfo, and once in the other fields of aggregatedConsensusInfo)
-// Cant we just get this stuff on the fly?
-// We go through the features anyway again.
-OpenMS::MSstatsFile::AggregatedConsensusInfo OpenMS::MSstatsFile::aggregateInfo_(const ConsensusMap& consensus_map,
-                                                                                 const std::vector<String>& spectra_paths)
+namespace
 {
-  OpenMS::MSstatsFile::AggregatedConsensusInfo aggregatedInfo; //results
-  const auto &column_headers = consensus_map.getColumnHeaders(); // needed for label_id
-
-  for (const OpenMS::ConsensusFeature &consensus_feature : consensus_map)
+  // Assigns ids to strings while collecting them and replaces ids by ranks (position in sorted order) afterwards
+  class StringIndex
   {
-
-    vector<OpenMS::String> filenames;
-    vector<OpenMS::MSstatsFile::Intensity> intensities;
-    vector<OpenMS::MSstatsFile::Coordinate> retention_times;
-    vector<unsigned> cf_labels;
-
-    // Store the file names and the run intensities of this feature
-    const OpenMS::ConsensusFeature::HandleSetType& fs(consensus_feature.getFeatures());
-    for (const auto& feat : fs)
+  public:
+    OpenMS::Size insert(const OpenMS::String& s)
     {
-      filenames.push_back(spectra_paths[feat.getMapIndex()]);
-      intensities.push_back(feat.getIntensity());
-      retention_times.push_back(feat.getRT());
+      auto it = ids_.emplace(s, strings_.size());
+      if (it.second) strings_.push_back(s);
+      return it.first->second;
+    }
 
-      // Get the label_id from the file description MetaValue
-      auto &column = column_headers.at(feat.getMapIndex());
-      if (column.metaValueExists("channel_id"))
-      {
-        cf_labels.push_back(OpenMS::Int(column.getMetaValue("channel_id")));
-      }
-      else
+    // sorts the strings, call after all strings are inserted
+    void finalize()
+    {
+      std::vector<OpenMS::Size> order(strings_.size());
+      std::iota(order.begin(), order.end(), 0);
+      std::sort(order.begin(), order.end(),
+        [this](OpenMS::Size a, OpenMS::Size b) { return strings_[a] < strings_[b]; });
+      ranks_.resize(strings_.size());
+      std::vector<OpenMS::String> sorted;
+      sorted.reserve(strings_.size());
+      for (OpenMS::Size r = 0; r < order.size(); ++r)
       {
-        // label id 1 is used in case the experimental design specifies a LFQ experiment
-        //TODO Not really, according to the if-case it only cares about the metavalue.
-        // which could be missing due to other reasons
-        cf_labels.push_back(1u);
+        ranks_[order[r]] = r;
+        sorted.push_back(std::move(strings_[order[r]]));
       }
+      strings_.swap(sorted);
+      ids_.clear();
     }
-    aggregatedInfo.consensus_feature_labels.push_back(cf_labels);
-    aggregatedInfo.consensus_feature_filenames.push_back(filenames);
-    aggregatedInfo.consensus_feature_intensities.push_back(intensities);
-    aggregatedInfo.consensus_feature_retention_times.push_back(retention_times);
-    aggregatedInfo.features.push_back(consensus_feature);
-  }
-  return aggregatedInfo;
+
+    OpenMS::Size rank(OpenMS::Size id) const { return ranks_[id]; }
+
+    // strings by rank (after finalize())
+    const std::vector<OpenMS::String>& sorted() const { return strings_; }
+
+  private:
+    std::unordered_map<OpenMS::String, OpenMS::Size> ids_;
+    std::vector<OpenMS::String> strings_;
+    std::vector<OpenMS::Size> ranks_;
+  };
 }
 
-//@todo LineType should be a template only for the line, not for the whole
-// mapping structure. More exact type matching/info then.
-template <class LineType>
-void OpenMS::MSstatsFile::constructFile_(const String& retention_time_summarization_method,
-                                         const bool rt_summarization_manual,
-                                         TextFile& csv_out,
-                                         const std::set<String>& peptideseq_quantifyable,
-                                         LineType& peptideseq_to_prefix_to_intensities) const
+void OpenMS::MSstatsFile::rankColumns_(std::vector<MSstatsColumn_>& columns, const bool isobaric)
+{
+  std::vector<Size> resolved;
+  for (Size i = 0; i < columns.size(); ++i)
+  {
+    if (columns[i].resolved) resolved.push_back(i);
+  }
+
+  auto key = [&columns, isobaric](Size i)
+  {
+    const MSstatsColumn_& c = columns[i];
+    return std::tie(c.run, c.condition, c.bioreplicate, isobaric ? c.mixture : na_string_);
+  };
+  std::sort(resolved.begin(), resolved.end(), [&key](Size a, Size b) { return key(a) < key(b); });
+  for (Size r = 0; r < resolved.size(); ++r)
+  {
+    columns[resolved[r]].key = (r > 0 && key(resolved[r - 1]) == key(resolved[r])) ? columns[resolved[r - 1]].key : r;
+  }
 
+  if (!isobaric) return;
+  std::sort(resolved.begin(), resolved.end(), [&columns](Size a, Size b) { return columns[a].channel < columns[b].channel; });
+  for (Size r = 0; r < resolved.size(); ++r)
+  {
+    columns[resolved[r]].channel_rank = (r > 0 && columns[resolved[r - 1]].channel == columns[resolved[r]].channel) ?
+      columns[resolved[r - 1]].channel_rank : r;
+  }
+}
+
+template <class MakePrefix>
+void OpenMS::MSstatsFile::storeRecords_(const String& filename,
+                                        const String& header,
+                                        const String& retention_time_summarization_method,
+                                        const bool rt_summarization_manual,
+                                        std::vector<MSstatsRecord_>& records,
+                                        const std::vector<String>& references,
+                                        MakePrefix make_prefix) const
 {
-  // sanity check that the triples (peptide_sequence, precursor_charge, run) only appears once
-  set<tuple<OpenMS::String, OpenMS::String, OpenMS::String> > peptideseq_precursor_charge_run;
+  // order of the MSstats lines: sequence, then the line prefix, then the intensities of the prefix
+  auto recordLess = [](const MSstatsRecord_& l, const MSstatsRecord_& r)
+  {
+    return std::tie(l.sequence, l.accession, l.key, l.charge, l.channel, l.intensity, l.retention_time, l.reference) <
+           std::tie(r.sequence, r.accession, r.key, r.charge, r.channel, r.intensity, r.retention_time, r.reference);
+  };
+  auto samePrefix = [](const MSstatsRecord_& l, const MSstatsRecord_& r)
+  {
+    return std::tie(l.sequence, l.accession, l.key, l.charge, l.channel) ==
+           std::tie(r.sequence, r.accession, r.key, r.charge, r.channel);
+  };
+
+  // each intensity (with retention time and reference) is only counted once per line prefix
+  std::sort(records.begin(), records.end(), recordLess);
+  records.erase(std::unique(records.begin(), records.end(),
+    [&recordLess](const MSstatsRecord_& l, const MSstatsRecord_& r) { return !recordLess(l, r) && !recordLess(r, l); }), records.end());
 
-  int count_similar = 0;
-  for (const auto &peptideseq : peptideseq_quantifyable)
+  // lines are written one prefix at a time, nothing but the records is kept in memory
+  ofstream os(filename.c_str(), ofstream::out);
+  if (!os)
   {
-    for (const auto &line :
-            peptideseq_to_prefix_to_intensities[peptideseq])
+    throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+  }
+  os << header << "\n";
+
+  for (auto prefix_begin = records.begin(); prefix_begin != records.end(); )
+  {
+    auto prefix_end = prefix_begin + 1;
+    while (prefix_end != records.end() && samePrefix(*prefix_begin, *prefix_end)) ++prefix_end;
+
+    // First, we collect all retention times and intensities
+    set<OpenMS::MSstatsFile::Coordinate> retention_times{};
+    set<OpenMS::MSstatsFile::Intensity> intensities{};
+    for (auto it = prefix_begin; it != prefix_end; ++it)
     {
-      // First, we collect all retention times and intensities
-      set<OpenMS::MSstatsFile::Coordinate> retention_times{};
-      set<OpenMS::MSstatsFile::Intensity> intensities{};
-      for (const auto &p : line.second)
+      if (retention_times.find(it->retention_time) != retention_times.end())
       {
-        if (retention_times.find(get<1>(p)) != retention_times.end())
-        {
-          OPENMS_LOG_WARN << "Peptide ion appears multiple times at the same retention time."
-                             " This is not expected."
-                          << endl;
-        }
-        else
-        {
-          retention_times.insert(get<1>(p));
-          intensities.insert(get<0>(p));
-        }
+        OPENMS_LOG_WARN << "Peptide ion appears multiple times at the same retention time."
+                           " This is not expected."
+                        << endl;
+      }
+      else
+      {
+        retention_times.insert(it->retention_time);
+        intensities.insert(it->intensity);
       }
+    }
 
-      tuple<OpenMS::String, OpenMS::String, OpenMS::String> tpl = make_tuple(
-          line.first.sequence(), line.first.precursor_charge(), line.first.run());
+    const String prefix = make_prefix(*prefix_begin);
 
-      if (peptideseq_precursor_charge_run.find(tpl) != peptideseq_precursor_charge_run.end())
+    // If the rt summarization method is set to manual, we simply output all it,rt pairs
+    if (rt_summarization_manual)
+    {
+      for (auto it = prefix_begin; it != prefix_end; ++it)
       {
-        //TODO What is this doing here??
-        count_similar += 1;
+        //RT, common prefix items, intensity, "unique ID (file+spectrumID)"
+        os << String(it->retention_time) + ',' + prefix + ',' + String(it->intensity) + ','
+              + quote_ + references[it->reference] + quote_ << "\n";
       }
-      peptideseq_precursor_charge_run.insert(tpl);
-
-      // If the rt summarization method is set to manual, we simply output all it,rt pairs
-      if (rt_summarization_manual)
+    }
+    // Otherwise, the intensities are resolved over the retention times
+    else
+    {
+      OpenMS::MSstatsFile::Intensity intensity(0);
+      if (retention_time_summarization_method == "max")
       {
-        for (const auto &ity_rt_file : line.second)
-        {
-          //RT, common prefix items, intensity, "unique ID (file+spectrumID)"
-          csv_out.addLine(
-              String(get<1>(ity_rt_file)) + ',' + line.first.toString() + ',' + String(get<0>(ity_rt_file)) + ','
-              + quote_ + get<2>(ity_rt_file) + quote_);
-        }
+        intensity = *(max_element(intensities.begin(), intensities.end()));
       }
-      // Otherwise, the intensities are resolved over the retention times
-      else
+      else if (retention_time_summarization_method == "min")
       {
-        OpenMS::MSstatsFile::Intensity intensity(0);
-        if (retention_time_summarization_method == "max")
-        {
-          intensity = *(max_element(intensities.begin(), intensities.end()));
-        }
-        else if (retention_time_summarization_method == "min")
-        {
-          intensity = *(min_element(intensities.begin(), intensities.end()));
-        }
-        else if (retention_time_summarization_method == "mean")
-        {
-          intensity = meanIntensity_(intensities);
-        }
-        else if (retention_time_summarization_method == "sum")
-        {
-          intensity = sumIntensity_(intensities);
-        }
-        //common prefix items, aggregated intensity, "unique ID (file of first spectrum in the set of 'same')"
-        //@todo we could collect all spectrum references contributing to this intensity instead
-        csv_out.addLine(
-            line.first.toString() + delim_ + OpenMS::String(intensity) + delim_ + quote_ +
-            get<2>(*line.second.begin()) + quote_);
+        intensity = *(min_element(intensities.begin(), intensities.end()));
+      }
+      else if (retention_time_summarization_method == "mean")
+      {
+        intensity = meanIntensity_(intensities);
       }
+      else if (retention_time_summarization_method == "sum")
+      {
+        intensity = sumIntensity_(intensities);
+      }
+      //common prefix items, aggregated intensity, "unique ID (file of first spectrum in the set of 'same')"
+      //@todo we could collect all spectrum references contributing to this intensity instead
+      os << prefix + delim_ + OpenMS::String(intensity) + delim_ + quote_ +
+            references[prefix_begin->reference] + quote_ << "\n";
     }
+    prefix_begin = prefix_end;
   }
+  os.close();
 }
 
 void OpenMS::MSstatsFile::storeLFQ(const String& filename,
@@ -232,9 +268,6 @@ void OpenMS::MSstatsFile::storeLFQ(const String& filename,
   std::map< pair< String, unsigned>, unsigned > run_map{};
   assembleRunMap_(run_map, design);
 
-  // Maps run in MSstats input to run for OpenMS
-  map< unsigned, unsigned > msstats_run_to_openms_fractiongroup;
-
   // Mapping of filepath and label to sample and fraction
   map< pair< String, unsigned >, unsigned> path_label_to_sample = design.getPathLabelToSampleMapping(true);
   map< pair< String, unsigned >, unsigned> path_label_to_fraction = design.getPathLabelToFractionMapping(true);
@@ -264,11 +297,8 @@ void OpenMS::MSstatsFile::storeLFQ(const String& filename,
   // Determine if the experiment has fractions
   const bool has_fraction = design.isFractionated();
 
-  //vector< OpenMS::BaseFeature> features{};
   vector< String > spectra_paths{};
 
-  //features.reserve(consensus_map.size());
-
   if (reannotate_filenames.empty())
   {
     consensus_map.getPrimaryMSRunPath(spectra_paths);
@@ -300,16 +330,12 @@ void OpenMS::MSstatsFile::storeLFQ(const String& filename,
     throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "The filenames (extension ignored) in the consensusXML file are not the same as in the experimental design");
   }
 
-  // Extract information from the consensus features.
-  OpenMS::MSstatsFile::AggregatedConsensusInfo aggregatedInfo = OpenMS::MSstatsFile::aggregateInfo_(consensus_map, spectra_paths);
-
-  // The output file of the MSstats converter
-  TextFile csv_out;
-  csv_out.addLine(
+  // The header of the MSstats converter output
+  const String header =
     String(rt_summarization_manual ? "RetentionTime,": "") +
     "ProteinName,PeptideSequence,PrecursorCharge,FragmentIon,"
     "ProductCharge,IsotopeLabelType,Condition,BioReplicate,Run," +
-    String(has_fraction ? "Fraction,": "") + "Intensity,Reference");
+    String(has_fraction ? "Fraction,": "") + "Intensity,Reference";
 
   // From the MSstats user guide: endogenous peptides (use "L") or labeled reference peptides (use "H").
   String isotope_label_type = "L";
@@ -351,29 +377,54 @@ void OpenMS::MSstatsFile::storeLFQ(const String& filename,
   // Map protein accession to its indistinguishable group
   std::unordered_map< String, const IndProtGrp* > accession_to_group = getAccessionToGroupMap_(ind_prots);
 
-  // To aggregate/uniquify on peptide sequence-level and save if a peptide is quantifyable
-  std::set<String> peptideseq_quantifyable; //set for deterministic ordering
-
-
-  // Stores all the lines that will be present in the final MSstats output
+  // The MSstats columns only depend on the map of the ConsensusMap, so they are resolved once per map.
+  const auto& column_headers = consensus_map.getColumnHeaders(); // needed for label_id
+  vector<MSstatsColumn_> columns(spectra_paths.size());
+  StringIndex sequences, accessions, charges, references;
+
+  auto resolveColumn = [&](Size map_index) -> MSstatsColumn_&
+  {
+    MSstatsColumn_& c = columns.at(map_index);
+    if (c.resolved) return c;
+
+    const String& current_filename = spectra_paths[map_index];
+    c.reference = references.insert(current_filename);
+
+    // Get the label_id from the file description MetaValue
+    // label id 1 is used in case the experimental design specifies a LFQ experiment
+    //TODO Not really, according to the if-case it only cares about the metavalue.
+    // which could be missing due to other reasons
+    auto &column = column_headers.at(map_index);
+    const unsigned label = column.metaValueExists("channel_id") ? unsigned(OpenMS::Int(column.getMetaValue("channel_id"))) : 1u;
+
+    const pair< String, unsigned> tpl1 = make_pair(current_filename, label);
+    const unsigned sample = path_label_to_sample[tpl1];
+    const unsigned fraction = path_label_to_fraction[tpl1];
+
+    // Resolve run
+    const pair< String, unsigned> tpl2 = make_pair(current_filename, fraction);
+    c.msstats_run = run_map[tpl2];  // MSstats run according to the file table
+    c.fractiongroup = path_label_to_fractiongroup[tpl1];
+    c.run = String(c.msstats_run);
+    c.condition = sampleSection.getFactorValue(sample, condition);
+    c.bioreplicate = sampleSection.getFactorValue(sample, bioreplicate);
+    c.fraction = has_fraction ? String(fraction) : "";
+    c.resolved = true;
+    return c;
+  };
+
+  // Collect one compact record per intensity that will be present in the final MSstats output.
   // Several things needs to be considered:
   // - We need to map peptide sequences to full features, because then we can ignore peptides
   //   that are mapped to multiple proteins.
   // - We also need to map to the intensities, such that we combine intensities over multiple retention times.
-  map< String, map< MSstatsLine_, set< tuple<Intensity, Coordinate, String> > > > peptideseq_to_prefix_to_intensities;
-
-  for (Size i = 0; i < aggregatedInfo.features.size(); ++i)
+  vector<MSstatsRecord_> records;
+  for (const OpenMS::ConsensusFeature& consensus_feature : consensus_map)
   {
-    const OpenMS::BaseFeature &base_feature = aggregatedInfo.features[i];
-
-    for (const OpenMS::PeptideIdentification &pep_id : base_feature.getPeptideIdentifications())
+    for (const OpenMS::PeptideIdentification &pep_id : consensus_feature.getPeptideIdentifications())
     {
       for (const OpenMS::PeptideHit & pep_hit : pep_id.getHits())
       {
-        //TODO Really double check with Meena Choi (MSStats author) or make it an option! I can't find any info
-        // on what is correct. For TMT we include them (since it is necessary) (see occurrence above as well when map is built!)
-        const String & sequence = pep_hit.getSequence().toString(); // to modified string
-
         // check if all referenced protein accessions are part of the same indistinguishable group
         // if so, we mark the sequence as quantifiable
         std::set<String> accs = pep_hit.extractProteinAccessionsSet();
@@ -382,83 +433,89 @@ void OpenMS::MSstatsFile::storeLFQ(const String& filename,
         // we check if the map is already set at this sequence since
         // it cannot happen that to peptides with the same sequence map to different proteins unless something is wrong.
         // Also I think MSstats cannot handle different associations to proteins across conditions.
-        if (isQuantifyable_(accs, accession_to_group))
-        {
-          peptideseq_quantifyable.emplace(sequence);
-        }
-        else
+        if (!isQuantifyable_(accs, accession_to_group))
         {
           continue; // we dont need the rest of the loop
         }
 
+        //TODO Really double check with Meena Choi (MSStats author) or make it an option! I can't find any info
+        // on what is correct. For TMT we include them (since it is necessary) (see occurrence above as well when map is built!)
+        const Size sequence = sequences.insert(pep_hit.getSequence().toString()); // to modified string
+
         // Variables of the peptide hit
         // MSstats User manual 3.7.3: Unknown precursor charge should be set to 0
-        const Int precursor_charge = pep_hit.getCharge();
-
-        // Unused for DDA data anyway
-        String fragment_ion = na_string_;
-        String frag_charge = "0";
+        const Size precursor_charge = charges.insert(String(pep_hit.getCharge()));
 
         String accession  = ListUtils::concatenate(accs,accdelim_);
         if (accession.empty()) accession = na_string_; //shouldn't really matter since we skip unquantifyable peptides
+        const Size accession_id = accessions.insert(accession);
 
         // Write new line for each run
-        for (Size j = 0; j < aggregatedInfo.consensus_feature_filenames[i].size(); j++)
+        for (const FeatureHandle& feat : consensus_feature.getFeatures())
         {
-          const String &current_filename = aggregatedInfo.consensus_feature_filenames[i][j];
-          const Intensity intensity(aggregatedInfo.consensus_feature_intensities[i][j]);
-          const Coordinate retention_time(aggregatedInfo.consensus_feature_retention_times[i][j]);
-          const unsigned label(aggregatedInfo.consensus_feature_labels[i][j]);
-
-          const pair< String, unsigned> tpl1 = make_pair(current_filename, label);
-          const unsigned sample = path_label_to_sample[tpl1];
-          const unsigned fraction = path_label_to_fraction[tpl1];
-
-          const pair< String, unsigned> tpl2 = make_pair(current_filename, fraction);
-
-          // Resolve run
-          const unsigned run = run_map[tpl2];  // MSstats run according to the file table
-          const unsigned openms_fractiongroup = path_label_to_fractiongroup[tpl1];
-          msstats_run_to_openms_fractiongroup[run] = openms_fractiongroup;
-
-          // Assemble MSstats line
-          //TODO since a lot of cols are constant in DDA LFQ, we could reduce the prefix and add the constant
-          // cols on-the-fly during constructFile_ (so we save during checking duplicates)
-          MSstatsLine_ prefix(
-                  has_fraction,
-                  accession,
-                  sequence,
-                  precursor_charge,
-                  fragment_ion,
-                  frag_charge,
-                  isotope_label_type,
-                  sampleSection.getFactorValue(sample, condition),
-                  sampleSection.getFactorValue(sample, bioreplicate),
-                  String(run),
-                  (has_fraction ? String(fraction) : "")
-          );
-          tuple<Intensity, Coordinate, String> intensity_retention_time = make_tuple(intensity, retention_time, current_filename);
-          peptideseq_to_prefix_to_intensities[sequence][prefix].insert(intensity_retention_time);
+          const MSstatsColumn_& c = resolveColumn(feat.getMapIndex());
+          records.push_back(MSstatsRecord_{sequence, accession_id, 0, precursor_charge, 0,
+            feat.getIntensity(), feat.getRT(), c.reference, feat.getMapIndex()});
         }
       }
     }
   }
 
+  // Replace the ids by ranks
+  sequences.finalize();
+  accessions.finalize();
+  charges.finalize();
+  references.finalize();
+  rankColumns_(columns, false);
+  for (MSstatsRecord_& r : records)
+  {
+    r.sequence = sequences.rank(r.sequence);
+    r.accession = accessions.rank(r.accession);
+    r.charge = charges.rank(r.charge);
+    r.reference = references.rank(r.reference);
+    r.key = columns[r.column].key;
+  }
+
   // Print the run mapping between MSstats and OpenMS
+  map< unsigned, unsigned > msstats_run_to_openms_fractiongroup;
+  for (const MSstatsColumn_& c : columns)
+  {
+    if (c.resolved) msstats_run_to_openms_fractiongroup[c.msstats_run] = c.fractiongroup;
+  }
   for (const auto& run_mapping : msstats_run_to_openms_fractiongroup)
   {
     cout << "MSstats run " << String(run_mapping.first)
          << " corresponds to OpenMS fraction group " << String(run_mapping.second) << endl;
   }
 
-  constructFile_(retention_time_summarization_method,
-                 rt_summarization_manual,
-                 csv_out,
-                 peptideseq_quantifyable,
-                 peptideseq_to_prefix_to_intensities);
-
-  // Store the final assembled CSV file
-  csv_out.store(filename);
+  // Unused for DDA data anyway
+  const String fragment_ion = na_string_;
+  const String frag_charge = "0";
+
+  //TODO since a lot of cols are constant in DDA LFQ, we could reduce the prefix and add the constant
+  // cols on-the-fly during storeRecords_
+  storeRecords_(filename,
+                header,
+                retention_time_summarization_method,
+                rt_summarization_manual,
+                records,
+                references.sorted(),
+                [&](const MSstatsRecord_& r)
+                {
+                  const MSstatsColumn_& c = columns[r.column];
+                  return MSstatsLine_(
+                    has_fraction,
+                    accessions.sorted()[r.accession],
+                    sequences.sorted()[r.sequence],
+                    charges.sorted()[r.charge],
+                    fragment_ion,
+                    frag_charge,
+                    isotope_label_type,
+                    c.condition,
+                    c.bioreplicate,
+                    c.run,
+                    c.fraction).toString();
+                });
 }
 
 void OpenMS::MSstatsFile::storeISO(const String& filename,
@@ -495,9 +552,6 @@ void OpenMS::MSstatsFile::storeISO(const String& filename,
     OPENMS_LOG_WARN << "No inference was performed on the first run, defaulting to one-peptide-rule." << std::endl;
   }
 
-  // Maps run in MSstats input to run for OpenMS
-  map< unsigned, unsigned > msstats_run_to_openms_fractiongroup;
-
   // Mapping of filepath and label to sample and fraction
   map< pair< String, unsigned >, unsigned> path_label_to_sample = design.getPathLabelToSampleMapping(true);
   map< pair< String, unsigned >, unsigned> path_label_to_fraction = design.getPathLabelToFractionMapping(true);
@@ -524,11 +578,8 @@ void OpenMS::MSstatsFile::storeISO(const String& filename,
     design_filenames.push_back(fn);
   }
 
-  vector< OpenMS::BaseFeature> features;
   vector< String > spectra_paths;
 
-  features.reserve(consensus_map.size());
-
   if (reannotate_filenames.empty())
   {
     consensus_map.getPrimaryMSRunPath(spectra_paths);
@@ -560,13 +611,9 @@ void OpenMS::MSstatsFile::storeISO(const String& filename,
     throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "The filenames (extension ignored) in the consensusXML file are not the same as in the experimental design");
   }
 
-  // Extract information from the consensus features.
-  OpenMS::MSstatsFile::AggregatedConsensusInfo AggregatedInfo = OpenMS::MSstatsFile::aggregateInfo_(consensus_map, spectra_paths);
-
-  // The output file of the MSstatsConverter
-  TextFile csv_out;
-  csv_out.addLine(String(rt_summarization_manual ? "RetentionTime,": "") +
-    "ProteinName,PeptideSequence,Charge,Channel,Condition,BioReplicate,Run,Mixture,TechRepMixture,Fraction,Intensity,Reference");
+  // The header of the MSstatsConverter output
+  const String header = String(rt_summarization_manual ? "RetentionTime,": "") +
+    "ProteinName,PeptideSequence,Charge,Channel,Condition,BioReplicate,Run,Mixture,TechRepMixture,Fraction,Intensity,Reference";
 
   // We quantify indistinguishable groups with one (corner case) or multiple proteins.
   // If indistinguishable groups are not annotated (no inference or only trivial inference has been performed) we assume
@@ -577,19 +624,48 @@ void OpenMS::MSstatsFile::storeISO(const String& filename,
   // Map protein accession to its indistinguishable group
   std::unordered_map< String, const IndProtGrp* > accession_to_group = getAccessionToGroupMap_(ind_prots);
 
-  std::set<String> peptideseq_quantifyable; //set for deterministic ordering
-
-  // Stores all the lines that will be present in the final MSstats output,
+  // The MSstats columns only depend on the map of the ConsensusMap, so they are resolved once per map.
+  const auto& column_headers = consensus_map.getColumnHeaders(); // needed for label_id
+  vector<MSstatsColumn_> columns(spectra_paths.size());
+  StringIndex sequences, accessions, charges, references;
+
+  auto resolveColumn = [&](Size map_index) -> MSstatsColumn_&
+  {
+    MSstatsColumn_& c = columns.at(map_index);
+    if (c.resolved) return c;
+
+    const String& current_filename = spectra_paths[map_index];
+
+    // Get the label_id from the file description MetaValue, label id 1 if missing
+    auto &column = column_headers.at(map_index);
+    const unsigned label = column.metaValueExists("channel_id") ? unsigned(OpenMS::Int(column.getMetaValue("channel_id"))) : 1u;
+    const unsigned channel(label + 1);
+
+    const pair< String, unsigned> tpl1 = make_pair(current_filename, channel);
+    const unsigned sample = path_label_to_sample[tpl1];
+    const unsigned fraction = path_label_to_fraction[tpl1];
+
+    // Resolve techrepmixture, run
+    c.fractiongroup = path_label_to_fractiongroup[tpl1];
+    c.techrepmixture = String(sampleSection.getFactorValue(sample, mixture)) + "_" + String(c.fractiongroup);
+    c.run = c.techrepmixture + "_" + String(fraction);
+    c.channel = String(channel);
+    c.condition = sampleSection.getFactorValue(sample, condition);
+    c.bioreplicate = sampleSection.getFactorValue(sample, bioreplicate);
+    c.mixture = sampleSection.getFactorValue(sample, mixture);
+    c.fraction = String(fraction);
+    c.resolved = true;
+    return c;
+  };
+
+  // Collect one compact record per intensity that will be present in the final MSstats output.
   // We need to map peptide sequences to full features, because then we can ignore peptides
   // that are mapped to multiple proteins. We also need to map to the
   // intensities, such that we combine intensities over multiple retention times.
-  map< String, map< MSstatsTMTLine_, set< tuple<Intensity, Coordinate, String> > > > peptideseq_to_prefix_to_intensities;
-
-  for (Size i = 0; i < AggregatedInfo.features.size(); ++i)
+  vector<MSstatsRecord_> records;
+  for (const OpenMS::ConsensusFeature& consensus_feature : consensus_map)
   {
-    const OpenMS::BaseFeature &base_feature = AggregatedInfo.features[i];
-
-    for (const OpenMS::PeptideIdentification &pep_id : base_feature.getPeptideIdentifications())
+    for (const OpenMS::PeptideIdentification &pep_id : consensus_feature.getPeptideIdentifications())
     {
       String nativeID = "NONATIVEID";
       if (pep_id.metaValueExists("spectrum_reference"))
@@ -599,11 +675,6 @@ void OpenMS::MSstatsFile::storeISO(const String& filename,
 
       for (const OpenMS::PeptideHit & pep_hit : pep_id.getHits())
       {
-        // Variables of the peptide hit
-        // MSstats User manual 3.7.3: Unknown precursor charge should be set to 0
-        const Int precursor_charge = (std::max)(pep_hit.getCharge(), 0);
-        const String & sequence = pep_hit.getSequence().toString();
-
         // check if all referenced protein accessions are part of the same indistinguishable group
         // if so, we mark the sequence as quantifiable
         std::set<String> accs = pep_hit.extractProteinAccessionsSet();
@@ -611,77 +682,74 @@ void OpenMS::MSstatsFile::storeISO(const String& filename,
         // When using extractProteinAccessionSet, we do not really need to loop over Evidences
         // anymore since MSStats does not care about anything else but the Protein accessions
 
-        if (isQuantifyable_(accs, accession_to_group))
-        {
-          peptideseq_quantifyable.emplace(sequence);
-        }
-        else
+        if (!isQuantifyable_(accs, accession_to_group))
         {
           continue; // we dont need the rest of the loop
         }
 
+        // Variables of the peptide hit
+        // MSstats User manual 3.7.3: Unknown precursor charge should be set to 0
+        const Size precursor_charge = charges.insert(String((std::max)(pep_hit.getCharge(), 0)));
+        const Size sequence = sequences.insert(pep_hit.getSequence().toString());
+
         String accession = ListUtils::concatenate(accs,accdelim_);
         if (accession.empty()) accession = na_string_; //shouldn't really matter since we skip unquantifyable peptides
+        const Size accession_id = accessions.insert(accession);
 
         // Write new line for each run
-        for (Size j = 0; j < AggregatedInfo.consensus_feature_filenames[i].size(); j++)
+        for (const FeatureHandle& feat : consensus_feature.getFeatures())
         {
-          const String &current_filename = AggregatedInfo.consensus_feature_filenames[i][j];
-
-          const Intensity intensity(AggregatedInfo.consensus_feature_intensities[i][j]);
-          const Coordinate retention_time(AggregatedInfo.consensus_feature_retention_times[i][j]);
-          const unsigned channel(AggregatedInfo.consensus_feature_labels[i][j] + 1);
-
-          const pair< String, unsigned> tpl1 = make_pair(current_filename, channel);
-          const unsigned sample = path_label_to_sample[tpl1];
-          const unsigned fraction = path_label_to_fraction[tpl1];
-
-          // Resolve techrepmixture, run
-          const unsigned openms_fractiongroup = path_label_to_fractiongroup[tpl1];
-          String techrepmixture = String(sampleSection.getFactorValue(sample, mixture)) + "_" + String(openms_fractiongroup);
-          String run = techrepmixture + "_" + String(fraction);
-
-          // Assemble MSstats line
-          MSstatsTMTLine_ prefix(
-              accession,
-              sequence,
-              precursor_charge,
-              String(channel),
-              sampleSection.getFactorValue(sample, condition),
-              sampleSection.getFactorValue(sample, bioreplicate),
-              String(run),
-              sampleSection.getFactorValue(sample, mixture),
-              String(techrepmixture),
-              String(fraction)
-          );
-
-          String identifier = current_filename;
+          resolveColumn(feat.getMapIndex());
+
+          String identifier = spectra_paths[feat.getMapIndex()];
           if (rt_summarization_manual)
           {
             identifier += "_" + nativeID;
           }
-          tuple<Intensity, Coordinate, String> intensity_retention_time = make_tuple(intensity, retention_time, identifier);
-          peptideseq_to_prefix_to_intensities[sequence][prefix].insert(intensity_retention_time);
+          records.push_back(MSstatsRecord_{sequence, accession_id, 0, precursor_charge, 0,
+            feat.getIntensity(), feat.getRT(), references.insert(identifier), feat.getMapIndex()});
         }
       }
     }
   }
 
-  // Print the run mapping between MSstats and OpenMS
-  for (const auto& run_mapping : msstats_run_to_openms_fractiongroup)
-  {
-    cout << "MSstats run " << String(run_mapping.first)
-         << " corresponds to OpenMS TechRepMixture " << String(run_mapping.second) << endl;
-  }
-
-  constructFile_(retention_time_summarization_method,
-                 rt_summarization_manual,
-                 csv_out,
-                 peptideseq_quantifyable,
-                 peptideseq_to_prefix_to_intensities);
-
-  // Store the final assembled CSV file
-  csv_out.store(filename);
+  // Replace the ids by ranks
+  sequences.finalize();
+  accessions.finalize();
+  charges.finalize();
+  references.finalize();
+  rankColumns_(columns, true);
+  for (MSstatsRecord_& r : records)
+  {
+    r.sequence = sequences.rank(r.sequence);
+    r.accession = accessions.rank(r.accession);
+    r.charge = charges.rank(r.charge);
+    r.reference = references.rank(r.reference);
+    r.key = columns[r.column].key;
+    r.channel = columns[r.column].channel_rank;
+  }
+
+  storeRecords_(filename,
+                header,
+                retention_time_summarization_method,
+                rt_summarization_manual,
+                records,
+                references.sorted(),
+                [&](const MSstatsRecord_& r)
+                {
+                  const MSstatsColumn_& c = columns[r.column];
+                  return MSstatsTMTLine_(
+                    accessions.sorted()[r.accession],
+                    sequences.sorted()[r.sequence],
+                    charges.sorted()[r.charge],
+                    c.channel,
+                    c.condition,
+                    c.bioreplicate,
+                    c.run,
+                    c.mixture,
+                    c.techrepmixture,
+                    c.fraction).toString();
+                });
 }
 
 bool OpenMS::MSstatsFile::checkUnorderedContent_(const std::vector<String> &first, const std::vector<String> &second)
@@ -56,7 +56,14 @@ namespace OpenMS
   void MzIdentMLFile::load(const String& filename, std::vector<ProteinIdentification>& poid, std::vector<PeptideIdentification>& peid)
   {
     Internal::MzIdentMLDOMHandler handler(poid, peid, schema_version_, *this);
-    handler.readMzIdentMLFile(filename);
+    handler.streamMzIdentMLFile(filename);
+  }
+
+  void MzIdentMLFile::load(const String& filename, std::vector<ProteinIdentification>& poid, const std::function<void(std::vector<PeptideIdentification>&)>& pep_id_callback, Size batch_size)
+  {
+    std::vector<PeptideIdentification> peid;
+    Internal::MzIdentMLDOMHandler handler(poid, peid, schema_version_, *this);
+    handler.streamMzIdentMLFile(filename, pep_id_callback, batch_size);
   }
 
   void MzIdentMLFile::store(const String& filename, const Identification& id) const
@@ -85,12 +92,7 @@ namespace OpenMS
     CVMappingFile().load(File::find("/MAPPING/mzIdentML-mapping.xml"), mapping);
 
     //load cvs
-    ControlledVocabulary cv;
-    cv.loadFromOBO("MS", File::find("/CV/psi-ms.obo"));
-    cv.loadFromOBO("PATO", File::find("/CV/quality.obo"));
-    cv.loadFromOBO("UO", File::find("/CV/unit.obo"));
-    cv.loadFromOBO("BTO", File::find("/CV/brenda.obo"));
-    cv.loadFromOBO("GO", File::find("/CV/goslim_goa.obo"));
+    const ControlledVocabulary& cv = ControlledVocabulary::getPSIMSCV();
 
     //validate
     Internal::MzIdentMLValidator v(mapping, cv);
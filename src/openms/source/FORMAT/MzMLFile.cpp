@@ -105,12 +105,7 @@ namespace OpenMS
     CVMappingFile().load(File::find("/MAPPING/ms-mapping.xml"), mapping);
 
     // load cvs
-    ControlledVocabulary cv;
-    cv.loadFromOBO("MS", File::find("/CV/psi-ms.obo"));
-    cv.loadFromOBO("PATO", File::find("/CV/quality.obo"));
-    cv.loadFromOBO("UO", File::find("/CV/unit.obo"));
-    cv.loadFromOBO("BTO", File::find("/CV/brenda.obo"));
-    cv.loadFromOBO("GO", File::find("/CV/goslim_goa.obo"));
+    const ControlledVocabulary& cv = ControlledVocabulary::getPSIMSCV();
 
     // validate
     Internal::MzMLValidator v(mapping, cv);
@@ -0,0 +1,147 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/MzMLFollower.h>
+
+#include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <fstream>
+
+namespace OpenMS
+{
+
+  MzMLFollower::MzMLFollower(const String& filename) :
+    filename_(filename)
+  {
+  }
+
+  PeakFileOptions& MzMLFollower::getOptions()
+  {
+    return mzml_.getOptions();
+  }
+
+  bool MzMLFollower::isComplete() const
+  {
+    return complete_;
+  }
+
+  Size MzMLFollower::getNrSpectra() const
+  {
+    return nr_spectra_;
+  }
+
+  std::string MzMLFollower::extractSpectra_(Size& count)
+  {
+    count = 0;
+    Size end = 0;
+    while (true)
+    {
+      // '<spectrum ' (with blank) does not match '<spectrumList'
+      Size start = buffer_.find("<spectrum ", end);
+      if (start == std::string::npos) break;
+      Size stop = buffer_.find("</spectrum>", start);
+      if (stop == std::string::npos) break; // still being written
+      end = stop + std::string("</spectrum>").size();
+      ++count;
+    }
+    if (buffer_.find("</spectrumList>", end) != std::string::npos)
+    {
+      complete_ = true;
+    }
+    std::string spectra = buffer_.substr(0, end);
+    buffer_.erase(0, end);
+    return spectra;
+  }
+
+  Size MzMLFollower::poll(Interfaces::IMSDataConsumer* consumer)
+  {
+    if (complete_ || !File::exists(filename_)) return 0;
+
+    std::ifstream is(filename_.c_str(), std::ios::binary);
+    if (!is)
+    {
+      throw Exception::FileNotReadable(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_);
+    }
+    is.seekg(0, std::ios::end);
+    std::streamoff size = is.tellg();
+    if (size < offset_)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_, "File was truncated while following it.");
+    }
+    if (size == offset_) return 0;
+
+    // read everything that was appended
+    is.seekg(offset_);
+    Size old_size = buffer_.size();
+    buffer_.resize(old_size + Size(size - offset_));
+    is.read(&buffer_[old_size], size - offset_);
+    buffer_.resize(old_size + Size(is.gcount()));
+    offset_ += is.gcount();
+
+    if (header_.empty())
+    {
+      Size list_start = buffer_.find("<spectrumList");
+      Size list_tag_end = (list_start == std::string::npos) ? std::string::npos : buffer_.find('>', list_start);
+      if (list_tag_end == std::string::npos) return 0; // header not written yet
+
+      header_ = buffer_.substr(0, list_tag_end + 1);
+      buffer_.erase(0, list_tag_end + 1);
+      footer_ = "</spectrumList></run></mzML>";
+      if (header_.find("<indexedmzML") != std::string::npos)
+      {
+        footer_ += "</indexedmzML>";
+      }
+    }
+
+    Size count;
+    std::string spectra = extractSpectra_(count);
+    if (count == 0) return 0;
+
+    PeakMap batch;
+    mzml_.loadBuffer(header_ + spectra + footer_, batch);
+    if (!settings_sent_)
+    {
+      consumer->setExperimentalSettings(batch);
+      settings_sent_ = true;
+    }
+    for (auto& spec : batch)
+    {
+      consumer->consumeSpectrum(spec);
+    }
+    nr_spectra_ += count;
+    return count;
+  }
+
+} // namespace OpenMS
@@ -39,6 +39,9 @@
 
 #include <boost/regex.hpp>
 
+#include <fstream>
+#include <memory>
+
 using namespace std;
 
 // TODO fix all the shadowed "String s"
@@ -47,6 +50,88 @@ using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /**
+      @brief Writes mzTab lines one by one through a large stream buffer
+
+      Lines are written as soon as they are generated, so no complete copy
+      of the file is held in memory. For files which were loaded before,
+      the original empty and comment lines are re-inserted at their line
+      numbers (like TextFile::store, existing line endings are kept).
+      The member is called push_back() so MzTabFile::generateMzTabSection_()
+      can write into it directly.
+    */
+    class MzTabLineWriter_
+    {
+  public:
+      MzTabLineWriter_(const String& filename, const vector<Size>& empty_rows = vector<Size>(), const map<Size, String>& comment_rows = map<Size, String>()) :
+        filename_(filename),
+        buffer_(new char[BUFFER_SIZE]),
+        empty_rows_(empty_rows),
+        comment_rows_(comment_rows)
+      {
+        // the buffer has to be set before the file is opened
+        stream_.rdbuf()->pubsetbuf(buffer_.get(), BUFFER_SIZE);
+        stream_.open(filename.c_str(), ios::out | ios::trunc);
+        if (!stream_)
+        {
+          throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+        }
+      }
+
+      void push_back(const String& line)
+      {
+        if (!empty_rows_.empty() || !comment_rows_.empty())
+        {
+          while (true) // check if current line was originally an empty or comment line
+          {
+            if (std::binary_search(empty_rows_.begin(), empty_rows_.end(), line_))
+            {
+              write_("\n");
+            }
+            else
+            {
+              map<Size, String>::const_iterator comment = comment_rows_.find(line_);
+              if (comment == comment_rows_.end()) break;
+              write_(comment->second);
+            }
+            ++line_;
+          }
+        }
+        write_(line);
+        ++line_;
+      }
+
+      void close()
+      {
+        stream_.close();
+        if (stream_.fail())
+        {
+          throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_, "error while writing");
+        }
+      }
+
+  private:
+      static const size_t BUFFER_SIZE = 1 << 20;
+
+      void write_(const String& line)
+      {
+        size_t length = line.size();
+        if (line.hasSuffix("\r\n")) length -= 2; // stream is not opened in binary mode: "\n" is platform dependent
+        else if (line.hasSuffix("\n")) length -= 1;
+        stream_.write(line.c_str(), length);
+        stream_.put('\n');
+      }
+
+      String filename_;
+      std::unique_ptr<char[]> buffer_;
+      ofstream stream_;
+      vector<Size> empty_rows_;
+      map<Size, String> comment_rows_;
+      Size line_ = 0;
+    };
+  }
 
   MzTabFile::MzTabFile():
   store_protein_reliability_(false),
@@ -2916,8 +3001,7 @@ namespace OpenMS
     vector<const ProteinIdentification*> prot_ids_ptr;
     for (const ProteinIdentification& pi : protein_identifications) { prot_ids_ptr.push_back(&pi); }
 
-    ofstream tab_file;
-    tab_file.open(filename, ios::out | ios::trunc);
+    MzTabLineWriter_ tab_file(filename);
 
     MzTab::IDMzTabStream s(
       prot_ids_ptr,
@@ -2933,7 +3017,7 @@ namespace OpenMS
     {
       StringList out;
       generateMzTabMetaDataSection_(meta_data, out);
-      for (const String & line : out) { tab_file << line << "\n"; }
+      for (const String & line : out) { tab_file.push_back(line); }
     }
    
     Size n_best_search_engine_score = meta_data.protein_search_engine_score.size();
@@ -2946,16 +3030,17 @@ namespace OpenMS
       {
         if (first)
         { // add header
-          tab_file << "\n" << generateMzTabProteinHeader_(
+          tab_file.push_back("");
+          tab_file.push_back(generateMzTabProteinHeader_(
             row,
             n_best_search_engine_score,
             s.getProteinOptionalColumnNames(),
             meta_data,
-            n_header_columns) + "\n";
+            n_header_columns));
           first = false;
         }
         size_t n_section_columns = 0;
-        tab_file << generateMzTabSectionRow_(row, s.getProteinOptionalColumnNames(), meta_data, n_section_columns) + "\n";
+        tab_file.push_back(generateMzTabSectionRow_(row, s.getProteinOptionalColumnNames(), meta_data, n_section_columns));
         if (n_header_columns != n_section_columns)  throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Protein header and content differs in columns. Please report this bug to the OpenMS developers.");
       }
     }
@@ -2975,11 +3060,12 @@ namespace OpenMS
       {
         if (first)
         { // add header
-          tab_file << "\n" << generateMzTabPSMHeader_(n_search_engine_scores, s.getPSMOptionalColumnNames(), n_header_columns) + "\n";
+          tab_file.push_back("");
+          tab_file.push_back(generateMzTabPSMHeader_(n_search_engine_scores, s.getPSMOptionalColumnNames(), n_header_columns));
           first = false;
         }
         size_t n_section_columns = 0;
-        tab_file << generateMzTabSectionRow_(row, s.getPSMOptionalColumnNames(), meta_data, n_section_columns) + "\n";
+        tab_file.push_back(generateMzTabSectionRow_(row, s.getPSMOptionalColumnNames(), meta_data, n_section_columns));
         if (n_header_columns != n_section_columns)  throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "PSM header and content differs in columns. Please report this bug to the OpenMS developers.");
       }
     }
@@ -2995,7 +3081,8 @@ namespace OpenMS
       const bool export_unidentified_features,
       const bool export_unassigned_ids,
       const bool export_subfeatures,
-      const bool export_empty_pep_ids) const
+      const bool export_empty_pep_ids,
+      const String& title) const
   {
     if (!(FileHandler::hasValidExtension(filename, FileTypes::MZTAB) || FileHandler::hasValidExtension(filename, FileTypes::TSV)))
     {
@@ -3003,8 +3090,7 @@ namespace OpenMS
       + FileTypes::typeToName(FileTypes::MZTAB) + "' or '" + FileTypes::typeToName(FileTypes::TSV) + "'");
     }
 
-    ofstream tab_file;
-    tab_file.open(filename, ios::out | ios::trunc);
+    MzTabLineWriter_ tab_file(filename);
 
     MzTab::CMMzTabStream s(
       cmap,
@@ -3014,7 +3100,7 @@ namespace OpenMS
       export_unassigned_ids,
       export_subfeatures,
       export_empty_pep_ids,
-      "ConsensusMap export from OpenMS");      
+      title);
 
     // generate full meta data section and write to file
     MzTabMetaData meta_data = s.getMetaData();
@@ -3022,7 +3108,7 @@ namespace OpenMS
     {
       StringList out;
       generateMzTabMetaDataSection_(meta_data, out);
-      for (const String & line : out) { tab_file << line << "\n"; }
+      for (const String & line : out) { tab_file.push_back(line); }
     }
    
     Size n_best_search_engine_score = meta_data.protein_search_engine_score.size();
@@ -3036,16 +3122,17 @@ namespace OpenMS
       {
         if (first)
         { // add header
-          tab_file << "\n" << generateMzTabProteinHeader_(
+          tab_file.push_back("");
+          tab_file.push_back(generateMzTabProteinHeader_(
             row,
             n_best_search_engine_score,
             s.getProteinOptionalColumnNames(),
             meta_data, 
-            n_header_columns) + "\n";
+            n_header_columns));
           first = false;
         }
         size_t n_section_columns = 0;
-        tab_file << generateMzTabSectionRow_(row, s.getProteinOptionalColumnNames(), meta_data, n_section_columns) + "\n";
+        tab_file.push_back(generateMzTabSectionRow_(row, s.getProteinOptionalColumnNames(), meta_data, n_section_columns));
         if (n_header_columns != n_section_columns)  throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Protein header and content differs in columns. Please report this bug to the OpenMS developers.");
       }
     }
@@ -3068,11 +3155,12 @@ namespace OpenMS
           OPENMS_LOG_DEBUG << "Exporting study variables: " << study_variables << endl;
           OPENMS_LOG_DEBUG << "Exporting search engines scores: " << n_search_engine_score << endl;
           Size n_best_search_engine_score = row.best_search_engine_score.size();
-          tab_file << "\n" << generateMzTabPeptideHeader_(search_ms_runs, n_best_search_engine_score, n_search_engine_score, assays, study_variables, s.getPeptideOptionalColumnNames(), n_header_columns) + "\n";
+          tab_file.push_back("");
+          tab_file.push_back(generateMzTabPeptideHeader_(search_ms_runs, n_best_search_engine_score, n_search_engine_score, assays, study_variables, s.getPeptideOptionalColumnNames(), n_header_columns));
           first = false;
         }
         size_t n_section_columns = 0;
-        tab_file << generateMzTabSectionRow_(row, s.getPeptideOptionalColumnNames(), meta_data, n_section_columns) + "\n";
+        tab_file.push_back(generateMzTabSectionRow_(row, s.getPeptideOptionalColumnNames(), meta_data, n_section_columns));
         if (n_header_columns != n_section_columns)
         {
           OPENMS_LOG_ERROR << "Number of columns in header/section: " << n_header_columns << "/" << n_section_columns << endl;
@@ -3099,11 +3187,12 @@ namespace OpenMS
       {
         if (first)
         { // add header
-          tab_file << "\n" << generateMzTabPSMHeader_(n_search_engine_scores, s.getPSMOptionalColumnNames(), n_header_columns) + "\n";
+          tab_file.push_back("");
+          tab_file.push_back(generateMzTabPSMHeader_(n_search_engine_scores, s.getPSMOptionalColumnNames(), n_header_columns));
           first = false;
         }
         size_t n_section_columns = 0;
-        tab_file << generateMzTabSectionRow_(row, s.getPSMOptionalColumnNames(), meta_data, n_section_columns) + "\n";
+        tab_file.push_back(generateMzTabSectionRow_(row, s.getPSMOptionalColumnNames(), meta_data, n_section_columns));
         if (n_header_columns != n_section_columns)  throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "PSM header and content differs in columns. Please report this bug to the OpenMS developers.");
       }
     }
@@ -3119,8 +3208,13 @@ namespace OpenMS
       + FileTypes::typeToName(FileTypes::MZTAB) + "' or '" + FileTypes::typeToName(FileTypes::TSV) + "'");
     }
 
-    StringList out;
-    generateMzTabMetaDataSection_(mz_tab.getMetaData(), out);
+    // lines are written as they are generated, restoring empty lines and comments (might provide critical cues for human reader)
+    MzTabLineWriter_ out(filename, mz_tab.getEmptyRows(), mz_tab.getCommentRows());
+    {
+      StringList meta_data;
+      generateMzTabMetaDataSection_(mz_tab.getMetaData(), meta_data);
+      for (const String& line : meta_data) { out.push_back(line); }
+    }
     bool complete = (mz_tab.getMetaData().mz_tab_mode.toCellString() == "Complete");
     Size ms_runs = mz_tab.getMetaData().ms_run.size();
 
@@ -3292,44 +3386,7 @@ namespace OpenMS
       generateMzTabSection_(mz_tab.getOSMSectionRows(), mz_tab.getOSMOptionalColumnNames(), mz_tab.getMetaData(), out, n_columns);
   }
 
-    // insert comments (might provide critical cues for human reader) and empty lines
-  Size line = 0;
-  vector<Size> empty_rows = mz_tab.getEmptyRows();
-  map<Size, String> comment_rows = mz_tab.getCommentRows();
-
-  if (empty_rows.empty() && comment_rows.empty())
-  {
-    TextFile tmp_out;
-    for (TextFile::ConstIterator it = out.begin(); it != out.end(); ++it)
-    {
-      tmp_out.addLine(*it);
-    }
-    tmp_out.store(filename);
-  }
-  else
-  {
-    TextFile tmp_out;
-    for (TextFile::ConstIterator it = out.begin(); it != out.end(); )
-    {
-      if (std::binary_search(empty_rows.begin(), empty_rows.end(), line))  // check if current line was originally an empty line
-      {
-        tmp_out.addLine("\n");
-        ++line;
-      }
-      else if (comment_rows.find(line) != comment_rows.end()) // check if current line was originally a comment line
-      {
-        tmp_out.addLine(comment_rows[line]);
-        ++line;
-      }
-      else   // no empty line, no comment => add row
-      {
-        tmp_out.addLine(*it);
-        ++line;
-        ++it;
-      }
-    }
-    tmp_out.store(filename);
-  }
+    out.close();
   }
 
 }
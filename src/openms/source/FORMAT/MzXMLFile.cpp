@@ -36,10 +36,78 @@
 
 #include <OpenMS/FORMAT/HANDLERS/MzXMLHandler.h>
 
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <unordered_map>
+
 using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// reads the '<index name="scan">' at the end of an mzXML file (scan number -> byte offset) and the offset of the index itself
+    bool readScanIndex(const String& filename, unordered_map<String, UInt64>& offsets, UInt64& index_offset)
+    {
+      ifstream in(filename.c_str(), ios::binary);
+      if (!in) return false;
+      in.seekg(0, ios::end);
+      const UInt64 file_size = in.tellg();
+
+      // '<indexOffset>' is the last element before '</mzXML>'
+      String tail(std::min(file_size, UInt64(1024)), ' ');
+      in.seekg(file_size - tail.size());
+      in.read(&tail[0], tail.size());
+      Size pos = tail.rfind("<indexOffset>");
+      if (!in || pos == String::npos) return false;
+      pos += 13;
+      Size pos_end = tail.find('<', pos);
+      if (pos_end == String::npos) return false;
+      try
+      {
+        index_offset = boost::lexical_cast<UInt64>(tail.substr(pos, pos_end - pos).trim());
+      }
+      catch (boost::bad_lexical_cast&)
+      {
+        return false;
+      }
+      if (index_offset == 0 || index_offset >= file_size) return false;
+
+      String index(file_size - index_offset, ' ');
+      in.seekg(index_offset);
+      in.read(&index[0], index.size());
+      if (!in || !index.hasPrefix("<index")) return false;
+      Size index_end = index.find("</index>");
+      if (index_end == String::npos) return false;
+      const String index_tag = index.prefix(index.find('>'));
+      if (!index_tag.hasSubstring("scan")) return false;
+
+      // '<offset id = "1" >1234</offset>'
+      for (pos = index.find("<offset"); pos < index_end; pos = index.find("<offset", pos_end))
+      {
+        Size tag_end = index.find('>', pos);
+        pos_end = index.find("</offset>", tag_end);
+        if (tag_end == String::npos || pos_end == String::npos) return false;
+        String tag = index.substr(pos, tag_end - pos);
+        Size id_begin = tag.find_first_of("\"'", tag.find("id"));
+        Size id_end = (id_begin == String::npos) ? String::npos : tag.find(tag[id_begin], id_begin + 1);
+        if (id_end == String::npos) return false;
+        try
+        {
+          offsets[tag.substr(id_begin + 1, id_end - id_begin - 1)] = boost::lexical_cast<UInt64>(index.substr(tag_end + 1, pos_end - tag_end - 1).trim());
+        }
+        catch (boost::bad_lexical_cast&)
+        {
+          return false;
+        }
+      }
+      return !offsets.empty();
+    }
+  }
+
   MzXMLFile::MzXMLFile() :
     XMLFile("/SCHEMAS/mzXML_idx_3.1.xsd", "3.1")
   {
@@ -72,11 +140,91 @@ namespace OpenMS
     map.setLoadedFileType(filename);
     map.setLoadedFilePath(filename);
 
+    if (options_.getFillData() && !options_.getMetadataOnly())
+    {
+      if (loadIndexed_(filename, map))
+      {
+        return;
+      }
+      // no (usable) index => start over with the sequential parser
+      map.reset();
+      map.setLoadedFileType(filename);
+      map.setLoadedFilePath(filename);
+    }
+
     Internal::MzXMLHandler handler(map, filename, schema_version_, *this);
     handler.setOptions(options_);
     parse_(filename, &handler);
   }
 
+  bool MzXMLFile::loadIndexed_(const String& filename, MapType& map)
+  {
+    unordered_map<String, UInt64> offsets;
+    UInt64 index_offset(0);
+    if (!readScanIndex(filename, offsets, index_offset))
+    {
+      return false;
+    }
+
+    // first pass: meta data of all scans passing the filters, no peak data
+    PeakFileOptions meta_options(options_);
+    meta_options.setFillData(false);
+    Internal::MzXMLHandler handler(map, filename, schema_version_, *this);
+    handler.setOptions(meta_options);
+    parse_(filename, &handler);
+
+    // byte range of each spectrum: up to the next scan (nested or not) or the index
+    vector<UInt64> sorted_offsets;
+    sorted_offsets.reserve(offsets.size() + 1);
+    for (const auto& o : offsets) sorted_offsets.push_back(o.second);
+    sorted_offsets.push_back(index_offset);
+    sort(sorted_offsets.begin(), sorted_offsets.end());
+
+    vector<pair<UInt64, UInt64> > ranges(map.size());
+    for (Size i = 0; i < map.size(); ++i)
+    {
+      const String& native_id = map[i].getNativeID();
+      auto it = native_id.hasPrefix("scan=") ? offsets.find(native_id.substr(5)) : offsets.end();
+      if (it == offsets.end() || it->second >= index_offset)
+      {
+        return false;
+      }
+      ranges[i].first = it->second;
+      ranges[i].second = *upper_bound(sorted_offsets.begin(), sorted_offsets.end(), it->second);
+    }
+
+    // second pass: every thread reads and decodes its scans through its own file handle
+    handler.setOptions(options_);
+    std::atomic<size_t> err_count{0};
+#pragma omp parallel
+    {
+      ifstream in(filename.c_str(), ios::binary);
+      String scan_xml;
+#pragma omp for schedule(dynamic, 16)
+      for (SignedSize i = 0; i < (SignedSize)ranges.size(); ++i)
+      {
+        if (err_count) continue; // no need to decode further if already an error was encountered
+        try
+        {
+          scan_xml.resize(ranges[i].second - ranges[i].first);
+          in.seekg(ranges[i].first);
+          in.read(&scan_xml[0], scan_xml.size());
+          if (!in)
+          {
+            throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Index offset beyond end of file");
+          }
+          handler.decodeScanPeaks(scan_xml, map[i]);
+        }
+        catch (...)
+        {
+          ++err_count;
+        }
+      }
+    }
+    // a broken index is not fatal: fall back to the sequential parser
+    return err_count == 0;
+  }
+
   void MzXMLFile::store(const String & filename, const MapType & map) const
   {
     Internal::MzXMLHandler handler(map, filename, schema_version_, *this);
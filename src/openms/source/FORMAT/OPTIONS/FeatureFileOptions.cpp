@@ -45,7 +45,9 @@ namespace OpenMS
     has_rt_range_(false),
     has_mz_range_(false),
     has_intensity_range_(false),
-    size_only_(false)
+    size_only_(false),
+    write_range_index_(false),
+    use_range_index_(true)
   {
   }
 
@@ -141,4 +143,24 @@ namespace OpenMS
     return intensity_range_;
   }
 
+  void FeatureFileOptions::setWriteRangeIndex(bool write)
+  {
+    write_range_index_ = write;
+  }
+
+  bool FeatureFileOptions::getWriteRangeIndex() const
+  {
+    return write_range_index_;
+  }
+
+  void FeatureFileOptions::setUseRangeIndex(bool use)
+  {
+    use_range_index_ = use;
+  }
+
+  bool FeatureFileOptions::getUseRangeIndex() const
+  {
+    return use_range_index_;
+  }
+
 } // namespace OpenMS
@@ -34,12 +34,15 @@
 
 #include <OpenMS/FORMAT/OSWFile.h>
 
+#include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/FORMAT/SqliteConnector.h>
+#include <OpenMS/SYSTEM/File.h>
 
 #include <sqlite3.h>
 
 #include <cstring> // for strcmp
-#include <sstream>
+#include <fstream>
+#include <unordered_map>
 
 namespace OpenMS
 {
@@ -56,7 +59,7 @@ namespace OpenMS
 
   void OSWFile::read(const std::string& in_osw,
                      const std::string& osw_level,
-                     std::stringstream& pin_output,
+                     std::ostream& pin_output,
                      const double& ipf_max_peakgroup_pep,
                      const double& ipf_max_transition_isotope_overlap,
                      const double& ipf_min_transition_sn)
@@ -107,74 +110,79 @@ namespace OpenMS
       conn.prepareStatement(&stmt, select_sql);
       sqlite3_step(stmt);
 
+      // find the columns once (if a name occurs several times, the last column is used); the features are written
+      // sorted by name
       int cols = sqlite3_column_count(stmt);
+      int psm_id_col = -1, group_id_col = -1, decoy_col = -1, peptide_col = -1;
+      std::map<std::string, int> feature_cols;
+      for (int i = 0; i < cols; i++)
+      {
+        const char* name = sqlite3_column_name(stmt, i);
+        if (strcmp(name, "FEATURE_ID") == 0)
+        {
+          psm_id_col = i;
+        }
+        if (strcmp(name, "GROUP_ID") == 0)
+        {
+          group_id_col = i;
+        }
+        if (strcmp(name, "DECOY") == 0)
+        {
+          decoy_col = i;
+        }
+        if (strcmp(name, "MODIFIED_SEQUENCE") == 0)
+        {
+          peptide_col = i;
+        }
+        if (strncmp(name, "VAR_", 4) == 0)
+        {
+          feature_cols[name] = i;
+        }
+      }
 
-      // Generate features
+      // Generate features, streaming them to the output
       int k = 0;
-      std::vector<std::basic_string<unsigned char>> group_id_index;
-      OpenMS::String tmp;
+      std::unordered_map<std::string, size_t> group_id_index;
       while (sqlite3_column_type( stmt, 0 ) != SQLITE_NULL)
       {
         std::string psm_id;
         size_t scan_id = 0;
         int label = 0;
         std::string peptide;
-        std::map<std::string, double> features;
 
-        for (int i = 0; i < cols; i++)
+        if (psm_id_col >= 0)
         {
-          if (strcmp(sqlite3_column_name(stmt, i), "FEATURE_ID") == 0)
-          {
-            Sql::extractValue<string>(&psm_id, stmt, i);
-          }
-          if (strcmp(sqlite3_column_name(stmt, i), "GROUP_ID") == 0)
-          {
-            auto it = std::find(group_id_index.begin(), group_id_index.end(), sqlite3_column_text(stmt, i));
-            if (it != group_id_index.end())
-            {
-              scan_id = it - group_id_index.begin();
-            }
-            else
-            {
-              scan_id = group_id_index.size();
-              group_id_index.push_back(sqlite3_column_text(stmt, i));
-            }
-          }
-          if (strcmp(sqlite3_column_name(stmt, i), "DECOY") == 0)
-          {
-            if (sqlite3_column_int( stmt, i ) == 1)
-            {
-              label = -1;
-            }
-            else
-            {
-              label = 1;
-            }
-          }
-          if (strcmp(sqlite3_column_name( stmt, i ), "MODIFIED_SEQUENCE") == 0)
-          {
-            Sql::extractValue<string>(&peptide, stmt, i);
-          }
-          if (strncmp(sqlite3_column_name( stmt, i ), "VAR_", 4) == 0)
-          {
-            features[OpenMS::String(sqlite3_column_name( stmt, i ))] = sqlite3_column_double( stmt, i );
-          }
+          Sql::extractValue<string>(&psm_id, stmt, psm_id_col);
+        }
+        if (group_id_col >= 0)
+        {
+          const unsigned char* group_id = sqlite3_column_text(stmt, group_id_col);
+          // the scan number is the index of the first occurrence of the group
+          scan_id = group_id_index.emplace(group_id ? reinterpret_cast<const char*>(group_id) : "", group_id_index.size()).first->second;
+        }
+        if (decoy_col >= 0)
+        {
+          label = (sqlite3_column_int( stmt, decoy_col ) == 1) ? -1 : 1;
+        }
+        if (peptide_col >= 0)
+        {
+          Sql::extractValue<string>(&peptide, stmt, peptide_col);
         }
 
         // Write output
         if (k == 0)
         {
           pin_output << "PSMId\tLabel\tScanNr";
-          for (auto const &feat : features)
+          for (auto const &feat : feature_cols)
           {
             pin_output << "\t" << feat.first;
           }
           pin_output << "\tPeptide\tProteins\n";
         }
         pin_output << psm_id << "\t" << label << "\t" << scan_id;
-        for (auto const &feat : features)
+        for (auto const &feat : feature_cols)
         {
-          pin_output << "\t" << feat.second;
+          pin_output << "\t" << sqlite3_column_double( stmt, feat.second );
         }
         pin_output << "\t." << peptide << ".\tProt1" << "\n";
 
@@ -199,12 +207,15 @@ namespace OpenMS
 
     }
 
-    void OSWFile::write(const std::string& in_osw,
-                        const std::string& osw_level,
-                        const std::map< std::string, std::vector<double> >& features)
+    OSWFile::ScoreWriter::ScoreWriter(const std::string& in_osw, const std::string& osw_level) :
+      conn_(new SqliteConnector(in_osw)),
+      stmt_(nullptr),
+      transition_level_(osw_level == "transition"),
+      committed_(false)
     {
       std::string table;
       std::string create_sql;
+      std::string insert_sql;
 
       if (osw_level == "ms1")
       {
@@ -215,7 +226,7 @@ namespace OpenMS
                       "SCORE DOUBLE NOT NULL," \
                       "QVALUE DOUBLE NOT NULL," \
                       "PEP DOUBLE NOT NULL);";
-
+        insert_sql = "INSERT INTO " + table + " (FEATURE_ID, SCORE, QVALUE, PEP) VALUES (?, ?, ?, ?);";
       }
       else if (osw_level == "transition")
       {
@@ -227,7 +238,7 @@ namespace OpenMS
                       "SCORE DOUBLE NOT NULL," \
                       "QVALUE DOUBLE NOT NULL," \
                       "PEP DOUBLE NOT NULL);";
-
+        insert_sql = "INSERT INTO " + table + " (FEATURE_ID, TRANSITION_ID, SCORE, QVALUE, PEP) VALUES (?, ?, ?, ?, ?);";
       }
       else
       {
@@ -238,45 +249,220 @@ namespace OpenMS
                       "SCORE DOUBLE NOT NULL," \
                       "QVALUE DOUBLE NOT NULL," \
                       "PEP DOUBLE NOT NULL);";
+        insert_sql = "INSERT INTO " + table + " (FEATURE_ID, SCORE, QVALUE, PEP) VALUES (?, ?, ?, ?);";
+      }
+
+      // the old table is only replaced once all scores were written
+      conn_->executeStatement("BEGIN TRANSACTION;");
+      try
+      {
+        conn_->executeStatement(create_sql);
+        conn_->prepareStatement(&stmt_, insert_sql);
+      }
+      catch (...)
+      {
+        conn_->executeStatement("ROLLBACK;");
+        throw;
       }
+    }
 
-      std::vector<std::string> insert_sqls;
+    OSWFile::ScoreWriter::~ScoreWriter()
+    {
+      sqlite3_finalize(stmt_);
+      if (!committed_)
+      {
+        try
+        {
+          conn_->executeStatement("ROLLBACK;");
+        }
+        catch (Exception::BaseException& e)
+        {
+          OPENMS_LOG_ERROR << "Error discarding OSW scores: " << e.what() << std::endl;
+        }
+      }
+    }
+
+    void OSWFile::ScoreWriter::add(const std::string& id, double score, double qvalue, double pep)
+    {
+      // the ids are bound as text, the INT affinity of the columns stores them as integers
+      int col = 1;
+      if (transition_level_)
+      {
+        std::vector<OpenMS::String> ids;
+        OpenMS::String(id).split("_", ids);
+        if (ids.size() != 2)
+        {
+          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+              "Invalid transition-level identifier '" + id + "', expected '<feature id>_<transition id>'.");
+        }
+        sqlite3_bind_text(stmt_, col++, ids[0].c_str(), (int)ids[0].size(), SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt_, col++, ids[1].c_str(), (int)ids[1].size(), SQLITE_TRANSIENT);
+      }
+      else
+      {
+        sqlite3_bind_text(stmt_, col++, id.c_str(), (int)id.size(), SQLITE_TRANSIENT);
+      }
+      sqlite3_bind_double(stmt_, col++, score);
+      sqlite3_bind_double(stmt_, col++, qvalue);
+      sqlite3_bind_double(stmt_, col++, pep);
+
+      const int rc = sqlite3_step(stmt_);
+      sqlite3_reset(stmt_);
+      if (rc != SQLITE_DONE)
+      {
+        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, sqlite3_errmsg(conn_->getDB()));
+      }
+    }
+
+    void OSWFile::ScoreWriter::commit()
+    {
+      if (committed_)
+      {
+        return;
+      }
+      sqlite3_finalize(stmt_);
+      stmt_ = nullptr;
+      conn_->executeStatement("COMMIT;");
+      committed_ = true;
+    }
+
+    void OSWFile::write(const std::string& in_osw,
+                        const std::string& osw_level,
+                        const std::map< std::string, std::vector<double> >& features)
+    {
+      ScoreWriter writer(in_osw, osw_level);
       for (auto const &feat : features)
       {
-        std::stringstream insert_sql;
-        if (osw_level == "transition") {
-          std::vector<OpenMS::String> ids;
-          OpenMS::String(feat.first).split("_", ids);
-          insert_sql << "INSERT INTO " << table;
-          insert_sql << " (FEATURE_ID, TRANSITION_ID, SCORE, QVALUE, PEP) VALUES (";
-          insert_sql <<  ids[0] << ",";
-          insert_sql <<  ids[1] << ",";
-          insert_sql <<  feat.second[0] << ",";
-          insert_sql <<  feat.second[1] << ",";
-          insert_sql <<  feat.second[2] << "); ";
+        writer.add(feat.first, feat.second[0], feat.second[1], feat.second[2]);
+      }
+      writer.commit();
+    }
+
+    namespace
+    {
+      /// names of the tables of database @p schema whose name starts with @p prefix
+      std::vector<std::string> tablesWithPrefix(sqlite3* db, const std::string& schema, const std::string& prefix)
+      {
+        sqlite3_stmt * stmt;
+        SqliteConnector::prepareStatement(db, &stmt, "SELECT name FROM " + schema + ".sqlite_master WHERE type = 'table' AND name LIKE '" + prefix + "%';");
+        std::vector<std::string> tables;
+        while (sqlite3_step(stmt) == SQLITE_ROW)
+        {
+          std::string name;
+          Sql::extractValue<std::string>(&name, stmt, 0);
+          tables.push_back(name);
         }
-        else
+        sqlite3_finalize(stmt);
+        return tables;
+      }
+
+      /// throws if database @p schema was already scored (scores are not comparable between shards)
+      void checkUnscored(sqlite3* db, const std::string& schema, const std::string& filename)
+      {
+        if (!tablesWithPrefix(db, schema, "SCORE").empty())
         {
-          insert_sql << "INSERT INTO " << table;
-          insert_sql << " (FEATURE_ID, SCORE, QVALUE, PEP) VALUES (";
-          insert_sql <<  feat.first << ",";
-          insert_sql <<  feat.second[0] << ",";
-          insert_sql <<  feat.second[1] << ",";
-          insert_sql <<  feat.second[2] << "); ";
+          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+              "OSW file '" + filename + "' already contains scores. Shards need to be merged before scoring.");
         }
+      }
+    }
 
-        insert_sqls.push_back(insert_sql.str());
+    void OSWFile::mergeShards(const std::vector<std::string>& in_osw, const std::string& out_osw)
+    {
+      if (in_osw.empty())
+      {
+        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "No OSW files given for merging.");
+      }
+      // ATTACH would silently create missing files
+      for (const std::string& shard : in_osw)
+      {
+        if (!File::exists(shard))
+        {
+          throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, shard);
+        }
       }
 
-      // Write to Sqlite database
-      SqliteConnector conn(in_osw);
-      conn.executeStatement(create_sql);
-      conn.executeStatement("BEGIN TRANSACTION");
-      for (size_t i = 0; i < insert_sqls.size(); i++)
+      const std::string tmp_osw = out_osw + ".tmp_merge";
+      {
+        std::ifstream src(in_osw[0].c_str(), std::ios::binary);
+        std::ofstream dst(tmp_osw.c_str(), std::ios::binary);
+        dst << src.rdbuf();
+        if (!dst)
+        {
+          throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, tmp_osw);
+        }
+      }
+
+      try
+      {
+        SqliteConnector conn(tmp_osw);
+        sqlite3* db = conn.getDB();
+        checkUnscored(db, "main", in_osw[0]);
+
+        for (size_t i = 1; i < in_osw.size(); ++i)
+        {
+          conn.executeStatement("ATTACH DATABASE '" + String(in_osw[i]).substitute("'", "''") + "' AS shard;");
+          try
+          {
+            checkUnscored(db, "shard", in_osw[i]);
+
+            conn.executeStatement("BEGIN TRANSACTION;");
+            try
+            {
+              // runs are identified by their file name, every shard created its own RUN entry
+              conn.executeStatement("INSERT INTO main.RUN SELECT * FROM shard.RUN WHERE FILENAME NOT IN (SELECT FILENAME FROM main.RUN);");
+
+              for (const std::string& table : tablesWithPrefix(db, "shard", "FEATURE"))
+              {
+                if (!conn.tableExists(table))
+                {
+                  sqlite3_stmt * stmt;
+                  conn.prepareStatement(&stmt, "SELECT sql FROM shard.sqlite_master WHERE type = 'table' AND name = '" + table + "';");
+                  std::string create_sql;
+                  if (sqlite3_step(stmt) == SQLITE_ROW)
+                  {
+                    Sql::extractValue<std::string>(&create_sql, stmt, 0);
+                  }
+                  sqlite3_finalize(stmt);
+                  conn.executeStatement(create_sql);
+                }
+                conn.executeStatement("INSERT INTO main." + table + " SELECT * FROM shard." + table + ";");
+              }
+
+              if (conn.tableExists("FEATURE"))
+              {
+                conn.executeStatement("UPDATE main.FEATURE SET RUN_ID = "                                       "(SELECT M.ID FROM main.RUN M INNER JOIN shard.RUN S ON M.FILENAME = S.FILENAME WHERE S.ID = main.FEATURE.RUN_ID) "                                       "WHERE RUN_ID IN (SELECT ID FROM shard.RUN WHERE ID NOT IN (SELECT ID FROM main.RUN));");
+              }
+              conn.executeStatement("COMMIT;");
+            }
+            catch (...)
+            {
+              conn.executeStatement("ROLLBACK;");
+              throw;
+            }
+          }
+          catch (...)
+          {
+            conn.executeStatement("DETACH DATABASE shard;");
+            throw;
+          }
+          conn.executeStatement("DETACH DATABASE shard;");
+        }
+      }
+      catch (...)
+      {
+        File::remove(tmp_osw);
+        throw;
+      }
+
+      if (File::exists(out_osw))
+      {
+        File::remove(out_osw);
+      }
+      if (!File::rename(tmp_osw, out_osw, true, false))
       {
-        conn.executeStatement(insert_sqls[i]);
+        throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, out_osw);
       }
-      conn.executeStatement("END TRANSACTION");
     }
 
 } // namespace OpenMS
@@ -0,0 +1,219 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/ReadAheadBuffer.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OpenMS
+{
+
+  struct ReadAheadBuffer::Impl_
+  {
+    struct Chunk
+    {
+      std::vector<char> data;
+      size_t size = 0; ///< number of valid bytes in data
+    };
+
+    Size chunk_size;
+    Size num_chunks;
+
+    mutable std::mutex mutex;
+    std::condition_variable filled;  ///< signalled by the producer
+    std::condition_variable emptied; ///< signalled by the reader
+    std::deque<Chunk> ready; ///< filled chunks, in order
+    std::vector<Chunk> spare; ///< chunks the producer may fill
+    Chunk current; ///< chunk the reader is consuming
+    size_t current_pos = 0;
+    bool producer_done = true;
+    bool cancel = false;
+    bool running = false;
+    std::exception_ptr error;
+    std::thread thread;
+
+    Impl_(Size chunk, Size chunks) :
+      chunk_size(std::max(chunk, Size(1))),
+      num_chunks(std::max(chunks, Size(1)))
+    {
+    }
+
+    void run(Producer producer)
+    {
+      try
+      {
+        while (true)
+        {
+          Chunk chunk;
+          {
+            std::unique_lock<std::mutex> lock(mutex);
+            emptied.wait(lock, [this] { return cancel || !spare.empty(); });
+            if (cancel) break;
+            chunk = std::move(spare.back());
+            spare.pop_back();
+          }
+
+          chunk.size = producer(chunk.data.data(), chunk.data.size());
+
+          if (chunk.size == 0) break; // end of data
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+            ready.push_back(std::move(chunk));
+          }
+          filled.notify_one();
+        }
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        error = std::current_exception();
+      }
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        producer_done = true;
+      }
+      filled.notify_all();
+    }
+  };
+
+  ReadAheadBuffer::ReadAheadBuffer(Size chunk_size, Size num_chunks) :
+    impl_(new Impl_(chunk_size, num_chunks))
+  {
+  }
+
+  ReadAheadBuffer::~ReadAheadBuffer()
+  {
+    stop();
+  }
+
+  void ReadAheadBuffer::start(Producer producer)
+  {
+    stop();
+
+    impl_->spare.resize(impl_->num_chunks);
+    for (auto& chunk : impl_->spare)
+    {
+      chunk.data.resize(impl_->chunk_size);
+    }
+    impl_->producer_done = false;
+    impl_->cancel = false;
+    impl_->running = true;
+    impl_->thread = std::thread(&Impl_::run, impl_.get(), std::move(producer));
+  }
+
+  size_t ReadAheadBuffer::read(char* s, size_t n)
+  {
+    Impl_& d = *impl_;
+    size_t copied = 0;
+    while (copied < n)
+    {
+      if (d.current_pos == d.current.size)
+      {
+        std::unique_lock<std::mutex> lock(d.mutex);
+        if (!d.current.data.empty()) // hand the consumed chunk back to the producer
+        {
+          d.current.size = 0;
+          d.current_pos = 0;
+          d.spare.push_back(std::move(d.current));
+          d.current = Impl_::Chunk();
+          d.emptied.notify_one();
+        }
+        d.filled.wait(lock, [&d] { return !d.ready.empty() || d.producer_done; });
+        if (d.ready.empty())
+        {
+          if (d.error) std::rethrow_exception(d.error);
+          break; // end of data
+        }
+        d.current = std::move(d.ready.front());
+        d.ready.pop_front();
+        d.current_pos = 0;
+      }
+
+      size_t count = std::min(n - copied, d.current.size - d.current_pos);
+      std::memcpy(s + copied, d.current.data.data() + d.current_pos, count);
+      d.current_pos += count;
+      copied += count;
+    }
+    return copied;
+  }
+
+  bool ReadAheadBuffer::atEnd() const
+  {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    return impl_->producer_done && impl_->ready.empty() && !impl_->error &&
+           impl_->current_pos == impl_->current.size;
+  }
+
+  bool ReadAheadBuffer::isRunning() const
+  {
+    return impl_->running;
+  }
+
+  void ReadAheadBuffer::stop()
+  {
+    Impl_& d = *impl_;
+    {
+      std::lock_guard<std::mutex> lock(d.mutex);
+      d.cancel = true;
+    }
+    d.emptied.notify_all();
+    if (d.thread.joinable()) d.thread.join();
+
+    d.ready.clear();
+    d.spare.clear();
+    d.current = Impl_::Chunk();
+    d.current_pos = 0;
+    d.producer_done = true;
+    d.error = nullptr;
+    d.running = false;
+  }
+
+  void ReadAheadBuffer::setChunkSize(Size chunk_size)
+  {
+    impl_->chunk_size = std::max(chunk_size, Size(1));
+  }
+
+  Size ReadAheadBuffer::getChunkSize() const
+  {
+    return impl_->chunk_size;
+  }
+
+} // namespace OpenMS
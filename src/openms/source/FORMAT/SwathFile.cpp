@@ -34,6 +34,7 @@
 
 #include <OpenMS/FORMAT/SwathFile.h>
 
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessOpenMSCached.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessSqMass.h>
 #include <OpenMS/OPENSWATHALGO/DATAACCESS/DataStructures.h>
 #include <OpenMS/FORMAT/DATAACCESS/MSDataChainingConsumer.h>
@@ -173,7 +174,9 @@ namespace OpenMS
     }
     else if (readoptions == "cache")
     {
-      dataConsumer = std::make_shared<CachedSwathFileConsumer>(known_window_boundaries, tmp, tmp_fname, nr_ms1_spectra, swath_counter);
+      auto cachedConsumer = std::make_shared<CachedSwathFileConsumer>(known_window_boundaries, tmp, tmp_fname, nr_ms1_spectra, swath_counter);
+      cachedConsumer->setReloadMetaData(reload_cached_meta_data_);
+      dataConsumer = cachedConsumer;
     }
     else if (readoptions == "split")
     {
@@ -243,7 +246,9 @@ namespace OpenMS
     }
     else if (readoptions == "cache")
     {
-      dataConsumer = new CachedSwathFileConsumer(known_window_boundaries, tmp, tmp_fname, nr_ms1_spectra, swath_counter);
+      CachedSwathFileConsumer* cachedConsumer = new CachedSwathFileConsumer(known_window_boundaries, tmp, tmp_fname, nr_ms1_spectra, swath_counter);
+      cachedConsumer->setReloadMetaData(reload_cached_meta_data_);
+      dataConsumer = cachedConsumer;
       MzXMLFile().transform(file, dataConsumer);
     }
     else if (readoptions == "split")
@@ -305,18 +310,37 @@ namespace OpenMS
     String meta_file = tmp + tmp_fname;
 
     // Create new consumer, transform infile, write out metadata
+    std::vector<std::streampos> spectra_index, chrom_index;
     {
       MSDataCachedConsumer cachedConsumer(cached_file, true);
       MzMLFile().transform(in, &cachedConsumer, *experiment_metadata.get());
       Internal::CachedMzMLHandler().writeMetadata(*experiment_metadata.get(), meta_file, true);
+      spectra_index = cachedConsumer.getSpectraIndex();
+      chrom_index = cachedConsumer.getChromatogramIndex();
     } // ensure that filestream gets closed
 
+    if (!reload_cached_meta_data_)
+    {
+      // the caller still uses experiment_metadata, thus the meta data is copied
+      return OpenSwath::SpectrumAccessPtr(new SpectrumAccessOpenMSCached(meta_file, *experiment_metadata, spectra_index, chrom_index));
+    }
+
     boost::shared_ptr<PeakMap > exp(new PeakMap);
     MzMLFile().load(meta_file, *exp.get());
     return SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(exp);
   }
 
-  /// Only read the meta data from a file and use it to populate exp_meta
+  void SwathFile::setReloadCachedMetaData(bool reload)
+  {
+    reload_cached_meta_data_ = reload;
+  }
+
+  bool SwathFile::getReloadCachedMetaData() const
+  {
+    return reload_cached_meta_data_;
+  }
+
+    /// Only read the meta data from a file and use it to populate exp_meta
   boost::shared_ptr< PeakMap > SwathFile::populateMetaData_(const String& file)
   {
     boost::shared_ptr<PeakMap > experiment_metadata(new PeakMap);
@@ -34,6 +34,7 @@
 
 #include <OpenMS/FORMAT/HANDLERS/XMLHandler.h>
 #include <OpenMS/FORMAT/VALIDATORS/XMLValidator.h>
+#include <OpenMS/FORMAT/XMLFile.h>
 #include <OpenMS/SYSTEM/File.h>
 
 #include <xercesc/sax2/SAX2XMLReader.hpp>
@@ -65,7 +66,7 @@ namespace OpenMS
     // initialize parser
     try
     {
-      XMLPlatformUtils::Initialize();
+      Internal::XMLFile::initializeXerces();
     }
     catch (const XMLException & toCatch)
     {
@@ -33,6 +33,7 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/FORMAT/XMLFile.h>
+#include <OpenMS/FORMAT/BufferedOfstream.h>
 
 #include <OpenMS/CONCEPT/Macros.h>
 
@@ -49,6 +50,7 @@
 
 #include <fstream>
 #include <iomanip> // setprecision etc.
+#include <mutex>
 
 #include <boost/shared_ptr.hpp>
 
@@ -79,6 +81,14 @@ private:
       XMLHandler * p_;
     };
 
+    void XMLFile::initializeXerces()
+    {
+      // XMLPlatformUtils::Initialize() maintains a plain reference count and is not thread-safe,
+      // so calling it for every file would race when files are parsed concurrently
+      static std::once_flag xerces_initialized;
+      std::call_once(xerces_initialized, []() { xercesc::XMLPlatformUtils::Initialize(); });
+    }
+
     XMLFile::XMLFile()
     {
     }
@@ -114,7 +124,7 @@ private:
       // initialize parser
       try
       {
-        xercesc::XMLPlatformUtils::Initialize();
+        initializeXerces();
       }
       catch (const xercesc::XMLException & toCatch)
       {
@@ -200,7 +210,7 @@ private:
       // initialize parser
       try
       {
-        xercesc::XMLPlatformUtils::Initialize();
+        initializeXerces();
       }
       catch (const xercesc::XMLException & toCatch)
       {
@@ -260,7 +270,7 @@ private:
     void XMLFile::save_(const String & filename, XMLHandler * handler) const
     {
       // open file in binary mode to avoid any line ending conversions
-      std::ofstream os(filename.c_str(), std::ios::out | std::ios::binary);
+      BufferedOfstream os(filename, std::ios::out | std::ios::binary);
 
       //set high precision for writing of floating point numbers
       os.precision(writtenDigits(double()));
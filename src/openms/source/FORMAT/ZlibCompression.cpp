@@ -36,6 +36,8 @@
 
 #include <zlib.h>
 
+#include <algorithm>
+
 using namespace std;
 
 namespace OpenMS
@@ -78,34 +80,69 @@ namespace OpenMS
     compressed_data.remove(0, 4);
   }
 
-  void ZlibCompression::uncompressString(const void * tt, size_t blob_bytes, std::string& uncompressed)
+  namespace
   {
-    // take a leap of faith and assume the input is valid
-    QByteArray compressed_data = QByteArray::fromRawData((const char*)tt, blob_bytes);
-    QByteArray raw_data;
+    /**
+      @brief Inflates @p in_size bytes at @p in into @p out (std::string or QByteArray) in a single pass
+
+      qUncompress() needs the uncompressed size up front and restarts decompression with twice the buffer
+      whenever the guess is too small. Here the output buffer grows while inflating, so every byte is only
+      decompressed once.
+    */
+    template <typename BufferType>
+    void inflateInto(const void* in, size_t in_size, BufferType& out)
+    {
+      // typical compression ratios of peak data are 2-4
+      size_t capacity = std::max((size_t)out.capacity(), 4 * in_size + 64);
+      out.resize(capacity);
+
+      z_stream stream;
+      stream.zalloc = Z_NULL;
+      stream.zfree = Z_NULL;
+      stream.opaque = Z_NULL;
+      stream.next_in = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(in));
+      stream.avail_in = (uInt) in_size;
+      if (inflateInit(&stream) != Z_OK)
+      {
+        throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Decompression error?");
+      }
+
+      size_t written = 0;
+      int zlib_error;
+      do
+      {
+        if (written == (size_t)out.size())
+        {
+          out.resize(2 * out.size());
+        }
+        stream.next_out = reinterpret_cast<Bytef*>(out.data()) + written;
+        stream.avail_out = (uInt) (out.size() - written);
+        zlib_error = inflate(&stream, Z_NO_FLUSH);
+        written = (size_t) stream.total_out;
+      }
+      while (zlib_error == Z_OK);
+      inflateEnd(&stream);
 
-    ZlibCompression::uncompressString(compressed_data, raw_data);
+      out.resize(written);
+      // qUncompress() reports both errors and empty output as empty result
+      if (zlib_error != Z_STREAM_END || written == 0)
+      {
+        throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Decompression error?");
+      }
+    }
+  }
 
+  void ZlibCompression::uncompressString(const void * tt, size_t blob_bytes, std::string& uncompressed)
+  {
     // Note that we may have zero bytes in the string, so we cannot use QString
     uncompressed.clear();
-    uncompressed = std::string(raw_data.data(), raw_data.size());
+    inflateInto(tt, blob_bytes, uncompressed);
   }
 
   void ZlibCompression::uncompressString(const QByteArray& compressed_data, QByteArray& raw_data)
   {
-    QByteArray czip;
-    czip.resize(4);
-    czip[0] = (compressed_data.size() & 0xff000000) >> 24;
-    czip[1] = (compressed_data.size() & 0x00ff0000) >> 16;
-    czip[2] = (compressed_data.size() & 0x0000ff00) >> 8;
-    czip[3] = (compressed_data.size() & 0x000000ff);
-    czip += compressed_data;
-    raw_data = qUncompress(czip);
-
-    if (raw_data.isEmpty())
-    {
-      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Decompression error?");
-    }
+    raw_data.clear();
+    inflateInto(compressed_data.constData(), compressed_data.size(), raw_data);
   }
 
 }
@@ -6,9 +6,11 @@ set(sources_list
 AbsoluteQuantitationMethodFile.cpp
 AbsoluteQuantitationStandardsFile.cpp
 Base64.cpp
+BufferedOfstream.cpp
 Bzip2Ifstream.cpp
 Bzip2InputStream.cpp
 CachedMzML.cpp
+ColumnarFeatureFile.cpp
 ChromeleonFile.cpp
 CompressedInputSource.cpp
 CVMappingFile.cpp
@@ -20,6 +22,7 @@ DTAFile.cpp
 EDTAFile.cpp
 ExperimentalDesignFile.cpp
 FASTAFile.cpp
+FASTAIndex.cpp
 FeatureXMLFile.cpp
 FileHandler.cpp
 FileTypes.cpp
@@ -48,6 +51,7 @@ MsInspectFile.cpp
 MzDataFile.cpp
 MzIdentMLFile.cpp
 MzMLFile.cpp
+MzMLFollower.cpp
 MzQuantMLFile.cpp
 MzTab.cpp
 MzTabFile.cpp
@@ -65,6 +69,7 @@ PepXMLFileMascot.cpp
 PercolatorOutfile.cpp
 ProtXMLFile.cpp
 QcMLFile.cpp
+ReadAheadBuffer.cpp
 SequestInfile.cpp
 SequestOutfile.cpp
 SpecArrayFile.cpp
@@ -45,6 +45,39 @@
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// remove redundant variable and fixed modifications from the search parameters (after merging)
+    void removeRedundantModifications(std::vector<ProteinIdentification>& protein_ids)
+    {
+      for (auto & pi : protein_ids)
+      {
+        std::vector<String>::iterator it_2;
+
+        // remove redundant variable modifications
+        std::vector<String>& varMod = pi.getSearchParameters().variable_modifications;
+        sort(varMod.begin(), varMod.end());
+        it_2 = unique(varMod.begin(), varMod.end());
+        varMod.resize(it_2 - varMod.begin());
+
+        // remove redundant fixed modifications
+        std::vector<String>& fixMod = pi.getSearchParameters().fixed_modifications;
+        sort(fixMod.begin(), fixMod.end());
+        it_2 = unique(fixMod.begin(), fixMod.end());
+        fixMod.resize(it_2 - fixMod.begin());
+      }
+    }
+
+    /// shift the "map_index" meta value of @p pid by @p offset
+    void shiftMapIndex(PeptideIdentification& pid, Size offset)
+    {
+      if (pid.metaValueExists("map_index"))
+      {
+        Size old_index = pid.getMetaValue("map_index");
+        pid.setMetaValue("map_index", offset + old_index);
+      }
+    }
+  }
 
   ConsensusMap::ColumnHeader::ColumnHeader() :
     MetaInfoInterface(),
@@ -172,22 +205,7 @@ namespace OpenMS
                                     rhs.protein_identifications_.end());
 
     // ensure non-redundant modification parameter
-    for (auto & pi : protein_identifications_)
-    {
-      std::vector<String>::iterator it_2;
-
-      // remove redundant variable modifications
-      std::vector<String>& varMod = pi.getSearchParameters().variable_modifications;
-      sort(varMod.begin(), varMod.end());
-      it_2 = unique(varMod.begin(), varMod.end());
-      varMod.resize(it_2 - varMod.begin());
-
-      // remove redundant fixed modifications
-      std::vector<String>& fixMod = pi.getSearchParameters().fixed_modifications;
-      sort(fixMod.begin(), fixMod.end());
-      it_2 = unique(fixMod.begin(), fixMod.end());
-      fixMod.resize(it_2 - fixMod.begin());
-    }
+    removeRedundantModifications(protein_identifications_);
 
     // append unassignedPeptideIdentifications
     unassigned_peptide_identifications_.insert(unassigned_peptide_identifications_.end(),
@@ -245,31 +263,12 @@ namespace OpenMS
                                     rhs.protein_identifications_.end());    
 
     // ensure non-redundant modification parameter
-    for (auto & pi : protein_identifications_)
-    {
-      std::vector<String>::iterator it_2;
-
-      // remove redundant variable modifications
-      std::vector<String>& varMod = pi.getSearchParameters().variable_modifications;
-      sort(varMod.begin(), varMod.end());
-      it_2 = unique(varMod.begin(), varMod.end());
-      varMod.resize(it_2 - varMod.begin());
-
-      // remove redundant fixed modifications
-      std::vector<String>& fixMod = pi.getSearchParameters().fixed_modifications;
-      sort(fixMod.begin(), fixMod.end());
-      it_2 = unique(fixMod.begin(), fixMod.end());
-      fixMod.resize(it_2 - fixMod.begin());
-    }
+    removeRedundantModifications(protein_identifications_);
 
     // append unassigned identifications and update map index:
     for (PeptideIdentification pid : rhs.unassigned_peptide_identifications_)
     {
-      if (pid.metaValueExists("map_index"))
-      {
-        Size old_index = pid.getMetaValue("map_index");
-        pid.setMetaValue("map_index", lhs_map_size + old_index);
-      }
+      shiftMapIndex(pid, lhs_map_size);
       unassigned_peptide_identifications_.push_back(pid);
     }
 
@@ -278,11 +277,7 @@ namespace OpenMS
     {
       for (PeptideIdentification & pid : cf.getPeptideIdentifications())
       {
-        if (pid.metaValueExists("map_index"))
-        {
-          Size old_index = pid.getMetaValue("map_index");
-          pid.setMetaValue("map_index", lhs_map_size + old_index);
-        }
+        shiftMapIndex(pid, lhs_map_size);
       }
 
       // update map indices
@@ -315,6 +310,178 @@ namespace OpenMS
   }
 
 
+  ConsensusMap& ConsensusMap::appendRows(std::vector<ConsensusMap>&& maps)
+  {
+    ConsensusMap empty_map;
+
+    // reset these:
+    RangeManagerType::operator=(empty_map);
+
+    bool has_identifier = !this->getIdentifier().empty();
+    Size n_features = this->size();
+    Size n_proteins = protein_identifications_.size();
+    Size n_unassigned = unassigned_peptide_identifications_.size();
+    for (const ConsensusMap& map : maps)
+    {
+      has_identifier = has_identifier || !map.getIdentifier().empty();
+      n_features += map.size();
+      n_proteins += map.protein_identifications_.size();
+      n_unassigned += map.unassigned_peptide_identifications_.size();
+    }
+    if (has_identifier)
+    {
+      OPENMS_LOG_INFO << "DocumentIdentifiers are lost during merge of ConsensusMaps\n";
+    }
+
+    DocumentIdentifier::operator=(empty_map);
+    UniqueIdInterface::operator=(empty_map);
+
+    this->reserve(n_features);
+    protein_identifications_.reserve(n_proteins);
+    unassigned_peptide_identifications_.reserve(n_unassigned);
+    for (ConsensusMap& map : maps)
+    {
+      // append dataProcessing
+      data_processing_.insert(data_processing_.end(),
+                              map.data_processing_.begin(),
+                              map.data_processing_.end());
+
+      // append fileDescription, update filename and map size (as in appendRows(const ConsensusMap&))
+      column_description_.insert(map.column_description_.begin(), map.column_description_.end());
+      ColumnHeaders::const_iterator it = column_description_.begin();
+      ColumnHeaders::const_iterator it2 = map.column_description_.begin();
+      for (; it != column_description_.end() && it2 != map.column_description_.end(); ++it, ++it2)
+      {
+        getColumnHeaders()[it->first].filename = "mergedConsensusXMLFile";
+        getColumnHeaders()[it->first].size = it->second.size + it2->second.size;
+      }
+
+      // move identifications and consensus elements
+      protein_identifications_.insert(protein_identifications_.end(),
+                                      std::make_move_iterator(map.protein_identifications_.begin()),
+                                      std::make_move_iterator(map.protein_identifications_.end()));
+      unassigned_peptide_identifications_.insert(unassigned_peptide_identifications_.end(),
+                                                 std::make_move_iterator(map.unassigned_peptide_identifications_.begin()),
+                                                 std::make_move_iterator(map.unassigned_peptide_identifications_.end()));
+      this->insert(this->end(), std::make_move_iterator(map.begin()), std::make_move_iterator(map.end()));
+      map.clear(true); // release the moved-from elements right away
+    }
+    maps.clear();
+
+    // ensure non-redundant modification parameter
+    removeRedundantModifications(protein_identifications_);
+
+    // consistency (once for all maps)
+    try
+    {
+      UniqueIdIndexer<ConsensusMap>::updateUniqueIdToIndex();
+    }
+    catch (Exception::Postcondition&) // assign new UID's for conflicting entries
+    {
+      Size replaced_uids =  UniqueIdIndexer<ConsensusMap>::resolveUniqueIdConflicts();
+      OPENMS_LOG_INFO << "Replaced " << replaced_uids << " invalid uniqueID's\n";
+    }
+
+    return *this;
+  }
+
+  ConsensusMap& ConsensusMap::appendColumns(std::vector<ConsensusMap>&& maps)
+  {
+    ConsensusMap empty_map;
+
+    // reset these:
+    RangeManagerType::operator=(empty_map);
+
+    bool has_identifier = !this->getIdentifier().empty();
+    Size n_features = this->size();
+    Size n_proteins = protein_identifications_.size();
+    Size n_unassigned = unassigned_peptide_identifications_.size();
+    for (const ConsensusMap& map : maps)
+    {
+      has_identifier = has_identifier || !map.getIdentifier().empty();
+      n_features += map.size();
+      n_proteins += map.protein_identifications_.size();
+      n_unassigned += map.unassigned_peptide_identifications_.size();
+    }
+    if (has_identifier)
+    {
+      OPENMS_LOG_INFO << "DocumentIdentifiers are lost during merge of ConsensusMaps\n";
+    }
+
+    DocumentIdentifier::operator=(empty_map);
+    UniqueIdInterface::operator=(empty_map);
+
+    this->reserve(n_features);
+    protein_identifications_.reserve(n_proteins);
+    unassigned_peptide_identifications_.reserve(n_unassigned);
+    for (ConsensusMap& map : maps)
+    {
+      // append dataProcessing
+      data_processing_.insert(data_processing_.end(),
+                              map.data_processing_.begin(),
+                              map.data_processing_.end());
+
+      // append column headers (file descriptions) and increase column index (map index)
+      Size lhs_map_size = column_description_.size();
+      for (auto& rhsfd : map.column_description_)
+      {
+        column_description_.insert(
+          std::make_pair(lhs_map_size + rhsfd.first, std::move(rhsfd.second)));
+      }
+
+      protein_identifications_.insert(protein_identifications_.end(),
+                                      std::make_move_iterator(map.protein_identifications_.begin()),
+                                      std::make_move_iterator(map.protein_identifications_.end()));
+
+      // move unassigned identifications and update map index:
+      for (PeptideIdentification& pid : map.unassigned_peptide_identifications_)
+      {
+        shiftMapIndex(pid, lhs_map_size);
+        unassigned_peptide_identifications_.push_back(std::move(pid));
+      }
+
+      // move consensus elements and update map index:
+      for (ConsensusFeature& cf : map)
+      {
+        for (PeptideIdentification& pid : cf.getPeptideIdentifications())
+        {
+          shiftMapIndex(pid, lhs_map_size);
+        }
+
+        // update map indices
+        ConsensusFeature::HandleSetType new_handles;
+        // std::set only provides const iterators, so we copy
+        for (auto handle : cf) // OMS_CODING_TEST_EXCLUDE
+        {
+          //since we only add a constant to the map_index, the set order will not change.
+          handle.setMapIndex(lhs_map_size + handle.getMapIndex());
+          new_handles.insert(new_handles.end(), handle);
+        }
+        cf.setFeatures(std::move(new_handles));
+
+        emplace_back(std::move(cf));
+      }
+      map.clear(true); // release the moved-from elements right away
+    }
+    maps.clear();
+
+    // ensure non-redundant modification parameter
+    removeRedundantModifications(protein_identifications_);
+
+    // consistency (once for all maps)
+    try
+    {
+      UniqueIdIndexer<ConsensusMap>::updateUniqueIdToIndex();
+    }
+    catch (Exception::Postcondition&) // assign new UID's for conflicting entries
+    {
+      Size replaced_uids =  UniqueIdIndexer<ConsensusMap>::resolveUniqueIdConflicts();
+      OPENMS_LOG_INFO << "Replaced " << replaced_uids << " invalid uniqueID's\n";
+    }
+
+    return *this;
+  }
+
   void ConsensusMap::clear(bool clear_meta_data)
   {
     Base::clear();
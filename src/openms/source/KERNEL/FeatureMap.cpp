@@ -206,6 +206,58 @@ namespace OpenMS
     return *this;
   }
 
+  FeatureMap& FeatureMap::append(std::vector<FeatureMap>&& maps)
+  {
+    FeatureMap empty_map;
+    // reset these:
+    RangeManagerType::operator=(empty_map);
+
+    bool has_identifier = !this->getIdentifier().empty();
+    Size n_features = this->size();
+    Size n_proteins = protein_identifications_.size();
+    Size n_unassigned = unassigned_peptide_identifications_.size();
+    for (const FeatureMap& map : maps)
+    {
+      has_identifier = has_identifier || !map.getIdentifier().empty();
+      n_features += map.size();
+      n_proteins += map.protein_identifications_.size();
+      n_unassigned += map.unassigned_peptide_identifications_.size();
+    }
+    if (has_identifier) OPENMS_LOG_INFO << "DocumentIdentifiers are lost during merge of FeatureMaps\n";
+    DocumentIdentifier::operator=(empty_map);
+
+    UniqueIdInterface::operator=(empty_map);
+
+    // merge (move) everything:
+    this->reserve(n_features);
+    protein_identifications_.reserve(n_proteins);
+    unassigned_peptide_identifications_.reserve(n_unassigned);
+    for (FeatureMap& map : maps)
+    {
+      protein_identifications_.insert(protein_identifications_.end(),
+        std::make_move_iterator(map.protein_identifications_.begin()), std::make_move_iterator(map.protein_identifications_.end()));
+      unassigned_peptide_identifications_.insert(unassigned_peptide_identifications_.end(),
+        std::make_move_iterator(map.unassigned_peptide_identifications_.begin()), std::make_move_iterator(map.unassigned_peptide_identifications_.end()));
+      data_processing_.insert(data_processing_.end(), map.data_processing_.begin(), map.data_processing_.end());
+      this->insert(this->end(), std::make_move_iterator(map.begin()), std::make_move_iterator(map.end()));
+      map.clear(true); // release the moved-from elements right away
+    }
+    maps.clear();
+
+    // consistency (once for all maps)
+    try
+    {
+      UniqueIdIndexer<FeatureMap>::updateUniqueIdToIndex();
+    }
+    catch (Exception::Postcondition&) // assign new UID's for conflicting entries
+    {
+      Size replaced_uids =  UniqueIdIndexer<FeatureMap>::resolveUniqueIdConflicts();
+      OPENMS_LOG_INFO << "Replaced " << replaced_uids << " invalid uniqueID's\n";
+    }
+
+    return *this;
+  }
+
   void FeatureMap::sortByIntensity(bool reverse)
   {
     if (reverse)
@@ -34,6 +34,8 @@
 
 #include <OpenMS/KERNEL/MSChromatogram.h>
 
+#include <OpenMS/DATASTRUCTURES/RadixSort.h>
+
 using namespace OpenMS;
 
 std::ostream& OpenMS::operator<<(std::ostream& os, const MSChromatogram& chrom)
@@ -204,35 +206,38 @@ void MSChromatogram::sortByIntensity(bool reverse) {
 
 void MSChromatogram::sortByPosition()
 {
-  if (float_data_arrays_.empty())
+  if (isSorted()) return;
+
+  if (float_data_arrays_.empty() && string_data_arrays_.empty() && integer_data_arrays_.empty())
   {
-    std::sort(ContainerType::begin(), ContainerType::end(), PeakType::PositionLess());
+    std::stable_sort(ContainerType::begin(), ContainerType::end(), PeakType::PositionLess());
   }
   else
   {
-    //sort index list
-    std::vector<std::pair<PeakType::PositionType, Size> > sorted_indices;
-    sorted_indices.reserve(ContainerType::size());
-    for (Size i = 0; i < ContainerType::size(); ++i)
+    // compute the sorting permutation (radix sort on the retention times) ...
+    std::vector<double> rt(ContainerType::size());
+    for (Size i = 0; i < rt.size(); ++i)
     {
-      sorted_indices.push_back(std::make_pair(ContainerType::operator[](i).getPosition(), i));
+      rt[i] = ContainerType::operator[](i).getRT();
     }
-    std::sort(sorted_indices.begin(), sorted_indices.end(), PairComparatorFirstElement<std::pair<PeakType::PositionType, Size> >());
+    const std::vector<Size> sorted_indices = RadixSort::sortPermutation(rt);
 
-    //apply sorting to ContainerType and to metadataarrays
+    // ... and apply it to ContainerType and to metadataarrays
     ContainerType tmp;
+    tmp.reserve(sorted_indices.size());
     for (Size i = 0; i < sorted_indices.size(); ++i)
     {
-      tmp.push_back(*(ContainerType::begin() + (sorted_indices[i].second)));
+      tmp.push_back(ContainerType::operator[](sorted_indices[i]));
     }
     ContainerType::swap(tmp);
 
     for (Size i = 0; i < float_data_arrays_.size(); ++i)
     {
       std::vector<float> mda_tmp;
+      mda_tmp.reserve(float_data_arrays_[i].size());
       for (Size j = 0; j < float_data_arrays_[i].size(); ++j)
       {
-        mda_tmp.push_back(*(float_data_arrays_[i].begin() + (sorted_indices[j].second)));
+        mda_tmp.push_back(float_data_arrays_[i][sorted_indices[j]]);
       }
       std::swap(float_data_arrays_[i], mda_tmp);
     }
@@ -240,9 +245,10 @@ void MSChromatogram::sortByPosition()
     for (Size i = 0; i < string_data_arrays_.size(); ++i)
     {
       std::vector<String> mda_tmp;
+      mda_tmp.reserve(string_data_arrays_[i].size());
       for (Size j = 0; j < string_data_arrays_[i].size(); ++j)
       {
-        mda_tmp.push_back(*(string_data_arrays_[i].begin() + (sorted_indices[j].second)));
+        mda_tmp.push_back(std::move(string_data_arrays_[i][sorted_indices[j]]));
       }
       std::swap(string_data_arrays_[i], mda_tmp);
     }
@@ -250,9 +256,10 @@ void MSChromatogram::sortByPosition()
     for (Size i = 0; i < integer_data_arrays_.size(); ++i)
     {
       std::vector<Int> mda_tmp;
+      mda_tmp.reserve(integer_data_arrays_[i].size());
       for (Size j = 0; j < integer_data_arrays_[i].size(); ++j)
       {
-        mda_tmp.push_back(*(integer_data_arrays_[i].begin() + (sorted_indices[j].second)));
+        mda_tmp.push_back(integer_data_arrays_[i][sorted_indices[j]]);
       }
       std::swap(integer_data_arrays_[i], mda_tmp);
     }
@@ -46,6 +46,36 @@
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// finds the native ID in the index of @p container, (re-)building it if necessary
+    template <typename ContainerType>
+    SignedSize findByNativeID_(const std::vector<ContainerType>& container, const String& native_id,
+                               std::unordered_map<String, Size>& index, const void*& index_data, Size& index_size, bool& index_built)
+    {
+      for (Size attempt = 0; attempt < 2; ++attempt)
+      {
+        const bool current = index_built && index_data == (const void*)container.data() && index_size == container.size();
+        if (current)
+        {
+          auto it = index.find(native_id);
+          if (it == index.end()) return -1;
+          if (it->second < container.size() && container[it->second].getNativeID() == native_id) return (SignedSize)it->second;
+          // stale (native IDs were changed in place): rebuild
+        }
+        index.clear();
+        index.reserve(container.size());
+        for (Size i = 0; i < container.size(); ++i)
+        {
+          index.emplace(container[i].getNativeID(), i); // keeps the first one
+        }
+        index_data = container.data();
+        index_size = container.size();
+        index_built = true;
+      }
+      return -1; // not reached
+    }
+  }
 
   // Aliases / chromatograms
   void MSExperiment::reserveSpaceSpectra(Size s)
@@ -88,6 +118,7 @@ namespace OpenMS
     total_size_ = source.total_size_;
     chromatograms_ = source.chromatograms_;
     spectra_ = source.spectra_;
+    clearLookupIndices();
 
     //no need to copy the alloc?!
     //alloc_
@@ -223,6 +254,41 @@ namespace OpenMS
   @param ms_level MS level to consider for m/z range, RT range and intensity range (all MS levels if negative)
   */
   void MSExperiment::updateRanges(Int ms_level)
+  {
+    for (SpectrumType& spectrum : spectra_)
+    {
+      if ((ms_level < Int(0) || Int(spectrum.getMSLevel()) == ms_level) && !spectrum.empty())
+      {
+        spectrum.updateRanges();
+      }
+    }
+    for (ChromatogramType& chromatogram : chromatograms_)
+    {
+      // TICs and ECs are not part of the ranges (see combineRanges_())
+      if (!chromatogram.empty()
+        && chromatogram.getChromatogramType() != ChromatogramSettings::TOTAL_ION_CURRENT_CHROMATOGRAM
+        && chromatogram.getChromatogramType() != ChromatogramSettings::EMISSION_CHROMATOGRAM)
+      {
+        chromatogram.updateRanges();
+      }
+    }
+    combineRanges_(ms_level);
+  }
+
+  void MSExperiment::updateRanges(const std::vector<Size>& changed_spectra, Int ms_level)
+  {
+    for (Size index : changed_spectra)
+    {
+      if (index >= spectra_.size())
+      {
+        throw Exception::IndexOverflow(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, index, spectra_.size());
+      }
+      spectra_[index].updateRanges();
+    }
+    combineRanges_(ms_level);
+  }
+
+  void MSExperiment::combineRanges_(Int ms_level)
   {
     //clear MS levels
     ms_levels_.clear();
@@ -259,8 +325,6 @@ namespace OpenMS
         //do not update mz and int when the spectrum is empty
         if (it->size() == 0) continue;
 
-        it->updateRanges();
-
         //mz
         if (it->getMin()[0] < RangeManagerType::pos_range_.minY()) RangeManagerType::pos_range_.setMinY(it->getMin()[0]);
         if (it->getMax()[0] > RangeManagerType::pos_range_.maxY()) RangeManagerType::pos_range_.setMaxY(it->getMax()[0]);
@@ -313,8 +377,6 @@ namespace OpenMS
 
       total_size_ += it->size();
 
-      it->updateRanges();
-
       // RT
       if (it->getMin()[0] < RangeManagerType::pos_range_.minX()) RangeManagerType::pos_range_.setMinX(it->getMin()[0]);
       if (it->getMax()[0] > RangeManagerType::pos_range_.maxX()) RangeManagerType::pos_range_.setMaxX(it->getMax()[0]);
@@ -373,6 +435,59 @@ namespace OpenMS
 
   ///@}
 
+  void MSExperiment::getPeakArrays(std::vector<CoordinateType>& mz, std::vector<IntensityType>& intensity, std::vector<Size>& offsets) const
+  {
+    offsets.resize(spectra_.size() + 1);
+    offsets[0] = 0;
+    for (Size i = 0; i < spectra_.size(); ++i)
+    {
+      offsets[i + 1] = offsets[i] + spectra_[i].size();
+    }
+    mz.resize(offsets.back());
+    intensity.resize(offsets.back());
+
+#pragma omp parallel for schedule(dynamic, 64)
+    for (SignedSize i = 0; i < (SignedSize)spectra_.size(); ++i)
+    {
+      Size pos = offsets[i];
+      for (const PeakType& p : spectra_[i])
+      {
+        mz[pos] = p.getMZ();
+        intensity[pos] = p.getIntensity();
+        ++pos;
+      }
+    }
+  }
+
+  void MSExperiment::setPeakArrays(const std::vector<CoordinateType>& mz, const std::vector<IntensityType>& intensity, const std::vector<Size>& offsets)
+  {
+    if (offsets.size() != spectra_.size() + 1 || offsets.front() != 0 || offsets.back() != mz.size() || mz.size() != intensity.size())
+    {
+      throw Exception::Precondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Peak arrays do not match the spectra of the experiment.");
+    }
+    for (Size i = 0; i < spectra_.size(); ++i)
+    {
+      if (offsets[i] > offsets[i + 1])
+      {
+        throw Exception::Precondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Peak array offsets must be ascending.");
+      }
+    }
+
+#pragma omp parallel for schedule(dynamic, 64)
+    for (SignedSize i = 0; i < (SignedSize)spectra_.size(); ++i)
+    {
+      MSSpectrum& spec = spectra_[i];
+      spec.resize(offsets[i + 1] - offsets[i]);
+      Size pos = offsets[i];
+      for (PeakType& p : spec)
+      {
+        p.setMZ(mz[pos]);
+        p.setIntensity(intensity[pos]);
+        ++pos;
+      }
+    }
+  }
+
   ///@name Sorting spectra and peaks
   ///@{
   /**
@@ -599,6 +714,77 @@ namespace OpenMS
   void MSExperiment::setSpectra(const std::vector<MSSpectrum> & spectra)
   {
     spectra_ = spectra;
+    clearLookupIndices();
+  }
+
+  SignedSize MSExperiment::findSpectrumByNativeID(const String& native_id) const
+  {
+    SignedSize result;
+#pragma omp critical (OPENMS_MSExperiment_lookup)
+    result = findByNativeID_(spectra_, native_id, spectrum_id_index_, spectrum_id_state_.data, spectrum_id_state_.size, spectrum_id_state_.built);
+    return result;
+  }
+
+  SignedSize MSExperiment::findChromatogramByNativeID(const String& native_id) const
+  {
+    SignedSize result;
+#pragma omp critical (OPENMS_MSExperiment_lookup)
+    result = findByNativeID_(chromatograms_, native_id, chromatogram_id_index_, chromatogram_id_state_.data, chromatogram_id_state_.size, chromatogram_id_state_.built);
+    return result;
+  }
+
+  std::vector<Size> MSExperiment::findSpectraByPrecursorMZ(double mz_low, double mz_high, double rt_low, double rt_high) const
+  {
+    std::vector<Size> result;
+#pragma omp critical (OPENMS_MSExperiment_lookup)
+    {
+      for (Size attempt = 0; attempt < 2; ++attempt)
+      {
+        if (!precursor_state_.built || precursor_state_.data != (const void*)spectra_.data() || precursor_state_.size != spectra_.size())
+        {
+          precursor_index_.clear();
+          for (Size i = 0; i < spectra_.size(); ++i)
+          {
+            const MSSpectrum& spec = spectra_[i];
+            if (spec.getMSLevel() < 2 || spec.getPrecursors().empty()) continue;
+            precursor_index_.push_back(PrecursorEntry_{spec.getPrecursors()[0].getMZ(), spec.getRT(), i});
+          }
+          std::stable_sort(precursor_index_.begin(), precursor_index_.end(), [](const PrecursorEntry_& a, const PrecursorEntry_& b) { return a.mz < b.mz; });
+          precursor_state_.data = spectra_.data();
+          precursor_state_.size = spectra_.size();
+          precursor_state_.built = true;
+        }
+
+        result.clear();
+        bool stale = false;
+        auto it = std::lower_bound(precursor_index_.begin(), precursor_index_.end(), mz_low, [](const PrecursorEntry_& e, double mz) { return e.mz < mz; });
+        for (; it != precursor_index_.end() && it->mz <= mz_high; ++it)
+        {
+          if (it->rt < rt_low || it->rt > rt_high) continue;
+          const MSSpectrum& spec = spectra_[it->index];
+          if (spec.getPrecursors().empty() || spec.getPrecursors()[0].getMZ() != it->mz || spec.getRT() != it->rt)
+          {
+            stale = true; // spectra were changed in place
+            break;
+          }
+          result.push_back(it->index);
+        }
+        if (!stale) break;
+        precursor_state_.built = false;
+      }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  void MSExperiment::clearLookupIndices()
+  {
+    spectrum_id_index_.clear();
+    spectrum_id_state_ = IndexState_();
+    chromatogram_id_index_.clear();
+    chromatogram_id_state_ = IndexState_();
+    precursor_index_.clear();
+    precursor_state_ = IndexState_();
   }
 
   /// adds a spectrum to the list
@@ -623,6 +809,7 @@ namespace OpenMS
   void MSExperiment::setChromatograms(const std::vector<MSChromatogram > & chromatograms)
   {
     chromatograms_ = chromatograms;
+    clearLookupIndices();
   }
 
   /// adds a chromatogram to the list
@@ -705,6 +892,7 @@ namespace OpenMS
   void MSExperiment::clear(bool clear_meta_data)
   {
     spectra_.clear();
+    clearLookupIndices();
 
     if (clear_meta_data)
     {
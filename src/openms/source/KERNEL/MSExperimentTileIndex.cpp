@@ -0,0 +1,273 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/KERNEL/MSExperimentTileIndex.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace OpenMS
+{
+  MSExperimentTileIndex::MSExperimentTileIndex() :
+    ms_level_(1),
+    spectra_per_block_(1)
+  {
+  }
+
+  MSExperimentTileIndex::MSExperimentTileIndex(const MSExperiment& exp, UInt ms_level, Size spectra_per_block, Size mz_bins) :
+    MSExperimentTileIndex()
+  {
+    build(exp, ms_level, spectra_per_block, mz_bins);
+  }
+
+  void MSExperimentTileIndex::build(const MSExperiment& exp, UInt ms_level, Size spectra_per_block, Size mz_bins)
+  {
+    if (spectra_per_block == 0 || mz_bins == 0)
+    {
+      throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "The number of spectra per RT block and the number of m/z bins must be positive.");
+    }
+    OPENMS_PRECONDITION(exp.isSorted(true), "Experiment is not sorted by RT and m/z!")
+
+    clear();
+    ms_level_ = ms_level;
+    spectra_per_block_ = spectra_per_block;
+
+    // collect the spectra of the requested level and their m/z range
+    CoordinateType min_mz = std::numeric_limits<CoordinateType>::max();
+    CoordinateType max_mz = -std::numeric_limits<CoordinateType>::max();
+    for (Size s = 0; s < exp.size(); ++s)
+    {
+      if (exp[s].getMSLevel() != ms_level) continue;
+      if (!rts_.empty() && exp[s].getRT() < rts_.back())
+      {
+        throw Exception::Precondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Experiment is not sorted by RT!");
+      }
+      spectra_.push_back(s);
+      rts_.push_back(exp[s].getRT());
+      if (!exp[s].empty())
+      {
+        min_mz = std::min(min_mz, exp[s].front().getMZ());
+        max_mz = std::max(max_mz, exp[s].back().getMZ());
+      }
+    }
+    if (spectra_.empty()) return;
+    if (min_mz > max_mz) min_mz = max_mz = 0.0; // only empty spectra
+
+    // equally wide bins covering [min_mz, max_mz]
+    const CoordinateType bin_width = (max_mz > min_mz) ? (max_mz - min_mz) / mz_bins : 1.0;
+    bin_bounds_.resize(mz_bins);
+    for (Size b = 0; b < mz_bins; ++b)
+    {
+      bin_bounds_[b] = min_mz + b * bin_width;
+    }
+
+    const Size n_blocks = getNumberOfRTBlocks();
+    bin_offsets_.resize(spectra_.size() * (mz_bins + 1));
+    tile_peak_count_.assign(n_blocks * mz_bins, 0);
+    tile_max_intensity_.assign(n_blocks * mz_bins, 0.0f);
+
+    for (Size i = 0; i < spectra_.size(); ++i)
+    {
+      const MSSpectrum& spec = exp[spectra_[i]];
+      UInt* offsets = &bin_offsets_[i * (mz_bins + 1)];
+      UInt* counts = &tile_peak_count_[(i / spectra_per_block) * mz_bins];
+      float* max_int = &tile_max_intensity_[(i / spectra_per_block) * mz_bins];
+
+      // single sweep: offsets[b] is the first peak with m/z >= bin_bounds_[b]
+      Size p = 0;
+      for (Size b = 0; b < mz_bins; ++b)
+      {
+        while (p < spec.size() && spec[p].getMZ() < bin_bounds_[b]) ++p;
+        offsets[b] = static_cast<UInt>(p);
+      }
+      offsets[mz_bins] = static_cast<UInt>(spec.size());
+
+      for (Size b = 0; b < mz_bins; ++b)
+      {
+        counts[b] += offsets[b + 1] - offsets[b];
+        for (UInt q = offsets[b]; q < offsets[b + 1]; ++q)
+        {
+          max_int[b] = std::max(max_int[b], static_cast<float>(spec[q].getIntensity()));
+        }
+      }
+    }
+  }
+
+  void MSExperimentTileIndex::clear()
+  {
+    spectra_.clear();
+    rts_.clear();
+    bin_bounds_.clear();
+    bin_offsets_.clear();
+    tile_peak_count_.clear();
+    tile_max_intensity_.clear();
+  }
+
+  bool MSExperimentTileIndex::empty() const
+  {
+    return spectra_.empty();
+  }
+
+  Size MSExperimentTileIndex::size() const
+  {
+    return spectra_.size();
+  }
+
+  UInt MSExperimentTileIndex::getMSLevel() const
+  {
+    return ms_level_;
+  }
+
+  Size MSExperimentTileIndex::getNumberOfRTBlocks() const
+  {
+    return (spectra_.size() + spectra_per_block_ - 1) / spectra_per_block_;
+  }
+
+  Size MSExperimentTileIndex::getNumberOfMZBins() const
+  {
+    return bin_bounds_.size();
+  }
+
+  Size MSExperimentTileIndex::getTilePeakCount(Size rt_block, Size mz_bin) const
+  {
+    if (rt_block >= getNumberOfRTBlocks())
+    {
+      throw Exception::IndexOverflow(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, rt_block, getNumberOfRTBlocks());
+    }
+    if (mz_bin >= getNumberOfMZBins())
+    {
+      throw Exception::IndexOverflow(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, mz_bin, getNumberOfMZBins());
+    }
+    return tile_peak_count_[rt_block * getNumberOfMZBins() + mz_bin];
+  }
+
+  float MSExperimentTileIndex::getTileMaxIntensity(Size rt_block, Size mz_bin) const
+  {
+    if (rt_block >= getNumberOfRTBlocks())
+    {
+      throw Exception::IndexOverflow(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, rt_block, getNumberOfRTBlocks());
+    }
+    if (mz_bin >= getNumberOfMZBins())
+    {
+      throw Exception::IndexOverflow(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, mz_bin, getNumberOfMZBins());
+    }
+    return tile_max_intensity_[rt_block * getNumberOfMZBins() + mz_bin];
+  }
+
+  Size MSExperimentTileIndex::mzBin_(CoordinateType mz) const
+  {
+    // last bin whose lower boundary is <= mz; using the stored boundaries keeps this consistent with build()
+    Size bin = std::upper_bound(bin_bounds_.begin(), bin_bounds_.end(), mz) - bin_bounds_.begin();
+    return bin == 0 ? 0 : bin - 1;
+  }
+
+  void MSExperimentTileIndex::getPeakRanges(const MSExperiment& exp, CoordinateType min_rt, CoordinateType max_rt, CoordinateType min_mz, CoordinateType max_mz, std::vector<PeakRange>& ranges) const
+  {
+    OPENMS_PRECONDITION(min_rt <= max_rt, "Swapped RT range boundaries!")
+    OPENMS_PRECONDITION(min_mz <= max_mz, "Swapped MZ range boundaries!")
+    OPENMS_PRECONDITION(spectra_.empty() || spectra_.back() < exp.size(), "Index was built for a different experiment!")
+
+    ranges.clear();
+    if (spectra_.empty() || min_mz > max_mz) return;
+
+    const Size n_bins = getNumberOfMZBins();
+    const Size first_bin = mzBin_(min_mz);
+    const Size last_bin = mzBin_(max_mz);
+    const Size first = std::lower_bound(rts_.begin(), rts_.end(), min_rt) - rts_.begin();
+    const Size last = std::upper_bound(rts_.begin(), rts_.end(), max_rt) - rts_.begin();
+
+    Size i = first;
+    while (i < last)
+    {
+      const Size block = i / spectra_per_block_;
+      const Size block_end = std::min(last, (block + 1) * spectra_per_block_);
+
+      // skip RT blocks without any peak in the requested bins
+      const UInt* counts = &tile_peak_count_[block * n_bins];
+      bool has_peaks = false;
+      for (Size b = first_bin; b <= last_bin && !has_peaks; ++b)
+      {
+        has_peaks = counts[b] != 0;
+      }
+      if (!has_peaks)
+      {
+        i = block_end;
+        continue;
+      }
+
+      for (; i < block_end; ++i)
+      {
+        // only the peaks of the touched bins need to be searched
+        const UInt* offsets = &bin_offsets_[i * (n_bins + 1)];
+        if (offsets[first_bin] == offsets[last_bin + 1]) continue;
+
+        const MSSpectrum& spec = exp[spectra_[i]];
+        MSSpectrum::ConstIterator bin_begin = spec.begin() + offsets[first_bin];
+        MSSpectrum::ConstIterator bin_end = spec.begin() + offsets[last_bin + 1];
+        MSSpectrum::ConstIterator begin = spec.MZBegin(bin_begin, min_mz, bin_end);
+        MSSpectrum::ConstIterator end = spec.MZEnd(begin, max_mz, bin_end);
+        if (begin == end) continue;
+
+        PeakRange range;
+        range.spectrum = spectra_[i];
+        range.begin = begin - spec.begin();
+        range.end = end - spec.begin();
+        ranges.push_back(range);
+      }
+    }
+  }
+
+  float MSExperimentTileIndex::getMaxIntensity(CoordinateType min_rt, CoordinateType max_rt, CoordinateType min_mz, CoordinateType max_mz) const
+  {
+    if (spectra_.empty() || min_rt > max_rt || min_mz > max_mz) return 0.0f;
+
+    const Size first = std::lower_bound(rts_.begin(), rts_.end(), min_rt) - rts_.begin();
+    const Size last = std::upper_bound(rts_.begin(), rts_.end(), max_rt) - rts_.begin();
+    if (first >= last) return 0.0f;
+
+    const Size n_bins = getNumberOfMZBins();
+    const Size first_bin = mzBin_(min_mz);
+    const Size last_bin = mzBin_(max_mz);
+    float max_int = 0.0f;
+    for (Size block = first / spectra_per_block_; block <= (last - 1) / spectra_per_block_; ++block)
+    {
+      for (Size b = first_bin; b <= last_bin; ++b)
+      {
+        max_int = std::max(max_int, tile_max_intensity_[block * n_bins + b]);
+      }
+    }
+    return max_int;
+  }
+
+} // namespace OpenMS
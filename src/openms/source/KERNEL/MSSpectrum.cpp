@@ -34,6 +34,7 @@
 
 #include <OpenMS/KERNEL/MSSpectrum.h>
 
+#include <OpenMS/DATASTRUCTURES/RadixSort.h>
 #include <OpenMS/FORMAT/PeakTypeEstimator.h>
 
 namespace OpenMS
@@ -375,23 +376,13 @@ namespace OpenMS
     }
     else
     {
-      //sort index list
-      std::vector<std::pair<PeakType::PositionType, Size> > sorted_indices;
-      sorted_indices.reserve(ContainerType::size());
-      for (Size i = 0; i < ContainerType::size(); ++i)
+      // compute the sorting permutation (radix sort on the m/z values) and apply it to peaks and data arrays
+      std::vector<double> mz(ContainerType::size());
+      for (Size i = 0; i < mz.size(); ++i)
       {
-        sorted_indices.push_back(std::make_pair(ContainerType::operator[](i).getPosition(), i));
+        mz[i] = ContainerType::operator[](i).getMZ();
       }
-      std::stable_sort(sorted_indices.begin(), sorted_indices.end(), PairComparatorFirstElement<std::pair<PeakType::PositionType, Size> >());
-
-      // extract list of indices
-      std::vector<Size> select_indices;
-      select_indices.reserve(sorted_indices.size());
-      for (Size i = 0; i < sorted_indices.size(); ++i)
-      {
-        select_indices.push_back(sorted_indices[i].second);
-      }
-      select(select_indices);
+      select(RadixSort::sortPermutation(mz));
     }
   }
 
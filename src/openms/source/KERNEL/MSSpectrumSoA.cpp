@@ -0,0 +1,127 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/KERNEL/MSSpectrumSoA.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace OpenMS
+{
+  MSSpectrumSoA::MSSpectrumSoA(const MSSpectrum& spectrum)
+  {
+    assign(spectrum);
+  }
+
+  void MSSpectrumSoA::assign(const MSSpectrum& spectrum)
+  {
+    const Size n = spectrum.size();
+    mz_.resize(n);
+    intensity_.resize(n);
+    for (Size i = 0; i < n; ++i)
+    {
+      mz_[i] = spectrum[i].getMZ();
+      intensity_[i] = spectrum[i].getIntensity();
+    }
+  }
+
+  void MSSpectrumSoA::writeTo(MSSpectrum& spectrum) const
+  {
+    if (spectrum.size() != mz_.size() || intensity_.size() != mz_.size())
+    {
+      throw Exception::Precondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Number of peaks in spectrum and arrays differ.");
+    }
+    for (Size i = 0; i < mz_.size(); ++i)
+    {
+      spectrum[i].setMZ(mz_[i]);
+      spectrum[i].setIntensity(intensity_[i]);
+    }
+  }
+
+  void MSSpectrumSoA::clear()
+  {
+    mz_.clear();
+    intensity_.clear();
+  }
+
+  Size MSSpectrumSoA::mzBegin(CoordinateType mz) const
+  {
+    return Size(std::lower_bound(mz_.begin(), mz_.end(), mz) - mz_.begin());
+  }
+
+  Size MSSpectrumSoA::mzEnd(CoordinateType mz) const
+  {
+    return Size(std::upper_bound(mz_.begin(), mz_.end(), mz) - mz_.begin());
+  }
+
+  Size MSSpectrumSoA::findNearest(CoordinateType mz) const
+  {
+    // no peak => no search
+    if (mz_.empty()) throw Exception::Precondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "There must be at least one peak to determine the nearest peak!");
+
+    // search for position for inserting
+    const Size i = mzBegin(mz);
+    // border cases
+    if (i == 0) return 0;
+    if (i == mz_.size()) return mz_.size() - 1;
+
+    // the peak before or the current peak are closest
+    if (std::fabs(mz_[i] - mz) < std::fabs(mz_[i - 1] - mz))
+    {
+      return i;
+    }
+    return i - 1;
+  }
+
+  Int MSSpectrumSoA::findNearest(CoordinateType mz, CoordinateType tolerance) const
+  {
+    if (mz_.empty()) return -1;
+    const Size i = findNearest(mz);
+    const double found_mz = mz_[i];
+    if (found_mz >= mz - tolerance && found_mz <= mz + tolerance)
+    {
+      return static_cast<Int>(i);
+    }
+    return -1;
+  }
+
+  double MSSpectrumSoA::sumIntensity(Size begin, Size end) const
+  {
+    end = std::min(end, intensity_.size());
+    if (begin >= end) return 0.0;
+    return std::accumulate(intensity_.begin() + begin, intensity_.begin() + end, 0.0);
+  }
+
+} // namespace OpenMS
@@ -36,8 +36,44 @@
 
 #include <OpenMS/FORMAT/MzMLFile.h>
 
+#include <QtCore/QFileInfo>
+
+#include <cstring>
+#include <fstream>
+
 namespace OpenMS
 {
+  namespace
+  {
+    const char SPECTRUM_HEADER_MAGIC[16] = "OPENMS_SPHDR_01";
+
+    /// value of attribute @p name in the XML start tag @p tag (empty if not present)
+    String attributeValue(const String& tag, const String& name)
+    {
+      for (const char* quote : {"\"", "'"})
+      {
+        String key = " " + name + "=" + quote;
+        Size pos = tag.find(key);
+        if (pos == String::npos) continue;
+        pos += key.size();
+        Size end = tag.find(quote, pos);
+        if (end != String::npos) return tag.substr(pos, end - pos);
+      }
+      return "";
+    }
+
+    /// start tag of the first cvParam with @p accession in @p xml between @p begin and @p end (empty if there is none)
+    String cvParamTag(const String& xml, const String& accession, Size begin = 0, Size end = String::npos)
+    {
+      Size pos = xml.find("\"" + accession + "\"", begin);
+      if (pos == String::npos || pos >= end) return "";
+      Size tag_begin = xml.rfind('<', pos);
+      Size tag_end = xml.find('>', pos);
+      if (tag_begin == String::npos || tag_end == String::npos) return "";
+      return xml.substr(tag_begin, tag_end - tag_begin);
+    }
+  }
+
 
   void OnDiscMSExperiment::loadMetaData_(const String& filename)
   {
@@ -114,5 +150,189 @@ namespace OpenMS
     return spec;
   }
 
-} //namespace OpenMS
+  void OnDiscMSExperiment::loadMetaData()
+  {
+    if (!meta_ms_experiment_ && !filename_.empty())
+    {
+      loadMetaData_(filename_);
+    }
+  }
+
+  String OnDiscMSExperiment::getSpectrumHeaderFilename(const String& filename)
+  {
+    return filename + ".headers";
+  }
+
+  const std::vector<OnDiscMSExperiment::SpectrumHeader>& OnDiscMSExperiment::getSpectrumHeaders()
+  {
+    if (!indexed_mzml_file_.getParsingSuccess())
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_, "File is not an indexed mzML file");
+    }
+    if (!spectrum_headers_.empty() || empty())
+    {
+      return spectrum_headers_;
+    }
+
+    if (meta_ms_experiment_)
+    {
+      buildSpectrumHeadersFromMetaData_();
+      return spectrum_headers_;
+    }
 
+    const String header_file = getSpectrumHeaderFilename(filename_);
+    if (loadSpectrumHeaders_(header_file))
+    {
+      return spectrum_headers_;
+    }
+    if (!buildSpectrumHeadersFromFile_())
+    {
+      loadMetaData_(filename_);
+      buildSpectrumHeadersFromMetaData_();
+    }
+    storeSpectrumHeaders_(header_file);
+    return spectrum_headers_;
+  }
+
+  String OnDiscMSExperiment::getSpectrumNativeID(Size id)
+  {
+    const std::vector<SpectrumHeader>& headers = getSpectrumHeaders();
+    if (id >= headers.size())
+    {
+      throw Exception::IndexOverflow(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, id, headers.size());
+    }
+    return spectrum_header_ids_.substr(headers[id].native_id_offset, headers[id].native_id_length);
+  }
+
+  void OnDiscMSExperiment::buildSpectrumHeadersFromMetaData_()
+  {
+    spectrum_headers_.clear();
+    spectrum_header_ids_.clear();
+    spectrum_headers_.reserve(meta_ms_experiment_->size());
+    for (const MSSpectrum& spec : meta_ms_experiment_->getSpectra())
+    {
+      SpectrumHeader header;
+      header.rt = spec.getRT();
+      header.ms_level = spec.getMSLevel();
+      header.precursor_mz = spec.getPrecursors().empty() ? 0.0 : spec.getPrecursors()[0].getMZ();
+      header.precursor_charge = spec.getPrecursors().empty() ? 0 : spec.getPrecursors()[0].getCharge();
+      header.native_id_offset = spectrum_header_ids_.size();
+      header.native_id_length = spec.getNativeID().size();
+      spectrum_header_ids_ += spec.getNativeID();
+      spectrum_headers_.push_back(header);
+    }
+  }
+
+  bool OnDiscMSExperiment::buildSpectrumHeadersFromFile_()
+  {
+    spectrum_headers_.clear();
+    spectrum_header_ids_.clear();
+    spectrum_headers_.reserve(getNrSpectra());
+    for (Size i = 0; i < getNrSpectra(); ++i)
+    {
+      const String xml = indexed_mzml_file_.getSpectrumHeaderById(int(i));
+
+      SpectrumHeader header;
+      const String native_id = attributeValue(xml.prefix(std::min(xml.find('>'), xml.size())), "id");
+      header.native_id_offset = spectrum_header_ids_.size();
+      header.native_id_length = native_id.size();
+      spectrum_header_ids_ += native_id;
+
+      // MS level and scan start time are mandatory
+      String ms_level = attributeValue(cvParamTag(xml, "MS:1000511"), "value");
+      String rt_tag = cvParamTag(xml, "MS:1000016");
+      String rt = attributeValue(rt_tag, "value");
+      if (ms_level.empty() || rt.empty())
+      {
+        return false;
+      }
+      try
+      {
+        header.ms_level = ms_level.toInt();
+        header.rt = rt.toDouble();
+        if (attributeValue(rt_tag, "unitAccession") == "UO:0000031") // minutes
+        {
+          header.rt *= 60.0;
+        }
+
+        // first selected ion of the first precursor
+        header.precursor_mz = 0.0;
+        header.precursor_charge = 0;
+        Size precursor = xml.find("<precursor");
+        if (precursor != String::npos)
+        {
+          Size precursor_end = xml.find("</precursor>", precursor);
+          String mz = attributeValue(cvParamTag(xml, "MS:1000744", precursor, precursor_end), "value");
+          String charge = attributeValue(cvParamTag(xml, "MS:1000041", precursor, precursor_end), "value");
+          if (!mz.empty()) header.precursor_mz = mz.toDouble();
+          if (!charge.empty()) header.precursor_charge = charge.toInt();
+        }
+      }
+      catch (Exception::ConversionError&)
+      {
+        return false;
+      }
+      spectrum_headers_.push_back(header);
+    }
+    return true;
+  }
+
+  bool OnDiscMSExperiment::loadSpectrumHeaders_(const String& header_file)
+  {
+    QFileInfo header_info(header_file.toQString()), mzml_info(filename_.toQString());
+    if (!header_info.exists() || header_info.lastModified() < mzml_info.lastModified())
+    {
+      return false;
+    }
+
+    std::ifstream is(header_file.c_str(), std::ios::binary);
+    char magic[sizeof(SPECTRUM_HEADER_MAGIC)];
+    UInt64 record_size(0), nr_spectra(0), pool_size(0), mzml_size(0);
+    is.read(magic, sizeof(magic));
+    is.read(reinterpret_cast<char*>(&record_size), sizeof(record_size));
+    is.read(reinterpret_cast<char*>(&nr_spectra), sizeof(nr_spectra));
+    is.read(reinterpret_cast<char*>(&pool_size), sizeof(pool_size));
+    is.read(reinterpret_cast<char*>(&mzml_size), sizeof(mzml_size));
+    if (!is || std::memcmp(magic, SPECTRUM_HEADER_MAGIC, sizeof(magic)) != 0 ||
+        record_size != sizeof(SpectrumHeader) || nr_spectra != getNrSpectra() ||
+        mzml_size != UInt64(mzml_info.size()))
+    {
+      return false;
+    }
+
+    std::vector<SpectrumHeader> headers(nr_spectra);
+    String ids(pool_size, ' ');
+    is.read(reinterpret_cast<char*>(headers.data()), nr_spectra * sizeof(SpectrumHeader));
+    is.read(&ids[0], pool_size);
+    if (!is)
+    {
+      return false;
+    }
+    for (const SpectrumHeader& header : headers)
+    {
+      if (header.native_id_offset + header.native_id_length > pool_size) return false;
+    }
+    spectrum_headers_.swap(headers);
+    spectrum_header_ids_.swap(ids);
+    return true;
+  }
+
+  void OnDiscMSExperiment::storeSpectrumHeaders_(const String& header_file) const
+  {
+    std::ofstream os(header_file.c_str(), std::ios::binary);
+    if (!os)
+    {
+      return; // e.g. no write permission next to the data file
+    }
+    UInt64 record_size(sizeof(SpectrumHeader)), nr_spectra(spectrum_headers_.size());
+    UInt64 pool_size(spectrum_header_ids_.size()), mzml_size(QFileInfo(filename_.toQString()).size());
+    os.write(SPECTRUM_HEADER_MAGIC, sizeof(SPECTRUM_HEADER_MAGIC));
+    os.write(reinterpret_cast<const char*>(&record_size), sizeof(record_size));
+    os.write(reinterpret_cast<const char*>(&nr_spectra), sizeof(nr_spectra));
+    os.write(reinterpret_cast<const char*>(&pool_size), sizeof(pool_size));
+    os.write(reinterpret_cast<const char*>(&mzml_size), sizeof(mzml_size));
+    os.write(reinterpret_cast<const char*>(spectrum_headers_.data()), nr_spectra * sizeof(SpectrumHeader));
+    os.write(spectrum_header_ids_.data(), pool_size);
+  }
+
+} //namespace OpenMS
@@ -16,7 +16,9 @@ MassTrace.cpp
 MRMFeature.cpp
 MRMTransitionGroup.cpp
 MSExperiment.cpp
+MSExperimentTileIndex.cpp
 MSSpectrum.cpp
+MSSpectrumSoA.cpp
 OnDiscMSExperiment.cpp
 Peak1D.cpp
 Peak2D.cpp
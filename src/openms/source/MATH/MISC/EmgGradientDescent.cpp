@@ -285,6 +285,70 @@ namespace OpenMS
     return result;
   }
 
+  double EmgGradientDescent::Loss_and_gradients(
+    const std::vector<double>& xs,
+    const std::vector<double>& ys,
+    const double h,
+    const double mu,
+    const double sigma,
+    const double tau,
+    double& diff_E_h,
+    double& diff_E_mu,
+    double& diff_E_sigma,
+    double& diff_E_tau
+  ) const
+  {
+    const double u = mu;
+    const double s = sigma;
+    const double t = tau;
+    const double s2 = s * s;
+    const double s3 = s2 * s;
+    const double t2 = t * t;
+    const double t3 = t2 * t;
+    const double sqrt_PI_2 = std::sqrt(PI / 2.0);
+    double E { 0.0 };
+    diff_E_h = diff_E_mu = diff_E_sigma = diff_E_tau = 0.0;
+    for (Size i = 0; i < xs.size(); ++i)
+    {
+      const double d = xs[i] - u;
+      const double z = compute_z(xs[i], mu, sigma, tau);
+      const double g = std::exp(-(d * d) / (2.0 * s2));
+      // EMG value and its partial derivatives wrt mu, sigma and tau for h = 1
+      // (the derivative wrt h is the value itself)
+      double f1, df1_mu, df1_sigma, df1_tau;
+      if (z <= 6.71e7)
+      {
+        // Both formulas describe the same function, they only differ in how
+        // the exponential is computed to avoid overflow
+        const double e = z < 0 ? std::exp(s2 / (2.0 * t2) - d / t) : std::exp(z * z - (d * d) / (2.0 * s2));
+        f1 = (s / t) * sqrt_PI_2 * e * std::erfc(z);
+        df1_mu = (f1 - g) / t;
+        df1_sigma = f1 * (1.0 / s + s / t2) - g * (s / t) * (1.0 / t + d / s2);
+        df1_tau = f1 * (d / t2 - s2 / t3 - 1.0 / t) + g * s2 / t3;
+      }
+      else
+      {
+        const double q = 1.0 - (t * d) / s2;
+        f1 = g / q;
+        df1_mu = f1 * (d / s2 - t / (s2 * q));
+        df1_sigma = f1 * ((d * d) / s3 - (2.0 * t * d) / (s3 * q));
+        df1_tau = f1 * d / (s2 * q);
+      }
+      const double r = h * f1 - ys[i];
+      E += r * r;
+      diff_E_h += 2.0 * r * f1;
+      diff_E_mu += 2.0 * r * h * df1_mu;
+      diff_E_sigma += 2.0 * r * h * df1_sigma;
+      diff_E_tau += 2.0 * r * h * df1_tau;
+    }
+    const double n = static_cast<double>(xs.size());
+    diff_E_h /= n;
+    diff_E_mu /= n;
+    diff_E_sigma /= n;
+    diff_E_tau /= n;
+    return E / n;
+  }
+
   void EmgGradientDescent::applyEstimatedParameters(
     const std::vector<double>& xs,
     const double h,
@@ -644,8 +708,18 @@ namespace OpenMS
         break;
       }
 
-      // Compute the cost given the current parameters
-      const double current_E = Loss_function(TrX, TrY, h, mu, sigma, tau);
+      // Compute the cost and its partial derivatives given the current parameters
+      // in a single pass over the training set
+      double diff_E_h, diff_E_mu, diff_E_sigma, diff_E_tau;
+      const double current_E = Loss_and_gradients(TrX, TrY, h, mu, sigma, tau, diff_E_h, diff_E_mu, diff_E_sigma, diff_E_tau);
+      if (print_debug_ == 2) // the terms of each point are only printed by the separate functions
+      {
+        Loss_function(TrX, TrY, h, mu, sigma, tau);
+        E_wrt_h(TrX, TrY, h, mu, sigma, tau);
+        E_wrt_mu(TrX, TrY, h, mu, sigma, tau);
+        E_wrt_sigma(TrX, TrY, h, mu, sigma, tau);
+        E_wrt_tau(TrX, TrY, h, mu, sigma, tau);
+      }
 
       // Break if the computed cost is an invalid value
       if (std::isnan(current_E) || std::isinf(current_E))
@@ -666,12 +740,6 @@ namespace OpenMS
         best_iter = iter_idx;
       }
 
-      // Compute the partial derivatives given the current parameters
-      double diff_E_h = E_wrt_h(TrX, TrY, h, mu, sigma, tau);
-      double diff_E_mu = E_wrt_mu(TrX, TrY, h, mu, sigma, tau);
-      double diff_E_sigma = E_wrt_sigma(TrX, TrY, h, mu, sigma, tau);
-      double diff_E_tau = E_wrt_tau(TrX, TrY, h, mu, sigma, tau);
-
       // Logging info to the terminal
       if (print_debug_ == 1 && iter_idx % info_iter_threshold == 0)
       {
@@ -33,6 +33,7 @@
 #include <algorithm>  // for min() and max() in VS2013
 #include <climits>
 #include <cmath>
+#include <cstddef>
 #include <iostream>
 #include <OpenMS/MATH/MISC/MSNumpress.h>
 
@@ -684,12 +685,25 @@ double optimalSlofFixedPoint(
 	if (dataSize == 0) return 0;
 	
 	double maxDouble = 1;
-	double x;
 	double fp;
 
-	for (size_t i=0; i<dataSize; i++) {
-		x = log(data[i]+1);
-		maxDouble = max(maxDouble, x);
+	// the maximum is order-independent, so large arrays are scanned in chunks
+	const ptrdiff_t n = static_cast<ptrdiff_t>(dataSize);
+#ifdef _OPENMP
+#pragma omp parallel if (n >= MS_NUMPRESS_PARALLEL_MIN_SIZE)
+#endif
+	{
+		double localMax = 1;
+#ifdef _OPENMP
+#pragma omp for nowait
+#endif
+		for (ptrdiff_t i=0; i<n; i++) {
+			localMax = max(localMax, log(data[i]+1));
+		}
+#ifdef _OPENMP
+#pragma omp critical (MSNumpress_optimalSlofFixedPoint)
+#endif
+		maxDouble = max(maxDouble, localMax);
 	}
 
 	// here we use 0xFFFE as maximal value as we add 0.5 during encoding (see encodeSlof)
@@ -709,25 +723,30 @@ size_t encodeSlof(
 		unsigned char *result,
 		double fixedPoint
 ) {
-	size_t i, ri;
-	double temp;
-	unsigned short x;
 	encodeFixedPoint(fixedPoint, result);
 
-	ri = 8;
-	for (i=0; i<dataSize; i++) {
-		temp = log(data[i]+1) * fixedPoint;
-
-		if (MS_NUMPRESS_THROW_ON_OVERFLOW && 
-				temp > USHRT_MAX		) {
-			throw "[MSNumpress::encodeSlof] Cannot encode a number that overflows USHRT_MAX.";
-		}
+	// every value is encoded independently into its own two bytes, so large
+	// arrays are split into chunks (throwing is not allowed inside the
+	// parallel region, an overflow is only flagged and reported afterwards)
+	const ptrdiff_t n = static_cast<ptrdiff_t>(dataSize);
+	unsigned char *out = result + 8;
+	int overflow = 0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(|:overflow) if (n >= MS_NUMPRESS_PARALLEL_MIN_SIZE)
+#endif
+	for (ptrdiff_t i=0; i<n; i++) {
+		double temp = log(data[i]+1) * fixedPoint;
+		overflow |= (temp > USHRT_MAX);
+
+		unsigned short x = static_cast<unsigned short>(temp + 0.5);
+		out[2*i] = x & 0xff;
+		out[2*i+1] = (x >> 8) & 0xff; 
+	}
 
-		x = static_cast<unsigned short>(temp + 0.5);
-		result[ri++] = x & 0xff;
-		result[ri++] = (x >> 8) & 0xff; 
+	if (MS_NUMPRESS_THROW_ON_OVERFLOW && overflow) {
+		throw "[MSNumpress::encodeSlof] Cannot encode a number that overflows USHRT_MAX.";
 	}
-	return ri;
+	return 8 + 2 * dataSize;
 }
 
 
@@ -737,21 +756,26 @@ size_t decodeSlof(
 		const size_t dataSize, 
 		double *result
 ) {
-	size_t i, ri;
-	unsigned short x;
 	double fixedPoint;
 
 	if (dataSize < 8) 
 		throw "[MSNumpress::decodeSlof] Corrupt input data: not enough bytes to read fixed point! ";
 	
-	ri = 0;
 	fixedPoint = decodeFixedPoint(data);
 
-	for (i=8; i<dataSize; i+=2) {
-		x = static_cast<unsigned short>(data[i] | (data[i+1] << 8));
-		result[ri++] = exp(x / fixedPoint) - 1;
+	// values are independent of each other: the loop has no carried state
+	// (the compiler can vectorize the byte unpacking) and large arrays are
+	// decoded in parallel chunks. A trailing odd byte is ignored.
+	const ptrdiff_t n = static_cast<ptrdiff_t>((dataSize - 8) / 2);
+	const unsigned char *in = data + 8;
+#ifdef _OPENMP
+#pragma omp parallel for if (n >= MS_NUMPRESS_PARALLEL_MIN_SIZE)
+#endif
+	for (ptrdiff_t i=0; i<n; i++) {
+		unsigned short x = static_cast<unsigned short>(in[2*i] | (in[2*i+1] << 8));
+		result[i] = exp(x / fixedPoint) - 1;
 	}
-	return ri;
+	return static_cast<size_t>(n);
 }
 
 
@@ -48,6 +48,7 @@
 #include <QDir>
 
 #include <algorithm>
+#include <array>
 
 
 
@@ -57,6 +58,112 @@ namespace OpenMS
 {
   namespace Math
   {
+    namespace
+    {
+      /// number of data points per block for the parallel sums of the EM algorithm
+      const Size em_block_size = 16384;
+
+      /**
+        @brief Adds up the values added to the @p N sums by @p add(i, sums) for all i in [0, n) in parallel
+
+        Every block of em_block_size data points is summed up sequentially, then the partial sums of
+        the blocks are added up in order. The result thus does not depend on the number of threads
+        (and is the plain sequential sum for up to em_block_size data points).
+      */
+      template <Size N, typename AddFunction>
+      std::array<double, N> blockSums(Size n, const AddFunction& add)
+      {
+        const SignedSize n_blocks = (n + em_block_size - 1) / em_block_size;
+        std::vector<std::array<double, N> > partial_sums(n_blocks);
+#pragma omp parallel for schedule(static)
+        for (SignedSize b = 0; b < n_blocks; ++b)
+        {
+          std::array<double, N> sums{};
+          const Size end = std::min(n, Size(b + 1) * em_block_size);
+          for (Size i = Size(b) * em_block_size; i < end; ++i)
+          {
+            add(i, sums);
+          }
+          partial_sums[b] = sums;
+        }
+        std::array<double, N> total{};
+        for (const std::array<double, N>& sums : partial_sums)
+        {
+          for (Size k = 0; k < N; ++k) total[k] += sums[k];
+        }
+        return total;
+      }
+
+      /// weight of data point @p i (all data points have weight one if @p weights is empty)
+      inline double weightAt(const vector<double>& weights, Size i)
+      {
+        return weights.empty() ? 1.0 : weights[i];
+      }
+
+      /// weighted sum of @p values
+      double weightedSum(const vector<double>& values, const vector<double>& weights)
+      {
+        return blockSums<1>(values.size(), [&](Size i, std::array<double, 1>& sums)
+        {
+          sums[0] += weightAt(weights, i) * values[i];
+        })[0];
+      }
+
+      /// weighted sums of the scores for the correct (first) and incorrect (second) component
+      std::pair<double, double> weightedMeans(const vector<double>& x_scores, const vector<double>& incorrect_posteriors, const vector<double>& weights)
+      {
+        std::array<double, 2> sums = blockSums<2>(incorrect_posteriors.size(), [&](Size i, std::array<double, 2>& sums)
+        {
+          const double w = weightAt(weights, i);
+          sums[0] += w * (1. - incorrect_posteriors[i]) * x_scores[i];
+          sums[1] += w * incorrect_posteriors[i] * x_scores[i];
+        });
+        return {sums[0], sums[1]};
+      }
+
+      /// weighted sums of the squared deviations from @p means for the correct (first) and incorrect (second) component
+      std::pair<double, double> weightedSigmas(const vector<double>& x_scores, const vector<double>& incorrect_posteriors, const std::pair<double, double>& means, const vector<double>& weights)
+      {
+        std::array<double, 2> sums = blockSums<2>(incorrect_posteriors.size(), [&](Size i, std::array<double, 2>& sums)
+        {
+          const double w = weightAt(weights, i);
+          sums[0] += w * (1. - incorrect_posteriors[i]) * pow(x_scores[i] - means.first, 2);
+          sums[1] += w * incorrect_posteriors[i] * pow(x_scores[i] - means.second, 2);
+        });
+        return {sums[0], sums[1]};
+      }
+
+      /**
+        @brief Bins the @p scores into @p n_bins bins of equal width
+
+        Every non-empty bin is represented by the mean of its scores (@p bin_scores) and
+        the number of scores in it (@p bin_weights).
+      */
+      void binScores(const vector<double>& scores, Size n_bins, vector<double>& bin_scores, vector<double>& bin_weights)
+      {
+        const std::pair<vector<double>::const_iterator, vector<double>::const_iterator> min_max = std::minmax_element(scores.begin(), scores.end());
+        const double min = *min_max.first;
+        const double width = (*min_max.second - min) / n_bins;
+
+        vector<double> sums(n_bins, 0.0), counts(n_bins, 0.0);
+        for (double score : scores)
+        {
+          const Size bin = (width > 0) ? std::min(n_bins - 1, Size((score - min) / width)) : 0;
+          sums[bin] += score;
+          counts[bin] += 1.0;
+        }
+
+        bin_scores.clear();
+        bin_weights.clear();
+        for (Size bin = 0; bin < n_bins; ++bin)
+        {
+          if (counts[bin] == 0) continue;
+          bin_scores.push_back(sums[bin] / counts[bin]);
+          bin_weights.push_back(counts[bin]);
+        }
+      }
+    }
+
     PosteriorErrorProbabilityModel::PosteriorErrorProbabilityModel() :
       DefaultParamHandler("PosteriorErrorProbabilityModel"),
       incorrectly_assigned_fit_param_(GaussFitter::GaussFitResult(-1, -1, -1)),
@@ -70,6 +177,8 @@ namespace OpenMS
       defaults_.setValue("max_nr_iterations", 1000, "Bounds the number of iterations for the EM algorithm when convergence is slow.", ListUtils::create<String>("advanced"));
       defaults_.setValidStrings("incorrectly_assigned", ListUtils::create<String>("Gumbel,Gauss"));
       defaults_.setValue("neg_log_delta",6, "The negative logarithm of the convergence threshold for the likelihood increase.");
+      defaults_.setValue("em_bins", 0, "Approximate the fit for large data sets: if more than ten times as many scores are given, the EM algorithm runs on this number of equally sized score bins (represented by their mean score and weighted by their size) instead of the individual scores. 0 = always use all scores.", ListUtils::create<String>("advanced"));
+      defaults_.setMinInt("em_bins", 0);
       defaults_.setValue("outlier_handling","ignore_iqr_outliers", "What to do with outliers:\n"
                                                                    "- ignore_iqr_outliers: ignore outliers outside of 3*IQR from Q1/Q3 for fitting\n"
                                                                    "- set_iqr_to_closest_valid: set IQR-based outliers to the last valid value for fitting\n"
@@ -151,7 +260,7 @@ namespace OpenMS
       vector<double> bins;
       vector<double> incorrect_posteriors;
       double maxlike = computeLLAndIncorrectPosteriorsFromLogDensities(incorrect_log_density, correct_log_density, incorrect_posteriors);
-      double sumIncorrectPosteriors = Math::sum(incorrect_posteriors.begin(),incorrect_posteriors.end());
+      double sumIncorrectPosteriors = weightedSum(incorrect_posteriors, vector<double>());
       double sumCorrectPosteriors = x_scores.size() - sumIncorrectPosteriors;
 
       OpenMS::Math::GumbelMaxLikelihoodFitter gmlf{incorrectly_assigned_fit_gumbel_param_};
@@ -160,23 +269,10 @@ namespace OpenMS
       {
         //-------------------------------------------------------------
         // E-STEP (gauss)
-        double newGaussMean = 0.0;
-        auto the_x = x_scores.cbegin();
-
-        for (auto incorrect = incorrect_posteriors.cbegin(); incorrect != incorrect_posteriors.cend(); ++incorrect, ++the_x)
-        {
-          newGaussMean += (1.-*incorrect) * *the_x;
-        }
-        newGaussMean /= sumCorrectPosteriors;
+        double newGaussMean = weightedMeans(x_scores, incorrect_posteriors, vector<double>()).first / sumCorrectPosteriors;
 
-        double newGaussSigma = 0.0;
-        the_x = x_scores.cbegin();
-
-        for (auto incorrect = incorrect_posteriors.cbegin(); incorrect != incorrect_posteriors.cend(); ++incorrect, ++the_x)
-        {
-          newGaussSigma += (1. - *incorrect) * pow((*the_x) - newGaussMean, 2);
-        }
-        newGaussSigma = sqrt(newGaussSigma/sumCorrectPosteriors);
+        const std::pair<double, double> means(newGaussMean, newGaussMean);
+        double newGaussSigma = sqrt(weightedSigmas(x_scores, incorrect_posteriors, means, vector<double>()).first / sumCorrectPosteriors);
 
         GumbelMaxLikelihoodFitter::GumbelDistributionFitResult newGumbelParams = gmlf.fitWeighted(x_scores, incorrect_posteriors);
 
@@ -197,7 +293,7 @@ namespace OpenMS
         // compute new prior probabilities negative peptides
         fillLogDensitiesGumbel(x_scores, incorrect_log_density, correct_log_density);
         double new_maxlike = computeLLAndIncorrectPosteriorsFromLogDensities(incorrect_log_density, correct_log_density, incorrect_posteriors);
-        sumIncorrectPosteriors = Math::sum(incorrect_posteriors.begin(),incorrect_posteriors.end());
+        sumIncorrectPosteriors = weightedSum(incorrect_posteriors, vector<double>());
         sumCorrectPosteriors = x_scores.size() - sumIncorrectPosteriors;
         negative_prior_ = sumIncorrectPosteriors / x_scores.size();
 
@@ -333,23 +429,34 @@ namespace OpenMS
       int delta = param_.getValue("neg_log_delta");
       int itns = 0;
 
+      // optionally run the EM algorithm on binned scores for large data sets
+      const Size em_bins = (Int)param_.getValue("em_bins");
+      vector<double> binned_scores, weights; // no weights: every score has weight one
+      if (em_bins > 0 && x_scores.size() > 10 * em_bins)
+      {
+        binScores(x_scores, em_bins, binned_scores, weights);
+      }
+      const vector<double>& em_scores = weights.empty() ? x_scores : binned_scores;
+      const double n_scores = x_scores.size();
+
+      // buffers are reused in all iterations
       vector<double> incorrect_log_density, correct_log_density;
-      fillLogDensities(x_scores, incorrect_log_density, correct_log_density);
+      fillLogDensities(em_scores, incorrect_log_density, correct_log_density);
       vector<double> incorrect_posteriors;
-      double maxlike = computeLLAndIncorrectPosteriorsFromLogDensities(incorrect_log_density, correct_log_density, incorrect_posteriors);
-      double sumIncorrectPosteriors = Math::sum(incorrect_posteriors.begin(),incorrect_posteriors.end());
-      double sumCorrectPosteriors = x_scores.size() - sumIncorrectPosteriors;
+      double maxlike = computeLLAndIncorrectPosteriors_(incorrect_log_density, correct_log_density, weights, incorrect_posteriors);
+      double sumIncorrectPosteriors = weightedSum(incorrect_posteriors, weights);
+      double sumCorrectPosteriors = n_scores - sumIncorrectPosteriors;
 
       do
       {
         //-------------------------------------------------------------
         // E-STEP
-        std::pair<double,double> newMeans = pos_neg_mean_weighted_posteriors(x_scores, incorrect_posteriors);
+        std::pair<double,double> newMeans = weightedMeans(em_scores, incorrect_posteriors, weights);
         newMeans.first /= sumCorrectPosteriors;
         newMeans.second /= sumIncorrectPosteriors;
 
         //new standard deviation
-        std::pair<double,double> newSigmas = pos_neg_sigma_weighted_posteriors(x_scores, incorrect_posteriors, newMeans);
+        std::pair<double,double> newSigmas = weightedSigmas(em_scores, incorrect_posteriors, newMeans, weights);
         newSigmas.first = sqrt(newSigmas.first/sumCorrectPosteriors);
         newSigmas.second = sqrt(newSigmas.second/sumIncorrectPosteriors);
 
@@ -371,11 +478,11 @@ namespace OpenMS
 
 
         // compute new prior probabilities negative peptides
-        fillLogDensities(x_scores, incorrect_log_density, correct_log_density);
-        double new_maxlike = computeLLAndIncorrectPosteriorsFromLogDensities(incorrect_log_density, correct_log_density, incorrect_posteriors);
-        sumIncorrectPosteriors = Math::sum(incorrect_posteriors.begin(),incorrect_posteriors.end());
-        sumCorrectPosteriors = x_scores.size() - sumIncorrectPosteriors;
-        negative_prior_ = sumIncorrectPosteriors / x_scores.size();
+        fillLogDensities(em_scores, incorrect_log_density, correct_log_density);
+        double new_maxlike = computeLLAndIncorrectPosteriors_(incorrect_log_density, correct_log_density, weights, incorrect_posteriors);
+        sumIncorrectPosteriors = weightedSum(incorrect_posteriors, weights);
+        sumCorrectPosteriors = n_scores - sumIncorrectPosteriors;
+        negative_prior_ = sumIncorrectPosteriors / n_scores;
 
         if (std::isnan(new_maxlike - maxlike))
         {
@@ -461,15 +568,12 @@ namespace OpenMS
         incorrect_density.resize(x_scores.size());
         correct_density.resize(x_scores.size());
       }
-      auto incorrect(incorrect_density.begin());
-      auto correct(correct_density.begin());
-      for (double const & score : x_scores)
+#pragma omp parallel for
+      for (SignedSize i = 0; i < (SignedSize)x_scores.size(); ++i)
       {
         // TODO: incorrect is currently filled with gauss as fitting gumble is not supported
-        *incorrect = incorrectly_assigned_fit_param_.eval(score);
-        *correct = correctly_assigned_fit_param_.eval(score);
-        ++incorrect;
-        ++correct;
+        incorrect_density[i] = incorrectly_assigned_fit_param_.eval(x_scores[i]);
+        correct_density[i] = correctly_assigned_fit_param_.eval(x_scores[i]);
       }
     }
 
@@ -480,14 +584,11 @@ namespace OpenMS
         incorrect_density.resize(x_scores.size());
         correct_density.resize(x_scores.size());
       }
-      auto incorrect(incorrect_density.begin());
-      auto correct(correct_density.begin());
-      for (double const & score : x_scores)
+#pragma omp parallel for
+      for (SignedSize i = 0; i < (SignedSize)x_scores.size(); ++i)
       {
-        *incorrect = incorrectly_assigned_fit_gumbel_param_.log_eval_no_normalize(score);
-        *correct = correctly_assigned_fit_param_.log_eval_no_normalize(score);
-        ++incorrect;
-        ++correct;
+        incorrect_density[i] = incorrectly_assigned_fit_gumbel_param_.log_eval_no_normalize(x_scores[i]);
+        correct_density[i] = correctly_assigned_fit_param_.log_eval_no_normalize(x_scores[i]);
       }
     }
 
@@ -498,15 +599,12 @@ namespace OpenMS
         incorrect_density.resize(x_scores.size());
         correct_density.resize(x_scores.size());
       }
-      auto incorrect(incorrect_density.begin());
-      auto correct(correct_density.begin());
-      for (double const & score : x_scores)
+#pragma omp parallel for
+      for (SignedSize i = 0; i < (SignedSize)x_scores.size(); ++i)
       {
         // TODO: incorrect is currently filled with gauss as fitting gumble is not supported
-        *incorrect = incorrectly_assigned_fit_param_.log_eval_no_normalize(score);
-        *correct = correctly_assigned_fit_param_.log_eval_no_normalize(score);
-        ++incorrect;
-        ++correct;
+        incorrect_density[i] = incorrectly_assigned_fit_param_.log_eval_no_normalize(x_scores[i]);
+        correct_density[i] = correctly_assigned_fit_param_.log_eval_no_normalize(x_scores[i]);
       }
     }
 
@@ -525,20 +623,24 @@ namespace OpenMS
         const vector<double>& incorrect_log_density, const vector<double>& correct_log_density,
         vector<double>& incorrect_posterior)
     {
-      double loglikelihood = 0.0;
+      return computeLLAndIncorrectPosteriors_(incorrect_log_density, correct_log_density, vector<double>(), incorrect_posterior);
+    }
+
+    double PosteriorErrorProbabilityModel::computeLLAndIncorrectPosteriors_(
+        const vector<double>& incorrect_log_density, const vector<double>& correct_log_density,
+        const vector<double>& weights, vector<double>& incorrect_posterior) const
+    {
       double log_prior_pos = log(1. - negative_prior_);
       double log_prior_neg = log(negative_prior_);
-      auto incorrect = incorrect_log_density.cbegin();
       if (incorrect_posterior.size() != incorrect_log_density.size())
       {
         incorrect_posterior.resize(incorrect_log_density.size());
       }
-      auto incorrect_posterior_it = incorrect_posterior.begin();
 
-      for (auto correct = correct_log_density.cbegin(); correct < correct_log_density.cend(); ++correct, ++incorrect, ++incorrect_posterior_it)
+      return blockSums<1>(correct_log_density.size(), [&](Size i, std::array<double, 1>& loglikelihood)
       {
-        double log_resp_correct = log_prior_pos + *correct;
-        double log_resp_incorrect = log_prior_neg + *incorrect;
+        double log_resp_correct = log_prior_pos + correct_log_density[i];
+        double log_resp_incorrect = log_prior_neg + incorrect_log_density[i];
         double max_log_resp = std::max(log_resp_correct,log_resp_incorrect);
         log_resp_correct -= max_log_resp;
         log_resp_incorrect -= max_log_resp;
@@ -546,24 +648,14 @@ namespace OpenMS
         double resp_incorrect = exp(log_resp_incorrect);
         double sum = resp_correct + resp_incorrect;
         // normalize
-        *incorrect_posterior_it = resp_incorrect / sum; //TODO can we somehow stay in log space (i.e. fill as log posteriors?)
-        loglikelihood += max_log_resp + log(sum);
-      }
-      return loglikelihood;
+        incorrect_posterior[i] = resp_incorrect / sum; //TODO can we somehow stay in log space (i.e. fill as log posteriors?)
+        loglikelihood[0] += weightAt(weights, i) * (max_log_resp + log(sum));
+      })[0];
     }
 
     std::pair<double,double> PosteriorErrorProbabilityModel::pos_neg_mean_weighted_posteriors(const vector<double>& x_scores, const vector<double>& incorrect_posteriors)
     {
-      double pos_x0(0);
-      double neg_x0(0);
-      auto the_x = x_scores.cbegin();
-
-      for (auto incorrect = incorrect_posteriors.cbegin(); incorrect < incorrect_posteriors.end(); ++incorrect, ++the_x)
-      {
-        pos_x0 += (1. - *incorrect) * (*the_x);
-        neg_x0 += (*incorrect) * (*the_x);
-      }
-      return {pos_x0,neg_x0};
+      return weightedMeans(x_scores, incorrect_posteriors, vector<double>());
     }
 
 
@@ -573,16 +665,7 @@ namespace OpenMS
         const vector<double>& incorrect_posteriors,
         const std::pair<double,double>& pos_neg_mean)
     {
-      double pos_sigma(0);
-      double neg_sigma(0);
-      auto the_x = x_scores.cbegin();
-
-      for (auto incorrect = incorrect_posteriors.cbegin(); incorrect < incorrect_posteriors.end(); ++incorrect, ++the_x)
-      {
-        pos_sigma += (1. - *incorrect) * pow((*the_x) - pos_neg_mean.first, 2);
-        neg_sigma += (*incorrect) * pow((*the_x) - pos_neg_mean.second, 2);
-      }
-      return {pos_sigma, neg_sigma};
+      return weightedSigmas(x_scores, incorrect_posteriors, pos_neg_mean, vector<double>());
     }
 
     double PosteriorErrorProbabilityModel::computeProbability(double score) const
@@ -0,0 +1,133 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hendrik Weisser $
+// $Authors: Hendrik Weisser $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/METADATA/ID/QueryMatchTable.h>
+
+#include <cmath>
+
+using namespace std;
+
+namespace OpenMS
+{
+  QueryMatchTable::QueryMatchTable(const IdentificationData& id_data)
+  {
+    const IdentificationData::MoleculeQueryMatches& matches =
+      id_data.getMoleculeQueryMatches();
+    match_refs_.reserve(matches.size());
+    query_indices_.reserve(matches.size());
+    molecule_indices_.reserve(matches.size());
+    map<IdentificationData::IdentifiedMoleculeRef, Size> molecule_lookup;
+    for (IdentificationData::QueryMatchRef ref = matches.begin();
+         ref != matches.end(); ++ref)
+    {
+      match_refs_.push_back(ref);
+      // matches are ordered by query, so a new query starts a new group:
+      if (queries_.empty() || (queries_.back() != ref->data_query_ref))
+      {
+        queries_.push_back(ref->data_query_ref);
+      }
+      query_indices_.push_back(queries_.size() - 1);
+      auto pos = molecule_lookup.insert(
+        make_pair(ref->identified_molecule_ref, molecules_.size())).first;
+      if (pos->second == molecules_.size())
+      {
+        molecules_.push_back(ref->identified_molecule_ref);
+      }
+      molecule_indices_.push_back(pos->second);
+    }
+  }
+
+
+  const vector<double>& QueryMatchTable::addScoreColumn(
+    IdentificationData::ScoreTypeRef score_ref)
+  {
+    auto pos = score_columns_.find(score_ref);
+    if (pos != score_columns_.end()) return pos->second;
+
+    vector<double>& column = score_columns_[score_ref];
+    column.resize(match_refs_.size());
+    // look-ups are read-only, so rows can be processed independently:
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (SignedSize row = 0; row < SignedSize(match_refs_.size()); ++row)
+    {
+      column[row] = match_refs_[row]->getScore(score_ref).first; // NaN if missing
+    }
+    return column;
+  }
+
+
+  const vector<double>& QueryMatchTable::getScoreColumn(
+    IdentificationData::ScoreTypeRef score_ref) const
+  {
+    auto pos = score_columns_.find(score_ref);
+    if (pos == score_columns_.end())
+    {
+      throw Exception::ElementNotFound(__FILE__, __LINE__,
+                                       OPENMS_PRETTY_FUNCTION,
+                                       "score column '" + score_ref->cv_term.getName() + "'");
+    }
+    return pos->second;
+  }
+
+
+  vector<Size> QueryMatchTable::getBestMatchPerQuery(
+    IdentificationData::ScoreTypeRef score_ref) const
+  {
+    const vector<double>& scores = getScoreColumn(score_ref);
+    const bool higher_better = score_ref->higher_better;
+    vector<Size> results;
+    results.reserve(queries_.size());
+    for (Size row = 0; row < scores.size(); )
+    {
+      // find the best-scoring row within the group of the current query:
+      Size best_row = row;
+      const Size query_index = query_indices_[row];
+      for (; (row < scores.size()) && (query_indices_[row] == query_index); ++row)
+      {
+        if (std::isnan(scores[row])) continue;
+        if (std::isnan(scores[best_row]) ||
+            IdentificationData::isBetterScore(scores[row], scores[best_row],
+                                              higher_better))
+        {
+          best_row = row;
+        }
+      }
+      if (!std::isnan(scores[best_row])) results.push_back(best_row);
+    }
+    return results;
+  }
+}
@@ -5,6 +5,7 @@ set(directory source/METADATA/ID)
 set(sources_list
 IdentificationData.cpp
 IdentificationDataConverter.cpp
+QueryMatchTable.cpp
 )
 
 ### add path to the filenames
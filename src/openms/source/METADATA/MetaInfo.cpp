@@ -34,6 +34,8 @@
 
 #include <OpenMS/METADATA/MetaInfo.h>
 
+#include <algorithm>
+
 using namespace std;
 
 namespace OpenMS
@@ -41,10 +43,38 @@ namespace OpenMS
 
   MetaInfoRegistry MetaInfo::registry_ = MetaInfoRegistry();
 
+  namespace
+  {
+    bool indexLess_(const std::pair<UInt, DataValue>& entry, UInt index)
+    {
+      return entry.first < index;
+    }
+  }
+
   MetaInfo::~MetaInfo()
   {
   }
 
+  MetaInfo::MapType::const_iterator MetaInfo::lowerBound_(UInt index) const
+  {
+    return std::lower_bound(index_to_value_.begin(), index_to_value_.end(), index, indexLess_);
+  }
+
+  MetaInfo::MapType::iterator MetaInfo::lowerBound_(UInt index)
+  {
+    return std::lower_bound(index_to_value_.begin(), index_to_value_.end(), index, indexLess_);
+  }
+
+  MetaInfo::MapType::const_iterator MetaInfo::find_(UInt index) const
+  {
+    MapType::const_iterator it = lowerBound_(index);
+    if (it != index_to_value_.end() && it->first == index)
+    {
+      return it;
+    }
+    return index_to_value_.end();
+  }
+
   bool MetaInfo::operator==(const MetaInfo& rhs) const
   {
     return index_to_value_ == rhs.index_to_value_;
@@ -57,7 +87,7 @@ namespace OpenMS
 
   const DataValue& MetaInfo::getValue(const String& name, const DataValue& default_value) const
   {
-    MapType::const_iterator it = index_to_value_.find(registry_.getIndex(name));
+    MapType::const_iterator it = find_(registry_.getIndex(name));
     if (it != index_to_value_.end())
     {
       return it->second;
@@ -67,7 +97,7 @@ namespace OpenMS
 
   const DataValue& MetaInfo::getValue(UInt index, const DataValue& default_value) const
   {
-    MapType::const_iterator it = index_to_value_.find(index);
+    MapType::const_iterator it = find_(index);
     if (it != index_to_value_.end())
     {
       return it->second;
@@ -84,18 +114,18 @@ namespace OpenMS
   void MetaInfo::setValue(UInt index, const DataValue& value)
   {
     // @TODO: check if that index is registered in MetaInfoRegistry?
-    auto it = index_to_value_.find(index);
-    if (it != index_to_value_.end())
+    MapType::iterator it = lowerBound_(index);
+    if (it != index_to_value_.end() && it->first == index)
     {
       it->second = value;
     }
     else
     {
       // Note; we need to create a copy of data value here and can't use the const &
-      // The underlying flat_map invalidates references to it if inserting
+      // The underlying vector invalidates references to it if inserting
       // an element leads to relocation (e.g, in constructs like: m.insert(1, m[2]));)
       DataValue tmp = value;
-      index_to_value_.insert(std::make_pair(index, tmp));
+      index_to_value_.insert(it, std::make_pair(index, tmp));
     }
   }
 
@@ -109,29 +139,29 @@ namespace OpenMS
     UInt index = registry_.getIndex(name);
     if (index != UInt(-1))
     {
-      return (index_to_value_.find(index) != index_to_value_.end());
+      return find_(index) != index_to_value_.end();
     }
     return false;
   }
 
   bool MetaInfo::exists(UInt index) const
   {
-    return (index_to_value_.find(index) != index_to_value_.end());
+    return find_(index) != index_to_value_.end();
   }
 
   void MetaInfo::removeValue(const String& name)
   {
-    MapType::iterator it = index_to_value_.find(registry_.getIndex(name));
-    if (it != index_to_value_.end())
+    UInt index = registry_.getIndex(name);
+    if (index != UInt(-1))
     {
-      index_to_value_.erase(it);
+      removeValue(index);
     }
   }
 
   void MetaInfo::removeValue(UInt index)
   {
-    MapType::iterator it = index_to_value_.find(index);
-    if (it != index_to_value_.end())
+    MapType::iterator it = lowerBound_(index);
+    if (it != index_to_value_.end() && it->first == index)
     {
       index_to_value_.erase(it);
     }
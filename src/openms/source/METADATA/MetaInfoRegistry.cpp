@@ -32,89 +32,77 @@
 // $Authors: Marc Sturm, Hendrik Weisser $
 // -------------------------------------------------------------------------
 
-#include <sstream>
-
 #include <OpenMS/METADATA/MetaInfoRegistry.h>
 
+#include <functional>
+
 using namespace std;
 
 namespace OpenMS
 {
 
+  struct MetaInfoRegistry::Entry
+  {
+    std::string name;
+    UInt index;
+    Size hash;
+    std::string description; ///< guarded by the mutex
+    std::string unit; ///< guarded by the mutex
+  };
+
+  struct MetaInfoRegistry::Table
+  {
+    explicit Table(Size size) :
+      capacity(size),
+      slots(new std::atomic<const Entry*>[size])
+    {
+      for (Size i = 0; i < capacity; ++i)
+      {
+        slots[i].store(nullptr, std::memory_order_relaxed);
+      }
+    }
+
+    const Size capacity;
+    std::unique_ptr<std::atomic<const Entry*>[]> slots;
+  };
+
+  namespace
+  {
+    /// initial capacity of the name hash table (a power of two)
+    const Size INITIAL_NAME_CAPACITY = 256;
+    /// initial capacity of the index table (covers the first 1024 registered names)
+    const Size INITIAL_INDEX_CAPACITY = 2048;
+  }
+
   MetaInfoRegistry::MetaInfoRegistry() :
-    next_index_(1024), 
-    name_to_index_(), 
-    index_to_name_(), 
-    index_to_description_(), 
-    index_to_unit_()
+    next_index_(1024),
+    size_(0),
+    name_table_(nullptr),
+    index_table_(nullptr)
   {
-    name_to_index_["isotopic_range"] = 1;
-    index_to_name_[1] = "isotopic_range";
-    index_to_description_[1] = "consecutive numbering of the peaks in an isotope pattern. 0 is the monoisotopic peak";
-    index_to_unit_[1] = "";
-
-    name_to_index_["cluster_id"] = 2;
-    index_to_name_[2] = "cluster_id";
-    index_to_description_[2] = "consecutive numbering of isotope clusters in a spectrum";
-    index_to_unit_[2] = "";
-
-    name_to_index_["label"] = 3;
-    index_to_name_[3] = "label";
-    index_to_description_[3] = "label e.g. shown in visualization";
-    index_to_unit_[3] = "";
-
-    name_to_index_["icon"] = 4;
-    index_to_name_[4] = "icon";
-    index_to_description_[4] = "icon shown in visualization";
-    index_to_unit_[4] = "";
-
-    name_to_index_["color"] = 5;
-    index_to_name_[5] = "color";
-    index_to_description_[5] = "color used for visualization e.g. #FF00FF for purple";
-    index_to_unit_[5] = "";
-
-    name_to_index_["RT"] = 6;
-    index_to_name_[6] = "RT";
-    index_to_description_[6] = "the retention time of an identification";
-    index_to_unit_[6] = "";
-
-    name_to_index_["MZ"] = 7;
-    index_to_name_[7] = "MZ";
-    index_to_description_[7] = "the MZ of an identification";
-    index_to_unit_[7] = "";
-
-    name_to_index_["predicted_RT"] = 8;
-    index_to_name_[8] = "predicted_RT";
-    index_to_description_[8] = "the predicted retention time of a peptide hit";
-    index_to_unit_[8] = "";
-
-    name_to_index_["predicted_RT_p_value"] = 9;
-    index_to_name_[9] = "predicted_RT_p_value";
-    index_to_description_[9] = "the predicted RT p-value of a peptide hit";
-    index_to_unit_[9] = "";
-
-    name_to_index_["spectrum_reference"] = 10;
-    index_to_name_[10] = "spectrum_reference";
-    index_to_description_[10] = "Reference to a spectrum or feature number";
-    index_to_unit_[10] = "";
-
-    name_to_index_["ID"] = 11;
-    index_to_name_[11] = "ID";
-    index_to_description_[11] = "Some type of identifier";
-    index_to_unit_[11] = "";
-
-    name_to_index_["low_quality"] = 12;
-    index_to_name_[12] = "low_quality";
-    index_to_description_[12] = "Flag which indicates that some entity has a low quality (e.g. a feature pair)";
-    index_to_unit_[12] = "";
-
-    name_to_index_["charge"] = 13;
-    index_to_name_[13] = "charge";
-    index_to_description_[13] = "Charge of a feature or peak";
-    index_to_unit_[13] = "";
+    std::lock_guard<std::mutex> lock(mutex_);
+    tables_.emplace_back(new Table(INITIAL_NAME_CAPACITY));
+    name_table_.store(tables_.back().get(), std::memory_order_release);
+    tables_.emplace_back(new Table(INITIAL_INDEX_CAPACITY));
+    index_table_.store(tables_.back().get(), std::memory_order_release);
+
+    insert_("isotopic_range", ISOTOPIC_RANGE, "consecutive numbering of the peaks in an isotope pattern. 0 is the monoisotopic peak", "");
+    insert_("cluster_id", CLUSTER_ID, "consecutive numbering of isotope clusters in a spectrum", "");
+    insert_("label", LABEL, "label e.g. shown in visualization", "");
+    insert_("icon", ICON, "icon shown in visualization", "");
+    insert_("color", COLOR, "color used for visualization e.g. #FF00FF for purple", "");
+    insert_("RT", RT, "the retention time of an identification", "");
+    insert_("MZ", MZ, "the MZ of an identification", "");
+    insert_("predicted_RT", PREDICTED_RT, "the predicted retention time of a peptide hit", "");
+    insert_("predicted_RT_p_value", PREDICTED_RT_P_VALUE, "the predicted RT p-value of a peptide hit", "");
+    insert_("spectrum_reference", SPECTRUM_REFERENCE, "Reference to a spectrum or feature number", "");
+    insert_("ID", ID, "Some type of identifier", "");
+    insert_("low_quality", LOW_QUALITY, "Flag which indicates that some entity has a low quality (e.g. a feature pair)", "");
+    insert_("charge", CHARGE, "Charge of a feature or peak", "");
   }
 
-  MetaInfoRegistry::MetaInfoRegistry(const MetaInfoRegistry& rhs)
+  MetaInfoRegistry::MetaInfoRegistry(const MetaInfoRegistry& rhs) :
+    MetaInfoRegistry()
   {
     *this = rhs;
   }
@@ -127,204 +115,215 @@ namespace OpenMS
   {
     if (this == &rhs) return *this;
 
-#pragma omp critical (MetaInfoRegistry)
+    // copy the entries first, so that both mutexes are never held at the same time
+    vector<Entry> entries;
+    UInt next_index;
+    {
+      std::lock_guard<std::mutex> lock(rhs.mutex_);
+      next_index = rhs.next_index_;
+      entries.reserve(rhs.entries_.size());
+      for (const auto& entry : rhs.entries_)
+      {
+        entries.push_back(*entry);
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_ = 0;
+    entries_.clear();
+    tables_.clear();
+    tables_.emplace_back(new Table(INITIAL_NAME_CAPACITY));
+    name_table_.store(tables_.back().get(), std::memory_order_release);
+    tables_.emplace_back(new Table(INITIAL_INDEX_CAPACITY));
+    index_table_.store(tables_.back().get(), std::memory_order_release);
+    for (const Entry& entry : entries)
     {
-      next_index_ = rhs.next_index_;
-      name_to_index_ = rhs.name_to_index_;
-      index_to_name_ = rhs.index_to_name_;
-      index_to_description_ = rhs.index_to_description_;
-      index_to_unit_ = rhs.index_to_unit_;
+      insert_(entry.name, entry.index, entry.description, entry.unit);
     }
+    next_index_ = next_index;
     return *this;
   }
 
-  UInt MetaInfoRegistry::registerName(const String& name, const String& description, const String& unit)
+  void MetaInfoRegistry::insert_(const String& name, UInt index, const String& description, const String& unit)
   {
-    UInt rv;
-#pragma omp critical (MetaInfoRegistry)
+    entries_.emplace_back(new Entry{name, index, std::hash<std::string>()(name), description, unit});
+    const Entry* entry = entries_.back().get();
+    ++size_;
+
+    // name table: keep the load factor below 1/2, grow by republishing a larger copy
+    const Table* names = name_table_.load(std::memory_order_relaxed);
+    if (2 * size_ > names->capacity)
     {
-      MapString2IndexType::iterator it = name_to_index_.find(name);
-      if (it == name_to_index_.end())
+      Table* grown = new Table(2 * names->capacity);
+      tables_.emplace_back(grown);
+      for (const auto& e : entries_)
       {
-        name_to_index_[name] = next_index_;
-        index_to_name_[next_index_] = name;
-        index_to_description_[next_index_] = description;
-        index_to_unit_[next_index_] = unit;
-        rv = next_index_++;
+        Size pos = e->hash & (grown->capacity - 1);
+        while (grown->slots[pos].load(std::memory_order_relaxed) != nullptr)
+        {
+          pos = (pos + 1) & (grown->capacity - 1);
+        }
+        grown->slots[pos].store(e.get(), std::memory_order_relaxed);
       }
-      else
+      name_table_.store(grown, std::memory_order_release);
+    }
+    else
+    {
+      Size pos = entry->hash & (names->capacity - 1);
+      while (names->slots[pos].load(std::memory_order_relaxed) != nullptr)
       {
-        rv = it->second;
+        pos = (pos + 1) & (names->capacity - 1);
       }
+      names->slots[pos].store(entry, std::memory_order_release);
     }
-    return rv;
-  }
 
-  void MetaInfoRegistry::setDescription(UInt index, const String& description)
-  {
-    MapIndex2StringType::iterator pos;
-#pragma omp critical (MetaInfoRegistry)
+    // index table: direct addressing
+    const Table* indices = index_table_.load(std::memory_order_relaxed);
+    if (index >= indices->capacity)
     {
-      pos = index_to_description_.find(index);
-      if (pos != index_to_description_.end())
-      {
-        pos->second = description;
-      }
-      else
+      Size capacity = indices->capacity;
+      while (index >= capacity) capacity *= 2;
+      Table* grown = new Table(capacity);
+      tables_.emplace_back(grown);
+      for (Size i = 0; i < indices->capacity; ++i)
       {
-        throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unregistered index!", String(index));
+        grown->slots[i].store(indices->slots[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
       }
+      grown->slots[index].store(entry, std::memory_order_relaxed);
+      index_table_.store(grown, std::memory_order_release);
+    }
+    else
+    {
+      indices->slots[index].store(entry, std::memory_order_release);
     }
   }
 
-  void MetaInfoRegistry::setDescription(const String& name, const String& description)
+  const MetaInfoRegistry::Entry* MetaInfoRegistry::findName_(const String& name) const
   {
-    MapString2IndexType::iterator pos;
-#pragma omp critical (MetaInfoRegistry)
+    const Table* names = name_table_.load(std::memory_order_acquire);
+    const Size hash = std::hash<std::string>()(name);
+    Size pos = hash & (names->capacity - 1);
+    // the table is never full, so there is always an empty slot which ends the probing
+    for (const Entry* entry = names->slots[pos].load(std::memory_order_acquire); entry != nullptr;
+         entry = names->slots[pos].load(std::memory_order_acquire))
     {
-      pos = name_to_index_.find(name);
-      if (pos != name_to_index_.end())
-      {
-        index_to_description_[pos->second] = description;
-      }
-      else
-      {
-        throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unregistered name!", name);
-      }
+      if (entry->hash == hash && entry->name == name) return entry;
+      pos = (pos + 1) & (names->capacity - 1);
     }
+    return nullptr;
   }
 
-  void MetaInfoRegistry::setUnit(UInt index, const String& unit)
+  const MetaInfoRegistry::Entry* MetaInfoRegistry::findIndex_(UInt index) const
+  {
+    const Table* indices = index_table_.load(std::memory_order_acquire);
+    if (index >= indices->capacity) return nullptr;
+    return indices->slots[index].load(std::memory_order_acquire);
+  }
+
+  const MetaInfoRegistry::Entry& MetaInfoRegistry::getEntry_(UInt index) const
   {
-    MapIndex2StringType::iterator pos;
-#pragma omp critical (MetaInfoRegistry)
+    const Entry* entry = findIndex_(index);
+    if (entry == nullptr)
     {
-      pos = index_to_unit_.find(index);
-      if (pos != index_to_unit_.end())
-      {
-        pos->second = unit;
-      }
-      else
-      {
-        throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unregistered index!", String(index));
-      }
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unregistered index!", String(index));
     }
+    return *entry;
   }
 
-  void MetaInfoRegistry::setUnit(const String& name, const String& unit)
+  UInt MetaInfoRegistry::registerName(const String& name, const String& description, const String& unit)
   {
-    MapString2IndexType::iterator pos;
-#pragma omp critical (MetaInfoRegistry)
+    // fast path without locking for names which are already registered
+    const Entry* entry = findName_(name);
+    if (entry != nullptr) return entry->index;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    entry = findName_(name); // another thread might have registered it in the meantime
+    if (entry != nullptr) return entry->index;
+    insert_(name, next_index_, description, unit);
+    return next_index_++;
+  }
+
+  void MetaInfoRegistry::setDescription(UInt index, const String& description)
+  {
+    Entry& entry = const_cast<Entry&>(getEntry_(index));
+    std::lock_guard<std::mutex> lock(mutex_);
+    entry.description = description;
+  }
+
+  void MetaInfoRegistry::setDescription(const String& name, const String& description)
+  {
+    const Entry* entry = findName_(name);
+    if (entry == nullptr)
     {
-      pos = name_to_index_.find(name);
-      if (pos != name_to_index_.end())
-      {
-        index_to_unit_[pos->second] = unit;
-      }
-      else
-      {
-        throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unregistered name!", name);
-      }
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unregistered name!", name);
     }
+    std::lock_guard<std::mutex> lock(mutex_);
+    const_cast<Entry*>(entry)->description = description;
   }
 
-  UInt MetaInfoRegistry::getIndex(const String& name) const
+  void MetaInfoRegistry::setUnit(UInt index, const String& unit)
   {
-    UInt rv = UInt(-1);
-#pragma omp critical (MetaInfoRegistry)
+    Entry& entry = const_cast<Entry&>(getEntry_(index));
+    std::lock_guard<std::mutex> lock(mutex_);
+    entry.unit = unit;
+  }
+
+  void MetaInfoRegistry::setUnit(const String& name, const String& unit)
+  {
+    const Entry* entry = findName_(name);
+    if (entry == nullptr)
     {
-      MapString2IndexType::const_iterator it = name_to_index_.find(name);
-      if (it != name_to_index_.end())
-      {
-        rv = it->second;
-      }
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unregistered name!", name);
     }
-    return rv;
+    std::lock_guard<std::mutex> lock(mutex_);
+    const_cast<Entry*>(entry)->unit = unit;
+  }
+
+  UInt MetaInfoRegistry::getIndex(const String& name) const
+  {
+    const Entry* entry = findName_(name);
+    return entry == nullptr ? UInt(-1) : entry->index;
   }
 
   String MetaInfoRegistry::getDescription(UInt index) const
   {
-    String result;
-#pragma omp critical (MetaInfoRegistry)
-    {
-      MapIndex2StringType::const_iterator it = index_to_description_.find(index);
-      if (it == index_to_description_.end())
-      {
-        throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unregistered index!", String(index));
-      }
-      result = it->second;
-    }
-    return result;
+    const Entry& entry = getEntry_(index);
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entry.description;
   }
 
   String MetaInfoRegistry::getDescription(const String& name) const
   {
-    String rv;
-    UInt index = getIndex(name); // this has to be outside the OpenMP "critical" block!
-    if (index == UInt(-1)) // not found
+    const Entry* entry = findName_(name);
+    if (entry == nullptr)
     {
       throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unregistered Name!", name);
     }
-    else
-    {
-#pragma omp critical (MetaInfoRegistry)
-      {
-        rv = (index_to_description_.find(index))->second;
-      }
-    }
-    return rv;
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entry->description;
   }
 
   String MetaInfoRegistry::getUnit(UInt index) const
   {
-    String result;
-#pragma omp critical (MetaInfoRegistry)
-    {
-      MapIndex2StringType::const_iterator it = index_to_unit_.find(index);
-      if (it == index_to_unit_.end())
-      {
-        throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unregistered index!", String(index));
-      }
-      result = it->second;
-    }
-    return result;
+    const Entry& entry = getEntry_(index);
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entry.unit;
   }
 
   String MetaInfoRegistry::getUnit(const String& name) const
   {
-    String rv;
-    UInt index = getIndex(name); // this has to be outside the OpenMP "critical" block!
-    if (index == UInt(-1)) // not found
+    const Entry* entry = findName_(name);
+    if (entry == nullptr)
     {
       throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unregistered Name!", name);
     }
-    else
-    {
-#pragma omp critical (MetaInfoRegistry)
-      {
-        rv = (index_to_unit_.find(index))->second;
-      }
-    }
-    return rv;
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entry->unit;
   }
 
   String MetaInfoRegistry::getName(UInt index) const
   {
-    String rv;
-#pragma omp critical (MetaInfoRegistry)
-    {
-      MapIndex2StringType::const_iterator it = index_to_name_.find(index);
-      if (it != index_to_name_.end())
-      {
-        rv = it->second;
-      }
-      else
-      {
-        throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unregistered index!", String(index));
-      }
-    }
-    return rv;
+    return getEntry_(index).name;
   }
 
 } //namespace
-
@@ -47,7 +47,7 @@ namespace OpenMS
     MetaInfoInterface(),
     score_(0),
     rank_(0),
-    accession_(""),
+    accession_(),
     sequence_(""),
     coverage_(COVERAGE_UNKNOWN)
   {
@@ -153,8 +153,8 @@ namespace OpenMS
   // sets the accession of the protein
   void ProteinHit::setAccession(const String& accession)
   {
-    accession_ = accession;
-    accession_.trim();
+    String trimmed(accession);
+    accession_ = trimmed.trim();
   }
 
   // sets the coverage (in percent) of the protein hit based upon matched peptides
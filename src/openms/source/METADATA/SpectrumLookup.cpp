@@ -34,6 +34,9 @@
 
 #include <OpenMS/METADATA/SpectrumLookup.h>
 
+#include <cctype>
+#include <cstring>
+
 using namespace std;
 
 namespace OpenMS
@@ -87,7 +90,7 @@ namespace OpenMS
 
   Size SpectrumLookup::findByNativeID(const String& native_id) const
   {
-    map<String, Size>::const_iterator pos = ids_.find(native_id);
+    unordered_map<String, Size>::const_iterator pos = ids_.find(native_id);
     if (pos == ids_.end())
     {
       String element = "spectrum with native ID '" + native_id + "'";
@@ -114,7 +117,7 @@ namespace OpenMS
 
   Size SpectrumLookup::findByScanNumber(Size scan_number) const
   {
-    map<Size, Size>::const_iterator pos = scans_.find(scan_number);
+    unordered_map<Size, Size>::const_iterator pos = scans_.find(scan_number);
     if (pos == scans_.end())
     {
       String element = "spectrum with scan number " + String(scan_number);
@@ -145,8 +148,77 @@ namespace OpenMS
                                        msg);
     }
 
+    // keep the simple versions in sync (unless formats were added directly):
+    bool in_sync = (simple_formats_.size() == reference_formats.size());
     boost::regex re(regexp);
     reference_formats.push_back(re);
+    if (in_sync) simple_formats_.push_back(parseSimpleFormat_(regexp));
+  }
+
+
+  SpectrumLookup::SimpleFormat_ SpectrumLookup::parseSimpleFormat_(const String& regexp)
+  {
+    SimpleFormat_ format;
+    Size group_start = regexp.find("(?<");
+    if (group_start == String::npos) return format;
+    Size group_end = regexp.find('>', group_start);
+    if (group_end == String::npos) return format;
+    String group = regexp.substr(group_start + 3, group_end - group_start - 3);
+    if ((group != "INDEX0") && (group != "INDEX1") && (group != "SCAN") && (group != "ID")) return format;
+
+    String rest = regexp.substr(group_end + 1);
+    if (rest == "\\d+)$") format.anchored = true;
+    else if (rest != "\\d+)") return format;
+
+    // the part before the group may only contain literal characters:
+    String literal;
+    for (Size i = 0; i < group_start; ++i)
+    {
+      char c = regexp[i];
+      if (c == '\\')
+      {
+        if (++i == group_start) return format;
+        c = regexp[i];
+        if (!strchr(".-_=:/ #", c)) return format; // escaped character class etc.
+      }
+      else if (!isalnum((unsigned char)c) && !strchr("-_=:/ #,;@", c))
+      {
+        return format;
+      }
+      literal += c;
+    }
+    format.literal = literal;
+    format.group = group;
+    format.valid = true;
+    return format;
+  }
+
+
+  int SpectrumLookup::matchSimpleFormat_(const SimpleFormat_& format, const String& input, bool last_match, String& value)
+  {
+    // "$" also matches before line breaks - leave such input to the regular expression
+    if (format.anchored && (input.find_first_of("\n\r\f\v") != String::npos)) return -1;
+    bool found = false;
+    Size pos = 0;
+    while (pos <= input.size())
+    {
+      Size start = input.find(format.literal, pos);
+      if (start == String::npos) break;
+      Size number_start = start + format.literal.size(), number_end = number_start;
+      while ((number_end < input.size()) && isdigit((unsigned char)input[number_end])) ++number_end;
+      if ((number_end > number_start) && (!format.anchored || (number_end == input.size())))
+      {
+        value = input.substr(number_start, number_end - number_start);
+        found = true;
+        if (!last_match) break;
+        pos = number_end; // matches don't overlap
+      }
+      else
+      {
+        pos = start + 1;
+      }
+    }
+    return found ? 1 : 0;
   }
 
 
@@ -206,16 +278,32 @@ namespace OpenMS
   }
 
 
+  Size SpectrumLookup::findByGroupValue_(const String& group, const String& value) const
+  {
+    if (group == "INDEX0") return findByIndex(value.toInt(), false);
+    if (group == "INDEX1") return findByIndex(value.toInt(), true);
+    if (group == "SCAN") return findByScanNumber(value.toInt());
+    return findByNativeID(value);
+  }
+
+
   Size SpectrumLookup::findByReference(const String& spectrum_ref) const
   {
-    for (vector<boost::regex>::const_iterator it = reference_formats.begin();
-         it != reference_formats.end(); ++it)
+    bool use_simple = (simple_formats_.size() == reference_formats.size());
+    for (Size i = 0; i < reference_formats.size(); ++i)
     {
+      if (use_simple && simple_formats_[i].valid)
+      {
+        String value;
+        int simple_match = matchSimpleFormat_(simple_formats_[i], spectrum_ref, false, value);
+        if (simple_match == 1) return findByGroupValue_(simple_formats_[i].group, value);
+        if (simple_match == 0) continue;
+      }
       boost::smatch match;
-      bool found = boost::regex_search(spectrum_ref, match, *it);
+      bool found = boost::regex_search(spectrum_ref, match, reference_formats[i]);
       if (found)
       {
-        return findByRegExpMatch_(spectrum_ref, it->str(), match);
+        return findByRegExpMatch_(spectrum_ref, reference_formats[i].str(), match);
       }
     }
     String msg = "Spectrum reference doesn't match any known format";
@@ -348,6 +436,25 @@ namespace OpenMS
     return -1;
   } 
 
+  Int SpectrumLookup::extractScanNumber_(const String& native_id) const
+  {
+    String value;
+    int simple_match = simple_scan_format_.valid ? matchSimpleFormat_(simple_scan_format_, native_id, true, value) : -1;
+    if (simple_match == -1) return extractScanNumber(native_id, scan_regexp_, true);
+    if (simple_match == 1)
+    {
+      try
+      {
+        return value.toInt();
+      }
+      catch (Exception::ConversionError&)
+      {
+      }
+    }
+    return -1;
+  }
+
+
   void SpectrumLookup::addEntry_(Size index, double rt, Int scan_number,
                                  const String& native_id)
   {
@@ -368,6 +475,7 @@ namespace OpenMS
                                          OPENMS_PRETTY_FUNCTION, msg);
       }
       scan_regexp_.assign(scan_regexp);
+      simple_scan_format_ = parseSimpleFormat_(scan_regexp);
     }
   }
 
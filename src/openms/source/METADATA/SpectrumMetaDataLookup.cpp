@@ -91,9 +91,36 @@ namespace OpenMS
                                                    SpectrumMetaData& meta,
                                                    MetaDataFlags flags) const
   {
+    bool use_simple = (simple_formats_.size() == reference_formats.size());
     for (std::vector<boost::regex>::const_iterator it = 
            reference_formats.begin(); it != reference_formats.end(); ++it)
     {
+      const SimpleFormat_* simple = use_simple ? &simple_formats_[it - reference_formats.begin()] : nullptr;
+      if (simple && simple->valid)
+      {
+        String value;
+        int simple_match = matchSimpleFormat_(*simple, spectrum_ref, false, value);
+        if (simple_match == 0) continue;
+        if (simple_match == 1)
+        {
+          if (((flags & MDF_SCANNUMBER) == MDF_SCANNUMBER) && (simple->group == "SCAN"))
+          {
+            meta.scan_number = value.toInt();
+            flags &= ~MDF_SCANNUMBER; // unset flag
+          }
+          if (((flags & MDF_NATIVEID) == MDF_NATIVEID) && (simple->group == "ID"))
+          {
+            meta.native_id = value;
+            flags &= ~MDF_NATIVEID; // unset flag
+          }
+          if (flags) // not all requested values have been found -> look them up
+          {
+            Size index = findByGroupValue_(simple->group, value);
+            meta = metadata_[index];
+          }
+          return; // use the first reference format that matches
+        }
+      }
       boost::smatch match;
       bool found = boost::regex_search(spectrum_ref, match, *it);
       if (found)
@@ -36,11 +36,40 @@
 
 #include <OpenMS/CONCEPT/Helpers.h>
 #include <boost/iterator/indirect_iterator.hpp> // for equality
+#include <boost/make_shared.hpp>
 
 using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// default constructed settings shared by all new spectra (never modified, since always shared)
+    template <typename T>
+    const boost::shared_ptr<T>& defaultInstance()
+    {
+      static const boost::shared_ptr<T> instance = boost::make_shared<T>();
+      return instance;
+    }
+
+    /// make sure @p ptr is not shared with another spectrum before it is modified
+    template <typename T>
+    T& detach(boost::shared_ptr<T>& ptr)
+    {
+      if (ptr.use_count() > 1)
+      {
+        ptr = boost::make_shared<T>(*ptr);
+      }
+      return *ptr;
+    }
+
+    /// compare shared settings (identical if the same object is shared)
+    template <typename T>
+    bool equalShared(const boost::shared_ptr<T>& lhs, const boost::shared_ptr<T>& rhs)
+    {
+      return lhs == rhs || *lhs == *rhs;
+    }
+  }
 
   const std::string SpectrumSettings::NamesOfSpectrumType[] = {"Unknown", "Centroid", "Profile"};
 
@@ -49,9 +78,9 @@ namespace OpenMS
     type_(UNKNOWN),
     native_id_(),
     comment_(),
-    instrument_settings_(),
-    source_file_(),
-    acquisition_info_(),
+    instrument_settings_(defaultInstance<InstrumentSettings>()),
+    source_file_(defaultInstance<SourceFile>()),
+    acquisition_info_(defaultInstance<AcquisitionInfo>()),
     precursors_(),
     products_(),
     identification_(),
@@ -59,6 +88,40 @@ namespace OpenMS
   {
   }
 
+  SpectrumSettings::SpectrumSettings(SpectrumSettings&& rhs) noexcept :
+    MetaInfoInterface(std::move(rhs)),
+    type_(rhs.type_),
+    native_id_(std::move(rhs.native_id_)),
+    comment_(std::move(rhs.comment_)),
+    instrument_settings_(rhs.instrument_settings_),
+    source_file_(rhs.source_file_),
+    acquisition_info_(rhs.acquisition_info_),
+    precursors_(std::move(rhs.precursors_)),
+    products_(std::move(rhs.products_)),
+    identification_(std::move(rhs.identification_)),
+    data_processing_(std::move(rhs.data_processing_))
+  {
+  }
+
+  SpectrumSettings& SpectrumSettings::operator=(SpectrumSettings&& rhs) & noexcept
+  {
+    if (&rhs == this) return *this;
+
+    MetaInfoInterface::operator=(std::move(rhs));
+    type_ = rhs.type_;
+    native_id_ = std::move(rhs.native_id_);
+    comment_ = std::move(rhs.comment_);
+    // copy the (cheap) pointers, so rhs stays usable
+    instrument_settings_ = rhs.instrument_settings_;
+    source_file_ = rhs.source_file_;
+    acquisition_info_ = rhs.acquisition_info_;
+    precursors_ = std::move(rhs.precursors_);
+    products_ = std::move(rhs.products_);
+    identification_ = std::move(rhs.identification_);
+    data_processing_ = std::move(rhs.data_processing_);
+    return *this;
+  }
+
   SpectrumSettings::~SpectrumSettings()
   {
   }
@@ -69,9 +132,9 @@ namespace OpenMS
            type_ == rhs.type_ &&
            native_id_ == rhs.native_id_ &&
            comment_ == rhs.comment_ &&
-           instrument_settings_ == rhs.instrument_settings_ &&
-           acquisition_info_ == rhs.acquisition_info_ &&
-           source_file_ == rhs.source_file_ &&
+           equalShared(instrument_settings_, rhs.instrument_settings_) &&
+           equalShared(acquisition_info_, rhs.acquisition_info_) &&
+           equalShared(source_file_, rhs.source_file_) &&
            precursors_ == rhs.precursors_ &&
            products_ == rhs.products_ &&
            identification_ == rhs.identification_ &&
@@ -131,47 +194,47 @@ namespace OpenMS
 
   const InstrumentSettings & SpectrumSettings::getInstrumentSettings() const
   {
-    return instrument_settings_;
+    return *instrument_settings_;
   }
 
   InstrumentSettings & SpectrumSettings::getInstrumentSettings()
   {
-    return instrument_settings_;
+    return detach(instrument_settings_);
   }
 
   void SpectrumSettings::setInstrumentSettings(const InstrumentSettings & instrument_settings)
   {
-    instrument_settings_ = instrument_settings;
+    instrument_settings_ = boost::make_shared<InstrumentSettings>(instrument_settings);
   }
 
   const AcquisitionInfo & SpectrumSettings::getAcquisitionInfo() const
   {
-    return acquisition_info_;
+    return *acquisition_info_;
   }
 
   AcquisitionInfo & SpectrumSettings::getAcquisitionInfo()
   {
-    return acquisition_info_;
+    return detach(acquisition_info_);
   }
 
   void SpectrumSettings::setAcquisitionInfo(const AcquisitionInfo & acquisition_info)
   {
-    acquisition_info_ = acquisition_info;
+    acquisition_info_ = boost::make_shared<AcquisitionInfo>(acquisition_info);
   }
 
   const SourceFile & SpectrumSettings::getSourceFile() const
   {
-    return source_file_;
+    return *source_file_;
   }
 
   SourceFile & SpectrumSettings::getSourceFile()
   {
-    return source_file_;
+    return detach(source_file_);
   }
 
   void SpectrumSettings::setSourceFile(const SourceFile & source_file)
   {
-    source_file_ = source_file;
+    source_file_ = boost::make_shared<SourceFile>(source_file);
   }
 
   const vector<Precursor> & SpectrumSettings::getPrecursors() const
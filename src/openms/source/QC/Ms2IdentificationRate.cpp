@@ -69,6 +69,27 @@ namespace OpenMS
       throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "No MS2 spectra found");
     }
 
+    compute_(feature_map, ms2_level_counter, force_fdr);
+  }
+
+  void Ms2IdentificationRate::compute(const FeatureMap& feature_map, const QCBase::SpectraSummary& summary, bool force_fdr)
+  {
+    if (summary.empty())
+    {
+      throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "MSExperiment is empty");
+    }
+
+    UInt64 ms2_level_counter = summary.getNrSpectra(2);
+    if (ms2_level_counter == 0)
+    {
+      throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "No MS2 spectra found");
+    }
+
+    compute_(feature_map, ms2_level_counter, force_fdr);
+  }
+
+  void Ms2IdentificationRate::compute_(const FeatureMap& feature_map, UInt64 ms2_level_counter, bool force_fdr)
+  {
     //counts peptideIdentifications
     UInt64 peptide_identification_counter{};
 
@@ -33,10 +33,13 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/QC/QCBase.h>
+#include <OpenMS/FILTERING/TRANSFORMERS/LinearResamplerAlign.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/KERNEL/ConsensusMap.h>
 
+#include <algorithm>
+
 namespace OpenMS
 {
   const std::string QCBase::names_of_requires[] = {"fail", "raw.mzML", "postFDR.featureXML", "preFDR.featureXML", "contaminants.fasta", "trafoAlign.trafoXML"};
@@ -80,6 +83,93 @@ namespace OpenMS
     return nativeid_to_index_.size();
   }
 
+  QCBase::SpectraSummary::SpectraSummary(const MSExperiment& exp)
+  {
+    calculate(exp);
+  }
+
+  void QCBase::SpectraSummary::calculate(const MSExperiment& exp)
+  {
+    entries_.assign(exp.size(), Entry());
+#pragma omp parallel for schedule(dynamic, 100)
+    for (SignedSize i = 0; i < (SignedSize)exp.size(); ++i)
+    {
+      entries_[i] = summarize_(exp[i]);
+    }
+  }
+
+  void QCBase::SpectraSummary::addSpectrum(const MSSpectrum& spec)
+  {
+    entries_.push_back(summarize_(spec));
+  }
+
+  QCBase::SpectraSummary::Entry QCBase::SpectraSummary::summarize_(const MSSpectrum& spec)
+  {
+    // TIC and base peak in one pass over the peaks
+    Entry e;
+    e.rt = spec.getRT();
+    e.ms_level = spec.getMSLevel();
+    MSSpectrum::PeakType::IntensityType tic{0}, bpi{0};
+    for (const auto& p : spec)
+    {
+      tic += p.getIntensity();
+      bpi = std::max(bpi, p.getIntensity());
+    }
+    e.tic = tic;
+    e.base_peak_intensity = bpi;
+    return e;
+  }
+
+  const std::vector<QCBase::SpectraSummary::Entry>& QCBase::SpectraSummary::getEntries() const
+  {
+    return entries_;
+  }
+
+  Size QCBase::SpectraSummary::getNrSpectra(UInt ms_level) const
+  {
+    return std::count_if(entries_.begin(), entries_.end(), [ms_level](const Entry& e) { return e.ms_level == ms_level; });
+  }
+
+  MSChromatogram QCBase::SpectraSummary::getTIC(float rt_bin_size) const
+  {
+    // same as MSExperiment::getTIC(), but without touching any peaks
+    MSChromatogram tic;
+    for (const Entry& e : entries_)
+    {
+      if (e.ms_level == 1)
+      {
+        ChromatogramPeak peak;
+        peak.setRT(e.rt);
+        peak.setIntensity(e.tic);
+        tic.push_back(peak);
+      }
+    }
+    if (rt_bin_size > 0)
+    {
+      LinearResamplerAlign lra;
+      Param param = lra.getParameters();
+      param.setValue("spacing", rt_bin_size);
+      lra.setParameters(param);
+      lra.raster(tic);
+    }
+    return tic;
+  }
+
+  void QCBase::SpectraSummary::clear()
+  {
+    entries_.clear();
+  }
+
+  bool QCBase::SpectraSummary::empty() const
+  {
+    return entries_.empty();
+  }
+
+  Size QCBase::SpectraSummary::size() const
+  {
+    return entries_.size();
+  }
+
   // function tests if a metric has the required input files
   // gives a warning with the name of the metric that can not be performed
   bool QCBase::isRunnable(const Status& s) const
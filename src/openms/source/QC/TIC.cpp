@@ -36,6 +36,7 @@
 #include <OpenMS/QC/TIC.h>
 #include <OpenMS/FILTERING/TRANSFORMERS/LinearResamplerAlign.h>
 #include <OpenMS/FORMAT/MzTab.h>
+#include <OpenMS/KERNEL/MSChromatogram.h>
 
 using namespace std;
 
@@ -51,6 +52,11 @@ namespace OpenMS
     results_.push_back(exp.getTIC(bin_size));
   }
 
+  void TIC::compute(const QCBase::SpectraSummary& summary, float bin_size)
+  {
+    results_.push_back(summary.getTIC(bin_size));
+  }
+
   /// Returns the name of the metric
   const String& TIC::getName() const
   {
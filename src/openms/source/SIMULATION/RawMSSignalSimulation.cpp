@@ -44,10 +44,6 @@
 #include <boost/random/normal_distribution.hpp>
 #include <boost/math/distributions.hpp>
 
-#ifdef _OPENMP
-#include <omp.h>
-
-#endif
 
 
 
@@ -386,111 +382,38 @@ namespace OpenMS
     }
     else // LC/MS
     {
-      std::vector<SimTypes::MSSimExperiment*> experiments; // pointer to experiment(s)
-      experiments.push_back(&experiment); // the master thread gets the original (just a reference, no copying here)
-
-      std::vector<SimTypes::MSSimExperiment*> experiments_ct; // pointer to experiment(s)
-      experiments_ct.push_back(&experiment_ct); // the master thread gets the original (just a reference, no copying here)
-
-
-#ifdef _OPENMP
-      // prepare random numbers for the different threads
-      // each possible thread gets his own set of random
-      // numbers
-      Size thread_count = omp_get_max_threads();
-
-      threaded_random_numbers_.resize(thread_count);
-      threaded_random_numbers_index_.resize(thread_count);
-      experiments.reserve(thread_count); // !reserve!
-      experiments_ct.reserve(thread_count); // !reserve!
-      std::vector<SimTypes::MSSimExperiment> experiments_tmp(thread_count - 1); // holds MSExperiments for slave threads
-      std::vector<SimTypes::MSSimExperiment> experiments_ct_tmp(thread_count - 1); // holds MSExperiments (centroided) for slave threads
-
-      for (Size i = 0; i < thread_count; ++i)
+      // Each feature gets its own random stream (seeded in feature order) and is sampled into its own buffer, which is
+      // added to the experiment in feature order. Thus, the result does not depend on the number of threads.
+      // Features are processed in blocks to limit the memory used by the buffers.
+      const std::vector<UInt64> seeds = drawSeeds_(features.size());
+      const Size block_size = 1000;
+      const Size compress_size_intermediate = 20000; // compress map every X features, (10.000 feature are ~ 2 GB at 0.002 sampling rate)
+      Size compress_count = 0;
+      std::vector<FeatureSignal_> signals;
+      for (Size block_start = 0; block_start < features.size(); block_start += block_size)
       {
-        threaded_random_numbers_[i].resize(THREADED_RANDOM_NUMBER_POOL_SIZE_);
-        threaded_random_numbers_index_[i] = THREADED_RANDOM_NUMBER_POOL_SIZE_;
-      }
+        const Size block_end = std::min(block_start + block_size, features.size());
+        signals.assign(block_end - block_start, FeatureSignal_());
 
-      if (thread_count > 1)
-      {
-        // prepare a temporary experiment to store the results
-        SimTypes::MSSimExperiment e_tmp = experiment;
-        SimTypes::MSSimExperiment e_ct_tmp = experiment_ct;
-        // remove actual data
-        for (Size i = 0; i < e_tmp.size(); ++i)
-        {
-          e_tmp[i].clear(false);
-          e_ct_tmp[i].clear(false);
-        }
-        // each slave thread gets a copy
-        for (Size i = 1; i < thread_count; ++i)
+#pragma omp parallel for schedule(dynamic)
+        for (SignedSize f = (SignedSize)block_start; f < (SignedSize)block_end; ++f)
         {
-          experiments_tmp[i - 1] = e_tmp;
-          experiments_ct_tmp[i - 1] = e_ct_tmp;
-          // assign it to the list of experiments (this is no real copy, but a reference!)
-          experiments.push_back(&(experiments_tmp[i - 1]));
-          experiments_ct.push_back(&(experiments_ct_tmp[i - 1]));
+          boost::random::mt19937_64 rng(seeds[f]);
+          add2DSignal_(features[f], experiment, signals[f - block_start], rng);
         }
-      }
-#else
-      Size thread_count = 1;
-#endif
-
-      Size compress_size_intermediate = 20000 / thread_count; // compress map every X features, (10.000 feature are ~ 2 GB at 0.002 sampling rate)
-      Size compress_count = 0; // feature count (for each thread)
 
-#ifdef _OPENMP
-#pragma omp parallel for firstprivate(compress_count)
-#endif
-      for (SignedSize f = 0; f < (SignedSize)features.size(); ++f)
-      {
-#ifdef _OPENMP // update experiment index if necessary
-        const int current_thread = omp_get_thread_num();
-#else
-        const int current_thread(0);
-#endif
-        add2DSignal_(features[f], *(experiments[current_thread]), *(experiments_ct[current_thread]));
-
-        // progresslogger, only master thread sets progress (no barrier here)
-#ifdef _OPENMP
-#pragma omp atomic
-#endif
-        ++progress;
-        if (current_thread == 0)
-        {
-          this->setProgress(progress);
-        }
+        addSignals_(signals, experiment, experiment_ct);
+        progress += signals.size();
+        this->setProgress(progress);
 
         // intermediate compress to avoid memory problems
-        ++compress_count;
-        if (compress_count > compress_size_intermediate)
+        compress_count += signals.size();
+        if (compress_count >= compress_size_intermediate)
         {
           compress_count = 0;
-          compressSignals_(*(experiments[current_thread]));
-        }
-      } // ! raw signal sim
-
-#ifdef _OPENMP // merge back other experiments
-      for (Size i = 1; i < experiments.size(); ++i)
-      {
-        // copy peak data from temporal experiment
-        for (Size scan = 0; scan < experiment.size(); ++scan)
-        {
-          if ((*experiments[i])[scan].empty())
-            continue; // we do not care if the spectrum wasn't touched at all
-          // append all points from temp to org
-          experiment[scan].insert(experiment[scan].end(), (*experiments[i])[scan].begin(), (*experiments[i])[scan].end());
-          // delete from child experiment to save memory (otherwise the merge would double it!)
-          (*experiments[i])[scan].clear(false);
-
-          // peak GT ( small, so no need to compress)
-          experiment_ct[scan].insert(experiment_ct[scan].end(), (*experiments_ct[i])[scan].begin(), (*experiments_ct[i])[scan].end());
-
+          compressSignals_(experiment);
         }
       }
-#endif
-
     } // ! 1D or 2D
 
     this->endProgress();
@@ -537,7 +460,7 @@ namespace OpenMS
 
   void RawMSSignalSimulation::add1DSignal_(Feature& active_feature, SimTypes::MSSimExperiment& experiment, SimTypes::MSSimExperiment& experiment_ct)
   {
-    SimTypes::SimIntensityType scale = getFeatureScaledIntensity_(active_feature.getIntensity(), 100.0);
+    SimTypes::SimIntensityType scale = getFeatureScaledIntensity_(active_feature.getIntensity(), 100.0, rnd_gen_->getTechnicalRng());
 
     SimTypes::SimChargeType q = active_feature.getCharge();
     EmpiricalFormula ef = active_feature.getPeptideIdentifications()[0].getHits()[0].getSequence().getFormula();
@@ -573,9 +496,9 @@ namespace OpenMS
     samplePeptideModel1D_(isomodel, mz_start, mz_end, experiment, experiment_ct, active_feature);
   }
 
-  void RawMSSignalSimulation::add2DSignal_(Feature& active_feature, SimTypes::MSSimExperiment& experiment, SimTypes::MSSimExperiment& experiment_ct)
+  void RawMSSignalSimulation::add2DSignal_(Feature& active_feature, const SimTypes::MSSimExperiment& experiment, FeatureSignal_& signal, boost::random::mt19937_64& rng)
   {
-    SimTypes::SimIntensityType scale = getFeatureScaledIntensity_(active_feature.getIntensity(), 1.0);
+    SimTypes::SimIntensityType scale = getFeatureScaledIntensity_(active_feature.getIntensity(), 1.0, rng);
 
     SimTypes::SimChargeType q = active_feature.getCharge();
     EmpiricalFormula ef;
@@ -638,7 +561,33 @@ namespace OpenMS
 
     // add peptide to GLOBAL MS map
     // add CH and new intensity to feature
-    samplePeptideModel2D_(pm, mz_start, mz_end, rt_start, rt_end, experiment, experiment_ct, active_feature);
+    samplePeptideModel2D_(pm, mz_start, mz_end, rt_start, rt_end, experiment, signal, active_feature, rng);
+  }
+
+  void RawMSSignalSimulation::addSignals_(const std::vector<FeatureSignal_>& signals, SimTypes::MSSimExperiment& experiment, SimTypes::MSSimExperiment& experiment_ct)
+  {
+    // scans are independent; within a scan, signals are appended in the order given
+#pragma omp parallel for schedule(dynamic, 10)
+    for (SignedSize scan = 0; scan < (SignedSize)experiment.size(); ++scan)
+    {
+      for (const FeatureSignal_& signal : signals)
+      {
+        if (Size(scan) < signal.first_scan || Size(scan) >= signal.first_scan + signal.raw.size()) continue;
+        const Size i = scan - signal.first_scan;
+        experiment[scan].insert(experiment[scan].end(), signal.raw[i].begin(), signal.raw[i].end());
+        experiment_ct[scan].insert(experiment_ct[scan].end(), signal.centroided[i].begin(), signal.centroided[i].end());
+      }
+    }
+  }
+
+  std::vector<UInt64> RawMSSignalSimulation::drawSeeds_(const Size count)
+  {
+    std::vector<UInt64> seeds(count);
+    for (UInt64& seed : seeds)
+    {
+      seed = rnd_gen_->getTechnicalRng()();
+    }
+    return seeds;
   }
 
   void RawMSSignalSimulation::samplePeptideModel1D_(const IsotopeModel& pm,
@@ -692,20 +641,24 @@ namespace OpenMS
                                                     const SimTypes::SimCoordinateType mz_end,
                                                     SimTypes::SimCoordinateType rt_start,
                                                     SimTypes::SimCoordinateType rt_end,
-                                                    SimTypes::MSSimExperiment& experiment,
-                                                    SimTypes::MSSimExperiment& experiment_ct,
-                                                    Feature& active_feature)
+                                                    const SimTypes::MSSimExperiment& experiment,
+                                                    FeatureSignal_& signal,
+                                                    Feature& active_feature,
+                                                    boost::random::mt19937_64& rng)
   {
     if (rt_start <= 0)
       rt_start = 0;
 
-    SimTypes::MSSimExperiment::iterator exp_start = experiment.RTBegin(rt_start);
-    SimTypes::MSSimExperiment::iterator exp_ct_start = experiment_ct.RTBegin(rt_start);
+    SimTypes::MSSimExperiment::ConstIterator exp_start = experiment.RTBegin(rt_start);
 
     if (exp_start == experiment.end())
     {
       throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 0);
     }
+    signal.first_scan = exp_start - experiment.begin();
+    signal.raw.clear();
+    signal.centroided.clear();
+    boost::normal_distribution<double> ndist(mz_error_mean_, mz_error_stddev_);
 
     SimTypes::SimIntensityType intensity_sum(0.0);
 
@@ -722,11 +675,12 @@ namespace OpenMS
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Sample the model ...
     SimTypes::SimCoordinateType rt(0);
-    SimTypes::MSSimExperiment::iterator exp_iter = exp_start;
-    SimTypes::MSSimExperiment::iterator exp_ct_iter = exp_ct_start;
-    for (; rt < rt_end && exp_iter != experiment.end(); ++exp_iter, ++exp_ct_iter)
+    SimTypes::MSSimExperiment::ConstIterator exp_iter = exp_start;
+    for (; rt < rt_end && exp_iter != experiment.end(); ++exp_iter)
     {
       rt = exp_iter->getRT();
+      signal.raw.emplace_back();
+      signal.centroided.emplace_back();
       double distortion = double(exp_iter->getMetaValue("distortion"));
       double rt_intensity = ((EGHModel*)pm.getModel(0))->getIntensity(rt);
 
@@ -741,7 +695,7 @@ namespace OpenMS
         if (point.getIntensity() <= 0.0)
           continue;
 
-        exp_ct_iter->push_back(point);
+        signal.centroided.back().push_back(point);
       }
 
       // RAW signal (sample it on the grid)
@@ -758,39 +712,9 @@ namespace OpenMS
         //OPENMS_LOG_ERROR << "Sampling " << rt << " , " << mz << " -> " << point.getIntensity() << std::endl;
 
         // add Gaussian distributed m/z error
-#ifdef _OPENMP
-        int CURRENT_THREAD = omp_get_thread_num();
-        // check if we need to refill the random number pool for this thread
-        if (threaded_random_numbers_index_[CURRENT_THREAD] == THREADED_RANDOM_NUMBER_POOL_SIZE_)
-        {
-          if (mz_error_stddev_ != 0.0)
-          {
-#pragma omp critical(generate_random_number_for_thread)
-            {
-              boost::normal_distribution<double> ndist(mz_error_mean_, mz_error_stddev_);
-              for (Size i = 0; i < THREADED_RANDOM_NUMBER_POOL_SIZE_; ++i)
-              {
-                threaded_random_numbers_[CURRENT_THREAD][i] = ndist(rnd_gen_->getTechnicalRng());
-              }
-            }
-          }
-          else
-          {
-            // we do not need to care about concurrency here
-            fill(threaded_random_numbers_[CURRENT_THREAD].begin(), threaded_random_numbers_[CURRENT_THREAD].end(), mz_error_mean_);
-          }
-          // reset index for this thread to first position
-          threaded_random_numbers_index_[CURRENT_THREAD] = 0;
-        }
-
-        const double mz_err = threaded_random_numbers_[CURRENT_THREAD][threaded_random_numbers_index_[CURRENT_THREAD]++];
-#else
-        // we can use the normal Gaussian ran-gen if we do not use OPENMP
-        boost::normal_distribution<double> ndist(mz_error_mean_, mz_error_stddev_);
-        const double mz_err = ndist(rnd_gen_->getTechnicalRng());
-#endif
+        const double mz_err = (mz_error_stddev_ != 0.0) ? ndist(rng) : mz_error_mean_;
         point.setMZ(std::fabs(point.getMZ() + mz_err));
-        exp_iter->push_back(point);
+        signal.raw.back().push_back(point);
 
         intensity_sum += point.getIntensity();
       }
@@ -977,7 +901,9 @@ namespace OpenMS
       feature.setMetaValue("sum_formula", contaminants_[i].sf.toString()); // formula without adducts or charges
       feature.setCharge(contaminants_[i].q);
       feature.setMetaValue("charge_adducts", "H" + String(contaminants_[i].q)); // adducts separately
-      add2DSignal_(feature, exp, exp_ct);
+      std::vector<FeatureSignal_> signal(1);
+      add2DSignal_(feature, exp, signal[0], rnd_gen_->getTechnicalRng());
+      addSignals_(signal, exp, exp_ct);
       c_map.push_back(feature);
     }
 
@@ -1079,16 +1005,20 @@ namespace OpenMS
       return;
     }
 
-    boost::normal_distribution<SimTypes::SimIntensityType> ndist(white_noise_mean, white_noise_stddev);
-
-    for (SimTypes::MSSimExperiment::iterator spectrum_it = experiment.begin(); spectrum_it != experiment.end(); ++spectrum_it)
+    // one random stream per scan (reproducible independent of the number of threads)
+    const std::vector<UInt64> seeds = drawSeeds_(experiment.size());
+#pragma omp parallel for schedule(dynamic, 10)
+    for (SignedSize scan = 0; scan < (SignedSize)experiment.size(); ++scan)
     {
+      boost::random::mt19937_64 rng(seeds[scan]);
+      boost::normal_distribution<SimTypes::SimIntensityType> ndist(white_noise_mean, white_noise_stddev);
+      SimTypes::MSSimExperiment::iterator spectrum_it = experiment.begin() + scan;
       SimTypes::MSSimExperiment::SpectrumType new_spec = (*spectrum_it);
       new_spec.clear(false);
 
       for (SimTypes::MSSimExperiment::SpectrumType::iterator peak_it = (*spectrum_it).begin(); peak_it != (*spectrum_it).end(); ++peak_it)
       {
-        SimTypes::SimIntensityType intensity = peak_it->getIntensity() + ndist(rnd_gen_->getTechnicalRng());
+        SimTypes::SimIntensityType intensity = peak_it->getIntensity() + ndist(rng);
         if (intensity > 0.0)
         {
           peak_it->setIntensity(intensity);
@@ -1114,9 +1044,14 @@ namespace OpenMS
       return;
     }
 
-    boost::normal_distribution<SimTypes::SimIntensityType> ndist(detector_noise_mean, detector_noise_stddev);
-    for (SimTypes::MSSimExperiment::iterator spectrum_it = experiment.begin(); spectrum_it != experiment.end(); ++spectrum_it)
+    // one random stream per scan (reproducible independent of the number of threads)
+    const std::vector<UInt64> seeds = drawSeeds_(experiment.size());
+#pragma omp parallel for schedule(dynamic, 10)
+    for (SignedSize scan = 0; scan < (SignedSize)experiment.size(); ++scan)
     {
+      boost::random::mt19937_64 rng(seeds[scan]);
+      boost::normal_distribution<SimTypes::SimIntensityType> ndist(detector_noise_mean, detector_noise_stddev);
+      SimTypes::MSSimExperiment::iterator spectrum_it = experiment.begin() + scan;
       SimTypes::MSSimExperiment::SpectrumType new_spec = (*spectrum_it);
       new_spec.clear(false);
 
@@ -1127,7 +1062,7 @@ namespace OpenMS
         // if peak is in grid
         if (peak_it != spectrum_it->end() && *grid_it == peak_it->getMZ())
         {
-          SimTypes::SimIntensityType intensity = peak_it->getIntensity() + ndist(rnd_gen_->getTechnicalRng());
+          SimTypes::SimIntensityType intensity = peak_it->getIntensity() + ndist(rng);
           if (intensity > 0.0)
           {
             peak_it->setIntensity(intensity);
@@ -1137,7 +1072,7 @@ namespace OpenMS
         }
         else // we have no point here, generate one if noise is above 0
         {
-          SimTypes::SimIntensityType intensity = ndist(rnd_gen_->getTechnicalRng());
+          SimTypes::SimIntensityType intensity = ndist(rng);
           if (intensity > 0.0)
           {
             SimTypes::MSSimExperiment::SpectrumType::PeakType noise_peak;
@@ -1203,9 +1138,10 @@ namespace OpenMS
     }
 
     Size point_count_before(0), point_count_after(0);
-    SimTypes::SimPointType p;
-    for (Size i = 0; i < experiment.size(); ++i)
+#pragma omp parallel for schedule(dynamic, 10) reduction(+: point_count_before, point_count_after)
+    for (SignedSize i = 0; i < (SignedSize)experiment.size(); ++i)
     {
+      SimTypes::SimPointType p;
       if (experiment[i].size() <= 1)
         continue;
 
@@ -1288,7 +1224,7 @@ namespace OpenMS
     return;
   }
 
-  SimTypes::SimIntensityType RawMSSignalSimulation::getFeatureScaledIntensity_(const SimTypes::SimIntensityType feature_intensity, const SimTypes::SimIntensityType natural_scaling_factor)
+  SimTypes::SimIntensityType RawMSSignalSimulation::getFeatureScaledIntensity_(const SimTypes::SimIntensityType feature_intensity, const SimTypes::SimIntensityType natural_scaling_factor, boost::random::mt19937_64& rng)
   {
     SimTypes::SimIntensityType intensity = feature_intensity * natural_scaling_factor * intensity_scale_;
 
@@ -1297,7 +1233,7 @@ namespace OpenMS
     // TODO: variables model f??r den intensit??ts-einfluss
     // e.g. sqrt(intensity) || ln(intensity)
     boost::normal_distribution<SimTypes::SimIntensityType> ndist(0, intensity_scale_stddev_ * intensity);
-    intensity += ndist(rnd_gen_->getTechnicalRng());
+    intensity += ndist(rng);
 
     return intensity;
   }
@@ -80,8 +80,22 @@ namespace OpenMS
   }
 
   ExternalProcess::RETURNSTATE ExternalProcess::run(const QString& exe, const QStringList& args, const QString& working_dir, const bool verbose, String& error_msg)
+  {
+    const RETURNSTATE started = start(exe, args, working_dir, verbose, error_msg);
+    if (started != RETURNSTATE::SUCCESS)
+    {
+      return started;
+    }
+    while (isRunning(50)) // wait 50msecs. Small enough to have the GUI repaint when switching windows
+    {
+    }
+    return getResult(verbose, error_msg);
+  }
+
+  ExternalProcess::RETURNSTATE ExternalProcess::start(const QString& exe, const QStringList& args, const QString& working_dir, const bool verbose, String& error_msg)
   {
     error_msg.clear();
+    exe_ = exe;
     if (!working_dir.isEmpty())
     {
       qp_->setWorkingDirectory(working_dir);
@@ -96,30 +110,41 @@ namespace OpenMS
       if (verbose) callbackStdErr_(error_msg + '\n');
       return RETURNSTATE::FAILED_TO_START;
     }
-    while (qp_->state() == QProcess::Running)
+    return RETURNSTATE::SUCCESS;
+  }
+
+  bool ExternalProcess::isRunning(int msecs)
+  {
+    if (qp_->state() != QProcess::Running)
+    {
+      return false;
+    }
+    QCoreApplication::processEvents();
+    if (qp_->waitForReadyRead(msecs))
     {
-      QCoreApplication::processEvents();
-      if (qp_->waitForReadyRead(50)) // wait 50msecs. Small enough to have the GUI repaint when switching windows
-      {
-        processStdOut_();
-        processStdErr_();
-      }
+      processStdOut_();
+      processStdErr_();
     }
+    return qp_->state() == QProcess::Running;
+  }
 
+  ExternalProcess::RETURNSTATE ExternalProcess::getResult(const bool verbose, String& error_msg)
+  {
+    error_msg.clear();
     if (qp_->exitStatus() != QProcess::NormalExit)
     {
-      error_msg = "Process '" + exe + "' crashed hard (segfault-like). Please check the log.";
+      error_msg = "Process '" + exe_ + "' crashed hard (segfault-like). Please check the log.";
       if (verbose) callbackStdErr_(error_msg + '\n');
       return RETURNSTATE::CRASH;
     }
     else if (qp_->exitCode() != 0)
     {
-      error_msg = "Process '" + exe + "' did not finish successfully (exit code: " + qp_->exitCode() + "). Please check the log.";
+      error_msg = "Process '" + exe_ + "' did not finish successfully (exit code: " + qp_->exitCode() + "). Please check the log.";
       if (verbose) callbackStdErr_(error_msg + '\n');
       return RETURNSTATE::NONZERO_EXIT;
     }
-    
-    if (verbose) callbackStdOut_("Executed '" + String(exe) + "' successfully!\n");
+
+    if (verbose) callbackStdOut_("Executed '" + String(exe_) + "' successfully!\n");
     return RETURNSTATE::SUCCESS;
   }
 
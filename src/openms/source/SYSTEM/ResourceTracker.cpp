@@ -0,0 +1,207 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/SYSTEM/ResourceTracker.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/SYSTEM/SysInfo.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+
+namespace OpenMS
+{
+  namespace
+  {
+    void writeJSONString(std::ostream& os, const String& s)
+    {
+      os << '"';
+      for (char c : s)
+      {
+        if (c == '"' || c == '\\') os << '\\';
+        os << c;
+      }
+      os << '"';
+    }
+  }
+
+  ResourceTracker::ResourceTracker() :
+    last_wall_time_(0.0),
+    last_cpu_time_(0.0),
+    peak_memory_kb_(0)
+  {
+  }
+
+  void ResourceTracker::start()
+  {
+    stages_.clear();
+    last_wall_time_ = 0.0;
+    last_cpu_time_ = 0.0;
+    peak_memory_kb_ = 0;
+    watch_.clear();
+    watch_.start();
+  }
+
+  void ResourceTracker::checkpoint(const String& name)
+  {
+    if (!watch_.isRunning()) return;
+
+    Stage stage;
+    stage.name = name;
+    const double wall_time = watch_.getClockTime();
+    const double cpu_time = watch_.getCPUTime();
+    stage.wall_time = wall_time - last_wall_time_;
+    stage.cpu_time = cpu_time - last_cpu_time_;
+    SysInfo::getProcessMemoryConsumption(stage.memory_kb);
+    SysInfo::getProcessPeakMemoryConsumption(stage.peak_memory_kb);
+    stages_.push_back(stage);
+
+    last_wall_time_ = wall_time;
+    last_cpu_time_ = cpu_time;
+  }
+
+  void ResourceTracker::stop()
+  {
+    if (!watch_.isRunning()) return;
+    watch_.stop();
+    SysInfo::getProcessPeakMemoryConsumption(peak_memory_kb_);
+  }
+
+  bool ResourceTracker::isRunning() const
+  {
+    return watch_.isRunning();
+  }
+
+  double ResourceTracker::getWallTime() const
+  {
+    return watch_.getClockTime();
+  }
+
+  double ResourceTracker::getCPUTime() const
+  {
+    return watch_.getCPUTime();
+  }
+
+  double ResourceTracker::getUserTime() const
+  {
+    return watch_.getUserTime();
+  }
+
+  double ResourceTracker::getSystemTime() const
+  {
+    return watch_.getSystemTime();
+  }
+
+  size_t ResourceTracker::getPeakMemory() const
+  {
+    if (!watch_.isRunning()) return peak_memory_kb_;
+    size_t peak(0);
+    SysInfo::getProcessPeakMemoryConsumption(peak);
+    return peak;
+  }
+
+  double ResourceTracker::getThreadUtilization(Size threads) const
+  {
+    const double wall_time = getWallTime();
+    if (wall_time <= 0.0 || threads == 0) return 0.0;
+    return getCPUTime() / (wall_time * threads);
+  }
+
+  const std::vector<ResourceTracker::Stage>& ResourceTracker::getStages() const
+  {
+    return stages_;
+  }
+
+  void ResourceTracker::writeJSON(std::ostream& os, const String& tool, Size threads, Int exit_code) const
+  {
+    const std::streamsize precision = os.precision(6);
+    const std::ios_base::fmtflags flags = os.flags();
+    os << std::fixed;
+
+    os << "{\n  \"tool\": ";
+    writeJSONString(os, tool);
+    os << ",\n  \"exit_code\": " << exit_code
+       << ",\n  \"threads\": " << threads
+       << ",\n  \"wall_time\": " << getWallTime()
+       << ",\n  \"cpu_time\": " << getCPUTime()
+       << ",\n  \"user_time\": " << getUserTime()
+       << ",\n  \"system_time\": " << getSystemTime()
+       << ",\n  \"thread_utilization\": " << getThreadUtilization(threads)
+       << ",\n  \"peak_memory_kb\": " << getPeakMemory()
+       << ",\n  \"time_unit\": \"s\""
+       << ",\n  \"stages\": [";
+    for (Size i = 0; i < stages_.size(); ++i)
+    {
+      const Stage& stage = stages_[i];
+      os << (i ? ",\n" : "\n") << "    {\"name\": ";
+      writeJSONString(os, stage.name);
+      os << ", \"wall_time\": " << stage.wall_time << ", \"cpu_time\": " << stage.cpu_time
+         << ", \"thread_utilization\": " << (stage.wall_time > 0.0 && threads > 0 ? stage.cpu_time / (stage.wall_time * threads) : 0.0)
+         << ", \"memory_kb\": " << stage.memory_kb << ", \"peak_memory_kb\": " << stage.peak_memory_kb << "}";
+    }
+    os << (stages_.empty() ? "]" : "\n  ]") << "\n}\n";
+
+    os.precision(precision);
+    os.flags(flags);
+  }
+
+  void ResourceTracker::storeJSON(const String& filename, const String& tool, Size threads, Int exit_code) const
+  {
+    std::ofstream os(filename.c_str());
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    writeJSON(os, tool, threads, exit_code);
+  }
+
+  size_t ResourceTracker::loadPeakMemory(const String& filename)
+  {
+    std::ifstream is(filename.c_str());
+    std::string line;
+    // the total comes first, before the stages (see writeJSON())
+    const std::string key = "\"peak_memory_kb\": ";
+    while (std::getline(is, line))
+    {
+      const std::string::size_type pos = line.find(key);
+      if (pos != std::string::npos)
+      {
+        return std::strtoull(line.c_str() + pos + key.size(), nullptr, 10);
+      }
+    }
+    return 0;
+  }
+
+} // namespace OpenMS
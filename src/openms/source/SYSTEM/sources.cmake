@@ -10,6 +10,7 @@ JavaInfo.cpp
 NetworkGetRequest.cpp
 PythonInfo.cpp
 RWrapper.cpp
+ResourceTracker.cpp
 StopWatch.cpp
 SysInfo.cpp
 UpdateCheck.cpp
@@ -35,6 +35,7 @@
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/ElutionModelFitter.h>
 
 #include <OpenMS/ANALYSIS/MAPMATCHING/TransformationModelLinear.h>
+#include <OpenMS/CONCEPT/ParallelExecution.h>
 #include <OpenMS/MATH/STATISTICS/StatisticFunctions.h>
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/EGHTraceFitter.h>
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/GaussTraceFitter.h>
@@ -209,25 +210,32 @@ void ElutionModelFitter::fitElutionModels(FeatureMap& features)
   double asym_limit = (asymmetric ?
                        double(param_.getValue("check:asymmetry")) : 0.0);
 
-  TraceFitter* fitter;
-  if (asymmetric)
-  {
-    fitter = new EGHTraceFitter();
-  }
-  else fitter = new GaussTraceFitter();
-  if (weighted)
+  // the fitters keep the state of the current fit, so every thread needs its own:
+  auto create_fitter = [asymmetric, weighted]()
   {
-    Param params = fitter->getDefaults();
-    params.setValue("weighted", "true");
-    fitter->setParameters(params);
-  }
+    unique_ptr<TraceFitter> fitter;
+    if (asymmetric)
+    {
+      fitter.reset(new EGHTraceFitter());
+    }
+    else fitter.reset(new GaussTraceFitter());
+    if (weighted)
+    {
+      Param params = fitter->getDefaults();
+      params.setValue("weighted", "true");
+      fitter->setParameters(params);
+    }
+    return fitter;
+  };
 
   // collect peaks that constitute mass traces:
   OPENMS_LOG_DEBUG << "Fitting elution models to features:" << endl;
-  Size index = 0;
-  for (FeatureMap::Iterator feat_it = features.begin();
-       feat_it != features.end(); ++feat_it, ++index)
+  // the features are fitted independently of each other:
+  ParallelExecution::forEachWithState(0, (SignedSize)features.size(), create_fitter,
+                                      [&](unique_ptr<TraceFitter>& fitter_ptr, SignedSize index)
   {
+    TraceFitter* fitter = fitter_ptr.get();
+    FeatureMap::Iterator feat_it = features.begin() + index;
     // OPENMS_LOG_DEBUG << String(feat_it->getMetaValue("PeptideRef")) << endl;
     double region_start = double(feat_it->getMetaValue("leftWidth"));
     double region_end = double(feat_it->getMetaValue("rightWidth"));
@@ -272,7 +280,7 @@ void ElutionModelFitter::fitElutionModels(FeatureMap& features)
         }
       }
       trace.updateMaximum();
-      if (trace.peaks.empty()) continue;
+      if (trace.peaks.empty()) continue; // next mass trace
       if (each_trace)
       {
         MassTraces temp;
@@ -318,8 +326,7 @@ void ElutionModelFitter::fitElutionModels(FeatureMap& features)
     // fit the model:
     fitAndValidateModel_(fitter, traces, *feat_it, region_start, region_end,
                          asymmetric, area_limit, check_boundaries);
-  }
-  delete fitter;
+  }, ParallelExecution::Schedule::DYNAMIC, 16);
 
   // find outliers in model parameters:
   if (width_limit > 0)
@@ -404,7 +411,7 @@ void ElutionModelFitter::fitElutionModels(FeatureMap& features)
   Size model_successes = 0, model_failures = 0;
 
   for (FeatureMap::Iterator feat_it = features.begin();
-       feat_it != features.end(); ++feat_it, ++index)
+       feat_it != features.end(); ++feat_it)
   {
     feat_it->setMetaValue("raw_intensity", feat_it->getIntensity());
     if (String(feat_it->getMetaValue("model_status"))[0] != '0')
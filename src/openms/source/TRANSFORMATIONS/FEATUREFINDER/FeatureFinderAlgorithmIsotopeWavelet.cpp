@@ -199,11 +199,18 @@ namespace OpenMS
       if (!hr_data_)                   //LowRes data
       {
         iwt->initializeScan((*this->map_)[i]);
-        for (UInt c = 0; c < max_charge_; ++c)
+
+        //the transforms of all charge states are independent of each other, the charge recognition is not
+        std::vector<MSSpectrum> c_transforms(max_charge_, c_ref);
+#pragma omp parallel for schedule(dynamic, 1)
+        for (Int c = 0; c < (Int)max_charge_; ++c)
         {
-          MSSpectrum c_trans(c_ref);
+          iwt->getTransform(c_transforms[c], c_ref, c);
+        }
 
-          iwt->getTransform(c_trans, c_ref, c);
+        for (UInt c = 0; c < max_charge_; ++c)
+        {
+          const MSSpectrum& c_trans(c_transforms[c]);
 
 #ifdef OPENMS_DEBUG_ISOTOPE_WAVELET
           std::stringstream stream;
@@ -231,13 +238,21 @@ namespace OpenMS
       }
       else                   //HighRes data
       {
-        for (UInt c = 0; c < max_charge_; ++c)
+        MSSpectrum* new_spec = createHRData(i);
+        //the part of the scan state used by the transform does not depend on the charge
+        iwt->initializeScan(*new_spec, 0);
+
+        std::vector<MSSpectrum> c_transforms(max_charge_, *new_spec);
+#pragma omp parallel for schedule(dynamic, 1)
+        for (Int c = 0; c < (Int)max_charge_; ++c)
         {
-          MSSpectrum* new_spec = createHRData(i);
-          iwt->initializeScan(*new_spec, c);
-          MSSpectrum c_trans(*new_spec);
+          iwt->getTransformHighRes(c_transforms[c], *new_spec, c);
+        }
 
-          iwt->getTransformHighRes(c_trans, *new_spec, c);
+        for (UInt c = 0; c < max_charge_; ++c)
+        {
+          const MSSpectrum& c_trans(c_transforms[c]);
+          if (c > 0) iwt->initializeScan(*new_spec, c); // charge-specific state for the charge recognition
 
 #ifdef OPENMS_DEBUG_ISOTOPE_WAVELET
           std::stringstream stream;
@@ -261,9 +276,9 @@ namespace OpenMS
           std::cout << "charge recognition O.K. ... "; std::cout.flush();
 #endif
           this->ff_->setProgress(++progress_counter_);
-
-          delete (new_spec); new_spec = nullptr;
         }
+
+        delete (new_spec); new_spec = nullptr;
       }
 
 
@@ -37,6 +37,7 @@
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/EGHTraceFitter.h>
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/GaussTraceFitter.h>
 
+#include <OpenMS/CONCEPT/Profiler.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/FORMAT/FeatureXMLFile.h>
 #include <OpenMS/FORMAT/TextFile.h>
@@ -45,10 +46,13 @@
 #include <OpenMS/CHEMISTRY/Element.h>
 #include <OpenMS/CHEMISTRY/ElementDB.h>
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsotopeDistribution.h>
+#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternCache.h>
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternGenerator.h>
 
 #include <QtCore/QDir>
 
+#include <memory>
+
 #ifdef _OPENMP
 #endif
 
@@ -157,6 +161,7 @@ namespace OpenMS
 
   void FeatureFinderAlgorithmPicked::run()
   {
+    OPENMS_PROFILE_SCOPE("FeatureFinderAlgorithmPicked::run");
     //-------------------------------------------------------------------------
     //General initialization
     //---------------------------------------------------------------------------
@@ -386,8 +391,7 @@ namespace OpenMS
       for (Size index = 0; index < num_isotopes; ++index)
       {
         //if(debug_) log_ << "Calculating iso dist for mass: " << 0.5*mass_window_width_ + index * mass_window_width_ << std::endl;
-        CoarseIsotopePatternGenerator solver(max_isotopes);
-        auto d = solver.estimateFromPeptideWeight(0.5 * mass_window_width_ + index * mass_window_width_);
+        auto d = CoarseIsotopePatternCache::getInstance()->estimateFromPeptideWeight(0.5 * mass_window_width_ + index * mass_window_width_, max_isotopes);
         //trim left and right. And store the number of isotopes on the left, to reconstruct the monoisotopic peak
         Size size_before = d.size();
         d.trimLeft(intensity_percentage_optional_);
@@ -447,7 +451,7 @@ namespace OpenMS
     //Step 3:
     //Charge loop (create seeds and features for each charge separately)
     //-------------------------------------------------------------------------
-    Int plot_nr_global = -1; //counter for the number of plots (debug info)
+    Int plot_nr_global = 0; //counter for the number of plots (debug info)
     Int feature_nr_global = 0; //counter for the number of features (debug info)
     for (SignedSize c = charge_low; c <= charge_high; ++c)
     {
@@ -600,15 +604,30 @@ namespace OpenMS
       // The features are stored in an temporary feature map until it is
       // decided whether they are contained within a seed of higher
       // intensity.
+      //
+      // Seeds are extended independently of each other (in parallel, with a
+      // fitter per seed); the features are then merged in the order of the
+      // seeds, so the result does not depend on the number of threads.
       std::map<Size, std::vector<Size> > seeds_in_features;
       typedef std::map<Size, Feature> FeatureMapType;
       FeatureMapType tmp_feature_map;
       int gl_progress = 0;
       ff_->startProgress(0, seeds.size(), String("Extending seeds for charge ") + String(c));
 
-#pragma omp parallel for
+      // seed indices sorted by m/z (for finding the seeds inside a feature)
+      std::vector<std::pair<double, Size> > seeds_by_mz(seeds.size());
+      for (Size i = 0; i < seeds.size(); ++i)
+      {
+        seeds_by_mz[i] = std::make_pair(map_[seeds[i].spectrum][seeds[i].peak].getMZ(), i);
+      }
+      std::sort(seeds_by_mz.begin(), seeds_by_mz.end());
+
+      // seeds differ a lot in the work needed, so distribute them dynamically
+#pragma omp parallel for schedule(dynamic, 16)
       for (SignedSize i = 0; i < (SignedSize)seeds.size(); ++i)
       {
+        OPENMS_PROFILE_SCOPE("FeatureFinderAlgorithmPicked::extendSeed");
+
         //------------------------------------------------------------------
         //Step 3.3.1:
         //Extend all mass traces
@@ -659,13 +678,8 @@ namespace OpenMS
         //Step 3.3.2:
         //Gauss/EGH fit (first fit to find the feature boundaries)
         //------------------------------------------------------------------
-        Int plot_nr = -1;
-
-
-#pragma omp critical (FeatureFinderAlgorithmPicked_PLOTNR)
-        {
-          plot_nr = ++plot_nr_global;
-        }
+        // (the seed index keeps plot numbers independent of the thread schedule)
+        Int plot_nr = plot_nr_global + (Int)i;
 
         //------------------------------------------------------------------
 
@@ -678,7 +692,7 @@ namespace OpenMS
 
         // choose fitter
         double egh_tau = 0.0;
-        TraceFitter* fitter = chooseTraceFitter_(egh_tau);
+        std::unique_ptr<TraceFitter> fitter(chooseTraceFitter_(egh_tau));
 
         fitter->setParameters(trace_fitter_params);
         fitter->fit(traces);
@@ -707,7 +721,7 @@ namespace OpenMS
         //Crop feature according to RT fit (2.5*sigma) and remove badly fitting traces
         //------------------------------------------------------------------
         MassTraces new_traces;
-        cropFeature_(fitter, traces, new_traces);
+        cropFeature_(fitter.get(), traces, new_traces);
 
         //------------------------------------------------------------------
         //Step 3.3.4:
@@ -719,14 +733,14 @@ namespace OpenMS
         double correlation = 0.0;
         double final_score = 0.0;
 
-        bool feature_ok = checkFeatureQuality_(fitter, new_traces, seed_mz, min_feature_score, error_msg, fit_score, correlation, final_score);
+        bool feature_ok = checkFeatureQuality_(fitter.get(), new_traces, seed_mz, min_feature_score, error_msg, fit_score, correlation, final_score);
 
         {
           //write debug output of feature
           if (debug_)
           {
 #pragma omp critical (FeatureFinderAlgorithmPicked_DEBUG)
-            writeFeatureDebugInfo_(fitter, traces, new_traces, feature_ok, error_msg, final_score, plot_nr, peak);
+            writeFeatureDebugInfo_(fitter.get(), traces, new_traces, feature_ok, error_msg, final_score, plot_nr, peak);
           }
         }
 
@@ -756,10 +770,10 @@ namespace OpenMS
         // Extract some of the model parameters.
         if (egh_tau != 0.0)
         {
-          egh_tau = (static_cast<EGHTraceFitter*>(fitter))->getTau();
+          egh_tau = (static_cast<EGHTraceFitter*>(fitter.get()))->getTau();
           f.setMetaValue("EGH_tau", egh_tau);
-          f.setMetaValue("EGH_height", (static_cast<EGHTraceFitter*>(fitter))->getHeight());
-          f.setMetaValue("EGH_sigma", (static_cast<EGHTraceFitter*>(fitter))->getSigma());
+          f.setMetaValue("EGH_height", (static_cast<EGHTraceFitter*>(fitter.get()))->getHeight());
+          f.setMetaValue("EGH_sigma", (static_cast<EGHTraceFitter*>(fitter.get()))->getSigma());
         }
 
         // Calculate the mass of the feature: maximum, average, monoisotopic
@@ -795,7 +809,7 @@ namespace OpenMS
         f.setIntensity(fitter->getArea() / getIsotopeDistribution_(f.getMZ()).max);
 
         // we do not need the fitter anymore
-        delete fitter;
+        fitter.reset();
 
         //add convex hulls of mass traces
         for (Size j = 0; j < traces.size(); ++j)
@@ -809,36 +823,41 @@ namespace OpenMS
         }
 
         //----------------------------------------------------------------
-        //Remember all seeds that lie inside the convex hull of the new feature
+        //Remember all (less intense) seeds that lie inside the convex hull of the new feature
         DBoundingBox<2> bb = f.getConvexHull().getBoundingBox();
-        for (Size j = i + 1; j < seeds.size(); ++j)
+        std::vector<Size> contained;
+        for (std::vector<std::pair<double, Size> >::const_iterator it = std::lower_bound(seeds_by_mz.begin(), seeds_by_mz.end(), std::make_pair(bb.minY(), Size(0)));
+             it != seeds_by_mz.end() && it->first <= bb.maxY(); ++it)
         {
+          Size j = it->second;
+          if (j <= (Size)i) continue;
           double rt = map_[seeds[j].spectrum].getRT();
-          double mz = map_[seeds[j].spectrum][seeds[j].peak].getMZ();
+          double mz = it->first;
           if (bb.encloses(rt, mz) && f.encloses(rt, mz))
           {
+            contained.push_back(j);
+          }
+        }
+        if (!contained.empty())
+        {
+          std::sort(contained.begin(), contained.end());
 #pragma omp critical (FeatureFinderAlgorithmPicked_SEEDSINFEATURES)
-            {
-              seeds_in_features[i].push_back(j);
-            }
+          {
+            seeds_in_features[i].swap(contained);
           }
         }
       } // end of OPENMP over seeds
+      plot_nr_global += (Int)seeds.size();
 
       // Here we have to evaluate which seeds are already contained in
       // features of seeds with higher intensities. Only if the seed is not
       // used in any feature with higher intensity, we can add it to the
       // features_ list.
-      std::vector<Size> seeds_contained;
+      std::vector<bool> seeds_contained(seeds.size(), false);
       for (auto& f : tmp_feature_map)
       {
         Size seed_nr = f.first;
-        bool is_used = false;
-        for (Size i : seeds_contained)
-        {
-          if (seed_nr == i) { is_used = true; break; }
-        }
-        if (!is_used)
+        if (!seeds_contained[seed_nr])
         {
           ++feature_candidates;
 
@@ -847,10 +866,9 @@ namespace OpenMS
           ++feature_nr_global;
           features_->push_back(f.second);
 
-          std::vector<Size> curr_seed = seeds_in_features[seed_nr];
-          for (Size k : curr_seed)
+          for (Size k : seeds_in_features[seed_nr])
           {
-            seeds_contained.push_back(k);
+            seeds_contained[k] = true;
           }
         }
       }
@@ -1037,9 +1055,13 @@ namespace OpenMS
   /// Writes the abort reason to the log file and counts occurrences for each reason
   void FeatureFinderAlgorithmPicked::abort_(const Seed& seed, const String& reason)
   {
-    if (debug_) log_ << "Abort: " << reason << std::endl;
-    aborts_[reason]++;
-    if (debug_) abort_reasons_[seed] = reason;
+    // called concurrently during seed extension
+#pragma omp critical (FeatureFinderAlgorithmPicked_ABORT)
+    {
+      if (debug_) log_ << "Abort: " << reason << std::endl;
+      aborts_[reason]++;
+      if (debug_) abort_reasons_[seed] = reason;
+    }
   }
 
   double FeatureFinderAlgorithmPicked::intersection_(const Feature& f1, const Feature& f2) const
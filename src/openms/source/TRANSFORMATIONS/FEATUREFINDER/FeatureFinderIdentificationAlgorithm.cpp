@@ -39,6 +39,7 @@
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/TraceFitter.h>
 
 #include <OpenMS/ANALYSIS/OPENSWATH/ChromatogramExtractor.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/DataAccessHelper.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SimpleOpenMSSpectraAccessFactory.h>
 #include <OpenMS/ANALYSIS/SVM/SimpleSVM.h>
 #include <OpenMS/ANALYSIS/MAPMATCHING/MapAlignmentAlgorithmIdentification.h>
@@ -47,6 +48,7 @@
 #include <OpenMS/FORMAT/FeatureXMLFile.h>
 #include <OpenMS/FORMAT/TraMLFile.h>
 #include <OpenMS/CHEMISTRY/ModificationsDB.h>
+#include <OpenMS/CONCEPT/ParallelExecution.h>
 
 #include <vector>
 #include <numeric>
@@ -363,43 +365,81 @@ namespace OpenMS
     // run feature detection
     //-------------------------------------------------------------
     OPENMS_LOG_DEBUG << "Extracting chromatograms..." << endl;
-    for (auto& chunk : chunks)
+    // The assays of a chunk are created serially (they all update 'ref_rt_map'). Then the chromatograms of
+    // the chunks of a wave are extracted and scored in parallel, every thread with its own feature finder and
+    // spectrum access. With fewer chunks than threads, the chunks are processed one after the other and
+    // the feature finder parallelizes within them instead. The features are collected in the chunk order.
+    const Size n_threads = ParallelExecution::getNumberOfThreads();
+    const Size wave_size = (chunks.size() >= n_threads) ? n_threads : 1;
+    // suppress status output from OpenSWATH, unless in debug mode:
+    if (debug_level_ < 1) OpenMS_Log_info.remove(cout);
+    for (Size wave_begin = 0; wave_begin < chunks.size(); wave_begin += wave_size)
     {
-      createAssayLibrary_(chunk.first, chunk.second, ref_rt_map);
-
-      ChromatogramExtractor extractor;
-      // extractor.setLogType(ProgressLogger::NONE);
+      const Size wave_end = min(chunks.size(), wave_begin + wave_size);
+      vector<TargetedExperiment> libraries(wave_end - wave_begin);
+      for (Size i = wave_begin; i < wave_end; ++i)
       {
-        vector<OpenSwath::ChromatogramPtr> chrom_temp;
-        vector<ChromatogramExtractor::ExtractionCoordinates> coords;
-        // take entries in library_ and put to chrom_temp and coords
-        extractor.prepare_coordinates(chrom_temp, coords, library_,
-                                      numeric_limits<double>::quiet_NaN(), false);
-
-
-        extractor.extractChromatograms(spec_temp, chrom_temp, coords, mz_window_,
-                                       mz_window_ppm_, "tophat");
-        extractor.return_chromatogram(chrom_temp, coords, library_, (*shared)[0],
-                                      chrom_data_.getChromatograms(), false);
+        createAssayLibrary_(chunks[i].first, chunks[i].second, ref_rt_map);
+        swap(libraries[i - wave_begin], library_);
+        library_.clear(true);
       }
 
-      OPENMS_LOG_DEBUG << "Extracted " << chrom_data_.getNrChromatograms()
-                       << " chromatogram(s)." << endl;
+      vector<FeatureMap> chunk_features(libraries.size());
+      ParallelExecution::forEachWithState(0, (SignedSize)libraries.size(),
+        [&]()
+        {
+          // set up like 'feat_finder_' (which is not copyable)
+          unique_ptr<MRMFeatureFinderScoring> feat_finder(new MRMFeatureFinderScoring());
+          feat_finder->setParameters(feat_finder_.getParameters());
+          feat_finder->setLogType(ProgressLogger::NONE);
+          feat_finder->setStrictFlag(false);
+          return make_pair(std::move(feat_finder), spec_temp->lightClone());
+        },
+        [&](pair<unique_ptr<MRMFeatureFinderScoring>, OpenSwath::SpectrumAccessPtr>& state, SignedSize i)
+        {
+          TargetedExperiment& library = libraries[i];
+          boost::shared_ptr<PeakMap> chrom_data = boost::make_shared<PeakMap>();
+          ChromatogramExtractor extractor;
+          {
+            vector<OpenSwath::ChromatogramPtr> chrom_temp;
+            vector<ChromatogramExtractor::ExtractionCoordinates> coords;
+            // take entries in library and put to chrom_temp and coords
+            extractor.prepare_coordinates(chrom_temp, coords, library,
+                                          numeric_limits<double>::quiet_NaN(), false);
+
+            extractor.extractChromatograms(state.second, chrom_temp, coords, mz_window_,
+                                           mz_window_ppm_, "tophat");
+            extractor.return_chromatogram(chrom_temp, coords, library, (*shared)[0],
+                                          chrom_data->getChromatograms(), false);
+          }
 
-      OPENMS_LOG_DEBUG << "Detecting chromatographic peaks..." << endl;
-      // suppress status output from OpenSWATH, unless in debug mode:
-      if (debug_level_ < 1) OpenMS_Log_info.remove(cout);
-      feat_finder_.pickExperiment(chrom_data_, features, library_,
-                                  TransformationDescription(), ms_data_);
-      if (debug_level_ < 1) OpenMS_Log_info.insert(cout); // revert logging change
-      chrom_data_.clear(true);
-      library_.clear(true);
-      // since chrom_data_ here is just a container for the chromatograms and identifications will be empty,
-      // pickExperiment above will only add empty ProteinIdentification runs with colliding identifiers.
-      // Usually we could sanitize the identifiers or merge the runs, but since they are empty and we add the
-      // "real" proteins later -> just clear them
-      features.getProteinIdentifications().clear();
+          OPENMS_LOG_DEBUG << "Extracted " << chrom_data->getNrChromatograms()
+                           << " chromatogram(s)." << endl;
+
+          OPENMS_LOG_DEBUG << "Detecting chromatographic peaks..." << endl;
+          // use the spectrum access of the MS data directly (instead of a copy of the data per chunk):
+          OpenSwath::LightTargetedExperiment light_library;
+          OpenSwathDataAccessHelper::convertTargetedExp(library, light_library);
+          library.clear(true);
+          OpenSwath::SwathMap swath_map;
+          swath_map.sptr = state.second;
+          MRMFeatureFinderScoring::TransitionGroupMapType transition_group_map;
+          state.first->pickExperiment(SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(chrom_data),
+                                     chunk_features[i], light_library, TransformationDescription(),
+                                     vector<OpenSwath::SwathMap>(1, swath_map), transition_group_map);
+        }, ParallelExecution::Schedule::DYNAMIC);
+
+      for (FeatureMap& chunk : chunk_features)
+      {
+        for (Feature& feature : chunk)
+        {
+          features.push_back(std::move(feature));
+        }
+      }
+      // since the chunk feature maps are just containers for the features, their (empty) ProteinIdentification
+      // runs with colliding identifiers are not taken over - we add the "real" proteins later
     }
+    if (debug_level_ < 1) OpenMS_Log_info.insert(cout); // revert logging change
 
     OPENMS_LOG_INFO << "Found " << features.size() << " feature candidates in total."
                     << endl;
@@ -1354,18 +1394,21 @@ namespace OpenMS
     for (vector<String>::iterator pred_it = svm_predictor_names_.begin();
          pred_it != svm_predictor_names_.end(); ++pred_it)
     {
-      predictors[*pred_it].reserve(features.size());
+      // look up the meta value by index (not by name) for every feature:
+      const UInt pred_key = MetaInfoInterface::metaRegistry().registerName(*pred_it);
+      vector<double>& values = predictors[*pred_it];
+      values.reserve(features.size());
       for (FeatureMap::Iterator feat_it = features.begin(); 
            feat_it < features.end(); ++feat_it)
       {
-        if (!feat_it->metaValueExists(*pred_it))
+        if (!feat_it->metaValueExists(pred_key))
         {
           OPENMS_LOG_ERROR << "Meta value '" << *pred_it << "' missing for feature '"
                     << feat_it->getUniqueId() << "'" << std::endl;
           predictors.erase(*pred_it);
           break;
         }
-        predictors[*pred_it].push_back(feat_it->getMetaValue(*pred_it));
+        values.push_back(feat_it->getMetaValue(pred_key));
       }
     }
 
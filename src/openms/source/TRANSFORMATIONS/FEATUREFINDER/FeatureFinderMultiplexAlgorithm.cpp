@@ -108,6 +108,10 @@ namespace OpenMS
     defaults_.setValidStrings("algorithm:averagine_type", ListUtils::create<String>("peptide,RNA,DNA"));
     defaults_.setValue("algorithm:knock_out", "false", "Is it likely that knock-outs are present? (Supported for doublex, triplex and quadruplex experiments only.)", ListUtils::create<String>("advanced"));
     defaults_.setValidStrings("algorithm:knock_out", ListUtils::create<String>("true,false"));
+    defaults_.setValue("algorithm:rt_window", 0.0, "Size [s] of RT windows which are filtered, clustered and reported independently (and in parallel). Memory use then scales with the window size instead of the size of the map. 0 processes the whole map at once.", ListUtils::create<String>("advanced"));
+    defaults_.setMinFloat("algorithm:rt_window", 0.0);
+    defaults_.setValue("algorithm:rt_window_overlap", 120.0, "RT range [s] added on both sides of each RT window (if 'rt_window' is used). Multiplets are only reported by the window containing their RT, the overlap provides the context which is needed to detect them completely. It should be larger than the elution time of the longest peptides.", ListUtils::create<String>("advanced"));
+    defaults_.setMinFloat("algorithm:rt_window_overlap", 0.0);
 
     defaults_.setSectionDescription("algorithm", "algorithmic parameters");
     
@@ -148,6 +152,9 @@ namespace OpenMS
     }
     
     centroided_ = false;
+
+    rt_core_begin_ = -std::numeric_limits<double>::max();
+    rt_core_end_ = std::numeric_limits<double>::max();
   }
   
   /**
@@ -721,7 +728,8 @@ namespace OpenMS
           consensus_map_.getColumnHeaders()[peptide].size++;
         }
         
-        if (!abort)
+        // in RT-windowed mode, each multiplet is reported by the window which contains it in its core
+        if (!abort && consensus.getRT() >= rt_core_begin_ && consensus.getRT() < rt_core_end_)
         {
           consensus_map_.push_back(consensus);
           for (std::vector<Feature>::iterator it = features.begin(); it != features.end(); ++it)
@@ -880,7 +888,8 @@ namespace OpenMS
           consensus_map_.getColumnHeaders()[peptide].size++;
         }
         
-        if (!abort)
+        // in RT-windowed mode, each multiplet is reported by the window which contains it in its core
+        if (!abort && consensus.getRT() >= rt_core_begin_ && consensus.getRT() < rt_core_end_)
         {
           consensus_map_.push_back(consensus);
           for (std::vector<Feature>::iterator it = features.begin(); it != features.end(); ++it)
@@ -962,6 +971,14 @@ namespace OpenMS
       centroided_ = false;
     }
     
+    // process large maps in independent RT windows
+    double rt_window = param_.getValue("algorithm:rt_window");
+    if (rt_window > 0.0 && exp.getMaxRT() - exp.getMinRT() > rt_window)
+    {
+      runWindowed_(exp);
+      return;
+    }
+
     // store experiment in member varaibles
     if (centroided_)
     {
@@ -1153,6 +1170,135 @@ namespace OpenMS
     feature_map_.applyMemberFunction(&UniqueIdInterface::setUniqueId);
   }
   
+  void FeatureFinderMultiplexAlgorithm::runWindowed_(const MSExperiment& exp)
+  {
+    const double rt_window = param_.getValue("algorithm:rt_window");
+    const double rt_overlap = param_.getValue("algorithm:rt_window_overlap");
+    const double rt_first = exp.getMinRT();
+    const SignedSize window_count = static_cast<SignedSize>(std::ceil((exp.getMaxRT() - rt_first) / rt_window));
+
+    // all windows use the same parameters (and the spectrum type determined for the complete map)
+    Param window_param(param_);
+    window_param.setValue("algorithm:rt_window", 0.0);
+    window_param.setValue("algorithm:spectrum_type", centroided_ ? "centroid" : "profile");
+
+    std::vector<FeatureMap> window_features(window_count);
+    std::vector<ConsensusMap> window_consensus(window_count);
+    std::vector<MSExperiment> window_blacklist(window_count);
+    std::vector<bool> window_processed(window_count, false);
+
+    if (progress_)
+    {
+      startProgress(0, window_count, "detecting peptide multiplets in RT windows");
+    }
+    Size progress = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (SignedSize w = 0; w < window_count; ++w)
+    {
+      // core [begin, end) of this window, the first and last window are open to the outside
+      const double core_begin = (w == 0) ? -std::numeric_limits<double>::max() : rt_first + w * rt_window;
+      const double core_end = (w + 1 == window_count) ? std::numeric_limits<double>::max() : rt_first + (w + 1) * rt_window;
+
+      // only the spectra of the window (including its overlap) are copied
+      MSExperiment window_exp;
+      for (MSExperiment::ConstIterator it = exp.RTBegin(core_begin - rt_overlap); it != exp.RTEnd(core_end + rt_overlap); ++it)
+      {
+        window_exp.addSpectrum(*it);
+      }
+
+      if (!window_exp.empty())
+      {
+        FeatureFinderMultiplexAlgorithm algorithm;
+        algorithm.setLogType(ProgressLogger::NONE);
+        algorithm.setParameters(window_param);
+        algorithm.rt_core_begin_ = core_begin;
+        algorithm.rt_core_end_ = core_end;
+        algorithm.run(window_exp, false);
+
+        window_features[w].swap(algorithm.getFeatureMap());
+        window_consensus[w].swap(algorithm.getConsensusMap());
+
+        // keep the blacklisted peaks of the core spectra
+        for (const MSSpectrum& spectrum : algorithm.getBlacklist())
+        {
+          if (spectrum.getRT() >= core_begin && spectrum.getRT() < core_end)
+          {
+            window_blacklist[w].addSpectrum(spectrum);
+          }
+        }
+        window_processed[w] = true;
+      }
+
+#ifdef _OPENMP
+#pragma omp critical (FeatureFinderMultiplexAlgorithm_progress)
+#endif
+      {
+        if (progress_)
+        {
+          setProgress(++progress);
+        }
+      }
+    }
+
+    if (progress_)
+    {
+      endProgress();
+    }
+
+    // stitch the windows together (in RT order)
+    feature_map_.clear(true);
+    consensus_map_.clear(true);
+    exp_blacklist_.clear(true);
+    bool headers_set = false;
+    for (SignedSize w = 0; w < window_count; ++w)
+    {
+      if (!window_processed[w])
+      {
+        continue;
+      }
+      if (!headers_set)
+      {
+        consensus_map_.setColumnHeaders(window_consensus[w].getColumnHeaders());
+        consensus_map_.setExperimentType(window_consensus[w].getExperimentType());
+        headers_set = true;
+      }
+      for (ConsensusFeature& consensus : window_consensus[w])
+      {
+        consensus_map_.push_back(std::move(consensus));
+      }
+      for (Feature& feature : window_features[w])
+      {
+        feature_map_.push_back(std::move(feature));
+      }
+      for (MSSpectrum& spectrum : window_blacklist[w])
+      {
+        exp_blacklist_.addSpectrum(std::move(spectrum));
+      }
+    }
+    exp_blacklist_.updateRanges();
+
+    // the number of features per channel, counted over the reported multiplets
+    for (auto& ch : consensus_map_.getColumnHeaders())
+    {
+      ch.second.size = 0;
+    }
+    for (const ConsensusFeature& consensus : consensus_map_)
+    {
+      for (const FeatureHandle& handle : consensus.getFeatures())
+      {
+        consensus_map_.getColumnHeaders()[handle.getMapIndex()].size++;
+      }
+    }
+
+    consensus_map_.sortByPosition();
+    consensus_map_.applyMemberFunction(&UniqueIdInterface::setUniqueId);
+    feature_map_.sortByPosition();
+    feature_map_.applyMemberFunction(&UniqueIdInterface::setUniqueId);
+  }
+
   FeatureMap& FeatureFinderMultiplexAlgorithm::getFeatureMap()
   {
     return feature_map_;
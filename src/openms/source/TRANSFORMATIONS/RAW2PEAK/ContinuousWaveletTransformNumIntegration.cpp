@@ -35,16 +35,39 @@
 
 #include <OpenMS/TRANSFORMATIONS/RAW2PEAK/ContinuousWaveletTransformNumIntegration.h>
 
+#include <Evergreen/evergreen.hpp>
+
 namespace OpenMS
 {
+  namespace
+  {
+    /// minimal number of wavelet values (at the data spacing) from which on the FFT is faster than the direct integration
+    const int FFT_MIN_KERNEL_SIZE_ = 64;
+  }
+
+  int ContinuousWaveletTransformNumIntegration::halfWidthInData_(double spacing_data) const
+  {
+    return (int)floor((wavelet_.size() * spacing_) / spacing_data);
+  }
+
+  int ContinuousWaveletTransformNumIntegration::waveletIndex_(int k, double spacing_data) const
+  {
+    // the half width in data points is rounded down, but the wavelet index is rounded to the nearest one,
+    // so the last data point may lie just outside the tabulated wavelet
+    return std::min((int)Math::round((k * spacing_data) / spacing_), (int)wavelet_.size() - 1);
+  }
+
+  bool ContinuousWaveletTransformNumIntegration::useFFT_(double spacing_data) const
+  {
+    return 2 * halfWidthInData_(spacing_data) + 1 >= FFT_MIN_KERNEL_SIZE_;
+  }
   double ContinuousWaveletTransformNumIntegration::integrate_
     (const std::vector<double> & processed_input,
     double spacing_data,
     int index)
   {
     double v = 0.;
-    int half_width = (int)wavelet_.size();
-    int index_in_data = (int)floor((half_width * spacing_) / spacing_data);
+    int index_in_data = halfWidthInData_(spacing_data);
     int offset_data_left = ((index - index_in_data) < 0) ? 0 : (index - index_in_data);
     int offset_data_right = ((index + index_in_data) > (int)processed_input.size() - 1) ? (int)processed_input.size() - 2 : (index + index_in_data);
 
@@ -53,7 +76,7 @@ namespace OpenMS
       int index_w_r = 0;
       for (int i = index; i > offset_data_left; --i)
       {
-        int index_w_l = (int)Math::round(((index - (i - 1)) * spacing_data) / spacing_);
+        int index_w_l = waveletIndex_(index - (i - 1), spacing_data);
         // we could also use:
         // v += spacing_data / 2. * (...), but this can be factored out (see below) for faster computation
         v += (processed_input[i] * wavelet_[index_w_r] + processed_input[i - 1] * wavelet_[index_w_l]);
@@ -66,7 +89,7 @@ namespace OpenMS
       int index_w_l = 0;
       for (int i = index; i < offset_data_right; ++i)
       {
-        int index_w_r = (int)Math::round((((i + 1) - index) * spacing_data) / spacing_);
+        int index_w_r = waveletIndex_((i + 1) - index, spacing_data);
         v += (processed_input[i + 1] * wavelet_[index_w_r] + processed_input[i] * wavelet_[index_w_l]);
         index_w_l = index_w_r;
       }
@@ -76,11 +99,56 @@ namespace OpenMS
     return v / 2./ sqrt(scale_) * spacing_data;
   }
 
+  void ContinuousWaveletTransformNumIntegration::integrateFFT_
+    (const std::vector<double> & processed_input,
+    double spacing_data,
+    std::vector<double> & result) const
+  {
+    const int n = (int)processed_input.size();
+    const int index_in_data = halfWidthInData_(spacing_data);
+    result.assign(n, 0.);
+    if (n == 0)
+    {
+      return;
+    }
+
+    // the (symmetric) wavelet at the data spacing, centered at index_in_data
+    std::vector<double> kernel(2 * index_in_data + 1);
+    for (int k = 0; k <= index_in_data; ++k)
+    {
+      kernel[index_in_data - k] = kernel[index_in_data + k] = wavelet_[waveletIndex_(k, spacing_data)];
+    }
+    const evergreen::Tensor<double> conv = evergreen::fft_convolve(
+      evergreen::Tensor<double>(evergreen::Vector<unsigned long>({(unsigned long)n}), evergreen::Vector<double>(processed_input)),
+      evergreen::Tensor<double>(evergreen::Vector<unsigned long>({(unsigned long)kernel.size()}), evergreen::Vector<double>(kernel)));
+
+    // integrate_() applies the trapezoidal rule on [offset_data_left, offset_data_right] (i.e. all values have weight 2,
+    // except for the two end points) and leaves out the last data point if the wavelet reaches beyond the right border
+    for (int i = 0; i < n; ++i)
+    {
+      const int left = std::max(0, i - index_in_data);
+      int right = i + index_in_data;
+      double sum = conv[i + index_in_data];
+      if (right > n - 1)
+      {
+        right = std::max(n - 2, i);
+        if (i < n - 1)
+        {
+          sum -= processed_input[n - 1] * kernel[index_in_data + (n - 1 - i)];
+        }
+      }
+      const double v = 2 * sum - processed_input[left] * kernel[index_in_data + (i - left)]
+                       - processed_input[right] * kernel[index_in_data + (right - i)];
+      result[i] = v / 2. / sqrt(scale_) * spacing_data;
+    }
+  }
+
   void ContinuousWaveletTransformNumIntegration::init(double scale, double spacing)
   {
     // will set members for scale_ and spacing_
     ContinuousWaveletTransform::init(scale, spacing);
     int number_of_points = (int)(ceil(5 * scale_ / spacing_)) + 1;
+    wavelet_.clear();
     wavelet_.reserve(number_of_points);
     wavelet_.push_back(1.);
 
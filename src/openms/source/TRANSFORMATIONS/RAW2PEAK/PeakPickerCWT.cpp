@@ -58,7 +58,9 @@ namespace OpenMS
     scale_(0.0),
     peak_corr_bound_(0.0),
     noise_level_(0.0),
-    optimization_(false)
+    optimization_(false),
+    peak_bound_cwt_(0.0),
+    peak_bound_ms2_level_cwt_(0.0)
   {
     defaults_.setValue("signal_to_noise", 1.0, "Minimal signal to noise ratio for a peak to be picked.");
     defaults_.setMinFloat("signal_to_noise", 0.0);
@@ -208,6 +210,13 @@ namespace OpenMS
     signal_to_noise_ = (float)param_.getValue("signal_to_noise");
 
     deconvolution_ = param_.getValue("deconvolution:deconvolution").toBool();
+
+    // the wavelets and the peak bounds in the CWT only depend on the parameters, so they are computed here once
+    // instead of for every spectrum
+    ContinuousWaveletTransformNumIntegration wt_ms2;
+    initializeWT_(wt_, peak_bound_, peak_bound_cwt_);
+    initializeWT_(wt_ms2, peak_bound_ms2_level_, peak_bound_ms2_level_cwt_);
+    wt_deconvolution_.init((float)param_.getValue("deconvolution:scaling") / 2, (double)param_.getValue("wavelet_transform:spacing"));
   }
 
   bool PeakPickerCWT::getMaxPosition_(
@@ -702,13 +711,10 @@ namespace OpenMS
 
   bool PeakPickerCWT::deconvolutePeak_(PeakShape & shape, std::vector<PeakShape> & peak_shapes, double peak_bound_cwt) const
   {
-    // scaling for charge one
-    float scaling_DC = (float) param_.getValue("deconvolution:scaling");
     double resolution = 10;
-    // init and calculate the transform of the signal in the convoluted region
-    // first take the scaling for charge 2
-    ContinuousWaveletTransformNumIntegration wtDC;
-    wtDC.init(scaling_DC / 2, (double)param_.getValue("wavelet_transform:spacing"));
+    // calculate the transform of the signal in the convoluted region
+    // first take the scaling for charge 2 (see updateMembers_())
+    ContinuousWaveletTransformNumIntegration wtDC(wt_deconvolution_);
     wtDC.transform(shape.getLeftEndpoint(), shape.getRightEndpoint(), resolution);
     
 #ifdef DEBUG_DECONV
@@ -1111,13 +1117,11 @@ namespace OpenMS
     output.getFloatDataArrays()[5].setName("peakShape");
     output.getFloatDataArrays()[6].setName("SignalToNoise");
 
-    /// The continuous wavelet "transformer"
-    ContinuousWaveletTransformNumIntegration wt;
+    /// The continuous wavelet "transformer" (every spectrum is picked with its own cwt, the wavelet is tabulated in updateMembers_())
+    ContinuousWaveletTransformNumIntegration wt(wt_);
     /// The minimal height which defines a peak in the CWT
-    double peak_bound_ms_cwt = 0.0;
+    double peak_bound_ms_cwt = (input.getMSLevel() <= 1 ? peak_bound_cwt_ : peak_bound_ms2_level_cwt_);
     double bound = (input.getMSLevel() <= 1 ? peak_bound_ : peak_bound_ms2_level_);
-    // now initialize every time as every spectrum is picked with its own cwt
-    initializeWT_(wt, bound, peak_bound_ms_cwt);
 
     //create the peak shapes vector
     std::vector<PeakShape> peak_shapes;
@@ -500,6 +500,16 @@ protected:
     QLabel* rt_label_;
     //@}
 
+    /**
+      @brief Loads a mzML file into @p map in a background thread
+
+      The GUI stays responsive meanwhile and a progress dialog allows to cancel loading.
+
+      @return false if loading was cancelled by the user
+      @exception Exception::BaseException is rethrown if loading failed
+    */
+    bool loadMzMLInBackground_(const String& filename, ExperimentType& map);
+
     /// @name Recent files
     //@{
     ///adds a Filename to the recent files
@@ -0,0 +1,135 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+// OpenMS_GUI config
+#include <OpenMS/VISUAL/OpenMS_GUIConfig.h>
+
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/KERNEL/StandardTypes.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+
+  /**
+    @brief Multi-resolution maximum intensity grid of the MS1 peaks of a peak map.
+
+    The base level divides the RT and m/z range of the MS1 data into a regular
+    grid of cells, each holding the maximum intensity of the peaks it contains
+    (or -1 if it contains none). Every further level halves the resolution in
+    both dimensions by taking the maximum of 2x2 cells of the previous level.
+
+    getMaxIntensities() uses the coarsest level whose cells are still smaller than
+    the requested pixels. Thus, the cost of a query only depends on the number of pixels,
+    not on the number of peaks in the map. This is used by Spectrum2DCanvas to paint
+    large maps at overview zoom levels. Queries for pixels smaller than the base cells
+    cannot be answered (see canResolve()) and need to fall back to the raw peaks.
+
+    @ingroup Visual
+  */
+  class OPENMS_GUI_DLLAPI MaxIntensityPyramid
+  {
+public:
+    /// Default constructor (empty pyramid)
+    MaxIntensityPyramid();
+
+    /**
+      @brief Builds the pyramid from the MS1 spectra of @p map
+
+      @param map The peak map (spectra need to be sorted by m/z)
+      @param rt_bins Maximum number of base level cells in RT dimension (not more than the number of MS1 spectra are used)
+      @param mz_bins Number of base level cells in m/z dimension
+    */
+    explicit MaxIntensityPyramid(const PeakMap& map, Size rt_bins = 1024, Size mz_bins = 4096);
+
+    /// Returns if the pyramid contains no data
+    bool empty() const;
+
+    /// Returns the number of levels (including the base level)
+    Size getLevelCount() const;
+
+    /// Returns if the pyramid was built from a map of the same size as @p map (used to detect changed data)
+    bool matches(const PeakMap& map) const;
+
+    /// Returns if pixels of the given size (in data coordinates) are at least as large as the base level cells
+    bool canResolve(double rt_pixel_size, double mz_pixel_size) const;
+
+    /**
+      @brief Computes the maximum intensity for each pixel of a grid over the given area
+
+      Each cell of the selected level is assigned to the pixel that contains its center.
+
+      @param rt_min Lower RT bound of the area
+      @param rt_max Upper RT bound of the area
+      @param rt_pixels Number of pixels in RT dimension
+      @param mz_min Lower m/z bound of the area
+      @param mz_max Upper m/z bound of the area
+      @param mz_pixels Number of pixels in m/z dimension
+      @param intensities Output: row-major (RT major) maximum intensities, -1 for pixels without peaks
+    */
+    void getMaxIntensities(double rt_min, double rt_max, Size rt_pixels,
+                           double mz_min, double mz_max, Size mz_pixels,
+                           std::vector<float>& intensities) const;
+
+protected:
+    /// One level of the pyramid
+    struct Level
+    {
+      Size rt_bins;
+      Size mz_bins;
+      double rt_cell_size;
+      double mz_cell_size;
+      std::vector<float> cells; ///< row-major (RT major)
+    };
+
+    /// Computes the next coarser level from @p fine
+    static Level coarsen_(const Level& fine);
+
+    /// levels, starting with the finest
+    std::vector<Level> levels_;
+    /// lower RT bound of the grid
+    double rt_origin_;
+    /// lower m/z bound of the grid
+    double mz_origin_;
+    /// number of spectra of the source map
+    Size map_spectra_;
+    /// number of peaks of the source map
+    UInt64 map_peaks_;
+  };
+
+} // namespace OpenMS
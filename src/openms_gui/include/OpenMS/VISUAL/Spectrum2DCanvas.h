@@ -41,6 +41,7 @@
 #include <OpenMS/VISUAL/SpectrumCanvas.h>
 #include <OpenMS/VISUAL/Spectrum1DCanvas.h>
 #include <OpenMS/KERNEL/PeakIndex.h>
+#include <OpenMS/VISUAL/MaxIntensityPyramid.h>
 
 // QT
 class QPainter;
@@ -185,6 +186,9 @@ protected:
       Paints the peaks as small ellipses. The peaks are colored according to the
       selected dot gradient.
 
+      If the layer has no active filters and its max. intensity pyramid (see getIntensityPyramid_())
+      is ready and fine enough for the current zoom level, the pyramid is painted instead of the raw peaks.
+
       @param layer_index The index of the layer.
       @param rt_pixel_count
       @param mz_pixel_count
@@ -348,6 +352,15 @@ protected:
     /// recalculates the dot gradient of a layer
     void recalculateDotGradient_(Size layer);
 
+    /**
+      @brief Returns the max. intensity pyramid of a peak layer
+
+      If the pyramid is not available yet (or the peak data changed since it was built), it is
+      built in a background thread and a null pointer is returned. The canvas is repainted when
+      building is finished.
+    */
+    boost::shared_ptr<const MaxIntensityPyramid> getIntensityPyramid_(Size layer_index);
+
     /// Highlights a single peak and prints coordinates to screen
     void highlightPeak_(QPainter& p, const PeakIndex& peak);
 
@@ -389,6 +402,9 @@ protected:
     double pen_size_max_; ///< maximum number of pixels for one data point
     double canvas_coverage_min_; ///< minimum coverage of the canvas required; if lower, points are upscaled in size
 
+    /// max. intensity pyramids of the peak layers (null while being built)
+    std::map<const ExperimentType*, boost::shared_ptr<const MaxIntensityPyramid> > intensity_pyramids_;
+
   private:
     /// Default C'tor hidden
     Spectrum2DCanvas();
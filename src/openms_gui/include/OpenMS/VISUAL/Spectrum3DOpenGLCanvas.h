@@ -43,6 +43,8 @@
 // OpenMS
 #include <OpenMS/DATASTRUCTURES/DRange.h>
 
+#include <vector>
+
 namespace OpenMS
 {
   class Spectrum3DCanvas;
@@ -114,6 +116,12 @@ protected:
     void qglColor_(QColor color);
     ///helper function to replicate old behaviour of QGLWidget
     void qglClearColor_(QColor clearColor);
+    /// Returns the position of @p intensity in the gradient of a layer, depending on the intensity mode
+    double gradientPosition_(float intensity, Size layer_index) const;
+    /// Appends a vertex and its color to the vertex arrays
+    static void appendVertex_(std::vector<GLfloat>& vertices, std::vector<GLfloat>& colors, GLfloat x, GLfloat y, GLfloat z, const QColor& color);
+    /// Draws vertex arrays (3 coordinates and 4 color components per vertex) with a single call (compiled into the current display list)
+    void drawVertexArrays_(GLenum mode, const std::vector<GLfloat>& vertices, const std::vector<GLfloat>& colors);
     /// Builds up a display list for the 3D view
     GLuint makeDataAsStick_();
     /// Builds up a display list for the axes
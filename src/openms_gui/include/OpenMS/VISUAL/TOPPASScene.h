@@ -44,6 +44,8 @@
 #include <QtWidgets/QGraphicsScene>
 #include <QtCore/QProcess>
 
+#include <map>
+
 namespace OpenMS
 {
   class TOPPASVertex;
@@ -93,11 +95,12 @@ public:
     struct TOPPProcess
     {
       /// Constructor
-      TOPPProcess(QProcess * p, const QString & cmd, const QStringList & arg, TOPPASToolVertex * const tool) :
+      TOPPProcess(QProcess * p, const QString & cmd, const QStringList & arg, TOPPASToolVertex * const tool, int nr_threads = 1) :
         proc(p),
         command(cmd),
         args(arg),
-        tv(tool)
+        tv(tool),
+        threads(nr_threads)
       {
       }
 
@@ -109,6 +112,8 @@ public:
       QStringList args;
       /// The tool which is started (used to call its slots)
       TOPPASToolVertex * tv;
+      /// Number of threads the tool uses (counted against the allowed threads)
+      int threads;
     };
 
     /// The current action mode (creation of a new edge, or panning of the widget)
@@ -206,7 +211,14 @@ public:
     bool askForOutputDir(bool always_ask = true);
     /// Enqueues the process, it will be run when the currently pending processes have finished
     void enqueueProcess(const TOPPProcess & process);
-    /// Runs the next process in the queue, if any
+    /**
+      @brief Runs queued processes as long as they fit into the allowed threads and memory
+
+      Processes are considered in queue order, but a process which does not fit (yet) is skipped
+      in favor of later, smaller ones. If nothing is running, the first process is started regardless
+      of its requirements. The memory requirement of a tool is the largest peak memory reported by
+      previous runs of the same tool (see setAllowedMemory()); tools without a report yet count as zero.
+    */
     void runNextProcess();
     /// Resets the processes queue
     void resetProcessesQueue();
@@ -240,8 +252,14 @@ public:
     QString getDescription() const;
     /// when description is updated by user, use this to update the description for later storage in file
     void setDescription(const QString & desc);
-    /// sets the maximum number of jobs
+    /// sets the maximum number of threads used by all running jobs (each job uses at least one)
     void setAllowedThreads(int num_threads);
+    /// sets the maximum memory (in MB) of all running jobs; 0 means unlimited
+    void setAllowedMemory(Size memory_mb);
+    /// sets the directory where results of tool nodes are cached between runs; an empty string disables caching
+    void setCacheDirectory(const QString& cache_dir);
+    /// returns the result cache directory (empty if caching is disabled)
+    const QString& getCacheDirectory() const;
     /// returns the hovering edge
     TOPPASEdge* getHoveringEdge();
     /// Checks whether all output vertices are finished, and if yes, emits entirePipelineFinished() (called by finished output vertices)
@@ -275,8 +293,8 @@ public slots:
     void changedParameter(const bool invalidates_running_pipeline);
     /// Invoked by OutfilelistVertex of user changed the folder name
     void changedOutputFolder();
-    /// Called by a finished QProcess to indicate that we are free to start a new one
-    void processFinished();
+    /// Called by a finished QProcess to indicate that we are free to start a new one (releases its threads and memory and records its resource report)
+    void processFinished(QProcess * p);
     /// dirty solution: when using ExecutePipeline this slot is called when the pipeline crashes. This will quit the app
     void quitWithError();
 
@@ -355,12 +373,22 @@ protected:
     TOPPASScene * clipboard_;
     /// dry run mode (no tools are actually called)
     bool dry_run_;
-    /// currently running processes...
+    /// threads used by the currently running processes
     int threads_active_;
     /// description text
     QString description_text_;
     /// maximum number of allowed threads
     int allowed_threads_;
+    /// memory (in KB) expected to be used by the currently running processes
+    Size memory_active_kb_;
+    /// maximum memory (in KB) of all running processes (0 = unlimited)
+    Size allowed_memory_kb_;
+    /// threads and expected memory (in KB) reserved for each running process
+    std::map<const QProcess*, std::pair<int, Size> > running_processes_;
+    /// largest peak memory (in KB) reported by each tool so far
+    std::map<String, Size> tool_peak_memory_kb_;
+    /// directory of the content-addressed result cache (empty = disabled)
+    QString cache_dir_;
     /// last node where 'resume' was started
     TOPPASToolVertex* resume_source_;
 
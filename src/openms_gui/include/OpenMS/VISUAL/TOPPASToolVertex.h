@@ -257,6 +257,12 @@ protected:
     /// smart naming of round-based filenames
     /// when basename is not unique we take the preceding directory name
     void smartFileNames_(std::vector<QStringList>& filenames);
+    /// Computes the result cache key of one round from the tool version, the parameters (without file parameters) and the contents of the @p inputs
+    String computeCacheKey_(const RoundPackage& inputs, const RoundPackage& outputs, const QVector<IOInfo>& in_params, const QVector<IOInfo>& out_params) const;
+    /// Copies the cached results in @p cache_entry to @p outputs. Returns false (cache miss) if the entry is incomplete.
+    bool restoreFromCache_(const QString& cache_entry, const QStringList& outputs) const;
+    /// Stores @p outputs of a successful round in @p cache_entry. Outputs which are not plain files (e.g. directories) are not cached.
+    void storeInCache_(const QString& cache_entry, const QStringList& outputs) const;
 
     /// The name of the tool
     String name_;
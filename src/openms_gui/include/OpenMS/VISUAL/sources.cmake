@@ -17,6 +17,7 @@ InputFile.h
 InputFileList.h
 LayerData.h
 ListEditor.h
+MaxIntensityPyramid.h
 MetaDataBrowser.h
 MultiGradient.h
 MultiGradientSelector.h
@@ -39,6 +39,8 @@
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/KERNEL/OnDiscMSExperiment.h>
 #include <OpenMS/FORMAT/HANDLERS/IndexedMzMLHandler.h>
+#include <OpenMS/FORMAT/HANDLERS/XMLHandler.h>
+#include <OpenMS/INTERFACES/IMSDataConsumer.h>
 #include <OpenMS/ANALYSIS/ID/IDMapper.h>
 #include <OpenMS/CHEMISTRY/TheoreticalSpectrumGenerator.h>
 #include <OpenMS/CHEMISTRY/AASequence.h>
@@ -95,6 +97,9 @@
 #include <QtCore/QDir>
 #include <QtCore/QTime>
 #include <QtCore/QUrl>
+#include <QtCore/QFileInfo>
+#include <QtConcurrent/QtConcurrent>
+#include <QtWidgets/QProgressDialog>
 #include <QtWidgets/QCheckBox>
 #include <QCloseEvent>
 #include <QtWidgets/QDesktopWidget>
@@ -119,6 +124,8 @@
 #include <QtWidgets/QWhatsThis>
 #include <QTextCodec>
 
+#include <atomic>
+
 #include <boost/math/special_functions/fpclassify.hpp>
 
 #include <algorithm>
@@ -595,6 +602,8 @@ namespace OpenMS
     defaults_.setValidStrings("preferences:use_cached_ms2", ListUtils::create<String>("true,false"));
     defaults_.setValue("preferences:use_cached_ms1", "false", "If possible, do not load MS1 spectra into memory spectra into memory and keep MS2 spectra on disk (using indexed mzML).");
     defaults_.setValidStrings("preferences:use_cached_ms1", ListUtils::create<String>("true,false"));
+    defaults_.setValue("preferences:on_disc_threshold", 2000, "Indexed mzML files larger than this (in MB) are opened with cached MS2 spectra, even if 'use_cached_ms2' is disabled (0 = never).");
+    defaults_.setMinInt("preferences:on_disc_threshold", 0);
     // 1d view
     Spectrum1DCanvas* def1 = new Spectrum1DCanvas(Param(), nullptr);
     defaults_.insert("preferences:1d:", def1->getDefaults());
@@ -760,6 +769,12 @@ namespace OpenMS
 
     bool cache_ms2_on_disc = ((String)param_.getValue("preferences:use_cached_ms2") == "true");
     bool cache_ms1_on_disc = ((String)param_.getValue("preferences:use_cached_ms1") == "true");
+    // large files are cached on disc by default
+    Int on_disc_threshold = param_.getValue("preferences:on_disc_threshold");
+    if (on_disc_threshold > 0 && QFileInfo(abs_filename.toQString()).size() > qint64(on_disc_threshold) * 1024 * 1024)
+    {
+      cache_ms2_on_disc = true;
+    }
 
     try
     {
@@ -892,7 +907,15 @@ namespace OpenMS
         }
 
         // Load all data into memory
-        if (!parsing_success)
+        if (!parsing_success && type == FileTypes::MZML)
+        {
+          if (!loadMzMLInBackground_(abs_filename, *peak_map_sptr))
+          {
+            showLogMessage_(LS_NOTICE, "Loading cancelled", String("Loading of '") + abs_filename + "' was cancelled.");
+            return;
+          }
+        }
+        else if (!parsing_success)
         {
           fh.loadExperiment(abs_filename, *peak_map_sptr, file_type, ProgressLogger::GUI);
         }
@@ -951,6 +974,106 @@ namespace OpenMS
     watcher_->addFile(abs_filename);
   }
 
+  namespace
+  {
+    /// Reports the progress of MzMLFile::transform and ends parsing when cancelled (the spectra are stored by the handler)
+    class CancellableLoadingConsumer :
+      public Interfaces::IMSDataConsumer
+    {
+    public:
+      CancellableLoadingConsumer(const std::atomic<bool>& cancel, std::atomic<Size>& expected, std::atomic<Size>& loaded) :
+        cancel_(cancel),
+        expected_(expected),
+        loaded_(loaded)
+      {
+      }
+
+      void setExpectedSize(Size expected_spectra, Size /* expected_chromatograms */) override
+      {
+        expected_ = expected_spectra;
+      }
+
+      void setExperimentalSettings(const ExperimentalSettings& /* exp */) override
+      {
+      }
+
+      void consumeSpectrum(SpectrumType& /* s */) override
+      {
+        checkCancelled_();
+        ++loaded_;
+      }
+
+      void consumeChromatogram(ChromatogramType& /* c */) override
+      {
+        checkCancelled_();
+      }
+
+    private:
+      void checkCancelled_() const
+      {
+        if (cancel_)
+        {
+          throw Internal::XMLHandler::EndParsingSoftly(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
+        }
+      }
+
+      const std::atomic<bool>& cancel_;
+      std::atomic<Size>& expected_;
+      std::atomic<Size>& loaded_;
+    };
+  }
+
+  bool TOPPViewBase::loadMzMLInBackground_(const String& filename, ExperimentType& map)
+  {
+    std::atomic<bool> cancel(false);
+    std::atomic<Size> expected(0);
+    std::atomic<Size> loaded(0);
+    std::exception_ptr error;
+
+    // the number of spectra is taken from the spectrumList element instead of counting them in an extra pass
+    QFuture<void> future = QtConcurrent::run([&]()
+    {
+      try
+      {
+        CancellableLoadingConsumer consumer(cancel, expected, loaded);
+        MzMLFile().transform(filename, &consumer, map, true);
+      }
+      catch (...)
+      {
+        error = std::current_exception();
+      }
+    });
+
+    QProgressDialog dlg(String("Loading '" + File::basename(filename) + "' ...").toQString(), "Cancel", 0, 0, this);
+    dlg.setWindowModality(Qt::WindowModal);
+    dlg.setMinimumDuration(500);
+    QMutex mutex; mutex.lock();
+    QWaitCondition qwait;
+    while (!future.isFinished())
+    {
+      if (dlg.wasCanceled())
+      {
+        cancel = true;
+      }
+      dlg.setMaximum(int(expected.load()));
+      dlg.setValue(int(std::min(loaded.load(), expected.load())));
+      qApp->processEvents(); // GUI responsiveness
+      qwait.wait(&mutex, 25); // block for 25ms (enough for GUI responsiveness), so CPU usage remains low
+    }
+    mutex.unlock();
+
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+    if (cancel)
+    {
+      map.clear(true);
+      return false;
+    }
+    return true;
+  }
+
   void TOPPViewBase::addData(FeatureMapSharedPtrType feature_map,
                              ConsensusMapSharedPtrType consensus_map,
                              vector<PeptideIdentification>& peptides,
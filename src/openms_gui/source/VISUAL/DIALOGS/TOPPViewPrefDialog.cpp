@@ -71,6 +71,7 @@ namespace OpenMS
       ui_->default_path_current->setChecked(param_.getValue("preferences:default_path_current").toBool());
       ui_->use_cached_ms1->setChecked(param_.getValue("preferences:use_cached_ms1").toBool());
       ui_->use_cached_ms2->setChecked(param_.getValue("preferences:use_cached_ms2").toBool());
+      ui_->on_disc_threshold->setValue((Int)param_.getValue("preferences:on_disc_threshold"));
    
       ui_->temp_path->setText(param_.getValue("preferences:tmp_file_path").toQString());
       ui_->recent_files->setValue((Int)param_.getValue("preferences:number_of_recent_files"));
@@ -157,6 +158,7 @@ namespace OpenMS
 
       p.setValue("preferences:use_cached_ms1", ui_->use_cached_ms1->isChecked());
       p.setValue("preferences:use_cached_ms2", ui_->use_cached_ms2->isChecked());
+      p.setValue("preferences:on_disc_threshold", ui_->on_disc_threshold->value());
 
       p.setValue("preferences:tmp_file_path", ui_->temp_path->text());
       p.setValue("preferences:number_of_recent_files", ui_->recent_files->value());
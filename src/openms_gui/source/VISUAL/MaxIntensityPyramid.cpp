@@ -0,0 +1,229 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/VISUAL/MaxIntensityPyramid.h>
+
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace OpenMS
+{
+  namespace
+  {
+    /// index of the cell containing @p value, clamped to the valid range
+    inline Size cellIndex(double value, double origin, double cell_size, Size bins)
+    {
+      double index = (value - origin) / cell_size;
+      if (index <= 0.0) return 0;
+      if (index >= double(bins - 1)) return bins - 1;
+      return Size(index);
+    }
+  }
+
+  MaxIntensityPyramid::MaxIntensityPyramid() :
+    levels_(),
+    rt_origin_(0.0),
+    mz_origin_(0.0),
+    map_spectra_(0),
+    map_peaks_(0)
+  {
+  }
+
+  MaxIntensityPyramid::MaxIntensityPyramid(const PeakMap& map, Size rt_bins, Size mz_bins) :
+    levels_(),
+    rt_origin_(0.0),
+    mz_origin_(0.0),
+    map_spectra_(map.size()),
+    map_peaks_(map.getSize())
+  {
+    // collect the MS1 spectra and their RT and m/z range
+    std::vector<Size> ms1_indices;
+    double rt_max = -std::numeric_limits<double>::max();
+    double mz_max = -std::numeric_limits<double>::max();
+    rt_origin_ = std::numeric_limits<double>::max();
+    mz_origin_ = std::numeric_limits<double>::max();
+    for (Size i = 0; i < map.size(); ++i)
+    {
+      const MSSpectrum& spec = map[i];
+      if (spec.getMSLevel() != 1 || spec.empty()) continue;
+      ms1_indices.push_back(i);
+      rt_origin_ = std::min(rt_origin_, spec.getRT());
+      rt_max = std::max(rt_max, spec.getRT());
+      mz_origin_ = std::min(mz_origin_, spec.front().getMZ());
+      mz_max = std::max(mz_max, spec.back().getMZ());
+    }
+    if (ms1_indices.empty() || rt_bins == 0 || mz_bins == 0)
+    {
+      rt_origin_ = 0.0;
+      mz_origin_ = 0.0;
+      return;
+    }
+
+    Level base;
+    base.rt_bins = std::min(rt_bins, ms1_indices.size());
+    base.mz_bins = mz_bins;
+    // a single spectrum (or peak) still gets a cell of non-zero width
+    base.rt_cell_size = (rt_max > rt_origin_ ? rt_max - rt_origin_ : 1.0) / base.rt_bins;
+    base.mz_cell_size = (mz_max > mz_origin_ ? mz_max - mz_origin_ : 1.0) / base.mz_bins;
+    base.cells.assign(base.rt_bins * base.mz_bins, -1.0f);
+
+    // spectra of each RT row of the base level
+    std::vector<std::vector<Size> > row_spectra(base.rt_bins);
+    for (Size i : ms1_indices)
+    {
+      row_spectra[cellIndex(map[i].getRT(), rt_origin_, base.rt_cell_size, base.rt_bins)].push_back(i);
+    }
+
+    // rows are independent of each other
+#pragma omp parallel for schedule(dynamic, 16)
+    for (SignedSize r = 0; r < (SignedSize)base.rt_bins; ++r)
+    {
+      float* row = &base.cells[r * base.mz_bins];
+      for (Size s : row_spectra[r])
+      {
+        for (const Peak1D& p : map[s])
+        {
+          float& cell = row[cellIndex(p.getMZ(), mz_origin_, base.mz_cell_size, base.mz_bins)];
+          cell = std::max(cell, p.getIntensity());
+        }
+      }
+    }
+
+    levels_.push_back(std::move(base));
+    while (levels_.back().rt_bins > 1 || levels_.back().mz_bins > 1)
+    {
+      levels_.push_back(coarsen_(levels_.back()));
+    }
+  }
+
+  MaxIntensityPyramid::Level MaxIntensityPyramid::coarsen_(const Level& fine)
+  {
+    Level coarse;
+    coarse.rt_bins = (fine.rt_bins + 1) / 2;
+    coarse.mz_bins = (fine.mz_bins + 1) / 2;
+    coarse.rt_cell_size = 2.0 * fine.rt_cell_size;
+    coarse.mz_cell_size = 2.0 * fine.mz_cell_size;
+    coarse.cells.assign(coarse.rt_bins * coarse.mz_bins, -1.0f);
+
+#pragma omp parallel for
+    for (SignedSize r = 0; r < (SignedSize)coarse.rt_bins; ++r)
+    {
+      const Size r_end = std::min(2 * Size(r) + 2, fine.rt_bins);
+      for (Size fr = 2 * r; fr < r_end; ++fr)
+      {
+        const float* fine_row = &fine.cells[fr * fine.mz_bins];
+        float* row = &coarse.cells[r * coarse.mz_bins];
+        for (Size fm = 0; fm < fine.mz_bins; ++fm)
+        {
+          row[fm / 2] = std::max(row[fm / 2], fine_row[fm]);
+        }
+      }
+    }
+    return coarse;
+  }
+
+  bool MaxIntensityPyramid::empty() const
+  {
+    return levels_.empty();
+  }
+
+  Size MaxIntensityPyramid::getLevelCount() const
+  {
+    return levels_.size();
+  }
+
+  bool MaxIntensityPyramid::matches(const PeakMap& map) const
+  {
+    return map.size() == map_spectra_ && map.getSize() == map_peaks_;
+  }
+
+  bool MaxIntensityPyramid::canResolve(double rt_pixel_size, double mz_pixel_size) const
+  {
+    return !empty() &&
+           rt_pixel_size >= levels_[0].rt_cell_size &&
+           mz_pixel_size >= levels_[0].mz_cell_size;
+  }
+
+  void MaxIntensityPyramid::getMaxIntensities(double rt_min, double rt_max, Size rt_pixels,
+                                              double mz_min, double mz_max, Size mz_pixels,
+                                              std::vector<float>& intensities) const
+  {
+    intensities.assign(rt_pixels * mz_pixels, -1.0f);
+    if (empty() || rt_pixels == 0 || mz_pixels == 0 || rt_max <= rt_min || mz_max <= mz_min) return;
+
+    const double rt_pixel_size = (rt_max - rt_min) / rt_pixels;
+    const double mz_pixel_size = (mz_max - mz_min) / mz_pixels;
+
+    // coarsest level whose cells are not larger than a pixel
+    Size l = 0;
+    while (l + 1 < levels_.size() &&
+           levels_[l + 1].rt_cell_size <= rt_pixel_size &&
+           levels_[l + 1].mz_cell_size <= mz_pixel_size)
+    {
+      ++l;
+    }
+    const Level& level = levels_[l];
+
+    // pixel of each visible m/z column (determined by the cell center)
+    std::vector<std::pair<Size, Size> > columns;
+    const Size mz_first = cellIndex(mz_min, mz_origin_, level.mz_cell_size, level.mz_bins);
+    for (Size m = mz_first; m < level.mz_bins; ++m)
+    {
+      const double center = mz_origin_ + (m + 0.5) * level.mz_cell_size;
+      if (center >= mz_max) break;
+      if (center < mz_min) continue;
+      columns.emplace_back(m, std::min(Size((center - mz_min) / mz_pixel_size), mz_pixels - 1));
+    }
+
+    const Size rt_first = cellIndex(rt_min, rt_origin_, level.rt_cell_size, level.rt_bins);
+    for (Size r = rt_first; r < level.rt_bins; ++r)
+    {
+      const double center = rt_origin_ + (r + 0.5) * level.rt_cell_size;
+      if (center >= rt_max) break;
+      if (center < rt_min) continue;
+      const Size rt_pixel = std::min(Size((center - rt_min) / rt_pixel_size), rt_pixels - 1);
+
+      const float* row = &level.cells[r * level.mz_bins];
+      float* pixel_row = &intensities[rt_pixel * mz_pixels];
+      for (const auto& c : columns)
+      {
+        pixel_row[c.second] = std::max(pixel_row[c.second], row[c.first]);
+      }
+    }
+  }
+
+} // namespace OpenMS
@@ -60,6 +60,8 @@
 #include <QtWidgets/QComboBox>
 #include <QtWidgets/QFileDialog>
 #include <QtWidgets/QMessageBox>
+#include <QtConcurrent/QtConcurrent>
+#include <QtCore/QFutureWatcher>
 
 //boost
 #include <boost/math/special_functions/fpclassify.hpp>
@@ -655,6 +657,33 @@ namespace OpenMS
     double rt_step_size = (rt_max - rt_min) / rt_pixel_count;
     double mz_step_size = (mz_max - mz_min) / mz_pixel_count;
 
+    // overview: paint the precomputed maxima (filters can only be applied to the raw peaks)
+    if (!layer.filters.isActive())
+    {
+      boost::shared_ptr<const MaxIntensityPyramid> pyramid = getIntensityPyramid_(layer_index);
+      if (pyramid && pyramid->canResolve(rt_step_size, mz_step_size))
+      {
+        vector<float> intensities;
+        pyramid->getMaxIntensities(rt_min, rt_max, rt_pixel_count, mz_min, mz_max, mz_pixel_count, intensities);
+        for (Size rt = 0; rt < rt_pixel_count; ++rt)
+        {
+          for (Size mz = 0; mz < mz_pixel_count; ++mz)
+          {
+            float max = intensities[rt * mz_pixel_count + mz];
+            if (max < 0.0) continue;
+
+            QPoint pos;
+            dataToWidget_(mz_min + (mz + 0.5) * mz_step_size, rt_min + (rt + 0.5) * rt_step_size, pos);
+            if (pos.y() >= 0 && pos.x() >= 0 && pos.y() < image_height && pos.x() < image_width)
+            {
+              buffer_.setPixel(pos.x(), pos.y(), heightColor_(max, layer.gradient, snap_factor).rgb());
+            }
+          }
+        }
+        return;
+      }
+    }
+
     // start at first visible RT scan
     Size scan_index = std::distance(map.begin(), map.RTBegin(rt_min));
     //iterate over all pixels (RT dimension)
@@ -726,6 +755,42 @@ namespace OpenMS
     }
   }
 
+  boost::shared_ptr<const MaxIntensityPyramid> Spectrum2DCanvas::getIntensityPyramid_(Size layer_index)
+  {
+    LayerData::ConstExperimentSharedPtrType data = getLayer(layer_index).getPeakData();
+    const ExperimentType* key = data.get();
+
+    std::map<const ExperimentType*, boost::shared_ptr<const MaxIntensityPyramid> >::const_iterator it = intensity_pyramids_.find(key);
+    if (it != intensity_pyramids_.end())
+    {
+      // still being built, or ready
+      if (!it->second || it->second->matches(*data))
+      {
+        return it->second;
+      }
+    }
+
+    // build in the background (the data is kept alive by the shared pointer), such that the GUI stays responsive
+    intensity_pyramids_[key].reset();
+    QFutureWatcher<boost::shared_ptr<const MaxIntensityPyramid> >* watcher = new QFutureWatcher<boost::shared_ptr<const MaxIntensityPyramid> >(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, key]()
+    {
+      std::map<const ExperimentType*, boost::shared_ptr<const MaxIntensityPyramid> >::iterator entry = intensity_pyramids_.find(key);
+      if (entry != intensity_pyramids_.end()) // layer might have been removed meanwhile
+      {
+        entry->second = watcher->result();
+        update_buffer_ = true;
+        update_(OPENMS_PRETTY_FUNCTION);
+      }
+      watcher->deleteLater();
+    });
+    watcher->setFuture(QtConcurrent::run([data]()
+    {
+      return boost::shared_ptr<const MaxIntensityPyramid>(new MaxIntensityPyramid(*data));
+    }));
+    return boost::shared_ptr<const MaxIntensityPyramid>();
+  }
+
   void Spectrum2DCanvas::paintFeatureData_(Size layer_index, QPainter& painter)
   {
     const LayerData& layer = getLayer(layer_index);
@@ -1330,8 +1395,13 @@ namespace OpenMS
       return;
     }
 
-    // remove the data
+    // remove the data (and its max. intensity pyramid, unless another layer shows the same data)
+    const ExperimentType* peak_data = layers_[layer_index].getPeakData().get();
     layers_.erase(layers_.begin() + layer_index);
+    if (std::none_of(layers_.begin(), layers_.end(), [peak_data](const LayerData& l) { return l.getPeakData().get() == peak_data; }))
+    {
+      intensity_pyramids_.erase(peak_data);
+    }
 
     // update visible area and boundaries
     DRange<3> old_data_range = overall_data_range_;
@@ -531,6 +531,50 @@ namespace OpenMS
     return list;
   }
 
+  double Spectrum3DOpenGLCanvas::gradientPosition_(float intensity, Size layer_index) const
+  {
+    switch (canvas_3d_.intensity_mode_)
+    {
+    case SpectrumCanvas::IM_PERCENTAGE:
+      return intensity * 100.0 / canvas_3d_.getMaxIntensity(layer_index);
+
+    case SpectrumCanvas::IM_LOG:
+      return log10(1 + max(0.0, (double)intensity));
+
+    case SpectrumCanvas::IM_NONE:
+    case SpectrumCanvas::IM_SNAP:
+    default:
+      return intensity;
+    }
+  }
+
+  void Spectrum3DOpenGLCanvas::appendVertex_(std::vector<GLfloat>& vertices, std::vector<GLfloat>& colors, GLfloat x, GLfloat y, GLfloat z, const QColor& color)
+  {
+    vertices.push_back(x);
+    vertices.push_back(y);
+    vertices.push_back(z);
+    colors.push_back(color.redF());
+    colors.push_back(color.greenF());
+    colors.push_back(color.blueF());
+    colors.push_back(color.alphaF());
+  }
+
+  void Spectrum3DOpenGLCanvas::drawVertexArrays_(GLenum mode, const std::vector<GLfloat>& vertices, const std::vector<GLfloat>& colors)
+  {
+    if (vertices.empty())
+    {
+      return;
+    }
+    // the arrays are copied into the display list which is currently compiled
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, vertices.data());
+    glColorPointer(4, GL_FLOAT, 0, colors.data());
+    glDrawArrays(mode, 0, GLsizei(vertices.size() / 3));
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+  }
+
   GLuint Spectrum3DOpenGLCanvas::makeDataAsTopView_()
   {
     GLuint list = glGenLists(1);
@@ -555,61 +599,34 @@ namespace OpenMS
         auto end_it = layer.getPeakData()->areaEndConst();
 
         // count peaks in area
-        int count = std::distance(begin_it, end_it);
+        Size count = std::distance(begin_it, end_it);
 
-        int max_displayed_peaks = 10000;
-        int step = 1;
-        if (count > max_displayed_peaks)
-        {
-          step = 1 + count / max_displayed_peaks;
-        }
+        // points are drawn from vertex arrays, so we can afford many more than with one glBegin/glEnd per peak
+        Size max_displayed_peaks = 1000000;
+        Size step = 1 + count / max_displayed_peaks;
 
-        for (auto it = begin_it; it != end_it; ++it)
+        std::vector<GLfloat> vertices, colors;
+        vertices.reserve(3 * std::min(count, max_displayed_peaks));
+        colors.reserve(4 * std::min(count, max_displayed_peaks));
+        Size index = 0;
+        for (auto it = begin_it; it != end_it; ++it, ++index)
         {
-          if (step > 1)
+          if (index % step != 0)
           {
-            for (int i = 0; i < step - 1; ++i)
-            {
-              ++it;
-            }
-          }
-          if (it == end_it)
-          {
-            glEndList();
-            return list;
+            continue;
           }
 
           PeakIndex pi = it.getPeakIndex();
           if (layer.filters.passes((*layer.getPeakData())[pi.spectrum], pi.peak))
           {
-            glBegin(GL_POINTS);
-            double intensity = 0;
-            switch (canvas_3d_.intensity_mode_)
-            {
-            case SpectrumCanvas::IM_NONE:
-              qglColor_(layer.gradient.precalculatedColorAt(it->getIntensity()));
-              break;
-
-            case SpectrumCanvas::IM_PERCENTAGE:
-              intensity = it->getIntensity() * 100.0 / canvas_3d_.getMaxIntensity(i);
-              qglColor_(layer.gradient.precalculatedColorAt(intensity));
-              break;
-
-            case SpectrumCanvas::IM_SNAP:
-              qglColor_(layer.gradient.precalculatedColorAt(it->getIntensity()));
-              break;
-
-            case SpectrumCanvas::IM_LOG:
-              qglColor_(layer.gradient.precalculatedColorAt(log10(1 + max(0.0, (double)(it->getIntensity())))));
-              break;
-
-            }
-            glVertex3f(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                       -corner_,
-                       -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-            glEnd();
+            appendVertex_(vertices, colors,
+                          -corner_ + (GLfloat)scaledMZ_(it->getMZ()),
+                          -corner_,
+                          -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()),
+                          layer.gradient.precalculatedColorAt(gradientPosition_(it->getIntensity(), i)));
           }
         }
+        drawVertexArrays_(GL_POINTS, vertices, colors);
       }
     }
     glEndList();
@@ -642,92 +659,35 @@ namespace OpenMS
         auto begin_it = layer.getPeakData()->areaBeginConst(canvas_3d_.visible_area_.min_[1], canvas_3d_.visible_area_.max_[1], canvas_3d_.visible_area_.min_[0], canvas_3d_.visible_area_.max_[0]);
         auto end_it = layer.getPeakData()->areaEndConst();
         // count peaks in area
-        int count = std::distance(begin_it, end_it);
-
-        int max_displayed_peaks = 100000;
-        int step = 1;
-        if (count > max_displayed_peaks)
+        Size count = std::distance(begin_it, end_it);
+
+        // sticks are drawn from vertex arrays, so we can afford many more than with one glBegin/glEnd per peak
+        Size max_displayed_peaks = 500000;
+        Size step = 1 + count / max_displayed_peaks;
+
+        const QColor base_color = layer.gradient.precalculatedColorAt(0.0);
+        std::vector<GLfloat> vertices, colors;
+        vertices.reserve(6 * std::min(count, max_displayed_peaks));
+        colors.reserve(8 * std::min(count, max_displayed_peaks));
+        Size index = 0;
+        for (auto it = begin_it; it != end_it; ++it, ++index)
         {
-          step = 1 + count / max_displayed_peaks;
-        }
-
-        for (auto it = begin_it; it != end_it; ++it)
-        {
-          if (step > 1)
-          {
-            for (int i = 0; i < step - 1; ++i)
-            {
-              ++it;
-            }
-          }
-          if (it == end_it)
+          if (index % step != 0)
           {
-            glEndList();
-            return list;
+            continue;
           }
 
           PeakIndex pi = it.getPeakIndex();
           if (layer.filters.passes((*layer.getPeakData())[pi.spectrum], pi.peak))
           {
-            glBegin(GL_LINES);
-            double intensity = 0;
-            switch (canvas_3d_.intensity_mode_)
-            {
-
-            case SpectrumCanvas::IM_PERCENTAGE:
-
-              intensity = it->getIntensity() * 100.0 / canvas_3d_.getMaxIntensity(i);
-              qglColor_(layer.gradient.precalculatedColorAt(0.0));
-              glVertex3d(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                         -corner_,
-                         -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-              qglColor_(layer.gradient.precalculatedColorAt(intensity));
-              glVertex3d(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                         -corner_ + (GLfloat)scaledIntensity_(it->getIntensity(), i),
-                         -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-              break;
-
-            case SpectrumCanvas::IM_NONE:
-
-              qglColor_(layer.gradient.precalculatedColorAt(0.0));
-              glVertex3d(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                         -corner_,
-                         -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-              qglColor_(layer.gradient.precalculatedColorAt(it->getIntensity()));
-              glVertex3d(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                         -corner_ + (GLfloat)scaledIntensity_(it->getIntensity(), i),
-                         -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-              break;
-
-            case SpectrumCanvas::IM_SNAP:
-
-              qglColor_(layer.gradient.precalculatedColorAt(0.0));
-              glVertex3d(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                         -corner_,
-                         -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-              qglColor_(layer.gradient.precalculatedColorAt(it->getIntensity()));
-              glVertex3d(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                         -corner_ + (GLfloat)scaledIntensity_(it->getIntensity(), i),
-                         -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-
-              break;
-
-            case SpectrumCanvas::IM_LOG:
-
-              qglColor_(layer.gradient.precalculatedColorAt(0.0));
-              glVertex3d(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                         -corner_,
-                         -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-              qglColor_(layer.gradient.precalculatedColorAt(log10(1 + max(0.0, (double)(it->getIntensity())))));
-              glVertex3d(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                         -corner_ + (GLfloat)scaledIntensity_(it->getIntensity(), i),
-                         -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-
-              break;
-            }
-            glEnd();
+            const GLfloat x = -corner_ + (GLfloat)scaledMZ_(it->getMZ());
+            const GLfloat z = -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT());
+            appendVertex_(vertices, colors, x, -corner_, z, base_color);
+            appendVertex_(vertices, colors, x, -corner_ + (GLfloat)scaledIntensity_(it->getIntensity(), i), z,
+                          layer.gradient.precalculatedColorAt(gradientPosition_(it->getIntensity(), i)));
           }
         }
+        drawVertexArrays_(GL_LINES, vertices, colors);
       }
     }
     glEndList();
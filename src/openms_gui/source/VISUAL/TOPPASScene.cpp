@@ -49,6 +49,7 @@
 #include <OpenMS/CONCEPT/VersionInfo.h>
 #include <OpenMS/DATASTRUCTURES/Map.h>
 #include <OpenMS/SYSTEM/File.h>
+#include <OpenMS/SYSTEM/ResourceTracker.h>
 #include <OpenMS/FORMAT/ParamXMLFile.h>
 
 #include <QApplication>
@@ -89,6 +90,11 @@ namespace OpenMS
     dry_run_(true),
     threads_active_(0),
     allowed_threads_(1),
+    memory_active_kb_(0),
+    allowed_memory_kb_(0),
+    running_processes_(),
+    tool_peak_memory_kb_(),
+    cache_dir_(),
     resume_source_(nullptr)
   {
     /*	ATTENTION!
@@ -1667,9 +1673,24 @@ namespace OpenMS
     }
   }
 
-  void TOPPASScene::processFinished()
+  void TOPPASScene::processFinished(QProcess* p)
   {
-    --threads_active_;
+    std::map<const QProcess*, std::pair<int, Size> >::iterator it = running_processes_.find(p);
+    if (it != running_processes_.end())
+    {
+      threads_active_ -= it->second.first;
+      memory_active_kb_ -= it->second.second;
+      running_processes_.erase(it);
+
+      // learn the memory footprint of the tool for scheduling its remaining rounds
+      const QString report = p->property("resource_report").toString();
+      if (!report.isEmpty())
+      {
+        const String tool = p->property("tool_name").toString();
+        Size& peak = tool_peak_memory_kb_[tool];
+        peak = std::max(peak, ResourceTracker::loadPeakMemory(report));
+      }
+    }
     // try to run next in line
     runNextProcess();
   }
@@ -2007,11 +2028,28 @@ namespace OpenMS
 
     used = true;
 
-    while (!topp_processes_queue_.empty() && threads_active_ < allowed_threads_)
+    // use an index, since finishing processes (e.g. a FakeProcess within start()) enqueue new ones
+    int i = 0;
+    while (i < topp_processes_queue_.size() && threads_active_ < allowed_threads_)
     {
-      ++threads_active_; // will be decreased, once the tool finishes
-      TOPPProcess tp = topp_processes_queue_.first();
-      topp_processes_queue_.pop_front();
+      const TOPPProcess& candidate = topp_processes_queue_[i];
+      // a tool which wants more threads than allowed runs on its own
+      const int threads = std::min(std::max(candidate.threads, 1), allowed_threads_);
+      const Size memory_kb = tool_peak_memory_kb_[candidate.tv->getName()];
+      if (!running_processes_.empty() &&
+          (threads_active_ + threads > allowed_threads_ ||
+           (allowed_memory_kb_ > 0 && memory_active_kb_ + memory_kb > allowed_memory_kb_)))
+      {
+        ++i; // does not fit yet, but a later process might
+        continue;
+      }
+
+      // reserve resources before starting, as a FakeProcess finishes immediately
+      threads_active_ += threads;
+      memory_active_kb_ += memory_kb;
+      running_processes_[candidate.proc] = std::make_pair(threads, memory_kb);
+      TOPPProcess tp = topp_processes_queue_.takeAt(i);
+      tp.proc->setProperty("tool_name", tp.tv->getName().toQString());
       FakeProcess* p = qobject_cast<FakeProcess*>(tp.proc);
       if (p)
       {
@@ -2352,6 +2390,21 @@ namespace OpenMS
     allowed_threads_ = num_jobs;
   }
 
+  void TOPPASScene::setAllowedMemory(Size memory_mb)
+  {
+    allowed_memory_kb_ = memory_mb * 1024;
+  }
+
+  void TOPPASScene::setCacheDirectory(const QString& cache_dir)
+  {
+    cache_dir_ = cache_dir;
+  }
+
+  const QString& TOPPASScene::getCacheDirectory() const
+  {
+    return cache_dir_;
+  }
+
   bool TOPPASScene::isGUIMode() const
   {
     return gui_;
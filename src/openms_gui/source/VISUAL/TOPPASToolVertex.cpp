@@ -36,6 +36,7 @@
 
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/CONCEPT/RAIICleanup.h>
+#include <OpenMS/CONCEPT/VersionInfo.h>
 #include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/FORMAT/ParamXMLFile.h>
 #include <OpenMS/SYSTEM/File.h>
@@ -47,6 +48,7 @@
 
 #include <QtWidgets/QGraphicsScene>
 #include <QtWidgets/QMessageBox>
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QDir>
@@ -54,6 +56,8 @@
 
 #include <QSvgRenderer>
 
+#include <sstream>
+
 namespace OpenMS
 {
   struct NameComponent
@@ -618,9 +622,36 @@ namespace OpenMS
       writeParam_(param_tmp, ini_file_iteration);
       args << "-ini" << ini_file_iteration;
 
+      // let TOPPBase tools report their memory footprint (used for scheduling the remaining rounds)
+      QString resource_report;
+      if (param_tmp.exists("resource_report"))
+      {
+        resource_report = QDir::toNativeSeparators(ini_file + QString::number(round) + ".resources.json");
+        args << "-resource_report" << resource_report;
+      }
+
+      // result cache: a round whose tool version, parameters and input contents are unchanged reuses the outputs of an earlier run
+      QStringList round_outputs;
+      for (RoundPackageConstIt it = output_files_[round].begin(); it != output_files_[round].end(); ++it)
+      {
+        round_outputs << it->second.filenames.get();
+      }
+      QString cache_entry;
+      bool from_cache = false;
+      if (!ts->isDryRun() && !ts->getCacheDirectory().isEmpty())
+      {
+        cache_entry = QDir(ts->getCacheDirectory()).filePath(computeCacheKey_(pkg[round], output_files_[round], in_params, out_params).toQString());
+        from_cache = restoreFromCache_(cache_entry, round_outputs);
+        if (from_cache)
+        {
+          ts->logTOPPOutput((String("\nReusing cached results of '") + name_ + "' (round " + (round + 1) + "/" + round_total_ + ") from '" + String(cache_entry) + "'\n").toQString());
+          cache_entry.clear(); // nothing to store afterwards
+        }
+      }
+
       // create process
       QProcess* p;
-      if (!ts->isDryRun())
+      if (!ts->isDryRun() && !from_cache)
       {
         p = new QProcess();
       }
@@ -629,6 +660,9 @@ namespace OpenMS
         p = new FakeProcess();
       }
 
+      p->setProperty("resource_report", resource_report);
+      p->setProperty("cache_entry", cache_entry);
+      p->setProperty("cache_outputs", round_outputs);
       p->setProcessChannelMode(QProcess::MergedChannels);
       connect(p, SIGNAL(readyReadStandardOutput()), this, SLOT(forwardTOPPOutput()));
       connect(ts, SIGNAL(terminateCurrentPipeline()), p, SLOT(kill()));
@@ -648,7 +682,8 @@ namespace OpenMS
         }
       }
       toolScheduledSlot();
-      ts->enqueueProcess(TOPPASScene::TOPPProcess(p, File::findSiblingTOPPExecutable(name_).toQString(), args, this));
+      const int threads = param_tmp.exists("threads") ? (int)param_tmp.getValue("threads") : 1;
+      ts->enqueueProcess(TOPPASScene::TOPPProcess(p, File::findSiblingTOPPExecutable(name_).toQString(), args, this, threads));
     }
 
     // run pending processes
@@ -671,12 +706,11 @@ namespace OpenMS
 
     RAIICleanup clean([&]() {
       // clean up at end
+      ts->processFinished(p);
       if (p)
       {
         delete p;
       }
-
-      ts->processFinished();
     });
 
     //** ERROR handling
@@ -691,6 +725,10 @@ namespace OpenMS
     else
     {
       //** no error ... proceed
+      if (p)
+      {
+        storeInCache_(p->property("cache_entry").toString(), p->property("cache_outputs").toStringList());
+      }
       ++round_counter_;
       //std::cout << (String("Increased iteration_nr_ to ") + round_counter_ + " / " + round_total_ ) << " for " << this->name_ << std::endl;
 
@@ -1243,6 +1281,107 @@ namespace OpenMS
     paramFile.store(ini_file, save_param);
   }
 
+  String TOPPASToolVertex::computeCacheKey_(const RoundPackage& inputs, const RoundPackage& outputs, const QVector<IOInfo>& in_params, const QVector<IOInfo>& out_params) const
+  {
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    auto add = [&hash](const String& s)
+    {
+      hash.addData(s.c_str(), (int)s.size());
+      hash.addData("\n", 1);
+    };
+
+    add(name_);
+    add(type_);
+    add(VersionInfo::getVersion());
+    add(VersionInfo::getRevision());
+
+    // file parameters contain run-specific (temporary) paths and are covered by the file contents below;
+    // the number of threads does not change the results
+    Param param = param_;
+    for (const IOInfo& io : in_params) param.remove(io.param_name);
+    for (const IOInfo& io : out_params) param.remove(io.param_name);
+    param.remove("threads");
+    std::stringstream param_xml;
+    ParamXMLFile().writeXMLToStream(&param_xml, param);
+    add(param_xml.str());
+
+    for (RoundPackageConstIt it = inputs.begin(); it != inputs.end(); ++it)
+    {
+      add(in_params[it->second.edge->getTargetInParam()].param_name);
+      for (const QString& file : it->second.filenames.get())
+      {
+        add(FileHandler::computeFileHash(file));
+      }
+    }
+
+    // the number and format of the output files (e.g. featureXML vs. consensusXML) is part of the key as well
+    for (RoundPackageConstIt it = outputs.begin(); it != outputs.end(); ++it)
+    {
+      add(out_params[it->first].param_name);
+      for (const QString& file : it->second.filenames.get())
+      {
+        add(String(QFileInfo(file).suffix()));
+      }
+    }
+
+    return String(QString(hash.result().toHex()));
+  }
+
+  bool TOPPASToolVertex::restoreFromCache_(const QString& cache_entry, const QStringList& outputs) const
+  {
+    QDir dir(cache_entry);
+    if (outputs.isEmpty() || !dir.exists("complete"))
+    {
+      return false;
+    }
+    for (int i = 0; i < outputs.size(); ++i)
+    {
+      if (!QFileInfo(dir.filePath(QString::number(i))).isFile())
+      {
+        return false;
+      }
+    }
+    for (int i = 0; i < outputs.size(); ++i)
+    {
+      QDir().mkpath(QFileInfo(outputs[i]).absolutePath());
+      QFile::remove(outputs[i]);
+      if (!QFile::copy(dir.filePath(QString::number(i)), outputs[i]))
+      {
+        OPENMS_LOG_WARN << "TOPPAS: could not restore '" << String(outputs[i]) << "' from the result cache. Running the tool instead." << std::endl;
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void TOPPASToolVertex::storeInCache_(const QString& cache_entry, const QStringList& outputs) const
+  {
+    if (cache_entry.isEmpty() || outputs.isEmpty())
+    {
+      return;
+    }
+    QDir dir(cache_entry);
+    if (!dir.mkpath("."))
+    {
+      OPENMS_LOG_WARN << "TOPPAS: could not create result cache entry '" << String(cache_entry) << "'." << std::endl;
+      return;
+    }
+    for (int i = 0; i < outputs.size(); ++i)
+    {
+      const QString target = dir.filePath(QString::number(i));
+      QFile::remove(target);
+      if (!QFileInfo(outputs[i]).isFile() || !QFile::copy(outputs[i], target))
+      {
+        // incomplete entries are never used
+        dir.removeRecursively();
+        return;
+      }
+    }
+    // written last, so an interrupted copy never results in a cache hit
+    QFile marker(dir.filePath("complete"));
+    marker.open(QIODevice::WriteOnly);
+  }
+
   void TOPPASToolVertex::toggleBreakpoint()
   {
     breakpoint_set_ = !breakpoint_set_;
@@ -20,6 +20,7 @@ InputFileList.cpp
 InputFileList.ui
 LayerData.cpp
 ListEditor.cpp
+MaxIntensityPyramid.cpp
 MetaDataBrowser.cpp
 MultiGradient.cpp
 MultiGradientSelector.cpp
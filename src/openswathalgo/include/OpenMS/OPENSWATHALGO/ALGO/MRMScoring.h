@@ -261,6 +261,22 @@ public:
 
 private:
 
+    /// copy of @p data with every trace standardized (mean 0, standard deviation 1)
+    static void standardizedData_(const std::vector< std::vector< double > >& data, std::vector< std::vector< double > >& normalized);
+
+    /// standardized intensities of the (precursor) features @p ids of @p mrmfeature, one entry per id
+    static void standardizedIntensities_(OpenSwath::IMRMFeature* mrmfeature, const std::vector<String>& ids, bool precursor,
+                                         std::vector< std::vector< double > >& intensities);
+
+    /**
+      @brief Fills @p matrix with the cross-correlations of standardized traces
+
+      Each trace is expected to be standardized already, so normalization is done once per trace
+      instead of once per pair. If @p upper_triangle is set, only entries with j >= i are computed.
+    */
+    static void fillXCorrMatrix_(const std::vector< std::vector< double > >& rows, const std::vector< std::vector< double > >& cols,
+                                 bool upper_triangle, XCorrMatrixType& matrix);
+
     /** @name Members */
     //@{
     /// the precomputed cross correlation matrix
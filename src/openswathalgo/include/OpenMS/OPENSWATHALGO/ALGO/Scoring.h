@@ -119,6 +119,11 @@ public:
     OPENSWATHALGO_DLLAPI XCorrArrayType normalizedCrossCorrelation(std::vector<double>& data1,
                                                                    std::vector<double>& data2, const int& maxdelay, const int& lag);
 
+    /// Calculate crosscorrelation on std::vector data that is already standardized (see standardize_data),
+    /// result is identical to normalizedCrossCorrelation() on the raw data
+    OPENSWATHALGO_DLLAPI XCorrArrayType normalizedCrossCorrelationPost(const std::vector<double>& normalized_data1,
+                                                                       const std::vector<double>& normalized_data2, const int& maxdelay, const int& lag);
+
     /// Calculate crosscorrelation on std::vector data without normalization
     OPENSWATHALGO_DLLAPI XCorrArrayType calculateCrossCorrelation(const std::vector<double>& data1,
                                                                   const std::vector<double>& data2, const int& maxdelay, const int& lag);
@@ -51,18 +51,9 @@ namespace OpenSwath
 
   void MRMScoring::initializeXCorrMatrix(const std::vector< std::vector< double > >& data)
   {
-    xcorr_matrix_.resize(data.size());
-    for (std::size_t i = 0; i < data.size(); i++)
-    {
-      xcorr_matrix_[i].resize(data.size());
-      for (std::size_t j = i; j < data.size(); j++)
-      {
-        // compute normalized cross correlation
-        std::vector< double > tmp1(data[i]);
-        std::vector< double > tmp2(data[j]);
-        xcorr_matrix_[i][j] = Scoring::normalizedCrossCorrelation(tmp1, tmp2, boost::numeric_cast<int>(data[i].size()), 1);
-      }
-    }
+    std::vector< std::vector< double > > normalized;
+    standardizedData_(data, normalized);
+    fillXCorrMatrix_(normalized, normalized, true, xcorr_matrix_);
   }
 
   const MRMScoring::XCorrMatrixType& MRMScoring::getXCorrContrastMatrix() const
@@ -82,147 +73,94 @@ namespace OpenSwath
 
   void MRMScoring::initializeXCorrMatrix(OpenSwath::IMRMFeature* mrmfeature, const std::vector<String>& native_ids)
   {
-    std::vector<double> intensityi, intensityj;
-    xcorr_matrix_.resize(native_ids.size());
-    for (std::size_t i = 0; i < native_ids.size(); i++)
-    {
-      String native_id = native_ids[i];
-      FeatureType fi = mrmfeature->getFeature(native_id);
-      xcorr_matrix_[i].resize(native_ids.size());
-      intensityi.clear();
-      fi->getIntensity(intensityi);
-      for (std::size_t j = i; j < native_ids.size(); j++)
-      {
-        String native_id2 = native_ids[j];
-        FeatureType fj = mrmfeature->getFeature(native_id2);
-        intensityj.clear();
-        fj->getIntensity(intensityj);
-        // compute normalized cross correlation
-        xcorr_matrix_[i][j] = Scoring::normalizedCrossCorrelation(intensityi, intensityj, boost::numeric_cast<int>(intensityi.size()), 1);
-      }
-    }
+    std::vector< std::vector< double > > intensities;
+    standardizedIntensities_(mrmfeature, native_ids, false, intensities);
+    fillXCorrMatrix_(intensities, intensities, true, xcorr_matrix_);
   }
 
   void MRMScoring::initializeXCorrContrastMatrix(OpenSwath::IMRMFeature* mrmfeature, const std::vector<String>& native_ids_set1, const std::vector<String>& native_ids_set2)
   {
-    std::vector<double> intensityi, intensityj;
-    xcorr_contrast_matrix_.resize(native_ids_set1.size());
-    for (std::size_t i = 0; i < native_ids_set1.size(); i++)
-    { 
-      String native_id = native_ids_set1[i];
-      FeatureType fi = mrmfeature->getFeature(native_id);
-      xcorr_contrast_matrix_[i].resize(native_ids_set2.size());
-      intensityi.clear();
-      fi->getIntensity(intensityi);
-      for (std::size_t j = 0; j < native_ids_set2.size(); j++)
-      {
-        String native_id2 = native_ids_set2[j];
-        FeatureType fj = mrmfeature->getFeature(native_id2);
-        intensityj.clear();
-        fj->getIntensity(intensityj);
-        // compute normalized cross correlation
-        xcorr_contrast_matrix_[i][j] = Scoring::normalizedCrossCorrelation(intensityi, intensityj, boost::numeric_cast<int>(intensityi.size()), 1);
-      }
-    }
+    std::vector< std::vector< double > > intensities1, intensities2;
+    standardizedIntensities_(mrmfeature, native_ids_set1, false, intensities1);
+    standardizedIntensities_(mrmfeature, native_ids_set2, false, intensities2);
+    fillXCorrMatrix_(intensities1, intensities2, false, xcorr_contrast_matrix_);
   }
 
   void MRMScoring::initializeXCorrPrecursorMatrix(OpenSwath::IMRMFeature* mrmfeature, const std::vector<String>& precursor_ids)
   {
-    std::vector<double> intensityi, intensityj;
-    xcorr_precursor_matrix_.resize(precursor_ids.size());
-    for (std::size_t i = 0; i < precursor_ids.size(); i++)
-    {
-      String precursor_id = precursor_ids[i];
-      FeatureType fi = mrmfeature->getPrecursorFeature(precursor_id);
-      xcorr_precursor_matrix_[i].resize(precursor_ids.size());
-      intensityi.clear();
-      fi->getIntensity(intensityi);
-      for (std::size_t j = i; j < precursor_ids.size(); j++)
-      {
-        String precursor_id2 = precursor_ids[j];
-        FeatureType fj = mrmfeature->getPrecursorFeature(precursor_id2);
-        intensityj.clear();
-        fj->getIntensity(intensityj);
-        // compute normalized cross correlation
-        xcorr_precursor_matrix_[i][j] = Scoring::normalizedCrossCorrelation(intensityi, intensityj, boost::numeric_cast<int>(intensityi.size()), 1);
-      }
-    }
+    std::vector< std::vector< double > > intensities;
+    standardizedIntensities_(mrmfeature, precursor_ids, true, intensities);
+    fillXCorrMatrix_(intensities, intensities, true, xcorr_precursor_matrix_);
   }
 
   void MRMScoring::initializeXCorrPrecursorContrastMatrix(OpenSwath::IMRMFeature* mrmfeature, const std::vector<String>& precursor_ids, const std::vector<String>& native_ids)
   {
-    std::vector<double> intensityi, intensityj;
-    xcorr_precursor_contrast_matrix_.resize(precursor_ids.size());
-    for (std::size_t i = 0; i < precursor_ids.size(); i++)
-    { 
-      String precursor_id = precursor_ids[i];
-      FeatureType fi = mrmfeature->getPrecursorFeature(precursor_id);
-      xcorr_precursor_contrast_matrix_[i].resize(native_ids.size());
-      intensityi.clear();
-      fi->getIntensity(intensityi);
-      for (std::size_t j = 0; j < native_ids.size(); j++)
-      {
-        String native_id = native_ids[j];
-        FeatureType fj = mrmfeature->getFeature(native_id);
-        intensityj.clear();
-        fj->getIntensity(intensityj);
-        // compute normalized cross correlation
-        xcorr_precursor_contrast_matrix_[i][j] = Scoring::normalizedCrossCorrelation(intensityi, intensityj, boost::numeric_cast<int>(intensityi.size()), 1);
-      }
-    }
+    std::vector< std::vector< double > > precursor_intensities, fragment_intensities;
+    standardizedIntensities_(mrmfeature, precursor_ids, true, precursor_intensities);
+    standardizedIntensities_(mrmfeature, native_ids, false, fragment_intensities);
+    fillXCorrMatrix_(precursor_intensities, fragment_intensities, false, xcorr_precursor_contrast_matrix_);
   }
 
   void MRMScoring::initializeXCorrPrecursorContrastMatrix(const std::vector< std::vector< double > >& data_precursor, const std::vector< std::vector< double > >& data_fragments)
   {
-    xcorr_precursor_contrast_matrix_.resize(data_precursor.size());
-    for (std::size_t i = 0; i < data_precursor.size(); i++)
-    { 
-      xcorr_precursor_contrast_matrix_[i].resize(data_fragments.size());
-      for (std::size_t j = 0; j < data_fragments.size(); j++)
-      {
-        // compute normalized cross correlation
-        std::vector< double > tmp1(data_precursor[i]);
-        std::vector< double > tmp2(data_fragments[j]);
-        xcorr_precursor_contrast_matrix_[i][j] = Scoring::normalizedCrossCorrelation(tmp1, tmp2, boost::numeric_cast<int>(tmp1.size()), 1);
+    std::vector< std::vector< double > > normalized_precursor, normalized_fragments;
+    standardizedData_(data_precursor, normalized_precursor);
+    standardizedData_(data_fragments, normalized_fragments);
+    fillXCorrMatrix_(normalized_precursor, normalized_fragments, false, xcorr_precursor_contrast_matrix_);
 #ifdef MRMSCORING_TESTING
-        std::cout << " fill xcorr_precursor_contrast_matrix_ "<< tmp1.size() << " / " << tmp2.size() << " : " << xcorr_precursor_contrast_matrix_[i][j].data.size() << std::endl;
-#endif
+    for (std::size_t i = 0; i < xcorr_precursor_contrast_matrix_.size(); i++)
+    {
+      for (std::size_t j = 0; j < xcorr_precursor_contrast_matrix_[i].size(); j++)
+      {
+        std::cout << " fill xcorr_precursor_contrast_matrix_ "<< data_precursor[i].size() << " / " << data_fragments[j].size() << " : " << xcorr_precursor_contrast_matrix_[i][j].data.size() << std::endl;
       }
     }
+#endif
   }
 
   void MRMScoring::initializeXCorrPrecursorCombinedMatrix(OpenSwath::IMRMFeature* mrmfeature, const std::vector<String>& precursor_ids, const std::vector<String>& native_ids)
   {
-    std::vector<double> intensityi, intensityj;
-    std::vector<FeatureType> features;
+    // precursor traces first, then fragment traces
+    std::vector< std::vector< double > > intensities, fragment_intensities;
+    standardizedIntensities_(mrmfeature, precursor_ids, true, intensities);
+    standardizedIntensities_(mrmfeature, native_ids, false, fragment_intensities);
+    intensities.insert(intensities.end(), fragment_intensities.begin(), fragment_intensities.end());
+    fillXCorrMatrix_(intensities, intensities, false, xcorr_precursor_combined_matrix_);
+  }
 
-    for (std::size_t i = 0; i < precursor_ids.size(); i++)
-    { 
-      String precursor_id = precursor_ids[i];
-      FeatureType fi = mrmfeature->getPrecursorFeature(precursor_id);
-      features.push_back(fi);
+  void MRMScoring::standardizedData_(const std::vector< std::vector< double > >& data, std::vector< std::vector< double > >& normalized)
+  {
+    normalized = data;
+    for (std::size_t i = 0; i < normalized.size(); i++)
+    {
+      Scoring::standardize_data(normalized[i]);
     }
-    for (std::size_t j = 0; j < native_ids.size(); j++)
+  }
+
+  void MRMScoring::standardizedIntensities_(OpenSwath::IMRMFeature* mrmfeature, const std::vector<String>& ids, bool precursor,
+                                            std::vector< std::vector< double > >& intensities)
+  {
+    intensities.resize(ids.size());
+    for (std::size_t i = 0; i < ids.size(); i++)
     {
-      String native_id = native_ids[j];
-      FeatureType fj = mrmfeature->getFeature(native_id);
-      features.push_back(fj);
+      FeatureType f = precursor ? mrmfeature->getPrecursorFeature(ids[i]) : mrmfeature->getFeature(ids[i]);
+      intensities[i].clear();
+      f->getIntensity(intensities[i]);
+      Scoring::standardize_data(intensities[i]);
     }
+  }
 
-    xcorr_precursor_combined_matrix_.resize(features.size());
-    for (std::size_t i = 0; i < features.size(); i++)
-    { 
-      FeatureType fi = features[i];
-      xcorr_precursor_combined_matrix_[i].resize(features.size());
-      intensityi.clear();
-      fi->getIntensity(intensityi);
-      for (std::size_t j = 0; j < features.size(); j++)
+  void MRMScoring::fillXCorrMatrix_(const std::vector< std::vector< double > >& rows, const std::vector< std::vector< double > >& cols,
+                                    bool upper_triangle, XCorrMatrixType& matrix)
+  {
+    matrix.resize(rows.size());
+    for (std::size_t i = 0; i < rows.size(); i++)
+    {
+      matrix[i].resize(cols.size());
+      for (std::size_t j = (upper_triangle ? i : 0); j < cols.size(); j++)
       {
-        FeatureType fj = features[j];
-        intensityj.clear();
-        fj->getIntensity(intensityj);
         // compute normalized cross correlation
-        xcorr_precursor_combined_matrix_[i][j] = Scoring::normalizedCrossCorrelation(intensityi, intensityj, boost::numeric_cast<int>(intensityi.size()), 1);
+        matrix[i][j] = Scoring::normalizedCrossCorrelationPost(rows[i], cols[j], boost::numeric_cast<int>(rows[i].size()), 1);
       }
     }
   }
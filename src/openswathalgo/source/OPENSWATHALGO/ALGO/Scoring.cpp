@@ -156,10 +156,16 @@ namespace OpenSwath
       // normalize the data
       standardize_data(data1);
       standardize_data(data2);
-      XCorrArrayType result = calculateCrossCorrelation(data1, data2, maxdelay, lag);
+      return normalizedCrossCorrelationPost(data1, data2, maxdelay, lag);
+    }
+
+    XCorrArrayType normalizedCrossCorrelationPost(const std::vector<double>& normalized_data1,
+                                                  const std::vector<double>& normalized_data2, const int& maxdelay, const int& lag)
+    {
+      XCorrArrayType result = calculateCrossCorrelation(normalized_data1, normalized_data2, maxdelay, lag);
       for (XCorrArrayType::iterator it = result.begin(); it != result.end(); ++it)
       {
-        it->second = it->second / data1.size();
+        it->second = it->second / normalized_data1.size();
       }
       return result;
     }
@@ -172,19 +178,19 @@ namespace OpenSwath
       XCorrArrayType result;
       result.data.reserve( (size_t)std::ceil((2*maxdelay + 1) / lag));
       int datasize = boost::numeric_cast<int>(data1.size());
-      int i, j, delay;
+      const double* d1 = data1.data();
+      const double* d2 = data2.data();
 
-      for (delay = -maxdelay; delay <= maxdelay; delay = delay + lag)
+      for (int delay = -maxdelay; delay <= maxdelay; delay = delay + lag)
       {
+        // only indices i with 0 <= i + delay < datasize overlap; compute the range directly
+        // instead of testing every index (same summation order as before)
+        const int i_begin = std::max(0, -delay);
+        const int i_end = std::min(datasize, datasize - delay);
         double sxy = 0;
-        for (i = 0; i < datasize; ++i)
+        for (int i = i_begin; i < i_end; ++i)
         {
-          j = i + delay;
-          if (j < 0 || j >= datasize)
-          {
-            continue;
-          }
-          sxy += (data1[i]) * (data2[j]);
+          sxy += d1[i] * d2[i + delay];
         }
         result.data.push_back(std::make_pair(delay, sxy));
       }
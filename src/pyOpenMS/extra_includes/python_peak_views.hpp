@@ -0,0 +1,145 @@
+#ifndef __PYTHON_PEAK_VIEWS_HPP__
+#define __PYTHON_PEAK_VIEWS_HPP__
+
+#include <Python.h>
+#include <numpy/arrayobject.h>
+
+#include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/KERNEL/MSSpectrum.h>
+#include <OpenMS/KERNEL/MSSpectrumSoA.h>
+
+#include <cstddef>
+#include <cstring>
+
+// Zero-copy NumPy access to peak data (see ../addons/MSSpectrum.pyx and ../addons/MSExperiment.pyx).
+//
+// The views returned here point directly into the C++ containers and keep the Python wrapper object
+// given as 'owner' alive. They become invalid when the number of peaks of the underlying spectrum
+// changes (e.g. push_back, resize, clear) -- exactly like iterators in C++.
+// Needs numpy.import_array() in the Cython module that includes this header.
+class PythonPeakViews
+{
+    typedef OpenMS::MSSpectrum::PeakType PeakType;
+
+    /// creates a 1D array of @p size elements of @p type_num at @p data with the given @p stride (in bytes)
+    static PyObject* makeView_(void* data, npy_intp size, npy_intp stride, int type_num, PyObject* owner, bool writeable)
+    {
+        npy_intp dims[1] = { size };
+        npy_intp strides[1] = { stride };
+        int flags = writeable ? NPY_ARRAY_WRITEABLE : 0;
+        if (size == 0) data = nullptr; // numpy allocates a dummy buffer
+        PyObject* array = PyArray_New(&PyArray_Type, 1, dims, type_num, size == 0 ? nullptr : strides,
+                                      data, 0, flags | NPY_ARRAY_ALIGNED, nullptr);
+        if (array == nullptr || data == nullptr) return array;
+        Py_INCREF(owner);
+        if (PyArray_SetBaseObject((PyArrayObject*)array, owner) < 0)
+        {
+            Py_DECREF(array); // also releases 'owner'
+            return nullptr;
+        }
+        return array;
+    }
+
+    /// creates a new (owning) 1D array of @p size elements of @p type_num
+    static PyObject* makeArray_(npy_intp size, int type_num)
+    {
+        npy_intp dims[1] = { size };
+        return PyArray_SimpleNew(1, dims, type_num);
+    }
+
+    static PeakType* peaks_(OpenMS::MSSpectrum& spec)
+    {
+        return spec.empty() ? nullptr : &spec[0];
+    }
+
+  public:
+
+    /// strided float64 view onto the m/z values of the peaks of @p spec (no copy)
+    static PyObject* mzView(OpenMS::MSSpectrum& spec, PyObject* owner, bool writeable)
+    {
+        PeakType* peaks = peaks_(spec);
+        void* data = peaks ? &peaks[0].getPosition()[0] : nullptr;
+        return makeView_(data, spec.size(), sizeof(PeakType), NPY_DOUBLE, owner, writeable);
+    }
+
+    /// strided float32 view onto the intensities of the peaks of @p spec (no copy)
+    static PyObject* intensityView(OpenMS::MSSpectrum& spec, PyObject* owner, bool writeable)
+    {
+        // Peak1D has no accessor returning a reference to its intensity; it directly follows the position
+        static_assert(sizeof(PeakType) >= sizeof(PeakType::PositionType) + sizeof(PeakType::IntensityType), "unexpected Peak1D layout");
+        PeakType* peaks = peaks_(spec);
+        void* data = peaks ? reinterpret_cast<char*>(&peaks[0].getPosition()) + sizeof(PeakType::PositionType) : nullptr;
+        return makeView_(data, spec.size(), sizeof(PeakType), NPY_FLOAT, owner, writeable);
+    }
+
+    /// contiguous float64 view onto the m/z array of @p soa (no copy)
+    static PyObject* mzView(OpenMS::MSSpectrumSoA& soa, PyObject* owner, bool writeable)
+    {
+        return makeView_(soa.mz().data(), soa.size(), sizeof(double), NPY_DOUBLE, owner, writeable);
+    }
+
+    /// contiguous float32 view onto the intensity array of @p soa (no copy)
+    static PyObject* intensityView(OpenMS::MSSpectrumSoA& soa, PyObject* owner, bool writeable)
+    {
+        return makeView_(soa.intensity().data(), soa.size(), sizeof(float), NPY_FLOAT, owner, writeable);
+    }
+
+    /// replaces the peaks of @p spec by @p size values of the arrays @p mz and @p intensity in a single pass
+    static void setPeaks(OpenMS::MSSpectrum& spec, const double* mz, const float* intensity, std::size_t size)
+    {
+        spec.resize(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            spec[i].setMZ(mz[i]);
+            spec[i].setIntensity(intensity[i]);
+        }
+    }
+
+    /**
+      @brief m/z, intensity and offset arrays of all spectra of @p exp as a tuple of new NumPy arrays
+
+      The peaks of spectrum i are at [offsets[i], offsets[i + 1]) (see MSExperiment::getPeakArrays()).
+      The values are copied once, directly into the NumPy buffers.
+    */
+    static PyObject* experimentPeakArrays(const OpenMS::MSExperiment& exp)
+    {
+        const std::size_t n_spectra = exp.size();
+        PyObject* offsets = makeArray_(n_spectra + 1, NPY_UINT64);
+        if (offsets == nullptr) return nullptr;
+        npy_uint64* off = (npy_uint64*)PyArray_DATA((PyArrayObject*)offsets);
+        off[0] = 0;
+        for (std::size_t i = 0; i < n_spectra; ++i)
+        {
+            off[i + 1] = off[i] + exp[i].size();
+        }
+
+        PyObject* mz = makeArray_(off[n_spectra], NPY_DOUBLE);
+        PyObject* intensity = makeArray_(off[n_spectra], NPY_FLOAT);
+        if (mz == nullptr || intensity == nullptr)
+        {
+            Py_XDECREF(mz);
+            Py_XDECREF(intensity);
+            Py_DECREF(offsets);
+            return nullptr;
+        }
+        double* mz_data = (double*)PyArray_DATA((PyArrayObject*)mz);
+        float* int_data = (float*)PyArray_DATA((PyArrayObject*)intensity);
+
+        Py_BEGIN_ALLOW_THREADS
+        for (std::size_t i = 0; i < n_spectra; ++i)
+        {
+            std::size_t pos = off[i];
+            for (const PeakType& p : exp[i])
+            {
+                mz_data[pos] = p.getMZ();
+                int_data[pos] = p.getIntensity();
+                ++pos;
+            }
+        }
+        Py_END_ALLOW_THREADS
+
+        return Py_BuildValue("(NNN)", mz, intensity, offsets);
+    }
+};
+
+#endif
@@ -62,6 +62,7 @@ namespace OpenMS
 {
 
   class CentroidData;
+  class CentroidPeak;
   class LCMSCData;
 
   class SUPERHIRN_DLLAPI ProcessData
@@ -147,6 +148,11 @@ public:
     ///////////////////////////////////////////////////////////////////////////////
     // inputs raw /centroided  data into the object:
     void add_scan_raw_data(int, double, CentroidData *);
+    // deisotopes the centroided data of a scan (does not change the object,
+    // so several scans can be processed in parallel):
+    void deisotope_scan_raw_data(int, double, CentroidData *, std::vector<MSPeak> &);
+    // inputs the centroided peaks and the deisotoped MS peaks of a scan into the object:
+    void add_scan_raw_data(double, std::list<CentroidPeak> &, std::vector<MSPeak> &);
     // inputs raw data into the object:
     void add_scan_raw_data(std::vector<MSPeak>);
 
@@ -44,6 +44,7 @@
 
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/SUPERHIRN/FTPeakDetectController.h>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <map>
@@ -55,6 +56,7 @@
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/SUPERHIRN/MSPeak.h>
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/SUPERHIRN/CentroidPeak.h>
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/SUPERHIRN/CentroidData.h>
+#include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/SUPERHIRN/IsotopicDist.h>
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/SUPERHIRN/SuperHirnParameters.h>
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/SUPERHIRN/LCElutionPeak.h>
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/SUPERHIRN/BackgroundIntensityBin.h>
@@ -117,25 +119,56 @@ namespace OpenMS
     lcms_->set_spectrum_ID((int) this->lcmsRuns_.size());
 
     ProcessData * dataProcessor = new ProcessData();
-    unsigned int i;
+    dataProcessor->setMaxScanDistance(0);
 
-    for (i = 0; i < datavec.size(); i++)
+    // select the scans within the retention time window:
+    vector<size_t> scans;
+    for (size_t i = 0; i < datavec.size(); i++)
     {
-      Map it = datavec.at(i);
-
-      dataProcessor->setMaxScanDistance(0);
+      const Map & it = datavec[i];
       if ((it.first >= SuperHirnParameters::instance()->getMinTR()) &&
           (it.first <= SuperHirnParameters::instance()->getMaxTR()))
       {
-        SuperHirnParameters::instance()->getScanTRIndex()->insert(std::pair<int, float>(i, (float) it.first));
+        SuperHirnParameters::instance()->getScanTRIndex()->insert(std::pair<int, float>((int) i, (float) it.first));
+        scans.push_back(i);
+      }
+    }
+
+    // the isotope distribution tables are initialised lazily, do it before the threads use them
+    IsotopicDist::init();
+
+    // Centroiding and deisotoping are independent for every scan and run in parallel.
+    // Adding the peaks to the background and the elution profiles depends on the previous
+    // scans and is done in scan order afterwards. Scans are processed in blocks to bound
+    // the memory for the intermediate peak lists.
+    const size_t block_size = 512;
+    vector<list<CentroidPeak> > centroid_peaks;
+    vector<vector<MSPeak> > ms_peaks;
+    for (size_t block_start = 0; block_start < scans.size(); block_start += block_size)
+    {
+      const size_t block_end = std::min(block_start + block_size, scans.size());
+      centroid_peaks.assign(block_end - block_start, list<CentroidPeak>());
+      ms_peaks.assign(block_end - block_start, vector<MSPeak>());
+
+#pragma omp parallel for schedule(dynamic, 1)
+      for (int k = (int) block_start; k < (int) block_end; ++k)
+      {
+        const size_t i = scans[k];
+        const Map & it = datavec[i];
 
         // centroid it:
         CentroidData cd(SuperHirnParameters::instance()->getCentroidWindowWidth(), it.second, it.first,
                         SuperHirnParameters::instance()->centroidDataModus());
 
-        //  store it:
-        dataProcessor->add_scan_raw_data(i, it.first, &cd);
+        // the background needs the peaks before the isotopic patterns are subtracted:
+        cd.get(centroid_peaks[k - block_start]);
+        dataProcessor->deisotope_scan_raw_data((int) i, it.first, &cd, ms_peaks[k - block_start]);
+      }
 
+      //  store it:
+      for (size_t k = block_start; k < block_end; ++k)
+      {
+        dataProcessor->add_scan_raw_data(datavec[scans[k]].first, centroid_peaks[k - block_start], ms_peaks[k - block_start]);
       }
     }
 
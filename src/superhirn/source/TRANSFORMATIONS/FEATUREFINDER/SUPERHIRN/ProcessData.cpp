@@ -308,27 +308,46 @@ namespace OpenMS
   void ProcessData::add_scan_raw_data(int SCAN, double TR, CentroidData * centroidedData)
   {
 
-    Deisotoper dei;
-
-    //////////////////////////////////
-    // add the peaks to the background controller:
+    // copy the peaks for the background controller before the deisotoping
+    // subtracts the isotopic patterns from them:
     list<CentroidPeak> pCentroidPeaks;
     centroidedData->get(pCentroidPeaks);
-    backgroundController->addPeakMSScan(TR, &pCentroidPeaks);
 
+    vector<MSPeak> PEAK_LIST;
+    deisotope_scan_raw_data(SCAN, TR, centroidedData, PEAK_LIST);
+
+    add_scan_raw_data(TR, pCentroidPeaks, PEAK_LIST);
+
+  }
+
+///////////////////////////////////////////////////////////////////////////////
+// deisotopes the centroided data of a scan and converts it to MS peaks.
+// Does not change the object, i.e. several scans can be processed in parallel
+  void ProcessData::deisotope_scan_raw_data(int SCAN, double TR, CentroidData * centroidedData, vector<MSPeak> & PEAK_LIST)
+  {
+
+    Deisotoper dei;
     dei.go(*centroidedData);
     dei.cleanDeconvPeaks();
 
     // convert to objects used for mass clustering over retention time
-    vector<MSPeak> PEAK_LIST;
     convert_ms_peaks(SCAN, TR, dei.getDeconvPeaks(), PEAK_LIST);
 
+  }
+
+///////////////////////////////////////////////////////////////////////////////
+// inputs the centroided peaks (background) and the deisotoped MS peaks of a scan
+// (see deisotope_scan_raw_data) into the object:
+  void ProcessData::add_scan_raw_data(double TR, list<CentroidPeak> & centroidPeaks, vector<MSPeak> & PEAK_LIST)
+  {
+
+    //////////////////////////////////
+    // add the peaks to the background controller:
+    backgroundController->addPeakMSScan(TR, &centroidPeaks);
+
     //  store it:
     this->add_scan_raw_data(PEAK_LIST);
 
-    // clear it:
-    PEAK_LIST.clear();
-
   }
 
 ///////////////////////////////////////////////////////////////////////////////
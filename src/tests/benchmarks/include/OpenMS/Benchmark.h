@@ -0,0 +1,218 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <chrono>
+#include <ctime>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Minimal microbenchmark harness for the OpenMS benchmark executables.
+
+    Modeled after Google Benchmark: a benchmark is a function taking a State,
+    which performs its setup and then runs the code under test inside
+    <tt>for (auto _ : state)</tt>. The runner decides how many iterations are
+    needed for a stable measurement.
+
+    @code
+    void BM_HyperScore(Benchmark::State& state)
+    {
+      // setup, not measured
+      PeakSpectrum exp = ...;
+      for (auto _ : state)
+      {
+        Benchmark::doNotOptimize(HyperScore::compute(...));
+      }
+      state.setItemsProcessed(state.iterations());
+    }
+    OPENMS_BENCHMARK(BM_HyperScore)->arg(100)->arg(1000);
+    @endcode
+
+    See Benchmark.cpp for the command line options of the generated executables.
+  */
+  namespace Benchmark
+  {
+    /// The state of a single benchmark run: iteration count, timing and arguments
+    class State
+    {
+public:
+      /// Iterator used by range based for loops over a State; times the loop
+      class Iterator
+      {
+public:
+        /// loop variable; the user-provided destructor avoids 'unused variable' warnings for 'auto _'
+        struct Value
+        {
+          ~Value() {}
+        };
+
+        Iterator(State* state, Size remaining) :
+          state_(state),
+          remaining_(remaining)
+        {
+        }
+
+        Value operator*() const
+        {
+          return Value();
+        }
+
+        Iterator& operator++()
+        {
+          --remaining_;
+          return *this;
+        }
+
+        bool operator!=(const Iterator&) const
+        {
+          if (remaining_ != 0) return true;
+          state_->stopTiming_();
+          return false;
+        }
+
+private:
+        State* state_;
+        Size remaining_;
+      };
+
+      State(Size iterations, const std::vector<Int64>& args);
+
+      /// starts the timing, the loop body is executed iterations() times
+      Iterator begin();
+
+      Iterator end();
+
+      /// number of iterations of the current run
+      Size iterations() const;
+
+      /// argument @p index of the benchmark (see Registration::arg)
+      Int64 range(Size index = 0) const;
+
+      /// stops the timer, e.g. to exclude per-iteration setup
+      void pauseTiming();
+
+      /// restarts the timer after pauseTiming()
+      void resumeTiming();
+
+      /// number of items (e.g. spectra, peptides) processed in total by the run, used to report a throughput
+      void setItemsProcessed(Int64 items);
+
+      /// marks the benchmark as skipped (e.g. missing input data); call before the loop and return
+      void skipWithError(const String& message);
+
+      /// @name Results (used by the runner)
+      //@{
+      double getRealTime() const;
+      double getCPUTime() const;
+      Int64 getItemsProcessed() const;
+      const String& getError() const;
+      //@}
+
+private:
+      void stopTiming_();
+
+      Size iterations_;
+      std::vector<Int64> args_;
+      bool running_;
+      std::chrono::steady_clock::time_point real_start_;
+      std::clock_t cpu_start_;
+      double real_time_; ///< seconds
+      double cpu_time_; ///< seconds
+      Int64 items_processed_;
+      String error_;
+    };
+
+    typedef void (*Function)(State&);
+
+    /// A registered benchmark with its argument sets
+    class Registration
+    {
+public:
+      Registration(const String& name, Function function);
+
+      /// adds a run of the benchmark with the single argument @p value
+      Registration* arg(Int64 value);
+
+      /// adds a run of the benchmark with several arguments
+      Registration* args(const std::vector<Int64>& values);
+
+      String name;
+      Function function;
+      std::vector<std::vector<Int64> > arg_sets;
+    };
+
+    /// registers a benchmark (use OPENMS_BENCHMARK)
+    Registration* registerBenchmark(const String& name, Function function);
+
+    /// all registered benchmarks
+    std::vector<Registration*>& getRegistrations();
+
+    /// Prevents the compiler from optimizing away the computation of @p value
+    template <typename T>
+    inline void doNotOptimize(const T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+      asm volatile("" : : "g"(&value) : "memory");
+#else
+      static volatile const void* sink;
+      sink = &value;
+#endif
+    }
+
+    /**
+      @brief Returns the full path of a (small, real) data file shipped with the class tests.
+
+      @return the path or an empty string if the file does not exist
+    */
+    String getDataPath(const String& filename);
+
+    /// Returns a unique name for a temporary file (which is not removed automatically)
+    String getTempFileName(const String& suffix);
+  }
+}
+
+/// helper macros to create a unique variable name
+#define OPENMS_BENCHMARK_CONCAT_IMPL_(a, b) a ## b
+#define OPENMS_BENCHMARK_CONCAT_(a, b) OPENMS_BENCHMARK_CONCAT_IMPL_(a, b)
+
+/// registers the benchmark function @p function; append ->arg(x) to run it with arguments
+#define OPENMS_BENCHMARK(function) \
+  static ::OpenMS::Benchmark::Registration* OPENMS_BENCHMARK_CONCAT_(openms_benchmark_, __LINE__) = \
+    ::OpenMS::Benchmark::registerBenchmark(#function, function)
@@ -0,0 +1,77 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/KERNEL/FeatureMap.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/KERNEL/MSSpectrum.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  class AASequence;
+
+  /**
+    @brief Deterministic synthetic datasets for the benchmarks.
+
+    All generators use a fixed seed, i.e. every call with the same arguments returns the same data.
+  */
+  namespace BenchmarkData
+  {
+    /// a profile spectrum (m/z 300-1500) with @p peaks Gaussian peaks sampled every 0.002 Th
+    MSSpectrum createProfileSpectrum(Size peaks, UInt seed = 1);
+
+    /// a centroided spectrum with @p peaks random peaks in m/z 100-2000
+    MSSpectrum createCentroidedSpectrum(Size peaks, UInt seed = 1);
+
+    /// @p spectra centroided MS1 spectra (1 s apart) with @p peaks_per_spectrum random peaks each
+    PeakMap createCentroidedMap(Size spectra, Size peaks_per_spectrum, UInt seed = 1);
+
+    /**
+      @brief A centroided LC-MS map of @p compounds eluting compounds (3 isotopic traces each, charge 1 or 2) plus noise.
+
+      Suited as input for MassTraceDetection / ElutionPeakDetection / FeatureFindingMetabo.
+    */
+    PeakMap createLCMSMap(Size compounds, UInt seed = 1);
+
+    /// @p maps feature maps with @p features features each; the same features are jittered in RT/m/z across maps
+    std::vector<FeatureMap> createFeatureMaps(Size maps, Size features, UInt seed = 1);
+
+    /// @p count random tryptic-like peptides (length 7-25, ending in K or R)
+    std::vector<AASequence> createPeptides(Size count, UInt seed = 1);
+  }
+}
@@ -0,0 +1,482 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/Benchmark.h>
+#include <OpenMS/benchmark_config.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/CONCEPT/UniqueIdGenerator.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <thread>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+  Command line options of all benchmark executables:
+
+  --filter=<text>      only run benchmarks whose name contains <text>
+  --min_time=<sec>     minimal (wall clock) time of a single measurement (default: 0.5)
+  --repetitions=<n>    number of measurements, the median is reported (default: 3)
+  --out=<file>         write the results as JSON (Google Benchmark compatible fields)
+  --baseline=<file>    compare against a JSON file written before by --out
+  --tolerance=<frac>   relative slowdown against the baseline that is reported as regression (default: 0.1)
+  --list               only list the benchmarks
+
+  The exit code is 1 if a regression against the baseline was found.
+*/
+
+using namespace std;
+
+namespace OpenMS
+{
+  namespace Benchmark
+  {
+    State::State(Size iterations, const std::vector<Int64>& args) :
+      iterations_(iterations),
+      args_(args),
+      running_(false),
+      cpu_start_(0),
+      real_time_(0.0),
+      cpu_time_(0.0),
+      items_processed_(0)
+    {
+    }
+
+    State::Iterator State::begin()
+    {
+      if (!error_.empty()) return Iterator(this, 0);
+      resumeTiming();
+      return Iterator(this, iterations_);
+    }
+
+    State::Iterator State::end()
+    {
+      return Iterator(this, 0);
+    }
+
+    Size State::iterations() const
+    {
+      return iterations_;
+    }
+
+    Int64 State::range(Size index) const
+    {
+      return args_.at(index);
+    }
+
+    void State::pauseTiming()
+    {
+      if (!running_) return;
+      real_time_ += chrono::duration<double>(chrono::steady_clock::now() - real_start_).count();
+      cpu_time_ += double(clock() - cpu_start_) / CLOCKS_PER_SEC;
+      running_ = false;
+    }
+
+    void State::resumeTiming()
+    {
+      if (running_) return;
+      running_ = true;
+      cpu_start_ = clock();
+      real_start_ = chrono::steady_clock::now();
+    }
+
+    void State::stopTiming_()
+    {
+      pauseTiming();
+    }
+
+    void State::setItemsProcessed(Int64 items)
+    {
+      items_processed_ = items;
+    }
+
+    void State::skipWithError(const String& message)
+    {
+      error_ = message;
+    }
+
+    double State::getRealTime() const
+    {
+      return real_time_;
+    }
+
+    double State::getCPUTime() const
+    {
+      return cpu_time_;
+    }
+
+    Int64 State::getItemsProcessed() const
+    {
+      return items_processed_;
+    }
+
+    const String& State::getError() const
+    {
+      return error_;
+    }
+
+    Registration::Registration(const String& name, Function function) :
+      name(name),
+      function(function)
+    {
+    }
+
+    Registration* Registration::arg(Int64 value)
+    {
+      arg_sets.push_back(vector<Int64>(1, value));
+      return this;
+    }
+
+    Registration* Registration::args(const vector<Int64>& values)
+    {
+      arg_sets.push_back(values);
+      return this;
+    }
+
+    vector<Registration*>& getRegistrations()
+    {
+      static vector<Registration*> registrations;
+      return registrations;
+    }
+
+    Registration* registerBenchmark(const String& name, Function function)
+    {
+      getRegistrations().push_back(new Registration(name, function));
+      return getRegistrations().back();
+    }
+
+    String getDataPath(const String& filename)
+    {
+      const String path = String(OPENMS_BENCHMARK_DATA_PATH) + filename;
+      return File::exists(path) ? path : String();
+    }
+
+    String getTempFileName(const String& suffix)
+    {
+      return File::getTempDirectory() + "/OpenMS_benchmark_" + String(UniqueIdGenerator::getUniqueId()) + suffix;
+    }
+  }
+}
+
+using namespace OpenMS;
+
+namespace
+{
+  struct Options
+  {
+    String filter;
+    double min_time = 0.5;
+    Size repetitions = 3;
+    String out;
+    String baseline;
+    double tolerance = 0.1;
+    bool list = false;
+  };
+
+  struct Result
+  {
+    String name;
+    Size iterations = 0;
+    double real_time = 0.0; ///< median ns per iteration
+    double real_time_min = 0.0; ///< fastest measurement, ns per iteration
+    double cpu_time = 0.0; ///< median ns per iteration
+    double items_per_second = 0.0;
+    String error;
+  };
+
+  String formatTime(double ns)
+  {
+    stringstream ss;
+    ss << fixed << setprecision(2);
+    if (ns < 1e3) ss << ns << " ns";
+    else if (ns < 1e6) ss << ns / 1e3 << " us";
+    else if (ns < 1e9) ss << ns / 1e6 << " ms";
+    else ss << ns / 1e9 << " s";
+    return ss.str();
+  }
+
+  double median(vector<double> values)
+  {
+    sort(values.begin(), values.end());
+    const Size n = values.size();
+    return n % 2 ? values[n / 2] : 0.5 * (values[n / 2 - 1] + values[n / 2]);
+  }
+
+  Result runBenchmark(const String& name, Benchmark::Function function, const vector<Int64>& args, const Options& options)
+  {
+    Result result;
+    result.name = name;
+
+    // find the number of iterations needed to reach the minimal time
+    Size iterations = 1;
+    while (true)
+    {
+      Benchmark::State state(iterations, args);
+      function(state);
+      if (!state.getError().empty())
+      {
+        result.error = state.getError();
+        return result;
+      }
+      const double time = state.getRealTime();
+      if (time >= options.min_time || iterations >= 1000000000) break;
+      // aim a bit higher than needed, but grow at most by a factor of 10 per step
+      const double factor = time > 0.0 ? min(10.0, max(1.5, 1.4 * options.min_time / time)) : 10.0;
+      iterations = max(iterations + 1, Size(iterations * factor));
+    }
+
+    vector<double> real_times, cpu_times;
+    Int64 items = 0;
+    for (Size r = 0; r < options.repetitions; ++r)
+    {
+      Benchmark::State state(iterations, args);
+      function(state);
+      real_times.push_back(state.getRealTime() * 1e9 / iterations);
+      cpu_times.push_back(state.getCPUTime() * 1e9 / iterations);
+      items = state.getItemsProcessed();
+    }
+
+    result.iterations = iterations;
+    result.real_time = median(real_times);
+    result.real_time_min = *min_element(real_times.begin(), real_times.end());
+    result.cpu_time = median(cpu_times);
+    if (items > 0 && result.real_time > 0.0)
+    {
+      result.items_per_second = double(items) / iterations / (result.real_time * 1e-9);
+    }
+    return result;
+  }
+
+  String escapeJSON(const String& s)
+  {
+    String escaped;
+    for (char c : s)
+    {
+      if (c == '"' || c == '\\') escaped += '\\';
+      escaped += c;
+    }
+    return escaped;
+  }
+
+  void writeJSON(const String& filename, const String& executable, const vector<Result>& results)
+  {
+    ofstream os(filename.c_str());
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    time_t now = time(nullptr);
+    char date[64];
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+    int threads = 1;
+#ifdef _OPENMP
+    threads = omp_get_max_threads();
+#endif
+
+    os << setprecision(12);
+    os << "{\n  \"context\": {\"date\": \"" << date << "\", \"executable\": \"" << escapeJSON(executable)
+       << "\", \"num_cpus\": " << std::thread::hardware_concurrency() << ", \"num_threads\": " << threads
+#ifdef NDEBUG
+       << ", \"library_build_type\": \"release\""
+#else
+       << ", \"library_build_type\": \"debug\""
+#endif
+       << "},\n  \"benchmarks\": [";
+    for (Size i = 0; i < results.size(); ++i)
+    {
+      const Result& r = results[i];
+      os << (i ? ",\n" : "\n") << "    {\"name\": \"" << escapeJSON(r.name) << "\"";
+      if (!r.error.empty())
+      {
+        os << ", \"error_occurred\": true, \"error_message\": \"" << escapeJSON(r.error) << "\"}";
+        continue;
+      }
+      os << ", \"iterations\": " << r.iterations << ", \"real_time\": " << r.real_time
+         << ", \"real_time_min\": " << r.real_time_min << ", \"cpu_time\": " << r.cpu_time << ", \"time_unit\": \"ns\"";
+      if (r.items_per_second > 0.0) os << ", \"items_per_second\": " << r.items_per_second;
+      os << "}";
+    }
+    os << "\n  ]\n}\n";
+  }
+
+  /// reads name -> real_time (ns) of all benchmarks in a JSON file written by writeJSON (or Google Benchmark)
+  map<String, double> readBaseline(const String& filename)
+  {
+    ifstream is(filename.c_str());
+    if (!is)
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    stringstream ss;
+    ss << is.rdbuf();
+    const std::string content = ss.str();
+
+    map<String, double> baseline;
+    const std::string name_key = "\"name\"", time_key = "\"real_time\"";
+    Size pos = content.find(name_key);
+    while (pos != std::string::npos)
+    {
+      const Size object_end = content.find('}', pos);
+      const Size name_start = content.find('"', content.find(':', pos) + 1) + 1;
+      const Size name_end = content.find('"', name_start);
+      const Size time_pos = content.find(time_key, pos);
+      if (name_end != std::string::npos && time_pos != std::string::npos && time_pos < object_end)
+      {
+        const Size value_start = content.find(':', time_pos) + 1;
+        baseline[content.substr(name_start, name_end - name_start)] = atof(content.c_str() + value_start);
+      }
+      pos = content.find(name_key, name_end);
+    }
+    return baseline;
+  }
+
+  bool parseOption(const String& argument, const String& option, String& value)
+  {
+    if (!argument.hasPrefix(option + "=")) return false;
+    value = argument.substr(option.size() + 1);
+    return true;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  Options options;
+  for (int i = 1; i < argc; ++i)
+  {
+    const String argument(argv[i]);
+    String value;
+    if (argument == "--list") options.list = true;
+    else if (parseOption(argument, "--filter", value)) options.filter = value;
+    else if (parseOption(argument, "--min_time", value)) options.min_time = value.toDouble();
+    else if (parseOption(argument, "--repetitions", value)) options.repetitions = max(1, value.toInt());
+    else if (parseOption(argument, "--out", value)) options.out = value;
+    else if (parseOption(argument, "--baseline", value)) options.baseline = value;
+    else if (parseOption(argument, "--tolerance", value)) options.tolerance = value.toDouble();
+    else
+    {
+      cerr << "Unknown option '" << argument << "'. Valid options: --filter=<text> --min_time=<sec> --repetitions=<n> "
+              "--out=<file> --baseline=<file> --tolerance=<fraction> --list" << endl;
+      return 2;
+    }
+  }
+
+  try
+  {
+    vector<Result> results;
+    for (const Benchmark::Registration* registration : Benchmark::getRegistrations())
+    {
+      vector<vector<Int64> > arg_sets = registration->arg_sets;
+      if (arg_sets.empty()) arg_sets.push_back(vector<Int64>());
+      for (const vector<Int64>& args : arg_sets)
+      {
+        String name = registration->name;
+        for (Int64 a : args) name += "/" + String(a);
+        if (!options.filter.empty() && !name.hasSubstring(options.filter)) continue;
+        if (options.list)
+        {
+          cout << name << endl;
+          continue;
+        }
+
+        Result result;
+        try
+        {
+          result = runBenchmark(name, registration->function, args, options);
+        }
+        catch (std::exception& e)
+        {
+          result.name = name;
+          result.error = String("exception: ") + e.what();
+        }
+        cout << left << setw(60) << result.name << right;
+        if (!result.error.empty())
+        {
+          cout << "  SKIPPED: " << result.error << endl;
+        }
+        else
+        {
+          cout << setw(14) << formatTime(result.real_time) << setw(14) << formatTime(result.cpu_time) << " (CPU)"
+               << setw(12) << result.iterations << " iterations";
+          if (result.items_per_second > 0.0) cout << "  " << fixed << setprecision(1) << result.items_per_second << " items/s";
+          cout << endl;
+        }
+        results.push_back(result);
+      }
+    }
+
+    if (!options.out.empty())
+    {
+      writeJSON(options.out, argv[0], results);
+    }
+
+    if (!options.baseline.empty())
+    {
+      const map<String, double> baseline = readBaseline(options.baseline);
+      Size regressions = 0;
+      cout << "\nComparison against baseline '" << options.baseline << "' (tolerance " << options.tolerance * 100 << "%):" << endl;
+      for (const Result& result : results)
+      {
+        map<String, double>::const_iterator base = baseline.find(result.name);
+        if (!result.error.empty() || base == baseline.end() || base->second <= 0.0) continue;
+        const double change = (result.real_time - base->second) / base->second;
+        const bool regression = change > options.tolerance;
+        if (regression) ++regressions;
+        cout << left << setw(60) << result.name << right << setw(14) << formatTime(base->second) << " -> "
+             << setw(14) << formatTime(result.real_time) << showpos << fixed << setprecision(1) << setw(9) << change * 100 << "%"
+             << noshowpos << (regression ? "  REGRESSION" : "") << endl;
+      }
+      if (regressions > 0)
+      {
+        cout << regressions << " benchmark(s) slower than the baseline." << endl;
+        return 1;
+      }
+    }
+  }
+  catch (Exception::BaseException& e)
+  {
+    cerr << "Error: " << e.what() << endl;
+    return 2;
+  }
+  return 0;
+}
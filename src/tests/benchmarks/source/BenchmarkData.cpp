@@ -0,0 +1,217 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/BenchmarkData.h>
+
+#include <OpenMS/CHEMISTRY/AASequence.h>
+#include <OpenMS/CONCEPT/Constants.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace OpenMS
+{
+  namespace BenchmarkData
+  {
+    MSSpectrum createProfileSpectrum(Size peaks, UInt seed)
+    {
+      std::mt19937 rng(seed);
+      std::uniform_real_distribution<double> mz_dist(300.0, 1500.0);
+      std::uniform_real_distribution<double> int_dist(1e3, 1e6);
+
+      std::vector<std::pair<double, double> > centers(peaks);
+      for (std::pair<double, double>& c : centers) c = std::make_pair(mz_dist(rng), int_dist(rng));
+      std::sort(centers.begin(), centers.end());
+
+      // resolution ~ 60k at m/z 400: sigma ~ 0.003
+      const double sigma = 0.003, spacing = 0.002;
+      MSSpectrum spectrum;
+      spectrum.setMSLevel(1);
+      spectrum.setType(SpectrumSettings::PROFILE);
+      for (const std::pair<double, double>& c : centers)
+      {
+        // only the part of each peak which is above the noise level is sampled
+        for (double mz = c.first - 4 * sigma; mz <= c.first + 4 * sigma; mz += spacing)
+        {
+          const double d = (mz - c.first) / sigma;
+          spectrum.push_back(Peak1D(mz, float(c.second * std::exp(-0.5 * d * d))));
+        }
+      }
+      spectrum.sortByPosition();
+      return spectrum;
+    }
+
+    MSSpectrum createCentroidedSpectrum(Size peaks, UInt seed)
+    {
+      std::mt19937 rng(seed);
+      std::uniform_real_distribution<double> mz_dist(100.0, 2000.0);
+      std::uniform_real_distribution<double> int_dist(10.0, 1e5);
+      MSSpectrum spectrum;
+      spectrum.setMSLevel(1);
+      spectrum.setType(SpectrumSettings::CENTROID);
+      spectrum.reserve(peaks);
+      for (Size i = 0; i < peaks; ++i)
+      {
+        spectrum.push_back(Peak1D(mz_dist(rng), float(int_dist(rng))));
+      }
+      spectrum.sortByPosition();
+      return spectrum;
+    }
+
+    PeakMap createCentroidedMap(Size spectra, Size peaks_per_spectrum, UInt seed)
+    {
+      PeakMap map;
+      for (Size i = 0; i < spectra; ++i)
+      {
+        MSSpectrum spectrum = createCentroidedSpectrum(peaks_per_spectrum, UInt(seed + i));
+        spectrum.setRT(double(i));
+        spectrum.setNativeID("scan=" + String(i + 1));
+        map.addSpectrum(spectrum);
+      }
+      map.updateRanges();
+      return map;
+    }
+
+    PeakMap createLCMSMap(Size compounds, UInt seed)
+    {
+      std::mt19937 rng(seed);
+      std::uniform_real_distribution<double> mz_dist(150.0, 1000.0);
+      std::uniform_real_distribution<double> rt_dist(30.0, 570.0);
+      std::uniform_real_distribution<double> int_dist(1e4, 1e7);
+      std::uniform_real_distribution<double> noise_mz_dist(100.0, 1100.0);
+      std::uniform_real_distribution<double> noise_int_dist(10.0, 500.0);
+      std::normal_distribution<double> mz_error(0.0, 0.0005);
+
+      struct Compound
+      {
+        double mz, rt, intensity;
+        int charge;
+      };
+      std::vector<Compound> cs(compounds);
+      for (Size i = 0; i < compounds; ++i)
+      {
+        cs[i].mz = mz_dist(rng);
+        cs[i].rt = rt_dist(rng);
+        cs[i].intensity = int_dist(rng);
+        cs[i].charge = 1 + int(i % 2);
+      }
+
+      // 600 s gradient, one spectrum per second, peaks with ~5 s standard deviation
+      const double rt_sigma = 5.0;
+      const double isotope_ratios[3] = {1.0, 0.5, 0.15};
+      PeakMap map;
+      for (Size s = 0; s < 600; ++s)
+      {
+        const double rt = double(s);
+        MSSpectrum spectrum;
+        spectrum.setMSLevel(1);
+        spectrum.setRT(rt);
+        spectrum.setType(SpectrumSettings::CENTROID);
+        spectrum.setNativeID("scan=" + String(s + 1));
+        for (const Compound& c : cs)
+        {
+          const double d = (rt - c.rt) / rt_sigma;
+          if (std::fabs(d) > 3.0) continue;
+          const double apex_intensity = c.intensity * std::exp(-0.5 * d * d);
+          for (int iso = 0; iso < 3; ++iso)
+          {
+            const double mz = c.mz + iso * Constants::C13C12_MASSDIFF_U / c.charge + mz_error(rng);
+            spectrum.push_back(Peak1D(mz, float(apex_intensity * isotope_ratios[iso])));
+          }
+        }
+        for (Size n = 0; n < 200; ++n)
+        {
+          spectrum.push_back(Peak1D(noise_mz_dist(rng), float(noise_int_dist(rng))));
+        }
+        spectrum.sortByPosition();
+        map.addSpectrum(spectrum);
+      }
+      map.updateRanges();
+      return map;
+    }
+
+    std::vector<FeatureMap> createFeatureMaps(Size maps, Size features, UInt seed)
+    {
+      std::mt19937 rng(seed);
+      std::uniform_real_distribution<double> mz_dist(300.0, 1500.0);
+      std::uniform_real_distribution<double> rt_dist(0.0, 3600.0);
+      std::uniform_real_distribution<double> int_dist(1e4, 1e7);
+      std::normal_distribution<double> rt_shift(0.0, 3.0);
+      std::normal_distribution<double> mz_shift(0.0, 0.002);
+
+      std::vector<std::pair<double, double> > positions(features);
+      for (std::pair<double, double>& p : positions) p = std::make_pair(rt_dist(rng), mz_dist(rng));
+
+      std::vector<FeatureMap> result(maps);
+      for (Size m = 0; m < maps; ++m)
+      {
+        for (Size f = 0; f < features; ++f)
+        {
+          Feature feature;
+          feature.setRT(positions[f].first + rt_shift(rng));
+          feature.setMZ(positions[f].second + mz_shift(rng));
+          feature.setIntensity(float(int_dist(rng)));
+          feature.setCharge(2);
+          feature.setUniqueId(UInt64(f + 1));
+          result[m].push_back(feature);
+        }
+        result[m].updateRanges();
+      }
+      return result;
+    }
+
+    std::vector<AASequence> createPeptides(Size count, UInt seed)
+    {
+      std::mt19937 rng(seed);
+      const String residues = "ACDEFGHILMNPQSTVWY";
+      std::uniform_int_distribution<Size> residue_dist(0, residues.size() - 1);
+      std::uniform_int_distribution<Size> length_dist(7, 25);
+      std::vector<AASequence> peptides;
+      peptides.reserve(count);
+      for (Size i = 0; i < count; ++i)
+      {
+        String sequence;
+        const Size length = length_dist(rng);
+        for (Size j = 0; j + 1 < length; ++j)
+        {
+          sequence += residues[residue_dist(rng)];
+        }
+        sequence += (i % 2 ? 'K' : 'R');
+        peptides.push_back(AASequence::fromString(sequence));
+      }
+      return peptides;
+    }
+  }
+}
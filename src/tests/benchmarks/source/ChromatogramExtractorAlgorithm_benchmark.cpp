@@ -0,0 +1,77 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/Benchmark.h>
+#include <OpenMS/BenchmarkData.h>
+
+#include <OpenMS/ANALYSIS/OPENSWATH/ChromatogramExtractorAlgorithm.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SimpleOpenMSSpectraAccessFactory.h>
+
+#include <random>
+
+using namespace OpenMS;
+
+/// extraction from 1000 synthetic spectra (5000 peaks each); argument: number of transitions
+void BM_ChromatogramExtractorAlgorithm_extractChromatograms(Benchmark::State& state)
+{
+  boost::shared_ptr<PeakMap> exp(new PeakMap(BenchmarkData::createCentroidedMap(1000, 5000)));
+  OpenSwath::SpectrumAccessPtr expptr = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(exp);
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> mz_dist(150.0, 1950.0);
+  std::vector<ChromatogramExtractorAlgorithm::ExtractionCoordinates> coordinates(Size(state.range(0)));
+  for (Size i = 0; i < coordinates.size(); ++i)
+  {
+    coordinates[i].mz = mz_dist(rng);
+    coordinates[i].rt_start = 0;
+    coordinates[i].rt_end = -1; // whole chromatogram
+    coordinates[i].id = "tr" + String(i);
+  }
+  // the algorithm expects coordinates sorted by m/z
+  std::sort(coordinates.begin(), coordinates.end(), ChromatogramExtractorAlgorithm::ExtractionCoordinates::SortExtractionCoordinatesByMZ);
+
+  ChromatogramExtractorAlgorithm extractor;
+  for (auto _ : state)
+  {
+    std::vector<OpenSwath::ChromatogramPtr> output;
+    for (Size i = 0; i < coordinates.size(); ++i)
+    {
+      output.push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+    }
+    extractor.extractChromatograms(expptr, output, coordinates, 0.05, false, -1, "tophat");
+    Benchmark::doNotOptimize(output);
+  }
+  state.setItemsProcessed(state.iterations() * coordinates.size());
+}
+OPENMS_BENCHMARK(BM_ChromatogramExtractorAlgorithm_extractChromatograms)->arg(100)->arg(1000);
@@ -0,0 +1,95 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/Benchmark.h>
+#include <OpenMS/BenchmarkData.h>
+
+#include <OpenMS/FILTERING/DATAREDUCTION/ElutionPeakDetection.h>
+#include <OpenMS/FILTERING/DATAREDUCTION/FeatureFindingMetabo.h>
+#include <OpenMS/FILTERING/DATAREDUCTION/MassTraceDetection.h>
+#include <OpenMS/FORMAT/MzMLFile.h>
+
+using namespace OpenMS;
+
+namespace
+{
+  /// the mass traces FeatureFindingMetabo works on (not part of the measurement)
+  std::vector<MassTrace> detectMassTraces(const PeakMap& input)
+  {
+    std::vector<MassTrace> traces, split_traces;
+    MassTraceDetection().run(input, traces);
+    ElutionPeakDetection().detectPeaks(traces, split_traces);
+    return split_traces;
+  }
+
+  void runFeatureFindingMetabo(Benchmark::State& state, const std::vector<MassTrace>& traces)
+  {
+    FeatureFindingMetabo ffm;
+    for (auto _ : state)
+    {
+      // run() modifies the traces (e.g. by sorting), so each iteration gets a fresh copy
+      state.pauseTiming();
+      std::vector<MassTrace> input(traces);
+      state.resumeTiming();
+
+      FeatureMap features;
+      std::vector<std::vector<MSChromatogram> > chromatograms;
+      ffm.run(input, features, chromatograms);
+      Benchmark::doNotOptimize(features);
+    }
+    state.setItemsProcessed(state.iterations() * traces.size());
+  }
+}
+
+/// feature assembly on a synthetic LC-MS map; argument: number of compounds
+void BM_FeatureFindingMetabo_run_synthetic(Benchmark::State& state)
+{
+  runFeatureFindingMetabo(state, detectMassTraces(BenchmarkData::createLCMSMap(Size(state.range(0)))));
+}
+OPENMS_BENCHMARK(BM_FeatureFindingMetabo_run_synthetic)->arg(200)->arg(2000);
+
+/// feature assembly on a small real dataset
+void BM_FeatureFindingMetabo_run_real(Benchmark::State& state)
+{
+  const String filename = Benchmark::getDataPath("FeatureFindingMetabo_input1.mzML");
+  if (filename.empty())
+  {
+    state.skipWithError("test data FeatureFindingMetabo_input1.mzML not found");
+    return;
+  }
+  PeakMap input;
+  MzMLFile().load(filename, input);
+  runFeatureFindingMetabo(state, detectMassTraces(input));
+}
+OPENMS_BENCHMARK(BM_FeatureFindingMetabo_run_real);
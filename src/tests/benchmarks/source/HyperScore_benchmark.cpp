@@ -0,0 +1,69 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/Benchmark.h>
+#include <OpenMS/BenchmarkData.h>
+
+#include <OpenMS/ANALYSIS/RNPXL/HyperScore.h>
+#include <OpenMS/CHEMISTRY/AASequence.h>
+#include <OpenMS/CHEMISTRY/TheoreticalSpectrumGenerator.h>
+
+using namespace OpenMS;
+
+/// scores 100 theoretical spectra against an experimental spectrum; argument: number of experimental peaks
+void BM_HyperScore_compute(Benchmark::State& state)
+{
+  const PeakSpectrum exp_spectrum = BenchmarkData::createCentroidedSpectrum(Size(state.range(0)));
+  const std::vector<AASequence> peptides = BenchmarkData::createPeptides(100);
+
+  TheoreticalSpectrumGenerator generator;
+  Param p = generator.getParameters();
+  p.setValue("add_metainfo", "true"); // HyperScore needs the ion names
+  generator.setParameters(p);
+  std::vector<PeakSpectrum> theo_spectra(peptides.size());
+  for (Size i = 0; i < peptides.size(); ++i)
+  {
+    generator.getSpectrum(theo_spectra[i], peptides[i], 1, 1);
+  }
+
+  for (auto _ : state)
+  {
+    for (const PeakSpectrum& theo_spectrum : theo_spectra)
+    {
+      Benchmark::doNotOptimize(HyperScore::compute(10.0, true, exp_spectrum, theo_spectrum));
+    }
+  }
+  state.setItemsProcessed(state.iterations() * theo_spectra.size());
+}
+OPENMS_BENCHMARK(BM_HyperScore_compute)->arg(100)->arg(1000);
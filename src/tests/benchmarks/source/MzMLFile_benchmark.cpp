@@ -0,0 +1,82 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/Benchmark.h>
+#include <OpenMS/BenchmarkData.h>
+
+#include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/SYSTEM/File.h>
+
+using namespace OpenMS;
+
+/// decoding of synthetic spectra; arguments: peaks per spectrum, zlib compression (0/1)
+void BM_MzMLFile_load_synthetic(Benchmark::State& state)
+{
+  const PeakMap exp = BenchmarkData::createCentroidedMap(100, Size(state.range(0)));
+  const String filename = Benchmark::getTempFileName(".mzML");
+  MzMLFile writer;
+  writer.getOptions().setCompression(state.range(1) != 0);
+  writer.store(filename, exp);
+
+  for (auto _ : state)
+  {
+    PeakMap loaded;
+    MzMLFile().load(filename, loaded);
+    Benchmark::doNotOptimize(loaded);
+  }
+  state.setItemsProcessed(state.iterations() * exp.size());
+  File::remove(filename);
+}
+OPENMS_BENCHMARK(BM_MzMLFile_load_synthetic)->args({1000, 0})->args({1000, 1})->args({10000, 0})->args({10000, 1});
+
+/// decoding of a small real (profile, Orbitrap) dataset
+void BM_MzMLFile_load_real(Benchmark::State& state)
+{
+  const String filename = Benchmark::getDataPath("PeakPickerHiRes_orbitrap.mzML");
+  if (filename.empty())
+  {
+    state.skipWithError("test data PeakPickerHiRes_orbitrap.mzML not found");
+    return;
+  }
+  Size spectra = 0;
+  for (auto _ : state)
+  {
+    PeakMap loaded;
+    MzMLFile().load(filename, loaded);
+    spectra = loaded.size();
+    Benchmark::doNotOptimize(loaded);
+  }
+  state.setItemsProcessed(state.iterations() * spectra);
+}
+OPENMS_BENCHMARK(BM_MzMLFile_load_real);
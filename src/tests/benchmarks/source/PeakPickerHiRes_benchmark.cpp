@@ -0,0 +1,78 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/Benchmark.h>
+#include <OpenMS/BenchmarkData.h>
+
+#include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/TRANSFORMATIONS/RAW2PEAK/PeakPickerHiRes.h>
+
+using namespace OpenMS;
+
+/// picking a synthetic profile spectrum; argument: number of peaks
+void BM_PeakPickerHiRes_pick(Benchmark::State& state)
+{
+  const MSSpectrum input = BenchmarkData::createProfileSpectrum(Size(state.range(0)));
+  PeakPickerHiRes picker;
+  for (auto _ : state)
+  {
+    MSSpectrum output;
+    picker.pick(input, output);
+    Benchmark::doNotOptimize(output);
+  }
+  state.setItemsProcessed(state.iterations() * state.range(0));
+}
+OPENMS_BENCHMARK(BM_PeakPickerHiRes_pick)->arg(100)->arg(1000)->arg(10000);
+
+/// picking a small real (profile, Orbitrap) dataset
+void BM_PeakPickerHiRes_pickExperiment_real(Benchmark::State& state)
+{
+  const String filename = Benchmark::getDataPath("PeakPickerHiRes_orbitrap.mzML");
+  if (filename.empty())
+  {
+    state.skipWithError("test data PeakPickerHiRes_orbitrap.mzML not found");
+    return;
+  }
+  PeakMap input;
+  MzMLFile().load(filename, input);
+  PeakPickerHiRes picker;
+  for (auto _ : state)
+  {
+    PeakMap output;
+    picker.pickExperiment(input, output);
+    Benchmark::doNotOptimize(output);
+  }
+  state.setItemsProcessed(state.iterations() * input.size());
+}
+OPENMS_BENCHMARK(BM_PeakPickerHiRes_pickExperiment_real);
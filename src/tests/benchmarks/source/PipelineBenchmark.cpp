@@ -0,0 +1,448 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/DATASTRUCTURES/ListUtils.h>
+#include <OpenMS/FORMAT/ConsensusXMLFile.h>
+#include <OpenMS/FORMAT/FeatureXMLFile.h>
+#include <OpenMS/FORMAT/FileHandler.h>
+#include <OpenMS/FORMAT/IdXMLFile.h>
+#include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/KERNEL/ConsensusMap.h>
+#include <OpenMS/SYSTEM/ExternalProcess.h>
+#include <OpenMS/SYSTEM/File.h>
+#include <OpenMS/SYSTEM/StopWatch.h>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QStringList>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+/**
+  End-to-end benchmark of TOPP tool chains.
+
+  A pipeline file lists one TOPP tool call per line ('#' starts a comment):
+
+    PeakPickerHiRes -in ${DATA_DIR}/run1.mzML -out ${WORK_DIR}/run1_picked.mzML
+
+  ${DATA_DIR} and ${WORK_DIR} are replaced by the respective options. Every step is run once per
+  thread count (with '-threads <n>' and '-profile <trace>' appended) and the wall clock time, the
+  peak memory (as recorded by the tool in its profile trace) and the throughput is reported.
+  Throughput is given with respect to the files after '-in' (input) and '-out*' (output):
+  spectra for mzML, features for featureXML/consensusXML and peptide identifications for idXML.
+
+  Command line options:
+    --pipeline=<file>       pipeline description (required)
+    --data_dir=<dir>        directory of the input data (default: current directory)
+    --work_dir=<dir>        directory for intermediate files and traces (default: temporary directory)
+    --bin_dir=<dir>         directory of the TOPP executables (default: the directory of this executable)
+    --threads=<n,m,...>     thread counts to run the pipeline with (default: 1)
+    --repetitions=<n>       runs per thread count, the median time is reported (default: 1)
+    --out=<file>            write the results as JSON
+    --verbose               forward the output of the tools
+*/
+
+using namespace OpenMS;
+using namespace std;
+
+namespace
+{
+  struct Options
+  {
+    String pipeline;
+    String data_dir = ".";
+    String work_dir;
+    String bin_dir;
+    vector<Int> threads = {1};
+    Size repetitions = 1;
+    String out;
+    bool verbose = false;
+  };
+
+  /// a single tool call of a pipeline
+  struct Step
+  {
+    String tool;
+    QStringList arguments;
+    StringList inputs;
+    StringList outputs;
+  };
+
+  /// number of work items in a file (0 if the type is not supported) and their unit
+  struct ItemCount
+  {
+    Size count = 0;
+    String unit;
+  };
+
+  struct StepResult
+  {
+    String tool;
+    double wall_time = 0.0; ///< in seconds
+    Size peak_memory_kb = 0;
+    ItemCount input;
+    ItemCount output;
+  };
+
+  struct RunResult
+  {
+    Int threads = 1;
+    double wall_time = 0.0; ///< in seconds
+    vector<StepResult> steps;
+  };
+
+  bool parseOption(const String& argument, const String& name, String& value)
+  {
+    if (!argument.hasPrefix(name + "=")) return false;
+    value = argument.substr(name.size() + 1);
+    return true;
+  }
+
+  /// reads the pipeline file; variables are substituted and '-in'/'-out*' files are collected
+  vector<Step> readPipeline(const Options& options)
+  {
+    ifstream is(options.pipeline.c_str());
+    if (!is)
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, options.pipeline);
+    }
+    vector<Step> steps;
+    std::string line;
+    while (getline(is, line))
+    {
+      String l(line);
+      if (l.has('#')) l = l.prefix('#');
+      l.substitute("${DATA_DIR}", options.data_dir);
+      l.substitute("${WORK_DIR}", options.work_dir);
+      l.simplify();
+      if (l.empty()) continue;
+
+      StringList tokens;
+      l.split(' ', tokens);
+      Step step;
+      step.tool = tokens[0];
+      StringList* files = nullptr;
+      for (Size i = 1; i < tokens.size(); ++i)
+      {
+        const String& token = tokens[i];
+        if (token.hasPrefix("-"))
+        {
+          files = nullptr;
+          if (token == "-in") files = &step.inputs;
+          else if (token.hasPrefix("-out")) files = &step.outputs;
+        }
+        else if (files != nullptr)
+        {
+          files->push_back(token);
+        }
+        step.arguments << token.toQString();
+      }
+      steps.push_back(step);
+    }
+    if (steps.empty())
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, options.pipeline, "pipeline does not contain any step");
+    }
+    return steps;
+  }
+
+  ItemCount countItems(const StringList& files)
+  {
+    ItemCount result;
+    for (const String& file : files)
+    {
+      if (!File::exists(file)) continue;
+      switch (FileHandler::getTypeByFileName(file))
+      {
+        case FileTypes::MZML:
+        {
+          Size spectra(0), chromatograms(0);
+          MzMLFile().loadSize(file, spectra, chromatograms);
+          result.count += spectra;
+          result.unit = "spectra";
+          break;
+        }
+        case FileTypes::FEATUREXML:
+          result.count += FeatureXMLFile().loadSize(file);
+          result.unit = "features";
+          break;
+        case FileTypes::CONSENSUSXML:
+        {
+          ConsensusMap map;
+          ConsensusXMLFile().load(file, map);
+          result.count += map.size();
+          result.unit = "features";
+          break;
+        }
+        case FileTypes::IDXML:
+        {
+          vector<ProteinIdentification> proteins;
+          vector<PeptideIdentification> peptides;
+          IdXMLFile().load(file, proteins, peptides);
+          result.count += peptides.size();
+          result.unit = "peptide IDs";
+          break;
+        }
+        default:
+          break;
+      }
+    }
+    return result;
+  }
+
+  /// the 'peak_memory_kb' counter written by TOPPBase into the profile trace
+  Size readPeakMemory(const String& trace_file)
+  {
+    ifstream is(trace_file.c_str());
+    stringstream ss;
+    ss << is.rdbuf();
+    const std::string content = ss.str();
+    const Size pos = content.find("\"peak_memory_kb\"");
+    if (pos == std::string::npos) return 0;
+    const Size value_pos = content.find("\"value\":", pos);
+    if (value_pos == std::string::npos) return 0;
+    return Size(atoll(content.c_str() + value_pos + 8));
+  }
+
+  StepResult runStep(const Step& step, Int threads, const String& trace_file, const Options& options)
+  {
+    String exe;
+    if (options.bin_dir.empty())
+    {
+      exe = File::findSiblingTOPPExecutable(step.tool);
+    }
+    else
+    {
+      exe = String(options.bin_dir).ensureLastChar('/') + step.tool;
+#ifdef OPENMS_WINDOWSPLATFORM
+      exe += ".exe";
+#endif
+    }
+    QStringList arguments = step.arguments;
+    arguments << "-threads" << String(threads).toQString() << "-profile" << trace_file.toQString();
+
+    ExternalProcess process;
+    if (options.verbose)
+    {
+      process.setCallbacks([](const String& out) { cout << out; }, [](const String& out) { cerr << out; });
+    }
+    String error;
+    StopWatch sw;
+    sw.start();
+    const ExternalProcess::RETURNSTATE state = process.run(exe.toQString(), arguments, QString(), options.verbose, error);
+    sw.stop();
+    if (state != ExternalProcess::RETURNSTATE::SUCCESS)
+    {
+      throw Exception::FailedAPICall(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, error);
+    }
+
+    StepResult result;
+    result.tool = step.tool;
+    result.wall_time = sw.getClockTime();
+    result.peak_memory_kb = readPeakMemory(trace_file);
+    return result;
+  }
+
+  String formatThroughput(const ItemCount& items, double seconds)
+  {
+    if (items.count == 0 || seconds <= 0.0) return "";
+    stringstream ss;
+    ss << fixed << setprecision(1) << items.count / seconds << " " << items.unit << "/s";
+    return ss.str();
+  }
+
+  String escapeJSON(const String& s)
+  {
+    String escaped;
+    for (char c : s)
+    {
+      if (c == '"' || c == '\\') escaped += '\\';
+      escaped += c;
+    }
+    return escaped;
+  }
+
+  void writeItems(ostream& os, const String& key, const ItemCount& items, double seconds)
+  {
+    if (items.count == 0) return;
+    os << ", \"" << key << "_items\": " << items.count << ", \"" << key << "_unit\": \"" << items.unit << "\"";
+    if (seconds > 0.0) os << ", \"" << key << "_items_per_second\": " << items.count / seconds;
+  }
+
+  void writeJSON(const String& filename, const Options& options, const vector<RunResult>& runs)
+  {
+    ofstream os(filename.c_str());
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    time_t now = time(nullptr);
+    char date[64];
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+    os << setprecision(12);
+    os << "{\n  \"context\": {\"date\": \"" << date << "\", \"pipeline\": \"" << escapeJSON(options.pipeline)
+       << "\", \"num_cpus\": " << std::thread::hardware_concurrency() << "},\n  \"runs\": [";
+    for (Size r = 0; r < runs.size(); ++r)
+    {
+      const RunResult& run = runs[r];
+      os << (r ? ",\n" : "\n") << "    {\"threads\": " << run.threads << ", \"wall_time\": " << run.wall_time
+         << ", \"time_unit\": \"s\", \"steps\": [";
+      for (Size s = 0; s < run.steps.size(); ++s)
+      {
+        const StepResult& step = run.steps[s];
+        os << (s ? ",\n" : "\n") << "      {\"step\": " << s + 1 << ", \"tool\": \"" << escapeJSON(step.tool)
+           << "\", \"wall_time\": " << step.wall_time << ", \"peak_memory_kb\": " << step.peak_memory_kb;
+        writeItems(os, "input", step.input, step.wall_time);
+        writeItems(os, "output", step.output, step.wall_time);
+        os << "}";
+      }
+      os << "\n    ]}";
+    }
+    os << "\n  ]\n}\n";
+  }
+}
+
+int main(int argc, char** argv)
+{
+  QCoreApplication app(argc, argv); // ExternalProcess processes Qt events while waiting
+
+  Options options;
+  for (int i = 1; i < argc; ++i)
+  {
+    const String argument(argv[i]);
+    String value;
+    if (argument == "--verbose") options.verbose = true;
+    else if (parseOption(argument, "--pipeline", value)) options.pipeline = value;
+    else if (parseOption(argument, "--data_dir", value)) options.data_dir = value;
+    else if (parseOption(argument, "--work_dir", value)) options.work_dir = value;
+    else if (parseOption(argument, "--bin_dir", value)) options.bin_dir = value;
+    else if (parseOption(argument, "--threads", value)) options.threads = ListUtils::create<Int>(value);
+    else if (parseOption(argument, "--repetitions", value)) options.repetitions = Size(max(1, value.toInt()));
+    else if (parseOption(argument, "--out", value)) options.out = value;
+    else
+    {
+      cerr << "Unknown option '" << argument << "'. Valid options: --pipeline=<file> --data_dir=<dir> --work_dir=<dir> "
+              "--bin_dir=<dir> --threads=<n,m,...> --repetitions=<n> --out=<file> --verbose" << endl;
+      return 2;
+    }
+  }
+  if (options.pipeline.empty())
+  {
+    cerr << "Missing option --pipeline=<file>." << endl;
+    return 2;
+  }
+
+  try
+  {
+    if (options.work_dir.empty())
+    {
+      options.work_dir = File::getTempDirectory() + "/PipelineBenchmark_" + File::getUniqueName();
+    }
+    if (!QDir().mkpath(options.work_dir.toQString()))
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, options.work_dir);
+    }
+    const vector<Step> steps = readPipeline(options);
+    const String name = FileHandler::stripExtension(File::basename(options.pipeline));
+
+    vector<RunResult> runs;
+    for (Int threads : options.threads)
+    {
+      RunResult run;
+      run.threads = threads;
+      // per step: wall times of all repetitions; memory and item counts of the last one
+      vector<vector<double> > times(steps.size());
+      for (Size rep = 0; rep < options.repetitions; ++rep)
+      {
+        run.steps.clear();
+        for (Size s = 0; s < steps.size(); ++s)
+        {
+          const String trace = options.work_dir + "/" + name + "_t" + threads + "_step" + (s + 1) + ".trace.json";
+          run.steps.push_back(runStep(steps[s], threads, trace, options));
+          times[s].push_back(run.steps.back().wall_time);
+        }
+      }
+      for (Size s = 0; s < steps.size(); ++s)
+      {
+        sort(times[s].begin(), times[s].end());
+        StepResult& step = run.steps[s];
+        step.wall_time = times[s][times[s].size() / 2];
+        step.input = countItems(steps[s].inputs);
+        step.output = countItems(steps[s].outputs);
+        run.wall_time += step.wall_time;
+      }
+
+      cout << "\n" << name << " with " << threads << " thread(s): " << fixed << setprecision(2) << run.wall_time << " s\n";
+      cout << left << setw(6) << "step" << setw(32) << "tool" << right << setw(12) << "time (s)" << setw(16)
+           << "peak mem (MB)" << setw(26) << "input" << setw(26) << "output" << endl;
+      for (Size s = 0; s < run.steps.size(); ++s)
+      {
+        const StepResult& step = run.steps[s];
+        cout << left << setw(6) << s + 1 << setw(32) << step.tool << right << setw(12) << step.wall_time << setw(16)
+             << step.peak_memory_kb / 1024.0 << setw(26) << formatThroughput(step.input, step.wall_time)
+             << setw(26) << formatThroughput(step.output, step.wall_time) << endl;
+      }
+      runs.push_back(run);
+    }
+
+    if (runs.size() > 1)
+    {
+      cout << "\nScaling (speedup relative to " << runs[0].threads << " thread(s)):" << endl;
+      for (const RunResult& run : runs)
+      {
+        cout << setw(6) << run.threads << " threads: " << setw(10) << run.wall_time << " s  x"
+             << (run.wall_time > 0.0 ? runs[0].wall_time / run.wall_time : 0.0) << endl;
+      }
+    }
+
+    if (!options.out.empty())
+    {
+      writeJSON(options.out, options, runs);
+      cout << "\nResults written to '" << options.out << "'." << endl;
+    }
+  }
+  catch (Exception::BaseException& e)
+  {
+    cerr << "Error: " << e.what() << endl;
+    return 2;
+  }
+  return 0;
+}
@@ -0,0 +1,70 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/Benchmark.h>
+#include <OpenMS/BenchmarkData.h>
+
+#include <OpenMS/CHEMISTRY/AASequence.h>
+#include <OpenMS/CHEMISTRY/TheoreticalSpectrumGenerator.h>
+
+using namespace OpenMS;
+
+/// spectra of 1000 peptides (charge 1-2); argument: 0 = b/y ions (default), 1 = all ion types, losses and precursor peaks
+void BM_TheoreticalSpectrumGenerator_getSpectrum(Benchmark::State& state)
+{
+  const std::vector<AASequence> peptides = BenchmarkData::createPeptides(1000);
+  TheoreticalSpectrumGenerator generator;
+  if (state.range(0) != 0)
+  {
+    Param p = generator.getParameters();
+    p.setValue("add_a_ions", "true");
+    p.setValue("add_c_ions", "true");
+    p.setValue("add_x_ions", "true");
+    p.setValue("add_z_ions", "true");
+    p.setValue("add_losses", "true");
+    p.setValue("add_precursor_peaks", "true");
+    generator.setParameters(p);
+  }
+  for (auto _ : state)
+  {
+    for (const AASequence& peptide : peptides)
+    {
+      PeakSpectrum spectrum;
+      generator.getSpectrum(spectrum, peptide, 1, 2);
+      Benchmark::doNotOptimize(spectrum);
+    }
+  }
+  state.setItemsProcessed(state.iterations() * peptides.size());
+}
+OPENMS_BENCHMARK(BM_TheoreticalSpectrumGenerator_getSpectrum)->arg(0)->arg(1);
@@ -39,6 +39,7 @@
 
 ///////////////////////////
 #include <OpenMS/ANALYSIS/ID/AScore.h>
+#include <OpenMS/CHEMISTRY/TheoreticalSpectrumGenerator.h>
 ///////////////////////////
 
 using namespace OpenMS;
@@ -611,6 +612,23 @@ START_SECTION(std::vector<PeakSpectrum> createTheoreticalSpectraTest_(const std:
   TEST_REAL_SIMILAR(th_spectra[4][2].getMZ(), 244.166);
   TEST_REAL_SIMILAR(th_spectra[4][21].getMZ(), 1352.57723);
   
+  // spectra derived from the unmodified ladder equal the ones generated for each phospho form
+  std::vector<std::vector<Size>> permutations_2 = { {1, 2}, {2, 10}, {4, 7} };
+  th_spectra = ptr_test->createTheoreticalSpectraTest_(permutations_2, seq_without_phospho);
+  TheoreticalSpectrumGenerator tsg;
+  for (Size i = 0; i < permutations_2.size(); ++i)
+  {
+    PeakSpectrum expected;
+    tsg.getSpectrum(expected, AASequence::fromString(th_spectra[i].getName()), 1, 1);
+    TEST_EQUAL(th_spectra[i].size(), expected.size());
+    ABORT_IF(th_spectra[i].size() != expected.size());
+    for (Size k = 0; k < expected.size(); ++k)
+    {
+      TEST_REAL_SIMILAR(th_spectra[i][k].getMZ(), expected[k].getMZ());
+    }
+  }
+  TEST_EQUAL(th_spectra[1].getName(), "QSS(Phospho)VTQVTEQS(Phospho)PK");
+
   th_spectra.clear();
 }
 END_SECTION 
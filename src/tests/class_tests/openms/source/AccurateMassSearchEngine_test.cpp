@@ -180,6 +180,47 @@ START_SECTION((void queryByMZ(const double& observed_mz, const Int& observed_cha
 }
 END_SECTION
 
+START_SECTION((void queryByMZs(const std::vector<double>& observed_mzs, const std::vector<Int>& observed_charges, const String& ion_mode, std::vector<std::vector<AccurateMassSearchResult> >& results) const))
+{
+  Param ams_param_tmp = ams_param;
+  ams_param_tmp.setValue("mass_error_value", 17.0);
+  AccurateMassSearchEngine ams_batch;
+  ams_batch.setParameters(ams_param_tmp);
+  std::vector<std::vector<AccurateMassSearchResult> > batch_results;
+  TEST_EXCEPTION(Exception::IllegalArgument, ams_batch.queryByMZs(std::vector<double>(1, 1234.0), std::vector<Int>(1, 1), "positive", batch_results));
+  ams_batch.init();
+  TEST_EXCEPTION(Exception::InvalidParameter, ams_batch.queryByMZs(std::vector<double>(1, 1234.0), std::vector<Int>(1, 1), "this_is_an_invalid_ionmode", batch_results));
+  TEST_EXCEPTION(Exception::InvalidSize, ams_batch.queryByMZs(std::vector<double>(2, 1234.0), std::vector<Int>(1, 1), "positive", batch_results));
+
+  // unsorted queries, with duplicates, unknown charges and masses without hits
+  double mz_na = EmpiricalFormula("C17H11N5").getMonoWeight() + EmpiricalFormula("Na").getMonoWeight() - Constants::ELECTRON_MASS_U;
+  double mz_3h = EmpiricalFormula("C17H20N2S").getMonoWeight() / 3 - Constants::PROTON_MASS_U;
+  std::vector<double> mzs = {mz_na, 399.33486, 50.0, mz_3h, mz_na, 100.0, 290.05475446, 1234.0};
+  std::vector<Int> charges = {1, 1, 1, 3, 0, 2, 0, 1};
+  for (const String ion_mode : {"positive", "negative"})
+  {
+    ams_batch.queryByMZs(mzs, charges, ion_mode, batch_results);
+    TEST_EQUAL(batch_results.size(), mzs.size())
+    for (Size q = 0; q < mzs.size(); ++q)
+    {
+      std::vector<AccurateMassSearchResult> single;
+      ams_batch.queryByMZ(mzs[q], charges[q], ion_mode, single);
+      TEST_EQUAL(batch_results[q].size(), single.size())
+      ABORT_IF(batch_results[q].size() != single.size())
+      for (Size i = 0; i < single.size(); ++i)
+      {
+        TEST_EQUAL(batch_results[q][i].getMatchingIndex(), single[i].getMatchingIndex())
+        TEST_EQUAL(batch_results[q][i].getFoundAdduct(), single[i].getFoundAdduct())
+        TEST_EQUAL(batch_results[q][i].getFormulaString(), single[i].getFormulaString())
+        TEST_REAL_SIMILAR(batch_results[q][i].getObservedMZ(), single[i].getObservedMZ())
+      }
+    }
+  }
+  ams_batch.queryByMZs(std::vector<double>(), std::vector<Int>(), "positive", batch_results);
+  TEST_EQUAL(batch_results.empty(), true)
+}
+END_SECTION
+
 AccurateMassSearchEngine ams_feat_test;
 ams_feat_test.setParameters(ams_param);
 ams_feat_test.init();
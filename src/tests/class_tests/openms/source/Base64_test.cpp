@@ -264,6 +264,74 @@ START_SECTION([EXTRA] zlib functionality)
 }
 END_SECTION
 
+START_SECTION([EXTRA] long arrays, whitespace and reserved output)
+{
+  Base64 b64;
+  String str;
+
+  // long enough to exercise the block-wise decoding
+  std::vector<double> data_double, res_double;
+  for (Size i = 0; i < 1001; ++i)
+  {
+    data_double.push_back(i * 1.5 + 0.25);
+  }
+  for (Size z = 0; z < 2; ++z)
+  {
+    std::vector<double> tmp = data_double;
+    b64.encode(tmp, Base64::BYTEORDER_LITTLEENDIAN, str, z == 1);
+    b64.decode(str, Base64::BYTEORDER_LITTLEENDIAN, res_double, z == 1);
+    TEST_EQUAL(res_double.size(), data_double.size())
+    TEST_EQUAL(res_double == data_double, true)
+
+    tmp = data_double;
+    b64.encode(tmp, Base64::BYTEORDER_BIGENDIAN, str, z == 1);
+    res_double.clear();
+    res_double.reserve(data_double.size());
+    b64.decode(str, Base64::BYTEORDER_BIGENDIAN, res_double, z == 1);
+    TEST_EQUAL(res_double.size(), data_double.size())
+    TEST_EQUAL(res_double == data_double, true)
+  }
+
+  // too small reservation, output needs to grow during decompression
+  std::vector<float> data, res;
+  for (Size i = 0; i < 777; ++i)
+  {
+    data.push_back(i * 0.5f);
+  }
+  std::vector<float> tmp = data;
+  b64.encode(tmp, Base64::BYTEORDER_LITTLEENDIAN, str, true);
+  res.reserve(3);
+  b64.decode(str, Base64::BYTEORDER_LITTLEENDIAN, res, true);
+  TEST_EQUAL(res.size(), data.size())
+  TEST_EQUAL(res == data, true)
+
+  // line breaks in compressed data are skipped
+  str.insert(str.size() / 2, "\n");
+  str.insert(0, "\n");
+  b64.decode(str + "\n\n", Base64::BYTEORDER_LITTLEENDIAN, res, true);
+  TEST_EQUAL(res.size(), data.size())
+  TEST_EQUAL(res == data, true)
+
+  // 64 bit integers
+  std::vector<Int64> data_int, res_int;
+  for (Int64 i = -500; i < 500; ++i)
+  {
+    data_int.push_back(i * 100000);
+  }
+  for (Size z = 0; z < 2; ++z)
+  {
+    std::vector<Int64> tmp_int = data_int;
+    b64.encodeIntegers(tmp_int, Base64::BYTEORDER_BIGENDIAN, str, z == 1);
+    b64.decodeIntegers(str, Base64::BYTEORDER_BIGENDIAN, res_int, z == 1);
+    TEST_EQUAL(res_int.size(), data_int.size())
+    TEST_EQUAL(res_int == data_int, true)
+  }
+
+  // corrupted compressed data
+  TEST_EXCEPTION(Exception::ConversionError, b64.decode("AAAAAAAA", Base64::BYTEORDER_LITTLEENDIAN, res, true))
+}
+END_SECTION
+
 START_SECTION(( void encodeStrings(const std::vector<String> & in, String & out, bool zlib_compression = false, bool append_zero_byte = true)))
 {
   Base64 b64;
@@ -106,6 +106,33 @@ START_SECTION((double operator()(const BinnedSpectrum &spec) const ))
 }
 END_SECTION
 
+START_SECTION((void compareBatch(const BinnedSpectrum& query, const std::vector<BinnedSpectrum>& targets, std::vector<double>& scores) const))
+{
+  PeakSpectrum s1, s2, s3;
+  DTAFile().load(OPENMS_GET_TEST_DATA_PATH("PILISSequenceDB_DFPIANGER_1.dta"), s1);
+  s2 = s1;
+  s2.pop_back();
+  s3 = s1;
+  s3.resize(s3.size() / 2);
+  BinnedSpectrum bs1(s1, 1.5, false, 2, 0);
+  vector<BinnedSpectrum> targets;
+  targets.push_back(bs1);
+  targets.push_back(BinnedSpectrum(s2, 1.5, false, 2, 0));
+  targets.push_back(BinnedSpectrum(s3, 1.5, false, 2, 0));
+
+  vector<double> scores(1, -1.0);
+  ptr->compareBatch(bs1, targets, scores);
+  TEST_EQUAL(scores.size(), targets.size())
+  for (Size i = 0; i < targets.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(scores[i], (*ptr)(bs1, targets[i]))
+  }
+
+  ptr->compareBatch(bs1, vector<BinnedSpectrum>(), scores);
+  TEST_EQUAL(scores.empty(), true)
+}
+END_SECTION
+
 START_SECTION((static BinnedSpectrumCompareFunctor* create()))
 {
   BinnedSpectrumCompareFunctor* bsf = BinnedSpectralContrastAngle::create();
@@ -0,0 +1,188 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/DATASTRUCTURES/BoundingBoxIndex.h>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(BoundingBoxIndex, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+typedef BoundingBoxIndex::BoxType BoxType;
+typedef BoundingBoxIndex::PositionType PositionType;
+
+vector<BoxType> boxes;
+boxes.push_back(BoxType(PositionType(10.0, 500.0), PositionType(20.0, 500.5)));
+boxes.push_back(BoxType(PositionType(15.0, 500.2), PositionType(40.0, 501.0)));
+boxes.push_back(BoxType()); // empty
+boxes.push_back(BoxType(PositionType(100.0, 300.0), PositionType(100.0, 900.0))); // zero width
+boxes.push_back(BoxType(PositionType(0.0, 700.0), PositionType(200.0, 700.0))); // zero height
+
+BoundingBoxIndex* ptr = nullptr;
+BoundingBoxIndex* null_ptr = nullptr;
+START_SECTION((BoundingBoxIndex()))
+{
+  ptr = new BoundingBoxIndex();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->empty(), true)
+  vector<Size> result(1, 5);
+  ptr->query(PositionType(0.0, 0.0), result);
+  TEST_EQUAL(result.empty(), true)
+}
+END_SECTION
+
+START_SECTION((~BoundingBoxIndex()))
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((explicit BoundingBoxIndex(const std::vector<BoxType>& boxes, double bin_width = 0.0)))
+{
+  BoundingBoxIndex index(boxes, 2.0);
+  TEST_EQUAL(index.size(), 5)
+}
+END_SECTION
+
+START_SECTION((void build(const std::vector<BoxType>& boxes, double bin_width = 0.0)))
+{
+  BoundingBoxIndex index;
+  index.build(boxes);
+  TEST_EQUAL(index.size(), 5)
+  index.build(vector<BoxType>(2)); // only empty boxes
+  TEST_EQUAL(index.size(), 2)
+  vector<Size> result;
+  index.query(PositionType(0.0, 0.0), result);
+  TEST_EQUAL(result.empty(), true)
+}
+END_SECTION
+
+START_SECTION((void clear()))
+{
+  BoundingBoxIndex index(boxes);
+  index.clear();
+  TEST_EQUAL(index.empty(), true)
+  TEST_EQUAL(index.size(), 0)
+}
+END_SECTION
+
+START_SECTION((Size size() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((bool empty() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((const BoxType& getBox(Size index) const))
+{
+  BoundingBoxIndex index(boxes);
+  TEST_EQUAL(index.getBox(1) == boxes[1], true)
+  TEST_EXCEPTION(Exception::IndexOverflow, index.getBox(5))
+}
+END_SECTION
+
+START_SECTION((void query(const PositionType& position, std::vector<Size>& result) const))
+{
+  for (double bin_width : {0.0, 0.5, 3.0, 1000.0})
+  {
+    BoundingBoxIndex index(boxes, bin_width);
+    vector<Size> result;
+
+    index.query(PositionType(17.0, 500.3), result);
+    TEST_EQUAL(result.size(), 2)
+    ABORT_IF(result.size() != 2)
+    TEST_EQUAL(result[0], 0)
+    TEST_EQUAL(result[1], 1)
+
+    // borders are included
+    index.query(PositionType(10.0, 500.0), result);
+    TEST_EQUAL(result.size(), 1)
+    index.query(PositionType(100.0, 700.0), result);
+    TEST_EQUAL(result.size(), 2)
+    ABORT_IF(result.size() != 2)
+    TEST_EQUAL(result[0], 3)
+    TEST_EQUAL(result[1], 4)
+
+    // outside of all boxes
+    index.query(PositionType(30.0, 500.1), result);
+    TEST_EQUAL(result.empty(), true)
+    index.query(PositionType(-1.0, 700.0), result);
+    TEST_EQUAL(result.empty(), true)
+    index.query(PositionType(250.0, 700.0), result);
+    TEST_EQUAL(result.empty(), true)
+  }
+
+  // same as checking all boxes
+  vector<BoxType> random_boxes;
+  for (Size i = 0; i < 500; ++i)
+  {
+    double x = (i * 7919) % 1000, y = 300.0 + (i * 104729) % 1500 / 1.7;
+    random_boxes.push_back(BoxType(PositionType(x, y), PositionType(x + (i % 50), y + (i % 7) * 0.3)));
+  }
+  BoundingBoxIndex index(random_boxes);
+  vector<Size> result, expected;
+  Size n_found = 0;
+  for (Size q = 0; q < 2000; ++q)
+  {
+    PositionType pos((q * 31) % 1100, 300.0 + (q * 7) % 900);
+    if (q % 2 == 0) pos = random_boxes[q % random_boxes.size()].maxPosition();
+    index.query(pos, result);
+    expected.clear();
+    for (Size i = 0; i < random_boxes.size(); ++i)
+    {
+      if (random_boxes[i].encloses(pos)) expected.push_back(i);
+    }
+    TEST_EQUAL(result == expected, true)
+    n_found += result.size();
+  }
+  TEST_EQUAL(n_found >= 1000, true)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
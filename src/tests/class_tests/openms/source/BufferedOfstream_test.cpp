@@ -0,0 +1,86 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg, Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/FORMAT/BufferedOfstream.h>
+///////////////////////////
+
+#include <OpenMS/FORMAT/TextFile.h>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(BufferedOfstream, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+START_SECTION((explicit BufferedOfstream(const String& filename, std::ios_base::openmode mode = std::ios_base::out, Size buffer_size = 1 << 20)))
+{
+  String filename;
+  NEW_TMP_FILE(filename)
+  {
+    BufferedOfstream os(filename, std::ios_base::out, 16); // tiny buffer: forces many flushes
+    TEST_EQUAL(os.good(), true)
+    for (Size i = 0; i < 1000; ++i)
+    {
+      os << "line " << i << "\n";
+    }
+  } // closed by the destructor
+
+  TextFile text(filename);
+  TEST_EQUAL(text.end() - text.begin(), 1000)
+  TEST_STRING_EQUAL(*text.begin(), "line 0")
+  TEST_STRING_EQUAL(*(text.end() - 1), "line 999")
+
+  // appending
+  {
+    BufferedOfstream os(filename, std::ios_base::app);
+    os << "appended\n";
+  }
+  text.load(filename);
+  TEST_EQUAL(text.end() - text.begin(), 1001)
+  TEST_STRING_EQUAL(*(text.end() - 1), "appended")
+
+  BufferedOfstream bad("/this/directory/does/not/exist/file.txt");
+  TEST_EQUAL(bool(bad), false)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -43,6 +43,8 @@
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 
+#include <iterator>
+
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wshadow"
 
@@ -412,6 +414,93 @@ START_SECTION( static inline void readChromatogramFast(OpenSwath::BinaryDataArra
 }
 END_SECTION
 
+START_SECTION(static std::vector<OpenSwath::BinaryDataArrayPtr> readSpectrumFast(const char* buffer, Size buffer_size, int& ms_level, double& rt))
+{
+  std::ifstream ifs_(tmp_filename.c_str(), std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(ifs_)), std::istreambuf_iterator<char>());
+  std::vector<std::streampos> spectra_index = cache_.getSpectraIndex();
+
+  for (Size k = 0; k < spectra_index.size(); ++k)
+  {
+    const Size offset = spectra_index[k];
+    int ms_level = -1;
+    double rt = -1.0;
+    std::vector<OpenSwath::BinaryDataArrayPtr> data = CachedMzMLHandler::readSpectrumFast(content.data() + offset, content.size() - offset, ms_level, rt);
+
+    TEST_EQUAL(data.size() >= 2, true)
+    TEST_EQUAL(data[0]->data.size(), exp.getSpectrum(k).size())
+    TEST_EQUAL(data[1]->data.size(), exp.getSpectrum(k).size())
+    TEST_EQUAL(ms_level, exp.getSpectrum(k).getMSLevel())
+    TEST_REAL_SIMILAR(rt, exp.getSpectrum(k).getRT())
+    for (Size i = 0; i < data[0]->data.size(); i++)
+    {
+      TEST_REAL_SIMILAR(data[0]->data[i], exp.getSpectrum(k)[i].getMZ())
+      TEST_REAL_SIMILAR(data[1]->data[i], exp.getSpectrum(k)[i].getIntensity())
+    }
+  }
+
+  // should not read past the end of the buffer
+  const Size offset = spectra_index[0];
+  int ms_level = -1;
+  double rt = -1.0;
+  TEST_EXCEPTION(Exception::ParseError, CachedMzMLHandler::readSpectrumFast(content.data() + offset, 10, ms_level, rt))
+}
+END_SECTION
+
+START_SECTION(static std::vector<OpenSwath::BinaryDataArrayPtr> readChromatogramFast(const char* buffer, Size buffer_size))
+{
+  std::ifstream ifs_(tmp_filename.c_str(), std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(ifs_)), std::istreambuf_iterator<char>());
+  std::vector<std::streampos> chrom_index = cache_.getChromatogramIndex();
+
+  for (Size k = 0; k < chrom_index.size(); ++k)
+  {
+    const Size offset = chrom_index[k];
+    std::vector<OpenSwath::BinaryDataArrayPtr> data = CachedMzMLHandler::readChromatogramFast(content.data() + offset, content.size() - offset);
+
+    TEST_EQUAL(data[0]->data.size(), exp.getChromatogram(k).size())
+    TEST_EQUAL(data[1]->data.size(), exp.getChromatogram(k).size())
+    for (Size i = 0; i < data[0]->data.size(); i++)
+    {
+      TEST_REAL_SIMILAR(data[0]->data[i], exp.getChromatogram(k)[i].getRT())
+      TEST_REAL_SIMILAR(data[1]->data[i], exp.getChromatogram(k)[i].getIntensity())
+    }
+  }
+
+  // should not read past the end of the buffer
+  const Size offset = chrom_index[0];
+  TEST_EXCEPTION(Exception::ParseError, CachedMzMLHandler::readChromatogramFast(content.data() + offset, 3))
+}
+END_SECTION
+
+START_SECTION(static void readSpectrum(SpectrumType& spectrum, const char* buffer, Size buffer_size))
+{
+  std::ifstream ifs_(tmp_filename.c_str(), std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(ifs_)), std::istreambuf_iterator<char>());
+  const Size offset = cache_.getSpectraIndex()[0];
+
+  MSSpectrum s;
+  CachedMzMLHandler::readSpectrum(s, content.data() + offset, content.size() - offset);
+  TEST_EQUAL(s.size(), exp.getSpectrum(0).size())
+  TEST_EQUAL(s.getMSLevel(), 1)
+  TEST_REAL_SIMILAR(s.getRT(), 5.1)
+  TEST_REAL_SIMILAR(s[0].getMZ(), exp.getSpectrum(0)[0].getMZ())
+}
+END_SECTION
+
+START_SECTION(static void readChromatogram(ChromatogramType& chromatogram, const char* buffer, Size buffer_size))
+{
+  std::ifstream ifs_(tmp_filename.c_str(), std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(ifs_)), std::istreambuf_iterator<char>());
+  const Size offset = cache_.getChromatogramIndex()[0];
+
+  MSChromatogram c;
+  CachedMzMLHandler::readChromatogram(c, content.data() + offset, content.size() - offset);
+  TEST_EQUAL(c.size(), exp.getChromatogram(0).size())
+  TEST_REAL_SIMILAR(c[0].getRT(), exp.getChromatogram(0)[0].getRT())
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
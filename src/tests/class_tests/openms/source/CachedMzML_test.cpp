@@ -220,6 +220,21 @@ START_SECTION(( const MSExperiment& getMetaData() const ))
 }
 END_SECTION
 
+START_SECTION(( bool isMemoryMapped() const ))
+{
+  TEST_EQUAL(cache_example.isMemoryMapped(), true)
+
+  // copies share the mapping and return the same data
+  CachedmzML cache_copy(cache_example);
+  TEST_EQUAL(cache_copy.isMemoryMapped(), true)
+  TEST_EQUAL(cache_copy.getSpectrum(0).size(), exp.getSpectrum(0).size())
+  TEST_EQUAL(cache_copy.getChromatogram(1).size(), exp.getChromatogram(1).size())
+
+  CachedmzML empty_cache;
+  TEST_EQUAL(empty_cache.isMemoryMapped(), false)
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -38,6 +38,7 @@
 #include <OpenMS/test_config.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SimpleOpenMSSpectraAccessFactory.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessIonMobilityIndexed.h>
 
 using namespace OpenMS;
 using namespace std;
@@ -257,6 +258,30 @@ START_SECTION([EXTRA] void extractChromatograms(const OpenSwath::SpectrumAccessP
     TEST_REAL_SIMILAR(max_value, 313 + 314 + 315)
     TEST_REAL_SIMILAR(foundat, 3)
   }
+
+  // ion mobility indexed spectrum access gives the same result
+  OpenSwath::SpectrumAccessPtr indexed_ptr(new SpectrumAccessIonMobilityIndexed(*expptr, 4));
+  for (double im_window : {15.0, 30.0, 200.0})
+  {
+    std::vector< OpenSwath::ChromatogramPtr > out_exp, out_exp_indexed;
+    for (int i = 0; i < 2; i++)
+    {
+      out_exp.push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+      out_exp_indexed.push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+    }
+
+    extractor.extractChromatograms(expptr, out_exp, coordinates, extract_window, false, im_window, "tophat");
+    extractor.extractChromatograms(indexed_ptr, out_exp_indexed, coordinates, extract_window, false, im_window, "tophat");
+    for (int i = 0; i < 2; i++)
+    {
+      TEST_EQUAL(out_exp_indexed[i]->getIntensityArray()->data.size(), out_exp[i]->getIntensityArray()->data.size())
+      for (Size k = 0; k < out_exp[i]->getIntensityArray()->data.size(); k++)
+      {
+        TEST_REAL_SIMILAR(out_exp_indexed[i]->getIntensityArray()->data[k], out_exp[i]->getIntensityArray()->data[k])
+        TEST_REAL_SIMILAR(out_exp_indexed[i]->getTimeArray()->data[k], out_exp[i]->getTimeArray()->data[k])
+      }
+    }
+  }
 }
 END_SECTION
 
@@ -540,6 +565,63 @@ START_SECTION([EXTRA]void extract_value_tophat(const std::vector< double >::cons
 }
 END_SECTION
 
+START_SECTION(static void extract_values_tophat(const std::vector<double>& mz_array, const std::vector<double>& int_array, const std::vector<double>& left, const std::vector<double>& right, std::vector<double>& integrated_intensities))
+{
+  std::vector<double> mz (mz_arr, mz_arr + sizeof(mz_arr) / sizeof(mz_arr[0]) );
+  std::vector<double> intensities (int_arr, int_arr + sizeof(int_arr) / sizeof(int_arr[0]) );
+
+  // same targets as for extract_value_tophat above, extracted all at once
+  std::vector<double> targets = {399.805, 399.91, 400.0, 400.05, 400.1, 400.28, 500.0};
+  std::vector<double> left, right, result;
+  for (double t : targets)
+  {
+    left.push_back(t - 0.1);
+    right.push_back(t + 0.1);
+  }
+  ChromatogramExtractorAlgorithm::extract_values_tophat(mz, intensities, left, right, result);
+  TEST_EQUAL(result.size(), 7)
+  TEST_REAL_SIMILAR(result[0], 0.0)
+  TEST_REAL_SIMILAR(result[1], 108.0)
+  TEST_REAL_SIMILAR(result[2], 4508.0)
+  // unlike extract_value_tophat, the first data point (400.0) is also found
+  // when it is more than one step left of the target
+  TEST_REAL_SIMILAR(result[3], 8408.0)
+  TEST_REAL_SIMILAR(result[4], 9000.0)
+  TEST_REAL_SIMILAR(result[5], 100.0)
+  TEST_REAL_SIMILAR(result[6], 10.0)
+
+  // ppm windows (500 ppm)
+  targets = {399.89, 399.91, 399.92, 400.0, 400.05, 400.1};
+  left.clear();
+  right.clear();
+  for (double t : targets)
+  {
+    left.push_back(t - t * 500 / 2.0 * 1.0e-6);
+    right.push_back(t + t * 500 / 2.0 * 1.0e-6);
+  }
+  ChromatogramExtractorAlgorithm::extract_values_tophat(mz, intensities, left, right, result);
+  TEST_EQUAL(result.size(), 6)
+  TEST_REAL_SIMILAR(result[0], 0.0)
+  TEST_REAL_SIMILAR(result[1], 8.0)
+  TEST_REAL_SIMILAR(result[2], 108.0)
+  TEST_REAL_SIMILAR(result[3], 4508.0)
+  TEST_REAL_SIMILAR(result[4], 8408.0)
+  TEST_REAL_SIMILAR(result[5], 9008.0)
+
+  // overlapping windows and an empty spectrum
+  left = {399.9, 400.0, 400.095};
+  right = {400.05, 400.1, 400.105};
+  ChromatogramExtractorAlgorithm::extract_values_tophat(mz, intensities, left, right, result);
+  TEST_REAL_SIMILAR(result[0], 1008.0)
+  TEST_REAL_SIMILAR(result[1], 4500.0)
+  TEST_REAL_SIMILAR(result[2], 900.0)
+  std::vector<double> empty;
+  ChromatogramExtractorAlgorithm::extract_values_tophat(empty, empty, left, right, result);
+  TEST_EQUAL(result.size(), 3)
+  TEST_REAL_SIMILAR(result[0], 0.0)
+}
+END_SECTION
+
 START_SECTION( [ChromatogramExtractorAlgorithm::ExtractionCoordinates] static bool SortExtractionCoordinatesByMZ(const ChromatogramExtractorAlgorithm::ExtractionCoordinates &left, const ChromatogramExtractorAlgorithm::ExtractionCoordinates &right))    
 {
   NOT_TESTABLE
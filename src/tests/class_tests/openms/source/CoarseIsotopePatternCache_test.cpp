@@ -0,0 +1,190 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternCache.h>
+///////////////////////////
+
+#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternGenerator.h>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(CoarseIsotopePatternCache, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+CoarseIsotopePatternCache* ptr = nullptr;
+CoarseIsotopePatternCache* null_ptr = nullptr;
+START_SECTION((explicit CoarseIsotopePatternCache(Size max_entries = 100000)))
+{
+  ptr = new CoarseIsotopePatternCache();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->size(), 0)
+}
+END_SECTION
+
+START_SECTION((static CoarseIsotopePatternCache* getInstance()))
+{
+  TEST_NOT_EQUAL(CoarseIsotopePatternCache::getInstance(), null_ptr)
+  TEST_EQUAL(CoarseIsotopePatternCache::getInstance(), CoarseIsotopePatternCache::getInstance())
+}
+END_SECTION
+
+START_SECTION((IsotopeDistribution getIsotopeDistribution(const EmpiricalFormula& formula, Size max_isotope, bool round_masses = false)))
+{
+  EmpiricalFormula ef("C100H150N20O30S2");
+  IsotopeDistribution expected = ef.getIsotopeDistribution(CoarseIsotopePatternGenerator(5));
+  IsotopeDistribution result = ptr->getIsotopeDistribution(ef, 5);
+  TEST_EQUAL(ptr->size(), 1)
+  TEST_EQUAL(result == expected, true)
+  // cached
+  result = ptr->getIsotopeDistribution(ef, 5);
+  TEST_EQUAL(ptr->size(), 1)
+  TEST_EQUAL(result == expected, true)
+
+  // different settings are different entries
+  IsotopeDistribution rounded = ptr->getIsotopeDistribution(ef, 5, true);
+  TEST_EQUAL(ptr->size(), 2)
+  TEST_EQUAL(rounded == ef.getIsotopeDistribution(CoarseIsotopePatternGenerator(5, true)), true)
+  TEST_EQUAL(ptr->getIsotopeDistribution(ef, 3).size(), 3)
+  TEST_EQUAL(ptr->size(), 3)
+}
+END_SECTION
+
+START_SECTION((IsotopeDistribution getIsotopeDistribution(const String& formula, Size max_isotope, bool round_masses = false)))
+{
+  IsotopeDistribution expected = EmpiricalFormula("C6H12O6").getIsotopeDistribution(CoarseIsotopePatternGenerator(4));
+  TEST_EQUAL(ptr->getIsotopeDistribution(String("C6H12O6"), 4) == expected, true)
+  TEST_EQUAL(ptr->getIsotopeDistribution(String("C6H12O6"), 4) == expected, true)
+}
+END_SECTION
+
+START_SECTION((IsotopeDistribution estimateFromPeptideWeight(double average_weight, Size max_isotope)))
+{
+  for (double weight : {500.0, 1234.5, 2500.0, 2500.2})
+  {
+    CoarseIsotopePatternGenerator solver(6);
+    TEST_EQUAL(ptr->estimateFromPeptideWeight(weight, 6) == solver.estimateFromPeptideWeight(weight), true)
+  }
+}
+END_SECTION
+
+START_SECTION((IsotopeDistribution estimateFromPeptideWeightInterpolated(double average_weight, Size max_isotope, double bucket_width = 10.0)))
+{
+  CoarseIsotopePatternGenerator solver(4);
+  // bucket borders are exact
+  IsotopeDistribution border = ptr->estimateFromPeptideWeightInterpolated(1500.0, 4);
+  TEST_EQUAL(border == solver.estimateFromPeptideWeight(1500.0), true)
+
+  // in between: close to the exact distribution
+  IsotopeDistribution exact = solver.estimateFromPeptideWeight(1505.0);
+  IsotopeDistribution approx = ptr->estimateFromPeptideWeightInterpolated(1505.0, 4);
+  TEST_EQUAL(approx.size(), exact.size())
+  TOLERANCE_ABSOLUTE(0.01)
+  for (Size i = 0; i < approx.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(approx.getContainer()[i].getIntensity(), exact.getContainer()[i].getIntensity())
+  }
+  TOLERANCE_ABSOLUTE(1.0)
+  TEST_REAL_SIMILAR(approx.getContainer()[0].getMZ(), exact.getContainer()[0].getMZ())
+
+  TEST_EXCEPTION(Exception::InvalidValue, ptr->estimateFromPeptideWeightInterpolated(1505.0, 4, 0.0))
+}
+END_SECTION
+
+START_SECTION((void precomputeAveragine(double max_weight, Size max_isotope, double bucket_width = 10.0)))
+{
+  CoarseIsotopePatternCache cache;
+  cache.precomputeAveragine(1000.0, 3, 100.0);
+  TEST_EQUAL(cache.size() > 0, true)
+  TEST_EQUAL(cache.size() <= 11, true)
+  TEST_EXCEPTION(Exception::InvalidValue, cache.precomputeAveragine(1000.0, 3, -1.0))
+}
+END_SECTION
+
+START_SECTION((void store(const String& filename) const))
+{
+  String filename;
+  NEW_TMP_FILE(filename)
+  ptr->store(filename);
+  NOT_TESTABLE // see load()
+}
+END_SECTION
+
+START_SECTION((void load(const String& filename)))
+{
+  String filename;
+  NEW_TMP_FILE(filename)
+  ptr->store(filename);
+
+  CoarseIsotopePatternCache cache;
+  cache.load(filename);
+  TEST_EQUAL(cache.size(), ptr->size())
+  EmpiricalFormula ef("C100H150N20O30S2");
+  IsotopeDistribution expected = ef.getIsotopeDistribution(CoarseIsotopePatternGenerator(5));
+  IsotopeDistribution loaded = cache.getIsotopeDistribution(ef, 5);
+  TEST_EQUAL(cache.size(), ptr->size()) // was loaded, not computed
+  TEST_EQUAL(loaded.size(), expected.size())
+  for (Size i = 0; i < loaded.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(loaded.getContainer()[i].getMZ(), expected.getContainer()[i].getMZ())
+    TEST_REAL_SIMILAR(loaded.getContainer()[i].getIntensity(), expected.getContainer()[i].getIntensity())
+  }
+
+  TEST_EXCEPTION(Exception::FileNotFound, cache.load("this_file_does_not_exist.txt"))
+}
+END_SECTION
+
+START_SECTION((Size size() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((void clear()))
+{
+  ptr->clear();
+  TEST_EQUAL(ptr->size(), 0)
+  delete ptr;
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -0,0 +1,427 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/FORMAT/ColumnarFeatureFile.h>
+///////////////////////////
+
+#include <OpenMS/KERNEL/ConsensusMap.h>
+#include <OpenMS/KERNEL/FeatureMap.h>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(ColumnarFeatureFile, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+FeatureMap features;
+features.setUniqueId(42);
+features.setMetaValue("spectra_data", ListUtils::create<String>("a.mzML"));
+for (Size i = 0; i < 3; ++i)
+{
+  Feature f;
+  f.setRT(100.0 + i);
+  f.setMZ(500.25 + i);
+  f.setIntensity(1000.0f * (i + 1));
+  f.setCharge(Int(i) + 1);
+  f.setOverallQuality(0.5f);
+  f.setQuality(0, 0.25f);
+  f.setQuality(1, 0.75f);
+  f.setWidth(3.5f);
+  f.setUniqueId(i + 1);
+  features.push_back(f);
+}
+ConvexHull2D::PointArrayType points;
+points.push_back(ConvexHull2D::PointType(99.0, 500.0));
+points.push_back(ConvexHull2D::PointType(101.0, 500.5));
+ConvexHull2D hull;
+hull.setHullPoints(points);
+features[0].getConvexHulls().push_back(hull);
+features[0].getConvexHulls().push_back(hull);
+features[2].getConvexHulls().push_back(hull);
+features[1].setMetaValue("label", "heavy");
+features[1].setMetaValue("score", 1.5);
+features[1].setMetaValue("count", 7);
+features[2].setMetaValue("isotopes", ListUtils::create<double>("1.5,2.5"));
+features[2].setMetaValue("scans", ListUtils::create<Int>("3,4,5"));
+
+String feature_file;
+NEW_TMP_FILE(feature_file)
+
+ColumnarFeatureFile* ptr = nullptr;
+ColumnarFeatureFile* null_ptr = nullptr;
+START_SECTION((ColumnarFeatureFile()))
+{
+  ptr = new ColumnarFeatureFile();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->size(), 0)
+  TEST_EQUAL(ptr->getColumnNames().size(), 0)
+}
+END_SECTION
+
+START_SECTION((~ColumnarFeatureFile()))
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((static void store(const String& filename, const FeatureMap& map)))
+{
+  ColumnarFeatureFile::store(feature_file, features);
+  TEST_EXCEPTION(Exception::UnableToCreateFile, ColumnarFeatureFile::store("/does/not/exist/file.bin", features))
+}
+END_SECTION
+
+START_SECTION((explicit ColumnarFeatureFile(const String& filename)))
+{
+  ColumnarFeatureFile file(feature_file);
+  TEST_EQUAL(file.size(), 3)
+  TEST_EXCEPTION(Exception::FileNotFound, ColumnarFeatureFile("/does/not/exist/file.bin"))
+}
+END_SECTION
+
+START_SECTION((void open(const String& filename)))
+{
+  ColumnarFeatureFile file;
+  file.open(feature_file);
+  TEST_EQUAL(file.size(), 3)
+
+  // not a columnar file
+  String text_file;
+  NEW_TMP_FILE(text_file)
+  ofstream out(text_file.c_str());
+  out << "<?xml version=\"1.0\" encoding=\"ISO-8859-1\"?>" << endl;
+  out.close();
+  TEST_EXCEPTION(Exception::ParseError, file.open(text_file))
+}
+END_SECTION
+
+START_SECTION((MapType getMapType() const))
+{
+  ColumnarFeatureFile file(feature_file);
+  TEST_EQUAL(file.getMapType(), ColumnarFeatureFile::FEATURE_MAP)
+}
+END_SECTION
+
+START_SECTION((Size size() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((std::vector<String> getColumnNames() const))
+{
+  ColumnarFeatureFile file(feature_file);
+  vector<String> names = file.getColumnNames();
+  TEST_EQUAL(find(names.begin(), names.end(), "rt") != names.end(), true)
+  TEST_EQUAL(find(names.begin(), names.end(), "hull_point_mz") != names.end(), true)
+  TEST_EQUAL(find(names.begin(), names.end(), "handle_rt") != names.end(), false)
+}
+END_SECTION
+
+START_SECTION((bool hasColumn(const String& name) const))
+{
+  ColumnarFeatureFile file(feature_file);
+  TEST_EQUAL(file.hasColumn("mz"), true)
+  TEST_EQUAL(file.hasColumn("meta_row"), true)
+  TEST_EQUAL(file.hasColumn("peptide_ids"), false)
+}
+END_SECTION
+
+START_SECTION((void getColumn(const String& name, std::vector<double>& values, Size first = 0, Size count = std::numeric_limits<Size>::max()) const))
+{
+  ColumnarFeatureFile file(feature_file);
+  vector<double> rt;
+  file.getColumn("rt", rt);
+  TEST_EQUAL(rt.size(), 3)
+  TEST_REAL_SIMILAR(rt[0], 100.0)
+  TEST_REAL_SIMILAR(rt[2], 102.0)
+  TEST_EXCEPTION(Exception::ElementNotFound, file.getColumn("unknown", rt))
+  TEST_EXCEPTION(Exception::InvalidValue, file.getColumn("intensity", rt))
+
+  // partial reads are clipped at the end of the column
+  file.getColumn("rt", rt, 1, 1);
+  TEST_EQUAL(rt.size(), 1)
+  TEST_REAL_SIMILAR(rt[0], 101.0)
+  file.getColumn("rt", rt, 1);
+  TEST_EQUAL(rt.size(), 2)
+  TEST_REAL_SIMILAR(rt[1], 102.0)
+  file.getColumn("rt", rt, 3, 5);
+  TEST_EQUAL(rt.size(), 0)
+  TEST_EXCEPTION(Exception::IndexOverflow, file.getColumn("rt", rt, 4, 1))
+}
+END_SECTION
+
+START_SECTION((void getColumn(const String& name, std::vector<float>& values, Size first = 0, Size count = std::numeric_limits<Size>::max()) const))
+{
+  ColumnarFeatureFile file(feature_file);
+  vector<float> intensity;
+  file.getColumn("intensity", intensity);
+  TEST_EQUAL(intensity.size(), 3)
+  TEST_REAL_SIMILAR(intensity[1], 2000.0)
+}
+END_SECTION
+
+START_SECTION((void getColumn(const String& name, std::vector<Int32>& values, Size first = 0, Size count = std::numeric_limits<Size>::max()) const))
+{
+  ColumnarFeatureFile file(feature_file);
+  vector<Int32> charge;
+  file.getColumn("charge", charge);
+  TEST_EQUAL(charge.size(), 3)
+  TEST_EQUAL(charge[2], 3)
+}
+END_SECTION
+
+START_SECTION((void getColumn(const String& name, std::vector<Int64>& values, Size first = 0, Size count = std::numeric_limits<Size>::max()) const))
+{
+  ColumnarFeatureFile file(feature_file);
+  vector<Int64> ints;
+  file.getColumn("meta_int", ints);
+  TEST_EQUAL(ints.size(), 4) // "count" and "scans"
+}
+END_SECTION
+
+START_SECTION((void getColumn(const String& name, std::vector<UInt32>& values, Size first = 0, Size count = std::numeric_limits<Size>::max()) const))
+{
+  ColumnarFeatureFile file(feature_file);
+  vector<UInt32> keys;
+  file.getColumn("meta_key", keys);
+  TEST_EQUAL(keys.size(), 6) // sparse: one row per meta value
+}
+END_SECTION
+
+START_SECTION((void getColumn(const String& name, std::vector<UInt64>& values, Size first = 0, Size count = std::numeric_limits<Size>::max()) const))
+{
+  ColumnarFeatureFile file(feature_file);
+  vector<UInt64> ids;
+  file.getColumn("unique_id", ids);
+  TEST_EQUAL(ids.size(), 3)
+  TEST_EQUAL(ids[1], 2)
+  vector<UInt64> rows;
+  file.getColumn("meta_row", rows);
+  TEST_EQUAL(rows.size(), 6)
+  TEST_EQUAL(rows[0], 1)
+  TEST_EQUAL(rows.back(), ColumnarFeatureFile::MAP_ROW)
+}
+END_SECTION
+
+START_SECTION((void getColumn(const String& name, std::vector<String>& values, Size first = 0, Size count = std::numeric_limits<Size>::max()) const))
+{
+  ColumnarFeatureFile file(feature_file);
+  vector<String> keys;
+  file.getColumn("meta_key_name", keys);
+  TEST_EQUAL(keys.size(), 6)
+  vector<String> strings;
+  file.getColumn("meta_string", strings);
+  TEST_EQUAL(strings.size(), 2)
+  TEST_EQUAL(find(strings.begin(), strings.end(), "heavy") != strings.end(), true)
+  vector<String> part;
+  file.getColumn("meta_key_name", part, 2, 3);
+  TEST_EQUAL(part.size(), 3)
+  TEST_EQUAL(part[0], keys[2])
+  TEST_EQUAL(part[2], keys[4])
+}
+END_SECTION
+
+START_SECTION((Size getColumnSize(const String& name) const))
+{
+  ColumnarFeatureFile file(feature_file);
+  TEST_EQUAL(file.getColumnSize("mz"), 3)
+  TEST_EQUAL(file.getColumnSize("meta_row"), 6)
+  TEST_EQUAL(file.getColumnSize("hull_begin"), 4)
+  TEST_EXCEPTION(Exception::ElementNotFound, file.getColumnSize("unknown"))
+}
+END_SECTION
+
+START_SECTION((void loadRange(Size first, Size count, FeatureMap& map) const))
+{
+  ColumnarFeatureFile file(feature_file);
+  FeatureMap part;
+  file.loadRange(1, 2, part);
+  TEST_EQUAL(part.size(), 2)
+  TEST_REAL_SIMILAR(part[0].getRT(), 101.0)
+  TEST_EQUAL(part[0].getUniqueId(), 2)
+  TEST_EQUAL(part[0].getConvexHulls().size(), 0)
+  TEST_EQUAL(part[0].getMetaValue("label"), "heavy")
+  TEST_EQUAL(part[0].getMetaValue("count"), 7)
+  TEST_EQUAL(part[1].getConvexHulls().size(), 1)
+  TEST_EQUAL(part[1].getConvexHulls()[0].getHullPoints().size(), 2)
+  TEST_REAL_SIMILAR(part[1].getConvexHulls()[0].getHullPoints()[1][0], 101.0)
+  TEST_EQUAL(part[1].getMetaValue("scans").toIntList().size(), 3)
+  TEST_EQUAL(part.metaValueExists("spectra_data"), false) // map data is not loaded
+  TEST_REAL_SIMILAR(part.getMin()[0], 101.0)
+
+  file.loadRange(0, 1, part);
+  TEST_EQUAL(part.size(), 1)
+  TEST_EQUAL(part[0].getConvexHulls().size(), 2)
+  TEST_EQUAL(part[0].isMetaEmpty(), true)
+  file.loadRange(2, 10, part);
+  TEST_EQUAL(part.size(), 1)
+  TEST_EQUAL(part[0].getUniqueId(), 3)
+  file.loadRange(3, 1, part);
+  TEST_EQUAL(part.size(), 0)
+  TEST_EXCEPTION(Exception::IndexOverflow, file.loadRange(4, 1, part))
+}
+END_SECTION
+
+START_SECTION((static void load(const String& filename, FeatureMap& map)))
+{
+  FeatureMap loaded;
+  ColumnarFeatureFile::load(feature_file, loaded);
+  TEST_EQUAL(loaded.size(), 3)
+  TEST_EQUAL(loaded.getUniqueId(), 42)
+  StringList runs;
+  loaded.getPrimaryMSRunPath(runs);
+  TEST_EQUAL(runs.size(), 1)
+  TEST_EQUAL(runs[0], "a.mzML")
+  for (Size i = 0; i < 3; ++i)
+  {
+    TEST_REAL_SIMILAR(loaded[i].getRT(), features[i].getRT())
+    TEST_REAL_SIMILAR(loaded[i].getMZ(), features[i].getMZ())
+    TEST_REAL_SIMILAR(loaded[i].getIntensity(), features[i].getIntensity())
+    TEST_EQUAL(loaded[i].getCharge(), features[i].getCharge())
+    TEST_REAL_SIMILAR(loaded[i].getOverallQuality(), 0.5)
+    TEST_REAL_SIMILAR(loaded[i].getQuality(0), 0.25)
+    TEST_REAL_SIMILAR(loaded[i].getQuality(1), 0.75)
+    TEST_REAL_SIMILAR(loaded[i].getWidth(), 3.5)
+    TEST_EQUAL(loaded[i].getUniqueId(), i + 1)
+    TEST_EQUAL(loaded[i].getConvexHulls().size(), features[i].getConvexHulls().size())
+  }
+  TEST_EQUAL(loaded[0].getConvexHulls()[1].getHullPoints().size(), 2)
+  TEST_REAL_SIMILAR(loaded[0].getConvexHulls()[1].getHullPoints()[1].getX(), 101.0)
+  TEST_REAL_SIMILAR(loaded[0].getConvexHulls()[1].getHullPoints()[1].getY(), 500.5)
+  TEST_EQUAL(loaded[0].isMetaEmpty(), true)
+  TEST_EQUAL(loaded[1].getMetaValue("label"), "heavy")
+  TEST_REAL_SIMILAR(loaded[1].getMetaValue("score"), 1.5)
+  TEST_EQUAL(loaded[1].getMetaValue("count").valueType(), DataValue::INT_VALUE)
+  TEST_EQUAL(Int(loaded[1].getMetaValue("count")), 7)
+  TEST_EQUAL(loaded[2].getMetaValue("isotopes").toDoubleList().size(), 2)
+  TEST_REAL_SIMILAR(loaded[2].getMetaValue("isotopes").toDoubleList()[1], 2.5)
+  TEST_EQUAL(loaded[2].getMetaValue("scans").toIntList().size(), 3)
+  TEST_EQUAL(loaded[2].getMetaValue("scans").toIntList()[2], 5)
+  TEST_REAL_SIMILAR(loaded.getMin()[0], 99.0) // ranges are updated (convex hulls)
+
+  ConsensusMap wrong_type;
+  TEST_EXCEPTION(Exception::ParseError, ColumnarFeatureFile::load(feature_file, wrong_type))
+
+  // empty map
+  String empty_file;
+  NEW_TMP_FILE(empty_file)
+  ColumnarFeatureFile::store(empty_file, FeatureMap());
+  ColumnarFeatureFile::load(empty_file, loaded);
+  TEST_EQUAL(loaded.size(), 0)
+}
+END_SECTION
+
+ConsensusMap consensus;
+consensus.setUniqueId(7);
+consensus.setExperimentType("labeled_MS1");
+consensus.getColumnHeaders()[0].filename = "light.featureXML";
+consensus.getColumnHeaders()[0].label = "light";
+consensus.getColumnHeaders()[0].size = 3;
+consensus.getColumnHeaders()[0].unique_id = 11;
+consensus.getColumnHeaders()[1].filename = "heavy.featureXML";
+consensus.getColumnHeaders()[1].label = "heavy";
+consensus.getColumnHeaders()[1].size = 3;
+consensus.getColumnHeaders()[1].unique_id = 12;
+for (Size i = 0; i < 2; ++i)
+{
+  ConsensusFeature cf;
+  cf.setRT(10.0 * (i + 1));
+  cf.setMZ(400.0 + i);
+  cf.setIntensity(50.0f);
+  cf.setCharge(2);
+  cf.setQuality(0.9f);
+  cf.setUniqueId(100 + i);
+  cf.insert(0, features[i]);
+  if (i == 0) cf.insert(1, features[2]);
+  consensus.push_back(cf);
+}
+consensus[1].setMetaValue("note", "single");
+
+String consensus_file;
+NEW_TMP_FILE(consensus_file)
+
+START_SECTION((static void store(const String& filename, const ConsensusMap& map)))
+{
+  ColumnarFeatureFile::store(consensus_file, consensus);
+  ColumnarFeatureFile file(consensus_file);
+  TEST_EQUAL(file.getMapType(), ColumnarFeatureFile::CONSENSUS_MAP)
+  TEST_EQUAL(file.size(), 2)
+  TEST_EQUAL(file.hasColumn("handle_map_index"), true)
+  TEST_EQUAL(file.hasColumn("hull_begin"), false)
+}
+END_SECTION
+
+START_SECTION((static void load(const String& filename, ConsensusMap& map)))
+{
+  ConsensusMap loaded;
+  ColumnarFeatureFile::load(consensus_file, loaded);
+  TEST_EQUAL(loaded.size(), 2)
+  TEST_EQUAL(loaded.getUniqueId(), 7)
+  TEST_EQUAL(loaded.getExperimentType(), "labeled_MS1")
+  TEST_EQUAL(loaded.getColumnHeaders().size(), 2)
+  TEST_EQUAL(loaded.getColumnHeaders()[1].filename, "heavy.featureXML")
+  TEST_EQUAL(loaded.getColumnHeaders()[1].label, "heavy")
+  TEST_EQUAL(loaded.getColumnHeaders()[1].size, 3)
+  TEST_EQUAL(loaded.getColumnHeaders()[1].unique_id, 12)
+  TEST_REAL_SIMILAR(loaded[1].getRT(), 20.0)
+  TEST_REAL_SIMILAR(loaded[1].getMZ(), 401.0)
+  TEST_REAL_SIMILAR(loaded[1].getQuality(), 0.9)
+  TEST_EQUAL(loaded[1].getUniqueId(), 101)
+  TEST_EQUAL(loaded[1].getMetaValue("note"), "single")
+  TEST_EQUAL(loaded[0].size(), 2)
+  TEST_EQUAL(loaded[1].size(), 1)
+  const FeatureHandle& handle = *loaded[0].getFeatures().rbegin();
+  TEST_EQUAL(handle.getMapIndex(), 1)
+  TEST_EQUAL(handle.getUniqueId(), 3)
+  TEST_REAL_SIMILAR(handle.getRT(), 102.0)
+  TEST_REAL_SIMILAR(handle.getMZ(), 502.25)
+  TEST_REAL_SIMILAR(handle.getIntensity(), 3000.0)
+  TEST_EQUAL(handle.getCharge(), 3)
+
+  FeatureMap wrong_type;
+  TEST_EXCEPTION(Exception::ParseError, ColumnarFeatureFile::load(consensus_file, wrong_type))
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
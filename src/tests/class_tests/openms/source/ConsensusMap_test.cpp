@@ -338,6 +338,77 @@ START_SECTION((ConsensusMap& appendColumns(const ConsensusMap &rhs)))
 }
 END_SECTION
 
+// maps for the bulk append tests: two columns each, identifications referencing both
+vector<ConsensusMap> bulk_maps(3);
+for (Size i = 0; i < bulk_maps.size(); ++i)
+{
+  ConsensusMap& m = bulk_maps[i];
+  m.getColumnHeaders()[0].filename = String("m") + i + "_1";
+  m.getColumnHeaders()[0].size = 1;
+  m.getColumnHeaders()[1].filename = String("m") + i + "_2";
+  m.getColumnHeaders()[1].size = 1;
+  m.getDataProcessing().resize(1);
+  m.getProteinIdentifications().resize(1);
+  m.getProteinIdentifications()[0].getSearchParameters().variable_modifications.push_back("Oxidation (M)");
+  m.getUnassignedPeptideIdentifications().resize(1);
+  m.getUnassignedPeptideIdentifications()[0].setMetaValue("map_index", 1);
+
+  Feature f;
+  f.setMZ(100.0 + i);
+  f.setUniqueId(10 + i);
+  ConsensusFeature cf;
+  cf.insert(0, f, 0);
+  cf.insert(1, f, 1);
+  cf.setMZ(100.0 + i);
+  cf.setUniqueId(i + 1);
+  cf.getPeptideIdentifications().resize(1);
+  cf.getPeptideIdentifications()[0].setMetaValue("map_index", 0);
+  m.push_back(cf);
+}
+
+START_SECTION((ConsensusMap& appendRows(std::vector<ConsensusMap>&& maps)))
+{
+  ConsensusMap expected = bulk_maps[0];
+  for (Size i = 1; i < bulk_maps.size(); ++i) expected.appendRows(bulk_maps[i]);
+
+  ConsensusMap m1 = bulk_maps[0];
+  m1.setIdentifier("123");
+  vector<ConsensusMap> maps(bulk_maps.begin() + 1, bulk_maps.end());
+  m1.appendRows(std::move(maps));
+  TEST_EQUAL(maps.empty(), true)
+  TEST_EQUAL(m1.getIdentifier(), "")
+  TEST_EQUAL(m1.size(), 3)
+  TEST_EQUAL(m1 == expected, true)
+  TEST_EQUAL(m1.getProteinIdentifications()[0].getSearchParameters().variable_modifications.size(), 1)
+  TEST_EQUAL(m1.uniqueIdToIndex(3), 2)
+
+  // appending nothing
+  m1.appendRows(vector<ConsensusMap>());
+  TEST_EQUAL(m1 == expected, true)
+}
+END_SECTION
+
+START_SECTION((ConsensusMap& appendColumns(std::vector<ConsensusMap>&& maps)))
+{
+  ConsensusMap expected = bulk_maps[0];
+  for (Size i = 1; i < bulk_maps.size(); ++i) expected.appendColumns(bulk_maps[i]);
+
+  ConsensusMap m1 = bulk_maps[0];
+  vector<ConsensusMap> maps(bulk_maps.begin() + 1, bulk_maps.end());
+  m1.appendColumns(std::move(maps));
+  TEST_EQUAL(maps.empty(), true)
+  TEST_EQUAL(m1 == expected, true)
+  TEST_EQUAL(m1.getColumnHeaders().size(), 6)
+  TEST_EQUAL(m1.getColumnHeaders()[5].filename, "m2_2")
+  ABORT_IF(m1.size() != 3)
+  TEST_EQUAL(m1[2].getFeatures().begin()->getMapIndex(), 4)
+  TEST_EQUAL(m1[2].getFeatures().rbegin()->getMapIndex(), 5)
+  TEST_EQUAL(m1[2].getPeptideIdentifications()[0].getMetaValue("map_index"), 4)
+  TEST_EQUAL(m1.getUnassignedPeptideIdentifications()[2].getMetaValue("map_index"), 5)
+  TEST_EQUAL(m1.uniqueIdToIndex(2), 1)
+}
+END_SECTION
+
 
 START_SECTION((ConsensusMap& operator = (const ConsensusMap& source)))
   ConsensusMap map1;
@@ -42,6 +42,16 @@
 using namespace OpenMS;
 using namespace std;
 
+// gives access to both ways of computing the transform of resampled data
+class TestCWT :
+  public ContinuousWaveletTransformNumIntegration
+{
+public:
+  using ContinuousWaveletTransformNumIntegration::integrate_;
+  using ContinuousWaveletTransformNumIntegration::integrateFFT_;
+  using ContinuousWaveletTransformNumIntegration::useFFT_;
+};
+
 START_TEST(ContinuousWaveletTransformNumIntegration, "$Id$")
 
 /////////////////////////////////////////////////////////////
@@ -82,6 +92,55 @@ START_SECTION((template <typename InputPeakIterator> void transform(InputPeakIte
   TEST_REAL_SIMILAR(transformer.getWavelet()[0],1.)
   TEST_REAL_SIMILAR(transformer.getScale(),scale)
   TEST_REAL_SIMILAR(transformer.getSpacing(),spacing)
+
+  // calling init() again does not extend the wavelet
+  Size wavelet_size = transformer.getWavelet().size();
+  transformer.init(scale, spacing);
+  TEST_EQUAL(transformer.getWavelet().size(), wavelet_size)
+END_SECTION
+
+START_SECTION([EXTRA] transform of resampled data using the FFT)
+  TestCWT transformer;
+  transformer.init(0.1, 0.001);
+  TEST_EQUAL(transformer.useFFT_(0.1), false)
+  TEST_EQUAL(transformer.useFFT_(0.001), true)
+
+  // same result as the direct integration, including the borders
+  for (Size n : {1, 2, 10, 300, 3000})
+  {
+    std::vector<double> data(n);
+    for (Size i = 0; i < n; ++i)
+    {
+      data[i] = (i * 7919) % 101;
+    }
+    std::vector<double> result;
+    transformer.integrateFFT_(data, 0.0007, result);
+    TEST_EQUAL(result.size(), n)
+    TOLERANCE_ABSOLUTE(1e-6)
+    for (Size i = 0; i < n; ++i)
+    {
+      TEST_REAL_SIMILAR(result[i], transformer.integrate_(data, 0.0007, (int)i))
+    }
+  }
+
+  // transform() with resolution > 1 uses the FFT for wide wavelets
+  std::vector<Peak1D> raw_data(200);
+  for (Size i = 0; i < raw_data.size(); ++i)
+  {
+    raw_data[i].setMZ(500.0 + i * 0.002);
+    raw_data[i].setIntensity(100.0f * exp(-pow((i - 100.0) / 20.0, 2)));
+  }
+  transformer.transform(raw_data.begin(), raw_data.end(), 2.);
+  TEST_EQUAL(transformer.getSignal().size(), 400)
+  TOLERANCE_ABSOLUTE(1e-3)
+  TEST_REAL_SIMILAR(transformer.getSignal()[0].getMZ(), 500.0)
+  std::vector<double> resampled(400);
+  for (Size i = 0; i < resampled.size(); ++i)
+  {
+    resampled[i] = transformer.getSignal()[i].getIntensity();
+  }
+  Size max_pos = std::max_element(resampled.begin(), resampled.end()) - resampled.begin();
+  TEST_EQUAL(max_pos >= 198 && max_pos <= 202, true)
 END_SECTION
 
 /////////////////////////////////////////////////////////////
@@ -70,6 +70,13 @@ START_SECTION(void loadFromOBO(const String &name, const String &filename))
 	TEST_EQUAL(cv.name(),"bla")
 END_SECTION
 
+START_SECTION(static const ControlledVocabulary& getPSIMSCV())
+	const ControlledVocabulary& psi_ms = ControlledVocabulary::getPSIMSCV();
+	TEST_EQUAL(psi_ms.exists("MS:1000514"), true) // m/z array
+	TEST_EQUAL(psi_ms.exists("UO:0000010"), true) // second
+	TEST_EQUAL(&psi_ms == &ControlledVocabulary::getPSIMSCV(), true) // loaded only once
+END_SECTION
+
 START_SECTION(bool exists(const String& id) const)
 	TEST_EQUAL(cv.exists("OpenMS:1"),true)
 	TEST_EQUAL(cv.exists("OpenMS:2"),true)
@@ -156,6 +163,9 @@ START_SECTION(bool isChildOf(const String& child, const String& parent) const)
 	TEST_EQUAL(cv.isChildOf("OpenMS:4","OpenMS:6"),false)
 	TEST_EQUAL(cv.isChildOf("OpenMS:2","OpenMS:6"),false)
 	TEST_EQUAL(cv.isChildOf("OpenMS:2","OpenMS:3"),false)
+	TEST_EQUAL(cv.isChildOf("OpenMS:6","OpenMS:1"),true) // indirect
+	TEST_EQUAL(cv.isChildOf("OpenMS:2","OpenMS:2"),false)
+	TEST_EQUAL(cv.isChildOf("OpenMS:2","OpenMS:7"),false) // unknown parent
 	TEST_EXCEPTION(Exception::InvalidValue, cv.isChildOf("OpenMS:7","OpenMS:3"))
 END_SECTION
 
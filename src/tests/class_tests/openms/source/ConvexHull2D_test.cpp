@@ -40,6 +40,8 @@
 
 #include <OpenMS/DATASTRUCTURES/ConvexHull2D.h>
 
+#include <algorithm>
+
 ///////////////////////////
 
 START_TEST(ConvexHull2D, "$Id$")
@@ -176,6 +178,46 @@ START_SECTION((bool encloses(const PointType& point) const))
 	TEST_EQUAL(tmp.encloses(DPosition<2>(5.0,0.0)),true)
 END_SECTION
 
+START_SECTION((void encloses(const PointArrayType& points, std::vector<bool>& result) const))
+	ConvexHull2D tmp;
+	vector<bool> result;
+	ConvexHull2D::PointArrayType points;
+	points.push_back(DPosition<2>(1.0,1.0));
+	// setting hull points alone does not allow to query encloses()
+	tmp.setHullPoints(vec2);
+	TEST_EXCEPTION(Exception::NotImplemented, tmp.encloses(points, result))
+
+	tmp.addPoints(vec);
+	tmp.addPoints(vec2);
+	points.clear();
+	points.push_back(DPosition<2>(3.0,3.0));
+	points.push_back(DPosition<2>(0.0,0.0));
+	points.push_back(DPosition<2>(6.0,0.0));
+	points.push_back(DPosition<2>(0.0,6.0));
+	points.push_back(DPosition<2>(1.5,1.5));
+	points.push_back(DPosition<2>(1.0,1.0));
+	points.push_back(DPosition<2>(1.1,1.0));
+	points.push_back(DPosition<2>(1.2,2.5));
+	points.push_back(DPosition<2>(1.2,3.21));
+	points.push_back(DPosition<2>(1.4,0.99));
+	points.push_back(DPosition<2>(2.5,1.2));
+	points.push_back(DPosition<2>(1.0,1.1));
+	points.push_back(DPosition<2>(3.0,1.0));
+	points.push_back(DPosition<2>(5.0,0.0));
+	tmp.encloses(points, result);
+	TEST_EQUAL(result.size(), points.size())
+	for (Size i = 0; i < points.size(); ++i)
+	{
+		TEST_EQUAL(bool(result[i]), tmp.encloses(points[i]))
+	}
+
+	// empty hull
+	ConvexHull2D empty;
+	empty.encloses(points, result);
+	TEST_EQUAL(result.size(), points.size())
+	TEST_EQUAL(std::count(result.begin(), result.end(), true), 0)
+END_SECTION
+
 START_SECTION((bool operator==(const ConvexHull2D& rhs) const))
 	ConvexHull2D tmp,tmp2;
 	tmp.setHullPoints(vec2);
@@ -238,6 +280,16 @@ START_SECTION((DBoundingBox<2> getBoundingBox() const))
 	TEST_REAL_SIMILAR(bb.minPosition()[1],2.0)
 	TEST_REAL_SIMILAR(bb.maxPosition()[0],3.0)
 	TEST_REAL_SIMILAR(bb.maxPosition()[1],4.0)
+
+	// added points replace the hull points
+	tmp.addPoint(DPosition<2>(2.0,5.0));
+	bb = tmp.getBoundingBox();
+	TEST_REAL_SIMILAR(bb.minPosition()[0],2.0)
+	TEST_REAL_SIMILAR(bb.minPosition()[1],5.0)
+	TEST_REAL_SIMILAR(bb.maxPosition()[0],2.0)
+	TEST_REAL_SIMILAR(bb.maxPosition()[1],5.0)
+	tmp.clear();
+	TEST_EQUAL(tmp.getBoundingBox().isEmpty(), true)
 END_SECTION
 
 START_SECTION((bool addPoint(const PointType& point)))
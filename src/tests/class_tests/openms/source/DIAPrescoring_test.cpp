@@ -36,12 +36,35 @@
 #include <OpenMS/test_config.h>
 
 #include <OpenMS/ANALYSIS/OPENSWATH/DIAPrescoring.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessOpenMS.h>
 #include "OpenMS/OPENSWATHALGO/DATAACCESS/MockObjects.h"
 
+#include <numeric>
+
 using namespace std;
 using namespace OpenMS;
 using namespace OpenSwath;
 
+// collects the rows written by DiaPrescore::operator()
+struct TestDataFrameWriter :
+  public OpenSwath::IDataFrameWriter
+{
+  std::vector<std::string> colnames_;
+  std::vector<std::string> rownames_;
+  std::vector<std::vector<double> > rows_;
+
+  void colnames(const std::vector<std::string>& colnames) override
+  {
+    colnames_ = colnames;
+  }
+
+  void store(const std::string& rowname, const std::vector<double>& values) override
+  {
+    rownames_.push_back(rowname);
+    rows_.push_back(values);
+  }
+};
+
 
 START_TEST(DiaPrescore2, "$Id$")
 
@@ -137,6 +160,102 @@ START_SECTION ( testscorefunction)
 }
 END_SECTION
 
+START_SECTION(void computeTheoreticalSpectrum(const std::vector<OpenSwath::LightTransition>& lt, TheoreticalSpectrum& theo) const)
+{
+  OpenSwath::LightTransition mock_tr1;
+  mock_tr1.product_mz = 500.;
+  mock_tr1.fragment_charge = 1;
+  mock_tr1.library_intensity = 5.;
+  OpenSwath::LightTransition mock_tr2 = mock_tr1;
+  mock_tr2.product_mz = 600.;
+
+  std::vector<OpenSwath::LightTransition> transitions;
+  transitions.push_back(mock_tr1);
+  transitions.push_back(mock_tr2);
+
+  DiaPrescore diaprescore(0.05);
+  DiaPrescore::TheoreticalSpectrum theo;
+  diaprescore.computeTheoreticalSpectrum(transitions, theo);
+
+  TEST_EQUAL(theo.masses.empty(), false)
+  TEST_EQUAL(std::is_sorted(theo.masses.begin(), theo.masses.end()), true)
+  TEST_EQUAL(theo.manhattan_intensities.size(), theo.masses.size())
+  TEST_EQUAL(theo.dotprod_intensities.size(), theo.masses.size())
+  TEST_REAL_SIMILAR(std::accumulate(theo.manhattan_intensities.begin(), theo.manhattan_intensities.end(), 0.0), 1.0)
+  TEST_REAL_SIMILAR(theo.empty_manhattan, 1.0)
+}
+END_SECTION
+
+START_SECTION(void operator()(OpenSwath::SpectrumAccessPtr swath_ptr, OpenSwath::LightTargetedExperiment& transition_exp_used, OpenSwath::IDataFrameWriter* ivw))
+{
+  // two transition groups, the second one outside the m/z range of all spectra
+  OpenSwath::LightTargetedExperiment exp;
+  OpenSwath::LightTransition tr;
+  tr.fragment_charge = 1;
+  tr.library_intensity = 5.;
+  tr.peptide_ref = "pep1";
+  tr.product_mz = 500.;
+  exp.transitions.push_back(tr);
+  tr.product_mz = 600.;
+  exp.transitions.push_back(tr);
+  tr.peptide_ref = "pep2";
+  tr.product_mz = 1000.;
+  exp.transitions.push_back(tr);
+
+  // spectra with signal at 600 Th, signal at 100 Th only and without any peaks
+  boost::shared_ptr<PeakMap> map(new PeakMap);
+  MSSpectrum s;
+  s.setRT(10.0);
+  for (double mz = 599.97; mz < 603.02; mz += 0.01)
+  {
+    s.push_back(Peak1D(mz, 10.0));
+  }
+  map->addSpectrum(s);
+  s.clear(true);
+  s.setRT(20.0);
+  s.push_back(Peak1D(100.0, 10.0));
+  s.push_back(Peak1D(101.0, 10.0));
+  map->addSpectrum(s);
+  s.clear(true);
+  s.setRT(30.0);
+  map->addSpectrum(s);
+  OpenSwath::SpectrumAccessPtr swath_ptr(new SpectrumAccessOpenMS(map));
+
+  DiaPrescore diaprescore(0.05);
+  TestDataFrameWriter writer;
+  diaprescore(swath_ptr, exp, &writer);
+
+  TEST_EQUAL(writer.colnames_.size(), 2)
+  ABORT_IF(writer.colnames_.size() != 2)
+  TEST_EQUAL(writer.colnames_[0], "pep1")
+  TEST_EQUAL(writer.colnames_[1], "pep2")
+  TEST_EQUAL(writer.rows_.size(), 6)
+  ABORT_IF(writer.rows_.size() != 6)
+  TEST_EQUAL(writer.rownames_[0], "score1_10")
+  TEST_EQUAL(writer.rownames_[1], "score2_10")
+  TEST_EQUAL(writer.rownames_[5], "score2_30")
+
+  // same scores as scoring each spectrum against each group separately
+  std::vector<std::vector<OpenSwath::LightTransition> > groups(2);
+  groups[0].push_back(exp.transitions[0]);
+  groups[0].push_back(exp.transitions[1]);
+  groups[1].push_back(exp.transitions[2]);
+  for (Size i = 0; i < 3; ++i)
+  {
+    for (Size g = 0; g < 2; ++g)
+    {
+      double dotprod = 0., manhattan = 0.;
+      diaprescore.score(swath_ptr->getSpectrumById(i), groups[g], dotprod, manhattan);
+      TEST_REAL_SIMILAR(writer.rows_[2 * i][g], dotprod)
+      TEST_REAL_SIMILAR(writer.rows_[2 * i + 1][g], manhattan)
+    }
+  }
+  TEST_EQUAL(writer.rows_[0][0] > 0.0, true)
+  TEST_REAL_SIMILAR(writer.rows_[2][0], 0.0)
+  TEST_REAL_SIMILAR(writer.rows_[3][0], 1.0)
+}
+END_SECTION
+
 
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
@@ -417,6 +417,33 @@ START_SECTION(double Loss_function(
 }
 END_SECTION
 
+START_SECTION(double Loss_and_gradients(
+  const std::vector<double>& xs,
+  const std::vector<double>& ys,
+  const double h,
+  const double mu,
+  const double sigma,
+  const double tau,
+  double& diff_E_h,
+  double& diff_E_mu,
+  double& diff_E_sigma,
+  double& diff_E_tau
+) const)
+{
+  EmgGradientDescent_friend emg_f;
+  const std::vector<double> xs { 2.5, 2.6, 2.7, 2.8, 2.9, 3.0 };
+  const std::vector<double> ys { 100.0, 400.0, 900.0, 700.0, 300.0, 150.0 };
+  double diff_E_h, diff_E_mu, diff_E_sigma, diff_E_tau;
+  const double E = emg_f.Loss_and_gradients(xs, ys, 1000.0, 2.7, 0.1, 0.15, diff_E_h, diff_E_mu, diff_E_sigma, diff_E_tau);
+  TEST_REAL_SIMILAR(E, 40623.678)
+  TEST_REAL_SIMILAR(E, emg_f.Loss_function(xs, ys, 1000.0, 2.7, 0.1, 0.15))
+  TEST_REAL_SIMILAR(diff_E_h, -39.63834995)
+  TEST_REAL_SIMILAR(diff_E_mu, 832567.053)
+  TEST_REAL_SIMILAR(diff_E_sigma, -257560.4314)
+  TEST_REAL_SIMILAR(diff_E_tau, 392620.6568)
+}
+END_SECTION
+
 START_SECTION(void extractTrainingSet(
   const std::vector<double>& xs,
   const std::vector<double>& ys,
@@ -43,6 +43,40 @@
 using namespace OpenMS;
 using namespace std;
 
+// exposes the tokenizer and a reference implementation via the enzyme's regex
+class EnzymaticDigestionTester :
+  public EnzymaticDigestion
+{
+public:
+  std::vector<int> tokenize(const String& sequence, int start, int end) const
+  {
+    return tokenize_(sequence, start, end);
+  }
+
+  std::vector<int> tokenizeByRegex(const String& sequence, int start, int end) const
+  {
+    std::vector<int> positions;
+    if (enzyme_->getRegEx() == "()")
+    {
+      positions.push_back(start);
+      return positions;
+    }
+    boost::sregex_token_iterator i(sequence.begin() + start, sequence.begin() + end, re_, -1);
+    boost::sregex_token_iterator j;
+    for (; i != j; ++i)
+    {
+      positions.push_back(start);
+      start += (int)i->length();
+    }
+    return positions;
+  }
+
+  bool usesSiteRules() const
+  {
+    return !site_rules_.empty();
+  }
+};
+
 ///////////////////////////
 
 START_TEST(EnzymaticDigestion, "$Id$")
@@ -504,6 +538,35 @@ START_SECTION([EXTRA] Size countMissedCleavages_(const std::vector<int>& cleavag
   TEST_EQUAL(ed.isValidProduct("KKKK", 0, 4, false), true);  // has 3 MC's, should be valid
 END_SECTION
 
+START_SECTION([EXTRA] std::vector<int> tokenize_(const String& sequence, int start, int end) const)
+{
+  EnzymaticDigestionTester ed;
+  TEST_EQUAL(ed.usesSiteRules(), true); // Trypsin: '(?<=[KR])(?!P)'
+
+  // cleavage sites found without the regex engine must be identical to the regex results, for all enzymes
+  vector<String> names;
+  ProteaseDB::getInstance()->getAllNames(names);
+  const String sequences[] = {"", "K", "P", "KP", "PK", "KKKK", "DDAD", "ACDEFGHIKLMNPQRSTVWY", "MKWVTFISLLFLFSSAYSRGVFRRDAHKSEVAHRFKDLGEENFKALVLIAFAQYLQQCPFEDHVKLVNEVTEFAKTCVADESAENCDKS"};
+  Size mismatches = 0;
+  for (const String& name : names)
+  {
+    ed.setEnzyme(ProteaseDB::getInstance()->getEnzyme(name));
+    for (const String& seq : sequences)
+    {
+      for (int start = 0; start <= (int)seq.size(); start += 3)
+      {
+        for (int end = start; end <= (int)seq.size(); end += 2)
+        {
+          if (ed.tokenize(seq, start, end) != ed.tokenizeByRegex(seq, start, end)) ++mismatches;
+        }
+        if (ed.tokenize(seq, start, -1) != ed.tokenizeByRegex(seq, start, (int)seq.size())) ++mismatches;
+      }
+    }
+  }
+  TEST_EQUAL(mismatches, 0)
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -128,6 +128,36 @@ START_SECTION(RETURNSTATE run(const QString& exe, const QStringList& args, const
 }
 END_SECTION
 
+START_SECTION(RETURNSTATE start(const QString& exe, const QStringList& args, const QString& working_dir, const bool verbose, String& error_msg))
+{
+  String all_out;
+  auto l_out = [&](const String& out) {all_out += out;};
+  auto l_err = [&](const String& /*out*/) {};
+  // two processes at the same time
+  ExternalProcess ep1(l_out, l_err), ep2;
+  String error_msg;
+  TEST_EQUAL(ep1.start(exe, args, "", false, error_msg) == ExternalProcess::RETURNSTATE::SUCCESS, true)
+  TEST_EQUAL(ep2.start(exe, args_broken, "", false, error_msg) == ExternalProcess::RETURNSTATE::SUCCESS, true)
+  while (ep1.isRunning(10) || ep2.isRunning(10)) {}
+  TEST_EQUAL(ep1.getResult(false, error_msg) == ExternalProcess::RETURNSTATE::SUCCESS, true)
+  TEST_EQUAL(error_msg.size(), 0)
+  TEST_NOT_EQUAL(all_out.size(), 0)
+  TEST_EQUAL(ep2.getResult(false, error_msg) == ExternalProcess::RETURNSTATE::NONZERO_EXIT, true)
+  TEST_NOT_EQUAL(error_msg.size(), 0)
+
+  TEST_EQUAL(ep2.start("this_exe_does_not_exist", args, "", false, error_msg) == ExternalProcess::RETURNSTATE::FAILED_TO_START, true)
+  TEST_NOT_EQUAL(error_msg.size(), 0)
+}
+END_SECTION
+
+START_SECTION(bool isRunning(int msecs = 50))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION(RETURNSTATE getResult(const bool verbose, String& error_msg))
+  NOT_TESTABLE // tested above
+END_SECTION
+
 START_SECTION(ExternalProcess::RETURNSTATE run(QWidget* parent, const QString& exe, const QStringList& args, const QString& working_dir, const bool verbose = false))
  NOT_TESTABLE // tested above..
 END_SECTION
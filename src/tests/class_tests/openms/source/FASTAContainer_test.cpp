@@ -219,6 +219,84 @@ START_SECTION(size_t size() const)
   TEST_EQUAL(pe6.description, "This is the description of the second protein")
 
 END_SECTION
+
+START_SECTION([TFI_MMap] bool cacheChunk(int suggested_size))
+  // same entries as FCFile, but the total size is known upfront
+  FASTAContainer<TFI_MMap> m(OPENMS_GET_TEST_DATA_PATH("FASTAFile_test.fasta"));
+  FCFile f(OPENMS_GET_TEST_DATA_PATH("FASTAFile_test.fasta"));
+  TEST_EQUAL(m.size(), 5)
+  TEST_EQUAL(m.empty(), false)
+  TEST_EQUAL(m.cacheChunk(3), true)
+  TEST_EQUAL(f.cacheChunk(3), true)
+  TEST_EQUAL(m.activateCache(), true)
+  TEST_EQUAL(f.activateCache(), true)
+  TEST_EQUAL(m.chunkSize(), 3)
+  for (Size i = 0; i < 3; ++i) TEST_EQUAL(m.chunkAt(i) == f.chunkAt(i), true)
+  TEST_EQUAL(m.cacheChunk(3), true)
+  TEST_EQUAL(f.cacheChunk(3), true)
+  TEST_EQUAL(m.activateCache(), true)
+  TEST_EQUAL(f.activateCache(), true)
+  TEST_EQUAL(m.getChunkOffset(), 3)
+  TEST_EQUAL(m.chunkSize(), 2)
+  for (Size i = 0; i < 2; ++i) TEST_EQUAL(m.chunkAt(i) == f.chunkAt(i), true)
+  TEST_EQUAL(m.cacheChunk(3), false)
+  TEST_EQUAL(m.activateCache(), false)
+
+  // random access, independent of the active chunk
+  FASTAFile::FASTAEntry pe, pe2;
+  TEST_EQUAL(m.readAt(pe, 4), true)
+  TEST_EQUAL(f.readAt(pe2, 4), true)
+  TEST_EQUAL(pe == pe2, true)
+  TEST_EQUAL(m.readAt(pe, 0), true)
+  TEST_EQUAL(pe.identifier, "P68509|1433F_BOVIN")
+  TEST_EXCEPTION(Exception::IndexOverflow, m.readAt(pe, 5))
+  String seq;
+  TEST_EQUAL(m.getSequence("test", seq), true)
+  TEST_EQUAL(seq, pe2.sequence)
+  TEST_EQUAL(m.getSequence("unknown", seq), false)
+
+  m.reset();
+  TEST_EQUAL(m.cacheChunk(2), true)
+  TEST_EQUAL(m.activateCache(), true)
+  TEST_EQUAL(m.getChunkOffset(), 0)
+  TEST_EQUAL(m.chunkAt(0).identifier, "P68509|1433F_BOVIN")
+
+  FASTAContainer<TFI_MMap> m2(OPENMS_GET_TEST_DATA_PATH("degenerate_cases/empty.fasta"));
+  TEST_EQUAL(m2.empty(), true)
+  TEST_EQUAL(m2.cacheChunk(2), false)
+END_SECTION
+
+START_SECTION([TFI_MMap] bool nextChunk(size_t chunk_size, size_t& begin, size_t& end))
+  FASTAContainer<TFI_MMap> m(OPENMS_GET_TEST_DATA_PATH("FASTAFile_test.fasta"));
+  std::vector<int> seen(m.size(), 0);
+#pragma omp parallel
+  {
+    size_t begin, end;
+    FASTAFile::FASTAEntry pe;
+    while (m.nextChunk(2, begin, end))
+    {
+      for (size_t i = begin; i < end; ++i)
+      {
+        m.readAt(pe, i);
+#pragma omp atomic
+        ++seen[i];
+      }
+    }
+  }
+  TEST_EQUAL(std::count(seen.begin(), seen.end(), 1), 5)
+
+  size_t begin, end;
+  TEST_EQUAL(m.nextChunk(2, begin, end), false)
+  m.reset();
+  TEST_EQUAL(m.nextChunk(4, begin, end), true)
+  TEST_EQUAL(begin, 0)
+  TEST_EQUAL(end, 4)
+  TEST_EQUAL(m.nextChunk(4, begin, end), true)
+  TEST_EQUAL(begin, 4)
+  TEST_EQUAL(end, 5)
+  TEST_EQUAL(m.nextChunk(4, begin, end), false)
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
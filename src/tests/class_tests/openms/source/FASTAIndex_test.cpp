@@ -0,0 +1,221 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/FORMAT/FASTAIndex.h>
+///////////////////////////
+
+#include <OpenMS/SYSTEM/File.h>
+
+#include <fstream>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(FASTAIndex, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+// PEFF header, Windows line breaks, lines of varying length, an empty sequence and a duplicate identifier
+String fasta_file;
+NEW_TMP_FILE(fasta_file)
+{
+  ofstream os(fasta_file.c_str(), ios::binary);
+  os << "# PEFF 1.0\n"
+     << ">P1 first protein\r\nPEPT\r\nIDEK\r\nAA\r\n"
+     << ">P2\n"
+     << ">P3\tthird protein\nMK LV\nMKLVMKLV\n\n"
+     << ">P1 duplicate\nAAAA";
+}
+
+FASTAIndex* ptr = nullptr;
+FASTAIndex* null_ptr = nullptr;
+START_SECTION(FASTAIndex())
+{
+  ptr = new FASTAIndex();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->empty(), true)
+}
+END_SECTION
+
+START_SECTION(~FASTAIndex())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(void open(const String& fasta_file, bool use_index_file = true))
+{
+  FASTAIndex index;
+  index.open(fasta_file);
+  TEST_EQUAL(index.size(), 4)
+  TEST_EQUAL(index.getFileName(), fasta_file)
+  TEST_EXCEPTION(Exception::FileNotFound, index.open("does_not_exist.fasta"))
+
+  String no_fasta;
+  NEW_TMP_FILE(no_fasta)
+  {
+    ofstream os(no_fasta.c_str());
+    os << "PEPTIDEK\n>P1\nPEPTIDEK\n";
+  }
+  TEST_EXCEPTION(Exception::ParseError, index.open(no_fasta))
+
+  index.open(OPENMS_GET_TEST_DATA_PATH("degenerate_cases/empty.fasta"));
+  TEST_EQUAL(index.empty(), true)
+}
+END_SECTION
+
+START_SECTION(const Entry& getEntry(Size index) const)
+{
+  FASTAIndex index(fasta_file);
+  TEST_EQUAL(index.getEntry(0).name, "P1")
+  TEST_EQUAL(index.getEntry(0).length, 10)
+  TEST_EQUAL(index.getEntry(0).offset, 30)
+  TEST_EQUAL(index.getEntry(0).line_bases, 4)
+  TEST_EQUAL(index.getEntry(0).line_width, 6)
+  TEST_EQUAL(index.getEntry(1).name, "P2")
+  TEST_EQUAL(index.getEntry(1).length, 0)
+  TEST_EQUAL(index.getEntry(2).name, "P3")
+  TEST_EQUAL(index.getEntry(2).length, 12)
+  TEST_EQUAL(index.getEntry(2).line_bases, 4)
+  TEST_EQUAL(index.getEntry(2).line_width, 6)
+  TEST_EQUAL(index.getEntry(3).length, 4)
+}
+END_SECTION
+
+START_SECTION(Size find(const String& name) const)
+{
+  FASTAIndex index(fasta_file);
+  TEST_EQUAL(index.find("P1"), 0) // first occurrence
+  TEST_EQUAL(index.find("P3"), 2)
+  TEST_EQUAL(index.find("P4"), Size(-1))
+}
+END_SECTION
+
+START_SECTION(bool readEntry(Size index, FASTAFile::FASTAEntry& protein) const)
+{
+  FASTAIndex index(fasta_file);
+  FASTAFile::FASTAEntry pe;
+  TEST_EQUAL(index.readEntry(0, pe), true)
+  TEST_EQUAL(pe.identifier, "P1")
+  TEST_EQUAL(pe.description, "first protein")
+  TEST_EQUAL(pe.sequence, "PEPTIDEKAA")
+  TEST_EQUAL(index.readEntry(1, pe), true)
+  TEST_EQUAL(pe.identifier, "P2")
+  TEST_EQUAL(pe.description, "")
+  TEST_EQUAL(pe.sequence, "")
+  TEST_EQUAL(index.readEntry(2, pe), true)
+  TEST_EQUAL(pe.description, "third protein")
+  TEST_EQUAL(pe.sequence, "MKLVMKLVMKLV")
+  TEST_EQUAL(index.readEntry(3, pe), true)
+  TEST_EQUAL(pe.description, "duplicate")
+  TEST_EQUAL(pe.sequence, "AAAA")
+  TEST_EQUAL(index.readEntry(4, pe), false)
+
+  // same as FASTAFile
+  FASTAIndex index2(OPENMS_GET_TEST_DATA_PATH("FASTAFile_test.fasta"));
+  vector<FASTAFile::FASTAEntry> entries;
+  FASTAFile::load(OPENMS_GET_TEST_DATA_PATH("FASTAFile_test.fasta"), entries);
+  TEST_EQUAL(index2.size(), entries.size())
+  for (Size i = 0; i < entries.size(); ++i)
+  {
+    TEST_EQUAL(index2.readEntry(i, pe), true)
+    TEST_EQUAL(pe == entries[i], true)
+  }
+}
+END_SECTION
+
+START_SECTION(bool getSequence(const String& name, String& sequence) const)
+{
+  FASTAIndex index(fasta_file);
+  String seq;
+  TEST_EQUAL(index.getSequence("P3", seq), true)
+  TEST_EQUAL(seq, "MKLVMKLVMKLV")
+  TEST_EQUAL(index.getSequence("P1", seq), true)
+  TEST_EQUAL(seq, "PEPTIDEKAA")
+  TEST_EQUAL(index.getSequence("P4", seq), false)
+}
+END_SECTION
+
+START_SECTION(void store(const String& fai_file) const)
+{
+  FASTAIndex index(fasta_file);
+  const String fai_file = FASTAIndex::indexFilename(fasta_file);
+  index.store(fai_file);
+  ifstream is(fai_file.c_str());
+  string line;
+  getline(is, line);
+  TEST_EQUAL(line, "P1\t10\t30\t4\t6")
+
+  // the stored index is used ...
+  FASTAIndex loaded(fasta_file);
+  TEST_EQUAL(loaded.size(), 4)
+  for (Size i = 0; i < loaded.size(); ++i)
+  {
+    TEST_EQUAL(loaded.getEntry(i).name, index.getEntry(i).name)
+    TEST_EQUAL(loaded.getEntry(i).offset, index.getEntry(i).offset)
+    TEST_EQUAL(loaded.getEntry(i).length, index.getEntry(i).length)
+  }
+  String seq;
+  TEST_EQUAL(loaded.getSequence("P3", seq), true)
+  TEST_EQUAL(seq, "MKLVMKLVMKLV")
+
+  // ... unless it does not match the FASTA file
+  {
+    ofstream os(fai_file.c_str());
+    os << "P1\t10\t12\t4\t6\n";
+  }
+  FASTAIndex rebuilt(fasta_file);
+  TEST_EQUAL(rebuilt.size(), 4)
+  FASTAIndex unused(fasta_file, false);
+  TEST_EQUAL(unused.size(), 4)
+  File::remove(fai_file);
+
+  TEST_EXCEPTION(Exception::UnableToCreateFile, index.store("/does/not/exist/file.fai"))
+}
+END_SECTION
+
+START_SECTION(static String indexFilename(const String& fasta_file))
+{
+  TEST_EQUAL(FASTAIndex::indexFilename("db.fasta"), "db.fasta.fai")
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
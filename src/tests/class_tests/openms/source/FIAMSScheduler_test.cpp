@@ -37,6 +37,7 @@
 
 ///////////////////////////
 #include <OpenMS/ANALYSIS/ID/FIAMSScheduler.h>
+#include <OpenMS/SYSTEM/File.h>
 
 ///////////////////////////
 
@@ -78,6 +79,19 @@ START_SECTION(FIAMSScheduler)
 }
 END_SECTION
 
+START_SECTION((void run(Size max_concurrent_samples = 0)))
+{
+    FIAMSScheduler fia_scheduler(
+        String(OPENMS_GET_TEST_DATA_PATH("FIAMS_input/params_test.csv")),
+        String(OPENMS_GET_TEST_DATA_PATH(""))
+    );
+    fia_scheduler.run(1);
+    const vector<map<String, String>> samples = fia_scheduler.getSamples();
+    String mztab = OPENMS_GET_TEST_DATA_PATH("") + samples[0].at("dir_output") + "/" + samples[0].at("filename") + "_10.mzTab";
+    TEST_EQUAL(File::exists(mztab), true);
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
\ No newline at end of file
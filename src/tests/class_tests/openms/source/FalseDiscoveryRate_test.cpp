@@ -235,6 +235,58 @@ START_SECTION((void apply(std::vector<ProteinIdentification>& ids)))
 }
 END_SECTION
 
+START_SECTION((void applyBasic(std::vector<PeptideIdentification> & ids)))
+{
+  // big enough to take the parallel code path, with blocks of equal scores crossing chunk boundaries
+  const Size n = 150001;
+  vector<PeptideIdentification> pep_ids(n);
+  for (Size i = 0; i < n; ++i)
+  {
+    PeptideHit hit;
+    hit.setScore(double(i / 3));
+    hit.setMetaValue("target_decoy", (i % 7 == 0) ? "decoy" : "target");
+    pep_ids[i].insertHit(hit);
+  }
+
+  // reference: walk from the best to the worst score, then take the cumulative minimum backwards
+  map<double, double> expected;
+  Size decoys = 0;
+  for (Size j = 1; j <= n; ++j)
+  {
+    Size i = n - j;
+    if (i % 7 == 0) ++decoys;
+    if (i % 3 == 0) // last hit of a block of equal scores
+    {
+      expected[double(i / 3)] = (decoys + 1.0) / (j + 1.0 - decoys);
+    }
+  }
+  double cummin = 1.0;
+  for (auto& e : expected)
+  {
+    cummin = std::min(cummin, e.second);
+    e.second = cummin;
+  }
+
+  FalseDiscoveryRate fdr;
+  fdr.applyBasic(pep_ids);
+
+  Size n_checked = 0, n_wrong = 0;
+  for (Size i = 0; i < n; ++i)
+  {
+    if (i % 7 == 0)
+    {
+      if (!pep_ids[i].getHits().empty()) ++n_wrong; // decoy hits are removed
+      continue;
+    }
+    ++n_checked;
+    if (std::fabs(pep_ids[i].getHits()[0].getScore() - expected[double(i / 3)]) > 1e-12) ++n_wrong;
+  }
+  TEST_EQUAL(n_checked, n - (n - 1) / 7 - 1)
+  TEST_EQUAL(n_wrong, 0)
+  TEST_EQUAL(pep_ids[1].getScoreType(), "q-value")
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
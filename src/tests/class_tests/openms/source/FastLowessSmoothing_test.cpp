@@ -246,6 +246,26 @@ START_SECTION([FastLowessSmoothing]void smoothData(const DoubleVector&, const Do
 }
 END_SECTION
 
+START_SECTION([FastLowessSmoothing_many_fits]void smoothData(const DoubleVector&, const DoubleVector&, DoubleVector&))
+{
+  // enough local fits (delta = 0) to be computed in parallel; a local linear
+  // fit reproduces a straight line exactly, including tied x values
+  TOLERANCE_ABSOLUTE(1e-6);
+  std::vector<double> x, y, out;
+  for (Size i = 0; i < 5000; ++i)
+  {
+    x.push_back((i / 2) * 0.01);
+    y.push_back(3.0 * x.back() - 2.0);
+  }
+  FastLowessSmoothing::lowess(x, y, 0.1, 3, 0.0, out);
+  TEST_EQUAL(out.size(), y.size())
+  for (Size i = 0; i < out.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(out[i], y[i]);
+  }
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
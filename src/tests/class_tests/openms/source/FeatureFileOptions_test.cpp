@@ -163,6 +163,36 @@ START_SECTION((const DRange<1>& getMZRange() const ))
 }
 END_SECTION
 
+START_SECTION((void setWriteRangeIndex(bool write)))
+{
+  FeatureFileOptions o;
+  TEST_EQUAL(o.getWriteRangeIndex(), false)
+  o.setWriteRangeIndex(true);
+  TEST_EQUAL(o.getWriteRangeIndex(), true)
+}
+END_SECTION
+
+START_SECTION((bool getWriteRangeIndex() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((void setUseRangeIndex(bool use)))
+{
+  FeatureFileOptions o;
+  TEST_EQUAL(o.getUseRangeIndex(), true)
+  o.setUseRangeIndex(false);
+  TEST_EQUAL(o.getUseRangeIndex(), false)
+}
+END_SECTION
+
+START_SECTION((bool getUseRangeIndex() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
 START_SECTION((~FeatureFileOptions()))
 {
   // TODO
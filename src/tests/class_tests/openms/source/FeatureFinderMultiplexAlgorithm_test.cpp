@@ -102,4 +102,55 @@ START_SECTION((virtual void run()))
 }
 END_SECTION
 
+START_SECTION(([EXTRA] run in RT windows))
+{
+  MzMLFile mzml_file;
+  MSExperiment exp;
+  
+  mzml_file.getOptions().addMSLevel(1);
+  mzml_file.load(OPENMS_GET_TEST_DATA_PATH("FeatureFinderMultiplex_1_input.mzML"), exp);
+  exp.updateRanges(1);
+  
+  Param param;
+  ParamXMLFile paramFile;
+  paramFile.load(OPENMS_GET_TEST_DATA_PATH("FeatureFinderMultiplex_1_parameters.ini"), param);
+  param = param.copy("FeatureFinderMultiplex:1:",true);
+  param.remove("in");
+  param.remove("out");
+  param.remove("out_multiplets");
+  param.remove("log");
+  param.remove("debug");
+  param.remove("threads");
+  param.remove("no_progress");
+  param.remove("force");
+  param.remove("test");
+  
+  // three windows whose overlap covers the complete map, i.e. each window sees all multiplets
+  double rt_range = exp.getMaxRT() - exp.getMinRT();
+  param.setValue("algorithm:rt_window", rt_range / 3.0);
+  param.setValue("algorithm:rt_window_overlap", rt_range);
+  
+  FeatureFinderMultiplexAlgorithm algorithm;
+  algorithm.setParameters(param);
+  algorithm.run(exp, false);
+  ConsensusMap result = algorithm.getConsensusMap();
+  
+  // each multiplet is reported only once
+  TEST_EQUAL(result.size(), 2);
+  Size handle_count = 0;
+  for (const ConsensusFeature& consensus : result)
+  {
+    handle_count += consensus.size();
+  }
+  TEST_EQUAL(algorithm.getFeatureMap().size(), handle_count);
+  TEST_EQUAL(result.getColumnHeaders()[0].size, result.size());
+  
+  double L = result[0].getFeatures().begin()->getIntensity();
+  double H = (++(result[0].getFeatures().begin()))->getIntensity();
+  
+  TOLERANCE_ABSOLUTE(0.2);
+  TEST_REAL_SIMILAR(H/L, 3.0);
+}
+END_SECTION
+
 END_TEST
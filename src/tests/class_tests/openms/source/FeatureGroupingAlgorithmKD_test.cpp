@@ -36,6 +36,7 @@
 #include <OpenMS/test_config.h>
 
 #include <OpenMS/ANALYSIS/MAPMATCHING/FeatureGroupingAlgorithmKD.h>
+#include <OpenMS/FORMAT/ColumnarFeatureFile.h>
 
 using namespace OpenMS;
 using namespace std;
@@ -77,6 +78,133 @@ START_SECTION((virtual void group(const std::vector<ConsensusMap>& maps, Consens
   NOT_TESTABLE;
 END_SECTION
 
+START_SECTION((void groupFromFiles(const StringList& files, ConsensusMap& out)))
+{
+  // two maps with three corresponding features each, well separated in m/z
+  vector<FeatureMap> maps(2);
+  for (Size k = 0; k < maps.size(); ++k)
+  {
+    for (Size i = 0; i < 3; ++i)
+    {
+      Feature f;
+      f.setRT(100.0 * (i + 1) + k);
+      f.setMZ(400.0 + 100.0 * i + 0.001 * k);
+      f.setIntensity(1000.0f);
+      f.setCharge(2);
+      f.setUniqueId(10 * k + i + 1);
+      maps[k].push_back(f);
+    }
+  }
+  // an unmatched feature in the second map
+  Feature single;
+  single.setRT(1000.0);
+  single.setMZ(900.0);
+  single.setIntensity(100.0f);
+  single.setUniqueId(99);
+  maps[1].push_back(single);
+
+  FeatureGroupingAlgorithmKD algo;
+  Param p = algo.getParameters();
+  p.setValue("warp:enabled", "false");
+  p.setValue("nr_partitions", 3);
+  algo.setParameters(p);
+
+  ConsensusMap in_memory;
+  algo.group(maps, in_memory);
+
+  StringList files(2);
+  for (Size k = 0; k < maps.size(); ++k)
+  {
+    NEW_TMP_FILE(files[k])
+    maps[k].sortByMZ();
+    ColumnarFeatureFile::store(files[k], maps[k]);
+  }
+  ConsensusMap from_files;
+  algo.groupFromFiles(files, from_files);
+
+  TEST_EQUAL(from_files.size(), 4)
+  TEST_EQUAL(from_files.size(), in_memory.size())
+  for (Size i = 0; i < from_files.size(); ++i)
+  {
+    TEST_EQUAL(from_files[i].size(), in_memory[i].size())
+    TEST_REAL_SIMILAR(from_files[i].getMZ(), in_memory[i].getMZ())
+    TEST_REAL_SIMILAR(from_files[i].getRT(), in_memory[i].getRT())
+  }
+
+  TEST_EXCEPTION(Exception::IllegalArgument, algo.groupFromFiles(StringList(1, files[0]), from_files))
+
+  // features must be sorted by m/z
+  std::reverse(maps[0].begin(), maps[0].end());
+  ColumnarFeatureFile::store(files[0], maps[0]);
+  TEST_EXCEPTION(Exception::IllegalArgument, algo.groupFromFiles(files, from_files))
+}
+END_SECTION
+
+START_SECTION((void addToConsensus(const std::vector<FeatureMap>& maps, ConsensusMap& consensus)))
+{
+  // three maps with three corresponding features each
+  vector<FeatureMap> maps(3);
+  for (Size k = 0; k < maps.size(); ++k)
+  {
+    for (Size i = 0; i < 3; ++i)
+    {
+      Feature f;
+      f.setRT(100.0 * (i + 1) + k);
+      f.setMZ(400.0 + 100.0 * i + 0.001 * k);
+      f.setIntensity(1000.0f);
+      f.setCharge(2);
+      f.setUniqueId(10 * k + i + 1);
+      maps[k].push_back(f);
+    }
+    maps[k].setUniqueId(100 + k);
+  }
+
+  FeatureGroupingAlgorithmKD algo;
+  Param p = algo.getParameters();
+  p.setValue("warp:enabled", "false");
+  algo.setParameters(p);
+
+  // link the first two maps, then add the third one
+  ConsensusMap consensus;
+  algo.group(vector<FeatureMap>(maps.begin(), maps.begin() + 2), consensus);
+  consensus.getColumnHeaders()[0].size = 3;
+  consensus.getColumnHeaders()[1].size = 3;
+  TEST_EQUAL(consensus.size(), 3)
+
+  // the third map also contains a feature without a partner
+  Feature single;
+  single.setRT(1000.0);
+  single.setMZ(900.0);
+  single.setIntensity(100.0f);
+  single.setUniqueId(99);
+  maps[2].push_back(single);
+  PeptideIdentification unassigned;
+  maps[2].getUnassignedPeptideIdentifications().push_back(unassigned);
+
+  algo.addToConsensus(vector<FeatureMap>(1, maps[2]), consensus);
+  TEST_EQUAL(consensus.size(), 4)
+  TEST_EQUAL(consensus.getColumnHeaders().size(), 3)
+  TEST_EQUAL(consensus.getColumnHeaders()[2].size, 4)
+  TEST_EQUAL(consensus.getColumnHeaders()[2].unique_id, 102)
+  TEST_EQUAL(consensus.getUnassignedPeptideIdentifications().size(), 1)
+  TEST_EQUAL(consensus.getUnassignedPeptideIdentifications()[0].getMetaValue("map_index"), 2)
+
+  // same result as linking all maps at once
+  ConsensusMap all;
+  algo.group(maps, all);
+  TEST_EQUAL(all.size(), consensus.size())
+  for (Size i = 0; i < all.size(); ++i)
+  {
+    TEST_EQUAL(consensus[i].size(), all[i].size())
+    TEST_REAL_SIMILAR(consensus[i].getMZ(), all[i].getMZ())
+    TEST_REAL_SIMILAR(consensus[i].getRT(), all[i].getRT())
+  }
+  TEST_EQUAL(consensus[0].getFeatures().rbegin()->getMapIndex(), 2)
+  TEST_EQUAL(consensus.back().size(), 1)
+  TEST_EQUAL(consensus.back().getFeatures().begin()->getUniqueId(), 99)
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 
@@ -376,6 +376,60 @@ START_SECTION((FeatureMap& operator+= (const FeatureMap& rhs)))
 
 END_SECTION
 
+START_SECTION((FeatureMap& append(std::vector<FeatureMap>&& maps)))
+{
+	FeatureMap m1;
+	Feature f1;
+	f1.setMZ(100.12);
+	f1.setUniqueId(1);
+	m1.push_back(f1);
+	m1.setIdentifier("123");
+	m1.getDataProcessing().resize(1);
+	m1.getProteinIdentifications().resize(1);
+	m1.ensureUniqueId();
+
+	vector<FeatureMap> maps(3);
+	for (Size i = 0; i < maps.size(); ++i)
+	{
+		Feature f;
+		f.setMZ(200.0 + i);
+		f.setUniqueId(i + 1); // first one conflicts with f1
+		maps[i].push_back(f);
+		maps[i].getDataProcessing().resize(1);
+		maps[i].getProteinIdentifications().resize(1);
+		maps[i].getUnassignedPeptideIdentifications().resize(2);
+	}
+	maps[1].setIdentifier("321");
+
+	// same result as operator+= for each map
+	FeatureMap expected = m1;
+	for (const FeatureMap& m : maps) expected += m;
+
+	m1.append(std::move(maps));
+	TEST_EQUAL(maps.empty(), true)
+	TEST_EQUAL(m1.getIdentifier(), "");
+	TEST_EQUAL(UniqueIdInterface::isValid(m1.getUniqueId()), false);
+	TEST_EQUAL(m1.getDataProcessing().size(), 4);
+	TEST_EQUAL(m1.getProteinIdentifications().size(), 4);
+	TEST_EQUAL(m1.getUnassignedPeptideIdentifications().size(), 6);
+	ABORT_IF(m1.size() != 4)
+	TEST_REAL_SIMILAR(m1[0].getMZ(), 100.12)
+	TEST_REAL_SIMILAR(m1[3].getMZ(), 202.0)
+	TEST_EQUAL(m1.size(), expected.size())
+
+	// unique ids were made unique and the index is valid
+	for (Size i = 0; i < m1.size(); ++i)
+	{
+		TEST_EQUAL(m1.uniqueIdToIndex(m1[i].getUniqueId()), i)
+	}
+	TEST_NOT_EQUAL(m1[0].getUniqueId(), m1[1].getUniqueId())
+
+	// appending nothing is fine
+	m1.append(vector<FeatureMap>());
+	TEST_EQUAL(m1.size(), 4)
+}
+END_SECTION
+
 START_SECTION((void sortByIntensity(bool reverse=false)))
 
 	FeatureMap to_be_sorted;
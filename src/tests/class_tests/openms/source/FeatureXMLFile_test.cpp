@@ -43,6 +43,10 @@
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
 #include <OpenMS/KERNEL/MSSpectrum.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <fstream>
+#include <sstream>
 
 using namespace OpenMS;
 using namespace std;
@@ -267,6 +271,84 @@ START_SECTION((FeatureFileOptions & getOptions()))
 }
 END_SECTION
 
+START_SECTION((static String getRangeIndexFilename(const String& filename)))
+{
+  TEST_EQUAL(FeatureXMLFile::getRangeIndexFilename("a/b.featureXML"), "a/b.featureXML.ridx")
+}
+END_SECTION
+
+START_SECTION([EXTRA] range-restricted loads using the range index)
+{
+  FeatureMap map;
+  for (Size i = 0; i < 2000; ++i)
+  {
+    Feature f;
+    f.setRT(i * 0.5);
+    f.setMZ(400.0 + (i % 7) * 100.0);
+    f.setIntensity(float(i % 100));
+    f.setCharge(2);
+    f.ensureUniqueId();
+    map.push_back(f);
+  }
+  map.updateRanges();
+
+  std::string filename;
+  NEW_TMP_FILE(filename);
+  FeatureXMLFile f;
+  f.getOptions().setWriteRangeIndex(true);
+  f.store(filename, map);
+  const String index_filename = FeatureXMLFile::getRangeIndexFilename(filename);
+  TEST_EQUAL(File::exists(index_filename), true)
+
+  // loads with and without index give the same result
+  FeatureMap indexed, full;
+  FeatureXMLFile g;
+  g.getOptions().setRTRange(makeRange(300.0, 350.5));
+  g.load(filename, indexed);
+  g.getOptions().setUseRangeIndex(false);
+  g.load(filename, full);
+  TEST_EQUAL(indexed.size(), 101)
+  TEST_EQUAL(indexed == full, true)
+  TEST_REAL_SIMILAR(indexed[0].getRT(), 300.0)
+
+  g.getOptions() = FeatureFileOptions();
+  g.getOptions().setMZRange(makeRange(550.0, 650.0));
+  g.getOptions().setIntensityRange(makeRange(10.0, 20.0));
+  g.load(filename, indexed);
+  g.getOptions().setUseRangeIndex(false);
+  g.load(filename, full);
+  TEST_EQUAL(indexed.size(), full.size())
+  TEST_EQUAL(indexed == full, true)
+
+  // nothing in range
+  g.getOptions() = FeatureFileOptions();
+  g.getOptions().setRTRange(makeRange(5000.0, 6000.0));
+  g.load(filename, indexed);
+  TEST_EQUAL(indexed.size(), 0)
+
+  // storing without index removes the old one; an outdated index is ignored
+  std::string index_content;
+  {
+    std::ifstream is(index_filename.c_str());
+    std::stringstream ss;
+    ss << is.rdbuf();
+    index_content = ss.str();
+  }
+  map.resize(500);
+  f.getOptions().setWriteRangeIndex(false);
+  f.store(filename, map);
+  TEST_EQUAL(File::exists(index_filename), false)
+  {
+    std::ofstream os(index_filename.c_str());
+    os << index_content;
+  }
+  g.getOptions() = FeatureFileOptions();
+  g.getOptions().setRTRange(makeRange(0.0, 1000.0));
+  g.load(filename, indexed);
+  TEST_EQUAL(indexed.size(), 500)
+}
+END_SECTION
+
 START_SECTION([EXTRA] static bool isValid(const String& filename))
 {
   FeatureXMLFile f;
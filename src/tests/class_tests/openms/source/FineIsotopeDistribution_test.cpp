@@ -462,6 +462,32 @@ START_SECTION(( void setAbsolute(bool absolute) ))
 END_SECTION
 
 
+START_SECTION(( std::vector<IsotopeDistribution> runBatch(const std::vector<EmpiricalFormula>& formulas) const ))
+{
+  vector<EmpiricalFormula> formulas;
+  formulas.push_back(EmpiricalFormula("C6H12O6"));
+  formulas.push_back(EmpiricalFormula("C100H202"));
+  formulas.push_back(EmpiricalFormula("C520H817N139O147S8"));
+  formulas.push_back(EmpiricalFormula("C6H13O6P"));
+  formulas.push_back(EmpiricalFormula("C6H12O6"));
+
+  for (bool use_total_prob : {true, false})
+  {
+    FineIsotopePatternGenerator gen(0.01, use_total_prob, false);
+    vector<IsotopeDistribution> batch = gen.runBatch(formulas);
+    TEST_EQUAL(batch.size(), formulas.size())
+    for (Size i = 0; i < formulas.size(); ++i)
+    {
+      IsotopeDistribution single = gen.run(formulas[i]);
+      TEST_EQUAL(batch[i].size(), single.size())
+      TEST_EQUAL(batch[i] == single, true)
+    }
+  }
+
+  TEST_EQUAL(FineIsotopePatternGenerator().runBatch(vector<EmpiricalFormula>()).empty(), true)
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
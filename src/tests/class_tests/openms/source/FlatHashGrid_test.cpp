@@ -0,0 +1,226 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Lars Nilse $
+// $Authors: Lars Nilse $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+#include <OpenMS/COMPARISON/CLUSTERING/FlatHashGrid.h>
+
+#include <limits>
+
+using namespace OpenMS;
+
+typedef OpenMS::FlatHashGrid<int> TestGrid;
+const TestGrid::ClusterCenter cell_dimension(1, 1);
+
+START_TEST(FlatHashGrid, "$Id$")
+
+TestGrid* ptr = nullptr;
+TestGrid* null_ptr = nullptr;
+
+START_SECTION(explicit FlatHashGrid(const ClusterCenter& cell_dimension))
+{
+  ptr = new TestGrid(cell_dimension);
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->getCellDimension(), cell_dimension)
+  TEST_EQUAL(ptr->size(), 0)
+  TEST_EQUAL(ptr->empty(), true)
+  TEST_EQUAL(ptr->cellCount(), 0)
+  TEST_EQUAL(ptr->find(TestGrid::CellIndex(0, 0)).empty(), true)
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(void insert(const value_type& v))
+{
+  TestGrid t(cell_dimension);
+  t.insert(std::make_pair(TestGrid::ClusterCenter(1.5, 2.5), 1));
+  TEST_EQUAL(t.size(), 0) // not before build()
+  {
+    const TestGrid::ClusterCenter key(0, (double)std::numeric_limits<Int64>::min() - 1e5);
+    TEST_EXCEPTION(Exception::OutOfRange, t.insert(std::make_pair(key, 2)));
+  }
+  {
+    const TestGrid::ClusterCenter key(0, (double)std::numeric_limits<Int64>::max() + 1e5);
+    TEST_EXCEPTION(Exception::OutOfRange, t.insert(std::make_pair(key, 2)));
+  }
+  t.build();
+  TEST_EQUAL(t.size(), 1)
+}
+END_SECTION
+
+TestGrid grid(cell_dimension);
+grid.insert(std::make_pair(TestGrid::ClusterCenter(1.5, 2.5), 1));
+grid.insert(std::make_pair(TestGrid::ClusterCenter(2.5, 1.5), 2));
+grid.insert(std::make_pair(TestGrid::ClusterCenter(1.2, 2.8), 3));
+grid.insert(std::make_pair(TestGrid::ClusterCenter(-0.5, 1.5), 4));
+grid.insert(std::make_pair(TestGrid::ClusterCenter(5.5, 5.5), 5));
+
+START_SECTION(void build())
+{
+  grid.build();
+  TEST_EQUAL(grid.size(), 5)
+  TEST_EQUAL(grid.empty(), false)
+  TEST_EQUAL(grid.cellCount(), 4)
+
+  // sorting again and adding to a built grid keeps all elements
+  TestGrid t(cell_dimension);
+  t.insert(std::make_pair(TestGrid::ClusterCenter(0.5, 0.5), 1));
+  t.build();
+  t.insert(std::make_pair(TestGrid::ClusterCenter(0.7, 0.7), 2));
+  t.build();
+  TEST_EQUAL(t.size(), 2)
+  TEST_EQUAL(t.cellCount(), 1)
+  TEST_EQUAL(t.getCell(0).begin()->second, 1)
+  TEST_EQUAL((t.getCell(0).begin() + 1)->second, 2)
+}
+END_SECTION
+
+START_SECTION(void clear())
+{
+  TestGrid t(cell_dimension);
+  t.insert(std::make_pair(TestGrid::ClusterCenter(0.5, 0.5), 1));
+  t.build();
+  t.clear();
+  TEST_EQUAL(t.size(), 0)
+  TEST_EQUAL(t.empty(), true)
+  TEST_EQUAL(t.cellCount(), 0)
+  TEST_EQUAL(t.find(TestGrid::CellIndex(0, 0)).empty(), true)
+}
+END_SECTION
+
+START_SECTION(Size size() const)
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION(bool empty() const)
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION(const_iterator begin() const)
+{
+  // elements are sorted by cell, insertion order within a cell
+  std::vector<int> payloads;
+  for (TestGrid::const_iterator it = grid.begin(); it != grid.end(); ++it)
+  {
+    payloads.push_back(it->second);
+  }
+  TEST_EQUAL(payloads.size(), 5)
+  ABORT_IF(payloads.size() != 5)
+  TEST_EQUAL(payloads[0], 4)
+  TEST_EQUAL(payloads[1], 1)
+  TEST_EQUAL(payloads[2], 3)
+  TEST_EQUAL(payloads[3], 2)
+  TEST_EQUAL(payloads[4], 5)
+}
+END_SECTION
+
+START_SECTION(const_iterator end() const)
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION(Size cellCount() const)
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION(const CellIndex& getCellIndex(Size cell) const)
+{
+  TEST_EQUAL(grid.getCellIndex(0)[0], -1)
+  TEST_EQUAL(grid.getCellIndex(0)[1], 1)
+  TEST_EQUAL(grid.getCellIndex(1)[0], 1)
+  TEST_EQUAL(grid.getCellIndex(1)[1], 2)
+  TEST_EQUAL(grid.getCellIndex(2)[0], 2)
+  TEST_EQUAL(grid.getCellIndex(2)[1], 1)
+  TEST_EQUAL(grid.getCellIndex(3)[0], 5)
+  TEST_EQUAL(grid.getCellIndex(3)[1], 5)
+}
+END_SECTION
+
+START_SECTION(CellRange getCell(Size cell) const)
+{
+  TEST_EQUAL(grid.getCell(0).size(), 1)
+  TEST_EQUAL(grid.getCell(1).size(), 2)
+  TEST_EQUAL(grid.getCell(1).begin()->second, 1)
+  TEST_EQUAL(grid.getCell(3).begin()->second, 5)
+}
+END_SECTION
+
+START_SECTION(CellRange find(const CellIndex& index) const)
+{
+  TestGrid::CellRange cell = grid.find(TestGrid::CellIndex(1, 2));
+  TEST_EQUAL(cell.size(), 2)
+  TEST_EQUAL(cell.begin()->second, 1)
+  TEST_EQUAL((cell.begin() + 1)->second, 3)
+  // mirrored index of (1, 2)
+  TEST_EQUAL(grid.find(TestGrid::CellIndex(2, 1)).size(), 1)
+  TEST_EQUAL(grid.find(TestGrid::CellIndex(2, 2)).empty(), true)
+  TEST_EQUAL(grid.find(TestGrid::CellIndex(-1, 1)).size(), 1)
+}
+END_SECTION
+
+START_SECTION((template <typename Function> void forEachNeighbor(const CellIndex& index, Function f) const))
+{
+  int sum = 0;
+  grid.forEachNeighbor(TestGrid::CellIndex(1, 1), [&sum](const TestGrid::value_type& v) { sum += v.second; });
+  TEST_EQUAL(sum, 1 + 2 + 3)
+
+  sum = 0;
+  grid.forEachNeighbor(TestGrid::CellIndex(0, 1), [&sum](const TestGrid::value_type& v) { sum += v.second; });
+  TEST_EQUAL(sum, 1 + 3 + 4)
+
+  sum = 0;
+  grid.forEachNeighbor(TestGrid::CellIndex(10, 10), [&sum](const TestGrid::value_type& v) { sum += v.second; });
+  TEST_EQUAL(sum, 0)
+}
+END_SECTION
+
+START_SECTION(CellIndex cellIndexAt(const ClusterCenter& center) const)
+{
+  TEST_EQUAL(grid.cellIndexAt(TestGrid::ClusterCenter(1.5, 2.5))[0], 1)
+  TEST_EQUAL(grid.cellIndexAt(TestGrid::ClusterCenter(1.5, 2.5))[1], 2)
+  TEST_EQUAL(grid.cellIndexAt(TestGrid::ClusterCenter(-0.5, 0.0))[0], -1)
+  TEST_EQUAL(grid.cellIndexAt(TestGrid::ClusterCenter(-0.5, 0.0))[1], 0)
+  TestGrid t(TestGrid::ClusterCenter(2, 10));
+  TEST_EQUAL(t.cellIndexAt(TestGrid::ClusterCenter(5, 25))[0], 2)
+  TEST_EQUAL(t.cellIndexAt(TestGrid::ClusterCenter(5, 25))[1], 2)
+}
+END_SECTION
+
+START_SECTION(const ClusterCenter& getCellDimension() const)
+  NOT_TESTABLE // tested above
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -0,0 +1,197 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/ANALYSIS/ID/FragmentIndex.h>
+///////////////////////////
+
+#include <OpenMS/CHEMISTRY/TheoreticalSpectrumGenerator.h>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(FragmentIndex, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+FragmentIndex* ptr = nullptr;
+FragmentIndex* null_ptr = nullptr;
+START_SECTION(FragmentIndex(double bucket_width = 0.05))
+{
+  ptr = new FragmentIndex();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->size(), 0)
+  TEST_EQUAL(ptr->getNrFragments(), 0)
+}
+END_SECTION
+
+START_SECTION(~FragmentIndex())
+{
+  delete ptr;
+}
+END_SECTION
+
+AASequence pep1 = AASequence::fromString("PEPTIDEK");
+AASequence pep2 = AASequence::fromString("PEPTIDEM");
+AASequence pep3 = AASequence::fromString("PEPTIDEM(Oxidation)");
+AASequence pep4 = AASequence::fromString("SAMPLER");
+
+FragmentIndex index;
+index.addPeptide("PEPTIDEK", 0, pep1);
+index.addPeptide("PEPTIDEM", 0, pep2);
+index.addPeptide("PEPTIDEM", 1, pep3);
+index.addPeptide("SAMPLER", 0, pep4);
+
+START_SECTION((void addPeptide(const String& unmodified_sequence, Size mod_index, const AASequence& peptide)))
+{
+  TEST_EQUAL(index.size(), 4)
+}
+END_SECTION
+
+START_SECTION((void query(const MSSpectrum& spectrum, double min_mass, double max_mass, double fragment_tolerance, bool fragment_tolerance_ppm, Size min_matched_peaks, std::vector<std::pair<Size, Size> >& candidates) const))
+{
+  vector<pair<Size, Size> > candidates;
+  TEST_EXCEPTION(Exception::Precondition, index.query(MSSpectrum(), 0, 10000, 0.01, false, 1, candidates))
+}
+END_SECTION
+
+START_SECTION((void build()))
+{
+  index.build();
+  TEST_EQUAL(index.size(), 4)
+  // b1..b7 and y1..y7 for each 8-mer, b1..b6 and y1..y6 for SAMPLER
+  TEST_EQUAL(index.getNrFragments(), 3 * 14 + 12)
+
+  // ordered by mass
+  for (Size i = 1; i < index.size(); ++i)
+  {
+    TEST_EQUAL(index.getPeptide(i - 1).mass <= index.getPeptide(i).mass, true)
+  }
+  TEST_EQUAL(index.getPeptide(0).sequence, "SAMPLER")
+  TEST_EQUAL(index.getPeptide(3).sequence, "PEPTIDEM(Oxidation)")
+  TEST_EQUAL(index.getPeptide(3).unmodified_sequence, "PEPTIDEM")
+  TEST_EQUAL(index.getPeptide(3).mod_index, 1)
+  TEST_REAL_SIMILAR(index.getPeptide(3).mass, pep3.getMonoWeight())
+}
+END_SECTION
+
+// experimental spectrum: all b- and y-ions of PEPTIDEM(Oxidation)
+TheoreticalSpectrumGenerator tsg;
+Param tsg_param(tsg.getParameters());
+tsg_param.setValue("add_first_prefix_ion", "true");
+tsg.setParameters(tsg_param);
+MSSpectrum spectrum;
+tsg.getSpectrum(spectrum, pep3, 1, 1);
+spectrum.sortByPosition();
+
+START_SECTION([EXTRA] query)
+{
+  vector<pair<Size, Size> > candidates;
+
+  // all candidates
+  index.query(spectrum, 0, 10000, 0.01, false, 1, candidates);
+  TEST_EQUAL(candidates.size(), 3) // SAMPLER shares no fragment
+  ABORT_IF(candidates.size() != 3)
+  TEST_EQUAL(index.getPeptide(candidates[0].first).sequence, "PEPTIDEK")
+  TEST_EQUAL(candidates[0].second, 7) // b1..b7
+  TEST_EQUAL(index.getPeptide(candidates[1].first).sequence, "PEPTIDEM")
+  TEST_EQUAL(candidates[1].second, 7) // b1..b7
+  TEST_EQUAL(index.getPeptide(candidates[2].first).sequence, "PEPTIDEM(Oxidation)")
+  TEST_EQUAL(candidates[2].second, 14)
+
+  // precursor mass window
+  index.query(spectrum, pep3.getMonoWeight() - 0.1, pep3.getMonoWeight() + 0.1, 0.01, false, 1, candidates);
+  TEST_EQUAL(candidates.size(), 1)
+  TEST_EQUAL(candidates[0].second, 14)
+
+  // min. number of matched peaks
+  index.query(spectrum, 0, 10000, 0.01, false, 8, candidates);
+  TEST_EQUAL(candidates.size(), 1)
+
+  // ppm tolerance
+  index.query(spectrum, 0, 10000, 10.0, true, 1, candidates);
+  TEST_EQUAL(candidates.size(), 3)
+
+  // empty window
+  index.query(spectrum, 10000, 20000, 0.01, false, 1, candidates);
+  TEST_EQUAL(candidates.size(), 0)
+}
+END_SECTION
+
+START_SECTION((void store(const String& filename, const String& key) const))
+{
+  NOT_TESTABLE // tested with load()
+}
+END_SECTION
+
+START_SECTION((bool load(const String& filename, const String& key)))
+{
+  String filename;
+  NEW_TMP_FILE(filename)
+  index.store(filename, "key");
+
+  FragmentIndex loaded;
+  TEST_EQUAL(loaded.load(filename, "other_key"), false)
+  TEST_EQUAL(loaded.size(), 0)
+  TEST_EQUAL(loaded.load(filename, "key"), true)
+  TEST_EQUAL(loaded.size(), index.size())
+  TEST_EQUAL(loaded.getNrFragments(), index.getNrFragments())
+  TEST_EQUAL(loaded.getPeptide(3).sequence, index.getPeptide(3).sequence)
+
+  vector<pair<Size, Size> > c1, c2;
+  index.query(spectrum, 0, 10000, 0.01, false, 1, c1);
+  loaded.query(spectrum, 0, 10000, 0.01, false, 1, c2);
+  TEST_EQUAL(c1 == c2, true)
+
+  TEST_EQUAL(loaded.load("this_file_does_not_exist.bin", "key"), false)
+  TEST_EXCEPTION(Exception::ParseError, loaded.load(OPENMS_GET_TEST_DATA_PATH("FASTAFile_test.fasta"), "key"))
+}
+END_SECTION
+
+START_SECTION((void clear()))
+{
+  index.clear();
+  TEST_EQUAL(index.size(), 0)
+  TEST_EQUAL(index.getNrFragments(), 0)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -187,6 +187,34 @@ START_SECTION((bool filter(OpenMS::Interfaces::ChromatogramPtr chromatogram)))
   TEST_REAL_SIMILAR(chromatogram->getIntensityArray()->data[8],0.000881793)
 END_SECTION 
 
+START_SECTION([EXTRA] uniformly spaced data)
+{
+  // uniformly spaced data uses pre-computed kernel values; compare to the
+  // general path (moving the last data point makes the data non-uniform)
+  std::vector<double> rt, intensities;
+  for (Size i = 0; i < 60; ++i)
+  {
+    rt.push_back(100.0 + 3.4 * i);
+    intensities.push_back(1000.0 * exp(-(i - 30.0) * (i - 30.0) / 50.0) + (i % 3) * 20.0);
+  }
+  std::vector<double> rt_shifted = rt;
+  rt_shifted.back() += 1e-5;
+
+  GaussFilterAlgorithm gauss;
+  gauss.initialize(30.0 /* gaussian_width */, 0.01 /* spacing */, 10.0 /* ppm_tolerance */, false /* use_ppm_tolerance */);
+  std::vector<double> rt_out(60), int_out(60), rt_out_shifted(60), int_out_shifted(60);
+  gauss.filter(rt.begin(), rt.end(), intensities.begin(), rt_out.begin(), int_out.begin());
+  gauss.filter(rt_shifted.begin(), rt_shifted.end(), intensities.begin(), rt_out_shifted.begin(), int_out_shifted.begin());
+
+  TOLERANCE_RELATIVE(1.0001)
+  for (Size i = 0; i < 59; ++i)
+  {
+    TEST_REAL_SIMILAR(rt_out[i], rt[i])
+    TEST_REAL_SIMILAR(int_out[i], int_out_shifted[i])
+  }
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -39,10 +39,45 @@
 #include <OpenMS/FORMAT/GzipIfstream.h>
 using namespace OpenMS;
 
-
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
 
 ///////////////////////////
 
+/// writes @p content as BGZF file (blocks of @p block_size bytes followed by the empty EOF block)
+void writeBGZF(const String& filename, const std::string& content, size_t block_size)
+{
+  std::vector<unsigned char> file;
+  for (size_t pos = 0; pos <= content.size(); pos += block_size)
+  {
+    size_t len = std::min(block_size, content.size() - pos);
+    std::vector<unsigned char> deflated(compressBound((uLong)len) + 16);
+    z_stream zs = z_stream();
+    deflateInit2(&zs, 6, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+    zs.next_in = (Bytef*)content.data() + pos;
+    zs.avail_in = (uInt)len;
+    zs.next_out = deflated.data();
+    zs.avail_out = (uInt)deflated.size();
+    deflate(&zs, Z_FINISH);
+    size_t deflated_size = zs.total_out;
+    deflateEnd(&zs);
+
+    size_t bsize = 18 + deflated_size + 8 - 1;
+    unsigned char header[18] = {31, 139, 8, 4, 0, 0, 0, 0, 0, 255, 6, 0, 'B', 'C', 2, 0,
+                                (unsigned char)(bsize & 0xff), (unsigned char)(bsize >> 8)};
+    file.insert(file.end(), header, header + 18);
+    file.insert(file.end(), deflated.begin(), deflated.begin() + deflated_size);
+    uLong crc = crc32(0L, (const Bytef*)content.data() + pos, (uInt)len);
+    for (int i = 0; i < 4; ++i) file.push_back((unsigned char)((crc >> (8 * i)) & 0xff));
+    for (int i = 0; i < 4; ++i) file.push_back((unsigned char)((len >> (8 * i)) & 0xff));
+  }
+  FILE* out = fopen(filename.c_str(), "wb");
+  fwrite(file.data(), 1, file.size(), out);
+  fclose(out);
+}
+
 START_TEST(GzipIfstream, "$Id$")
 
 GzipIfstream* ptr = nullptr;
@@ -141,6 +176,53 @@ START_SECTION(size_t read(char *s, size_t n))
 	TEST_EQUAL(String(buffer), String("Was decompression successful?"))
 END_SECTION
 
+START_SECTION([EXTRA] read BGZF and multi-chunk gzip files)
+{
+  std::string content;
+  for (int i = 0; i < 200000; ++i)
+  {
+    content += "line " + String(i) + "\n";
+  }
+
+  // BGZF files are inflated block-parallel, regular gzip files through the read-ahead thread
+  String bgzf_file, gzip_file;
+  NEW_TMP_FILE(bgzf_file)
+  NEW_TMP_FILE(gzip_file)
+  writeBGZF(bgzf_file, content, 60000);
+  gzFile gz = gzopen(gzip_file.c_str(), "wb");
+  gzwrite(gz, content.data(), (unsigned int)content.size());
+  gzclose(gz);
+
+  for (const String& filename : {bgzf_file, gzip_file})
+  {
+    GzipIfstream gzip(filename.c_str());
+    std::string result;
+    char buffer[4099];
+    while (!gzip.streamEnd())
+    {
+      result.append(buffer, gzip.read(buffer, sizeof(buffer)));
+    }
+    TEST_EQUAL(result.size(), content.size())
+    TEST_EQUAL(result == content, true)
+    TEST_EQUAL(gzip.isOpen(), false)
+  }
+
+  // corrupt BGZF block
+  String corrupt_file;
+  NEW_TMP_FILE(corrupt_file)
+  writeBGZF(corrupt_file, content, 60000);
+  FILE* f = fopen(corrupt_file.c_str(), "r+b");
+  fseek(f, 30, SEEK_SET);
+  fputc(0xff, f);
+  fputc(0x00, f);
+  fclose(f);
+  GzipIfstream corrupt(corrupt_file.c_str());
+  std::vector<char> buffer(content.size());
+  TEST_EXCEPTION(Exception::ConversionError, corrupt.read(&buffer[0], buffer.size()))
+  TEST_EQUAL(corrupt.isOpen(), false)
+}
+END_SECTION
+
 START_SECTION(void close())
 	//tested in read
 	NOT_TESTABLE
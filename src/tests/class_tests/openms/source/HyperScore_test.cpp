@@ -117,6 +117,50 @@ START_SECTION((static double compute(double fragment_mass_tolerance, bool fragme
 }
 END_SECTION
 
+START_SECTION((static double compute(double fragment_mass_tolerance, bool fragment_mass_tolerance_unit_ppm, const PeakSpectrum& exp_spectrum, const std::vector<double>& theo_mz, const std::vector<char>& theo_ion_types)))
+{
+  PeakSpectrum exp_spectrum;
+  vector<double> theo_mz;
+  vector<char> theo_ion_types;
+
+  AASequence peptide = AASequence::fromString("PEPTIDE");
+
+  // empty spectrum
+  tsg.getIonSeries(theo_mz, theo_ion_types, peptide, 1, 1);
+  TEST_REAL_SIMILAR(HyperScore::compute(0.1, false, exp_spectrum, theo_mz, theo_ion_types), 0.0);
+
+  // full match, 11 identical masses, identical intensities (=1)
+  tsg.getSpectrum(exp_spectrum, peptide, 1, 1);
+  TEST_REAL_SIMILAR(HyperScore::compute(0.1, false, exp_spectrum, theo_mz, theo_ion_types), 13.8516496);
+  TEST_REAL_SIMILAR(HyperScore::compute(10, true, exp_spectrum, theo_mz, theo_ion_types), 13.8516496);
+
+  exp_spectrum.clear(true);
+
+  // no match
+  tsg.getSpectrum(exp_spectrum, peptide, 1, 3);
+  tsg.getIonSeries(theo_mz, theo_ion_types, AASequence::fromString("YYYYYY"), 1, 3);
+  TEST_REAL_SIMILAR(HyperScore::compute(1e-5, false, exp_spectrum, theo_mz, theo_ion_types), 0.0);
+
+  // full match, 33 identical masses, identical intensities (=1)
+  tsg.getIonSeries(theo_mz, theo_ion_types, peptide, 1, 3);
+  TEST_REAL_SIMILAR(HyperScore::compute(0.1, false, exp_spectrum, theo_mz, theo_ion_types), 67.8210771);
+  TEST_REAL_SIMILAR(HyperScore::compute(10, true, exp_spectrum, theo_mz, theo_ion_types), 67.8210771);
+
+  // same score as for the theoretical spectrum
+  PeakSpectrum theo_spectrum;
+  tsg.getSpectrum(theo_spectrum, peptide, 1, 3);
+  for (Size i = 0; i < theo_spectrum.size(); ++i)
+  {
+    double mz = pow(theo_spectrum[i].getMZ(), 2);
+    exp_spectrum[i].setMZ(mz);
+    theo_spectrum[i].setMZ(mz + 9 * 1e-6 * mz); // +9 ppm error
+    theo_mz[i] = theo_spectrum[i].getMZ();
+  }
+  TEST_REAL_SIMILAR(HyperScore::compute(0.1, false, exp_spectrum, theo_mz, theo_ion_types), HyperScore::compute(0.1, false, exp_spectrum, theo_spectrum));
+  TEST_REAL_SIMILAR(HyperScore::compute(10, true, exp_spectrum, theo_mz, theo_ion_types), 67.8210771);
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
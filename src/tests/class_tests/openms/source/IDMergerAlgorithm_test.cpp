@@ -150,6 +150,10 @@ START_TEST(IDMergerAlgorithm, "$Id$")
       TEST_EQUAL(pes.size(), 9)
       TEST_EQUAL(peres.size(), 8)
       TEST_EQUAL(prres.getHits().size(), 7)
+      // proteins are kept in the order of their first occurrence
+      TEST_EQUAL(prres.getHits()[0].getAccession(), "A")
+      TEST_EQUAL(prres.getHits()[3].getAccession(), "D")
+      TEST_EQUAL(prres.getHits()[6].getAccession(), "G")
       StringList toFill; prres.getPrimaryMSRunPath(toFill);
       TEST_EQUAL(toFill.size(), 7)
       TEST_EQUAL(static_cast<int>(peres[2].getMetaValue("id_merge_index")), 2)
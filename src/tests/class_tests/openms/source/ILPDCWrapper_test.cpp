@@ -68,7 +68,7 @@ START_SECTION(virtual ~ILPDCWrapper())
 END_SECTION
 
 
-START_SECTION((double compute(const FeatureMap fm, PairsType &pairs, Size verbose_level) const))
+START_SECTION((double compute(const FeatureMap& fm, PairsType& pairs, Size verbose_level) const))
 {
   EmpiricalFormula ef("H1");
   Adduct a(+1, 1, ef.getMonoWeight(), "H1", 0.1, 0, "");
@@ -90,6 +90,37 @@ START_SECTION((double compute(const FeatureMap fm, PairsType &pairs, Size verbos
 }
 END_SECTION
 
+START_SECTION((void setGreedyThreshold(Size max_edges)))
+{
+  ILPDCWrapper iw;
+  TEST_EQUAL(iw.getGreedyThreshold(), 0)
+  iw.setGreedyThreshold(1);
+  TEST_EQUAL(iw.getGreedyThreshold(), 1)
+
+  FeatureMap fm;
+  fm.resize(3);
+  // f1 cannot have charge 2 and 3 at the same time; the best edge wins
+  ILPDCWrapper::PairsType pairs;
+  pairs.push_back(ChargePair(0, 1, 1, 2, Compomer(1, 0.0, log(0.9)), 0.0, false));
+  pairs.push_back(ChargePair(1, 2, 3, 1, Compomer(2, 0.0, log(0.5)), 0.0, false));
+  pairs.push_back(ChargePair(0, 2, 1, 1, Compomer(0, 0.0, log(0.3)), 0.0, false));
+
+  double score = iw.compute(fm, pairs, 0);
+  TEST_REAL_SIMILAR(score, 0.9 + 0.3)
+  TEST_EQUAL(pairs.size(), 3)
+  for (Size i = 0; i < pairs.size(); ++i)
+  {
+    TEST_EQUAL(pairs[i].isActive(), pairs[i].getCharge(1) != 3)
+  }
+}
+END_SECTION
+
+START_SECTION((Size getGreedyThreshold() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
 
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
@@ -224,6 +224,62 @@ START_SECTION(void store(String filename, const std::vector<ProteinIdentificatio
 END_SECTION
 
 
+START_SECTION(void transform(const String& filename, Interfaces::IIdentificationConsumer* consumer, Size batch_size = 10000))
+  // collects everything, remembers the batch sizes
+  struct CollectingConsumer : public Interfaces::IIdentificationConsumer
+  {
+    std::vector<ProteinIdentification> protein_ids;
+    std::vector<PeptideIdentification> peptide_ids;
+    std::vector<Size> batches;
+    Size peptides_before_proteins = 0;
+
+    void consumeProteinIdentification(ProteinIdentification& prot_id) override
+    {
+      protein_ids.push_back(prot_id);
+    }
+
+    void consumePeptideIdentifications(std::vector<PeptideIdentification>& pep_ids) override
+    {
+      batches.push_back(pep_ids.size());
+      for (auto& pep : pep_ids)
+      {
+        bool found = false;
+        for (const auto& prot : protein_ids) found |= (prot.getIdentifier() == pep.getIdentifier());
+        if (!found) ++peptides_before_proteins;
+        peptide_ids.push_back(std::move(pep));
+      }
+    }
+  };
+
+  std::vector<ProteinIdentification> protein_ids;
+  std::vector<PeptideIdentification> peptide_ids;
+  IdXMLFile().load(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_whole.idXML"), protein_ids, peptide_ids);
+
+  CollectingConsumer consumer;
+  IdXMLFile().transform(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_whole.idXML"), &consumer, 1);
+  TEST_EQUAL(consumer.protein_ids.size(), 2)
+  TEST_EQUAL(consumer.peptide_ids.size(), 3)
+  TEST_EQUAL(consumer.batches.size(), 3) // batch size 1
+  TEST_EQUAL(consumer.peptides_before_proteins, 0)
+  // same content as load() (identifiers are unique per load)
+  for (Size i = 0; i < protein_ids.size(); ++i)
+  {
+    consumer.protein_ids[i].setIdentifier(protein_ids[i].getIdentifier());
+  }
+  for (Size i = 0; i < peptide_ids.size(); ++i)
+  {
+    consumer.peptide_ids[i].setIdentifier(peptide_ids[i].getIdentifier());
+  }
+  TEST_EQUAL(consumer.protein_ids == protein_ids, true)
+  TEST_EQUAL(consumer.peptide_ids == peptide_ids, true)
+
+  CollectingConsumer consumer2;
+  IdXMLFile().transform(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_whole.idXML"), &consumer2);
+  TEST_EQUAL(consumer2.peptide_ids.size(), 3)
+  TEST_EQUAL(consumer2.batches.size(), 2) // one per run
+END_SECTION
+
+
 START_SECTION([EXTRA] static bool isValid(const String& filename))
   std::vector<ProteinIdentification> protein_ids, protein_ids2;
   std::vector<PeptideIdentification> peptide_ids, peptide_ids2;
@@ -0,0 +1,150 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/FORMAT/DATAACCESS/IdXMLWritingConsumer.h>
+///////////////////////////
+
+#include <OpenMS/CONCEPT/FuzzyStringComparator.h>
+#include <OpenMS/FORMAT/IdXMLFile.h>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(IdXMLWritingConsumer, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+IdXMLWritingConsumer* ptr = nullptr;
+IdXMLWritingConsumer* null_ptr = nullptr;
+START_SECTION((explicit IdXMLWritingConsumer(const String& filename, const String& document_id = "")))
+{
+  String filename;
+  NEW_TMP_FILE(filename)
+  ptr = new IdXMLWritingConsumer(filename);
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EXCEPTION(Exception::UnableToCreateFile, IdXMLWritingConsumer("wrong_extension.txt"))
+}
+END_SECTION
+
+START_SECTION((~IdXMLWritingConsumer()))
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((void consumeProteinIdentification(ProteinIdentification& prot_id)))
+{
+  String filename;
+  NEW_TMP_FILE(filename)
+  IdXMLWritingConsumer writer(filename);
+  ProteinIdentification prot_id;
+  prot_id.setIdentifier("run_1");
+  writer.consumeProteinIdentification(prot_id);
+  TEST_EXCEPTION(Exception::IllegalArgument, writer.consumeProteinIdentification(prot_id))
+}
+END_SECTION
+
+START_SECTION((void consumePeptideIdentifications(std::vector<PeptideIdentification>& pep_ids)))
+{
+  String filename;
+  NEW_TMP_FILE(filename)
+  {
+    IdXMLWritingConsumer writer(filename);
+    ProteinIdentification prot_id;
+    prot_id.setIdentifier("run_1");
+    prot_id.insertHit(ProteinHit(1.0, 1, "PROT1", "PEPTIDEK"));
+    writer.consumeProteinIdentification(prot_id);
+
+    vector<PeptideIdentification> pep_ids(3);
+    PeptideHit hit(10.0, 1, 2, AASequence::fromString("PEPTIDEK"));
+    hit.addPeptideEvidence(PeptideEvidence("PROT1", 0, 7, PeptideEvidence::N_TERMINAL_AA, PeptideEvidence::C_TERMINAL_AA));
+    pep_ids[0].setIdentifier("run_1");
+    pep_ids[0].insertHit(hit);
+    pep_ids[1].setIdentifier("run_1"); // no hits - omitted
+    pep_ids[2].setIdentifier("unknown_run"); // omitted
+    pep_ids[2].insertHit(hit);
+    writer.consumePeptideIdentifications(pep_ids);
+
+    // unknown protein accession
+    vector<PeptideIdentification> wrong(1);
+    wrong[0].setIdentifier("run_1");
+    hit.setPeptideEvidences(vector<PeptideEvidence>(1, PeptideEvidence("PROT2", 0, 7, PeptideEvidence::N_TERMINAL_AA, PeptideEvidence::C_TERMINAL_AA)));
+    wrong[0].insertHit(hit);
+    TEST_EXCEPTION(Exception::ElementNotFound, writer.consumePeptideIdentifications(wrong))
+  } // destructor writes the file
+
+  vector<ProteinIdentification> protein_ids;
+  vector<PeptideIdentification> peptide_ids;
+  IdXMLFile().load(filename, protein_ids, peptide_ids);
+  TEST_EQUAL(protein_ids.size(), 1)
+  TEST_EQUAL(protein_ids[0].getHits().size(), 1)
+  TEST_EQUAL(peptide_ids.size(), 1)
+  TEST_EQUAL(peptide_ids[0].getHits()[0].getSequence().toString(), "PEPTIDEK")
+  TEST_EQUAL(peptide_ids[0].getHits()[0].getPeptideEvidences()[0].getProteinAccession(), "PROT1")
+  TEST_EQUAL(peptide_ids[0].getIdentifier(), protein_ids[0].getIdentifier())
+}
+END_SECTION
+
+START_SECTION((void close()))
+{
+  // streaming a file through the writer gives the same result as store()
+  String target_file = OPENMS_GET_TEST_DATA_PATH("IdXMLFile_whole.idXML");
+  String filename;
+  NEW_TMP_FILE(filename)
+  IdXMLWritingConsumer writer(filename, "LSID1234");
+  IdXMLFile().transform(target_file, &writer, 1);
+  writer.close();
+
+  FuzzyStringComparator fuzzy;
+  fuzzy.setWhitelist(ListUtils::create<String>("<?xml-stylesheet"));
+  fuzzy.setAcceptableAbsolute(0.0001);
+  TEST_EQUAL(fuzzy.compareFiles(filename, target_file), true);
+
+  // empty output is valid
+  NEW_TMP_FILE(filename)
+  IdXMLWritingConsumer empty(filename);
+  empty.close();
+  TEST_EQUAL(IdXMLFile().isValid(filename, std::cerr), true)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
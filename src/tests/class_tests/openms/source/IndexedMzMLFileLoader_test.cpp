@@ -121,6 +121,40 @@ START_SECTION(bool load(const String& filename, OnDiscPeakMap& exp))
 }
 END_SECTION
 
+START_SECTION(bool load(const String& filename, PeakMap& exp))
+{
+  IndexedMzMLFileLoader file;
+  PeakMap exp;
+  bool success = file.load(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), exp);
+  TEST_EQUAL(success, true)
+
+  PeakMap exp2;
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), exp2);
+
+  TEST_EQUAL(exp.getNrSpectra(), 2)
+  TEST_EQUAL(exp.getNrChromatograms(), 1)
+  TEST_EQUAL(exp == exp2, true)
+
+  // MS level filtering happens in the meta data pass
+  file.getOptions().addMSLevel(2);
+  PeakMap exp3, exp4;
+  file.load(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), exp3);
+  MzMLFile f;
+  f.setOptions(file.getOptions());
+  f.load(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), exp4);
+  TEST_EQUAL(exp3.size(), exp4.size())
+  TEST_EQUAL(exp3 == exp4, true)
+
+  // files without index are parsed sequentially
+  IndexedMzMLFileLoader file2;
+  PeakMap exp5, exp6;
+  success = file2.load(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), exp5);
+  TEST_EQUAL(success, false)
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), exp6);
+  TEST_EQUAL(exp5 == exp6, true)
+}
+END_SECTION
+
 START_SECTION([EXTRA]CheckParsing)
 {
   // Check return value of load
@@ -44,6 +44,8 @@
 #include <OpenMS/DATASTRUCTURES/Map.h>
 #include <OpenMS/CHEMISTRY/ResidueDB.h>
 #include <OpenMS/CHEMISTRY/Residue.h>
+#include <fstream>
+#include <iterator>
 
 using namespace OpenMS;
 using namespace ims;
@@ -97,25 +99,93 @@ START_SECTION(~IntegerMassDecomposer())
 }
 END_SECTION
 
-START_SECTION((bool exist(value_type mass)))
+START_SECTION((IntegerMassDecomposer(const Weights &alphabet, const std::string &table_file)))
+{
+  String table_file;
+  NEW_TMP_FILE(table_file)
+  Weights weights = createWeights();
+  IntegerMassDecomposer<> computed(weights, table_file); // table does not exist yet: computed and stored
+  IntegerMassDecomposer<> loaded(weights, table_file);
+  IntegerMassDecomposer<> plain(weights);
+  for (IntegerMassDecomposer<>::value_type mass = 50000; mass < 60000; mass += 997)
+  {
+    TEST_EQUAL(loaded.exist(mass), plain.exist(mass))
+    TEST_EQUAL(loaded.getDecomposition(mass) == plain.getDecomposition(mass), true)
+    TEST_EQUAL(loaded.getAllDecompositions(mass) == plain.getAllDecompositions(mass), true)
+    TEST_EQUAL(computed.getAllDecompositions(mass) == plain.getAllDecompositions(mass), true)
+  }
+}
+END_SECTION
+
+START_SECTION((void storeTable(const std::string &filename) const))
+{
+  IntegerMassDecomposer<> decomposer(createWeights());
+  String table_file;
+  NEW_TMP_FILE(table_file)
+  decomposer.storeTable(table_file);
+  TEST_EQUAL(IntegerMassDecomposer<>(createWeights()).loadTable(table_file), true)
+  TEST_EXCEPTION(Exception::UnableToCreateFile, decomposer.storeTable("/this/directory/does/not/exist/table.ert"))
+}
+END_SECTION
+
+START_SECTION((bool loadTable(const std::string &filename)))
+{
+  Weights weights = createWeights();
+  IntegerMassDecomposer<> decomposer(weights);
+  String table_file;
+  NEW_TMP_FILE(table_file)
+  decomposer.storeTable(table_file);
+
+  IntegerMassDecomposer<> loaded(weights);
+  TEST_EQUAL(loaded.loadTable(table_file), true)
+  TEST_EQUAL(loaded.getAllDecompositions(55555) == decomposer.getAllDecompositions(55555), true)
+  TEST_EQUAL(loaded.loadTable("this_file_does_not_exist.ert"), false)
+
+  // table of a different alphabet is rejected
+  Weights other(std::vector<double>{57.02146, 71.03711, 87.03203}, 0.01);
+  IntegerMassDecomposer<> different(other);
+  TEST_EQUAL(different.loadTable(table_file), false)
+  TEST_EQUAL(different.exist(5702), true)
+
+  // not a table at all
+  TEST_EQUAL(loaded.loadTable(OPENMS_GET_TEST_DATA_PATH("reducedHMDBMapping.tsv")), false)
+
+  // truncated table
+  String truncated_file;
+  NEW_TMP_FILE(truncated_file)
+  {
+    std::ifstream in(table_file.c_str(), std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::ofstream out(truncated_file.c_str(), std::ios::binary);
+    out.write(content.data(), content.size() - 8);
+  }
+  TEST_EQUAL(loaded.loadTable(truncated_file), false)
+
+  // copies share the mapped table
+  IntegerMassDecomposer<> copy(loaded);
+  TEST_EQUAL(copy.getAllDecompositions(55555) == decomposer.getAllDecompositions(55555), true)
+}
+END_SECTION
+
+START_SECTION((bool exist(value_type mass) const))
 {
   // TODO
 }
 END_SECTION
 
-START_SECTION((IntegerMassDecomposer< ValueType, DecompositionValueType >::decomposition_type getDecomposition(value_type mass)))
+START_SECTION((IntegerMassDecomposer< ValueType, DecompositionValueType >::decomposition_type getDecomposition(value_type mass) const))
 {
   // TODO
 }
 END_SECTION
 
-START_SECTION((IntegerMassDecomposer< ValueType, DecompositionValueType >::decompositions_type getAllDecompositions(value_type mass)))
+START_SECTION((IntegerMassDecomposer< ValueType, DecompositionValueType >::decompositions_type getAllDecompositions(value_type mass) const))
 {
   // TODO
 }
 END_SECTION
 
-START_SECTION((IntegerMassDecomposer< ValueType, DecompositionValueType >::decomposition_value_type getNumberOfDecompositions(value_type mass)))
+START_SECTION((IntegerMassDecomposer< ValueType, DecompositionValueType >::decomposition_value_type getNumberOfDecompositions(value_type mass) const))
 {
   // TODO
 }
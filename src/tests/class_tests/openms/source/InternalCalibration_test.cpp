@@ -69,7 +69,7 @@ START_SECTION(~InternalCalibration())
 END_SECTION
 
 
-START_SECTION(Size fillCalibrants(const PeakMap exp, const std::vector<InternalCalibration::LockMass>& ref_masses, double tol_ppm, bool lock_require_mono, bool lock_require_iso, CalibrationData& failed_lock_masses, bool verbose = true))
+START_SECTION(Size fillCalibrants(const PeakMap& exp, const std::vector<InternalCalibration::LockMass>& ref_masses, double tol_ppm, bool lock_require_mono, bool lock_require_iso, CalibrationData& failed_lock_masses, bool verbose = true))
   PeakMap exp;
   MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("InternalCalibration_2_lockmass.mzML.gz"), exp);
   std::vector<InternalCalibration::LockMass> ref_masses;
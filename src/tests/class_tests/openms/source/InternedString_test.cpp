@@ -0,0 +1,161 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/DATASTRUCTURES/InternedString.h>
+
+#include <unordered_set>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(InternedString, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+InternedString* ptr = nullptr;
+InternedString* null_ptr = nullptr;
+START_SECTION((InternedString()))
+{
+  ptr = new InternedString();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->empty(), true)
+  TEST_EQUAL(ptr->get(), "")
+}
+END_SECTION
+
+START_SECTION((~InternedString()))
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((explicit InternedString(const String& s)))
+{
+  InternedString a(String("P01234"));
+  TEST_EQUAL(a.get(), "P01234")
+  TEST_EQUAL(a.empty(), false)
+  InternedString e(String(""));
+  TEST_EQUAL(e == InternedString(), true)
+}
+END_SECTION
+
+START_SECTION((InternedString& operator=(const String& s)))
+{
+  InternedString a;
+  a = String("Q98765");
+  TEST_EQUAL(a.get(), "Q98765")
+  TEST_EQUAL(a == InternedString(String("Q98765")), true)
+}
+END_SECTION
+
+START_SECTION((const String& get() const))
+{
+  InternedString a(String("P01234")), b(String("P01234"));
+  // both refer to the same entry of the pool
+  TEST_EQUAL(&a.get() == &b.get(), true)
+}
+END_SECTION
+
+START_SECTION((operator const String&() const))
+{
+  InternedString a(String("P01234"));
+  const String& s = a;
+  TEST_EQUAL(s, "P01234")
+}
+END_SECTION
+
+START_SECTION((bool empty() const))
+{
+  TEST_EQUAL(InternedString().empty(), true)
+  TEST_EQUAL(InternedString(String("x")).empty(), false)
+}
+END_SECTION
+
+START_SECTION((bool operator==(const InternedString& rhs) const))
+{
+  TEST_EQUAL(InternedString(String("A")) == InternedString(String("A")), true)
+  TEST_EQUAL(InternedString(String("A")) == InternedString(String("B")), false)
+}
+END_SECTION
+
+START_SECTION((bool operator!=(const InternedString& rhs) const))
+{
+  TEST_EQUAL(InternedString(String("A")) != InternedString(String("A")), false)
+  TEST_EQUAL(InternedString(String("A")) != InternedString(String("B")), true)
+}
+END_SECTION
+
+START_SECTION((bool operator<(const InternedString& rhs) const))
+{
+  // ordering uses the values, not the pool entries
+  InternedString b(String("B")), a(String("A"));
+  TEST_EQUAL(a < b, true)
+  TEST_EQUAL(b < a, false)
+  TEST_EQUAL(a < a, false)
+}
+END_SECTION
+
+START_SECTION((std::size_t hash() const))
+{
+  InternedString a(String("P01234")), b(String("P01234"));
+  TEST_EQUAL(a.hash(), b.hash())
+  TEST_EQUAL(std::hash<InternedString>()(a), a.hash())
+
+  unordered_set<InternedString> set;
+  set.insert(a);
+  set.insert(b);
+  set.insert(InternedString(String("Q98765")));
+  TEST_EQUAL(set.size(), 2)
+}
+END_SECTION
+
+START_SECTION((static Size poolSize()))
+{
+  Size before = InternedString::poolSize();
+  InternedString a(String("InternedString_test_unique_value"));
+  TEST_EQUAL(InternedString::poolSize(), before + 1)
+  InternedString b(String("InternedString_test_unique_value"));
+  TEST_EQUAL(InternedString::poolSize(), before + 1)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
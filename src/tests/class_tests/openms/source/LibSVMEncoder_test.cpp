@@ -272,6 +272,48 @@ START_SECTION((svm_problem* encodeLibSVMProblemWithCompositionAndLengthVectors(c
 	delete problem;
 END_SECTION
 
+START_SECTION((void encodeCompositionAndLengthVectors(const std::vector<String>& sequences, const String& allowed_characters, UInt maximum_sequence_length, std::vector<svm_node>& nodes, std::vector<svm_node*>& vectors, std::vector<Size>& sequence_to_vector) const))
+	vector<String> sequences;
+	String allowed_characters = "ACNGT";
+	vector<svm_node> nodes;
+	vector<svm_node*> vectors;
+	vector<Size> sequence_to_vector;
+
+	sequences.push_back(String("ACCGGGTTTT"));
+	sequences.push_back(String("ACCA"));
+	sequences.push_back(String("ACCGGGTTTT"));
+
+	encoder.encodeCompositionAndLengthVectors(sequences, allowed_characters, 10, nodes, vectors, sequence_to_vector);
+	TEST_EQUAL(vectors.size(), 2)
+	TEST_EQUAL(nodes.size(), 10)
+	TEST_EQUAL(sequence_to_vector.size(), 3)
+	ABORT_IF(vectors.size() != 2 || sequence_to_vector.size() != 3)
+	TEST_EQUAL(sequence_to_vector[0], 0)
+	TEST_EQUAL(sequence_to_vector[1], 1)
+	TEST_EQUAL(sequence_to_vector[2], 0)
+
+	// same vectors as encodeLibSVMProblemWithCompositionAndLengthVectors
+	vector<double> labels(2, 0.0);
+	sequences.pop_back();
+	svm_problem* problem = encoder.encodeLibSVMProblemWithCompositionAndLengthVectors(sequences, labels, allowed_characters, 10);
+	for (Size i = 0; i < 2; ++i)
+	{
+		for (Size j = 0; ; ++j)
+		{
+			TEST_EQUAL(vectors[i][j].index, problem->x[i][j].index)
+			TEST_REAL_SIMILAR(vectors[i][j].value, problem->x[i][j].value)
+			if (vectors[i][j].index == -1 || problem->x[i][j].index == -1) break;
+		}
+	}
+	LibSVMEncoder::destroyProblem(problem);
+
+	sequences.clear();
+	encoder.encodeCompositionAndLengthVectors(sequences, allowed_characters, 10, nodes, vectors, sequence_to_vector);
+	TEST_EQUAL(vectors.size(), 0)
+	TEST_EQUAL(nodes.size(), 0)
+	TEST_EQUAL(sequence_to_vector.size(), 0)
+END_SECTION
+
 START_SECTION((svm_problem* encodeLibSVMProblemWithCompositionLengthAndWeightVectors(const std::vector< String > &sequences, std::vector< double > &labels, const String &allowed_characters)))
 	vector<String> sequences;
 	String allowed_characters = "ACNGT";
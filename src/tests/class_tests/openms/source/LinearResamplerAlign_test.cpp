@@ -220,6 +220,56 @@ START_SECTION( ( template <typename PeakTypeIterator, typename ConstPeakTypeIter
 }
 END_SECTION
 
+START_SECTION((template <typename MZType, typename IntensityType, typename ResampledIntensityType> static void raster_uniform(const MZType* mz, const IntensityType* intensity, Size size, double start_pos, double spacing, ResampledIntensityType* resampled_intensity, Size resampled_size)))
+{
+  std::vector<double> mz_data = {0, 0.5, 1., 1.6, 1.8};
+  std::vector<float> int_data = {3.0f, 6.0f, 8.0f, 2.0f, 1.0f};
+
+  // same raster as above: 0, 0.75, 1.5 and 2.25
+  std::vector<double> int_res_data(4, 0.0);
+  LinearResamplerAlign::raster_uniform(mz_data.data(), int_data.data(), mz_data.size(), 0.0, 0.75, int_res_data.data(), int_res_data.size());
+
+  TEST_REAL_SIMILAR(int_res_data[0], 3+2);
+  TEST_REAL_SIMILAR(int_res_data[1], 4+2.0/3*8);
+  TEST_REAL_SIMILAR(int_res_data[2], 1.0/3*8+2+1.0/3);
+  TEST_REAL_SIMILAR(int_res_data[3], 2.0 / 3);
+
+  // intensities are added, points outside of the raster go to the first / last point
+  std::vector<double> mz_outside = {-1.0, 0.75, 1.5, 5.0};
+  std::vector<double> int_outside = {1.0, 2.0, 4.0, 8.0};
+  LinearResamplerAlign::raster_uniform(mz_outside.data(), int_outside.data(), mz_outside.size(), 0.0, 0.75, int_res_data.data(), int_res_data.size());
+
+  TEST_REAL_SIMILAR(int_res_data[0], 3+2 + 1);
+  TEST_REAL_SIMILAR(int_res_data[1], 4+2.0/3*8 + 2);
+  TEST_REAL_SIMILAR(int_res_data[2], 1.0/3*8+2+1.0/3 + 4);
+  TEST_REAL_SIMILAR(int_res_data[3], 2.0 / 3 + 8);
+
+  // gives the same result as raster() on a larger input
+  std::vector<double> mz_many, int_many;
+  for (Size i = 0; i < 1000; ++i)
+  {
+    mz_many.push_back(100.0 + i * 0.0137);
+    int_many.push_back(1.0 + (i % 7));
+  }
+  std::vector<double> mz_res(500), int_res(500, 0.0), int_res_uniform(500, 0.0);
+  for (Size i = 0; i < mz_res.size(); ++i) mz_res[i] = 101.0 + i * 0.02;
+
+  LinearResamplerAlign lr;
+  lr.raster(mz_many.begin(), mz_many.end(), int_many.begin(), int_many.end(),
+            mz_res.begin(), mz_res.end(), int_res.begin(), int_res.end());
+  LinearResamplerAlign::raster_uniform(mz_many.data(), int_many.data(), mz_many.size(), 101.0, 0.02, int_res_uniform.data(), int_res_uniform.size());
+  for (Size i = 0; i < mz_res.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(int_res_uniform[i], int_res[i])
+  }
+
+  // a single resampling point gets everything
+  double single = 0.0;
+  LinearResamplerAlign::raster_uniform(mz_data.data(), int_data.data(), mz_data.size(), 1.0, 0.75, &single, 1);
+  TEST_REAL_SIMILAR(single, 20)
+}
+END_SECTION
+
 // it should work with alignment to 0, 1.8 and give the same result
 START_SECTION((template < template< typename > class SpecT, typename PeakType > void raster_align(SpecT< PeakType > &spectrum, double start_pos, double end_pos)))
 {
@@ -510,6 +510,52 @@ START_SECTION(([EXTRA] Macro test - OPENMS_LOG_DEBUG))
 }
 END_SECTION
 
+START_SECTION((bool hasStreams() const))
+{
+  LogStream l1(new LogStreamBuf());
+  TEST_EQUAL(l1.hasStreams(), false)
+  ostringstream stream_by_logger;
+  l1.insert(stream_by_logger);
+  TEST_EQUAL(l1.hasStreams(), true)
+  l1.remove(stream_by_logger);
+  TEST_EQUAL(l1.hasStreams(), false)
+
+  LogStream l2(nullptr);
+  TEST_EQUAL(l2.hasStreams(), false)
+}
+END_SECTION
+
+START_SECTION(([EXTRA] Macros do not evaluate messages for unbound streams))
+{
+  OpenMS_Log_debug.remove(cout);
+  ostringstream stream_by_logger;
+  OpenMS_Log_debug.remove(stream_by_logger);
+  Size evaluated = 0;
+  OPENMS_LOG_DEBUG << ++evaluated << endl;
+  TEST_EQUAL(evaluated, 0)
+
+  OpenMS_Log_debug.insert(stream_by_logger);
+  OPENMS_LOG_DEBUG << ++evaluated << endl;
+  TEST_EQUAL(evaluated, 1)
+  OpenMS_Log_debug.remove(stream_by_logger);
+}
+END_SECTION
+
+START_SECTION(([EXTRA] Macro test - OPENMS_LOG_WARN_LIMITED))
+{
+  OpenMS_Log_warn.remove(cout);
+  OpenMS_Log_warn.rdbuf()->clearCache();
+  ostringstream stream_by_logger;
+  OpenMS_Log_warn.insert(stream_by_logger);
+  for (Size i = 0; i < 10; ++i)
+  {
+    OPENMS_LOG_WARN_LIMITED(3) << i << endl;
+  }
+  OpenMS_Log_warn.remove(stream_by_logger);
+  TEST_EQUAL(stream_by_logger.str(), "0\n1\n2\n")
+}
+END_SECTION
+
 START_SECTION(([EXTRA] Test caching of empty lines))
 {
   ostringstream stream_by_logger;
@@ -59,6 +59,16 @@ public:
     return getMatchingPeptidoforms_(fragment_ion, ions, mz_threshold);
   }
 
+  std::vector<std::string> getMatchingPeptidoformsSorted_test(const double fragment_ion, std::vector<std::pair<double, std::string> >& ions, const double mz_threshold)
+  {
+    return getMatchingPeptidoformsSorted_(fragment_ion, ions, mz_threshold);
+  }
+
+  void sortIonMap_test(IonMapT& ion_map)
+  {
+    sortIonMap_(ion_map);
+  }
+
   int getSwath_test(const std::vector<std::pair<double, double> >& swathes, const double precursor_mz)
   {
     return getSwath_(swathes, precursor_mz);
@@ -133,6 +143,43 @@ START_SECTION(std::vector<std::string> MRMAssay::getMatchingPeptidoforms_(const
 
 END_SECTION
 
+START_SECTION(std::vector<std::string> getMatchingPeptidoformsSorted_(const double fragment_ion, const FragmentSeqMap& ions, const double mz_threshold))
+{
+  MRMAssay_test mrma;
+
+  MRMAssay::IonMapT ion_map;
+  std::vector<std::pair<double, std::string> >& ions = ion_map[0]["PEPTIDEK"];
+  ions.push_back(std::make_pair(100.00, "PEPTIDEK"));
+  ions.push_back(std::make_pair(100.01, "PEPTIDEK"));
+  ions.push_back(std::make_pair(100.10, "PEPT(UniMod:21)IDEK"));
+  ions.push_back(std::make_pair(100.12, "PEPTIDEK"));
+  ions.push_back(std::make_pair(100.11, "PEPTIDEK"));
+  std::vector<std::pair<double, std::string> > unsorted = ions;
+  mrma.sortIonMap_test(ion_map);
+  TEST_EQUAL(std::is_sorted(ions.begin(), ions.end()), true)
+
+  TEST_EQUAL(mrma.getMatchingPeptidoformsSorted_test(100.06, ions, 0.03).size(), 0)
+  std::vector<std::string> isoforms = mrma.getMatchingPeptidoformsSorted_test(100.06, ions, 0.06);
+  TEST_EQUAL(isoforms.size(), 2)
+  ABORT_IF(isoforms.size() != 2)
+  TEST_EQUAL(isoforms[0], "PEPT(UniMod:21)IDEK")
+  TEST_EQUAL(isoforms[1], "PEPTIDEK")
+
+  // same result as the linear scan
+  for (double mz = 99.9; mz < 100.25; mz += 0.005)
+  {
+    TEST_EQUAL(ListUtils::concatenate(mrma.getMatchingPeptidoformsSorted_test(mz, ions, 0.02), "|"),
+               ListUtils::concatenate(mrma.getMatchingPeptidoforms_test(mz, unsorted, 0.02), "|"))
+  }
+}
+END_SECTION
+
+START_SECTION(void sortIonMap_(IonMapT& ion_map))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
 START_SECTION(int MRMAssay::getSwath_(const std::vector<std::pair<double, double> > swathes, const double precursor_mz))
 {
   MRMAssay_test mrma;
@@ -491,7 +491,8 @@ START_SECTION((void generateDecoys(const OpenMS::TargetedExperiment& exp,
                         const std::vector<size_t>& fragment_charges,
                         const bool enable_specific_losses,
                         const bool enable_unspecific_losses,
-                        const int round_decPow = -4) const))
+                        const int round_decPow = -4,
+                        const int seed = -1) const))
 {
   String method = "pseudo-reverse";
   double identity_threshold = 0.7;
@@ -0,0 +1,173 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataBlockMergingConsumer.h>
+
+///////////////////////////
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataStoringConsumer.h>
+#include <OpenMS/FORMAT/MzMLFile.h>
+
+START_TEST(MSDataBlockMergingConsumer, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+using namespace OpenMS;
+
+PeakMap input;
+MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("SpectraMerger_input_2.mzML"), input);
+
+SpectraMerger merger;
+Param p;
+p.setValue("mz_binning_width", 0.0001);
+p.setValue("mz_binning_width_unit", "Da");
+merger.setParameters(p);
+
+MSDataBlockMergingConsumer* merging_consumer_ptr = nullptr;
+MSDataBlockMergingConsumer* merging_consumer_nullPointer = nullptr;
+
+START_SECTION((MSDataBlockMergingConsumer(Interfaces::IMSDataConsumer* next_consumer, const SpectraMerger& merger)))
+{
+  MSDataStoringConsumer storage;
+  merging_consumer_ptr = new MSDataBlockMergingConsumer(&storage, merger);
+  TEST_NOT_EQUAL(merging_consumer_ptr, merging_consumer_nullPointer)
+  delete merging_consumer_ptr;
+}
+END_SECTION
+
+START_SECTION((~MSDataBlockMergingConsumer()))
+{
+  // destructor flushes the open block
+  MSDataStoringConsumer storage;
+  {
+    MSDataBlockMergingConsumer merging_consumer(&storage, merger);
+    MSSpectrum s = input[0];
+    merging_consumer.consumeSpectrum(s);
+    TEST_EQUAL(storage.getData().size(), 0)
+  }
+  TEST_EQUAL(storage.getData().size(), 1)
+}
+END_SECTION
+
+START_SECTION((void consumeSpectrum(SpectrumType& s)))
+{
+  // same result as merging the experiment in memory
+  std::vector<std::pair<Int, String> > settings = {{5, "1"}, {4, "2"}, {4, "1,2"}, {1, "1"}};
+  for (const auto& setting : settings)
+  {
+    Param param = merger.getParameters();
+    param.setValue("block_method:rt_block_size", setting.first);
+    param.setValue("block_method:ms_levels", ListUtils::create<Int>(setting.second));
+    SpectraMerger block_merger;
+    block_merger.setParameters(param);
+
+    PeakMap expected = input;
+    block_merger.mergeSpectraBlockWise(expected);
+
+    MSDataStoringConsumer storage;
+    {
+      MSDataBlockMergingConsumer merging_consumer(&storage, block_merger);
+      for (Size i = 0; i < input.size(); ++i)
+      {
+        MSSpectrum s = input[i];
+        merging_consumer.consumeSpectrum(s);
+      }
+    }
+    const PeakMap& result = storage.getData();
+
+    TEST_EQUAL(result.size(), expected.size())
+    ABORT_IF(result.size() != expected.size())
+    for (Size i = 0; i < result.size(); ++i)
+    {
+      TEST_REAL_SIMILAR(result[i].getRT(), expected[i].getRT())
+      TEST_EQUAL(result[i].getMSLevel(), expected[i].getMSLevel())
+      TEST_EQUAL(result[i].size(), expected[i].size())
+    }
+  }
+}
+END_SECTION
+
+START_SECTION((void consumeChromatogram(ChromatogramType& c)))
+{
+  MSDataStoringConsumer storage;
+  MSDataBlockMergingConsumer merging_consumer(&storage, merger);
+  MSSpectrum s = input[0];
+  merging_consumer.consumeSpectrum(s);
+  MSChromatogram c;
+  merging_consumer.consumeChromatogram(c);
+  // spectra are passed on before the chromatogram
+  TEST_EQUAL(storage.getData().size(), 1)
+  TEST_EQUAL(storage.getData().getChromatograms().size(), 1)
+}
+END_SECTION
+
+START_SECTION((void flush()))
+{
+  MSDataStoringConsumer storage;
+  MSDataBlockMergingConsumer merging_consumer(&storage, merger);
+  for (Size i = 0; i < 3; ++i)
+  {
+    MSSpectrum s = input[i];
+    merging_consumer.consumeSpectrum(s);
+  }
+  merging_consumer.flush();
+  TEST_EQUAL(storage.getData().size() > 0, true)
+  Size size = storage.getData().size();
+  merging_consumer.flush();
+  TEST_EQUAL(storage.getData().size(), size)
+}
+END_SECTION
+
+START_SECTION((void setExpectedSize(Size expectedSpectra, Size expectedChromatograms)))
+{
+  NOT_TESTABLE // forwarded
+}
+END_SECTION
+
+START_SECTION((void setExperimentalSettings(const OpenMS::ExperimentalSettings& exp)))
+{
+  NOT_TESTABLE // forwarded
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
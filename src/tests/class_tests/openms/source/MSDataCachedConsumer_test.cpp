@@ -42,6 +42,7 @@
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SimpleOpenMSSpectraAccessFactory.h>
 #include <OpenMS/FORMAT/CachedMzML.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessOpenMSCached.h>
 
 START_TEST(MSDataCachedConsumer, "$Id$")
 
@@ -193,6 +194,47 @@ START_SECTION((void setExpectedSize(Size expectedSpectra, Size expectedChromatog
   NOT_TESTABLE // tested above
 END_SECTION
 
+START_SECTION([EXTRA] index recorded while writing)
+{
+  std::string tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+
+  PeakMap exp;
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), exp);
+  PeakMap meta = exp;
+  std::vector<std::streampos> spectra_index, chrom_index;
+  {
+    MSDataCachedConsumer cached_consumer(tmp_filename + ".cached", true);
+    cached_consumer.setExpectedSize(meta.getNrSpectra(), meta.getNrChromatograms());
+    for (auto& s : meta.getSpectra()) cached_consumer.consumeSpectrum(s);
+    for (auto& c : meta.getChromatograms()) cached_consumer.consumeChromatogram(c);
+    spectra_index = cached_consumer.getSpectraIndex();
+    chrom_index = cached_consumer.getChromatogramIndex();
+  }
+
+  // identical to the index created from the finished file
+  Internal::CachedMzMLHandler cache;
+  cache.createMemdumpIndex(tmp_filename + ".cached");
+  TEST_EQUAL(spectra_index.size(), exp.getNrSpectra())
+  TEST_EQUAL(chrom_index.size(), exp.getNrChromatograms())
+  TEST_EQUAL(spectra_index == cache.getSpectraIndex(), true)
+  TEST_EQUAL(chrom_index == cache.getChromatogramIndex(), true)
+
+  // the file can be accessed with the recorded index and the meta data in memory
+  SpectrumAccessOpenMSCached access(tmp_filename, meta, spectra_index, chrom_index);
+  TEST_EQUAL(access.getNrSpectra(), exp.getNrSpectra())
+  TEST_EQUAL(access.getNrChromatograms(), exp.getNrChromatograms())
+  TEST_EQUAL(access.getSpectrumById(1)->getMZArray()->data.size(), exp.getSpectrum(1).size())
+  TEST_REAL_SIMILAR(access.getSpectrumById(1)->getMZArray()->data[0], exp.getSpectrum(1)[0].getMZ())
+  TEST_EQUAL(access.getChromatogramById(0)->getTimeArray()->data.size(), exp.getChromatogram(0).size())
+  TEST_EQUAL(access.getSpectraMetaInfo(1).getNativeID(), exp.getSpectrum(1).getNativeID())
+
+  // the index has to match the meta data
+  spectra_index.pop_back();
+  TEST_EXCEPTION(Exception::IllegalArgument, SpectrumAccessOpenMSCached(tmp_filename, meta, spectra_index, chrom_index))
+}
+END_SECTION
+
 START_SECTION([EXTRA] test empty file)
 {
   // try an empty file
@@ -0,0 +1,199 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataPeakPickingConsumer.h>
+
+///////////////////////////
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataStoringConsumer.h>
+
+#include <cmath>
+
+START_TEST(MSDataPeakPickingConsumer, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+using namespace OpenMS;
+
+// profile spectrum with three gaussian peaks
+MSSpectrum profile;
+profile.setMSLevel(1);
+profile.setType(SpectrumSettings::PROFILE);
+for (Size i = 0; i < 600; ++i)
+{
+  double mz = 400.0 + i * 0.005;
+  double intensity = 0.0;
+  for (double center : {400.5, 401.2, 402.4})
+  {
+    intensity += 1000.0 * std::exp(-(mz - center) * (mz - center) / (2 * 0.01 * 0.01));
+  }
+  profile.push_back(Peak1D(mz, intensity));
+}
+
+MSChromatogram profile_chrom;
+for (Size i = 0; i < 100; ++i)
+{
+  double rt = i * 0.5;
+  profile_chrom.push_back(ChromatogramPeak(rt, 1000.0 * std::exp(-(rt - 25.0) * (rt - 25.0) / (2 * 2.0 * 2.0))));
+}
+
+PeakPickerHiRes pp;
+Param p = pp.getParameters();
+p.setValue("signal_to_noise", 0.0);
+pp.setParameters(p);
+
+MSDataPeakPickingConsumer* pp_consumer_ptr = nullptr;
+MSDataPeakPickingConsumer* pp_consumer_nullPointer = nullptr;
+
+START_SECTION((MSDataPeakPickingConsumer(Interfaces::IMSDataConsumer* next_consumer, const PeakPickerHiRes& pp, Size batch_size = 64, bool check_spectrum_type = true)))
+  MSDataStoringConsumer storage;
+  pp_consumer_ptr = new MSDataPeakPickingConsumer(&storage, pp);
+  TEST_NOT_EQUAL(pp_consumer_ptr, pp_consumer_nullPointer)
+END_SECTION
+
+START_SECTION((~MSDataPeakPickingConsumer()))
+  delete pp_consumer_ptr;
+END_SECTION
+
+START_SECTION((void consumeSpectrum(SpectrumType& s)))
+{
+  MSSpectrum expected;
+  pp.pick(profile, expected);
+  TEST_EQUAL(expected.size(), 3)
+
+  MSDataStoringConsumer storage;
+  {
+    MSDataPeakPickingConsumer pp_consumer(&storage, pp, 3);
+
+    MSSpectrum centroided = expected;
+    centroided.setType(SpectrumSettings::CENTROID);
+    for (Size i = 0; i < 7; ++i)
+    {
+      MSSpectrum s = (i == 4 ? centroided : profile);
+      s.setRT(i);
+      pp_consumer.consumeSpectrum(s);
+      TEST_EQUAL(s.size(), (i == 4 ? 3 : 600)) // input is left unchanged
+    }
+    // two full batches have been passed on, the last spectrum is still pending
+    TEST_EQUAL(storage.getData().size(), 6)
+  }
+  // destructor flushes
+  TEST_EQUAL(storage.getData().size(), 7)
+
+  for (Size i = 0; i < 7; ++i)
+  {
+    const MSSpectrum& s = storage.getData()[i];
+    TEST_REAL_SIMILAR(s.getRT(), i)
+    TEST_EQUAL(s.size(), 3)
+    for (Size k = 0; k < s.size(); ++k)
+    {
+      TEST_REAL_SIMILAR(s[k].getMZ(), expected[k].getMZ())
+      TEST_REAL_SIMILAR(s[k].getIntensity(), expected[k].getIntensity())
+    }
+  }
+}
+END_SECTION
+
+START_SECTION((void consumeChromatogram(ChromatogramType& c)))
+{
+  MSChromatogram expected;
+  pp.pick(profile_chrom, expected);
+  TEST_EQUAL(expected.size(), 1)
+
+  MSDataStoringConsumer storage;
+  MSDataPeakPickingConsumer pp_consumer(&storage, pp, 2);
+  pp_consumer.consumeSpectrum(profile);
+  pp_consumer.consumeChromatogram(profile_chrom);
+  // a chromatogram flushes pending spectra to keep the order intact
+  TEST_EQUAL(storage.getData().size(), 1)
+  TEST_EQUAL(storage.getData().getChromatograms().size(), 0)
+  pp_consumer.consumeChromatogram(profile_chrom);
+  TEST_EQUAL(storage.getData().getChromatograms().size(), 2)
+
+  TEST_EQUAL(storage.getData().getChromatograms()[0].size(), 1)
+  TEST_REAL_SIMILAR(storage.getData().getChromatograms()[0][0].getRT(), expected[0].getRT())
+  TEST_REAL_SIMILAR(storage.getData().getChromatograms()[1][0].getIntensity(), expected[0].getIntensity())
+}
+END_SECTION
+
+START_SECTION((void flush()))
+{
+  MSDataStoringConsumer storage;
+  MSDataPeakPickingConsumer pp_consumer(&storage, pp);
+  pp_consumer.consumeSpectrum(profile);
+  pp_consumer.consumeSpectrum(profile);
+  TEST_EQUAL(storage.getData().size(), 0)
+  pp_consumer.flush();
+  TEST_EQUAL(storage.getData().size(), 2)
+  TEST_EQUAL(storage.getData()[1].size(), 3)
+
+  // manual mode: centroided data on a level to be picked is an error
+  Param p_ms1 = pp.getParameters();
+  p_ms1.setValue("ms_levels", ListUtils::create<Int>("1"));
+  PeakPickerHiRes pp_ms1;
+  pp_ms1.setParameters(p_ms1);
+
+  MSSpectrum centroided;
+  pp.pick(profile, centroided);
+  centroided.setType(SpectrumSettings::CENTROID);
+
+  MSDataPeakPickingConsumer pp_consumer_ms1(&storage, pp_ms1);
+  pp_consumer_ms1.consumeSpectrum(centroided);
+  TEST_EXCEPTION(Exception::IllegalArgument, pp_consumer_ms1.flush())
+
+  MSDataPeakPickingConsumer pp_consumer_force(&storage, pp_ms1, 64, false);
+  pp_consumer_force.consumeSpectrum(centroided);
+  pp_consumer_force.flush();
+  TEST_EQUAL(storage.getData().size(), 3)
+}
+END_SECTION
+
+START_SECTION((void setExpectedSize(Size expectedSpectra, Size expectedChromatograms)))
+  NOT_TESTABLE // forwarded to the next consumer
+END_SECTION
+
+START_SECTION((void setExperimentalSettings(const OpenMS::ExperimentalSettings& exp)))
+  NOT_TESTABLE // forwarded to the next consumer
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
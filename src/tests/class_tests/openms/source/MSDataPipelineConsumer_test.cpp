@@ -0,0 +1,238 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataPipelineConsumer.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataStoringConsumer.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataTransformingConsumer.h>
+
+///////////////////////////
+
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+#include <stdexcept>
+
+START_TEST(MSDataPipelineConsumer, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+using namespace OpenMS;
+
+MSDataPipelineConsumer* pipeline_ptr = nullptr;
+MSDataPipelineConsumer* pipeline_nullPointer = nullptr;
+
+START_SECTION((explicit MSDataPipelineConsumer(Size queue_size = 64)))
+  pipeline_ptr = new MSDataPipelineConsumer();
+  TEST_NOT_EQUAL(pipeline_ptr, pipeline_nullPointer)
+END_SECTION
+
+START_SECTION((~MSDataPipelineConsumer()))
+  delete pipeline_ptr;
+END_SECTION
+
+START_SECTION((void appendStage(Interfaces::IMSDataConsumer * consumer, Size workers = 1)))
+{
+  MSDataPipelineConsumer pipeline;
+  TEST_EXCEPTION(Exception::IllegalArgument, pipeline.appendStage(nullptr))
+
+  MSDataStoringConsumer storing_consumer;
+  pipeline.appendFanOut({&storing_consumer});
+  TEST_EXCEPTION(Exception::IllegalArgument, pipeline.appendStage(&storing_consumer))
+}
+END_SECTION
+
+START_SECTION((void appendFanOut(const std::vector<Interfaces::IMSDataConsumer *> & consumers)))
+{
+  MSDataPipelineConsumer pipeline;
+  TEST_EXCEPTION(Exception::IllegalArgument, pipeline.appendFanOut({}))
+
+  MSDataTransformingConsumer transforming_consumer;
+  pipeline.appendStage(&transforming_consumer);
+  MSSpectrum spectrum;
+  pipeline.consumeSpectrum(spectrum);
+  // consuming has started
+  TEST_EXCEPTION(Exception::IllegalArgument, pipeline.appendFanOut({&transforming_consumer}))
+  pipeline.finish();
+}
+END_SECTION
+
+START_SECTION((void consumeSpectrum(SpectrumType & s)))
+{
+  // parallel transformation followed by a sequential stage and a fan-out to two storing consumers
+  MSDataTransformingConsumer scaling_consumer;
+  scaling_consumer.setSpectraProcessingFunc([](MSSpectrum& s)
+  {
+    for (Peak1D& p : s) p.setIntensity(p.getIntensity() * 2);
+  });
+  MSDataTransformingConsumer renaming_consumer;
+  renaming_consumer.setSpectraProcessingFunc([](MSSpectrum& s)
+  {
+    s.setNativeID("scan=" + s.getNativeID());
+  });
+  MSDataStoringConsumer storing_consumer1, storing_consumer2;
+
+  MSDataPipelineConsumer pipeline(4);
+  pipeline.appendStage(&scaling_consumer, 4);
+  pipeline.appendStage(&renaming_consumer);
+  pipeline.appendFanOut({&storing_consumer1, &storing_consumer2});
+  pipeline.setExpectedSize(500, 1);
+
+  for (Size i = 0; i < 500; ++i)
+  {
+    MSSpectrum spectrum;
+    spectrum.setNativeID(String(i));
+    spectrum.push_back(Peak1D(100.0, (float)i));
+    pipeline.consumeSpectrum(spectrum);
+    TEST_EQUAL(spectrum.getNativeID(), String(i)) // the caller's spectrum is not modified
+    if (i == 250)
+    {
+      MSChromatogram chromatogram;
+      chromatogram.setNativeID("chrom");
+      pipeline.consumeChromatogram(chromatogram);
+    }
+  }
+  pipeline.finish();
+
+  const PeakMap& exp1 = storing_consumer1.getData();
+  const PeakMap& exp2 = storing_consumer2.getData();
+  TEST_EQUAL(exp1.size(), 500)
+  TEST_EQUAL(exp2.size(), 500)
+  ABORT_IF(exp1.size() != 500 || exp2.size() != 500)
+  bool in_order = true;
+  for (Size i = 0; i < 500; ++i)
+  {
+    in_order &= exp1[i].getNativeID() == "scan=" + String(i) && exp2[i].getNativeID() == "scan=" + String(i);
+    in_order &= exp1[i][0].getIntensity() == 2.0f * i;
+  }
+  TEST_EQUAL(in_order, true)
+  TEST_EQUAL(exp1.getNrChromatograms(), 1)
+  TEST_EQUAL(exp2.getNrChromatograms(), 1)
+
+  // consuming after finish()
+  MSSpectrum spectrum;
+  TEST_EXCEPTION(Exception::IllegalArgument, pipeline.consumeSpectrum(spectrum))
+}
+END_SECTION
+
+START_SECTION((void consumeChromatogram(ChromatogramType & c)))
+{
+  MSDataTransformingConsumer transforming_consumer;
+  transforming_consumer.setChromatogramProcessingFunc([](MSChromatogram& c)
+  {
+    c.setNativeID(c.getNativeID() + "_processed");
+  });
+  MSDataStoringConsumer storing_consumer;
+
+  MSDataPipelineConsumer pipeline;
+  pipeline.appendStage(&transforming_consumer, 2);
+  pipeline.appendStage(&storing_consumer);
+  for (Size i = 0; i < 20; ++i)
+  {
+    MSChromatogram chromatogram;
+    chromatogram.setNativeID(String(i));
+    pipeline.consumeChromatogram(chromatogram);
+  }
+  pipeline.finish();
+  TEST_EQUAL(storing_consumer.getData().getNrChromatograms(), 20)
+  ABORT_IF(storing_consumer.getData().getNrChromatograms() != 20)
+  TEST_EQUAL(storing_consumer.getData().getChromatograms()[19].getNativeID(), "19_processed")
+}
+END_SECTION
+
+START_SECTION((void finish()))
+{
+  // an exception thrown by a stage is passed on to the caller
+  MSDataTransformingConsumer failing_consumer;
+  failing_consumer.setSpectraProcessingFunc([](MSSpectrum& s)
+  {
+    if (s.getNativeID() == "3") throw std::runtime_error("cannot process spectrum");
+  });
+  MSDataStoringConsumer storing_consumer;
+
+  MSDataPipelineConsumer pipeline;
+  pipeline.appendStage(&failing_consumer);
+  pipeline.appendStage(&storing_consumer);
+  // depending on the timing, the error is reported by a later consumeSpectrum() call or by finish()
+  Size reported = 0;
+  for (Size i = 0; i < 5; ++i)
+  {
+    MSSpectrum spectrum;
+    spectrum.setNativeID(String(i));
+    try
+    {
+      pipeline.consumeSpectrum(spectrum);
+    }
+    catch (std::runtime_error&)
+    {
+      ++reported;
+      break;
+    }
+  }
+  try
+  {
+    pipeline.finish();
+  }
+  catch (std::runtime_error&)
+  {
+    ++reported;
+  }
+  TEST_EQUAL(reported, 1) // reported exactly once
+  pipeline.finish();
+  TEST_EQUAL(storing_consumer.getData().size() <= 3, true)
+
+  // without any stages, nothing happens
+  MSDataPipelineConsumer empty_pipeline;
+  MSSpectrum spectrum;
+  empty_pipeline.consumeSpectrum(spectrum);
+  empty_pipeline.finish();
+}
+END_SECTION
+
+START_SECTION((void setExpectedSize(Size s_size, Size c_size)))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((void setExperimentalSettings(const ExperimentalSettings & settings)))
+  NOT_TESTABLE
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
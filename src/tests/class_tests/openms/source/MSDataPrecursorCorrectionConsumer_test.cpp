@@ -0,0 +1,197 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataPrecursorCorrectionConsumer.h>
+
+///////////////////////////
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataStoringConsumer.h>
+
+START_TEST(MSDataPrecursorCorrectionConsumer, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+using namespace OpenMS;
+
+// MS1 spectrum with three peaks around 500 Th, the most intense one at 499.999
+auto makeMS1 = [](const String& native_id)
+{
+  MSSpectrum s;
+  s.setMSLevel(1);
+  s.setNativeID(native_id);
+  s.push_back(Peak1D(499.9990, 300.0));
+  s.push_back(Peak1D(500.0000, 100.0));
+  s.push_back(Peak1D(500.0020, 200.0));
+  return s;
+};
+
+auto makeMS2 = [](double rt, double pc_mz)
+{
+  MSSpectrum s;
+  s.setMSLevel(2);
+  s.setRT(rt);
+  Precursor pc;
+  pc.setMZ(pc_mz);
+  pc.setIntensity(1.0);
+  s.getPrecursors().push_back(pc);
+  return s;
+};
+
+MSDataPrecursorCorrectionConsumer* ptr = nullptr;
+MSDataPrecursorCorrectionConsumer* null_ptr = nullptr;
+
+START_SECTION((MSDataPrecursorCorrectionConsumer(Interfaces::IMSDataConsumer* next_consumer, CorrectionMethod method, double mz_tolerance, bool ppm, Size max_survey_scans = 8)))
+  MSDataStoringConsumer storage;
+  ptr = new MSDataPrecursorCorrectionConsumer(&storage, MSDataPrecursorCorrectionConsumer::NEAREST_PEAK, 5.0, true);
+  TEST_NOT_EQUAL(ptr, null_ptr)
+END_SECTION
+
+START_SECTION((~MSDataPrecursorCorrectionConsumer()))
+  delete ptr;
+END_SECTION
+
+START_SECTION((void consumeSpectrum(SpectrumType& s)))
+{
+  // nearest peak
+  {
+    MSDataStoringConsumer storage;
+    MSDataPrecursorCorrectionConsumer consumer(&storage, MSDataPrecursorCorrectionConsumer::NEAREST_PEAK, 5.0, true);
+    MSSpectrum s = makeMS2(0.5, 500.0001);
+    consumer.consumeSpectrum(s); // no MS1 spectrum yet
+    s = makeMS1("scan=1");
+    consumer.consumeSpectrum(s);
+    s = makeMS2(1.5, 500.0001);
+    consumer.consumeSpectrum(s);
+    s = makeMS2(2.5, 500.0100); // out of tolerance
+    consumer.consumeSpectrum(s);
+
+    const MSExperiment& out = storage.getData();
+    TEST_EQUAL(out.size(), 4)
+    TEST_REAL_SIMILAR(out[0].getPrecursors()[0].getMZ(), 500.0001)
+    TEST_REAL_SIMILAR(out[2].getPrecursors()[0].getMZ(), 500.0000)
+    TEST_REAL_SIMILAR(out[2].getPrecursors()[0].getIntensity(), 1.0)
+    TEST_REAL_SIMILAR(out[3].getPrecursors()[0].getMZ(), 500.0100)
+    TEST_EQUAL(consumer.getNumberOfCorrectedPrecursors(), 1)
+  }
+
+  // highest intensity peak
+  {
+    MSDataStoringConsumer storage;
+    MSDataPrecursorCorrectionConsumer consumer(&storage, MSDataPrecursorCorrectionConsumer::HIGHEST_INTENSITY_PEAK, 0.0015, false);
+    MSSpectrum s = makeMS1("scan=1");
+    consumer.consumeSpectrum(s);
+    s = makeMS2(1.5, 500.0001);
+    consumer.consumeSpectrum(s);
+
+    const MSExperiment& out = storage.getData();
+    TEST_EQUAL(out.size(), 2)
+    TEST_REAL_SIMILAR(out[1].getPrecursors()[0].getMZ(), 499.9990)
+    TEST_REAL_SIMILAR(out[1].getPrecursors()[0].getIntensity(), 300.0)
+  }
+
+  // referenced survey scans are used while they are in the buffer
+  {
+    MSDataStoringConsumer storage;
+    MSDataPrecursorCorrectionConsumer consumer(&storage, MSDataPrecursorCorrectionConsumer::NEAREST_PEAK, 0.01, false, 2);
+    MSSpectrum s = makeMS1("scan=1");
+    consumer.consumeSpectrum(s);
+    s = makeMS1("scan=2");
+    for (Peak1D& p : s) p.setMZ(p.getMZ() + 0.005);
+    consumer.consumeSpectrum(s);
+    s = makeMS2(2.5, 500.0001);
+    s.getPrecursors()[0].setMetaValue("spectrum_ref", "scan=1");
+    consumer.consumeSpectrum(s);
+    s = makeMS1("scan=3");
+    consumer.consumeSpectrum(s); // pushes 'scan=1' out of the buffer
+    s = makeMS2(3.5, 500.0041);
+    s.getPrecursors()[0].setMetaValue("spectrum_ref", "scan=1");
+    consumer.consumeSpectrum(s);
+
+    const MSExperiment& out = storage.getData();
+    TEST_EQUAL(out.size(), 5)
+    TEST_REAL_SIMILAR(out[2].getPrecursors()[0].getMZ(), 500.0000) // from 'scan=1'
+    TEST_REAL_SIMILAR(out[4].getPrecursors()[0].getMZ(), 500.0020) // most recent ('scan=3')
+  }
+}
+END_SECTION
+
+START_SECTION((void consumeChromatogram(ChromatogramType& c)))
+{
+  MSDataStoringConsumer storage;
+  MSDataPrecursorCorrectionConsumer consumer(&storage, MSDataPrecursorCorrectionConsumer::NEAREST_PEAK, 5.0, true);
+  MSChromatogram c;
+  c.push_back(ChromatogramPeak(1.0, 2.0));
+  consumer.consumeChromatogram(c);
+  TEST_EQUAL(storage.getData().getChromatograms().size(), 1)
+}
+END_SECTION
+
+START_SECTION((Size getNumberOfCorrectedPrecursors() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((const std::vector<double>& getDeltaMZs() const))
+{
+  MSDataStoringConsumer storage;
+  MSDataPrecursorCorrectionConsumer consumer(&storage, MSDataPrecursorCorrectionConsumer::NEAREST_PEAK, 5.0, true);
+  MSSpectrum s = makeMS1("scan=1");
+  consumer.consumeSpectrum(s);
+  s = makeMS2(1.5, 500.0001);
+  consumer.consumeSpectrum(s);
+  TEST_EQUAL(consumer.getDeltaMZs().size(), 1)
+  TEST_REAL_SIMILAR(consumer.getDeltaMZs()[0], -0.0001)
+  TEST_EQUAL(consumer.getMZs().size(), 1)
+  TEST_REAL_SIMILAR(consumer.getMZs()[0], 500.0001)
+  TEST_EQUAL(consumer.getRTs().size(), 1)
+  TEST_REAL_SIMILAR(consumer.getRTs()[0], 1.5)
+}
+END_SECTION
+
+START_SECTION((const std::vector<double>& getMZs() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((const std::vector<double>& getRTs() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -0,0 +1,161 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataSqlConsumer.h>
+#include <OpenMS/FORMAT/SqMassFile.h>
+#include <OpenMS/FORMAT/HANDLERS/MzMLSqliteHandler.h>
+
+///////////////////////////
+
+START_TEST(MSDataSqlConsumer, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+using namespace OpenMS;
+
+MSDataSqlConsumer* ptr = nullptr;
+MSDataSqlConsumer* nullPointer = nullptr;
+
+START_SECTION((MSDataSqlConsumer(String filename, int buffer_size = 500, bool full_meta = true, bool lossy_compression=false, double linear_mass_acc=1e-4)))
+{
+  String tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+  ptr = new MSDataSqlConsumer(tmp_filename);
+  TEST_NOT_EQUAL(ptr, nullPointer)
+}
+END_SECTION
+
+START_SECTION((~MSDataSqlConsumer()))
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((void consumeSpectrum(SpectrumType & s)))
+{
+  // several batches are written in the background
+  String tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+  {
+    MSDataSqlConsumer consumer(tmp_filename, 100);
+    for (Size i = 0; i < 1050; ++i)
+    {
+      MSSpectrum s;
+      s.setNativeID("spectrum=" + String(i));
+      s.setRT(i * 2.0);
+      s.setMSLevel(1);
+      s.push_back(Peak1D(100.0 + i, 10.0));
+      s.push_back(Peak1D(200.0 + i, 20.0));
+      consumer.consumeSpectrum(s);
+      TEST_EQUAL(s.size(), 0) // data is removed from the consumed spectrum
+    }
+  }
+
+  PeakMap exp;
+  SqMassFile().load(tmp_filename, exp);
+  TEST_EQUAL(exp.size(), 1050)
+  ABORT_IF(exp.size() != 1050)
+  bool in_order = true;
+  for (Size i = 0; i < exp.size(); ++i)
+  {
+    in_order &= exp[i].getNativeID() == "spectrum=" + String(i);
+  }
+  TEST_EQUAL(in_order, true)
+  TEST_EQUAL(exp[1049].size(), 2)
+  TEST_REAL_SIMILAR(exp[1049][0].getMZ(), 1149.0)
+  TEST_REAL_SIMILAR(exp[1049].getRT(), 2098.0)
+}
+END_SECTION
+
+START_SECTION((void consumeChromatogram(ChromatogramType & c)))
+{
+  String tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+  {
+    MSDataSqlConsumer consumer(tmp_filename, 10);
+    for (Size i = 0; i < 25; ++i)
+    {
+      MSChromatogram c;
+      c.setNativeID("chromatogram=" + String(i));
+      c.push_back(ChromatogramPeak(1.0, 5.0 * i));
+      consumer.consumeChromatogram(c);
+    }
+  }
+
+  PeakMap exp;
+  SqMassFile().load(tmp_filename, exp);
+  TEST_EQUAL(exp.getNrChromatograms(), 25)
+  ABORT_IF(exp.getNrChromatograms() != 25)
+  TEST_EQUAL(exp.getChromatograms()[24].getNativeID(), "chromatogram=24")
+  TEST_REAL_SIMILAR(exp.getChromatograms()[24][0].getIntensity(), 120.0)
+}
+END_SECTION
+
+START_SECTION((void flush()))
+{
+  String tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+  MSDataSqlConsumer consumer(tmp_filename, 100);
+  for (Size i = 0; i < 150; ++i)
+  {
+    MSSpectrum s;
+    s.setNativeID("spectrum=" + String(i));
+    s.push_back(Peak1D(100.0, 10.0));
+    consumer.consumeSpectrum(s);
+  }
+  consumer.flush(); // all data is on disk afterwards
+
+  OpenMS::Internal::MzMLSqliteHandler handler(tmp_filename);
+  TEST_EQUAL(handler.getNrSpectra(), 150)
+}
+END_SECTION
+
+START_SECTION((void setExpectedSize(Size, Size)))
+  NOT_TESTABLE // does nothing
+END_SECTION
+
+START_SECTION((void setExperimentalSettings(const ExperimentalSettings&)))
+  NOT_TESTABLE // does nothing
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
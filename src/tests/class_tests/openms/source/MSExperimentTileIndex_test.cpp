@@ -0,0 +1,267 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/KERNEL/MSExperimentTileIndex.h>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(MSExperimentTileIndex, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+// 50 MS1 spectra (RT 0, 2, 4, ...) each followed by an MS2 spectrum
+PeakMap exp;
+for (Size s = 0; s < 50; ++s)
+{
+  MSSpectrum ms1;
+  ms1.setRT(2.0 * s);
+  ms1.setMSLevel(1);
+  for (Size p = 0; p < 100; ++p)
+  {
+    // every fifth spectrum has no peaks above 600
+    double mz = 100.0 + 7.3 * p + 0.01 * s;
+    if (s % 5 == 0 && mz > 600.0) break;
+    ms1.push_back(Peak1D(mz, float((s * 31 + p * 17) % 97)));
+  }
+  exp.addSpectrum(ms1);
+
+  MSSpectrum ms2;
+  ms2.setRT(2.0 * s + 1.0);
+  ms2.setMSLevel(2);
+  ms2.push_back(Peak1D(500.0, 1000.0f));
+  exp.addSpectrum(ms2);
+}
+exp.updateRanges();
+
+MSExperimentTileIndex* ptr = nullptr;
+MSExperimentTileIndex* nullPointer = nullptr;
+START_SECTION((MSExperimentTileIndex()))
+{
+  ptr = new MSExperimentTileIndex();
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->empty(), true)
+  TEST_EQUAL(ptr->getNumberOfRTBlocks(), 0)
+}
+END_SECTION
+
+START_SECTION((~MSExperimentTileIndex()))
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((MSExperimentTileIndex(const MSExperiment& exp, UInt ms_level = 1, Size spectra_per_block = 16, Size mz_bins = 64)))
+{
+  MSExperimentTileIndex index(exp, 2, 8, 4);
+  TEST_EQUAL(index.size(), 50)
+  TEST_EQUAL(index.getMSLevel(), 2)
+  TEST_EQUAL(index.getNumberOfRTBlocks(), 7)
+  TEST_EQUAL(index.getNumberOfMZBins(), 4)
+}
+END_SECTION
+
+START_SECTION((void build(const MSExperiment& exp, UInt ms_level = 1, Size spectra_per_block = 16, Size mz_bins = 64)))
+{
+  MSExperimentTileIndex index;
+  index.build(exp, 1, 16, 10);
+  TEST_EQUAL(index.size(), 50)
+  TEST_EQUAL(index.getMSLevel(), 1)
+  TEST_EQUAL(index.getNumberOfRTBlocks(), 4)
+  TEST_EQUAL(index.getNumberOfMZBins(), 10)
+
+  // all peaks are counted exactly once
+  Size n_peaks = 0, n_expected = 0;
+  for (Size block = 0; block < index.getNumberOfRTBlocks(); ++block)
+  {
+    for (Size bin = 0; bin < index.getNumberOfMZBins(); ++bin)
+    {
+      n_peaks += index.getTilePeakCount(block, bin);
+    }
+  }
+  for (Size s = 0; s < exp.size(); ++s)
+  {
+    if (exp[s].getMSLevel() == 1) n_expected += exp[s].size();
+  }
+  TEST_EQUAL(n_peaks, n_expected)
+
+  // rebuilding replaces the old index
+  index.build(exp, 3);
+  TEST_EQUAL(index.empty(), true)
+
+  TEST_EXCEPTION(Exception::InvalidParameter, index.build(exp, 1, 0, 10))
+  TEST_EXCEPTION(Exception::InvalidParameter, index.build(exp, 1, 16, 0))
+
+  PeakMap unsorted = exp;
+  unsorted[0].setRT(1000.0);
+  TEST_EXCEPTION(Exception::Precondition, index.build(unsorted))
+}
+END_SECTION
+
+START_SECTION((void clear()))
+{
+  MSExperimentTileIndex index(exp);
+  TEST_EQUAL(index.empty(), false)
+  index.clear();
+  TEST_EQUAL(index.empty(), true)
+  TEST_EQUAL(index.size(), 0)
+  TEST_EQUAL(index.getNumberOfMZBins(), 0)
+}
+END_SECTION
+
+START_SECTION((bool empty() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((Size size() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((UInt getMSLevel() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((Size getNumberOfRTBlocks() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((Size getNumberOfMZBins() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((Size getTilePeakCount(Size rt_block, Size mz_bin) const))
+{
+  MSExperimentTileIndex index(exp, 1, 5, 10);
+  // bins are about 72.3 wide starting at 100: the first bin holds 10 peaks of every spectrum,
+  // the last one only those of the spectra without cut-off at 600
+  TEST_EQUAL(index.getTilePeakCount(0, 0), 5 * 10)
+  TEST_EQUAL(index.getTilePeakCount(0, 9), 4 * 10)
+  TEST_EXCEPTION(Exception::IndexOverflow, index.getTilePeakCount(10, 0))
+  TEST_EXCEPTION(Exception::IndexOverflow, index.getTilePeakCount(0, 10))
+}
+END_SECTION
+
+START_SECTION((float getTileMaxIntensity(Size rt_block, Size mz_bin) const))
+{
+  MSExperimentTileIndex index(exp, 1, 5, 10);
+  float max_int = 0.0f;
+  for (Size s = 0; s < 5; ++s)
+  {
+    for (const Peak1D& p : exp[2 * s])
+    {
+      if (p.getMZ() < 172.0) max_int = max(max_int, p.getIntensity());
+    }
+  }
+  TEST_REAL_SIMILAR(index.getTileMaxIntensity(0, 0), max_int)
+  TEST_EXCEPTION(Exception::IndexOverflow, index.getTileMaxIntensity(10, 0))
+  TEST_EXCEPTION(Exception::IndexOverflow, index.getTileMaxIntensity(0, 10))
+}
+END_SECTION
+
+START_SECTION((void getPeakRanges(const MSExperiment& exp, CoordinateType min_rt, CoordinateType max_rt, CoordinateType min_mz, CoordinateType max_mz, std::vector<PeakRange>& ranges) const))
+{
+  MSExperimentTileIndex index(exp, 1, 4, 16);
+  vector<MSExperimentTileIndex::PeakRange> ranges;
+
+  // same peaks as the AreaIterator for a number of windows
+  const double windows[][4] = { {0.0, 100.0, 0.0, 2000.0}, {10.0, 30.0, 400.0, 410.0}, {-5.0, 3.0, 99.0, 101.0},
+                                {1.0, 1.0, 0.0, 2000.0}, {20.0, 60.0, 650.0, 700.0}, {0.0, 100.0, 314.5, 314.5},
+                                {0.0, 100.0, 2000.0, 3000.0}, {0.0, 100.0, 822.7, 830.0}, {50.0, 50.0, 100.0, 900.0} };
+  for (const auto& w : windows)
+  {
+    index.getPeakRanges(exp, w[0], w[1], w[2], w[3], ranges);
+    vector<PeakIndex> expected, found;
+    for (PeakMap::ConstAreaIterator it = exp.areaBeginConst(w[0], w[1], w[2], w[3]); it != exp.areaEndConst(); ++it)
+    {
+      expected.push_back(it.getPeakIndex());
+    }
+    for (const MSExperimentTileIndex::PeakRange& r : ranges)
+    {
+      TEST_EQUAL(r.begin < r.end, true)
+      for (Size p = r.begin; p < r.end; ++p) found.push_back(PeakIndex(r.spectrum, p));
+    }
+    TEST_EQUAL(found.size(), expected.size())
+    TEST_EQUAL(found == expected, true)
+  }
+
+  // empty index
+  MSExperimentTileIndex().getPeakRanges(exp, 0.0, 100.0, 0.0, 2000.0, ranges);
+  TEST_EQUAL(ranges.empty(), true)
+}
+END_SECTION
+
+START_SECTION((float getMaxIntensity(CoordinateType min_rt, CoordinateType max_rt, CoordinateType min_mz, CoordinateType max_mz) const))
+{
+  MSExperimentTileIndex index(exp, 1, 4, 16);
+  // the whole map
+  float max_int = 0.0f;
+  for (Size s = 0; s < exp.size(); s += 2)
+  {
+    for (const Peak1D& p : exp[s]) max_int = max(max_int, p.getIntensity());
+  }
+  TEST_REAL_SIMILAR(index.getMaxIntensity(-1.0, 1000.0, 0.0, 2000.0), max_int)
+
+  // upper bound of the exact maximum
+  float exact = 0.0f;
+  for (PeakMap::ConstAreaIterator it = exp.areaBeginConst(10.0, 30.0, 400.0, 410.0); it != exp.areaEndConst(); ++it)
+  {
+    exact = max(exact, it->getIntensity());
+  }
+  TEST_EQUAL(index.getMaxIntensity(10.0, 30.0, 400.0, 410.0) >= exact, true)
+
+  // no spectra in RT range
+  TEST_EQUAL(index.getMaxIntensity(200.0, 300.0, 0.0, 2000.0), 0.0f)
+  TEST_EQUAL(MSExperimentTileIndex().getMaxIntensity(0.0, 100.0, 0.0, 2000.0), 0.0f)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
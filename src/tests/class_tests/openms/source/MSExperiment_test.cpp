@@ -448,6 +448,72 @@ START_SECTION((UInt64 getSize() const ))
 }
 END_SECTION
 
+START_SECTION((void getPeakArrays(std::vector<CoordinateType>& mz, std::vector<IntensityType>& intensity, std::vector<Size>& offsets) const))
+{
+  PeakMap exp;
+  exp.resize(3);
+  exp[0].push_back(Peak1D(100.0, 1.0f));
+  exp[0].push_back(Peak1D(200.0, 2.0f));
+  exp[2].push_back(Peak1D(300.0, 3.0f));
+
+  vector<double> mz(5, 1.0);
+  vector<float> intensity;
+  vector<Size> offsets;
+  exp.getPeakArrays(mz, intensity, offsets);
+  TEST_EQUAL(mz.size(), 3)
+  TEST_EQUAL(intensity.size(), 3)
+  ABORT_IF(offsets.size() != 4)
+  TEST_EQUAL(offsets[0], 0)
+  TEST_EQUAL(offsets[1], 2)
+  TEST_EQUAL(offsets[2], 2)
+  TEST_EQUAL(offsets[3], 3)
+  TEST_REAL_SIMILAR(mz[1], 200.0)
+  TEST_REAL_SIMILAR(mz[2], 300.0)
+  TEST_REAL_SIMILAR(intensity[0], 1.0)
+  TEST_REAL_SIMILAR(intensity[2], 3.0)
+
+  PeakMap empty;
+  empty.getPeakArrays(mz, intensity, offsets);
+  TEST_EQUAL(mz.size(), 0)
+  TEST_EQUAL(offsets.size(), 1)
+}
+END_SECTION
+
+START_SECTION((void setPeakArrays(const std::vector<CoordinateType>& mz, const std::vector<IntensityType>& intensity, const std::vector<Size>& offsets)))
+{
+  PeakMap exp;
+  exp.resize(2);
+  exp[0].setRT(5.0);
+  exp[0].push_back(Peak1D(100.0, 1.0f));
+
+  vector<double> mz = {10.0, 20.0, 30.0};
+  vector<float> intensity = {1.0f, 2.0f, 3.0f};
+  vector<Size> offsets = {0, 1, 3};
+  exp.setPeakArrays(mz, intensity, offsets);
+  TEST_EQUAL(exp[0].size(), 1)
+  TEST_EQUAL(exp[1].size(), 2)
+  TEST_REAL_SIMILAR(exp[0].getRT(), 5.0)
+  TEST_REAL_SIMILAR(exp[0][0].getMZ(), 10.0)
+  TEST_REAL_SIMILAR(exp[1][1].getMZ(), 30.0)
+  TEST_REAL_SIMILAR(exp[1][0].getIntensity(), 2.0)
+
+  // round trip
+  vector<double> mz2;
+  vector<float> intensity2;
+  vector<Size> offsets2;
+  exp.getPeakArrays(mz2, intensity2, offsets2);
+  TEST_EQUAL(offsets2 == offsets, true)
+  TEST_EQUAL(mz2 == mz, true)
+
+  vector<Size> wrong_count = {0, 3};
+  TEST_EXCEPTION(Exception::Precondition, exp.setPeakArrays(mz, intensity, wrong_count))
+  vector<Size> wrong_end = {0, 1, 2};
+  TEST_EXCEPTION(Exception::Precondition, exp.setPeakArrays(mz, intensity, wrong_end))
+  vector<Size> descending = {0, 4, 3};
+  TEST_EXCEPTION(Exception::Precondition, exp.setPeakArrays(mz, intensity, descending))
+}
+END_SECTION
+
 START_SECTION((const AreaType& getDataRange() const))
 {
   PeakMap tmp;
@@ -582,6 +648,59 @@ START_SECTION((virtual void updateRanges()))
 }
 END_SECTION
 
+START_SECTION((void updateRanges(const std::vector<Size>& changed_spectra, Int ms_level = -1)))
+{
+  PeakMap tmp;
+  MSSpectrum s;
+  s.setMSLevel(1);
+  for (Size i = 0; i < 3; ++i)
+  {
+    s.clear(false);
+    s.setRT(10.0 * (i + 1));
+    s.push_back(Peak1D(100.0 + i, 1.0f + i));
+    tmp.addSpectrum(s);
+  }
+  tmp.updateRanges();
+
+  // change one spectrum: only its peaks need to be scanned again
+  tmp[1].push_back(Peak1D(500.0, 50.0f));
+  tmp.updateRanges(vector<Size>(1, 1));
+  TEST_REAL_SIMILAR(tmp.getMinMZ(), 100.0)
+  TEST_REAL_SIMILAR(tmp.getMaxMZ(), 500.0)
+  TEST_REAL_SIMILAR(tmp.getMaxInt(), 50.0)
+  TEST_REAL_SIMILAR(tmp.getMinRT(), 10.0)
+  TEST_REAL_SIMILAR(tmp.getMaxRT(), 30.0)
+  TEST_EQUAL(tmp.getSize(), 4)
+
+  // ranges can also shrink
+  tmp[1].pop_back();
+  tmp.updateRanges(vector<Size>(1, 1));
+  TEST_REAL_SIMILAR(tmp.getMaxMZ(), 102.0)
+  TEST_REAL_SIMILAR(tmp.getMaxInt(), 3.0)
+  TEST_EQUAL(tmp.getSize(), 3)
+
+  // added spectrum
+  s.clear(false);
+  s.setMSLevel(2);
+  s.setRT(40.0);
+  s.push_back(Peak1D(50.0, 0.5f));
+  tmp.addSpectrum(s);
+  tmp.updateRanges(vector<Size>(1, 3));
+  TEST_REAL_SIMILAR(tmp.getMinMZ(), 50.0)
+  TEST_EQUAL(tmp.getMSLevels().size(), 2)
+  tmp.updateRanges(vector<Size>(), 1);
+  TEST_REAL_SIMILAR(tmp.getMinMZ(), 100.0)
+  TEST_REAL_SIMILAR(tmp.getMaxRT(), 30.0)
+
+  // same result as a full update
+  PeakMap full = tmp;
+  full.updateRanges(1);
+  TEST_EQUAL(full.getDataRange() == tmp.getDataRange(), true)
+
+  TEST_EXCEPTION(Exception::IndexOverflow, tmp.updateRanges(vector<Size>(1, 4)))
+}
+END_SECTION
+
 START_SECTION((void updateRanges(Int ms_level)))
 {
   PeakMap tmp;
@@ -1300,6 +1419,110 @@ START_SECTION((const MSChromatogram getTIC(float rt_bin_size=0) const))
 }
 END_SECTION
 
+START_SECTION((SignedSize findSpectrumByNativeID(const String& native_id) const))
+{
+  PeakMap exp;
+  exp.resize(3);
+  exp[0].setNativeID("scan=1");
+  exp[1].setNativeID("scan=2");
+  exp[2].setNativeID("scan=2");
+  TEST_EQUAL(exp.findSpectrumByNativeID("scan=1"), 0)
+  TEST_EQUAL(exp.findSpectrumByNativeID("scan=2"), 1) // first one of duplicates
+  TEST_EQUAL(exp.findSpectrumByNativeID("scan=3"), -1)
+
+  // index is rebuilt if spectra are added
+  MSSpectrum spec;
+  spec.setNativeID("scan=3");
+  exp.addSpectrum(spec);
+  TEST_EQUAL(exp.findSpectrumByNativeID("scan=3"), 3)
+
+  // ... or a hit does not match anymore
+  exp[0].setNativeID("scan=10");
+  TEST_EQUAL(exp.findSpectrumByNativeID("scan=1"), -1)
+  TEST_EQUAL(exp.findSpectrumByNativeID("scan=10"), 0)
+
+  // copies are independent
+  PeakMap copy(exp);
+  copy[1].setNativeID("scan=20");
+  copy.clearLookupIndices();
+  TEST_EQUAL(copy.findSpectrumByNativeID("scan=20"), 1)
+  TEST_EQUAL(exp.findSpectrumByNativeID("scan=20"), -1)
+  TEST_EQUAL(exp.findSpectrumByNativeID("scan=2"), 1)
+
+  exp.clear(true);
+  TEST_EQUAL(exp.findSpectrumByNativeID("scan=2"), -1)
+}
+END_SECTION
+
+START_SECTION((SignedSize findChromatogramByNativeID(const String& native_id) const))
+{
+  PeakMap exp;
+  TEST_EQUAL(exp.findChromatogramByNativeID("c1"), -1)
+  MSChromatogram chrom;
+  chrom.setNativeID("c1");
+  exp.addChromatogram(chrom);
+  chrom.setNativeID("c2");
+  exp.addChromatogram(chrom);
+  TEST_EQUAL(exp.findChromatogramByNativeID("c1"), 0)
+  TEST_EQUAL(exp.findChromatogramByNativeID("c2"), 1)
+  TEST_EQUAL(exp.findChromatogramByNativeID("c3"), -1)
+  std::vector<MSChromatogram> chroms(1);
+  chroms[0].setNativeID("c3");
+  exp.setChromatograms(chroms);
+  TEST_EQUAL(exp.findChromatogramByNativeID("c1"), -1)
+  TEST_EQUAL(exp.findChromatogramByNativeID("c3"), 0)
+}
+END_SECTION
+
+START_SECTION((std::vector<Size> findSpectraByPrecursorMZ(double mz_low, double mz_high, double rt_low = -std::numeric_limits<double>::max(), double rt_high = std::numeric_limits<double>::max()) const))
+{
+  PeakMap exp;
+  const double mzs[] = { 0.0, 500.0, 400.0, 500.2, 0.0, 300.0 };
+  for (Size i = 0; i < 6; ++i)
+  {
+    MSSpectrum spec;
+    spec.setRT(10.0 * i);
+    if (mzs[i] == 0.0)
+    {
+      spec.setMSLevel(1);
+    }
+    else
+    {
+      spec.setMSLevel(2);
+      Precursor prec;
+      prec.setMZ(mzs[i]);
+      spec.getPrecursors().push_back(prec);
+    }
+    exp.addSpectrum(spec);
+  }
+  std::vector<Size> res = exp.findSpectraByPrecursorMZ(400.0, 500.5);
+  TEST_EQUAL(res.size(), 3)
+  ABORT_IF(res.size() != 3)
+  TEST_EQUAL(res[0], 1)
+  TEST_EQUAL(res[1], 2)
+  TEST_EQUAL(res[2], 3)
+
+  res = exp.findSpectraByPrecursorMZ(499.0, 501.0, 5.0, 25.0);
+  TEST_EQUAL(res.size(), 1)
+  ABORT_IF(res.size() != 1)
+  TEST_EQUAL(res[0], 1)
+
+  TEST_EQUAL(exp.findSpectraByPrecursorMZ(100.0, 200.0).size(), 0)
+  TEST_EQUAL(exp.findSpectraByPrecursorMZ(0.0, 1000.0).size(), 4)
+
+  // precursor changed in place
+  exp[5].getPrecursors()[0].setMZ(450.0);
+  exp.clearLookupIndices();
+  TEST_EQUAL(exp.findSpectraByPrecursorMZ(440.0, 460.0).size(), 1)
+}
+END_SECTION
+
+START_SECTION((void clearLookupIndices()))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
 START_SECTION( std::ostream& operator<<(std::ostream& os, const MSExperiment& chrom)) 
 {
   PeakMap tmp;
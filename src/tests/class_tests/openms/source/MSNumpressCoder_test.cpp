@@ -41,6 +41,7 @@
 ///////////////////////////
 
 #include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/MATH/MISC/MSNumpress.h>
 #include <cmath>       /* pow */
 
 using namespace std;
@@ -399,6 +400,49 @@ START_SECTION([EXTRA] test_large_SLOF)
 }
 END_SECTION
 
+START_SECTION([EXTRA] test_parallel_SLOF)
+{
+  // arrays above MS_NUMPRESS_PARALLEL_MIN_SIZE are encoded and decoded in
+  // chunks, the result has to be identical to the element-wise definition
+  const size_t size = 3 * MS_NUMPRESS_PARALLEL_MIN_SIZE + 17;
+  std::vector<double> in(size);
+  for (size_t i = 0; i < size; ++i)
+  {
+    in[i] = (i % 1000) * 12.5 + (i % 7) * 0.25;
+  }
+
+  MSNumpressCoder::NumpressConfig config;
+  config.np_compression = MSNumpressCoder::SLOF;
+  config.estimate_fixed_point = true;
+  config.numpressErrorTolerance = -1.0; // small values exceed the default relative tolerance
+
+  String encoded;
+  MSNumpressCoder().encodeNPRaw(in, encoded, config);
+  TEST_EQUAL(encoded.size(), size * 2 + 8)
+
+  const double fixed_point = ms::numpress::MSNumpress::optimalSlofFixedPoint(&in[0], in.size());
+  std::vector<double> result;
+  MSNumpressCoder().decodeNPRaw(encoded, result, config);
+  TEST_EQUAL(result.size(), size)
+
+  bool identical = true;
+  for (size_t i = 0; i < size; ++i)
+  {
+    unsigned short x = static_cast<unsigned short>(log(in[i] + 1) * fixed_point + 0.5);
+    if (result[i] != exp(x / fixed_point) - 1) identical = false;
+  }
+  TEST_EQUAL(identical, true)
+
+  // overflow is still reported for large arrays
+  in[size - 1] = 1e300;
+  config.estimate_fixed_point = false;
+  config.numpressFixedPoint = 1000.0;
+  encoded.clear();
+  MSNumpressCoder().encodeNPRaw(in, encoded, config);
+  TEST_EQUAL(encoded.size(), 0)
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
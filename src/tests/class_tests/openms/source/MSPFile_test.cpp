@@ -42,6 +42,8 @@
 #include <OpenMS/KERNEL/MSSpectrum.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 
+#include <fstream>
+
 using namespace OpenMS;
 using namespace std;
 
@@ -126,6 +128,44 @@ START_SECTION(void load(const String &filename, std::vector< PeptideIdentificati
 	TEST_STRING_EQUAL(exp[1].getNativeID(), "index=3")
 	TEST_STRING_EQUAL(exp[2].getNativeID(), "index=4")
 
+	// more spectra than are parsed in one block
+	String large_filepath;
+	NEW_TMP_FILE(large_filepath)
+	{
+		ofstream ofs(large_filepath.c_str());
+		for (Size i = 0; i < 2500; ++i)
+		{
+			ofs << "Name: PEPTIDER/2\nMW: 955.46\nComment: Mods=0 Inst=it\nNum peaks: 2\n";
+			ofs << "100.5\t" << i << "\t\"b1/0.0\"\n" << "200.5\t1000\t\"y1/0.0\"\n\n";
+		}
+	}
+	p.setValue("instrument", "");
+	msp_file.setParameters(p);
+	ids.clear();
+	msp_file.load(large_filepath, ids, exp);
+	TEST_EQUAL(exp.size(), 2500)
+	TEST_EQUAL(ids.size(), 2500)
+	ABORT_IF(exp.size() != 2500)
+	TEST_STRING_EQUAL(exp[2499].getNativeID(), "index=2499")
+	TEST_EQUAL(exp[2499].size(), 2)
+	TEST_REAL_SIMILAR(exp[2499][0].getIntensity(), 2499.0)
+	TEST_REAL_SIMILAR(exp[1500][1].getMZ(), 200.5)
+	TEST_EQUAL(exp[1500].getStringDataArrays()[0].size(), 2)
+	TEST_STRING_EQUAL(exp[1500].getStringDataArrays()[0][1], "\"y1/0.0\"")
+
+	// malformed peak line in a later block
+	NEW_TMP_FILE(large_filepath)
+	{
+		ofstream ofs(large_filepath.c_str());
+		for (Size i = 0; i < 1500; ++i)
+		{
+			ofs << "Name: PEPTIDER/2\nNum peaks: 1\n";
+			ofs << (i == 1200 ? "100.5 1000\n\n" : "100.5\t1000\t\"b1/0.0\"\n\n");
+		}
+	}
+	ids.clear();
+	TEST_EXCEPTION(Exception::ParseError, msp_file.load(large_filepath, ids, exp))
+
 END_SECTION
 
 START_SECTION(void store(const String& filename, const PeakMap& exp) const)
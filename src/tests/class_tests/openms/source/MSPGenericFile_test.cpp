@@ -38,6 +38,7 @@
 ///////////////////////////
 #include <OpenMS/FORMAT/MSPGenericFile.h>
 #include <OpenMS/KERNEL/SpectrumHelper.h>
+#include <fstream>
 ///////////////////////////
 
 using namespace OpenMS;
@@ -184,6 +185,32 @@ START_SECTION(void load(const String& filename, MSExperiment& experiment) const)
   TEST_EQUAL(s3[14].getIntensity(), 20)
   TEST_EQUAL(s3[15].getPos(), 111)
   TEST_EQUAL(s3[15].getIntensity(), 44)
+
+  // a library larger than one block of records (records are parsed in parallel, block by block)
+  String large_filepath;
+  NEW_TMP_FILE(large_filepath)
+  {
+    ofstream ofs(large_filepath.c_str());
+    ofs << "Comment: lines before the first record are ignored\n";
+    for (Size i = 0; i < 10000; ++i)
+    {
+      ofs << "Name: compound " << (i == 5000 ? 1 : i) << "\n"; // record 5000 duplicates record 1
+      ofs << "Synon: synonym " << i << "\n";
+      ofs << "Num Peaks: 2\n";
+      ofs << "10 " << i << "; " << (20 + i) << ".5 2;\n\n";
+    }
+  }
+  msp.load(large_filepath, experiment);
+  TEST_EQUAL(experiment.size(), 9999)
+  TEST_EQUAL(experiment[0].getName(), "compound 0")
+  TEST_EQUAL(experiment[0].metaValueExists("Comment"), false)
+  TEST_STRING_EQUAL(experiment[1].getMetaValue("Synon"), "synonym 1")
+  TEST_EQUAL(experiment[4999].getName(), "compound 4999")
+  TEST_EQUAL(experiment[5000].getName(), "compound 5001")
+  TEST_EQUAL(experiment[9998].getName(), "compound 9999")
+  TEST_EQUAL(experiment[9998].size(), 2)
+  TEST_EQUAL(experiment[9998][0].getIntensity(), 9999)
+  TEST_REAL_SIMILAR(experiment[9998][1].getMZ(), 10019.5)
 }
 END_SECTION
 
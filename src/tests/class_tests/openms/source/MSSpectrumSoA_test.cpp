@@ -0,0 +1,216 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/KERNEL/MSSpectrumSoA.h>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(MSSpectrumSoA, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+MSSpectrum spec;
+for (Size i = 0; i < 5; ++i)
+{
+  Peak1D p;
+  p.setMZ(100.0 + 10.0 * i);
+  p.setIntensity(1.0f + i);
+  spec.push_back(p);
+}
+
+MSSpectrumSoA* ptr = nullptr;
+MSSpectrumSoA* nullPointer = nullptr;
+START_SECTION((MSSpectrumSoA()))
+{
+  ptr = new MSSpectrumSoA();
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->size(), 0)
+  TEST_EQUAL(ptr->empty(), true)
+}
+END_SECTION
+
+START_SECTION((~MSSpectrumSoA()))
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((explicit MSSpectrumSoA(const MSSpectrum& spectrum)))
+{
+  MSSpectrumSoA soa(spec);
+  TEST_EQUAL(soa.size(), 5)
+  TEST_EQUAL(soa.empty(), false)
+  TEST_REAL_SIMILAR(soa.mz()[0], 100.0)
+  TEST_REAL_SIMILAR(soa.mz()[4], 140.0)
+  TEST_REAL_SIMILAR(soa.intensity()[0], 1.0)
+  TEST_REAL_SIMILAR(soa.intensity()[4], 5.0)
+}
+END_SECTION
+
+START_SECTION((void assign(const MSSpectrum& spectrum)))
+{
+  MSSpectrumSoA soa(spec);
+  MSSpectrum tmp = spec;
+  tmp.pop_back();
+  tmp[0].setIntensity(42.0f);
+  soa.assign(tmp);
+  TEST_EQUAL(soa.size(), 4)
+  TEST_EQUAL(soa.intensity().size(), 4)
+  TEST_REAL_SIMILAR(soa.intensity()[0], 42.0)
+
+  soa.assign(MSSpectrum());
+  TEST_EQUAL(soa.empty(), true)
+}
+END_SECTION
+
+START_SECTION((void writeTo(MSSpectrum& spectrum) const))
+{
+  MSSpectrumSoA soa(spec);
+  for (auto& i : soa.intensity()) i *= 2;
+  soa.mz()[0] = 99.0;
+  MSSpectrum tmp = spec;
+  soa.writeTo(tmp);
+  TEST_REAL_SIMILAR(tmp[0].getMZ(), 99.0)
+  TEST_REAL_SIMILAR(tmp[0].getIntensity(), 2.0)
+  TEST_REAL_SIMILAR(tmp[4].getMZ(), 140.0)
+  TEST_REAL_SIMILAR(tmp[4].getIntensity(), 10.0)
+
+  tmp.pop_back();
+  TEST_EXCEPTION(Exception::Precondition, soa.writeTo(tmp))
+}
+END_SECTION
+
+START_SECTION((void clear()))
+{
+  MSSpectrumSoA soa(spec);
+  soa.clear();
+  TEST_EQUAL(soa.size(), 0)
+  TEST_EQUAL(soa.intensity().size(), 0)
+}
+END_SECTION
+
+START_SECTION((Size size() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((bool empty() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((const std::vector<CoordinateType>& mz() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((const std::vector<IntensityType>& intensity() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((Size mzBegin(CoordinateType mz) const))
+{
+  MSSpectrumSoA soa(spec);
+  TEST_EQUAL(soa.mzBegin(50.0), 0)
+  TEST_EQUAL(soa.mzBegin(110.0), 1)
+  TEST_EQUAL(soa.mzBegin(115.0), 2)
+  TEST_EQUAL(soa.mzBegin(200.0), 5)
+  // same result as MSSpectrum
+  TEST_EQUAL(soa.mzBegin(115.0), spec.MZBegin(115.0) - spec.begin())
+}
+END_SECTION
+
+START_SECTION((Size mzEnd(CoordinateType mz) const))
+{
+  MSSpectrumSoA soa(spec);
+  TEST_EQUAL(soa.mzEnd(50.0), 0)
+  TEST_EQUAL(soa.mzEnd(110.0), 2)
+  TEST_EQUAL(soa.mzEnd(115.0), 2)
+  TEST_EQUAL(soa.mzEnd(200.0), 5)
+  TEST_EQUAL(soa.mzEnd(110.0), spec.MZEnd(110.0) - spec.begin())
+}
+END_SECTION
+
+START_SECTION((Size findNearest(CoordinateType mz) const))
+{
+  MSSpectrumSoA soa(spec);
+  TEST_EQUAL(soa.findNearest(0.0), 0)
+  TEST_EQUAL(soa.findNearest(104.0), 0)
+  TEST_EQUAL(soa.findNearest(106.0), 1)
+  TEST_EQUAL(soa.findNearest(500.0), 4)
+  TEST_EQUAL(soa.findNearest(131.0), spec.findNearest(131.0))
+
+  MSSpectrumSoA empty;
+  TEST_EXCEPTION(Exception::Precondition, empty.findNearest(10.0))
+}
+END_SECTION
+
+START_SECTION((Int findNearest(CoordinateType mz, CoordinateType tolerance) const))
+{
+  MSSpectrumSoA soa(spec);
+  TEST_EQUAL(soa.findNearest(104.0, 5.0), 0)
+  TEST_EQUAL(soa.findNearest(104.0, 1.0), -1)
+  TEST_EQUAL(soa.findNearest(141.0, 1.0), 4)
+
+  MSSpectrumSoA empty;
+  TEST_EQUAL(empty.findNearest(10.0, 1.0), -1)
+}
+END_SECTION
+
+START_SECTION((double sumIntensity(Size begin, Size end) const))
+{
+  MSSpectrumSoA soa(spec);
+  TEST_REAL_SIMILAR(soa.sumIntensity(0, 5), 15.0)
+  TEST_REAL_SIMILAR(soa.sumIntensity(1, 3), 5.0)
+  TEST_REAL_SIMILAR(soa.sumIntensity(3, 100), 9.0)
+  TEST_REAL_SIMILAR(soa.sumIntensity(3, 3), 0.0)
+  TEST_REAL_SIMILAR(soa.sumIntensity(soa.mzBegin(105.0), soa.mzEnd(125.0)), 5.0)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
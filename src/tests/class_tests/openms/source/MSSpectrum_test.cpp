@@ -803,6 +803,36 @@ START_SECTION((void sortByPosition()))
 }
 END_SECTION
 
+START_SECTION(([EXTRA] void sortByPosition() on large spectra with data arrays))
+{
+  // large enough for the radix sort, with ties
+  MSSpectrum ds;
+  MSSpectrum::FloatDataArray float_array;
+  MSSpectrum::IntegerDataArray int_array;
+  for (Size i = 0; i < 5000; ++i)
+  {
+    Peak1D p;
+    p.setMZ(1000.0 - (double)((i * 7919) % 2500) * 0.25); // each m/z occurs twice
+    p.setIntensity((float)i);
+    ds.push_back(p);
+    float_array.push_back((float)i);
+    int_array.push_back((Int)i);
+  }
+  ds.getFloatDataArrays().push_back(float_array);
+  ds.getIntegerDataArrays().push_back(int_array);
+  ds.sortByPosition();
+  TEST_EQUAL(ds.isSorted(), true)
+  Size mismatches = 0;
+  for (Size i = 0; i < ds.size(); ++i)
+  {
+    // data arrays follow their peaks, ties keep their order
+    if (ds.getFloatDataArrays()[0][i] != ds[i].getIntensity() || ds.getIntegerDataArrays()[0][i] != (Int)ds[i].getIntensity()) ++mismatches;
+    if (i > 0 && ds[i - 1].getMZ() == ds[i].getMZ() && ds[i - 1].getIntensity() > ds[i].getIntensity()) ++mismatches;
+  }
+  TEST_EQUAL(mismatches, 0)
+}
+END_SECTION
+
 
 START_SECTION((void sortByPositionPresorted()))
 {
@@ -150,6 +150,31 @@ START_SECTION(double predict(double mz) const)
   TEST_REAL_SIMILAR(m2.predict(mz_obs), mz_theo);
 END_SECTION
 
+START_SECTION(void predict(std::vector<double>& mzs) const)
+  std::vector<double> mzs = {100.0, 250.5, 1000.25};
+  // linear and quadratic models, on ppm and absolute scale
+  for (bool use_ppm : {true, false})
+  {
+    MZTrafoModel m(use_ppm);
+    for (double power : {0.0, 1e-5})
+    {
+      m.setCoefficients(2.5, 0.01, power);
+      std::vector<double> calibrated = mzs;
+      m.predict(calibrated);
+      TEST_EQUAL(calibrated.size(), mzs.size())
+      for (Size i = 0; i < mzs.size(); ++i)
+      {
+        TEST_REAL_SIMILAR(calibrated[i], m.predict(mzs[i]))
+      }
+    }
+  }
+  std::vector<double> empty;
+  MZTrafoModel m(true);
+  m.setCoefficients(25, 0, 0);
+  m.predict(empty);
+  TEST_EQUAL(empty.empty(), true)
+END_SECTION
+
 
 START_SECTION(static Size findNearest(const std::vector<MZTrafoModel>& tms, double rt))
   std::vector<MZTrafoModel> tms;
@@ -69,7 +69,7 @@ START_SECTION((template <typename MapType> void setReference(const MapType& map)
 }
 END_SECTION
 
-START_SECTION((void align(const PeakMap& map, TransformationDescription& trafo)))
+START_SECTION((void align(const PeakMap& map, TransformationDescription& trafo) const))
 {
   MzMLFile f;
   std::vector<PeakMap > maps(2);
@@ -94,17 +94,32 @@ START_SECTION((void align(const PeakMap& map, TransformationDescription& trafo))
   lm.getParameters(slope, intercept, x_weight, y_weight, x_datum_min, x_datum_max, y_datum_min, y_datum_max);
   TEST_REAL_SIMILAR(slope, 1.01164);
   TEST_REAL_SIMILAR(intercept, -32.0912);
+
+  // concurrent alignments against the shared reference give the same result
+  std::vector<TransformationDescription> trafos(4);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (int i = 0; i < static_cast<int>(trafos.size()); ++i)
+  {
+    aligner.align(maps[1], trafos[i]);
+  }
+  for (Size i = 0; i < trafos.size(); ++i)
+  {
+    TEST_EQUAL(trafos[i].getDataPoints().size(), 307);
+    TEST_EQUAL(trafos[i].getModelParameters().getValue("slope"), trafo.getModelParameters().getValue("slope"));
+  }
 }
 END_SECTION
 
-START_SECTION((void align(const FeatureMap& map, TransformationDescription& trafo)))
+START_SECTION((void align(const FeatureMap& map, TransformationDescription& trafo) const))
 {
   // Tested extensively in TEST/TOPP
   NOT_TESTABLE;
 }
 END_SECTION
 
-START_SECTION((void align(const ConsensusMap& map, TransformationDescription& trafo)))
+START_SECTION((void align(const ConsensusMap& map, TransformationDescription& trafo) const))
 {
   // Tested extensively in TEST/TOPP
   NOT_TESTABLE;
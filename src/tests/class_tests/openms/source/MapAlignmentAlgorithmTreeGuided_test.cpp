@@ -108,6 +108,45 @@ START_SECTION((static void buildTree(std::vector<FeatureMap>& feature_maps, std:
 }
 END_SECTION
 
+START_SECTION((static void buildTree(std::vector<FeatureMap>& feature_maps, std::vector<BinaryTreeNode>& tree, std::vector<std::vector<double>>& maps_ranges, DistanceMatrix<float>& dist_matrix)))
+{
+  vector<BinaryTreeNode> tree;
+  vector<vector<double>> ranges(3);
+  DistanceMatrix<float> dist_matrix;
+  OpenMS::MapAlignmentAlgorithmTreeGuided::buildTree(maps, tree, ranges, dist_matrix);
+  TEST_EQUAL(dist_matrix.dimensionsize(), 3);
+  TEST_REAL_SIMILAR(dist_matrix(0, 2), 1.84834e-04);
+  TEST_EQUAL(tree.size(), result_tree.size());
+  for (Size i = 0; i < tree.size(); ++i)
+  {
+    TEST_EQUAL(tree[i].left_child, result_tree[i].left_child);
+    TEST_EQUAL(tree[i].right_child, result_tree[i].right_child);
+    TEST_REAL_SIMILAR(tree[i].distance, result_tree[i].distance);
+  }
+
+  // distances of the first two maps are reused, only the row of the third map is computed
+  DistanceMatrix<float> cached(2, 1);
+  cached.setValueQuick(1, 0, dist_matrix(1, 0));
+  vector<BinaryTreeNode> tree_cached;
+  vector<vector<double>> ranges_cached(3);
+  OpenMS::MapAlignmentAlgorithmTreeGuided::buildTree(maps, tree_cached, ranges_cached, cached);
+  TEST_EQUAL(cached.dimensionsize(), 3);
+  for (Size i = 1; i < 3; ++i)
+  {
+    for (Size j = 0; j < i; ++j)
+    {
+      TEST_REAL_SIMILAR(cached(i, j), dist_matrix(i, j));
+    }
+  }
+  TEST_EQUAL(tree_cached.size(), tree.size());
+  for (Size i = 0; i < tree.size(); ++i)
+  {
+    TEST_EQUAL(tree_cached[i].left_child, tree[i].left_child);
+    TEST_EQUAL(tree_cached[i].right_child, tree[i].right_child);
+  }
+}
+END_SECTION
+
 START_SECTION((void treeGuidedAlignment(const std::vector<BinaryTreeNode>& tree, std::vector<FeatureMap>& feature_maps_transformed,
         std::vector<std::vector<double>>& maps_ranges, FeatureMap& map_transformed, std::vector<Size>& trafo_order)))
 {
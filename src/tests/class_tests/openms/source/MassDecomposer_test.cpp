@@ -55,28 +55,28 @@ START_SECTION((virtual ~MassDecomposer()))
 }
 END_SECTION
 
-START_SECTION((virtual bool exist(value_type mass)=0))
+START_SECTION((virtual bool exist(value_type mass) const=0))
 {
   // MassDecomposer is an abstract base class, without any implementation
   NOT_TESTABLE
 }
 END_SECTION
 
-START_SECTION((virtual decomposition_type getDecomposition(value_type mass)=0))
+START_SECTION((virtual decomposition_type getDecomposition(value_type mass) const=0))
 {
   // MassDecomposer is an abstract base class, without any implementation
   NOT_TESTABLE
 }
 END_SECTION
 
-START_SECTION((virtual decompositions_type getAllDecompositions(value_type mass)=0))
+START_SECTION((virtual decompositions_type getAllDecompositions(value_type mass) const=0))
 {
   // MassDecomposer is an abstract base class, without any implementation
   NOT_TESTABLE
 }
 END_SECTION
 
-START_SECTION((virtual decomposition_value_type getNumberOfDecompositions(value_type mass)=0))
+START_SECTION((virtual decomposition_value_type getNumberOfDecompositions(value_type mass) const=0))
 {
   // MassDecomposer is an abstract base class, without any implementation
   NOT_TESTABLE
@@ -40,6 +40,10 @@
 #include <OpenMS/CHEMISTRY/AASequence.h>
 ///////////////////////////
 
+#include <OpenMS/SYSTEM/File.h>
+
+#include <QDir>
+
 using namespace OpenMS;
 using namespace std;
 
@@ -63,7 +67,7 @@ START_SECTION(virtual ~MassDecompositionAlgorithm())
 }
 END_SECTION
 
-START_SECTION((void getDecompositions(std::vector<MassDecomposition>& decomps, double weight)))
+START_SECTION((void getDecompositions(std::vector<MassDecomposition>& decomps, double weight) const))
 {
   vector<MassDecomposition> decomps;
   double mass = AASequence::fromString("DFPIANGER").getMonoWeight(Residue::Internal);
@@ -85,6 +89,39 @@ START_SECTION((void getDecompositions(std::vector<MassDecomposition>& decomps, d
 }
 END_SECTION
 
+START_SECTION(([EXTRA] decomposition tables cached on disk))
+{
+  double mass = AASequence::fromString("DFPIANGER").getMonoWeight(Residue::Internal);
+  String cache_dir = File::getTempDirectory() + "/MassDecompositionAlgorithm_test_" + String(File::getUniqueName());
+  QDir().mkpath(cache_dir.toQString());
+
+  MassDecompositionAlgorithm mda;
+  Param p(mda.getParameters());
+  p.setValue("tolerance", 0.0001);
+  p.setValue("decomp_table_cache", cache_dir);
+  mda.setParameters(p); // computes and stores the table
+  StringList tables;
+  File::fileList(cache_dir, "*.ert", tables);
+  TEST_EQUAL(tables.size(), 1)
+
+  MassDecompositionAlgorithm mda_cached;
+  mda_cached.setParameters(p); // loads the table
+  File::fileList(cache_dir, "*.ert", tables);
+  TEST_EQUAL(tables.size(), 1)
+  vector<MassDecomposition> decomps;
+  mda_cached.getDecompositions(decomps, mass);
+  TEST_EQUAL(decomps.size(), 842)
+
+  // a different precision is a different table
+  p.setValue("decomp_weights_precision", 0.02);
+  mda_cached.setParameters(p);
+  File::fileList(cache_dir, "*.ert", tables);
+  TEST_EQUAL(tables.size(), 2)
+
+  File::removeDirRecursively(cache_dir);
+}
+END_SECTION
+
 
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
@@ -175,6 +175,69 @@ START_SECTION((void run(const PeakMap &, std::vector< MassTrace > &)))
 }
 END_SECTION
 
+START_SECTION(([EXTRA] parallel detection in m/z bins gives the serial result))
+{
+  // many traces, some of them closer in m/z than the search window, so that bins have to be merged
+  PeakMap synthetic;
+  for (Size scan = 0; scan < 40; ++scan)
+  {
+    MSSpectrum spec;
+    spec.setRT(100.0 + scan);
+    for (Size t = 0; t < 30; ++t)
+    {
+      double mz = 200.0 + 10.0 * (t / 2) + ((t % 2) ? 0.004 : 0.0) + 0.0005 * std::sin(double(scan + t));
+      double dist = double(scan) - 5.0 - double(t);
+      Peak1D p(mz, 1000.0 + 100.0 * t + 50000.0 * std::exp(-dist * dist / 50.0));
+      spec.push_back(p);
+    }
+    spec.sortByPosition();
+    synthetic.addSpectrum(spec);
+  }
+
+  std::vector<PeakMap*> maps;
+  maps.push_back(&input);
+  maps.push_back(&synthetic);
+  for (Size m = 0; m < maps.size(); ++m)
+  {
+    MassTraceDetection serial;
+    serial.setParameters(p_mtd);
+    std::vector<MassTrace> serial_mt;
+    serial.run(*maps[m], serial_mt);
+
+    const Size bin_counts[3] = {2, 5, 64};
+    for (Size b = 0; b < 3; ++b)
+    {
+      MassTraceDetection binned;
+      Param p(p_mtd);
+      p.setValue("parallel_mz_bins", bin_counts[b]);
+      binned.setParameters(p);
+      std::vector<MassTrace> binned_mt;
+      binned.run(*maps[m], binned_mt);
+
+      TEST_EQUAL(binned_mt.size(), serial_mt.size())
+      ABORT_IF(binned_mt.size() != serial_mt.size())
+      for (Size i = 0; i < serial_mt.size(); ++i)
+      {
+        TEST_EQUAL(binned_mt[i].getLabel(), serial_mt[i].getLabel())
+        TEST_EQUAL(binned_mt[i].getSize(), serial_mt[i].getSize())
+        TEST_EQUAL(binned_mt[i].getCentroidMZ(), serial_mt[i].getCentroidMZ())
+        TEST_EQUAL(binned_mt[i].getCentroidRT(), serial_mt[i].getCentroidRT())
+      }
+
+      // maximum number of traces
+      std::vector<MassTrace> limited;
+      binned.run(*maps[m], limited, 2);
+      TEST_EQUAL(limited.size(), std::min(Size(2), serial_mt.size()))
+      for (Size i = 0; i < limited.size(); ++i)
+      {
+        TEST_EQUAL(limited[i].getLabel(), serial_mt[i].getLabel())
+        TEST_EQUAL(limited[i].getCentroidMZ(), serial_mt[i].getCentroidMZ())
+      }
+    }
+  }
+}
+END_SECTION
+
 std::vector<MassTrace> filt;
 
 //START_SECTION((void filterByPeakWidth(std::vector< MassTrace > &, std::vector< MassTrace > &)))
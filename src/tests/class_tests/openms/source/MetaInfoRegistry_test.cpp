@@ -43,6 +43,8 @@
 
 #include <OpenMS/METADATA/MetaInfoRegistry.h>
 
+#include <set>
+
 ///////////////////////////
 
 START_TEST(MetaInfoRegistry, "$Id$")
@@ -115,6 +117,41 @@ START_SECTION((String getName(UInt index) const))
 	TEST_STRING_EQUAL(mir.getName(1025), "retention time")
 END_SECTION
 
+START_SECTION([EXTRA] reserved indices)
+	TEST_STRING_EQUAL(mir.getName(MetaInfoRegistry::SPECTRUM_REFERENCE), "spectrum_reference")
+	TEST_EQUAL(mir.getIndex("charge"), MetaInfoRegistry::CHARGE)
+	TEST_EXCEPTION(Exception::InvalidValue, mir.getName(14))
+END_SECTION
+
+START_SECTION([EXTRA] growing tables)
+{
+	// more names than fit into the initial tables, registered concurrently
+	MetaInfoRegistry reg;
+	vector<UInt> indices(5000);
+#pragma omp parallel for
+	for (int k = 0; k < 5000; ++k)
+	{
+		indices[k] = reg.registerName("name_" + String(k % 2500));
+	}
+	set<UInt> different(indices.begin(), indices.end());
+	TEST_EQUAL(different.size(), 2500)
+	TEST_EQUAL(*different.begin(), 1024)
+	TEST_EQUAL(*different.rbegin(), 1024 + 2499)
+	bool consistent = true;
+	for (int k = 0; k < 5000; ++k)
+	{
+		consistent &= (reg.getIndex("name_" + String(k % 2500)) == indices[k]);
+		consistent &= (reg.getName(indices[k]) == "name_" + String(k % 2500));
+	}
+	TEST_EQUAL(consistent, true)
+	TEST_EQUAL(reg.getIndex("name_2500"), UInt(-1))
+
+	MetaInfoRegistry copy(reg);
+	TEST_EQUAL(copy.getIndex("name_2499"), reg.getIndex("name_2499"))
+	TEST_EQUAL(copy.registerName("one more"), 1024 + 2500)
+}
+END_SECTION
+
 START_SECTION((String getDescription(UInt index) const))
 	TEST_STRING_EQUAL(mir.getDescription(1024), "this is just a test")
 	TEST_STRING_EQUAL(mir.getDescription(1025), "this is just another test")
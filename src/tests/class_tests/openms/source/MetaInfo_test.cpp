@@ -237,6 +237,23 @@ START_SECTION((void removeValue(UInt index)))
 
 	//try if removing a non-existing value works as well
 	i.removeValue(1234);
+
+	// more values than are stored inline, inserted out of order
+	for (UInt index = 10; index > 0; --index)
+	{
+		i.setValue(index, DataValue(double(index)));
+	}
+	i.removeValue(5);
+	vector<UInt> keys;
+	i.getKeys(keys);
+	TEST_EQUAL(keys.size(), 9)
+	TEST_EQUAL(keys[0], 1)
+	TEST_EQUAL(keys[4], 6)
+	TEST_EQUAL(keys[8], 10)
+	TEST_EQUAL(i.exists(5), false)
+	TEST_REAL_SIMILAR(double(i.getValue(6)), 6.0)
+	MetaInfo i3(i);
+	TEST_EQUAL(i3 == i, true)
 END_SECTION
 
 START_SECTION((void removeValue(const String& name)))
@@ -279,6 +279,92 @@ START_SECTION((static void applyVariableModifications(const ModifiedPeptideGener
 }
 END_SECTION
 
+START_SECTION((VariantEnumerator(const MapToResidueType& var_mods, const AASequence& peptide, Size max_variable_mods_per_peptide, bool keep_unmodified = true)))
+{
+  StringList modNames;
+  modNames << "Oxidation (M)";
+  ModifiedPeptideGenerator::MapToResidueType variable_mods = ModifiedPeptideGenerator::getModifications(modNames);
+
+  // no target site
+  AASequence seq = AASequence::fromString("AAAAAAAAA");
+  ModifiedPeptideGenerator::VariantEnumerator no_site(variable_mods, seq, 2, false);
+  TEST_EQUAL(no_site.next(), false)
+  ModifiedPeptideGenerator::VariantEnumerator only_original(variable_mods, seq, 2, true);
+  TEST_EQUAL(only_original.next(), true)
+  TEST_EQUAL(only_original.getPlacements().size(), 0)
+  TEST_EQUAL(only_original.getPeptide(), seq)
+  TEST_EQUAL(only_original.next(), false)
+}
+END_SECTION
+
+START_SECTION((bool VariantEnumerator::next()))
+{
+  // same variants in the same order as applyVariableModifications()
+  StringList modNames;
+  modNames << "Glutathione (C)" << "Carbamidomethyl (C)" << "Oxidation (M)" << "Carbamyl (N-term)";
+  ModifiedPeptideGenerator::MapToResidueType variable_mods = ModifiedPeptideGenerator::getModifications(modNames);
+
+  const AASequence seq = AASequence::fromString("ACMACMACA");
+  for (Size max_mods = 0; max_mods <= 4; ++max_mods)
+  {
+    for (bool keep : {true, false})
+    {
+      vector<AASequence> expected;
+      if (max_mods != 1) // at most one modification uses a different order
+      {
+        ModifiedPeptideGenerator::applyVariableModifications(variable_mods, seq, max_mods, expected, keep);
+      }
+      vector<AASequence> enumerated;
+      ModifiedPeptideGenerator::VariantEnumerator variants(variable_mods, seq, max_mods, keep);
+      while (variants.next())
+      {
+        TEST_EQUAL(variants.getPlacements().size() <= max_mods, true)
+        enumerated.push_back(variants.getPeptide());
+      }
+      if (max_mods != 1)
+      {
+        TEST_EQUAL(enumerated.size(), expected.size())
+        TEST_EQUAL(enumerated == expected, true)
+      }
+      else
+      {
+        TEST_EQUAL(enumerated.size(), 9 + (keep ? 1 : 0)) // 3 x 2 C mods, 2 x Ox, N-term
+      }
+    }
+  }
+}
+END_SECTION
+
+START_SECTION((double VariantEnumerator::getMassDelta() const))
+{
+  StringList modNames;
+  modNames << "Oxidation (M)" << "Phospho (S)";
+  ModifiedPeptideGenerator::MapToResidueType variable_mods = ModifiedPeptideGenerator::getModifications(modNames);
+
+  const AASequence seq = AASequence::fromString("SAMASMAS");
+  const double mono_weight = seq.getMonoWeight();
+  Size count = 0;
+  ModifiedPeptideGenerator::VariantEnumerator variants(variable_mods, seq, 3);
+  while (variants.next())
+  {
+    ++count;
+    TEST_REAL_SIMILAR(mono_weight + variants.getMassDelta(), variants.getPeptide().getMonoWeight())
+  }
+  TEST_EQUAL(count, 1 + 5 + 10 + 10) // unmodified, one, two or three of the five sites modified
+
+  // prune by mass: only variants with exactly two phosphorylations
+  const double phospho = ModificationsDB::getInstance()->getModification("Phospho (S)")->getDiffMonoMass();
+  ModifiedPeptideGenerator::VariantEnumerator pruned(variable_mods, seq, 3);
+  count = 0;
+  while (pruned.next(2 * phospho - 0.01, 2 * phospho + 0.01))
+  {
+    ++count;
+    TEST_EQUAL(pruned.getPlacements().size(), 2)
+  }
+  TEST_EQUAL(count, 3)
+}
+END_SECTION
+
 START_SECTION([EXTRA] multithreaded example)
 {
   int nr_iterations (1e5);
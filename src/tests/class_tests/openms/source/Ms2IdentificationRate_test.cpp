@@ -215,6 +215,21 @@ START_SECTION(void compute(FeatureMap const & feature_map, MSExperiment const &
 }
 END_SECTION
 
+START_SECTION(void compute(const FeatureMap& feature_map, const QCBase::SpectraSummary& summary, bool force_fdr = false))
+{
+  Ms2IdentificationRate ms2ir_summary;
+  ms2ir_summary.compute(fmap, QCBase::SpectraSummary(ms_exp));
+  ABORT_IF(ms2ir_summary.getResults().size() != 1);
+  TEST_EQUAL(ms2ir_summary.getResults()[0].num_peptide_identification, 2)
+  TEST_EQUAL(ms2ir_summary.getResults()[0].num_ms2_spectra, 6)
+  TEST_REAL_SIMILAR(ms2ir_summary.getResults()[0].identification_rate, 1./3)
+
+  TEST_EXCEPTION_WITH_MESSAGE(Exception::Precondition, ms2ir_summary.compute(fmap, QCBase::SpectraSummary(ms2_2_exp)), "There are more Identifications than MS2 spectra. Please check your data.")
+  TEST_EXCEPTION_WITH_MESSAGE(Exception::MissingInformation, ms2ir_summary.compute(fmap, QCBase::SpectraSummary(ms_empty_exp)), "MSExperiment is empty")
+  TEST_EXCEPTION_WITH_MESSAGE(Exception::MissingInformation, ms2ir_summary.compute(fmap, QCBase::SpectraSummary(ms1_exp)), "No MS2 spectra found")
+}
+END_SECTION
+
 
 START_SECTION(const String& getName() const override)
 {
@@ -129,6 +129,44 @@ START_SECTION(void load(const String& filename, std::vector<ProteinIdentificatio
 }
 END_SECTION
 
+START_SECTION(void load(const String& filename, std::vector<ProteinIdentification>& poid, const std::function<void(std::vector<PeptideIdentification>&)>& pep_id_callback, Size batch_size = 10000))
+{
+  std::vector<ProteinIdentification> protein_ids, protein_ids2;
+  std::vector<PeptideIdentification> peptide_ids, peptide_ids2;
+  String input_path = OPENMS_GET_TEST_DATA_PATH("MzIdentMLFile_msgf_mini.mzid");
+  MzIdentMLFile().load(input_path, protein_ids, peptide_ids);
+
+  std::vector<Size> batch_sizes;
+  MzIdentMLFile().load(input_path, protein_ids2, [&](std::vector<PeptideIdentification>& batch)
+  {
+    // the runs are known before the first batch
+    TEST_EQUAL(protein_ids2.size(), 2)
+    batch_sizes.push_back(batch.size());
+    peptide_ids2.insert(peptide_ids2.end(), batch.begin(), batch.end());
+  }, 2);
+
+  TEST_EQUAL(batch_sizes.size(), 3)
+  TEST_EQUAL(batch_sizes[0], 2)
+  TEST_EQUAL(batch_sizes[2], 1)
+  TEST_EQUAL(protein_ids2.size(), protein_ids.size())
+  TEST_EQUAL(protein_ids2[0].getHits().size(), protein_ids[0].getHits().size())
+  TEST_EQUAL(protein_ids2[1].getHits().size(), protein_ids[1].getHits().size())
+  TEST_EQUAL(peptide_ids2.size(), peptide_ids.size())
+  ABORT_IF(peptide_ids2.size() != peptide_ids.size())
+  for (Size i = 0; i < peptide_ids.size(); ++i)
+  {
+    bool run_found = (peptide_ids2[i].getIdentifier() == protein_ids2[0].getIdentifier()) || (peptide_ids2[i].getIdentifier() == protein_ids2[1].getIdentifier());
+    TEST_EQUAL(run_found, true)
+    TEST_EQUAL(peptide_ids2[i].getHits().size(), peptide_ids[i].getHits().size())
+    TEST_EQUAL(peptide_ids2[i].getHits()[0].getSequence(), peptide_ids[i].getHits()[0].getSequence())
+    TEST_REAL_SIMILAR(peptide_ids2[i].getHits()[0].getScore(), peptide_ids[i].getHits()[0].getScore())
+    TEST_REAL_SIMILAR(peptide_ids2[i].getRT(), peptide_ids[i].getRT())
+  }
+
+  TEST_EXCEPTION(Exception::FileNotFound, MzIdentMLFile().load("this_file_does_not_exist.mzid", protein_ids2, [](std::vector<PeptideIdentification>&) {}))
+}
+END_SECTION
+
 START_SECTION(void store(String filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids) )
 {
   //store and load data from various sources, starting with idxml, contents already checked above, so checking integrity of the data over repeated r/w
@@ -39,8 +39,15 @@
 #include <OpenMS/FORMAT/MzMLFile.h>
 ///////////////////////////
 
+#include <OpenMS/CONCEPT/FuzzyStringComparator.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
 #include <OpenMS/FORMAT/FileTypes.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/KERNEL/OnDiscMSExperiment.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace OpenMS;
 using namespace std;
@@ -1111,6 +1118,74 @@ START_SECTION((void storeBuffer(std::string & output, const PeakMap& map) const)
 }
 END_SECTION
 
+START_SECTION([EXTRA] store with parallel encoding of spectra and chromatograms)
+{
+  // spectra and chromatograms are encoded in parallel batches; the output must not depend on the number of threads
+  PeakMap exp;
+  MzMLFile file;
+  file.load(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), exp);
+  PeakMap large; // more spectra than fit into a single batch
+  large.getSpectra().reserve(exp.size() * 100);
+  for (Size i = 0; i < 100; ++i)
+  {
+    for (const MSSpectrum& spec : exp) large.addSpectrum(spec);
+  }
+  for (const MSChromatogram& chrom : exp.getChromatograms()) large.addChromatogram(chrom);
+  for (Size i = 0; i < large.size(); ++i) large[i].setNativeID(String("scan=") + i);
+  file.getOptions().setCompression(true);
+
+#ifdef _OPENMP
+  const int threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+#endif
+  std::string serial;
+  file.storeBuffer(serial, large);
+  String serial_consumer_file;
+  NEW_TMP_FILE(serial_consumer_file)
+  {
+    PlainMSDataWritingConsumer consumer(serial_consumer_file);
+    consumer.getOptions().setCompression(true);
+    consumer.setExpectedSize(large.size(), large.getChromatograms().size());
+    consumer.setExperimentalSettings(large);
+    for (MSSpectrum spec : large) consumer.consumeSpectrum(spec);
+    for (MSChromatogram chrom : large.getChromatograms()) consumer.consumeChromatogram(chrom);
+  }
+#ifdef _OPENMP
+  omp_set_num_threads(4);
+#endif
+  std::string parallel;
+  file.storeBuffer(parallel, large);
+  String parallel_consumer_file;
+  NEW_TMP_FILE(parallel_consumer_file)
+  {
+    PlainMSDataWritingConsumer consumer(parallel_consumer_file);
+    consumer.getOptions().setCompression(true);
+    consumer.setExpectedSize(large.size(), large.getChromatograms().size());
+    consumer.setExperimentalSettings(large);
+    for (MSSpectrum spec : large) consumer.consumeSpectrum(spec);
+    for (MSChromatogram chrom : large.getChromatograms()) consumer.consumeChromatogram(chrom);
+    TEST_EQUAL(consumer.getNrSpectraWritten(), large.size())
+  }
+#ifdef _OPENMP
+  omp_set_num_threads(threads);
+#endif
+
+  TEST_EQUAL(parallel.size(), serial.size())
+  TEST_EQUAL(parallel == serial, true)
+  TEST_EQUAL(FuzzyStringComparator().compareFiles(parallel_consumer_file, serial_consumer_file), true)
+
+  // the index offsets point to the right elements
+  OnDiscMSExperiment on_disc;
+  TEST_EQUAL(on_disc.openFile(parallel_consumer_file), true)
+  TEST_EQUAL(on_disc.getNrSpectra(), large.size())
+  for (Size i : {Size(0), Size(201), large.size() - 1})
+  {
+    TEST_EQUAL(on_disc.getSpectrum(i).size(), large[i].size())
+  }
+  TEST_EQUAL(on_disc.getChromatogram(1).size(), large.getChromatograms()[1].size())
+}
+END_SECTION
+
 START_SECTION(bool isValid(const String& filename, std::ostream& os = std::cerr))
 {
   std::string tmp_filename;
@@ -0,0 +1,145 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/FORMAT/MzMLFollower.h>
+///////////////////////////
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataStoringConsumer.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+#include <fstream>
+#include <iterator>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(MzMLFollower, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+MzMLFollower* ptr = nullptr;
+MzMLFollower* null_ptr = nullptr;
+START_SECTION(explicit MzMLFollower(const String& filename))
+  ptr = new MzMLFollower("does_not_exist_yet.mzML");
+  TEST_NOT_EQUAL(ptr, null_ptr)
+END_SECTION
+
+START_SECTION(~MzMLFollower())
+  delete ptr;
+END_SECTION
+
+// the full file and its expected content
+String in_file = OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML");
+PeakMap exp_full;
+MzMLFile().load(in_file, exp_full);
+std::ifstream ifs(in_file.c_str(), std::ios::binary);
+std::string content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+
+START_SECTION(Size poll(Interfaces::IMSDataConsumer* consumer))
+{
+  String tmp_file;
+  NEW_TMP_FILE(tmp_file);
+  MzMLFollower follower(tmp_file);
+  MSDataStoringConsumer consumer;
+  TEST_EQUAL(follower.poll(&consumer), 0) // no file yet
+
+  // the writer is in the middle of the header
+  Size cut = content.find("<run");
+  { std::ofstream os(tmp_file.c_str(), std::ios::binary); os << content.substr(0, cut); }
+  TEST_EQUAL(follower.poll(&consumer), 0)
+
+  // ... in the middle of the second spectrum
+  Size first = content.find("<spectrum ");
+  Size cut2 = content.find("<spectrum ", first + 1) + 20;
+  { std::ofstream os(tmp_file.c_str(), std::ios::binary | std::ios::app); os << content.substr(cut, cut2 - cut); }
+  TEST_EQUAL(follower.poll(&consumer), 1)
+  TEST_EQUAL(follower.poll(&consumer), 0) // nothing new
+  TEST_EQUAL(follower.isComplete(), false)
+
+  // ... and finished
+  { std::ofstream os(tmp_file.c_str(), std::ios::binary | std::ios::app); os << content.substr(cut2); }
+  TEST_EQUAL(follower.poll(&consumer), exp_full.size() - 1)
+  TEST_EQUAL(follower.isComplete(), true)
+  TEST_EQUAL(follower.getNrSpectra(), exp_full.size())
+
+  const PeakMap& exp = consumer.getData();
+  ABORT_IF(exp.size() != exp_full.size())
+  for (Size i = 0; i < exp.size(); ++i)
+  {
+    TEST_EQUAL(exp[i].getNativeID(), exp_full[i].getNativeID())
+    TEST_EQUAL(exp[i].getMSLevel(), exp_full[i].getMSLevel())
+    TEST_REAL_SIMILAR(exp[i].getRT(), exp_full[i].getRT())
+    TEST_EQUAL(exp[i].size(), exp_full[i].size())
+  }
+  TEST_EQUAL(exp.getInstrument().getName(), exp_full.getInstrument().getName())
+
+  // truncated file
+  MzMLFollower follower2(tmp_file);
+  follower2.poll(&consumer);
+  { std::ofstream os(tmp_file.c_str(), std::ios::binary); os << content.substr(0, cut); }
+  TEST_EXCEPTION(Exception::ParseError, follower2.poll(&consumer))
+}
+END_SECTION
+
+START_SECTION(bool isComplete() const)
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION(Size getNrSpectra() const)
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION(PeakFileOptions& getOptions())
+{
+  String tmp_file;
+  NEW_TMP_FILE(tmp_file);
+  { std::ofstream os(tmp_file.c_str(), std::ios::binary); os << content; }
+  MzMLFollower follower(tmp_file);
+  follower.getOptions().setMSLevels({2});
+  MSDataStoringConsumer consumer;
+  TEST_EQUAL(follower.poll(&consumer), exp_full.size()) // counts all spectra
+  Size nr_ms2 = 0;
+  for (const auto& spec : exp_full) nr_ms2 += (spec.getMSLevel() == 2);
+  TEST_EQUAL(consumer.getData().size(), nr_ms2)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
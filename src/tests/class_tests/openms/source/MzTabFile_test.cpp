@@ -122,6 +122,37 @@ START_SECTION(void store(const String& filename, MzTab& mzTab) )
 }
 END_SECTION
 
+START_SECTION([EXTRA] store restores empty and comment rows at their original line)
+{
+  // lines are streamed to the file while they are generated; empty and comment rows are inserted on the fly
+  MzTab mz_tab;
+  MzTabMetaData meta;
+  meta.description.fromCellString("streaming test");
+  mz_tab.setMetaData(meta);
+  mz_tab.setEmptyRows(vector<Size>(1, 1));
+  map<Size, String> comments;
+  comments[3] = "COM\tfirst comment";
+  comments[4] = "COM\tsecond comment";
+  mz_tab.setCommentRows(comments);
+
+  String stored_mzTab;
+  NEW_TMP_FILE(stored_mzTab)
+  MzTabFile().store(stored_mzTab, mz_tab);
+
+  TextFile stored(stored_mzTab); // keeps empty lines
+  vector<String> lines(stored.begin(), stored.end());
+  TEST_EQUAL(lines.size() > 5, true)
+  TEST_EQUAL(lines[0].hasPrefix("MTD\tmzTab-version"), true)
+  TEST_EQUAL(lines[1], "")
+  TEST_EQUAL(lines[2].hasPrefix("MTD\t"), true)
+  TEST_EQUAL(lines[3], "COM\tfirst comment")
+  TEST_EQUAL(lines[4], "COM\tsecond comment")
+  TEST_EQUAL(lines[5].hasPrefix("MTD\t"), true)
+
+  TEST_EXCEPTION(Exception::UnableToCreateFile, MzTabFile().store("/this/directory/does/not/exist/file.mzTab", mz_tab))
+}
+END_SECTION
+
 START_SECTION(~MzTabFile())
 {
   delete ptr;
@@ -42,6 +42,9 @@
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/KERNEL/StandardTypes.h>
 
+#include <fstream>
+#include <sstream>
+
 using namespace OpenMS;
 using namespace std;
 
@@ -592,6 +595,75 @@ START_SECTION(([EXTRA] load/store for nested scans))
 }
 END_SECTION
 
+START_SECTION(([EXTRA] load using the scan index))
+{
+  // nested scans with peaks, stored with index
+  PeakMap e;
+  e.resize(5);
+  UInt ms_levels[5] = {1, 2, 2, 1, 2};
+  for (Size i = 0; i < e.size(); ++i)
+  {
+    e[i].setMSLevel(ms_levels[i]);
+    e[i].setRT(10.0 * (i + 1));
+    e[i].setNativeID(String("scan=") + (i + 1));
+    for (Size p = 0; p <= i; ++p)
+    {
+      Peak1D peak;
+      peak.setMZ(100.0 + p);
+      peak.setIntensity(1000.0 * (i + 1));
+      e[i].push_back(peak);
+    }
+  }
+  String tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+  MzXMLFile f;
+  f.getOptions().setWriteIndex(true);
+  f.store(tmp_filename, e);
+
+  PeakMap indexed;
+  f.load(tmp_filename, indexed);
+  TEST_EQUAL(indexed.size(), 5)
+  for (Size i = 0; i < indexed.size(); ++i)
+  {
+    TEST_EQUAL(indexed[i].getMSLevel(), ms_levels[i])
+    TEST_EQUAL(indexed[i].size(), i + 1)
+    TEST_REAL_SIMILAR(indexed[i].back().getMZ(), 100.0 + i)
+    TEST_REAL_SIMILAR(indexed[i].back().getIntensity(), 1000.0 * (i + 1))
+  }
+
+  // filters are applied in the meta data pass
+  f.getOptions().addMSLevel(2);
+  f.load(tmp_filename, indexed);
+  TEST_EQUAL(indexed.size(), 3)
+  TEST_EQUAL(indexed[2].size(), 5)
+  f.getOptions().clearMSLevels();
+
+  // offsets pointing to the wrong position: falls back to sequential parsing
+  String content;
+  {
+    ifstream in(tmp_filename.c_str());
+    stringstream ss;
+    ss << in.rdbuf();
+    content = ss.str();
+  }
+  Size index_pos = content.find("<index");
+  String broken = content.prefix(index_pos) + content.substr(index_pos).substitute("<offset id = \"3\" >", "<offset id = \"3\" >1");
+  String broken_filename;
+  NEW_TMP_FILE(broken_filename);
+  {
+    ofstream out(broken_filename.c_str());
+    out << broken;
+  }
+  PeakMap sequential;
+  f.load(broken_filename, sequential);
+  TEST_EQUAL(sequential.size(), 5)
+  for (Size i = 0; i < sequential.size(); ++i)
+  {
+    TEST_EQUAL(sequential[i].size(), i + 1)
+  }
+}
+END_SECTION
+
 START_SECTION((template<typename MapType> void store(const String& filename, const MapType& map) const ))
 {
   std::string tmp_filename;
@@ -249,6 +249,63 @@ START_SECTION((void getMultipleSpectra(std::map<Int, MSSpectrum>& spectra, const
 }
 END_SECTION
 
+START_SECTION((FragmentLadder getLadder(const NASequence& oligo) const))
+{
+  NucleicAcidSpectrumGenerator gen;
+  NucleicAcidSpectrumGenerator::FragmentLadder ladder = gen.getLadder(NASequence::fromString("AUCCACAG"));
+  TEST_EQUAL(ladder.ribos.size(), 8);
+  ABORT_IF(ladder.sources.size() != ladder.uncharged.size());
+  // default: b and y ions (without b1)
+  TEST_EQUAL(ladder.uncharged.size(), 6 + 7);
+  TEST_EQUAL(ladder.sources[0].first == NucleicAcidSpectrumGenerator::FragmentLadder::Source::PREFIX, true);
+  TEST_EQUAL(ladder.sources[0].second, 1);
+  TEST_EQUAL(ladder.sources.back().first == NucleicAcidSpectrumGenerator::FragmentLadder::Source::SUFFIX, true);
+  TEST_EQUAL(ladder.sources.back().second, 6);
+}
+END_SECTION
+
+START_SECTION((void getMultipleSpectra(std::map<Int, MSSpectrum>& spectra, const FragmentLadder& ladder, const NASequence& oligo, const std::set<Int>& charges, Int base_charge = 1) const))
+{
+  NucleicAcidSpectrumGenerator gen;
+  Param param = gen.getParameters();
+  param.setValue("add_first_prefix_ion", "true");
+  param.setValue("add_metainfo", "true");
+  param.setValue("add_precursor_peaks", "true");
+  param.setValue("add_a_ions", "true");
+  param.setValue("add_c_ions", "true");
+  param.setValue("add_d_ions", "true");
+  param.setValue("add_w_ions", "true");
+  param.setValue("add_x_ions", "true");
+  param.setValue("add_z_ions", "true");
+  param.setValue("add_a-B_ions", "true");
+  gen.setParameters(param);
+
+  NucleicAcidSpectrumGenerator::FragmentLadder ladder = gen.getLadder(NASequence::fromString("AUCCACAG"));
+  set<Int> charges = {-1, -3, -5};
+  // variants of the ladder's oligo (and an oligo of different length):
+  for (const String& variant : ListUtils::create<String>("AUCCACAG,[m1A]UCCACAGp,AUC[m5C]ACA[m1G],AUCCAC"))
+  {
+    NASequence seq = NASequence::fromString(variant);
+    map<Int, MSSpectrum> compare, spectra;
+    gen.getMultipleSpectra(compare, seq, charges, -1);
+    gen.getMultipleSpectra(spectra, ladder, seq, charges, -1);
+    TEST_EQUAL(compare.size(), spectra.size());
+    for (Int charge : charges)
+    {
+      const MSSpectrum& expected = compare[charge];
+      const MSSpectrum& derived = spectra[charge];
+      ABORT_IF(expected.size() != derived.size());
+      for (Size i = 0; i < expected.size(); ++i)
+      {
+        TEST_REAL_SIMILAR(derived[i].getMZ(), expected[i].getMZ());
+      }
+      TEST_EQUAL(derived.getStringDataArrays()[0] == expected.getStringDataArrays()[0], true);
+      TEST_EQUAL(derived.getIntegerDataArrays()[0] == expected.getIntegerDataArrays()[0], true);
+    }
+  }
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 
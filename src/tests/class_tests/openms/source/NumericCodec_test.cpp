@@ -0,0 +1,171 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg, Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/DATASTRUCTURES/NumericCodec.h>
+///////////////////////////
+
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <cmath>
+#include <limits>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(NumericCodec, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+START_SECTION((static bool parse(const char* begin, const char* end, double& value)))
+{
+  const char* inputs[] = {"1.5", " -2.25e-7 ", "123456789.123", "+4", "1e300", "0", "\t3.1415926535897\n"};
+  for (const char* in : inputs)
+  {
+    double value = 0;
+    TEST_EQUAL(NumericCodec::parse(in, in + strlen(in), value), true)
+    TEST_EQUAL(value, String(in).toDouble()) // identical to the String conversion
+  }
+
+  double value = 7.0;
+  String bad("1.5x");
+  TEST_EQUAL(NumericCodec::parse(bad.c_str(), bad.c_str() + bad.size(), value), false)
+  bad = "1.5 2.5";
+  TEST_EQUAL(NumericCodec::parse(bad.c_str(), bad.c_str() + bad.size(), value), false)
+  bad = "  ";
+  TEST_EQUAL(NumericCodec::parse(bad.c_str(), bad.c_str() + bad.size(), value), false)
+  TEST_EQUAL(value, 7.0) // unchanged
+
+  String nan("nan");
+  TEST_EQUAL(NumericCodec::parse(nan.c_str(), nan.c_str() + nan.size(), value), true)
+  TEST_EQUAL(std::isnan(value), true)
+}
+END_SECTION
+
+START_SECTION((static bool parse(const char* begin, const char* end, float& value)))
+{
+  float value = 0;
+  String in(" 0.125 ");
+  TEST_EQUAL(NumericCodec::parse(in.c_str(), in.c_str() + in.size(), value), true)
+  TEST_EQUAL(value, 0.125f)
+  in = "a";
+  TEST_EQUAL(NumericCodec::parse(in.c_str(), in.c_str() + in.size(), value), false)
+  TEST_EQUAL(value, 0.125f)
+}
+END_SECTION
+
+START_SECTION((template <typename IntegerT> static bool parse(const char* begin, const char* end, IntegerT& value)))
+{
+  Int i = 0;
+  String in(" -42 ");
+  TEST_EQUAL(NumericCodec::parse(in.c_str(), in.c_str() + in.size(), i), true)
+  TEST_EQUAL(i, -42)
+  in = "+17";
+  TEST_EQUAL(NumericCodec::parse(in.c_str(), in.c_str() + in.size(), i), true)
+  TEST_EQUAL(i, 17)
+  in = "17.5";
+  TEST_EQUAL(NumericCodec::parse(in.c_str(), in.c_str() + in.size(), i), false)
+  in = "99999999999";
+  TEST_EQUAL(NumericCodec::parse(in.c_str(), in.c_str() + in.size(), i), false) // out of range
+  TEST_EQUAL(i, 17)
+
+  UInt64 u = 0;
+  in = "18446744073709551615";
+  TEST_EQUAL(NumericCodec::parse(in.c_str(), in.c_str() + in.size(), u), true)
+  TEST_EQUAL(u, std::numeric_limits<UInt64>::max())
+  in = "-1";
+  TEST_EQUAL(NumericCodec::parse(in.c_str(), in.c_str() + in.size(), u), false)
+}
+END_SECTION
+
+START_SECTION((static Size write(double value, char* buffer, bool full_precision = true)))
+{
+  char buffer[NumericCodec::MAX_LENGTH];
+  const double values[] = {0.0, 1.5, -2.25e-7, 123456789.123, 1e300, -1e-300, 3.14159265358979, 0.01, 9999.5,
+                           std::numeric_limits<double>::max(), std::numeric_limits<double>::quiet_NaN()};
+  for (double value : values)
+  {
+    Size n = NumericCodec::write(value, buffer);
+    TEST_STRING_EQUAL(String(buffer, buffer + n), String(value, true))
+    n = NumericCodec::write(value, buffer, false);
+    TEST_STRING_EQUAL(String(buffer, buffer + n), String(value, false))
+  }
+}
+END_SECTION
+
+START_SECTION((static Size write(float value, char* buffer, bool full_precision = true)))
+{
+  char buffer[NumericCodec::MAX_LENGTH];
+  const float values[] = {0.0f, 1.5f, -2.25e-7f, 123456.789f, std::numeric_limits<float>::max()};
+  for (float value : values)
+  {
+    Size n = NumericCodec::write(value, buffer);
+    TEST_STRING_EQUAL(String(buffer, buffer + n), String(value, true))
+    n = NumericCodec::write(value, buffer, false);
+    TEST_STRING_EQUAL(String(buffer, buffer + n), String(value, false))
+  }
+}
+END_SECTION
+
+START_SECTION((static Size write(long double value, char* buffer, bool full_precision = true)))
+{
+  char buffer[NumericCodec::MAX_LENGTH];
+  const long double values[] = {0.0L, 1.5L, -2.25e-7L, 1e4000L, std::numeric_limits<long double>::max()};
+  for (long double value : values)
+  {
+    Size n = NumericCodec::write(value, buffer);
+    TEST_STRING_EQUAL(String(buffer, buffer + n), String(value, true))
+  }
+}
+END_SECTION
+
+START_SECTION((template <typename IntegerT> static Size write(IntegerT value, char* buffer)))
+{
+  char buffer[NumericCodec::MAX_LENGTH];
+  Size n = NumericCodec::write(-123, buffer);
+  TEST_STRING_EQUAL(String(buffer, buffer + n), String(-123))
+  n = NumericCodec::write(std::numeric_limits<Int64>::min(), buffer);
+  TEST_STRING_EQUAL(String(buffer, buffer + n), String(std::numeric_limits<Int64>::min()))
+  n = NumericCodec::write(std::numeric_limits<UInt64>::max(), buffer);
+  TEST_STRING_EQUAL(String(buffer, buffer + n), String(std::numeric_limits<UInt64>::max()))
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
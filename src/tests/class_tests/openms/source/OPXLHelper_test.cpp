@@ -131,6 +131,7 @@ START_SECTION(static std::vector<OPXLDataStructs::XLPrecursor> enumerateCrossLin
   TOLERANCE_ABSOLUTE(1e-3)
   TEST_EQUAL(precursors.size(), 9604)
   TEST_EQUAL(spectrum_precursor_correction_positions.size(), 9604)
+  TEST_EQUAL(std::is_sorted(spectrum_precursor_correction_positions.begin(), spectrum_precursor_correction_positions.end()), true)
   // sample about 1/15 of the data, since a lot of precursors are generated
 
   for (Size i = 0; i < precursors.size(); i += 2000)
@@ -0,0 +1,159 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Eugen Netz $
+// $Authors: Eugen Netz $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/ANALYSIS/XLMS/OPXLTheoreticalSpectrumPool.h>
+///////////////////////////
+
+#include <OpenMS/CHEMISTRY/AASequence.h>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(OPXLTheoreticalSpectrumPool, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+SimpleTSGXLMS generator;
+Param param(generator.getParameters());
+param.setValue("add_losses", "true");
+param.setValue("add_k_linked_ions", "true");
+generator.setParameters(param);
+
+AASequence alpha = AASequence::fromString("IFSQVGK");
+AASequence beta = AASequence::fromString("TESTPEP");
+OPXLDataStructs::ProteinProteinCrossLink test_link;
+test_link.alpha = &alpha;
+test_link.beta = &beta;
+test_link.cross_link_position = std::make_pair<SignedSize, SignedSize> (3, 4);
+test_link.cross_linker_mass = 150.0;
+
+OPXLTheoreticalSpectrumPool* ptr = nullptr;
+OPXLTheoreticalSpectrumPool* null_ptr = nullptr;
+START_SECTION((explicit OPXLTheoreticalSpectrumPool(const SimpleTSGXLMS& generator, Size max_entries = 100000)))
+{
+  ptr = new OPXLTheoreticalSpectrumPool(generator);
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->size(), 0)
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((SimpleSpectrumPtr getLinearIonSpectrum(const AASequence& peptide, Size link_pos, int charge = 1, Size link_pos_2 = 0)))
+{
+  OPXLTheoreticalSpectrumPool pool(generator);
+  OPXLTheoreticalSpectrumPool::SimpleSpectrum direct;
+  generator.getLinearIonSpectrum(direct, alpha, 3, 2);
+
+  OPXLTheoreticalSpectrumPool::SimpleSpectrumPtr pooled = pool.getLinearIonSpectrum(alpha, 3, 2);
+  TEST_EQUAL(pooled->size(), direct.size())
+  for (Size i = 0; i != direct.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(pooled->at(i).mz, direct[i].mz)
+    TEST_EQUAL(pooled->at(i).charge, direct[i].charge)
+  }
+  TEST_EQUAL(pool.size(), 1)
+
+  // the same request returns the pooled spectrum
+  TEST_EQUAL(pool.getLinearIonSpectrum(alpha, 3, 2) == pooled, true)
+  TEST_EQUAL(pool.size(), 1)
+
+  // a different link position or charge is a different spectrum
+  TEST_EQUAL(pool.getLinearIonSpectrum(alpha, 2, 2) == pooled, false)
+  TEST_EQUAL(pool.getLinearIonSpectrum(alpha, 3, 3) == pooled, false)
+  TEST_EQUAL(pool.size(), 3)
+}
+END_SECTION
+
+START_SECTION((SimpleSpectrumPtr getXLinkIonSpectrum(const OPXLDataStructs::ProteinProteinCrossLink& crosslink, bool frag_alpha, int mincharge, int maxcharge)))
+{
+  OPXLTheoreticalSpectrumPool pool(generator);
+  OPXLTheoreticalSpectrumPool::SimpleSpectrum direct_alpha, direct_beta;
+  generator.getXLinkIonSpectrum(direct_alpha, test_link, true, 2, 3);
+  generator.getXLinkIonSpectrum(direct_beta, test_link, false, 2, 3);
+
+  OPXLTheoreticalSpectrumPool::SimpleSpectrumPtr pooled_alpha = pool.getXLinkIonSpectrum(test_link, true, 2, 3);
+  OPXLTheoreticalSpectrumPool::SimpleSpectrumPtr pooled_beta = pool.getXLinkIonSpectrum(test_link, false, 2, 3);
+  TEST_EQUAL(pool.size(), 2)
+  TEST_EQUAL(pooled_alpha->size(), direct_alpha.size())
+  TEST_EQUAL(pooled_beta->size(), direct_beta.size())
+  for (Size i = 0; i != direct_alpha.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(pooled_alpha->at(i).mz, direct_alpha[i].mz)
+  }
+  for (Size i = 0; i != direct_beta.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(pooled_beta->at(i).mz, direct_beta[i].mz)
+  }
+  TEST_EQUAL(pool.getXLinkIonSpectrum(test_link, true, 2, 3) == pooled_alpha, true)
+
+  // a different cross-linker mass is a different spectrum
+  OPXLDataStructs::ProteinProteinCrossLink other_link = test_link;
+  other_link.cross_linker_mass = 138.0;
+  TEST_EQUAL(pool.getXLinkIonSpectrum(other_link, true, 2, 3) == pooled_alpha, false)
+  TEST_EQUAL(pool.size(), 3)
+}
+END_SECTION
+
+START_SECTION((Size size() const))
+{
+  // no more spectra are pooled once max_entries is reached
+  OPXLTheoreticalSpectrumPool pool(generator, 2);
+  pool.getLinearIonSpectrum(alpha, 1, 2);
+  pool.getLinearIonSpectrum(alpha, 2, 2);
+  OPXLTheoreticalSpectrumPool::SimpleSpectrumPtr unpooled = pool.getLinearIonSpectrum(alpha, 3, 2);
+  TEST_EQUAL(pool.size(), 2)
+  TEST_EQUAL(unpooled->empty(), false)
+  TEST_EQUAL(pool.getLinearIonSpectrum(alpha, 3, 2) == unpooled, false)
+}
+END_SECTION
+
+START_SECTION((void clear()))
+{
+  OPXLTheoreticalSpectrumPool pool(generator);
+  pool.getLinearIonSpectrum(alpha, 3, 2);
+  pool.getLinearIonSpectrum(beta, 4, 2);
+  TEST_EQUAL(pool.size(), 2)
+  pool.clear();
+  TEST_EQUAL(pool.size(), 0)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
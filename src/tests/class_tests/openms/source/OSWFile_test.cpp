@@ -0,0 +1,200 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: George Rosenberger $
+// $Authors: George Rosenberger $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/FORMAT/OSWFile.h>
+///////////////////////////
+
+#include <OpenMS/FORMAT/SqliteConnector.h>
+
+#include <sqlite3.h>
+
+#include <sstream>
+
+using namespace OpenMS;
+using namespace std;
+
+// creates a minimal OSW file with three MS2-level features (two of them in the same peak group)
+void createOSW(const String& filename)
+{
+  SqliteConnector conn(filename);
+  conn.executeStatement("CREATE TABLE FEATURE(ID INT, PRECURSOR_ID INT, RUN_ID INT);"
+                        "CREATE TABLE FEATURE_MS2(FEATURE_ID INT, VAR_B DOUBLE, VAR_A DOUBLE);"
+                        "CREATE TABLE PRECURSOR(ID INT, DECOY INT);"
+                        "CREATE TABLE PRECURSOR_PEPTIDE_MAPPING(PRECURSOR_ID INT, PEPTIDE_ID INT);"
+                        "CREATE TABLE PEPTIDE(ID INT, MODIFIED_SEQUENCE TEXT);"
+                        "INSERT INTO FEATURE VALUES (11, 1, 0), (12, 2, 0), (13, 1, 0);"
+                        "INSERT INTO FEATURE_MS2 VALUES (11, 2.0, 0.5), (12, 3.0, 1.5), (13, 4.0, 2.5);"
+                        "INSERT INTO PRECURSOR VALUES (1, 0), (2, 1);"
+                        "INSERT INTO PRECURSOR_PEPTIDE_MAPPING VALUES (1, 1), (2, 2);"
+                        "INSERT INTO PEPTIDE VALUES (1, 'PEPTIDE'), (2, 'EDITPEP');");
+}
+
+// sum of the values of @p column in @p table (and number of rows)
+pair<Size, double> sumColumn(const String& filename, const String& table, const String& column)
+{
+  SqliteConnector conn(filename);
+  sqlite3_stmt* stmt;
+  conn.prepareStatement(&stmt, "SELECT COUNT(*), TOTAL(" + column + ") FROM " + table + ";");
+  sqlite3_step(stmt);
+  pair<Size, double> result(sqlite3_column_int(stmt, 0), sqlite3_column_double(stmt, 1));
+  sqlite3_finalize(stmt);
+  return result;
+}
+
+START_TEST(OSWFile, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+OSWFile* ptr = nullptr;
+OSWFile* null_ptr = nullptr;
+START_SECTION(OSWFile())
+{
+  ptr = new OSWFile();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+}
+END_SECTION
+
+START_SECTION(virtual ~OSWFile())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(void read(const std::string& in_osw, const std::string& osw_level, std::ostream& pin_output, const double& ipf_max_peakgroup_pep, const double& ipf_max_transition_isotope_overlap, const double& ipf_min_transition_sn))
+{
+  String filename;
+  NEW_TMP_FILE(filename)
+  createOSW(filename);
+
+  std::stringstream pin;
+  OSWFile().read(filename, "ms2", pin, 0.7, 0.5, 0);
+  std::vector<String> lines;
+  String(pin.str()).trim().split('\n', lines);
+  TEST_EQUAL(lines.size(), 4)
+  ABORT_IF(lines.size() != 4)
+  TEST_EQUAL(lines[0], "PSMId\tLabel\tScanNr\tVAR_A\tVAR_B\tPeptide\tProteins")
+
+  std::map<String, std::vector<String> > rows;
+  for (Size i = 1; i < lines.size(); ++i)
+  {
+    std::vector<String> fields;
+    lines[i].split('\t', fields);
+    TEST_EQUAL(fields.size(), 7)
+    rows[fields[0]] = fields;
+  }
+  TEST_EQUAL(rows["11"][1], "1")
+  TEST_EQUAL(rows["12"][1], "-1")
+  TEST_EQUAL(rows["11"][2], rows["13"][2])
+  TEST_NOT_EQUAL(rows["11"][2], rows["12"][2])
+  TEST_EQUAL(rows["13"][3], "2.5")
+  TEST_EQUAL(rows["13"][4], "4")
+  TEST_EQUAL(rows["12"][5], ".EDITPEP.")
+  TEST_EQUAL(rows["12"][6], "Prot1")
+
+  // transition level needs MS2 scores
+  TEST_EXCEPTION(Exception::IllegalArgument, OSWFile().read(filename, "transition", pin, 0.7, 0.5, 0))
+}
+END_SECTION
+
+START_SECTION(void write(const std::string& in_osw, const std::string& osw_level, const std::map< std::string, std::vector<double> >& features))
+{
+  String filename;
+  NEW_TMP_FILE(filename)
+  createOSW(filename);
+
+  std::map<std::string, std::vector<double> > features;
+  features["11"] = {1.0, 0.01, 0.1};
+  features["12"] = {-1.0, 0.5, 0.9};
+  OSWFile().write(filename, "ms2", features);
+  pair<Size, double> pep = sumColumn(filename, "SCORE_MS2", "PEP");
+  TEST_EQUAL(pep.first, 2)
+  TEST_REAL_SIMILAR(pep.second, 1.0)
+
+  // writing again replaces the table
+  features.erase("12");
+  OSWFile().write(filename, "ms2", features);
+  TEST_EQUAL(sumColumn(filename, "SCORE_MS2", "PEP").first, 1)
+}
+END_SECTION
+
+START_SECTION(([OSWFile::ScoreWriter] void add(const std::string& id, double score, double qvalue, double pep)))
+{
+  String filename;
+  NEW_TMP_FILE(filename)
+  createOSW(filename);
+
+  {
+    OSWFile::ScoreWriter writer(filename, "transition");
+    writer.add("11_100", 1.0, 0.01, 0.25);
+    writer.add("11_101", 2.0, 0.02, 0.5);
+    TEST_EXCEPTION(Exception::IllegalArgument, writer.add("11", 2.0, 0.02, 0.5))
+    writer.commit();
+  }
+  TEST_EQUAL(sumColumn(filename, "SCORE_TRANSITION", "TRANSITION_ID").first, 2)
+  TEST_REAL_SIMILAR(sumColumn(filename, "SCORE_TRANSITION", "TRANSITION_ID").second, 201)
+  TEST_REAL_SIMILAR(sumColumn(filename, "SCORE_TRANSITION", "PEP").second, 0.75)
+}
+END_SECTION
+
+START_SECTION(([OSWFile::ScoreWriter] void commit()))
+{
+  String filename;
+  NEW_TMP_FILE(filename)
+  createOSW(filename);
+
+  {
+    OSWFile::ScoreWriter writer(filename, "ms1");
+    writer.add("11", 1.0, 0.01, 0.25);
+    writer.commit();
+  }
+  // without commit(), the previous scores are kept
+  {
+    OSWFile::ScoreWriter writer(filename, "ms1");
+    writer.add("12", 1.0, 0.01, 0.5);
+    writer.add("13", 1.0, 0.01, 0.5);
+  }
+  pair<Size, double> pep = sumColumn(filename, "SCORE_MS1", "PEP");
+  TEST_EQUAL(pep.first, 1)
+  TEST_REAL_SIMILAR(pep.second, 0.25)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
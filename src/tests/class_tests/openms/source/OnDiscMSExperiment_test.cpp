@@ -39,6 +39,10 @@
 #include <OpenMS/KERNEL/OnDiscMSExperiment.h>
 ///////////////////////////
 
+#include <OpenMS/SYSTEM/File.h>
+
+#include <fstream>
+
 START_TEST(OnDiscMSExperiment, "$Id$");
 
 /////////////////////////////////////////////////////////////
@@ -334,7 +338,77 @@ START_SECTION(MSMSSpectrum getSpectrumByNativeId(const std::string& id))
 }
 END_SECTION
 
+START_SECTION((void loadMetaData()))
+{
+  OnDiscPeakMap tmp; tmp.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), true);
+  TEST_EQUAL(tmp.getMetaData() == nullptr, true)
+  tmp.loadMetaData();
+  TEST_EQUAL(tmp.getMetaData() == nullptr, false)
+  TEST_EQUAL(tmp.getMetaData()->size(), 2)
+  TEST_EQUAL(tmp.getSpectrum(0).getNativeID(), "controllerType=0 controllerNumber=1 scan=1")
+}
+END_SECTION
+
+START_SECTION((static String getSpectrumHeaderFilename(const String& filename)))
+{
+  TEST_EQUAL(OnDiscPeakMap::getSpectrumHeaderFilename("data/test.mzML"), "data/test.mzML.headers")
+}
+END_SECTION
+
+START_SECTION((const std::vector<SpectrumHeader>& getSpectrumHeaders()))
+{
+  // work on a copy, the header table is cached next to the file
+  String filename;
+  NEW_TMP_FILE(filename)
+  {
+    ifstream in(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), ios::binary);
+    ofstream out(filename.c_str(), ios::binary);
+    out << in.rdbuf();
+  }
+  String header_file = OnDiscPeakMap::getSpectrumHeaderFilename(filename);
+  File::remove(header_file);
+
+  // reference: headers derived from the full meta data
+  OnDiscPeakMap full; full.openFile(filename);
+  vector<OnDiscPeakMap::SpectrumHeader> expected = full.getSpectrumHeaders();
+  TEST_EQUAL(expected.size(), 2)
+  TEST_EQUAL(File::exists(header_file), false)
+
+  // fast scan of the file, without meta data
+  OnDiscPeakMap lazy; lazy.openFile(filename, true);
+  const vector<OnDiscPeakMap::SpectrumHeader>& headers = lazy.getSpectrumHeaders();
+  TEST_EQUAL(lazy.getMetaData() == nullptr, true)
+  TEST_EQUAL(headers.size(), expected.size())
+  for (Size i = 0; i < headers.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(headers[i].rt, expected[i].rt)
+    TEST_EQUAL(headers[i].ms_level, expected[i].ms_level)
+    TEST_REAL_SIMILAR(headers[i].precursor_mz, expected[i].precursor_mz)
+    TEST_EQUAL(headers[i].precursor_charge, expected[i].precursor_charge)
+    TEST_EQUAL(lazy.getSpectrumNativeID(i), full.getSpectrumNativeID(i))
+  }
+  TEST_EQUAL(File::exists(header_file), true)
+
+  // sidecar file is used on the next open
+  OnDiscPeakMap cached; cached.openFile(filename, true);
+  TEST_EQUAL(cached.getSpectrumHeaders().size(), expected.size())
+  TEST_EQUAL(cached.getSpectrumNativeID(1), "controllerType=0 controllerNumber=1 scan=2")
+  TEST_REAL_SIMILAR(cached.getSpectrumHeaders()[1].rt, expected[1].rt)
+
+  OnDiscPeakMap failed; failed.openFile(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), true);
+  TEST_EXCEPTION(Exception::ParseError, failed.getSpectrumHeaders())
+  File::remove(header_file);
+}
+END_SECTION
+
+START_SECTION((String getSpectrumNativeID(Size id)))
+{
+  OnDiscPeakMap tmp; tmp.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
+  TEST_EQUAL(tmp.getSpectrumNativeID(0), "controllerType=0 controllerNumber=1 scan=1")
+  TEST_EXCEPTION(Exception::IndexOverflow, tmp.getSpectrumNativeID(2))
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
-
@@ -133,6 +133,75 @@ START_SECTION(static void selectSwathTransitions(const OpenSwath::LightTargetedE
 }
 END_SECTION
 
+START_SECTION(static void selectShard(const OpenSwath::LightTargetedExperiment& targeted_exp, OpenSwath::LightTargetedExperiment& shard, Size shard_index, Size shard_count))
+{
+  LightTargetedExperiment exp;
+  const char* compound_ids[] = {"A", "B", "C", "D"};
+  const char* protein_ids[] = {"P1", "P2", "P1", "P3"};
+  const int nr_transitions[] = {3, 1, 2, 2};
+  for (Size i = 0; i < 4; ++i)
+  {
+    LightCompound compound;
+    compound.id = compound_ids[i];
+    compound.protein_refs.push_back(protein_ids[i]);
+    exp.compounds.push_back(compound);
+  }
+  for (Size k = 0; k < 3; ++k)
+  {
+    for (Size i = 0; i < 4; ++i)
+    {
+      if (int(k) >= nr_transitions[i]) continue;
+      LightTransition tr;
+      tr.transition_name = String(compound_ids[i]) + "_" + String(k);
+      tr.peptide_ref = compound_ids[i];
+      exp.transitions.push_back(tr);
+    }
+  }
+  const char* all_proteins[] = {"P1", "P2", "P3"};
+  for (Size i = 0; i < 3; ++i)
+  {
+    LightProtein protein;
+    protein.id = all_proteins[i];
+    exp.proteins.push_back(protein);
+  }
+
+  // balanced by number of transitions: A (3) + B (1) and C (2) + D (2)
+  LightTargetedExperiment shard0, shard1;
+  OpenSwathHelper::selectShard(exp, shard0, 0, 2);
+  OpenSwathHelper::selectShard(exp, shard1, 1, 2);
+
+  TEST_EQUAL(shard0.compounds.size(), 2)
+  TEST_EQUAL(shard0.compounds[0].id, "A")
+  TEST_EQUAL(shard0.compounds[1].id, "B")
+  TEST_EQUAL(shard0.transitions.size(), 4)
+  TEST_EQUAL(shard0.transitions[0].transition_name, "A_0")
+  TEST_EQUAL(shard0.transitions[1].transition_name, "B_0")
+  TEST_EQUAL(shard0.transitions[2].transition_name, "A_1")
+  TEST_EQUAL(shard0.proteins.size(), 2)
+  TEST_EQUAL(shard0.proteins[0].id, "P1")
+  TEST_EQUAL(shard0.proteins[1].id, "P2")
+
+  TEST_EQUAL(shard1.compounds.size(), 2)
+  TEST_EQUAL(shard1.compounds[0].id, "C")
+  TEST_EQUAL(shard1.compounds[1].id, "D")
+  TEST_EQUAL(shard1.transitions.size(), 4)
+  TEST_EQUAL(shard1.proteins.size(), 2)
+  TEST_EQUAL(shard1.proteins[0].id, "P1")
+  TEST_EQUAL(shard1.proteins[1].id, "P3")
+
+  // a single shard keeps everything
+  LightTargetedExperiment all;
+  OpenSwathHelper::selectShard(exp, all, 0, 1);
+  TEST_EQUAL(all.compounds.size(), 4)
+  TEST_EQUAL(all.transitions.size(), 8)
+  TEST_EQUAL(all.proteins.size(), 3)
+
+  LightTargetedExperiment invalid;
+  TEST_EXCEPTION(Exception::IllegalArgument, OpenSwathHelper::selectShard(exp, invalid, 2, 2))
+  TEST_EXCEPTION(Exception::IllegalArgument, OpenSwathHelper::selectShard(exp, invalid, 0, 0))
+}
+END_SECTION
+
 START_SECTION( (template < class TargetedExperimentT > static bool checkSwathMapAndSelectTransitions(const OpenMS::PeakMap &exp, const TargetedExperimentT &targeted_exp, TargetedExperimentT &transition_exp_used, double min_upper_edge_dist)))
 {
   // tested above already
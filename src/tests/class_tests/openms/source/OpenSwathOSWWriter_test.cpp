@@ -0,0 +1,145 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathOSWWriter.h>
+///////////////////////////
+
+#include <OpenMS/FORMAT/SqliteConnector.h>
+
+#include <sqlite3.h>
+
+using namespace OpenMS;
+using namespace std;
+
+// number of rows in the FEATURE table
+Size countFeatures(const String& filename)
+{
+  SqliteConnector conn(filename);
+  sqlite3_stmt* stmt;
+  conn.prepareStatement(&stmt, "SELECT COUNT(*) FROM FEATURE;");
+  sqlite3_step(stmt);
+  Size n = sqlite3_column_int(stmt, 0);
+  sqlite3_finalize(stmt);
+  return n;
+}
+
+// one INSERT statement per feature id in [begin, end)
+vector<String> featureStatements(Size begin, Size end)
+{
+  vector<String> statements;
+  for (Size i = begin; i < end; ++i)
+  {
+    statements.push_back("INSERT INTO FEATURE (ID, RUN_ID, PRECURSOR_ID, EXP_RT, NORM_RT, DELTA_RT, LEFT_WIDTH, RIGHT_WIDTH) VALUES (" +
+                         String(i) + ", 0, 0, 1.0, 1.0, 0.0, 0.5, 1.5);");
+  }
+  return statements;
+}
+
+START_TEST(OpenSwathOSWWriter, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+OpenSwathOSWWriter* ptr = nullptr;
+OpenSwathOSWWriter* null_ptr = nullptr;
+START_SECTION(OpenSwathOSWWriter(const String& output_filename, const String& input_filename = "inputfile", bool ms1_scores = false, bool sonar = false, bool uis_scores = false))
+{
+  ptr = new OpenSwathOSWWriter("");
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->isActive(), false)
+}
+END_SECTION
+
+START_SECTION(~OpenSwathOSWWriter())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(void writeLines(const std::vector<String>& to_osw_output))
+{
+  String filename;
+  NEW_TMP_FILE(filename)
+  OpenSwathOSWWriter writer(filename);
+  writer.writeHeader();
+  writer.writeLines(featureStatements(0, 3));
+  TEST_EQUAL(countFeatures(filename), 3)
+}
+END_SECTION
+
+START_SECTION(void startAsyncWriting(Size max_queued_batches = 64))
+{
+  String filename;
+  NEW_TMP_FILE(filename)
+  OpenSwathOSWWriter writer(filename);
+  writer.writeHeader();
+  writer.startAsyncWriting(2);
+  writer.startAsyncWriting(2); // no-op
+  for (Size b = 0; b < 10; ++b)
+  {
+    writer.writeLines(featureStatements(b * 5, b * 5 + 5));
+  }
+  writer.finishAsyncWriting();
+  TEST_EQUAL(countFeatures(filename), 50)
+
+  // inactive writer
+  OpenSwathOSWWriter inactive("");
+  inactive.startAsyncWriting();
+  inactive.finishAsyncWriting();
+}
+END_SECTION
+
+START_SECTION(void finishAsyncWriting())
+{
+  String filename;
+  NEW_TMP_FILE(filename)
+  OpenSwathOSWWriter writer(filename);
+  writer.writeHeader();
+  writer.finishAsyncWriting(); // not started: no-op
+
+  // errors of the writer thread are reported
+  writer.startAsyncWriting();
+  writer.writeLines(featureStatements(0, 1));
+  writer.writeLines(featureStatements(0, 1)); // duplicate primary key
+  TEST_EXCEPTION(Exception::IllegalArgument, writer.finishAsyncWriting())
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
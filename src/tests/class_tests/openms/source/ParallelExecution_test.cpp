@@ -0,0 +1,195 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/CONCEPT/ParallelExecution.h>
+#include <OpenMS/CONCEPT/Exception.h>
+
+#include <atomic>
+#include <numeric>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(ParallelExecution, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+START_SECTION((static int getAvailableCores()))
+{
+  TEST_EQUAL(ParallelExecution::getAvailableCores() >= 1, true)
+}
+END_SECTION
+
+START_SECTION((static void setNumberOfThreads(int num_threads)))
+{
+  ParallelExecution::setNumberOfThreads(1);
+  TEST_EQUAL(ParallelExecution::getNumberOfThreads(), 1)
+#ifdef _OPENMP
+  // limited to the available cores
+  ParallelExecution::setNumberOfThreads(100000);
+  TEST_EQUAL(ParallelExecution::getNumberOfThreads(), ParallelExecution::getAvailableCores())
+  ParallelExecution::setNumberOfThreads(0);
+  TEST_EQUAL(ParallelExecution::getNumberOfThreads(), ParallelExecution::getAvailableCores())
+#endif
+  ParallelExecution::setNumberOfThreads(2);
+}
+END_SECTION
+
+START_SECTION((static int getNumberOfThreads()))
+{
+  TEST_EQUAL(ParallelExecution::getNumberOfThreads() >= 1, true)
+}
+END_SECTION
+
+START_SECTION((static void setThreadAffinity(ThreadAffinity affinity)))
+{
+  const int cores = ParallelExecution::getAvailableCores();
+  ParallelExecution::setThreadAffinity(ParallelExecution::ThreadAffinity::SPREAD);
+  // the cores available to the process do not change by pinning its threads
+  TEST_EQUAL(ParallelExecution::getAvailableCores(), cores)
+  vector<int> values(100, 0);
+  ParallelExecution::forEach(0, 100, [&](SignedSize i) { values[i] = 1; });
+  TEST_EQUAL(std::accumulate(values.begin(), values.end(), 0), 100)
+  ParallelExecution::setThreadAffinity(ParallelExecution::ThreadAffinity::CLOSE);
+  TEST_EQUAL(ParallelExecution::getAvailableCores(), cores)
+  ParallelExecution::setThreadAffinity(ParallelExecution::ThreadAffinity::NONE);
+  TEST_EQUAL(ParallelExecution::getAvailableCores(), cores)
+}
+END_SECTION
+
+START_SECTION((static bool inParallelRegion()))
+{
+  TEST_EQUAL(ParallelExecution::inParallelRegion(), false)
+  vector<char> inside(10, 0);
+  ParallelExecution::forEach(0, 10, [&](SignedSize i) { inside[i] = ParallelExecution::inParallelRegion() || ParallelExecution::getNumberOfThreads() == 1; });
+  TEST_EQUAL(std::count(inside.begin(), inside.end(), 1), 10)
+}
+END_SECTION
+
+START_SECTION((template <typename Function> static void forEach(SignedSize begin, SignedSize end, const Function& f, Schedule schedule = Schedule::STATIC, int chunk_size = 1)))
+{
+  vector<int> values(1000, 0);
+  ParallelExecution::forEach(0, 1000, [&](SignedSize i) { values[i] = (int)i; });
+  TEST_EQUAL(std::accumulate(values.begin(), values.end(), 0), 999 * 1000 / 2)
+
+  vector<int> dynamic(1000, 0);
+  ParallelExecution::forEach(10, 1000, [&](SignedSize i) { dynamic[i] = 1; }, ParallelExecution::Schedule::DYNAMIC, 7);
+  TEST_EQUAL(std::accumulate(dynamic.begin(), dynamic.end(), 0), 990)
+
+  // empty range
+  ParallelExecution::forEach(5, 5, [&](SignedSize) { values[0] = -1; });
+  TEST_EQUAL(values[0], 0)
+
+  // nested loops do not start new threads but still process everything
+  std::atomic<int> count(0);
+  ParallelExecution::forEach(0, 10, [&](SignedSize)
+  {
+    ParallelExecution::forEach(0, 10, [&](SignedSize) { ++count; });
+  });
+  TEST_EQUAL(count, 100)
+
+  // the first exception is rethrown after the loop, all other iterations are processed
+  vector<int> processed(100, 0);
+  TEST_EXCEPTION(Exception::InvalidValue, ParallelExecution::forEach(0, 100, [&](SignedSize i)
+  {
+    processed[i] = 1;
+    if (i == 42) throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "test", "42");
+  }))
+  TEST_EQUAL(std::accumulate(processed.begin(), processed.end(), 0), 100)
+}
+END_SECTION
+
+START_SECTION((template <typename Init, typename Function> static void forEachWithState(SignedSize begin, SignedSize end, const Init& init, const Function& f, Schedule schedule = Schedule::STATIC, int chunk_size = 1)))
+{
+  // every thread accumulates into its own state
+  std::atomic<int> nr_states(0);
+  vector<int> values(500, 0);
+  ParallelExecution::forEachWithState(0, 500, [&]() { ++nr_states; return vector<int>(); },
+    [&](vector<int>& state, SignedSize i)
+    {
+      state.push_back((int)i);
+      values[i] = (int)state.size();
+    }, ParallelExecution::Schedule::DYNAMIC);
+  TEST_EQUAL(nr_states >= 1, true)
+  TEST_EQUAL(nr_states <= ParallelExecution::getNumberOfThreads(), true)
+  TEST_EQUAL(std::count(values.begin(), values.end(), 0), 0)
+
+  TEST_EXCEPTION(Exception::InvalidValue, ParallelExecution::forEachWithState(0, 10,
+    []() -> int { throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "test", "init"); },
+    [](int&, SignedSize) {}))
+}
+END_SECTION
+
+START_SECTION((static void runTasks(const std::vector<std::function<void()> >& tasks)))
+{
+  vector<int> done(3, 0);
+  vector<std::function<void()> > tasks;
+  tasks.push_back([&]() { done[0] = 1; });
+  tasks.push_back([&]() { done[1] = 2; });
+  tasks.push_back([&]() { done[2] = 3; });
+  ParallelExecution::runTasks(tasks);
+  TEST_EQUAL(done[0], 1)
+  TEST_EQUAL(done[1], 2)
+  TEST_EQUAL(done[2], 3)
+}
+END_SECTION
+
+START_SECTION((template <typename Compute, typename Consume> static void pipeline(SignedSize begin, SignedSize end, SignedSize block_size, const Compute& compute, const Consume& consume, Schedule schedule = Schedule::DYNAMIC)))
+{
+  vector<int> computed(100, 0);
+  vector<int> consumed;
+  ParallelExecution::pipeline(0, 100, 16,
+    [&](SignedSize i) { computed[i] = (int)(i * i); },
+    [&](SignedSize i)
+    {
+      // results of the block are available and consumed in order
+      TEST_EQUAL(computed[i], (int)(i * i))
+      consumed.push_back((int)i);
+    });
+  TEST_EQUAL(consumed.size(), 100)
+  bool in_order = true;
+  for (Size i = 0; i < consumed.size(); ++i) in_order &= (consumed[i] == (int)i);
+  TEST_EQUAL(in_order, true)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -939,6 +939,59 @@ START_SECTION((Param(const Param& rhs)))
 	TEST_EQUAL(p2.getTags("test:float") == ListUtils::create<String>("a,b,c"), true)
 END_SECTION
 
+START_SECTION((Param(Param&& rhs)))
+{
+	Param p1(p_src);
+	Param p2(std::move(p1));
+	TEST_EQUAL(Int(p2.getValue("test:int")), 17)
+	TEST_EQUAL(p1.empty(), true) // moved-from Param is empty, but usable
+	p1.setValue("new", 1);
+	TEST_EQUAL(p1.size(), 1)
+}
+END_SECTION
+
+START_SECTION(([EXTRA] copy-on-write and hashed lookup))
+{
+	Param p1(p_src);
+	Param p2(p1);
+	// modifying a copy does not affect the others
+	p2.setValue("test:int", 42);
+	p2.setMinInt("test:int", 5);
+	p2.addTag("test2:int", "advanced");
+	TEST_EQUAL(Int(p1.getValue("test:int")), 17)
+	TEST_EQUAL(Int(p_src.getValue("test:int")), 17)
+	TEST_EQUAL(Int(p2.getValue("test:int")), 42)
+	TEST_EQUAL(p1.getEntry("test:int").min_int, -std::numeric_limits<Int>::max())
+	TEST_EQUAL(p1.hasTag("test2:int", "advanced"), false)
+	TEST_EQUAL(p2.hasTag("test2:int", "advanced"), true)
+	p1.remove("test2:");
+	TEST_EQUAL(p_src.exists("test2:int"), true)
+
+	// many lookups build the index, which has to be dropped on modification
+	Param p3(p_src);
+	for (Size i = 0; i < 100; ++i)
+	{
+		TEST_EQUAL(p3.exists("test:int"), true)
+		TEST_EQUAL(p3.exists("test:in"), false)
+		TEST_EQUAL(p3.exists("test"), false)
+	}
+	TEST_EQUAL(p3.getValue("test2:string"), "test2")
+	p3.remove("test:int");
+	p3.setValue("test:int2", 3);
+	TEST_EQUAL(p3.exists("test:int"), false)
+	TEST_EQUAL(Int(p3.getValue("test:int2")), 3)
+	TEST_EXCEPTION(Exception::ElementNotFound, p3.getValue("test:int"))
+	Param p4(p3); // the copy shares the index
+	for (Size i = 0; i < 100; ++i)
+	{
+		TEST_EQUAL(Int(p4.getValue("test:int2")), 3)
+	}
+	p3.clear();
+	TEST_EQUAL(Int(p4.getValue("test:int2")), 3)
+	TEST_EQUAL(p3.exists("test:int2"), false)
+}
+END_SECTION
+
 START_SECTION((Param& operator = (const Param& rhs)))
 	Param p2;
 	p2=p_src;
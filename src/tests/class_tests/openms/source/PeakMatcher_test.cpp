@@ -0,0 +1,154 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/COMPARISON/SPECTRA/PeakMatcher.h>
+///////////////////////////
+
+#include <OpenMS/KERNEL/MSSpectrum.h>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(PeakMatcher, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+PeakSpectrum spec;
+for (double mz : {100.0, 200.0, 300.0})
+{
+  spec.push_back(Peak1D(mz, mz / 100.0));
+}
+
+START_SECTION((static void getMZs(const PeakSpectrum& spectrum, std::vector<double>& mz)))
+{
+  vector<double> mz;
+  PeakMatcher::getMZs(spec, mz);
+  TEST_EQUAL(mz.size(), 3)
+  TEST_REAL_SIMILAR(mz[2], 300.0)
+}
+END_SECTION
+
+START_SECTION((static void getIntensities(const PeakSpectrum& spectrum, std::vector<double>& intensities)))
+{
+  vector<double> intensities;
+  PeakMatcher::getIntensities(spec, intensities);
+  TEST_EQUAL(intensities.size(), 3)
+  TEST_REAL_SIMILAR(intensities[1], 2.0)
+}
+END_SECTION
+
+START_SECTION((static void getToleranceWindows(const std::vector<double>& mz, double tolerance, bool tolerance_unit_ppm, std::vector<double>& lower, std::vector<double>& upper)))
+{
+  vector<double> mz = {100.0, 1000.0};
+  vector<double> lower, upper;
+  PeakMatcher::getToleranceWindows(mz, 0.5, false, lower, upper);
+  TEST_REAL_SIMILAR(lower[0], 99.5)
+  TEST_REAL_SIMILAR(upper[1], 1000.5)
+  PeakMatcher::getToleranceWindows(mz, 10.0, true, lower, upper);
+  TEST_REAL_SIMILAR(lower[0], 99.999)
+  TEST_REAL_SIMILAR(upper[1], 1000.01)
+}
+END_SECTION
+
+START_SECTION((static Size matchClosest(const std::vector<double>& ref_mz, const std::vector<double>& lower, const std::vector<double>& upper, const std::vector<double>& tgt_mz, std::vector<std::pair<Size, Size> >& matches)))
+{
+  vector<double> ref = {100.0, 200.0, 300.0, 400.0};
+  vector<double> tgt = {99.8, 100.1, 199.0, 300.2, 300.4};
+  vector<double> lower, upper;
+  PeakMatcher::getToleranceWindows(ref, 0.5, false, lower, upper);
+  vector<pair<Size, Size> > matches;
+  TEST_EQUAL(PeakMatcher::matchClosest(ref, lower, upper, tgt, matches), 2)
+  TEST_EQUAL(matches[0].first, 0)
+  TEST_EQUAL(matches[0].second, 1) // closest peak
+  TEST_EQUAL(matches[1].first, 2)
+  TEST_EQUAL(matches[1].second, 3)
+
+  // equal distance: the smaller m/z is preferred
+  matches.clear();
+  tgt = {99.75, 100.25};
+  TEST_EQUAL(PeakMatcher::matchClosest(ref, lower, upper, tgt, matches), 1)
+  TEST_EQUAL(matches[0].second, 0)
+
+  matches.clear();
+  TEST_EQUAL(PeakMatcher::matchClosest(ref, lower, upper, vector<double>(), matches), 0)
+}
+END_SECTION
+
+START_SECTION((static Size countMatchedReference(const std::vector<double>& lower, const std::vector<double>& upper, const std::vector<double>& tgt_mz)))
+{
+  vector<double> ref = {100.0, 100.3, 200.0};
+  vector<double> tgt = {100.1, 150.0};
+  vector<double> lower, upper;
+  PeakMatcher::getToleranceWindows(ref, 0.5, false, lower, upper);
+  // one target peak can match several reference peaks
+  TEST_EQUAL(PeakMatcher::countMatchedReference(lower, upper, tgt), 2)
+}
+END_SECTION
+
+START_SECTION((static double sumMatchedTarget(const std::vector<double>& ref_mz, const std::vector<double>& lower, const std::vector<double>& upper, const std::vector<double>& tgt_mz, const std::vector<double>& tgt_intensities, Size& matched, double& sum_error)))
+{
+  vector<double> ref = {100.0, 100.3, 200.0};
+  vector<double> tgt = {100.1, 100.2, 150.0, 200.4};
+  vector<double> intensities = {1.0, 2.0, 4.0, 8.0};
+  vector<double> lower, upper;
+  PeakMatcher::getToleranceWindows(ref, 0.5, false, lower, upper);
+  Size matched(0);
+  double sum_error(0.0);
+  // every target peak is counted once, even if it is in two windows
+  TEST_REAL_SIMILAR(PeakMatcher::sumMatchedTarget(ref, lower, upper, tgt, intensities, matched, sum_error), 11.0)
+  TEST_EQUAL(matched, 3)
+  TEST_REAL_SIMILAR(sum_error, 0.1 + 0.2 + 0.4)
+}
+END_SECTION
+
+START_SECTION((static Size countSharedBins(const std::vector<double>& mz1, const std::vector<double>& mz2, double bin_size)))
+{
+  vector<double> mz1 = {100.1, 100.2, 200.0, 300.0};
+  vector<double> mz2 = {100.3, 250.0, 300.0, 301.0};
+  // bins of size 1: 101, 200, 300 and 101, 250, 300, 301
+  TEST_EQUAL(PeakMatcher::countSharedBins(mz1, mz2, 1.0), 2)
+  TEST_EQUAL(PeakMatcher::countSharedBins(mz1, vector<double>(), 1.0), 0)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
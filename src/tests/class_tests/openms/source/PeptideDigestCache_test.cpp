@@ -0,0 +1,201 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/ANALYSIS/ID/PeptideDigestCache.h>
+///////////////////////////
+
+#include <OpenMS/CHEMISTRY/AASequence.h>
+
+#include <fstream>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(PeptideDigestCache, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+PeptideDigestCache* ptr = nullptr;
+PeptideDigestCache* null_ptr = nullptr;
+START_SECTION(PeptideDigestCache())
+{
+  ptr = new PeptideDigestCache();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->size(), 0)
+}
+END_SECTION
+
+START_SECTION(~PeptideDigestCache())
+{
+  delete ptr;
+}
+END_SECTION
+
+PeptideDigestCache::Settings settings;
+settings.enzyme = "Trypsin";
+settings.missed_cleavages = 0;
+settings.min_length = 3;
+settings.max_length = 0;
+settings.fixed_modifications = {};
+settings.variable_modifications = {"Oxidation (M)"};
+settings.max_variable_mods_per_peptide = 1;
+
+vector<FASTAFile::FASTAEntry> proteins(2);
+proteins[0].identifier = "P1";
+proteins[0].sequence = "PEPTIDEKSAMPLERAAAK";
+proteins[1].identifier = "P2";
+proteins[1].sequence = "SAMPLERK";
+
+START_SECTION((String Settings::toString() const))
+{
+  PeptideDigestCache::Settings other = settings;
+  TEST_EQUAL(other.toString() == settings.toString(), true)
+  other.missed_cleavages = 1;
+  TEST_EQUAL(other.toString() == settings.toString(), false)
+  other = settings;
+  other.database_tag = "decoys";
+  TEST_EQUAL(other.toString() == settings.toString(), false)
+}
+END_SECTION
+
+START_SECTION((static String getKey(const String& fasta_file, const Settings& settings)))
+{
+  String key = PeptideDigestCache::getKey(OPENMS_GET_TEST_DATA_PATH("FASTAFile_test.fasta"), settings);
+  TEST_EQUAL(key.size(), 40) // SHA-1
+  TEST_EQUAL(key, PeptideDigestCache::getKey(OPENMS_GET_TEST_DATA_PATH("FASTAFile_test.fasta"), settings))
+  PeptideDigestCache::Settings other = settings;
+  other.enzyme = "Lys-C";
+  TEST_NOT_EQUAL(key, PeptideDigestCache::getKey(OPENMS_GET_TEST_DATA_PATH("FASTAFile_test.fasta"), other))
+}
+END_SECTION
+
+START_SECTION((static String getFilename(const String& directory, const String& key)))
+{
+  TEST_EQUAL(PeptideDigestCache::getFilename("/tmp", "abc"), "/tmp/abc.digest")
+}
+END_SECTION
+
+String filename;
+NEW_TMP_FILE(filename)
+
+START_SECTION((static void build(const std::vector<FASTAFile::FASTAEntry>& proteins, const Settings& settings, const String& key, const String& filename)))
+{
+  PeptideDigestCache::build(proteins, settings, "key", filename);
+  NOT_TESTABLE // tested with load()
+}
+END_SECTION
+
+PeptideDigestCache cache;
+
+START_SECTION((bool load(const String& filename, const String& key)))
+{
+  TEST_EQUAL(cache.load(filename, "other_key"), false)
+  TEST_EQUAL(cache.size(), 0)
+  TEST_EQUAL(cache.load("this_file_does_not_exist.digest", "key"), false)
+
+  String bad_file;
+  NEW_TMP_FILE(bad_file)
+  ofstream(bad_file.c_str()) << "not a digest cache";
+  TEST_EXCEPTION(Exception::ParseError, cache.load(bad_file, "key"))
+
+  TEST_EQUAL(cache.load(filename, "key"), true)
+  // AAAK, SAMPLER, SAM(Oxidation)PLER, PEPTIDEK (SAMPLER of both proteins only once)
+  TEST_EQUAL(cache.size(), 4)
+}
+END_SECTION
+
+START_SECTION((Peptide getPeptide(Size index) const))
+{
+  ABORT_IF(cache.size() != 4)
+  TEST_EQUAL(cache.getPeptide(0).sequence.getString(), "AAAK")
+  TEST_EQUAL(cache.getPeptide(1).sequence.getString(), "SAMPLER")
+  TEST_EQUAL(cache.getPeptide(1).mod_index, 0)
+  TEST_EQUAL(cache.getPeptide(2).sequence.getString(), "SAM(Oxidation)PLER")
+  TEST_EQUAL(cache.getPeptide(2).unmodified_sequence.getString(), "SAMPLER")
+  TEST_EQUAL(cache.getPeptide(2).mod_index, 1)
+  TEST_EQUAL(cache.getPeptide(3).sequence.getString(), "PEPTIDEK")
+  TEST_REAL_SIMILAR(cache.getPeptide(3).mass, AASequence::fromString("PEPTIDEK").getMonoWeight())
+}
+END_SECTION
+
+START_SECTION((double getMass(Size index) const))
+{
+  for (Size i = 1; i < cache.size(); ++i)
+  {
+    TEST_EQUAL(cache.getMass(i - 1) <= cache.getMass(i), true)
+  }
+  TEST_REAL_SIMILAR(cache.getMass(1), AASequence::fromString("SAMPLER").getMonoWeight())
+}
+END_SECTION
+
+START_SECTION((Size lowerBound(double mass) const))
+{
+  TEST_EQUAL(cache.lowerBound(0.0), 0)
+  TEST_EQUAL(cache.lowerBound(cache.getMass(2)), 2)
+  TEST_EQUAL(cache.lowerBound(cache.getMass(2) + 0.001), 3)
+  TEST_EQUAL(cache.lowerBound(10000.0), 4)
+}
+END_SECTION
+
+START_SECTION((Size size() const))
+{
+  // mass range restriction
+  PeptideDigestCache::Settings restricted = settings;
+  restricted.min_mass = 500.0;
+  restricted.max_mass = 900.0;
+  String restricted_file;
+  NEW_TMP_FILE(restricted_file)
+  PeptideDigestCache::build(proteins, restricted, "key", restricted_file);
+  PeptideDigestCache restricted_cache;
+  TEST_EQUAL(restricted_cache.load(restricted_file, "key"), true)
+  TEST_EQUAL(restricted_cache.size(), 2)
+}
+END_SECTION
+
+START_SECTION((void clear()))
+{
+  cache.clear();
+  TEST_EQUAL(cache.size(), 0)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -338,6 +338,35 @@ START_SECTION(([EXTRA]virtual void run(const std::vector<Peak2D> & map_model, co
 }
 END_SECTION
 
+START_SECTION(([EXTRA] coarse-to-fine estimation))
+{
+  // 200 corresponding points (well separated in m/z), model RT = 1.01 * scene RT + 10
+  std::vector<Peak2D> map_model, map_scene;
+  for (Size i = 0; i < 200; ++i)
+  {
+    Peak2D p;
+    p.setMZ(300.0 + 3.7 * i);
+    p.setRT(100.0 + 15.0 * ((i * 37) % 200));
+    p.setIntensity(1000.0f + 10.0f * i);
+    map_scene.push_back(p);
+    p.setRT(1.01 * p.getRT() + 10.0);
+    map_model.push_back(p);
+  }
+
+  Param parameters;
+  parameters.setValue("coarse_to_fine:num_used_points", 50);
+  PoseClusteringAffineSuperimposer pcat;
+  pcat.setParameters(parameters);
+  TransformationDescription transformation;
+  pcat.run(map_model, map_scene, transformation);
+
+  TEST_STRING_EQUAL(transformation.getModelType(), "linear")
+  parameters = transformation.getModelParameters();
+  TEST_REAL_SIMILAR(parameters.getValue("slope"), 1.01)
+  TEST_REAL_SIMILAR(parameters.getValue("intercept"), 10.0)
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
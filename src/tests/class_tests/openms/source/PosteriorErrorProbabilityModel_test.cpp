@@ -37,11 +37,13 @@
 
 ///////////////////////////
 #include <OpenMS/MATH/STATISTICS/PosteriorErrorProbabilityModel.h>
+#include <OpenMS/CONCEPT/Constants.h>
 #include <OpenMS/FORMAT/IdXMLFile.h>
 #include <OpenMS/FORMAT/CsvFile.h>
 #include <OpenMS/DATASTRUCTURES/StringListUtils.h>
 #include <vector>
 #include <iostream>
+#include <random>
 ///////////////////////////
 
 using namespace OpenMS;
@@ -329,6 +331,46 @@ END_SECTION
         }
     END_SECTION
 
+START_SECTION([EXTRA] fit with binned scores (em_bins))
+{
+  // mixture of two Gaussians (Box-Muller on a fixed engine, so the data is the same everywhere)
+  std::mt19937 rng(42);
+  auto gauss = [&rng](double mean, double sd)
+  {
+    double u1 = (rng() + 1.0) / (double(rng.max()) + 2.0);
+    double u2 = (rng() + 1.0) / (double(rng.max()) + 2.0);
+    return mean + sd * sqrt(-2.0 * log(u1)) * cos(2.0 * Constants::PI * u2);
+  };
+  vector<double> scores;
+  for (Size i = 0; i < 7000; ++i) scores.push_back(gauss(2.0, 0.5));
+  for (Size i = 0; i < 3000; ++i) scores.push_back(gauss(5.0, 1.0));
+  vector<double> scores_binned = scores;
+
+  PosteriorErrorProbabilityModel exact;
+  Param param;
+  param.setValue("incorrectly_assigned", "Gauss");
+  exact.setParameters(param);
+  TEST_EQUAL(exact.fit(scores, "none"), true)
+
+  PosteriorErrorProbabilityModel binned;
+  param.setValue("em_bins", 100);
+  binned.setParameters(param);
+  TEST_EQUAL(binned.fit(scores_binned, "none"), true)
+
+  TOLERANCE_ABSOLUTE(0.01)
+  TEST_REAL_SIMILAR(binned.getCorrectlyAssignedFitResult().x0, exact.getCorrectlyAssignedFitResult().x0)
+  TEST_REAL_SIMILAR(binned.getCorrectlyAssignedFitResult().sigma, exact.getCorrectlyAssignedFitResult().sigma)
+  TEST_REAL_SIMILAR(binned.getIncorrectlyAssignedFitResult().x0, exact.getIncorrectlyAssignedFitResult().x0)
+  TEST_REAL_SIMILAR(binned.getIncorrectlyAssignedFitResult().sigma, exact.getIncorrectlyAssignedFitResult().sigma)
+  TEST_REAL_SIMILAR(binned.getNegativePrior(), exact.getNegativePrior())
+  for (double score : {1.5, 2.5, 3.0, 3.5, 4.0, 5.0})
+  {
+    TEST_REAL_SIMILAR(binned.computeProbability(score), exact.computeProbability(score))
+  }
+  TOLERANCE_ABSOLUTE(0.001)
+}
+END_SECTION
+
 START_SECTION((const String getBothGnuplotFormula(const GaussFitter::GaussFitResult& incorrect, const GaussFitter::GaussFitResult& correct) const))
 NOT_TESTABLE
 delete ptr;
@@ -195,6 +195,57 @@ START_SECTION((static void getPrecursors(const MSExperiment &exp, std::vector< P
 }
 END_SECTION
 
+START_SECTION((static std::vector<Size> getSurveyScanIndex(const MSExperiment &exp)))
+{
+  vector<Size> survey_scans = PrecursorCorrection::getSurveyScanIndex(exp);
+  TEST_EQUAL(survey_scans.size(), 6)
+  // MS1 spectra have no survey scan
+  TEST_EQUAL(survey_scans[0], 6)
+  TEST_EQUAL(survey_scans[2], 6)
+  TEST_EQUAL(survey_scans[4], 6)
+  TEST_EQUAL(survey_scans[1], 0)
+  TEST_EQUAL(survey_scans[3], 2)
+  TEST_EQUAL(survey_scans[5], 4)
+
+  // a referenced MS1 spectrum takes precedence over the closest one
+  MSExperiment ref_exp = exp;
+  ref_exp[5].getPrecursors()[0].setMetaValue("spectrum_ref", "scan=1");
+  survey_scans = PrecursorCorrection::getSurveyScanIndex(ref_exp);
+  TEST_EQUAL(survey_scans[5], 0)
+  // unknown references are ignored
+  ref_exp[5].getPrecursors()[0].setMetaValue("spectrum_ref", "scan=42");
+  survey_scans = PrecursorCorrection::getSurveyScanIndex(ref_exp);
+  TEST_EQUAL(survey_scans[5], 4)
+
+  // no preceding MS1 spectrum
+  MSExperiment ms2_first;
+  ms2_first.addSpectrum(exp[1]);
+  ms2_first.addSpectrum(exp[0]);
+  survey_scans = PrecursorCorrection::getSurveyScanIndex(ms2_first);
+  TEST_EQUAL(survey_scans[0], 2)
+  TEST_EQUAL(survey_scans[1], 2)
+}
+END_SECTION
+
+START_SECTION((static int findNearestMS1Peak(const MSSpectrum &survey_scan, double mz, double mz_tolerance, bool ppm)))
+{
+  TEST_EQUAL(PrecursorCorrection::findNearestMS1Peak(exp[0], 509.9999, 1.0, true), 1)
+  TEST_EQUAL(PrecursorCorrection::findNearestMS1Peak(exp[0], 509.9990, 1.0, true), 0)
+  TEST_EQUAL(PrecursorCorrection::findNearestMS1Peak(exp[0], 509.9800, 1.0, true), -1)
+  TEST_EQUAL(PrecursorCorrection::findNearestMS1Peak(exp[0], 509.9800, 0.1, false), 0)
+  TEST_EQUAL(PrecursorCorrection::findNearestMS1Peak(MSSpectrum(), 509.9999, 1.0, true), -1)
+}
+END_SECTION
+
+START_SECTION((static int findHighestIntensityMS1Peak(const MSSpectrum &survey_scan, double mz, double mz_tolerance, bool ppm)))
+{
+  TEST_EQUAL(PrecursorCorrection::findHighestIntensityMS1Peak(exp[0], 509.9999, 0.0005, false), 1)
+  TEST_EQUAL(PrecursorCorrection::findHighestIntensityMS1Peak(exp[2], 610.0001, 0.0005, false), 0)
+  TEST_EQUAL(PrecursorCorrection::findHighestIntensityMS1Peak(exp[2], 610.0005, 0.0001, false), 2)
+  TEST_EQUAL(PrecursorCorrection::findHighestIntensityMS1Peak(exp[2], 612.0, 0.0005, false), -1)
+}
+END_SECTION
+
 FuzzyStringComparator fsc;
 fsc.setAcceptableAbsolute(1e-8);
 
@@ -0,0 +1,153 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/ANALYSIS/ID/PrecursorMassIndex.h>
+///////////////////////////
+
+#include <map>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(PrecursorMassIndex, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+typedef PrecursorMassIndex<Size> Index;
+
+Index index;
+multimap<double, Size> reference;
+const double masses[] = {1200.5, 800.25, 1000.0, 1000.0, 950.0, 2000.75, 1000.0, 500.0};
+for (Size i = 0; i < 8; ++i)
+{
+  index.add(masses[i], i);
+  reference.insert(make_pair(masses[i], i));
+}
+
+START_SECTION((void add(double mass, const ValueType& value)))
+{
+  TEST_EQUAL(index.size(), 8)
+  TEST_EXCEPTION(Exception::Precondition, index.getRange(0.0, 1.0))
+}
+END_SECTION
+
+START_SECTION((void build()))
+{
+  index.build();
+  // same order as a std::multimap, also for equal masses
+  Size pos = 0;
+  for (const auto& r : reference)
+  {
+    TEST_REAL_SIMILAR(index.getMass(pos), r.first)
+    TEST_EQUAL(index.getValue(pos), r.second)
+    ++pos;
+  }
+}
+END_SECTION
+
+START_SECTION((Range getRange(double min_mass, double max_mass) const))
+{
+  Index::Range r = index.getRange(999.0, 1001.0);
+  TEST_EQUAL(r.first, 3)
+  TEST_EQUAL(r.second, 6)
+  r = index.getRange(1000.0, 1000.0);
+  TEST_EQUAL(r.second - r.first, 3)
+  r = index.getRange(3000.0, 4000.0);
+  TEST_EQUAL(r.first, r.second)
+  // same as the bounds of a std::multimap
+  for (double low = 400.0; low < 2100.0; low += 37.5)
+  {
+    r = index.getRange(low, low + 100.0);
+    TEST_EQUAL(r.first, (Size)distance(reference.begin(), reference.lower_bound(low)))
+    TEST_EQUAL(r.second, (Size)distance(reference.begin(), reference.upper_bound(low + 100.0)))
+  }
+}
+END_SECTION
+
+START_SECTION((bool hasMassInRange(double min_mass, double max_mass) const))
+{
+  TEST_EQUAL(index.hasMassInRange(940.0, 960.0), true)
+  TEST_EQUAL(index.hasMassInRange(960.0, 990.0), false)
+}
+END_SECTION
+
+START_SECTION((void getRanges(const std::vector<double>& min_masses, const std::vector<double>& max_masses, std::vector<Range>& ranges) const))
+{
+  // ascending and unordered queries give the same result as single queries
+  vector<double> min_masses = {450.0, 790.0, 990.0, 1500.0, 2000.0, 100.0, 1190.0};
+  vector<double> max_masses;
+  for (double m : min_masses) { max_masses.push_back(m + 20.0); }
+  vector<Index::Range> ranges;
+  index.getRanges(min_masses, max_masses, ranges);
+  TEST_EQUAL(ranges.size(), min_masses.size())
+  for (Size i = 0; i < ranges.size(); ++i)
+  {
+    TEST_EQUAL(ranges[i] == index.getRange(min_masses[i], max_masses[i]), true)
+  }
+  TEST_EXCEPTION(Exception::InvalidSize, index.getRanges(min_masses, vector<double>(), ranges))
+}
+END_SECTION
+
+START_SECTION(([PrecursorMassIndex::Cursor] Range getRange(double min_mass, double max_mass)))
+{
+  Index::Cursor cursor(index);
+  for (double low = 400.0; low < 2100.0; low += 12.5)
+  {
+    TEST_EQUAL(cursor.getRange(low, low + 60.0) == index.getRange(low, low + 60.0), true)
+  }
+  // going backwards
+  TEST_EQUAL(cursor.getRange(499.0, 501.0) == index.getRange(499.0, 501.0), true)
+  TEST_EQUAL(cursor.getRange(0.0, 10000.0).second, 8)
+}
+END_SECTION
+
+START_SECTION((void clear()))
+{
+  index.clear();
+  TEST_EQUAL(index.empty(), true)
+  Index::Range r = index.getRange(0.0, 10000.0);
+  TEST_EQUAL(r.first, r.second)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -0,0 +1,218 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/CONCEPT/Profiler.h>
+///////////////////////////
+
+#include <OpenMS/CONCEPT/ProgressLogger.h>
+#include <OpenMS/FORMAT/TextFile.h>
+#include <OpenMS/SYSTEM/StopWatch.h>
+
+#include <sstream>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(Profiler, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+START_SECTION((static bool isEnabled()))
+{
+  TEST_EQUAL(Profiler::isEnabled(), false)
+}
+END_SECTION
+
+START_SECTION((static void setEnabled(bool enabled)))
+{
+  { OPENMS_PROFILE_SCOPE("Profiler_test::disabled"); }
+  Profiler::addCounter("Profiler_test::disabled");
+  TEST_EQUAL(Profiler::getTimerCount("Profiler_test::disabled"), 0)
+  TEST_EQUAL(Profiler::getCounter("Profiler_test::disabled"), 0)
+
+  Profiler::setEnabled(true);
+  TEST_EQUAL(Profiler::isEnabled(), true)
+  { OPENMS_PROFILE_SCOPE("Profiler_test::enabled"); }
+  TEST_EQUAL(Profiler::getTimerCount("Profiler_test::enabled"), 1)
+  Profiler::setEnabled(false);
+  { OPENMS_PROFILE_SCOPE("Profiler_test::enabled"); }
+  TEST_EQUAL(Profiler::getTimerCount("Profiler_test::enabled"), 1)
+}
+END_SECTION
+
+START_SECTION((static void clear()))
+{
+  Profiler::clear();
+  TEST_EQUAL(Profiler::getTimerCount("Profiler_test::enabled"), 0)
+}
+END_SECTION
+
+START_SECTION((static Int64 now()))
+{
+  Int64 t1 = Profiler::now();
+  Int64 t2 = Profiler::now();
+  TEST_EQUAL(t1 <= t2, true)
+}
+END_SECTION
+
+START_SECTION((static void addEvent(const char* name, Int64 start, Int64 end)))
+{
+  Profiler::setEnabled(true);
+  Profiler::addEvent("Profiler_test::event", 0, 1000);
+  Profiler::addEvent("Profiler_test::event", 1000, 3000);
+  TEST_EQUAL(Profiler::getTimerCount("Profiler_test::event"), 2)
+  Profiler::setEnabled(false);
+  Profiler::clear();
+}
+END_SECTION
+
+START_SECTION((static void addStopWatch(const char* name, const StopWatch& sw)))
+{
+  Profiler::setEnabled(true);
+  StopWatch sw;
+  Profiler::addStopWatch("Profiler_test::stopwatch", sw);
+  TEST_EQUAL(Profiler::getTimerCount("Profiler_test::stopwatch"), 1)
+  Profiler::setEnabled(false);
+  Profiler::clear();
+}
+END_SECTION
+
+START_SECTION((static void addCounter(const char* name, Int64 value = 1)))
+{
+  Profiler::setEnabled(true);
+  // counters are summed over all threads
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (SignedSize i = 0; i < 1000; ++i)
+  {
+    Profiler::addCounter("Profiler_test::counter");
+    OPENMS_PROFILE_SCOPE("Profiler_test::loop");
+  }
+  Profiler::addCounter("Profiler_test::counter", 10);
+  TEST_EQUAL(Profiler::getCounter("Profiler_test::counter"), 1010)
+  TEST_EQUAL(Profiler::getTimerCount("Profiler_test::loop"), 1000)
+  TEST_EQUAL(Profiler::getCounter("Profiler_test::unknown"), 0)
+  Profiler::setEnabled(false);
+}
+END_SECTION
+
+START_SECTION((static void addSample(const char* name, double value)))
+{
+  Profiler::setEnabled(true);
+  Profiler::addSample("Profiler_test::histogram", 0.5);
+  Profiler::addSample("Profiler_test::histogram", 3.0);
+  Profiler::addSample("Profiler_test::histogram", -1.0);
+  Profiler::setEnabled(false);
+
+  stringstream ss;
+  Profiler::printSummary(ss);
+  String summary(ss.str());
+  TEST_EQUAL(summary.hasSubstring("Profiler_test::histogram"), true)
+  TEST_EQUAL(summary.hasSubstring("count: 3"), true)
+}
+END_SECTION
+
+START_SECTION((static const char* intern(const String& name)))
+{
+  String name("Profiler_test::");
+  name += "dynamic";
+  const char* interned = Profiler::intern(name);
+  TEST_STRING_EQUAL(interned, "Profiler_test::dynamic")
+  TEST_EQUAL(interned == Profiler::intern(String("Profiler_test::dynamic")), true)
+}
+END_SECTION
+
+START_SECTION((static Int64 getCounter(const String& name)))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((static Size getTimerCount(const String& name)))
+{
+  // progress regions are recorded as well
+  Profiler::setEnabled(true);
+  ProgressLogger pl;
+  pl.startProgress(0, 1, "Profiler_test progress");
+  pl.endProgress();
+  TEST_EQUAL(Profiler::getTimerCount("Profiler_test progress"), 1)
+  Profiler::setEnabled(false);
+}
+END_SECTION
+
+START_SECTION((static void storeChromeTrace(const String& filename)))
+{
+  String filename;
+  NEW_TMP_FILE(filename)
+  Profiler::storeChromeTrace(filename);
+  TextFile tf(filename);
+  String content;
+  for (TextFile::ConstIterator it = tf.begin(); it != tf.end(); ++it)
+  {
+    content += *it;
+  }
+  TEST_EQUAL(content.hasPrefix("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), true)
+  TEST_EQUAL(content.hasSubstring("\"name\":\"Profiler_test::loop\",\"cat\":\"OpenMS\",\"ph\":\"X\""), true)
+  TEST_EQUAL(content.hasSubstring("\"name\":\"Profiler_test::counter\",\"cat\":\"OpenMS\",\"ph\":\"C\""), true)
+  TEST_EQUAL(content.hasSubstring("\"Profiler_test::histogram\":{\"0\":{\"count\":3"), true)
+  TEST_EQUAL(content.hasSuffix("}}"), true)
+
+  TEST_EXCEPTION(Exception::UnableToCreateFile, Profiler::storeChromeTrace("/does/not/exist/trace.json"))
+}
+END_SECTION
+
+START_SECTION((static void printSummary(std::ostream& os)))
+{
+  stringstream ss;
+  Profiler::printSummary(ss);
+  String summary(ss.str());
+  TEST_EQUAL(summary.hasSubstring("Timers"), true)
+  TEST_EQUAL(summary.hasSubstring("Profiler_test::loop"), true)
+  TEST_EQUAL(summary.hasSubstring("Counters"), true)
+
+  Profiler::clear();
+  stringstream empty;
+  Profiler::printSummary(empty);
+  TEST_EQUAL(empty.str(), "")
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
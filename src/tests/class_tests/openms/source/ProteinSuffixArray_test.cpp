@@ -0,0 +1,223 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/ANALYSIS/ID/ProteinSuffixArray.h>
+///////////////////////////
+
+#include <algorithm>
+
+using namespace OpenMS;
+using namespace std;
+
+// sorted positions (protein, offset) for comparison
+vector<pair<Size, Size> > sortedHits(const vector<ProteinSuffixArray::Hit>& hits)
+{
+  vector<pair<Size, Size> > res;
+  for (const ProteinSuffixArray::Hit& h : hits)
+  {
+    res.emplace_back(h.protein_index, h.position);
+  }
+  sort(res.begin(), res.end());
+  return res;
+}
+
+START_TEST(ProteinSuffixArray, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+ProteinSuffixArray* ptr = nullptr;
+ProteinSuffixArray* null_ptr = nullptr;
+START_SECTION(ProteinSuffixArray())
+{
+  ptr = new ProteinSuffixArray();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->size(), 0)
+}
+END_SECTION
+
+START_SECTION(~ProteinSuffixArray())
+{
+  delete ptr;
+}
+END_SECTION
+
+ProteinSuffixArray index;
+index.addProtein("P1", "PEPTIDEKPEPTIDER");
+index.addProtein("P2", "");
+index.addProtein("P3", "AAPEPBIDEXK");
+
+START_SECTION((void addProtein(const String& accession, const String& sequence)))
+{
+  TEST_EQUAL(index.size(), 3)
+}
+END_SECTION
+
+START_SECTION((void build()))
+{
+  index.build();
+  TEST_EXCEPTION(Exception::IllegalArgument, index.addProtein("P4", "PEPTIDE"))
+}
+END_SECTION
+
+START_SECTION((String getAccession(Size index) const))
+{
+  TEST_EQUAL(index.getAccession(0), "P1")
+  TEST_EQUAL(index.getAccession(1), "")
+  TEST_EQUAL(index.getAccession(2), "P3")
+}
+END_SECTION
+
+START_SECTION((StringView getSequence(Size index) const))
+{
+  TEST_EQUAL(index.getSequence(0).getString(), "PEPTIDEKPEPTIDER")
+  TEST_EQUAL(index.getSequence(1).size(), 0)
+  TEST_EQUAL(index.getSequence(2).getString(), "AAPEPBIDEXK")
+}
+END_SECTION
+
+START_SECTION((void findAll(const String& peptide, Size aaa_max, Size mm_max, std::vector<Hit>& hits) const))
+{
+  vector<ProteinSuffixArray::Hit> hits;
+  // exact
+  index.findAll("PEPTIDE", 0, 0, hits);
+  vector<pair<Size, Size> > res = sortedHits(hits);
+  TEST_EQUAL(res.size(), 2)
+  TEST_EQUAL(res[0] == make_pair(Size(0), Size(0)), true)
+  TEST_EQUAL(res[1] == make_pair(Size(0), Size(8)), true)
+
+  // no match across protein boundaries
+  hits.clear();
+  index.findAll("PEPTIDERAA", 0, 0, hits);
+  TEST_EQUAL(hits.size(), 0)
+
+  // ambiguous amino acids in the protein: B covers D/N, X covers anything
+  hits.clear();
+  index.findAll("PEPDIDEAK", 2, 0, hits);
+  res = sortedHits(hits);
+  TEST_EQUAL(res.size(), 1)
+  TEST_EQUAL(res[0] == make_pair(Size(2), Size(2)), true)
+  hits.clear();
+  index.findAll("PEPDIDEAK", 1, 0, hits); // needs two AAA's
+  TEST_EQUAL(hits.size(), 0)
+
+  // mismatches
+  hits.clear();
+  index.findAll("PEPTIDEK", 0, 1, hits);
+  res = sortedHits(hits);
+  TEST_EQUAL(res.size(), 2) // exact + 'R' -> 'K'
+  TEST_EQUAL(res[0] == make_pair(Size(0), Size(0)), true)
+  TEST_EQUAL(res[1] == make_pair(Size(0), Size(8)), true)
+}
+END_SECTION
+
+START_SECTION((void findProteins(const std::vector<std::string>& tags, Size min_tags, std::vector<Size>& proteins) const))
+{
+  vector<Size> proteins;
+  index.findProteins({"PEP", "TIDE"}, 1, proteins);
+  TEST_EQUAL(proteins.size(), 2)
+  TEST_EQUAL(proteins[0], 0)
+  TEST_EQUAL(proteins[1], 2)
+
+  // P3 does not contain "TIDE"
+  index.findProteins({"PEP", "TIDE"}, 2, proteins);
+  TEST_EQUAL(proteins.size(), 1)
+  TEST_EQUAL(proteins[0], 0)
+
+  // duplicate tags count once, no match across protein boundaries
+  index.findProteins({"EXK", "EXK"}, 2, proteins);
+  TEST_EQUAL(proteins.size(), 0)
+  index.findProteins({"EXK", "DERA"}, 1, proteins);
+  TEST_EQUAL(proteins.size(), 1)
+  TEST_EQUAL(proteins[0], 2)
+  index.findProteins({}, 1, proteins);
+  TEST_EQUAL(proteins.size(), 0)
+}
+END_SECTION
+
+String filename;
+NEW_TMP_FILE(filename)
+
+START_SECTION((void store(const String& filename, const String& key) const))
+{
+  index.store(filename, "key");
+  ProteinSuffixArray unbuilt;
+  TEST_EXCEPTION(Exception::UnableToCreateFile, unbuilt.store(filename + ".2", "key"))
+}
+END_SECTION
+
+START_SECTION((bool load(const String& filename, const String& key)))
+{
+  ProteinSuffixArray loaded;
+  TEST_EQUAL(loaded.load(filename, "other_key"), false)
+  TEST_EQUAL(loaded.size(), 0)
+  TEST_EQUAL(loaded.load(filename + ".missing", "key"), false)
+  TEST_EQUAL(loaded.load(filename, "key"), true)
+  TEST_EQUAL(loaded.size(), 3)
+  TEST_EQUAL(loaded.getAccession(2), "P3")
+  TEST_EQUAL(loaded.getSequence(0).getString(), "PEPTIDEKPEPTIDER")
+  vector<ProteinSuffixArray::Hit> hits;
+  loaded.findAll("PEPTIDE", 0, 0, hits);
+  TEST_EQUAL(hits.size(), 2)
+}
+END_SECTION
+
+START_SECTION((void clear()))
+{
+  ProteinSuffixArray loaded;
+  loaded.load(filename, "key");
+  loaded.clear();
+  TEST_EQUAL(loaded.size(), 0)
+  loaded.addProtein("P1", "PEPTIDE");
+  loaded.build();
+  TEST_EQUAL(loaded.size(), 1)
+}
+END_SECTION
+
+START_SECTION((static String getKey(const String& fasta_file, const String& settings)))
+{
+  String key = ProteinSuffixArray::getKey(OPENMS_GET_TEST_DATA_PATH("FASTAFile_test.fasta"), "IL_equivalent=false");
+  TEST_EQUAL(key.size(), 40) // SHA-1
+  TEST_NOT_EQUAL(key, ProteinSuffixArray::getKey(OPENMS_GET_TEST_DATA_PATH("FASTAFile_test.fasta"), "IL_equivalent=true"))
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -105,6 +105,101 @@ START_TEST(SpectraMap, "$Id$")
   START_SECTION(QCBase::SpectraMap::size())
     NOT_TESTABLE;
   END_SECTION
+
+  MSExperiment exp_sum;
+  {
+    MSSpectrum ms1;
+    ms1.setMSLevel(1);
+    ms1.setRT(10);
+    ms1.push_back(Peak1D(100, 5));
+    ms1.push_back(Peak1D(200, 7));
+    MSSpectrum ms2;
+    ms2.setMSLevel(2);
+    ms2.setRT(11);
+    ms2.push_back(Peak1D(50, 3));
+    MSSpectrum ms1_empty;
+    ms1_empty.setMSLevel(1);
+    ms1_empty.setRT(12);
+    exp_sum.setSpectra({ms1, ms2, ms1_empty});
+  }
+
+  START_SECTION(QCBase::SpectraSummary::SpectraSummary(const MSExperiment& exp))
+    QCBase::SpectraSummary summary(exp_sum);
+    TEST_EQUAL(summary.size(), 3);
+  END_SECTION
+
+  START_SECTION(QCBase::SpectraSummary::calculate(const MSExperiment& exp))
+    QCBase::SpectraSummary summary;
+    summary.calculate(exp_sum);
+    summary.calculate(exp_sum); // replaces the old summary
+    ABORT_IF(summary.size() != 3);
+    const auto& e = summary.getEntries();
+    TEST_EQUAL(e[0].ms_level, 1);
+    TEST_REAL_SIMILAR(e[0].rt, 10);
+    TEST_REAL_SIMILAR(e[0].tic, 12);
+    TEST_REAL_SIMILAR(e[0].base_peak_intensity, 7);
+    TEST_EQUAL(e[1].ms_level, 2);
+    TEST_REAL_SIMILAR(e[1].tic, 3);
+    TEST_REAL_SIMILAR(e[2].tic, 0);
+    TEST_REAL_SIMILAR(e[2].base_peak_intensity, 0);
+  END_SECTION
+
+  START_SECTION(QCBase::SpectraSummary::addSpectrum(const MSSpectrum& spec))
+    QCBase::SpectraSummary summary;
+    for (const auto& spec : exp_sum)
+    {
+      summary.addSpectrum(spec);
+    }
+    QCBase::SpectraSummary summary_exp(exp_sum);
+    ABORT_IF(summary.size() != summary_exp.size());
+    for (Size i = 0; i < summary.size(); ++i)
+    {
+      TEST_EQUAL(summary.getEntries()[i].ms_level, summary_exp.getEntries()[i].ms_level);
+      TEST_REAL_SIMILAR(summary.getEntries()[i].tic, summary_exp.getEntries()[i].tic);
+    }
+  END_SECTION
+
+  START_SECTION(QCBase::SpectraSummary::getEntries() const)
+    NOT_TESTABLE; // tested above
+  END_SECTION
+
+  START_SECTION(QCBase::SpectraSummary::getNrSpectra(UInt ms_level) const)
+    QCBase::SpectraSummary summary(exp_sum);
+    TEST_EQUAL(summary.getNrSpectra(1), 2);
+    TEST_EQUAL(summary.getNrSpectra(2), 1);
+    TEST_EQUAL(summary.getNrSpectra(3), 0);
+  END_SECTION
+
+  START_SECTION(QCBase::SpectraSummary::getTIC(float rt_bin_size = 0) const)
+    QCBase::SpectraSummary summary(exp_sum);
+    MSChromatogram tic = summary.getTIC();
+    MSChromatogram tic_exp = exp_sum.getTIC();
+    ABORT_IF(tic.size() != tic_exp.size());
+    for (Size i = 0; i < tic.size(); ++i)
+    {
+      TEST_REAL_SIMILAR(tic[i].getRT(), tic_exp[i].getRT());
+      TEST_REAL_SIMILAR(tic[i].getIntensity(), tic_exp[i].getIntensity());
+    }
+    tic = summary.getTIC(1.0);
+    tic_exp = exp_sum.getTIC(1.0);
+    TEST_EQUAL(tic.size(), tic_exp.size());
+  END_SECTION
+
+  START_SECTION(QCBase::SpectraSummary::clear())
+    QCBase::SpectraSummary summary(exp_sum);
+    TEST_EQUAL(summary.empty(), false);
+    summary.clear();
+    TEST_EQUAL(summary.empty(), true);
+    TEST_EQUAL(summary.size(), 0);
+  END_SECTION
+
+  START_SECTION(QCBase::SpectraSummary::empty())
+    NOT_TESTABLE; // tested above
+  END_SECTION
+
+  START_SECTION(QCBase::SpectraSummary::size())
+    NOT_TESTABLE; // tested above
+  END_SECTION
   
 END_TEST
 
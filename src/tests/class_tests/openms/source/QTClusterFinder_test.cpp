@@ -255,6 +255,24 @@ START_SECTION((void run(const std::vector<FeatureMap >& input_maps, ConsensusMap
 	// "ind6" is closer, but its annotation doesn't match
 	STATUS(ind7);
   TEST_EQUAL(*(it) == ind7, true);
+
+  // partitions (m/z around 0 and 200) are clustered independently, but
+  // give the same groups
+  for (Size i = 0; i < input.size(); ++i) input[i].updateRanges();
+  param.setValue("nr_partitions", 10); // splits at every gap larger than the tolerance
+  finder.setParameters(param);
+  ConsensusMap partitioned;
+  finder.run(input, partitioned);
+  TEST_EQUAL(partitioned.size(), result.size());
+  Size found = 0;
+  for (Size i = 0; i < result.size(); ++i)
+  {
+    for (Size j = 0; j < partitioned.size(); ++j)
+    {
+      if (result[i].getFeatures() == partitioned[j].getFeatures()) ++found;
+    }
+  }
+  TEST_EQUAL(found, result.size());
 }
 END_SECTION
 
@@ -0,0 +1,188 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hendrik Weisser $
+// $Authors: Hendrik Weisser $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/METADATA/ID/QueryMatchTable.h>
+///////////////////////////
+
+#include <cmath>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(QueryMatchTable, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+IdentificationData data;
+IdentificationData::ScoreTypeRef score_ref =
+  data.registerScoreType(IdentificationData::ScoreType("score", true));
+IdentificationData::ScoreTypeRef other_ref =
+  data.registerScoreType(IdentificationData::ScoreType("other", true));
+IdentificationData::DataQueryRef query_ref1 =
+  data.registerDataQuery(IdentificationData::DataQuery("spectrum_1"));
+IdentificationData::DataQueryRef query_ref2 =
+  data.registerDataQuery(IdentificationData::DataQuery("spectrum_2"));
+IdentificationData::IdentifiedPeptideRef peptide_ref1 =
+  data.registerIdentifiedPeptide(IdentificationData::IdentifiedPeptide(AASequence::fromString("PEPTIDE")));
+IdentificationData::IdentifiedPeptideRef peptide_ref2 =
+  data.registerIdentifiedPeptide(IdentificationData::IdentifiedPeptide(AASequence::fromString("TEST")));
+
+IdentificationData::MoleculeQueryMatch match(peptide_ref1, query_ref1, 2);
+match.addScore(score_ref, 10.0);
+IdentificationData::QueryMatchRef match_ref11 = data.registerMoleculeQueryMatch(match);
+match = IdentificationData::MoleculeQueryMatch(peptide_ref2, query_ref1, 2);
+match.addScore(score_ref, 20.0);
+IdentificationData::QueryMatchRef match_ref12 = data.registerMoleculeQueryMatch(match);
+match = IdentificationData::MoleculeQueryMatch(peptide_ref1, query_ref2, 3);
+match.addScore(score_ref, 5.0);
+IdentificationData::QueryMatchRef match_ref21 = data.registerMoleculeQueryMatch(match);
+match = IdentificationData::MoleculeQueryMatch(peptide_ref2, query_ref2, 3);
+match.addScore(other_ref, 1.0); // no score of type "score"
+IdentificationData::QueryMatchRef match_ref22 = data.registerMoleculeQueryMatch(match);
+
+// row of a match in the table
+auto findRow = [](const QueryMatchTable& table, IdentificationData::QueryMatchRef ref)
+{
+  for (Size row = 0; row < table.size(); ++row)
+  {
+    if (table.getMatchRefs()[row] == ref) return row;
+  }
+  return table.size();
+};
+
+QueryMatchTable* ptr = nullptr;
+QueryMatchTable* null_ptr = nullptr;
+START_SECTION((explicit QueryMatchTable(const IdentificationData& id_data)))
+{
+  ptr = new QueryMatchTable(data);
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->size(), 4)
+  delete ptr;
+}
+END_SECTION
+
+QueryMatchTable table(data);
+
+START_SECTION((const std::vector<IdentificationData::QueryMatchRef>& getMatchRefs() const))
+{
+  TEST_EQUAL(table.getMatchRefs().size(), 4)
+  // same order as in the container:
+  Size row = 0;
+  for (auto it = data.getMoleculeQueryMatches().begin(); it != data.getMoleculeQueryMatches().end(); ++it, ++row)
+  {
+    TEST_EQUAL(table.getMatchRefs()[row] == it, true)
+  }
+}
+END_SECTION
+
+START_SECTION((const std::vector<Size>& getQueryIndices() const))
+{
+  TEST_EQUAL(table.getQueryIndices().size(), 4)
+  TEST_EQUAL(table.getQueries().size(), 2)
+  Size row11 = findRow(table, match_ref11), row12 = findRow(table, match_ref12);
+  Size row21 = findRow(table, match_ref21), row22 = findRow(table, match_ref22);
+  TEST_EQUAL(table.getQueryIndices()[row11], table.getQueryIndices()[row12])
+  TEST_EQUAL(table.getQueryIndices()[row21], table.getQueryIndices()[row22])
+  TEST_NOT_EQUAL(table.getQueryIndices()[row11], table.getQueryIndices()[row21])
+  TEST_EQUAL(table.getQueries()[table.getQueryIndices()[row11]] == query_ref1, true)
+}
+END_SECTION
+
+START_SECTION((const std::vector<IdentificationData::DataQueryRef>& getQueries() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((const std::vector<Size>& getMoleculeIndices() const))
+{
+  TEST_EQUAL(table.getMolecules().size(), 2)
+  Size row11 = findRow(table, match_ref11), row21 = findRow(table, match_ref21);
+  Size row12 = findRow(table, match_ref12);
+  TEST_EQUAL(table.getMoleculeIndices()[row11], table.getMoleculeIndices()[row21])
+  TEST_NOT_EQUAL(table.getMoleculeIndices()[row11], table.getMoleculeIndices()[row12])
+  IdentificationData::IdentifiedMoleculeRef molecule_ref = table.getMolecules()[table.getMoleculeIndices()[row11]];
+  TEST_EQUAL(boost::get<IdentificationData::IdentifiedPeptideRef>(molecule_ref) == peptide_ref1, true)
+}
+END_SECTION
+
+START_SECTION((const std::vector<IdentificationData::IdentifiedMoleculeRef>& getMolecules() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((const std::vector<double>& addScoreColumn(IdentificationData::ScoreTypeRef score_ref)))
+{
+  const vector<double>& scores = table.addScoreColumn(score_ref);
+  TEST_EQUAL(scores.size(), 4)
+  TEST_REAL_SIMILAR(scores[findRow(table, match_ref11)], 10.0)
+  TEST_REAL_SIMILAR(scores[findRow(table, match_ref12)], 20.0)
+  TEST_REAL_SIMILAR(scores[findRow(table, match_ref21)], 5.0)
+  TEST_EQUAL(std::isnan(scores[findRow(table, match_ref22)]), true)
+  // adding again returns the existing column:
+  TEST_EQUAL(&table.addScoreColumn(score_ref) == &scores, true)
+}
+END_SECTION
+
+START_SECTION((const std::vector<double>& getScoreColumn(IdentificationData::ScoreTypeRef score_ref) const))
+{
+  TEST_EQUAL(table.getScoreColumn(score_ref).size(), 4)
+  TEST_EXCEPTION(Exception::ElementNotFound, table.getScoreColumn(other_ref))
+}
+END_SECTION
+
+START_SECTION((std::vector<Size> getBestMatchPerQuery(IdentificationData::ScoreTypeRef score_ref) const))
+{
+  vector<Size> best = table.getBestMatchPerQuery(score_ref);
+  TEST_EQUAL(best.size(), 2)
+  vector<IdentificationData::QueryMatchRef> expected = data.getBestMatchPerQuery(score_ref);
+  TEST_EQUAL(expected.size(), 2)
+  for (Size i = 0; i < best.size(); ++i)
+  {
+    TEST_EQUAL(table.getMatchRefs()[best[i]] == expected[i], true)
+  }
+  TEST_EXCEPTION(Exception::ElementNotFound, table.getBestMatchPerQuery(other_ref))
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -67,6 +67,55 @@ START_SECTION((static RNPxlModificationMassesResult initModificationMassesRNA(St
 }
 END_SECTION
 
+StringList target_nucleotides = ListUtils::create<String>("A=C10H14N5O7P,C=C9H14N3O8P,G=C10H14N5O8P,U=C9H13N2O9P");
+StringList nt_groups = ListUtils::create<String>("AUGC");
+set<char> can_xl = {'U'};
+StringList mappings = ListUtils::create<String>("A->A,C->C,G->G,U->U");
+StringList modifications = ListUtils::create<String>("U:,U:-H2O");
+
+START_SECTION((static String getModificationMassesKey(const StringList& target_nucleotides, const StringList& nt_groups, const std::set<char>& can_xl, const StringList& mappings, const StringList& modifications, const String& sequence_restriction, bool cysteine_adduct, Int max_length)))
+{
+  String key = RNPxlModificationsGenerator::getModificationMassesKey(target_nucleotides, nt_groups, can_xl, mappings, modifications, "", false, 2);
+  TEST_EQUAL(key, RNPxlModificationsGenerator::getModificationMassesKey(target_nucleotides, nt_groups, can_xl, mappings, modifications, "", false, 2))
+  TEST_NOT_EQUAL(key, RNPxlModificationsGenerator::getModificationMassesKey(target_nucleotides, nt_groups, can_xl, mappings, modifications, "", false, 3))
+  TEST_NOT_EQUAL(key, RNPxlModificationsGenerator::getModificationMassesKey(target_nucleotides, nt_groups, can_xl, mappings, modifications, "", true, 2))
+}
+END_SECTION
+
+START_SECTION((static void storeModificationMasses(const String& filename, const String& key, const RNPxlModificationMassesResult& result)))
+{
+  NOT_TESTABLE // tested with loadModificationMasses()
+}
+END_SECTION
+
+START_SECTION((static bool loadModificationMasses(const String& filename, const String& key, RNPxlModificationMassesResult& result)))
+{
+  RNPxlModificationMassesResult mm = RNPxlModificationsGenerator::initModificationMassesRNA(target_nucleotides, nt_groups, can_xl, mappings, modifications, "", true, 2);
+  TEST_EQUAL(mm.mod_masses.empty(), false)
+  TEST_EQUAL(mm.mod_masses.size(), mm.mod_combinations.size())
+
+  String filename;
+  NEW_TMP_FILE(filename)
+  RNPxlModificationsGenerator::storeModificationMasses(filename, "key", mm);
+
+  RNPxlModificationMassesResult loaded;
+  TEST_EQUAL(RNPxlModificationsGenerator::loadModificationMasses(filename, "other key", loaded), false)
+  TEST_EQUAL(loaded.mod_masses.empty(), true)
+  TEST_EQUAL(RNPxlModificationsGenerator::loadModificationMasses(filename, "key", loaded), true)
+  TEST_EQUAL(loaded.mod_masses.size(), mm.mod_masses.size())
+  TEST_EQUAL(loaded.mod_combinations == mm.mod_combinations, true)
+  auto it = loaded.mod_masses.begin();
+  for (auto const & m : mm.mod_masses)
+  {
+    TEST_EQUAL(it->first, m.first)
+    TEST_REAL_SIMILAR(it->second, m.second)
+    ++it;
+  }
+
+  TEST_EQUAL(RNPxlModificationsGenerator::loadModificationMasses("this_file_does_not_exist", "key", loaded), false)
+}
+END_SECTION
+
 
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
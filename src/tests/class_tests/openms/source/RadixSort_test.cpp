@@ -0,0 +1,85 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/DATASTRUCTURES/RadixSort.h>
+///////////////////////////
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(RadixSort, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+START_SECTION((std::vector<Size> sortPermutation(const std::vector<double>& keys)))
+{
+  TEST_EQUAL(RadixSort::sortPermutation(vector<double>()).empty(), true)
+
+  vector<double> small = {3.0, -1.0, 2.0, -1.0, 0.0};
+  vector<Size> perm = RadixSort::sortPermutation(small);
+  vector<Size> expected = {1, 3, 4, 2, 0};
+  TEST_EQUAL(perm == expected, true)
+
+  // large input (radix sort), negative values, ties, -0.0, infinity
+  vector<double> keys;
+  for (Size i = 0; i < 10000; ++i)
+  {
+    keys.push_back(((Int)((i * 104729) % 3001) - 1500) * 0.37);
+  }
+  keys[10] = -0.0;
+  keys[20] = 0.0;
+  keys[30] = -0.0;
+  keys[40] = numeric_limits<double>::infinity();
+  keys[50] = -numeric_limits<double>::infinity();
+  perm = RadixSort::sortPermutation(keys);
+  expected.resize(keys.size());
+  iota(expected.begin(), expected.end(), 0);
+  stable_sort(expected.begin(), expected.end(), [&keys](Size a, Size b) { return keys[a] < keys[b]; });
+  TEST_EQUAL(perm == expected, true)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+END_TEST
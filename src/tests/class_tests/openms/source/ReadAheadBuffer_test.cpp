@@ -0,0 +1,197 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/FORMAT/ReadAheadBuffer.h>
+///////////////////////////
+
+#include <OpenMS/CONCEPT/Exception.h>
+
+#include <algorithm>
+#include <string>
+
+using namespace OpenMS;
+using namespace std;
+
+/// produces the bytes 0, 1, ..., 250, 0, 1, ... up to a total of @p total bytes, in pieces of at most @p piece bytes
+struct CountingProducer
+{
+  size_t total;
+  size_t piece;
+  size_t produced = 0;
+
+  size_t operator()(char* buffer, size_t size)
+  {
+    size_t n = std::min(std::min(size, piece), total - produced);
+    for (size_t i = 0; i < n; ++i)
+    {
+      buffer[i] = char((produced + i) % 251);
+    }
+    produced += n;
+    return n;
+  }
+};
+
+START_TEST(ReadAheadBuffer, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+ReadAheadBuffer* ptr = nullptr;
+ReadAheadBuffer* null_ptr = nullptr;
+START_SECTION((explicit ReadAheadBuffer(Size chunk_size = 1 << 20, Size num_chunks = 2)))
+{
+  ptr = new ReadAheadBuffer();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->getChunkSize(), 1 << 20)
+  TEST_EQUAL(ptr->isRunning(), false)
+  TEST_EQUAL(ptr->atEnd(), true)
+}
+END_SECTION
+
+START_SECTION((~ReadAheadBuffer()))
+{
+  delete ptr;
+
+  // destroying a buffer whose producer still has data must not block
+  ReadAheadBuffer buffer(16);
+  buffer.start(CountingProducer{1000000, 16});
+}
+END_SECTION
+
+START_SECTION((void start(Producer producer)))
+{
+  ReadAheadBuffer buffer(100, 3);
+  buffer.start(CountingProducer{1000, 37});
+  TEST_EQUAL(buffer.isRunning(), true)
+  char data[10];
+  TEST_EQUAL(buffer.read(data, 10), 10)
+  TEST_EQUAL(int(data[9]), 9)
+
+  // restarting discards the old data
+  buffer.start(CountingProducer{5, 5});
+  TEST_EQUAL(buffer.read(data, 10), 5)
+  TEST_EQUAL(int(data[0]), 0)
+  TEST_EQUAL(buffer.atEnd(), true)
+}
+END_SECTION
+
+START_SECTION((size_t read(char* s, size_t n)))
+{
+  // reads spanning several chunks and producer pieces return the data in order
+  const size_t total = 100000;
+  ReadAheadBuffer buffer(1000);
+  buffer.start(CountingProducer{total, 333});
+
+  string result;
+  char data[777];
+  size_t n;
+  while ((n = buffer.read(data, sizeof(data))) == sizeof(data))
+  {
+    result.append(data, n);
+  }
+  result.append(data, n);
+  TEST_EQUAL(result.size(), total)
+  bool in_order = true;
+  for (size_t i = 0; i < result.size(); ++i)
+  {
+    if (result[i] != char(i % 251)) in_order = false;
+  }
+  TEST_EQUAL(in_order, true)
+  TEST_EQUAL(buffer.read(data, sizeof(data)), 0)
+
+  // errors are reported after the data that was produced before them
+  size_t calls = 0;
+  buffer.start([&calls](char* s, size_t size) -> size_t
+  {
+    if (++calls > 2) throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "broken");
+    std::fill(s, s + size, 'x');
+    return size;
+  });
+  TEST_EQUAL(buffer.read(data, 500), 500)
+  TEST_EQUAL(buffer.read(data, 500), 500)
+  TEST_EQUAL(buffer.read(data, 500), 500)
+  TEST_EQUAL(buffer.read(data, 500), 500)
+  TEST_EXCEPTION(Exception::ConversionError, buffer.read(data, 1))
+  TEST_EQUAL(buffer.atEnd(), false)
+}
+END_SECTION
+
+START_SECTION((bool atEnd() const))
+{
+  ReadAheadBuffer buffer(10);
+  buffer.start(CountingProducer{20, 20});
+  char data[20];
+  TEST_EQUAL(buffer.read(data, 20), 20)
+  TEST_EQUAL(buffer.read(data, 20), 0)
+  TEST_EQUAL(buffer.atEnd(), true)
+}
+END_SECTION
+
+START_SECTION((bool isRunning() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((void stop()))
+{
+  ReadAheadBuffer buffer(10);
+  buffer.start(CountingProducer{1000, 10});
+  buffer.stop();
+  TEST_EQUAL(buffer.isRunning(), false)
+  char data[1];
+  TEST_EQUAL(buffer.read(data, 1), 0)
+}
+END_SECTION
+
+START_SECTION((void setChunkSize(Size chunk_size)))
+{
+  ReadAheadBuffer buffer;
+  buffer.setChunkSize(4096);
+  TEST_EQUAL(buffer.getChunkSize(), 4096)
+}
+END_SECTION
+
+START_SECTION((Size getChunkSize() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -98,20 +98,34 @@ START_SECTION(~RealMassDecomposer())
 }
 END_SECTION
 
+START_SECTION((RealMassDecomposer(const Weights &weights, const std::string &table_file)))
+{
+  String table_file;
+  NEW_TMP_FILE(table_file)
+  RealMassDecomposer computed(createWeights(), table_file); // computes and stores the table
+  RealMassDecomposer loaded(createWeights(), table_file);
+  RealMassDecomposer plain(createWeights());
+  TEST_EQUAL(loaded.getDecompositions(1000.0, 0.05) == plain.getDecompositions(1000.0, 0.05), true)
+  TEST_EQUAL(computed.getDecompositions(1000.0, 0.05) == plain.getDecompositions(1000.0, 0.05), true)
+  TEST_EQUAL(loaded.getNumberOfDecompositions(1000.0, 0.05), plain.getNumberOfDecompositions(1000.0, 0.05))
+  TEST_NOT_EQUAL(plain.getNumberOfDecompositions(1000.0, 0.05), 0)
+}
+END_SECTION
+
 
-START_SECTION((decompositions_type getDecompositions(double mass, double error)))
+START_SECTION((decompositions_type getDecompositions(double mass, double error) const))
 {
   // TODO
 }
 END_SECTION
 
-START_SECTION((decompositions_type getDecompositions(double mass, double error, const constraints_type &constraints)))
+START_SECTION((decompositions_type getDecompositions(double mass, double error, const constraints_type &constraints) const))
 {
   // TODO
 }
 END_SECTION
 
-START_SECTION((number_of_decompositions_type getNumberOfDecompositions(double mass, double error)))
+START_SECTION((number_of_decompositions_type getNumberOfDecompositions(double mass, double error) const))
 {
   // TODO
 }
@@ -40,6 +40,7 @@
 
 #include <OpenMS/CHEMISTRY/ResidueDB.h>
 #include <OpenMS/CHEMISTRY/Residue.h>
+#include <OpenMS/CHEMISTRY/ModificationsDB.h>
 
 using namespace OpenMS;
 using namespace std;
@@ -160,6 +161,62 @@ START_SECTION(Size getNumberOfModifiedResidues() const)
 	TEST_EQUAL(ptr->getNumberOfModifiedResidues(), 2)
 END_SECTION
 
+START_SECTION([EXTRA] multithreaded example)
+{
+  const Residue* ox_m = ptr->getModifiedResidue(ptr->getResidue("M"), "Oxidation");
+  TEST_EQUAL(ptr->hasResidue(ox_m), true)
+  Size nr_modified = ptr->getNumberOfModifiedResidues();
+
+  // known modified residues are found without locking, new ones are registered exactly once
+  int nr_iterations(1e4), test(0);
+#pragma omp parallel for reduction (+: test)
+  for (int k = 0; k < nr_iterations; ++k)
+  {
+    const Residue* m = ptr->getModifiedResidue(ptr->getResidue("M"), "Oxidation");
+    const Residue* d = ptr->getModifiedResidue(ptr->getResidue(k % 2 == 0 ? "N" : "Q"), "Deamidated");
+    if (m == ox_m && ptr->hasResidue(d) && d->getModificationName() == "Deamidated") ++test;
+  }
+  TEST_EQUAL(test, nr_iterations)
+  TEST_EQUAL(ptr->getNumberOfModifiedResidues(), nr_modified + 2)
+  TEST_EQUAL(ptr->getModifiedResidue(ptr->getResidue("N"), "Deamidated"), ptr->getModifiedResidue(ptr->getResidue("N"), "Deamidated (N)"))
+}
+END_SECTION
+
+START_SECTION([EXTRA] many modified residues)
+{
+  // registers several hundred entries, which are merged into new immutable indices along the way
+  std::vector<String> mod_names;
+  ModificationsDB::getInstance()->getAllSearchModifications(mod_names);
+  std::vector<const Residue*> first(mod_names.size(), nullptr);
+  Size registered(0);
+  for (Size i = 0; i < mod_names.size(); ++i)
+  {
+    try
+    {
+      first[i] = ptr->getModifiedResidue(mod_names[i]);
+      ++registered;
+    }
+    catch (Exception::BaseException&)
+    {
+      // e.g. terminal modifications without a residue of origin
+    }
+  }
+  TEST_EQUAL(registered > 100, true)
+
+  Size nr_modified = ptr->getNumberOfModifiedResidues();
+  int mismatches(0);
+#pragma omp parallel for reduction (+: mismatches)
+  for (int i = 0; i < static_cast<int>(mod_names.size()); ++i)
+  {
+    if (first[i] == nullptr) continue;
+    const Residue* again = ptr->getModifiedResidue(mod_names[i]);
+    if (again != first[i] || !ptr->hasResidue(again)) ++mismatches;
+  }
+  TEST_EQUAL(mismatches, 0)
+  TEST_EQUAL(ptr->getNumberOfModifiedResidues(), nr_modified)
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
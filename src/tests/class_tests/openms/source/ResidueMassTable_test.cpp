@@ -0,0 +1,163 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/CHEMISTRY/ResidueMassTable.h>
+///////////////////////////
+
+#include <OpenMS/ANALYSIS/RNPXL/ModifiedPeptideGenerator.h>
+#include <OpenMS/CHEMISTRY/AASequence.h>
+#include <OpenMS/CHEMISTRY/ResidueModification.h>
+
+#include <cmath>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(ResidueMassTable, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+const String sequences[] = {"PEPTIDEK", "C", "MCPEPTIDECM", "QSAMPLERC", "ACDEFGHIKLMNPQRSTVWY"};
+
+ResidueMassTable* ptr = nullptr;
+ResidueMassTable* null_ptr = nullptr;
+START_SECTION(ResidueMassTable())
+{
+  ptr = new ResidueMassTable();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_REAL_SIMILAR(ptr->getResidueMass('G'), AASequence::fromString("G").getMonoWeight(Residue::Internal))
+  TEST_EQUAL(std::isnan(ptr->getResidueMass('X')), true)
+  TEST_EQUAL(std::isnan(ptr->getResidueMass('1')), true)
+}
+END_SECTION
+
+START_SECTION(~ResidueMassTable())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(double getMonoWeight(const StringView& sequence) const)
+{
+  ResidueMassTable table;
+  for (const String& s : sequences)
+  {
+    TEST_REAL_SIMILAR(table.getMonoWeight(s), AASequence::fromString(s).getMonoWeight())
+  }
+  TEST_EXCEPTION(Exception::InvalidValue, table.getMonoWeight(String("PEPXIDE")))
+  TEST_EXCEPTION(Exception::InvalidValue, table.getMonoWeight(String()))
+}
+END_SECTION
+
+START_SECTION(ResidueMassTable(const std::vector<const ResidueModification*>& fixed_modifications))
+{
+  // residue and peptide terminal modifications
+  const StringList mod_names = ListUtils::create<String>("Carbamidomethyl (C),Acetyl (N-term),Amidated (C-term)");
+  ModifiedPeptideGenerator::MapToResidueType fixed_modifications = ModifiedPeptideGenerator::getModifications(mod_names);
+  vector<const ResidueModification*> fixed_mods;
+  for (const auto& m : fixed_modifications.val) { fixed_mods.push_back(m.first); }
+
+  ResidueMassTable table(fixed_mods);
+  for (const String& s : sequences)
+  {
+    AASequence aas = AASequence::fromString(s);
+    ModifiedPeptideGenerator::applyFixedModifications(fixed_modifications, aas);
+    TEST_REAL_SIMILAR(table.getMonoWeight(s), aas.getMonoWeight())
+  }
+}
+END_SECTION
+
+START_SECTION(void getPrefixMonoWeights(const StringView& sequence, std::vector<double>& masses) const)
+{
+  ModifiedPeptideGenerator::MapToResidueType fixed_modifications = ModifiedPeptideGenerator::getModifications(ListUtils::create<String>("Carbamidomethyl (C)"));
+  vector<const ResidueModification*> fixed_mods;
+  for (const auto& m : fixed_modifications.val) { fixed_mods.push_back(m.first); }
+  ResidueMassTable table(fixed_mods);
+
+  const String s = "MCPEPTIDECM";
+  vector<double> masses(100, 0.0);
+  table.getPrefixMonoWeights(s, masses);
+  TEST_EQUAL(masses.size(), s.size())
+  for (Size i = 0; i != s.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(masses[i], table.getMonoWeight(s.prefix(i + 1)))
+  }
+
+  table.getPrefixMonoWeights(String("PEXP"), masses);
+  TEST_EQUAL(masses.size(), 4)
+  TEST_REAL_SIMILAR(masses[1], table.getMonoWeight(String("PE")))
+  TEST_EQUAL(std::isnan(masses[2]), true)
+  TEST_EQUAL(std::isnan(masses[3]), true)
+}
+END_SECTION
+
+START_SECTION(void getVariableModificationShiftRange(const std::vector<const ResidueModification*>& variable_modifications, Size max_mods, double& min_shift, double& max_shift) const)
+{
+  ResidueMassTable table;
+  ModifiedPeptideGenerator::MapToResidueType variable_modifications = ModifiedPeptideGenerator::getModifications(ListUtils::create<String>("Oxidation (M),Amidated (C-term)"));
+  vector<const ResidueModification*> variable_mods;
+  for (const auto& m : variable_modifications.val) { variable_mods.push_back(m.first); }
+
+  double min_shift(1.0), max_shift(-1.0);
+  table.getVariableModificationShiftRange(vector<const ResidueModification*>(), 2, min_shift, max_shift);
+  TEST_REAL_SIMILAR(min_shift, 0.0)
+  TEST_REAL_SIMILAR(max_shift, 0.0)
+
+  table.getVariableModificationShiftRange(variable_mods, 2, min_shift, max_shift);
+  TEST_REAL_SIMILAR(min_shift, 2 * -0.984016)
+  TEST_REAL_SIMILAR(max_shift, 2 * 15.994915)
+
+  // all variants generated by ModifiedPeptideGenerator are within the range
+  const String s = "MPEPTMIDEM";
+  const double mass = table.getMonoWeight(s);
+  vector<AASequence> all_modified_peptides;
+  ModifiedPeptideGenerator::applyVariableModifications(variable_modifications, AASequence::fromString(s), 2, all_modified_peptides);
+  TEST_EQUAL(all_modified_peptides.size() > 1, true)
+  for (const AASequence& aas : all_modified_peptides)
+  {
+    TEST_EQUAL(aas.getMonoWeight() >= mass + min_shift - 1e-6, true)
+    TEST_EQUAL(aas.getMonoWeight() <= mass + max_shift + 1e-6, true)
+  }
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
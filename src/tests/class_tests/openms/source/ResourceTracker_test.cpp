@@ -0,0 +1,230 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/SYSTEM/ResourceTracker.h>
+///////////////////////////
+
+#include <OpenMS/SYSTEM/File.h>
+
+#include <sstream>
+
+using namespace OpenMS;
+using namespace std;
+
+// burns some CPU time
+double work()
+{
+  double sum = 0.0;
+  for (Size i = 1; i < 20000000; ++i) sum += 1.0 / double(i);
+  return sum;
+}
+
+START_TEST(ResourceTracker, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+ResourceTracker* ptr = nullptr;
+ResourceTracker* null_ptr = nullptr;
+START_SECTION(ResourceTracker())
+{
+  ptr = new ResourceTracker();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->isRunning(), false)
+  TEST_EQUAL(ptr->getStages().size(), 0)
+}
+END_SECTION
+
+START_SECTION(~ResourceTracker())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((void start()))
+{
+  ResourceTracker rt;
+  rt.start();
+  TEST_EQUAL(rt.isRunning(), true)
+  rt.checkpoint("a");
+  rt.start(); // forgets stages
+  TEST_EQUAL(rt.getStages().size(), 0)
+}
+END_SECTION
+
+START_SECTION((void checkpoint(const String& name)))
+{
+  ResourceTracker rt;
+  rt.checkpoint("ignored"); // not running
+  TEST_EQUAL(rt.getStages().size(), 0)
+  rt.start();
+  TEST_NOT_EQUAL(work(), 0.0)
+  rt.checkpoint("first");
+  TEST_NOT_EQUAL(work(), 0.0)
+  rt.checkpoint("second");
+  rt.stop();
+  TEST_EQUAL(rt.getStages().size(), 2)
+  TEST_EQUAL(rt.getStages()[0].name, "first")
+  TEST_EQUAL(rt.getStages()[1].name, "second")
+  TEST_EQUAL(rt.getStages()[0].wall_time > 0.0, true)
+  TEST_EQUAL(rt.getStages()[1].cpu_time >= 0.0, true)
+  // stages are disjoint parts of the total time
+  TEST_EQUAL(rt.getStages()[0].wall_time + rt.getStages()[1].wall_time <= rt.getWallTime() + 1e-6, true)
+}
+END_SECTION
+
+START_SECTION((void stop()))
+{
+  ResourceTracker rt;
+  rt.start();
+  TEST_NOT_EQUAL(work(), 0.0)
+  rt.stop();
+  TEST_EQUAL(rt.isRunning(), false)
+  const double wall_time = rt.getWallTime();
+  TEST_NOT_EQUAL(work(), 0.0)
+  TEST_REAL_SIMILAR(rt.getWallTime(), wall_time) // no longer counting
+}
+END_SECTION
+
+START_SECTION((bool isRunning() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((double getWallTime() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((double getCPUTime() const))
+{
+  ResourceTracker rt;
+  rt.start();
+  TEST_NOT_EQUAL(work(), 0.0)
+  rt.stop();
+  TEST_EQUAL(rt.getCPUTime() > 0.0, true)
+  TEST_REAL_SIMILAR(rt.getCPUTime(), rt.getUserTime() + rt.getSystemTime())
+}
+END_SECTION
+
+START_SECTION((double getUserTime() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((double getSystemTime() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((size_t getPeakMemory() const))
+{
+  NOT_TESTABLE // depends on the OS
+}
+END_SECTION
+
+START_SECTION((double getThreadUtilization(Size threads) const))
+{
+  ResourceTracker rt;
+  TEST_EQUAL(rt.getThreadUtilization(1), 0.0)
+  rt.start();
+  TEST_NOT_EQUAL(work(), 0.0)
+  rt.stop();
+  TEST_EQUAL(rt.getThreadUtilization(0), 0.0)
+  // a single busy thread: using 1 of 2 threads is half the utilization of using 1 of 1
+  TEST_REAL_SIMILAR(rt.getThreadUtilization(2), rt.getThreadUtilization(1) / 2)
+}
+END_SECTION
+
+START_SECTION((const std::vector<Stage>& getStages() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((void writeJSON(std::ostream& os, const String& tool, Size threads, Int exit_code) const))
+{
+  ResourceTracker rt;
+  rt.start();
+  rt.checkpoint("loading \"data\"");
+  rt.stop();
+  stringstream ss;
+  rt.writeJSON(ss, "MyTool", 4, 0);
+  String json(ss.str());
+  TEST_EQUAL(json.hasSubstring("\"tool\": \"MyTool\""), true)
+  TEST_EQUAL(json.hasSubstring("\"threads\": 4"), true)
+  TEST_EQUAL(json.hasSubstring("\"exit_code\": 0"), true)
+  TEST_EQUAL(json.hasSubstring("\"peak_memory_kb\""), true)
+  TEST_EQUAL(json.hasSubstring("\"thread_utilization\""), true)
+  TEST_EQUAL(json.hasSubstring("{\"name\": \"loading \\\"data\\\"\""), true)
+}
+END_SECTION
+
+START_SECTION((void storeJSON(const String& filename, const String& tool, Size threads, Int exit_code) const))
+{
+  ResourceTracker rt;
+  rt.start();
+  rt.stop();
+  String filename;
+  NEW_TMP_FILE(filename)
+  rt.storeJSON(filename, "MyTool", 1, 0);
+  TEST_EQUAL(File::exists(filename), true)
+  TEST_EXCEPTION(Exception::UnableToCreateFile, rt.storeJSON("/this/dir/does/not/exist/report.json", "MyTool", 1, 0))
+}
+END_SECTION
+
+START_SECTION((static size_t loadPeakMemory(const String& filename)))
+{
+  ResourceTracker rt;
+  rt.start();
+  rt.checkpoint("stage");
+  rt.stop();
+  String filename;
+  NEW_TMP_FILE(filename)
+  rt.storeJSON(filename, "MyTool", 1, 0);
+  TEST_EQUAL(ResourceTracker::loadPeakMemory(filename), rt.getPeakMemory())
+  TEST_EQUAL(ResourceTracker::loadPeakMemory("/this/file/does/not/exist.json"), 0)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
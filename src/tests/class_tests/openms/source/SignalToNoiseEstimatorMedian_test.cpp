@@ -36,6 +36,9 @@
 #include <OpenMS/test_config.h>
 #include <OpenMS/FORMAT/DTAFile.h>
 
+#include <algorithm>
+#include <random>
+
 ///////////////////////////
 #include <OpenMS/FILTERING/NOISEESTIMATION/SignalToNoiseEstimatorMedian.h>
 ///////////////////////////
@@ -115,6 +118,60 @@ START_SECTION([EXTRA](virtual void init(const PeakIterator& it_begin, const Peak
 END_SECTION
 
 
+START_SECTION([EXTRA] incremental median matches a full histogram scan)
+{
+  // unevenly spaced data, so the window grows and shrinks
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> step(0.01, 2.0);
+  std::uniform_real_distribution<double> intensity(0.0, 1200.0);
+  MSSpectrum raw_data;
+  double mz = 100.0;
+  for (Size i = 0; i < 2000; ++i)
+  {
+    mz += (i % 200 < 100) ? step(rng) : 10 * step(rng);
+    Peak1D p;
+    p.setMZ(mz);
+    p.setIntensity(intensity(rng));
+    raw_data.push_back(p);
+  }
+
+  const double win_len = 20.0;
+  const double max_intensity = 1000.0;
+  const int bin_count = 100;
+  const int min_required = 5;
+  SignalToNoiseEstimatorMedian< MSSpectrum > sne;
+  Param p;
+  p.setValue("win_len", win_len);
+  p.setValue("bin_count", bin_count);
+  p.setValue("auto_mode", -1);
+  p.setValue("max_intensity", max_intensity);
+  p.setValue("min_required_elements", min_required);
+  p.setValue("noise_for_empty_window", 2.0);
+  sne.setParameters(p);
+  sne.init(raw_data);
+
+  const double bin_size = max_intensity / bin_count;
+  for (MSSpectrum::const_iterator it = raw_data.begin(); it != raw_data.end(); ++it)
+  {
+    std::vector<int> bins;
+    for (MSSpectrum::const_iterator w = raw_data.begin(); w != raw_data.end(); ++w)
+    {
+      if (w->getMZ() >= it->getMZ() - win_len / 2 && w->getMZ() <= it->getMZ() + win_len / 2)
+      {
+        bins.push_back(std::max(std::min<int>((int)(w->getIntensity() / bin_size), bin_count - 1), 0));
+      }
+    }
+    double noise = 2.0;
+    if ((int)bins.size() >= min_required)
+    {
+      std::sort(bins.begin(), bins.end());
+      noise = std::max(1.0, (bins[(bins.size() + 1) / 2 - 1] + 0.5) * bin_size);
+    }
+    TEST_REAL_SIMILAR(sne.getSignalToNoise(it), it->getIntensity() / noise)
+  }
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -114,6 +114,32 @@ START_SECTION((template < typename MapType > void mergeSpectraBlockWise(MapType
 
 END_SECTION
 
+START_SECTION((template <typename MapType> typename MapType::SpectrumType mergeBlock(const MapType& block, const UInt ms_level) const))
+{
+  PeakMap exp;
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("SpectraMerger_input_2.mzML"), exp);
+
+  SpectraMerger merger;
+  Param p;
+  p.setValue("mz_binning_width", 0.0001);
+  p.setValue("mz_binning_width_unit", "Da");
+  merger.setParameters(p);
+
+  PeakMap block;
+  for (Size i = 0; i < 3; ++i)
+  {
+    block.addSpectrum(exp[i]);
+  }
+  MSSpectrum merged = merger.mergeBlock(block, 1);
+  TEST_REAL_SIMILAR(merged.getRT(), (exp[0].getRT() + exp[1].getRT() + exp[2].getRT()) / 3)
+  TEST_EQUAL(merged.getMSLevel(), 1)
+  TEST_EQUAL(merged.size() >= exp[0].size(), true)
+  TEST_EQUAL(merged.size() <= exp[0].size() + exp[1].size() + exp[2].size(), true)
+
+  TEST_EQUAL(merger.mergeBlock(PeakMap(), 1).empty(), true)
+}
+END_SECTION
+
 START_SECTION((template < typename MapType > void mergeSpectraPrecursors(MapType &exp)))
 	PeakMap exp;
 	MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("SpectraMerger_input_precursor.mzML"), exp);
@@ -0,0 +1,164 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/COMPARISON/SPECTRA/SpectralLibraryIndex.h>
+///////////////////////////
+
+#include <OpenMS/COMPARISON/SPECTRA/SpectraSTSimilarityScore.h>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(SpectralLibraryIndex, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+// library: precursors 500, 400, (none), 400, 600
+vector<MSSpectrum> library(5);
+double lib_mz[] = {500.0, 400.0, 0.0, 400.0, 600.0};
+for (Size i = 0; i < library.size(); ++i)
+{
+  if (i != 2)
+  {
+    Precursor prec;
+    prec.setMZ(lib_mz[i]);
+    library[i].getPrecursors().push_back(prec);
+  }
+  for (Size k = 1; k <= 5; ++k)
+  {
+    Peak1D p;
+    p.setMZ(100.0 * k + 10.0 * i);
+    p.setIntensity(k + i);
+    library[i].push_back(p);
+  }
+}
+
+SpectralLibraryIndex* ptr = nullptr;
+SpectralLibraryIndex* null_ptr = nullptr;
+START_SECTION(SpectralLibraryIndex())
+{
+  ptr = new SpectralLibraryIndex();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+}
+END_SECTION
+
+START_SECTION(~SpectralLibraryIndex())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((explicit SpectralLibraryIndex(const std::vector<MSSpectrum>& library, bool bin_spectra = false)))
+{
+  SpectralLibraryIndex index(library);
+  TEST_EQUAL(index.size(), 4) // spectrum without precursor is skipped
+  TEST_EQUAL(index.hasBinnedSpectra(), false)
+}
+END_SECTION
+
+START_SECTION((Size size() const))
+{
+  TEST_EQUAL(SpectralLibraryIndex().size(), 0)
+  TEST_EQUAL(SpectralLibraryIndex(library).size(), 4)
+}
+END_SECTION
+
+START_SECTION((bool empty() const))
+{
+  TEST_EQUAL(SpectralLibraryIndex().empty(), true)
+  TEST_EQUAL(SpectralLibraryIndex(library).empty(), false)
+}
+END_SECTION
+
+START_SECTION((std::pair<ConstIterator, ConstIterator> findByPrecursorMZ(double mz_low, double mz_high) const))
+{
+  SpectralLibraryIndex index(library);
+
+  // equal precursors keep library order
+  std::pair<SpectralLibraryIndex::ConstIterator, SpectralLibraryIndex::ConstIterator> r = index.findByPrecursorMZ(399.0, 401.0);
+  TEST_EQUAL(r.second - r.first, 2)
+  TEST_EQUAL(r.first->second, 1)
+  TEST_EQUAL((r.first + 1)->second, 3)
+
+  // closed interval
+  r = index.findByPrecursorMZ(400.0, 500.0);
+  TEST_EQUAL(r.second - r.first, 3)
+  TEST_EQUAL((r.second - 1)->second, 0)
+
+  r = index.findByPrecursorMZ(500.5, 599.5);
+  TEST_EQUAL(r.first == r.second, true)
+
+  r = index.findByPrecursorMZ(0.0, 1000.0);
+  TEST_EQUAL(r.second - r.first, 4)
+  for (SpectralLibraryIndex::ConstIterator it = r.first; it != r.second; ++it)
+  {
+    TEST_NOT_EQUAL(it->second, 2)
+  }
+}
+END_SECTION
+
+START_SECTION((bool hasBinnedSpectra() const))
+{
+  TEST_EQUAL(SpectralLibraryIndex(library).hasBinnedSpectra(), false)
+  TEST_EQUAL(SpectralLibraryIndex(library, true).hasBinnedSpectra(), true)
+}
+END_SECTION
+
+START_SECTION((const BinnedSpectrum& getBinnedSpectrum(Size position) const))
+{
+  TEST_EXCEPTION(Exception::Precondition, SpectralLibraryIndex(library).getBinnedSpectrum(0))
+
+  SpectralLibraryIndex index(library, true);
+  TEST_EXCEPTION(Exception::IndexOverflow, index.getBinnedSpectrum(library.size()))
+
+  // same representation as SpectraSTSimilarityScore uses
+  SpectraSTSimilarityScore spectrast;
+  for (Size i = 0; i < library.size(); ++i)
+  {
+    BinnedSpectrum expected = spectrast.transform(library[i]);
+    const BinnedSpectrum& binned = index.getBinnedSpectrum(i);
+    TEST_REAL_SIMILAR(spectrast(binned, expected), 1.0)
+    TEST_REAL_SIMILAR(spectrast(binned, spectrast.transform(library[1])), spectrast(library[i], library[1]))
+  }
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -0,0 +1,196 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessIonMobilityIndexed.h>
+///////////////////////////
+
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SimpleOpenMSSpectraAccessFactory.h>
+
+using namespace OpenMS;
+using namespace std;
+
+OpenSwath::SpectrumPtr getIMFrame()
+{
+  // 10 peaks sorted by m/z, ion mobility is not sorted
+  OpenSwath::SpectrumPtr frame(new OpenSwath::Spectrum);
+  OpenSwath::BinaryDataArrayPtr im_arr(new OpenSwath::BinaryDataArray);
+  im_arr->description = "Ion Mobility";
+  for (int k = 0; k < 10; k++)
+  {
+    frame->getMZArray()->data.push_back(500.0 + k);
+    frame->getIntensityArray()->data.push_back(k + 1);
+    im_arr->data.push_back(0.6 + (k * 3 % 10) * 0.1);
+  }
+  frame->getDataArrays().push_back(im_arr);
+  return frame;
+}
+
+START_TEST(SpectrumAccessIonMobilityIndexed, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+START_SECTION((FrameIndex(const OpenSwath::Spectrum& frame, Size nr_buckets)))
+{
+  SpectrumAccessIonMobilityIndexed::FrameIndex index(*getIMFrame(), 5);
+  TEST_EQUAL(index.size(), 10)
+  TEST_EQUAL(index.getNrBuckets(), 5)
+
+  OpenSwath::Spectrum no_im;
+  TEST_EXCEPTION(Exception::IllegalArgument, SpectrumAccessIonMobilityIndexed::FrameIndex(no_im, 5))
+}
+END_SECTION
+
+START_SECTION((double integrate(double left, double right, double left_im, double right_im) const))
+{
+  OpenSwath::SpectrumPtr frame = getIMFrame();
+  for (Size nr_buckets : {1, 3, 5, 100})
+  {
+    SpectrumAccessIonMobilityIndexed::FrameIndex index(*frame, nr_buckets);
+    for (double im_lower : {0.0, 0.65, 0.85, 1.25})
+    {
+      // compare to a linear scan
+      double mz_lower = 501.5, mz_upper = 507.5, im_upper = im_lower + 0.35;
+      double expected = 0;
+      for (Size k = 0; k < frame->getMZArray()->data.size(); k++)
+      {
+        double mz = frame->getMZArray()->data[k], im = frame->getDriftTimeArray()->data[k];
+        if (mz > mz_lower && mz < mz_upper && im > im_lower && im < im_upper) expected += frame->getIntensityArray()->data[k];
+      }
+      TEST_REAL_SIMILAR(index.integrate(mz_lower, mz_upper, im_lower, im_upper), expected)
+    }
+    TEST_REAL_SIMILAR(index.integrate(400, 600, 0.0, 2.0), 55)
+    TEST_REAL_SIMILAR(index.integrate(400, 600, 2.0, 3.0), 0)
+    TEST_REAL_SIMILAR(index.integrate(600, 700, 0.0, 2.0), 0)
+  }
+}
+END_SECTION
+
+START_SECTION((template <typename FunctorType> void forEachPeak(double left, double right, double left_im, double right_im, FunctorType f) const))
+{
+  SpectrumAccessIonMobilityIndexed::FrameIndex index(*getIMFrame(), 10);
+  // peaks are visited by ion mobility bucket and in m/z order within each bucket
+  std::vector<double> mz, im;
+  index.forEachPeak(500, 509, 0.0, 2.0, [&](double m, double i, double) { mz.push_back(m); im.push_back(i); });
+  TEST_EQUAL(mz.size(), 10)
+  for (Size k = 1; k < im.size(); k++)
+  {
+    TEST_EQUAL(im[k - 1] <= im[k] + 1e-10, true)
+  }
+
+  mz.clear();
+  index.forEachPeak(500, 509, 0.55, 0.65, [&](double m, double, double) { mz.push_back(m); });
+  TEST_EQUAL(mz.empty(), false)
+  TEST_REAL_SIMILAR(mz[0], 500.0)
+}
+END_SECTION
+
+SpectrumAccessIonMobilityIndexed* ptr = nullptr;
+SpectrumAccessIonMobilityIndexed* nullPointer = nullptr;
+
+boost::shared_ptr<PeakMap> exp(new PeakMap);
+{
+  for (int i = 0; i < 3; i++)
+  {
+    MSSpectrum s;
+    s.setRT(i);
+    s.push_back(Peak1D(400.0, 10.0));
+    s.push_back(Peak1D(500.0, 20.0));
+    if (i != 1)
+    {
+      OpenMS::DataArrays::FloatDataArray fda;
+      fda.push_back(0.8);
+      fda.push_back(1.2);
+      fda.setName("Ion Mobility");
+      s.getFloatDataArrays().push_back(fda);
+    }
+    exp->addSpectrum(s);
+  }
+}
+OpenSwath::SpectrumAccessPtr expptr = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(exp);
+
+START_SECTION((explicit SpectrumAccessIonMobilityIndexed(OpenSwath::ISpectrumAccess & origin, Size nr_buckets = 128)))
+{
+  ptr = new SpectrumAccessIonMobilityIndexed(*expptr);
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->getNrSpectra(), 3)
+}
+END_SECTION
+
+START_SECTION((~SpectrumAccessIonMobilityIndexed()))
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((FrameIndexPtr getFrameIndex(int id) const))
+{
+  SpectrumAccessIonMobilityIndexed indexed(*expptr, 2);
+  TEST_EQUAL(indexed.getFrameIndex(0) != nullptr, true)
+  TEST_EQUAL(indexed.getFrameIndex(1) == nullptr, true) // no ion mobility
+  TEST_EQUAL(indexed.getFrameIndex(2) != nullptr, true)
+  TEST_REAL_SIMILAR(indexed.getFrameIndex(0)->integrate(300, 600, 1.0, 1.5), 20.0)
+  TEST_REAL_SIMILAR(indexed.getFrameIndex(0)->integrate(300, 600, 0.5, 1.5), 30.0)
+}
+END_SECTION
+
+START_SECTION((boost::shared_ptr<OpenSwath::ISpectrumAccess> lightClone() const))
+{
+  SpectrumAccessIonMobilityIndexed indexed(*expptr, 2);
+  boost::shared_ptr<OpenSwath::ISpectrumAccess> clone = indexed.lightClone();
+  SpectrumAccessIonMobilityIndexed* indexed_clone = dynamic_cast<SpectrumAccessIonMobilityIndexed*>(clone.get());
+  TEST_NOT_EQUAL(indexed_clone, nullPointer)
+  TEST_EQUAL(indexed_clone->getNrSpectra(), 3)
+  // indices are shared
+  TEST_EQUAL(indexed_clone->getFrameIndex(2) == indexed.getFrameIndex(2), true)
+  TEST_EQUAL(indexed_clone->getSpectrumById(2)->getMZArray()->data.size(), 2)
+}
+END_SECTION
+
+START_SECTION((SpectrumAccessIonMobilityIndexed(const SpectrumAccessIonMobilityIndexed & rhs)))
+{
+  SpectrumAccessIonMobilityIndexed indexed(*expptr, 2);
+  SpectrumAccessIonMobilityIndexed copy(indexed);
+  TEST_EQUAL(copy.getNrSpectra(), indexed.getNrSpectra())
+  TEST_EQUAL(copy.getFrameIndex(0) == indexed.getFrameIndex(0), true)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
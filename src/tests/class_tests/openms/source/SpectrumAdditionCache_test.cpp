@@ -0,0 +1,163 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/ANALYSIS/OPENSWATH/SpectrumAdditionCache.h>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+// spectrum with n peaks (m/z and intensity array)
+OpenSwath::SpectrumPtr makeSpectrum(Size n)
+{
+  OpenSwath::SpectrumPtr s(new OpenSwath::Spectrum);
+  s->getMZArray()->data.assign(n, 100.0);
+  s->getIntensityArray()->data.assign(n, 1.0);
+  return s;
+}
+
+START_TEST(SpectrumAdditionCache, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+SpectrumAdditionCache* ptr = nullptr;
+SpectrumAdditionCache* null_ptr = nullptr;
+START_SECTION(explicit SpectrumAdditionCache(Size max_bytes = 64 * 1024 * 1024))
+{
+  ptr = new SpectrumAdditionCache();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->getMaxBytes(), 64 * 1024 * 1024)
+  TEST_EQUAL(SpectrumAdditionCache(100).getMaxBytes(), 100)
+}
+END_SECTION
+
+START_SECTION(~SpectrumAdditionCache())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((OpenSwath::SpectrumPtr get(const Key& key)))
+{
+  SpectrumAdditionCache cache;
+  SpectrumAdditionCache::Key k1 = {5, 3, 0.0, 0.0};
+  SpectrumAdditionCache::Key k2 = {5, 3, 0.8, 0.9};
+  TEST_EQUAL(bool(cache.get(k1)), false)
+
+  OpenSwath::SpectrumPtr s = makeSpectrum(10);
+  cache.insert(k1, s);
+  TEST_EQUAL(cache.get(k1) == s, true)
+  TEST_EQUAL(bool(cache.get(k2)), false) // different drift window
+}
+END_SECTION
+
+START_SECTION((void insert(const Key& key, const OpenSwath::SpectrumPtr& spectrum)))
+{
+  // room for two spectra of 10 peaks (2 arrays * 10 * 8 bytes each)
+  SpectrumAdditionCache cache(2 * 160);
+  SpectrumAdditionCache::Key k1 = {1, 1, 0.0, 0.0};
+  SpectrumAdditionCache::Key k2 = {2, 1, 0.0, 0.0};
+  SpectrumAdditionCache::Key k3 = {3, 1, 0.0, 0.0};
+  cache.insert(k1, makeSpectrum(10));
+  cache.insert(k2, makeSpectrum(10));
+  TEST_EQUAL(cache.size(), 2)
+  TEST_EQUAL(cache.getMemoryUsage(), 320)
+
+  // k1 becomes most recently used, so k2 is evicted
+  TEST_EQUAL(bool(cache.get(k1)), true)
+  cache.insert(k3, makeSpectrum(10));
+  TEST_EQUAL(cache.size(), 2)
+  TEST_EQUAL(bool(cache.get(k1)), true)
+  TEST_EQUAL(bool(cache.get(k2)), false)
+  TEST_EQUAL(bool(cache.get(k3)), true)
+
+  // replacing an entry does not count twice
+  cache.insert(k3, makeSpectrum(5));
+  TEST_EQUAL(cache.size(), 2)
+  TEST_EQUAL(cache.getMemoryUsage(), 240)
+
+  // spectra larger than the limit are not stored, null pointers are ignored
+  cache.insert(k2, makeSpectrum(100));
+  cache.insert(k2, OpenSwath::SpectrumPtr());
+  TEST_EQUAL(bool(cache.get(k2)), false)
+  TEST_EQUAL(cache.size(), 2)
+}
+END_SECTION
+
+START_SECTION((Size size() const))
+{
+  SpectrumAdditionCache cache;
+  TEST_EQUAL(cache.size(), 0)
+  SpectrumAdditionCache::Key k = {1, 1, 0.0, 0.0};
+  cache.insert(k, makeSpectrum(1));
+  TEST_EQUAL(cache.size(), 1)
+}
+END_SECTION
+
+START_SECTION((Size getMemoryUsage() const))
+{
+  SpectrumAdditionCache cache;
+  TEST_EQUAL(cache.getMemoryUsage(), 0)
+  SpectrumAdditionCache::Key k = {1, 1, 0.0, 0.0};
+  cache.insert(k, makeSpectrum(4));
+  TEST_EQUAL(cache.getMemoryUsage(), 2 * 4 * sizeof(double))
+}
+END_SECTION
+
+START_SECTION((Size getMaxBytes() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((void clear()))
+{
+  SpectrumAdditionCache cache;
+  SpectrumAdditionCache::Key k = {1, 1, 0.0, 0.0};
+  cache.insert(k, makeSpectrum(4));
+  cache.clear();
+  TEST_EQUAL(cache.size(), 0)
+  TEST_EQUAL(cache.getMemoryUsage(), 0)
+  TEST_EQUAL(bool(cache.get(k)), false)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
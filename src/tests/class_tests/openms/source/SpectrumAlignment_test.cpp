@@ -190,6 +190,39 @@ START_SECTION(template <typename SpectrumType> void getSpectrumAlignment(std::ve
     TEST_EQUAL(alignment[i].second, alignment_result[i].second)
   }
 
+  // absolute tolerance, tolerance windows of neighbouring peaks do not overlap
+  PeakSpectrum s5, s6;
+  for (double mz : {100.0, 200.0, 300.0, 400.0}) s5.push_back(Peak1D(mz, 1.0));
+  for (double mz : {99.8, 250.0, 300.2, 300.9, 500.0}) s6.push_back(Peak1D(mz, 1.0));
+  p.setValue("is_relative_tolerance", "false");
+  p.setValue("tolerance", 0.3);
+  sas1.setParameters(p);
+  sas1.getSpectrumAlignment(alignment, s5, s6);
+  TEST_EQUAL(alignment.size(), 2)
+  ABORT_IF(alignment.size() != 2)
+  TEST_EQUAL(alignment[0].first, 0)
+  TEST_EQUAL(alignment[0].second, 0)
+  TEST_EQUAL(alignment[1].first, 2)
+  TEST_EQUAL(alignment[1].second, 2)
+
+  // same result on repeated calls (the workspace is reused) and with overlapping windows
+  sas1.getSpectrumAlignment(alignment, s5, s6);
+  TEST_EQUAL(alignment.size(), 2)
+  s6.push_back(Peak1D(400.1, 1.0));
+  s6.push_back(Peak1D(400.3, 1.0));
+  s6.sortByPosition();
+  sas1.getSpectrumAlignment(alignment, s5, s6);
+  TEST_EQUAL(alignment.size(), 3)
+  ABORT_IF(alignment.size() != 3)
+  TEST_EQUAL(alignment[2].first, 3)
+  TEST_EQUAL(alignment[2].second, 4)
+
+  // empty spectra
+  sas1.getSpectrumAlignment(alignment, s5, PeakSpectrum());
+  TEST_EQUAL(alignment.size(), 0)
+
+  s5.push_back(Peak1D(10.0, 1.0));
+  TEST_EXCEPTION(Exception::IllegalArgument, sas1.getSpectrumAlignment(alignment, s5, s6))
 
 END_SECTION
 
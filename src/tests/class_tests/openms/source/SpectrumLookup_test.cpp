@@ -151,6 +151,27 @@ START_SECTION((Size findByReference(const String&) const))
 }
 END_SECTION
 
+START_SECTION([EXTRA] findByReference with simple and complex formats)
+{
+  SpectrumLookup lookup2;
+  lookup2.readSpectra(spectra);
+  lookup2.addReferenceFormat("index=(?<INDEX0>\\d+)$"); // matched without regular expression
+  lookup2.addReferenceFormat("[Ss]can (?<SCAN>\\d+)");
+  TEST_EQUAL(lookup2.findByReference("index=2"), 2);
+  TEST_EQUAL(lookup2.findByReference("file=1,index=2"), 2);
+  TEST_EQUAL(lookup2.findByReference("Scan 1"), 1);
+  TEST_EXCEPTION(Exception::ParseError, lookup2.findByReference("index=2,scan=1"));
+  TEST_EXCEPTION(Exception::ElementNotFound, lookup2.findByReference("index=5"));
+
+  // formats can be added directly, too:
+  lookup2.reference_formats.push_back(boost::regex("#(?<INDEX1>\\d+)"));
+  TEST_EQUAL(lookup2.findByReference("#3"), 2);
+  TEST_EQUAL(lookup2.findByReference("index=1"), 1);
+  lookup2.addReferenceFormat("id=(?<ID>\\d+)");
+  TEST_EXCEPTION(Exception::ElementNotFound, lookup2.findByReference("id=0"));
+}
+END_SECTION
+
 
 START_SECTION((static Int extractScanNumber(const String&,
                                             const boost::regex&)))
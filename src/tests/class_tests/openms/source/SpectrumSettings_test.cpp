@@ -295,6 +295,24 @@ START_SECTION((SpectrumSettings(const SpectrumSettings& source)))
 	TEST_EQUAL(tmp2.getDataProcessing().size(),0);
 	TEST_EQUAL(tmp2.metaValueExists("bla"),false);
 
+	// shared settings are copied on write
+	SpectrumSettings tmp3(tmp);
+	const SpectrumSettings& tmp3_const = tmp3;
+	TEST_EQUAL(&tmp3_const.getAcquisitionInfo(), &static_cast<const SpectrumSettings&>(tmp).getAcquisitionInfo());
+	tmp3.getAcquisitionInfo().setMethodOfCombination("other");
+	tmp3.getInstrumentSettings().getScanWindows().clear();
+	tmp3.getSourceFile().setNameOfFile("other.mzML");
+	TEST_STRING_EQUAL(tmp3.getAcquisitionInfo().getMethodOfCombination(), "other");
+	TEST_STRING_EQUAL(tmp.getAcquisitionInfo().getMethodOfCombination(), "test");
+	TEST_EQUAL(tmp.getInstrumentSettings().getScanWindows().size(), 1);
+	TEST_EQUAL(tmp.getSourceFile() == SourceFile(), true);
+
+	// modifying new settings leaves the defaults of other spectra untouched
+	SpectrumSettings tmp4, tmp5;
+	tmp4.getSourceFile().setNameOfFile("file.mzML");
+	TEST_EQUAL(tmp5.getSourceFile() == SourceFile(), true);
+	TEST_EQUAL(SpectrumSettings().getSourceFile() == SourceFile(), true);
+
 END_SECTION
 
 START_SECTION((bool operator== (const SpectrumSettings& rhs) const))
@@ -0,0 +1,224 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Johannes Veit $
+// $Authors: Johannes Veit $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/DATASTRUCTURES/StaticKDTree.h>
+///////////////////////////
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+
+using namespace OpenMS;
+using namespace std;
+
+typedef StaticKDTree<2> Tree;
+
+// brute force reference
+vector<Size> inBox(const vector<Tree::PointType>& points, const Tree::PointType& low, const Tree::PointType& high)
+{
+  vector<Size> result;
+  for (Size i = 0; i < points.size(); ++i)
+  {
+    if (points[i][0] >= low[0] && points[i][0] <= high[0] && points[i][1] >= low[1] && points[i][1] <= high[1]) result.push_back(i);
+  }
+  return result;
+}
+
+START_TEST(StaticKDTree, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+// random points, some of them with identical coordinates
+boost::mt19937 rng(42);
+boost::random::uniform_real_distribution<double> rt_dist(0.0, 1000.0), mz_dist(200.0, 1200.0);
+vector<Tree::PointType> points;
+for (Size i = 0; i < 2000; ++i)
+{
+  points.push_back({{rt_dist(rng), mz_dist(rng)}});
+}
+for (Size i = 0; i < 100; ++i)
+{
+  points.push_back(points[i * 7]);
+}
+
+Tree* ptr = nullptr;
+Tree* null_ptr = nullptr;
+START_SECTION((StaticKDTree()))
+{
+  ptr = new Tree();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->size(), 0)
+  TEST_EQUAL(ptr->empty(), true)
+}
+END_SECTION
+
+START_SECTION((~StaticKDTree()))
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((void build(const std::vector<PointType>& points)))
+{
+  Tree tree;
+  tree.build(points);
+  TEST_EQUAL(tree.size(), points.size())
+  tree.build(vector<Tree::PointType>());
+  TEST_EQUAL(tree.empty(), true)
+}
+END_SECTION
+
+START_SECTION((explicit StaticKDTree(const std::vector<PointType>& points)))
+{
+  Tree tree(points);
+  TEST_EQUAL(tree.size(), points.size())
+  TEST_EQUAL(tree.empty(), false)
+}
+END_SECTION
+
+START_SECTION((void clear()))
+{
+  Tree tree(points);
+  tree.clear();
+  TEST_EQUAL(tree.size(), 0)
+  vector<Size> result;
+  tree.queryBox({{0.0, 0.0}}, {{1e6, 1e6}}, result);
+  TEST_EQUAL(result.size(), 0)
+}
+END_SECTION
+
+Tree tree(points);
+
+START_SECTION((void queryBox(const PointType& low, const PointType& high, std::vector<Size>& result) const))
+{
+  Size mismatches = 0;
+  for (Size i = 0; i < 200; ++i)
+  {
+    Tree::PointType low = points[i * 3];
+    Tree::PointType high = {{low[0] + 50.0, low[1] + 10.0}};
+    vector<Size> result;
+    tree.queryBox(low, high, result);
+    sort(result.begin(), result.end());
+    if (result != inBox(points, low, high)) ++mismatches;
+  }
+  TEST_EQUAL(mismatches, 0)
+
+  vector<Size> result(1, 12345); // results are appended
+  tree.queryBox({{-1.0, -1.0}}, {{2000.0, 2000.0}}, result);
+  TEST_EQUAL(result.size(), points.size() + 1)
+  TEST_EQUAL(result[0], 12345)
+}
+END_SECTION
+
+START_SECTION((void queryRadius(const PointType& center, double radius, std::vector<Size>& result) const))
+{
+  Size mismatches = 0;
+  for (Size i = 0; i < 200; ++i)
+  {
+    const Tree::PointType& center = points[i * 5];
+    vector<Size> result;
+    tree.queryRadius(center, 30.0, result);
+    sort(result.begin(), result.end());
+    vector<Size> expected;
+    for (Size k = 0; k < points.size(); ++k)
+    {
+      double dx = points[k][0] - center[0], dy = points[k][1] - center[1];
+      if (dx * dx + dy * dy <= 900.0) expected.push_back(k);
+    }
+    if (result != expected) ++mismatches;
+  }
+  TEST_EQUAL(mismatches, 0)
+}
+END_SECTION
+
+START_SECTION((void queryBoxes(const std::vector<PointType>& lows, const std::vector<PointType>& highs, std::vector<std::vector<Size> >& results) const))
+{
+  vector<Tree::PointType> lows, highs;
+  for (Size i = 0; i < 100; ++i)
+  {
+    lows.push_back(points[i]);
+    highs.push_back({{points[i][0] + 20.0, points[i][1] + 20.0}});
+  }
+  vector<vector<Size> > results;
+  tree.queryBoxes(lows, highs, results);
+  TEST_EQUAL(results.size(), 100)
+  Size mismatches = 0;
+  for (Size i = 0; i < results.size(); ++i)
+  {
+    vector<Size> expected;
+    tree.queryBox(lows[i], highs[i], expected);
+    if (results[i] != expected) ++mismatches;
+  }
+  TEST_EQUAL(mismatches, 0)
+}
+END_SECTION
+
+START_SECTION((void queryRadii(const std::vector<PointType>& centers, double radius, std::vector<std::vector<Size> >& results) const))
+{
+  vector<Tree::PointType> centers(points.begin(), points.begin() + 100);
+  vector<vector<Size> > results;
+  tree.queryRadii(centers, 15.0, results);
+  TEST_EQUAL(results.size(), 100)
+  Size mismatches = 0;
+  for (Size i = 0; i < results.size(); ++i)
+  {
+    vector<Size> expected;
+    tree.queryRadius(centers[i], 15.0, expected);
+    if (results[i] != expected) ++mismatches;
+  }
+  TEST_EQUAL(mismatches, 0)
+}
+END_SECTION
+
+START_SECTION((Size size() const))
+{
+  TEST_EQUAL(tree.size(), 2100)
+}
+END_SECTION
+
+START_SECTION((bool empty() const))
+{
+  TEST_EQUAL(tree.empty(), false)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+END_TEST
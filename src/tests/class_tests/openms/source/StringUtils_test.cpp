@@ -336,6 +336,21 @@ START_SECTION((template <typename IteratorT> static bool extractDouble(IteratorT
 }
 END_SECTION
 
+START_SECTION((template <typename IteratorT> static bool extractFloat(IteratorT& begin, const IteratorT& end, float& target)))
+{
+  float f = 0;
+  std::string ss("-5.5\t9.1");
+  auto it = ss.begin();
+  TEST_EQUAL(StringUtils::extractFloat(it, ss.end(), f), true);
+  TEST_REAL_SIMILAR(f, -5.5)
+  TEST_EQUAL((int)std::distance(ss.begin(), it), 4); // was the iterator advanced?
+  std::string bad("x1.0");
+  it = bad.begin();
+  TEST_EQUAL(StringUtils::extractFloat(it, bad.end(), f), false);
+  TEST_EQUAL((int)std::distance(bad.begin(), it), 0);
+}
+END_SECTION
+
 START_SECTION((static String& toUpper(String &this_s)))
 {
   // TODO
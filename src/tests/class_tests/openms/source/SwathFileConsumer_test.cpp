@@ -462,6 +462,49 @@ START_SECTION(([EXTRA] consumeAndRetrieve))
 }
 END_SECTION
 
+START_SECTION(([EXTRA] consumeAndRetrieve_noReload))
+{
+  int nr_swath = 2;
+  std::vector<int> nr_ms2_spectra(nr_swath,1);
+  CachedSwathFileConsumer cached_sfc("./", "tmp_osw_cached_direct", 1, nr_ms2_spectra);
+  TEST_EQUAL(cached_sfc.getReloadMetaData(), true)
+  cached_sfc.setReloadMetaData(false);
+  TEST_EQUAL(cached_sfc.getReloadMetaData(), false)
+  PeakMap exp;
+  getSwathFile(exp, nr_swath);
+  // Consume all the spectra
+  for (Size i = 0; i < exp.getSpectra().size(); i++)
+  {
+    cached_sfc.consumeSpectrum(exp.getSpectra()[i]);
+  }
+
+  std::vector< OpenSwath::SwathMap > maps;
+  cached_sfc.retrieveSwathMaps(maps);
+
+  TEST_EQUAL(maps.size(), nr_swath+1) // Swath number + MS1
+  TEST_EQUAL(maps[0].ms1, true)
+  TEST_EQUAL(maps[0].sptr->getNrSpectra(), 1)
+  TEST_EQUAL(maps[0].sptr->getSpectrumById(0)->getMZArray()->data.size(), 1)
+  TEST_REAL_SIMILAR(maps[0].sptr->getSpectrumById(0)->getMZArray()->data[0], 100.0)
+  TEST_REAL_SIMILAR(maps[0].sptr->getSpectrumById(0)->getIntensityArray()->data[0], 200.0)
+
+  for (int i = 0; i< nr_swath; i++)
+  {
+    TEST_EQUAL(maps[i+1].ms1, false)
+    TEST_EQUAL(maps[i+1].sptr->getNrSpectra(), 1)
+    TEST_REAL_SIMILAR(maps[i+1].sptr->getSpectrumById(0)->getMZArray()->data[0], 101.0+i)
+    TEST_REAL_SIMILAR(maps[i+1].sptr->getSpectrumById(0)->getIntensityArray()->data[0], 201.0+i)
+    TEST_REAL_SIMILAR(maps[i+1].lower, 400+i*25.0)
+    TEST_REAL_SIMILAR(maps[i+1].upper, 425+i*25.0)
+  }
+
+  // the meta data files are written in any case
+  PeakMap meta;
+  MzMLFile().load("./tmp_osw_cached_direct_1.mzML", meta);
+  TEST_EQUAL(meta.size(), 1)
+}
+END_SECTION
+
 START_SECTION(([EXTRA] consumeAndRetrieve_noMS1))
 {
   // 2 SWATH should be sufficient for the test
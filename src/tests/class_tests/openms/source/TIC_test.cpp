@@ -81,6 +81,23 @@ START_SECTION(void compute(const MSExperiment &exp, float bin_size))
   ABORT_IF(r[0][0].getIntensity() != 0); // empty spectrum
 END_SECTION
 
+START_SECTION(void compute(const QCBase::SpectraSummary& summary, float bin_size))
+  MSExperiment exp;
+  MSSpectrum spec;
+  spec.setRT(5);
+  spec.push_back(Peak1D(100, 4));
+  spec.push_back(Peak1D(101, 6));
+  exp.setSpectra({ spec, MSSpectrum() });
+  TIC tic;
+  tic.compute(QCBase::SpectraSummary(exp), 0);
+  auto r = tic.getResults();
+  TEST_EQUAL(r.size(), 1);
+  ABORT_IF(r[0].size() != 2);
+  TEST_REAL_SIMILAR(r[0][0].getRT(), 5);
+  TEST_REAL_SIMILAR(r[0][0].getIntensity(), 10);
+  TEST_REAL_SIMILAR(r[0][1].getIntensity(), 0);
+END_SECTION
+
 START_SECTION(vector<MSChromatogram> getResults() const)
   NOT_TESTABLE // tested above
 END_SECTION
@@ -40,10 +40,13 @@
 #include <OpenMS/CONCEPT/VersionInfo.h>
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
 #include <OpenMS/DATASTRUCTURES/ListUtilsIO.h>
+#include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/FORMAT/TextFile.h>
 #include <OpenMS/FORMAT/ParamXMLFile.h>
 #include <OpenMS/KERNEL/FeatureMap.h>
 #include <OpenMS/KERNEL/ConsensusMap.h>
+#include <OpenMS/METADATA/PeptideIdentification.h>
+#include <OpenMS/METADATA/ProteinIdentification.h>
 
 #include <cstdlib>
 ///////////////////////////
@@ -185,6 +188,17 @@ class TOPPBaseTest
       return parseRange_(text, low, high);
     }
 
+    StringList writeSpectrumChunks(const PeakMap& exp, Size chunks, const String& file_prefix) const
+    {
+      return writeSpectrumChunks_(exp, chunks, file_prefix);
+    }
+
+    static void mergeChunkIdentifications(vector<ProteinIdentification>& proteins, vector<PeptideIdentification>& peptides,
+                                          vector<ProteinIdentification>& chunk_proteins, vector<PeptideIdentification>& chunk_peptides)
+    {
+      mergeChunkIdentifications_(proteins, peptides, chunk_proteins, chunk_peptides);
+    }
+
 };
 
 // Test class for no-optional parameters
@@ -746,6 +760,80 @@ START_SECTION(([EXTRA] data processing methods))
 	}
 END_SECTION
 
+START_SECTION(([EXTRA] StringList writeSpectrumChunks_(const PeakMap& exp, Size chunks, const String& file_prefix) const))
+{
+  // MS1 followed by three MS2 spectra, twice
+  PeakMap exp;
+  for (Size i = 0; i < 8; ++i)
+  {
+    MSSpectrum spec;
+    spec.setMSLevel(i % 4 == 0 ? 1 : 2);
+    spec.setNativeID("scan=" + String(i + 1));
+    spec.setRT(double(i));
+    exp.addSpectrum(spec);
+  }
+  TOPPBaseTest topp;
+  String prefix;
+  NEW_TMP_FILE(prefix);
+  StringList files = topp.writeSpectrumChunks(exp, 2, prefix);
+  TEST_EQUAL(files.size(), 2)
+  PeakMap chunk;
+  MzMLFile().load(files[1], chunk);
+  TEST_EQUAL(chunk.size(), 4)
+  TEST_EQUAL(chunk[0].getMSLevel(), 1)
+  TEST_EQUAL(chunk[0].getNativeID(), "scan=5")
+  TEST_REAL_SIMILAR(chunk[3].getRT(), 7.0)
+
+  // chunks are not cut between an MS1 spectrum and its MS2 spectra
+  files = topp.writeSpectrumChunks(exp, 4, prefix);
+  TEST_EQUAL(files.size(), 2)
+
+  // MS2 only: cut anywhere; no more chunks than spectra
+  PeakMap ms2;
+  for (const MSSpectrum& spec : exp)
+  {
+    if (spec.getMSLevel() == 2) ms2.addSpectrum(spec);
+  }
+  files = topp.writeSpectrumChunks(ms2, 10, prefix);
+  TEST_EQUAL(files.size(), 6)
+  MzMLFile().load(files[5], chunk);
+  TEST_EQUAL(chunk.size(), 1)
+  TEST_EQUAL(chunk[0].getNativeID(), "scan=8")
+}
+END_SECTION
+
+START_SECTION(([EXTRA] static void mergeChunkIdentifications_(std::vector<ProteinIdentification>& proteins, std::vector<PeptideIdentification>& peptides, std::vector<ProteinIdentification>& chunk_proteins, std::vector<PeptideIdentification>& chunk_peptides)))
+{
+  vector<ProteinIdentification> proteins, chunk_proteins;
+  vector<PeptideIdentification> peptides, chunk_peptides;
+  TEST_EXCEPTION(Exception::MissingInformation, TOPPBaseTest::mergeChunkIdentifications(proteins, peptides, chunk_proteins, chunk_peptides))
+
+  for (Size c = 0; c < 2; ++c)
+  {
+    chunk_proteins.resize(1);
+    chunk_proteins[0].setIdentifier("chunk" + String(c));
+    ProteinHit hit;
+    hit.setAccession("P" + String(c));
+    chunk_proteins[0].insertHit(hit);
+    hit.setAccession("shared");
+    chunk_proteins[0].insertHit(hit);
+    chunk_peptides.resize(1);
+    chunk_peptides[0].setIdentifier("chunk" + String(c));
+    chunk_peptides[0].setMetaValue("spectrum_reference", "scan=" + String(c));
+    TOPPBaseTest::mergeChunkIdentifications(proteins, peptides, chunk_proteins, chunk_peptides);
+    TEST_EQUAL(chunk_proteins.empty(), true)
+    TEST_EQUAL(chunk_peptides.empty(), true)
+  }
+  TEST_EQUAL(proteins.size(), 1)
+  TEST_EQUAL(proteins[0].getIdentifier(), "chunk0")
+  ABORT_IF(proteins[0].getHits().size() != 3)
+  TEST_EQUAL(proteins[0].getHits()[2].getAccession(), "P1")
+  TEST_EQUAL(peptides.size(), 2)
+  TEST_EQUAL(peptides[1].getIdentifier(), "chunk0")
+  TEST_EQUAL(peptides[1].getMetaValue("spectrum_reference"), "scan=1")
+}
+END_SECTION
+
 START_SECTION(([EXTRA] const Param& getParam_()))
 {
 	Param test_param;
@@ -830,6 +830,96 @@ START_SECTION(void matchSpectrum(
 }
 END_SECTION
 
+START_SECTION(void matchSpectra(
+  const std::vector<MSSpectrum>& input_spectra,
+  const Comparator& cmp,
+  std::vector<std::vector<Match>>& matches
+) const)
+{
+  const String msp_path = OPENMS_GET_TEST_DATA_PATH("MoNA-export-GC-MS_Spectra_reduced_TSE_matchSpectrum.msp");
+  const String gcms_fullscan_path = OPENMS_GET_TEST_DATA_PATH("TargetedSpectraExtractor_matchSpectrum_GCMS.mzML");
+  MzMLFile mzml;
+  MSExperiment gcms_experiment;
+  mzml.load(gcms_fullscan_path, gcms_experiment);
+  TargetedSpectraExtractor tse;
+  Param params = tse.getParameters();
+  params.setValue("top_matches_to_report", 2);
+  params.setValue("min_match_score", 0.51);
+  tse.setParameters(params);
+
+  MSExperiment library;
+  MSPGenericFile mse(msp_path, library);
+
+  TargetedSpectraExtractor::BinnedSpectrumComparator cmp;
+  std::map<String,DataValue> options = {
+    {"bin_size", 1.0},
+    {"peak_spread", 0},
+    {"bin_offset", 0.4}
+  };
+  cmp.init(library.getSpectra(), options);
+
+  // same results as matching one spectrum at a time
+  vector<vector<TargetedSpectraExtractor::Match>> all_matches;
+  tse.matchSpectra(gcms_experiment.getSpectra(), cmp, all_matches);
+  TEST_EQUAL(all_matches.size(), gcms_experiment.size())
+  for (Size i = 0; i < gcms_experiment.size(); ++i)
+  {
+    vector<TargetedSpectraExtractor::Match> matches;
+    tse.matchSpectrum(gcms_experiment[i], cmp, matches);
+    ABORT_IF(all_matches[i].size() != matches.size())
+    for (Size j = 0; j < matches.size(); ++j)
+    {
+      TEST_STRING_EQUAL(all_matches[i][j].spectrum.getName(), matches[j].spectrum.getName())
+      TEST_REAL_SIMILAR(all_matches[i][j].score, matches[j].score)
+    }
+  }
+}
+END_SECTION
+
+START_SECTION([EXTRA] BinnedSpectrumComparator with precursor_mz_tolerance)
+{
+  // three identical library spectra: precursor at 100, at 200 and without precursor
+  vector<MSSpectrum> library(3);
+  for (Size i = 0; i < library.size(); ++i)
+  {
+    library[i].emplace_back(50.0, 100.0);
+    library[i].emplace_back(60.0, 50.0);
+    if (i < 2)
+    {
+      Precursor prec;
+      prec.setMZ(100.0 * (i + 1));
+      library[i].setPrecursors({prec});
+    }
+  }
+  MSSpectrum query = library[1];
+
+  TargetedSpectraExtractor::BinnedSpectrumComparator cmp;
+  std::map<String,DataValue> options = { {"precursor_mz_tolerance", 1.0} };
+  cmp.init(library, options);
+  vector<pair<Size, double>> scores;
+  cmp.generateScores(query, scores, 0.5);
+  ABORT_IF(scores.size() != 2)
+  TEST_EQUAL(scores[0].first, 1)
+  TEST_EQUAL(scores[1].first, 2)
+  TEST_REAL_SIMILAR(scores[0].second, 1.0)
+
+  // queries without precursor are scored against everything
+  query.getPrecursors().clear();
+  vector<vector<pair<Size, double>>> batch_scores;
+  cmp.generateScores(vector<MSSpectrum>{query, library[0]}, batch_scores, 0.5);
+  TEST_EQUAL(batch_scores.size(), 2)
+  TEST_EQUAL(batch_scores[0].size(), 3)
+  TEST_EQUAL(batch_scores[1].size(), 2)
+  TEST_EQUAL(batch_scores[1][0].first, 0)
+
+  // tolerance 0: no filtering
+  options["precursor_mz_tolerance"] = 0.0;
+  cmp.init(library, options);
+  cmp.generateScores(library[1], scores, 0.5);
+  TEST_EQUAL(scores.size(), 3)
+}
+END_SECTION
+
 START_SECTION(void targetedMatching(
   const std::vector<MSSpectrum>& spectra,
   Comparator& cmp,
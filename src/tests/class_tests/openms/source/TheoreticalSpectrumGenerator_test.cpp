@@ -835,6 +835,77 @@ START_SECTION(([EXTRA] test first prefix loss))
 }
 END_SECTION
 
+START_SECTION((void getIonSeries(std::vector<double>& mz, std::vector<char>& ion_types, const AASequence& peptide, Int min_charge, Int max_charge) const))
+{
+  TheoreticalSpectrumGenerator t_gen;
+  Param params = t_gen.getParameters();
+  params.setValue("add_metainfo", "true");
+
+  vector<double> mz;
+  vector<char> ion_types;
+  PeakSpectrum spec;
+
+  // same m/z values and annotations (in the same order) as getSpectrum()
+  vector<String> peptides = {"IFSQVGK", "PEPTIDEK", ".(Acetyl)PEPTIDEM(Oxidation)K", "SAMPLERC.(Amidated)", "GG", "K"};
+  for (const String& first_prefix : ListUtils::create<String>("true,false"))
+  {
+    params.setValue("add_first_prefix_ion", first_prefix);
+    for (const String& ion_set : ListUtils::create<String>("by,abcxyz,ax"))
+    {
+      for (char ion : String("abcxyz"))
+      {
+        params.setValue(String("add_") + ion + "_ions", ion_set.has(ion) ? "true" : "false");
+      }
+      t_gen.setParameters(params);
+
+      for (const String& seq : peptides)
+      {
+        AASequence aa = AASequence::fromString(seq);
+        if (aa.size() < 2 && (ion_set.has('c') || ion_set.has('x'))) { continue; } // c- and x-ions need two residues
+        spec.clear(true);
+        t_gen.getSpectrum(spec, aa, 1, 3);
+        t_gen.getIonSeries(mz, ion_types, aa, 1, 3);
+
+        TEST_EQUAL(mz.size(), spec.size())
+        TEST_EQUAL(ion_types.size(), spec.size())
+        ABORT_IF(mz.size() != spec.size())
+        for (Size i = 0; i < spec.size(); ++i)
+        {
+          TEST_EQUAL(mz[i], spec[i].getMZ())
+          TEST_EQUAL(ion_types[i], spec.getStringDataArrays()[0][i][0])
+        }
+      }
+    }
+  }
+
+  // buffers are cleared
+  t_gen.getIonSeries(mz, ion_types, AASequence(), 1, 1);
+  TEST_EQUAL(mz.size(), 0)
+  TEST_EQUAL(ion_types.size(), 0)
+
+  params.setValue("add_c_ions", "true");
+  t_gen.setParameters(params);
+  TEST_EXCEPTION(Exception::InvalidSize, t_gen.getIonSeries(mz, ion_types, AASequence::fromString("K"), 1, 1))
+  TEST_EXCEPTION(Exception::InvalidParameter, t_gen.getIonSeries(mz, ion_types, AASequence::fromString("PEPTIDEK"), 1, 100))
+}
+END_SECTION
+
+START_SECTION((void getIonSeries(std::vector<double>& mz, const AASequence& peptide, Int min_charge, Int max_charge) const))
+{
+  TheoreticalSpectrumGenerator t_gen;
+  vector<double> mz;
+  PeakSpectrum spec;
+  t_gen.getSpectrum(spec, peptide, 1, 2);
+  t_gen.getIonSeries(mz, peptide, 1, 2);
+  TEST_EQUAL(mz.size(), spec.size())
+  ABORT_IF(mz.size() != spec.size())
+  for (Size i = 0; i < spec.size(); ++i)
+  {
+    TEST_EQUAL(mz[i], spec[i].getMZ())
+  }
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 
@@ -143,6 +143,32 @@ START_SECTION((double apply(double value) const))
 }
 END_SECTION
 
+START_SECTION((void apply(std::vector<double>& values) const))
+{
+	TransformationDescription td;
+	std::vector<double> values = {-0.5, 0.0, 1000.0};
+	td.apply(values);
+	TEST_REAL_SIMILAR(values[0], -0.5);
+	TEST_REAL_SIMILAR(values[1], 0.0);
+	TEST_REAL_SIMILAR(values[2], 1000.0);
+
+	// results must match the value-by-value version for every model:
+	TransformationDescription td2(data_nonlinear);
+	StringList types = ListUtils::create<String>("linear,b_spline,interpolated,lowess");
+	std::vector<double> input = {-0.5, 0.0, 0.1, 0.25, 0.6, 1.0, 1.5};
+	for (const String& type : types)
+	{
+		td2.fitModel(type);
+		values = input;
+		td2.apply(values);
+		for (Size i = 0; i < input.size(); ++i)
+		{
+			TEST_REAL_SIMILAR(values[i], td2.apply(input[i]));
+		}
+	}
+}
+END_SECTION
+
 START_SECTION((const String& getModelType() const))
 {
 	TransformationDescription td;
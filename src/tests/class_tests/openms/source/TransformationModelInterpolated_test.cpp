@@ -139,6 +139,46 @@ START_SECTION((double evaluate(double value) const))
 }
 END_SECTION
 
+START_SECTION((void evaluateBatch(std::vector<double>& values) const))
+{
+  TransformationModel::DataPoints data;
+  data.push_back(make_pair(0.0, 1.0));
+  data.push_back(make_pair(0.5, 4.0));
+  data.push_back(make_pair(1.0, 2.0));
+  data.push_back(make_pair(2.0, 3.0));
+
+  // sorted input, including values outside of the data range and on the knots:
+  std::vector<double> sorted = {-1.0, 0.0, 0.1, 0.5, 0.5, 0.75, 1.0, 1.9, 2.0, 3.5};
+  // unsorted input:
+  std::vector<double> unsorted = {1.9, -1.0, 0.75, 3.5, 0.0, 0.5};
+
+  StringList types = ListUtils::create<String>("linear,cspline,akima");
+  for (const String& type : types)
+  {
+    Param params;
+    TransformationModelInterpolated::getDefaultParameters(params);
+    params.setValue("interpolation_type", type);
+    params.setValue("extrapolation_type", "four-point-linear");
+    TransformationModelInterpolated tm(data, params);
+
+    for (const std::vector<double>& input : {sorted, unsorted})
+    {
+      std::vector<double> values = input;
+      tm.evaluateBatch(values);
+      TEST_EQUAL(values.size(), input.size())
+      for (Size i = 0; i < input.size(); ++i)
+      {
+        TEST_REAL_SIMILAR(values[i], tm.evaluate(input[i]))
+      }
+    }
+  }
+
+  std::vector<double> empty;
+  TransformationModelInterpolated(data, Param()).evaluateBatch(empty);
+  TEST_EQUAL(empty.empty(), true)
+}
+END_SECTION
+
 START_SECTION(([EXTRA] TransformationModelInterpolated::evaluate() beyond the actual borders))
 {
   Param p;
@@ -0,0 +1,184 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/DataAccessHelper.h>
+#include <OpenMS/FORMAT/TraMLFile.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <fstream>
+
+///////////////////////////
+#include <OpenMS/ANALYSIS/OPENSWATH/TransitionBinaryFile.h>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(TransitionBinaryFile, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+TransitionBinaryFile* ptr = nullptr;
+TransitionBinaryFile* nullPointer = nullptr;
+
+START_SECTION(TransitionBinaryFile())
+{
+  ptr = new TransitionBinaryFile();
+  TEST_NOT_EQUAL(ptr, nullPointer)
+}
+END_SECTION
+
+START_SECTION(~TransitionBinaryFile())
+{
+  delete ptr;
+}
+END_SECTION
+
+TargetedExperiment targeted_exp;
+TraMLFile().load(OPENMS_GET_TEST_DATA_PATH("ChromatogramExtractor_input.TraML"), targeted_exp);
+String bin_file;
+NEW_TMP_FILE(bin_file)
+
+START_SECTION(void convertTargetedExperimentToBinary(const char* filename, OpenMS::TargetedExperiment& targeted_exp))
+{
+  TransitionBinaryFile().convertTargetedExperimentToBinary(bin_file.c_str(), targeted_exp);
+  TEST_EQUAL(File::empty(bin_file), false)
+  TEST_EXCEPTION(Exception::UnableToCreateFile, TransitionBinaryFile().convertTargetedExperimentToBinary("/does/not/exist.trbin", targeted_exp))
+}
+END_SECTION
+
+START_SECTION(void convertBinaryToTargetedExperiment(const char* filename, OpenMS::TargetedExperiment& targeted_exp))
+{
+  // same result as the round trip through a TSV file
+  String tsv_file;
+  NEW_TMP_FILE(tsv_file)
+  TransitionTSVFile().convertTargetedExperimentToTSV(tsv_file.c_str(), targeted_exp);
+  TargetedExperiment reference, loaded;
+  TransitionTSVFile().convertTSVToTargetedExperiment(tsv_file.c_str(), FileTypes::TSV, reference);
+  TransitionBinaryFile().convertBinaryToTargetedExperiment(bin_file.c_str(), loaded);
+
+  TEST_EQUAL(loaded.getTransitions().size(), targeted_exp.getTransitions().size())
+  TEST_EQUAL(loaded.getTransitions().size(), reference.getTransitions().size())
+  TEST_EQUAL(loaded.getPeptides().size(), reference.getPeptides().size())
+  TEST_EQUAL(loaded.getProteins().size(), reference.getProteins().size())
+  for (Size i = 0; i < loaded.getTransitions().size(); ++i)
+  {
+    TEST_EQUAL(loaded.getTransitions()[i].getNativeID(), reference.getTransitions()[i].getNativeID())
+    TEST_EQUAL(loaded.getTransitions()[i].getPeptideRef(), reference.getTransitions()[i].getPeptideRef())
+    TEST_REAL_SIMILAR(loaded.getTransitions()[i].getPrecursorMZ(), reference.getTransitions()[i].getPrecursorMZ())
+    TEST_REAL_SIMILAR(loaded.getTransitions()[i].getProductMZ(), reference.getTransitions()[i].getProductMZ())
+    TEST_REAL_SIMILAR(loaded.getTransitions()[i].getLibraryIntensity(), reference.getTransitions()[i].getLibraryIntensity())
+  }
+  for (Size i = 0; i < loaded.getPeptides().size(); ++i)
+  {
+    TEST_EQUAL(loaded.getPeptides()[i].sequence, reference.getPeptides()[i].sequence)
+    TEST_EQUAL(loaded.getPeptides()[i].protein_refs.size(), reference.getPeptides()[i].protein_refs.size())
+  }
+
+  TEST_EXCEPTION(Exception::FileNotFound, TransitionBinaryFile().convertBinaryToTargetedExperiment("does_not_exist.trbin", loaded))
+}
+END_SECTION
+
+START_SECTION(void convertBinaryToTargetedExperiment(const char* filename, OpenSwath::LightTargetedExperiment& targeted_exp))
+{
+  OpenSwath::LightTargetedExperiment reference, loaded;
+  OpenSwathDataAccessHelper::convertTargetedExp(targeted_exp, reference);
+  TransitionBinaryFile().convertBinaryToTargetedExperiment(bin_file.c_str(), loaded);
+
+  TEST_EQUAL(loaded.getTransitions().size(), reference.getTransitions().size())
+  TEST_EQUAL(loaded.getCompounds().size(), reference.getCompounds().size())
+  TEST_EQUAL(loaded.getProteins().size(), reference.getProteins().size())
+  TEST_EQUAL(loaded.getTransitions().empty(), false)
+  for (Size i = 0; i < loaded.getTransitions().size(); ++i)
+  {
+    const OpenSwath::LightTransition& tr = loaded.getTransitions()[i];
+    const OpenSwath::LightTransition& ref = reference.getTransitions()[i];
+    TEST_EQUAL(tr.transition_name, ref.transition_name)
+    TEST_EQUAL(tr.peptide_ref, ref.peptide_ref)
+    TEST_EQUAL(tr.precursor_mz, ref.precursor_mz)
+    TEST_EQUAL(tr.product_mz, ref.product_mz)
+    TEST_EQUAL(tr.library_intensity, ref.library_intensity)
+    TEST_EQUAL(tr.fragment_charge, ref.fragment_charge)
+    TEST_EQUAL(tr.decoy, ref.decoy)
+    TEST_EQUAL(tr.detecting_transition, ref.detecting_transition)
+    TEST_EQUAL(tr.quantifying_transition, ref.quantifying_transition)
+    TEST_EQUAL(tr.identifying_transition, ref.identifying_transition)
+  }
+  for (Size i = 0; i < loaded.getCompounds().size(); ++i)
+  {
+    const OpenSwath::LightCompound& c = loaded.getCompounds()[i];
+    const OpenSwath::LightCompound& ref = reference.getCompounds()[i];
+    TEST_EQUAL(c.id, ref.id)
+    TEST_EQUAL(c.sequence, ref.sequence)
+    TEST_EQUAL(c.charge, ref.charge)
+    TEST_EQUAL(c.rt, ref.rt)
+    TEST_EQUAL(c.drift_time, ref.drift_time)
+    TEST_EQUAL(c.peptide_group_label, ref.peptide_group_label)
+    TEST_EQUAL(c.protein_refs.size(), ref.protein_refs.size())
+    TEST_EQUAL(c.modifications.size(), ref.modifications.size())
+    for (Size k = 0; k < c.modifications.size() && k < ref.modifications.size(); ++k)
+    {
+      TEST_EQUAL(c.modifications[k].location, ref.modifications[k].location)
+      TEST_EQUAL(c.modifications[k].unimod_id, ref.modifications[k].unimod_id)
+    }
+  }
+  for (Size i = 0; i < loaded.getProteins().size(); ++i)
+  {
+    TEST_EQUAL(loaded.getProteins()[i].id, reference.getProteins()[i].id)
+  }
+
+  // not a binary transition library / truncated file
+  String other_file;
+  NEW_TMP_FILE(other_file)
+  {
+    ofstream os(other_file.c_str());
+    os << "PrecursorMz\tProductMz\n";
+  }
+  TEST_EXCEPTION(Exception::ParseError, TransitionBinaryFile().convertBinaryToTargetedExperiment(other_file.c_str(), loaded))
+  {
+    ifstream is(bin_file.c_str(), ios::binary);
+    string content((istreambuf_iterator<char>(is)), istreambuf_iterator<char>());
+    ofstream os(other_file.c_str(), ios::binary);
+    os << content.substr(0, content.size() / 2);
+  }
+  TEST_EXCEPTION(Exception::ParseError, TransitionBinaryFile().convertBinaryToTargetedExperiment(other_file.c_str(), loaded))
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
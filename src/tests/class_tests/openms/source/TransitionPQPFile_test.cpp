@@ -80,6 +80,71 @@ START_SECTION( void convertPQPToTargetedExperiment(const char * filename, OpenMS
 }
 END_SECTION
 
+START_SECTION( void convertPQPToLightTargetedExperiment(const char* filename, OpenSwath::LightTargetedExperiment& targeted_exp, bool legacy_traml_id = false, double precursor_mz_lower = 0.0, double precursor_mz_upper = std::numeric_limits<double>::max()))
+{
+  TargetedExperiment targeted_exp;
+  TraMLFile().load(OPENMS_GET_TEST_DATA_PATH("ChromatogramExtractor_input.TraML"), targeted_exp);
+  String pqp_file;
+  NEW_TMP_FILE(pqp_file)
+  TransitionPQPFile pqp;
+  pqp.convertTargetedExperimentToPQP(pqp_file.c_str(), targeted_exp);
+
+  // direct loading gives the same result as the conversion through TSVTransition
+  OpenSwath::LightTargetedExperiment reference, direct;
+  pqp.convertPQPToTargetedExperiment(pqp_file.c_str(), reference);
+  pqp.convertPQPToLightTargetedExperiment(pqp_file.c_str(), direct);
+  TEST_EQUAL(direct.getTransitions().size(), reference.getTransitions().size())
+  TEST_EQUAL(direct.getCompounds().size(), reference.getCompounds().size())
+  TEST_EQUAL(direct.getProteins().size(), reference.getProteins().size())
+  TEST_EQUAL(direct.getTransitions().empty(), false)
+
+  std::map<String, const OpenSwath::LightTransition*> reference_transitions;
+  for (const auto& tr : reference.getTransitions()) reference_transitions[tr.transition_name] = &tr;
+  for (const auto& tr : direct.getTransitions())
+  {
+    TEST_EQUAL(reference_transitions.count(tr.transition_name), 1)
+    if (reference_transitions.count(tr.transition_name) == 0) continue;
+    const OpenSwath::LightTransition* ref = reference_transitions[tr.transition_name];
+    TEST_EQUAL(tr.peptide_ref, ref->peptide_ref)
+    TEST_REAL_SIMILAR(tr.precursor_mz, ref->precursor_mz)
+    TEST_REAL_SIMILAR(tr.product_mz, ref->product_mz)
+    TEST_REAL_SIMILAR(tr.library_intensity, ref->library_intensity)
+    TEST_EQUAL(tr.fragment_charge, ref->fragment_charge)
+    TEST_EQUAL(tr.decoy, ref->decoy)
+  }
+
+  std::map<String, const OpenSwath::LightCompound*> reference_compounds;
+  for (const auto& c : reference.getCompounds()) reference_compounds[c.id] = &c;
+  for (const auto& c : direct.getCompounds())
+  {
+    TEST_EQUAL(reference_compounds.count(c.id), 1)
+    if (reference_compounds.count(c.id) == 0) continue;
+    const OpenSwath::LightCompound* ref = reference_compounds[c.id];
+    TEST_EQUAL(c.sequence, ref->sequence)
+    TEST_EQUAL(c.charge, ref->charge)
+    TEST_REAL_SIMILAR(c.rt, ref->rt)
+    TEST_EQUAL(c.peptide_group_label, ref->peptide_group_label)
+    TEST_EQUAL(c.protein_refs.size(), ref->protein_refs.size())
+    TEST_EQUAL(c.modifications.size(), ref->modifications.size())
+  }
+
+  // restrict loading to a precursor m/z range
+  double split_mz = reference.getTransitions()[0].precursor_mz;
+  Size nr_below = 0;
+  for (const auto& tr : reference.getTransitions())
+  {
+    if (tr.precursor_mz <= split_mz) ++nr_below;
+  }
+  OpenSwath::LightTargetedExperiment window;
+  pqp.convertPQPToLightTargetedExperiment(pqp_file.c_str(), window, false, 0.0, split_mz);
+  TEST_EQUAL(window.getTransitions().size(), nr_below)
+  for (const auto& tr : window.getTransitions())
+  {
+    TEST_EQUAL(tr.precursor_mz <= split_mz, true)
+  }
+}
+END_SECTION
+
 START_SECTION( void validateTargetedExperiment(OpenMS::TargetedExperiment & targeted_exp))
 {
   NOT_TESTABLE
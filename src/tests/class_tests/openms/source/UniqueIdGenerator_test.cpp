@@ -165,6 +165,31 @@ START_SECTION([EXTRA] multithreaded example)
   // check if the generated ids contain (at least) two equal ones
   std::vector<OpenMS::UInt64>::iterator iter = std::adjacent_find(ids.begin(), ids.end());
   TEST_EQUAL(iter == ids.end(), true);
+
+  /* setSeed() discards the ids reserved by the threads, so a fixed seed reproduces the serial sequence */
+  OpenMS::UniqueIdGenerator::setSeed(546666321);
+  std::vector<OpenMS::UInt64> ids_serial;
+  for (unsigned i = 0; i < nofIdsToGenerate; ++i)
+  {
+    ids_serial.push_back(OpenMS::UniqueIdGenerator::getUniqueId());
+  }
+  std::vector<OpenMS::UInt64> ids_parallel(nofIdsToGenerate);
+#pragma omp parallel for
+  for (int i = 0; i < static_cast<int>(nofIdsToGenerate); ++i)
+  {
+    ids_parallel[i] = OpenMS::UniqueIdGenerator::getUniqueId();
+  }
+  OpenMS::UniqueIdGenerator::setSeed(546666321);
+  std::vector<OpenMS::UInt64> ids_serial2;
+  for (unsigned i = 0; i < nofIdsToGenerate; ++i)
+  {
+    ids_serial2.push_back(OpenMS::UniqueIdGenerator::getUniqueId());
+  }
+  TEST_EQUAL(ids_serial == ids_serial2, true);
+  // the parallel ids follow the serial ones in the random sequence
+  ids_parallel.insert(ids_parallel.end(), ids_serial.begin(), ids_serial.end());
+  std::sort(ids_parallel.begin(), ids_parallel.end());
+  TEST_EQUAL(std::adjacent_find(ids_parallel.begin(), ids_parallel.end()) == ids_parallel.end(), true);
 }
 END_SECTION
 
@@ -0,0 +1,170 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+
+///////////////////////////
+
+#include <OpenMS/VISUAL/MaxIntensityPyramid.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+#include <algorithm>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(MaxIntensityPyramid, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+// 4 MS1 spectra at RT 0, 10, 20, 30 with peaks at m/z 100 .. 200 and one MS2 spectrum
+PeakMap exp;
+for (Size s = 0; s < 4; ++s)
+{
+  MSSpectrum spec;
+  spec.setRT(10.0 * s);
+  spec.setMSLevel(1);
+  for (Size i = 0; i <= 10; ++i)
+  {
+    Peak1D p;
+    p.setMZ(100.0 + 10.0 * i);
+    p.setIntensity(float(s * 100 + i));
+    spec.push_back(p);
+  }
+  exp.addSpectrum(spec);
+}
+{
+  MSSpectrum spec;
+  spec.setRT(15.0);
+  spec.setMSLevel(2);
+  Peak1D p;
+  p.setMZ(150.0);
+  p.setIntensity(10000.0f);
+  spec.push_back(p);
+  exp.addSpectrum(spec);
+}
+exp.sortSpectra();
+
+MaxIntensityPyramid* ptr = nullptr;
+MaxIntensityPyramid* null_ptr = nullptr;
+START_SECTION((MaxIntensityPyramid()))
+{
+  ptr = new MaxIntensityPyramid();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->empty(), true)
+  TEST_EQUAL(ptr->getLevelCount(), 0)
+}
+END_SECTION
+
+START_SECTION((~MaxIntensityPyramid()))
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((explicit MaxIntensityPyramid(const PeakMap& map, Size rt_bins = 1024, Size mz_bins = 4096)))
+{
+  // RT bins are limited by the number of MS1 spectra: 4x8 -> 2x4 -> 1x2 -> 1x1
+  MaxIntensityPyramid pyramid(exp, 1024, 8);
+  TEST_EQUAL(pyramid.empty(), false)
+  TEST_EQUAL(pyramid.getLevelCount(), 4)
+
+  TEST_EQUAL(MaxIntensityPyramid(PeakMap()).empty(), true)
+}
+END_SECTION
+
+START_SECTION((bool empty() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((Size getLevelCount() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((bool matches(const PeakMap& map) const))
+{
+  MaxIntensityPyramid pyramid(exp);
+  TEST_EQUAL(pyramid.matches(exp), true)
+  PeakMap changed = exp;
+  changed[0].pop_back();
+  TEST_EQUAL(pyramid.matches(changed), false)
+}
+END_SECTION
+
+START_SECTION((bool canResolve(double rt_pixel_size, double mz_pixel_size) const))
+{
+  // base cells: 7.5 s x 12.5 Th
+  MaxIntensityPyramid pyramid(exp, 1024, 8);
+  TEST_EQUAL(pyramid.canResolve(7.5, 12.5), true)
+  TEST_EQUAL(pyramid.canResolve(30.0, 100.0), true)
+  TEST_EQUAL(pyramid.canResolve(1.0, 12.5), false)
+  TEST_EQUAL(pyramid.canResolve(7.5, 1.0), false)
+  TEST_EQUAL(MaxIntensityPyramid().canResolve(30.0, 100.0), false)
+}
+END_SECTION
+
+START_SECTION((void getMaxIntensities(double rt_min, double rt_max, Size rt_pixels, double mz_min, double mz_max, Size mz_pixels, std::vector<float>& intensities) const))
+{
+  MaxIntensityPyramid pyramid(exp, 1024, 8);
+  std::vector<float> intensities;
+
+  // a single pixel covering all data: MS2 peaks are ignored
+  pyramid.getMaxIntensities(0.0, 30.0, 1, 100.0, 200.0, 1, intensities);
+  TEST_EQUAL(intensities.size(), 1)
+  TEST_REAL_SIMILAR(intensities[0], 310.0)
+
+  // one pixel per spectrum and two m/z halves
+  pyramid.getMaxIntensities(0.0, 30.0, 4, 100.0, 200.0, 2, intensities);
+  TEST_EQUAL(intensities.size(), 8)
+  TEST_REAL_SIMILAR(intensities[0], 4.0)
+  TEST_REAL_SIMILAR(intensities[1], 10.0)
+  TEST_REAL_SIMILAR(intensities[6], 304.0)
+  TEST_REAL_SIMILAR(intensities[7], 310.0)
+
+  // area without data
+  pyramid.getMaxIntensities(100.0, 200.0, 3, 100.0, 200.0, 3, intensities);
+  TEST_EQUAL(intensities.size(), 9)
+  TEST_EQUAL(std::count(intensities.begin(), intensities.end(), -1.0f), 9)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
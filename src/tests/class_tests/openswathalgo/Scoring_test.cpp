@@ -252,6 +252,32 @@ BOOST_AUTO_TEST_CASE(test_MRMFeatureScoring_normalizedCrossCorrelation)
 }
 END_SECTION
 
+BOOST_AUTO_TEST_CASE(test_MRMFeatureScoring_normalizedCrossCorrelationPost)
+{
+  static const double arr1[] = {0,1,3,5,2,0};
+  static const double arr2[] = {1,3,5,2,0,0};
+  std::vector<double> data1 (arr1, arr1 + sizeof(arr1) / sizeof(arr1[0]) );
+  std::vector<double> data2 (arr2, arr2 + sizeof(arr2) / sizeof(arr2[0]) );
+  Scoring::standardize_data(data1);
+  Scoring::standardize_data(data2);
+
+  OpenSwath::Scoring::XCorrArrayType result = Scoring::normalizedCrossCorrelationPost(data1, data2, 2, 1);
+
+  TEST_REAL_SIMILAR (result.data[4].second, -0.7374631);  // .find( 2)
+  TEST_REAL_SIMILAR (result.data[3].second, -0.567846);   // .find( 1)
+  TEST_REAL_SIMILAR (result.data[2].second,  0.4159292);  // .find( 0)
+  TEST_REAL_SIMILAR (result.data[1].second,  0.8215339);  // .find(-1)
+  TEST_REAL_SIMILAR (result.data[0].second,  0.15634218); // .find(-2)
+
+  // lags beyond the data length do not overlap
+  result = Scoring::normalizedCrossCorrelationPost(data1, data2, 8, 1);
+  TEST_EQUAL (result.data.size(), 17)
+  TEST_REAL_SIMILAR (result.data[0].second, 0.0)
+  TEST_REAL_SIMILAR (result.data[16].second, 0.0)
+  TEST_REAL_SIMILAR (result.data[8+2].second, -0.7374631)
+}
+END_SECTION
+
 BOOST_AUTO_TEST_CASE(test_MRMFeatureScoring_calcxcorr_legacy_mquest_)
 //START_SECTION((MRMFeatureScoring::XCorrArrayType MRMFeatureScoring::calcxcorr(std::vector<double>& data1, std::vector<double>& data2, bool normalize)))
 {
@@ -220,6 +220,8 @@ protected:
     setValidStrings_("clip_nterm_methionine", ListUtils::create<String>("true,false"));
     registerIntOption_("spectrum_batch_size", "<posnum>", 20000, "max. number of spectra to search at a time; use 0 to search the entire scan range in one batch", false, true);
     setMinInt_("spectrum_batch_size", 0);
+    registerIntOption_("chunks", "<num>", 1, "Split the spectra into this many ranges and search them with concurrent Comet processes, each using 'threads'/'chunks' threads (Comet scales poorly beyond a few threads). The results are merged into a single output. The thread count of 'default_params_file' is used as is.", false, true);
+    setMinInt_("chunks", 1);
     registerDoubleList_("mass_offsets", "<doubleoffset1, doubleoffset2,...>", {0.0}, "One or more mass offsets to search (values subtracted from deconvoluted precursor mass). Has to include 0.0 if you want the default mass to be searched.", false, true);
 
     // spectral processing
@@ -268,7 +270,7 @@ protected:
     return modifications;
   }
 
-  void createParamFile_(ostream& os, const String& comet_version)
+  void createParamFile_(ostream& os, const String& comet_version, Int num_threads)
   {
     os << comet_version << "\n";              // required as first line in the param file
     os << "# Comet MS/MS search engine parameters file.\n";
@@ -278,7 +280,7 @@ protected:
     os << "peff_format = 0\n";                                                          // 0=no (normal fasta, default), 1=PEFF PSI-MOD, 2=PEFF Unimod
     os << "peff_obo =\n";                                                               // path to PSI Mod or Unimod OBO file
 
-    os << "num_threads = " << getIntOption_("threads") << "\n";                         // 0=poll CPU to set num threads; else specify num threads directly (max 64)
+    os << "num_threads = " << num_threads << "\n";                                                             // 0=poll CPU to set num threads; else specify num threads directly (max 64)
 
     // masses
     map<String,int> precursor_error_units;
@@ -633,13 +635,17 @@ protected:
     String tmp_pin = tmp_dir.getPath() + "result.pin";
     String default_params = getStringOption_("default_params_file");
     String tmp_file;
+    // each concurrent Comet process gets its share of the threads
+    const Size chunks = getIntOption_("chunks");
+    const Int threads = getIntOption_("threads");
+    const Int threads_per_process = chunks > 1 ? std::max(1, threads / Int(chunks)) : threads;
 
     //default params given or to be written
     if (default_params.empty())
     {
         tmp_file = tmp_dir.getPath() + "param.txt";
         ofstream os(tmp_file.c_str());
-        createParamFile_(os, comet_version);
+        createParamFile_(os, comet_version, threads_per_process);
         os.close();
     }
     else
@@ -661,7 +667,7 @@ protected:
     MzMLFile mzml_file{};
     String input_file_with_index = inputfile_name;
     auto index_offset = IndexedMzMLDecoder().findIndexListOffset(inputfile_name);
-    if (index_offset == (std::streampos)-1)
+    if (chunks <= 1 && index_offset == (std::streampos)-1) // chunks are written with index anyway
     {
       OPENMS_LOG_WARN << "The mzML file provided to CometAdapter is not indexed, but comet requires one. "
                       << "We will add an index by writing a temporary file. If you run this analysis more often, consider indexing your mzML in advance!" << std::endl;
@@ -686,11 +692,38 @@ protected:
     QStringList arguments;
     arguments << paramP.toQString() << paramN.toQString() << input_file_with_index.toQString();
 
+    // chunked search: every spectrum range is searched by its own Comet process (result_<i>.pep.xml)
+    StringList chunk_results;
+    vector<QStringList> chunk_arguments;
+    if (chunks > 1)
+    {
+      MSExperiment spectra;
+      MzMLFile chunk_loader;
+      chunk_loader.getOptions().addMSLevel(ms_level);
+      chunk_loader.load(inputfile_name, spectra);
+      const StringList chunk_files = writeSpectrumChunks_(spectra, chunks, tmp_dir.getPath() + "chunk");
+      spectra.clear(true);
+
+      for (Size i = 0; i < chunk_files.size(); ++i)
+      {
+        chunk_results.push_back(tmp_dir.getPath() + "result_" + String(i + 1));
+        chunk_arguments.push_back(QStringList() << paramP.toQString() << String("-N" + chunk_results.back()).toQString() << chunk_files[i].toQString());
+      }
+    }
+
     //-------------------------------------------------------------
     // run comet
     //-------------------------------------------------------------
-    // Comet execution with the executable and the arguments StringList
-    exit_code = runExternalProcess_(comet_executable.toQString(), arguments);
+    if (!chunk_arguments.empty())
+    {
+      writeDebug_("Running " + String(chunk_arguments.size()) + " Comet processes with " + String(threads_per_process) + " thread(s) each", 1);
+      exit_code = runExternalProcesses_(comet_executable.toQString(), chunk_arguments, "", chunk_arguments.size());
+    }
+    else
+    {
+      // Comet execution with the executable and the arguments StringList
+      exit_code = runExternalProcess_(comet_executable.toQString(), arguments);
+    }
     if (exit_code != EXECUTION_OK)
     {
       return exit_code;
@@ -705,7 +738,31 @@ protected:
     vector<ProteinIdentification> protein_identifications;
 
     writeDebug_("load PepXMLFile", 1);
-    PepXMLFile().load(tmp_pepxml, protein_identifications, peptide_identifications);
+    if (chunk_results.empty())
+    {
+      PepXMLFile().load(tmp_pepxml, protein_identifications, peptide_identifications);
+    }
+    else
+    {
+      ofstream pin; // concatenate the Percolator input of all chunks (one header)
+      if (!getStringOption_("pin_out").empty()) pin.open(tmp_pin.c_str());
+      for (Size i = 0; i < chunk_results.size(); ++i)
+      {
+        vector<ProteinIdentification> chunk_proteins;
+        vector<PeptideIdentification> chunk_peptides;
+        PepXMLFile().load(chunk_results[i] + ".pep.xml", chunk_proteins, chunk_peptides);
+        mergeChunkIdentifications_(protein_identifications, peptide_identifications, chunk_proteins, chunk_peptides);
+
+        if (!pin.is_open()) continue;
+        ifstream chunk_pin((chunk_results[i] + ".pin").c_str());
+        String line;
+        for (Size l = 0; getline(chunk_pin, line); ++l)
+        {
+          if (l == 0 && i > 0) continue;
+          pin << line << "\n";
+        }
+      }
+    }
     writeDebug_("write idXMLFile", 1);
     writeDebug_(out, 1);
 
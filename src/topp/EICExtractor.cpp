@@ -39,6 +39,7 @@
 #include <OpenMS/FORMAT/EDTAFile.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/KERNEL/MSExperimentTileIndex.h>
 #include <OpenMS/KERNEL/MSChromatogram.h>
 #include <OpenMS/FILTERING/NOISEESTIMATION/SignalToNoiseEstimatorMedian.h>
 #include <OpenMS/FILTERING/SMOOTHING/GaussFilter.h>
@@ -392,6 +393,9 @@ public:
 
 
       // search for each EIC and add up
+      // (many small area queries on the same map: index the MS1 peaks once)
+      MSExperimentTileIndex tile_index(exp);
+      std::vector<MSExperimentTileIndex::PeakRange> peak_ranges;
       Int not_found(0);
       Map<Size, double> quant;
 
@@ -418,21 +422,25 @@ public:
         //std::cerr << "Rt" << cm[i].getRT() << "  mz: " << cm[i].getMZ() << " R " <<  cm[i].getMetaValue("rank") << "\n";
 
         double mz_da = mztol * cm[i].getMZ() / 1e6; // mz tolerance in Dalton
-        PeakMap::ConstAreaIterator it = exp.areaBeginConst(cm[i].getRT() - rttol / 2,
-                                                                  cm[i].getRT() + rttol / 2,
-                                                                  cm[i].getMZ() - mz_da,
-                                                                  cm[i].getMZ() + mz_da);
+        tile_index.getPeakRanges(exp, cm[i].getRT() - rttol / 2,
+                                      cm[i].getRT() + rttol / 2,
+                                      cm[i].getMZ() - mz_da,
+                                      cm[i].getMZ() + mz_da, peak_ranges);
         Peak2D max_peak;
         max_peak.setIntensity(0);
         max_peak.setRT(cm[i].getRT());
         max_peak.setMZ(cm[i].getMZ());
-        for (; it != exp.areaEndConst(); ++it)
+        for (const MSExperimentTileIndex::PeakRange& range : peak_ranges)
         {
-          if (max_peak.getIntensity() < it->getIntensity())
+          const MSSpectrum& spec = exp[range.spectrum];
+          for (Size p = range.begin; p < range.end; ++p)
           {
-            max_peak.setIntensity(it->getIntensity());
-            max_peak.setRT(it.getRT());
-            max_peak.setMZ(it->getMZ());
+            if (max_peak.getIntensity() < spec[p].getIntensity())
+            {
+              max_peak.setIntensity(spec[p].getIntensity());
+              max_peak.setRT(spec.getRT());
+              max_peak.setMZ(spec[p].getMZ());
+            }
           }
         }
         double ppm = 0; // observed m/z offset
@@ -448,11 +456,13 @@ public:
           PeakMap::Iterator itm = exp.RTBegin(max_peak.getRT());
           SignedSize low = std::min<SignedSize>(std::distance(exp.begin(), itm), rt_collect);
           SignedSize high = std::min<SignedSize>(std::distance(itm, exp.end()) - 1, rt_collect);
-          PeakMap::AreaIterator itt = exp.areaBegin((itm - low)->getRT() - 0.01, (itm + high)->getRT() + 0.01, cm[i].getMZ() - mz_da, cm[i].getMZ() + mz_da);
-          for (; itt != exp.areaEnd(); ++itt)
+          tile_index.getPeakRanges(exp, (itm - low)->getRT() - 0.01, (itm + high)->getRT() + 0.01, cm[i].getMZ() - mz_da, cm[i].getMZ() + mz_da, peak_ranges);
+          for (const MSExperimentTileIndex::PeakRange& range : peak_ranges)
           {
-            mz.push_back(itt->getMZ());
-            //std::cerr << "ppm: " << itt.getRT() << " " <<  itt->getMZ() << " " << itt->getIntensity() << std::endl;
+            for (Size p = range.begin; p < range.end; ++p)
+            {
+              mz.push_back(exp[range.spectrum][p].getMZ());
+            }
           }
 
           if ((SignedSize)mz.size() > (low + high + 1)) OPENMS_LOG_WARN << "Compound " << i << " has overlapping peaks [" << mz.size() << "/" << low + high + 1 << "]" << std::endl;
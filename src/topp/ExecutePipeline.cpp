@@ -110,8 +110,11 @@ protected:
     setValidFormats_("in", ListUtils::create<String>("toppas"));
     registerStringOption_("out_dir", "<directory>", "", "Directory for output files (default: user's home directory)", false);
     registerStringOption_("resource_file", "<file>", "", "A TOPPAS resource file (*.trf) specifying the files this workflow is to be applied to", false);
-    registerIntOption_("num_jobs", "<integer>", 1, "Maximum number of jobs running in parallel", false, false);
+    registerIntOption_("num_jobs", "<integer>", 1, "Maximum number of jobs running in parallel. A job of a tool using several threads (see the tool's 'threads' parameter) counts as that many jobs.", false, false);
     setMinInt_("num_jobs", 1);
+    registerIntOption_("memory_limit", "<MB>", 0, "Maximum memory used by all jobs running in parallel (0 = unlimited). The memory of a job is estimated from previous runs of the same tool in this workflow.", false, true);
+    setMinInt_("memory_limit", 0);
+    registerStringOption_("cache_dir", "<directory>", "", "Directory for caching the results of tool nodes. Nodes whose tool version, parameters and input file contents did not change since a previous run reuse the cached results instead of running the tool again (default: no caching).", false, true);
   }
 
   ExitCodes main_(int argc, const char ** argv) override
@@ -139,6 +142,8 @@ protected:
 
     ts.load(toppas_file);
     ts.setAllowedThreads(num_jobs);
+    ts.setAllowedMemory(getIntOption_("memory_limit"));
+    ts.setCacheDirectory(getStringOption_("cache_dir").toQString());
 
     if (resource_file != "")
     {
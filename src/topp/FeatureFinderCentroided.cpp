@@ -200,6 +200,7 @@ protected:
     PeakMap exp;
     f.load(in, exp);
     exp.updateRanges();
+    addResourceCheckpoint_("loading");
 
     if (exp.getSpectra().empty())
     {
@@ -248,6 +249,7 @@ protected:
     // Apply the feature finder
     ff.run(FeatureFinderAlgorithmPicked::getProductName(), exp, features, feafi_param, seeds);
     features.applyMemberFunction(&UniqueIdInterface::setUniqueId);
+    addResourceCheckpoint_("feature finding");
 
     // DEBUG
     if (debug_level_ > 10)
@@ -309,6 +311,7 @@ protected:
       MzQuantMLFile file;
       file.store(out_mzq, msq);
     }
+    addResourceCheckpoint_("writing");
 
     return EXECUTION_OK;
   }
@@ -89,6 +89,91 @@ protected:
     registerFlag_("keep_subelements", "For consensusXML input only: If set, the sub-features of the inputs are transferred to the output.");
   }
 
+  /**
+    @brief Prepares a loaded feature map for linking as map @p map_index of @p out_map
+
+    Sets the column header of the map in @p out_map and, to save memory, removes
+    convex hulls, subordinates and meta values (except adduct information) of
+    the features.
+  */
+  void prepareFeatureMap_(Size map_index, FeatureMap& map, ConsensusMap& out_map, StringList& ms_run_locations)
+  {
+    StringList ms_runs;
+    map.getPrimaryMSRunPath(ms_runs);
+
+    // associate mzML file with map i in consensusXML
+    if (ms_runs.size() > 1 || ms_runs.empty())
+    {
+      OPENMS_LOG_WARN << "Exactly one MS run should be associated with a FeatureMap. "
+        << ms_runs.size() 
+        << " provided." << endl;
+    }
+    else
+    {
+      out_map.getColumnHeaders()[map_index].filename = ms_runs.front();
+    }
+    out_map.getColumnHeaders()[map_index].size = map.size();
+    out_map.getColumnHeaders()[map_index].unique_id = map.getUniqueId();
+
+    // copy over information on the primary MS run
+    ms_run_locations.insert(ms_run_locations.end(), ms_runs.begin(), ms_runs.end());
+
+    // to save memory, remove convex hulls, subordinates:
+    for (FeatureMap::Iterator it = map.begin(); it != map.end();
+         ++it)
+    {
+      String adduct;
+      //exception: addduct information
+      if (it->metaValueExists("dc_charge_adducts"))
+      {
+        adduct = it->getMetaValue("dc_charge_adducts");
+      }
+      it->getSubordinates().clear();
+      it->getConvexHulls().clear();
+      it->clearMetaInfo();
+      if (!adduct.empty())
+      {
+        it->setMetaValue("dc_charge_adducts", adduct);
+      }
+
+    }
+  }
+
+  /// Finalizes the linking result @p out_map (unique ids, data processing) and stores it as @p out
+  void writeConsensusMap_(const String& out, ConsensusMap& out_map)
+  {
+    // assign unique ids
+    out_map.applyMemberFunction(&UniqueIdInterface::setUniqueId);
+
+    // annotate output with data processing info
+    addDataProcessing_(out_map,
+                       getProcessingInfo_(DataProcessing::FEATURE_GROUPING));
+
+
+    // sort list of peptide identifications in each consensus feature by map index
+    out_map.sortPeptideIdentificationsByMapIndex();
+
+    // write output
+    ConsensusXMLFile().store(out, out_map);
+
+    // some statistics
+    map<Size, UInt> num_consfeat_of_size;
+    for (ConsensusMap::const_iterator cmit = out_map.begin();
+         cmit != out_map.end(); ++cmit)
+    {
+      ++num_consfeat_of_size[cmit->size()];
+    }
+
+    OPENMS_LOG_INFO << "Number of consensus features:" << endl;
+    for (map<Size, UInt>::reverse_iterator i = num_consfeat_of_size.rbegin();
+         i != num_consfeat_of_size.rend(); ++i)
+    {
+      OPENMS_LOG_INFO << "  of size " << setw(2) << i->first << ": " << setw(6) 
+               << i->second << endl;
+    }
+    OPENMS_LOG_INFO << "  total:      " << setw(6) << out_map.size() << endl;
+  }
+
   ExitCodes common_main_(FeatureGroupingAlgorithm * algorithm,
                          bool labeled = false)
   {
@@ -201,45 +286,7 @@ protected:
         FeatureMap tmp;
         f.load(ins[i], tmp);
 
-        StringList ms_runs;
-        tmp.getPrimaryMSRunPath(ms_runs);
-
-        // associate mzML file with map i in consensusXML
-        if (ms_runs.size() > 1 || ms_runs.empty())
-        {
-          OPENMS_LOG_WARN << "Exactly one MS run should be associated with a FeatureMap. "
-            << ms_runs.size() 
-            << " provided." << endl;
-        }
-        else
-        {
-          out_map.getColumnHeaders()[i].filename = ms_runs.front();
-        }
-        out_map.getColumnHeaders()[i].size = tmp.size();
-        out_map.getColumnHeaders()[i].unique_id = tmp.getUniqueId();
-
-        // copy over information on the primary MS run
-        ms_run_locations.insert(ms_run_locations.end(), ms_runs.begin(), ms_runs.end());
-
-        // to save memory, remove convex hulls, subordinates:
-        for (FeatureMap::Iterator it = tmp.begin(); it != tmp.end();
-             ++it)
-        {
-          String adduct;
-          //exception: addduct information
-          if (it->metaValueExists("dc_charge_adducts"))
-          {
-            adduct = it->getMetaValue("dc_charge_adducts");
-          }
-          it->getSubordinates().clear();
-          it->getConvexHulls().clear();
-          it->clearMetaInfo();
-          if (!adduct.empty())
-          {
-            it->setMetaValue("dc_charge_adducts", adduct);
-          }
-
-        }
+        prepareFeatureMap_(i, tmp, out_map, ms_run_locations);
 
         maps[i] = tmp;
         maps[i].updateRanges();
@@ -335,36 +382,7 @@ protected:
       }
     }
 
-    // assign unique ids
-    out_map.applyMemberFunction(&UniqueIdInterface::setUniqueId);
-
-    // annotate output with data processing info
-    addDataProcessing_(out_map,
-                       getProcessingInfo_(DataProcessing::FEATURE_GROUPING));
-
-
-    // sort list of peptide identifications in each consensus feature by map index
-    out_map.sortPeptideIdentificationsByMapIndex();
-
-    // write output
-    ConsensusXMLFile().store(out, out_map);
-
-    // some statistics
-    map<Size, UInt> num_consfeat_of_size;
-    for (ConsensusMap::const_iterator cmit = out_map.begin();
-         cmit != out_map.end(); ++cmit)
-    {
-      ++num_consfeat_of_size[cmit->size()];
-    }
-
-    OPENMS_LOG_INFO << "Number of consensus features:" << endl;
-    for (map<Size, UInt>::reverse_iterator i = num_consfeat_of_size.rbegin();
-         i != num_consfeat_of_size.rend(); ++i)
-    {
-      OPENMS_LOG_INFO << "  of size " << setw(2) << i->first << ": " << setw(6) 
-               << i->second << endl;
-    }
-    OPENMS_LOG_INFO << "  total:      " << setw(6) << out_map.size() << endl;
+    writeConsensusMap_(out, out_map);
 
     return EXECUTION_OK;
   }
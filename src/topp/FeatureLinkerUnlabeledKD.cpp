@@ -37,11 +37,15 @@
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 #include <OpenMS/DATASTRUCTURES/DefaultParamHandler.h>
 #include <OpenMS/ANALYSIS/MAPMATCHING/FeatureGroupingAlgorithmKD.h>
+#include <OpenMS/FORMAT/ColumnarFeatureFile.h>
+#include <OpenMS/SYSTEM/File.h>
 
 #include "../topp/FeatureLinkerBase.cpp"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <unordered_map>
 
 using namespace OpenMS;
 using namespace std;
@@ -96,6 +100,22 @@ using namespace std;
  used connected components memory-wise. More stringent m/z or retention time
  tolerances might be required then.
 
+ For very large cohorts of featureXML files, the -out_of_core flag avoids
+ holding all input maps in memory at once: the inputs are converted one by one
+ into temporary binary files, from which the features are read back one m/z
+ partition (see -algorithm:nr_partitions) at a time during alignment and
+ linking. Protein and unassigned peptide identifications are transferred as
+ usual. Peptide identifications assigned to features are transferred by
+ reading those inputs a second time, so the result is the same as in memory.
+
+ When new runs are added to a project, -add_to links the input featureXMLs
+ incrementally against an existing result (consensusXML produced by this
+ tool): the new features are matched to the existing consensus features,
+ which are updated, and only the remaining features are linked among each
+ other. The new maps are appended to the column headers of the consensus map.
+ RT warping is not performed in this mode, so the new maps should already be
+ aligned to the existing ones.
+
  <B>The command line parameters of this tool are:</B>
  @verbinclude TOPP_FeatureLinkerUnlabeledKD.cli
  <B>INI file documentation of this tool:</B>
@@ -121,6 +141,9 @@ protected:
   void registerOptionsAndFlags_() override
   {
     TOPPFeatureLinkerBase::registerOptionsAndFlags_();
+    registerFlag_("out_of_core", "For featureXML input without design only: Stream the input maps from temporary files partition by partition instead of keeping them all in memory (for very large cohorts).", true);
+    registerInputFile_("add_to", "<file>", "", "For featureXML input without design only: Add the input maps to this existing linking result instead of linking all inputs from scratch (no RT warping).", false, true);
+    setValidFormats_("add_to", ListUtils::create<String>("consensusXML"));
     registerSubsection_("algorithm", "Algorithm parameters section");
   }
 
@@ -134,9 +157,202 @@ protected:
   ExitCodes main_(int, const char **) override
   {
     FeatureGroupingAlgorithmKD algo;
+    if (!getStringOption_("add_to").empty())
+    {
+      return incrementalMain_(algo);
+    }
+    if (getFlag_("out_of_core"))
+    {
+      return outOfCoreMain_(algo);
+    }
     return TOPPFeatureLinkerBase::common_main_(&algo);
   }
 
+  ExitCodes incrementalMain_(FeatureGroupingAlgorithmKD& algo)
+  {
+    StringList ins = getStringList_("in");
+    String out = getStringOption_("out");
+    for (Size i = 0; i < ins.size(); ++i)
+    {
+      if (FileHandler::getType(ins[i]) != FileTypes::FEATUREXML)
+      {
+        writeLog_("Error: Option 'add_to' requires featureXML input!");
+        return ILLEGAL_PARAMETERS;
+      }
+    }
+    if (!getStringOption_("design").empty() || getFlag_("out_of_core"))
+    {
+      writeLog_("Error: Option 'add_to' can not be combined with 'design' or 'out_of_core'!");
+      return ILLEGAL_PARAMETERS;
+    }
+
+    Param algorithm_param = getParam_().copy("algorithm:", true);
+    writeDebug_("Used algorithm parameters", algorithm_param, 3);
+    algo.setParameters(algorithm_param);
+
+    ConsensusMap out_map;
+    ConsensusXMLFile().load(getStringOption_("add_to"), out_map);
+    OPENMS_LOG_INFO << "Adding " << ins.size() << " featureXMLs to " << out_map.getColumnHeaders().size() << " linked maps." << endl;
+
+    FeatureXMLFile f;
+    FeatureFileOptions options = f.getOptions();
+    options.setLoadSubordinates(false);
+    options.setLoadConvexHull(false);
+    f.setOptions(options);
+
+    vector<FeatureMap> maps(ins.size());
+    ConsensusMap headers; // column headers are set by addToConsensus()
+    StringList ms_run_locations;
+    for (Size i = 0; i < ins.size(); ++i)
+    {
+      f.load(ins[i], maps[i]);
+      prepareFeatureMap_(i, maps[i], headers, ms_run_locations);
+      maps[i].updateRanges();
+    }
+
+    algo.addToConsensus(maps, out_map);
+
+    writeConsensusMap_(out, out_map);
+
+    return EXECUTION_OK;
+  }
+
+  ExitCodes outOfCoreMain_(FeatureGroupingAlgorithmKD& algo)
+  {
+    StringList ins = getStringList_("in");
+    String out = getStringOption_("out");
+    for (Size i = 0; i < ins.size(); ++i)
+    {
+      if (FileHandler::getType(ins[i]) != FileTypes::FEATUREXML)
+      {
+        writeLog_("Error: Option 'out_of_core' requires featureXML input!");
+        return ILLEGAL_PARAMETERS;
+      }
+    }
+    if (!getStringOption_("design").empty())
+    {
+      writeLog_("Error: Option 'out_of_core' does not support a fractionated design!");
+      return ILLEGAL_PARAMETERS;
+    }
+
+    Param algorithm_param = getParam_().copy("algorithm:", true);
+    writeDebug_("Used algorithm parameters", algorithm_param, 3);
+    algo.setParameters(algorithm_param);
+
+    OPENMS_LOG_INFO << "Linking " << ins.size() << " featureXMLs (out of core)." << endl;
+
+    FeatureXMLFile f;
+    FeatureFileOptions options = f.getOptions();
+    options.setLoadSubordinates(false);
+    options.setLoadConvexHull(false);
+    f.setOptions(options);
+
+    // convert the inputs to m/z-sorted columnar files, one map in memory at a time
+    ConsensusMap out_map;
+    StringList ms_run_locations, columnar_files;
+    std::vector<bool> has_assigned_ids(ins.size(), false);
+    Size progress = 0;
+    setLogType(ProgressLogger::CMD);
+    startProgress(0, ins.size(), "reading input");
+    for (Size i = 0; i < ins.size(); ++i)
+    {
+      FeatureMap tmp;
+      f.load(ins[i], tmp);
+      prepareFeatureMap_(i, tmp, out_map, ms_run_locations);
+
+      // identifications are kept in memory (see FeatureGroupingAlgorithm::postprocess_)
+      out_map.getProteinIdentifications().insert(out_map.getProteinIdentifications().end(),
+        tmp.getProteinIdentifications().begin(), tmp.getProteinIdentifications().end());
+      for (PeptideIdentification pep_id : tmp.getUnassignedPeptideIdentifications())
+      {
+        pep_id.setMetaValue("map_index", i);
+        out_map.getUnassignedPeptideIdentifications().push_back(pep_id);
+      }
+      for (const Feature& feature : tmp)
+      {
+        if (!feature.getPeptideIdentifications().empty())
+        {
+          has_assigned_ids[i] = true;
+          break;
+        }
+      }
+
+      tmp.sortByMZ();
+      columnar_files.push_back(File::getTemporaryFile());
+      ColumnarFeatureFile::store(columnar_files.back(), tmp);
+
+      setProgress(progress++);
+    }
+    endProgress();
+
+    algo.groupFromFiles(columnar_files, out_map);
+
+    transferAssignedIdentifications_(ins, f, has_assigned_ids, out_map);
+
+    writeConsensusMap_(out, out_map);
+
+    return EXECUTION_OK;
+  }
+
+  /**
+    @brief Adds the peptide identifications assigned to the input features to the linked consensus features
+
+    The columnar files do not store peptide identifications, so the inputs which have assigned
+    identifications are read again, one at a time. The consensus features get the identifications
+    in the same order and with the same "map_index" annotation as ConsensusFeature::insert() gives
+    them when the maps are linked in memory.
+  */
+  void transferAssignedIdentifications_(const StringList& ins, FeatureXMLFile& f, const std::vector<bool>& has_assigned_ids, ConsensusMap& out_map)
+  {
+    if (std::find(has_assigned_ids.begin(), has_assigned_ids.end(), true) == has_assigned_ids.end())
+    {
+      return;
+    }
+
+    // input feature -> consensus feature, only for the maps which need it
+    std::vector<std::unordered_map<UInt64, Size> > consensus_index(ins.size());
+    for (Size c = 0; c < out_map.size(); ++c)
+    {
+      for (const FeatureHandle& handle : out_map[c].getFeatures())
+      {
+        if (has_assigned_ids[handle.getMapIndex()])
+        {
+          consensus_index[handle.getMapIndex()][handle.getUniqueId()] = c;
+        }
+      }
+    }
+
+    Size progress = 0;
+    startProgress(0, ins.size(), "transferring assigned peptide identifications");
+    for (Size i = 0; i < ins.size(); ++i)
+    {
+      setProgress(progress++);
+      if (!has_assigned_ids[i])
+      {
+        continue;
+      }
+      FeatureMap tmp;
+      f.load(ins[i], tmp);
+      for (const Feature& feature : tmp)
+      {
+        std::unordered_map<UInt64, Size>::const_iterator it = consensus_index[i].find(feature.getUniqueId());
+        if (it == consensus_index[i].end())
+        {
+          continue;
+        }
+        std::vector<PeptideIdentification>& ids = out_map[it->second].getPeptideIdentifications();
+        for (PeptideIdentification pep_id : feature.getPeptideIdentifications())
+        {
+          pep_id.setMetaValue("map_index", i);
+          ids.push_back(pep_id);
+        }
+      }
+      // free the index of this map early
+      std::unordered_map<UInt64, Size>().swap(consensus_index[i]);
+    }
+    endProgress();
+  }
+
 };
 
 
@@ -219,9 +219,10 @@ protected:
     {
       FeatureMap out;
       FeatureXMLFile fh;
+      std::vector<FeatureMap> maps(file_list.size());
       for (Size i = 0; i < file_list.size(); ++i)
       {
-        FeatureMap map;
+        FeatureMap& map = maps[i];
         fh.load(file_list[i], map);
 
         if (annotate_file_origin)
@@ -236,9 +237,9 @@ protected:
         {
           adjustRetentionTimes_(map, trafo_out[i], i == 0);
         }
-
-        out += map;
       }
+      // merge all at once (moves the features)
+      out.append(std::move(maps));
 
       //-------------------------------------------------------------
       // writing output
@@ -268,9 +269,10 @@ protected:
           }
 
           // skip first file for adding
+          std::vector<ConsensusMap> maps(file_list.size() - 1);
           for (Size i = 1; i < file_list.size(); ++i)
           {
-            ConsensusMap map;
+            ConsensusMap& map = maps[i - 1];
             fh.load(file_list[i], map);
 
             if (annotate_file_origin)
@@ -285,20 +287,19 @@ protected:
             {  
               adjustRetentionTimes_(map, trafo_out[i], i == 0);
             }
-
-            out.appendRows(map);
           }
+          out.appendRows(std::move(maps));
       }
       
       if (append_cols)
       { 
           // skip first file for adding
+          std::vector<ConsensusMap> maps(file_list.size() - 1);
           for (Size i = 1; i < file_list.size(); ++i)
           {
-            ConsensusMap map;
-            fh.load(file_list[i], map);
-            out.appendColumns(map);
+            fh.load(file_list[i], maps[i - 1]);
           }
+          out.appendColumns(std::move(maps));
       }
 
       //-------------------------------------------------------------
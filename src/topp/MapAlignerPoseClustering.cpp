@@ -165,25 +165,31 @@ protected:
     {
       OPENMS_LOG_INFO << "Picking a reference (by size) ..." << std::flush;
       // use map with highest number of features as reference:
-      Size max_count(0);
-      FeatureXMLFile f;
-      for (Size i = 0; i < in_files.size(); ++i)
+      vector<Size> sizes(in_files.size(), 0);
+      // loading mzML is expensive, so read the files in parallel (one map per thread in memory)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+      for (int i = 0; i < static_cast<int>(in_files.size()); ++i)
       {
-        Size s = 0;
         if (in_type == FileTypes::FEATUREXML) 
         {
-          s = f.loadSize(in_files[i]);
+          sizes[i] = FeatureXMLFile().loadSize(in_files[i]);
         }
-        else if (in_type == FileTypes::MZML) // this is expensive!
+        else if (in_type == FileTypes::MZML)
         {
           PeakMap exp;
           MzMLFile().load(in_files[i], exp);
           exp.updateRanges(1);
-          s = exp.getSize();
+          sizes[i] = exp.getSize();
         }
-        if (s > max_count)
+      }
+      Size max_count(0);
+      for (Size i = 0; i < in_files.size(); ++i)
+      {
+        if (sizes[i] > max_count)
         {
-          max_count = s;
+          max_count = sizes[i];
           reference_index = i;
         }
       }
@@ -216,6 +222,9 @@ protected:
     ProgressLogger plog;
     plog.setLogType(log_type_);
 
+    // every thread loads, aligns and stores one map at a time, so at most one
+    // input map per thread is in memory; the reference is shared read-only
+    // (MapAlignmentAlgorithmPoseClustering::align() is thread-safe)
     plog.startProgress(0, in_files.size(), "Aligning input maps");
     Size progress(0); // thread-safe progress
     // TODO: it should all work on featureXML files, since we might need them for output anyway. Converting to consensusXML is just wasting memory!
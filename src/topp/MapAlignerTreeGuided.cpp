@@ -36,6 +36,10 @@
 #include <OpenMS/APPLICATIONS/MapAlignerBase.h>
 
 #include <OpenMS/COMPARISON/CLUSTERING/ClusterAnalyzer.h> // to print newick tree on cml
+#include <OpenMS/FORMAT/TextFile.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <fstream>
 
 
 using namespace OpenMS;
@@ -89,6 +93,10 @@ see "Detailed Description" in the @ref OpenMS::MapAlignmentAlgorithmTreeGuided "
 
 Note that alignment is based on the sequence including modifications, thus an exact match is required. I.e., a peptide with oxidised methionine will not be matched to its unmodified version. This behavior is generally desired since (some) modifications can cause retention time shifts.
 
+The pairwise map distances can be cached in a text file (parameter @p similarity_cache). On a rerun, the distances of all
+input files that are listed in the cache (in the same order, at the beginning of @p in) are reused and only the rows of
+new input files are computed. The cache is updated afterwards.
+
 Also note that convex hulls are removed for alignment and are therefore missing in the output files.
 
 Since %OpenMS 1.8, the extraction of data for the alignment has been separate from the modeling of RT transformations based on that data. It is now possible to use different models independently of the chosen algorithm. This algorithm has been tested with the "b_spline" model. The different available models are:
@@ -159,6 +167,56 @@ private:
     progresslogger.endProgress();
   }
 
+  // Reads cached map distances. Only the leading rows whose file names match the start of 'in_files' are used.
+  void loadSimilarityCache_(const String& filename, const StringList& in_files, DistanceMatrix<float>& dist_matrix) const
+  {
+    if (filename.empty() || !File::exists(filename)) return;
+
+    TextFile cache(filename, false, -1, true);
+    vector<vector<float>> rows;
+    for (TextFile::ConstIterator it = cache.begin(); it != cache.end() && rows.size() < in_files.size(); ++it)
+    {
+      vector<String> fields;
+      it->split('\t', fields);
+      // row i: file name and the distances to the i previous files
+      if (fields.size() != rows.size() + 1 || fields[0] != in_files[rows.size()]) break;
+      vector<float> row;
+      for (Size j = 1; j < fields.size(); ++j)
+      {
+        row.push_back(fields[j].toFloat());
+      }
+      rows.push_back(row);
+    }
+    dist_matrix.resize(rows.size(), 1);
+    for (Size i = 1; i < rows.size(); ++i)
+    {
+      for (Size j = 0; j < i; ++j)
+      {
+        dist_matrix.setValueQuick(i, j, rows[i][j]);
+      }
+    }
+    OPENMS_LOG_INFO << "Reusing cached distances of " << rows.size() << " of " << in_files.size() << " input files." << endl;
+  }
+
+  void storeSimilarityCache_(const String& filename, const StringList& in_files, const DistanceMatrix<float>& dist_matrix) const
+  {
+    ofstream os(filename.c_str());
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    os.precision(writtenDigits<float>(0.0f));
+    for (Size i = 0; i < dist_matrix.dimensionsize(); ++i)
+    {
+      os << in_files[i];
+      for (Size j = 0; j < i; ++j)
+      {
+        os << '\t' << dist_matrix(i, j);
+      }
+      os << '\n';
+    }
+  }
+
   void registerOptionsAndFlags_() override
   {
     TOPPMapAlignerBase::registerOptionsAndFlags_("featureXML",
@@ -166,6 +224,7 @@ private:
     registerSubsection_("algorithm", "Algorithm parameters section");
     registerStringOption_("copy_data", "String", "true", "When aligning a large dataset with many files, load the input files twice and bypass copying.", false, false);
     setValidStrings_("copy_data", {"true","false"});
+    registerStringOption_("similarity_cache", "<file>", "", "Text file to cache the pairwise distances between the input files. Distances of input files already contained in the cache (same order, at the beginning of 'in') are reused, the file is updated with the distances of all input files afterwards.", false, true);
   }
 
   Param getSubsectionDefaults_(const String& section) const override
@@ -214,7 +273,14 @@ private:
     MapAlignmentAlgorithmTreeGuided algoTree;
     Param algo_params = getParam_().copy("algorithm:", true);
     algoTree.setParameters(algo_params);
-    OpenMS::MapAlignmentAlgorithmTreeGuided::buildTree(feature_maps, tree, maps_ranges);
+    String similarity_cache = getStringOption_("similarity_cache");
+    DistanceMatrix<float> dist_matrix;
+    loadSimilarityCache_(similarity_cache, in_files, dist_matrix);
+    OpenMS::MapAlignmentAlgorithmTreeGuided::buildTree(feature_maps, tree, maps_ranges, dist_matrix);
+    if (!similarity_cache.empty())
+    {
+      storeSimilarityCache_(similarity_cache, in_files, dist_matrix);
+    }
 
     // print tree
     ClusterAnalyzer ca;
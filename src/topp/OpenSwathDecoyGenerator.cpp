@@ -34,6 +34,7 @@
 
 #include <OpenMS/ANALYSIS/OPENSWATH/MRMDecoy.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/TransitionTSVFile.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/TransitionBinaryFile.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/TransitionPQPFile.h>
 #include <OpenMS/APPLICATIONS/TOPPBase.h>
 #include <OpenMS/CONCEPT/ProgressLogger.h>
@@ -120,11 +121,11 @@ protected:
   {
     registerInputFile_("in", "<file>", "", "Input file");
     registerStringOption_("in_type", "<type>", "", "Input file type -- default: determined from file extension or content\n", false);
-    String formats("tsv,mrm,pqp,TraML");
+    String formats("tsv,mrm,pqp,trbin,TraML");
     setValidFormats_("in", ListUtils::create<String>(formats));
     setValidStrings_("in_type", ListUtils::create<String>(formats));
 
-    formats = "tsv,pqp,TraML";
+    formats = "tsv,pqp,trbin,TraML";
     registerOutputFile_("out", "<file>", "", "Output file");
     setValidFormats_("out", ListUtils::create<String>(formats));
     registerStringOption_("out_type", "<type>", "", "Output file type -- default: determined from file extension or content\n", false);
@@ -248,6 +249,13 @@ protected:
       pqp_reader.convertPQPToTargetedExperiment(tr_file, targeted_exp);
       pqp_reader.validateTargetedExperiment(targeted_exp);
     }
+    else if (in_type == FileTypes::TRBIN)
+    {
+      TransitionBinaryFile bin_reader;
+      bin_reader.setLogType(log_type_);
+      bin_reader.convertBinaryToTargetedExperiment(in.c_str(), targeted_exp);
+      bin_reader.validateTargetedExperiment(targeted_exp);
+    }
     else if (in_type == FileTypes::TRAML)
     {
       TraMLFile traml;
@@ -303,6 +311,12 @@ protected:
       pqp_reader.setLogType(log_type_);
       pqp_reader.convertTargetedExperimentToPQP(tr_file, targeted_merged);
     }
+    else if (out_type == FileTypes::TRBIN)
+    {
+      TransitionBinaryFile bin_writer;
+      bin_writer.setLogType(log_type_);
+      bin_writer.convertTargetedExperimentToBinary(out.c_str(), targeted_merged);
+    }
     else if (out_type == FileTypes::TRAML)
     {
       TraMLFile traml;
@@ -44,6 +44,7 @@
 
 #include <map>
 #include <iterator>
+#include <set>
 
 using namespace OpenMS;
 using namespace std;
@@ -185,17 +186,36 @@ protected:
     // calculations
     //-------------------------------------------------------------
 
+    // the predictions are stored per sequence, so every distinct sequence is encoded and predicted once
+    set<String> seen_peptides;
     for (Size i = 0; i < identifications.size(); i++)
     {
       temp_peptide_hits = identifications[i].getHits();
       for (Size j = 0; j < temp_peptide_hits.size(); j++)
       {
-        peptides.push_back(temp_peptide_hits[j].getSequence().toUnmodifiedString());
+        String peptide = temp_peptide_hits[j].getSequence().toUnmodifiedString();
+        if (seen_peptides.insert(peptide).second)
+        {
+          peptides.push_back(peptide);
+        }
       }
     }
 
-    vector<double> labels;
-    labels.resize(peptides.size(), 0);
+    if (svm.getIntParameter(SVMWrapper::KERNEL_TYPE) == SVMWrapper::OLIGO && !peptides.empty())
+    {
+      inputFileReadable_((svmfile_name + "_samples"), "svm_model (derived)");
+
+      training_data = encoder.loadLibSVMProblem(svmfile_name + "_samples");
+      svm.setTrainingSample(training_data);
+
+      svm.setParameter(SVMWrapper::BORDER_LENGTH, (Int) border_length);
+      svm.setParameter(SVMWrapper::SIGMA, sigma);
+    }
+
+    // encoded batch of the composition and length kernels
+    vector<svm_node> prediction_nodes;
+    vector<svm_node*> prediction_vectors;
+    vector<Size> sequence_to_vector;
 
     vector<String>::iterator it_from = peptides.begin();
     vector<String>::iterator it_to = peptides.begin();
@@ -213,48 +233,48 @@ protected:
       temp_peptides.insert(temp_peptides.end(), it_from, it_to);
       temp_labels.resize(temp_peptides.size(), 0);
 
-      svm_problem* prediction_data = nullptr;
-
       if (svm.getIntParameter(SVMWrapper::KERNEL_TYPE) != SVMWrapper::OLIGO)
       {
-        prediction_data =
-          encoder.encodeLibSVMProblemWithCompositionAndLengthVectors(temp_peptides,
-                                                                     temp_labels,
-                                                                     allowed_amino_acid_characters,
-                                                                     maximum_length);
+        encoder.encodeCompositionAndLengthVectors(temp_peptides,
+                                                  allowed_amino_acid_characters,
+                                                  maximum_length,
+                                                  prediction_nodes,
+                                                  prediction_vectors,
+                                                  sequence_to_vector);
+        // the problem only refers to the batch buffers and must not be destroyed
+        svm_problem prediction_data;
+        prediction_data.l = (int) prediction_vectors.size();
+        prediction_data.y = temp_labels.data();
+        prediction_data.x = prediction_vectors.data();
+        svm.getSVCProbabilities(&prediction_data, predicted_likelihoods, predicted_labels);
       }
       else
       {
-        prediction_data = encoder.encodeLibSVMProblemWithOligoBorderVectors(temp_peptides,
-                                                                            temp_labels,
-                                                                            k_mer_length,
-                                                                            allowed_amino_acid_characters,
-                                                                            border_length);
-      }
-
-      if (svm.getIntParameter(SVMWrapper::KERNEL_TYPE) == SVMWrapper::OLIGO)
-      {
-        inputFileReadable_((svmfile_name + "_samples"), "svm_model (derived)");
-
-        training_data = encoder.loadLibSVMProblem(svmfile_name + "_samples");
-        svm.setTrainingSample(training_data);
-
-        svm.setParameter(SVMWrapper::BORDER_LENGTH, (Int) border_length);
-        svm.setParameter(SVMWrapper::SIGMA, sigma);
+        svm_problem* prediction_data = encoder.encodeLibSVMProblemWithOligoBorderVectors(temp_peptides,
+                                                                                         temp_labels,
+                                                                                         k_mer_length,
+                                                                                         allowed_amino_acid_characters,
+                                                                                         border_length);
+        svm.getSVCProbabilities(prediction_data, predicted_likelihoods, predicted_labels);
+        LibSVMEncoder::destroyProblem(prediction_data);
+        sequence_to_vector.resize(temp_peptides.size());
+        for (Size p = 0; p < temp_peptides.size(); ++p)
+        {
+          sequence_to_vector[p] = p;
+        }
       }
-      svm.getSVCProbabilities(prediction_data, predicted_likelihoods, predicted_labels);
 
       for (Size p = 0; p < temp_peptides.size(); p++)
       {
         predicted_data.insert(make_pair(temp_peptides[p],
-                                        (predicted_likelihoods[p])));
+                                        (predicted_likelihoods[sequence_to_vector[p]])));
       }
       predicted_likelihoods.clear();
       predicted_labels.clear();
-      LibSVMEncoder::destroyProblem(prediction_data);
 
       it_from = it_to;
     }
+    LibSVMEncoder::destroyProblem(training_data);
 
     for (Size i = 0; i < identifications.size(); i++)
     {
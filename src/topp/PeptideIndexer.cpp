@@ -176,7 +176,7 @@ protected:
     // calculations
     //-------------------------------------------------------------
 
-    FASTAContainer<TFI_File> proteins(db_name);
+    FASTAContainer<TFI_MMap> proteins(db_name);
     PeptideIndexing::ExitCodes indexer_exit = indexer.run(proteins, prot_ids, pep_ids);
   
     //-------------------------------------------------------------
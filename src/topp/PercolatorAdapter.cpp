@@ -45,10 +45,13 @@
 #include <OpenMS/FORMAT/OSWFile.h>
 #include <OpenMS/SYSTEM/File.h>
 #include <OpenMS/CONCEPT/Constants.h>
+#include <OpenMS/CONCEPT/ParallelExecution.h>
+#include <OpenMS/METADATA/MetaInfoRegistry.h>
 
 #include <QtCore/qfile.h>
 
 #include <iostream>
+#include <fstream>
 #include <cmath>
 #include <string>
 #include <set>
@@ -432,104 +435,120 @@ protected:
     return count;
   }
 
+  /// columns of the pin file computed in preparePin_ (all other columns are meta values of the PSMs)
+  enum PinColumn_
+  {
+    PIN_META, PIN_SPEC_ID, PIN_LABEL, PIN_SCAN_NR, PIN_CALC_MASS, PIN_EXP_MASS, PIN_DELTA_MASS, PIN_RT,
+    PIN_MASS, PIN_SCORE, PIN_PEPLEN, PIN_CHARGE, PIN_ENZ_N, PIN_ENZ_C, PIN_ENZ_INT, PIN_DM, PIN_ABS_DM,
+    PIN_PEPTIDE, PIN_PROTEINS
+  };
+
   //id <tab> label <tab> scannr <tab> calcmass <tab> expmass <tab> feature1 <tab> ... <tab> featureN <tab> peptide <tab> proteinId1 <tab> .. <tab> proteinIdM
-  void preparePin_(vector<PeptideIdentification>& peptide_ids, StringList& feature_set, std::string& enz, TextFile& txt, int min_charge, int max_charge)
+  void preparePin_(vector<PeptideIdentification>& peptide_ids, const StringList& feature_set, std::string& enz, std::ostream& pin, int min_charge, int max_charge)
   {
-    for (vector<PeptideIdentification>::iterator it = peptide_ids.begin(); it != peptide_ids.end(); ++it)
+    // resolve the columns once: either computed here (with the charge for PIN_CHARGE) or a meta value key
+    map<String, pair<PinColumn_, int>> computed =
+    {
+      {"SpecId", {PIN_SPEC_ID, 0}}, {"Label", {PIN_LABEL, 0}}, {"ScanNr", {PIN_SCAN_NR, 0}},
+      {"CalcMass", {PIN_CALC_MASS, 0}}, {"ExpMass", {PIN_EXP_MASS, 0}}, {"deltamass", {PIN_DELTA_MASS, 0}},
+      {"retentiontime", {PIN_RT, 0}}, {"mass", {PIN_MASS, 0}}, {"score", {PIN_SCORE, 0}},
+      {"peplen", {PIN_PEPLEN, 0}}, {"enzN", {PIN_ENZ_N, 0}}, {"enzC", {PIN_ENZ_C, 0}},
+      {"enzInt", {PIN_ENZ_INT, 0}}, {"dm", {PIN_DM, 0}}, {"absdm", {PIN_ABS_DM, 0}},
+      {"Peptide", {PIN_PEPTIDE, 0}}, {"Proteins", {PIN_PROTEINS, 0}}
+    };
+    for (int i = min_charge; i <= max_charge; ++i)
+    {
+      computed["charge" + String(i)] = {PIN_CHARGE, i};
+    }
+    MetaInfoRegistry& registry = MetaInfoInterface::metaRegistry();
+    vector<pair<PinColumn_, int>> columns;
+    vector<UInt> meta_keys;
+    for (const String& feat : feature_set)
     {
+      auto it = computed.find(feat);
+      columns.push_back(it != computed.end() ? it->second : make_pair(PIN_META, 0));
+      meta_keys.push_back(columns.back().first == PIN_META ? registry.registerName(feat) : 0);
+    }
+    const UInt target_decoy_key = registry.registerName("target_decoy");
+    const UInt calc_mass_key = registry.registerName("CalcMass");
+    const UInt old_isotope_error_key = registry.registerName("IsotopeError");
+    const UInt isotope_error_key = registry.registerName(Constants::UserParam::ISOTOPE_ERROR);
+
+    // the lines of a block of spectra are computed in parallel and then written in order,
+    // so the (potentially huge) pin file is never held in memory
+    const SignedSize block_size = 10000;
+    vector<String> lines(block_size);
+    ParallelExecution::pipeline(0, (SignedSize)peptide_ids.size(), block_size, [&](SignedSize pep_idx)
+    {
+      vector<PeptideIdentification>::iterator it = peptide_ids.begin() + pep_idx;
+      String& out = lines[pep_idx % block_size];
+      out.clear();
+
       String scan_identifier = getScanIdentifier_(it, peptide_ids.begin());
       Int scan_number = getScanNumber_(scan_identifier);
       
       double exp_mass = it->getMZ();
       double retention_time = it->getRT();
-      for (vector<PeptideHit>::const_iterator jt = it->getHits().begin(); jt != it->getHits().end(); ++jt)
+      for (const PeptideHit& hit : it->getHits())
       {
-        if (jt->getPeptideEvidences().empty())
+        if (hit.getPeptideEvidences().empty())
         {
           OPENMS_LOG_WARN << "PSM (PeptideHit) without protein reference found. "
                    << "This may indicate incomplete mapping during PeptideIndexing (e.g., wrong enzyme settings)." 
                    << "Will skip this PSM." << endl;
           continue;
         }
-        PeptideHit hit(*jt); // make a copy of the hit to store temporary features
-        hit.setMetaValue("SpecId", scan_identifier);
-        hit.setMetaValue("ScanNr", scan_number);
         
-        if (!hit.metaValueExists("target_decoy") 
-          || hit.getMetaValue("target_decoy").toString().empty()) 
+        if (!hit.metaValueExists(target_decoy_key) 
+          || hit.getMetaValue(target_decoy_key).toString().empty()) 
         {
           continue;
         }
         
         int label = 1;
-        if (hit.getMetaValue("target_decoy") == "decoy")
+        if (hit.getMetaValue(target_decoy_key) == "decoy")
         {
           label = -1;
         }
-        hit.setMetaValue("Label", label);
         
         int charge = hit.getCharge();
         String unmodified_sequence = hit.getSequence().toUnmodifiedString();
        
-        double calc_mass; 
-        if (!hit.metaValueExists("CalcMass"))
+        double calc_mass;
+        DataValue calc_mass_value;
+        if (!hit.metaValueExists(calc_mass_key))
         {
           calc_mass = hit.getSequence().getMonoWeight(Residue::Full, charge)/charge;
-          hit.setMetaValue("CalcMass", calc_mass);
+          calc_mass_value = calc_mass;
         }
         else
         {
-          calc_mass = hit.getMetaValue("CalcMass");
+          calc_mass_value = hit.getMetaValue(calc_mass_key);
+          calc_mass = calc_mass_value;
         }
 
-        if (hit.metaValueExists("IsotopeError"))  // for backwards compatibility (generated by MSGFPlusAdaper OpenMS < 2.6)
+        if (hit.metaValueExists(old_isotope_error_key))  // for backwards compatibility (generated by MSGFPlusAdaper OpenMS < 2.6)
         {
-          float isoErr = hit.getMetaValue("IsotopeError").toString().toFloat();
+          float isoErr = hit.getMetaValue(old_isotope_error_key).toString().toFloat();
           exp_mass = exp_mass - (isoErr * Constants::C13C12_MASSDIFF_U) / charge;
         }
-        else if (hit.metaValueExists(Constants::UserParam::ISOTOPE_ERROR)) // OpenMS user param name for isotope error
+        else if (hit.metaValueExists(isotope_error_key)) // OpenMS user param name for isotope error
         {
-          float isoErr = hit.getMetaValue(Constants::UserParam::ISOTOPE_ERROR).toString().toFloat();
+          float isoErr = hit.getMetaValue(isotope_error_key).toString().toFloat();
           exp_mass = exp_mass - (isoErr * Constants::C13C12_MASSDIFF_U) / charge;
         }
-                
-        hit.setMetaValue("ExpMass", exp_mass);
 
         // needed in case "description of correct" option is used
         double delta_mass = exp_mass - calc_mass;
-        hit.setMetaValue("deltamass", delta_mass);
-        hit.setMetaValue("retentiontime", retention_time);
-
-        hit.setMetaValue("mass", exp_mass);
-        
-        double score = hit.getScore();
-        // TODO better to use log scores for E-value based scores
-        hit.setMetaValue("score", score);
-        
-        int peptide_length = unmodified_sequence.size();
-        hit.setMetaValue("peplen", peptide_length);
-        
-        for (int i = min_charge; i <= max_charge; ++i)
-        {
-           hit.setMetaValue("charge" + String(i), charge == i);
-        }
 
         // just first peptide evidence
         char aa_before = hit.getPeptideEvidences().front().getAABefore();
         char aa_after = hit.getPeptideEvidences().front().getAAAfter();
 
         bool enzN = isEnz_(aa_before, unmodified_sequence.prefix(1)[0], enz);
-        hit.setMetaValue("enzN", enzN);
         bool enzC = isEnz_(unmodified_sequence.suffix(1)[0], aa_after, enz);
-        hit.setMetaValue("enzC", enzC);
         int enzInt = countEnzymatic_(unmodified_sequence, enz);
-        hit.setMetaValue("enzInt", enzInt);
 
-        hit.setMetaValue("dm", delta_mass);
-        
-        double abs_delta_mass = abs(delta_mass);
-        hit.setMetaValue("absdm", abs_delta_mass);
-        
         //peptide
         String sequence = "";
 
@@ -543,31 +562,63 @@ protected:
         sequence += "."; 
         sequence += aa_after;
         
-        hit.setMetaValue("Peptide", sequence);
-        
         //proteinId1
         StringList proteins;
-        for (vector<PeptideEvidence>::const_iterator kt = hit.getPeptideEvidences().begin(); kt != hit.getPeptideEvidences().end(); ++kt)
+        for (const PeptideEvidence& evidence : hit.getPeptideEvidences())
         {
-          proteins.push_back(kt->getProteinAccession());
+          proteins.push_back(evidence.getProteinAccession());
         }
-        hit.setMetaValue("Proteins", ListUtils::concatenate(proteins, '\t'));
-        
-        StringList feats;
-        for (vector<String>::const_iterator feat = feature_set.begin(); feat != feature_set.end(); ++feat)
+
+        // the values are formatted like the meta values they used to be stored in
+        String line;
+        bool complete = true;
+        for (Size c = 0; c < columns.size() && complete; ++c)
         {
-        // Some Hits have no NumMatchedMainIons, and MeanError, etc. values. Have to ignore them!
-          if (hit.metaValueExists(*feat))
+          if (c > 0) line += '\t';
+          switch (columns[c].first)
           {
-            feats.push_back(hit.getMetaValue(*feat).toString());
+            case PIN_SPEC_ID: line += scan_identifier; break;
+            case PIN_LABEL: line += DataValue(label).toString(); break;
+            case PIN_SCAN_NR: line += DataValue(scan_number).toString(); break;
+            case PIN_CALC_MASS: line += calc_mass_value.toString(); break;
+            case PIN_EXP_MASS:
+            case PIN_MASS: line += DataValue(exp_mass).toString(); break;
+            case PIN_DELTA_MASS:
+            case PIN_DM: line += DataValue(delta_mass).toString(); break;
+            case PIN_RT: line += DataValue(retention_time).toString(); break;
+            case PIN_SCORE: line += DataValue(hit.getScore()).toString(); break;  // TODO better to use log scores for E-value based scores
+            case PIN_PEPLEN: line += DataValue(int(unmodified_sequence.size())).toString(); break;
+            case PIN_CHARGE: line += DataValue(int(charge == columns[c].second)).toString(); break;
+            case PIN_ENZ_N: line += DataValue(int(enzN)).toString(); break;
+            case PIN_ENZ_C: line += DataValue(int(enzC)).toString(); break;
+            case PIN_ENZ_INT: line += DataValue(enzInt).toString(); break;
+            case PIN_ABS_DM: line += DataValue(abs(delta_mass)).toString(); break;
+            case PIN_PEPTIDE: line += sequence; break;
+            case PIN_PROTEINS: line += ListUtils::concatenate(proteins, '\t'); break;
+            case PIN_META:
+              // Some Hits have no NumMatchedMainIons, and MeanError, etc. values. Have to ignore them!
+              if (hit.metaValueExists(meta_keys[c]))
+              {
+                line += hit.getMetaValue(meta_keys[c]).toString();
+              }
+              else
+              {
+                complete = false;
+              }
+              break;
           }
         }
-        if (feats.size() == feature_set.size())
+        if (complete)
         { // only if all feats were present add
-          txt.addLine(ListUtils::concatenate(feats, '\t'));
+          out += line;
+          out += '\n';
         }
       }
-    }
+    },
+    [&](SignedSize pep_idx)
+    {
+      pin << lines[pep_idx % block_size];
+    });
   }
   
   void readPoutAsMap_(const String& pout_file, std::map<String, PercolatorResult>& pep_map)
@@ -981,20 +1032,24 @@ protected:
       feature_set.push_back("Proteins");
       
       OPENMS_LOG_DEBUG << "Writing percolator input file." << endl;
-      TextFile txt;  
-      txt.addLine(ListUtils::concatenate(feature_set, '\t'));
-      preparePin_(all_peptide_ids, feature_set, enz_str, txt, min_charge, max_charge);
-      txt.store(pin_file);
+      std::ofstream pin(pin_file.c_str());
+      if (!pin)
+      {
+        throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, pin_file);
+      }
+      pin << ListUtils::concatenate(feature_set, '\t') << "\n";
+      preparePin_(all_peptide_ids, feature_set, enz_str, pin, min_charge, max_charge);
     }
     // OSW input
     else
     {
       OPENMS_LOG_DEBUG << "Writing percolator input file." << endl;
-      TextFile txt;  
-      std::stringstream pin_output;
-      OSWFile().read(in_osw, osw_level, pin_output, ipf_max_peakgroup_pep, ipf_max_transition_isotope_overlap, ipf_min_transition_sn);
-      txt << pin_output.str();
-      txt.store(pin_file);
+      std::ofstream pin(pin_file.c_str());
+      if (!pin)
+      {
+        throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, pin_file);
+      }
+      OSWFile().read(in_osw, osw_level, pin, ipf_max_peakgroup_pep, ipf_max_transition_isotope_overlap, ipf_min_transition_sn);
     }
 
     QStringList arguments;
@@ -1326,15 +1381,17 @@ protected:
     }
     else
     {
-      std::map< std::string, std::vector<double> > features;
+      // the scores are written as they are read; only the first result of a PSMId (in the order of pep_map) is used
+      OSWFile::ScoreWriter writer(out, osw_level);
+      std::set<String> written;
       for (auto const &feat : pep_map)
       {
-
-        features[feat.second.PSMId].push_back(feat.second.score);
-        features[feat.second.PSMId].push_back(feat.second.qvalue);
-        features[feat.second.PSMId].push_back(feat.second.posterior_error_prob);
+        if (written.insert(feat.second.PSMId).second)
+        {
+          writer.add(feat.second.PSMId, feat.second.score, feat.second.qvalue, feat.second.posterior_error_prob);
+        }
       }
-      OSWFile().write(out, osw_level, features);
+      writer.commit();
     }
 
     writeLog_("PercolatorAdapter finished successfully!");
@@ -260,7 +260,7 @@ protected:
   // E.g. Percolator_qvalue <-> q-value.
   // Improvement for the future would be to have unique names for the score_types
   // LuciphorAdapter uses the same strategy to backup previous scores.
-  void addScoreToMetaValues_(PeptideHit& hit, const String score_type)
+  void addScoreToMetaValues_(PeptideHit& hit, const String score_type) const
   {
     if (!hit.metaValueExists(score_type) && !hit.metaValueExists(score_type + "_score"))
     {
@@ -313,28 +313,38 @@ protected:
     SpectrumLookup lookup;
     lookup.readSpectra(exp.getSpectra());
 
-    for (vector<PeptideIdentification>::iterator pep_id = pep_ids.begin(); pep_id != pep_ids.end(); ++pep_id)
+    // look up all spectra first (may throw), then score the identifications in parallel;
+    // the spectra are sorted, so AScore::compute() only reads them
+    vector<Size> scan_ids(pep_ids.size());
+    for (Size i = 0; i < pep_ids.size(); ++i)
     {
-      Size scan_id = lookup.findByRT(pep_id->getRT());
-      PeakSpectrum& temp = exp.getSpectrum(scan_id);
+      scan_ids[i] = lookup.findByRT(pep_ids[i].getRT());
+    }
+
+    pep_out.resize(pep_ids.size());
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < (SignedSize)pep_ids.size(); ++i)
+    {
+      const PeptideIdentification& pep_id = pep_ids[i];
+      PeakSpectrum& temp = exp.getSpectrum(scan_ids[i]);
       
       vector<PeptideHit> scored_peptides;
-      for (vector<PeptideHit>::const_iterator hit = pep_id->getHits().begin(); hit < pep_id->getHits().end(); ++hit)
+      for (vector<PeptideHit>::const_iterator hit = pep_id.getHits().begin(); hit < pep_id.getHits().end(); ++hit)
       {
         PeptideHit scored_hit = *hit;
-        addScoreToMetaValues_(scored_hit, pep_id->getScoreType()); // backup score value
+        addScoreToMetaValues_(scored_hit, pep_id.getScoreType()); // backup score value
         
-        OPENMS_LOG_DEBUG << "starting to compute AScore RT=" << pep_id->getRT() << " SEQUENCE: " << scored_hit.getSequence().toString() << std::endl;
+        OPENMS_LOG_DEBUG << "starting to compute AScore RT=" << pep_id.getRT() << " SEQUENCE: " << scored_hit.getSequence().toString() << std::endl;
         
         PeptideHit phospho_sites = ascore.compute(scored_hit, temp);
         scored_peptides.push_back(phospho_sites);
       }
 
-      PeptideIdentification new_pep_id(*pep_id);
+      PeptideIdentification new_pep_id(pep_id);
       new_pep_id.setScoreType("PhosphoScore");
       new_pep_id.setHigherScoreBetter(true);
       new_pep_id.setHits(scored_peptides);
-      pep_out.push_back(new_pep_id);
+      pep_out[i] = new_pep_id;
     }
     
     //-------------------------------------------------------------
@@ -249,6 +249,7 @@ protected:
     MzMLFile mzml_file;
     PeakMap exp;
     QCBase::SpectraMap spec_map;
+    QCBase::SpectraSummary spec_summary; // TIC, MS levels etc. gathered once per mzML and shared by the metrics
 
     // Loop through featuremaps...
     vector<PeptideIdentification> all_new_upep_ids;
@@ -261,6 +262,7 @@ protected:
       { // we either have 'n' or 1 mzML ... use the correct one in each iteration
         mzml_file.load(in_raw[i], exp);
         spec_map.calculateMap(exp);
+        spec_summary.calculate(exp);
       }
 
       ProteinIdentification::Mapping mp_f;
@@ -299,7 +301,7 @@ protected:
 
       if (qc_ms2ir.isRunnable(status))
       {
-        qc_ms2ir.compute(*fmap, exp, fdr_flag);
+        qc_ms2ir.compute(*fmap, spec_summary, fdr_flag);
       }
 
       if (qc_mz_calibration.isRunnable(status))
@@ -330,7 +332,7 @@ protected:
 
       if (qc_tic.isRunnable(status))
       {
-        qc_tic.compute(exp);
+        qc_tic.compute(spec_summary);
       }
 
       if (qc_ms2stats.isRunnable(status))
@@ -196,7 +196,6 @@ protected:
     vector<double> all_predicted_retention_times;
     map<String, double> predicted_data;
     map<AASequence, double> predicted_modified_data;
-    svm_problem* prediction_data = nullptr;
     SVMData training_samples;
     SVMData prediction_samples;
     UInt border_length = 0;
@@ -406,6 +405,29 @@ protected:
     vector<double> rts;
     rts.resize(number_of_peptides, 0);
 
+    // the training samples of the OLIGO kernel are needed for all batches
+    if (svm.getIntParameter(SVMWrapper::KERNEL_TYPE) == SVMWrapper::OLIGO && number_of_peptides > 0)
+    {
+      String in_trainset_name = getStringOption_("in_oligo_trainset");
+      if (in_trainset_name.empty())
+      {
+        in_trainset_name = svmfile_name + "_samples";
+        writeLog_("Warning: Using OLIGO kernel but in_oligo_trainset parameter is missing. Trying default filename: " + in_trainset_name);
+      }
+      inputFileReadable_(in_trainset_name, "in_oligo_trainset");
+
+      training_samples.load(in_trainset_name);
+      svm.setTrainingSample(training_samples);
+
+      svm.setParameter(SVMWrapper::BORDER_LENGTH, (Int) border_length);
+      svm.setParameter(SVMWrapper::SIGMA, sigma);
+    }
+
+    // encoded batch: each distinct peptide of a batch is encoded and predicted only once
+    vector<svm_node> prediction_nodes;
+    vector<svm_node*> prediction_vectors;
+    vector<Size> sequence_to_vector;
+
     vector<String>::iterator it_from = peptides.begin();
     vector<String>::iterator it_to = peptides.begin();
     vector<AASequence>::iterator it_from_mod = modified_peptides.begin();
@@ -427,13 +449,13 @@ protected:
         }
         temp_peptides.insert(temp_peptides.end(), it_from, it_to);
         //temp_peptides.insert(temp_peptides.end(), peptides.begin(), peptides.end());
-        temp_rts.resize(temp_peptides.size(), 0);
 
-        prediction_data =
-          encoder.encodeLibSVMProblemWithCompositionAndLengthVectors(temp_peptides,
-                                                                     temp_rts,
-                                                                     allowed_amino_acid_characters,
-                                                                     maximum_length);
+        encoder.encodeCompositionAndLengthVectors(temp_peptides,
+                                                  allowed_amino_acid_characters,
+                                                  maximum_length,
+                                                  prediction_nodes,
+                                                  prediction_vectors,
+                                                  sequence_to_vector);
         it_from = it_to;
       }
       else
@@ -445,9 +467,19 @@ protected:
         }
         temp_modified_peptides.insert(temp_modified_peptides.end(), it_from_mod, it_to_mod);
         // temp_modified_peptides.insert(temp_modified_peptides.end(), modified_peptides.begin(), modified_peptides.end());
-        temp_rts.resize(temp_modified_peptides.size(), 0);
 
-        encoder.encodeProblemWithOligoBorderVectors(temp_modified_peptides,
+        vector<AASequence> distinct_peptides;
+        map<AASequence, Size> distinct_index;
+        sequence_to_vector.clear();
+        for (const AASequence& peptide : temp_modified_peptides)
+        {
+          auto it = distinct_index.emplace(peptide, distinct_peptides.size());
+          if (it.second) distinct_peptides.push_back(peptide);
+          sequence_to_vector.push_back(it.first->second);
+        }
+        temp_rts.resize(distinct_peptides.size(), 0);
+
+        encoder.encodeProblemWithOligoBorderVectors(distinct_peptides,
                                                     k_mer_length,
                                                     allowed_amino_acid_characters,
                                                     border_length,
@@ -457,29 +489,23 @@ protected:
       }
       counter += temp_counter;
 
+      vector<double> distinct_retention_times;
       if (svm.getIntParameter(SVMWrapper::KERNEL_TYPE) == SVMWrapper::OLIGO)
       {
-        String in_trainset_name = getStringOption_("in_oligo_trainset");
-        if (in_trainset_name.empty())
-        {
-          in_trainset_name = svmfile_name + "_samples";
-          writeLog_("Warning: Using OLIGO kernel but in_oligo_trainset parameter is missing. Trying default filename: " + in_trainset_name);
-        }
-        inputFileReadable_(in_trainset_name, "in_oligo_trainset");
-
-        training_samples.load(in_trainset_name);
-        svm.setTrainingSample(training_samples);
-
-        svm.setParameter(SVMWrapper::BORDER_LENGTH, (Int) border_length);
-        svm.setParameter(SVMWrapper::SIGMA, sigma);
-        svm.predict(prediction_samples, predicted_retention_times);
+        svm.predict(prediction_samples, distinct_retention_times);
         prediction_samples.labels.clear();
         prediction_samples.sequences.clear();
       }
       else
       {
-        svm.predict(prediction_data, predicted_retention_times);
-        LibSVMEncoder::destroyProblem(prediction_data);
+        svm.predict(prediction_vectors, distinct_retention_times);
+      }
+      if (!distinct_retention_times.empty())
+      {
+        for (Size index : sequence_to_vector)
+        {
+          predicted_retention_times.push_back(distinct_retention_times[index]);
+        }
       }
       for (Size i = 0; i < temp_counter; ++i)
       {
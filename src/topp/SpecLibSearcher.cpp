@@ -39,6 +39,7 @@
 #include <OpenMS/CONCEPT/Factory.h>
 #include <OpenMS/COMPARISON/SPECTRA/BinnedSpectrum.h>
 #include <OpenMS/COMPARISON/SPECTRA/SpectraSTSimilarityScore.h>
+#include <OpenMS/COMPARISON/SPECTRA/SpectralLibraryIndex.h>
 #include <OpenMS/COMPARISON/SPECTRA/ZhangSimilarityScore.h>
 #include <OpenMS/FORMAT/IdXMLFile.h>
 #include <OpenMS/FORMAT/MSPFile.h>
@@ -163,15 +164,13 @@ protected:
     addEmptyLine_();
   }
 
-  using MapLibraryPrecursorToLibrarySpectrum = multimap<double, PeakSpectrum>;
-    
-  MapLibraryPrecursorToLibrarySpectrum annotateIdentificationsToSpectra_(const vector<PeptideIdentification>& ids, 
+  vector<PeakSpectrum> annotateIdentificationsToSpectra_(const vector<PeptideIdentification>& ids, 
     const PeakMap& library, 
     StringList variable_modifications, 
     StringList fixed_modifications,
     double remove_peaks_below_threshold)
   {
-    MapLibraryPrecursorToLibrarySpectrum annotated_lib;
+    vector<PeakSpectrum> annotated_lib;
 
     ModificationsDB* mdb = ModificationsDB::getInstance();
 
@@ -182,7 +181,6 @@ protected:
     for (; library_it < library.end(); ++library_it, ++id_it)
     {
       const MSSpectrum& lib_spec = *library_it;
-      const double& precursor_MZ = lib_spec.getPrecursors()[0].getMZ();
 
       const PeptideIdentification& id = *id_it;
       const AASequence& aaseq = id.getHits()[0].getSequence();
@@ -263,7 +261,7 @@ protected:
            lib_entry.push_back(peak);
          }
        }
-       annotated_lib.insert(make_pair(precursor_MZ, lib_entry));
+       annotated_lib.push_back(lib_entry);
      }
     return annotated_lib;
   }
@@ -352,7 +350,11 @@ protected:
     cout << endl;
     */
 
-    MapLibraryPrecursorToLibrarySpectrum mslib = annotateIdentificationsToSpectra_(ids, library, variable_modifications, fixed_modifications, remove_peaks_below_threshold);
+    vector<PeakSpectrum> mslib = annotateIdentificationsToSpectra_(ids, library, variable_modifications, fixed_modifications, remove_peaks_below_threshold);
+
+    // precursor index over the library; SpectraST compares binned spectra, so bin each library entry only once
+    const bool spectrast_score = compare_function == "SpectraSTSimilarityScore";
+    SpectralLibraryIndex mslib_index(mslib, spectrast_score);
 
     time_t end_build_time = time(nullptr);
     OPENMS_LOG_INFO << "Time needed for preprocessing data: " << (end_build_time - start_build_time) << "\n";
@@ -363,7 +365,6 @@ protected:
    //-------------------------------------------------------------
     // calculations
     //-------------------------------------------------------------
-    double score;
     StringList::iterator in, out_file;
     for (in  = in_spec.begin(), out_file  = out.begin(); in < in_spec.end(); ++in, ++out_file)
     {
@@ -401,21 +402,31 @@ protected:
 
 
       /***********SEARCH**********/
-      for (UInt j = 0; j < query.size(); ++j)
+      // query spectra are scored independently; results are collected per query and reported in query order
+      vector<PeptideIdentification> query_results(query.size());
+      vector<char> query_reported(query.size(), 0);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (SignedSize js = 0; js < (SignedSize)query.size(); ++js)
       {
+        const Size j = (Size)js;
+
         //Set identifier for each identifications
-        PeptideIdentification pid;
+        PeptideIdentification& pid = query_results[j];
         pid.setIdentifier("test");
         pid.setScoreType(compare_function);
-        ProteinHit pr_hit;
-        pr_hit.setAccession(j);
-        prot_id.insertHit(pr_hit);
+        const String accession(j);
 
         // proper MS2?
         if (query[j].empty() || query[j].getMSLevel() != 2) {continue; }
 
         if (query[j].getPrecursors().empty())
         {
+#ifdef _OPENMP
+#pragma omp critical (SpecLibSearcher_log)
+#endif
           writeLog_("Warning MS2 spectrum without precursor information");
           continue;
         }
@@ -458,6 +469,12 @@ protected:
         
         if (query_charge > 0 && (query_charge < pc_min_charge || query_charge > pc_max_charge)) { continue; } 
 
+        BinnedSpectrum quer_bin_spec;
+        if (spectrast_score)
+        {
+          quer_bin_spec = SpectraSTSimilarityScore().transform(filtered_query);
+        }
+
         for (auto const & iso : isotopes)
         {
           // isotopic misassignment corrected query
@@ -492,30 +509,28 @@ protected:
 
 
           // determine MS2 precursors that match to the current peptide mass
-          MapLibraryPrecursorToLibrarySpectrum::const_iterator low_it, up_it;
-        
-          low_it = mslib.lower_bound(ic_query_mz - 0.5 * precursor_mass_tolerance_mz);
-          up_it = mslib.upper_bound(ic_query_mz + 0.5 * precursor_mass_tolerance_mz);
+          std::pair<SpectralLibraryIndex::ConstIterator, SpectralLibraryIndex::ConstIterator> candidates =
+            mslib_index.findByPrecursorMZ(ic_query_mz - 0.5 * precursor_mass_tolerance_mz, ic_query_mz + 0.5 * precursor_mass_tolerance_mz);
         
           // no matching precursor in data
-          if (low_it == up_it) { continue; }
+          if (candidates.first == candidates.second) { continue; }
        
-          for (; low_it != up_it; ++low_it)
+          for (SpectralLibraryIndex::ConstIterator low_it = candidates.first; low_it != candidates.second; ++low_it)
           {
-            const PeakSpectrum& lib_spec = low_it->second;;
+            const PeakSpectrum& lib_spec = mslib[low_it->second];
             PeptideHit hit = lib_spec.getPeptideIdentifications()[0].getHits()[0];
             const int& lib_charge = hit.getCharge();  
 
             // check if charge state between library and experimental spectrum match
             if (query_charge > 0 && lib_charge != query_charge) { continue; }
 
+            double score;
             // Special treatment for SpectraST score as it computes a score based on the whole library
-            if (compare_function == "SpectraSTSimilarityScore")
+            if (spectrast_score)
             {
-              SpectraSTSimilarityScore* sp = static_cast<SpectraSTSimilarityScore*>(comparor);
-              BinnedSpectrum quer_bin_spec = sp->transform(filtered_query);
-              BinnedSpectrum lib_bin_spec = sp->transform(lib_spec);
-              score = (*sp)(filtered_query, lib_spec); //(*sp)(quer_bin,librar_bin);
+              const SpectraSTSimilarityScore* sp = static_cast<const SpectraSTSimilarityScore*>(comparor);
+              const BinnedSpectrum& lib_bin_spec = mslib_index.getBinnedSpectrum(low_it->second);
+              score = (*sp)(quer_bin_spec, lib_bin_spec); // normalized dot product
               double dot_bias = sp->dot_bias(quer_bin_spec, lib_bin_spec, score);
               hit.setMetaValue("DOTBIAS", dot_bias);
             }
@@ -531,7 +546,7 @@ protected:
             hit.setMetaValue(Constants::UserParam::ISOTOPE_ERROR, iso);
             hit.setScore(score);
             PeptideEvidence pe;
-            pe.setProteinAccession(pr_hit.getAccession());
+            pe.setProteinAccession(accession);
             hit.addPeptideEvidence(pe);
             pid.insertHit(hit);
           }
@@ -540,7 +555,7 @@ protected:
         pid.setHigherScoreBetter(true);
         pid.sort();
 
-        if (compare_function == "SpectraSTSimilarityScore")
+        if (spectrast_score)
         {
           if (!pid.empty() && !pid.getHits().empty())
           {
@@ -575,7 +590,15 @@ protected:
         {
           pid.getHits().resize(top_hits);
         }
-        peptide_ids.push_back(pid);
+        query_reported[j] = 1;
+      }
+
+      for (Size j = 0; j < query.size(); ++j)
+      {
+        ProteinHit pr_hit;
+        pr_hit.setAccession(j);
+        prot_id.insertHit(pr_hit);
+        if (query_reported[j]) peptide_ids.push_back(query_results[j]);
       }
       protein_ids.push_back(prot_id);
 
@@ -34,6 +34,7 @@
 
 #include <OpenMS/FORMAT/IdXMLFile.h>
 #include <OpenMS/FORMAT/FASTAFile.h>
+#include <OpenMS/DATASTRUCTURES/FASTAContainer.h>
 #include <OpenMS/METADATA/ProteinIdentification.h>
 #include <OpenMS/CHEMISTRY/ModificationsDB.h>
 #include <OpenMS/CHEMISTRY/ProteaseDB.h>
@@ -42,6 +43,10 @@
 #include <OpenMS/CHEMISTRY/DigestionEnzyme.h>
 #include <OpenMS/APPLICATIONS/TOPPBase.h>
 #include <boost/regex.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+
+#include <exception>
 
 using namespace OpenMS;
 using namespace std;
@@ -72,6 +77,9 @@ using namespace std;
 
   The tool will keep track of all protein identifiers and report duplicates.
 
+  The input is streamed in chunks, and the decoys of each chunk are computed in parallel (see @p threads).
+  Output order and decoy sequences do not depend on the number of threads, since every entry is shuffled using the same seed.
+
   <B>The command line parameters of this tool are:</B>
   @verbinclude UTILS_DecoyDatabase.cli
   <B>INI file documentation of this tool:</B>
@@ -183,10 +191,6 @@ protected:
 
     set<String> identifiers; // spot duplicate identifiers  // std::unordered_set<string> has slightly more RAM, but slightly less CPU
 
-    FASTAFile f;
-    f.writeStart(out);
-    FASTAFile::FASTAEntry entry;
-
     // Configure Enzymatic digestion
     // TODO: allow user-specified regex
     ProteaseDigestion digestion;
@@ -199,125 +203,211 @@ protected:
     MRMDecoy m;
     m.setParameters(decoy_param);
 
-    for (Size i = 0; i < in.size(); ++i)
+    const boost::regex rna_token("[^\\[]|(\\[[^\\[\\]]*\\])");
+
+    // computes the decoy of a single entry; only reads shared state (the random generators are local
+    // and seeded with the same seed for every entry), thus it may be called by many threads at once
+    // and the result does not depend on the number of threads
+    auto makeDecoy = [&](const FASTAFile::FASTAEntry& target)
     {
-      f.readStart(in[i]);
+      FASTAFile::FASTAEntry entry = target;
 
-      //-------------------------------------------------------------
-      // calculations
-      //-------------------------------------------------------------
-      while (f.readNext(entry))
+      // identifier
+      entry.identifier = getIdentifier_(entry.identifier, decoy_string, decoy_string_position_prefix);
+
+      // sequence
+      if (input_type == SeqType::RNA)
       {
-        if (identifiers.find(entry.identifier) != identifiers.end())
+        string quick_seq = entry.sequence;
+        bool five_p = (entry.sequence.front() == 'p');
+        bool three_p = (entry.sequence.back() == 'p');
+        if (five_p) //we don't want to reverse terminal phosphates
         {
-          OPENMS_LOG_WARN << "DecoyDatabase: Warning, identifier '" << entry.identifier << "' occurs more than once!" << endl;
+          quick_seq.erase(0, 1);
         }
-        identifiers.insert(entry.identifier);
-
-        if (append)
+        if (three_p)
         {
-          f.writeNext(entry);
+          quick_seq.pop_back();
+        }
+        vector<String> tokenized;
+        boost::smatch m;
+        while (boost::regex_search(quick_seq, m, rna_token))
+        {
+          tokenized.push_back(m.str(0));
+          quick_seq = m.suffix();
         }
 
-        // identifier
-        entry.identifier = getIdentifier_(entry.identifier, decoy_string, decoy_string_position_prefix);
-
-        // sequence
-        if (input_type == SeqType::RNA)
+        if (shuffle)
         {
-          string quick_seq = entry.sequence;
-          bool five_p = (entry.sequence.front() == 'p');
-          bool three_p = (entry.sequence.back() == 'p');
-          if (five_p) //we don't want to reverse terminal phosphates
-          {
-            quick_seq.erase(0, 1);
-          }
-          if (three_p)
+          // portable Fisher-Yates shuffle (std::random_shuffle differs between standard libraries)
+          boost::mt19937 generator(seed);
+          for (Size x = tokenized.size(); x > 1; --x)
           {
-            quick_seq.pop_back();
+            boost::random::uniform_int_distribution<Size> dist(0, x - 1);
+            swap(tokenized[x - 1], tokenized[dist(generator)]);
           }
-          vector<String> tokenized;
-          boost::smatch m;
-          while (boost::regex_search(quick_seq, m, boost::regex("[^\\[]|(\\[[^\\[\\]]*\\])")))
+        }
+        else  // reverse
+        {
+          reverse(tokenized.begin(), tokenized.end()); //reverse the tokens
+        }
+        if (five_p)  //add back 5'
+        {
+          tokenized.insert(tokenized.begin(), String("p"));
+        }
+        if (three_p) //add back 3'
+        {
+          tokenized.push_back(String("p"));
+        }
+        entry.sequence = ListUtils::concatenate(tokenized, "");
+      }
+      else // protein input
+      {
+        // if (terminal_aminos != "none")
+        if (enzyme != "no cleavage" && (keepN || keepC))
+        {
+          std::vector<AASequence> peptides;
+          digestion.digest(AASequence::fromString(entry.sequence), peptides);
+          String new_sequence = "";
+          for (auto const& peptide : peptides)
           {
-            tokenized.push_back(m.str(0));
-            quick_seq = m.suffix();
+            if (shuffle)
+            {
+              OpenMS::TargetedExperiment::Peptide p;
+              p.sequence = peptide.toString();
+              OpenMS::TargetedExperiment::Peptide decoy_p = m.shufflePeptide(p, identity_threshold, seed, max_attempts);
+              new_sequence += decoy_p.sequence;
+            }
+            else
+            {
+              OpenMS::TargetedExperiment::Peptide p;
+              p.sequence = peptide.toString();
+              OpenMS::TargetedExperiment::Peptide decoy_p = MRMDecoy::reversePeptide(p, keepN, keepC, keep_const_pattern);
+              new_sequence += decoy_p.sequence;
+            }
           }
-
+          entry.sequence = new_sequence;
+        }
+        else
+        {
+          // sequence
           if (shuffle)
           {
-            srand(seed);
-            random_shuffle(tokenized.begin(), tokenized.end());
-          }
-          else  // reverse
-          {
-            reverse(tokenized.begin(), tokenized.end()); //reverse the tokens
-          }
-          if (five_p)  //add back 5'
-          {
-            tokenized.insert(tokenized.begin(), String("p"));
+            String temp;
+            Size x = entry.sequence.size();
+            boost::mt19937 generator(seed); // identical proteins are shuffled the same way
+            while (x != 0)
+            {
+              boost::random::uniform_int_distribution<Size> dist(0, x - 1);
+              Size y = dist(generator);
+              temp += entry.sequence[y];
+              --x;
+              entry.sequence[y] = entry.sequence[x]; // overwrite consumed position with last position (about to go out of scope for next dice roll)
+            }
+            entry.sequence = temp;
           }
-          if (three_p) //add back 3'
+          else // reverse
           {
-            tokenized.push_back(String("p"));
+            entry.sequence.reverse();
           }
-          entry.sequence = ListUtils::concatenate(tokenized, "");
         }
-        else // protein input
+      }
+      return entry;
+    };
+
+    FASTAFile f;
+    f.writeStart(out);
+
+    // Entries are read (and written) in chunks by a single thread, while the decoys of the active chunk are
+    // computed in parallel. Output order is the input order, thus memory is bounded by the chunk size.
+    const size_t PROTEIN_CACHE_SIZE = 1e5;
+
+    for (Size i = 0; i < in.size(); ++i)
+    {
+      FASTAContainer<TFI_File> proteins(in[i]);
+      proteins.cacheChunk(PROTEIN_CACHE_SIZE);
+
+      vector<FASTAFile::FASTAEntry> decoys;
+      bool has_active_data = true;
+      std::exception_ptr error;
+
+      //-------------------------------------------------------------
+      // calculations
+      //-------------------------------------------------------------
+      #pragma omp parallel
+      {
+        while (true)
         {
-          // if (terminal_aminos != "none")
-          if (enzyme != "no cleavage" && (keepN || keepC))
+          #pragma omp barrier // all decoys of the active chunk are computed, prefetching is done
+
+          #pragma omp single
           {
-            std::vector<AASequence> peptides;
-            digestion.digest(AASequence::fromString(entry.sequence), peptides);
-            String new_sequence = "";
-            for (auto const& peptide : peptides)
+            try
             {
-              if (shuffle)
+              //-------------------------------------------------------------
+              // writing output (of the previous chunk)
+              //-------------------------------------------------------------
+              for (Size j = 0; j < decoys.size(); ++j)
               {
-                OpenMS::TargetedExperiment::Peptide p;
-                p.sequence = peptide.toString();
-                OpenMS::TargetedExperiment::Peptide decoy_p = m.shufflePeptide(p, identity_threshold, seed, max_attempts);
-                new_sequence += decoy_p.sequence;
+                if (append)
+                {
+                  f.writeNext(proteins.chunkAt(j));
+                }
+                f.writeNext(decoys[j]);
               }
-              else
+
+              has_active_data = !error && proteins.activateCache();
+              decoys.assign(proteins.chunkSize(), FASTAFile::FASTAEntry());
+
+              for (Size j = 0; j < proteins.chunkSize(); ++j)
               {
-                OpenMS::TargetedExperiment::Peptide p;
-                p.sequence = peptide.toString();
-                OpenMS::TargetedExperiment::Peptide decoy_p = MRMDecoy::reversePeptide(p, keepN, keepC, keep_const_pattern);
-                new_sequence += decoy_p.sequence;
+                const String& identifier = proteins.chunkAt(j).identifier;
+                if (!identifiers.insert(identifier).second)
+                {
+                  OPENMS_LOG_WARN << "DecoyDatabase: Warning, identifier '" << identifier << "' occurs more than once!" << endl;
+                }
               }
             }
-            entry.sequence = new_sequence;
+            catch (...)
+            {
+              error = std::current_exception();
+              has_active_data = false;
+            }
+          } // implicit barrier here
+
+          if (!has_active_data) break; // leave while-loop
+
+          #pragma omp master
+          {
+            try
+            {
+              proteins.cacheChunk(PROTEIN_CACHE_SIZE);
+            }
+            catch (...)
+            {
+              #pragma omp critical (DecoyDatabase_error)
+              if (!error) error = std::current_exception();
+            }
           }
-          else
+
+          const SignedSize prot_count = (SignedSize)proteins.chunkSize();
+          #pragma omp for schedule(dynamic, 100) nowait
+          for (SignedSize j = 0; j < prot_count; ++j)
           {
-            // sequence
-            if (shuffle)
+            try
             {
-              String temp;
-              Size x = entry.sequence.size();
-              srand(seed); // identical proteins are shuffled the same way
-              while (x != 0)
-              {
-                Size y = rand() % x;
-                temp += entry.sequence[y];
-                --x;
-                entry.sequence[y] = entry.sequence[x]; // overwrite consumed position with last position (about to go out of scope for next dice roll)
-              }
+              decoys[j] = makeDecoy(proteins.chunkAt(j));
             }
-            else // reverse
+            catch (...)
             {
-              entry.sequence.reverse();
+              #pragma omp critical (DecoyDatabase_error)
+              if (!error) error = std::current_exception();
             }
           }
         }
+      }
 
-        //-------------------------------------------------------------
-        // writing output
-        //-------------------------------------------------------------
-        f.writeNext(entry);
-      } // next protein
+      if (error) std::rethrow_exception(error);
     } // input files
 
     return EXECUTION_OK;
@@ -77,6 +77,7 @@
 
 // post-processing of results
 #include <OpenMS/ANALYSIS/ID/FalseDiscoveryRate.h>
+#include <OpenMS/ANALYSIS/ID/PrecursorMassIndex.h>
 #include <OpenMS/FILTERING/ID/IDFilter.h>
 
 
@@ -1030,8 +1031,8 @@ protected:
     OPENMS_LOG_DEBUG << "preprocessed spectra: " << spectra.getNrSpectra()
                      << endl;
 
-    // build multimap of precursor mass to scan index (and other information):
-    multimap<double, PrecursorInfo> precursor_mass_map;
+    // build index of precursor mass to scan index (and other information):
+    PrecursorMassIndex<PrecursorInfo> precursor_mass_index;
     for (PeakMap::ConstIterator s_it = spectra.begin(); s_it != spectra.end();
          ++s_it)
     {
@@ -1092,11 +1093,12 @@ protected:
                                       negative_mode);
             PrecursorInfo info(scan_index, precursor_charge, isotope_number,
                                adduct_pair.second);
-            precursor_mass_map.insert(make_pair(precursor_mass, info));
+            precursor_mass_index.add(precursor_mass, info);
           }
         }
       }
     }
+    precursor_mass_index.build();
 
     // create spectrum generator
     NucleicAcidSpectrumGenerator spectrum_generator;
@@ -1190,6 +1192,13 @@ protected:
         variable_modifications, ns, max_variable_mods_per_oligo,
         all_modified_oligos, true);
 
+      // modified oligos are looked up in ascending mass order
+      PrecursorMassIndex<PrecursorInfo>::Cursor precursor_cursor(precursor_mass_index);
+
+      // fragment ladder of the unmodified oligo, shared by all variants (built on first use):
+      NucleicAcidSpectrumGenerator::FragmentLadder ladder;
+      bool have_ladder = false;
+
       // group modified oligos by precursor mass - oligos with the same
       // combination of mods (just different placements) will have same mass:
       map<double, vector<const NASequence*>> modified_oligos_by_mass;
@@ -1210,17 +1219,16 @@ protected:
         {
           tol *= candidate_mass * 1e-6;
         }
-        multimap<double, PrecursorInfo>::const_iterator low_it =
-          precursor_mass_map.lower_bound(candidate_mass - tol), up_it =
-          precursor_mass_map.upper_bound(candidate_mass + tol);
+        const PrecursorMassIndex<PrecursorInfo>::Range precursor_range =
+          precursor_cursor.getRange(candidate_mass - tol, candidate_mass + tol);
 
-        if (low_it == up_it) continue; // no matching precursor in data
+        if (precursor_range.first == precursor_range.second) continue; // no matching precursor in data
 
         // collect all relevant charge states for theoret. spectrum generation:
         set<Int> precursor_charges;
-        for (auto prec_it = low_it; prec_it != up_it; ++prec_it) // OMS_CODING_TEST_EXCLUDE
+        for (Size prec_pos = precursor_range.first; prec_pos != precursor_range.second; ++prec_pos)
         {
-          precursor_charges.insert(prec_it->second.charge * base_charge);
+          precursor_charges.insert(precursor_mass_index.getValue(prec_pos).charge * base_charge);
         }
 
         for (const NASequence* seq_ptr : pair.second)
@@ -1230,22 +1238,28 @@ protected:
                            << float(candidate_mass) << " Da)" << endl;
 
           // pre-generate spectra:
+          if (!have_ladder)
+          {
+            ladder = spectrum_generator.getLadder(ns);
+            have_ladder = true;
+          }
           map<Int, MSSpectrum> theo_spectra_by_charge;
-          spectrum_generator.getMultipleSpectra(theo_spectra_by_charge,
+          spectrum_generator.getMultipleSpectra(theo_spectra_by_charge, ladder,
                                                 candidate, precursor_charges,
                                                 base_charge);
 
-          for (auto prec_it = low_it; prec_it != up_it; ++prec_it) // OMS_CODING_TEST_EXCLUDE
+          for (Size prec_pos = precursor_range.first; prec_pos != precursor_range.second; ++prec_pos)
           {
             OPENMS_LOG_DEBUG << "Matching precursor mass: "
-                             << float(prec_it->first) << endl;
+                             << float(precursor_mass_index.getMass(prec_pos)) << endl;
 
-            Size charge = prec_it->second.charge;
+            const PrecursorInfo& precursor_info = precursor_mass_index.getValue(prec_pos);
+            Size charge = precursor_info.charge;
             // look up theoretical spectrum for this charge:
             MSSpectrum& theo_spectrum =
               theo_spectra_by_charge[charge * base_charge];
 
-            Size scan_index = prec_it->second.scan_index;
+            Size scan_index = precursor_info.scan_index;
             const MSSpectrum& exp_spectrum = spectra[scan_index];
             vector<PeptideHit::PeakAnnotation> annotations;
             double score = MetaboliteSpectralMatching::computeHyperScore(
@@ -1303,9 +1317,9 @@ protected:
                 ah.sequence = candidate;
                 // @TODO: is "observed - calculated" the right way around?
                 ah.precursor_error_ppm =
-                  (prec_it->first - candidate_mass) / candidate_mass * 1.0e6;
+                  (precursor_mass_index.getMass(prec_pos) - candidate_mass) / candidate_mass * 1.0e6;
                 ah.annotations = annotations;
-                ah.precursor_ref = &(prec_it->second);
+                ah.precursor_ref = &precursor_info;
               }
             }
           }
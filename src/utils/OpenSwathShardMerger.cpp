@@ -0,0 +1,109 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/APPLICATIONS/TOPPBase.h>
+#include <OpenMS/FORMAT/OSWFile.h>
+
+using namespace OpenMS;
+using namespace std;
+
+//-------------------------------------------------------------
+//Doxygen docu
+//-------------------------------------------------------------
+
+/**
+  @page UTILS_OpenSwathShardMerger OpenSwathShardMerger
+
+  @brief Merges the OSW files of a run that was analyzed in shards by OpenSwathWorkflow.
+
+  Large assay libraries can be split into shards that are analyzed
+  independently (e.g. on different cluster nodes) by running OpenSwathWorkflow
+  with the same input for every value of <i>shard_index</i> and the same
+  <i>shard_count</i>. This tool combines the resulting OSW files into a single
+  file, which can then be scored with PyProphet or PercolatorAdapter as if the
+  run had been analyzed in one go.
+
+  The output is only written if all shards could be merged.
+
+  <B>The command line parameters of this tool are:</B>
+  @verbinclude UTILS_OpenSwathShardMerger.cli
+  <B>INI file documentation of this tool:</B>
+  @htmlinclude UTILS_OpenSwathShardMerger.html
+
+*/
+
+// We do not want this class to show up in the docu:
+/// @cond TOPPCLASSES
+
+class TOPPOpenSwathShardMerger
+  : public TOPPBase
+{
+public:
+
+  TOPPOpenSwathShardMerger()
+    : TOPPBase("OpenSwathShardMerger", "Merges the OSW files of the library shards of one run.", false)
+  {
+  }
+
+protected:
+
+  void registerOptionsAndFlags_() override
+  {
+    registerInputFileList_("in", "<files>", StringList(), "OSW files of all shards of one run (unscored)");
+    setValidFormats_("in", ListUtils::create<String>("osw"));
+
+    registerOutputFile_("out", "<file>", "", "Merged OSW file");
+    setValidFormats_("out", ListUtils::create<String>("osw"));
+  }
+
+  ExitCodes main_(int, const char **) override
+  {
+    StringList in = getStringList_("in");
+    String out = getStringOption_("out");
+
+    OSWFile osw;
+    osw.mergeShards(std::vector<std::string>(in.begin(), in.end()), out);
+
+    return EXECUTION_OK;
+  }
+
+};
+
+int main(int argc, const char ** argv)
+{
+  TOPPOpenSwathShardMerger tool;
+  return tool.main(argc, argv);
+}
+
+/// @endcond
@@ -52,6 +52,7 @@
 #include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathTSVWriter.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathOSWWriter.h>
 #include <OpenMS/SYSTEM/File.h>
+#include <OpenMS/CONCEPT/UniqueIdGenerator.h>
 
 // Kernel and implementations
 #include <OpenMS/KERNEL/MSExperiment.h>
@@ -146,6 +147,7 @@ using namespace OpenMS;
       <li> @ref OpenMS::TraMLFile "TraML" </li>
       <li> @ref OpenMS::TransitionTSVFile "OpenSWATH TSV transition lists" </li>
       <li> @ref OpenMS::TransitionPQPFile "OpenSWATH PQP SQLite files" </li>
+      <li> @ref OpenMS::TransitionBinaryFile "OpenSWATH binary transition libraries" (fastest to load) </li>
       <li> SpectraST MRM transition lists </li>
       <li> Skyline transition lists </li>
       <li> Spectronaut transition lists </li>
@@ -433,14 +435,14 @@ protected:
     registerInputFileList_("in", "<files>", StringList(), "Input files separated by blank");
     setValidFormats_("in", ListUtils::create<String>("mzML,mzXML,sqMass"));
 
-    registerInputFile_("tr", "<file>", "", "transition file ('TraML','tsv','pqp')");
-    setValidFormats_("tr", ListUtils::create<String>("traML,tsv,pqp"));
+    registerInputFile_("tr", "<file>", "", "transition file ('TraML','tsv','pqp','trbin')");
+    setValidFormats_("tr", ListUtils::create<String>("traML,tsv,pqp,trbin"));
     registerStringOption_("tr_type", "<type>", "", "input file type -- default: determined from file extension or content\n", false);
-    setValidStrings_("tr_type", ListUtils::create<String>("traML,tsv,pqp"));
+    setValidStrings_("tr_type", ListUtils::create<String>("traML,tsv,pqp,trbin"));
 
     // one of the following two needs to be set
     registerInputFile_("tr_irt", "<file>", "", "transition file ('TraML')", false);
-    setValidFormats_("tr_irt", ListUtils::create<String>("traML,tsv,pqp"));
+    setValidFormats_("tr_irt", ListUtils::create<String>("traML,tsv,pqp,trbin"));
 
     // one of the following two needs to be set
     registerInputFile_("tr_irt_nonlinear", "<file>", "", "additional nonlinear transition file ('TraML')", false);
@@ -527,11 +529,16 @@ protected:
 
     registerIntOption_("batchSize", "<number>", 250, "The batch size of chromatograms to process (0 means to only have one batch, sensible values are around 250-1000)", false, true);
     setMinInt_("batchSize", 0);
-    registerIntOption_("outer_loop_threads", "<number>", -1, "How many threads should be used for the outer loop (-1 use all threads, use 4 to analyze 4 SWATH windows in memory at once).", false, true);
+    registerIntOption_("outer_loop_threads", "<number>", -1, "How many SWATH windows should be analyzed concurrently (-1 no limit, use 4 to analyze 4 SWATH windows in memory at once). All threads are shared between these windows.", false, true);
 
     registerIntOption_("ms1_isotopes", "<number>", 0, "The number of MS1 isotopes used for extraction", false, true);
     setMinInt_("ms1_isotopes", 0);
 
+    registerIntOption_("shard_count", "<number>", 1, "Split the assay library into this many shards of similar size and only analyze one of them (see 'shard_index'). Allows distributing one run over several processes or nodes; merge the resulting OSW files with OpenSwathShardMerger before scoring.", false, true);
+    setMinInt_("shard_count", 1);
+    registerIntOption_("shard_index", "<number>", 0, "Index (0-based) of the library shard to analyze, needs to be smaller than 'shard_count'", false, true);
+    setMinInt_("shard_index", 0);
+
     registerSubsection_("Scoring", "Scoring parameters section");
     registerSubsection_("Library", "Library parameters section");
 
@@ -688,6 +695,8 @@ protected:
     int batchSize = (int)getIntOption_("batchSize");
     int outer_loop_threads = (int)getIntOption_("outer_loop_threads");
     int ms1_isotopes = (int)getIntOption_("ms1_isotopes");
+    Size shard_count = (Size)getIntOption_("shard_count");
+    Size shard_index = (Size)getIntOption_("shard_index");
     Size debug_level = (Size)getIntOption_("debug");
 
     double min_rsq = getDoubleOption_("min_rsq");
@@ -734,6 +743,12 @@ protected:
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
           "Either out_features, out_tsv or out_osw needs to be set (but not two or three at the same time)");
     }
+    if (shard_index >= shard_count)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "Parameter 'shard_index' needs to be smaller than 'shard_count'");
+    }
+
     if (!out_osw.empty() && tr_type != FileTypes::PQP)
     {
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
@@ -805,6 +820,18 @@ protected:
     OPENMS_LOG_INFO << "Loaded " << transition_exp.getProteins().size() << " proteins, " <<
       transition_exp.getCompounds().size() << " compounds with " << transition_exp.getTransitions().size() << " transitions." << std::endl;
 
+    if (shard_count > 1)
+    {
+      OpenSwath::LightTargetedExperiment shard_exp;
+      OpenSwathHelper::selectShard(transition_exp, shard_exp, shard_index, shard_count);
+      transition_exp = shard_exp;
+      OPENMS_LOG_INFO << "Analyzing shard " << shard_index + 1 << " of " << shard_count << ": " << transition_exp.getProteins().size() << " proteins, " <<
+        transition_exp.getCompounds().size() << " compounds with " << transition_exp.getTransitions().size() << " transitions." << std::endl;
+
+      // shards of the same run must not produce the same unique ids (e.g. when started at the same time or in test mode)
+      UniqueIdGenerator::setSeed(UniqueIdGenerator::getSeed() + shard_index);
+    }
+
     if (tr_type == FileTypes::PQP)
     {
       remove(out_osw.c_str());
@@ -85,6 +85,14 @@
 #include <OpenMS/ANALYSIS/ID/PeptideIndexing.h>
 #include <OpenMS/ANALYSIS/ID/IDMergerAlgorithm.h>
 
+#include <QCryptographicHash>
+#include <QDir>
+
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <sstream>
+
 using namespace OpenMS;
 using namespace std;
 using Internal::IDBoostGraph;
@@ -134,6 +142,15 @@ using Internal::IDBoostGraph;
   // - change percentage of missingness in ID transfer
   // - disable elution peak fit
 
+  Checkpoints:
+         If 'checkpoint_dir' is set, the feature map of each MS run (including its identifications) and the
+         RT transformations of each fraction are stored in this directory. Their file names are derived from a hash
+         of the content of the input files and of all parameters of the corresponding stage (and of the previous stages).
+         A rerun with changed parameters or inputs thus only recomputes the affected stages, results of unchanged
+         stages are loaded from the directory. Old checkpoints are never removed automatically.
+
+         Independent fractions are processed in parallel.
+
   Potential scripts to perform the search can be found under src/tests/topp/ProteomicsLFQTestScripts
  **/
 
@@ -228,6 +245,11 @@ protected:
     registerStringOption_("mass_recalibration", "<option>", "false", "Mass recalibration.", false, true);
     setValidStrings_("mass_recalibration", ListUtils::create<String>("true,false"));
 
+    registerStringOption_("checkpoint_dir", "<directory>", "",
+      "Directory for intermediate results (feature maps of the MS runs, RT transformations). "
+      "Results are identified by a hash of the input files and the parameters that affect them, "
+      "reruns reuse all results whose inputs and parameters did not change.", false, true);
+
 
     /// TODO: think about export of quality control files (qcML?)
 
@@ -415,11 +437,7 @@ protected:
     MZTrafoModel::MODELTYPE md = MZTrafoModel::LINEAR;
     bool use_RANSAC = true;
 
-    Size RANSAC_initial_points = (md == MZTrafoModel::LINEAR) ? 2 : 3;
-    Math::RANSACParam p(RANSAC_initial_points, 70, 10, 30, true); // TODO: check defaults (taken from tool)
-    MZTrafoModel::setRANSACParams(p);
-    // these limits are a little loose, but should prevent grossly wrong models without burdening the user with yet another parameter.
-    MZTrafoModel::setCoefficientLimits(25.0, 25.0, 0.5); 
+    // RANSAC parameters and coefficient limits are global (see setCalibrationModelLimits_())
 
     IntList ms_level = {1};
     double rt_chunk = 300.0; // 5 minutes
@@ -444,6 +462,18 @@ protected:
     }
   }
 
+  // sets the (static) RANSAC parameters and coefficient limits of MZTrafoModel used by recalibrateMasses_
+  // (done once before any fraction is processed, as fractions are processed in parallel)
+  static void setCalibrationModelLimits_()
+  {
+    MZTrafoModel::MODELTYPE md = MZTrafoModel::LINEAR;
+    Size RANSAC_initial_points = (md == MZTrafoModel::LINEAR) ? 2 : 3;
+    Math::RANSACParam p(RANSAC_initial_points, 70, 10, 30, true); // TODO: check defaults (taken from tool)
+    MZTrafoModel::setRANSACParams(p);
+    // these limits are a little loose, but should prevent grossly wrong models without burdening the user with yet another parameter.
+    MZTrafoModel::setCoefficientLimits(25.0, 25.0, 0.5); 
+  }
+
   double estimateMedianChromatographicFWHM_(MSExperiment & ms_centroided)
   {
     MassTraceDetection mt_ext;
@@ -649,18 +679,24 @@ protected:
   }
 
   // Align and link.
+  // The transformations are loaded from / stored to @p checkpoint_key (if not empty).
   // @return maximum alignment difference observed (to guide linking)
   double alignAndLink_(
     vector<FeatureMap> & feature_maps, 
     ConsensusMap & consensus_fraction,
     vector<TransformationDescription>& transformations,
-    const double median_fwhm)
+    const double median_fwhm,
+    const String& checkpoint_key)
   {
     double max_alignment_diff(0.0);
 
     if (feature_maps.size() > 1)
     {
-      max_alignment_diff = align_(feature_maps, transformations);
+      if (checkpoint_key.empty() || !loadAlignmentCheckpoint_(checkpoint_key, feature_maps.size(), transformations, max_alignment_diff))
+      {
+        max_alignment_diff = align_(feature_maps, transformations);
+        if (!checkpoint_key.empty()) storeAlignmentCheckpoint_(checkpoint_key, transformations, max_alignment_diff);
+      }
 
       transform_(feature_maps, transformations);
 
@@ -937,6 +973,185 @@ protected:
     return EXECUTION_OK;
   }
  
+  //-------------------------------------------------------------
+  // Checkpoints (see option 'checkpoint_dir')
+  //-------------------------------------------------------------
+
+  // SHA-1 of all @p parts (e.g. file hashes, parameters and keys of previous stages)
+  static String checkpointKey_(const StringList& parts)
+  {
+    QCryptographicHash crypto(QCryptographicHash::Sha1);
+    for (const String& part : parts)
+    {
+      crypto.addData(part.c_str());
+      crypto.addData("\n");
+    }
+    return String((QString)crypto.result().toHex());
+  }
+
+  // SHA-1 of the content of @p filename (computed only once per file)
+  String fileHash_(const String& filename)
+  {
+    String hash;
+#pragma omp critical (ProteomicsLFQ_file_hashes)
+    {
+      auto it = file_hashes_.find(filename);
+      if (it != file_hashes_.end()) hash = it->second;
+    }
+    if (hash.empty())
+    {
+      hash = FileHandler::computeFileHash(filename);
+#pragma omp critical (ProteomicsLFQ_file_hashes)
+      file_hashes_[filename] = hash;
+    }
+    return hash;
+  }
+
+  String paramString_(const String& prefix) const
+  {
+    std::stringstream ss;
+    ss << getParam_().copy(prefix, true);
+    return ss.str();
+  }
+
+  // key of the feature map of a single MS run (without transferred IDs)
+  String featureCheckpointKey_(const String& mz_file, const String& id_file, Size fraction, Size fraction_group)
+  {
+    return checkpointKey_({"ProteomicsLFQ features 1", mz_file, fileHash_(mz_file), id_file, fileHash_(id_file),
+      String(fraction), String(fraction_group), paramString_("Centroiding:"), paramString_("PeptideQuantification:"),
+      getStringOption_("mass_recalibration"), getStringOption_("targeted_only"), String(getDoubleOption_("seedThreshold"))});
+  }
+
+  // file name of the checkpoint @p key
+  String checkpointFile_(const String& key, const String& suffix) const
+  {
+    return checkpoint_dir_ + "/" + key + suffix;
+  }
+
+  // moves the file written under @p tmp_filename to @p filename (readers never see partially written checkpoints)
+  static void commitCheckpointFile_(const String& tmp_filename, const String& filename)
+  {
+    if (File::exists(filename)) File::remove(filename);
+    if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+    {
+      File::remove(tmp_filename);
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+  }
+
+  // stores the feature map of a single MS run together with the values it contributes to later stages
+  void storeFeatureCheckpoint_(const String& key, FeatureMap& fm, double median_fwhm, const String& id_ms_run,
+    const StringList& fixed_modifications, const StringList& variable_modifications)
+  {
+    const String filename = checkpointFile_(key, ".featureXML");
+    const String tmp_filename = checkpointFile_(key, "." + File::getUniqueName() + ".tmp.featureXML");
+    fm.setMetaValue("ProteomicsLFQ:median_fwhm", median_fwhm);
+    fm.setMetaValue("ProteomicsLFQ:id_ms_run", id_ms_run);
+    fm.setMetaValue("ProteomicsLFQ:fixed_modifications", fixed_modifications);
+    fm.setMetaValue("ProteomicsLFQ:variable_modifications", variable_modifications);
+    FeatureXMLFile().store(tmp_filename, fm);
+    for (const char* k : {"median_fwhm", "id_ms_run", "fixed_modifications", "variable_modifications"})
+    {
+      fm.removeMetaValue(String("ProteomicsLFQ:") + k);
+    }
+    commitCheckpointFile_(tmp_filename, filename);
+    writeDebug_("Stored checkpoint " + filename, 1);
+  }
+
+  // loads the feature map of a single MS run stored by storeFeatureCheckpoint_, returns false if not available
+  bool loadFeatureCheckpoint_(const String& key, FeatureMap& fm, double& median_fwhm, String& id_ms_run,
+    set<String>& fixed_modifications, set<String>& variable_modifications)
+  {
+    const String filename = checkpointFile_(key, ".featureXML");
+    if (!File::exists(filename)) return false;
+    try
+    {
+      FeatureMap loaded;
+      FeatureXMLFile().load(filename, loaded);
+      const double loaded_fwhm = loaded.getMetaValue("ProteomicsLFQ:median_fwhm");
+      const String loaded_ms_run = loaded.getMetaValue("ProteomicsLFQ:id_ms_run");
+      const StringList fixed_mods = loaded.getMetaValue("ProteomicsLFQ:fixed_modifications");
+      const StringList var_mods = loaded.getMetaValue("ProteomicsLFQ:variable_modifications");
+      for (const char* k : {"median_fwhm", "id_ms_run", "fixed_modifications", "variable_modifications"})
+      {
+        loaded.removeMetaValue(String("ProteomicsLFQ:") + k);
+      }
+
+      fm.swap(loaded);
+      median_fwhm = loaded_fwhm;
+      id_ms_run = loaded_ms_run;
+      fixed_modifications.insert(fixed_mods.begin(), fixed_mods.end());
+      variable_modifications.insert(var_mods.begin(), var_mods.end());
+    }
+    catch (Exception::BaseException& e)
+    {
+      OPENMS_LOG_WARN << "Ignoring invalid checkpoint " << filename << ": " << e.what() << endl;
+      return false;
+    }
+    OPENMS_LOG_INFO << "Using feature map from checkpoint " << filename << endl;
+    return true;
+  }
+
+  // stores the RT transformations of all runs of a fraction, the '.alignment' file is written last and marks a complete checkpoint
+  void storeAlignmentCheckpoint_(const String& key, const vector<TransformationDescription>& transformations, double max_alignment_diff)
+  {
+    for (Size i = 0; i < transformations.size(); ++i)
+    {
+      const String filename = checkpointFile_(key, "_" + String(i) + ".trafoXML");
+      const String tmp_filename = checkpointFile_(key, "_" + String(i) + "." + File::getUniqueName() + ".tmp.trafoXML");
+      TransformationXMLFile().store(tmp_filename, transformations[i]);
+      commitCheckpointFile_(tmp_filename, filename);
+    }
+
+    const String filename = checkpointFile_(key, ".alignment");
+    const String tmp_filename = filename + "." + File::getUniqueName() + ".tmp";
+    {
+      std::ofstream ofs(tmp_filename.c_str());
+      ofs.precision(17);
+      ofs << transformations.size() << "\n" << max_alignment_diff << "\n";
+      if (!ofs)
+      {
+        throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, tmp_filename);
+      }
+    }
+    commitCheckpointFile_(tmp_filename, filename);
+    writeDebug_("Stored checkpoint " + filename, 1);
+  }
+
+  // loads the RT transformations stored by storeAlignmentCheckpoint_, returns false if not available
+  bool loadAlignmentCheckpoint_(const String& key, Size nr_maps, vector<TransformationDescription>& transformations, double& max_alignment_diff)
+  {
+    const String filename = checkpointFile_(key, ".alignment");
+    if (!File::exists(filename)) return false;
+
+    std::ifstream ifs(filename.c_str());
+    Size stored_maps(0);
+    double stored_diff(0.0);
+    if (!(ifs >> stored_maps >> stored_diff) || stored_maps != nr_maps)
+    {
+      OPENMS_LOG_WARN << "Ignoring invalid checkpoint " << filename << endl;
+      return false;
+    }
+
+    vector<TransformationDescription> loaded(nr_maps);
+    try
+    {
+      for (Size i = 0; i < nr_maps; ++i)
+      {
+        TransformationXMLFile().load(checkpointFile_(key, "_" + String(i) + ".trafoXML"), loaded[i]);
+      }
+    }
+    catch (Exception::BaseException& e)
+    {
+      OPENMS_LOG_WARN << "Ignoring invalid checkpoint " << filename << ": " << e.what() << endl;
+      return false;
+    }
+    transformations.swap(loaded);
+    max_alignment_diff = stored_diff;
+    OPENMS_LOG_INFO << "Using RT transformations from checkpoint " << filename << endl;
+    return true;
+  }
+
   ExitCodes quantifyFraction_(
     const pair<unsigned int, std::vector<String> > & ms_files, 
     const map<String, String>& mzfile2idfile, 
@@ -961,10 +1176,53 @@ protected:
     StringList id_MS_run_ref;
     StringList in_MS_run = ms_files.second;
 
+    // checkpoint keys: the feature maps without transferred IDs depend only on the inputs of their run,
+    // the alignment and the requantification (with transferred IDs) on all runs of the fraction
+    vector<String> checkpoint_keys;
+    String alignment_checkpoint_key;
+    if (!checkpoint_dir_.empty())
+    {
+      StringList alignment_parts = {"ProteomicsLFQ alignment 1", paramString_("Alignment:"), String(getFlag_("force"))};
+      Size group{1};
+      for (String const & mz_file : ms_files.second)
+      {
+        const String& mz_file_abs_path = File::absolutePath(mz_file);
+        checkpoint_keys.push_back(featureCheckpointKey_(mz_file, mzfile2idfile.at(mz_file_abs_path), fraction, group++));
+        alignment_parts.push_back(checkpoint_keys.back());
+      }
+      alignment_checkpoint_key = checkpointKey_(alignment_parts);
+
+      if (!transfered_ids.empty())
+      {
+        for (String& key : checkpoint_keys)
+        {
+          key = checkpointKey_({"ProteomicsLFQ transferred features 1", key, alignment_checkpoint_key,
+            paramString_("Linking:"), getStringOption_("transfer_ids")});
+        }
+      }
+    }
+
     // for each MS file of current fraction (e.g., all MS files that measured the n-th fraction) 
     Size fraction_group{1};
     for (String const & mz_file : ms_files.second)
     { 
+      const String& mz_file_abs_path = File::absolutePath(mz_file);
+      const String& id_file_abs_path = File::absolutePath(mzfile2idfile.at(mz_file_abs_path));
+      const String checkpoint_key = checkpoint_keys.empty() ? String() : checkpoint_keys[fraction_group - 1];
+
+      if (!checkpoint_key.empty())
+      {
+        FeatureMap fm;
+        String id_ms_run;
+        if (loadFeatureCheckpoint_(checkpoint_key, fm, median_fwhm, id_ms_run, fixed_modifications, variable_modifications))
+        {
+          id_MS_run_ref.push_back(id_ms_run);
+          feature_maps.push_back(std::move(fm));
+          ++fraction_group;
+          continue;
+        }
+      }
+
       // centroid spectra (if in profile mode) and correct precursor masses
       MSExperiment ms_centroided;    
 
@@ -976,8 +1234,6 @@ protected:
       // load and clean identification data associated with MS run
       vector<ProteinIdentification> protein_ids;
       vector<PeptideIdentification> peptide_ids;
-      const String& mz_file_abs_path = File::absolutePath(mz_file);
-      const String& id_file_abs_path = File::absolutePath(mzfile2idfile.at(mz_file_abs_path));
 
       {
         ExitCodes e = loadAndCleanupIDFile_(id_file_abs_path, mz_file, fraction_group, fraction, protein_ids, peptide_ids, fixed_modifications, variable_modifications);
@@ -987,6 +1243,10 @@ protected:
       StringList id_msfile_ref;
       protein_ids[0].getPrimaryMSRunPath(id_msfile_ref);
       id_MS_run_ref.push_back(id_msfile_ref[0]);
+
+      // modifications contributed by this run (part of the checkpoint)
+      const StringList run_fixed_modifications = protein_ids[0].getSearchParameters().fixed_modifications;
+      const StringList run_variable_modifications = protein_ids[0].getSearchParameters().variable_modifications;
      
       //-------------------------------------------------------------
       // Internal Calibration of spectra peaks and precursor peaks with high-confidence IDs
@@ -1085,6 +1345,11 @@ protected:
 
       IDConflictResolverAlgorithm::resolve(tmp, false); // keep only best peptide per feature
 
+      if (!checkpoint_key.empty())
+      {
+        storeFeatureCheckpoint_(checkpoint_key, tmp, median_fwhm, id_MS_run_ref.back(), run_fixed_modifications, run_variable_modifications);
+      }
+
       feature_maps.push_back(tmp);
       
       if (debug_level_ > 666)
@@ -1112,7 +1377,8 @@ protected:
         feature_maps, 
         consensus_fraction, 
         transformations,
-        median_fwhm);
+        median_fwhm,
+        alignment_checkpoint_key);
     }
     else // Data already aligned. Link with previously determined alignment difference
     {
@@ -1250,7 +1516,7 @@ protected:
       indexer.setParameters(param_pi);
 
       // stream data in fasta file
-      FASTAContainer<TFI_File> fasta_db(in_db);
+      FASTAContainer<TFI_MMap> fasta_db(in_db);
       PeptideIndexing::ExitCodes indexer_exit = indexer.run(fasta_db, inferred_protein_ids, inferred_peptide_ids);
 
       if ((indexer_exit != PeptideIndexing::EXECUTION_OK) &&
@@ -1450,6 +1716,16 @@ protected:
         OPENMS_PRETTY_FUNCTION, "MSstats export for spectral counting data not supported. Please remove output file.");
     }
 
+    checkpoint_dir_ = getStringOption_("checkpoint_dir");
+    if (!checkpoint_dir_.empty())
+    {
+      if (!QDir().mkpath(checkpoint_dir_.toQString()))
+      {
+        throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, checkpoint_dir_);
+      }
+      OPENMS_LOG_INFO << "Using checkpoints in " << checkpoint_dir_ << endl;
+    }
+
     //-------------------------------------------------------------
     // Experimental design: read or generate default
     //-------------------------------------------------------------      
@@ -1573,52 +1849,83 @@ protected:
     if (getStringOption_("quantification_method") == "feature_intensity")
     {
       OPENMS_LOG_INFO << "Performing feature intensity-based quantification." << endl;
-      double median_fwhm(0);
-      for (auto const & ms_files : frac2ms) // for each fraction->ms file(s)
-      {      
-        ConsensusMap consensus_fraction; // quantitative result for this fraction identifier
-        vector<TransformationDescription> transformations; // filled by RT alignment
-        double max_alignment_diff(0.0);
-
-        ExitCodes e = quantifyFraction_(
-          ms_files, 
-          mzfile2idfile,
-          median_fwhm, 
-          multimap<Size, PeptideIdentification>(),
-          consensus_fraction, 
-          transformations,  // transformations are empty, will be filled by alignment
-          max_alignment_diff,  // max_alignment_diff not yet determined, will be filled by alignment
-          fixed_modifications, 
-          variable_modifications);
-
-        if (e != EXECUTION_OK) { return e; }
-        
-        if (getStringOption_("transfer_ids") != "false")
-        {  
-          OPENMS_LOG_INFO << "Transferring identification data between runs of the same fraction." << endl;
-          // needs to occur in >= 50% of all runs for transfer
-          const Size min_occurrance = (ms_files.second.size() + 1) / 2;
-          multimap<Size, PeptideIdentification> transfered_ids = transferIDsBetweenSameFraction_(consensus_fraction, min_occurrance);
-          consensus_fraction.clear();
-
-          // The transferred IDs were calculated on the aligned data
-          // So we make sure we use the aligned IDs and peak maps in the re-quantification step
-          e = quantifyFraction_(
+      setCalibrationModelLimits_();
+
+      // fractions are independent of each other and processed in parallel (if there is more than one)
+      const vector<pair<unsigned int, vector<String> > > fractions(frac2ms.begin(), frac2ms.end());
+      vector<ConsensusMap> consensus_fractions(fractions.size());
+      vector<ExitCodes> fraction_exit_codes(fractions.size(), EXECUTION_OK);
+      vector<set<String> > fraction_fixed_modifications(fractions.size()), fraction_variable_modifications(fractions.size());
+      std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 1) if (fractions.size() > 1)
+      for (SignedSize f = 0; f < (SignedSize)fractions.size(); ++f) // for each fraction->ms file(s)
+      {
+        try
+        {      
+          auto const & ms_files = fractions[f];
+          ConsensusMap& consensus_fraction = consensus_fractions[f]; // quantitative result for this fraction identifier
+          vector<TransformationDescription> transformations; // filled by RT alignment
+          double max_alignment_diff(0.0);
+          double median_fwhm(0);
+
+          ExitCodes e = quantifyFraction_(
             ms_files, 
-            mzfile2idfile, 
+            mzfile2idfile,
             median_fwhm, 
-            transfered_ids, 
+            multimap<Size, PeptideIdentification>(),
             consensus_fraction, 
-            transformations,  // transformations as determined by alignment
-            max_alignment_diff, // max_alignment_error as determined by alignment
-            fixed_modifications,
-            variable_modifications);
+            transformations,  // transformations are empty, will be filled by alignment
+            max_alignment_diff,  // max_alignment_diff not yet determined, will be filled by alignment
+            fraction_fixed_modifications[f], 
+            fraction_variable_modifications[f]);
 
-          OPENMS_POSTCONDITION(!consensus_fraction.empty(), "ConsensusMap of fraction empty after ID transfer.!");
-          if (e != EXECUTION_OK) { return e; }
+          if (e != EXECUTION_OK)
+          {
+            fraction_exit_codes[f] = e;
+            continue;
+          }
+        
+          if (getStringOption_("transfer_ids") != "false")
+          {  
+            OPENMS_LOG_INFO << "Transferring identification data between runs of the same fraction." << endl;
+            // needs to occur in >= 50% of all runs for transfer
+            const Size min_occurrance = (ms_files.second.size() + 1) / 2;
+            multimap<Size, PeptideIdentification> transfered_ids = transferIDsBetweenSameFraction_(consensus_fraction, min_occurrance);
+            consensus_fraction.clear();
+
+            // The transferred IDs were calculated on the aligned data
+            // So we make sure we use the aligned IDs and peak maps in the re-quantification step
+            e = quantifyFraction_(
+              ms_files, 
+              mzfile2idfile, 
+              median_fwhm, 
+              transfered_ids, 
+              consensus_fraction, 
+              transformations,  // transformations as determined by alignment
+              max_alignment_diff, // max_alignment_error as determined by alignment
+              fraction_fixed_modifications[f],
+              fraction_variable_modifications[f]);
+
+            OPENMS_POSTCONDITION(!consensus_fraction.empty(), "ConsensusMap of fraction empty after ID transfer.!");
+            fraction_exit_codes[f] = e;
+          }
+        }  // end of scope of fraction related data
+        catch (...)
+        {
+#pragma omp critical (ProteomicsLFQ_fraction_error)
+          if (!error) error = std::current_exception();
         }
-        consensus.appendColumns(consensus_fraction);  // append consensus map calculated for this fraction number
-      }  // end of scope of fraction related data
+      }
+      if (error) std::rethrow_exception(error);
+
+      for (Size f = 0; f < fractions.size(); ++f)
+      {
+        if (fraction_exit_codes[f] != EXECUTION_OK) { return fraction_exit_codes[f]; }
+        consensus.appendColumns(consensus_fractions[f]);  // append consensus map calculated for this fraction number
+        fixed_modifications.insert(fraction_fixed_modifications[f].begin(), fraction_fixed_modifications[f].end());
+        variable_modifications.insert(fraction_variable_modifications[f].begin(), fraction_variable_modifications[f].end());
+      }
+      consensus_fractions.clear();
 
       consensus.sortByPosition();
       consensus.sortPeptideIdentificationsByMapIndex();
@@ -1860,14 +2167,16 @@ protected:
     const bool report_unmapped(true);
     const bool report_unidentified_features(false);
 
-    MzTab m = MzTab::exportConsensusMapToMzTab(
-      consensus, 
-      String("null"),
+    const bool report_subfeatures(true);
+
+    // rows are generated and written one by one instead of building the complete mzTab in memory
+    MzTabFile().store(
+      out,
+      consensus,
       true,
-      report_unidentified_features, 
+      report_unidentified_features,
       report_unmapped,
-      "Export from ProteomicsLFQ workflow in OpenMS.");
-    MzTabFile().store(out, m);
+      report_subfeatures);
 
     if (!out_msstats.empty())
     {
@@ -1890,6 +2199,12 @@ protected:
 
     return EXECUTION_OK;
   }
+
+  // directory of the checkpoints (empty: no checkpoints)
+  String checkpoint_dir_;
+
+  // SHA-1 of the input files (see fileHash_())
+  map<String, String> file_hashes_;
 };
 
 int main(int argc, const char ** argv)
@@ -0,0 +1,232 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/APPLICATIONS/TOPPBase.h>
+#include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/FORMAT/MzMLFollower.h>
+#include <OpenMS/INTERFACES/IMSDataConsumer.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/MATH/MISC/MathFunctions.h>
+#include <OpenMS/QC/QCBase.h>
+
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <thread>
+
+using namespace OpenMS;
+using namespace std;
+
+//-------------------------------------------------------------
+//Doxygen docu
+//-------------------------------------------------------------
+
+/**
+  @page UTILS_QCLiveMonitor QCLiveMonitor
+
+  @brief Computes QC metrics of an mzML file while it is being acquired.
+
+  The input mzML is followed like 'tail -f': every @p poll_interval seconds the spectra
+  appended since the last check are read and one line per spectrum is appended to the
+  tab-separated output file (which is flushed after each update, so other programs can follow it):
+
+  <table>
+  <tr><td>index</td><td>spectrum index</td></tr>
+  <tr><td>native_id</td><td>native ID of the spectrum</td></tr>
+  <tr><td>rt</td><td>retention time in seconds</td></tr>
+  <tr><td>ms_level</td><td>MS level</td></tr>
+  <tr><td>tic</td><td>total ion count</td></tr>
+  <tr><td>base_peak_intensity</td><td>intensity of the highest peak</td></tr>
+  <tr><td>ms2_rate</td><td>number of MS2 spectra per minute within the last @p ms2_rate_window seconds</td></tr>
+  <tr><td>lock_mass_ppm</td><td>MS1 only: mean mass error (ppm) of the most intense peaks near the given @p lock_mass values (empty if none was found)</td></tr>
+  </table>
+
+  The lock mass errors are a proxy for the mass calibration drift which does not need identifications
+  (use QualityControl for ID-based calibration metrics after the run).
+
+  The tool stops when the spectrum list of the mzML was closed or when the file did not grow for @p timeout seconds.
+
+  <B>The command line parameters of this tool are:</B>
+  @verbinclude UTILS_QCLiveMonitor.cli
+  <B>INI file documentation of this tool:</B>
+  @htmlinclude UTILS_QCLiveMonitor.html
+*/
+
+// We do not want this class to show up in the docu:
+/// @cond TOPPCLASSES
+
+/// writes one line of metrics per spectrum
+class LiveQCConsumer :
+  public Interfaces::IMSDataConsumer
+{
+public:
+  LiveQCConsumer(std::ostream& os, const DoubleList& lock_masses, double lock_mass_tolerance, double ms2_rate_window) :
+    os_(os),
+    lock_masses_(lock_masses),
+    lock_mass_tolerance_(lock_mass_tolerance),
+    ms2_rate_window_(ms2_rate_window)
+  {
+    os_ << "index\tnative_id\trt\tms_level\ttic\tbase_peak_intensity\tms2_rate\tlock_mass_ppm\n";
+  }
+
+  void consumeSpectrum(SpectrumType& s) override
+  {
+    summary_.addSpectrum(s);
+    const QCBase::SpectraSummary::Entry& e = summary_.getEntries().back();
+
+    if (e.ms_level == 2)
+    {
+      ms2_rts_.push_back(e.rt);
+    }
+    while (!ms2_rts_.empty() && ms2_rts_.front() < e.rt - ms2_rate_window_)
+    {
+      ms2_rts_.pop_front();
+    }
+    double ms2_rate = ms2_rts_.size() / (ms2_rate_window_ / 60.0);
+
+    os_ << (summary_.size() - 1) << '\t' << s.getNativeID() << '\t' << e.rt << '\t' << e.ms_level << '\t'
+        << e.tic << '\t' << e.base_peak_intensity << '\t' << ms2_rate << '\t';
+    if (e.ms_level == 1 && !lock_masses_.empty())
+    {
+      s.sortByPosition();
+      double sum_ppm{0};
+      Size found{0};
+      for (double lock_mass : lock_masses_)
+      {
+        double tol = Math::ppmToMass(lock_mass_tolerance_, lock_mass);
+        Int idx = s.findHighestInWindow(lock_mass, tol, tol);
+        if (idx < 0) continue;
+        sum_ppm += Math::getPPM(s[idx].getMZ(), lock_mass);
+        ++found;
+      }
+      if (found > 0) os_ << (sum_ppm / found);
+    }
+    os_ << '\n';
+  }
+
+  void consumeChromatogram(ChromatogramType& /* c */) override {}
+  void setExpectedSize(Size /* expectedSpectra */, Size /* expectedChromatograms */) override {}
+  void setExperimentalSettings(const ExperimentalSettings& /* exp */) override {}
+
+  const QCBase::SpectraSummary& getSummary() const
+  {
+    return summary_;
+  }
+
+private:
+  std::ostream& os_;
+  DoubleList lock_masses_;
+  double lock_mass_tolerance_;
+  double ms2_rate_window_;
+  QCBase::SpectraSummary summary_;
+  std::deque<double> ms2_rts_; ///< RTs of MS2 spectra within the rate window
+};
+
+class TOPPQCLiveMonitor :
+  public TOPPBase
+{
+public:
+  TOPPQCLiveMonitor() :
+    TOPPBase("QCLiveMonitor", "Computes QC metrics of an mzML file while it is being acquired.", false)
+  {
+  }
+
+protected:
+
+  void registerOptionsAndFlags_() override
+  {
+    registerStringOption_("in", "<file>", "", "mzML file which is being written (does not need to exist yet)");
+    registerOutputFile_("out", "<file>", "", "Metrics (tab-separated, one line per spectrum)");
+    setValidFormats_("out", ListUtils::create<String>("tsv"));
+    registerDoubleOption_("poll_interval", "<sec>", 1.0, "Check for new spectra every ... seconds", false);
+    setMinFloat_("poll_interval", 0.0);
+    registerDoubleOption_("timeout", "<sec>", 600.0, "Stop if the input did not grow for ... seconds (0 = wait forever)", false);
+    setMinFloat_("timeout", 0.0);
+    registerDoubleOption_("ms2_rate_window", "<sec>", 60.0, "RT window (seconds) for the MS2 rate", false);
+    setMinFloat_("ms2_rate_window", 1.0);
+    registerDoubleList_("lock_mass", "<mz>", DoubleList(), "Known m/z values (e.g. background ions) for monitoring the mass accuracy of MS1 spectra", false);
+    registerDoubleOption_("lock_mass_tolerance", "<ppm>", 10.0, "Search window around each lock mass", false);
+    setMinFloat_("lock_mass_tolerance", 0.0);
+  }
+
+  ExitCodes main_(int, const char**) override
+  {
+    String in = getStringOption_("in");
+    String out = getStringOption_("out");
+    double poll_interval = getDoubleOption_("poll_interval");
+    double timeout = getDoubleOption_("timeout");
+
+    std::ofstream os(out.c_str());
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, out);
+    }
+    LiveQCConsumer consumer(os, getDoubleList_("lock_mass"), getDoubleOption_("lock_mass_tolerance"), getDoubleOption_("ms2_rate_window"));
+
+    MzMLFollower follower(in);
+    auto last_data = std::chrono::steady_clock::now();
+    while (true)
+    {
+      Size n = follower.poll(&consumer);
+      auto now = std::chrono::steady_clock::now();
+      if (n > 0)
+      {
+        os.flush();
+        last_data = now;
+        OPENMS_LOG_INFO << "Read " << follower.getNrSpectra() << " spectra." << std::endl;
+      }
+      if (follower.isComplete()) break;
+      if (timeout > 0 && std::chrono::duration<double>(now - last_data).count() > timeout)
+      {
+        OPENMS_LOG_WARN << "Input did not grow for " << timeout << " seconds. Stopping before the end of the file was reached." << std::endl;
+        break;
+      }
+      std::this_thread::sleep_for(std::chrono::duration<double>(poll_interval));
+    }
+
+    const QCBase::SpectraSummary& summary = consumer.getSummary();
+    OPENMS_LOG_INFO << "Spectra: " << summary.size() << " (MS1: " << summary.getNrSpectra(1) << ", MS2: " << summary.getNrSpectra(2) << ")" << std::endl;
+
+    return EXECUTION_OK;
+  }
+};
+
+
+int main(int argc, const char** argv)
+{
+  TOPPQCLiveMonitor tool;
+  return tool.main(argc, argv);
+}
+
+/// @endcond
@@ -35,6 +35,7 @@
 #include <OpenMS/CONCEPT/Constants.h>
 #include <OpenMS/ANALYSIS/ID/FalseDiscoveryRate.h>
 #include <OpenMS/ANALYSIS/ID/PeptideIndexing.h>
+#include <OpenMS/ANALYSIS/ID/PrecursorMassIndex.h>
 #include <OpenMS/ANALYSIS/ID/PrecursorPurity.h>
 #include <OpenMS/ANALYSIS/RNPXL/HyperScore.h>
 #include <OpenMS/ANALYSIS/RNPXL/RNPxlModificationsGenerator.h>
@@ -191,6 +192,8 @@ protected:
 
     registerStringOption_("RNPxl:sequence", "", "", "Sequence to restrict the generation of oligonucleotide chains. (disabled for empty sequence)", false);
 
+    registerStringOption_("RNPxl:adduct_cache", "<file>", "", "Optional file to store the generated precursor adducts. If it exists and was generated with the same RNPxl settings, the adducts are loaded from it instead of being generated again.", false, true);
+
     registerStringList_("RNPxl:target_nucleotides",
                         "",
                         {"A=C10H14N5O7P", "C=C9H14N3O8P", "G=C10H14N5O8P", "U=C9H13N2O9P"},
@@ -1476,7 +1479,7 @@ protected:
                                  const double small_peptide_mass_filter_threshold,
                                  const Size peptide_min_size,
                                  const PeakMap & spectra,
-                                 multimap<double, pair<Size, int>> & multimap_mass_2_scan_index) const
+                                 PrecursorMassIndex<pair<Size, int>> & precursor_mass_index) const
   {
     Size fractional_mass_filtered(0), small_peptide_mass_filtered(0);
 
@@ -1522,10 +1525,11 @@ protected:
             continue;
           }
 
-          multimap_mass_2_scan_index.insert(make_pair(precursor_mass, make_pair(scan_index, i)));
+          precursor_mass_index.add(precursor_mass, make_pair(scan_index, i));
         }
       }
     }
+    precursor_mass_index.build();
   }
 
   void initializeSpectrumGenerators(TheoreticalSpectrumGenerator &total_loss_spectrum_generator,
@@ -1675,7 +1679,8 @@ protected:
     RNPxlModificationMassesResult mm;
     if (max_nucleotide_length != 0)
     {
-      mm = RNPxlModificationsGenerator::initModificationMassesRNA(
+      const String adduct_cache = getStringOption_("RNPxl:adduct_cache");
+      const String adduct_key = RNPxlModificationsGenerator::getModificationMassesKey(
             target_nucleotides,
             nt_groups,
             can_xl_,
@@ -1684,6 +1689,27 @@ protected:
             sequence_restriction,
             cysteine_adduct,
             max_nucleotide_length);
+
+      if (!adduct_cache.empty() && RNPxlModificationsGenerator::loadModificationMasses(adduct_cache, adduct_key, mm))
+      {
+        OPENMS_LOG_INFO << "Precursor adducts loaded from: " << adduct_cache << " (" << mm.mod_masses.size() << " adducts)" << endl;
+      }
+      else
+      {
+        mm = RNPxlModificationsGenerator::initModificationMassesRNA(
+              target_nucleotides,
+              nt_groups,
+              can_xl_,
+              mappings,
+              modifications,
+              sequence_restriction,
+              cysteine_adduct,
+              max_nucleotide_length);
+        if (!adduct_cache.empty())
+        {
+          RNPxlModificationsGenerator::storeModificationMasses(adduct_cache, adduct_key, mm);
+        }
+      }
     }
 
     if (!getFlag_("RNPxl:only_xl"))
@@ -1740,16 +1766,16 @@ protected:
     preprocessSpectra_(spectra, fragment_mass_tolerance, fragment_mass_tolerance_unit_ppm, convert_to_single_charge, annotate_charge);
     progresslogger.endProgress();
 
-    // build multimap of precursor mass to scan index (and perform some mass and length based filtering)
-    using MassToScanMultiMap = multimap<double, pair<Size, int>>;
-    MassToScanMultiMap multimap_mass_2_scan_index;  // map precursor mass to scan index and (potential) isotopic missassignment
+    // build index of precursor mass to scan index (and perform some mass and length based filtering)
+    using MassToScanIndex = PrecursorMassIndex<pair<Size, int>>;
+    MassToScanIndex precursor_mass_index;  // map precursor mass to scan index and (potential) isotopic missassignment
     mapPrecursorMassesToScans(min_precursor_charge,
                               max_precursor_charge,
                               precursor_isotopes,
                               small_peptide_mass_filter_threshold,
                               peptide_min_size,
                               spectra,
-                              multimap_mass_2_scan_index);
+                              precursor_mass_index);
 
     // initialize spectrum generators (generated ions, etc.)
     TheoreticalSpectrumGenerator total_loss_spectrum_generator;
@@ -1835,6 +1861,9 @@ protected:
 
       digestor.digestUnmodified(current_fasta_entry.sequence, current_digest, min_peptide_length, max_peptide_length);
 
+      // per-thread position in the precursor index, reused for all candidates of this protein
+      MassToScanIndex::Cursor precursor_cursor(precursor_mass_index);
+
       for (auto cit = current_digest.begin(); cit != current_digest.end(); ++cit)
       {
         bool already_processed = false;
@@ -1866,17 +1895,12 @@ protected:
 
         const String unmodified_sequence = cit->getString();
 
-#ifdef _OPENMP
-#pragma omp critical (residuedb_access)
-#endif
+        // only process peptides without ambiguous amino acids (placeholder / any amino acid)
+        if (unmodified_sequence.find_first_of("XBZ") == std::string::npos)
         {
-           // only process peptides without ambiguous amino acids (placeholder / any amino acid)
-          if (unmodified_sequence.find_first_of("XBZ") == std::string::npos)
-          {
-            AASequence aas = AASequence::fromString(unmodified_sequence);
-            ModifiedPeptideGenerator::applyFixedModifications(fixed_modifications, aas);
-            ModifiedPeptideGenerator::applyVariableModifications(variable_modifications, aas, max_variable_mods_per_peptide, all_modified_peptides);
-          }
+          AASequence aas = AASequence::fromString(unmodified_sequence);
+          ModifiedPeptideGenerator::applyFixedModifications(fixed_modifications, aas);
+          ModifiedPeptideGenerator::applyVariableModifications(variable_modifications, aas, max_variable_mods_per_peptide, all_modified_peptides);
         }
 
         for (SignedSize mod_pep_idx = 0; mod_pep_idx < (SignedSize)all_modified_peptides.size(); ++mod_pep_idx)
@@ -1904,20 +1928,10 @@ protected:
             // TODO: const char xl_nucleotide; // can be none
 
             // determine MS2 precursors that match to the current peptide mass
-            MassToScanMultiMap::const_iterator low_it, up_it;
-
-            if (precursor_mass_tolerance_unit_ppm) // ppm
-            {
-              low_it = multimap_mass_2_scan_index.lower_bound(current_peptide_mass - current_peptide_mass * precursor_mass_tolerance * 1e-6);
-              up_it = multimap_mass_2_scan_index.upper_bound(current_peptide_mass + current_peptide_mass * precursor_mass_tolerance * 1e-6);
-            }
-            else // Dalton
-            {
-              low_it = multimap_mass_2_scan_index.lower_bound(current_peptide_mass - precursor_mass_tolerance);
-              up_it = multimap_mass_2_scan_index.upper_bound(current_peptide_mass + precursor_mass_tolerance);
-            }
+            const double precursor_tolerance = precursor_mass_tolerance_unit_ppm ? current_peptide_mass * precursor_mass_tolerance * 1e-6 : precursor_mass_tolerance;
+            const MassToScanIndex::Range precursor_range = precursor_cursor.getRange(current_peptide_mass - precursor_tolerance, current_peptide_mass + precursor_tolerance);
 
-            if (low_it == up_it) { continue; } // no matching precursor in data
+            if (precursor_range.first == precursor_range.second) { continue; } // no matching precursor in data
 
             // add peaks for b- and y- ions with charge 1 (sorted by m/z)
 
@@ -1951,11 +1965,11 @@ protected:
               if (precursor_rna_adduct == "none")
               {
                 // score peptide without RNA (same method as fast scoring)
-                for (auto l = low_it; l != up_it; ++l) // OMS_CODING_TEST_EXCLUDE
+                for (Size l = precursor_range.first; l != precursor_range.second; ++l)
                 {
-                  //const double exp_pc_mass = l->first;
-                  const Size & scan_index = l->second.first;
-                  const int & isotope_error = l->second.second;
+                  //const double exp_pc_mass = precursor_mass_index.getMass(l);
+                  const Size & scan_index = precursor_mass_index.getValue(l).first;
+                  const int & isotope_error = precursor_mass_index.getValue(l).second;
                   const PeakSpectrum & exp_spectrum = spectra[scan_index];
                   const int & exp_pc_charge = exp_spectrum.getPrecursors()[0].getCharge();
                   PeakSpectrum & total_loss_spectrum = (exp_pc_charge < 3) ? total_loss_spectrum_z1 : total_loss_spectrum_z2;
@@ -2094,11 +2108,11 @@ protected:
                     marker_ions_sub_score_spectrum_z1.getIntegerDataArrays()[0],
                     marker_ions_sub_score_spectrum_z1.getStringDataArrays()[0]);
 
-                  for (auto l = low_it; l != up_it; ++l) // OMS_CODING_TEST_EXCLUDE
+                  for (Size l = precursor_range.first; l != precursor_range.second; ++l)
                   {
-                    //const double exp_pc_mass = l->first;
-                    const Size& scan_index = l->second.first;
-                    const int& isotope_error = l->second.second;
+                    //const double exp_pc_mass = precursor_mass_index.getMass(l);
+                    const Size& scan_index = precursor_mass_index.getValue(l).first;
+                    const int& isotope_error = precursor_mass_index.getValue(l).second;
                     const PeakSpectrum& exp_spectrum = spectra[scan_index];
                     float tlss_MIC(0), tlss_err(0), tlss_Morph(0),
                       immonium_sub_score(0), precursor_sub_score(0),
@@ -2186,11 +2200,11 @@ protected:
             }
             else // fast scoring
             {
-              for (auto l = low_it; l != up_it; ++l) // OMS_CODING_TEST_EXCLUDE
+              for (Size l = precursor_range.first; l != precursor_range.second; ++l)
               {
-                //const double exp_pc_mass = l->first;
-                const Size &scan_index = l->second.first;
-                const int &isotope_error = l->second.second;
+                //const double exp_pc_mass = precursor_mass_index.getMass(l);
+                const Size &scan_index = precursor_mass_index.getValue(l).first;
+                const int &isotope_error = precursor_mass_index.getValue(l).second;
                 const PeakSpectrum &exp_spectrum = spectra[scan_index];
                 float total_loss_score;
                 float immonium_sub_score;
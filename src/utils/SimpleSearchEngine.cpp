@@ -73,6 +73,12 @@ using namespace std;
     @em This search engine is mainly for educational/benchmarking/prototyping use cases.
     It lacks behind in speed and/or quality of results when compared to state-of-the-art search engines.
 
+    Large searches can be distributed over several processes or nodes with the parameters in the
+    @em Search:shard section: every process searches a range of the spectra and/or of the proteins
+    and reports its own top hits. Afterwards, the idXML files of all shards are combined with
+    @em -shards (using the same @em -database and search parameters). This yields the same hits and
+    ranks as a single search, so FDR estimation has to be done after merging.
+
     @note Currently mzIdentML (mzid) is not directly supported as an input/output format of this tool. Convert mzid files to/from idXML using @ref TOPP_IDFileConverter if necessary.
 
     <B>The command line parameters of this tool are:</B>
@@ -99,9 +105,12 @@ class SimpleSearchEngine :
   protected:
     void registerOptionsAndFlags_() override
     {
-      registerInputFile_("in", "<file>", "", "input file ");
+      registerInputFile_("in", "<file>", "", "input file (required unless 'shards' is given)", false);
       setValidFormats_("in", ListUtils::create<String>("mzML"));
 
+      registerInputFileList_("shards", "<files>", StringList(), "merge the results of these sharded searches (see Search:shard) instead of searching 'in'", false);
+      setValidFormats_("shards", ListUtils::create<String>("idXML"));
+
       registerInputFile_("database", "<file>", "", "input file ");
       setValidFormats_("database", ListUtils::create<String>("fasta"));
 
@@ -117,9 +126,16 @@ class SimpleSearchEngine :
     ExitCodes main_(int, const char**) override
     {
       String in = getStringOption_("in");
+      StringList shards = getStringList_("shards");
       String database = getStringOption_("database");
       String out = getStringOption_("out");
 
+      if (in.empty() == shards.empty())
+      {
+        writeLog_("Error: Either 'in' or 'shards' needs to be given.");
+        return ILLEGAL_PARAMETERS;
+      }
+
       ProgressLogger progresslogger;
       progresslogger.setLogType(log_type_);
 
@@ -130,14 +146,28 @@ class SimpleSearchEngine :
       sse.setParameters(getParam_().copy("Search:", true));
       //TODO ??? Why not use the TOPPBase ExitCodes?
       // same for OpenPepXL etc. Otherwise please write a proper mapping.
-      SimpleSearchEngineAlgorithm::ExitCodes e = sse.search(in, database, protein_ids, peptide_ids);
+      SimpleSearchEngineAlgorithm::ExitCodes e;
+      if (shards.empty())
+      {
+        e = sse.search(in, database, protein_ids, peptide_ids);
+      }
+      else
+      {
+        vector<vector<ProteinIdentification> > shard_protein_ids(shards.size());
+        vector<vector<PeptideIdentification> > shard_peptide_ids(shards.size());
+        for (Size i = 0; i < shards.size(); ++i)
+        {
+          IdXMLFile().load(shards[i], shard_protein_ids[i], shard_peptide_ids[i]);
+        }
+        e = sse.mergeShards(shard_protein_ids, shard_peptide_ids, database, protein_ids, peptide_ids);
+      }
       if (e != SimpleSearchEngineAlgorithm::ExitCodes::EXECUTION_OK)
       {
         return TOPPBase::ExitCodes::INTERNAL_ERROR;
       }
 
       // MS path already set in algorithm. Overwrite here so we get something testable
-      if (getFlag_("test"))
+      if (getFlag_("test") && shards.empty())
       {
         // if test mode set, add file without path so we can compare it
         protein_ids[0].setPrimaryMSRunPath({"file://" + File::basename(in)});
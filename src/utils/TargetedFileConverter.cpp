@@ -33,6 +33,7 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/ANALYSIS/OPENSWATH/TransitionTSVFile.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/TransitionBinaryFile.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/TransitionPQPFile.h>
 
 #include <OpenMS/APPLICATIONS/TOPPBase.h>
@@ -60,6 +61,7 @@ using namespace OpenMS;
           <li> @ref OpenMS::TraMLFile "TraML" </li>
           <li> @ref OpenMS::TransitionTSVFile "OpenSWATH TSV transition lists" </li>
           <li> @ref OpenMS::TransitionPQPFile "OpenSWATH PQP SQLite files" </li>
+          <li> @ref OpenMS::TransitionBinaryFile "OpenSWATH binary transition libraries" </li>
           <li> SpectraST MRM transition lists </li>
           <li> Skyline transition lists </li>
           <li> Spectronaut transition lists </li>
@@ -92,11 +94,11 @@ protected:
     registerInputFile_("in", "<file>", "", "Input file to convert.\n "
                                            "See http://www.openms.de/current_doxygen/html/UTILS_TargetedFileConverter.html for format of OpenSWATH transition TSV file or SpectraST MRM file.");
     registerStringOption_("in_type", "<type>", "", "input file type -- default: determined from file extension or content\n", false);
-    StringList formats{"tsv", "mrm" ,"pqp", "TraML"};
+    StringList formats{"tsv", "mrm" ,"pqp", "trbin", "TraML"};
     setValidFormats_("in", formats);
     setValidStrings_("in_type", formats);
 
-    formats = { "tsv", "pqp", "TraML" };
+    formats = { "tsv", "pqp", "trbin", "TraML" };
     registerOutputFile_("out", "<file>", "", "Output file");
     setValidFormats_("out", formats);
     registerStringOption_("out_type", "<type>", "", "Output file type -- default: determined from file extension or content\nNote: not all conversion paths work or make sense.", false);
@@ -171,6 +173,13 @@ protected:
       pqp_reader.convertPQPToTargetedExperiment(in.c_str(), targeted_exp, legacy_traml_id);
       pqp_reader.validateTargetedExperiment(targeted_exp);
     }
+    else if (in_type == FileTypes::TRBIN)
+    {
+      TransitionBinaryFile bin_reader;
+      bin_reader.setLogType(log_type_);
+      bin_reader.convertBinaryToTargetedExperiment(in.c_str(), targeted_exp);
+      bin_reader.validateTargetedExperiment(targeted_exp);
+    }
     else if (in_type == FileTypes::TRAML)
     {
       TraMLFile traml;
@@ -189,6 +198,12 @@ protected:
       pqp_reader.setLogType(log_type_);
       pqp_reader.convertTargetedExperimentToPQP(out.c_str(), targeted_exp);
     }
+    else if (out_type == FileTypes::TRBIN)
+    {
+      TransitionBinaryFile bin_writer;
+      bin_writer.setLogType(log_type_);
+      bin_writer.convertTargetedExperimentToBinary(out.c_str(), targeted_exp);
+    }
     else if (out_type == FileTypes::TRAML)
     {
       TraMLFile traml;
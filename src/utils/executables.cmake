@@ -45,6 +45,7 @@ QCEmbedder
 QCExporter
 QCExtractor
 QCImporter
+QCLiveMonitor
 QCMerger
 QCShrinker
 ProteomicsLFQ
@@ -74,6 +75,7 @@ if(NOT DISABLE_OPENSWATH)
     OpenSwathWorkflow
     OpenSwathFileSplitter
     OpenSwathRewriteToFeatureXML
+    OpenSwathShardMerger
     MRMTransitionGroupPicker
   )
 endif(NOT DISABLE_OPENSWATH)